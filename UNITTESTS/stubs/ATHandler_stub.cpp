@@ -379,6 +379,27 @@ void ATHandler::set_send_delay(uint16_t send_delay)
 {
 }
 
+void ATHandler::set_file_handle(FileHandle *fh)
+{
+}
+
+void ATHandler::set_is_filehandle_usable(bool usable)
+{
+}
+
+void ATHandler::set_resp_queue_depth(uint8_t depth)
+{
+}
+
+void ATHandler::resp_queue(Callback<void()> handler)
+{
+    handler();
+}
+
+void ATHandler::resp_queue_flush()
+{
+}
+
 void ATHandler::set_baud(int baud_rate)
 {
 }
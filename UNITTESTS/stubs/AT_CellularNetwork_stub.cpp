@@ -31,6 +31,7 @@ nsapi_error_t AT_CellularNetwork_stub::nsapi_error_value = 0;
 int AT_CellularNetwork_stub::fail_counter = 0;
 int AT_CellularNetwork_stub::set_registration_urc_fail_counter = 0;
 int AT_CellularNetwork_stub::get_registration_params_fail_counter = 0;
+CellularNetwork::AttachStatus AT_CellularNetwork_stub::attach_status = CellularNetwork::Detached;
 
 AT_CellularNetwork::AT_CellularNetwork(ATHandler &atHandler, AT_CellularDevice &device) : _at(atHandler), _device(device)
 {
@@ -87,6 +88,7 @@ nsapi_error_t AT_CellularNetwork::set_attach()
 
 nsapi_error_t AT_CellularNetwork::get_attach(AttachStatus &status)
 {
+    status = AT_CellularNetwork_stub::attach_status;
     return NSAPI_ERROR_OK;
 }
 
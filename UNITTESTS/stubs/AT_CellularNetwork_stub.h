@@ -24,6 +24,7 @@ extern nsapi_error_t nsapi_error_value;
 extern int fail_counter;
 extern int set_registration_urc_fail_counter;
 extern int get_registration_params_fail_counter;
+extern mbed::CellularNetwork::AttachStatus attach_status;
 }
 
 
@@ -96,6 +96,11 @@ short BufferedSerial::poll(short events) const
     return 0;
 }
 
+bool BufferedSerial::poll_notifies() const
+{
+    return true;
+}
+
 void BufferedSerial::api_lock(void)
 {
 }
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CellularMux.h"
+
+using namespace mbed;
+
+CellularMux::Channel::Channel() :
+    _mux(NULL),
+    _dlci(0),
+    _open(false),
+    _blocking(true)
+{
+}
+
+ssize_t CellularMux::Channel::read(void *buffer, size_t size)
+{
+    return 0;
+}
+
+ssize_t CellularMux::Channel::write(const void *buffer, size_t size)
+{
+    return size;
+}
+
+off_t CellularMux::Channel::seek(off_t offset, int whence)
+{
+    return -1;
+}
+
+int CellularMux::Channel::close()
+{
+    return 0;
+}
+
+int CellularMux::Channel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+    return 0;
+}
+
+bool CellularMux::Channel::is_blocking() const
+{
+    return _blocking;
+}
+
+short CellularMux::Channel::poll(short events) const
+{
+    return 0;
+}
+
+bool CellularMux::Channel::poll_notifies() const
+{
+    return true;
+}
+
+void CellularMux::Channel::sigio(Callback<void()> func)
+{
+}
+
+CellularMux::CellularMux(FileHandle *fh) :
+    _fh(fh),
+    _open(false)
+{
+}
+
+CellularMux::~CellularMux()
+{
+}
+
+nsapi_error_t CellularMux::open()
+{
+    return NSAPI_ERROR_OK;
+}
+
+void CellularMux::close()
+{
+}
+
+FileHandle *CellularMux::get_channel(uint8_t dlci)
+{
+    if (dlci < 1 || dlci > MBED_CONF_CELLULAR_MUX_CHANNELS) {
+        return NULL;
+    }
+    return &_channels[dlci - 1];
+}
+
+FileHandle *CellularMux::get_file_handle()
+{
+    return _fh;
+}
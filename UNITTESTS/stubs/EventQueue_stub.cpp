@@ -61,6 +61,18 @@ void EventQueue::background(Callback<void(int)> update)
 {
 }
 
+void EventQueue::get_stats(equeue_stats_t *stats)
+{
+}
+
+void EventQueue::reset_stats()
+{
+}
+
+void EventQueue::get_mem_info(equeue_mem_info_t *info)
+{
+}
+
 int EventQueue::chain(EventQueue *target)
 {
     return 0;
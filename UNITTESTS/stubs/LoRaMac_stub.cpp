@@ -260,6 +260,16 @@ int LoRaMac::get_backoff_timer_event_id(void)
     return LoRaMac_stub::int_value;
 }
 
+lorawan_time_t LoRaMac::get_next_tx_delay(void)
+{
+    return 0;
+}
+
+uint8_t LoRaMac::get_max_uplink_payload_size(void)
+{
+    return LoRaMac_stub::uint8_value;
+}
+
 lorawan_status_t LoRaMac::clear_tx_pipe(void)
 {
     return LoRaMac_stub::status_value;
@@ -464,3 +474,24 @@ uint8_t LoRaMac::get_prev_QOS_level(void)
 {
     return LoRaMac_stub::uint8_value;
 }
+
+#if MBED_CONF_LORA_SESSION_STORAGE
+void LoRaMac::get_session_context(loramac_session_context_t &context, bool is_otaa)
+{
+}
+
+lorawan_status_t LoRaMac::set_session_context(const loramac_session_context_t &context, bool is_otaa)
+{
+    return LoRaMac_stub::status_value;
+}
+
+void LoRaMac::set_frame_counters(uint32_t uplink, uint32_t downlink)
+{
+}
+
+void LoRaMac::get_frame_counters(uint32_t &uplink, uint32_t &downlink)
+{
+    uplink = 0;
+    downlink = 0;
+}
+#endif
@@ -288,6 +288,10 @@ bool LoRaPHY::is_custom_channel_plan_supported()
     return LoRaPHY_stub::bool_table[LoRaPHY_stub::bool_counter++];
 }
 
+void LoRaPHY::restore_channel_plan(const channel_params_t *channels, const uint16_t *mask)
+{
+}
+
 void LoRaPHY::restore_default_channels()
 {
 }
@@ -388,6 +392,11 @@ void LoRaPHY::calculate_backoff(bool joined, bool last_tx_was_join_req, bool dc_
 {
 }
 
+lorawan_time_t LoRaPHY::get_next_tx_delay(bool dc_enabled)
+{
+    return LoRaPHY_stub::uint32_value;
+}
+
 lorawan_status_t LoRaPHY::set_next_channel(channel_selection_params_t *params,
                                            uint8_t *channel, lorawan_time_t *time,
                                            lorawan_time_t *aggregate_timeoff)
@@ -108,3 +108,25 @@ nsapi_error_t NetworkStack::get_ip_address_if(SocketAddress* address, const char
 {
     return NSAPI_ERROR_UNSUPPORTED;
 }
+
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
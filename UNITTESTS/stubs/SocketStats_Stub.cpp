@@ -61,4 +61,24 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
 {
     return;
 }
+
+void SocketStats::mbed_stats_socket_get_totals(const char *interface_name, mbed_stats_socket_totals_t *totals)
+{
+    *totals = {};
+}
+
+void SocketStats::stats_update_interface(const Socket *const reference_id, const char *interface_name)
+{
+    return;
+}
+
+void SocketStats::stats_connect_started(const Socket *const reference_id)
+{
+    return;
+}
+
+void SocketStats::stats_connect_finished(const Socket *const reference_id)
+{
+    return;
+}
 #endif
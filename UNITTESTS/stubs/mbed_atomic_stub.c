@@ -35,13 +35,20 @@ bool core_util_atomic_cas_u16(volatile uint16_t *ptr, uint16_t *expectedCurrentV
 
 bool core_util_atomic_cas_u32(volatile uint32_t *ptr, uint32_t *expectedCurrentValue, uint32_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 
 uint8_t core_util_atomic_exchange_u8(volatile uint8_t *ptr, uint8_t desiredValue)
 {
-    return 0;
+    uint8_t currentValue = *ptr;
+    *ptr = desiredValue;
+    return currentValue;
 }
 
 uint16_t core_util_atomic_exchange_u16(volatile uint16_t *ptr, uint16_t desiredValue)
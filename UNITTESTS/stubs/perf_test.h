@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PERF_TEST_H
+#define PERF_TEST_H
+
+/* Helpers for the performance test suites, labelled "perf".
+ *
+ * Host timings say little about the timings on a target, and vary from a
+ * machine and a build to another. The suites therefore check how the cost
+ * of an operation grows with the amount of work rather than its absolute
+ * cost: a workload is timed at two sizes, and the cost per item at the
+ * larger size must stay within a factor of the cost at the smaller one.
+ * A linear search or a copy sneaking into an operation expected to take
+ * a constant time makes the cost per item grow with the size, and fails
+ * the check on any machine.
+ *
+ * The timings are printed and recorded as properties of the test, so they
+ * also appear in the XML reports of --gtest_output=xml.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdio.h>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace perf {
+
+/** Factor by which the cost per item may grow from the smaller to the larger size */
+const double default_slack = 4.0;
+
+/** Runs of a workload timed, of which the fastest is kept */
+const int default_runs = 5;
+
+/** Time a workload.
+ *
+ * @param items     Size of the workload, passed to it
+ * @param workload  Callable doing the work for a size, including its set up if
+ *                  that grows with the size
+ * @param runs      Number of runs, the fastest is kept to filter out the
+ *                  disturbances from the rest of the machine
+ * @return the time of the fastest run in nanoseconds per item
+ */
+template <typename Workload>
+double ns_per_item(size_t items, Workload &&workload, int runs = default_runs)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        workload(items);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best / items;
+}
+
+/** Record a timing as a property of the current test, and print it.
+ *
+ * @param name  Name of the timing
+ * @param ns    Time per item in nanoseconds
+ * @param items Size of the workload timed
+ */
+inline void report(const char *name, double ns, size_t items)
+{
+    char value[32];
+    snprintf(value, sizeof(value), "%.1f", ns);
+    ::testing::Test::RecordProperty(name, value);
+    printf("[   PERF   ] %s: %s ns per item at %zu items\n", name, value, items);
+}
+
+/** Check that the cost per item of a workload does not grow with its size.
+ *
+ * Use as EXPECT_TRUE(perf::scales_linearly(...)).
+ *
+ * @param name     Name of the workload reported
+ * @param small    Smaller size, large enough for the workload to take at least
+ *                 tens of microseconds
+ * @param large    Larger size, typically 16 times the smaller one
+ * @param workload Callable doing the work for a size
+ * @param slack    Factor by which the cost per item may grow
+ * @return a success if the cost per item at the larger size is within slack
+ *         times the cost at the smaller size
+ */
+template <typename Workload>
+::testing::AssertionResult scales_linearly(const char *name, size_t small, size_t large,
+                                           Workload &&workload, double slack = default_slack)
+{
+    // Warm up the caches and the allocator
+    workload(small);
+
+    double small_ns = ns_per_item(small, workload);
+    double large_ns = ns_per_item(large, workload);
+    report((std::string(name) + "_small").c_str(), small_ns, small);
+    report((std::string(name) + "_large").c_str(), large_ns, large);
+
+    if (large_ns > small_ns * slack) {
+        return ::testing::AssertionFailure() << name << " takes " << large_ns << " ns per item at "
+               << large << " items against " << small_ns << " ns at " << small << " items";
+    }
+    return ::testing::AssertionSuccess();
+}
+
+} // namespace perf
+
+#endif // PERF_TEST_H
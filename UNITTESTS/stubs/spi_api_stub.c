@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/spi_api.h"
+#include "spi_api_stub.h"
+
+#if DEVICE_SPI
+
+spi_api_stub_def spi_api_stub;
+
+void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel)
+{
+}
+
+void spi_init_direct(spi_t *obj, const spi_pinmap_t *pinmap)
+{
+}
+
+void spi_free(spi_t *obj)
+{
+}
+
+void spi_format(spi_t *obj, int bits, int mode, int slave)
+{
+}
+
+void spi_frequency(spi_t *obj, int hz)
+{
+}
+
+int spi_master_write(spi_t *obj, int value)
+{
+    return 0;
+}
+
+int spi_master_block_write(spi_t *obj, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, char write_fill)
+{
+    return tx_length > rx_length ? tx_length : rx_length;
+}
+
+#if DEVICE_SPI_ASYNCH
+
+void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    spi_api_stub.tx = tx;
+    spi_api_stub.tx_length = tx_length;
+    spi_api_stub.rx = rx;
+    spi_api_stub.rx_length = rx_length;
+    spi_api_stub.transfer_count++;
+}
+
+uint32_t spi_irq_handler_asynch(spi_t *obj)
+{
+    return SPI_EVENT_COMPLETE;
+}
+
+uint8_t spi_active(spi_t *obj)
+{
+    return 0;
+}
+
+void spi_abort_asynch(spi_t *obj)
+{
+}
+
+#endif
+
+#endif
@@ -28,6 +28,11 @@ void us_ticker_irq_handler(void)
 {
 }
 
+us_timestamp_t us_ticker_read_us(void)
+{
+    return 0;
+}
+
 void us_ticker_init(void)
 {
 }
@@ -24,6 +24,7 @@
 #ifndef MBED_ASSERT_H
 #define MBED_ASSERT_H
 
+#include <stdbool.h>
 #include "mbed_preprocessor.h"
 #include "mbed_toolchain.h"
 
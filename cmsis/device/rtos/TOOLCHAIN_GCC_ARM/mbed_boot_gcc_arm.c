@@ -18,6 +18,7 @@
 #include "cmsis.h"
 #include "mbed_toolchain.h"
 #include "mbed_boot.h"
+#include "mbed_stats.h"
 #include "mbed_rtos_storage.h"
 #include "cmsis_os2.h"
 
@@ -36,6 +37,26 @@ extern uint32_t             __HeapLimit;
 
 extern void __libc_init_array(void);
 
+#if defined(MBED_BOOT_STATS_ENABLED)
+extern void (*__preinit_array_start[])(void);
+extern void (*__preinit_array_end[])(void);
+extern void (*__init_array_start[])(void);
+extern void (*__init_array_end[])(void);
+extern void _init(void);
+
+/* __libc_init_array(), running the initializers one by one to time them */
+static void mbed_init_array_timed(void)
+{
+    for (void (**init)(void) = __preinit_array_start; init < __preinit_array_end; init++) {
+        mbed_stats_boot_initializer_run(*init);
+    }
+    _init();
+    for (void (**init)(void) = __init_array_start; init < __init_array_end; init++) {
+        mbed_stats_boot_initializer_run(*init);
+    }
+}
+#endif
+
 /*
  * mbed entry point for the GCC toolchain
  *
@@ -67,7 +88,11 @@ void mbed_toolchain_init()
     env_mutex_id = osMutexNew(&env_mutex_attr);
 
     /* Run the C++ global object constructors */
+#if defined(MBED_BOOT_STATS_ENABLED)
+    mbed_init_array_timed();
+#else
     __libc_init_array();
+#endif
 }
 
 extern int __real_main(void);
@@ -118,7 +118,12 @@
 
 #define OS_DYNAMIC_MEM_SIZE         0
 
-#if defined(OS_TICK_FREQ) && (OS_TICK_FREQ != 1000)
+#ifdef MBED_CONF_RTOS_TICK_FREQ
+#if defined(OS_TICK_FREQ) && (OS_TICK_FREQ != MBED_CONF_RTOS_TICK_FREQ)
+#error "OS Tickrate must be set with rtos.tick-freq for system timing"
+#endif
+#define OS_TICK_FREQ                MBED_CONF_RTOS_TICK_FREQ
+#elif defined(OS_TICK_FREQ) && (OS_TICK_FREQ != 1000)
 #error "OS Tickrate must be 1000 for system timing"
 #endif
 
@@ -188,7 +193,9 @@
 #define EVR_RTX_KERNEL_GET_SYS_TIMER_COUNT_DISABLE
 #define EVR_RTX_KERNEL_GET_SYS_TIMER_FREQ_DISABLE
 #define EVR_RTX_THREAD_NEW_DISABLE
+#ifndef MBED_THREAD_CPU_STATS_ENABLED
 #define EVR_RTX_THREAD_CREATED_DISABLE
+#endif
 #define EVR_RTX_THREAD_GET_NAME_DISABLE
 #define EVR_RTX_THREAD_GET_ID_DISABLE
 #define EVR_RTX_THREAD_GET_STATE_DISABLE
@@ -207,10 +214,16 @@
 #define EVR_RTX_THREAD_JOIN_PENDING_DISABLE
 #define EVR_RTX_THREAD_JOINED_DISABLE
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
+#ifndef MBED_THREAD_CPU_STATS_ENABLED
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
+#endif
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
+#ifndef MBED_THREAD_CPU_STATS_ENABLED
 #define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
+#ifndef MBED_THREAD_CPU_STATS_ENABLED
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
+#endif
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
 #define EVR_RTX_THREAD_FLAGS_SET_DISABLE
@@ -63,6 +63,7 @@
 #include "mbed_boot.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "mbed_stats.h"
 
 int main(void);
 static void mbed_cpy_nvic(void);
@@ -83,22 +84,30 @@ void mbed_init(void)
     SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 #endif
 #endif
+    mbed_stats_boot_mark("mbed_init");
     mbed_mpu_manager_init();
     mbed_cpy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark("sdk_init");
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
+    mbed_stats_boot_mark("us_ticker");
 #endif
     mbed_rtos_init();
+    mbed_stats_boot_mark("rtos_init");
 }
 
 void mbed_start(void)
 {
+    mbed_stats_boot_mark("rtos_start");
     mbed_rtos_init_singleton_mutex();
     mbed_tfm_init();
     mbed_toolchain_init();
+    mbed_stats_boot_mark("static_init");
     mbed_main();
+    mbed_stats_boot_mark("mbed_main");
     mbed_error_initialize();
+    mbed_stats_boot_mark("main");
     main();
 }
 
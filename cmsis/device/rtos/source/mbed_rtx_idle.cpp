@@ -24,6 +24,7 @@
 #include "rtos/source/rtos_idle.h"
 #include "rtos/Kernel.h"
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_stats.h"
 #include "platform/internal/mbed_os_timer.h"
 #include "TimerEvent.h"
 #include "mbed_critical.h"
@@ -47,7 +48,7 @@ extern "C" {
     // Setup OS Tick timer to generate periodic RTOS Kernel Ticks
     int32_t OS_Tick_Setup(uint32_t freq, IRQHandler_t handler)
     {
-        MBED_ASSERT(freq == 1000);
+        MBED_ASSERT(freq == OS_TICK_FREQ);
 
 #ifdef TARGET_CORTEX_A
         IRQn_ID_t irq = OsTimer::get_irq_number();
@@ -167,10 +168,27 @@ extern "C" {
         }
     }
 
+#if defined(MBED_STACK_STATS_ENABLED) && MBED_CONF_PLATFORM_STACK_STATS_SAMPLE_INTERVAL > 0
+    // Sampled here rather than from an attached idle hook, which would
+    // replace the default one and its sleep
+    static void idle_stack_sample(void)
+    {
+        static uint32_t last_sample;
+        uint32_t now = osKernelGetTickCount();
+        if (now - last_sample >= (uint32_t)((uint64_t)MBED_CONF_PLATFORM_STACK_STATS_SAMPLE_INTERVAL * OS_TICK_FREQ / 1000)) {
+            last_sample = now;
+            mbed_stats_stack_sample();
+        }
+    }
+#endif
+
     MBED_NORETURN void rtos_idle_loop(void)
     {
         //Continuously call the idle hook function pointer
         while (1) {
+#if defined(MBED_STACK_STATS_ENABLED) && MBED_CONF_PLATFORM_STACK_STATS_SAMPLE_INTERVAL > 0
+            idle_stack_sample();
+#endif
             idle_hook_fptr();
         }
     }
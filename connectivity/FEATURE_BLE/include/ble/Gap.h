@@ -30,6 +30,7 @@
 #include "ble/gap/AdvertisingParameters.h"
 #include "ble/gap/ConnectionParameters.h"
 #include "ble/gap/ScanParameters.h"
+#include "ble/gap/ScanReportFilter.h"
 #include "ble/gap/Events.h"
 #include "ble/gap/Types.h"
 
@@ -341,6 +342,20 @@ public:
         {
         }
 
+        /**
+         * Called with a batch of advertising reports when the scan report
+         * filter groups them.
+         *
+         * @param reports Advertising reports, in the order received. They and
+         * their payloads are only valid during the call.
+         *
+         * @see setScanReportFilter()
+         * @see ScanReportFilter::setBatchSize()
+         */
+        virtual void onAdvertisingReports(Span<const AdvertisingReportEvent> reports)
+        {
+        }
+
         /**
          * Called when scan times out.
          *
@@ -538,6 +553,39 @@ public:
         )
         {
         }
+
+        /**
+         * Called when the negotiations started by the throughput profile on a
+         * new connection have completed.
+         *
+         * @param event The parameters negotiated and the throughput expected.
+         *
+         * @see setThroughputProfile()
+         */
+        virtual void onThroughputProfileComplete(
+            const ThroughputProfileCompleteEvent &event
+        )
+        {
+        }
+
+        /**
+         * Called after a connection event in which packets have been
+         * exchanged, on the connections for which it has been enabled.
+         *
+         * It is called at most once per connection event, shortly after the
+         * anchor point. The application can schedule work on its EventQueue
+         * to complete just before the next connection event, so the CPU wakes
+         * up once for its work and the radio.
+         *
+         * @param event The connection and the time left until its next event.
+         *
+         * @see enableConnectionEventNotification()
+         */
+        virtual void onConnectionEvent(
+            const ConnectionEventNotificationEvent &event
+        )
+        {
+        }
     protected:
         /**
          * Prevent polymorphic deletion and avoid unnecessary virtual destructor
@@ -829,6 +877,16 @@ public:
      */
     ble_error_t setScanParameters(const ScanParameters &params);
 
+    /** Select the advertising reports delivered while scanning.
+     *
+     * The filter applies to the reports received from now on. The reports
+     * remembered by the duplicate filtering are forgotten by startScan().
+     *
+     * @param filter Report filter, @see ScanReportFilter for details.
+     * @return BLE_ERROR_NONE on success.
+     */
+    ble_error_t setScanReportFilter(const ScanReportFilter &filter);
+
     /** Start scanning.
      *
      * @param duration How long to scan for. Special value 0 means scan forever.
@@ -1143,6 +1201,72 @@ public:
         connection_handle_t connectionHandle,
         local_disconnection_reason_t reason
     );
+
+    /**
+     * Negotiate the link of the connections established from now on for bulk
+     * transfers.
+     *
+     * On each new connection, the stack requests:
+     *   - the largest link layer packets, 251 octets, with data length
+     *   extension.
+     *   - the 2M PHY, if the controller supports it.
+     *   - a connection interval between ble-gap-throughput-min-connection-interval
+     *   and ble-gap-throughput-max-connection-interval, without slave latency.
+     *   - the largest ATT MTU, if the GATT client is present.
+     *
+     * Each request the peer rejects leaves that parameter unchanged.
+     * The values obtained are reported by
+     * EventHandler::onThroughputProfileComplete, once the PHY and
+     * the connection parameters have been settled.
+     *
+     * @param enable True to apply the profile to new connections.
+     *
+     * @return BLE_ERROR_NONE in case of success or an appropriate error code.
+     *
+     * @note The final ATT MTU is reported by
+     * GattClient::EventHandler::onAttMtuChange.
+     */
+    ble_error_t setThroughputProfile(bool enable);
+
+    /**
+     * Report the connection events of a connection to the application.
+     *
+     * The host has no view of the radio schedule: it timestamps the packets
+     * the controller receives or acknowledges, which happen in connection
+     * events, and predicts the next events from the connection interval.
+     * A connection exchanging no data, even empty packets being exchanged,
+     * is not observed.
+     *
+     * @param connection Handle of the connection.
+     * @param enable True to call EventHandler::onConnectionEvent after the
+     * connection events observed.
+     *
+     * @return BLE_ERROR_NONE in case of success, BLE_ERROR_INVALID_PARAM if
+     * the connection does not exist.
+     */
+    ble_error_t enableConnectionEventNotification(
+        connection_handle_t connection,
+        bool enable
+    );
+
+    /**
+     * Get the time left until the next connection event of a connection.
+     *
+     * The time is predicted from the last connection event observed, see
+     * enableConnectionEventNotification(), and the connection interval. It is
+     * more accurate when packets have been exchanged recently.
+     *
+     * @param connection Handle of the connection.
+     * @param delay The time left until the next connection event.
+     *
+     * @return BLE_ERROR_NONE in case of success, BLE_ERROR_INVALID_PARAM if
+     * the connection does not exist or BLE_ERROR_INVALID_STATE if no
+     * connection event has been observed yet.
+     */
+    ble_error_t getTimeToNextConnectionEvent(
+        connection_handle_t connection,
+        microsecond_t &delay
+    );
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
     /**
@@ -115,6 +115,24 @@ public:
             (void)connectionHandle;
             (void)attMtuSize;
         }
+
+        /**
+         * Function invoked when the queue of write commands, full or refusing
+         * a command previously, has room for half of its capacity again.
+         *
+         * @param connectionHandle The handle of the connection of the last
+         * command sent.
+         * @param space The number of commands queueWriteCommand() accepts now.
+         *
+         * @see queueWriteCommand()
+         */
+        virtual void onWriteCommandQueueReady(
+            ble::connection_handle_t connectionHandle,
+            uint8_t space
+        ) {
+            (void)connectionHandle;
+            (void)space;
+        }
     protected:
         /**
          * Prevent polymorphic deletion and avoid unnecessary virtual destructor
@@ -459,6 +477,59 @@ public:
         const uint8_t *value
     ) const;
 
+    /**
+     * Queue a write command on an attribute value, for streaming.
+     *
+     * The commands queued are handed to the stack one at a time, each one as
+     * soon as the stack has accepted the previous one, so that the link
+     * layer sends as many as possible per connection event while the host
+     * buffers never overflow. The value is copied: the buffer can be reused
+     * once the function returns.
+     *
+     * The completion of each command is reported to the event handlers
+     * registered through onDataWritten(), and the room made in a full queue
+     * to EventHandler::onWriteCommandQueueReady().
+     *
+     * The queue holds ble-gatt-client-write-command-queue-size commands for
+     * all the connections.
+     *
+     * @param[in] connHandle Handle of the connection used to send the command.
+     * @param[in] attributeHandle Handle of the attribute value to write.
+     * @param[in] length Number of bytes present in @p value, not greater than
+     * the size of the mtu of connHandle minus three.
+     * @param[in] value Data buffer to write to attributeHandle.
+     *
+     * @return BLE_ERROR_NONE if the command has been queued.
+     * @return BLE_ERROR_NO_MEM if the queue is full.
+     * @return BLE_ERROR_PARAM_OUT_OF_RANGE if the value is too long.
+     *
+     * @note Write commands to the same attribute should not be sent with
+     * write() while commands queued are pending.
+     */
+    ble_error_t queueWriteCommand(
+        ble::connection_handle_t connHandle,
+        GattAttribute::Handle_t attributeHandle,
+        size_t length,
+        const uint8_t *value
+    );
+
+    /**
+     * Get the number of write commands queueWriteCommand() accepts now.
+     *
+     * @return The free space of the write command queue.
+     */
+    uint8_t getWriteCommandQueueSpace() const;
+
+    /**
+     * Get the number of ACL data packets the controller can accept now.
+     *
+     * It shows how much of the transmit capacity of the controller the
+     * pending write commands and notifications are using.
+     *
+     * @return The number of free ACL data buffers of the controller.
+     */
+    uint8_t getAvailableTxBuffers() const;
+
     /* Event callback handlers. */
 
     /**
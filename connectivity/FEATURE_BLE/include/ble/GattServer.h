@@ -346,6 +346,66 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * Allocate the buffer of a value sent by notify().
+     *
+     * The buffer comes from the Bluetooth stack, with room for the ATT and
+     * L2CAP headers in front of the value, so that the notification PDU is
+     * built around it without copying the value.
+     *
+     * @param[in] size Size of the value (in bytes).
+     *
+     * @return A buffer of @p size bytes, or nullptr if the stack is out of
+     * memory.
+     */
+    uint8_t *allocateNotification(uint16_t size);
+
+    /**
+     * Release a buffer obtained from allocateNotification() which has not
+     * been passed to notify().
+     *
+     * @param[in] value The buffer to release.
+     */
+    void freeNotification(uint8_t *value);
+
+    /**
+     * Send a notification of a characteristic value to a client, without
+     * copying it.
+     *
+     * Unlike write(), the value is neither copied into the attribute
+     * database nor into an ATT buffer: the buffer becomes the notification
+     * PDU and is released by the stack once sent. One buffer is therefore
+     * needed for each client notified.
+     *
+     * The notifications of a connection are queued, up to
+     * ble-gatt-server-notification-queue-size, while the stack holds as many
+     * notifications as it can send at once (cordio.max-att-notifications),
+     * so that several updates can leave in the same connection event.
+     * Each notification sent is reported by onDataSent.
+     *
+     * @param[in] connectionHandle Connection handle of the client.
+     * @param[in] attributeHandle Handle for the value attribute of the
+     * characteristic.
+     * @param[in] value A buffer from allocateNotification() holding the value.
+     * It is owned by the stack once this function is called, even if it fails.
+     * @param[in] size Size of the value (in bytes).
+     *
+     * @return BLE_ERROR_NONE if the notification has been sent or queued,
+     * BLE_ERROR_INVALID_STATE if the client has not subscribed to the
+     * notifications of the characteristic, BLE_ERROR_NO_MEM if the queue of
+     * the connection is full or BLE_ERROR_PARAM_OUT_OF_RANGE if the
+     * attribute is not a notifiable characteristic value.
+     *
+     * @note Reads of the attribute still return the value last written with
+     * write().
+     */
+    ble_error_t notify(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        uint8_t *value,
+        uint16_t size
+    );
+
     /**
      * Determine if one of the connected clients has subscribed to notifications
      * or indications of the characteristic in input.
@@ -818,6 +818,178 @@ private:
 
 };
 
+/**
+ * Event received when the throughput profile has been applied to a
+ * connection.
+ *
+ * Each parameter holds the value negotiated, which is the previous one if the
+ * peer or the local controller refused the change.
+ *
+ * @see ble::Gap::setThroughputProfile()
+ * @see ble::Gap::EventHandler::onThroughputProfileComplete().
+ */
+struct ThroughputProfileCompleteEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    ThroughputProfileCompleteEvent(
+        connection_handle_t connectionHandle,
+        phy_t txPhy,
+        phy_t rxPhy,
+        uint16_t txSize,
+        uint16_t rxSize,
+        const conn_interval_t &connectionInterval,
+        uint32_t txThroughput,
+        uint32_t rxThroughput
+    ) :
+        connectionHandle(connectionHandle),
+        txPhy(txPhy),
+        rxPhy(rxPhy),
+        txSize(txSize),
+        rxSize(rxSize),
+        connectionInterval(connectionInterval),
+        txThroughput(txThroughput),
+        rxThroughput(rxThroughput)
+    {
+    }
+
+#endif
+
+    /**
+     * Get the handle of the connection.
+     */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /**
+     * Get the PHY used by the transmitter.
+     */
+    phy_t getTxPhy() const
+    {
+        return txPhy;
+    }
+
+    /**
+     * Get the PHY used by the receiver.
+     */
+    phy_t getRxPhy() const
+    {
+        return rxPhy;
+    }
+
+    /**
+     * Get the maximum number of octets sent in a single link layer packet.
+     */
+    uint16_t getTxSize() const
+    {
+        return txSize;
+    }
+
+    /**
+     * Get the maximum number of octets received in a single link layer packet.
+     */
+    uint16_t getRxSize() const
+    {
+        return rxSize;
+    }
+
+    /**
+     * Get the connection interval.
+     */
+    const conn_interval_t &getConnectionInterval() const
+    {
+        return connectionInterval;
+    }
+
+    /**
+     * Get an estimate of the data rate the local device can send, in bits
+     * per second.
+     *
+     * It counts back to back packets of getTxSize() octets, each acknowledged
+     * by an empty packet, over the whole connection events. It is an upper
+     * bound: the controller may end the connection events earlier and the
+     * L2CAP and ATT headers take 7 octets of each ATT PDU.
+     */
+    uint32_t getTxThroughput() const
+    {
+        return txThroughput;
+    }
+
+    /**
+     * Get an estimate of the data rate the peer can send, in bits per second.
+     *
+     * @see getTxThroughput()
+     */
+    uint32_t getRxThroughput() const
+    {
+        return rxThroughput;
+    }
+
+private:
+    ble::connection_handle_t connectionHandle;
+    phy_t txPhy;
+    phy_t rxPhy;
+    uint16_t txSize;
+    uint16_t rxSize;
+    ble::conn_interval_t connectionInterval;
+    uint32_t txThroughput;
+    uint32_t rxThroughput;
+};
+
+/**
+ * Event received when the stack has seen a connection event happen.
+ *
+ * @see ble::Gap::enableConnectionEventNotification()
+ * @see ble::Gap::EventHandler::onConnectionEvent().
+ */
+struct ConnectionEventNotificationEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    ConnectionEventNotificationEvent(
+        connection_handle_t connectionHandle,
+        const conn_interval_t &connectionInterval,
+        const microsecond_t &timeToNextEvent
+    ) :
+        connectionHandle(connectionHandle),
+        connectionInterval(connectionInterval),
+        timeToNextEvent(timeToNextEvent)
+    {
+    }
+
+#endif
+
+    /**
+     * Get the handle of the connection.
+     */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /**
+     * Get the connection interval, the time between two connection events.
+     */
+    const conn_interval_t &getConnectionInterval() const
+    {
+        return connectionInterval;
+    }
+
+    /**
+     * Get the time left, when the event is delivered, until the next
+     * connection event.
+     */
+    const microsecond_t &getTimeToNextEvent() const
+    {
+        return timeToNextEvent;
+    }
+
+private:
+    ble::connection_handle_t connectionHandle;
+    ble::conn_interval_t connectionInterval;
+    ble::microsecond_t timeToNextEvent;
+};
+
 /**
  * @}
  * @}
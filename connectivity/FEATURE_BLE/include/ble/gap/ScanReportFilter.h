@@ -0,0 +1,219 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_GAP_SCAN_REPORT_FILTER_H__
+#define MBED_GAP_SCAN_REPORT_FILTER_H__
+
+#include <cstdint>
+
+#include "ble/common/blecommon.h"
+#include "ble/common/BLETypes.h"
+#include "ble/common/UUID.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+/**
+ * Selection of the advertising reports delivered to the application while
+ * scanning.
+ *
+ * The filter is evaluated by the stack before any event handler is called:
+ *   - Duplicate filtering drops a report identical, in address, event type
+ *   and payload, to one already delivered since the scan started. Unlike the
+ *   controller filter, it remembers up to ble-gap-scan-duplicate-table-size
+ *   reports and reports the advertisers again when their payload changes.
+ *   - The service UUID, manufacturer ID and RSSI criteria drop the reports
+ *   that do not match all the criteria set.
+ *
+ * Reports accepted can be grouped into batches delivered to
+ * Gap::EventHandler::onAdvertisingReports instead of one call of
+ * Gap::EventHandler::onAdvertisingReport per report.
+ */
+class ScanReportFilter {
+public:
+    /**
+     * Construct a filter accepting every report, delivered one by one.
+     */
+    ScanReportFilter() :
+        service_uuid(),
+        manufacturer_id(0),
+        min_rssi(-127),
+        batch_size(0),
+        duplicate_filtering(false),
+        service_uuid_set(false),
+        manufacturer_id_set(false)
+    {
+    }
+
+    /**
+     * Drop the reports already delivered since the scan started.
+     *
+     * @param enable True to filter duplicates.
+     * @return A reference to this.
+     */
+    ScanReportFilter &setDuplicateFiltering(bool enable)
+    {
+        duplicate_filtering = enable;
+        return *this;
+    }
+
+    /**
+     * Only accept the reports listing a service UUID in their payload.
+     *
+     * @param uuid The service UUID, 16 or 128 bits, looked for in the complete
+     * and incomplete lists of service UUIDs.
+     * @return A reference to this.
+     */
+    ScanReportFilter &setServiceUuid(const UUID &uuid)
+    {
+        service_uuid = uuid;
+        service_uuid_set = true;
+        return *this;
+    }
+
+    /**
+     * Accept reports whatever the services they list.
+     *
+     * @return A reference to this.
+     */
+    ScanReportFilter &clearServiceUuid()
+    {
+        service_uuid_set = false;
+        return *this;
+    }
+
+    /**
+     * Only accept the reports with manufacturer specific data of a company.
+     *
+     * @param companyId The company identifier, first two octets of the
+     * manufacturer specific data.
+     * @return A reference to this.
+     */
+    ScanReportFilter &setManufacturerId(uint16_t companyId)
+    {
+        manufacturer_id = companyId;
+        manufacturer_id_set = true;
+        return *this;
+    }
+
+    /**
+     * Accept reports whatever their manufacturer specific data.
+     *
+     * @return A reference to this.
+     */
+    ScanReportFilter &clearManufacturerId()
+    {
+        manufacturer_id_set = false;
+        return *this;
+    }
+
+    /**
+     * Only accept the reports received with a minimum signal strength.
+     *
+     * @param rssi The weakest RSSI accepted in dBm, -127 to accept all.
+     * @return A reference to this.
+     */
+    ScanReportFilter &setMinimumRssi(rssi_t rssi)
+    {
+        min_rssi = rssi;
+        return *this;
+    }
+
+    /**
+     * Group the reports accepted into batches.
+     *
+     * A batch is delivered when it is full, when its payloads fill
+     * ble-gap-scan-batch-buffer-size, ble-gap-scan-batch-timeout-ms after its
+     * first report or when the scan stops.
+     *
+     * @param reports The size of the batches, 0 or 1 to deliver the reports
+     * one by one. It is capped at ble-gap-scan-batch-max-reports.
+     * @return A reference to this.
+     */
+    ScanReportFilter &setBatchSize(uint8_t reports)
+    {
+        batch_size = reports;
+        return *this;
+    }
+
+    /** Get if duplicates are filtered. */
+    bool isDuplicateFilteringEnabled() const
+    {
+        return duplicate_filtering;
+    }
+
+    /** Get the service UUID looked for, if isServiceUuidSet(). */
+    const UUID &getServiceUuid() const
+    {
+        return service_uuid;
+    }
+
+    /** Get if the reports must list a service UUID. */
+    bool isServiceUuidSet() const
+    {
+        return service_uuid_set;
+    }
+
+    /** Get the company identifier looked for, if isManufacturerIdSet(). */
+    uint16_t getManufacturerId() const
+    {
+        return manufacturer_id;
+    }
+
+    /** Get if the reports must hold data of a manufacturer. */
+    bool isManufacturerIdSet() const
+    {
+        return manufacturer_id_set;
+    }
+
+    /** Get the weakest RSSI accepted. */
+    rssi_t getMinimumRssi() const
+    {
+        return min_rssi;
+    }
+
+    /** Get the size of the batches. */
+    uint8_t getBatchSize() const
+    {
+        return batch_size;
+    }
+
+private:
+    UUID service_uuid;
+    uint16_t manufacturer_id;
+    rssi_t min_rssi;
+    uint8_t batch_size;
+    bool duplicate_filtering;
+    bool service_uuid_set;
+    bool manufacturer_id_set;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif // MBED_GAP_SCAN_REPORT_FILTER_H__
@@ -181,6 +181,12 @@ ble_error_t Gap::setScanParameters(const ScanParameters &params)
 }
 
 
+ble_error_t Gap::setScanReportFilter(const ScanReportFilter &filter)
+{
+    return impl->setScanReportFilter(filter);
+}
+
+
 ble_error_t Gap::startScan(
     scan_duration_t duration,
     duplicates_filter_t filtering,
@@ -357,6 +363,30 @@ ble_error_t Gap::disconnect(
     return impl->disconnect(connectionHandle, reason);
 }
 
+
+ble_error_t Gap::setThroughputProfile(bool enable)
+{
+    return impl->setThroughputProfile(enable);
+}
+
+
+ble_error_t Gap::enableConnectionEventNotification(
+    connection_handle_t connection,
+    bool enable
+)
+{
+    return impl->enableConnectionEventNotification(connection, enable);
+}
+
+
+ble_error_t Gap::getTimeToNextConnectionEvent(
+    connection_handle_t connection,
+    microsecond_t &delay
+)
+{
+    return impl->getTimeToNextConnectionEvent(connection, delay);
+}
+
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
 
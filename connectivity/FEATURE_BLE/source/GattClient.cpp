@@ -87,6 +87,26 @@ ble_error_t GattClient::write(
     return impl->write(cmd, connHandle, attributeHandle, length, value);
 }
 
+ble_error_t GattClient::queueWriteCommand(
+    ble::connection_handle_t connHandle,
+    GattAttribute::Handle_t attributeHandle,
+    size_t length,
+    const uint8_t *value
+)
+{
+    return impl->queueWriteCommand(connHandle, attributeHandle, length, value);
+}
+
+uint8_t GattClient::getWriteCommandQueueSpace() const
+{
+    return impl->getWriteCommandQueueSpace();
+}
+
+uint8_t GattClient::getAvailableTxBuffers() const
+{
+    return impl->getAvailableTxBuffers();
+}
+
 /* Event callback handlers. */
 
 void GattClient::onDataRead(ble::ReadCallback_t callback)
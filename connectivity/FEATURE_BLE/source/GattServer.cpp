@@ -75,6 +75,26 @@ ble_error_t GattServer::write(
     return impl->write(connectionHandle, attributeHandle, value, size, localOnly);
 }
 
+uint8_t *GattServer::allocateNotification(uint16_t size)
+{
+    return impl->allocateNotification(size);
+}
+
+void GattServer::freeNotification(uint8_t *value)
+{
+    impl->freeNotification(value);
+}
+
+ble_error_t GattServer::notify(
+    ble::connection_handle_t connectionHandle,
+    GattAttribute::Handle_t attributeHandle,
+    uint8_t *value,
+    uint16_t size
+)
+{
+    return impl->notify(connectionHandle, attributeHandle, value, size);
+}
+
 ble_error_t GattServer::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
     bool *enabledP
@@ -24,10 +24,19 @@
 #include "hci_cmd.h"
 #include "hci_core.h"
 #include "bstream.h"
+#include "wsf_msg.h"
 #include "hci_mbed_os_adaptation.h"
 
+#if MBED_CONF_CORDIO_HOST_AES
+#include "mbedtls/aes.h"
+#endif
+
 #define HCI_RESET_RAND_CNT        4
 
+#ifndef MBED_CONF_CORDIO_HOST_AES_RPA_CACHE_SIZE
+#define MBED_CONF_CORDIO_HOST_AES_RPA_CACHE_SIZE 8
+#endif
+
 namespace ble {
 
 namespace {
@@ -60,6 +69,138 @@ static void hciCoreReadResolvingListSize(void)
     }
 }
 
+#if MBED_CONF_CORDIO_HOST_AES
+
+/* Length of prand, the random part of a resolvable private address */
+#define HCI_PRAND_LEN             3
+
+/* Length of the parameters of the command complete event of LE Encrypt */
+#define HCI_LEN_LE_ENCRYPT_CMPL_EVT (HCI_LEN_CMD_CMPL + 1 + HCI_ENCRYPT_DATA_LEN)
+
+/*
+ * Results of ah(), the IRK and prand of the addresses resolved recently. A
+ * peer reconnecting or advertising with the same address is resolved against
+ * each IRK without running AES again.
+ */
+struct rpa_cache_entry_t {
+    uint8_t irk[HCI_KEY_LEN];
+    uint8_t prand[HCI_PRAND_LEN];
+    uint8_t ciphertext[HCI_ENCRYPT_DATA_LEN];
+    bool valid;
+};
+
+static rpa_cache_entry_t rpa_cache[MBED_CONF_CORDIO_HOST_AES_RPA_CACHE_SIZE];
+static uint8_t rpa_cache_next;
+
+/*
+ * ah() encrypts prand padded with 13 zero octets. The parameters of the
+ * command are little endian: the padding is at the end.
+ */
+static bool is_address_hash(const uint8_t *plaintext)
+{
+    for (size_t i = HCI_PRAND_LEN; i < HCI_ENCRYPT_DATA_LEN; i++) {
+        if (plaintext[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static rpa_cache_entry_t *find_address_hash(const uint8_t *key, const uint8_t *plaintext)
+{
+    for (rpa_cache_entry_t &entry : rpa_cache) {
+        if (entry.valid &&
+            memcmp(entry.prand, plaintext, HCI_PRAND_LEN) == 0 &&
+            memcmp(entry.irk, key, HCI_KEY_LEN) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+static void add_address_hash(const uint8_t *key, const uint8_t *plaintext, const uint8_t *ciphertext)
+{
+    rpa_cache_entry_t &entry = rpa_cache[rpa_cache_next];
+    rpa_cache_next = (rpa_cache_next + 1) % MBED_CONF_CORDIO_HOST_AES_RPA_CACHE_SIZE;
+
+    memcpy(entry.irk, key, HCI_KEY_LEN);
+    memcpy(entry.prand, plaintext, HCI_PRAND_LEN);
+    memcpy(entry.ciphertext, ciphertext, HCI_ENCRYPT_DATA_LEN);
+    entry.valid = true;
+}
+
+static void reverse_copy(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = src[len - 1 - i];
+    }
+}
+
+/*
+ * Run an HCI LE Encrypt command on the host, with the AES engine used by
+ * mbed TLS - the AES peripheral when the target has one - and queue its
+ * command complete event as if it came from the controller. The security
+ * services of the stack (address resolution and generation, pairing
+ * functions, CMAC of signed writes) all go through this command; running it
+ * locally saves a transport round trip per block.
+ *
+ * @return true if the command has been processed.
+ */
+static bool host_le_encrypt(const uint8_t *cmd)
+{
+    const uint8_t *key = cmd + HCI_CMD_HDR_LEN;
+    const uint8_t *plaintext = key + HCI_KEY_LEN;
+
+    uint8_t *evt = (uint8_t *) WsfMsgAlloc(HCI_EVT_HDR_LEN + HCI_LEN_LE_ENCRYPT_CMPL_EVT);
+    if (evt == nullptr) {
+        /* let the controller do it */
+        return false;
+    }
+
+    uint8_t *p = evt;
+    UINT8_TO_BSTREAM(p, HCI_CMD_CMPL_EVT);
+    UINT8_TO_BSTREAM(p, HCI_LEN_LE_ENCRYPT_CMPL_EVT);
+    UINT8_TO_BSTREAM(p, 1); /* num packets */
+    UINT16_TO_BSTREAM(p, HCI_OPCODE_LE_ENCRYPT);
+    uint8_t *status = p++;
+    uint8_t *ciphertext = p;
+
+    const bool address_hash = is_address_hash(plaintext);
+    rpa_cache_entry_t *cached = address_hash ? find_address_hash(key, plaintext) : nullptr;
+
+    if (cached) {
+        memcpy(ciphertext, cached->ciphertext, HCI_ENCRYPT_DATA_LEN);
+        *status = HCI_SUCCESS;
+    } else {
+        /* mbed TLS works on big endian blocks */
+        uint8_t be_key[HCI_KEY_LEN];
+        uint8_t be_block[HCI_ENCRYPT_DATA_LEN];
+        reverse_copy(be_key, key, HCI_KEY_LEN);
+        reverse_copy(be_block, plaintext, HCI_ENCRYPT_DATA_LEN);
+
+        mbedtls_aes_context aes;
+        mbedtls_aes_init(&aes);
+        int err = mbedtls_aes_setkey_enc(&aes, be_key, HCI_KEY_LEN * 8);
+        if (err == 0) {
+            err = mbedtls_aes_crypt_ecb(&aes, MBEDTLS_AES_ENCRYPT, be_block, be_block);
+        }
+        mbedtls_aes_free(&aes);
+        memset(be_key, 0, sizeof(be_key));
+
+        reverse_copy(ciphertext, be_block, HCI_ENCRYPT_DATA_LEN);
+        *status = (err == 0) ? HCI_SUCCESS : HCI_ERR_UNSPECIFIED;
+
+        if (err == 0 && address_hash) {
+            add_address_hash(key, plaintext, ciphertext);
+        }
+    }
+
+    hciCoreRecv(HCI_EVT_TYPE, evt);
+    return true;
+}
+
+#endif // MBED_CONF_CORDIO_HOST_AES
+
 } // end of anonymous namespace
 
 
@@ -279,6 +420,21 @@ void CordioHCIDriver::signal_reset_sequence_done()
 
 uint16_t CordioHCIDriver::write(uint8_t type, uint16_t len, uint8_t *pData)
 {
+#if MBED_CONF_CORDIO_HOST_AES
+    if (type == HCI_CMD_TYPE && len == HCI_CMD_HDR_LEN + HCI_LEN_LE_ENCRYPT) {
+        uint16_t opcode;
+        uint8_t *p = pData;
+        BSTREAM_TO_UINT16(opcode, p);
+        if (opcode == HCI_OPCODE_LE_ENCRYPT && host_le_encrypt(pData)) {
+#if CORDIO_ZERO_COPY_HCI
+            /* the buffer is owned by the driver */
+            WsfMsgFree(pData);
+#endif
+            return len;
+        }
+    }
+#endif // MBED_CONF_CORDIO_HOST_AES
+
     return _transport_driver.write(type, len, pData);
 }
 
@@ -83,6 +83,11 @@ extern "C" uint16_t hci_mbed_os_drv_write(uint8_t type, uint16_t len, uint8_t *p
     return ble_cordio_get_hci_driver().write(type, len, pData);
 }
 
+extern "C" void hci_mbed_os_signal_connection_event(uint16_t handle)
+{
+    ble::impl::PalGap::connection_event_observed(handle);
+}
+
 extern "C" void hci_mbed_os_start_reset_sequence(void)
 {
     ble_cordio_get_hci_driver().start_reset_sequence();
@@ -630,6 +635,9 @@ void BLEInstanceBase::callDispatcher()
 
     wsfOsDispatcher();
 
+    // report the connection events timestamped by the HCI transport
+    PalGap::process_connection_events();
+
     static mbed::LowPowerTimeout nextTimeout;
     mbed::CriticalSectionLock critical_section;
 
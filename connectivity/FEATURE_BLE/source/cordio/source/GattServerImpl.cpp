@@ -137,6 +137,7 @@ ble_error_t GattServer::addService(GattService &service)
     // register services and update cccds
     AttsAddGroup(&att_service->attGroup);
     AttsCccRegister(cccd_cnt, (attsCccSet_t *) cccds, cccd_cb);
+    update_handle_index();
     return BLE_ERROR_NONE;
 }
 
@@ -758,29 +759,131 @@ ble_error_t GattServer::write(
     return BLE_ERROR_NONE;
 }
 
+uint8_t *GattServer::allocateNotification(uint16_t size)
+{
+    return (uint8_t *) AttMsgAlloc(size, ATT_PDU_VALUE_NTF);
+}
+
+void GattServer::freeNotification(uint8_t *value)
+{
+    AttMsgFree(value, ATT_PDU_VALUE_NTF);
+}
+
+ble_error_t GattServer::notify(
+    connection_handle_t connection,
+    GattAttribute::Handle_t att_handle,
+    uint8_t *value,
+    uint16_t len
+)
+{
+    uint8_t cccd_index;
+    if ((connection == DM_CONN_ID_NONE) || (connection > DM_CONN_MAX) ||
+        !get_cccd_index_by_value_handle(att_handle, cccd_index)) {
+        AttMsgFree(value, ATT_PDU_VALUE_NTF);
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
+
+    if (!(AttsCccEnabled(connection, cccd_index) & ATT_CLIENT_CFG_NOTIFY) ||
+        !is_update_authorized(connection, att_handle)) {
+        AttMsgFree(value, ATT_PDU_VALUE_NTF);
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    if (queue.count == BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE) {
+        AttMsgFree(value, ATT_PDU_VALUE_NTF);
+        return BLE_ERROR_NO_MEM;
+    }
+
+    queued_notification_t &entry =
+        queue.waiting[(queue.head + queue.count) % BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE];
+    entry.value = value;
+    entry.handle = att_handle;
+    entry.size = len;
+    queue.count++;
+
+    send_notifications(connection);
+
+    return BLE_ERROR_NONE;
+}
+
+void GattServer::send_notifications(connection_handle_t connection)
+{
+    notification_queue_t &queue = _notification_queues[connection - 1];
+
+    // Sent in order: the head waits while the stack holds one of its handle
+    while (queue.count && queue.sent_count < ATT_NUM_SIMUL_NTF) {
+        queued_notification_t &entry = queue.waiting[queue.head];
+        for (uint8_t i = 0; i < queue.sent_count; i++) {
+            if (queue.sent_handles[i] == entry.handle) {
+                return;
+            }
+        }
+
+        queue.sent_handles[queue.sent_count++] = entry.handle;
+        queue.head = (queue.head + 1) % BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE;
+        queue.count--;
+        AttsHandleValueNtfZeroCpy(connection, entry.handle, entry.size, entry.value);
+    }
+}
+
+void GattServer::on_notification_complete(connection_handle_t connection, GattAttribute::Handle_t handle)
+{
+    if ((connection == DM_CONN_ID_NONE) || (connection > DM_CONN_MAX)) {
+        return;
+    }
+
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    for (uint8_t i = 0; i < queue.sent_count; i++) {
+        if (queue.sent_handles[i] == handle) {
+            queue.sent_handles[i] = queue.sent_handles[--queue.sent_count];
+            break;
+        }
+    }
+
+    if (DmConnInUse(connection) == false) {
+        // The stack completes the pending notifications when the link closes
+        flush_notifications(connection);
+        return;
+    }
+
+    send_notifications(connection);
+}
+
+void GattServer::flush_notifications(connection_handle_t connection)
+{
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    while (queue.count) {
+        AttMsgFree(queue.waiting[queue.head].value, ATT_PDU_VALUE_NTF);
+        queue.head = (queue.head + 1) % BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE;
+        queue.count--;
+    }
+    queue.head = 0;
+    queue.sent_count = 0;
+}
+
 ble_error_t GattServer::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
     bool *enabled
 )
 {
-    for (size_t idx = 0; idx < cccd_cnt; idx++) {
-        if (characteristic.getValueHandle() == cccd_handles[idx]) {
-            for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
-                if (DmConnInUse(conn_id) == true) {
-                    uint16_t cccd_value = AttsCccGet(conn_id, idx);
-                    if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
-                        *enabled = true;
-                        return BLE_ERROR_NONE;
-                    }
+    uint8_t idx;
+    if (!get_cccd_index_by_value_handle(characteristic.getValueHandle(), idx)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
 
-                }
+    for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
+        if (DmConnInUse(conn_id) == true) {
+            uint16_t cccd_value = AttsCccGet(conn_id, idx);
+            if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
+                *enabled = true;
+                return BLE_ERROR_NONE;
             }
-            *enabled = false;
-            return BLE_ERROR_NONE;
+
         }
     }
-
-    return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    *enabled = false;
+    return BLE_ERROR_NONE;
 }
 
 ble_error_t GattServer::areUpdatesEnabled(
@@ -793,18 +896,18 @@ ble_error_t GattServer::areUpdatesEnabled(
         return BLE_ERROR_INVALID_PARAM;
     }
 
-    for (uint8_t idx = 0; idx < cccd_cnt; idx++) {
-        if (characteristic.getValueHandle() == cccd_handles[idx]) {
-            uint16_t cccd_value = AttsCccGet(connectionHandle, idx);
-            if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
-                *enabled = true;
-            } else {
-                *enabled = false;
-            }
-            return BLE_ERROR_NONE;
-        }
+    uint8_t idx;
+    if (!get_cccd_index_by_value_handle(characteristic.getValueHandle(), idx)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
-    return BLE_ERROR_PARAM_OUT_OF_RANGE;
+
+    uint16_t cccd_value = AttsCccGet(connectionHandle, idx);
+    if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
+        *enabled = true;
+    } else {
+        *enabled = false;
+    }
+    return BLE_ERROR_NONE;
 }
 
 bool GattServer::isOnDataReadAvailable() const
@@ -884,6 +987,10 @@ ble_error_t GattServer::reset(ble::GattServer* server)
     serviceCount = 0;
     characteristicCount = 0;
 
+    for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
+        flush_notifications(conn_id);
+    }
+
     dataSentCallChain.clear();
     dataWrittenCallChain.clear();
     dataReadCallChain.clear();
@@ -913,6 +1020,10 @@ ble_error_t GattServer::reset(ble::GattServer* server)
 
     _auth_char_count = 0;
 
+    free(_handle_index);
+    _handle_index = nullptr;
+    _handle_index_size = 0;
+
     AttsCccRegister(cccd_cnt, (attsCccSet_t *) cccds, cccd_cb);
 
     return BLE_ERROR_NONE;
@@ -935,8 +1046,11 @@ void GattServer::att_cb(const attEvt_t *evt)
         if (handler) {
             handler->onAttMtuChange(evt->hdr.param, evt->mtu);
         }
-    } else if (evt->hdr.status == ATT_SUCCESS && evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
-        getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+    } else if (evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
+        getInstance().on_notification_complete(evt->hdr.param, evt->handle);
+        if (evt->hdr.status == ATT_SUCCESS) {
+            getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+        }
     }
 }
 
@@ -1279,6 +1393,7 @@ void GattServer::add_generic_attribute_service()
     generic_attribute_service.service.endHandle = currentHandle;
     AttsAddGroup(&generic_attribute_service.service);
     AttsCccRegister(cccd_cnt, (attsCccSet_t *) cccds, cccd_cb);
+    update_handle_index();
 }
 
 void *GattServer::alloc_block(size_t block_size)
@@ -1299,8 +1414,41 @@ void *GattServer::alloc_block(size_t block_size)
     return block->data;
 }
 
+void GattServer::update_handle_index()
+{
+    auto *index = (handle_index_t *) realloc(_handle_index, (currentHandle + 1) * sizeof(handle_index_t));
+    if (index == nullptr) {
+        // The lookups fall back to a scan of the tables
+        free(_handle_index);
+        _handle_index = nullptr;
+        _handle_index_size = 0;
+        return;
+    }
+
+    _handle_index = index;
+    _handle_index_size = currentHandle + 1;
+    memset(_handle_index, NO_INDEX, _handle_index_size * sizeof(handle_index_t));
+
+    // A handle is either a characteristic value or a CCCD: one field serves both
+    for (uint8_t i = 0; i < cccd_cnt; i++) {
+        _handle_index[cccds[i].handle].cccd_index = i;
+        _handle_index[cccd_handles[i]].cccd_index = i;
+    }
+    for (uint8_t i = 0; i < _auth_char_count; i++) {
+        _handle_index[_auth_char[i]->getValueHandle()].auth_char_index = i;
+    }
+}
+
 GattCharacteristic *GattServer::get_auth_char(uint16_t value_handle)
 {
+    if (_handle_index) {
+        if (value_handle >= _handle_index_size) {
+            return nullptr;
+        }
+        uint8_t i = _handle_index[value_handle].auth_char_index;
+        return i == NO_INDEX ? nullptr : _auth_char[i];
+    }
+
     for (size_t i = 0; i < _auth_char_count; ++i) {
         if (_auth_char[i]->getValueHandle() == value_handle) {
             return _auth_char[i];
@@ -1311,6 +1459,14 @@ GattCharacteristic *GattServer::get_auth_char(uint16_t value_handle)
 
 bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t &idx) const
 {
+    if (_handle_index) {
+        if (cccd_handle >= _handle_index_size) {
+            return false;
+        }
+        idx = _handle_index[cccd_handle].cccd_index;
+        return idx != NO_INDEX && cccds[idx].handle == cccd_handle;
+    }
+
     for (idx = 0; idx < cccd_cnt; idx++) {
         if (cccd_handle == cccds[idx].handle) {
             return true;
@@ -1321,6 +1477,14 @@ bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_hand
 
 bool GattServer::get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t &idx) const
 {
+    if (_handle_index) {
+        if (char_handle >= _handle_index_size) {
+            return false;
+        }
+        idx = _handle_index[char_handle].cccd_index;
+        return idx != NO_INDEX && cccd_handles[idx] == char_handle;
+    }
+
     for (idx = 0; idx < cccd_cnt; ++idx) {
         if (char_handle == cccd_handles[idx]) {
             return true;
@@ -1398,10 +1562,13 @@ GattServer::GattServer() :
     cccd_cnt(0),
     _auth_char(),
     _auth_char_count(0),
+    _handle_index(nullptr),
+    _handle_index_size(0),
     generic_access_service(),
     generic_attribute_service(),
     registered_service(nullptr),
     allocated_blocks(nullptr),
+    _notification_queues(),
     currentHandle(0),
     default_services_added(false)
 {
@@ -24,6 +24,8 @@
 
 #include "wsf_types.h"
 #include "att_api.h"
+#include "dm_api.h"
+#include "cfg_stack.h"
 
 #include "ble/GattServer.h"
 #include "ble/Gap.h"
@@ -41,6 +43,10 @@
 #include "source/generic/GattServerEvents.h"
 #include "source/pal/PalSigningMonitor.h"
 
+#ifndef BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE
+#define BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE 4
+#endif
+
 namespace ble {
 
 // fwd declaration of PalAttClient, PalGenericAccessService and BLE
@@ -102,6 +108,17 @@ public:
         bool localOnly = false
     );
 
+    uint8_t *allocateNotification(uint16_t size);
+
+    void freeNotification(uint8_t *value);
+
+    ble_error_t notify(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        uint8_t *value,
+        uint16_t size
+    );
+
     ble_error_t areUpdatesEnabled(
         const GattCharacteristic &characteristic,
         bool *enabledP
@@ -279,8 +296,16 @@ private:
 
     bool get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t &idx) const;
 
+    void update_handle_index();
+
     bool is_update_authorized(connection_handle_t connection, GattAttribute::Handle_t value_handle);
 
+    void send_notifications(connection_handle_t connection);
+
+    void on_notification_complete(connection_handle_t connection, GattAttribute::Handle_t handle);
+
+    void flush_notifications(connection_handle_t connection);
+
     struct alloc_block_t {
         alloc_block_t *next;
         uint8_t data[1];
@@ -356,6 +381,20 @@ private:
     GattCharacteristic *_auth_char[MBED_CONF_BLE_API_IMPLEMENTATION_MAX_CHARACTERISTIC_AUTHORISATION_COUNT];
     uint8_t _auth_char_count;
 
+    /*
+     * Position of the CCCD and authorisation entries of each attribute,
+     * indexed by handle and rebuilt whenever attributes are added.
+     */
+    struct handle_index_t {
+        uint8_t cccd_index;
+        uint8_t auth_char_index;
+    };
+
+    static const uint8_t NO_INDEX = 0xFF;
+
+    handle_index_t *_handle_index;
+    uint16_t _handle_index_size;
+
     struct {
         attsGroup_t service;
         attsAttr_t attributes[7];
@@ -381,6 +420,26 @@ private:
     internal_service_t *registered_service;
     alloc_block_t *allocated_blocks;
 
+    struct queued_notification_t {
+        uint8_t *value;
+        uint16_t handle;
+        uint16_t size;
+    };
+
+    /*
+     * Notifications of a connection: the ones handed to the stack, at most
+     * one per handle as the stack rejects a second one, and the ones waiting.
+     */
+    struct notification_queue_t {
+        queued_notification_t waiting[BLE_GATT_SERVER_NOTIFICATION_QUEUE_SIZE];
+        uint16_t sent_handles[ATT_NUM_SIMUL_NTF];
+        uint8_t head;
+        uint8_t count;
+        uint8_t sent_count;
+    };
+
+    notification_queue_t _notification_queues[DM_CONN_MAX];
+
     uint16_t currentHandle;
 
     bool default_services_added;
@@ -26,6 +26,7 @@
 
 #include "att_api.h"
 #include "att_defs.h"
+#include "hci_core.h"
 
 namespace ble {
 namespace impl {
@@ -238,6 +239,14 @@ ble_error_t PalAttClient::signed_write_command(
     return BLE_ERROR_NONE;
 }
 
+/**
+* @see ble::PalAttClient::get_available_tx_buffers
+*/
+uint8_t PalAttClient::get_available_tx_buffers()
+{
+    return hciCoreCb.availBufs;
+}
+
 /**
 * Initialises the counter used to sign messages. Counter will be incremented every
 * time a message is signed.
@@ -135,6 +135,11 @@ public:
         const Span<const uint8_t> &value
     ) final;
 
+    /**
+     * @see ble::PalAttClient::get_available_tx_buffers
+     */
+    uint8_t get_available_tx_buffers() final;
+
     /**
      * Initialises the counter used to sign messages. Counter will be incremented every
      * time a message is signed.
@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 #include "source/PalGapImpl.h"
+#include "platform/CriticalSectionLock.h"
 #include "hci_api.h"
 #include "dm_api.h"
 #include "dm_main.h"
@@ -532,6 +533,170 @@ ble_error_t PalGap::set_phy(
     return BLE_ERROR_NONE;
 }
 
+
+ble_error_t PalGap::set_data_length(
+    connection_handle_t connection,
+    uint16_t tx_octets,
+    uint16_t tx_time
+)
+{
+    DmConnSetDataLen(connection, tx_octets, tx_time);
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t PalGap::set_connection_event_notification(
+    connection_handle_t connection,
+    bool enable
+)
+{
+    connection_event_cb_t *cb = get_connection_event_cb(connection);
+    if (!cb) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    mbed::CriticalSectionLock critical_section;
+    cb->notify = enable;
+    cb->pending = false;
+
+    return BLE_ERROR_NONE;
+}
+
+
+ble_error_t PalGap::get_next_connection_event(
+    connection_handle_t connection,
+    uint16_t &connection_interval,
+    uint32_t &time_to_next_event
+)
+{
+    connection_event_cb_t *cb = get_connection_event_cb(connection);
+    if (!cb) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    mbed::HighResClock::time_point last_event;
+    {
+        mbed::CriticalSectionLock critical_section;
+        if (!cb->observed) {
+            return BLE_ERROR_INVALID_STATE;
+        }
+        last_event = cb->last_event;
+        connection_interval = cb->connection_interval;
+    }
+
+    /* connection events follow each other every interval from the anchor */
+    const uint32_t interval_us = connection_interval * 1250;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        mbed::HighResClock::now() - last_event
+    ).count();
+    time_to_next_event = interval_us - (uint32_t) (elapsed % interval_us);
+
+    return BLE_ERROR_NONE;
+}
+
+
+void PalGap::connection_event_observed(uint16_t hci_handle)
+{
+    const mbed::HighResClock::time_point now = mbed::HighResClock::now();
+
+    for (connection_event_cb_t &cb : get_gap().connection_event_cb) {
+        if (!cb.open || cb.hci_handle != hci_handle) {
+            continue;
+        }
+
+        /* keep the first packet of a connection event: the closest to its anchor */
+        const std::chrono::microseconds half_interval(cb.connection_interval * 625);
+        if (!cb.observed || now - cb.last_event > half_interval) {
+            cb.last_event = now;
+            cb.observed = true;
+            cb.pending = cb.notify;
+        }
+        return;
+    }
+}
+
+
+void PalGap::process_connection_events()
+{
+    PalGap &gap = get_gap();
+
+    for (size_t i = 0; i < DM_CONN_MAX; i++) {
+        connection_event_cb_t &cb = gap.connection_event_cb[i];
+        {
+            mbed::CriticalSectionLock critical_section;
+            if (!cb.pending) {
+                continue;
+            }
+            cb.pending = false;
+        }
+
+        const connection_handle_t connection = i + 1;
+        uint16_t connection_interval;
+        uint32_t time_to_next_event;
+        if (gap._pal_event_handler &&
+            gap.get_next_connection_event(connection, connection_interval, time_to_next_event) == BLE_ERROR_NONE) {
+            gap._pal_event_handler->on_connection_event(connection, connection_interval, time_to_next_event);
+        }
+    }
+}
+
+
+PalGap::connection_event_cb_t *PalGap::get_connection_event_cb(connection_handle_t connection)
+{
+    /* DM connection identifiers start at 1 */
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX) {
+        return nullptr;
+    }
+
+    connection_event_cb_t *cb = &connection_event_cb[connection - 1];
+    return cb->open ? cb : nullptr;
+}
+
+
+void PalGap::update_connection_event_cb(const wsfMsgHdr_t *msg)
+{
+    if (msg->param == DM_CONN_ID_NONE || msg->param > DM_CONN_MAX) {
+        return;
+    }
+
+    connection_event_cb_t &cb = connection_event_cb[msg->param - 1];
+    mbed::CriticalSectionLock critical_section;
+
+    switch (msg->event) {
+        case DM_CONN_OPEN_IND: {
+            const auto *evt = (const hciLeConnCmplEvt_t *) msg;
+            if (evt->status != HCI_SUCCESS) {
+                break;
+            }
+            cb.hci_handle = evt->handle;
+            cb.connection_interval = evt->connInterval;
+            cb.observed = false;
+            cb.notify = false;
+            cb.pending = false;
+            cb.open = true;
+            break;
+        }
+
+        case DM_CONN_UPDATE_IND: {
+            const auto *evt = (const hciLeConnUpdateCmplEvt_t *) msg;
+            if (evt->status == HCI_SUCCESS) {
+                /* the anchor moves with the new parameters */
+                cb.connection_interval = evt->connInterval;
+                cb.observed = false;
+            }
+            break;
+        }
+
+        case DM_CONN_CLOSE_IND:
+            cb.open = false;
+            cb.pending = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
 // singleton of the ARM Cordio client
 
 PalGap &PalGap::get_gap()
@@ -736,7 +901,13 @@ void PalGap::gap_handler(const wsfMsgHdr_t *msg)
         }
             break;
 
+        case DM_CONN_UPDATE_IND:
+            get_gap().update_connection_event_cb(msg);
+            break;
+
         case DM_CONN_CLOSE_IND: {
+            get_gap().update_connection_event_cb(msg);
+
             // Intercept connection close indication received when direct  advertising timeout.
             // Leave the rest of the processing to the event handlers bellow.
             const auto *evt = (const hciDisconnectCmplEvt_t *) msg;
@@ -760,6 +931,8 @@ void PalGap::gap_handler(const wsfMsgHdr_t *msg)
             break;
 
         case DM_CONN_OPEN_IND: {
+            get_gap().update_connection_event_cb(msg);
+
             // Intercept connection open indication received when direct advertising timeout.
             // Leave the rest of the processing to the event handlers bellow.
             // There is no advertising stop event generated for directed connectable advertising.
@@ -19,6 +19,7 @@
 #ifndef IMPL_PAL_GAP_
 #define IMPL_PAL_GAP_
 
+#include "drivers/HighResClock.h"
 #include "source/pal/PalGap.h"
 #include "dm_api.h"
 
@@ -167,6 +168,37 @@ public:
         coded_symbol_per_bit_t coded_symbol
     ) final;
 
+    ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) final;
+
+    ble_error_t set_connection_event_notification(
+        connection_handle_t connection,
+        bool enable
+    ) final;
+
+    ble_error_t get_next_connection_event(
+        connection_handle_t connection,
+        uint16_t &connection_interval,
+        uint32_t &time_to_next_event
+    ) final;
+
+    /**
+     * Timestamp a connection event: called by the HCI transport, possibly
+     * in interrupt context, for each packet received or acknowledged.
+     *
+     * @param hci_handle HCI handle of the connection.
+     */
+    static void connection_event_observed(uint16_t hci_handle);
+
+    /**
+     * Report the connection events observed since the last call to the
+     * event handler.
+     */
+    static void process_connection_events();
+
     // singleton of the ARM Cordio client
     static PalGap &get_gap();
 
@@ -535,12 +567,31 @@ private:
     }
 
 private:
+    /*
+     * Timing of a connection, indexed by the DM connection identifier. The
+     * HCI transport identifies connections by their HCI handle.
+     */
+    struct connection_event_cb_t {
+        mbed::HighResClock::time_point last_event;
+        uint16_t hci_handle = 0;
+        uint16_t connection_interval = 0;
+        bool open = false;
+        bool observed = false;
+        bool notify = false;
+        bool pending = false;
+    };
+
+    connection_event_cb_t *get_connection_event_cb(connection_handle_t connection);
+
+    void update_connection_event_cb(const wsfMsgHdr_t *msg);
+
     PalGapEventHandler *_pal_event_handler;
     address_t device_random_address;
     bool use_active_scanning;
     uint8_t extended_scan_type[3];
     phy_set_t scanning_phys;
     direct_adv_cb_t direct_adv_cb[DM_NUM_ADV_SETS];
+    connection_event_cb_t connection_event_cb[DM_CONN_MAX];
 
     /**
      * Callback called when an event is emitted by the LE subsystem.
@@ -57,6 +57,15 @@ void hci_mbed_os_handle_reset_sequence(uint8_t* msg);
  */
 void hci_mbed_os_signal_reset_sequence_done(void);
 
+/**
+ * Signal a packet received or acknowledged on a connection, so during one of
+ * its connection events.
+ * @param handle: The HCI handle of the connection.
+ * @note called by the HCI transport, possibly in interrupt context.
+ * @note definition provided in mbed OS.
+ */
+void hci_mbed_os_signal_connection_event(uint16_t handle);
+
 #ifdef __cplusplus
 };
 #endif
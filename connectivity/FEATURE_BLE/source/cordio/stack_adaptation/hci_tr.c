@@ -35,6 +35,7 @@
 /* PORTING: EXACTLE removed as replaced by zero copy hci driver in mbedos */
 
 uint16_t hci_mbed_os_drv_write(uint8_t type, uint16_t len, uint8_t *pData);
+void hci_mbed_os_signal_connection_event(uint16_t handle);
 
 /**************************************************************************************************
   Data Types
@@ -110,6 +111,41 @@ void hciTrSendCmd(uint8_t *pCmdData)
   }
 }
 
+/*************************************************************************************************/
+/*!
+ *  \brief  Signal the connection events seen in a received packet: ACL data is received and
+ *          packets are acknowledged during connection events.
+ *
+ *  \param  pktInd   Packet type.
+ *  \param  pPkt     Received packet.
+ *
+ *  \return None.
+ */
+/*************************************************************************************************/
+static void hciTrSignalConnectionEvents(uint8_t pktInd, uint8_t *pPkt)
+{
+  uint16_t handle;
+
+  if (pktInd == HCI_ACL_TYPE)
+  {
+    BYTES_TO_UINT16(handle, pPkt);
+    hci_mbed_os_signal_connection_event(handle & HCI_HANDLE_MASK);
+  }
+  else if (pktInd == HCI_EVT_TYPE && pPkt[0] == HCI_NUM_CMPL_PKTS_EVT)
+  {
+    uint8_t numHandles = pPkt[HCI_EVT_HDR_LEN];
+    uint8_t *p = pPkt + HCI_EVT_HDR_LEN + 1;
+
+    /* handles are interleaved with their number of completed packets */
+    while (numHandles--)
+    {
+      BYTES_TO_UINT16(handle, p);
+      hci_mbed_os_signal_connection_event(handle & HCI_HANDLE_MASK);
+      p += 4;
+    }
+  }
+}
+
 /*************************************************************************************************/
 /*!
  *  \fn     hciSerialRxIncoming
@@ -257,6 +293,7 @@ void hciTrSerialRxIncoming(uint8_t *pBuf, uint8_t len)
       /* deliver data */
       if (pPktRx != NULL)
       {
+        hciTrSignalConnectionEvents(pktIndRx, pPktRx);
         hciCoreRecv(pktIndRx, pPktRx);
       }
 
@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <new>
 
 #include "ble/Gap.h"
 #include "ble/SecurityManager.h"
@@ -302,6 +304,112 @@ microsecond_t minSupervisionTimeout(
     return (1 + slaveLatency.value()) * maxConnectionInterval * 2;
 }
 
+/*
+ * Search a service UUID in the lists of service UUIDs of an advertising
+ * payload.
+ */
+bool is_service_advertised(Span<const uint8_t> payload, const UUID &uuid)
+{
+    bool is_short = uuid.shortOrLong() == UUID::UUID_TYPE_SHORT;
+
+    AdvertisingDataParser parser(payload);
+    while (parser.hasNext()) {
+        AdvertisingDataParser::element_t element = parser.next();
+        Span<const uint8_t> ids = element.value;
+
+        if (is_short &&
+            (element.type == adv_data_type_t::INCOMPLETE_LIST_16BIT_SERVICE_IDS ||
+             element.type == adv_data_type_t::COMPLETE_LIST_16BIT_SERVICE_IDS)) {
+            for (size_t i = 0; i + 1 < (size_t) ids.size(); i += 2) {
+                if ((ids[i] | (ids[i + 1] << 8)) == uuid.getShortUUID()) {
+                    return true;
+                }
+            }
+        } else if (!is_short &&
+            (element.type == adv_data_type_t::INCOMPLETE_LIST_128BIT_SERVICE_IDS ||
+             element.type == adv_data_type_t::COMPLETE_LIST_128BIT_SERVICE_IDS)) {
+            // Both are little endian
+            for (size_t i = 0; i + UUID::LENGTH_OF_LONG_UUID <= (size_t) ids.size(); i += UUID::LENGTH_OF_LONG_UUID) {
+                if (memcmp(ids.data() + i, uuid.getBaseUUID(), UUID::LENGTH_OF_LONG_UUID) == 0) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * Search the manufacturer specific data of a company in an advertising
+ * payload.
+ */
+bool is_manufacturer_advertised(Span<const uint8_t> payload, uint16_t company_id)
+{
+    AdvertisingDataParser parser(payload);
+    while (parser.hasNext()) {
+        AdvertisingDataParser::element_t element = parser.next();
+        if (element.type == adv_data_type_t::MANUFACTURER_SPECIFIC_DATA &&
+            element.value.size() >= 2 &&
+            (element.value[0] | (element.value[1] << 8)) == company_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * FNV-1a hash, identifying the advertising reports already delivered.
+ */
+uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+#if BLE_FEATURE_CONNECTABLE
+/*
+ * Steps of the throughput profile awaiting the peer.
+ */
+const uint8_t THROUGHPUT_PHY_PENDING = 0x01;
+const uint8_t THROUGHPUT_PARAMETERS_PENDING = 0x02;
+
+/*
+ * Largest payload of a link layer packet and its duration on the 1M PHY,
+ * see BLUETOOTH SPECIFICATION Version 5.0 | Vol 6, Part B - 4.5.10
+ */
+const uint16_t THROUGHPUT_TX_OCTETS = 251;
+const uint16_t THROUGHPUT_TX_TIME = 2120;
+
+/*
+ * Time on air of a link layer packet, in us, with the preamble, access
+ * address, header and CRC. The coded PHY is counted with 8 symbols per bit.
+ */
+uint32_t packet_time(phy_t phy, uint16_t octets)
+{
+    switch (phy.value()) {
+        case phy_t::LE_2M:
+            return 4 * (octets + 11);
+        case phy_t::LE_CODED:
+            return 376 + 64 * (octets + 5);
+        default:
+            return 8 * (octets + 10);
+    }
+}
+
+/*
+ * Bits per second of back to back packets, each acknowledged by an empty
+ * packet after the inter frame space.
+ */
+uint32_t link_throughput(phy_t data_phy, uint16_t octets, phy_t ack_phy)
+{
+    const uint32_t t_ifs = 150;
+    uint32_t period = packet_time(data_phy, octets) + t_ifs + packet_time(ack_phy, 0) + t_ifs;
+    return (octets * 8 * 1000000UL) / period;
+}
+#endif // BLE_FEATURE_CONNECTABLE
+
 } // end of anonymous namespace
 
 const peripheral_privacy_configuration_t Gap::default_peripheral_privacy_configuration = {
@@ -336,6 +444,15 @@ Gap::Gap(
     _scan_enabled(false),
     _advertising_timeout(),
     _scan_timeout(),
+    _scan_filter(),
+    _scan_duplicates(),
+    _scan_batch_data_size(0),
+    _scan_batch_count(0),
+    _scan_batch_timeout(),
+#if BLE_FEATURE_CONNECTABLE
+    _throughput_links(),
+    _throughput_profile_enabled(false),
+#endif // BLE_FEATURE_CONNECTABLE
     _user_manage_connection_parameter_requests(false)
 {
     _pal_gap.initialize();
@@ -474,6 +591,8 @@ ble_error_t Gap::stopScan()
 
     _scan_timeout.detach();
 
+    flush_scan_batch();
+
     return BLE_ERROR_NONE;
 }
 
@@ -687,6 +806,14 @@ void Gap::on_data_length_change(
     uint16_t rx_size
 )
 {
+#if BLE_FEATURE_CONNECTABLE
+    throughput_link_t *link = get_throughput_link(connection_handle);
+    if (link) {
+        link->tx_size = tx_size;
+        link->rx_size = rx_size;
+    }
+#endif // BLE_FEATURE_CONNECTABLE
+
     if (_event_handler) {
         _event_handler->onDataLengthChange(connection_handle, tx_size, rx_size);
     }
@@ -708,6 +835,17 @@ void Gap::on_phy_update_complete(
     if (_event_handler) {
         _event_handler->onPhyUpdateComplete(status, connection_handle, tx_phy, rx_phy);
     }
+
+#if BLE_FEATURE_CONNECTABLE
+    throughput_link_t *link = get_throughput_link(connection_handle);
+    if (link && (link->pending & THROUGHPUT_PHY_PENDING)) {
+        if (status == BLE_ERROR_NONE) {
+            link->tx_phy = tx_phy;
+            link->rx_phy = rx_phy;
+        }
+        on_throughput_step_complete(link, THROUGHPUT_PHY_PENDING);
+    }
+#endif // BLE_FEATURE_CONNECTABLE
 }
 
 
@@ -720,6 +858,41 @@ ble_error_t Gap::disconnect(
 }
 
 
+ble_error_t Gap::setThroughputProfile(bool enable)
+{
+    _throughput_profile_enabled = enable;
+    return BLE_ERROR_NONE;
+}
+
+
+ble_error_t Gap::enableConnectionEventNotification(
+    connection_handle_t connection,
+    bool enable
+)
+{
+    return _pal_gap.set_connection_event_notification(connection, enable);
+}
+
+
+ble_error_t Gap::getTimeToNextConnectionEvent(
+    connection_handle_t connection,
+    microsecond_t &delay
+)
+{
+    uint16_t connection_interval;
+    uint32_t time_to_next_event;
+    ble_error_t err = _pal_gap.get_next_connection_event(
+        connection,
+        connection_interval,
+        time_to_next_event
+    );
+    if (err == BLE_ERROR_NONE) {
+        delay = microsecond_t(time_to_next_event);
+    }
+    return err;
+}
+
+
 uint8_t Gap::getMaxWhitelistSize(void) const
 {
     return _pal_gap.read_white_list_capacity();
@@ -915,6 +1088,10 @@ ble_error_t Gap::reset()
 #endif
 #if BLE_ROLE_OBSERVER
     _scan_timeout.detach();
+    _scan_batch_timeout.detach();
+    _scan_batch_count = 0;
+    _scan_batch_data_size = 0;
+    _scan_filter = ScanReportFilter();
 #endif
 
 #if BLE_FEATURE_EXTENDED_ADVERTISING
@@ -997,6 +1174,7 @@ void Gap::on_scan_timeout()
             )
         );
     } else {
+        flush_scan_batch();
         if (_event_handler) {
             _event_handler->onScanTimeout(ScanTimeoutEvent());
         }
@@ -1012,6 +1190,7 @@ void Gap::process_legacy_scan_timeout()
     set_random_address_rotation(false);
 #endif
 
+    flush_scan_batch();
     if (_event_handler) {
         _event_handler->onScanTimeout(ScanTimeoutEvent());
     }
@@ -1120,7 +1299,7 @@ void Gap::on_advertising_report(const GapAdvertisingReportEvent &e)
                     break;
             }
 
-            _event_handler->onAdvertisingReport(
+            deliver_advertising_report(
                 AdvertisingReportEvent(
                     advertising_event_t(event_type),
                     peer_address_type,
@@ -1256,6 +1435,12 @@ void Gap::on_connection_complete(const GapConnectionCompleteEvent &e)
         );
     }
 
+#if BLE_FEATURE_CONNECTABLE
+    if (_throughput_profile_enabled) {
+        start_throughput_profile(e);
+    }
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
     // Now starts pairing or authentication procedures if required
     if (needs_pairing) {
@@ -1273,6 +1458,13 @@ void Gap::on_connection_complete(const GapConnectionCompleteEvent &e)
 void Gap::on_disconnection_complete(const GapDisconnectionCompleteEvent &e)
 {
     if (e.status == hci_error_code_t::SUCCESS) {
+#if BLE_FEATURE_CONNECTABLE
+        throughput_link_t *link = get_throughput_link(e.connection_handle);
+        if (link) {
+            link->in_use = false;
+        }
+#endif // BLE_FEATURE_CONNECTABLE
+
         // signal internal stack
         if (_connection_event_handler) {
             _connection_event_handler->on_disconnected(
@@ -1328,20 +1520,135 @@ void Gap::on_connection_parameter_request(const GapRemoteConnectionParameterRequ
 
 void Gap::on_connection_update(const GapConnectionUpdateEvent &e)
 {
-    if (!_event_handler) {
+    if (_event_handler) {
+        _event_handler->onConnectionParametersUpdateComplete(
+            ConnectionParametersUpdateCompleteEvent(
+                e.status == hci_error_code_t::SUCCESS ? BLE_ERROR_NONE : BLE_ERROR_UNSPECIFIED,
+                e.connection_handle,
+                conn_interval_t(e.connection_interval),
+                e.connection_latency,
+                supervision_timeout_t(e.supervision_timeout)
+            )
+        );
+    }
+
+#if BLE_FEATURE_CONNECTABLE
+    throughput_link_t *link = get_throughput_link(e.connection_handle);
+    if (link && (link->pending & THROUGHPUT_PARAMETERS_PENDING)) {
+        if (e.status == hci_error_code_t::SUCCESS) {
+            link->connection_interval = e.connection_interval;
+        }
+        on_throughput_step_complete(link, THROUGHPUT_PARAMETERS_PENDING);
+    }
+#endif // BLE_FEATURE_CONNECTABLE
+}
+
+
+#if BLE_FEATURE_CONNECTABLE
+Gap::throughput_link_t *Gap::get_throughput_link(connection_handle_t connection)
+{
+    for (throughput_link_t &link : _throughput_links) {
+        if (link.in_use && link.handle == connection) {
+            return &link;
+        }
+    }
+    return nullptr;
+}
+
+
+void Gap::start_throughput_profile(const GapConnectionCompleteEvent &e)
+{
+    throughput_link_t *link = nullptr;
+    for (throughput_link_t &candidate : _throughput_links) {
+        if (!candidate.in_use) {
+            link = &candidate;
+            break;
+        }
+    }
+    if (!link) {
+        // The connection keeps the parameters it was established with
         return;
     }
 
-    _event_handler->onConnectionParametersUpdateComplete(
-        ConnectionParametersUpdateCompleteEvent(
-            e.status == hci_error_code_t::SUCCESS ? BLE_ERROR_NONE : BLE_ERROR_UNSPECIFIED,
+    link->handle = e.connection_handle;
+    link->connection_interval = e.connection_interval;
+    link->tx_size = 27;
+    link->rx_size = 27;
+    link->tx_phy = phy_t::LE_1M;
+    link->rx_phy = phy_t::LE_1M;
+    link->pending = 0;
+    link->in_use = true;
+
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION)) {
+        // Not awaited: there is no event when the peer keeps its length
+        _pal_gap.set_data_length(e.connection_handle, THROUGHPUT_TX_OCTETS, THROUGHPUT_TX_TIME);
+    }
+
+#if BLE_FEATURE_PHY_MANAGEMENT
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_2M_PHY)) {
+        phy_set_t phys(phy_t::LE_2M);
+        ble_error_t err = _pal_gap.set_phy(
             e.connection_handle,
-            conn_interval_t(e.connection_interval),
-            e.connection_latency,
+            phys,
+            phys,
+            coded_symbol_per_bit_t::UNDEFINED
+        );
+        if (err == BLE_ERROR_NONE) {
+            link->pending |= THROUGHPUT_PHY_PENDING;
+        }
+    }
+#endif // BLE_FEATURE_PHY_MANAGEMENT
+
+    if (e.connection_interval > BLE_GAP_THROUGHPUT_MAX_CONNECTION_INTERVAL) {
+        ble_error_t err = updateConnectionParameters(
+            e.connection_handle,
+            conn_interval_t(BLE_GAP_THROUGHPUT_MIN_CONNECTION_INTERVAL),
+            conn_interval_t(BLE_GAP_THROUGHPUT_MAX_CONNECTION_INTERVAL),
+            slave_latency_t(0),
             supervision_timeout_t(e.supervision_timeout)
-        )
-    );
+        );
+        if (err == BLE_ERROR_NONE) {
+            link->pending |= THROUGHPUT_PARAMETERS_PENDING;
+        }
+    }
+
+#if BLE_FEATURE_GATT_CLIENT
+    // The exchanged MTU is reported by GattClient::EventHandler::onAttMtuChange
+    createBLEInstance()->getGattClient().negotiateAttMtu(e.connection_handle);
+#endif // BLE_FEATURE_GATT_CLIENT
+
+    if (link->pending == 0) {
+        on_throughput_step_complete(link, 0);
+    }
+}
+
+
+void Gap::on_throughput_step_complete(throughput_link_t *link, uint8_t step)
+{
+    link->pending &= ~step;
+    if (link->pending) {
+        return;
+    }
+
+    // The data length changes negotiated later still reach onDataLengthChange
+    link->in_use = false;
+
+    if (_event_handler) {
+        _event_handler->onThroughputProfileComplete(
+            ThroughputProfileCompleteEvent(
+                link->handle,
+                link->tx_phy,
+                link->rx_phy,
+                link->tx_size,
+                link->rx_size,
+                conn_interval_t(link->connection_interval),
+                link_throughput(link->tx_phy, link->tx_size, link->rx_phy),
+                link_throughput(link->rx_phy, link->rx_size, link->tx_phy)
+            )
+        );
+    }
 }
+#endif // BLE_FEATURE_CONNECTABLE
 
 
 void Gap::on_unexpected_error(const GapUnexpectedErrorEvent &e)
@@ -2285,7 +2592,7 @@ void Gap::on_extended_advertising_report(
         return;
     }
 
-    _event_handler->onAdvertisingReport(
+    deliver_advertising_report(
         AdvertisingReportEvent(
             event_type,
             address_type ?
@@ -2425,19 +2732,45 @@ void Gap::on_connection_update_complete(
     uint16_t supervision_timeout
 )
 {
-    if (!_event_handler) {
-        return;
+    if (_event_handler) {
+        _event_handler->onConnectionParametersUpdateComplete(
+            ConnectionParametersUpdateCompleteEvent(
+                status == hci_error_code_t::SUCCESS ? BLE_ERROR_NONE : BLE_ERROR_UNSPECIFIED,
+                connection_handle,
+                conn_interval_t(connection_interval),
+                slave_latency_t(connection_latency),
+                supervision_timeout_t(supervision_timeout)
+            )
+        );
     }
 
-    _event_handler->onConnectionParametersUpdateComplete(
-        ConnectionParametersUpdateCompleteEvent(
-            status == hci_error_code_t::SUCCESS ? BLE_ERROR_NONE : BLE_ERROR_UNSPECIFIED,
-            connection_handle,
-            conn_interval_t(connection_interval),
-            slave_latency_t(connection_latency),
-            supervision_timeout_t(supervision_timeout)
-        )
-    );
+#if BLE_FEATURE_CONNECTABLE
+    throughput_link_t *link = get_throughput_link(connection_handle);
+    if (link && (link->pending & THROUGHPUT_PARAMETERS_PENDING)) {
+        if (status == hci_error_code_t::SUCCESS) {
+            link->connection_interval = connection_interval;
+        }
+        on_throughput_step_complete(link, THROUGHPUT_PARAMETERS_PENDING);
+    }
+#endif // BLE_FEATURE_CONNECTABLE
+}
+
+
+void Gap::on_connection_event(
+    connection_handle_t connection_handle,
+    uint16_t connection_interval,
+    uint32_t time_to_next_event
+)
+{
+    if (_event_handler) {
+        _event_handler->onConnectionEvent(
+            ConnectionEventNotificationEvent(
+                connection_handle,
+                conn_interval_t(connection_interval),
+                microsecond_t(time_to_next_event)
+            )
+        );
+    }
 }
 
 
@@ -2474,6 +2807,139 @@ void Gap::on_remote_connection_parameter(
 }
 
 
+ble_error_t Gap::setScanReportFilter(const ScanReportFilter &filter)
+{
+    // Deliver the reports batched under the previous filter
+    flush_scan_batch();
+    _scan_filter = filter;
+    return BLE_ERROR_NONE;
+}
+
+
+bool Gap::is_advertising_report_accepted(const AdvertisingReportEvent &report)
+{
+    if (report.getRssi() < _scan_filter.getMinimumRssi()) {
+        return false;
+    }
+
+    if (_scan_filter.isServiceUuidSet() &&
+        !is_service_advertised(report.getPayload(), _scan_filter.getServiceUuid())) {
+        return false;
+    }
+
+    if (_scan_filter.isManufacturerIdSet() &&
+        !is_manufacturer_advertised(report.getPayload(), _scan_filter.getManufacturerId())) {
+        return false;
+    }
+
+    if (_scan_filter.isDuplicateFilteringEnabled()) {
+        uint8_t header[] = {
+            report.getPeerAddressType().value(),
+            report.getType().connectable(),
+            report.getType().scannable_advertising(),
+            report.getType().directed_advertising(),
+            report.getType().scan_response(),
+            report.getType().legacy_advertising(),
+            report.getType().data_status().value()
+        };
+        uint32_t hash = fnv1a(2166136261UL, header, sizeof(header));
+        hash = fnv1a(hash, report.getPeerAddress().data(), report.getPeerAddress().size());
+        hash = fnv1a(hash, report.getPayload().data(), report.getPayload().size());
+        // 0 marks the free entries
+        if (hash == 0) {
+            hash = 1;
+        }
+
+        // Direct mapped: a collision forgets the previous report
+        uint32_t &entry = _scan_duplicates[hash % BLE_GAP_SCAN_DUPLICATE_TABLE_SIZE];
+        if (entry == hash) {
+            return false;
+        }
+        entry = hash;
+    }
+
+    return true;
+}
+
+
+void Gap::deliver_advertising_report(const AdvertisingReportEvent &report)
+{
+    if (!_event_handler || !is_advertising_report_accepted(report)) {
+        return;
+    }
+
+    uint8_t batch_size = std::min<uint8_t>(_scan_filter.getBatchSize(), BLE_GAP_SCAN_BATCH_MAX_REPORTS);
+    if (batch_size <= 1) {
+        _event_handler->onAdvertisingReport(report);
+        return;
+    }
+
+    Span<const uint8_t> payload = report.getPayload();
+    if (_scan_batch_data_size + payload.size() > BLE_GAP_SCAN_BATCH_BUFFER_SIZE) {
+        flush_scan_batch();
+    }
+    if (payload.size() > BLE_GAP_SCAN_BATCH_BUFFER_SIZE) {
+        // Too large to be held, it makes a batch on its own
+        _event_handler->onAdvertisingReports(Span<const AdvertisingReportEvent>(&report, 1));
+        return;
+    }
+
+    uint8_t *data = _scan_batch_data + _scan_batch_data_size;
+    memcpy(data, payload.data(), payload.size());
+    _scan_batch_data_size += payload.size();
+
+    new (_scan_batch + _scan_batch_count * sizeof(AdvertisingReportEvent)) AdvertisingReportEvent(
+        report.getType(),
+        report.getPeerAddressType(),
+        report.getPeerAddress(),
+        report.getPrimaryPhy(),
+        report.getSecondaryPhy(),
+        report.getSID(),
+        report.getTxPower(),
+        report.getRssi(),
+        report.getPeriodicInterval().value(),
+        report.getDirectAddressType(),
+        report.getDirectAddress(),
+        Span<const uint8_t>(data, payload.size())
+    );
+    _scan_batch_count++;
+
+    if (_scan_batch_count >= batch_size) {
+        flush_scan_batch();
+    } else if (_scan_batch_count == 1) {
+        _scan_batch_timeout.attach(
+            mbed::callback(this, &Gap::on_scan_batch_timeout),
+            std::chrono::milliseconds(BLE_GAP_SCAN_BATCH_TIMEOUT_MS)
+        );
+    }
+}
+
+
+void Gap::on_scan_batch_timeout()
+{
+    _event_queue.post(mbed::callback(this, &Gap::flush_scan_batch));
+}
+
+
+void Gap::flush_scan_batch()
+{
+    _scan_batch_timeout.detach();
+
+    uint8_t count = _scan_batch_count;
+    _scan_batch_count = 0;
+    _scan_batch_data_size = 0;
+
+    if (count && _event_handler) {
+        _event_handler->onAdvertisingReports(
+            Span<const AdvertisingReportEvent>(
+                reinterpret_cast<const AdvertisingReportEvent *>(_scan_batch),
+                count
+            )
+        );
+    }
+}
+
+
 ble_error_t Gap::setScanParameters(const ScanParameters &params)
 {
     if (is_extended_advertising_available()) {
@@ -2569,6 +3035,8 @@ ble_error_t Gap::startScan(
 
     _scan_enabled = true;
 
+    memset(_scan_duplicates, 0, sizeof(_scan_duplicates));
+
     return BLE_ERROR_NONE;
 }
 
@@ -41,6 +41,34 @@
 
 #include "ble/Gap.h"
 
+#ifndef BLE_GAP_SCAN_DUPLICATE_TABLE_SIZE
+#define BLE_GAP_SCAN_DUPLICATE_TABLE_SIZE 32
+#endif
+
+#ifndef BLE_GAP_SCAN_BATCH_MAX_REPORTS
+#define BLE_GAP_SCAN_BATCH_MAX_REPORTS 8
+#endif
+
+#ifndef BLE_GAP_SCAN_BATCH_BUFFER_SIZE
+#define BLE_GAP_SCAN_BATCH_BUFFER_SIZE 256
+#endif
+
+#ifndef BLE_GAP_SCAN_BATCH_TIMEOUT_MS
+#define BLE_GAP_SCAN_BATCH_TIMEOUT_MS 100
+#endif
+
+#ifndef BLE_GAP_THROUGHPUT_MAX_CONNECTIONS
+#define BLE_GAP_THROUGHPUT_MAX_CONNECTIONS 3
+#endif
+
+#ifndef BLE_GAP_THROUGHPUT_MIN_CONNECTION_INTERVAL
+#define BLE_GAP_THROUGHPUT_MIN_CONNECTION_INTERVAL 6
+#endif
+
+#ifndef BLE_GAP_THROUGHPUT_MAX_CONNECTION_INTERVAL
+#define BLE_GAP_THROUGHPUT_MAX_CONNECTION_INTERVAL 12
+#endif
+
 namespace ble {
 
 class PalGenericAccessService;
@@ -164,6 +192,8 @@ public:
 
     ble_error_t setScanParameters(const ScanParameters &params);
 
+    ble_error_t setScanReportFilter(const ScanReportFilter &filter);
+
     ble_error_t startScan(
         scan_duration_t duration = scan_duration_t::forever(),
         duplicates_filter_t filtering = duplicates_filter_t::DISABLE,
@@ -260,6 +290,18 @@ public:
         local_disconnection_reason_t reason
     );
 
+    ble_error_t setThroughputProfile(bool enable);
+
+    ble_error_t enableConnectionEventNotification(
+        connection_handle_t connection,
+        bool enable
+    );
+
+    ble_error_t getTimeToNextConnectionEvent(
+        connection_handle_t connection,
+        microsecond_t &delay
+    );
+
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
 
@@ -420,6 +462,45 @@ private:
 
     void prepare_legacy_advertising_set();
 
+    bool is_advertising_report_accepted(const AdvertisingReportEvent &report);
+
+    void deliver_advertising_report(const AdvertisingReportEvent &report);
+
+    void on_scan_batch_timeout();
+
+    void flush_scan_batch();
+
+#if BLE_FEATURE_CONNECTABLE
+    struct throughput_link_t {
+        throughput_link_t() :
+            handle(0),
+            connection_interval(0),
+            tx_size(0),
+            rx_size(0),
+            tx_phy(phy_t::LE_1M),
+            rx_phy(phy_t::LE_1M),
+            pending(0),
+            in_use(false)
+        {
+        }
+
+        connection_handle_t handle;
+        uint16_t connection_interval;
+        uint16_t tx_size;
+        uint16_t rx_size;
+        phy_t tx_phy;
+        phy_t rx_phy;
+        uint8_t pending;
+        bool in_use;
+    };
+
+    throughput_link_t *get_throughput_link(connection_handle_t connection);
+
+    void start_throughput_profile(const GapConnectionCompleteEvent &e);
+
+    void on_throughput_step_complete(throughput_link_t *link, uint8_t step);
+#endif // BLE_FEATURE_CONNECTABLE
+
     /* implements PalGap::EventHandler */
 private:
     void on_read_phy(
@@ -525,6 +606,12 @@ private:
 
     void on_scan_timeout() override;
 
+    void on_connection_event(
+        connection_handle_t connection_handle,
+        uint16_t connection_interval,
+        uint32_t time_to_next_event
+    ) override;
+
     void process_legacy_scan_timeout();
 
 private:
@@ -613,6 +700,19 @@ private:
     BitArray<BLE_GAP_MAX_ADVERTISING_SETS> _connectable_payload_size_exceeded;
     BitArray<BLE_GAP_MAX_ADVERTISING_SETS> _set_is_connectable;
 
+    ScanReportFilter _scan_filter;
+    uint32_t _scan_duplicates[BLE_GAP_SCAN_DUPLICATE_TABLE_SIZE];
+    alignas(AdvertisingReportEvent) uint8_t _scan_batch[BLE_GAP_SCAN_BATCH_MAX_REPORTS * sizeof(AdvertisingReportEvent)];
+    uint8_t _scan_batch_data[BLE_GAP_SCAN_BATCH_BUFFER_SIZE];
+    uint16_t _scan_batch_data_size;
+    uint8_t _scan_batch_count;
+    mbed::LowPowerTimeout _scan_batch_timeout;
+
+#if BLE_FEATURE_CONNECTABLE
+    throughput_link_t _throughput_links[BLE_GAP_THROUGHPUT_MAX_CONNECTIONS];
+    bool _throughput_profile_enabled;
+#endif // BLE_FEATURE_CONNECTABLE
+
     bool _user_manage_connection_parameter_requests : 1;
 };
 
@@ -1019,7 +1019,12 @@ GattClient::GattClient(PalGattClient &pal_client) :
     _signing_event_handler(nullptr),
 #endif
     control_blocks(nullptr),
-    _is_reseting(false)
+    _is_reseting(false),
+    _write_commands(),
+    _write_command_head(0),
+    _write_command_count(0),
+    _write_command_in_flight(false),
+    _write_command_queue_blocked(false)
 {
     _pal_client.when_server_message_received(
         mbed::callback(this, &GattClient::on_server_message_received)
@@ -1294,6 +1299,110 @@ ble_error_t GattClient::write(
 }
 
 
+ble_error_t GattClient::queueWriteCommand(
+    connection_handle_t connection_handle,
+    GattAttribute::Handle_t attribute_handle,
+    size_t length,
+    const uint8_t *value
+)
+{
+    if (_is_reseting) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    if (length > (uint16_t) (get_mtu(connection_handle) - WRITE_HEADER_LENGTH)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
+
+    if (_write_command_count == BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE) {
+        _write_command_queue_blocked = true;
+        return BLE_ERROR_NO_MEM;
+    }
+
+    uint8_t *data = nullptr;
+    if (length) {
+        data = (uint8_t *) malloc(length);
+        if (data == nullptr) {
+            return BLE_ERROR_NO_MEM;
+        }
+        memcpy(data, value, length);
+    }
+
+    uint8_t tail = (_write_command_head + _write_command_count) % BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE;
+    _write_commands[tail] = { connection_handle, attribute_handle, (uint16_t) length, data };
+    _write_command_count++;
+    if (_write_command_count == BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE) {
+        _write_command_queue_blocked = true;
+    }
+
+    send_queued_write_command();
+
+    return BLE_ERROR_NONE;
+}
+
+
+uint8_t GattClient::getWriteCommandQueueSpace() const
+{
+    return BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE - _write_command_count;
+}
+
+
+uint8_t GattClient::getAvailableTxBuffers() const
+{
+    return _pal_client.get_available_tx_buffers();
+}
+
+
+void GattClient::send_queued_write_command()
+{
+    // The stack refuses a write command to an attribute while the previous
+    // one waits for buffers: a single command is handed over at a time, the
+    // next one when on_write_command_sent reports it accepted.
+    while (_write_command_count && !_write_command_in_flight) {
+        QueuedWriteCommand &command = _write_commands[_write_command_head];
+
+        _write_command_in_flight = true;
+        ble_error_t err = _pal_client.write_without_response(
+            command.connection_handle,
+            command.attribute_handle,
+            make_const_Span(command.value, command.length)
+        );
+
+        // The stack has copied the value
+        free(command.value);
+        command.value = nullptr;
+
+        if (err) {
+            _write_command_in_flight = false;
+            _write_command_head = (_write_command_head + 1) % BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE;
+            _write_command_count--;
+
+            GattWriteCallbackParams response = {
+                command.connection_handle,
+                command.attribute_handle,
+                GattWriteCallbackParams::OP_WRITE_CMD,
+                err,
+                0
+            };
+            processWriteResponse(&response);
+        }
+    }
+}
+
+
+void GattClient::flush_write_command_queue()
+{
+    while (_write_command_count) {
+        free(_write_commands[_write_command_head].value);
+        _write_commands[_write_command_head].value = nullptr;
+        _write_command_head = (_write_command_head + 1) % BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE;
+        _write_command_count--;
+    }
+    _write_command_in_flight = false;
+    _write_command_queue_blocked = false;
+}
+
+
 void GattClient::onServiceDiscoveryTermination(
     ServiceDiscovery::TerminationCallback_t callback
 )
@@ -1412,6 +1521,7 @@ ble_error_t GattClient::reset()
     while (control_blocks) {
         control_blocks->abort(this);
     }
+    flush_write_command_queue();
     _is_reseting = false;
 
     return BLE_ERROR_NONE;
@@ -1454,6 +1564,26 @@ void GattClient::on_write_command_sent(
         status
     };
 
+    if (_write_command_in_flight &&
+        _write_commands[_write_command_head].connection_handle == connection_handle &&
+        _write_commands[_write_command_head].attribute_handle == attribute_handle
+    ) {
+        _write_command_in_flight = false;
+        _write_command_head = (_write_command_head + 1) % BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE;
+        _write_command_count--;
+
+        // Keep the stack fed before the application handles the event
+        send_queued_write_command();
+
+        uint8_t space = getWriteCommandQueueSpace();
+        if (_write_command_queue_blocked && space >= (BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE + 1) / 2) {
+            _write_command_queue_blocked = false;
+            if (eventHandler) {
+                eventHandler->onWriteCommandQueueReady(connection_handle, space);
+            }
+        }
+    }
+
     this->processWriteResponse(&response);
 }
 
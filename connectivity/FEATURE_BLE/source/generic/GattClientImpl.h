@@ -33,6 +33,10 @@
 #include "source/pal/PalSigningMonitor.h"
 #include "ble/GattClient.h"
 
+#ifndef BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE
+#define BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE 8
+#endif
+
 namespace ble {
 
 class BLEInstanceBase;
@@ -97,6 +101,17 @@ public:
         const uint8_t *value
     ) const;
 
+    ble_error_t queueWriteCommand(
+        ble::connection_handle_t connHandle,
+        GattAttribute::Handle_t attributeHandle,
+        size_t length,
+        const uint8_t *value
+    );
+
+    uint8_t getWriteCommandQueueSpace() const;
+
+    uint8_t getAvailableTxBuffers() const;
+
     /* Event callback handlers. */
 
     void onDataRead(ReadCallback_t callback);
@@ -212,7 +227,21 @@ private:
 
     uint16_t get_mtu(connection_handle_t connection) const;
 
+    void send_queued_write_command();
+
+    void flush_write_command_queue();
+
 private:
+    /**
+     * Write command waiting for the stack to accept the previous one.
+     */
+    struct QueuedWriteCommand {
+        connection_handle_t connection_handle;
+        attribute_handle_t attribute_handle;
+        uint16_t length;
+        uint8_t *value;
+    };
+
     /**
      * Event handler provided by the application.
      */
@@ -248,6 +277,12 @@ private:
     mutable ProcedureControlBlock *control_blocks;
     bool _is_reseting;
 
+    QueuedWriteCommand _write_commands[BLE_GATT_CLIENT_WRITE_COMMAND_QUEUE_SIZE];
+    uint8_t _write_command_head;
+    uint8_t _write_command_count;
+    bool _write_command_in_flight;
+    bool _write_command_queue_blocked;
+
 private:
     /**
      * Create a PalGattClient from a PalGattClient
@@ -52,11 +52,16 @@ constexpr char KVStoreSecurityDb::DB_RESTORE[DB_KEY_SIZE];
 typedef SecurityDb::entry_handle_t entry_handle_t;
 
 KVStoreSecurityDb::KVStoreSecurityDb()
-    : SecurityDb() {
+    : SecurityDb(), _dirty_identities(0) {
     memset(_entries, 0, sizeof(_entries));
+    memset(_identities, 0, sizeof(_identities));
+    /* each entry owns the keys with its index */
     for (size_t i = 0; i < get_entry_count(); i++) {
-        _entries[i].index = ENTRY_INVALID;
+        _entries[i].index = i;
     }
+    _pending.index = ENTRY_INVALID;
+    _pending.loaded = 0;
+    _pending.dirty = 0;
 }
 
 KVStoreSecurityDb::~KVStoreSecurityDb()
@@ -141,10 +146,9 @@ void KVStoreSecurityDb::set_entry_local_ltk(
 
     entry->flags.ltk_sent = true;
 
-    SecurityEntryKeys_t* current_entry = read_in_entry_local_keys(db_handle);
-    current_entry->ltk = ltk;
-
-    db_write_entry(current_entry, DB_ENTRY_LOCAL_KEYS, entry->index);
+    pending_t* pending = get_pending(entry, RECORD_LOCAL_KEYS);
+    pending->local_keys.ltk = ltk;
+    pending->dirty |= RECORD_LOCAL_KEYS;
 }
 
 void KVStoreSecurityDb::set_entry_local_ediv_rand(
@@ -158,11 +162,10 @@ void KVStoreSecurityDb::set_entry_local_ediv_rand(
         return;
     }
 
-    SecurityEntryKeys_t* current_entry = read_in_entry_local_keys(db_handle);
-    current_entry->ediv = ediv;
-    current_entry->rand = rand;
-
-    db_write_entry(current_entry, DB_ENTRY_LOCAL_KEYS, entry->index);
+    pending_t* pending = get_pending(entry, RECORD_LOCAL_KEYS);
+    pending->local_keys.ediv = ediv;
+    pending->local_keys.rand = rand;
+    pending->dirty |= RECORD_LOCAL_KEYS;
 }
 
 /* peer's keys */
@@ -181,10 +184,9 @@ void KVStoreSecurityDb::set_entry_peer_ltk(
 
     entry->flags.ltk_stored = true;
 
-    SecurityEntryKeys_t* current_entry = read_in_entry_peer_keys(db_handle);
-    current_entry->ltk = ltk;
-
-    db_write_entry(current_entry, DB_ENTRY_PEER_KEYS, entry->index);
+    pending_t* pending = get_pending(entry, RECORD_PEER_KEYS);
+    pending->peer_keys.ltk = ltk;
+    pending->dirty |= RECORD_PEER_KEYS;
 }
 
 void KVStoreSecurityDb::set_entry_peer_ediv_rand(
@@ -198,11 +200,10 @@ void KVStoreSecurityDb::set_entry_peer_ediv_rand(
         return;
     }
 
-    SecurityEntryKeys_t* current_entry = read_in_entry_peer_keys(db_handle);
-    current_entry->ediv = ediv;
-    current_entry->rand = rand;
-
-    db_write_entry(current_entry, DB_ENTRY_PEER_KEYS, entry->index);
+    pending_t* pending = get_pending(entry, RECORD_PEER_KEYS);
+    pending->peer_keys.ediv = ediv;
+    pending->peer_keys.rand = rand;
+    pending->dirty |= RECORD_PEER_KEYS;
 }
 
 void KVStoreSecurityDb::set_entry_peer_irk(
@@ -217,10 +218,8 @@ void KVStoreSecurityDb::set_entry_peer_irk(
 
     entry->flags.irk_stored = true;
 
-    SecurityEntryIdentity_t* current_entry = read_in_entry_peer_identity(db_handle);
-    current_entry->irk = irk;
-
-    db_write_entry(current_entry, DB_ENTRY_PEER_IDENTITY, entry->index);
+    _identities[entry->index].irk = irk;
+    _dirty_identities |= 1 << entry->index;
 }
 
 void KVStoreSecurityDb::set_entry_peer_bdaddr(
@@ -234,11 +233,10 @@ void KVStoreSecurityDb::set_entry_peer_bdaddr(
         return;
     }
 
-    SecurityEntryIdentity_t* current_entry = read_in_entry_peer_identity(db_handle);
-    current_entry->identity_address = peer_address;
-    current_entry->identity_address_is_public = address_is_public;
-
-    db_write_entry(current_entry, DB_ENTRY_PEER_IDENTITY, entry->index);
+    SecurityEntryIdentity_t* identity = &_identities[entry->index];
+    identity->identity_address = peer_address;
+    identity->identity_address_is_public = address_is_public;
+    _dirty_identities |= 1 << entry->index;
 }
 
 void KVStoreSecurityDb::set_entry_peer_csrk(
@@ -253,10 +251,9 @@ void KVStoreSecurityDb::set_entry_peer_csrk(
 
     entry->flags.csrk_stored = true;
 
-    SecurityEntrySigning_t* current_entry = read_in_entry_peer_signing(db_handle);
-    current_entry->csrk = csrk;
-
-    db_write_entry(current_entry, DB_ENTRY_PEER_SIGNING, entry->index);
+    pending_t* pending = get_pending(entry, RECORD_PEER_SIGNING);
+    pending->peer_signing.csrk = csrk;
+    pending->dirty |= RECORD_PEER_SIGNING;
 }
 
 void KVStoreSecurityDb::set_entry_peer_sign_counter(
@@ -305,6 +302,13 @@ void KVStoreSecurityDb::restore()
     db_read(&_local_identity, DB_LOCAL_IDENTITY);
     db_read(&_local_csrk, DB_LOCAL_CSRK);
     db_read(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+
+    for (size_t i = 0; i < get_entry_count(); i++) {
+        _entries[i].index = i;
+        db_read_entry(&_identities[i], DB_ENTRY_PEER_IDENTITY, i);
+    }
+    _dirty_identities = 0;
+    _pending.index = ENTRY_INVALID;
 }
 
 void KVStoreSecurityDb::sync(entry_handle_t db_handle)
@@ -314,11 +318,7 @@ void KVStoreSecurityDb::sync(entry_handle_t db_handle)
         return;
     }
 
-    /* all entries are stored in a single key so we store them all*/
-    db_write(&_entries, DB_ENTRIES);
-    db_write(&_local_identity, DB_LOCAL_IDENTITY);
-    db_write(&_local_csrk, DB_LOCAL_CSRK);
-    db_write(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+    flush();
 }
 
 void KVStoreSecurityDb::set_restore(bool reload)
@@ -326,6 +326,12 @@ void KVStoreSecurityDb::set_restore(bool reload)
     db_write(&reload, DB_RESTORE);
 }
 
+void KVStoreSecurityDb::clear_entries()
+{
+    this->SecurityDb::clear_entries();
+    flush();
+}
+
 /* helper functions */
 
 uint8_t KVStoreSecurityDb::get_entry_count()
@@ -349,16 +355,16 @@ void KVStoreSecurityDb::reset_entry(entry_handle_t db_handle)
         return;
     }
 
-    if (entry->index != ENTRY_INVALID) {
-        uint8_t zero_buffer[sizeof(SecurityEntryKeys_t)] = {0};
+    /* the zeroed records are written with the entry, no need to read them in */
+    pending_t* pending = get_pending(entry, 0);
+    memset(&pending->local_keys, 0, sizeof(pending->local_keys));
+    memset(&pending->peer_keys, 0, sizeof(pending->peer_keys));
+    memset(&pending->peer_signing, 0, sizeof(pending->peer_signing));
+    pending->loaded = RECORD_LOCAL_KEYS | RECORD_PEER_KEYS | RECORD_PEER_SIGNING;
+    pending->dirty = pending->loaded;
 
-        db_write_entry((SecurityEntryKeys_t*)zero_buffer, DB_ENTRY_LOCAL_KEYS, entry->index);
-        db_write_entry((SecurityEntryIdentity_t*)zero_buffer, DB_ENTRY_PEER_IDENTITY, entry->index);
-        db_write_entry((SecurityEntryKeys_t*)zero_buffer, DB_ENTRY_PEER_KEYS, entry->index);
-        db_write_entry((SecurityEntrySigning_t*)zero_buffer, DB_ENTRY_PEER_SIGNING, entry->index);
-
-        entry->index = ENTRY_INVALID;
-    }
+    memset(&_identities[entry->index], 0, sizeof(SecurityEntryIdentity_t));
+    _dirty_identities |= 1 << entry->index;
 
     entry->flags = SecurityDistributionFlags_t();
     entry->peer_sign_counter = 0;
@@ -371,10 +377,7 @@ SecurityEntryIdentity_t* KVStoreSecurityDb::read_in_entry_peer_identity(entry_ha
         return nullptr;
     }
 
-    SecurityEntryIdentity_t* identity = reinterpret_cast<SecurityEntryIdentity_t*>(_buffer);
-    db_read_entry(identity, DB_ENTRY_PEER_IDENTITY, entry->index);
-
-    return identity;
+    return &_identities[entry->index];
 };
 
 SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_peer_keys(entry_handle_t db_handle)
@@ -384,10 +387,7 @@ SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_peer_keys(entry_handle_t d
         return nullptr;
     }
 
-    SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
-    db_read_entry(keys, DB_ENTRY_PEER_KEYS, entry->index);
-
-    return keys;
+    return &get_pending(entry, RECORD_PEER_KEYS)->peer_keys;
 };
 
 SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_local_keys(entry_handle_t db_handle)
@@ -397,10 +397,7 @@ SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_local_keys(entry_handle_t
         return nullptr;
     }
 
-    SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
-    db_read_entry(keys, DB_ENTRY_LOCAL_KEYS, entry->index);
-
-    return keys;
+    return &get_pending(entry, RECORD_LOCAL_KEYS)->local_keys;
 };
 
 SecurityEntrySigning_t* KVStoreSecurityDb::read_in_entry_peer_signing(entry_handle_t db_handle)
@@ -410,18 +407,76 @@ SecurityEntrySigning_t* KVStoreSecurityDb::read_in_entry_peer_signing(entry_hand
         return nullptr;
     }
 
-    /* only read in the csrk */
-    csrk_t* csrk = reinterpret_cast<csrk_t*>(_buffer);
-    db_read_entry(csrk, DB_ENTRY_PEER_SIGNING, entry->index);
-
+    pending_t* pending = get_pending(entry, RECORD_PEER_SIGNING);
 
     /* use the counter held in memory */
     SecurityEntrySigning_t* signing = reinterpret_cast<SecurityEntrySigning_t*>(_buffer);
+    signing->csrk = pending->peer_signing.csrk;
     signing->counter = entry->peer_sign_counter;
 
     return signing;
 };
 
+KVStoreSecurityDb::pending_t* KVStoreSecurityDb::get_pending(entry_t *entry, uint8_t records)
+{
+    if (_pending.index != entry->index) {
+        flush_pending();
+        _pending.index = entry->index;
+        _pending.loaded = 0;
+    }
+
+    records &= ~_pending.loaded;
+    if (records & RECORD_LOCAL_KEYS) {
+        db_read_entry(&_pending.local_keys, DB_ENTRY_LOCAL_KEYS, entry->index);
+    }
+    if (records & RECORD_PEER_KEYS) {
+        db_read_entry(&_pending.peer_keys, DB_ENTRY_PEER_KEYS, entry->index);
+    }
+    if (records & RECORD_PEER_SIGNING) {
+        /* only read in the csrk */
+        db_read_entry(&_pending.peer_signing.csrk, DB_ENTRY_PEER_SIGNING, entry->index);
+    }
+    _pending.loaded |= records;
+
+    return &_pending;
+}
+
+void KVStoreSecurityDb::flush_pending()
+{
+    if (_pending.index == ENTRY_INVALID) {
+        return;
+    }
+
+    if (_pending.dirty & RECORD_LOCAL_KEYS) {
+        db_write_entry(&_pending.local_keys, DB_ENTRY_LOCAL_KEYS, _pending.index);
+    }
+    if (_pending.dirty & RECORD_PEER_KEYS) {
+        db_write_entry(&_pending.peer_keys, DB_ENTRY_PEER_KEYS, _pending.index);
+    }
+    if (_pending.dirty & RECORD_PEER_SIGNING) {
+        db_write_entry(&_pending.peer_signing, DB_ENTRY_PEER_SIGNING, _pending.index);
+    }
+    _pending.dirty = 0;
+}
+
+void KVStoreSecurityDb::flush()
+{
+    flush_pending();
+
+    for (size_t i = 0; i < get_entry_count(); i++) {
+        if (_dirty_identities & (1 << i)) {
+            db_write_entry(&_identities[i], DB_ENTRY_PEER_IDENTITY, i);
+        }
+    }
+    _dirty_identities = 0;
+
+    /* all entries are stored in a single key so we store them all*/
+    db_write(&_entries, DB_ENTRIES);
+    db_write(&_local_identity, DB_LOCAL_IDENTITY);
+    db_write(&_local_csrk, DB_LOCAL_CSRK);
+    db_write(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+}
+
 } /* namespace generic */
 
 #endif // BLE_SECURITY_DATABASE_KVSTORE
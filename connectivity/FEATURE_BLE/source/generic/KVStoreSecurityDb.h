@@ -41,7 +41,25 @@ private:
         uint8_t index;
     };
 
-    static constexpr uint8_t KVSTORESECURITYDB_VERSION = 1;
+    /* records of an entry, each stored in its own key */
+    enum record_t : uint8_t {
+        RECORD_LOCAL_KEYS = 1 << 0,
+        RECORD_PEER_KEYS = 1 << 1,
+        RECORD_PEER_SIGNING = 1 << 2
+    };
+
+    /* write-back cache of the records of the last entry accessed, so the
+     * keys distributed during pairing cost one write per record */
+    struct pending_t {
+        SecurityEntryKeys_t local_keys;
+        SecurityEntryKeys_t peer_keys;
+        SecurityEntrySigning_t peer_signing;
+        uint8_t index;
+        uint8_t loaded;
+        uint8_t dirty;
+    };
+
+    static constexpr uint8_t KVSTORESECURITYDB_VERSION = 2;
 
     static constexpr size_t DB_PREFIX_SIZE = 7 + sizeof (STR(MBED_CONF_STORAGE_DEFAULT_KV)) - 1;
     static constexpr size_t DB_KEY_SIZE = 3;
@@ -207,6 +225,8 @@ public:
 
     virtual void set_restore(bool reload);
 
+    virtual void clear_entries();
+
 private:
     virtual uint8_t get_entry_count();
 
@@ -225,8 +245,32 @@ private:
      */
     static bool erase_db();
 
+    /**
+     * Get the cached records of an entry, reading them in if needed.
+     * @param entry entry accessed, the records of another entry are flushed
+     * @param records records read in, combination of record_t
+     * @return the write-back cache
+     */
+    pending_t* get_pending(entry_t *entry, uint8_t records);
+
+    /**
+     * Write the records modified in the write-back cache.
+     */
+    void flush_pending();
+
+    /**
+     * Write the cached records, identities and entries modified.
+     */
+    void flush();
+
 private:
     entry_t _entries[BLE_SECURITY_DATABASE_MAX_ENTRIES];
+    /* identities of the peers, kept in RAM so looking up a peer by its
+     * address or listing the IRKs never reads the store */
+    SecurityEntryIdentity_t _identities[BLE_SECURITY_DATABASE_MAX_ENTRIES];
+    /* bit n set when the identity of entry n must be written */
+    uint16_t _dirty_identities;
+    pending_t _pending;
     uint8_t _buffer[sizeof(SecurityEntryKeys_t)];
 };
 
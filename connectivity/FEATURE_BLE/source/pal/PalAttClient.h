@@ -598,6 +598,16 @@ public:
         bool execute
     ) = 0;
 
+    /**
+     * Get the number of ACL data packets the controller can accept now.
+     *
+     * Packets sent while it is 0 wait in the host until the controller
+     * reports completed packets.
+     *
+     * @return The number of free ACL data buffers of the controller.
+     */
+    virtual uint8_t get_available_tx_buffers() = 0;
+
     /**
      * Register a callback which will handle messages from the server.
      *
@@ -199,6 +199,12 @@ ble_error_t PalAttClientToGattClient::signed_write_without_response(
 }
 
 
+uint8_t PalAttClientToGattClient::get_available_tx_buffers()
+{
+    return _client.get_available_tx_buffers();
+}
+
+
 ble_error_t PalAttClientToGattClient::write_attribute(
     connection_handle_t connection_handle,
     attribute_handle_t attribute_handle,
@@ -150,6 +150,11 @@ public:
         const Span<const uint8_t>& value
     ) override;
 
+    /**
+     * @see ble::PalGattClient::get_available_tx_buffers
+     */
+    uint8_t get_available_tx_buffers() override;
+
     /**
      * @see ble::PalGattClient::write_attribute
      */
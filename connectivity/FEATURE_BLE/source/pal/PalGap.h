@@ -239,6 +239,22 @@ public:
         uint16_t connection_latency,
         uint16_t supervision_timeout
      ) = 0;
+
+    /** Called after a connection event observed on a connection for which
+     * the notification has been enabled.
+     *
+     * @param connection_handle Handle of the connection.
+     * @param connection_interval Connection interval in units of 1.25ms.
+     * @param time_to_next_event Microseconds left until the next connection
+     * event.
+     *
+     * @see PalGap::set_connection_event_notification
+     */
+    virtual void on_connection_event(
+        connection_handle_t connection_handle,
+        uint16_t connection_interval,
+        uint32_t time_to_next_event
+     ) = 0;
 };
 
 /**
@@ -1603,6 +1619,63 @@ public:
         coded_symbol_per_bit_t coded_symbol
     ) = 0;
 
+    /**
+     * Suggest to the controller the maximum payload and transmission time of
+     * the link layer packets sent on a connection.
+     *
+     * The negotiation result, if the length changes, is reported by
+     * PalGapEventHandler::on_data_length_change.
+     *
+     * @param connection Handle of the connection to update.
+     * @param tx_octets Maximum payload of the packets sent, in [27 : 251].
+     * @param tx_time Maximum time to send a packet in microseconds, in
+     * [328 : 17040].
+     *
+     * @return BLE_ERROR_NONE if the request has been sent to the controller.
+     */
+    virtual ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) = 0;
+
+    /**
+     * Report the connection events observed on a connection through
+     * PalGapEventHandler::on_connection_event.
+     *
+     * Connection events are observed through the packets the controller
+     * receives or acknowledges on the connection.
+     *
+     * @param connection Handle of the connection.
+     * @param enable True to report the connection events.
+     *
+     * @return BLE_ERROR_NONE in case of success, BLE_ERROR_INVALID_PARAM if
+     * the connection does not exist.
+     */
+    virtual ble_error_t set_connection_event_notification(
+        connection_handle_t connection,
+        bool enable
+    ) = 0;
+
+    /**
+     * Predict the next connection event of a connection from the last one
+     * observed.
+     *
+     * @param connection Handle of the connection.
+     * @param connection_interval Connection interval in units of 1.25ms.
+     * @param time_to_next_event Microseconds left until the next connection
+     * event.
+     *
+     * @return BLE_ERROR_NONE in case of success, BLE_ERROR_INVALID_PARAM if
+     * the connection does not exist or BLE_ERROR_INVALID_STATE if no
+     * connection event has been observed yet.
+     */
+    virtual ble_error_t get_next_connection_event(
+        connection_handle_t connection,
+        uint16_t &connection_interval,
+        uint32_t &time_to_next_event
+    ) = 0;
+
     /**
      * Register a callback which will handle PalGap events.
      *
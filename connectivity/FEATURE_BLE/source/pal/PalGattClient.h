@@ -495,6 +495,13 @@ public:
         const Span<const uint8_t>& value
     ) = 0;
 
+    /**
+     * Get the number of ACL data packets the controller can accept now.
+     *
+     * @return The number of free ACL data buffers of the controller.
+     */
+    virtual uint8_t get_available_tx_buffers() = 0;
+
     /**
      * Send a write request to the server.
      *
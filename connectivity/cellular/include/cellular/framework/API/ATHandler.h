@@ -51,6 +51,7 @@ extern const char *OK;
 extern const char *CRLF;
 
 #define BUFF_SIZE 32
+#define AT_RESP_QUEUE_MAX 4
 
 /* AT Error types enumeration */
 enum DeviceErrorType {
@@ -98,6 +99,13 @@ public:
      */
     FileHandle *get_file_handle();
 
+    /** Changes the file handle, for example to a channel of CellularMux.
+     *  The receiving buffer is emptied and the queued responses are dropped.
+     *
+     *  @param fh file handle of the modem
+     */
+    void set_file_handle(FileHandle *fh);
+
     /** Locks the mutex for file handle if AT_HANDLER_MUTEX is defined.
      */
     void lock();
@@ -189,6 +197,13 @@ public:
      */
     void set_send_delay(uint16_t send_delay);
 
+    /** Sets how many commands can be sent before their responses are read, see resp_queue().
+     *  Queued responses are read first.
+     *
+     *  @param depth number of queued responses the modem accepts, at most AT_RESP_QUEUE_MAX. 0 to not pipeline.
+     */
+    void set_resp_queue_depth(uint8_t depth);
+
     /** Sets BufferedSerial filehandle to given baud rate
      *
      *  @param baud_rate
@@ -385,6 +400,22 @@ public:
      */
     void resp_stop();
 
+    /**  Queues the response of the command just sent, so that the next commands can be sent
+     *   before it is read (pipelining).
+     *
+     *   The handler reads the response with resp_start() and resp_stop(), as is done after cmd_stop().
+     *   Queued responses are read in order by the resp_start() of a command that isn't queued,
+     *   by flush(), by processing the URCs or once the queue is full. Errors in a queued response
+     *   are seen by its handler only. With a queue depth of 0, or after an error, the handler is called at once.
+     *
+     *  @param handler reads the response, called with the ATHandler locked
+     */
+    void resp_queue(Callback<void()> handler);
+
+    /**  Reads all the queued responses, see resp_queue().
+     */
+    void resp_queue_flush();
+
     /**  Looks for matching the prefix given to resp_start() call.
      *   If needed, it ends the scope of a previous information response.
      *   Sets the information response scope if new prefix is found and response scope if prefix is not found.
@@ -443,6 +474,7 @@ private: //Private structs & enums
     struct oob_t {
         const char *prefix;
         int prefix_len;
+        uint32_t prefix_hash;
         Callback<void()> cb;
         oob_t *next;
     };
@@ -509,14 +541,17 @@ private: //Private functions
     // Returns 0 or time in ms for polling.
     int poll_timeout(bool wait_for_timeout = true);
     // Reads from serial to receiving buffer.
+    // Rewinds the buffer first if that makes more room than is left after the unread content.
     // Returns true on successful read OR false on timeout.
     bool fill_buffer(bool wait_for_timeout = true);
+    // Reads the oldest queued response.
+    void read_queued_resp();
 
     void set_tag(tag_t *tag_dest, const char *tag_seq);
 
-    // Rewinds the receiving buffer and compares it against given str.
+    // Compares the unread content of the receiving buffer against given str.
     bool match(const char *str, size_t size);
-    // Iterates URCs and checks if they match the receiving buffer content.
+    // Looks up the URC with the longest prefix matching the receiving buffer content.
     // If URC match sets the scope to information response and after urc's cb returns
     // finishes the information response scope(consumes to CRLF).
     bool match_urc();
@@ -590,6 +625,7 @@ private: //Member variables
     uint16_t _oob_string_max_length;
     char *_output_delimiter;
 
+    // sorted by prefix length
     oob_t *_oobs;
     mbed::chrono::milliseconds_u32 _at_timeout;
     mbed::chrono::milliseconds_u32 _previous_at_timeout;
@@ -641,6 +677,14 @@ private: //Member variables
     int _event_id;
 
     char _cmd_buffer[BUFF_SIZE];
+
+    // handlers of the queued responses, the oldest at _resp_queue_head
+    Callback<void()> _resp_queue[AT_RESP_QUEUE_MAX];
+    uint8_t _resp_queue_depth;
+    uint8_t _resp_queue_head;
+    uint8_t _resp_queue_count;
+    // set while a queued response is read
+    bool _resp_queue_reading;
 };
 
 } // namespace mbed
@@ -27,6 +27,7 @@ class AT_CellularInformation;
 class AT_CellularNetwork;
 class AT_CellularSMS;
 class AT_CellularContext;
+class CellularMux;
 class FileHandle;
 
 /**
@@ -63,6 +64,8 @@ public:
         PROPERTY_IP_TCP,                // 0 = not supported, 1 = supported. Modem IP stack has support for TCP
         PROPERTY_IP_UDP,                // 0 = not supported, 1 = supported. Modem IP stack has support for TCP
         PROPERTY_AT_SEND_DELAY,         // Sending delay between AT commands in ms
+        PROPERTY_AT_PIPELINE_DEPTH,     // Number of AT commands that can be sent before their responses are read, 0 = no pipelining
+        PROPERTY_AT_CMUX,               // 0 = not supported, 1 = supported. 3GPP TS 27.010 multiplexing with AT+CMUX=0
         PROPERTY_MAX
     };
 
@@ -135,6 +138,27 @@ public:
      */
     void set_cellular_properties(const intptr_t *property_array);
 
+    /** Switches the modem to 3GPP TS 27.010 multiplexing with AT+CMUX.
+     *  AT commands then run on channel 1 and the other channels carry binary data,
+     *  such as PPP or the transparent sockets of the modem, see get_mux_channel().
+     *
+     *  @return NSAPI_ERROR_OK on success
+     *          NSAPI_ERROR_UNSUPPORTED if the modem doesn't support PROPERTY_AT_CMUX
+     *          otherwise the error of AT+CMUX or of CellularMux::open()
+     */
+    nsapi_error_t start_mux();
+
+    /** Closes the multiplexer, AT commands run on the serial line again.
+     */
+    void stop_mux();
+
+    /** Gets a data channel of the multiplexer
+     *
+     *  @param dlci channel number, 2 to MBED_CONF_CELLULAR_MUX_CHANNELS
+     *  @return     channel, or NULL if the multiplexer isn't started or there is no such data channel
+     */
+    FileHandle *get_mux_channel(uint8_t dlci);
+
 protected:
     /** Creates new instance of AT_CellularContext or if overridden, modem specific implementation.
      *
@@ -196,6 +220,7 @@ private:
     AT_CellularNetwork *_network;
     AT_CellularInformation *_information;
     AT_CellularContext *_context_list;
+    CellularMux *_mux;
 
     std::chrono::duration<int, std::milli> _default_timeout;
     bool _modem_debug_on;
@@ -104,7 +104,8 @@ protected:
             tx_ready(false),
             tls_socket(false),
             pending_bytes(0),
-            txfull_event(false)
+            txfull_event(false),
+            send_error(NSAPI_ERROR_OK)
         {
         }
         // Socket identifier, generally it will be the socket ID assigned by the
@@ -123,6 +124,7 @@ protected:
         bool tls_socket; // socket uses modem's internal TLS socket functionality
         nsapi_size_t pending_bytes; // The number of received bytes pending
         bool txfull_event; // socket event after wouldblock
+        nsapi_error_t send_error; // error in the response of a pipelined send, returned by the next send
     };
 
     /**
@@ -152,6 +154,16 @@ protected:
     virtual nsapi_size_or_error_t socket_sendto_impl(CellularSocket *socket, const SocketAddress &address,
                                                      const void *data, nsapi_size_t size) = 0;
 
+    /**
+    * Reads the response of the send command written by socket_sendto_impl(), with resp_start()
+    * and resp_stop(). If the modem accepts pipelined AT commands, see PROPERTY_AT_PIPELINE_DEPTH,
+    * the response is queued and read later instead, so that the next send doesn't wait for it.
+    * An error in a queued response is returned by the next send on the socket.
+    *
+    * @param socket   Cellular socket handle
+    */
+    void socket_sendto_resp(CellularSocket *socket);
+
     /**
      *  Implements modem specific AT command set for receiving data
      *
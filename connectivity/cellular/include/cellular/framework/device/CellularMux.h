@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CELLULAR_MUX_H_
+#define CELLULAR_MUX_H_
+
+#include "platform/FileHandle.h"
+#include "platform/CircularBuffer.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "netsocket/nsapi_types.h"
+
+namespace mbed {
+
+// Maximum size of the information field, the default N1 of AT+CMUX
+#define CELLULAR_MUX_FRAME_SIZE 31
+
+/** CellularMux class
+ *
+ *  3GPP TS 27.010 multiplexer, basic option. Once the modem has been switched
+ *  to multiplexing with AT+CMUX=0, the serial line carries several channels:
+ *  AT commands on one of them and binary data, such as PPP or a transparent socket,
+ *  on the others, without the hex encoding of the AT socket commands.
+ *
+ *  Each channel is a FileHandle that can be given to ATHandler or to a PPP interface.
+ *  The serial line is read when a channel is read or polled, the frames received
+ *  are then dispatched to the channels.
+ *
+ *  @note Flow control (MSC, FCon/FCoff) requests from the modem are acknowledged but not acted on.
+ */
+class CellularMux : private NonCopyable<CellularMux> {
+public:
+    /** Channel of the multiplexer, DLCI 1 to MBED_CONF_CELLULAR_MUX_CHANNELS
+     */
+    class Channel : public FileHandle {
+    public:
+        Channel();
+
+        ssize_t read(void *buffer, size_t size) override;
+        ssize_t write(const void *buffer, size_t size) override;
+        off_t seek(off_t offset, int whence = SEEK_SET) override;
+        int close() override;
+        int set_blocking(bool blocking) override;
+        bool is_blocking() const override;
+        short poll(short events) const override;
+        bool poll_notifies() const override;
+        void sigio(Callback<void()> func) override;
+
+    private:
+        friend class CellularMux;
+
+        CellularMux *_mux;
+        uint8_t _dlci;
+        bool _open;
+        bool _blocking;
+        Callback<void()> _sigio_cb;
+        CircularBuffer<uint8_t, MBED_CONF_CELLULAR_MUX_BUFFER_SIZE> _rx;
+    };
+
+    /** Constructor
+     *
+     *  @param fh   serial line to the modem, already switched to multiplexing
+     */
+    CellularMux(FileHandle *fh);
+    ~CellularMux();
+
+    /** Opens the control channel and the channels, DLCI 0 to MBED_CONF_CELLULAR_MUX_CHANNELS
+     *
+     *  @return NSAPI_ERROR_OK on success
+     *          NSAPI_ERROR_TIMEOUT if the modem doesn't answer
+     *          NSAPI_ERROR_DEVICE_ERROR if the modem refuses a channel
+     */
+    nsapi_error_t open();
+
+    /** Closes the channels and the multiplexer, the modem goes back to AT commands on the serial line
+     */
+    void close();
+
+    /** Gets a channel
+     *
+     *  @param dlci  channel number, 1 to MBED_CONF_CELLULAR_MUX_CHANNELS
+     *  @return      channel, or NULL if there is no such channel
+     */
+    FileHandle *get_channel(uint8_t dlci);
+
+    /** Gets the serial line
+     *
+     *  @return      serial line to the modem
+     */
+    FileHandle *get_file_handle();
+
+private:
+    enum RxState {
+        RX_FLAG,
+        RX_ADDRESS,
+        RX_CONTROL,
+        RX_LENGTH,
+        RX_LENGTH2,
+        RX_INFO,
+        RX_FCS,
+        RX_END
+    };
+
+    ssize_t channel_read(Channel *ch, void *buffer, size_t size);
+    ssize_t channel_write(Channel *ch, const void *buffer, size_t size);
+    short channel_poll(const Channel *ch, short events);
+
+    nsapi_error_t open_dlci(uint8_t dlci);
+    nsapi_error_t wait_ua(uint8_t dlci);
+    int send_frame(uint8_t dlci, uint8_t control, bool command, const uint8_t *info, size_t len);
+    int write_all(const uint8_t *data, size_t len);
+    void process_input();
+    void rx_byte(uint8_t byte);
+    void handle_frame();
+    void handle_control();
+    void serial_sigio();
+
+    FileHandle *_fh;
+    Channel _channels[MBED_CONF_CELLULAR_MUX_CHANNELS];
+    PlatformMutex _mutex;
+    bool _open;
+
+    // DLCIs from which UA or DM was received
+    uint32_t _ua_mask;
+    uint32_t _dm_mask;
+
+    RxState _rx_state;
+    uint8_t _rx_header[4];
+    uint8_t _rx_header_len;
+    uint16_t _rx_len;
+    uint16_t _rx_pos;
+    uint8_t _rx_fcs;
+    uint8_t _rx_info[CELLULAR_MUX_FRAME_SIZE];
+};
+
+} // namespace mbed
+
+#endif // CELLULAR_MUX_H_
@@ -29,6 +29,11 @@ class CellularDevice;
 /** CellularStateMachine class
  *
  *  Finite State Machine for attaching to cellular network. Used by CellularDevice.
+ *
+ *  Once attached, the registration type is remembered until the state machine is stopped or the
+ *  registration is lost. When connecting again while the modem is still ready, for example after PSM,
+ *  only the registration and attach status are verified and SIM and registration states are skipped.
+ *  See cellular.fast-reattach.
  */
 class CellularStateMachine {
 public:
@@ -146,6 +151,7 @@ private:
     bool get_network_registration(CellularNetwork::RegistrationType type, CellularNetwork::RegistrationStatus &status, bool &is_registered);
     bool is_registered();
     bool device_ready();
+    bool fast_reattach();
 
     // state functions to keep state machine simple
     void state_init();
@@ -201,6 +207,10 @@ private:
     std::chrono::duration<int, std::milli> _state_timeout_connect; // timeout for PS attach, PDN connect and socket operations
 
     cell_signal_quality_t _signal_quality;
+
+    // registration of the last attach, verified by fast_reattach()
+    bool _reattach_valid;
+    CellularNetwork::RegistrationType _reattach_reg_type;
 };
 
 } // namespace
@@ -23,6 +23,7 @@
 #include "AT_CellularSMS.h"
 #include "AT_CellularContext.h"
 #include "AT_CellularStack.h"
+#include "CellularMux.h"
 #include "CellularLog.h"
 #include "ATHandler.h"
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN) || defined(DOXYGEN_ONLY)
@@ -48,6 +49,7 @@ AT_CellularDevice::AT_CellularDevice(FileHandle *fh) :
     _network(0),
     _information(0),
     _context_list(0),
+    _mux(0),
     _default_timeout(DEFAULT_AT_TIMEOUT),
     _modem_debug_on(false),
     _property_array(NULL)
@@ -86,6 +88,8 @@ AT_CellularDevice::~AT_CellularDevice()
         delete curr;
         curr = next;
     }
+
+    stop_mux();
 }
 
 void AT_CellularDevice::set_at_urcs_impl()
@@ -109,6 +113,7 @@ void AT_CellularDevice::setup_at_handler()
     set_at_urcs();
 
     _at.set_send_delay(get_property(AT_CellularDevice::PROPERTY_AT_SEND_DELAY));
+    _at.set_resp_queue_depth(get_property(AT_CellularDevice::PROPERTY_AT_PIPELINE_DEPTH));
 }
 
 void AT_CellularDevice::urc_nw_deact()
@@ -646,3 +651,61 @@ intptr_t AT_CellularDevice::get_property(CellularProperty key)
         return 0;
     }
 }
+
+nsapi_error_t AT_CellularDevice::start_mux()
+{
+    if (!get_property(PROPERTY_AT_CMUX)) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    if (_mux) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _at.lock();
+    nsapi_error_t err = _at.at_cmd_discard("+CMUX", "=0");
+    if (err != NSAPI_ERROR_OK) {
+        _at.unlock();
+        return err;
+    }
+
+    // the serial line now belongs to the multiplexer
+    FileHandle *fh = _at.get_file_handle();
+    _at.set_is_filehandle_usable(false);
+    _mux = new CellularMux(fh);
+    err = _mux->open();
+    if (err != NSAPI_ERROR_OK) {
+        delete _mux;
+        _mux = NULL;
+    } else {
+        _at.set_file_handle(_mux->get_channel(1));
+    }
+    _at.set_is_filehandle_usable(true);
+    _at.unlock();
+
+    return err;
+}
+
+void AT_CellularDevice::stop_mux()
+{
+    if (!_mux) {
+        return;
+    }
+
+    _at.lock();
+    _at.set_is_filehandle_usable(false);
+    _mux->close();
+    _at.set_file_handle(_mux->get_file_handle());
+    delete _mux;
+    _mux = NULL;
+    _at.set_is_filehandle_usable(true);
+    _at.unlock();
+}
+
+FileHandle *AT_CellularDevice::get_mux_channel(uint8_t dlci)
+{
+    if (!_mux || dlci < 2) {
+        return NULL;
+    }
+    return _mux->get_channel(dlci);
+}
@@ -173,6 +173,8 @@ nsapi_error_t AT_CellularStack::socket_close(nsapi_socket_t handle)
 
     // Close the socket on the modem if it was created
     _at.lock();
+    // the queued responses of the sends refer to the socket
+    _at.resp_queue_flush();
     if (sock_id > -1) {
         err = socket_close_impl(sock_id);
     }
@@ -305,7 +307,13 @@ nsapi_size_or_error_t AT_CellularStack::socket_sendto(nsapi_socket_t handle, con
 
     _at.lock();
 
-    ret_val = socket_sendto_impl(socket, addr, data, size);
+    if (socket->send_error != NSAPI_ERROR_OK) {
+        // the response of an earlier pipelined send failed
+        ret_val = socket->send_error;
+        socket->send_error = NSAPI_ERROR_OK;
+    } else {
+        ret_val = socket_sendto_impl(socket, addr, data, size);
+    }
 
     _at.unlock();
 
@@ -318,6 +326,23 @@ nsapi_size_or_error_t AT_CellularStack::socket_sendto(nsapi_socket_t handle, con
     return ret_val;
 }
 
+void AT_CellularStack::socket_sendto_resp(CellularSocket *socket)
+{
+    if (!_device.get_property(AT_CellularDevice::PROPERTY_AT_PIPELINE_DEPTH)) {
+        _at.resp_start();
+        _at.resp_stop();
+        return;
+    }
+
+    _at.resp_queue([this, socket]() {
+        _at.resp_start();
+        _at.resp_stop();
+        if (_at.get_last_error() != NSAPI_ERROR_OK) {
+            socket->send_error = _at.get_last_error();
+        }
+    });
+}
+
 nsapi_size_or_error_t AT_CellularStack::socket_recv(nsapi_socket_t handle, void *data, unsigned size)
 {
     return socket_recvfrom(handle, NULL, data, size);
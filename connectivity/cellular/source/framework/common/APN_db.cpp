@@ -29,6 +29,7 @@
    google: https://www.google.de/search?q=APN+list
 ---------------------------------------------------------------- */
 
+#include <stdint.h>
 #include "APN_db.h"
 
 /**
@@ -56,7 +57,7 @@ static const char apndef[] = _APN("internet",,);
  * The APN without username/password have to be listed first.
  */
 
-static const APN_t apnlut[] = {
+static constexpr APN_t apnlut[] = {
 // MCC Country
 //  { /* Operator */ "MCC-MNC[,MNC]" _APN(APN,USERNAME,PASSWORD) },
 // MCC must be 3 digits
@@ -87,7 +88,7 @@ static const APN_t apnlut[] = {
 
 // 440 Japan - JP
     { /* Softbank */ "440-04,06,20,40,41,42,43,44,45,46,47,48,90,91,92,93,94,95"
-        ",96,97,98"
+        ",96,97,98",
         _APN("open.softbank.ne.jp", "opensoftbank", "ebMNuX1FIHg9d3DA")
         _APN("smile.world", "dna1trop", "so2t3k3m2a")
     },
@@ -146,29 +147,123 @@ static const APN_t apnlut[] = {
     { /* Transatel */ "901-37", _APN("netgprs.com", "tsl", "tsl") },
 };
 
+static constexpr bool apn_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static constexpr uint32_t apn_digits(const char *p, int len)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < len; i++) {
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * Index key of a MCC and MNC, a 3 digit MNC doesn't match the same 2 digit one
+ */
+static constexpr uint32_t apn_key(uint32_t mcc, uint32_t mnc, int mnc_len)
+{
+    return (mcc << 11) | ((mnc_len == 3 ? 1 : 0) << 10) | mnc;
+}
+
+/**
+ * Number of MNC listed in apnlut
+ */
+static constexpr size_t apn_mnc_count()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < sizeof(apnlut) / sizeof(*apnlut); i++) {
+        const char *p = apnlut[i].mccmnc + 3;
+        while (((p[0] == '-') || (p[0] == ',')) && apn_is_digit(p[1]) && apn_is_digit(p[2])) {
+            p += apn_is_digit(p[3]) ? 4 : 3;
+            count++;
+        }
+    }
+    return count;
+}
+
+static constexpr size_t APN_MNC_COUNT = apn_mnc_count();
+
+static_assert(sizeof(apnlut) / sizeof(*apnlut) <= 0x100, "apnlut index must fit in 8 bits");
+
+/**
+ * Sorted index of apnlut, one entry per MNC: the key of the MCC and MNC and the apnlut index in the low 8 bits
+ */
+typedef struct {
+    uint32_t entry[APN_MNC_COUNT];
+} APN_index_t;
+
+static constexpr APN_index_t apn_make_index()
+{
+    APN_index_t index = {};
+    size_t count = 0;
+    for (size_t i = 0; i < sizeof(apnlut) / sizeof(*apnlut); i++) {
+        const char *p = apnlut[i].mccmnc;
+        uint32_t mcc = apn_digits(p, 3);
+        p += 3;
+        while (((p[0] == '-') || (p[0] == ',')) && apn_is_digit(p[1]) && apn_is_digit(p[2])) {
+            int l = apn_is_digit(p[3]) ? 3 : 2;
+            uint32_t entry = (apn_key(mcc, apn_digits(p + 1, l), l) << 8) | i;
+            // insertion sort, the table is small
+            size_t j = count++;
+            while (j > 0 && index.entry[j - 1] > entry) {
+                index.entry[j] = index.entry[j - 1];
+                j--;
+            }
+            index.entry[j] = entry;
+            p += 1 + l;
+        }
+    }
+    return index;
+}
+
+static constexpr APN_index_t apnidx = apn_make_index();
+
+/**
+ * Finds the first apnlut entry listing the key
+ *
+ * @return apnlut index, or -1 if not found
+ */
+static int apn_find(uint32_t key)
+{
+    size_t low = 0;
+    size_t high = APN_MNC_COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if ((apnidx.entry[mid] >> 8) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < APN_MNC_COUNT && (apnidx.entry[low] >> 8) == key) {
+        return apnidx.entry[low] & 0xFF;
+    }
+    return -1;
+}
+
 const char *apnconfig(const char *imsi)
 {
     const char *config = NULL;
-    if (imsi && *imsi) {
+    if (imsi && apn_is_digit(imsi[0]) && apn_is_digit(imsi[1]) && apn_is_digit(imsi[2]) &&
+            apn_is_digit(imsi[3]) && apn_is_digit(imsi[4])) {
         // many carriers use internet without username and password, os use this as default
-        // now try to lookup the setting for our table
-        for (size_t i = 0; i < sizeof(apnlut) / sizeof(*apnlut) && !config; i ++) {
-            const char *p = apnlut[i].mccmnc;
-            // check the MCC
-            if ((0 == memcmp(imsi, p, 3))) {
-                p += 3;
-                // check all the MNC, MNC length can be 2 or 3 digits
-                while (((p[0] == '-') || (p[0] == ',')) &&
-                        (p[1] >= '0') && (p[1] <= '9') &&
-                        (p[2] >= '0') && (p[2] <= '9') && !config) {
-                    int l = ((p[3] >= '0') && (p[3] <= '9')) ? 3 : 2;
-                    if (0 == memcmp(imsi + 3, p + 1, l)) {
-                        config = apnlut[i].cfg;
-                    }
-                    p += 1 + l;
-                }
+        // now try to lookup the setting for our table, MNC length can be 2 or 3 digits
+        uint32_t mcc = apn_digits(imsi, 3);
+        int found = apn_find(apn_key(mcc, apn_digits(imsi + 3, 2), 2));
+        if (apn_is_digit(imsi[5])) {
+            int found3 = apn_find(apn_key(mcc, apn_digits(imsi + 3, 3), 3));
+            // the entry listed first in the table wins
+            if (found3 >= 0 && (found < 0 || found3 < found)) {
+                found = found3;
             }
         }
+        if (found >= 0) {
+            config = apnlut[found].cfg;
+        }
     }
     // use default if not found
     if (!config) {
@@ -62,6 +62,14 @@ const uint8_t ERROR_LENGTH = 7;
 const uint8_t MAX_RESP_LENGTH = CMS_ERROR_LENGTH;
 const char DEFAULT_DELIMITER = ',';
 
+// FNV-1a, URC prefixes are compared only when their hashes match
+const uint32_t URC_HASH_INIT = 2166136261UL;
+
+static inline uint32_t urc_hash(uint32_t hash, char c)
+{
+    return (hash ^ (uint8_t)c) * 16777619UL;
+}
+
 static const uint8_t map_3gpp_errors[][2] =  {
     { 103, 3 },  { 106, 6 },  { 107, 7 },  { 108, 8 },  { 111, 11 }, { 112, 12 }, { 113, 13 }, { 114, 14 },
     { 115, 15 }, { 122, 22 }, { 125, 25 }, { 172, 95 }, { 173, 96 }, { 174, 97 }, { 175, 99 }, { 176, 111 },
@@ -101,7 +109,11 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, mbed::chrono::millisecon
     _cmd_start(false),
     _use_delimiter(true),
     _start_time(),
-    _event_id(0)
+    _event_id(0),
+    _resp_queue_depth(0),
+    _resp_queue_head(0),
+    _resp_queue_count(0),
+    _resp_queue_reading(false)
 {
     clear_error();
 
@@ -182,6 +194,16 @@ FileHandle *ATHandler::get_file_handle()
     return _fileHandle;
 }
 
+void ATHandler::set_file_handle(FileHandle *fh)
+{
+    ScopedLock<ATHandler> lock(*this);
+    bool usable = _is_fh_usable;
+    set_is_filehandle_usable(false);
+    _fileHandle = fh;
+    reset_buffer();
+    set_is_filehandle_usable(usable);
+}
+
 void ATHandler::set_is_filehandle_usable(bool usable)
 {
     ScopedLock<ATHandler> lock(*this);
@@ -192,6 +214,12 @@ void ATHandler::set_is_filehandle_usable(bool usable)
         } else {
             _fileHandle->set_blocking(true); // set back to default state
             _fileHandle->sigio(nullptr);
+            // the queued responses can't be read anymore
+            while (_resp_queue_count) {
+                _resp_queue[_resp_queue_head] = nullptr;
+                _resp_queue_head = (_resp_queue_head + 1) % AT_RESP_QUEUE_MAX;
+                _resp_queue_count--;
+            }
         }
         _is_fh_usable = usable;
     }
@@ -220,9 +248,19 @@ void ATHandler::set_urc_handler(const char *prefix, Callback<void()> callback)
 
     oob->prefix = prefix;
     oob->prefix_len = prefix_len;
+    oob->prefix_hash = URC_HASH_INIT;
+    for (size_t i = 0; i < prefix_len; i++) {
+        oob->prefix_hash = urc_hash(oob->prefix_hash, prefix[i]);
+    }
     oob->cb = callback;
-    oob->next = _oobs;
-    _oobs = oob;
+
+    // keep the list sorted by prefix length for match_urc()
+    oob_t **next = &_oobs;
+    while (*next && (*next)->prefix_len < oob->prefix_len) {
+        next = &(*next)->next;
+    }
+    oob->next = *next;
+    *next = oob;
 }
 
 void ATHandler::remove_urc_handler(const char *prefix)
@@ -328,6 +366,9 @@ void ATHandler::process_oob()
 #endif
         return;
     }
+    if (_resp_queue_count) {
+        resp_queue_flush();
+    }
     if (_fileHandle->readable() || (_recv_pos < _recv_len)) {
         tr_debug("AT OoB readable %d, len %u", _fileHandle->readable(), _recv_len - _recv_pos);
         _current_scope = NotSet;
@@ -338,7 +379,7 @@ void ATHandler::process_oob()
                 if (!(_fileHandle->readable() || (_recv_pos < _recv_len))) {
                     break; // we have nothing to read anymore
                 }
-            } else if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) { // If no match found, look for CRLF and consume everything up to CRLF
+            } else if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) { // If no match found, look for CRLF and consume everything up to CRLF
                 _at_timeout = PROCESS_URC_TIME;
                 consume_to_tag(CRLF, true);
             } else {
@@ -385,7 +426,7 @@ int ATHandler::poll_timeout(bool wait_for_timeout)
         } else if (_start_time + _at_timeout - now > timeout.max()) {
             timeout = timeout.max();
         } else {
-            timeout = _start_time + _at_timeout - now;
+            timeout = std::chrono::duration_cast<std::chrono::duration<int, std::milli>>(_start_time + _at_timeout - now);
         }
     } else {
         timeout = 0s;
@@ -395,6 +436,13 @@ int ATHandler::poll_timeout(bool wait_for_timeout)
 
 bool ATHandler::fill_buffer(bool wait_for_timeout)
 {
+    // Move the unread content only when that frees more room than is left after it
+    if (_recv_pos == _recv_len) {
+        reset_buffer();
+    } else if (sizeof(_recv_buff) - _recv_len < _recv_pos) {
+        rewind_buffer();
+    }
+
     // Reset buffer when full
     if (sizeof(_recv_buff) == _recv_len) {
         tr_warn("AT overflow");
@@ -769,8 +817,6 @@ void ATHandler::set_scope(ScopeType scope_type)
 // should match from recv_pos?
 bool ATHandler::match(const char *str, size_t size)
 {
-    rewind_buffer();
-
     if ((_recv_len - _recv_pos) < size) {
         return false;
     }
@@ -785,22 +831,34 @@ bool ATHandler::match(const char *str, size_t size)
 
 bool ATHandler::match_urc()
 {
-    rewind_buffer();
-    size_t prefix_len = 0;
-    for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
-        prefix_len = oob->prefix_len;
-        if (_recv_len >= prefix_len) {
-            if (match(oob->prefix, prefix_len)) {
-                set_scope(InfoType);
-                if (oob->cb) {
-                    oob->cb();
-                }
-                information_response_stop();
-                return true;
-            }
+    // The prefixes are sorted by length, so the hash of the unread content is
+    // extended one char at a time. A prefix wins over the shorter ones it starts with.
+    const char *data = _recv_buff + _recv_pos;
+    size_t data_len = _recv_len - _recv_pos;
+    uint32_t hash = URC_HASH_INIT;
+    size_t hash_len = 0;
+    struct oob_t *found = NULL;
+    for (struct oob_t *oob = _oobs; oob && (size_t)oob->prefix_len <= data_len; oob = oob->next) {
+        while (hash_len < (size_t)oob->prefix_len) {
+            hash = urc_hash(hash, data[hash_len++]);
+        }
+        if (hash == oob->prefix_hash && memcmp(data, oob->prefix, oob->prefix_len) == 0) {
+            found = oob;
         }
     }
-    return false;
+
+    if (!found) {
+        return false;
+    }
+
+    // consume matching part
+    _recv_pos += found->prefix_len;
+    set_scope(InfoType);
+    if (found->cb) {
+        found->cb();
+    }
+    information_response_stop();
+    return true;
 }
 
 bool ATHandler::match_error()
@@ -925,7 +983,7 @@ void ATHandler::resp(const char *prefix, bool check_urc)
         }
 
         // If no match found, look for CRLF and consume everything up to and including CRLF
-        if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) {
+        if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) {
             // If no prefix, return on CRLF - means data to read
             if (!prefix || (prefix && !strlen(prefix))) {
                 return;
@@ -954,9 +1012,13 @@ void ATHandler::resp_start(const char *prefix, bool stop)
         return;
     }
 
+    // the responses of the queued commands come first
+    if (_resp_queue_count && !_resp_queue_reading) {
+        resp_queue_flush();
+    }
+
     set_scope(NotSet);
     // Try get as much data as possible
-    rewind_buffer();
     (void)fill_buffer(false);
 
     if (prefix) {
@@ -1123,7 +1185,7 @@ void ATHandler::resp_stop()
                 }
 
                 // If no URC nor stop_tag found, look for CRLF and consume everything up to and including CRLF
-                if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) {
+                if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) {
                     consume_to_tag(CRLF, true);
                     // If stop tag is CRLF we have to stop reading/consuming the buffer
                     if (!strncmp(CRLF, _stop_tag->tag, _stop_tag->len)) {
@@ -1376,6 +1438,43 @@ void ATHandler::cmd_stop_read_resp()
     resp_stop();
 }
 
+void ATHandler::resp_queue(Callback<void()> handler)
+{
+    if (!_resp_queue_depth || !ok_to_proceed()) {
+        handler();
+        return;
+    }
+
+    while (_resp_queue_count >= _resp_queue_depth) {
+        read_queued_resp();
+    }
+
+    _resp_queue[(_resp_queue_head + _resp_queue_count) % AT_RESP_QUEUE_MAX] = handler;
+    _resp_queue_count++;
+}
+
+void ATHandler::resp_queue_flush()
+{
+    while (_resp_queue_count && !_resp_queue_reading) {
+        read_queued_resp();
+    }
+}
+
+void ATHandler::read_queued_resp()
+{
+    Callback<void()> handler = _resp_queue[_resp_queue_head];
+    _resp_queue[_resp_queue_head] = nullptr;
+    _resp_queue_head = (_resp_queue_head + 1) % AT_RESP_QUEUE_MAX;
+    _resp_queue_count--;
+
+    // the response timeout starts now, and its errors are for the handler only
+    _start_time = rtos::Kernel::Clock::now();
+    _resp_queue_reading = true;
+    handler();
+    _resp_queue_reading = false;
+    clear_error();
+}
+
 size_t ATHandler::write_bytes(const uint8_t *data, size_t len)
 {
     if (!ok_to_proceed()) {
@@ -1456,6 +1555,7 @@ void ATHandler::flush()
         return;
     }
     tr_debug("AT flush");
+    resp_queue_flush();
     reset_buffer();
     while (fill_buffer(false)) {
         reset_buffer();
@@ -1551,6 +1651,12 @@ void ATHandler::set_send_delay(uint16_t send_delay)
     _at_send_delay = std::chrono::duration<uint16_t, std::milli>(send_delay);
 }
 
+void ATHandler::set_resp_queue_depth(uint8_t depth)
+{
+    resp_queue_flush();
+    _resp_queue_depth = depth > AT_RESP_QUEUE_MAX ? AT_RESP_QUEUE_MAX : depth;
+}
+
 void ATHandler::write_hex_string(const char *str, size_t size)
 {
     // do common checks before sending subparameter
@@ -0,0 +1,542 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include "CellularMux.h"
+#include "mbed_poll.h"
+#include "rtos/Kernel.h"
+#include "CellularLog.h"
+
+using namespace mbed;
+using namespace std::chrono_literals;
+
+#define MUX_FLAG        0xF9
+#define MUX_EA          0x01
+#define MUX_CR          0x02
+#define MUX_PF          0x10
+
+// frame types of the control field, without the P/F bit
+#define MUX_SABM        0x2F
+#define MUX_UA          0x63
+#define MUX_DM          0x0F
+#define MUX_DISC        0x43
+#define MUX_UIH         0xEF
+#define MUX_UI          0x03
+
+// control channel message types, without the EA and C/R bits
+#define MUX_MSG_CLD     0xC0
+#define MUX_MSG_TYPE(x) ((x) & 0xFC)
+
+#define MUX_FCS_INIT    0xFF
+#define MUX_FCS_GOOD    0xCF
+
+// how long the modem has to answer SABM and DISC
+#define MUX_RESP_TIME   1s
+// how long a write waits for the serial line
+#define MUX_WRITE_TIME  1000
+
+// reversed CRC-8 of TS 27.010, polynomial x^8 + x^2 + x + 1
+static uint8_t mux_fcs(uint8_t fcs, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        fcs ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            fcs = (fcs & 1) ? (fcs >> 1) ^ 0xE0 : (fcs >> 1);
+        }
+    }
+    return fcs;
+}
+
+CellularMux::Channel::Channel() :
+    _mux(NULL),
+    _dlci(0),
+    _open(false),
+    _blocking(true)
+{
+}
+
+ssize_t CellularMux::Channel::read(void *buffer, size_t size)
+{
+    return _mux->channel_read(this, buffer, size);
+}
+
+ssize_t CellularMux::Channel::write(const void *buffer, size_t size)
+{
+    return _mux->channel_write(this, buffer, size);
+}
+
+off_t CellularMux::Channel::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int CellularMux::Channel::close()
+{
+    return 0;
+}
+
+int CellularMux::Channel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+    return 0;
+}
+
+bool CellularMux::Channel::is_blocking() const
+{
+    return _blocking;
+}
+
+short CellularMux::Channel::poll(short events) const
+{
+    return _mux->channel_poll(this, events);
+}
+
+bool CellularMux::Channel::poll_notifies() const
+{
+    return true;
+}
+
+void CellularMux::Channel::sigio(Callback<void()> func)
+{
+    _mux->_mutex.lock();
+    _sigio_cb = func;
+    _mux->_mutex.unlock();
+}
+
+CellularMux::CellularMux(FileHandle *fh) :
+    _fh(fh),
+    _open(false),
+    _ua_mask(0),
+    _dm_mask(0),
+    _rx_state(RX_FLAG),
+    _rx_header_len(0),
+    _rx_len(0),
+    _rx_pos(0),
+    _rx_fcs(0)
+{
+    for (uint8_t i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        _channels[i]._mux = this;
+        _channels[i]._dlci = i + 1;
+    }
+}
+
+CellularMux::~CellularMux()
+{
+    close();
+}
+
+nsapi_error_t CellularMux::open()
+{
+    _mutex.lock();
+    _fh->set_blocking(false);
+    _fh->sigio(callback(this, &CellularMux::serial_sigio));
+    _rx_state = RX_FLAG;
+    _open = true;
+    _mutex.unlock();
+
+    nsapi_error_t err = open_dlci(0);
+    for (uint8_t i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS && err == NSAPI_ERROR_OK; i++) {
+        err = open_dlci(_channels[i]._dlci);
+        _channels[i]._open = (err == NSAPI_ERROR_OK);
+    }
+
+    if (err != NSAPI_ERROR_OK) {
+        tr_error("CMUX open failed %d", err);
+        close();
+    }
+    return err;
+}
+
+void CellularMux::close()
+{
+    if (!_open) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        if (_channels[i]._open) {
+            _mutex.lock();
+            _ua_mask &= ~(1UL << _channels[i]._dlci);
+            send_frame(_channels[i]._dlci, MUX_DISC | MUX_PF, true, NULL, 0);
+            _mutex.unlock();
+            (void)wait_ua(_channels[i]._dlci);
+            _channels[i]._open = false;
+        }
+    }
+
+    // close down the multiplexer
+    const uint8_t cld[] = { MUX_MSG_CLD | MUX_CR | MUX_EA, MUX_EA };
+    _mutex.lock();
+    send_frame(0, MUX_UIH, true, cld, sizeof(cld));
+    _fh->sigio(nullptr);
+    _fh->set_blocking(true);
+    _open = false;
+    _mutex.unlock();
+}
+
+FileHandle *CellularMux::get_channel(uint8_t dlci)
+{
+    if (dlci < 1 || dlci > MBED_CONF_CELLULAR_MUX_CHANNELS) {
+        return NULL;
+    }
+    return &_channels[dlci - 1];
+}
+
+FileHandle *CellularMux::get_file_handle()
+{
+    return _fh;
+}
+
+nsapi_error_t CellularMux::open_dlci(uint8_t dlci)
+{
+    _mutex.lock();
+    _ua_mask &= ~(1UL << dlci);
+    _dm_mask &= ~(1UL << dlci);
+    int ret = send_frame(dlci, MUX_SABM | MUX_PF, true, NULL, 0);
+    _mutex.unlock();
+    if (ret < 0) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    return wait_ua(dlci);
+}
+
+nsapi_error_t CellularMux::wait_ua(uint8_t dlci)
+{
+    auto end = rtos::Kernel::Clock::now() + MUX_RESP_TIME;
+    while (true) {
+        _mutex.lock();
+        process_input();
+        uint32_t ua = _ua_mask & (1UL << dlci);
+        uint32_t dm = _dm_mask & (1UL << dlci);
+        _mutex.unlock();
+
+        if (ua) {
+            return NSAPI_ERROR_OK;
+        }
+        if (dm) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+
+        auto now = rtos::Kernel::Clock::now();
+        if (now >= end) {
+            return NSAPI_ERROR_TIMEOUT;
+        }
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+        (void)poll(&fhs, 1, std::chrono::duration_cast<std::chrono::milliseconds>(end - now).count());
+    }
+}
+
+ssize_t CellularMux::channel_read(Channel *ch, void *buffer, size_t size)
+{
+    uint8_t *data = (uint8_t *)buffer;
+    while (true) {
+        _mutex.lock();
+        process_input();
+        size_t len = 0;
+        while (len < size && ch->_rx.pop(data[len])) {
+            len++;
+        }
+        bool open = ch->_open;
+        _mutex.unlock();
+
+        if (len || !size) {
+            return len;
+        }
+        if (!open) {
+            return 0;
+        }
+        if (!ch->_blocking) {
+            return -EAGAIN;
+        }
+
+        // the data of this channel may also be read from the serial line by another channel
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+        (void)poll(&fhs, 1, 10);
+    }
+}
+
+ssize_t CellularMux::channel_write(Channel *ch, const void *buffer, size_t size)
+{
+    const uint8_t *data = (const uint8_t *)buffer;
+    size_t written = 0;
+
+    _mutex.lock();
+    if (!ch->_open) {
+        _mutex.unlock();
+        return -ENOTCONN;
+    }
+
+    while (written < size) {
+        size_t len = size - written;
+        if (len > CELLULAR_MUX_FRAME_SIZE) {
+            len = CELLULAR_MUX_FRAME_SIZE;
+        }
+        int ret = send_frame(ch->_dlci, MUX_UIH, true, data + written, len);
+        if (ret < 0) {
+            _mutex.unlock();
+            return written ? (ssize_t)written : ret;
+        }
+        written += len;
+    }
+    _mutex.unlock();
+
+    return written;
+}
+
+short CellularMux::channel_poll(const Channel *ch, short events)
+{
+    _mutex.lock();
+    process_input();
+    short revents = 0;
+    if (!ch->_rx.empty()) {
+        revents |= POLLIN;
+    }
+    if (_fh->poll(POLLOUT) & POLLOUT) {
+        revents |= POLLOUT;
+    }
+    if (!ch->_open) {
+        revents |= POLLHUP;
+    }
+    _mutex.unlock();
+
+    return revents & (events | POLLHUP);
+}
+
+int CellularMux::send_frame(uint8_t dlci, uint8_t control, bool command, const uint8_t *info, size_t len)
+{
+    uint8_t header[5];
+    size_t header_len = 4;
+    header[0] = MUX_FLAG;
+    header[1] = (dlci << 2) | (command ? MUX_CR : 0) | MUX_EA;
+    header[2] = control;
+    if (len < 128) {
+        header[3] = (len << 1) | MUX_EA;
+    } else {
+        header[3] = len << 1;
+        header[4] = len >> 7;
+        header_len = 5;
+    }
+
+    // the FCS of UIH frames covers the header only
+    uint8_t fcs = mux_fcs(MUX_FCS_INIT, header + 1, header_len - 1);
+    if ((control & ~MUX_PF) != MUX_UIH) {
+        fcs = mux_fcs(fcs, info, len);
+    }
+    uint8_t trailer[2] = { (uint8_t)(0xFF - fcs), MUX_FLAG };
+
+    int ret = write_all(header, header_len);
+    if (ret == 0 && len) {
+        ret = write_all(info, len);
+    }
+    if (ret == 0) {
+        ret = write_all(trailer, sizeof(trailer));
+    }
+    return ret;
+}
+
+int CellularMux::write_all(const uint8_t *data, size_t len)
+{
+    while (len) {
+        ssize_t ret = _fh->write(data, len);
+        if (ret == -EAGAIN) {
+            pollfh fhs;
+            fhs.fh = _fh;
+            fhs.events = POLLOUT;
+            if (poll(&fhs, 1, MUX_WRITE_TIME) <= 0) {
+                return -ETIMEDOUT;
+            }
+            continue;
+        }
+        if (ret < 0) {
+            return ret;
+        }
+        data += ret;
+        len -= ret;
+    }
+    return 0;
+}
+
+void CellularMux::process_input()
+{
+    if (!_open) {
+        return;
+    }
+
+    uint8_t buf[32];
+    ssize_t len;
+    while ((len = _fh->read(buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < len; i++) {
+            rx_byte(buf[i]);
+        }
+    }
+}
+
+void CellularMux::rx_byte(uint8_t byte)
+{
+    switch (_rx_state) {
+        case RX_FLAG:
+            if (byte == MUX_FLAG) {
+                _rx_state = RX_ADDRESS;
+            }
+            break;
+        case RX_ADDRESS:
+            // the closing flag of a frame may be followed by the opening flag of the next one
+            if (byte != MUX_FLAG) {
+                _rx_header[0] = byte;
+                _rx_state = RX_CONTROL;
+            }
+            break;
+        case RX_CONTROL:
+            _rx_header[1] = byte;
+            _rx_state = RX_LENGTH;
+            break;
+        case RX_LENGTH:
+        case RX_LENGTH2:
+            if (_rx_state == RX_LENGTH) {
+                _rx_header[2] = byte;
+                _rx_header_len = 3;
+                _rx_len = byte >> 1;
+            } else {
+                _rx_header[3] = byte;
+                _rx_header_len = 4;
+                _rx_len |= (uint16_t)byte << 7;
+            }
+            if (_rx_state == RX_LENGTH && !(byte & MUX_EA)) {
+                _rx_state = RX_LENGTH2;
+            } else if (_rx_len > sizeof(_rx_info)) {
+                tr_warn("CMUX frame too long %u", _rx_len);
+                _rx_state = RX_FLAG;
+            } else {
+                _rx_pos = 0;
+                _rx_state = _rx_len ? RX_INFO : RX_FCS;
+            }
+            break;
+        case RX_INFO:
+            _rx_info[_rx_pos++] = byte;
+            if (_rx_pos == _rx_len) {
+                _rx_state = RX_FCS;
+            }
+            break;
+        case RX_FCS:
+            _rx_fcs = byte;
+            _rx_state = RX_END;
+            break;
+        case RX_END:
+            if (byte == MUX_FLAG) {
+                uint8_t fcs = mux_fcs(MUX_FCS_INIT, _rx_header, _rx_header_len);
+                if ((_rx_header[1] & ~MUX_PF) != MUX_UIH) {
+                    fcs = mux_fcs(fcs, _rx_info, _rx_len);
+                }
+                if (mux_fcs(fcs, &_rx_fcs, 1) == MUX_FCS_GOOD) {
+                    handle_frame();
+                } else {
+                    tr_warn("CMUX FCS error");
+                }
+                _rx_state = RX_ADDRESS;
+            } else {
+                _rx_state = RX_FLAG;
+            }
+            break;
+    }
+}
+
+void CellularMux::handle_frame()
+{
+    uint8_t dlci = _rx_header[0] >> 2;
+    uint8_t control = _rx_header[1] & ~MUX_PF;
+    Channel *ch = (dlci >= 1 && dlci <= MBED_CONF_CELLULAR_MUX_CHANNELS) ? &_channels[dlci - 1] : NULL;
+
+    switch (control) {
+        case MUX_UA:
+            _ua_mask |= 1UL << dlci;
+            break;
+        case MUX_DM:
+            _dm_mask |= 1UL << dlci;
+            if (ch) {
+                ch->_open = false;
+                poll_notify(ch);
+            }
+            break;
+        case MUX_SABM:
+            send_frame(dlci, MUX_UA | MUX_PF, false, NULL, 0);
+            break;
+        case MUX_DISC:
+            send_frame(dlci, MUX_UA | MUX_PF, false, NULL, 0);
+            if (ch) {
+                ch->_open = false;
+                poll_notify(ch);
+            }
+            break;
+        case MUX_UIH:
+        case MUX_UI:
+            if (dlci == 0) {
+                handle_control();
+            } else if (ch) {
+                bool was_empty = ch->_rx.empty();
+                for (uint16_t i = 0; i < _rx_len; i++) {
+                    if (ch->_rx.full()) {
+                        tr_warn("CMUX channel %d overflow", dlci);
+                        break;
+                    }
+                    ch->_rx.push(_rx_info[i]);
+                }
+                if (was_empty && !ch->_rx.empty()) {
+                    poll_notify(ch);
+                    if (ch->_sigio_cb) {
+                        ch->_sigio_cb();
+                    }
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void CellularMux::handle_control()
+{
+    if (_rx_len < 1 || !(_rx_info[0] & MUX_CR)) {
+        // a response to our message
+        return;
+    }
+
+    // respond with the same message
+    _rx_info[0] &= ~MUX_CR;
+    send_frame(0, MUX_UIH, true, _rx_info, _rx_len);
+
+    if (MUX_MSG_TYPE(_rx_info[0]) == MUX_MSG_CLD) {
+        for (uint8_t i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+            _channels[i]._open = false;
+            poll_notify(&_channels[i]);
+        }
+    }
+}
+
+void CellularMux::serial_sigio()
+{
+    // the data is read and dispatched by the channel that is woken up
+    for (uint8_t i = 0; i < MBED_CONF_CELLULAR_MUX_CHANNELS; i++) {
+        poll_notify(&_channels[i]);
+        if (_channels[i]._sigio_cb) {
+            _channels[i]._sigio_cb();
+        }
+    }
+}
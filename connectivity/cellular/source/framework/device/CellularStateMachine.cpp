@@ -61,7 +61,8 @@ CellularStateMachine::CellularStateMachine(CellularDevice &device, events::Event
     _start_time(rand() % (MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY)),
 #endif // MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY
     _event_timeout(-1s), _event_id(-1), _plmn(0), _command_success(false),
-    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0)
+    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0),
+    _reattach_valid(false), _reattach_reg_type(CellularNetwork::C_EREG)
 {
 
     // set initial retry values in seconds
@@ -106,6 +107,7 @@ void CellularStateMachine::stop()
     tr_debug("CellularStateMachine stop");
     reset();
     _event_id = STM_STOPPED;
+    _reattach_valid = false;
 }
 
 bool CellularStateMachine::power_on()
@@ -126,6 +128,7 @@ void CellularStateMachine::set_sim_pin(const char *sim_pin)
 void CellularStateMachine::set_plmn(const char *plmn)
 {
     _plmn = plmn;
+    _reattach_valid = false;
 }
 
 bool CellularStateMachine::open_sim()
@@ -187,6 +190,7 @@ bool CellularStateMachine::is_registered()
     for (int type = 0; type < CellularNetwork::C_REG; type++) {
         if (get_network_registration((CellularNetwork::RegistrationType) type, status, is_registered)) {
             if (is_registered) {
+                _reattach_reg_type = (CellularNetwork::RegistrationType)type;
                 break;
             }
         }
@@ -258,6 +262,7 @@ void CellularStateMachine::report_failure(const char *msg)
     tr_error("CellularStateMachine failure: %s", msg);
 
     _event_id = -1;
+    _reattach_valid = false;
     _cb_data.final_try = true;
     send_event_cb(_current_event);
 
@@ -311,6 +316,8 @@ void CellularStateMachine::state_init()
     _cb_data.error = _cellularDevice.is_ready();
     _status = _cb_data.error ? 0 : DEVICE_READY;
     if (_cb_data.error != NSAPI_ERROR_OK) {
+        // modem is powered on again, it has to register again
+        _reattach_valid = false;
         _event_timeout = _start_time;
         if (_start_time > 0s) {
             tr_info("Startup delay %d s", _start_time.count());
@@ -353,10 +360,43 @@ bool CellularStateMachine::device_ready()
     return true;
 }
 
+bool CellularStateMachine::fast_reattach()
+{
+#if MBED_CONF_CELLULAR_FAST_REATTACH
+    if (!_reattach_valid) {
+        return false;
+    }
+
+    CellularNetwork::RegistrationStatus status = CellularNetwork::Unknown;
+    bool registered = false;
+    CellularNetwork::AttachStatus attach = CellularNetwork::Detached;
+    if (!get_network_registration(_reattach_reg_type, status, registered) || !registered ||
+            _network.get_attach(attach) != NSAPI_ERROR_OK || attach != CellularNetwork::Attached ||
+            _network.set_registration_urc(_reattach_reg_type, true) != NSAPI_ERROR_OK) {
+        tr_info("Not attached anymore, full connect");
+        _reattach_valid = false;
+        return false;
+    }
+
+    tr_info("Fast re-attach, registration type %d", _reattach_reg_type);
+    // report the skipped states, so that CellularContext and the application follow as on the full path
+    _cb_data.error = NSAPI_ERROR_OK;
+    _cb_data.status_data = CellularDevice::SimStateReady;
+    send_event_cb(CellularSIMStatusChanged);
+    _cb_data.status_data = status;
+    send_event_cb(CellularRegistrationStatusChanged);
+    _status = ATTACHED_TO_NETWORK;
+    return true;
+#else
+    return false;
+#endif // MBED_CONF_CELLULAR_FAST_REATTACH
+}
+
 void CellularStateMachine::state_device_ready()
 {
     change_timeout(_state_timeout_power_on);
-    if (!(_status & DEVICE_READY)) {
+    bool was_ready = _status & DEVICE_READY;
+    if (!was_ready) {
         tr_debug("Device was not ready, calling soft_power_on()");
         _cb_data.error = _cellularDevice.soft_power_on();
     }
@@ -385,9 +425,14 @@ void CellularStateMachine::state_device_ready()
 
             if (device_ready()) {
                 _status = 0;
-                enter_to_state(STATE_SIM_PIN);
+                if (was_ready && fast_reattach()) {
+                    enter_to_state(STATE_ATTACHING_NETWORK);
+                } else {
+                    enter_to_state(STATE_SIM_PIN);
+                }
             } else {
                 tr_warning("Power cycle CellularDevice and restart connecting");
+                _reattach_valid = false;
                 (void) _cellularDevice.soft_power_off();
                 (void) _cellularDevice.hard_power_off();
                 _status = 0;
@@ -491,6 +536,7 @@ void CellularStateMachine::state_attaching()
         _cb_data.error = _network.set_attach();
     }
     if (_cb_data.error == NSAPI_ERROR_OK) {
+        _reattach_valid = true;
         _cb_data.status_data = CellularNetwork::Attached;
         send_event_cb(_current_event);
     } else {
@@ -699,6 +745,15 @@ bool CellularStateMachine::check_is_target_reached()
 void CellularStateMachine::cellular_event_changed(nsapi_event_t ev, intptr_t ptr)
 {
     cell_callback_data_t *data = (cell_callback_data_t *)ptr;
+    if ((cellular_connection_status_t)ev == CellularRegistrationStatusChanged && _reattach_valid &&
+            data->status_data != CellularNetwork::RegisteredHomeNetwork &&
+            data->status_data != CellularNetwork::RegisteredRoaming) {
+        CellularNetwork::registration_params_t reg_params;
+        if (_network.get_registration_params(reg_params) == NSAPI_ERROR_OK && reg_params._type == _reattach_reg_type) {
+            tr_debug("Registration lost, next connect runs all states");
+            _reattach_valid = false;
+        }
+    }
     if ((cellular_connection_status_t)ev == CellularRegistrationStatusChanged && (
                 _state == STATE_REGISTERING_NETWORK || _state == STATE_SIGNAL_QUALITY)) {
         // expect packet data so only these states are valid
@@ -711,6 +766,7 @@ void CellularStateMachine::cellular_event_changed(nsapi_event_t ev, intptr_t ptr
                 _queue.cancel(_event_id);
                 _is_retry = false;
                 _event_id = -1;
+                _reattach_reg_type = reg_params._type;
                 if (!check_is_target_reached()) {
                     continue_from_state(STATE_ATTACHING_NETWORK);
                 }
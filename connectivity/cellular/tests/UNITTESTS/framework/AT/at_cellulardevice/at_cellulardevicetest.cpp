@@ -368,3 +368,32 @@ TEST_F(TestAT_CellularDevice, test_AT_CellularDevice_set_ready_cb)
 
     delete dev;
 }
+
+TEST_F(TestAT_CellularDevice, test_AT_CellularDevice_start_stop_mux)
+{
+    FileHandle_stub fh1;
+    AT_CellularDevice *dev = new AT_CellularDevice(&fh1);
+
+    // no PROPERTY_AT_CMUX
+    EXPECT_EQ(NSAPI_ERROR_UNSUPPORTED, dev->start_mux());
+    EXPECT_TRUE(dev->get_mux_channel(2) == NULL);
+
+    static intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = { 0 };
+    cellular_properties[AT_CellularDevice::PROPERTY_AT_CMUX] = 1;
+    dev->set_cellular_properties(cellular_properties);
+
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_DEVICE_ERROR;
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, dev->start_mux());
+    EXPECT_TRUE(dev->get_mux_channel(2) == NULL);
+
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_OK;
+    EXPECT_EQ(NSAPI_ERROR_OK, dev->start_mux());
+    EXPECT_TRUE(dev->get_mux_channel(1) == NULL);
+    EXPECT_TRUE(dev->get_mux_channel(2) != NULL);
+    EXPECT_TRUE(dev->get_mux_channel(3) == NULL);
+
+    dev->stop_mux();
+    EXPECT_TRUE(dev->get_mux_channel(2) == NULL);
+
+    delete dev;
+}
@@ -44,6 +44,7 @@ set(unittest-test-sources
   stubs/ThisThread_stub.cpp
   stubs/ConditionVariable_stub.cpp
   stubs/Mutex_stub.cpp
+  stubs/CellularMux_stub.cpp
 )
 
 set(unittest-test-flags
@@ -58,4 +59,6 @@ set(unittest-test-flags
   -DMDMRXD=NC
   -DMBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE=115200
   -DMBED_CONF_CELLULAR_USE_SMS=1
+  -DMBED_CONF_CELLULAR_MUX_CHANNELS=2
+  -DMBED_CONF_CELLULAR_MUX_BUFFER_SIZE=256
 )
@@ -36,8 +36,11 @@ void urc_callback()
     urc_callback_count++;
 }
 
+uint8_t urc2_callback_count;
+
 void urc2_callback()
 {
+    urc2_callback_count++;
 }
 
 // AStyle ignored as the definition is not clear due to preprocessor usage
@@ -48,6 +51,7 @@ protected:
     void SetUp()
     {
         urc_callback_count = 0;
+        urc2_callback_count = 0;
         CellularUtil_stub::char_ptr = NULL;
         CellularUtil_stub::char_pos = 0;
         filehandle_stub_short_value_counter = 0;
@@ -1048,6 +1052,86 @@ TEST_F(TestATHandler, test_ATHandler_resp_start)
     EXPECT_TRUE(at.get_last_error() == NSAPI_ERROR_DEVICE_ERROR);
 }
 
+TEST_F(TestATHandler, test_ATHandler_resp_start_urc_longest_prefix)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    at.set_urc_handler("+CGEV: NW ", &urc2_callback);
+    at.set_urc_handler("+CGEV: ", &urc_callback);
+
+    char table[] = "+CGEV: NW DETACH\r\n+CGEV: ME DETACH\r\nOK\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    at.resp_start();
+    at.resp_stop();
+    EXPECT_TRUE(at.get_last_error() == NSAPI_ERROR_OK);
+    EXPECT_EQ(1, urc_callback_count);
+    EXPECT_EQ(1, urc2_callback_count);
+
+    at.set_urc_handler("+CGEV: NW ", NULL);
+    at.set_urc_handler("+CGEV: ", NULL);
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
+TEST_F(TestATHandler, test_ATHandler_resp_queue)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+
+    ATHandler at(&fh1, que, 0, ",");
+    nsapi_error_t err1 = NSAPI_ERROR_NO_SOCKET;
+    nsapi_error_t err2 = NSAPI_ERROR_NO_SOCKET;
+
+    // read at once without pipelining
+    at.resp_queue([&]() {
+        at.resp_start();
+        at.resp_stop();
+        err1 = at.get_last_error();
+    });
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, err1);
+    at.clear_error();
+
+    err1 = NSAPI_ERROR_NO_SOCKET;
+    at.set_resp_queue_depth(2);
+    at.resp_queue([&]() {
+        at.resp_start();
+        at.resp_stop();
+        err1 = at.get_last_error();
+    });
+    at.resp_queue([&]() {
+        at.resp_start();
+        at.resp_stop();
+        err2 = at.get_last_error();
+    });
+    EXPECT_EQ(NSAPI_ERROR_NO_SOCKET, err1);
+    EXPECT_EQ(NSAPI_ERROR_NO_SOCKET, err2);
+
+    // the queued responses are read in order before the one of the next command
+    char table[] = "OK\r\nERROR\r\nOK\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    at.resp_start();
+    at.resp_stop();
+    EXPECT_EQ(NSAPI_ERROR_OK, err1);
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, err2);
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
 TEST_F(TestATHandler, test_ATHandler_resp_stop)
 {
     EventQueue que;
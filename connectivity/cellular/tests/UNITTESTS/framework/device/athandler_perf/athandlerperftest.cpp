@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include <string.h>
+#include <string>
+#include "events/EventQueue.h"
+#include "ATHandler.h"
+#include "mbed_poll_stub.h"
+
+using namespace mbed;
+using namespace events;
+
+#define CONTEXT_LINE "+CGDCONT: 1,\"IP\",\"internet.example.com\",\"10.0.0.1\",0,0\r\n"
+#define URC_LINE     "+CREG: 1\r\n"
+
+// Serves a modem response in pieces of the size the ATHandler asks for
+class ResponseFileHandle : public FileHandle {
+public:
+    std::string response;
+    size_t pos = 0;
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        size_t len = std::min(size, response.size() - pos);
+        memcpy(buffer, response.data() + pos, len);
+        pos += len;
+        return len;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        return size;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return 0;
+    }
+
+    virtual int close()
+    {
+        return 0;
+    }
+
+    virtual short poll(short events) const
+    {
+        return pos < response.size() ? POLLIN : 0;
+    }
+};
+
+static int urc_count;
+
+static void urc_callback()
+{
+    urc_count++;
+}
+
+class TestATHandlerPerf : public testing::Test {
+protected:
+    EventQueue que;
+    ResponseFileHandle fh;
+
+    void SetUp()
+    {
+        urc_count = 0;
+        mbed_poll_stub::revents_value = POLLIN;
+        mbed_poll_stub::int_value = 1;
+    }
+
+    void TearDown()
+    {
+        mbed_poll_stub::revents_value = POLLOUT;
+        mbed_poll_stub::int_value = 0;
+    }
+
+    // Parse the information responses of a context listing
+    size_t read_contexts(ATHandler &at)
+    {
+        size_t contexts = 0;
+        char buf[64];
+        at.lock();
+        at.resp_start("+CGDCONT:");
+        while (at.info_resp()) {
+            EXPECT_EQ(1, at.read_int());
+            EXPECT_EQ(2, at.read_string(buf, sizeof(buf)));
+            EXPECT_EQ(20, at.read_string(buf, sizeof(buf)));
+            EXPECT_EQ(8, at.read_string(buf, sizeof(buf)));
+            EXPECT_EQ(0, at.read_int());
+            EXPECT_EQ(0, at.read_int());
+            contexts++;
+        }
+        at.resp_stop();
+        EXPECT_EQ(NSAPI_ERROR_OK, at.unlock_return_error());
+        return contexts;
+    }
+};
+
+TEST_F(TestATHandlerPerf, information_responses)
+{
+    ATHandler at(&fh, que, 1000, "\r");
+
+    auto workload = [this, &at](size_t lines) {
+        fh.response.clear();
+        for (size_t i = 0; i < lines; i++) {
+            fh.response += CONTEXT_LINE;
+        }
+        fh.response += "\r\nOK\r\n";
+        fh.pos = 0;
+        EXPECT_EQ(lines, read_contexts(at));
+    };
+    EXPECT_TRUE(perf::scales_linearly("information_responses", 1 << 6, 1 << 10, workload));
+}
+
+TEST_F(TestATHandlerPerf, urcs_between_responses)
+{
+    ATHandler at(&fh, que, 1000, "\r");
+    at.set_urc_handler("+CREG:", urc_callback);
+    at.set_urc_handler("+CGEV:", urc_callback);
+    at.set_urc_handler("+CEREG:", urc_callback);
+
+    auto workload = [this, &at](size_t lines) {
+        fh.response.clear();
+        for (size_t i = 0; i < lines; i++) {
+            fh.response += URC_LINE;
+            fh.response += CONTEXT_LINE;
+        }
+        fh.response += "\r\nOK\r\n";
+        fh.pos = 0;
+        EXPECT_EQ(lines, read_contexts(at));
+    };
+    EXPECT_TRUE(perf::scales_linearly("urcs_between_responses", 1 << 6, 1 << 10, workload));
+    EXPECT_NE(0, urc_count);
+}
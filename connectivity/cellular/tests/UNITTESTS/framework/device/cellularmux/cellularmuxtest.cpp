@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include <errno.h>
+#include <string.h>
+#include <deque>
+#include <vector>
+#include "CellularMux.h"
+#include "mbed_poll_stub.h"
+
+using namespace mbed;
+
+static uint8_t fcs_of(const uint8_t *data, size_t len)
+{
+    uint8_t fcs = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        fcs ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            fcs = (fcs & 1) ? (fcs >> 1) ^ 0xE0 : (fcs >> 1);
+        }
+    }
+    return 0xFF - fcs;
+}
+
+// serial line of a modem that answers SABM and DISC, with DM for the refused DLCI
+class MuxSerial : public FileHandle {
+public:
+    MuxSerial() : refused_dlci(0xFF) {}
+
+    ssize_t read(void *buffer, size_t size) override
+    {
+        if (rx.empty()) {
+            return -EAGAIN;
+        }
+        size_t len = 0;
+        while (len < size && !rx.empty()) {
+            ((uint8_t *)buffer)[len++] = rx.front();
+            rx.pop_front();
+        }
+        return len;
+    }
+
+    ssize_t write(const void *buffer, size_t size) override
+    {
+        tx.insert(tx.end(), (const uint8_t *)buffer, (const uint8_t *)buffer + size);
+        size_t n = tx.size();
+        if (n >= 6 && tx[n - 1] == 0xF9 && tx[n - 6] == 0xF9 && tx[n - 3] == 0x01) {
+            uint8_t control = tx[n - 4] & ~0x10;
+            uint8_t dlci = tx[n - 5] >> 2;
+            if (control == 0x2F || control == 0x43) {
+                inject(dlci, (dlci == refused_dlci) ? 0x1F : 0x73, NULL, 0);
+            }
+        }
+        return size;
+    }
+
+    off_t seek(off_t offset, int whence = SEEK_SET) override
+    {
+        return -ESPIPE;
+    }
+
+    int close() override
+    {
+        return 0;
+    }
+
+    short poll(short events) const override
+    {
+        return (rx.empty() ? 0 : POLLIN) | POLLOUT;
+    }
+
+    void inject(uint8_t dlci, uint8_t control, const uint8_t *info, size_t len)
+    {
+        uint8_t header[3] = { (uint8_t)((dlci << 2) | 0x01), control, (uint8_t)((len << 1) | 0x01) };
+        std::vector<uint8_t> fcs_data(header, header + 3);
+        if ((control & ~0x10) != 0xEF) {
+            fcs_data.insert(fcs_data.end(), info, info + len);
+        }
+        rx.push_back(0xF9);
+        rx.insert(rx.end(), header, header + 3);
+        rx.insert(rx.end(), info, info + len);
+        rx.push_back(fcs_of(fcs_data.data(), fcs_data.size()));
+        rx.push_back(0xF9);
+    }
+
+    std::vector<uint8_t> tx;
+    std::deque<uint8_t> rx;
+    uint8_t refused_dlci;
+};
+
+// AStyle ignored as the definition is not clear due to preprocessor usage
+// *INDENT-OFF*
+class TestCellularMux : public testing::Test {
+protected:
+
+    void SetUp()
+    {
+        mbed_poll_stub::int_value = 0;
+    }
+
+    void TearDown()
+    {
+    }
+};
+// *INDENT-ON*
+
+TEST_F(TestCellularMux, Create)
+{
+    MuxSerial serial;
+    CellularMux *mux = new CellularMux(&serial);
+    EXPECT_TRUE(mux != NULL);
+    EXPECT_TRUE(mux->get_file_handle() == &serial);
+    EXPECT_TRUE(mux->get_channel(0) == NULL);
+    EXPECT_TRUE(mux->get_channel(1) != NULL);
+    EXPECT_TRUE(mux->get_channel(MBED_CONF_CELLULAR_MUX_CHANNELS + 1) == NULL);
+    delete mux;
+    // never opened, nothing is sent
+    EXPECT_TRUE(serial.tx.empty());
+}
+
+TEST_F(TestCellularMux, test_CellularMux_open_close)
+{
+    MuxSerial serial;
+    CellularMux mux(&serial);
+
+    EXPECT_EQ(NSAPI_ERROR_OK, mux.open());
+    // SABM on DLCI 0, then on each channel
+    const uint8_t sabm0[] = { 0xF9, 0x03, 0x3F, 0x01, 0x1C, 0xF9 };
+    ASSERT_EQ(6 * (1 + MBED_CONF_CELLULAR_MUX_CHANNELS), serial.tx.size());
+    EXPECT_EQ(0, memcmp(serial.tx.data(), sabm0, sizeof(sabm0)));
+    EXPECT_EQ(0x07, serial.tx[7]);
+    EXPECT_EQ(0x3F, serial.tx[8]);
+    EXPECT_EQ(POLLOUT, mux.get_channel(1)->poll(POLLIN | POLLOUT));
+
+    serial.tx.clear();
+    mux.close();
+    // DISC on each channel, then CLD on DLCI 0
+    ASSERT_EQ(6 * MBED_CONF_CELLULAR_MUX_CHANNELS + 8, serial.tx.size());
+    EXPECT_EQ(0x53, serial.tx[2]);
+    const uint8_t *cld = serial.tx.data() + 6 * MBED_CONF_CELLULAR_MUX_CHANNELS;
+    EXPECT_EQ(0x03, cld[1]);
+    EXPECT_EQ(0xEF, cld[2]);
+    EXPECT_EQ(0xC3, cld[4]);
+    EXPECT_TRUE(mux.get_channel(1)->poll(POLLOUT) & POLLHUP);
+    EXPECT_EQ(-ENOTCONN, mux.get_channel(1)->write("AT", 2));
+}
+
+TEST_F(TestCellularMux, test_CellularMux_open_refused)
+{
+    MuxSerial serial;
+    CellularMux mux(&serial);
+
+    serial.refused_dlci = 1;
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, mux.open());
+    EXPECT_EQ(-ENOTCONN, mux.get_channel(1)->write("AT", 2));
+}
+
+TEST_F(TestCellularMux, test_CellularMux_channel_read_write)
+{
+    MuxSerial serial;
+    CellularMux mux(&serial);
+    ASSERT_EQ(NSAPI_ERROR_OK, mux.open());
+    serial.tx.clear();
+
+    FileHandle *ch = mux.get_channel(1);
+    EXPECT_EQ(3, ch->write("AT\r", 3));
+    ASSERT_EQ(9, serial.tx.size());
+    const uint8_t header[] = { 0x07, 0xEF, 0x07 };
+    EXPECT_EQ(0, memcmp(serial.tx.data() + 1, header, sizeof(header)));
+    EXPECT_EQ(0, memcmp(serial.tx.data() + 4, "AT\r", 3));
+    EXPECT_EQ(fcs_of(header, sizeof(header)), serial.tx[7]);
+
+    // written in frames of at most N1 bytes
+    serial.tx.clear();
+    uint8_t data[CELLULAR_MUX_FRAME_SIZE + 1] = { 0 };
+    EXPECT_EQ(sizeof(data), ch->write(data, sizeof(data)));
+    EXPECT_EQ(2 * 6 + sizeof(data), serial.tx.size());
+
+    // only the data of channel 1 is read from it, the frames of channel 2 are kept for it
+    serial.inject(2, 0xEF, (const uint8_t *)"two", 3);
+    serial.inject(1, 0xEF, (const uint8_t *)"OK\r\n", 4);
+    ch->set_blocking(false);
+    EXPECT_TRUE(ch->poll(POLLIN) & POLLIN);
+    char buf[16];
+    EXPECT_EQ(4, ch->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, "OK\r\n", 4));
+    EXPECT_EQ(-EAGAIN, ch->read(buf, sizeof(buf)));
+    EXPECT_EQ(3, mux.get_channel(2)->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, "two", 3));
+
+    // a frame with a bad FCS is dropped
+    serial.inject(1, 0xEF, (const uint8_t *)"OK", 2);
+    serial.rx[serial.rx.size() - 2] ^= 0xFF;
+    EXPECT_EQ(-EAGAIN, ch->read(buf, sizeof(buf)));
+
+    // the modem closes the channel
+    serial.inject(1, 0x53, NULL, 0);
+    EXPECT_EQ(0, ch->read(buf, sizeof(buf)));
+}
@@ -0,0 +1,35 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  ../platform
+  ../connectivity/cellular/tests/UNITTESTS/framework/common/util
+  ../connectivity/cellular/include/cellular/framework/common
+  ../connectivity/cellular/include/cellular/framework/device
+)
+
+# Source files
+set(unittest-sources
+  ../connectivity/cellular/source/framework/device/CellularMux.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/cellularmuxtest.cpp
+  stubs/FileHandle_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_poll_stub.cpp
+  stubs/Kernel_stub.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_rtos_rtx_stub.c
+  stubs/rtx_mutex_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_CELLULAR_MUX_CHANNELS=2
+  -DMBED_CONF_CELLULAR_MUX_BUFFER_SIZE=256
+)
@@ -407,3 +407,49 @@ TEST_F(TestCellularStateMachine, test_run_to_state)
 
 
 
+
+TEST_F(TestCellularStateMachine, test_fast_reattach)
+{
+    UT_CellularStateMachine ut;
+    FileHandle_stub fh1;
+
+    CellularDevice *dev = new AT_CellularDevice(&fh1);
+    EXPECT_TRUE(dev);
+
+    CellularStateMachine *stm = ut.create_state_machine(*dev, *dev->get_queue(), *dev->open_network());
+    EXPECT_TRUE(stm);
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.start_dispatch());
+
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    ut.set_cellular_callback(&cellular_callback);
+
+    AT_CellularNetwork_stub::attach_status = CellularNetwork::Attached;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    UT_CellularState current_state;
+    UT_CellularState target_state;
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_ATTACHING_NETWORK, current_state);
+    ut.reset();
+
+    // still attached, SIM is not read again
+    AT_CellularDevice_stub::get_sim_failure_count = 100;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_ATTACHING_NETWORK, current_state);
+    ut.reset();
+
+    // detached meanwhile, all states are run
+    AT_CellularNetwork_stub::attach_status = CellularNetwork::Detached;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_SIM_PIN, current_state);
+    ut.reset();
+
+    AT_CellularDevice_stub::get_sim_failure_count = 0;
+    ut.delete_state_machine();
+
+    delete dev;
+    dev = NULL;
+}
@@ -52,4 +52,5 @@ set(unittest-test-flags
   -DDEVICE_SERIAL=1
   -DDEVICE_INTERRUPTIN=1
   -DMBED_CONF_CELLULAR_USE_SMS=1
+  -DMBED_CONF_CELLULAR_FAST_REATTACH=1
 )
@@ -0,0 +1,378 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include <string.h>
+
+#include "mbed_interface.h"
+#include "rtos/ThisThread.h"
+
+#include "usbcdc_ecm_emac.h"
+
+using namespace std::chrono;
+
+#define USB_ECM_EMAC_IF_NAME        "ue"
+
+#define FLAG_RX                     (1 << 0)
+#define FLAG_LINK                   (1 << 1)
+
+/* Retry period while the pool is too short to allocate receive buffers */
+#define RX_REFILL_RETRY             10ms
+
+USBCDC_ECM_EMAC::USBCDC_ECM_EMAC(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
+    : USBCDC_ECM(phy, vendor_id, product_id, product_release),
+      _thread(osPriorityNormal, MBED_CONF_USB_ECM_EMAC_THREAD_STACKSIZE, NULL, "usb_ecm_emac")
+{
+    char mac[USB_ECM_EMAC_HWADDR_SIZE];
+
+    /* The host end of the link uses the board address, see string_iconfiguration_desc() */
+    mbed_mac_address(mac);
+    memcpy(_hwaddr, mac, sizeof(_hwaddr));
+    _hwaddr[USB_ECM_EMAC_HWADDR_SIZE - 1] ^= 0x01;
+
+    init();
+}
+
+USBCDC_ECM_EMAC::~USBCDC_ECM_EMAC()
+{
+    deinit();
+}
+
+uint32_t USBCDC_ECM_EMAC::get_mtu_size() const
+{
+    return USB_ECM_EMAC_MTU_SIZE;
+}
+
+uint32_t USBCDC_ECM_EMAC::get_align_preference() const
+{
+    return 0;
+}
+
+void USBCDC_ECM_EMAC::get_ifname(char *name, uint8_t size) const
+{
+    memcpy(name, USB_ECM_EMAC_IF_NAME, (size < sizeof(USB_ECM_EMAC_IF_NAME)) ? size : sizeof(USB_ECM_EMAC_IF_NAME));
+}
+
+uint8_t USBCDC_ECM_EMAC::get_hwaddr_size() const
+{
+    return USB_ECM_EMAC_HWADDR_SIZE;
+}
+
+bool USBCDC_ECM_EMAC::get_hwaddr(uint8_t *addr) const
+{
+    memcpy(addr, _hwaddr, USB_ECM_EMAC_HWADDR_SIZE);
+    return true;
+}
+
+void USBCDC_ECM_EMAC::set_hwaddr(const uint8_t *addr)
+{
+    memcpy(_hwaddr, addr, USB_ECM_EMAC_HWADDR_SIZE);
+}
+
+bool USBCDC_ECM_EMAC::link_out(emac_mem_buf_t *buf)
+{
+    if (_memory_manager->get_total_len(buf) > USB_ECM_EMAC_FRAME_SIZE) {
+        _memory_manager->free(buf);
+        return false;
+    }
+
+    bool ret = true;
+    uint32_t packet_len = 0;
+
+    write_lock();
+
+    /* Full packets are sent in place, only the ones straddling two buffers
+     * of the chain are assembled in _tx_packet */
+    for (emac_mem_buf_t *seg = buf; seg && ret; seg = _memory_manager->get_next(seg)) {
+        const uint8_t *ptr = static_cast<const uint8_t *>(_memory_manager->get_ptr(seg));
+        uint32_t len = _memory_manager->get_len(seg);
+
+        if (packet_len) {
+            uint32_t copy = MAX_PACKET_SIZE_BULK - packet_len;
+            if (copy > len) {
+                copy = len;
+            }
+            memcpy(_tx_packet + packet_len, ptr, copy);
+            packet_len += copy;
+            ptr += copy;
+            len -= copy;
+            if (packet_len < MAX_PACKET_SIZE_BULK) {
+                continue;
+            }
+            ret = write_packet(_tx_packet, MAX_PACKET_SIZE_BULK);
+            packet_len = 0;
+        }
+
+        while (ret && len >= MAX_PACKET_SIZE_BULK) {
+            ret = write_packet(ptr, MAX_PACKET_SIZE_BULK);
+            ptr += MAX_PACKET_SIZE_BULK;
+            len -= MAX_PACKET_SIZE_BULK;
+        }
+
+        memcpy(_tx_packet, ptr, len);
+        packet_len = len;
+    }
+
+    /* Short packet ending the frame, zero length if the frame is a multiple
+     * of the packet size */
+    if (ret) {
+        ret = write_packet(_tx_packet, packet_len);
+    }
+
+    write_unlock();
+
+    _memory_manager->free(buf);
+    return ret;
+}
+
+bool USBCDC_ECM_EMAC::power_up()
+{
+    if (!_memory_manager) {
+        return false;
+    }
+
+    if (_thread.get_state() == rtos::Thread::Inactive) {
+        if (_thread.start(mbed::callback(this, &USBCDC_ECM_EMAC::thread_function)) != osOK) {
+            return false;
+        }
+    }
+
+    _powered = true;
+    _thread.flags_set(FLAG_RX);
+    connect();
+    return true;
+}
+
+void USBCDC_ECM_EMAC::power_down()
+{
+    _powered = false;
+    disconnect();
+
+    lock();
+    emac_mem_buf_t *frame = _rx_frame;
+    _rx_frame = nullptr;
+    _rx_seg = nullptr;
+    unlock();
+
+    if (frame) {
+        _memory_manager->free(frame);
+    }
+
+    emac_mem_buf_t *buf;
+    while (_rx_free.pop(buf)) {
+        _memory_manager->free(buf);
+    }
+
+    rx_frame_t received;
+    while (_rx_frames.pop(received)) {
+        _memory_manager->free(received.buf);
+    }
+}
+
+void USBCDC_ECM_EMAC::set_link_input_cb(emac_link_input_cb_t input_cb)
+{
+    _emac_link_input_cb = input_cb;
+}
+
+void USBCDC_ECM_EMAC::set_link_state_cb(emac_link_state_change_cb_t state_cb)
+{
+    _emac_link_state_cb = state_cb;
+}
+
+void USBCDC_ECM_EMAC::add_multicast_group(const uint8_t *address)
+{
+    /* The host forwards all multicasts, nothing to configure */
+}
+
+void USBCDC_ECM_EMAC::remove_multicast_group(const uint8_t *address)
+{
+}
+
+void USBCDC_ECM_EMAC::set_all_multicast(bool all)
+{
+}
+
+void USBCDC_ECM_EMAC::set_memory_manager(EMACMemoryManager &mem_mngr)
+{
+    _memory_manager = &mem_mngr;
+}
+
+void USBCDC_ECM_EMAC::callback_state_change(DeviceState new_state)
+{
+    USBCDC_ECM::callback_state_change(new_state);
+
+    if (new_state != Configured) {
+        /* Drop the frame being received, the buffer is kept for the next one */
+        rx_frame_reset();
+        if (_link_up) {
+            _link_up = false;
+            _thread.flags_set(FLAG_LINK);
+        }
+    }
+}
+
+void USBCDC_ECM_EMAC::callback_set_interface(uint16_t interface, uint8_t alternate)
+{
+    USBCDC_ECM::callback_set_interface(interface, alternate);
+
+    if (alternate && !_link_up) {
+        _link_up = true;
+        _thread.flags_set(FLAG_LINK);
+    }
+}
+
+void USBCDC_ECM_EMAC::rx_frame_reset()
+{
+    _rx_seg = _rx_frame;
+    _rx_seg_pos = 0;
+    _rx_len = 0;
+    _rx_overflow = false;
+}
+
+void USBCDC_ECM_EMAC::rx_advance(uint32_t size)
+{
+    _rx_seg_pos += size;
+    _rx_len += size;
+    while (_rx_seg && _rx_seg_pos == _memory_manager->get_len(_rx_seg)) {
+        _rx_seg = _memory_manager->get_next(_rx_seg);
+        _rx_seg_pos = 0;
+    }
+}
+
+uint8_t *USBCDC_ECM_EMAC::rx_buffer()
+{
+    if (!_rx_frame) {
+        if (!_rx_free.pop(_rx_frame)) {
+            /* Held until the thread allocates buffers */
+            return nullptr;
+        }
+        rx_frame_reset();
+    }
+
+    if (!_rx_overflow && _rx_seg &&
+            _memory_manager->get_len(_rx_seg) - _rx_seg_pos >= MAX_PACKET_SIZE_BULK) {
+        return static_cast<uint8_t *>(_memory_manager->get_ptr(_rx_seg)) + _rx_seg_pos;
+    }
+
+    /* Packet straddling two buffers of the chain, or being discarded */
+    return _rx_bounce;
+}
+
+void USBCDC_ECM_EMAC::callback_rx_packet(uint8_t *buffer, uint32_t size, bool end)
+{
+    assert_locked();
+
+    if (buffer != _rx_bounce) {
+        rx_advance(size);
+    } else {
+        while (size && _rx_seg && !_rx_overflow) {
+            uint32_t copy = _memory_manager->get_len(_rx_seg) - _rx_seg_pos;
+            if (copy > size) {
+                copy = size;
+            }
+            memcpy(static_cast<uint8_t *>(_memory_manager->get_ptr(_rx_seg)) + _rx_seg_pos, buffer, copy);
+            buffer += copy;
+            size -= copy;
+            rx_advance(copy);
+        }
+        if (size) {
+            _rx_overflow = true;
+        }
+    }
+
+    if (!end) {
+        return;
+    }
+
+    if (!_rx_overflow && _rx_len && !_rx_frames.full()) {
+        rx_frame_t received = { _rx_frame, _rx_len };
+        _rx_frames.push(received);
+        _rx_frame = nullptr;
+        _thread.flags_set(FLAG_RX);
+    } else {
+        /* Dropped, the buffer is reused for the next frame */
+        rx_frame_reset();
+    }
+}
+
+void USBCDC_ECM_EMAC::deliver_frame(emac_mem_buf_t *buf, uint32_t len)
+{
+    /* Trim the buffers to the frame, those past its end are left empty */
+    uint32_t head_len = 0;
+    for (emac_mem_buf_t *seg = buf; seg; seg = _memory_manager->get_next(seg)) {
+        uint32_t seg_len = _memory_manager->get_len(seg);
+        if (seg_len > len) {
+            seg_len = len;
+        }
+        _memory_manager->set_len(seg, seg_len);
+        if (seg == buf) {
+            head_len = seg_len;
+        }
+        len -= seg_len;
+    }
+    /* Recompute the total lengths of the chain from its head */
+    _memory_manager->set_len(buf, head_len);
+
+    if (_emac_link_input_cb) {
+        _emac_link_input_cb(buf);
+    } else {
+        _memory_manager->free(buf);
+    }
+}
+
+bool USBCDC_ECM_EMAC::refill_rx_buffers()
+{
+    while (_powered && !_rx_free.full()) {
+        emac_mem_buf_t *buf = _memory_manager->alloc_pool(USB_ECM_EMAC_FRAME_SIZE, 0);
+        if (!buf) {
+            return false;
+        }
+        _rx_free.push(buf);
+    }
+    return true;
+}
+
+void USBCDC_ECM_EMAC::thread_function()
+{
+    bool refilled = true;
+
+    while (true) {
+        uint32_t flags;
+        if (refilled) {
+            flags = rtos::ThisThread::flags_wait_any(FLAG_RX | FLAG_LINK);
+        } else {
+            flags = rtos::ThisThread::flags_wait_any_for(FLAG_RX | FLAG_LINK, RX_REFILL_RETRY);
+        }
+
+        if (flags & FLAG_LINK) {
+            if (_emac_link_state_cb) {
+                _emac_link_state_cb(_link_up);
+            }
+        }
+
+        rx_frame_t received;
+        while (_rx_frames.pop(received)) {
+            deliver_frame(received.buf, received.len);
+        }
+
+        refilled = refill_rx_buffers();
+        if (_powered) {
+            restart_rx();
+        }
+    }
+}
+#endif // defined(MBED_CONF_RTOS_PRESENT)
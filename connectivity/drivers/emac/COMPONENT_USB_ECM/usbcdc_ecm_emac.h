@@ -0,0 +1,211 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USBCDC_ECM_EMAC_H
+#define USBCDC_ECM_EMAC_H
+
+#include "EMAC.h"
+#include "USBCDC_ECM.h"
+#include "usb_phy_api.h"
+#include "platform/CircularBuffer.h"
+#include "rtos/Thread.h"
+
+#define USB_ECM_EMAC_HWADDR_SIZE    (6)
+#define USB_ECM_EMAC_MTU_SIZE       (1500)
+#define USB_ECM_EMAC_FRAME_SIZE     (1514)
+
+/** Ethernet over USB interface, for the network stack
+ *
+ * The device enumerates as a CDC ECM network adapter and the host sees it
+ * as one end of an Ethernet link. Frames are not buffered by USBCDC_ECM:
+ * bulk OUT packets are read in place into buffers allocated ahead from the
+ * memory manager pool, and frames to send are written to the bulk IN
+ * endpoint straight from the buffer chain, only packets straddling two
+ * buffers of the chain being assembled.
+ *
+ * @code
+ * USBCDC_ECM_EMAC emac;
+ * EMACInterface net(emac, OnboardNetworkStack::get_default_instance());
+ *
+ * net.set_network("192.168.7.2", "255.255.255.0", "192.168.7.1");
+ * net.connect();
+ * @endcode
+ */
+class USBCDC_ECM_EMAC : public EMAC, public USBCDC_ECM {
+public:
+    /**
+     * Construct the interface, the device connects to the host on power_up()
+     *
+     * @param phy USB phy to use
+     * @param vendor_id Your vendor_id
+     * @param product_id Your product_id
+     * @param product_release Your product_release
+     */
+    USBCDC_ECM_EMAC(USBPhy *phy = get_usb_phy(), uint16_t vendor_id = 0x0700, uint16_t product_id = 0x0101, uint16_t product_release = 0x0001);
+
+    virtual ~USBCDC_ECM_EMAC();
+
+    /**
+     * Return maximum transmission unit
+     *
+     * @return     MTU in bytes
+     */
+    virtual uint32_t get_mtu_size() const;
+
+    /**
+     * Gets memory buffer alignment preference
+     *
+     * @return         Memory alignment requirement in bytes
+     */
+    virtual uint32_t get_align_preference() const;
+
+    /**
+     * Return interface name
+     *
+     * @param name Pointer to where the name should be written
+     * @param size Maximum number of character to copy
+     */
+    virtual void get_ifname(char *name, uint8_t size) const;
+
+    /**
+     * Returns size of the underlying interface HW address size.
+     *
+     * @return     HW address size in bytes
+     */
+    virtual uint8_t get_hwaddr_size() const;
+
+    /**
+     * Return interface-supplied HW address
+     *
+     * The address is derived from mbed_mac_address(), which the device
+     * reports to the host as the address of the host end of the link.
+     *
+     * @param addr HW address for underlying interface
+     * @return     true if HW address is available
+     */
+    virtual bool get_hwaddr(uint8_t *addr) const;
+
+    /**
+     * Set HW address for interface
+     *
+     * @param addr Address to be set
+     */
+    virtual void set_hwaddr(const uint8_t *addr);
+
+    /**
+     * Sends the packet over the link
+     *
+     * That can not be called from an interrupt context.
+     *
+     * @param buf  Packet to be send
+     * @return     True if the packet was send successfully, False otherwise
+     */
+    virtual bool link_out(emac_mem_buf_t *buf);
+
+    /**
+     * Connects the device to the host
+     *
+     * @return True on success, False in case of an error.
+     */
+    virtual bool power_up();
+
+    /**
+     * Disconnects the device from the host
+     */
+    virtual void power_down();
+
+    /**
+     * Sets a callback that needs to be called for packets received for that
+     * interface
+     *
+     * @param input_cb Function to be register as a callback
+     */
+    virtual void set_link_input_cb(emac_link_input_cb_t input_cb);
+
+    /**
+     * Sets a callback that needs to be called on link status changes for given
+     * interface
+     *
+     * @param state_cb Function to be register as a callback
+     */
+    virtual void set_link_state_cb(emac_link_state_change_cb_t state_cb);
+
+    /** Add device to a multicast group
+     *
+     * @param address  A multicast group hardware address
+     */
+    virtual void add_multicast_group(const uint8_t *address);
+
+    /** Remove device from a multicast group
+     *
+     * @param address  A multicast group hardware address
+     */
+    virtual void remove_multicast_group(const uint8_t *address);
+
+    /** Request reception of all multicast packets
+     *
+     * @param all True to receive all multicasts
+     *            False to receive only multicasts addressed to specified groups
+     */
+    virtual void set_all_multicast(bool all);
+
+    /** Sets memory manager that is used to handle memory buffers
+     *
+     * @param mem_mngr Pointer to memory manager
+     */
+    virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
+
+protected:
+    virtual void callback_state_change(DeviceState new_state);
+    virtual void callback_set_interface(uint16_t interface, uint8_t alternate);
+    virtual uint8_t *rx_buffer();
+    virtual void callback_rx_packet(uint8_t *buffer, uint32_t size, bool end);
+
+private:
+    struct rx_frame_t {
+        emac_mem_buf_t *buf;
+        uint32_t len;
+    };
+
+    void thread_function();
+    void deliver_frame(emac_mem_buf_t *buf, uint32_t len);
+    bool refill_rx_buffers();
+    void rx_frame_reset();
+    void rx_advance(uint32_t size);
+
+    rtos::Thread _thread;
+    EMACMemoryManager *_memory_manager = nullptr;
+    emac_link_input_cb_t _emac_link_input_cb;
+    emac_link_state_change_cb_t _emac_link_state_cb;
+    uint8_t _hwaddr[USB_ECM_EMAC_HWADDR_SIZE];
+    volatile bool _powered = false;
+    volatile bool _link_up = false;
+
+    // Reception state, updated in ISR context
+    mbed::CircularBuffer<emac_mem_buf_t *, MBED_CONF_USB_ECM_EMAC_RX_BUFFERS> _rx_free;
+    mbed::CircularBuffer<rx_frame_t, MBED_CONF_USB_ECM_EMAC_RX_BUFFERS> _rx_frames;
+    emac_mem_buf_t *_rx_frame = nullptr;
+    emac_mem_buf_t *_rx_seg = nullptr;
+    uint32_t _rx_seg_pos = 0;
+    uint32_t _rx_len = 0;
+    bool _rx_overflow = false;
+    uint8_t _rx_bounce[MAX_PACKET_SIZE_BULK];
+
+    uint8_t _tx_packet[MAX_PACKET_SIZE_BULK];
+};
+
+#endif /* USBCDC_ECM_EMAC_H */
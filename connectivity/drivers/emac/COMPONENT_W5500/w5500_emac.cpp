@@ -0,0 +1,602 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include <string.h>
+
+#include "mbed_interface.h"
+#include "rtos/Kernel.h"
+#include "rtos/ThisThread.h"
+#include "netsocket/EthernetInterface.h"
+
+#include "w5500_emac.h"
+
+using namespace std::chrono;
+
+#define W5500_EMAC_IF_NAME          "wz"
+
+#define FLAG_RX                     (1 << 0)
+#define FLAG_LINK                   (1 << 1)
+
+/* Period of the link state polling, the chip has no link interrupt */
+#define LINK_POLL_PERIOD            500ms
+/* Retry period while the pool is too short to allocate receive buffers */
+#define RX_REFILL_RETRY             10ms
+/* Longest time a frame takes to be sent */
+#define TX_TIMEOUT                  100ms
+/* Time taken by the chip to come out of reset */
+#define RESET_TIME                  2ms
+
+#define W5500_ASYNC_TRANSFER_MIN_SIZE   32
+/* Time after which an asynchronous SPI transfer that did not complete is aborted */
+#define TRANSFER_TIMEOUT            100ms
+
+/* SPI frame control byte */
+#define CONTROL_BSB_SHIFT           3
+#define CONTROL_WRITE               0x04
+
+/* Blocks: common registers, and registers and memory of socket 0 */
+#define BLOCK_COMMON                0x00
+#define BLOCK_S0_REG                0x01
+#define BLOCK_S0_TX                 0x02
+#define BLOCK_S0_RX                 0x03
+#define BLOCK_SOCKET_REG(n)         (((n) << 2) + 1)
+#define SOCKETS                     8
+
+/* Common registers */
+#define REG_MR                      0x0000
+#define REG_SHAR                    0x0009
+#define REG_SIMR                    0x0018
+#define REG_PHYCFGR                 0x002E
+#define REG_VERSIONR                0x0039
+
+#define MR_RST                      0x80
+#define PHYCFGR_LNK                 0x01
+#define VERSION                     0x04
+
+/* Socket registers */
+#define REG_SN_MR                   0x0000
+#define REG_SN_CR                   0x0001
+#define REG_SN_IR                   0x0002
+#define REG_SN_SR                   0x0003
+#define REG_SN_RXBUF_SIZE           0x001E
+#define REG_SN_TXBUF_SIZE           0x001F
+#define REG_SN_TX_WR                0x0024
+#define REG_SN_RX_RSR               0x0026
+#define REG_SN_RX_RD                0x0028
+#define REG_SN_IMR                  0x002C
+
+#define SN_MR_MACRAW                0x04
+#define SN_MR_MFEN                  0x80
+#define SN_CR_OPEN                  0x01
+#define SN_CR_CLOSE                 0x10
+#define SN_CR_SEND                  0x20
+#define SN_CR_RECV                  0x40
+#define SN_IR_SEND_OK               0x10
+#define SN_IR_RECV                  0x04
+#define SN_SR_MACRAW                0x42
+
+/* All the memory of the chip for socket 0, in KB */
+#define SOCKET_MEMORY_SIZE          16
+
+/* Polls of the command register before giving up on a command */
+#define COMMAND_POLLS               1000
+
+/* Each received frame starts with its length, header included */
+#define RX_HEADER_SIZE              2
+
+W5500_EMAC::W5500_EMAC(PinName mosi, PinName miso, PinName sclk, PinName cs, PinName irq, PinName reset, int frequency)
+    : _spi(mosi, miso, sclk),
+      _cs(cs, 1),
+      _irq(irq),
+      _reset(reset),
+#if W5500_ASYNC_TRANSFER
+      _transfer_done(0),
+#endif
+      _thread(osPriorityNormal, MBED_CONF_W5500_EMAC_THREAD_STACKSIZE, NULL, "w5500_emac")
+{
+    char mac[W5500_EMAC_HWADDR_SIZE];
+    mbed_mac_address(mac);
+    memcpy(_hwaddr, mac, sizeof(_hwaddr));
+
+    _spi.format(8, 0);
+    _spi.frequency(frequency);
+    _spi.set_default_write_value(0);
+#if W5500_ASYNC_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
+}
+
+W5500_EMAC::~W5500_EMAC()
+{
+    power_down();
+}
+
+uint32_t W5500_EMAC::get_mtu_size() const
+{
+    return W5500_EMAC_MTU_SIZE;
+}
+
+uint32_t W5500_EMAC::get_align_preference() const
+{
+    return 0;
+}
+
+void W5500_EMAC::get_ifname(char *name, uint8_t size) const
+{
+    memcpy(name, W5500_EMAC_IF_NAME, (size < sizeof(W5500_EMAC_IF_NAME)) ? size : sizeof(W5500_EMAC_IF_NAME));
+}
+
+uint8_t W5500_EMAC::get_hwaddr_size() const
+{
+    return W5500_EMAC_HWADDR_SIZE;
+}
+
+bool W5500_EMAC::get_hwaddr(uint8_t *addr) const
+{
+    memcpy(addr, _hwaddr, W5500_EMAC_HWADDR_SIZE);
+    return true;
+}
+
+void W5500_EMAC::set_hwaddr(const uint8_t *addr)
+{
+    memcpy(_hwaddr, addr, W5500_EMAC_HWADDR_SIZE);
+
+    if (_powered) {
+        _spi_mutex.lock();
+        write_buffer(REG_SHAR, BLOCK_COMMON, _hwaddr, W5500_EMAC_HWADDR_SIZE);
+        _spi_mutex.unlock();
+    }
+}
+
+bool W5500_EMAC::link_out(emac_mem_buf_t *buf)
+{
+    uint32_t len = _memory_manager->get_total_len(buf);
+    if (!_powered || !_link_up || len > W5500_EMAC_FRAME_SIZE) {
+        _memory_manager->free(buf);
+        return false;
+    }
+
+    bool ret = true;
+
+    _spi_mutex.lock();
+
+    /* The frame is written from the buffer chain in one SPI frame, past the
+     * frame being sent if any: there is room for both in the memory */
+    uint16_t wr = read_reg16(REG_SN_TX_WR, BLOCK_S0_REG);
+    spi_begin(wr, BLOCK_S0_TX, true);
+    for (emac_mem_buf_t *seg = buf; seg; seg = _memory_manager->get_next(seg)) {
+        spi_burst(static_cast<const uint8_t *>(_memory_manager->get_ptr(seg)), NULL, _memory_manager->get_len(seg));
+    }
+    spi_end();
+
+    /* A single frame is sent at a time */
+    if (_tx_pending) {
+        auto deadline = rtos::Kernel::Clock::now() + TX_TIMEOUT;
+        while (!(read_reg(REG_SN_IR, BLOCK_S0_REG) & SN_IR_SEND_OK)) {
+            if (rtos::Kernel::Clock::now() > deadline) {
+                /* The chip is stuck, start over */
+                open_socket();
+                ret = false;
+                break;
+            }
+        }
+        write_reg(REG_SN_IR, BLOCK_S0_REG, SN_IR_SEND_OK);
+        _tx_pending = false;
+    }
+
+    if (ret) {
+        write_reg16(REG_SN_TX_WR, BLOCK_S0_REG, wr + len);
+        ret = exec_command(SN_CR_SEND);
+        _tx_pending = ret;
+    }
+
+    _spi_mutex.unlock();
+
+    _memory_manager->free(buf);
+    return ret;
+}
+
+bool W5500_EMAC::power_up()
+{
+    if (!_memory_manager) {
+        return false;
+    }
+
+    _spi_mutex.lock();
+
+    if (_reset != NC) {
+        mbed::DigitalOut reset(_reset, 0);
+        rtos::ThisThread::sleep_for(1ms);
+        reset = 1;
+        rtos::ThisThread::sleep_for(RESET_TIME);
+    }
+
+    write_reg(REG_MR, BLOCK_COMMON, MR_RST);
+    rtos::ThisThread::sleep_for(RESET_TIME);
+
+    bool ok = !(read_reg(REG_MR, BLOCK_COMMON) & MR_RST) &&
+              read_reg(REG_VERSIONR, BLOCK_COMMON) == VERSION;
+    if (ok) {
+        write_buffer(REG_SHAR, BLOCK_COMMON, _hwaddr, W5500_EMAC_HWADDR_SIZE);
+
+        /* Other sockets first, the sizes must never add up to more than the memory */
+        for (int n = 1; n < SOCKETS; n++) {
+            write_reg(REG_SN_RXBUF_SIZE, BLOCK_SOCKET_REG(n), 0);
+            write_reg(REG_SN_TXBUF_SIZE, BLOCK_SOCKET_REG(n), 0);
+        }
+        write_reg(REG_SN_RXBUF_SIZE, BLOCK_S0_REG, SOCKET_MEMORY_SIZE);
+        write_reg(REG_SN_TXBUF_SIZE, BLOCK_S0_REG, SOCKET_MEMORY_SIZE);
+
+        ok = open_socket();
+    }
+    if (ok) {
+        write_reg(REG_SN_IMR, BLOCK_S0_REG, SN_IR_RECV);
+        write_reg(REG_SIMR, BLOCK_COMMON, 0x01);
+    }
+
+    _spi_mutex.unlock();
+
+    if (!ok) {
+        return false;
+    }
+
+    if (_thread.get_state() == rtos::Thread::Inactive) {
+        if (_thread.start(mbed::callback(this, &W5500_EMAC::thread_function)) != osOK) {
+            return false;
+        }
+    }
+
+    _powered = true;
+    _irq.fall(mbed::callback(this, &W5500_EMAC::irq_handler));
+    /* Frames received before the interrupt was attached raised no edge */
+    _thread.flags_set(FLAG_RX | FLAG_LINK);
+    return true;
+}
+
+void W5500_EMAC::power_down()
+{
+    if (!_powered) {
+        return;
+    }
+    _powered = false;
+    _irq.fall(nullptr);
+
+    _spi_mutex.lock();
+    write_reg(REG_SIMR, BLOCK_COMMON, 0);
+    exec_command(SN_CR_CLOSE);
+    _tx_pending = false;
+    _spi_mutex.unlock();
+
+    _link_up = false;
+}
+
+void W5500_EMAC::set_link_input_cb(emac_link_input_cb_t input_cb)
+{
+    _emac_link_input_cb = input_cb;
+}
+
+bool W5500_EMAC::set_link_input_batch_cb(emac_link_input_batch_cb_t input_cb, uint32_t budget)
+{
+    _rx_budget = budget < W5500_EMAC_RX_BATCH ? budget : W5500_EMAC_RX_BATCH;
+    if (_rx_budget == 0) {
+        _rx_budget = 1;
+    }
+    _emac_link_input_batch_cb = input_cb;
+    return true;
+}
+
+void W5500_EMAC::set_link_state_cb(emac_link_state_change_cb_t state_cb)
+{
+    _emac_link_state_cb = state_cb;
+}
+
+void W5500_EMAC::add_multicast_group(const uint8_t *address)
+{
+    /* No multicast filter, all multicasts are received */
+}
+
+void W5500_EMAC::remove_multicast_group(const uint8_t *address)
+{
+}
+
+void W5500_EMAC::set_all_multicast(bool all)
+{
+}
+
+void W5500_EMAC::set_memory_manager(EMACMemoryManager &mem_mngr)
+{
+    _memory_manager = &mem_mngr;
+}
+
+void W5500_EMAC::irq_handler()
+{
+    _thread.flags_set(FLAG_RX);
+}
+
+bool W5500_EMAC::open_socket()
+{
+    exec_command(SN_CR_CLOSE);
+    /* MAC filter: only broadcasts, multicasts and frames to our address */
+    write_reg(REG_SN_MR, BLOCK_S0_REG, SN_MR_MACRAW | SN_MR_MFEN);
+    exec_command(SN_CR_OPEN);
+    write_reg(REG_SN_IR, BLOCK_S0_REG, 0xFF);
+    _tx_pending = false;
+    return read_reg(REG_SN_SR, BLOCK_S0_REG) == SN_SR_MACRAW;
+}
+
+bool W5500_EMAC::check_link()
+{
+    _spi_mutex.lock();
+    bool up = read_reg(REG_PHYCFGR, BLOCK_COMMON) & PHYCFGR_LNK;
+    _spi_mutex.unlock();
+
+    if (up != _link_up) {
+        _link_up = up;
+        if (_emac_link_state_cb) {
+            _emac_link_state_cb(up);
+        }
+    }
+    return up;
+}
+
+uint32_t W5500_EMAC::receive_frames(emac_mem_buf_t **frames, uint32_t count)
+{
+    uint32_t received = 0;
+    bool resync = false;
+
+    _spi_mutex.lock();
+
+    /* Frames are read from the receive memory in the order they came, the
+     * memory is given back with a single command for all of them */
+    uint16_t available = read_rx_size();
+    uint16_t rd = read_reg16(REG_SN_RX_RD, BLOCK_S0_REG);
+    uint16_t start = rd;
+
+    while (received < count && available >= RX_HEADER_SIZE) {
+        uint8_t header[RX_HEADER_SIZE];
+        read_buffer(rd, BLOCK_S0_RX, header, RX_HEADER_SIZE);
+        uint16_t size = (header[0] << 8) | header[1];
+        if (size <= RX_HEADER_SIZE || size > available || size - RX_HEADER_SIZE > W5500_EMAC_FRAME_SIZE) {
+            /* Lost track of the frames, start over with an empty memory */
+            resync = true;
+            break;
+        }
+
+        emac_mem_buf_t *buf = _memory_manager->alloc_pool(size - RX_HEADER_SIZE, 0);
+        if (!buf) {
+            /* Left in the chip until the pool has buffers again */
+            break;
+        }
+
+        spi_begin(rd + RX_HEADER_SIZE, BLOCK_S0_RX, false);
+        for (emac_mem_buf_t *seg = buf; seg; seg = _memory_manager->get_next(seg)) {
+            spi_burst(NULL, static_cast<uint8_t *>(_memory_manager->get_ptr(seg)), _memory_manager->get_len(seg));
+        }
+        spi_end();
+
+        frames[received++] = buf;
+        rd += size;
+        available -= size;
+    }
+
+    if (resync) {
+        open_socket();
+    } else if (rd != start) {
+        write_reg16(REG_SN_RX_RD, BLOCK_S0_REG, rd);
+        exec_command(SN_CR_RECV);
+    }
+
+    if (received < count) {
+        /* Ends the interrupt, the frames received meanwhile raise it again */
+        write_reg(REG_SN_IR, BLOCK_S0_REG, SN_IR_RECV);
+    }
+
+    _spi_mutex.unlock();
+
+    return received;
+}
+
+void W5500_EMAC::deliver_frames(emac_mem_buf_t **frames, uint32_t count)
+{
+    if (_emac_link_input_batch_cb) {
+        _emac_link_input_batch_cb(frames, count);
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (_emac_link_input_cb) {
+            _emac_link_input_cb(frames[i]);
+        } else {
+            _memory_manager->free(frames[i]);
+        }
+    }
+}
+
+void W5500_EMAC::thread_function()
+{
+    emac_mem_buf_t *frames[W5500_EMAC_RX_BATCH];
+    auto next_link_check = rtos::Kernel::Clock::now();
+    bool retry = false;
+
+    while (true) {
+        rtos::ThisThread::flags_wait_any_for(FLAG_RX | FLAG_LINK, retry ? RX_REFILL_RETRY : LINK_POLL_PERIOD);
+
+        if (!_powered) {
+            retry = false;
+            continue;
+        }
+
+        auto now = rtos::Kernel::Clock::now();
+        if (now >= next_link_check) {
+            check_link();
+            next_link_check = now + LINK_POLL_PERIOD;
+        }
+
+        uint32_t budget = _rx_budget;
+        uint32_t count = receive_frames(frames, budget);
+        if (count) {
+            deliver_frames(frames, count);
+        }
+
+        if (count == budget) {
+            /* More frames may be waiting: poll again without the interrupt */
+            _thread.flags_set(FLAG_RX);
+            retry = false;
+        } else {
+            /* Short batch with frames left in the chip if the pool is empty */
+            retry = true;
+            _spi_mutex.lock();
+            if (read_rx_size() < RX_HEADER_SIZE) {
+                retry = false;
+            }
+            _spi_mutex.unlock();
+        }
+    }
+}
+
+void W5500_EMAC::spi_begin(uint16_t address, uint8_t block, bool write)
+{
+    const uint8_t header[3] = {
+        static_cast<uint8_t>(address >> 8),
+        static_cast<uint8_t>(address),
+        static_cast<uint8_t>((block << CONTROL_BSB_SHIFT) | (write ? CONTROL_WRITE : 0))
+    };
+    _cs = 0;
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+}
+
+void W5500_EMAC::spi_end()
+{
+    _cs = 1;
+}
+
+void W5500_EMAC::spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t size)
+{
+    if (size == 0) {
+        return;
+    }
+
+#if W5500_ASYNC_TRANSFER
+    if (size >= W5500_ASYNC_TRANSFER_MIN_SIZE) {
+        if (0 == _spi.transfer_burst(tx_buffer, rx_buffer, (int)size,
+                                     mbed::callback(this, &W5500_EMAC::spi_transfer_done),
+                                     SPI_EVENT_COMPLETE)) {
+            if (!_transfer_done.try_acquire_for(TRANSFER_TIMEOUT)) {
+                _spi.abort_transfer();
+            }
+            return;
+        }
+    }
+#endif
+
+    _spi.write(reinterpret_cast<const char *>(tx_buffer), tx_buffer ? size : 0,
+               reinterpret_cast<char *>(rx_buffer), rx_buffer ? size : 0);
+}
+
+#if W5500_ASYNC_TRANSFER
+void W5500_EMAC::spi_transfer_done(int event)
+{
+    _transfer_done.release();
+}
+#endif
+
+void W5500_EMAC::read_buffer(uint16_t address, uint8_t block, uint8_t *data, uint32_t size)
+{
+    spi_begin(address, block, false);
+    spi_burst(NULL, data, size);
+    spi_end();
+}
+
+void W5500_EMAC::write_buffer(uint16_t address, uint8_t block, const uint8_t *data, uint32_t size)
+{
+    spi_begin(address, block, true);
+    spi_burst(data, NULL, size);
+    spi_end();
+}
+
+uint8_t W5500_EMAC::read_reg(uint16_t address, uint8_t block)
+{
+    uint8_t value;
+    read_buffer(address, block, &value, 1);
+    return value;
+}
+
+void W5500_EMAC::write_reg(uint16_t address, uint8_t block, uint8_t value)
+{
+    write_buffer(address, block, &value, 1);
+}
+
+uint16_t W5500_EMAC::read_reg16(uint16_t address, uint8_t block)
+{
+    uint8_t data[2];
+    read_buffer(address, block, data, sizeof(data));
+    return (data[0] << 8) | data[1];
+}
+
+uint16_t W5500_EMAC::read_rx_size()
+{
+    /* The chip updates the counter while it is read: read until two reads
+     * agree, as the datasheet recommends */
+    uint16_t value = read_reg16(REG_SN_RX_RSR, BLOCK_S0_REG);
+    uint16_t previous;
+    do {
+        previous = value;
+        value = read_reg16(REG_SN_RX_RSR, BLOCK_S0_REG);
+    } while (value != previous);
+    return value;
+}
+
+void W5500_EMAC::write_reg16(uint16_t address, uint8_t block, uint16_t value)
+{
+    const uint8_t data[2] = { static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+    write_buffer(address, block, data, sizeof(data));
+}
+
+bool W5500_EMAC::exec_command(uint8_t command)
+{
+    write_reg(REG_SN_CR, BLOCK_S0_REG, command);
+    /* Cleared once the command is accepted */
+    for (int i = 0; i < COMMAND_POLLS; i++) {
+        if (read_reg(REG_SN_CR, BLOCK_S0_REG) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if MBED_CONF_W5500_EMAC_PROVIDE_DEFAULT
+
+#ifndef MBED_CONF_W5500_EMAC_RESET
+#define MBED_CONF_W5500_EMAC_RESET NC
+#endif
+
+EMAC &EMAC::get_default_instance()
+{
+    static W5500_EMAC emac(MBED_CONF_W5500_EMAC_SPI_MOSI, MBED_CONF_W5500_EMAC_SPI_MISO, MBED_CONF_W5500_EMAC_SPI_SCLK,
+                           MBED_CONF_W5500_EMAC_SPI_CS, MBED_CONF_W5500_EMAC_IRQ, MBED_CONF_W5500_EMAC_RESET);
+    return emac;
+}
+
+EthInterface *EthInterface::get_target_default_instance()
+{
+    static EthernetInterface ethernet;
+    return &ethernet;
+}
+
+#endif // MBED_CONF_W5500_EMAC_PROVIDE_DEFAULT
+#endif // defined(MBED_CONF_RTOS_PRESENT)
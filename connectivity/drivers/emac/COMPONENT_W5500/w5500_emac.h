@@ -0,0 +1,251 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef W5500_EMAC_H
+#define W5500_EMAC_H
+
+#include "EMAC.h"
+#include "drivers/SPI.h"
+#include "drivers/DigitalOut.h"
+#include "drivers/InterruptIn.h"
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Thread.h"
+
+#define W5500_EMAC_HWADDR_SIZE      (6)
+#define W5500_EMAC_MTU_SIZE         (1500)
+#define W5500_EMAC_FRAME_SIZE       (1514)
+
+/* Frames delivered to the stack per batch, at most */
+#if MBED_CONF_NSAPI_EMAC_RX_BUDGET > 0
+#define W5500_EMAC_RX_BATCH         MBED_CONF_NSAPI_EMAC_RX_BUDGET
+#else
+#define W5500_EMAC_RX_BATCH         1
+#endif
+
+/* Transfers handed to the SPI peripheral, DMA where available, from this size */
+#if DEVICE_SPI_ASYNCH
+#define W5500_ASYNC_TRANSFER        1
+#else
+#define W5500_ASYNC_TRANSFER        0
+#endif
+
+/** Ethernet over a WIZnet W5500 controller attached to SPI
+ *
+ * For targets without an Ethernet MAC, such as the STM32L4. The W5500 has
+ * its own TCP/IP stack, which is bypassed: socket 0 runs in MAC raw mode
+ * with all 16 KB of receive and transmit memory of the chip, and the
+ * network stack of Mbed OS handles the frames.
+ *
+ * Frames are transferred straight between the chip and the memory manager
+ * buffers, with asynchronous SPI transfers on targets supporting them. The
+ * interrupt of the chip wakes a thread reading the received frames, which
+ * hands them to the stack in batches (see EMAC::set_link_input_batch_cb).
+ * The chip has no link interrupt, the thread polls the PHY state.
+ *
+ * The chip has no multicast filter: all multicast frames are received.
+ *
+ * @code
+ * W5500_EMAC emac(PA_7, PA_6, PA_5, PB_6, PA_8, PA_9);
+ * EthernetInterface net(emac);
+ *
+ * net.connect();
+ * @endcode
+ */
+class W5500_EMAC : public EMAC {
+public:
+    /**
+     * Construct the driver, the chip is set up on power_up()
+     *
+     * @param mosi      SPI MOSI pin
+     * @param miso      SPI MISO pin
+     * @param sclk      SPI clock pin
+     * @param cs        Chip select pin
+     * @param irq       Interrupt pin
+     * @param reset     Reset pin, NC to reset the chip by software
+     * @param frequency SPI clock frequency in Hz
+     */
+    W5500_EMAC(PinName mosi, PinName miso, PinName sclk, PinName cs, PinName irq, PinName reset = NC,
+               int frequency = MBED_CONF_W5500_EMAC_SPI_FREQUENCY);
+
+    virtual ~W5500_EMAC();
+
+    /**
+     * Return maximum transmission unit
+     *
+     * @return     MTU in bytes
+     */
+    virtual uint32_t get_mtu_size() const;
+
+    /**
+     * Gets memory buffer alignment preference
+     *
+     * @return         Memory alignment requirement in bytes
+     */
+    virtual uint32_t get_align_preference() const;
+
+    /**
+     * Return interface name
+     *
+     * @param name Pointer to where the name should be written
+     * @param size Maximum number of character to copy
+     */
+    virtual void get_ifname(char *name, uint8_t size) const;
+
+    /**
+     * Returns size of the underlying interface HW address size.
+     *
+     * @return     HW address size in bytes
+     */
+    virtual uint8_t get_hwaddr_size() const;
+
+    /**
+     * Return interface-supplied HW address
+     *
+     * The chip has no address of its own, mbed_mac_address() is used.
+     *
+     * @param addr HW address for underlying interface
+     * @return     true if HW address is available
+     */
+    virtual bool get_hwaddr(uint8_t *addr) const;
+
+    /**
+     * Set HW address for interface
+     *
+     * @param addr Address to be set
+     */
+    virtual void set_hwaddr(const uint8_t *addr);
+
+    /**
+     * Sends the packet over the link
+     *
+     * That can not be called from an interrupt context.
+     *
+     * @param buf  Packet to be send
+     * @return     True if the packet was send successfully, False otherwise
+     */
+    virtual bool link_out(emac_mem_buf_t *buf);
+
+    /**
+     * Initializes the chip
+     *
+     * @return True on success, False in case of an error.
+     */
+    virtual bool power_up();
+
+    /**
+     * Stops the reception, the chip is left powered
+     */
+    virtual void power_down();
+
+    /**
+     * Sets a callback that needs to be called for packets received for that
+     * interface
+     *
+     * @param input_cb Function to be register as a callback
+     */
+    virtual void set_link_input_cb(emac_link_input_cb_t input_cb);
+
+    /**
+     * Sets a callback to be called with batches of received packets
+     *
+     * @param input_cb Function to be register as a callback
+     * @param budget   Maximum number of packets per call
+     * @return         True
+     */
+    virtual bool set_link_input_batch_cb(emac_link_input_batch_cb_t input_cb, uint32_t budget);
+
+    /**
+     * Sets a callback that needs to be called on link status changes for given
+     * interface
+     *
+     * @param state_cb Function to be register as a callback
+     */
+    virtual void set_link_state_cb(emac_link_state_change_cb_t state_cb);
+
+    /** Add device to a multicast group
+     *
+     * @param address  A multicast group hardware address
+     */
+    virtual void add_multicast_group(const uint8_t *address);
+
+    /** Remove device from a multicast group
+     *
+     * @param address  A multicast group hardware address
+     */
+    virtual void remove_multicast_group(const uint8_t *address);
+
+    /** Request reception of all multicast packets
+     *
+     * @param all True to receive all multicasts
+     *            False to receive only multicasts addressed to specified groups
+     */
+    virtual void set_all_multicast(bool all);
+
+    /** Sets memory manager that is used to handle memory buffers
+     *
+     * @param mem_mngr Pointer to memory manager
+     */
+    virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
+
+private:
+    void irq_handler();
+    void thread_function();
+    bool check_link();
+    uint32_t receive_frames(emac_mem_buf_t **frames, uint32_t count);
+    void deliver_frames(emac_mem_buf_t **frames, uint32_t count);
+    bool open_socket();
+
+    /* Register and buffer access, the SPI lock held */
+    void spi_begin(uint16_t address, uint8_t block, bool write);
+    void spi_end();
+    void spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t size);
+    void read_buffer(uint16_t address, uint8_t block, uint8_t *data, uint32_t size);
+    void write_buffer(uint16_t address, uint8_t block, const uint8_t *data, uint32_t size);
+    uint8_t read_reg(uint16_t address, uint8_t block);
+    void write_reg(uint16_t address, uint8_t block, uint8_t value);
+    uint16_t read_reg16(uint16_t address, uint8_t block);
+    void write_reg16(uint16_t address, uint8_t block, uint16_t value);
+    uint16_t read_rx_size();
+    bool exec_command(uint8_t command);
+#if W5500_ASYNC_TRANSFER
+    void spi_transfer_done(int event);
+#endif
+
+    mbed::SPI _spi;
+    mbed::DigitalOut _cs;
+    mbed::InterruptIn _irq;
+    PinName _reset;
+    rtos::Mutex _spi_mutex;
+#if W5500_ASYNC_TRANSFER
+    rtos::Semaphore _transfer_done;
+#endif
+    rtos::Thread _thread;
+
+    EMACMemoryManager *_memory_manager = nullptr;
+    emac_link_input_cb_t _emac_link_input_cb;
+    emac_link_input_batch_cb_t _emac_link_input_batch_cb;
+    emac_link_state_change_cb_t _emac_link_state_cb;
+    uint32_t _rx_budget = 1;
+    uint8_t _hwaddr[W5500_EMAC_HWADDR_SIZE];
+    volatile bool _powered = false;
+    bool _link_up = false;
+    // A SEND command was issued and its completion not seen yet
+    bool _tx_pending = false;
+};
+
+#endif /* W5500_EMAC_H */
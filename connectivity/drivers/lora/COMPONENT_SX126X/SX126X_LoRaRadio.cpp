@@ -36,6 +36,16 @@ SPDX-License-Identifier: BSD-3-Clause
 #define SPI_FREQUENCY    16000000
 #endif
 
+/**
+ * Smallest burst worth an asynchronous SPI transfer
+ */
+#define SX126X_ASYNC_TRANSFER_MIN_SIZE  32
+
+/**
+ * Time after which an asynchronous SPI transfer that did not complete is aborted
+ */
+#define SX126X_ASYNC_TRANSFER_TIMEOUT   std::chrono::milliseconds(100)
+
 using namespace mbed;
 using namespace rtos;
 
@@ -410,6 +420,11 @@ void SX126X_LoRaRadio::init_radio(radio_events_t *events)
     _chip_select = 1;
     _spi.format(8, 0);
     _spi.frequency(SPI_FREQUENCY);
+    // block reads clock out zeros (NOPs), as single byte reads do
+    _spi.set_default_write_value(0);
+#if SX126X_ASYNC_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
     // 100 us wait to settle down
     wait_us(100);
 
@@ -564,6 +579,7 @@ uint32_t SX126X_LoRaRadio::random(void)
 
 void SX126X_LoRaRadio::write_opmode_command(uint8_t cmd, uint8_t *buffer, uint16_t size)
 {
+    _spi.lock();
     _chip_select = 0;
 
     while (_busy) {
@@ -571,31 +587,29 @@ void SX126X_LoRaRadio::write_opmode_command(uint8_t cmd, uint8_t *buffer, uint16
     }
 
     _spi.write(cmd);
-
-    for (int i = 0; i < size; i++) {
-        _spi.write(buffer[i]);
-    }
+    spi_burst(buffer, NULL, size);
 
     _chip_select = 1;
+    _spi.unlock();
 }
 
 void SX126X_LoRaRadio::read_opmode_command(uint8_t cmd,
                                            uint8_t *buffer, uint16_t size)
 {
+    const uint8_t header[] = { cmd, 0 };
+
+    _spi.lock();
     _chip_select = 0;
 
     while (_busy) {
         // do nothing
     }
 
-    _spi.write(cmd);
-    _spi.write(0);
-
-    for (int i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+    spi_burst(NULL, buffer, size);
 
     _chip_select = 1;
+    _spi.unlock();
 }
 
 void SX126X_LoRaRadio::write_to_register(uint16_t addr, uint8_t data)
@@ -606,17 +620,20 @@ void SX126X_LoRaRadio::write_to_register(uint16_t addr, uint8_t data)
 void SX126X_LoRaRadio::write_to_register(uint16_t addr, uint8_t *data,
                                          uint8_t size)
 {
-    _chip_select = 0;
+    const uint8_t header[] = {
+        RADIO_WRITE_REGISTER,
+        (uint8_t)((addr & 0xFF00) >> 8),
+        (uint8_t)(addr & 0x00FF)
+    };
 
-    _spi.write(RADIO_WRITE_REGISTER);
-    _spi.write((addr & 0xFF00) >> 8);
-    _spi.write(addr & 0x00FF);
+    _spi.lock();
+    _chip_select = 0;
 
-    for (int i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+    spi_burst(data, NULL, size);
 
     _chip_select = 1;
+    _spi.unlock();
 }
 
 uint8_t SX126X_LoRaRadio::read_register(uint16_t addr)
@@ -630,33 +647,72 @@ uint8_t SX126X_LoRaRadio::read_register(uint16_t addr)
 void SX126X_LoRaRadio::read_register(uint16_t addr, uint8_t *buffer,
                                      uint8_t size)
 {
+    // the status byte clocked in after the address is discarded
+    const uint8_t header[] = {
+        RADIO_READ_REGISTER,
+        (uint8_t)((addr & 0xFF00) >> 8),
+        (uint8_t)(addr & 0x00FF),
+        0
+    };
+
+    _spi.lock();
     _chip_select = 0;
 
-    _spi.write(RADIO_READ_REGISTER);
-    _spi.write((addr & 0xFF00) >> 8);
-    _spi.write(addr & 0x00FF);
-    _spi.write(0);
-
-    for (int i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+    spi_burst(NULL, buffer, size);
 
     _chip_select = 1;
+    _spi.unlock();
 }
 
 void SX126X_LoRaRadio::write_fifo(uint8_t *buffer, uint8_t size)
 {
+    const uint8_t header[] = { RADIO_WRITE_BUFFER, 0 };
+
+    _spi.lock();
     _chip_select = 0;
 
-    _spi.write(RADIO_WRITE_BUFFER);
-    _spi.write(0);
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+    spi_burst(buffer, NULL, size);
+
+    _chip_select = 1;
+    _spi.unlock();
+}
 
-    for (int i = 0; i < size; i++) {
-        _spi.write(buffer[i]);
+/**
+ * Transfers the data phase of a command, the chip being selected. Large
+ * bursts, such as whole FIFO payloads, use the asynchronous SPI API when
+ * enabled, the calling thread sleeping meanwhile.
+ */
+void SX126X_LoRaRadio::spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint16_t size)
+{
+    if (size == 0) {
+        return;
     }
 
-    _chip_select = 1;
+#if SX126X_ASYNC_TRANSFER
+    if (size >= SX126X_ASYNC_TRANSFER_MIN_SIZE) {
+        if (0 == _spi.transfer_burst(tx_buffer, rx_buffer, (int)size,
+                                     callback(this, &SX126X_LoRaRadio::spi_transfer_done),
+                                     SPI_EVENT_COMPLETE)) {
+            if (!_transfer_done.try_acquire_for(SX126X_ASYNC_TRANSFER_TIMEOUT)) {
+                _spi.abort_transfer();
+            }
+            return;
+        }
+    }
+#endif
+
+    _spi.write(reinterpret_cast<const char *>(tx_buffer), tx_buffer ? size : 0,
+               reinterpret_cast<char *>(rx_buffer), rx_buffer ? size : 0);
+}
+
+#if SX126X_ASYNC_TRANSFER
+void SX126X_LoRaRadio::spi_transfer_done(int event)
+{
+    _transfer_done.release();
 }
+#endif
 
 void SX126X_LoRaRadio::set_modem(uint8_t modem)
 {
@@ -677,17 +733,16 @@ uint8_t SX126X_LoRaRadio::get_modem()
 
 void SX126X_LoRaRadio::read_fifo(uint8_t *buffer, uint8_t size, uint8_t offset)
 {
-    _chip_select = 0;
+    const uint8_t header[] = { RADIO_READ_BUFFER, offset, 0 };
 
-    _spi.write(RADIO_READ_BUFFER);
-    _spi.write(offset);
-    _spi.write(0);
+    _spi.lock();
+    _chip_select = 0;
 
-    for (int i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    _spi.write(reinterpret_cast<const char *>(header), sizeof(header), NULL, 0);
+    spi_burst(NULL, buffer, size);
 
     _chip_select = 1;
+    _spi.unlock();
 }
 
 uint8_t SX126X_LoRaRadio::get_device_variant(void)
@@ -40,6 +40,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
 #endif
+
+#if DEVICE_SPI_ASYNCH && defined(MBED_CONF_RTOS_PRESENT) && MBED_CONF_SX126X_LORA_DRIVER_ASYNC_TRANSFER
+#define SX126X_ASYNC_TRANSFER 1
+#include "rtos/Semaphore.h"
+#else
+#define SX126X_ASYNC_TRANSFER 0
+#endif
 #include "sx126x_ds.h"
 #include "lorawan/LoRaRadio.h"
 
@@ -331,6 +338,11 @@ private:
     rtos::Thread irq_thread;
 #endif
 
+#if SX126X_ASYNC_TRANSFER
+    // Signals the end of an asynchronous SPI burst
+    rtos::Semaphore _transfer_done;
+#endif
+
     // Access protection
     PlatformMutex mutex;
 
@@ -338,6 +350,10 @@ private:
     void wakeup();
     void read_opmode_command(uint8_t cmd, uint8_t *buffer, uint16_t size);
     void write_opmode_command(uint8_t cmd, uint8_t *buffer, uint16_t size);
+    void spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint16_t size);
+#if SX126X_ASYNC_TRANSFER
+    void spi_transfer_done(int event);
+#endif
     void set_dio2_as_rfswitch_ctrl(uint8_t enable);
     void set_dio3_as_tcxo_ctrl(radio_TCXO_ctrl_voltage_t voltage, uint32_t timeout);
     uint8_t get_device_variant(void);
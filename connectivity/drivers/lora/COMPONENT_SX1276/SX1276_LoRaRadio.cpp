@@ -131,6 +131,16 @@ static const fsk_bw_t fsk_bandwidths[] = {
 #define SPI_WRITE_CMD   0x80
 #define SPI_READ_CMD    0x7F
 
+/**
+ * Smallest burst worth an asynchronous SPI transfer
+ */
+#define SX1276_ASYNC_TRANSFER_MIN_SIZE  32
+
+/**
+ * Time after which an asynchronous SPI transfer that did not complete is aborted
+ */
+#define SX1276_ASYNC_TRANSFER_TIMEOUT   std::chrono::milliseconds(100)
+
 /**
  * Signals
  */
@@ -1196,19 +1206,22 @@ void SX1276_LoRaRadio::write_to_register(uint8_t addr, uint8_t data)
  */
 void SX1276_LoRaRadio::write_to_register(uint8_t addr, uint8_t *data, uint8_t size)
 {
+    _spi.lock();
+
     // set chip-select low
     _chip_select = 0;
 
     // set write command
     _spi.write(addr | SPI_WRITE_CMD);
 
-    // write data
-    for (uint8_t i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    // write data in a single burst, the address auto-increments
+    // (the FIFO address doesn't)
+    spi_burst(data, NULL, size);
 
     // set chip-select high
     _chip_select = 1;
+
+    _spi.unlock();
 }
 
 /**
@@ -1226,21 +1239,58 @@ uint8_t SX1276_LoRaRadio::read_register(uint8_t addr)
  */
 void SX1276_LoRaRadio::read_register(uint8_t addr, uint8_t *buffer, uint8_t size)
 {
+    _spi.lock();
+
     // set chip-select low
     _chip_select = 0;
 
     // set read command
     _spi.write(addr & SPI_READ_CMD);
 
-    // read buffers
-    for (uint8_t i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    // read buffers in a single burst
+    spi_burst(NULL, buffer, size);
 
     // set chip-select high
     _chip_select = 1;
+
+    _spi.unlock();
+}
+
+/**
+ * Transfers the data phase of a register or FIFO access, the chip being
+ * selected. Large bursts, such as whole FIFO payloads, use the asynchronous
+ * SPI API when enabled, the calling thread sleeping meanwhile.
+ */
+void SX1276_LoRaRadio::spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint8_t size)
+{
+    if (size == 0) {
+        return;
+    }
+
+#if SX1276_ASYNC_TRANSFER
+    if (size >= SX1276_ASYNC_TRANSFER_MIN_SIZE) {
+        if (0 == _spi.transfer_burst(tx_buffer, rx_buffer, (int)size,
+                                     mbed::callback(this, &SX1276_LoRaRadio::spi_transfer_done),
+                                     SPI_EVENT_COMPLETE)) {
+            if (!_transfer_done.try_acquire_for(SX1276_ASYNC_TRANSFER_TIMEOUT)) {
+                _spi.abort_transfer();
+            }
+            return;
+        }
+    }
+#endif
+
+    _spi.write(reinterpret_cast<const char *>(tx_buffer), tx_buffer ? size : 0,
+               reinterpret_cast<char *>(rx_buffer), rx_buffer ? size : 0);
 }
 
+#if SX1276_ASYNC_TRANSFER
+void SX1276_LoRaRadio::spi_transfer_done(int event)
+{
+    _transfer_done.release();
+}
+#endif
+
 /**
  * Writes to FIIO provided by the chip
  */
@@ -1352,6 +1402,11 @@ void SX1276_LoRaRadio::setup_spi()
     // Hold chip-select high
     _chip_select = 1;
     _spi.format(8, 0);
+    // block reads clock out zeros, as single byte reads do
+    _spi.set_default_write_value(0);
+#if SX1276_ASYNC_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
 
 #if defined (TARGET_KL25Z)
     //bus-clock frequency is halved -> double the SPI frequency to compensate
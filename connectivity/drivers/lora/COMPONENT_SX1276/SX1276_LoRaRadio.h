@@ -38,6 +38,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "rtos/Thread.h"
 #endif
 
+#if DEVICE_SPI_ASYNCH && defined(MBED_CONF_RTOS_PRESENT) && MBED_CONF_SX1276_LORA_DRIVER_ASYNC_TRANSFER
+#define SX1276_ASYNC_TRANSFER 1
+#include "rtos/Semaphore.h"
+#else
+#define SX1276_ASYNC_TRANSFER 0
+#endif
+
 #include "lorawan/LoRaRadio.h"
 
 #ifdef MBED_CONF_SX1276_LORA_DRIVER_BUFFER_SIZE
@@ -398,6 +405,11 @@ private:
     rtos::Thread irq_thread;
 #endif
 
+#if SX1276_ASYNC_TRANSFER
+    // Signals the end of an asynchronous SPI burst
+    rtos::Semaphore _transfer_done;
+#endif
+
     // Access protection
     PlatformMutex mutex;
 
@@ -408,6 +420,10 @@ private:
     void default_antenna_switch_ctrls();
     void set_antenna_switch(uint8_t operation_mode);
     void setup_spi();
+    void spi_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint8_t size);
+#if SX1276_ASYNC_TRANSFER
+    void spi_transfer_done(int event);
+#endif
     void gpio_init();
     void gpio_deinit();
     void setup_interrupts();
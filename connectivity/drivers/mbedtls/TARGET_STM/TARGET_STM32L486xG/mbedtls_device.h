@@ -22,4 +22,11 @@
 
 #define MBEDTLS_AES_ALT
 
+/* P-256 point arithmetic on the core, see ecp_internal_alt.c */
+#define MBEDTLS_ECP_INTERNAL_ALT
+#define MBEDTLS_ECP_ADD_MIXED_ALT
+#define MBEDTLS_ECP_DOUBLE_JAC_ALT
+#define MBEDTLS_ECP_NORMALIZE_JAC_ALT
+#define MBEDTLS_ECP_NORMALIZE_JAC_MANY_ALT
+
 #endif /* MBEDTLS_DEVICE_H */
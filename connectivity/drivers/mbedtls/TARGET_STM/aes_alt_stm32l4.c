@@ -28,6 +28,13 @@
 
 #include "mbedtls/platform.h"
 
+/* Largest length processed by one call to HAL_CRYPEx_AES */
+#define ST_AES_MAX_CHUNK  ((size_t) 0xFFF0)
+
+/* Context whose key and mode are loaded in the AES peripheral: consecutive
+   blocks of the same context are processed without reinitializing it */
+static mbedtls_aes_context *aes_hw_owner = NULL;
+
 static int aes_set_key(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits)
 {
     switch (keybits) {
@@ -47,25 +54,72 @@ static int aes_set_key(mbedtls_aes_context *ctx, const unsigned char *key, unsig
 
     ctx->hcryp_aes.Init.DataType = CRYP_DATATYPE_8B;
     ctx->hcryp_aes.Instance = AES;
-
-    /* Deinitializes the CRYP peripheral */
-    if (HAL_CRYP_DeInit(&ctx->hcryp_aes) == HAL_ERROR) {
-        return (HAL_ERROR);
+    ctx->dec_key_ready = 0;
+    if (aes_hw_owner == ctx) {
+        aes_hw_owner = NULL;
     }
 
     /* Enable CRYP clock */
     __HAL_RCC_AES_CLK_ENABLE();
 
-    ctx->hcryp_aes.Init.pKey = ctx->aes_key;
-    ctx->hcryp_aes.Init.KeyWriteFlag = CRYP_KEY_WRITE_ENABLE;
-    if (HAL_CRYP_Init(&ctx->hcryp_aes) == HAL_ERROR) {
-        return (HAL_ERROR);
+    return (0);
+}
+
+/* Load the key and modes of the context in the AES peripheral, the IV is
+   only used by the CBC and CTR chaining modes */
+static int aes_hw_setup(mbedtls_aes_context *ctx, uint32_t opmode, uint32_t chmode, unsigned char *iv)
+{
+    CRYP_HandleTypeDef *hcryp = &ctx->hcryp_aes;
+
+    if (aes_hw_owner == ctx && chmode == CRYP_CHAINMODE_AES_ECB &&
+            hcryp->Init.OperatingMode == opmode && hcryp->Init.ChainingMode == chmode &&
+            hcryp->State == HAL_CRYP_STATE_READY) {
+        return 0;
+    }
+    aes_hw_owner = NULL;
+
+    /* The decryption key schedule is run once, its last round key is kept */
+    if (opmode == CRYP_ALGOMODE_DECRYPT && !ctx->dec_key_ready) {
+        hcryp->Init.OperatingMode = CRYP_ALGOMODE_KEYDERIVATION;
+        hcryp->Init.KeyWriteFlag = CRYP_KEY_WRITE_ENABLE;
+        hcryp->Init.pKey = ctx->aes_key;
+        if (HAL_CRYP_DeInit(hcryp) != HAL_OK || HAL_CRYP_Init(hcryp) != HAL_OK) {
+            return ST_ERR_AES_BUSY;
+        }
+        if (HAL_CRYPEx_AES(hcryp, NULL, 0, ctx->aes_dec_key, ST_AES_TIMEOUT) != HAL_OK) {
+            return ST_ERR_AES_BUSY;
+        }
+        ctx->dec_key_ready = 1;
     }
 
-    /* allow multi-instance of CRYP use: save context for CRYP HW module CR */
-    ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
-    return (0);
+    hcryp->Init.DataType = CRYP_DATATYPE_8B;
+    hcryp->Init.OperatingMode = opmode;
+    hcryp->Init.ChainingMode = chmode;
+    hcryp->Init.KeyWriteFlag = CRYP_KEY_WRITE_ENABLE;
+    hcryp->Init.pKey = (opmode == CRYP_ALGOMODE_DECRYPT) ? ctx->aes_dec_key : ctx->aes_key;
+    hcryp->Init.pInitVect = iv;
+    if (HAL_CRYP_DeInit(hcryp) != HAL_OK || HAL_CRYP_Init(hcryp) != HAL_OK) {
+        return ST_ERR_AES_BUSY;
+    }
 
+    aes_hw_owner = ctx;
+    return 0;
+}
+
+/* Process whole blocks with the loaded key and modes */
+static int aes_hw_process(mbedtls_aes_context *ctx, size_t length, const unsigned char *input, unsigned char *output)
+{
+    while (length) {
+        size_t chunk = length < ST_AES_MAX_CHUNK ? length : ST_AES_MAX_CHUNK;
+        if (HAL_CRYPEx_AES(&ctx->hcryp_aes, (uint8_t *)input, chunk, output, ST_AES_TIMEOUT) != HAL_OK) {
+            aes_hw_owner = NULL;
+            return ST_ERR_AES_BUSY;
+        }
+        input += chunk;
+        output += chunk;
+        length -= chunk;
+    }
+    return 0;
 }
 
 /* Implementation that should never be optimized out by the compiler */
@@ -81,7 +135,9 @@ static void mbedtls_zeroize(void *v, size_t n)
 void mbedtls_aes_init(mbedtls_aes_context *ctx)
 {
     memset(ctx, 0, sizeof(mbedtls_aes_context));
-
+    if (aes_hw_owner == ctx) {
+        aes_hw_owner = NULL;
+    }
 }
 
 
@@ -99,6 +155,9 @@ void mbedtls_aes_free(mbedtls_aes_context *ctx)
 
     /* Release the CRYP Periheral Clock Reset */
     __HAL_RCC_AES_RELEASE_RESET();
+
+    /* The reset cleared the key of any context */
+    aes_hw_owner = NULL;
 #if defined(DUAL_CORE)
     LL_HSEM_ReleaseLock(HSEM, CFG_HW_RCC_SEMID, HSEM_CR_COREID_CURRENT);
 #endif /* DUAL_CORE */
@@ -129,13 +188,6 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
                           const unsigned char input[16],
                           unsigned char output[16])
 {
-
-    /* allow multi-instance of CRYP use: restore context for CRYP hw module */
-    ctx->hcryp_aes.Instance->CR = ctx->ctx_save_cr;
-    ctx->hcryp_aes.Phase = HAL_CRYP_PHASE_READY;
-    ctx->hcryp_aes.Init.DataType = CRYP_DATATYPE_8B;
-    ctx->hcryp_aes.Init.pKey = ctx->aes_key;
-
     if (mode == MBEDTLS_AES_DECRYPT) { /* AES decryption */
         if (mbedtls_internal_aes_decrypt(ctx, input, output)) {
             return ST_ERR_AES_BUSY;
@@ -145,49 +197,11 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
             return ST_ERR_AES_BUSY;
         }
     }
-    /* allow multi-instance of CRYP use: save context for CRYP HW module CR */
-    ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
 
     return (0);
 }
 
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
-static int st_cbc_restore_context(mbedtls_aes_context *ctx)
-{
-    uint32_t tickstart;
-    tickstart = HAL_GetTick();
-    while ((ctx->hcryp_aes.Instance->SR & AES_SR_BUSY) != 0) {
-        if ((HAL_GetTick() - tickstart) > ST_AES_TIMEOUT) {
-            return ST_ERR_AES_BUSY; // timeout: CRYP processor is busy
-        }
-    }
-    /* allow multi-instance of CRYP use: restore context for CRYP hw module */
-    ctx->hcryp_aes.Instance->CR = ctx->ctx_save_cr;
-    return 0;
-}
-
-static int st_hal_cryp_cbc(mbedtls_aes_context *ctx, uint32_t opmode, size_t length,
-                           unsigned char iv[16], uint8_t *input, uint8_t *output)
-{
-    ctx->hcryp_aes.Init.pInitVect = &iv[0]; // used in process, not in the init
-    /* At this moment only, we know we have CBC mode: Re-initialize AES
-        IP with proper parameters and apply key and IV for multi context usecase */
-    if (HAL_CRYP_DeInit(&ctx->hcryp_aes) != HAL_OK) {
-        return ST_ERR_AES_BUSY;
-    }
-    ctx->hcryp_aes.Init.OperatingMode = opmode;
-    ctx->hcryp_aes.Init.ChainingMode = CRYP_CHAINMODE_AES_CBC;
-    ctx->hcryp_aes.Init.KeyWriteFlag = CRYP_KEY_WRITE_ENABLE;
-    if (HAL_CRYP_Init(&ctx->hcryp_aes) != HAL_OK) {
-        return ST_ERR_AES_BUSY;
-    }
-
-    if (HAL_CRYPEx_AES(&ctx->hcryp_aes, input, length, output, 10) != 0) {
-        return ST_ERR_AES_BUSY;
-    }
-    return 0;
-}
-
 int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
                           int mode,
                           size_t length,
@@ -195,39 +209,34 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
                           const unsigned char *input,
                           unsigned char *output)
 {
-    uint32_t tickstart;
-    uint32_t *iv_ptr = (uint32_t *)&iv[0];
+    unsigned char next_iv[16];
+
     if (length % 16) {
         return (MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH);
     }
-    ctx->hcryp_aes.Init.pInitVect = &iv[0];
-    if (st_cbc_restore_context(ctx) != 0) {
-        return (ST_ERR_AES_BUSY);
+    if (length == 0) {
+        return 0;
     }
 
+    /* The IV registers chain the blocks of all the chunks */
     if (mode == MBEDTLS_AES_DECRYPT) {
-        if (st_hal_cryp_cbc(ctx, CRYP_ALGOMODE_KEYDERIVATION_DECRYPT, length, iv, (uint8_t *)input, (uint8_t *)output) != 0) {
+        /* the last cipher block is the IV of the next call, input and output may overlap */
+        memcpy(next_iv, input + length - 16, 16);
+        if (aes_hw_setup(ctx, CRYP_ALGOMODE_DECRYPT, CRYP_CHAINMODE_AES_CBC, iv) != 0) {
             return ST_ERR_AES_BUSY;
         }
-        /* Save the internal IV vector for multi context purpose */
-        tickstart = HAL_GetTick();
-        while ((ctx->hcryp_aes.Instance->SR & AES_SR_BUSY) != 0) {
-            if ((HAL_GetTick() - tickstart) > ST_AES_TIMEOUT) {
-                return ST_ERR_AES_BUSY; // timeout: CRYP processor is busy
-            }
+        if (aes_hw_process(ctx, length, input, output) != 0) {
+            return ST_ERR_AES_BUSY;
         }
-        ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR; // save here before overwritten
-        ctx->hcryp_aes.Instance->CR &= ~AES_CR_EN;
-        *iv_ptr++ = ctx->hcryp_aes.Instance->IVR3;
-        *iv_ptr++ = ctx->hcryp_aes.Instance->IVR2;
-        *iv_ptr++ = ctx->hcryp_aes.Instance->IVR1;
-        *iv_ptr++ = ctx->hcryp_aes.Instance->IVR0;
+        memcpy(iv, next_iv, 16);
     } else {
-        if (st_hal_cryp_cbc(ctx, CRYP_ALGOMODE_ENCRYPT, length, iv, (uint8_t *)input, (uint8_t *)output) != 0) {
+        if (aes_hw_setup(ctx, CRYP_ALGOMODE_ENCRYPT, CRYP_CHAINMODE_AES_CBC, iv) != 0) {
+            return ST_ERR_AES_BUSY;
+        }
+        if (aes_hw_process(ctx, length, input, output) != 0) {
             return ST_ERR_AES_BUSY;
         }
-        memcpy(iv, output, 16);   /* current output is the IV vector for the next call */
-        ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
+        memcpy(iv, output + length - 16, 16);   /* current output is the IV vector for the next call */
     }
 
     return 0;
@@ -324,6 +333,33 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx,
     int c, i;
     size_t n = *nc_off;
 
+    /* Whole blocks go through the CTR mode of the peripheral, which only
+       increments the low 32 bits of the counter: stop before they wrap */
+    if (n == 0 && length >= 16) {
+        uint32_t low = ((uint32_t)nonce_counter[12] << 24) | ((uint32_t)nonce_counter[13] << 16) |
+                       ((uint32_t)nonce_counter[14] << 8) | (uint32_t)nonce_counter[15];
+        size_t blocks = length / 16;
+        if (blocks > (size_t)(0xFFFFFFFFUL - low)) {
+            blocks = 0xFFFFFFFFUL - low;
+        }
+        if (blocks) {
+            if (aes_hw_setup(ctx, CRYP_ALGOMODE_ENCRYPT, CRYP_CHAINMODE_AES_CTR, nonce_counter) != 0) {
+                return ST_ERR_AES_BUSY;
+            }
+            if (aes_hw_process(ctx, blocks * 16, input, output) != 0) {
+                return ST_ERR_AES_BUSY;
+            }
+            low += blocks;
+            nonce_counter[12] = (unsigned char)(low >> 24);
+            nonce_counter[13] = (unsigned char)(low >> 16);
+            nonce_counter[14] = (unsigned char)(low >> 8);
+            nonce_counter[15] = (unsigned char)low;
+            input += blocks * 16;
+            output += blocks * 16;
+            length -= blocks * 16;
+        }
+    }
+
     while (length--) {
         if (n == 0) {
             if (mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce_counter, stream_block) != 0) {
@@ -351,23 +387,20 @@ int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx,
                                  const unsigned char input[16],
                                  unsigned char output[16])
 {
-    if (HAL_CRYP_AESECB_Encrypt(&ctx->hcryp_aes, (uint8_t *)input, 16, (uint8_t *)output, 10) != HAL_OK) {
-        // error found
+    if (aes_hw_setup(ctx, CRYP_ALGOMODE_ENCRYPT, CRYP_CHAINMODE_AES_ECB, NULL) != 0) {
         return ST_ERR_AES_BUSY;
     }
-    return 0;
-
+    return aes_hw_process(ctx, 16, input, output);
 }
 
 int mbedtls_internal_aes_decrypt(mbedtls_aes_context *ctx,
                                  const unsigned char input[16],
                                  unsigned char output[16])
 {
-    if (HAL_CRYP_AESECB_Decrypt(&ctx->hcryp_aes, (uint8_t *)input, 16, (uint8_t *)output, 10) != HAL_OK) {
-        // error found
+    if (aes_hw_setup(ctx, CRYP_ALGOMODE_DECRYPT, CRYP_CHAINMODE_AES_ECB, NULL) != 0) {
         return ST_ERR_AES_BUSY;
     }
-    return 0;
+    return aes_hw_process(ctx, 16, input, output);
 }
 
 #if !defined(MBEDTLS_DEPRECATED_REMOVED)
@@ -43,9 +43,10 @@ extern "C" {
  *                 generating an extra round key
  */
 typedef struct {
-    unsigned char      aes_key[32]; /* Decryption key */
+    unsigned char      aes_key[32];     /* Encryption key */
+    unsigned char      aes_dec_key[32]; /* Decryption key, derived once from aes_key */
     CRYP_HandleTypeDef hcryp_aes;
-    uint32_t           ctx_save_cr; /* save context for multi-instance */
+    unsigned char      dec_key_ready;   /* aes_dec_key holds the derived key */
 }
 mbedtls_aes_context;
 
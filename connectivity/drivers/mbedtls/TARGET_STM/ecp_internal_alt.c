@@ -0,0 +1,710 @@
+/*
+ *  P-256 point arithmetic for Cortex-M4/M33 (MBEDTLS_ECP_INTERNAL_ALT)
+ *******************************************************************************
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECP_C) && defined(MBEDTLS_ECP_INTERNAL_ALT)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "mbedtls/ecp.h"
+#include "mbedtls/ecp_internal.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
+
+/*
+ * Only secp256r1 is handled here; every other curve goes through the generic
+ * mbedtls code. Field elements are kept as 8 little-endian 32-bit words and
+ * are always fully reduced (0 <= a < p). Coordinates are converted from/to
+ * mbedtls_mpi at the boundary of each point operation, which is cheap next to
+ * the ~10 modular multiplications performed by each of them.
+ */
+
+#define P256_WORDS      8
+#define P256_LIMBS      ((P256_WORDS * 4 + sizeof(mbedtls_mpi_uint) - 1) / sizeof(mbedtls_mpi_uint))
+#define P256_WPL        (sizeof(mbedtls_mpi_uint) / 4)     /* 32-bit words per mpi limb */
+
+typedef uint32_t p256_fe[P256_WORDS];
+
+static const p256_fe p256_p = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+/*
+ * (*hi:*lo) = a * b + *lo + *hi, which cannot overflow 64 bits.
+ * A single UMAAL on cores with the DSP extension.
+ */
+static inline void p256_umaal(uint32_t *lo, uint32_t *hi, uint32_t a, uint32_t b)
+{
+#if defined(__GNUC__) && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    __asm__("umaal %0, %1, %2, %3" : "+r"(*lo), "+r"(*hi) : "r"(a), "r"(b));
+#else
+    uint64_t r = (uint64_t) a * b + *lo + *hi;
+    *lo = (uint32_t) r;
+    *hi = (uint32_t)(r >> 32);
+#endif
+}
+
+static inline int p256_is_zero(const uint32_t *a)
+{
+    uint32_t acc = 0;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        acc |= a[i];
+    }
+    return acc == 0;
+}
+
+/* r = t - p if t >= p, t otherwise (t < 2p) */
+static void p256_sub_p_if_ge(uint32_t *r, const uint32_t *t)
+{
+    uint32_t s[P256_WORDS];
+    uint32_t borrow = 0, mask;
+    uint64_t d;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        d = (uint64_t) t[i] - p256_p[i] - borrow;
+        s[i] = (uint32_t) d;
+        borrow = (uint32_t)(d >> 63);
+    }
+
+    mask = 0 - borrow;
+    for (i = 0; i < P256_WORDS; i++) {
+        r[i] = (t[i] & mask) | (s[i] & ~mask);
+    }
+}
+
+static void p256_add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+    uint32_t s[P256_WORDS], t[P256_WORDS];
+    uint32_t carry, borrow = 0, mask;
+    uint64_t acc = 0, d;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        acc += (uint64_t) a[i] + b[i];
+        s[i] = (uint32_t) acc;
+        acc >>= 32;
+    }
+    carry = (uint32_t) acc;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        d = (uint64_t) s[i] - p256_p[i] - borrow;
+        t[i] = (uint32_t) d;
+        borrow = (uint32_t)(d >> 63);
+    }
+
+    /* Keep a + b - p unless it went negative without a carry out of a + b */
+    mask = 0 - (carry | (borrow ^ 1));
+    for (i = 0; i < P256_WORDS; i++) {
+        r[i] = (t[i] & mask) | (s[i] & ~mask);
+    }
+}
+
+static void p256_sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+    uint32_t s[P256_WORDS];
+    uint32_t borrow = 0, mask;
+    uint64_t acc = 0, d;
+    int i;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        d = (uint64_t) a[i] - b[i] - borrow;
+        s[i] = (uint32_t) d;
+        borrow = (uint32_t)(d >> 63);
+    }
+
+    mask = 0 - borrow;
+    for (i = 0; i < P256_WORDS; i++) {
+        acc += (uint64_t) s[i] + (p256_p[i] & mask);
+        r[i] = (uint32_t) acc;
+        acc >>= 32;
+    }
+}
+
+/*
+ * Fast reduction of a 512-bit product (FIPS 186-4 D.2.3):
+ * r = s1 + 2 s2 + 2 s3 + s4 + s5 - d1 - d2 - d3 - d4 mod p,
+ * accumulated per 32-bit word with signed 64-bit sums.
+ */
+static void p256_reduce(uint32_t *r, const uint32_t *c)
+{
+    int64_t w[P256_WORDS];
+    int64_t acc, k;
+    uint32_t t[P256_WORDS];
+    int i;
+
+    w[0] = (int64_t) c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    w[1] = (int64_t) c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    w[2] = (int64_t) c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    w[3] = (int64_t) c[3] + 2 * (int64_t) c[11] + 2 * (int64_t) c[12] + c[13] - c[15] - c[8] - c[9];
+    w[4] = (int64_t) c[4] + 2 * (int64_t) c[12] + 2 * (int64_t) c[13] + c[14] - c[9] - c[10];
+    w[5] = (int64_t) c[5] + 2 * (int64_t) c[13] + 2 * (int64_t) c[14] + c[15] - c[10] - c[11];
+    w[6] = (int64_t) c[6] + 3 * (int64_t) c[14] + 2 * (int64_t) c[15] + c[13] - c[8] - c[9];
+    w[7] = (int64_t) c[7] + 3 * (int64_t) c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    acc = 0;
+    for (i = 0; i < P256_WORDS; i++) {
+        acc += w[i];
+        t[i] = (uint32_t) acc;
+        acc >>= 32;
+    }
+
+    /* Fold the signed carry back in with 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p */
+    while (acc != 0) {
+        k = acc;
+        acc = 0;
+        for (i = 0; i < P256_WORDS; i++) {
+            acc += t[i];
+            if (i == 0 || i == 7) {
+                acc += k;
+            } else if (i == 3 || i == 6) {
+                acc -= k;
+            }
+            t[i] = (uint32_t) acc;
+            acc >>= 32;
+        }
+    }
+
+    p256_sub_p_if_ge(r, t);
+}
+
+static void p256_mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+    uint32_t c[2 * P256_WORDS] = { 0 };
+    uint32_t hi;
+    int i, j;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        hi = 0;
+        for (j = 0; j < P256_WORDS; j++) {
+            p256_umaal(&c[i + j], &hi, a[i], b[j]);
+        }
+        c[i + P256_WORDS] = hi;
+    }
+
+    p256_reduce(r, c);
+}
+
+static void p256_sqr(uint32_t *r, const uint32_t *a)
+{
+    p256_mul(r, a, a);
+}
+
+static void p256_sqr_n(uint32_t *r, const uint32_t *a, int n)
+{
+    p256_sqr(r, a);
+    while (--n > 0) {
+        p256_sqr(r, r);
+    }
+}
+
+/* r = a^(p - 2) = a^-1: 255 squarings and 12 multiplications */
+static void p256_inv(uint32_t *r, const uint32_t *a)
+{
+    p256_fe x2, x3, x6, x12, x15, x30, x32, t;
+
+    p256_sqr(t, a);
+    p256_mul(x2, t, a);
+    p256_sqr(t, x2);
+    p256_mul(x3, t, a);
+    p256_sqr_n(t, x3, 3);
+    p256_mul(x6, t, x3);
+    p256_sqr_n(t, x6, 6);
+    p256_mul(x12, t, x6);
+    p256_sqr_n(t, x12, 3);
+    p256_mul(x15, t, x3);
+    p256_sqr_n(t, x15, 15);
+    p256_mul(x30, t, x15);
+    p256_sqr_n(t, x30, 2);
+    p256_mul(x32, t, x2);
+
+    p256_sqr_n(t, x32, 32);
+    p256_mul(t, t, a);
+    p256_sqr_n(t, t, 128);
+    p256_mul(t, t, x32);
+    p256_sqr_n(t, t, 32);
+    p256_mul(t, t, x32);
+    p256_sqr_n(t, t, 30);
+    p256_mul(t, t, x30);
+    p256_sqr_n(t, t, 2);
+    p256_mul(r, t, a);
+}
+
+/* Coordinates handed over by ecp.c are always in [0, p) */
+static void p256_from_mpi(uint32_t *r, const mbedtls_mpi *X)
+{
+    size_t i, limb;
+
+    for (i = 0; i < P256_WORDS; i++) {
+        limb = i / P256_WPL;
+        r[i] = limb < X->n ? (uint32_t)(X->p[limb] >> (32 * (i % P256_WPL))) : 0;
+    }
+}
+
+static int p256_to_mpi(mbedtls_mpi *X, const uint32_t *a)
+{
+    int ret;
+    size_t i;
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_grow(X, P256_LIMBS));
+    memset(X->p, 0, X->n * sizeof(mbedtls_mpi_uint));
+    for (i = 0; i < P256_WORDS; i++) {
+        X->p[i / P256_WPL] |= (mbedtls_mpi_uint) a[i] << (32 * (i % P256_WPL));
+    }
+    X->s = 1;
+
+cleanup:
+    return ret;
+}
+
+static int p256_to_point(mbedtls_ecp_point *R, const uint32_t *x, const uint32_t *y, const uint32_t *z)
+{
+    int ret;
+
+    MBEDTLS_MPI_CHK(p256_to_mpi(&R->X, x));
+    MBEDTLS_MPI_CHK(p256_to_mpi(&R->Y, y));
+    if (z != NULL) {
+        MBEDTLS_MPI_CHK(p256_to_mpi(&R->Z, z));
+    } else {
+        MBEDTLS_MPI_CHK(mbedtls_mpi_lset(&R->Z, 1));
+    }
+
+cleanup:
+    return ret;
+}
+
+/* Same a = -3 formulas as ecp_double_jac() */
+static void p256_double(uint32_t *x3, uint32_t *y3, uint32_t *z3,
+                        const uint32_t *x, const uint32_t *y, const uint32_t *z)
+{
+    p256_fe m, s, t, u;
+
+    /* M = 3(X + Z^2)(X - Z^2) */
+    p256_sqr(s, z);
+    p256_add(t, x, s);
+    p256_sub(u, x, s);
+    p256_mul(s, t, u);
+    p256_add(m, s, s);
+    p256_add(m, m, s);
+
+    /* S = 4.X.Y^2 */
+    p256_sqr(t, y);
+    p256_add(t, t, t);
+    p256_mul(s, x, t);
+    p256_add(s, s, s);
+
+    /* U = 8.Y^4 */
+    p256_sqr(u, t);
+    p256_add(u, u, u);
+
+    /* Z3 = 2.Y.Z, computed first as the outputs may alias the inputs */
+    p256_mul(z3, y, z);
+    p256_add(z3, z3, z3);
+
+    /* X3 = M^2 - 2.S */
+    p256_sqr(t, m);
+    p256_sub(t, t, s);
+    p256_sub(x3, t, s);
+
+    /* Y3 = M(S - X3) - U */
+    p256_sub(s, s, x3);
+    p256_mul(s, s, m);
+    p256_sub(y3, s, u);
+}
+
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+/*
+ * Comb table for the base point, as ecp_precompute_comb() would build it for
+ * the window ecp_mul_comb() picks when P == G (5, clamped to
+ * MBEDTLS_ECP_WINDOW_SIZE): with d = ceil(256 / w),
+ * T[i] = i_{w-1} 2^((w-1)d) G + ... + i_1 2^d G + G, affine, X then Y.
+ */
+#if MBEDTLS_ECP_WINDOW_SIZE < 5
+#define P256_COMB_W     MBEDTLS_ECP_WINDOW_SIZE
+#else
+#define P256_COMB_W     5
+#endif
+
+#if P256_COMB_W == 5
+static const uint32_t p256_comb[16][16] = {
+    {
+        0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+        0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2
+    },
+    {
+        0x04BAC870, 0xF7D24BB7, 0x3A23C6AB, 0x593A09A0, 0xF94C9D1D, 0xDFCC2358, 0x297BED02, 0x3CFA0F87,
+        0x40F26940, 0xCE98A30B, 0x0248A8AF, 0x62121C0D, 0x8309AF9B, 0xA758AA80, 0x70BE12C6, 0xE4E37694
+    },
+    {
+        0x86EF7D7D, 0xDD37E3FF, 0x088B86DB, 0xF6D77C27, 0x254C5491, 0x28FE9A4F, 0x6DF0FD5E, 0xD6690337,
+        0xADDAD596, 0x9FF04992, 0x9E4373F9, 0xF3D1A7AF, 0xDF074167, 0xA13E9578, 0xE6D13D22, 0x20E2A53C
+    },
+    {
+        0x525D6ABF, 0xAEBFD735, 0x96BEA25A, 0xC302F8F4, 0x544920A4, 0xDB82B3EA, 0x02EADB2E, 0x621C75D1,
+        0x9EF485F0, 0x8939DC4C, 0x57C46D63, 0x225D03D8, 0x522D7F70, 0x4FDAC96F, 0xB4FA649D, 0xD7C4A4FE
+    },
+    {
+        0xC0B9372A, 0x8BC659AA, 0xEDD9583F, 0xF7659958, 0x8C267D88, 0x9F05F94A, 0xC99A739D, 0x00DC46E7,
+        0xDF55D0F2, 0x4AF50A00, 0x8156BF6A, 0xB5EB202D, 0x5228C111, 0x40D1E3AB, 0x45793424, 0x0312A557
+    },
+    {
+        0x7EB8CFEE, 0x8D9692F7, 0x0D8C013D, 0x05E3F223, 0x84E32E59, 0x76347A52, 0x15B0A1E5, 0x3C53E290,
+        0xFAE798D4, 0x538B7DA5, 0x00D23591, 0x1B9F1BD1, 0x9A08693F, 0x11A9F072, 0x140EFEB3, 0xD30E7CDA
+    },
+    {
+        0xF8E8F683, 0x6DFCF787, 0x3F7FBE90, 0x13D72B7A, 0x2DF232CF, 0xFD426D94, 0x5FE39AAD, 0xED84BB42,
+        0x732995FC, 0x023E67A1, 0x355430E3, 0x67DD0A8E, 0x97A1D703, 0x0CF83B61, 0x583C33F2, 0xA3233455
+    },
+    {
+        0x5F165D99, 0xCEBBBC7B, 0x8A4EEE61, 0x50CC51C1, 0x1B4D0D1F, 0xB31D2353, 0x66382ADA, 0x95E18452,
+        0x0A839B5B, 0xACAD4F81, 0x4142FF0F, 0xA0A2A96E, 0x1F4FA12F, 0x3EAA8289, 0x6B0FB8F3, 0x68D68C8F
+    },
+    {
+        0x51BBB3F1, 0x9311A269, 0x8D0F4F65, 0xE80F26BD, 0x6BECCBB9, 0x9D3DC334, 0x101E5DE4, 0x54E244D5,
+        0xF1B19E28, 0xB3AD4C6E, 0x58C2E3B7, 0x4334FBC0, 0x35DF9C25, 0x19BD4107, 0xEC106EB6, 0xD6BBEC0E
+    },
+    {
+        0x3FEFCFC8, 0xE8881A83, 0xB9B5290B, 0xAEA3C9E0, 0x771E4688, 0x10B37ECD, 0xD4D021B6, 0xEE0816A3,
+        0xB3A8CAA1, 0x8E9929BF, 0xC105F2D1, 0x48915DCF, 0xDB49019F, 0x3A5FDF82, 0xAD9006E1, 0xC4A438E3
+    },
+    {
+        0xE83AD2C9, 0x5D6DC503, 0xAED035BE, 0xCA9F7A1D, 0xCBD21E33, 0x552788AC, 0xE09CB9F0, 0x8699DD31,
+        0x329BF961, 0x38584196, 0xB82A5AF9, 0x4CB20E96, 0xC72C78C1, 0x24199908, 0xE92859B7, 0x16E65484
+    },
+    {
+        0xDB3038DD, 0xA20A2C70, 0xE99D5C7C, 0x5F0B46D5, 0x4B600B83, 0xC9B97D37, 0x3DF3245E, 0x186C7F79,
+        0x4F1CE57F, 0x2AF72460, 0x91E2D8ED, 0x9249897F, 0x8D2EA797, 0x8139B36A, 0x9AB58913, 0x9C428DB8
+    },
+    {
+        0x4BE6458D, 0x1F1E4F3F, 0x595E6547, 0x5F72CC22, 0x271A93F1, 0x5BC5341E, 0x58A5F263, 0xC62E155C,
+        0x58BA7FF4, 0x5F6F845A, 0x7E36A6AD, 0x67E1F7DC, 0xEEAA4D04, 0xD33A7657, 0x18267E4E, 0xFF9F2322
+    },
+    {
+        0xC7644C1D, 0xE33F0255, 0xBB9002D8, 0x4030ECC3, 0xF4646F9F, 0xA4486916, 0x959C44FA, 0x5E677D0C,
+        0xD88B9144, 0xE2E7D7D0, 0x6248F91F, 0x5D93A86F, 0x02993AEA, 0xE33D0BD5, 0x3100D31E, 0x449F0CE6
+    },
+    {
+        0xFDAAB256, 0x52DF1588, 0x3127354C, 0x68C0CD44, 0xA591F853, 0x2A849471, 0x93D0CB92, 0xE4DA88E9,
+        0x1639C624, 0x6D1EA35D, 0x263707BA, 0x60FE2A36, 0xD0F3BC51, 0x97FC50DE, 0x10062E80, 0xF7FA4D15
+    },
+    {
+        0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0, 0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194,
+        0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4, 0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE
+    },
+};
+#elif P256_COMB_W == 4
+static const uint32_t p256_comb[8][16] = {
+    {
+        0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+        0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2
+    },
+    {
+        0x097992AF, 0x93391CE2, 0x0D35F1FA, 0xE96C98FD, 0x95E02789, 0xB257C0DE, 0x89D6726F, 0x300A4BBC,
+        0xC08127A0, 0xAA54A291, 0xA9D806A5, 0x5BB1EEAD, 0xFF1E3C6F, 0x7F1DDB25, 0xD09B4644, 0x72AAC7E0
+    },
+    {
+        0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B, 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932,
+        0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08, 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3
+    },
+    {
+        0xFC5CDE01, 0xE48ECAFF, 0x0D715F26, 0x7CCD84E7, 0xF43E4391, 0xA2E8F483, 0xB21141EA, 0xEB5D7745,
+        0x731A3479, 0xCAC917E2, 0x2844B645, 0x85F22CFE, 0x58006CEE, 0x0990E6A1, 0xDBECC17B, 0xEAFD72EB
+    },
+    {
+        0x677C8A3E, 0x2DF48C04, 0x0203A56B, 0x74E02F08, 0xB8C7FEDB, 0x31855F7D, 0x72C9DDAD, 0x4E769E76,
+        0xB824BBB0, 0xA4C36165, 0x3B9122A5, 0xFB9AE16F, 0x06947281, 0x1EC00572, 0xDE830663, 0x42B99082
+    },
+    {
+        0xC31A3573, 0x7F991ED2, 0xD54FB496, 0x5B82DD5B, 0x812FFCAE, 0x595C5220, 0x716B1287, 0x0C88BC4D,
+        0x5F48ACA8, 0x3A57BF63, 0xDF2564F3, 0x7C8181F4, 0x9C04E6AA, 0x18D1B5B3, 0xF3901DC6, 0xDD5DDEA3
+    },
+    {
+        0xA2582E7F, 0xD36B4789, 0x4EC39C28, 0x0D1A1014, 0xEDBAD7A0, 0x663C62C3, 0x6F461DB9, 0x4052BF4B,
+        0x188D25EB, 0x235A27C3, 0x99BFCC5B, 0xE724F339, 0x71D70CC8, 0x862BE6BD, 0x90B0FC61, 0xFECF4D51
+    },
+    {
+        0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32, 0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4,
+        0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404, 0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540
+    },
+};
+#elif P256_COMB_W == 3
+static const uint32_t p256_comb[4][16] = {
+    {
+        0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+        0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2
+    },
+    {
+        0x7318188E, 0xAEC90264, 0xCA167099, 0x410BEC28, 0x099C202B, 0xBF664D2F, 0x55FA625C, 0x13CCCA34,
+        0x05421C0C, 0xAA84C231, 0x6CDB0D71, 0x6B647521, 0xFB216A5E, 0xE90446B1, 0xAF46893D, 0x4B5BA5A5
+    },
+    {
+        0x016476EA, 0xC6E4B6D0, 0xD4EC2510, 0x71B9A7E5, 0xCBE490D2, 0x1975B71E, 0xB52ACD25, 0xDF6B472F,
+        0x784055EB, 0xF1738716, 0xB87D399E, 0xCCC7B0B3, 0x1BB51119, 0x3C9A1337, 0xA88FD593, 0xB42639E1
+    },
+    {
+        0xF119B8CC, 0x546A08E7, 0x8AFC696A, 0x03B7D523, 0x459F70B4, 0x0A896132, 0xA86A9116, 0x57A46257,
+        0xBB314C65, 0xFAA56FEF, 0x74795C6D, 0xF4E61F40, 0x437850D6, 0x1A3C5652, 0x6621EC11, 0x7C4B127D
+    },
+};
+#elif P256_COMB_W == 2
+static const uint32_t p256_comb[2][16] = {
+    {
+        0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+        0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2
+    },
+    {
+        0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B, 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932,
+        0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08, 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3
+    },
+};
+#endif
+
+#define P256_COMB_SIZE  (sizeof(p256_comb) / sizeof(p256_comb[0]))
+#endif /* MBEDTLS_ECP_FIXED_POINT_OPTIM == 1 */
+
+unsigned char mbedtls_internal_ecp_grp_capable(const mbedtls_ecp_group *grp)
+{
+    return grp->id == MBEDTLS_ECP_DP_SECP256R1;
+}
+
+int mbedtls_internal_ecp_init(const mbedtls_ecp_group *grp)
+{
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+    /*
+     * Install the flash comb table so that the first multiplication by G
+     * does not pay for ecp_precompute_comb(). ecp.c owns grp->T and frees it
+     * with the group, so the points have to live on the heap.
+     */
+    mbedtls_ecp_group *g = (mbedtls_ecp_group *) grp;
+    mbedtls_ecp_point *T;
+    size_t i;
+    int ret;
+
+    if (g->T != NULL) {
+        return 0;
+    }
+
+    T = mbedtls_calloc(P256_COMB_SIZE, sizeof(mbedtls_ecp_point));
+    if (T == NULL) {
+        /* Not fatal: ecp.c computes the table itself */
+        return 0;
+    }
+
+    for (i = 0; i < P256_COMB_SIZE; i++) {
+        mbedtls_ecp_point_init(&T[i]);
+        MBEDTLS_MPI_CHK(p256_to_point(&T[i], p256_comb[i], p256_comb[i] + P256_WORDS, NULL));
+    }
+
+    g->T = T;
+    g->T_size = P256_COMB_SIZE;
+    return 0;
+
+cleanup:
+    for (i = 0; i < P256_COMB_SIZE; i++) {
+        mbedtls_ecp_point_free(&T[i]);
+    }
+    mbedtls_free(T);
+    return ret;
+#else
+    (void) grp;
+    return 0;
+#endif
+}
+
+void mbedtls_internal_ecp_free(const mbedtls_ecp_group *grp)
+{
+    (void) grp;
+}
+
+#if defined(MBEDTLS_ECP_ADD_MIXED_ALT)
+int mbedtls_internal_ecp_add_mixed(const mbedtls_ecp_group *grp,
+                                   mbedtls_ecp_point *R, const mbedtls_ecp_point *P,
+                                   const mbedtls_ecp_point *Q)
+{
+    p256_fe px, py, pz, qx, qy, t1, t2, t3, t4, x, y, z;
+
+    (void) grp;
+
+    /* Special cases as in ecp_add_mixed(); Q->Z unset means 1 */
+    if (mbedtls_mpi_cmp_int(&P->Z, 0) == 0) {
+        return mbedtls_ecp_copy(R, Q);
+    }
+
+    if (Q->Z.p != NULL && mbedtls_mpi_cmp_int(&Q->Z, 0) == 0) {
+        return mbedtls_ecp_copy(R, P);
+    }
+
+    if (Q->Z.p != NULL && mbedtls_mpi_cmp_int(&Q->Z, 1) != 0) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    p256_from_mpi(px, &P->X);
+    p256_from_mpi(py, &P->Y);
+    p256_from_mpi(pz, &P->Z);
+    p256_from_mpi(qx, &Q->X);
+    p256_from_mpi(qy, &Q->Y);
+
+    p256_sqr(t1, pz);
+    p256_mul(t2, t1, pz);
+    p256_mul(t1, t1, qx);
+    p256_mul(t2, t2, qy);
+    p256_sub(t1, t1, px);
+    p256_sub(t2, t2, py);
+
+    if (p256_is_zero(t1)) {
+        if (p256_is_zero(t2)) {
+            p256_double(x, y, z, px, py, pz);
+            return p256_to_point(R, x, y, z);
+        }
+        return mbedtls_ecp_set_zero(R);
+    }
+
+    p256_mul(z, pz, t1);
+    p256_sqr(t3, t1);
+    p256_mul(t4, t3, t1);
+    p256_mul(t3, t3, px);
+    p256_add(t1, t3, t3);
+    p256_sqr(x, t2);
+    p256_sub(x, x, t1);
+    p256_sub(x, x, t4);
+    p256_sub(t3, t3, x);
+    p256_mul(t3, t3, t2);
+    p256_mul(t4, t4, py);
+    p256_sub(y, t3, t4);
+
+    return p256_to_point(R, x, y, z);
+}
+#endif /* MBEDTLS_ECP_ADD_MIXED_ALT */
+
+#if defined(MBEDTLS_ECP_DOUBLE_JAC_ALT)
+int mbedtls_internal_ecp_double_jac(const mbedtls_ecp_group *grp,
+                                    mbedtls_ecp_point *R, const mbedtls_ecp_point *P)
+{
+    p256_fe x, y, z;
+
+    (void) grp;
+
+    p256_from_mpi(x, &P->X);
+    p256_from_mpi(y, &P->Y);
+    p256_from_mpi(z, &P->Z);
+    p256_double(x, y, z, x, y, z);
+
+    return p256_to_point(R, x, y, z);
+}
+#endif /* MBEDTLS_ECP_DOUBLE_JAC_ALT */
+
+#if defined(MBEDTLS_ECP_NORMALIZE_JAC_ALT)
+int mbedtls_internal_ecp_normalize_jac(const mbedtls_ecp_group *grp,
+                                       mbedtls_ecp_point *pt)
+{
+    p256_fe x, y, zi, zzi;
+
+    (void) grp;
+
+    p256_from_mpi(zi, &pt->Z);
+    p256_inv(zi, zi);
+    p256_sqr(zzi, zi);
+
+    p256_from_mpi(x, &pt->X);
+    p256_from_mpi(y, &pt->Y);
+    p256_mul(x, x, zzi);
+    p256_mul(y, y, zzi);
+    p256_mul(y, y, zi);
+
+    return p256_to_point(pt, x, y, NULL);
+}
+#endif /* MBEDTLS_ECP_NORMALIZE_JAC_ALT */
+
+#if defined(MBEDTLS_ECP_NORMALIZE_JAC_MANY_ALT)
+int mbedtls_internal_ecp_normalize_jac_many(const mbedtls_ecp_group *grp,
+                                            mbedtls_ecp_point *T[], size_t t_len)
+{
+    /* Montgomery's trick: one inversion for the whole batch */
+    p256_fe *c;
+    p256_fe u, zi, zzi, x, y;
+    size_t i;
+    int ret = 0;
+
+    (void) grp;
+
+    c = mbedtls_calloc(t_len, sizeof(p256_fe));
+    if (c == NULL) {
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    /* c[i] = Z_0 * ... * Z_i */
+    p256_from_mpi(c[0], &T[0]->Z);
+    for (i = 1; i < t_len; i++) {
+        p256_from_mpi(zi, &T[i]->Z);
+        p256_mul(c[i], c[i - 1], zi);
+    }
+
+    if (p256_is_zero(c[t_len - 1])) {
+        ret = MBEDTLS_ERR_MPI_NOT_ACCEPTABLE;
+        goto cleanup;
+    }
+
+    /* u = 1 / (Z_0 * ... * Z_n) mod P */
+    p256_inv(u, c[t_len - 1]);
+
+    for (i = t_len - 1; ; i--) {
+        /* Zi = 1 / Z_i, u = 1 / (Z_0 * ... * Z_i-1) */
+        if (i == 0) {
+            memcpy(zi, u, sizeof(zi));
+        } else {
+            p256_mul(zi, u, c[i - 1]);
+            p256_from_mpi(x, &T[i]->Z);
+            p256_mul(u, u, x);
+        }
+
+        p256_sqr(zzi, zi);
+        p256_from_mpi(x, &T[i]->X);
+        p256_from_mpi(y, &T[i]->Y);
+        p256_mul(x, x, zzi);
+        p256_mul(y, y, zzi);
+        p256_mul(y, y, zi);
+
+        /* Z is released rather than set to 1 to save memory, as ecp.c does */
+        MBEDTLS_MPI_CHK(p256_to_mpi(&T[i]->X, x));
+        MBEDTLS_MPI_CHK(p256_to_mpi(&T[i]->Y, y));
+        mbedtls_mpi_free(&T[i]->Z);
+
+        if (i == 0) {
+            break;
+        }
+    }
+
+cleanup:
+    mbedtls_platform_zeroize(c, t_len * sizeof(p256_fe));
+    mbedtls_free(c);
+    return ret;
+}
+#endif /* MBEDTLS_ECP_NORMALIZE_JAC_MANY_ALT */
+
+#endif /* MBEDTLS_ECP_C && MBEDTLS_ECP_INTERNAL_ALT */
@@ -23,6 +23,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <new>
 
 #include "ESP8266.h"
 #include "netsocket/nsapi_types.h"
@@ -35,6 +36,11 @@
 #define TRACE_GROUP  "ESPA" // ESP8266 AT layer
 
 #define ESP8266_ALL_SOCKET_IDS      -1
+// id of a released packet in the pool
+#define ESP8266_FREE_PACKET_ID      -1
+
+// +CIPRECVDATA supports up to 2048 bytes at a time
+#define ESP8266_RECV_DATA_MAX       2048
 
 #define ESP8266_DEFAULT_SERIAL_BAUDRATE 115200
 
@@ -51,11 +57,17 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
       _serial(tx, rx, MBED_CONF_ESP8266_SERIAL_BAUDRATE),
       _serial_rts(rts),
       _serial_cts(cts),
+      _baud(ESP8266_DEFAULT_SERIAL_BAUDRATE),
+      _uart_fc(0),
       _parser(&_serial),
       _packets(0),
       _packets_end(&_packets),
       _sock_active_id(-1),
       _heap_usage(0),
+      _pool(NULL),
+      _pool_head(0),
+      _pool_tail(0),
+      _pool_used(0),
       _connect_error(0),
       _disconnect(false),
       _fail(false),
@@ -115,6 +127,12 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
     _scan_r.cnt = 0;
 }
 
+ESP8266::~ESP8266()
+{
+    _clear_socket_packets(ESP8266_ALL_SOCKET_IDS);
+    delete[] _pool;
+}
+
 bool ESP8266::at_available()
 {
     bool ready = false;
@@ -127,13 +145,21 @@ bool ESP8266::at_available()
         if (ready) {
             break;
         }
+        if (_baud != ESP8266_DEFAULT_SERIAL_BAUDRATE) {
+            // Reset by HW, ESP8266 is back to its default baud-rate
+            _serial.set_baud(ESP8266_DEFAULT_SERIAL_BAUDRATE);
+            _baud = ESP8266_DEFAULT_SERIAL_BAUDRATE;
+            _uart_fc = 0;
+        }
         tr_debug("at_available(): Waiting AT response.");
     }
     // Switch baud-rate from default one to assigned one
-    if (MBED_CONF_ESP8266_SERIAL_BAUDRATE !=  ESP8266_DEFAULT_SERIAL_BAUDRATE) {
+    if (MBED_CONF_ESP8266_SERIAL_BAUDRATE !=  ESP8266_DEFAULT_SERIAL_BAUDRATE && _baud == ESP8266_DEFAULT_SERIAL_BAUDRATE) {
         ready &= _parser.send("AT+UART_CUR=%u,8,1,0,0", MBED_CONF_ESP8266_SERIAL_BAUDRATE)
                  && _parser.recv("OK\n");
         _serial.set_baud(MBED_CONF_ESP8266_SERIAL_BAUDRATE);
+        _baud = MBED_CONF_ESP8266_SERIAL_BAUDRATE;
+        _uart_fc = 0;
         ready &= _parser.send("AT")
                  && _parser.recv("OK\n");
     }
@@ -203,8 +229,11 @@ bool ESP8266::stop_uart_hw_flow_ctrl(void)
         _serial.set_flow_control(SerialBase::Disabled, _serial_rts, _serial_cts);
 
         // Stop ESP8266's flow control
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,0", MBED_CONF_ESP8266_SERIAL_BAUDRATE)
+        done = _parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,0", _baud)
                && _parser.recv("OK\n");
+        if (done) {
+            _uart_fc = 0;
+        }
     }
 
 #endif
@@ -219,10 +248,11 @@ bool ESP8266::start_uart_hw_flow_ctrl(void)
     _smutex.lock();
     if (_serial_rts != NC && _serial_cts != NC) {
         // Start ESP8266's flow control
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,3", MBED_CONF_ESP8266_SERIAL_BAUDRATE)
+        done = _parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,3", _baud)
                && _parser.recv("OK\n");
 
         if (done) {
+            _uart_fc = 3;
             // Start board's flow control
             _serial.set_flow_control(SerialBase::RTSCTS, _serial_rts, _serial_cts);
         }
@@ -231,15 +261,19 @@ bool ESP8266::start_uart_hw_flow_ctrl(void)
         _serial.set_flow_control(SerialBase::RTS, _serial_rts, NC);
 
         // Enable ESP8266's CTS pin
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,2", MBED_CONF_ESP8266_SERIAL_BAUDRATE)
+        done = _parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,2", _baud)
                && _parser.recv("OK\n");
+        if (done) {
+            _uart_fc = 2;
+        }
 
     } else if (_serial_cts != NC) {
         // Enable ESP8266's RTS pin
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,1", MBED_CONF_ESP8266_SERIAL_BAUDRATE)
+        done = _parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,1", _baud)
                && _parser.recv("OK\n");
 
         if (done) {
+            _uart_fc = 1;
             _serial.set_flow_control(SerialBase::CTS, NC, _serial_cts);
         }
     }
@@ -256,6 +290,64 @@ bool ESP8266::start_uart_hw_flow_ctrl(void)
     return done;
 }
 
+bool ESP8266::negotiate_baud(uint32_t max_baud)
+{
+    // highest first, the first one that works is kept
+    static const uint32_t rates[] = { 3000000, 2000000, 1500000, 1000000, 921600, 460800, 230400 };
+    bool done = true;
+
+#if DEVICE_SERIAL_FC
+    _smutex.lock();
+    if (_uart_fc != 3) {
+        tr_debug("negotiate_baud(): RTS and CTS flow control needed, staying at %" PRIu32, _baud);
+        _smutex.unlock();
+        return true;
+    }
+
+    uint32_t baud = _baud;
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        if (rates[i] > max_baud || rates[i] <= baud) {
+            continue;
+        }
+
+        // ESP8266 switches after its OK, which may be lost if it didn't switch: verify in both cases
+        (void)(_parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,%d", rates[i], _uart_fc)
+               && _parser.recv("OK\n"));
+        _serial.set_baud(rates[i]);
+        if (_link_ok()) {
+            _baud = rates[i];
+            tr_info("negotiate_baud(): UART at %" PRIu32, _baud);
+            break;
+        }
+
+        // revert, ESP8266 is either at the new rate or didn't switch
+        tr_debug("negotiate_baud(): %" PRIu32 " failed", rates[i]);
+        (void)(_parser.send("AT+UART_CUR=%" PRIu32 ",8,1,0,%d", baud, _uart_fc)
+               && _parser.recv("OK\n"));
+        _serial.set_baud(baud);
+        if (!_link_ok()) {
+            tr_error("negotiate_baud(): link lost at %" PRIu32, baud);
+            done = false;
+            break;
+        }
+    }
+    _smutex.unlock();
+#endif
+
+    return done;
+}
+
+bool ESP8266::_link_ok()
+{
+    _parser.flush();
+    for (int i = 0; i < 3; i++) {
+        if (!(_parser.send("AT+GMR") && _parser.recv("OK\n"))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ESP8266::startup(int mode)
 {
     if (!(mode == WIFIMODE_STATION || mode == WIFIMODE_SOFTAP
@@ -291,6 +383,11 @@ bool ESP8266::reset(void)
             continue;
         }
 
+        // ESP8266 restarts at its default baud-rate, without flow control
+        _serial.set_baud(ESP8266_DEFAULT_SERIAL_BAUDRATE);
+        _baud = ESP8266_DEFAULT_SERIAL_BAUDRATE;
+        _uart_fc = 0;
+
         while (!_reset_done) {
             _process_oob(ESP8266_RECV_TIMEOUT, true); // UART mutex claimed -> need to check for OOBs ourselves
             if (_reset_done || rtos::Kernel::Clock::now() - start_time >= ESP8266_BOOTTIME) {
@@ -810,7 +907,6 @@ void ESP8266::_oob_packet_hdlr()
     int id;
     int port;
     int amount;
-    int pdu_len;
 
     // Get socket id
     if (!_parser.scanf(",%d,", &id)) {
@@ -837,19 +933,10 @@ void ESP8266::_oob_packet_hdlr()
         }
     }
 
-    pdu_len = sizeof(struct packet) + amount;
-
-    if ((_heap_usage + pdu_len) > MBED_CONF_ESP8266_SOCKET_BUFSIZE) {
-        tr_debug("\"esp8266.socket-bufsize\"-limit exceeded, packet dropped");
-        return;
-    }
-
-    struct packet *packet = (struct packet *)malloc(pdu_len);
+    struct packet *packet = _packet_alloc(amount);
     if (!packet) {
-        tr_debug("_oob_packet_hdlr(): Out of memory, unable to allocate memory for packet.");
         return;
     }
-    _heap_usage += pdu_len;
 
     packet->id = id;
     if (_sock_i[id].proto == NSAPI_UDP) {
@@ -857,12 +944,10 @@ void ESP8266::_oob_packet_hdlr()
         memcpy(packet->remote_ip, _ip_buffer, 16);
     }
     packet->len = amount;
-    packet->alloc_len = amount;
     packet->next = 0;
 
     if (_parser.read((char *)(packet + 1), amount) < amount) {
-        free(packet);
-        _heap_usage -= pdu_len;
+        _packet_free(packet);
         return;
     }
 
@@ -871,6 +956,99 @@ void ESP8266::_oob_packet_hdlr()
     _packets_end = &packet->next;
 }
 
+struct ESP8266::packet *ESP8266::_packet_alloc(uint32_t amount)
+{
+    uint32_t pdu_len = sizeof(struct packet) + amount;
+
+    if ((_heap_usage + pdu_len) > MBED_CONF_ESP8266_SOCKET_BUFSIZE) {
+        tr_debug("\"esp8266.socket-bufsize\"-limit exceeded, packet dropped");
+        return NULL;
+    }
+
+#if MBED_CONF_ESP8266_PACKET_POOL
+    // whole packets of alignment size, so that each one starts aligned
+    uint32_t size = (pdu_len + alignof(struct packet) - 1) & ~(alignof(struct packet) - 1);
+    const uint32_t pool_size = MBED_CONF_ESP8266_SOCKET_BUFSIZE & ~(alignof(struct packet) - 1);
+
+    if (!_pool) {
+        _pool = new (std::nothrow) char[pool_size];
+    }
+    struct packet *packet = NULL;
+    if (_pool && size <= pool_size) {
+        if (!_pool_used) {
+            _pool_head = 0;
+            _pool_tail = 0;
+        }
+        if (_pool_used && _pool_head == _pool_tail) {
+            // full
+        } else if (_pool_head < _pool_tail) {
+            if (_pool_tail - _pool_head >= size) {
+                packet = (struct packet *)(_pool + _pool_head);
+            }
+        } else if (pool_size - _pool_head >= size) {
+            packet = (struct packet *)(_pool + _pool_head);
+        } else if (_pool_tail >= size) {
+            // skip the end of the pool, a released packet marks it if it has room for one
+            uint32_t skip = pool_size - _pool_head;
+            if (skip >= sizeof(struct packet)) {
+                struct packet *end = (struct packet *)(_pool + _pool_head);
+                end->id = ESP8266_FREE_PACKET_ID;
+                end->alloc_len = skip - sizeof(struct packet);
+            }
+            _pool_used += skip;
+            _pool_head = 0;
+            packet = (struct packet *)_pool;
+        }
+    }
+    if (packet) {
+        _pool_head += size;
+        _pool_used += size;
+    }
+#else
+    struct packet *packet = (struct packet *)malloc(pdu_len);
+#endif
+    if (!packet) {
+        tr_debug("_oob_packet_hdlr(): Out of memory, unable to allocate memory for packet.");
+        return NULL;
+    }
+
+    _heap_usage += pdu_len;
+    packet->alloc_len = amount;
+    return packet;
+}
+
+void ESP8266::_packet_free(struct packet *p)
+{
+    _heap_usage -= sizeof(struct packet) + p->alloc_len;
+
+#if MBED_CONF_ESP8266_PACKET_POOL
+    const uint32_t pool_size = MBED_CONF_ESP8266_SOCKET_BUFSIZE & ~(alignof(struct packet) - 1);
+
+    // packets are released in any order, the space is reclaimed in allocation order
+    p->id = ESP8266_FREE_PACKET_ID;
+    while (_pool_used) {
+        if (pool_size - _pool_tail < sizeof(struct packet)) {
+            // end of the pool too short for a packet, skipped when wrapping
+            _pool_used -= pool_size - _pool_tail;
+            _pool_tail = 0;
+            continue;
+        }
+        struct packet *tail = (struct packet *)(_pool + _pool_tail);
+        if (tail->id != ESP8266_FREE_PACKET_ID) {
+            break;
+        }
+        uint32_t size = (sizeof(struct packet) + tail->alloc_len + alignof(struct packet) - 1) & ~(alignof(struct packet) - 1);
+        _pool_used -= size;
+        _pool_tail += size;
+        if (_pool_tail == pool_size) {
+            _pool_tail = 0;
+        }
+    }
+#else
+    free(p);
+#endif
+}
+
 void ESP8266::_process_oob(duration<uint32_t, milli> timeout, bool all)
 {
     set_timeout(timeout);
@@ -890,44 +1068,59 @@ void ESP8266::bg_process_oob(duration<uint32_t, milli> timeout, bool all)
 int32_t ESP8266::_recv_tcp_passive(int id, void *data, uint32_t amount, duration<uint32_t, milli> timeout)
 {
     int32_t ret = NSAPI_ERROR_WOULD_BLOCK;
+    uint32_t received = 0;
 
     _smutex.lock();
 
     _process_oob(timeout, true);
 
-    if (_sock_i[id].tcp_data_avbl != 0) {
-        _sock_i[id].tcp_data = (char *)data;
+    // the data is read straight into the caller's buffer, in as many +CIPRECVDATA as it takes
+    // to fill it with the data waiting on the modem
+    while (_sock_i[id].tcp_data_avbl != 0 && received < amount) {
+        _sock_i[id].tcp_data = (char *)data + received;
         _sock_i[id].tcp_data_rcvd = NSAPI_ERROR_WOULD_BLOCK;
         _sock_active_id = id;
 
-        // +CIPRECVDATA supports up to 2048 bytes at a time
-        amount = amount > 2048 ? 2048 : amount;
+        uint32_t chunk = amount - received;
+        chunk = chunk > ESP8266_RECV_DATA_MAX ? ESP8266_RECV_DATA_MAX : chunk;
 
         // NOTE: documentation v3.0 says '+CIPRECVDATA:<data_len>,' but it's not how the FW responds...
-        bool done = _parser.send("AT+CIPRECVDATA=%d,%" PRIu32, id, amount)
+        bool done = _parser.send("AT+CIPRECVDATA=%d,%" PRIu32, id, chunk)
                     && _parser.recv("OK\n");
 
         _sock_i[id].tcp_data = NULL;
         _sock_active_id = -1;
 
         if (!done) {
+            if (received) {
+                // return what was read, the error shows up on the next call
+                break;
+            }
             goto BUSY;
         }
 
+        if (_sock_i[id].tcp_data_rcvd <= 0) {
+            break;
+        }
+
         // update internal variable tcp_data_avbl to reflect the remaining data
-        if (_sock_i[id].tcp_data_rcvd > 0) {
-            if (_sock_i[id].tcp_data_rcvd > (int32_t)amount) {
-                MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER, MBED_ERROR_CODE_EBADMSG), \
-                           "ESP8266::_recv_tcp_passive() too much data from modem\n");
-            }
-            if (_sock_i[id].tcp_data_avbl > _sock_i[id].tcp_data_rcvd) {
-                _sock_i[id].tcp_data_avbl -= _sock_i[id].tcp_data_rcvd;
-            } else {
-                _sock_i[id].tcp_data_avbl = 0;
-            }
+        if (_sock_i[id].tcp_data_rcvd > (int32_t)chunk) {
+            MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER, MBED_ERROR_CODE_EBADMSG), \
+                       "ESP8266::_recv_tcp_passive() too much data from modem\n");
         }
+        if (_sock_i[id].tcp_data_avbl > _sock_i[id].tcp_data_rcvd) {
+            _sock_i[id].tcp_data_avbl -= _sock_i[id].tcp_data_rcvd;
+        } else {
+            _sock_i[id].tcp_data_avbl = 0;
+        }
+        received += _sock_i[id].tcp_data_rcvd;
+
+        // the modem may have notified more data meanwhile
+        _process_oob(0ms, true);
+    }
 
-        ret = _sock_i[id].tcp_data_rcvd;
+    if (received) {
+        ret = received;
     }
 
     if (!_sock_i[id].open && ret == NSAPI_ERROR_WOULD_BLOCK) {
@@ -968,26 +1161,25 @@ int32_t ESP8266::recv_tcp(int id, void *data, uint32_t amount, duration<uint32_t
         if ((*p)->id == id) {
             struct packet *q = *p;
 
+            // data not read yet is at the end of the packet
+            const char *pdu = (const char *)(q + 1) + (q->alloc_len - q->len);
+
             if (q->len <= amount) { // Return and remove full packet
-                memcpy(data, q + 1, q->len);
+                memcpy(data, pdu, q->len);
 
                 if (_packets_end == &(*p)->next) {
                     _packets_end = p;
                 }
                 *p = (*p)->next;
 
-                _smutex.unlock();
-
-                uint32_t pdu_len = sizeof(struct packet) + q->alloc_len;
                 uint32_t len = q->len;
-                free(q);
-                _heap_usage -= pdu_len;
+                _packet_free(q);
+                _smutex.unlock();
                 return len;
             } else { // return only partial packet
-                memcpy(data, q + 1, amount);
+                memcpy(data, pdu, amount);
 
                 q->len -= amount;
-                memmove(q + 1, (uint8_t *)(q + 1) + amount, q->len);
 
                 _smutex.unlock();
                 return amount;
@@ -1035,11 +1227,9 @@ int32_t ESP8266::recv_udp(struct esp8266_socket *socket, void *data, uint32_t am
                 _packets_end = p;
             }
             *p = (*p)->next;
-            _smutex.unlock();
 
-            uint32_t pdu_len = sizeof(struct packet) + q->alloc_len;
-            free(q);
-            _heap_usage -= pdu_len;
+            _packet_free(q);
+            _smutex.unlock();
             return len;
         }
     }
@@ -1061,14 +1251,12 @@ void ESP8266::_clear_socket_packets(int id)
     while (*p) {
         if ((*p)->id == id || id == ESP8266_ALL_SOCKET_IDS) {
             struct packet *q = *p;
-            int pdu_len = sizeof(struct packet) + q->alloc_len;
 
             if (_packets_end == &(*p)->next) {
                 _packets_end = p; // Set last packet next field/_packets
             }
             *p = (*p)->next;
-            free(q);
-            _heap_usage -= pdu_len;
+            _packet_free(q);
         } else {
             // Point to last packet next field
             p = &(*p)->next;
@@ -85,6 +85,7 @@ struct esp8266_socket {
 class ESP8266 {
 public:
     ESP8266(PinName tx, PinName rx, bool debug = false, PinName rts = NC, PinName cts = NC);
+    ~ESP8266();
 
     /**
     * ESP8266 firmware SDK version
@@ -459,6 +460,19 @@ public:
      */
     bool stop_uart_hw_flow_ctrl();
 
+    /**
+     * Raise the UART baud rate of the board and of ESP8266 to the highest rate, up to max_baud,
+     * that the link sustains. The rates are tried from the highest down, each one is verified
+     * with a few AT+GMR round trips, and a failing one is reverted.
+     *
+     * Requires UART HW flow control with both RTS and CTS, see start_uart_hw_flow_ctrl(),
+     * the baud rate isn't changed otherwise.
+     *
+     * @param max_baud Highest baud rate to try
+     * @return true if ESP8266 answers, at the raised or at the current baud rate
+     */
+    bool negotiate_baud(uint32_t max_baud);
+
     /*
      * From AT firmware v1.7.0.0 onwards enables TCP passive mode
      */
@@ -508,11 +522,15 @@ private:
     mbed::BufferedSerial _serial;
     PinName _serial_rts;
     PinName _serial_cts;
+    uint32_t _baud;     // current baud rate of the link
+    int _uart_fc;       // flow control of AT+UART_CUR
     rtos::Mutex _smutex; // Protect serial port access
 
     // AT Command Parser
     mbed::ATCmdParser _parser;
 
+    bool _link_ok();
+
     // Wifi scan result handling
     bool _recv_ap(nsapi_wifi_ap_t *ap);
 
@@ -533,6 +551,14 @@ private:
     // Memory statistics
     size_t _heap_usage; // (Socket data buffer usage)
 
+    // Packets are allocated in FIFO order from the pool, see esp8266.packet-pool
+    struct packet *_packet_alloc(uint32_t amount);
+    void _packet_free(struct packet *p);
+    char *_pool;
+    uint32_t _pool_head; // where the next packet is allocated
+    uint32_t _pool_tail; // oldest packet not released yet
+    uint32_t _pool_used; // including the unused end of the pool when wrapped
+
     // OOB processing
     void _process_oob(std::chrono::duration<uint32_t, std::milli> timeout, bool all);
 
@@ -733,6 +733,11 @@ nsapi_error_t ESP8266Interface::_init(void)
         if (!_esp.start_uart_hw_flow_ctrl()) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
+#ifdef MBED_CONF_ESP8266_SERIAL_BAUDRATE_MAX
+        if (!_esp.negotiate_baud(MBED_CONF_ESP8266_SERIAL_BAUDRATE_MAX)) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+#endif
         if (!_get_firmware_ok()) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
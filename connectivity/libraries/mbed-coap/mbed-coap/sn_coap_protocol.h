@@ -260,6 +260,28 @@ extern int8_t sn_coap_convert_block_size(uint16_t block_size);
  */
 extern int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle, uint8_t handle_response);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_block_callback(struct coap_s *handle, int8_t (*block_callback_ptr)(const sn_coap_hdr_s *, const sn_nsdl_addr_s *, uint32_t, uint8_t, void *))
+ *
+ * \brief Streams received blockwise payloads to a callback instead of assembling them.
+ *
+ * Each received Block1 or Block2 payload is given to the callback once, in order, with
+ * its offset in the whole payload. Out of order blocks are refused. The payload is not
+ * stored, so the size of a transfer is not limited by SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE.
+ * The message of the last block is still returned with COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED
+ * status, but its payload is only the last block, already given to the callback.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param block_callback_ptr Callback called with the message carrying the block, the source address,
+ *        the offset of the block, 1 if more blocks follow, and the parameter given to sn_coap_protocol_parse().
+ *        It returns 0 on success, or a negative value to abort the transfer. Set to NULL to assemble
+ *        the payloads again.
+ *
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_block_callback(struct coap_s *handle,
+        int8_t (*block_callback_ptr)(const sn_coap_hdr_s *, const sn_nsdl_addr_s *, uint32_t, uint8_t, void *));
+
 /**
  * \fn void sn_coap_protocol_clear_sent_blockwise_messages(struct coap_s *handle)
  *
@@ -283,4 +283,52 @@
 #define SN_COAP_REDUCE_BLOCKWISE_HEAP_FOOTPRINT              0   /**< Disabled by default */
 #endif
 
+/**
+ * \def SN_COAP_MESSAGE_POOL_SIZE
+ * \brief Number of CoAP message headers and option lists preallocated in each CoAP handle.
+ * Parsed and built messages take them from the pool before falling back to the
+ * malloc function given to sn_coap_protocol_init(). Messages must then be freed
+ * with sn_coap_parser_release_allocated_coap_msg_mem().
+ * Setting of this value to 0 disables the pool. Maximum is 32.
+ * By default, this feature is disabled.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_MESSAGE_POOL_SIZE
+#define SN_COAP_MESSAGE_POOL_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_MESSAGE_POOL_SIZE
+#endif
+
+#ifndef SN_COAP_MESSAGE_POOL_SIZE
+#define SN_COAP_MESSAGE_POOL_SIZE                            0   /**< Disabled by default */
+#endif
+
+/**
+ * \def SN_COAP_DUPLICATION_HASH_SIZE
+ * \brief Number of buckets of the message ID hash table used for message duplication detection.
+ * Without it every received message is compared with all the stored duplication infos.
+ * Must be a power of two. Setting of this value to 0 disables the hash table.
+ * By default, this feature is disabled.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_HASH_SIZE
+#endif
+
+#ifndef SN_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE                        0   /**< Disabled by default */
+#endif
+
+/**
+ * \def SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+ * \brief Number of one second slots of the timer wheel used for message resending.
+ * Without it sn_coap_protocol_exec() checks all the stored messages on every call.
+ * With it, only the messages of the slots that became due since the previous call are checked.
+ * Setting of this value to 0 disables the timer wheel.
+ * By default, this feature is disabled.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+#define SN_COAP_RESENDING_TIMER_WHEEL_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+#endif
+
+#ifndef SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+#define SN_COAP_RESENDING_TIMER_WHEEL_SIZE                   0   /**< Disabled by default */
+#endif
+
 #endif // SN_CONFIG_H
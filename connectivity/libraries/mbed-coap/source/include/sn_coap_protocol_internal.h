@@ -41,6 +41,14 @@ struct sn_coap_hdr_;
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
 #define COAP_OPTION_BLOCK_NONE                      (-1) /**< Internal value to represent no Block1/2 option */
 
+#if SN_COAP_MESSAGE_POOL_SIZE > 32
+#error "SN_COAP_MESSAGE_POOL_SIZE must be at most 32"
+#endif
+
+#if SN_COAP_DUPLICATION_HASH_SIZE & (SN_COAP_DUPLICATION_HASH_SIZE - 1)
+#error "SN_COAP_DUPLICATION_HASH_SIZE must be a power of two"
+#endif
+
 int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coap_hdr_ptr);
 
 /* Structure which is stored to Linked list for message sending purposes */
@@ -53,9 +61,17 @@ typedef struct coap_send_msg_ {
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
     ns_list_link_t      link;
+
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+    uint16_t            wheel_slot;         /* Timer wheel slot of the resending time */
+    ns_list_link_t      wheel_link;
+#endif
 } coap_send_msg_s;
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+typedef NS_LIST_HEAD(coap_send_msg_s, wheel_link) coap_send_msg_wheel_slot_t;
+#endif
 
 /* Structure which is stored to Linked list for message duplication detection purposes */
 typedef struct coap_duplication_info_ {
@@ -66,9 +82,15 @@ typedef struct coap_duplication_info_ {
     sn_nsdl_addr_s      *address;
     void                *param;
     ns_list_link_t      link;
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    ns_list_link_t      hash_link;
+#endif
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
+#if SN_COAP_DUPLICATION_HASH_SIZE
+typedef NS_LIST_HEAD(coap_duplication_info_s, hash_link) coap_duplication_info_bucket_t;
+#endif
 
 /* Structure which is stored to Linked list for blockwise messages sending purposes */
 typedef struct coap_blockwise_msg_ {
@@ -114,11 +136,18 @@ struct coap_s {
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
         uint16_t count_resent_msgs;
+        #if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+            coap_send_msg_wheel_slot_t resending_wheel[SN_COAP_RESENDING_TIMER_WHEEL_SIZE]; /* Active resending messages by resending time */
+            uint32_t                   resending_wheel_time; /* System time of the last visited slot */
+        #endif
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
         uint16_t                      count_duplication_msgs;
+        #if SN_COAP_DUPLICATION_HASH_SIZE
+            coap_duplication_info_bucket_t duplication_hash[SN_COAP_DUPLICATION_HASH_SIZE]; /* Same messages by Message ID */
+        #endif
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
@@ -134,6 +163,14 @@ struct coap_s {
     uint8_t sn_coap_resending_intervall;
     uint8_t sn_coap_duplication_buffer_size;
     uint8_t sn_coap_internal_block2_resp_handling; /* If this is set then coap itself sends a next GET request automatically */
+    int8_t (*sn_coap_block_callback)(const sn_coap_hdr_s *, const sn_nsdl_addr_s *, uint32_t, uint8_t, void *); /* If this is set then received blocks are streamed to it */
+
+    #if SN_COAP_MESSAGE_POOL_SIZE /* If the message pool is not used at all, this part of code will not be compiled */
+        sn_coap_hdr_s          message_pool[SN_COAP_MESSAGE_POOL_SIZE];
+        sn_coap_options_list_s options_pool[SN_COAP_MESSAGE_POOL_SIZE];
+        uint32_t               message_pool_used; /* Bit per pool entry, set when in use */
+        uint32_t               options_pool_used;
+    #endif
 };
 
 /* Utility function which performs a call to sn_coap_protocol_malloc() and memset's the result to zero. */
@@ -142,6 +179,14 @@ void *sn_coap_protocol_calloc(struct coap_s *handle, uint16_t length);
 /* Utility function which performs a call to sn_coap_protocol_malloc() and memcopy's the source to result buffer. */
 void *sn_coap_protocol_malloc_copy(struct coap_s *handle, const void *source, uint16_t length);
 
+/* Utility functions which take message headers and option lists from the message pool, or call sn_coap_protocol_malloc() when it is empty. */
+sn_coap_hdr_s *sn_coap_protocol_alloc_message(struct coap_s *handle);
+sn_coap_options_list_s *sn_coap_protocol_alloc_options(struct coap_s *handle);
+
+/* Utility functions which give message headers and option lists back to the message pool, or call sn_coap_protocol_free(). */
+void sn_coap_protocol_free_message(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr);
+void sn_coap_protocol_free_options(struct coap_s *handle, sn_coap_options_list_s *options_list_ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,8 +78,8 @@ sn_coap_hdr_s *sn_coap_parser_alloc_message_with_options(struct coap_s *handle)
     if ((coap_msg_ptr == NULL) || (options_list_ptr == NULL)) {
 
         // oops, out of memory free if got already any
-        handle->sn_coap_protocol_free(coap_msg_ptr);
-        handle->sn_coap_protocol_free(options_list_ptr);
+        sn_coap_protocol_free_message(handle, coap_msg_ptr);
+        sn_coap_protocol_free_options(handle, options_list_ptr);
 
         coap_msg_ptr = NULL;
     }
@@ -97,7 +97,7 @@ sn_coap_hdr_s *sn_coap_parser_alloc_message(struct coap_s *handle)
     }
 
     /* * * * Allocate memory for returned CoAP message and initialize allocated memory with with default values  * * * */
-    returned_coap_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(sn_coap_hdr_s));
+    returned_coap_msg_ptr = sn_coap_protocol_alloc_message(handle);
 
     return sn_coap_parser_init_message(returned_coap_msg_ptr);
 }
@@ -118,13 +118,15 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
 
     /* * * * Allocate memory for options and initialize allocated memory with with default values  * * * */
     /* XXX not technically legal to memset pointers to 0 */
-    options_list_ptr = sn_coap_protocol_calloc(handle, sizeof(sn_coap_options_list_s));
+    options_list_ptr = sn_coap_protocol_alloc_options(handle);
 
     if (options_list_ptr == NULL) {
         tr_error("sn_coap_parser_alloc_options - failed to allocate options list!");
         return NULL;
     }
 
+    memset(options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+
     coap_msg_ptr->options_list_ptr = options_list_ptr;
 
     options_list_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
@@ -206,10 +208,10 @@ void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coa
 
             local_free(options_list_ptr->uri_query_ptr);
 
-            local_free(options_list_ptr);
+            sn_coap_protocol_free_options(handle, options_list_ptr);
         }
 
-        local_free(freed_coap_msg_ptr);
+        sn_coap_protocol_free_message(handle, freed_coap_msg_ptr);
     }
 }
 
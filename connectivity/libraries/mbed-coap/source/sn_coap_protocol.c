@@ -52,6 +52,7 @@ static void                  sn_coap_protocol_linked_list_duplication_info_store
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 static void                  sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
+static void                  sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data_all(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 
@@ -60,6 +61,7 @@ static bool                  sn_coap_protocol_update_duplicate_package_data_all(
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not enabled, this part of code will not be compiled */
 static void                     sn_coap_protocol_linked_list_blockwise_msg_remove(struct coap_s *handle, coap_blockwise_msg_s *removed_msg_ptr);
 static void                     sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t payload_len, uint8_t *payload_ptr, uint8_t *token_ptr, uint8_t token_len, uint32_t block_number, uint32_t size1);
+static bool                     sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, const sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option, void *param);
 static uint8_t                  *sn_coap_protocol_linked_list_blockwise_payload_search(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t *payload_length, const uint8_t *token_ptr, uint8_t token_len);
 static coap_blockwise_payload_s *sn_coap_protocol_linked_list_blockwise_search(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, const uint8_t *token_ptr, uint8_t token_len);
 static bool                     sn_coap_protocol_linked_list_blockwise_payload_search_compare_block_number(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, const uint8_t *token_ptr, uint8_t token_len, uint32_t block_number);
@@ -76,6 +78,11 @@ static int16_t                  store_blockwise_copy(struct coap_s *handle, cons
 #if ENABLE_RESENDINGS
 static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param);
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_resend_msg(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr, uint32_t current_time);
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+static void                  sn_coap_protocol_resending_wheel_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+#endif
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
 static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
@@ -106,7 +113,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
 
-        ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
+        sn_coap_protocol_duplication_info_unlink(handle, tmp);
 
         sn_coap_protocol_duplication_info_free(handle, tmp);
     }
@@ -162,6 +169,11 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
     handle->sn_coap_resending_queue_bytes = SN_COAP_RESENDING_QUEUE_SIZE_BYTES;
     handle->sn_coap_resending_intervall = DEFAULT_RESPONSE_TIMEOUT;
     handle->sn_coap_resending_count = SN_COAP_RESENDING_MAX_COUNT;
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+    for (uint16_t i = 0; i < SN_COAP_RESENDING_TIMER_WHEEL_SIZE; i++) {
+        ns_list_init(&handle->resending_wheel[i]);
+    }
+#endif
 
 
 #endif /* ENABLE_RESENDINGS */
@@ -170,6 +182,11 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
     /* * * * Create Linked list for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    for (uint16_t i = 0; i < SN_COAP_DUPLICATION_HASH_SIZE; i++) {
+        ns_list_init(&handle->duplication_hash[i]);
+    }
+#endif
 #endif
 
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not enabled, this part of code will not be compiled */
@@ -194,6 +211,17 @@ int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle,
     return 0;
 }
 
+int8_t sn_coap_protocol_set_block_callback(struct coap_s *handle,
+        int8_t (*block_callback_ptr)(const sn_coap_hdr_s *, const sn_nsdl_addr_s *, uint32_t, uint8_t, void *))
+{
+    if (handle == NULL) {
+        return -1;
+    }
+
+    handle->sn_coap_block_callback = block_callback_ptr;
+    return 0;
+}
+
 int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size)
 {
     (void) handle;
@@ -315,9 +343,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -332,8 +359,7 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
         if (tmp->send_msg_ptr.packet_ptr) {
             uint16_t temp_msg_id = read_packet_msg_id(tmp);
             if (temp_msg_id == msg_id) {
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
                 return 0;
             }
@@ -357,8 +383,7 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, co
             if (memcmp(&stored_msg->send_msg_ptr.packet_ptr[4], token, stored_token_len) == 0) {
 
                 tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %" PRIu16, read_packet_msg_id(stored_msg));
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg);
@@ -866,54 +891,42 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
 #if ENABLE_RESENDINGS
     /* Check if there is ongoing active message sendings */
     /* foreach_safe isn't sufficient because callback routine could cancel messages. */
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+    /* Only the slots of the seconds elapsed since the previous call can hold messages to be sent */
+    uint32_t elapsed_slots = current_time > handle->resending_wheel_time ? current_time - handle->resending_wheel_time : 0;
+    if (elapsed_slots > SN_COAP_RESENDING_TIMER_WHEEL_SIZE) {
+        elapsed_slots = SN_COAP_RESENDING_TIMER_WHEEL_SIZE;
+    }
+    handle->resending_wheel_time = current_time;
+
+    for (uint32_t slot_time = current_time - elapsed_slots + 1; elapsed_slots > 0; slot_time++, elapsed_slots--) {
+        coap_send_msg_wheel_slot_t *slot_ptr = &handle->resending_wheel[slot_time % SN_COAP_RESENDING_TIMER_WHEEL_SIZE];
+rescan:
+        ns_list_foreach(coap_send_msg_s, stored_msg_ptr, slot_ptr) {
+            /* The slot also holds messages of the next turns of the wheel */
+            if (current_time >= stored_msg_ptr->resending_time) {
+                sn_coap_protocol_resend_msg(handle, stored_msg_ptr, current_time);
+
+                /* Callback routine could have wiped the list (eg as a response to sending failed) */
+                /* Be super cautious and rescan from the start */
+                goto rescan;
+            }
+        }
+    }
+#else
 rescan:
     ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
         // First check that msg belongs to handle
         /* Check if it is time to send this message */
         if (current_time >= stored_msg_ptr->resending_time) {
-            /* * * Increase Resending counter  * * */
-            stored_msg_ptr->resending_counter++;
-
-            /* Check if all re-sendings have been done */
-            if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                coap_version_e coap_version = COAP_VERSION_UNKNOWN;
-
+            sn_coap_protocol_resend_msg(handle, stored_msg_ptr, current_time);
 
-                /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
-
-                /* If RX callback have been defined.. */
-                if (handle->sn_coap_rx_callback != 0) {
-                    sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                    /* Parse CoAP message, set status and call RX callback */
-                    tmp_coap_hdr_ptr = sn_coap_parser(handle, stored_msg_ptr->send_msg_ptr.packet_len, stored_msg_ptr->send_msg_ptr.packet_ptr, &coap_version);
-
-                    if (tmp_coap_hdr_ptr != 0) {
-                        tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-                        handle->sn_coap_rx_callback(tmp_coap_hdr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
-
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp_coap_hdr_ptr);
-                    }
-                }
-
-                /* Free memory of stored message */
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-            } else {
-                /* Send message  */
-                handle->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr.packet_ptr,
-                        stored_msg_ptr->send_msg_ptr.packet_len, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
-
-                /* * * Count new Resending time  * * */
-                stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                   handle->sn_coap_resending_intervall,
-                                                                                   stored_msg_ptr->resending_counter);
-            }
             /* Callback routine could have wiped the list (eg as a response to sending failed) */
             /* Be super cautious and rescan from the start */
             goto rescan;
         }
     }
+#endif
 
 #endif /* ENABLE_RESENDINGS */
 
@@ -922,6 +935,62 @@ rescan:
 
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_resend_msg(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr, uint32_t current_time)
+ *
+ * \brief Sends again a message whose resending time has come, or removes it
+ *        and notifies the application when all re-sendings have been done
+ *
+ * \param *stored_msg_ptr is the message to be sent
+ * \param current_time is the current System time
+ *****************************************************************************/
+
+static void sn_coap_protocol_resend_msg(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr, uint32_t current_time)
+{
+    /* * * Increase Resending counter  * * */
+    stored_msg_ptr->resending_counter++;
+
+    /* Check if all re-sendings have been done */
+    if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+        coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+
+
+        /* Remove message from Linked list */
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+
+        /* If RX callback have been defined.. */
+        if (handle->sn_coap_rx_callback != 0) {
+            sn_coap_hdr_s *tmp_coap_hdr_ptr;
+            /* Parse CoAP message, set status and call RX callback */
+            tmp_coap_hdr_ptr = sn_coap_parser(handle, stored_msg_ptr->send_msg_ptr.packet_len, stored_msg_ptr->send_msg_ptr.packet_ptr, &coap_version);
+
+            if (tmp_coap_hdr_ptr != 0) {
+                tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+                handle->sn_coap_rx_callback(tmp_coap_hdr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
+
+                sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp_coap_hdr_ptr);
+            }
+        }
+
+        /* Free memory of stored message */
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+    } else {
+        /* Send message  */
+        handle->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr.packet_ptr,
+                stored_msg_ptr->send_msg_ptr.packet_len, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
+
+        /* * * Count new Resending time  * * */
+        stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
+                                                                           handle->sn_coap_resending_intervall,
+                                                                           stored_msg_ptr->resending_counter);
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+        /* * * Move it to the slot of the new Resending time  * * */
+        ns_list_remove(&handle->resending_wheel[stored_msg_ptr->wheel_slot], stored_msg_ptr);
+        sn_coap_protocol_resending_wheel_add(handle, stored_msg_ptr);
+#endif
+    }
+}
+
 /**************************************************************************//**
  * \fn static uint8_t sn_coap_protocol_linked_list_send_msg_store(sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time)
  *
@@ -994,9 +1063,52 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     /* Storing Resending message to Linked list */
     ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
     ++handle->count_resent_msgs;
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+    sn_coap_protocol_resending_wheel_add(handle, stored_msg_ptr);
+#endif
     return 1;
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Removes stored resending message from Linked list, without freeing it
+ *
+ * \param *stored_msg_ptr is message to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    --handle->count_resent_msgs;
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+    ns_list_remove(&handle->resending_wheel[stored_msg_ptr->wheel_slot], stored_msg_ptr);
+#endif
+}
+
+#if SN_COAP_RESENDING_TIMER_WHEEL_SIZE
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_resending_wheel_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Stores resending message to the timer wheel slot of its resending time
+ *
+ * A resending time already passed goes to the next slot to be visited.
+ *
+ * \param *stored_msg_ptr is message to be stored
+ *****************************************************************************/
+
+static void sn_coap_protocol_resending_wheel_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    uint32_t slot_time = stored_msg_ptr->resending_time;
+    if (slot_time <= handle->resending_wheel_time) {
+        slot_time = handle->resending_wheel_time + 1;
+    }
+
+    stored_msg_ptr->wheel_slot = slot_time % SN_COAP_RESENDING_TIMER_WHEEL_SIZE;
+    ns_list_add_to_end(&handle->resending_wheel[stored_msg_ptr->wheel_slot], stored_msg_ptr);
+}
+#endif
+
 
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
@@ -1021,8 +1133,7 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
                 /* * * Message found * * */
 
                 /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
@@ -1121,6 +1232,9 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    ns_list_add_to_end(&handle->duplication_hash[msg_id & (SN_COAP_DUPLICATION_HASH_SIZE - 1)], stored_duplication_info_ptr);
+#endif
 }
 
 /**************************************************************************//**
@@ -1138,7 +1252,11 @@ static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_se
         const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
     /* Loop all nodes in Linked list for searching Message ID */
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->duplication_hash[msg_id & (SN_COAP_DUPLICATION_HASH_SIZE - 1)]) {
+#else
     ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+#endif
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address & port is same than is searched */
@@ -1165,22 +1283,45 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
         if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
             /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
+            sn_coap_protocol_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
             /* Free memory of stored Duplication info */
             sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
+        } else {
+            /* Linked list is in storing order, the rest are newer */
+            break;
         }
     }
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+ *
+ * \brief Removes stored Duplication info from Linked list, without freeing it
+ *
+ * \param *duplication_info_ptr is Duplication info to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+{
+    ns_list_remove(&handle->linked_list_duplication_msgs, duplication_info_ptr);
+    --handle->count_duplication_msgs;
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    ns_list_remove(&handle->duplication_hash[duplication_info_ptr->msg_id & (SN_COAP_DUPLICATION_HASH_SIZE - 1)], duplication_info_ptr);
+#endif
+}
+
 #endif /* SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
 
 void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, const uint8_t *scr_addr_ptr, const uint16_t port, const uint16_t msg_id)
 {
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
     /* Loop all stored duplication messages in Linked list */
+#if SN_COAP_DUPLICATION_HASH_SIZE
+    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->duplication_hash[msg_id & (SN_COAP_DUPLICATION_HASH_SIZE - 1)]) {
+#else
     ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+#endif
         /* If message's Address is same than is searched */
         if (0 == memcmp(scr_addr_ptr,
                         removed_duplication_info_ptr->address->addr_ptr,
@@ -1191,8 +1332,7 @@ void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle,
                 if (removed_duplication_info_ptr->msg_id == msg_id) {
                     /* * * * Correct Duplication info found, remove it from Linked list * * * */
                     tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
+                    sn_coap_protocol_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
                     /* Free memory of stored Duplication info */
                     sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
@@ -1381,6 +1521,94 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
     stored_blockwise_payload_ptr->timestamp = handle->system_time;
 }
 
+/**************************************************************************//**
+ * \fn static bool sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr,
+ *                                                      const sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option, void *param)
+ *
+ * \brief Gives received blockwise payload to the block callback
+ *
+ * Only the number of the last given block is stored to Linked list, to
+ * keep the blocks in order and to drop the retransmitted ones.
+ *
+ * \param *addr_ptr is pointer to Address information of the sender
+ * \param *received_coap_msg_ptr is pointer to the message carrying the block
+ * \param block_option is the Block1 or Block2 option of the message
+ * \param *param is passed to the block callback
+ *
+ * \return true if the block was given or already given, false if the transfer is aborted
+ *****************************************************************************/
+
+static bool sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr,
+        const sn_coap_hdr_s *received_coap_msg_ptr,
+        int32_t block_option,
+        void *param)
+{
+    const uint32_t block_number = block_option >> 4;
+    const uint32_t block_size = 1u << ((block_option & 0x07) + 4);
+    const uint8_t more = (block_option & 0x08) ? 1 : 0;
+
+    coap_blockwise_payload_s *stream_ptr = sn_coap_protocol_linked_list_blockwise_search(handle, addr_ptr,
+                                                                                         received_coap_msg_ptr->token_ptr,
+                                                                                         received_coap_msg_ptr->token_len);
+
+    // Do not give duplicates to the callback, this could happen if server needs to retransmit block message again
+    if (stream_ptr && stream_ptr->block_number == block_number) {
+        return true;
+    }
+
+    // Block 0 starts the transfer again
+    if (block_number && (!stream_ptr || stream_ptr->block_number + 1 != block_number)) {
+        tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - block %" PRIu32 " out of order!", block_number);
+        return false;
+    }
+
+    if (!stream_ptr) {
+        stream_ptr = sn_coap_protocol_calloc(handle, sizeof(coap_blockwise_payload_s));
+        if (stream_ptr == NULL) {
+            tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate blockwise!");
+            return false;
+        }
+
+        stream_ptr->addr_ptr = sn_coap_protocol_malloc_copy(handle, addr_ptr->addr_ptr, addr_ptr->addr_len);
+        if (stream_ptr->addr_ptr == NULL) {
+            tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate address pointer!");
+            handle->sn_coap_protocol_free(stream_ptr);
+            return false;
+        }
+
+        if (received_coap_msg_ptr->token_ptr) {
+            stream_ptr->token_ptr = sn_coap_protocol_malloc_copy(handle, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+            if (stream_ptr->token_ptr == NULL) {
+                tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate token pointer!");
+                handle->sn_coap_protocol_free(stream_ptr->addr_ptr);
+                handle->sn_coap_protocol_free(stream_ptr);
+                return false;
+            }
+            stream_ptr->token_len = received_coap_msg_ptr->token_len;
+        }
+
+        stream_ptr->addr_len = addr_ptr->addr_len;
+        stream_ptr->port = addr_ptr->port;
+
+        ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stream_ptr);
+    }
+
+    if (handle->sn_coap_block_callback(received_coap_msg_ptr, addr_ptr, block_number * block_size, more, param) < 0) {
+        tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - aborted by callback!");
+        sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stream_ptr);
+        return false;
+    }
+
+    if (!more) {
+        sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stream_ptr);
+        return true;
+    }
+
+    stream_ptr->block_number = block_number;
+    stream_ptr->timestamp = handle->system_time;
+    return true;
+}
+
 /**************************************************************************//**
  * \fn static uint8_t *sn_coap_protocol_linked_list_blockwise_payload_search(sn_nsdl_addr_s *src_addr_ptr, uint16_t *payload_length)
  *
@@ -1825,9 +2053,9 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
                     if (!dst_ack_packet_data_ptr) {
                         tr_error("sn_coap_handle_blockwise_message - (send block1) failed to allocate ack message!");
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
+                        sn_coap_protocol_free_options(handle, src_coap_blockwise_ack_msg_ptr->options_list_ptr);
                         handle->sn_coap_protocol_free(original_payload_ptr);
-                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                        sn_coap_protocol_free_message(handle, src_coap_blockwise_ack_msg_ptr);
                         stored_blockwise_msg_temp_ptr->coap_msg_ptr = NULL;
                         return NULL;
                     }
@@ -1908,8 +2136,10 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
                 }
 
-                // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle
-                if (received_coap_msg_ptr->options_list_ptr->size1 > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE) {
+                // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle.
+                // Streamed payloads are not stored, so there is no limit for them.
+                if (!handle->sn_coap_block_callback &&
+                    received_coap_msg_ptr->options_list_ptr->size1 > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE) {
                     // Include maximum size that stack can handle into response
                     tr_error("sn_coap_handle_blockwise_message - (recv block1) COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
                     src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
@@ -1935,6 +2165,18 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     }
                 }
 
+                // Give the block to the callback before acknowledging it, so that an aborted transfer is not continued
+                if (handle->sn_coap_block_callback &&
+                    src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE &&
+                    src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE &&
+                    !sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                           src_addr_ptr,
+                                                                           received_coap_msg_ptr,
+                                                                           received_coap_msg_ptr->options_list_ptr->block1,
+                                                                           param)) {
+                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
+                }
+
                 src_coap_blockwise_ack_msg_ptr->msg_id = received_coap_msg_ptr->msg_id;
 
                 // Copy token to response
@@ -1948,8 +2190,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
                 if (!dst_ack_packet_data_ptr) {
                     tr_error("sn_coap_handle_blockwise_message - (recv block1) message allocation failed!");
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     return NULL;
                 }
 
@@ -1968,7 +2209,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 }
 #endif
                 // Store only in success case
-                if (src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE &&
+                if (!handle->sn_coap_block_callback &&
+                    src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE &&
                     src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE) {
                     sn_coap_protocol_linked_list_blockwise_payload_store(handle,
                                                                          src_addr_ptr,
@@ -1993,14 +2235,24 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 /* * * This is the last block when whole Blockwise payload from received * * */
                 /* * * blockwise messages is gathered and returned to User               * * */
 
-                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                     src_addr_ptr,
-                                                                     received_coap_msg_ptr->payload_len,
-                                                                     received_coap_msg_ptr->payload_ptr,
-                                                                     received_coap_msg_ptr->token_ptr,
-                                                                     received_coap_msg_ptr->token_len,
-                                                                     block_number,
-                                                                     received_coap_msg_ptr->options_list_ptr->size1);
+                if (handle->sn_coap_block_callback) {
+                    if (!sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                               src_addr_ptr,
+                                                                               received_coap_msg_ptr,
+                                                                               received_coap_msg_ptr->options_list_ptr->block1,
+                                                                               param)) {
+                        return NULL;
+                    }
+                } else {
+                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                         src_addr_ptr,
+                                                                         received_coap_msg_ptr->payload_len,
+                                                                         received_coap_msg_ptr->payload_ptr,
+                                                                         received_coap_msg_ptr->token_ptr,
+                                                                         received_coap_msg_ptr->token_len,
+                                                                         block_number,
+                                                                         received_coap_msg_ptr->options_list_ptr->size1);
+                }
 
                 if (!sn_coap_handle_last_blockwise(handle, src_addr_ptr, received_coap_msg_ptr)) {
 
@@ -2019,16 +2271,31 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 #if SN_COAP_BLOCKWISE_INTERNAL_BLOCK_2_HANDLING_ENABLED
             if (handle->sn_coap_internal_block2_resp_handling) {
                 uint32_t block_number = 0;
-                /* Store blockwise payload to Linked list */
-                //todo: add block number to stored values - just to make sure all packets are in order
-                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                     src_addr_ptr,
-                                                                     received_coap_msg_ptr->payload_len,
-                                                                     received_coap_msg_ptr->payload_ptr,
-                                                                     received_coap_msg_ptr->token_ptr,
-                                                                     received_coap_msg_ptr->token_len,
-                                                                     received_coap_msg_ptr->options_list_ptr->block2 >> 4,
-                                                                     received_coap_msg_ptr->options_list_ptr->size1);
+                if (handle->sn_coap_block_callback) {
+                    /* Give blockwise payload to the callback, an aborted transfer is not continued */
+                    if (!sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                               src_addr_ptr,
+                                                                               received_coap_msg_ptr,
+                                                                               received_coap_msg_ptr->options_list_ptr->block2,
+                                                                               param)) {
+                        coap_blockwise_msg_s *aborted_blockwise_msg_ptr = search_sent_blockwise_message(handle, received_coap_msg_ptr->msg_id);
+                        if (aborted_blockwise_msg_ptr) {
+                            sn_coap_protocol_linked_list_blockwise_msg_remove(handle, aborted_blockwise_msg_ptr);
+                        }
+                        return NULL;
+                    }
+                } else {
+                    /* Store blockwise payload to Linked list */
+                    //todo: add block number to stored values - just to make sure all packets are in order
+                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                         src_addr_ptr,
+                                                                         received_coap_msg_ptr->payload_len,
+                                                                         received_coap_msg_ptr->payload_ptr,
+                                                                         received_coap_msg_ptr->token_ptr,
+                                                                         received_coap_msg_ptr->token_len,
+                                                                         received_coap_msg_ptr->options_list_ptr->block2 >> 4,
+                                                                         received_coap_msg_ptr->options_list_ptr->size1);
+                }
                 /* If not last block (more value is set) */
                 if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
                     coap_blockwise_msg_s *previous_blockwise_msg_ptr;
@@ -2287,6 +2554,12 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
 static bool sn_coap_handle_last_blockwise(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
 {
+    // Streamed payloads were given to the callback already, the message keeps the last block only
+    if (handle->sn_coap_block_callback) {
+        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+        return true;
+    }
+
     uint16_t payload_len            = 0;
     uint32_t whole_payload_len      = sn_coap_protocol_linked_list_blockwise_payloads_get_len(handle, src_addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
     uint8_t *payload_ptr            = sn_coap_protocol_linked_list_blockwise_payload_search(handle, src_addr_ptr, &payload_len, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
@@ -2521,6 +2794,74 @@ void *sn_coap_protocol_calloc(struct coap_s *handle, uint16_t length)
     return result;
 }
 
+#if SN_COAP_MESSAGE_POOL_SIZE
+static void *sn_coap_protocol_pool_alloc(uint32_t *used_ptr, void *pool_ptr, uint16_t entry_size)
+{
+    for (uint8_t i = 0; i < SN_COAP_MESSAGE_POOL_SIZE; i++) {
+        if (!(*used_ptr & (1UL << i))) {
+            *used_ptr |= (1UL << i);
+            return (uint8_t *)pool_ptr + (i * entry_size);
+        }
+    }
+    return NULL;
+}
+
+static bool sn_coap_protocol_pool_free(uint32_t *used_ptr, void *pool_ptr, uint16_t entry_size, void *entry_ptr)
+{
+    uint8_t *start_ptr = pool_ptr;
+
+    /* Not from the pool, it was allocated by sn_coap_protocol_malloc() or by the application */
+    if ((uint8_t *)entry_ptr < start_ptr || (uint8_t *)entry_ptr >= start_ptr + (SN_COAP_MESSAGE_POOL_SIZE * entry_size)) {
+        return false;
+    }
+
+    *used_ptr &= ~(1UL << (((uint8_t *)entry_ptr - start_ptr) / entry_size));
+    return true;
+}
+#endif
+
+sn_coap_hdr_s *sn_coap_protocol_alloc_message(struct coap_s *handle)
+{
+#if SN_COAP_MESSAGE_POOL_SIZE
+    sn_coap_hdr_s *coap_msg_ptr = sn_coap_protocol_pool_alloc(&handle->message_pool_used, handle->message_pool, sizeof(sn_coap_hdr_s));
+    if (coap_msg_ptr) {
+        return coap_msg_ptr;
+    }
+#endif
+    return handle->sn_coap_protocol_malloc(sizeof(sn_coap_hdr_s));
+}
+
+sn_coap_options_list_s *sn_coap_protocol_alloc_options(struct coap_s *handle)
+{
+#if SN_COAP_MESSAGE_POOL_SIZE
+    sn_coap_options_list_s *options_list_ptr = sn_coap_protocol_pool_alloc(&handle->options_pool_used, handle->options_pool, sizeof(sn_coap_options_list_s));
+    if (options_list_ptr) {
+        return options_list_ptr;
+    }
+#endif
+    return handle->sn_coap_protocol_malloc(sizeof(sn_coap_options_list_s));
+}
+
+void sn_coap_protocol_free_message(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr)
+{
+#if SN_COAP_MESSAGE_POOL_SIZE
+    if (sn_coap_protocol_pool_free(&handle->message_pool_used, handle->message_pool, sizeof(sn_coap_hdr_s), coap_msg_ptr)) {
+        return;
+    }
+#endif
+    handle->sn_coap_protocol_free(coap_msg_ptr);
+}
+
+void sn_coap_protocol_free_options(struct coap_s *handle, sn_coap_options_list_s *options_list_ptr)
+{
+#if SN_COAP_MESSAGE_POOL_SIZE
+    if (sn_coap_protocol_pool_free(&handle->options_pool_used, handle->options_pool, sizeof(sn_coap_options_list_s), options_list_ptr)) {
+        return;
+    }
+#endif
+    handle->sn_coap_protocol_free(options_list_ptr);
+}
+
 static bool compare_address_and_port(const sn_nsdl_addr_s* left, const sn_nsdl_addr_s* right)
 {
     bool match = false;
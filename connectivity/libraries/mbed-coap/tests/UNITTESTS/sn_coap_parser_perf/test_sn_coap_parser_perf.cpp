@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+
+static void *coap_malloc(uint16_t size)
+{
+    return malloc(size);
+}
+
+static void coap_free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint8_t coap_tx(uint8_t *packet, uint16_t len, sn_nsdl_addr_s *addr, void *param)
+{
+    return 0;
+}
+
+static int8_t coap_rx(sn_coap_hdr_s *msg, sn_nsdl_addr_s *addr, void *param)
+{
+    return 0;
+}
+
+class TestSnCoapParserPerf : public testing::Test {
+protected:
+    struct coap_s *handle;
+
+    virtual void SetUp()
+    {
+        handle = sn_coap_protocol_init(coap_malloc, coap_free, coap_tx, coap_rx);
+        ASSERT_TRUE(handle);
+    }
+
+    virtual void TearDown()
+    {
+        sn_coap_protocol_destroy(handle);
+    }
+
+    // Build a request for a path, with the options of an LwM2M observation
+    std::vector<uint8_t> build(const std::string &path, const std::string &payload)
+    {
+        uint8_t token[4] = { 1, 2, 3, 4 };
+        sn_coap_hdr_s *msg = sn_coap_parser_alloc_message_with_options(handle);
+        EXPECT_TRUE(msg);
+        msg->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        msg->msg_code = COAP_MSG_CODE_REQUEST_PUT;
+        msg->msg_id = 0x1234;
+        msg->token_ptr = token;
+        msg->token_len = sizeof(token);
+        msg->uri_path_ptr = (uint8_t *)path.data();
+        msg->uri_path_len = path.size();
+        msg->content_format = COAP_CT_TEXT_PLAIN;
+        msg->options_list_ptr->observe = 7;
+        msg->options_list_ptr->max_age = 30;
+        msg->payload_ptr = (uint8_t *)payload.data();
+        msg->payload_len = payload.size();
+
+        std::vector<uint8_t> packet(sn_coap_builder_calc_needed_packet_data_size(msg));
+        EXPECT_EQ((int16_t)packet.size(), sn_coap_builder(packet.data(), msg));
+
+        // The buffers built from are not the library's to free
+        msg->token_ptr = NULL;
+        msg->uri_path_ptr = NULL;
+        msg->payload_ptr = NULL;
+        sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        return packet;
+    }
+
+    sn_coap_hdr_s *parse(std::vector<uint8_t> &packet)
+    {
+        coap_version_e version;
+        sn_coap_hdr_s *msg = sn_coap_parser(handle, packet.size(), packet.data(), &version);
+        EXPECT_TRUE(msg);
+        EXPECT_EQ(COAP_STATUS_OK, msg->coap_status);
+        return msg;
+    }
+};
+
+TEST_F(TestSnCoapParserPerf, messages)
+{
+    std::vector<uint8_t> packet = build("3/0/1", "a value of a resource");
+
+    auto workload = [this, &packet](size_t messages) {
+        for (size_t i = 0; i < messages; i++) {
+            sn_coap_hdr_s *msg = parse(packet);
+            EXPECT_EQ(5, msg->uri_path_len);
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        }
+    };
+    EXPECT_TRUE(perf::scales_linearly("messages", 1 << 10, 1 << 14, workload));
+}
+
+TEST_F(TestSnCoapParserPerf, path_segments)
+{
+    // Messages kept for every size timed, as the workload builds none
+    std::vector<uint8_t> packets[2];
+    // The parser handles up to 127 segments in a path
+    const size_t sizes[2] = { 1 << 3, 1 << 6 };
+    for (int i = 0; i < 2; i++) {
+        std::string path;
+        for (size_t segment = 0; segment < sizes[i]; segment++) {
+            path += segment ? "/s" : "s";
+            path += std::to_string(segment % 10);
+        }
+        packets[i] = build(path, "");
+    }
+
+    // Each run parses the message a fixed number of times, its size being the count of segments
+    auto workload = [this, &packets, &sizes](size_t segments) {
+        std::vector<uint8_t> &packet = packets[segments == sizes[0] ? 0 : 1];
+        for (int i = 0; i < 256; i++) {
+            sn_coap_hdr_s *msg = parse(packet);
+            EXPECT_EQ(segments * 3 - 1, msg->uri_path_len);
+            sn_coap_parser_release_allocated_coap_msg_mem(handle, msg);
+        }
+    };
+    EXPECT_TRUE(perf::scales_linearly("path_segments", sizes[0], sizes[1], workload));
+}
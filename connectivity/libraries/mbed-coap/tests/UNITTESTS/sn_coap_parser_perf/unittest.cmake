@@ -0,0 +1,30 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Ahead of target_h, whose randLIB.h only declares what the cellular stubs use
+set(unittest-includes
+  ../platform/randlib/include/mbed-client-randlib
+  ${unittest-includes}
+  ../connectivity/libraries/mbed-coap
+  ../connectivity/libraries/mbed-coap/source/include
+)
+
+set(unittest-sources
+  ../connectivity/libraries/mbed-coap/source/sn_coap_builder.c
+  ../connectivity/libraries/mbed-coap/source/sn_coap_header_check.c
+  ../connectivity/libraries/mbed-coap/source/sn_coap_parser.c
+  ../connectivity/libraries/mbed-coap/source/sn_coap_protocol.c
+  ../connectivity/libraries/nanostack-libservice/source/libList/ns_list.c
+  ../platform/mbed-trace/source/mbed_trace.c
+)
+
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/test_sn_coap_parser_perf.cpp
+  stubs/randLIB_stub.c
+)
+
+set(unittest-test-labels
+  perf
+)
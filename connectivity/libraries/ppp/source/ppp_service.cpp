@@ -166,7 +166,7 @@ void ppp_service::ppp_input()
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
+        u8_t buffer[MBED_CONF_PPP_INPUT_BUFFER_SIZE];
 
         ssize_t len = ppp_service_stream->read(buffer, sizeof buffer);
 
@@ -64,6 +64,7 @@ static void pppos_input_callback(void *arg);
 static void pppos_input_free_current_packet(pppos_pcb *pppos);
 static void pppos_input_drop(pppos_pcb *pppos);
 static err_t pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t accm, u16_t *fcs);
+static err_t pppos_output_append_block(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs);
 static err_t pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs);
 
 /* Callbacks structure for PPP core */
@@ -221,9 +222,7 @@ pppos_write(ppp_pcb *ppp, void *ctx, struct pbuf *p)
   s = (u8_t*)p->payload;
   n = p->len;
 
-  while (n-- > 0) {
-    err = pppos_output_append(pppos, err,  nb, *s++, 1, &fcs_out);
-  }
+  err = pppos_output_append_block(pppos, err, nb, s, n, &fcs_out);
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
   if (err == ERR_OK) {
@@ -287,11 +286,9 @@ pppos_netif_output(ppp_pcb *ppp, void *ctx, struct pbuf *pb, u16_t protocol)
   NetStackMemoryManager *mem_mngr = static_cast<NetStackMemoryManager *>(ppp->netif->memory_manager);
   for (p = static_cast<struct pbuf *>(pb->buffer); p; p = static_cast<struct pbuf *>(mem_mngr->get_next(p))) {
       u16_t n = mem_mngr->get_len(p);
-      u8_t *s = (u8_t*) mem_mngr->get_ptr(p);
+      const u8_t *s = (const u8_t*) mem_mngr->get_ptr(p);
 
-      while (n-- > 0) {
-        err = pppos_output_append(pppos, err, nb, *s++, 1, &fcs_out);
-      }
+      err = pppos_output_append_block(pppos, err, nb, s, n, &fcs_out);
   }
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
@@ -478,7 +475,42 @@ pppos_input(ppp_pcb *ppp, u8_t *s, int l)
   PPPOS_DECL_PROTECT(lev);
 
   PPPDEBUG(LOG_DEBUG, ("pppos_input[%d]: got %d bytes\n", ppp->netif->num, l));
-  while (l-- > 0) {
+  while (l > 0) {
+    /* Fast path: inside a packet, copy the run of characters that need no
+     * special handling straight into the tail buffer. The ACCM is read once
+     * per run instead of once per character. */
+    if (pppos->in_state == PDDATA && !pppos->in_escaped && pppos->in_tail != NULL
+        && pppos->in_tail->len < pppos->in_tail->tot_len) {
+      ext_accm in_accm;
+      u8_t *dst;
+      u16_t fcs;
+      int room, n;
+
+      PPPOS_PROTECT(lev);
+      if (!pppos->open) {
+        PPPOS_UNPROTECT(lev);
+        return;
+      }
+      MEMCPY(in_accm, pppos->in_accm, sizeof(in_accm));
+      PPPOS_UNPROTECT(lev);
+
+      dst = (u8_t*)pppos->in_tail->payload + pppos->in_tail->len;
+      room = PPP_MIN(pppos->in_tail->tot_len - pppos->in_tail->len, l);
+      fcs = pppos->in_fcs;
+      for (n = 0; n < room && !ESCAPE_P(in_accm, s[n]); n++) {
+        dst[n] = s[n];
+        fcs = PPP_FCS(fcs, s[n]);
+      }
+      pppos->in_tail->len += n;
+      pppos->in_fcs = fcs;
+      s += n;
+      l -= n;
+      if (l == 0) {
+        break;
+      }
+    }
+
+    l--;
     cur_char = *s++;
 
     PPPOS_PROTECT(lev);
@@ -705,7 +737,7 @@ pppos_input(ppp_pcb *ppp, u8_t *s, int l)
       /* update the frame check sequence number. */
       pppos->in_fcs = PPP_FCS(pppos->in_fcs, cur_char);
     }
-  } /* while (l-- > 0), all bytes processed */
+  } /* while (l > 0), all bytes processed */
 }
 
 #if PPP_INPROC_IRQ_SAFE
@@ -856,6 +888,52 @@ pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t a
   return ERR_OK;
 }
 
+/* Same as pppos_output_append() with accm set, for a run of characters.
+ * The buffer is only checked for room once per run of characters that
+ * cannot overflow it, an escaped character taking two bytes. */
+static err_t
+pppos_output_append_block(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs)
+{
+  u16_t fcs_out;
+
+  if (err != ERR_OK) {
+    return err;
+  }
+
+  fcs_out = *fcs;
+  while (n > 0) {
+    u8_t *dst;
+    u16_t run;
+
+    if ((nb->tot_len - nb->len) < 2) {
+      u32_t l = pppos->output_cb(pppos->ppp, (u8_t*)nb->payload, nb->len, pppos->ppp->ctx_cb);
+      if (l != nb->len) {
+        *fcs = fcs_out;
+        return ERR_IF;
+      }
+      nb->len = 0;
+    }
+
+    dst = (u8_t*)nb->payload + nb->len;
+    run = PPP_MIN(n, (nb->tot_len - nb->len) / 2);
+    n -= run;
+    while (run-- > 0) {
+      u8_t c = *s++;
+      fcs_out = PPP_FCS(fcs_out, c);
+      if (ESCAPE_P(pppos->out_accm, c)) {
+        *dst++ = PPP_ESCAPE;
+        *dst++ = c ^ PPP_TRANS;
+      } else {
+        *dst++ = c;
+      }
+    }
+    nb->len = dst - (u8_t*)nb->payload;
+  }
+  *fcs = fcs_out;
+
+  return ERR_OK;
+}
+
 static err_t
 pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs)
 {
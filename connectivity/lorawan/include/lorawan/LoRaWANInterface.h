@@ -100,6 +100,11 @@ public:
      * an ABP device is always connected. That's why storing the frame counters is important for ABP.
      * That's why we restore frame counters from session information after a disconnection.
      *
+     * With the `session-storage` option, the session is also saved to KVStore and connect() resumes
+     * it after a power cycle, without a new Join request, if the credentials are unchanged. The frame
+     * counters are saved once every `session-fcnt-gap` uplinks, so a reset skips up to that many uplink
+     * counters. disconnect() forgets an OTAA session, so the next connect() joins again.
+     *
      * @return    Common:   LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
      *                      LORAWAN_STATUS_PARAMETER_INVALID if connection parameters are invalid.
      *
@@ -143,6 +148,11 @@ public:
      * server, an ABP device is always connected. That's why storing the frame counters is important
      * for ABP. That's why we restore frame counters from session information after a disconnection.
      *
+     * With the `session-storage` option, the session is also saved to KVStore and connect() resumes
+     * it after a power cycle, without a new Join request, if the credentials are unchanged. The frame
+     * counters are saved once every `session-fcnt-gap` uplinks, so a reset skips up to that many uplink
+     * counters. disconnect() forgets an OTAA session, so the next connect() joins again.
+     *
      * @param connect  Options for an end device connection to the gateway.
      *
      * @return    Common:   LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
@@ -352,6 +362,42 @@ public:
      */
     int16_t send(uint8_t port, const uint8_t *data, uint16_t length, int flags);
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    /** Queue a message for the gateway
+     *
+     * Unlike send(), there is no need to wait for TX_DONE before the next message:
+     * up to MBED_CONF_LORA_UPLINK_QUEUE_SIZE messages wait in the stack, which sends
+     * them in order as soon as the ongoing transmission is over and the duty cycle
+     * allows it. The events of send() are received for each frame sent, and
+     * TX_SCHEDULING_ERROR for a message that could not be sent.
+     *
+     * Messages queued with aggregate set, for the same port and flags, may share a frame
+     * while they wait for the duty cycle: the Network Server receives their payloads
+     * concatenated, so the application format must tell them apart.
+     *
+     * @param port          The application port number, as for send().
+     *
+     * @param data          A pointer to the data being sent. The ownership of the buffer is not transferred.
+     *                      The data is copied to the queue.
+     *
+     * @param length        The size of data in bytes, which must fit a frame at the current datarate.
+     *
+     * @param flags         A flag used to determine what type of message is being sent, as for send().
+     *
+     * @param aggregate     True to allow sending the message in the frame of other messages.
+     *
+     * @return              LORAWAN_STATUS_OK if the message is queued, or a negative error code on failure:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
+     *                      LORAWAN_STATUS_NO_ACTIVE_SESSIONS if connection is not open,
+     *                      LORAWAN_STATUS_WOULD_BLOCK       if the queue is full,
+     *                      LORAWAN_STATUS_LENGTH_ERROR      if the message does not fit a frame,
+     *                      LORAWAN_STATUS_PORT_INVALID      if trying to send to an invalid port (e.g. to 0)
+     *                      LORAWAN_STATUS_PARAMETER_INVALID if NULL data pointer is given or flags are invalid.
+     */
+    lorawan_status_t queue_send(uint8_t port, const uint8_t *data, uint16_t length, int flags,
+                                bool aggregate = false);
+#endif
+
     /** Receives a message from the Network Server on a specific port.
      *
      * @param port          The application port number. Port numbers 0 and 224 are reserved,
@@ -518,6 +564,21 @@ public:
      */
     lorawan_status_t get_backoff_metadata(int &backoff);
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    /** Get the state of the uplink queue
+     *
+     * @param    count      the inbound integer that will carry the number of messages queued.
+     *
+     * @param    send_time  the inbound integer that will carry the time in ms before the first
+     *                      message queued is sent, 0 if it is being sent, or -1 if the queue is
+     *                      empty or waits for the ongoing transmission to be over.
+     *
+     * @return              LORAWAN_STATUS_OK on success, or
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    lorawan_status_t get_uplink_queue_metadata(uint8_t &count, int &send_time);
+#endif
+
     /** Cancel outgoing transmission
      *
      * This API is used to cancel any outstanding transmission in the TX pipe.
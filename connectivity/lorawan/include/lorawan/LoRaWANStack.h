@@ -384,6 +384,55 @@ public:
      */
     lorawan_status_t stop_sending(void);
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    /** Queues a message for uplink
+     *
+     * The message is copied into a queue of MBED_CONF_LORA_UPLINK_QUEUE_SIZE
+     * messages, sent one after another by the stack as soon as the ongoing
+     * transmission is over and the duty cycle allows it. A message queued while
+     * the duty cycle holds the previous one back may be appended to it, so both
+     * go in the same frame.
+     *
+     * @param port              The application port number, as for handle_tx().
+     *
+     * @param data              A pointer to the data being sent. The ownership of the
+     *                          buffer is not transferred.
+     *
+     * @param length            The size of data in bytes. It must fit a frame at the
+     *                          current datarate.
+     *
+     * @param flags             A flag used to determine what type of message is being
+     *                          sent, as for handle_tx().
+     *
+     * @param aggregate         If true, the message may be appended to the last one
+     *                          queued, if that one was queued with aggregate set, for
+     *                          the same port and flags, and both fit a frame. The
+     *                          application then receives their payloads concatenated.
+     *
+     * @return                  LORAWAN_STATUS_OK if the message is queued,
+     *                          LORAWAN_STATUS_WOULD_BLOCK if the queue is full,
+     *                          LORAWAN_STATUS_LENGTH_ERROR if the message does not fit
+     *                          a frame, or another negative error code on failure.
+     *                          The events of handle_tx() are sent for each frame,
+     *                          TX_SCHEDULING_ERROR if a queued message is dropped.
+     */
+    lorawan_status_t queue_tx(uint8_t port, const uint8_t *data, uint16_t length,
+                              uint8_t flags, bool aggregate);
+
+    /** Acquire uplink queue meta-data
+     *
+     * @param    count       A reference filled with the number of messages queued.
+     *
+     * @param    send_time   A reference filled with the time in ms before the first
+     *                       message queued is sent, 0 if it is being sent, or -1 if
+     *                       the queue is empty or waits for an ongoing transmission.
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_NOT_INITIALIZED otherwise
+     */
+    lorawan_status_t acquire_uplink_queue_metadata(uint8_t &count, int &send_time);
+#endif
+
     void lock(void)
     {
         _loramac.lock();
@@ -492,6 +541,61 @@ private:
     void post_process_tx_with_reception(void);
     void post_process_tx_no_reception(void);
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    /**
+     * A message of the uplink queue
+     */
+    typedef struct {
+        uint8_t port;
+        uint8_t flags;
+        bool aggregate;
+        uint16_t length;
+        uint8_t data[MBED_CONF_LORA_TX_MAX_SIZE];
+    } uplink_message_t;
+
+    /**
+     * Posts process_uplink_queue() if messages are queued and it is not
+     * already posted.
+     */
+    void schedule_uplink_queue(void);
+
+    /**
+     * Sends the first message queued, or waits for the duty cycle to allow it.
+     */
+    void process_uplink_queue(void);
+
+    /**
+     * Drops the messages queued.
+     */
+    void flush_uplink_queue(void);
+#endif
+
+#if MBED_CONF_LORA_SESSION_STORAGE
+    /**
+     * Resumes the session saved for the credentials given to connect().
+     *
+     * @return true if the session is resumed, false if a new one is needed.
+     */
+    bool restore_session(bool is_otaa);
+
+    /**
+     * Saves the session context, if it changed since it was last saved.
+     */
+    void save_session(void);
+
+    /**
+     * Saves the frame counters, if the next uplink counter reaches the one
+     * reserved by the last save or the downlink counter went
+     * MBED_CONF_LORA_SESSION_FCNT_GAP frames ahead of the one saved.
+     */
+    void save_frame_counters(void);
+
+    /**
+     * Forgets the session saved.
+     */
+    void erase_session(void);
+#endif
+
 private:
     LoRaMac _loramac;
     radio_events_t radio_events;
@@ -512,6 +616,17 @@ private:
     uint8_t _rx_payload[LORAMAC_PHY_MAXPAYLOAD];
     events::EventQueue *_queue;
     lorawan_time_t _tx_timestamp;
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    uplink_message_t _uplink_queue[MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+    uint8_t _uplink_queue_head;
+    uint8_t _uplink_queue_count;
+    int _uplink_queue_event_id;
+#endif
+#if MBED_CONF_LORA_SESSION_STORAGE
+    uint32_t _session_crc;
+    uint32_t _uplink_counter_reserved;
+    uint32_t _downlink_counter_saved;
+#endif
 };
 
 #endif /* LORAWANSTACK_H_ */
@@ -66,6 +66,16 @@ using namespace mbed;
  */
 #define DOWN_LINK                                   1
 
+/*!
+ * Timing error the RX windows are widened by. The precise RX timing
+ * compensates the wakeup and dispatch latency, only its jitter is left.
+ */
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+#define RX_WINDOW_ERROR                             MBED_CONF_LORA_PRECISE_RX_ERROR
+#else
+#define RX_WINDOW_ERROR                             MBED_CONF_LORA_MAX_SYS_RX_ERROR
+#endif
+
 LoRaMac::LoRaMac()
     : _lora_time(),
       _lora_phy(NULL),
@@ -634,6 +644,13 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
 
     if (_params.is_rx_window_enabled == true) {
         lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+        // open the rx windows from the low power ticker interrupt
+        _lora_time.start_precise(_params.timers.rx_window1_timer, _tx_done_time,
+                                 _params.rx_window1_delay);
+        _lora_time.start_precise(_params.timers.rx_window2_timer, _tx_done_time,
+                                 _params.rx_window2_delay);
+#else
         // start timer after which rx1_window will get opened
         _lora_time.start(_params.timers.rx_window1_timer,
                          _params.rx_window1_delay - time_diff);
@@ -641,6 +658,7 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
         // start timer after which rx2_window will get opened
         _lora_time.start(_params.timers.rx_window2_timer,
                          _params.rx_window2_delay - time_diff);
+#endif
 
         // If class C and an Unconfirmed messgae is outgoing,
         // this will start a timer which will invoke rx2 would be
@@ -672,6 +690,13 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
     _mac_commands.clear_command_buffer();
 }
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+void LoRaMac::capture_tx_done_time(void)
+{
+    _tx_done_time = _lora_time.get_precise_time();
+}
+#endif
+
 void LoRaMac::on_radio_rx_done(const uint8_t *const payload, uint16_t size,
                                int16_t rssi, int8_t snr)
 {
@@ -879,6 +904,10 @@ void LoRaMac::open_rx1_window(void)
     Lock lock(*this);
     _demod_ongoing = true;
     _continuous_rx2_window_open = false;
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    mbed::LowPowerClock::time_point fire_time;
+    bool timed = _lora_time.get_precise_fire_time(_params.timers.rx_window1_timer, fire_time);
+#endif
     _lora_time.stop(_params.timers.rx_window1_timer);
     _params.rx_slot = RX_SLOT_WIN_1;
 
@@ -904,6 +933,12 @@ void LoRaMac::open_rx1_window(void)
     _lora_phy->rx_config(&_params.rx_window1_config);
     _lora_phy->handle_receive();
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    if (timed) {
+        _lora_time.calibrate_precise(fire_time);
+    }
+#endif
+
     tr_debug("RX1 slot open, Freq = %lu", _params.rx_window1_config.frequency);
 }
 
@@ -915,6 +950,10 @@ void LoRaMac::open_rx2_window()
     }
     Lock lock(*this);
     _continuous_rx2_window_open = true;
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    mbed::LowPowerClock::time_point fire_time;
+    bool timed = _lora_time.get_precise_fire_time(_params.timers.rx_window2_timer, fire_time);
+#endif
     _lora_time.stop(_params.timers.rx_window2_timer);
 
     _params.rx_window2_config.channel = _params.channel;
@@ -937,6 +976,12 @@ void LoRaMac::open_rx2_window()
     _lora_phy->handle_receive();
     _params.rx_slot = _params.rx_window2_config.rx_slot;
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    if (timed) {
+        _lora_time.calibrate_precise(fire_time);
+    }
+#endif
+
     tr_debug("RX2 slot open, Freq = %lu", _params.rx_window2_config.frequency);
 }
 
@@ -1062,6 +1107,42 @@ int LoRaMac::get_backoff_timer_event_id(void)
     return _params.timers.backoff_timer.timer_id;
 }
 
+lorawan_time_t LoRaMac::get_next_tx_delay(void)
+{
+    lorawan_time_t delay = 0;
+    lorawan_time_t elapsed = _lora_time.get_elapsed_time(_params.timers.aggregated_last_tx_time);
+
+    if (MBED_CONF_LORA_DUTY_CYCLE_ON && _lora_phy->verify_duty_cycle(true)) {
+        delay = _lora_phy->get_next_tx_delay(true);
+    }
+
+    if (_params.sys_params.max_duty_cycle != 0
+            && _params.timers.aggregated_timeoff > elapsed
+            && _params.timers.aggregated_timeoff - elapsed > delay) {
+        delay = _params.timers.aggregated_timeoff - elapsed;
+    }
+
+    return delay;
+}
+
+uint8_t LoRaMac::get_max_uplink_payload_size(void)
+{
+    uint8_t fopts_len = _mac_commands.get_mac_cmd_length()
+                        + _mac_commands.get_repeat_commands_length();
+    uint8_t max_size = get_max_possible_tx_size(0);
+
+    // MAC commands that do not fit are dropped from the frame
+    if (max_size >= fopts_len) {
+        max_size -= fopts_len;
+    }
+
+    if (max_size > MBED_CONF_LORA_TX_MAX_SIZE) {
+        max_size = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    return max_size;
+}
+
 lorawan_status_t LoRaMac::clear_tx_pipe(void)
 {
     if (!_can_cancel_tx) {
@@ -1152,12 +1233,12 @@ lorawan_status_t LoRaMac::schedule_tx()
 
 
     _lora_phy->compute_rx_win_params(rx1_dr, MBED_CONF_LORA_DOWNLINK_PREAMBLE_LENGTH,
-                                     MBED_CONF_LORA_MAX_SYS_RX_ERROR,
+                                     RX_WINDOW_ERROR,
                                      &_params.rx_window1_config);
 
     _lora_phy->compute_rx_win_params(_params.sys_params.rx2_channel.datarate,
                                      MBED_CONF_LORA_DOWNLINK_PREAMBLE_LENGTH,
-                                     MBED_CONF_LORA_MAX_SYS_RX_ERROR,
+                                     RX_WINDOW_ERROR,
                                      &_params.rx_window2_config);
 
     if (!_is_nwk_joined) {
@@ -1429,7 +1510,7 @@ void LoRaMac::set_device_class(const device_class_t &device_class,
         _lora_phy->put_radio_to_sleep();
         _lora_phy->compute_rx_win_params(_params.sys_params.rx2_channel.datarate,
                                          MBED_CONF_LORA_DOWNLINK_PREAMBLE_LENGTH,
-                                         MBED_CONF_LORA_MAX_SYS_RX_ERROR,
+                                         RX_WINDOW_ERROR,
                                          &_params.rx_window2_config);
     }
 
@@ -1807,10 +1888,17 @@ lorawan_status_t LoRaMac::initialize(EventQueue *queue,
 
     _lora_time.init(_params.timers.backoff_timer,
                     mbed::callback(this, &LoRaMac::on_backoff_timer_expiry));
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    _lora_time.init_precise(_params.timers.rx_window1_timer, _rx_window1_timeout,
+                            mbed::callback(this, &LoRaMac::open_rx1_window));
+    _lora_time.init_precise(_params.timers.rx_window2_timer, _rx_window2_timeout,
+                            mbed::callback(this, &LoRaMac::open_rx2_window));
+#else
     _lora_time.init(_params.timers.rx_window1_timer,
                     mbed::callback(this, &LoRaMac::open_rx1_window));
     _lora_time.init(_params.timers.rx_window2_timer,
                     mbed::callback(this, &LoRaMac::open_rx2_window));
+#endif
     _lora_time.init(_params.timers.ack_timeout_timer,
                     mbed::callback(this, &LoRaMac::on_ack_timeout_timer_event));
 
@@ -1989,3 +2077,81 @@ uint8_t LoRaMac::get_prev_QOS_level()
     return _prev_qos_level;
 }
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+void LoRaMac::get_session_context(loramac_session_context_t &context, bool is_otaa)
+{
+    const uint8_t nb_channels = _lora_phy->get_max_nb_channels();
+
+    memset(&context, 0, sizeof(context));
+    context.version = LORAMAC_SESSION_CONTEXT_VERSION;
+    context.size = sizeof(context);
+    context.is_otaa = is_otaa;
+
+    if (is_otaa) {
+        memcpy(context.dev_eui, _params.keys.dev_eui, sizeof(context.dev_eui));
+        memcpy(context.app_eui, _params.keys.app_eui, sizeof(context.app_eui));
+    }
+
+    context.net_id = _params.net_id;
+    context.dev_addr = _params.dev_addr;
+    memcpy(context.nwk_skey, _params.keys.nwk_skey, sizeof(context.nwk_skey));
+    memcpy(context.app_skey, _params.keys.app_skey, sizeof(context.app_skey));
+    memcpy(&context.sys_params, &_params.sys_params, sizeof(context.sys_params));
+
+    MBED_ASSERT(nb_channels <= LORA_PHY_MAX_CHANNEL_MASK_SIZE * 16);
+    memcpy(context.channel_mask, _lora_phy->get_channel_mask(),
+           ((nb_channels + 15) / 16) * sizeof(uint16_t));
+
+    // The channels of the other regions are fixed
+    if (_lora_phy->is_custom_channel_plan_supported()) {
+        MBED_ASSERT(nb_channels <= LORA_MAX_NB_CHANNELS);
+        memcpy(context.channels, _lora_phy->get_phy_channels(),
+               nb_channels * sizeof(channel_params_t));
+    }
+}
+
+lorawan_status_t LoRaMac::set_session_context(const loramac_session_context_t &context, bool is_otaa)
+{
+    if (context.version != LORAMAC_SESSION_CONTEXT_VERSION
+            || context.size != sizeof(context)
+            || context.is_otaa != is_otaa) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (is_otaa) {
+        // Credentials changed since: join again
+        if (memcmp(context.dev_eui, _params.keys.dev_eui, sizeof(context.dev_eui)) != 0
+                || memcmp(context.app_eui, _params.keys.app_eui, sizeof(context.app_eui)) != 0) {
+            return LORAWAN_STATUS_PARAMETER_INVALID;
+        }
+
+        _params.net_id = context.net_id;
+        _params.dev_addr = context.dev_addr;
+        memcpy(_params.keys.nwk_skey, context.nwk_skey, sizeof(_params.keys.nwk_skey));
+        memcpy(_params.keys.app_skey, context.app_skey, sizeof(_params.keys.app_skey));
+    } else if (context.dev_addr != _params.dev_addr
+               || memcmp(context.nwk_skey, _params.keys.nwk_skey, sizeof(context.nwk_skey)) != 0) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    _params.sys_params = context.sys_params;
+    _lora_phy->restore_channel_plan(context.channels, context.channel_mask);
+    _is_nwk_joined = true;
+
+    return LORAWAN_STATUS_OK;
+}
+
+void LoRaMac::set_frame_counters(uint32_t uplink, uint32_t downlink)
+{
+    _params.ul_frame_counter = uplink;
+    _params.dl_frame_counter = downlink;
+    _params.adr_ack_counter = 0;
+}
+
+void LoRaMac::get_frame_counters(uint32_t &uplink, uint32_t &downlink)
+{
+    uplink = _params.ul_frame_counter;
+    downlink = _params.dl_frame_counter;
+}
+#endif
+
@@ -56,6 +56,32 @@
 
 #include "platform/ScopedLock.h"
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+/**
+ * Version of loramac_session_context_t, changed with its layout
+ */
+#define LORAMAC_SESSION_CONTEXT_VERSION     1
+
+/**
+ * Context of a joined session, saved to resume it after a reset without
+ * joining again. The frame counters are not part of it, being saved apart.
+ */
+typedef struct {
+    uint16_t version;
+    uint16_t size;
+    bool is_otaa;
+    uint8_t dev_eui[8];
+    uint8_t app_eui[8];
+    uint32_t net_id;
+    uint32_t dev_addr;
+    uint8_t nwk_skey[16];
+    uint8_t app_skey[16];
+    lora_mac_system_params_t sys_params;
+    uint16_t channel_mask[LORA_PHY_MAX_CHANNEL_MASK_SIZE];
+    channel_params_t channels[LORA_MAX_NB_CHANNELS];
+} loramac_session_context_t;
+#endif
+
 /** LoRaMac Class
  * Implementation of LoRaWAN MAC layer
  */
@@ -331,6 +357,14 @@ public:
      */
     void on_radio_tx_done(lorawan_time_t timestamp);
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    /**
+     * Time stamps the end of a transmission for the RX windows,
+     * called from the radio interrupt
+     */
+    void capture_tx_done_time(void);
+#endif
+
     /**
      * MAC operations upon reception
      */
@@ -392,6 +426,22 @@ public:
      */
     int get_backoff_timer_event_id(void);
 
+    /**
+     * Gets the time before the duty cycle allows the next transmission.
+     *
+     * @return 0 if a frame can be sent now, otherwise the time in ms before
+     *         a band is free and the aggregated time-off is over.
+     */
+    lorawan_time_t get_next_tx_delay(void);
+
+    /**
+     * Gets the largest application payload a frame can carry at the current
+     * datarate, along with the MAC commands pending.
+     *
+     * @return Size in bytes, capped at MBED_CONF_LORA_TX_MAX_SIZE.
+     */
+    uint8_t get_max_uplink_payload_size(void);
+
     /**
      * Clears out the TX pipe by discarding any outgoing message if the backoff
      * timer is still running.
@@ -419,6 +469,46 @@ public:
      */
     uint8_t get_prev_QOS_level(void);
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+    /**
+     * Gets the context of the session joined: addresses, session keys,
+     * system parameters as last set by the network and channel plan.
+     *
+     * @param context  Filled with the context, padding bytes zeroed.
+     * @param is_otaa  True if the session was joined over the air.
+     */
+    void get_session_context(loramac_session_context_t &context, bool is_otaa);
+
+    /**
+     * Resumes a session saved with get_session_context(), after prepare_join().
+     * The MAC is then joined.
+     *
+     * @param context  The context saved.
+     * @param is_otaa  True if the session is to be joined over the air.
+     *
+     * @return LORAWAN_STATUS_OK if the session is resumed,
+     *         LORAWAN_STATUS_PARAMETER_INVALID if the context is from another
+     *         version, activation or device.
+     */
+    lorawan_status_t set_session_context(const loramac_session_context_t &context, bool is_otaa);
+
+    /**
+     * Sets the frame counters of a session resumed.
+     *
+     * @param uplink    The counter of the next uplink frame.
+     * @param downlink  The counter of the last downlink frame received.
+     */
+    void set_frame_counters(uint32_t uplink, uint32_t downlink);
+
+    /**
+     * Gets the frame counters of the session.
+     *
+     * @param uplink    Filled with the counter of the next uplink frame.
+     * @param downlink  Filled with the counter of the last downlink frame received.
+     */
+    void get_frame_counters(uint32_t &uplink, uint32_t &downlink);
+#endif
+
     /**
      * These locks trample through to the upper layers and make
      * the stack thread safe.
@@ -668,6 +758,16 @@ private:
 
     timer_event_t _rx2_closure_timer_for_class_c;
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    /**
+     * Low power ticker timeouts opening the RX windows, relative to the
+     * end of transmission captured by the radio interrupt
+     */
+    mbed::LowPowerTimeout _rx_window1_timeout;
+    mbed::LowPowerTimeout _rx_window2_timeout;
+    mbed::LowPowerClock::time_point _tx_done_time;
+#endif
+
     /**
      * Structure to hold MCPS indication data.
      */
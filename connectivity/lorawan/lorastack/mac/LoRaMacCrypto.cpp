@@ -30,11 +30,13 @@
 #include "LoRaMacCrypto.h"
 #include "system/lorawan_data_structures.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 
 
 #if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_C)
 
 LoRaMacCrypto::LoRaMacCrypto()
+    : aes_ctx_next(0), cmac_key_length(0), cmac_ready(false), cmac_keyed(false)
 {
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(NULL);
@@ -42,15 +44,102 @@ LoRaMacCrypto::LoRaMacCrypto()
         MBED_ASSERT(0 && "LoRaMacCrypto: Fail in mbedtls_platform_setup.");
     }
 #endif /* MBEDTLS_PLATFORM_C */
+
+    for (uint8_t i = 0; i < LORAMAC_CRYPTO_AES_CONTEXTS; i++) {
+        mbedtls_aes_init(&aes_ctx[i].ctx);
+        aes_ctx[i].key_length = 0;
+        aes_ctx[i].keyed = false;
+    }
+    mbedtls_cipher_init(aes_cmac_ctx);
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
 {
+    for (uint8_t i = 0; i < LORAMAC_CRYPTO_AES_CONTEXTS; i++) {
+        mbedtls_aes_free(&aes_ctx[i].ctx);
+        mbedtls_platform_zeroize(aes_ctx[i].key, sizeof(aes_ctx[i].key));
+    }
+    mbedtls_cipher_free(aes_cmac_ctx);
+    mbedtls_platform_zeroize(cmac_key, sizeof(cmac_key));
+
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
 }
 
+int LoRaMacCrypto::get_aes_context(const uint8_t *key, uint32_t key_length,
+                                   mbedtls_aes_context **ctx)
+{
+    int ret = 0;
+    const size_t key_size = key_length / 8;
+
+    for (uint8_t i = 0; i < LORAMAC_CRYPTO_AES_CONTEXTS; i++) {
+        aes_key_context_t *cached = &aes_ctx[i];
+        if (cached->keyed && cached->key_length == key_length
+                && memcmp(cached->key, key, key_size) == 0) {
+            *ctx = &cached->ctx;
+            return 0;
+        }
+    }
+
+    aes_key_context_t *cached = &aes_ctx[aes_ctx_next];
+    aes_ctx_next = (aes_ctx_next + 1) % LORAMAC_CRYPTO_AES_CONTEXTS;
+
+    cached->keyed = false;
+    ret = mbedtls_aes_setkey_enc(&cached->ctx, key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
+
+    // Longer keys work but are set up again on each use
+    if (key_size <= sizeof(cached->key)) {
+        memcpy(cached->key, key, key_size);
+        cached->key_length = key_length;
+        cached->keyed = true;
+    }
+
+    *ctx = &cached->ctx;
+    return 0;
+}
+
+int LoRaMacCrypto::start_cmac(const uint8_t *key, uint32_t key_length)
+{
+    int ret = 0;
+    const size_t key_size = key_length / 8;
+
+    if (!cmac_ready) {
+        const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+        if (NULL == cipher_info) {
+            return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+        }
+
+        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
+        if (0 != ret) {
+            return ret;
+        }
+        cmac_ready = true;
+    }
+
+    if (cmac_keyed && cmac_key_length == key_length
+            && memcmp(cmac_key, key, key_size) == 0) {
+        return mbedtls_cipher_cmac_reset(aes_cmac_ctx);
+    }
+
+    cmac_keyed = false;
+    ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
+
+    if (key_size <= sizeof(cmac_key)) {
+        memcpy(cmac_key, key, key_size);
+        cmac_key_length = key_length;
+        cmac_keyed = true;
+    }
+
+    return 0;
+}
+
 int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
                                const uint8_t *key, const uint32_t key_length,
                                uint32_t address, uint8_t dir, uint32_t seq_counter,
@@ -76,45 +165,30 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 
     mic_block_b0[15] = size & 0xFF;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = start_cmac(key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+
     return ret;
 }
 
@@ -129,11 +203,11 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     int ret = 0;
     uint8_t a_block[16] = {};
     uint8_t s_block[16] = {};
+    mbedtls_aes_context *ctx = NULL;
 
-    mbedtls_aes_init(&aes_ctx);
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes_context(key, key_length, &ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     a_block[0] = 0x01;
@@ -152,10 +226,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     while (size >= 16) {
         a_block[15] = ((ctr) & 0xFF);
         ctr++;
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < 16; i++) {
@@ -167,10 +241,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
 
     if (size > 0) {
         a_block[15] = ((ctr) & 0xFF);
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < size; i++) {
@@ -178,8 +252,6 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
         }
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -199,39 +271,25 @@ int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *buffer, uint16_t size,
     uint8_t computed_mic[16] = {};
     int ret = 0;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = start_cmac(key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+
     return ret;
 }
 
@@ -240,28 +298,25 @@ int LoRaMacCrypto::decrypt_join_frame(const uint8_t *buffer, uint16_t size,
                                       uint8_t *dec_buffer)
 {
     int ret = 0;
+    mbedtls_aes_context *ctx = NULL;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes_context(key, key_length, &ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
+    ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, buffer,
                                 dec_buffer);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     // Check if optional CFList is included
     if (size >= 16) {
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
                                     dec_buffer + 16);
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -272,31 +327,28 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *key, uint32_t key
     uint8_t nonce[16];
     uint8_t *p_dev_nonce = (uint8_t *) &dev_nonce;
     int ret = 0;
+    mbedtls_aes_context *ctx = NULL;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = get_aes_context(key, key_length, &ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x01;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
+    ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x02;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
+    ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 #else
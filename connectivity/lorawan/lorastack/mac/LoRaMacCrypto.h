@@ -33,6 +33,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "mbedtls/aes.h"
 #include "mbedtls/cmac.h"
 
+/**
+ * Number of AES keys whose key schedule is kept, enough for the two
+ * session keys (NwkSKey, AppSKey) or the AppKey during a join.
+ */
+#define LORAMAC_CRYPTO_AES_CONTEXTS 2
+
 
 class LoRaMacCrypto {
 public:
@@ -152,14 +158,52 @@ public:
 
 private:
     /**
-     * AES computation context variable
+     * An AES context and the key it is set up with
+     */
+    struct aes_key_context_t {
+        mbedtls_aes_context ctx;
+        uint8_t key[32];
+        uint32_t key_length;
+        bool keyed;
+    };
+
+    /**
+     * Get an AES context set up for encryption with a key
+     *
+     * The contexts are kept across frames, so that the key schedule only runs
+     * when a key changes, i.e. on join. With a hardware AES (MBEDTLS_AES_ALT),
+     * the peripheral also stays configured for the context across blocks.
+     *
+     * @param [in]  key             - AES key to be used
+     * @param [in]  key_length      - Length of the key (bits)
+     * @param [out] ctx             - The context keyed
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_aes_context(const uint8_t *key, uint32_t key_length, mbedtls_aes_context **ctx);
+
+    /**
+     * Start a CMAC computation, only setting up the key if it changed
+     *
+     * @param [in]  key             - AES key to be used
+     * @param [in]  key_length      - Length of the key (bits)
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int start_cmac(const uint8_t *key, uint32_t key_length);
+
+    /**
+     * AES computation contexts, replaced in turn when a new key is used
      */
-    mbedtls_aes_context aes_ctx;
+    aes_key_context_t aes_ctx[LORAMAC_CRYPTO_AES_CONTEXTS];
+    uint8_t aes_ctx_next;
 
     /**
-     * CMAC computation context variable
+     * CMAC computation context variable and the key it is set up with
      */
     mbedtls_cipher_context_t aes_cmac_ctx[1];
+    uint8_t cmac_key[32];
+    uint32_t cmac_key_length;
+    bool cmac_ready;
+    bool cmac_keyed;
 };
 
 #endif // MBED_LORAWAN_MAC_LORAMAC_CRYPTO_H__
@@ -27,6 +27,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <stdint.h>
 #include <math.h>
 
+#include "platform/mbed_assert.h"
 #include "LoRaPHY.h"
 
 #define BACKOFF_DC_1_HOUR       100
@@ -34,10 +35,19 @@ SPDX-License-Identifier: BSD-3-Clause
 #define BACKOFF_DC_24_HOURS     10000
 #define MAX_PREAMBLE_LENGTH     8.0f
 #define TICK_GRANULARITY_JITTER 1.0f
+
+// The precise RX timing measures the wakeup time and opens the windows after it
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+#define RX_WAKEUP_TIME 0.0f
+#else
+#define RX_WAKEUP_TIME MBED_CONF_LORA_WAKEUP_TIME
+#endif
 #define CHANNELS_IN_MASK        16
 
 LoRaPHY::LoRaPHY()
-    : _radio(NULL),
+    : _dr_mask_channels(NULL),
+      _dr_mask_datarate(-1),
+      _radio(NULL),
       _lora_time(NULL)
 {
     memset(&phy_params, 0, sizeof(phy_params));
@@ -308,6 +318,28 @@ lorawan_time_t LoRaPHY::update_band_timeoff(bool joined, bool duty_cycle,
     return next_tx_delay;
 }
 
+lorawan_time_t LoRaPHY::get_next_tx_delay(bool dc_enabled)
+{
+    band_t *bands = (band_t *) phy_params.bands.table;
+    lorawan_time_t next_tx_delay = (lorawan_time_t)(-1);
+
+    if (!dc_enabled) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < phy_params.bands.size; i++) {
+        lorawan_time_t elapsed = _lora_time->get_elapsed_time(bands[i].last_tx_time);
+
+        if (bands[i].off_time <= elapsed) {
+            return 0;
+        }
+
+        next_tx_delay = MIN(bands[i].off_time - elapsed, next_tx_delay);
+    }
+
+    return next_tx_delay;
+}
+
 uint8_t LoRaPHY::parse_link_ADR_req(const uint8_t *payload,
                                     uint8_t payload_size,
                                     link_adr_params_t *params)
@@ -485,6 +517,30 @@ uint8_t LoRaPHY::get_bandwidth(uint8_t dr)
     }
 }
 
+const uint16_t *LoRaPHY::get_datarate_channel_mask(uint8_t datarate)
+{
+    const channel_params_t *channels = phy_params.channels.channel_list;
+
+    if (_dr_mask_datarate == datarate && _dr_mask_channels == channels) {
+        return _dr_channel_mask;
+    }
+
+    MBED_ASSERT(phy_params.max_channel_cnt <= LORA_PHY_MAX_CHANNEL_MASK_SIZE * 16);
+
+    memset(_dr_channel_mask, 0, sizeof(_dr_channel_mask));
+    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
+        if (val_in_range(datarate, channels[i].dr_range.fields.min,
+                         channels[i].dr_range.fields.max)) {
+            mask_bit_set(_dr_channel_mask, i);
+        }
+    }
+
+    _dr_mask_channels = channels;
+    _dr_mask_datarate = datarate;
+
+    return _dr_channel_mask;
+}
+
 uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
                                        const uint16_t *channel_mask,
                                        uint8_t *channel_indices,
@@ -492,25 +548,39 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
 {
     uint8_t count = 0;
     uint8_t delay_transmission = 0;
+    const uint8_t mask_size = (phy_params.max_channel_cnt + 15) / 16;
+    band_t *band_table = (band_t *) phy_params.bands.table;
+    uint16_t enabled = 0;
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    for (uint8_t i = 0; i < mask_size; i++) {
+        enabled |= channel_mask[i];
+    }
 
-            if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
-                             phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
-                // data rate range invalid for this channel
+    if (enabled == 0) {
+        *delayTx = 0;
+        return 0;
+    }
+
+    // Only the channels both enabled and supporting the datarate are visited,
+    // not the whole channel list
+    const uint16_t *dr_mask = get_datarate_channel_mask(datarate);
+
+    for (uint8_t i = 0; i < mask_size; i++) {
+        uint16_t candidates = channel_mask[i] & dr_mask[i];
+
+        for (uint8_t channel = i * 16; candidates != 0; channel++, candidates >>= 1) {
+            if ((candidates & 1) == 0) {
                 continue;
             }
 
-            band_t *band_table = (band_t *) phy_params.bands.table;
-            if (band_table[phy_params.channels.channel_list[i].band].off_time > 0) {
+            if (band_table[phy_params.channels.channel_list[channel].band].off_time > 0) {
                 // Check if the band is available for transmission
                 delay_transmission++;
                 continue;
             }
 
             // otherwise count the channel as enabled
-            channel_indices[count++] = i;
+            channel_indices[count++] = channel;
         }
     }
 
@@ -666,6 +736,17 @@ bool LoRaPHY::is_custom_channel_plan_supported()
     return phy_params.custom_channelplans_supported;
 }
 
+void LoRaPHY::restore_channel_plan(const channel_params_t *channels, const uint16_t *mask)
+{
+    if (phy_params.custom_channelplans_supported) {
+        memcpy(phy_params.channels.channel_list, channels,
+               phy_params.max_channel_cnt * sizeof(channel_params_t));
+    }
+    copy_channel_mask(phy_params.channels.mask, const_cast<uint16_t *>(mask),
+                      phy_params.channels.mask_size);
+    _dr_mask_datarate = -1;
+}
+
 void LoRaPHY::restore_default_channels()
 {
     // Restore channels default mask
@@ -849,7 +930,7 @@ void LoRaPHY::compute_rx_win_params(int8_t datarate, uint8_t min_rx_symbols,
         rx_conf_params->frequency = phy_params.channels.channel_list[rx_conf_params->channel].frequency;
     }
 
-    get_rx_window_params(t_symbol, min_rx_symbols, (float) rx_error, MBED_CONF_LORA_WAKEUP_TIME,
+    get_rx_window_params(t_symbol, min_rx_symbols, (float) rx_error, RX_WAKEUP_TIME,
                          &rx_conf_params->window_timeout, &rx_conf_params->window_timeout_ms,
                          &rx_conf_params->window_offset,
                          rx_conf_params->datarate);
@@ -1394,6 +1475,7 @@ lorawan_status_t LoRaPHY::add_channel(const channel_params_t *new_channel,
     }
 
     memmove(&(phy_params.channels.channel_list[id]), new_channel, sizeof(channel_params_t));
+    _dr_mask_datarate = -1;
 
     phy_params.channels.channel_list[id].band = new_channel->band;
 
@@ -1414,6 +1496,7 @@ bool LoRaPHY::remove_channel(uint8_t channel_id)
     // Remove the channel from the list of channels
     const channel_params_t empty_channel = { 0, 0, {0}, 0 };
     phy_params.channels.channel_list[channel_id] = empty_channel;
+    _dr_mask_datarate = -1;
 
     return disable_channel(phy_params.channels.mask, channel_id,
                            phy_params.max_channel_cnt);
@@ -40,6 +40,11 @@
 #include "LoRaRadio.h"
 #include "lora_phy_ds.h"
 
+/**
+ * Size of the largest channel mask of the regions, in 16-bit words (CN470)
+ */
+#define LORA_PHY_MAX_CHANNEL_MASK_SIZE  6
+
 /** LoRaPHY Class
  * Parent class for LoRa regional PHY implementations
  */
@@ -124,6 +129,17 @@ public:
     void calculate_backoff(bool joined, bool last_tx_was_join_req, bool dc_enabled, uint8_t channel,
                            lorawan_time_t elapsed_time, lorawan_time_t tx_toa);
 
+    /**
+     * @brief get_next_tx_delay Gets the time before a band is out of its
+     *                          duty cycle time-off, without updating the bands.
+     *
+     * @param dc_enabled            Set to true, if the duty cycle is enabled, otherwise false.
+     *
+     * @return 0 if a band can transmit now, otherwise the time in ms before the
+     *         first one can.
+     */
+    lorawan_time_t get_next_tx_delay(bool dc_enabled);
+
     /**
       * Tests if a channel is on or off in the channel mask
       */
@@ -520,6 +536,16 @@ public:
      */
     bool is_custom_channel_plan_supported();
 
+    /**
+     * @brief restore_channel_plan Restores the channels and the channel mask of
+     *                             a previous session.
+     *
+     * @param channels  The channels, get_max_nb_channels() of them. Only used
+     *                  with custom channel plans, the others are fixed.
+     * @param mask      The channel mask, of get_max_nb_channels() bits.
+     */
+    void restore_channel_plan(const channel_params_t *channels, const uint16_t *mask);
+
     /**
      * @brief get_rx_time_on_air(...) calculates the time the received spent on air
      * @return time spent on air in milliseconds
@@ -674,6 +700,19 @@ private:
      */
     float compute_symb_timeout_fsk(uint8_t phy_dr);
 
+    /**
+     * Gets the mask of the channels of the channel list supporting a datarate,
+     * rebuilt only when the datarate or the channel plan changed.
+     */
+    const uint16_t *get_datarate_channel_mask(uint8_t datarate);
+
+    /**
+     * Channels supporting _dr_mask_datarate, cached for enabled_channel_count()
+     */
+    uint16_t _dr_channel_mask[LORA_PHY_MAX_CHANNEL_MASK_SIZE];
+    const channel_params_t *_dr_mask_channels;
+    int8_t _dr_mask_datarate;
+
 protected:
     LoRaRadio *_radio;
     LoRaWANTimeHandler *_lora_time;
@@ -137,6 +137,15 @@ int16_t LoRaWANInterface::send(uint8_t port, const uint8_t *data, uint16_t lengt
     return _lw_stack.handle_tx(port, data, length, flags);
 }
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+lorawan_status_t LoRaWANInterface::queue_send(uint8_t port, const uint8_t *data, uint16_t length,
+                                              int flags, bool aggregate)
+{
+    Lock lock(*this);
+    return _lw_stack.queue_tx(port, data, length, flags, aggregate);
+}
+#endif
+
 lorawan_status_t LoRaWANInterface::cancel_sending(void)
 {
     Lock lock(*this);
@@ -161,6 +170,14 @@ lorawan_status_t LoRaWANInterface::get_backoff_metadata(int &backoff)
     return _lw_stack.acquire_backoff_metadata(backoff);
 }
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+lorawan_status_t LoRaWANInterface::get_uplink_queue_metadata(uint8_t &count, int &send_time)
+{
+    Lock lock(*this);
+    return _lw_stack.acquire_uplink_queue_metadata(count, send_time);
+}
+#endif
+
 int16_t LoRaWANInterface::receive(uint8_t port, uint8_t *data, uint16_t length, int flags)
 {
     Lock lock(*this);
@@ -30,6 +30,15 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "LoRaWANStack.h"
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+#include "drivers/MbedCRC.h"
+#include "platform/mbed_error.h"
+#include "kvstore_global_api.h"
+
+#define SESSION_CONTEXT_KEY         MBED_CONF_LORA_SESSION_STORAGE_PREFIX "lora_session"
+#define SESSION_COUNTERS_KEY        MBED_CONF_LORA_SESSION_STORAGE_PREFIX "lora_fcnt"
+#endif
+
 #include "mbed-trace/mbed_trace.h"
 #define TRACE_GROUP "LSTK"
 
@@ -74,6 +83,16 @@ LoRaWANStack::LoRaWANStack()
       _link_check_requested(false),
       _automatic_uplink_ongoing(false),
       _queue(NULL)
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    , _uplink_queue_head(0),
+      _uplink_queue_count(0),
+      _uplink_queue_event_id(0)
+#endif
+#if MBED_CONF_LORA_SESSION_STORAGE
+    , _session_crc(0),
+      _uplink_counter_reserved(0),
+      _downlink_counter_saved(0)
+#endif
 {
     _tx_metadata.stale = true;
     _rx_metadata.stale = true;
@@ -279,6 +298,9 @@ lorawan_status_t LoRaWANStack::stop_sending(void)
         _ctrl_flags &= ~TX_DONE_FLAG;
         _loramac.set_tx_ongoing(false);
         _device_current_state = DEVICE_STATE_IDLE;
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+        schedule_uplink_queue();
+#endif
         return LORAWAN_STATUS_OK;
     }
 
@@ -340,6 +362,11 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
 
     int16_t len = _loramac.prepare_ongoing_tx(port, data, length, flags, _num_retry);
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+    // Before the counter is used, so a reset never reuses it
+    save_frame_counters();
+#endif
+
     status = state_controller(DEVICE_STATE_SCHEDULING);
 
     // send user the length of data which is scheduled now.
@@ -505,12 +532,171 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
     return LORAWAN_STATUS_METADATA_NOT_AVAILABLE;
 }
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+lorawan_status_t LoRaWANStack::queue_tx(const uint8_t port, const uint8_t *data,
+                                        uint16_t length, uint8_t flags, bool aggregate)
+{
+    if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    if (!data) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (!_lw_session.active) {
+        return LORAWAN_STATUS_NO_ACTIVE_SESSIONS;
+    }
+
+    if (!is_port_valid(port)) {
+        tr_error("Illegal application port definition.");
+        return LORAWAN_STATUS_PORT_INVALID;
+    }
+
+    switch (flags & MSG_FLAG_MASK) {
+        case MSG_UNCONFIRMED_FLAG:
+        case MSG_CONFIRMED_FLAG:
+        case MSG_PROPRIETARY_FLAG:
+            break;
+
+        default:
+            tr_error("Invalid send flags");
+            return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    const uint8_t max_size = _loramac.get_max_uplink_payload_size();
+
+    if (length > max_size) {
+        tr_error("Cannot queue %d bytes. Possible TX Size is %d bytes", length, max_size);
+        return LORAWAN_STATUS_LENGTH_ERROR;
+    }
+
+    // The last message is not sent yet: both can share its frame
+    if (aggregate && _uplink_queue_count > 0) {
+        uplink_message_t &last = _uplink_queue[(_uplink_queue_head + _uplink_queue_count - 1)
+                                               % MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+
+        if (last.aggregate && last.port == port && last.flags == flags
+                && last.length + length <= max_size) {
+            memcpy(last.data + last.length, data, length);
+            last.length += length;
+            return LORAWAN_STATUS_OK;
+        }
+    }
+
+    if (_uplink_queue_count == MBED_CONF_LORA_UPLINK_QUEUE_SIZE) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    uplink_message_t &msg = _uplink_queue[(_uplink_queue_head + _uplink_queue_count)
+                                          % MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+    msg.port = port;
+    msg.flags = flags;
+    msg.aggregate = aggregate;
+    msg.length = length;
+    memcpy(msg.data, data, length);
+    _uplink_queue_count++;
+
+    schedule_uplink_queue();
+
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::acquire_uplink_queue_metadata(uint8_t &count, int &send_time)
+{
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    count = _uplink_queue_count;
+
+    if (_uplink_queue_count == 0 || _loramac.tx_ongoing()) {
+        send_time = -1;
+    } else if (_uplink_queue_event_id != 0) {
+        send_time = _queue->time_left(_uplink_queue_event_id);
+    } else {
+        send_time = _loramac.get_next_tx_delay();
+    }
+
+    return LORAWAN_STATUS_OK;
+}
+#endif
+
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+/*****************************************************************************
+ * Uplink queue                                                              *
+ ****************************************************************************/
+void LoRaWANStack::schedule_uplink_queue(void)
+{
+    if (_uplink_queue_count > 0 && _uplink_queue_event_id == 0) {
+        _uplink_queue_event_id = _queue->call(this, &LoRaWANStack::process_uplink_queue);
+        MBED_ASSERT(_uplink_queue_event_id != 0);
+    }
+}
+
+void LoRaWANStack::process_uplink_queue(void)
+{
+    Lock lock(*this);
+
+    _uplink_queue_event_id = 0;
+
+    // The completion of the ongoing transmission, or the connection, posts
+    // this again
+    if (_uplink_queue_count == 0 || _loramac.tx_ongoing() || !_loramac.nwk_joined()) {
+        return;
+    }
+
+    // Waiting in the queue rather than in the MAC backoff timer keeps the
+    // message open for aggregation
+    const lorawan_time_t delay = _loramac.get_next_tx_delay();
+    if (delay > 0) {
+        _uplink_queue_event_id = _queue->call_in(std::chrono::milliseconds(delay), this,
+                                                 &LoRaWANStack::process_uplink_queue);
+        MBED_ASSERT(_uplink_queue_event_id != 0);
+        return;
+    }
+
+    uplink_message_t &msg = _uplink_queue[_uplink_queue_head];
+    const int16_t ret = handle_tx(msg.port, msg.data, msg.length, msg.flags);
+
+    if (ret == LORAWAN_STATUS_WOULD_BLOCK || ret == LORAWAN_STATUS_BUSY) {
+        return;
+    }
+
+    if (ret < 0) {
+        tr_error("Dropped a queued uplink message, error code = %d", ret);
+        send_event_to_application(TX_SCHEDULING_ERROR);
+    } else if (ret < msg.length) {
+        // The datarate went down meanwhile: the rest goes in the next frame
+        memmove(msg.data, msg.data + ret, msg.length - ret);
+        msg.length -= ret;
+        return;
+    }
+
+    _uplink_queue_head = (_uplink_queue_head + 1) % MBED_CONF_LORA_UPLINK_QUEUE_SIZE;
+    _uplink_queue_count--;
+}
+
+void LoRaWANStack::flush_uplink_queue(void)
+{
+    if (_uplink_queue_event_id != 0) {
+        _queue->cancel(_uplink_queue_event_id);
+        _uplink_queue_event_id = 0;
+    }
+    _uplink_queue_head = 0;
+    _uplink_queue_count = 0;
+}
+#endif
+
 /*****************************************************************************
  * Interrupt handlers                                                        *
  ****************************************************************************/
 void LoRaWANStack::tx_interrupt_handler(void)
 {
     _tx_timestamp = _loramac.get_current_time();
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    _loramac.capture_tx_done_time();
+#endif
     const int ret = _queue->call(this, &LoRaWANStack::process_transmission);
     MBED_ASSERT(ret != 0);
     (void)ret;
@@ -905,10 +1091,7 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
         // communication. In case of ABP specification is meddled about frame counters.
         // It says to reset counters to zero but there is no mechanism to tell the
         // network server that the device was disconnected or restarted.
-        // At the moment, this implementation does not support a non-volatile
-        // memory storage.
-        //_lw_session.downlink_counter; //Get from NVM
-        //_lw_session.uplink_counter; //Get from NVM
+        // With session storage, the counters saved are restored below.
 
         tr_debug("Initiating ABP");
         tr_debug("Frame Counters. UpCnt=%lu, DownCnt=%lu",
@@ -916,9 +1099,105 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
         _ctrl_flags &= ~USING_OTAA_FLAG;
     }
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+    if (restore_session(is_otaa)) {
+        tr_debug("Session restored. UpCnt=%lu, DownCnt=%lu",
+                 _lw_session.uplink_counter, _lw_session.downlink_counter);
+        _device_current_state = DEVICE_STATE_CONNECTING;
+        process_connected_state();
+        return LORAWAN_STATUS_OK;
+    }
+
+    // A new session: its counters start from zero
+    _session_crc = 0;
+    _uplink_counter_reserved = 0;
+    _downlink_counter_saved = 0;
+#endif
+
     return state_controller(DEVICE_STATE_CONNECTING);
 }
 
+#if MBED_CONF_LORA_SESSION_STORAGE
+bool LoRaWANStack::restore_session(bool is_otaa)
+{
+    loramac_session_context_t context;
+    uint32_t counters[2];
+    size_t size = 0;
+
+    // counters[0] is the uplink counter reserved, counters[1] the downlink one
+    if (kv_get(SESSION_COUNTERS_KEY, counters, sizeof(counters), &size) != MBED_SUCCESS
+            || size != sizeof(counters)) {
+        return false;
+    }
+
+    if (kv_get(SESSION_CONTEXT_KEY, &context, sizeof(context), &size) != MBED_SUCCESS
+            || size != sizeof(context)
+            || _loramac.set_session_context(context, is_otaa) != LORAWAN_STATUS_OK) {
+        return false;
+    }
+
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    ct.compute(&context, sizeof(context), &_session_crc);
+
+    // The frames sent since the last save used counters below the one
+    // reserved: resume from it, the first uplink then reserves the next ones.
+    _loramac.set_frame_counters(counters[0], counters[1]);
+    _uplink_counter_reserved = counters[0];
+    _downlink_counter_saved = counters[1];
+    _lw_session.uplink_counter = counters[0];
+    _lw_session.downlink_counter = counters[1];
+
+    return true;
+}
+
+void LoRaWANStack::save_session(void)
+{
+    loramac_session_context_t context;
+    uint32_t crc = 0;
+
+    _loramac.get_session_context(context, _ctrl_flags & USING_OTAA_FLAG);
+
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    ct.compute(&context, sizeof(context), &crc);
+    if (crc == _session_crc) {
+        return;
+    }
+
+    if (kv_set(SESSION_CONTEXT_KEY, &context, sizeof(context), 0) != MBED_SUCCESS) {
+        tr_error("Failed to save the session");
+        return;
+    }
+    _session_crc = crc;
+}
+
+void LoRaWANStack::save_frame_counters(void)
+{
+    uint32_t uplink;
+    uint32_t downlink;
+
+    _loramac.get_frame_counters(uplink, downlink);
+    if (uplink < _uplink_counter_reserved
+            && downlink - _downlink_counter_saved < MBED_CONF_LORA_SESSION_FCNT_GAP) {
+        return;
+    }
+
+    const uint32_t counters[2] = {uplink + MBED_CONF_LORA_SESSION_FCNT_GAP, downlink};
+    if (kv_set(SESSION_COUNTERS_KEY, counters, sizeof(counters), 0) != MBED_SUCCESS) {
+        tr_error("Failed to save the frame counters");
+        return;
+    }
+    _uplink_counter_reserved = counters[0];
+    _downlink_counter_saved = counters[1];
+}
+
+void LoRaWANStack::erase_session(void)
+{
+    kv_remove(SESSION_COUNTERS_KEY);
+    kv_remove(SESSION_CONTEXT_KEY);
+    _session_crc = 0;
+}
+#endif
+
 void LoRaWANStack::mlme_indication_handler()
 {
     if (_loramac.get_mlme_indication()->indication_type == MLME_SCHEDULE_UPLINK) {
@@ -1122,6 +1401,15 @@ void LoRaWANStack::process_shutdown_state(lorawan_status_t &op_status)
      */
     drop_channel_list();
     _loramac.disconnect();
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    flush_uplink_queue();
+#endif
+#if MBED_CONF_LORA_SESSION_STORAGE
+    // An ABP device keeps its counters across connections
+    if (_ctrl_flags & USING_OTAA_FLAG) {
+        erase_session();
+    }
+#endif
     _lw_session.active = false;
     _device_current_state = DEVICE_STATE_SHUTDOWN;
     op_status = LORAWAN_STATUS_DEVICE_OFF;
@@ -1167,6 +1455,19 @@ void LoRaWANStack::process_status_check_state()
             mcps_indication_handler();
         }
     }
+
+#if MBED_CONF_LORA_SESSION_STORAGE
+    // The MAC commands received may have changed the session parameters
+    if ((_ctrl_flags & CONNECTED_FLAG) && !_loramac.tx_ongoing()) {
+        save_session();
+    }
+#endif
+
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    if (!_loramac.tx_ongoing()) {
+        schedule_uplink_queue();
+    }
+#endif
 }
 
 void LoRaWANStack::process_scheduling_state(lorawan_status_t &op_status)
@@ -1221,9 +1522,16 @@ void LoRaWANStack::process_connected_state()
     }
 
     _lw_session.active = true;
+#if MBED_CONF_LORA_SESSION_STORAGE
+    save_session();
+    save_frame_counters();
+#endif
     send_event_to_application(CONNECTED);
 
     _device_current_state = DEVICE_STATE_IDLE;
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    schedule_uplink_queue();
+#endif
 }
 
 void LoRaWANStack::process_connecting_state(lorawan_status_t &op_status)
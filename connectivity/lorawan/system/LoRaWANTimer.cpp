@@ -22,8 +22,18 @@ SPDX-License-Identifier: BSD-3-Clause
 
 using namespace std::chrono;
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+// Until measured, the platform wakeup time is the latency of the precise timers
+#define PRECISE_LATENCY_DEFAULT milliseconds(MBED_CONF_LORA_WAKEUP_TIME)
+// Longer latencies are taken as timers fired late, they are not measured
+#define PRECISE_LATENCY_MAX (2 * PRECISE_LATENCY_DEFAULT)
+#endif
+
 LoRaWANTimeHandler::LoRaWANTimeHandler()
     : _queue(NULL)
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    , _precise_latency(PRECISE_LATENCY_DEFAULT)
+#endif
 {
 }
 
@@ -51,6 +61,9 @@ void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callbac
 {
     obj.callback = callback;
     obj.timer_id = 0;
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    obj.precise_timeout = NULL;
+#endif
 }
 
 void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
@@ -61,6 +74,60 @@ void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
 
 void LoRaWANTimeHandler::stop(timer_event_t &obj)
 {
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    // Once detached, the ticker can no longer post the callback
+    if (obj.precise_timeout) {
+        obj.precise_timeout->detach();
+    }
+#endif
     _queue->cancel(obj.timer_id);
     obj.timer_id = 0;
 }
+
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+void LoRaWANTimeHandler::init_precise(timer_event_t &obj, mbed::LowPowerTimeout &timeout,
+                                      mbed::Callback<void()> callback)
+{
+    init(obj, callback);
+    obj.precise_timeout = &timeout;
+}
+
+mbed::LowPowerClock::time_point LoRaWANTimeHandler::get_precise_time(void)
+{
+    return mbed::LowPowerClock::now();
+}
+
+void LoRaWANTimeHandler::start_precise(timer_event_t &obj, mbed::LowPowerClock::time_point reference,
+                                       int32_t timeout)
+{
+    MBED_ASSERT(obj.precise_timeout != NULL);
+    obj.timer_id = 0;
+    obj.precise_timeout->attach_absolute([this, &obj] { on_precise_timeout(&obj); },
+                                         reference + milliseconds(timeout) - _precise_latency);
+}
+
+bool LoRaWANTimeHandler::get_precise_fire_time(timer_event_t &obj, mbed::LowPowerClock::time_point &fire_time)
+{
+    if (obj.precise_timeout == NULL || obj.timer_id == 0) {
+        return false;
+    }
+    fire_time = obj.precise_timeout->scheduled_time();
+    return true;
+}
+
+void LoRaWANTimeHandler::calibrate_precise(mbed::LowPowerClock::time_point fire_time)
+{
+    microseconds latency = duration_cast<microseconds>(mbed::LowPowerClock::now() - fire_time);
+    if (latency < 0us || latency > PRECISE_LATENCY_MAX) {
+        return;
+    }
+    // Moving average over about 4 measures
+    _precise_latency += (latency - _precise_latency) / 4;
+}
+
+void LoRaWANTimeHandler::on_precise_timeout(timer_event_t *obj)
+{
+    obj->timer_id = _queue->call(obj->callback);
+    MBED_ASSERT(obj->timer_id != 0);
+}
+#endif
@@ -24,6 +24,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <stdint.h>
 #include "events/EventQueue.h"
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+#if !DEVICE_LPTICKER
+#error "lora.precise-rx-timing needs a low power ticker"
+#endif
+#include "drivers/LowPowerTimeout.h"
+#endif
+
 #include "lorawan_data_structures.h"
 
 class LoRaWANTimeHandler {
@@ -76,8 +83,58 @@ public:
      */
     void stop(timer_event_t &obj);
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    /** Initializes a precise timer object.
+     * @param [in] obj          The structure containing the timer object parameters.
+     * @param [in] timeout      The low power ticker timeout of the timer.
+     * @param [in] callback     The function callback called at the end of the timeout.
+     */
+    void init_precise(timer_event_t &obj, mbed::LowPowerTimeout &timeout,
+                      mbed::Callback<void()> callback);
+
+    /** Read the current time with the resolution of the low power ticker.
+     * @remark Interrupt safe, to time stamp radio events from their interrupt.
+     * @return time The current time.
+     */
+    mbed::LowPowerClock::time_point get_precise_time(void);
+
+    /** Starts a precise timer.
+     * The low power ticker interrupt posts the callback ahead of the expiry
+     * by the latency measured by calibrate_precise(), so that the callback
+     * runs when the timer expires rather than after the wakeup from sleep
+     * and the dispatch of the queue.
+     * @param [in] obj       The structure containing the timer object parameters.
+     * @param [in] reference The time the timeout is relative to.
+     * @param [in] timeout   The timeout value in ms, possibly negative.
+     */
+    void start_precise(timer_event_t &obj, mbed::LowPowerClock::time_point reference,
+                       int32_t timeout);
+
+    /** Read when the low power ticker of a precise timer fired.
+     * @param [in]  obj       The structure containing the timer object parameters.
+     * @param [out] fire_time The time the ticker was set to fire.
+     * @return      true if the timer callback has been posted by the ticker.
+     */
+    bool get_precise_fire_time(timer_event_t &obj, mbed::LowPowerClock::time_point &fire_time);
+
+    /** Measures the latency of the precise timers.
+     * To be called once the action timed by a precise timer is done.
+     * @param [in] fire_time The time its ticker was set to fire.
+     */
+    void calibrate_precise(mbed::LowPowerClock::time_point fire_time);
+#endif
+
 private:
     events::EventQueue *_queue;
+
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    void on_precise_timeout(timer_event_t *obj);
+
+    /**
+     * Average time from the ticker interrupt to the action timed
+     */
+    std::chrono::microseconds _precise_latency;
+#endif
 };
 
 #endif // MBED_LORAWAN_SYS_TIMER_H__
@@ -37,6 +37,12 @@
 #include <inttypes.h>
 #include "lorawan_types.h"
 
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+namespace mbed {
+class LowPowerTimeout;
+}
+#endif
+
 /*!
  * \brief Timer time variable definition
  */
@@ -1054,6 +1060,12 @@ typedef struct {
 typedef struct {
     mbed::Callback<void()> callback;
     int timer_id;
+#if MBED_CONF_LORA_PRECISE_RX_TIMING
+    /*!
+     * Low power ticker timeout of a precise timer, NULL for the others
+     */
+    mbed::LowPowerTimeout *precise_timeout;
+#endif
 } timer_event_t;
 
 /*!
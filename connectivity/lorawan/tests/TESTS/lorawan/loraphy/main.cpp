@@ -0,0 +1,137 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Cost of the channel selection of the regional PHYs.
+ *
+ * Every case selects channels at the default datarate of a region, from
+ * its default channel mask and with the duty cycle off so each call succeeds,
+ * checks the channels selected support the datarate and prints the time
+ * taken per selection. No radio is needed, hence AS923 and KR920, which
+ * listen before talk on the selected channel, are left out.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "LoRaPHYAU915.h"
+#include "LoRaPHYCN470.h"
+#include "LoRaPHYEU868.h"
+#include "LoRaPHYIN865.h"
+#include "LoRaPHYUS915.h"
+
+using namespace utest::v1;
+
+#define SELECTIONS  1000
+
+static EventQueue queue;
+static LoRaWANTimeHandler lora_time;
+
+template <class PHY>
+class phy_access : public PHY {
+public:
+    loraphy_params_t &get_phy_params()
+    {
+        return this->phy_params;
+    }
+};
+
+template <class PHY>
+static void test_channel_selection(const char *region)
+{
+    phy_access<PHY> phy;
+    phy.initialize(&lora_time);
+
+    channel_selection_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.current_datarate = phy.get_default_tx_datarate();
+    params.joined = true;
+    params.dc_enabled = false;
+
+    uint8_t channel;
+    lorawan_time_t time;
+    lorawan_time_t aggregate_timeoff;
+    int failures = 0;
+
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < SELECTIONS; i++) {
+        if (phy.set_next_channel(&params, &channel, &time, &aggregate_timeoff) != LORAWAN_STATUS_OK) {
+            failures++;
+        }
+    }
+    timer.stop();
+
+    const channel_params_t &selected = phy.get_phy_params().channels.channel_list[channel];
+    TEST_ASSERT_EQUAL(0, failures);
+    TEST_ASSERT_TRUE(selected.dr_range.fields.min <= params.current_datarate);
+    TEST_ASSERT_TRUE(selected.dr_range.fields.max >= params.current_datarate);
+
+    printf("%s: %lu ns per selection at DR%u\r\n", region,
+           (unsigned long)(timer.elapsed_time().count() * 1000 / SELECTIONS),
+           params.current_datarate);
+}
+
+static void test_eu868()
+{
+    test_channel_selection<LoRaPHYEU868>("EU868");
+}
+
+static void test_in865()
+{
+    test_channel_selection<LoRaPHYIN865>("IN865");
+}
+
+static void test_us915()
+{
+    test_channel_selection<LoRaPHYUS915>("US915");
+}
+
+static void test_au915()
+{
+    test_channel_selection<LoRaPHYAU915>("AU915");
+}
+
+static void test_cn470()
+{
+    test_channel_selection<LoRaPHYCN470>("CN470");
+}
+
+Case cases[] = {
+    Case("LoRaPHY: EU868 channel selection", test_eu868, greentea_failure_handler),
+    Case("LoRaPHY: IN865 channel selection", test_in865, greentea_failure_handler),
+    Case("LoRaPHY: US915 channel selection", test_us915, greentea_failure_handler),
+    Case("LoRaPHY: AU915 channel selection", test_au915, greentea_failure_handler),
+    Case("LoRaPHY: CN470 channel selection", test_cn470, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    lora_time.activate_timer_subsystem(&queue);
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
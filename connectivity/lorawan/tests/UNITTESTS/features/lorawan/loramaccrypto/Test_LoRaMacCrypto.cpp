@@ -96,7 +96,8 @@ TEST_F(Test_LoRaMacCrypto, encrypt_payload)
     uint8_t enc[60];
     EXPECT_TRUE(-2 == object->encrypt_payload(buf, 20, NULL, 0, 0, 0, 0, enc));
 
-    aes_stub.int_zero_counter = 2;
+    // The key is already set up, only the blocks are encrypted
+    aes_stub.int_zero_counter = 1;
     aes_stub.int_value = -3;
     EXPECT_TRUE(-3 == object->encrypt_payload(buf, 20, NULL, 0, 0, 0, 0, enc));
 
@@ -109,6 +110,38 @@ TEST_F(Test_LoRaMacCrypto, encrypt_payload)
     EXPECT_TRUE(0 == object->encrypt_payload(NULL, 0, NULL, 0, 0, 0, 0, NULL));
 }
 
+TEST_F(Test_LoRaMacCrypto, encrypt_payload_key_cache)
+{
+    uint8_t key_a[16] = {1};
+    uint8_t key_b[16] = {2};
+    uint8_t key_c[16] = {3};
+    uint8_t buf[16];
+    uint8_t enc[16];
+
+    aes_stub.int_value = -1;
+
+    // Key setup and one block
+    aes_stub.int_zero_counter = 2;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_a, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_a, 128, 0, 0, 0, enc));
+
+    aes_stub.int_zero_counter = 2;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_b, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_a, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_b, 128, 0, 0, 0, enc));
+
+    // A third key replaces the first one set up
+    aes_stub.int_zero_counter = 2;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_c, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 16, key_b, 128, 0, 0, 0, enc));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(-1 == object->encrypt_payload(buf, 16, key_a, 128, 0, 0, 0, enc));
+}
+
 TEST_F(Test_LoRaMacCrypto, decrypt_payload)
 {
     EXPECT_TRUE(0 == object->decrypt_payload(NULL, 0, NULL, 0, 0, 0, 0, NULL));
@@ -35,6 +35,12 @@ public:
     {
         return phy_params;
     }
+
+    uint8_t get_enabled_channel_count(uint8_t datarate, const uint16_t *mask,
+                                      uint8_t *channels, uint8_t *delay_tx)
+    {
+        return enabled_channel_count(datarate, mask, channels, delay_tx);
+    }
 };
 
 class my_radio : public LoRaRadio {
@@ -713,6 +719,53 @@ TEST_F(Test_LoRaPHY, set_next_channel)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->set_next_channel(&p, &ch, &t1, &t2));
 }
 
+TEST_F(Test_LoRaPHY, enabled_channel_count)
+{
+    band_t b[2];
+    memset(b, 0, sizeof(b));
+    b[1].off_time = 1000;
+    object->get_phy_params().bands.size = 2;
+    object->get_phy_params().bands.table = b;
+
+    channel_params_t l[20];
+    memset(l, 0, sizeof(l));
+    for (int i = 0; i < 20; i++) {
+        l[i].dr_range.value = (DR_5 << 4) | DR_0;
+    }
+    l[17].dr_range.value = (DR_2 << 4) | DR_0;
+    l[18].band = 1;
+    object->get_phy_params().channels.channel_list = l;
+    object->get_phy_params().max_channel_cnt = 20;
+
+    uint16_t mask[2] = {0x0001, 0x0006};
+    uint16_t default_mask[2] = {0, 0};
+    object->get_phy_params().channels.mask = mask;
+    object->get_phy_params().channels.default_mask = default_mask;
+    object->get_phy_params().channels.mask_size = 2;
+
+    uint8_t channels[20];
+    uint8_t delay_tx;
+    EXPECT_EQ(2, object->get_enabled_channel_count(DR_0, mask, channels, &delay_tx));
+    EXPECT_EQ(0, channels[0]);
+    EXPECT_EQ(17, channels[1]);
+    EXPECT_EQ(1, delay_tx);
+
+    EXPECT_EQ(1, object->get_enabled_channel_count(DR_3, mask, channels, &delay_tx));
+    EXPECT_EQ(0, channels[0]);
+    EXPECT_EQ(1, delay_tx);
+
+    // The channel plan changed: channel 0 no longer supports DR_3
+    EXPECT_TRUE(object->remove_channel(0));
+    mask[0] = 0x0001;
+    EXPECT_EQ(0, object->get_enabled_channel_count(DR_3, mask, channels, &delay_tx));
+    EXPECT_EQ(1, delay_tx);
+
+    mask[0] = 0;
+    mask[1] = 0;
+    EXPECT_EQ(0, object->get_enabled_channel_count(DR_0, mask, channels, &delay_tx));
+    EXPECT_EQ(0, delay_tx);
+}
+
 TEST_F(Test_LoRaPHY, add_channel)
 {
     uint16_t list[16];
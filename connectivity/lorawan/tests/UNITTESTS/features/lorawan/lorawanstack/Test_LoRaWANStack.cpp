@@ -729,6 +729,57 @@ TEST_F(Test_LoRaWANStack, stop_sending)
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->stop_sending());
 }
 
+TEST_F(Test_LoRaWANStack, queue_tx)
+{
+    uint8_t data[20] = {0};
+    uint8_t count;
+    int send_time;
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->queue_tx(1, data, 4, 0x01, false));
+    EXPECT_TRUE(LORAWAN_STATUS_NOT_INITIALIZED == object->acquire_uplink_queue_metadata(count, send_time));
+
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->queue_tx(1, NULL, 4, 0x01, false));
+    EXPECT_TRUE(LORAWAN_STATUS_NO_ACTIVE_SESSIONS == object->queue_tx(1, data, 4, 0x01, false));
+
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    lorawan_connect_t conn;
+    conn.connect_type = LORAWAN_CONNECTION_ABP;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->connect(conn));
+
+    // Messages stay queued: the stub queue does not dispatch the sending
+    equeue_stub.call_cb_immediately = false;
+    EXPECT_TRUE(LORAWAN_STATUS_PORT_INVALID == object->queue_tx(0, data, 4, 0x01, false));
+    EXPECT_TRUE(LORAWAN_STATUS_PARAMETER_INVALID == object->queue_tx(1, data, 4, 0x04, false));
+
+    LoRaMac_stub::uint8_value = 10;
+    EXPECT_TRUE(LORAWAN_STATUS_LENGTH_ERROR == object->queue_tx(1, data, 11, 0x01, false));
+
+    // Aggregated while they fit a frame, for the same port and flags
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->queue_tx(1, data, 4, 0x01, true));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->queue_tx(1, data, 4, 0x01, true));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_uplink_queue_metadata(count, send_time));
+    EXPECT_EQ(1, count);
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->queue_tx(1, data, 4, 0x01, true));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->queue_tx(2, data, 4, 0x01, true));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->queue_tx(2, data, 4, 0x01, false));
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_uplink_queue_metadata(count, send_time));
+    EXPECT_EQ(4, count);
+
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->queue_tx(2, data, 4, 0x01, false));
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->queue_tx(2, data, 4, 0x01, true));
+
+    // Shutdown drops the messages queued
+    EXPECT_TRUE(LORAWAN_STATUS_DEVICE_OFF == object->shutdown());
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->acquire_uplink_queue_metadata(count, send_time));
+    EXPECT_EQ(0, count);
+    EXPECT_EQ(-1, send_time);
+
+    LoRaMac_stub::uint8_value = 1;
+}
+
 TEST_F(Test_LoRaWANStack, lock)
 {
     object->lock();
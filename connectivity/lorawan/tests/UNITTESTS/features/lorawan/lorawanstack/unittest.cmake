@@ -49,5 +49,6 @@ set(unittest-test-flags
   -DMBED_CONF_LORA_OVER_THE_AIR_ACTIVATION=true
   -DMBED_CONF_LORA_AUTOMATIC_UPLINK_MESSAGE=true
   -DMBED_CONF_LORA_TX_MAX_SIZE=255
+  -DMBED_CONF_LORA_UPLINK_QUEUE_SIZE=4
 )
 
@@ -18,6 +18,21 @@
 
 #include "EMACMemoryManager.h"
 
+/** Memory statistics of LWIPMemoryManager
+ *
+ *  Allocation counts cover the buffers allocated through the memory manager,
+ *  that is by the drivers. Usage of the pool covers lwIP as a whole.
+ */
+typedef struct {
+    uint32_t pool_current_size;         /**< Number of pool buffers in use */
+    uint32_t pool_max_size;             /**< Maximum number of pool buffers in use, sampled on allocation */
+    uint32_t pool_total_size;           /**< Number of buffers in the pool */
+    uint32_t pool_alloc_cnt;            /**< Number of pool allocations */
+    uint32_t pool_alloc_fail_cnt;       /**< Number of pool allocations the pool could not serve */
+    uint32_t pool_heap_fallback_cnt;    /**< Number of those served from the heap instead */
+    uint32_t heap_alloc_cnt;            /**< Number of heap allocations */
+    uint32_t heap_alloc_fail_cnt;       /**< Number of failed heap allocations */
+} lwip_memory_stats_t;
 
 class LWIPMemoryManager final : public EMACMemoryManager {
 public:
@@ -40,6 +55,9 @@ public:
      * (aligned) allocation unit, otherwise may be chained. Will typically come from
      * fixed-size packet pool memory.
      *
+     * If the lwip.pbuf-pool-heap-fallback configuration is enabled and the pool
+     * runs dry, a contiguous buffer is allocated from the heap instead.
+     *
      * @param  size    Total size of the memory to allocate in bytes
      * @param  align   Memory alignment requirement for each buffer in bytes
      * @return         Allocated memory buffer chain, or NULL in case of error
@@ -161,8 +179,24 @@ public:
      */
     void set_len(net_stack_mem_buf_t *buf, uint32_t len) override;
 
+    /**
+     * Get the memory statistics
+     *
+     * @param stats    Structure to fill in
+     */
+    void get_stats(lwip_memory_stats_t *stats);
+
 private:
 
+    /**
+     * Returns the number of free buffers in the pool
+     *
+     * Also updates the maximum number of pool buffers in use.
+     *
+     * @return         Number of free buffers
+     */
+    uint32_t update_pool_usage();
+
     /**
      * Returns a total memory alignment size
      *
@@ -196,6 +230,13 @@ private:
      * @param pbuf     Memory buffer
      */
     void set_total_len(struct pbuf *pbuf);
+
+    uint32_t _pool_max_size = 0;
+    uint32_t _pool_alloc_cnt = 0;
+    uint32_t _pool_alloc_fail_cnt = 0;
+    uint32_t _pool_heap_fallback_cnt = 0;
+    uint32_t _heap_alloc_cnt = 0;
+    uint32_t _heap_alloc_fail_cnt = 0;
 };
 
 #endif /* LWIP_MEMORY_MANAGER_H */
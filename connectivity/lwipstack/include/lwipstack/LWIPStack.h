@@ -166,6 +166,8 @@ public:
 #if LWIP_ETHERNET
         static err_t emac_low_level_output(struct netif *netif, struct pbuf *p);
         void emac_input(net_stack_mem_buf_t *buf);
+        void emac_input_batch(net_stack_mem_buf_t **bufs, uint32_t count);
+        static void emac_input_batch_handle(void *ptr);
         void emac_state_change(bool up);
 #if LWIP_IGMP
         static err_t emac_igmp_mac_filter(struct netif *netif, const ip4_addr_t *group, enum netif_mac_filter_action action);
@@ -350,6 +352,12 @@ public:
       */
     void set_default_interface(OnboardNetworkStack::Interface *interface) override;
 
+    /** Get the memory statistics of the packet buffers
+     *
+     *  @param stats    Structure to fill in
+     */
+    void get_memory_stats(lwip_memory_stats_t *stats);
+
 protected:
     LWIP();
 
@@ -502,6 +510,61 @@ protected:
     nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                           void *buffer, nsapi_size_t size) override;
 
+    /** Send a scatter-gather list over a socket
+     *
+     *  TCP data is written in one call from up to 8 buffers. A UDP datagram
+     *  is sent from the buffers by reference, without assembly.
+     *
+     *  @copydetails NetworkStack::socket_sendmsg
+     */
+    nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                         const nsapi_iovec_t *iov, unsigned iovcnt) override;
+
+    /** @copydoc NetworkStack::socket_recvmsg
+     */
+    nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                         const nsapi_iovec_t *iov, unsigned iovcnt) override;
+
+    /** Send a batch of datagrams over a UDP socket
+     *
+     *  One netbuf refers to each datagram in turn.
+     *
+     *  @copydetails NetworkStack::socket_sendmmsg
+     */
+    nsapi_size_or_error_t socket_sendmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count) override;
+
+    /** @copydoc NetworkStack::socket_recvmmsg
+     */
+    nsapi_size_or_error_t socket_recvmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count) override;
+
+    /** @copydoc NetworkStack::get_memory_manager
+     */
+    NetStackMemoryManager *get_memory_manager() override;
+
+    /** Send data of a memory buffer chain over a TCP socket
+     *
+     *  The data is copied by lwIP to the send queue of the connection, as
+     *  it is kept until acknowledged.
+     *
+     *  @copydetails NetworkStack::socket_send_buf
+     */
+    nsapi_size_or_error_t socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf,
+                                          nsapi_size_t offset) override;
+
+    /** @copydoc NetworkStack::socket_recv_buf
+     */
+    nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf) override;
+
+    /** @copydoc NetworkStack::socket_sendto_buf
+     */
+    nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                            net_stack_mem_buf_t *buf) override;
+
+    /** @copydoc NetworkStack::socket_recvfrom_buf
+     */
+    nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                              net_stack_mem_buf_t **buf) override;
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -595,6 +658,10 @@ private:
         nsapi_ip_mreq_t *multicast_memberships;
         uint32_t         multicast_memberships_count;
         uint32_t         multicast_memberships_registry;
+
+        // Send buffer size set by NSAPI_SNDBUF or autotuning, 0 for TCP_SND_BUF
+        u32_t snd_buf_size;
+        bool snd_buf_autotune;
     };
 
     struct lwip_callback {
@@ -603,6 +670,7 @@ private:
     };
 
     static nsapi_error_t err_remap(err_t err);
+    nsapi_error_t sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address, struct netbuf *buf);
     static bool is_local_addr(const ip_addr_t *ip_addr);
     static const ip_addr_t *get_ip_addr(bool any_addr, const struct netif *netif);
     static const ip_addr_t *get_ipv4_addr(const struct netif *netif);
@@ -646,6 +714,12 @@ private:
 
     static void socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len);
 
+#if LWIP_TCP
+    u32_t set_tcp_snd_buf(struct mbed_lwip_socket *s, u32_t size);
+    void autotune_tcp_snd_buf(struct mbed_lwip_socket *s);
+    void release_tcp_snd_buf(struct mbed_lwip_socket *s);
+#endif
+
     static void tcpip_init_irq(void *handle);
     static void tcpip_thread_callback(void *ptr);
 
@@ -656,6 +730,8 @@ private:
     rtos::Mutex adaptation;
     rtos::EventFlags _event_flag;
     static const int TCP_CLOSED_FLAG = 0x4u;
+    // Bytes the send buffers have grown beyond TCP_SND_BUF, out of tcp-snd-buf-budget
+    u32_t tcp_snd_buf_granted = 0;
 };
 
 #endif /* LWIPSTACK_H_ */
@@ -317,8 +317,8 @@
 #define LWIP_ARP                    0
 #endif
 
-// Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
-#define LWIP_CHECKSUM_ON_COPY       0
+// Checksum-on-copy disabled by default due to https://savannah.nongnu.org/bugs/?50914
+#define LWIP_CHECKSUM_ON_COPY       MBED_CONF_LWIP_CHECKSUM_ON_COPY
 
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
@@ -71,16 +71,23 @@ extern "C" {
     #define ALIGNED(n)  __attribute__((aligned (n)))
 #endif
 
-/* Provide Thumb-2 routines for GCC to improve performance */
-#if defined(TOOLCHAIN_GCC) && defined(__thumb2__)
+/* Provide Thumb-2 routines to improve performance */
+#if defined(__thumb2__) || (defined(__ARM_ARCH_ISA_THUMB) && (__ARM_ARCH_ISA_THUMB >= 2))
+    #if defined(TOOLCHAIN_GCC)
     #define MEMCPY(dst,src,len)     thumb2_memcpy(dst,src,len)
+
+    void* thumb2_memcpy(void* pDest, const void* pSource, size_t length);
+    #endif
+
     #define LWIP_CHKSUM             thumb2_checksum
     /* Set algorithm to 0 so that unused lwip_standard_chksum function
        doesn't generate compiler warning */
     #define LWIP_CHKSUM_ALGORITHM   0
+    /* Used on the TCP send path if LWIP_CHECKSUM_ON_COPY is enabled */
+    #define LWIP_CHKSUM_COPY(dst,src,len) thumb2_checksum_copy(dst,src,len)
 
-    void* thumb2_memcpy(void* pDest, const void* pSource, size_t length);
     uint16_t thumb2_checksum(const void* pData, int length);
+    uint16_t thumb2_checksum_copy(void* pDest, const void* pSource, int length);
 #else
     /* Used with IP headers only */
     #define LWIP_CHKSUM_ALGORITHM   1
@@ -23,9 +23,16 @@
 #include "netsocket/EMAC.h"
 
 #include "LWIPStack.h"
+#include <stdlib.h>
 
 #if LWIP_ETHERNET
 
+struct emac_rx_batch {
+    struct netif *netif;
+    uint32_t count;
+    struct pbuf *bufs[1];
+};
+
 err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p)
 {
     /* Increase reference counter since lwip stores handle to pbuf and frees
@@ -49,6 +56,43 @@ void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
     }
 }
 
+void LWIP::Interface::emac_input_batch(emac_mem_buf_t **bufs, uint32_t count)
+{
+    /* one message to the tcpip thread for the whole batch, instead of one per packet */
+    struct emac_rx_batch *batch = static_cast<struct emac_rx_batch *>(malloc(sizeof(struct emac_rx_batch) + (count - 1) * sizeof(struct pbuf *)));
+    if (batch) {
+        batch->netif = &netif;
+        batch->count = count;
+        for (uint32_t i = 0; i < count; i++) {
+            batch->bufs[i] = static_cast<struct pbuf *>(bufs[i]);
+        }
+        if (tcpip_callback_with_block(&LWIP::Interface::emac_input_batch_handle, batch, 1) == ERR_OK) {
+            return;
+        }
+        ::free(batch);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        emac_input(bufs[i]);
+    }
+}
+
+void LWIP::Interface::emac_input_batch_handle(void *ptr)
+{
+    struct emac_rx_batch *batch = static_cast<struct emac_rx_batch *>(ptr);
+
+    /* in the tcpip thread, what tcpip_input() does for an ethernet netif */
+    for (uint32_t i = 0; i < batch->count; i++) {
+        if (ethernet_input(batch->bufs[i], batch->netif) != ERR_OK) {
+            LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
+
+            pbuf_free(batch->bufs[i]);
+        }
+    }
+
+    ::free(batch);
+}
+
 void LWIP::Interface::emac_state_change(bool up)
 {
     if (up) {
@@ -139,6 +183,9 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     mbed_if->emac->set_memory_manager(*mbed_if->memory_manager);
     mbed_if->emac->set_link_input_cb(mbed::callback(mbed_if, &LWIP::Interface::emac_input));
+#if MBED_CONF_NSAPI_EMAC_RX_BUDGET > 0
+    mbed_if->emac->set_link_input_batch_cb(mbed::callback(mbed_if, &LWIP::Interface::emac_input_batch), MBED_CONF_NSAPI_EMAC_RX_BUDGET);
+#endif
     mbed_if->emac->set_link_state_cb(mbed::callback(mbed_if, &LWIP::Interface::emac_state_change));
 
     /* Interface capabilities */
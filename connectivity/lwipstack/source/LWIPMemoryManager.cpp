@@ -15,14 +15,20 @@
 
 #include "pbuf.h"
 #include "LWIPMemoryManager.h"
+#include "lwip/memp.h"
+#include "lwip/priv/memp_priv.h"
+#include "lwip/sys.h"
+#include "platform/mbed_atomic.h"
 
 net_stack_mem_buf_t *LWIPMemoryManager::alloc_heap(uint32_t size, uint32_t align)
 {
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_RAM);
     if (pbuf == NULL) {
+        core_util_atomic_incr_u32(&_heap_alloc_fail_cnt, 1);
         return NULL;
     }
 
+    core_util_atomic_incr_u32(&_heap_alloc_cnt, 1);
     align_memory(pbuf, align);
 
     return static_cast<net_stack_mem_buf_t *>(pbuf);
@@ -33,8 +39,21 @@ net_stack_mem_buf_t *LWIPMemoryManager::alloc_pool(uint32_t size, uint32_t align
     uint32_t total_align = count_total_align(size, align);
 
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + total_align, PBUF_POOL);
+    update_pool_usage();
     if (pbuf == NULL) {
+        core_util_atomic_incr_u32(&_pool_alloc_fail_cnt, 1);
+#if MBED_CONF_LWIP_PBUF_POOL_HEAP_FALLBACK
+        // Borrows from the heap on bursts, rather than dropping the packet
+        pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_RAM);
+        if (pbuf == NULL) {
+            return NULL;
+        }
+        core_util_atomic_incr_u32(&_pool_heap_fallback_cnt, 1);
+#else
         return NULL;
+#endif
+    } else {
+        core_util_atomic_incr_u32(&_pool_alloc_cnt, 1);
     }
 
     align_memory(pbuf, align);
@@ -104,6 +123,42 @@ void LWIPMemoryManager::set_len(net_stack_mem_buf_t *buf, uint32_t len)
     set_total_len(pbuf);
 }
 
+void LWIPMemoryManager::get_stats(lwip_memory_stats_t *stats)
+{
+    uint32_t free_count = update_pool_usage();
+
+    stats->pool_total_size = PBUF_POOL_SIZE;
+    stats->pool_current_size = PBUF_POOL_SIZE - free_count;
+    stats->pool_max_size = core_util_atomic_load_u32(&_pool_max_size);
+    stats->pool_alloc_cnt = core_util_atomic_load_u32(&_pool_alloc_cnt);
+    stats->pool_alloc_fail_cnt = core_util_atomic_load_u32(&_pool_alloc_fail_cnt);
+    stats->pool_heap_fallback_cnt = core_util_atomic_load_u32(&_pool_heap_fallback_cnt);
+    stats->heap_alloc_cnt = core_util_atomic_load_u32(&_heap_alloc_cnt);
+    stats->heap_alloc_fail_cnt = core_util_atomic_load_u32(&_heap_alloc_fail_cnt);
+}
+
+uint32_t LWIPMemoryManager::update_pool_usage()
+{
+#if MEMP_MEM_MALLOC
+    // Pool buffers come from the heap, there is no pool to count
+    return PBUF_POOL_SIZE;
+#else
+    uint32_t free_count = 0;
+
+    SYS_ARCH_DECL_PROTECT(old_level);
+    SYS_ARCH_PROTECT(old_level);
+    for (struct memp *elem = *memp_pools[MEMP_PBUF_POOL]->tab; elem; elem = elem->next) {
+        free_count++;
+    }
+    if (PBUF_POOL_SIZE - free_count > _pool_max_size) {
+        _pool_max_size = PBUF_POOL_SIZE - free_count;
+    }
+    SYS_ARCH_UNPROTECT(old_level);
+
+    return free_count;
+#endif
+}
+
 uint32_t LWIPMemoryManager::count_total_align(uint32_t size, uint32_t align)
 {
     uint32_t buffers = size / get_pool_alloc_unit(align);
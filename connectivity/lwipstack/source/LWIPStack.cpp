@@ -334,6 +334,10 @@ nsapi_error_t LWIP::socket_listen(nsapi_socket_t handle, int backlog)
     }
 
     err_t err = netconn_listen_with_backlog(s->conn, backlog);
+    if (err == ERR_OK) {
+        // the listening pcb has no send buffer, accepted ones start at TCP_SND_BUF
+        release_tcp_snd_buf(s);
+    }
     return err_remap(err);
 #else
     return NSAPI_ERROR_UNSUPPORTED;
@@ -377,6 +381,7 @@ nsapi_error_t LWIP::socket_accept(nsapi_socket_t server, nsapi_socket_t *handle,
     }
 
     netconn_set_nonblocking(ns->conn, true);
+    ns->snd_buf_autotune = s->snd_buf_autotune;
     *(struct mbed_lwip_socket **)handle = ns;
 
     ip_addr_t peer_addr;
@@ -401,6 +406,12 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     size_t bytes_written = 0;
 
+#if LWIP_TCP
+    if (s->snd_buf_autotune) {
+        autotune_tcp_snd_buf(s);
+    }
+#endif
+
     err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
     if (err != ERR_OK) {
         return err_remap(err);
@@ -437,9 +448,8 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
 #endif
 }
 
-nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+nsapi_error_t LWIP::sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address, struct netbuf *buf)
 {
-    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     ip_addr_t ip_addr;
 
     nsapi_addr_t addr = address.get_addr();
@@ -456,6 +466,18 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
             return NSAPI_ERROR_PARAMETER;
         }
     }
+
+    err_t err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     struct netbuf *buf = netbuf_new();
 
     err_t err = netbuf_ref(buf, data, (u16_t)size);
@@ -464,10 +486,10 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
         return err_remap(err);
     }
 
-    err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    nsapi_error_t ret = sendto_netbuf(s, address, buf);
     netbuf_delete(buf);
-    if (err != ERR_OK) {
-        return err_remap(err);
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
     }
 
     return size;
@@ -496,6 +518,319 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                           const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        struct netvector vectors[8];
+        u16_t count = 0;
+        size_t bytes_written = 0;
+
+        for (; count < iovcnt && count < 8; count++) {
+            vectors[count].ptr = iov[count].iov_base;
+            vectors[count].len = iov[count].iov_len;
+        }
+
+        err_t err = netconn_write_vectors_partly(s->conn, vectors, count, NETCONN_COPY, &bytes_written);
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+
+        return (nsapi_size_or_error_t)bytes_written;
+    }
+
+    if (!address) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+
+    // The buffers are chained by reference, as socket_sendto does for one
+    nsapi_size_t size = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
+    if (size > 0xFFFF) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    err_t err = netbuf_ref(buf, iovcnt ? iov[0].iov_base : NULL, iovcnt ? (u16_t)iov[0].iov_len : 0);
+    for (unsigned i = 1; err == ERR_OK && i < iovcnt; i++) {
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+        if (!p) {
+            err = ERR_MEM;
+            break;
+        }
+        p->payload = iov[i].iov_base;
+        p->len = p->tot_len = (u16_t)iov[i].iov_len;
+        pbuf_cat(buf->p, p);
+    }
+    if (err != ERR_OK) {
+        netbuf_delete(buf);
+        return err_remap(err);
+    }
+
+    nsapi_error_t ret = sendto_netbuf(s, *address, buf);
+    netbuf_delete(buf);
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                           const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    nsapi_size_t recv = 0;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+#if LWIP_TCP
+        if (!s->buf) {
+            err_t err = netconn_recv_tcp_pbuf(s->conn, &s->buf);
+            s->offset = 0;
+
+            if (err != ERR_OK) {
+                return err_remap(err);
+            }
+        }
+
+        // Only from the pbuf chain at hand, like socket_recv
+        for (unsigned i = 0; i < iovcnt && s->offset < s->buf->tot_len; i++) {
+            u16_t len = iov[i].iov_len > 0xFFFF ? 0xFFFF : (u16_t)iov[i].iov_len;
+            u16_t copied = pbuf_copy_partial(s->buf, iov[i].iov_base, len, s->offset);
+            s->offset += copied;
+            recv += copied;
+        }
+
+        if (s->offset >= s->buf->tot_len) {
+            pbuf_free(s->buf);
+            s->buf = 0;
+        }
+
+        return recv;
+#else
+        return NSAPI_ERROR_UNSUPPORTED;
+#endif
+    }
+
+    struct netbuf *buf;
+
+    err_t err = netconn_recv(s->conn, &buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(buf));
+    }
+
+    // The rest of a datagram larger than the buffers is dropped, like socket_recvfrom
+    for (unsigned i = 0; i < iovcnt && recv < buf->p->tot_len; i++) {
+        u16_t len = iov[i].iov_len > 0xFFFF ? 0xFFFF : (u16_t)iov[i].iov_len;
+        recv += pbuf_copy_partial(buf->p, iov[i].iov_base, len, (u16_t)recv);
+    }
+    netbuf_delete(buf);
+
+    return recv;
+}
+
+nsapi_size_or_error_t LWIP::socket_sendmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+    unsigned i = 0;
+    for (; i < count; i++) {
+        err_t err = netbuf_ref(buf, msgs[i].data, (u16_t)msgs[i].size);
+        if (err != ERR_OK) {
+            ret = err_remap(err);
+            break;
+        }
+
+        ret = sendto_netbuf(s, msgs[i].address, buf);
+        if (ret != NSAPI_ERROR_OK) {
+            break;
+        }
+        msgs[i].length = msgs[i].size;
+    }
+    netbuf_delete(buf);
+
+    if (!i && ret != NSAPI_ERROR_OK) {
+        return ret;
+    }
+    return i;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    // The socket is non-blocking, so this drains the datagrams pending
+    unsigned i = 0;
+    for (; i < count; i++) {
+        struct netbuf *buf;
+
+        err_t err = netconn_recv(s->conn, &buf);
+        if (err != ERR_OK) {
+            if (!i) {
+                return err_remap(err);
+            }
+            break;
+        }
+
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        msgs[i].address.set_addr(addr);
+        msgs[i].address.set_port(netbuf_fromport(buf));
+        msgs[i].length = netbuf_copy(buf, msgs[i].data, (u16_t)msgs[i].size);
+        netbuf_delete(buf);
+    }
+
+    return i;
+}
+
+NetStackMemoryManager *LWIP::get_memory_manager()
+{
+    return &memory_manager;
+}
+
+void LWIP::get_memory_stats(lwip_memory_stats_t *stats)
+{
+    memory_manager.get_stats(stats);
+}
+
+nsapi_size_or_error_t LWIP::socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf, nsapi_size_t offset)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netvector vectors[8];
+    u16_t count = 0;
+    size_t bytes_written = 0;
+
+    // Written from the pbufs of the chain in one call, as many as fit the vectors
+    for (struct pbuf *p = static_cast<struct pbuf *>(buf); p && count < 8; p = p->next) {
+        if (offset >= p->len) {
+            offset -= p->len;
+            continue;
+        }
+        vectors[count].ptr = static_cast<u8_t *>(p->payload) + offset;
+        vectors[count].len = p->len - offset;
+        offset = 0;
+        count++;
+    }
+    if (!count) {
+        return 0;
+    }
+
+    err_t err = netconn_write_vectors_partly(s->conn, vectors, count, NETCONN_COPY, &bytes_written);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return (nsapi_size_or_error_t)bytes_written;
+}
+
+nsapi_size_or_error_t LWIP::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+#if LWIP_TCP
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf) {
+        err_t err = netconn_recv_tcp_pbuf(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    // Hand over what socket_recv hasn't consumed yet
+    struct pbuf *p = s->buf;
+    if (s->offset) {
+        p = pbuf_free_header(p, s->offset);
+    }
+    s->buf = 0;
+    s->offset = 0;
+
+    *buf = p;
+    return p->tot_len;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct pbuf *p = static_cast<struct pbuf *>(buf);
+    nsapi_size_t size = p->tot_len;
+
+    struct netbuf *nbuf = netbuf_new();
+    if (!nbuf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    nbuf->p = nbuf->ptr = p;
+
+    nsapi_error_t ret = sendto_netbuf(s, address, nbuf);
+    if (ret != NSAPI_ERROR_OK) {
+        // The caller keeps the chain
+        nbuf->p = nbuf->ptr = NULL;
+        netbuf_delete(nbuf);
+        return ret;
+    }
+
+    // Drops the reference of the caller, lwIP keeps its own while the packet is queued
+    netbuf_delete(nbuf);
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address, net_stack_mem_buf_t **buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netbuf *nbuf;
+
+    err_t err = netconn_recv(s->conn, &nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(nbuf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(nbuf));
+    }
+
+    struct pbuf *p = nbuf->p;
+    nbuf->p = nbuf->ptr = NULL;
+    netbuf_delete(nbuf);
+
+    *buf = p;
+    return p->tot_len;
+}
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr)
 {
     uint32_t count = 0;
@@ -552,6 +887,49 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int *)optval;
             return 0;
+
+        case NSAPI_SNDBUF:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval <= 0) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            LOCK_TCPIP_CORE();
+            set_tcp_snd_buf(s, *(int *)optval);
+            UNLOCK_TCPIP_CORE();
+            return 0;
+
+        case NSAPI_SNDBUF_AUTOTUNE:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            s->snd_buf_autotune = *(int *)optval;
+            return 0;
+
+        case NSAPI_TCP_NODELAY: {
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            nsapi_error_t ret = NSAPI_ERROR_OK;
+            LOCK_TCPIP_CORE();
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            if (!pcb) {
+                ret = NSAPI_ERROR_NO_CONNECTION;
+            } else if (pcb->state == LISTEN) {
+                ret = NSAPI_ERROR_UNSUPPORTED;
+            } else if (*(int *)optval) {
+                tcp_nagle_disable(pcb);
+            } else {
+                tcp_nagle_enable(pcb);
+            }
+            UNLOCK_TCPIP_CORE();
+            return ret;
+        }
 #endif
 
         case NSAPI_REUSEADDR:
@@ -671,8 +1049,95 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
+#if LWIP_TCP
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    switch (optname) {
+        case NSAPI_SNDBUF:
+            *(int *)optval = s->snd_buf_size ? s->snd_buf_size : TCP_SND_BUF;
+            break;
+
+        case NSAPI_SNDBUF_AUTOTUNE:
+            *(int *)optval = s->snd_buf_autotune;
+            break;
+
+        case NSAPI_TCP_NODELAY:
+            LOCK_TCPIP_CORE();
+            if (!s->conn->pcb.tcp || s->conn->pcb.tcp->state == LISTEN) {
+                UNLOCK_TCPIP_CORE();
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+            *(int *)optval = tcp_nagle_disabled(s->conn->pcb.tcp) ? 1 : 0;
+            UNLOCK_TCPIP_CORE();
+            break;
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    *optlen = sizeof(int);
+    return 0;
+#else
     return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+#if LWIP_TCP
+/* The send queue holds at most TCP_SND_QUEUELEN segments */
+#define LWIP_TCP_SND_BUF_MAX LWIP_MIN((u32_t)TCP_SND_QUEUELEN / 2 * TCP_MSS, (u32_t)(tcpwnd_size_t)~0)
+
+/* Must be called with the core locked, returns the size set */
+u32_t LWIP::set_tcp_snd_buf(struct mbed_lwip_socket *s, u32_t size)
+{
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    u32_t current = s->snd_buf_size ? s->snd_buf_size : TCP_SND_BUF;
+    if (!pcb || pcb->state == LISTEN) {
+        return current;
+    }
+
+    // grow within the budget left by the other sockets, but not below what is queued
+    u32_t granted = tcp_snd_buf_granted - (current > TCP_SND_BUF ? current - TCP_SND_BUF : 0);
+    u32_t queued = current > pcb->snd_buf ? current - pcb->snd_buf : 0;
+    size = LWIP_MIN(size, LWIP_TCP_SND_BUF_MAX);
+    size = LWIP_MIN(size, TCP_SND_BUF + MBED_CONF_LWIP_TCP_SND_BUF_BUDGET - granted);
+    size = LWIP_MAX(size, LWIP_MAX(queued, (u32_t)TCP_MSS));
+
+    pcb->snd_buf = (tcpwnd_size_t)(pcb->snd_buf + size - current);
+    tcp_snd_buf_granted = granted + (size > TCP_SND_BUF ? size - TCP_SND_BUF : 0);
+    s->snd_buf_size = size;
+    return size;
+}
+
+void LWIP::autotune_tcp_snd_buf(struct mbed_lwip_socket *s)
+{
+    LOCK_TCPIP_CORE();
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    // grow when the buffer rather than the windows limits the sender. The congestion
+    // window follows the bandwidth-delay product, and the buffer has to hold the data
+    // in flight and the next window of it to keep the path full.
+    if (pcb && pcb->state == ESTABLISHED && tcp_sndbuf(pcb) < TCP_MSS) {
+        u32_t target = 2 * (u32_t)LWIP_MIN(pcb->cwnd, pcb->snd_wnd);
+        if (target > (s->snd_buf_size ? s->snd_buf_size : TCP_SND_BUF)) {
+            set_tcp_snd_buf(s, target);
+        }
+    }
+    UNLOCK_TCPIP_CORE();
+}
+
+void LWIP::release_tcp_snd_buf(struct mbed_lwip_socket *s)
+{
+    if (s->snd_buf_size > TCP_SND_BUF) {
+        LOCK_TCPIP_CORE();
+        tcp_snd_buf_granted -= s->snd_buf_size - TCP_SND_BUF;
+        UNLOCK_TCPIP_CORE();
+    }
+    s->snd_buf_size = 0;
 }
+#endif
 
 
 void LWIP::socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *data)
@@ -219,6 +219,10 @@ void LWIP::arena_dealloc(struct mbed_lwip_socket *s)
 
     free(s->multicast_memberships);
     s->multicast_memberships = NULL;
+
+#if LWIP_TCP
+    release_tcp_snd_buf(s);
+#endif
 }
 
 bool convert_lwip_addr_to_mbed(nsapi_addr_t *out, const ip_addr_t *in)
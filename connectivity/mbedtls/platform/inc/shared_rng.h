@@ -27,10 +27,12 @@
 #include MBEDTLS_CONFIG_FILE
 #endif
 
-#if defined(MBEDTLS_SSL_CONF_RNG)
+#include <stddef.h>
 
 #define MBED_SHARED_RNG_NOT_INITIALIZED -1  /**< init_global_rng not called before global_rng */
 
+#if defined(MBEDTLS_SSL_CONF_RNG)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -90,4 +92,41 @@ mbedtls_entropy_context *get_global_entropy();
 #endif
 
 #endif // MBEDTLS_SSL_CONF_RNG
+
+#if defined(MBEDTLS_CTR_DRBG_C) && defined(MBEDTLS_ENTROPY_C)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief       Seeds the CTR_DRBG shared by the TLS sockets, on the first call
+ *
+ * \note        The DRBG reseeds from the entropy sources every
+ *              MBEDTLS_CTR_DRBG_RESEED_INTERVAL requests.
+ *
+ * \return      0 if successful, or
+ *              MBEDTLS_ERR_CTR_DRBG_ENTROPY_SOURCE_FAILED.
+ */
+int mbed_shared_ctr_drbg_init(void);
+
+/**
+ * \brief       Shared CTR_DRBG generate random, thread safe
+ *
+ * \param ctx   Unused, for use as the f_rng of Mbed TLS
+ * \param dst   Buffer to fill
+ * \param len   Length of the buffer
+ *
+ * \return      0 if successful, or
+ *              MBEDTLS_ERR_CTR_DRBG_ENTROPY_SOURCE_FAILED, or
+ *              MBEDTLS_ERR_CTR_DRBG_REQUEST_TOO_BIG or
+ *              MBED_SHARED_RNG_NOT_INITIALIZED
+ */
+int mbed_shared_ctr_drbg_random(void *ctx, unsigned char *dst, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBEDTLS_CTR_DRBG_C && MBEDTLS_ENTROPY_C
 #endif // SHARED_RNG_H
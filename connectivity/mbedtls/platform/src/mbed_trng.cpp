@@ -24,7 +24,18 @@ SingletonPtr<PlatformMutex> mbedtls_mutex;
 
 extern "C"
 int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
-#if defined(DEVICE_TRNG)
+#if defined(DEVICE_TRNG) && MBED_CONF_MBEDTLS_TRNG_KEEP_INITIALIZED
+    static trng_t trng_obj;
+    static bool trng_initialized = false;
+    mbedtls_mutex->lock();
+    if (!trng_initialized) {
+        trng_init(&trng_obj);
+        trng_initialized = true;
+    }
+    int ret = trng_get_bytes(&trng_obj, output, len, olen);
+    mbedtls_mutex->unlock();
+    return ret;
+#elif defined(DEVICE_TRNG)
     trng_t trng_obj;
     mbedtls_mutex->lock();
     trng_init(&trng_obj);
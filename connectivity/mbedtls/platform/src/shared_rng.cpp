@@ -20,12 +20,12 @@
 
 #include "shared_rng.h"
 
-#if defined(MBEDTLS_SSL_CONF_RNG)
-
 #include "mbed_trace.h"
 
 #define TRACE_GROUP "SRNG"
 
+#if defined(MBEDTLS_SSL_CONF_RNG)
+
 mbedtls_hmac_drbg_context global_hmac_drbg;
 mbedtls_entropy_context global_entropy;
 static bool is_initialized = false;
@@ -75,3 +75,57 @@ mbedtls_entropy_context *get_global_entropy()
 }
 
 #endif // MBEDTLS_SSL_CONF_RNG
+
+#if defined(MBEDTLS_CTR_DRBG_C) && defined(MBEDTLS_ENTROPY_C)
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "platform/SingletonPtr.h"
+#include "platform/PlatformMutex.h"
+
+static const char shared_ctr_drbg_pers[] = "mbed_shared_drbg";
+static mbedtls_ctr_drbg_context shared_ctr_drbg;
+static mbedtls_entropy_context shared_ctr_drbg_entropy;
+static bool shared_ctr_drbg_seeded = false;
+static SingletonPtr<PlatformMutex> shared_ctr_drbg_mutex;
+
+int mbed_shared_ctr_drbg_init(void)
+{
+    int ret = 0;
+
+    shared_ctr_drbg_mutex->lock();
+    if (!shared_ctr_drbg_seeded) {
+        mbedtls_entropy_init(&shared_ctr_drbg_entropy);
+        mbedtls_ctr_drbg_init(&shared_ctr_drbg);
+        ret = mbedtls_ctr_drbg_seed(&shared_ctr_drbg, mbedtls_entropy_func, &shared_ctr_drbg_entropy,
+                                    (const unsigned char *) shared_ctr_drbg_pers,
+                                    sizeof(shared_ctr_drbg_pers));
+        if (ret != 0) {
+            tr_error("mbed_shared_ctr_drbg_init failed! mbedtls_ctr_drbg_seed returned -0x%x", -ret);
+            mbedtls_ctr_drbg_free(&shared_ctr_drbg);
+            mbedtls_entropy_free(&shared_ctr_drbg_entropy);
+        } else {
+            shared_ctr_drbg_seeded = true;
+        }
+    }
+    shared_ctr_drbg_mutex->unlock();
+
+    return ret;
+}
+
+int mbed_shared_ctr_drbg_random(void *ctx, unsigned char *dst, size_t len)
+{
+    (void)ctx;
+    int ret = MBED_SHARED_RNG_NOT_INITIALIZED;
+
+    shared_ctr_drbg_mutex->lock();
+    if (shared_ctr_drbg_seeded) {
+        // Reseeds from the entropy sources when the interval is reached
+        ret = mbedtls_ctr_drbg_random(&shared_ctr_drbg, dst, len);
+    }
+    shared_ctr_drbg_mutex->unlock();
+
+    return ret;
+}
+
+#endif // MBEDTLS_CTR_DRBG_C && MBEDTLS_ENTROPY_C
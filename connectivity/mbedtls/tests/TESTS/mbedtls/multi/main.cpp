@@ -22,6 +22,7 @@
 #include "utest/utest.h"
 
 #include "mbedtls/sha256.h"
+#include "mbedtls/aes.h"
 
 #if defined(MBEDTLS_PLATFORM_C)
 #include "mbedtls/platform.h"
@@ -163,6 +164,105 @@ void test_case_sha256_multi()
 }
 #endif //MBEDTLS_SHA256_C
 
+#if defined(MBEDTLS_AES_C)
+/* Tests that interleaving operations of 2 aes objects does not impact the result */
+void test_case_aes_multi()
+{
+    const unsigned char key1[16] = {
+        0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+        0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+    };
+    const unsigned char key2[32] = {
+        0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE,
+        0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+        0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7,
+        0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+    };
+    // NIST SP 800-38A F.1.1 and F.1.5 first block
+    const unsigned char plain[16] = {
+        0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96,
+        0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A
+    };
+    const unsigned char cipher1[16] = {
+        0x3A, 0xD7, 0x7B, 0xB4, 0x0D, 0x7A, 0x36, 0x60,
+        0xA8, 0x9E, 0xCA, 0xF3, 0x24, 0x66, 0xEF, 0x97
+    };
+    const unsigned char cipher2[16] = {
+        0xF3, 0xEE, 0xD1, 0xBD, 0xB5, 0xD2, 0xA0, 0x3C,
+        0x06, 0x4B, 0x5A, 0x7E, 0x3D, 0xB1, 0x81, 0xF8
+    };
+    unsigned char out[16];
+
+    mbedtls_aes_context enc1;
+    mbedtls_aes_context dec2;
+    mbedtls_aes_init(&enc1);
+    mbedtls_aes_init(&dec2);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&enc1, key1, 128));
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_dec(&dec2, key2, 256));
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ecb(&enc1, MBEDTLS_AES_ENCRYPT, plain, out));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(cipher1, out, 16);
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ecb(&dec2, MBEDTLS_AES_DECRYPT, cipher2, out));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(plain, out, 16);
+    }
+
+    mbedtls_aes_free(&enc1);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ecb(&dec2, MBEDTLS_AES_DECRYPT, cipher2, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(plain, out, 16);
+    mbedtls_aes_free(&dec2);
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+/* Tests that a counter run split at any offset gives the result of a single run */
+void test_case_aes_ctr_split()
+{
+    const unsigned char key[16] = {
+        0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+        0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+    };
+    unsigned char input[100];
+    unsigned char ref[100];
+    unsigned char out[100];
+    unsigned char nonce[16];
+    unsigned char stream[16];
+    size_t off;
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (unsigned char)i;
+    }
+
+    mbedtls_aes_context ctx;
+    mbedtls_aes_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&ctx, key, 128));
+
+    // the low 32 bits of the counter wrap in the run
+    memset(nonce, 0, sizeof(nonce));
+    memset(nonce + 12, 0xFF, 4);
+    nonce[15] = 0xFE;
+    off = 0;
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ctr(&ctx, sizeof(input), &off, nonce, stream, input, ref));
+
+    const size_t splits[] = { 1, 16, 17, 33, 64 };
+    for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++) {
+        memset(nonce, 0, sizeof(nonce));
+        memset(nonce + 12, 0xFF, 4);
+        nonce[15] = 0xFE;
+        off = 0;
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ctr(&ctx, splits[s], &off, nonce, stream, input, out));
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ctr(&ctx, sizeof(input) - splits[s], &off, nonce, stream,
+                                                   input + splits[s], out + splits[s]));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, out, sizeof(input));
+    }
+
+    // the counter carried past the low 32 bits
+    TEST_ASSERT_EQUAL_HEX8(0x01, nonce[11]);
+
+    mbedtls_aes_free(&ctx);
+}
+#endif // MBEDTLS_CIPHER_MODE_CTR
+#endif // MBEDTLS_AES_C
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -174,6 +274,12 @@ Case cases[] = {
     Case("Crypto: sha256_split", test_case_sha256_split, greentea_failure_handler),
     Case("Crypto: sha256_multi", test_case_sha256_multi, greentea_failure_handler),
 #endif
+#if defined(MBEDTLS_AES_C)
+    Case("Crypto: aes_multi", test_case_aes_multi, greentea_failure_handler),
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+    Case("Crypto: aes_ctr_split", test_case_aes_ctr_split, greentea_failure_handler),
+#endif
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Throughput of the bulk ciphers and hashes used by TLS.
+ *
+ * Every case checks that the data round trips and prints its throughput.
+ * To compare a hardware implementation with the software one, run it
+ * again with the MBEDTLS_xxx_ALT define of the target undefined in an
+ * MBEDTLS_USER_CONFIG_FILE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#define mbedtls_printf     printf
+#endif
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 4096
+#define ROUNDS      16
+
+static unsigned char input[BUFFER_SIZE];
+static unsigned char output[BUFFER_SIZE];
+static unsigned char check[BUFFER_SIZE];
+
+static const unsigned char key[32] = {
+    0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE,
+    0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+    0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7,
+    0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+};
+
+static void fill_input()
+{
+    for (size_t i = 0; i < BUFFER_SIZE; i++) {
+        input[i] = (unsigned char)(i * 7 + 3);
+    }
+}
+
+static void print_throughput(const char *name, Timer &timer)
+{
+    uint64_t us = timer.elapsed_time().count();
+    if (!us) {
+        us = 1;
+    }
+    mbedtls_printf("%s: %lu KiB/s\r\n", name,
+                   (unsigned long)((uint64_t)BUFFER_SIZE * ROUNDS * 1000000 / 1024 / us));
+}
+
+#if defined(MBEDTLS_AES_C)
+static void test_case_aes_ecb()
+{
+    mbedtls_aes_context enc, dec;
+    Timer timer;
+
+    fill_input();
+    mbedtls_aes_init(&enc);
+    mbedtls_aes_init(&dec);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&enc, key, 128));
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_dec(&dec, key, 128));
+
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < BUFFER_SIZE; i += 16) {
+            TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ecb(&enc, MBEDTLS_AES_ENCRYPT, input + i, output + i));
+        }
+    }
+    timer.stop();
+    print_throughput("AES-128-ECB encrypt", timer);
+
+    timer.reset();
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < BUFFER_SIZE; i += 16) {
+            TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ecb(&dec, MBEDTLS_AES_DECRYPT, output + i, check + i));
+        }
+    }
+    timer.stop();
+    print_throughput("AES-128-ECB decrypt", timer);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, check, BUFFER_SIZE);
+
+    mbedtls_aes_free(&enc);
+    mbedtls_aes_free(&dec);
+}
+
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+static void test_case_aes_cbc()
+{
+    mbedtls_aes_context enc, dec;
+    unsigned char iv[16];
+    Timer timer;
+
+    fill_input();
+    mbedtls_aes_init(&enc);
+    mbedtls_aes_init(&dec);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&enc, key, 256));
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_dec(&dec, key, 256));
+
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        memset(iv, r, sizeof(iv));
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_cbc(&enc, MBEDTLS_AES_ENCRYPT, BUFFER_SIZE, iv, input, output));
+    }
+    timer.stop();
+    print_throughput("AES-256-CBC encrypt", timer);
+
+    timer.reset();
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        memset(iv, ROUNDS - 1, sizeof(iv));
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_cbc(&dec, MBEDTLS_AES_DECRYPT, BUFFER_SIZE, iv, output, check));
+    }
+    timer.stop();
+    print_throughput("AES-256-CBC decrypt", timer);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, check, BUFFER_SIZE);
+
+    mbedtls_aes_free(&enc);
+    mbedtls_aes_free(&dec);
+}
+#endif // MBEDTLS_CIPHER_MODE_CBC
+
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+static void test_case_aes_ctr()
+{
+    mbedtls_aes_context ctx;
+    unsigned char nonce[16];
+    unsigned char stream[16];
+    size_t off;
+    Timer timer;
+
+    fill_input();
+    mbedtls_aes_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_setkey_enc(&ctx, key, 128));
+
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        memset(nonce, 0, sizeof(nonce));
+        off = 0;
+        TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ctr(&ctx, BUFFER_SIZE, &off, nonce, stream, input, output));
+    }
+    timer.stop();
+    print_throughput("AES-128-CTR", timer);
+
+    memset(nonce, 0, sizeof(nonce));
+    off = 0;
+    TEST_ASSERT_EQUAL(0, mbedtls_aes_crypt_ctr(&ctx, BUFFER_SIZE, &off, nonce, stream, output, check));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, check, BUFFER_SIZE);
+
+    mbedtls_aes_free(&ctx);
+}
+#endif // MBEDTLS_CIPHER_MODE_CTR
+#endif // MBEDTLS_AES_C
+
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+static void test_case_aes_gcm()
+{
+    mbedtls_gcm_context ctx;
+    const unsigned char iv[12] = { 0 };
+    unsigned char tag[16];
+    Timer timer;
+
+    fill_input();
+    mbedtls_gcm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, BUFFER_SIZE, iv, sizeof(iv),
+                                                       NULL, 0, input, output, sizeof(tag), tag));
+    }
+    timer.stop();
+    print_throughput("AES-128-GCM", timer);
+
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_auth_decrypt(&ctx, BUFFER_SIZE, iv, sizeof(iv), NULL, 0,
+                                                  tag, sizeof(tag), output, check));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(input, check, BUFFER_SIZE);
+
+    mbedtls_gcm_free(&ctx);
+}
+#endif // MBEDTLS_GCM_C && MBEDTLS_AES_C
+
+#if defined(MBEDTLS_SHA256_C)
+static void test_case_sha256()
+{
+    unsigned char sum[32];
+    unsigned char sum_check[32];
+    Timer timer;
+
+    fill_input();
+    timer.start();
+    for (int r = 0; r < ROUNDS; r++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_ret(input, BUFFER_SIZE, sum, 0));
+    }
+    timer.stop();
+    print_throughput("SHA-256", timer);
+
+    // the same digest when fed in uneven pieces
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts_ret(&ctx, 0));
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_update_ret(&ctx, input, 61));
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_update_ret(&ctx, input + 61, BUFFER_SIZE - 61));
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish_ret(&ctx, sum_check));
+    mbedtls_sha256_free(&ctx);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(sum, sum_check, sizeof(sum));
+}
+#endif // MBEDTLS_SHA256_C
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+#if defined(MBEDTLS_AES_C)
+    Case("Crypto: aes_ecb throughput", test_case_aes_ecb, greentea_failure_handler),
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+    Case("Crypto: aes_cbc throughput", test_case_aes_cbc, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+    Case("Crypto: aes_ctr throughput", test_case_aes_ctr, greentea_failure_handler),
+#endif
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    Case("Crypto: aes_gcm throughput", test_case_aes_gcm, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    Case("Crypto: sha256 throughput", test_case_sha256, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    int ret = 0;
+#if defined(MBEDTLS_PLATFORM_C)
+    if ((ret = mbedtls_platform_setup(NULL)) != 0) {
+        mbedtls_printf("Mbed TLS throughput test failed! mbedtls_platform_setup returned %d\n", ret);
+        return 1;
+    }
+#endif
+    ret = (Harness::run(specification) ? 0 : 1);
+#if defined(MBEDTLS_PLATFORM_C)
+    mbedtls_platform_teardown(NULL);
+#endif
+    return ret;
+}
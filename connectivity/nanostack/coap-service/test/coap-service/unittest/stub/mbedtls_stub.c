@@ -299,6 +299,14 @@ int mbedtls_x509_crt_parse(mbedtls_x509_crt *a, const unsigned char *b, size_t c
     return mbedtls_stub.expected_int;
 }
 
+int mbedtls_x509_crt_parse_der_nocopy(mbedtls_x509_crt *a, const unsigned char *b, size_t c)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
 int mbedtls_x509_crt_info(char *buf, size_t size, const char *prefix,
                           const mbedtls_x509_crt *crt)
 {
@@ -416,10 +424,56 @@ int mbedtls_ssl_session_reset(mbedtls_ssl_context *ssl)
     return mbedtls_stub.expected_int;
 }
 
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session)
+{
+}
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session)
+{
+}
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_session_save(const mbedtls_ssl_session *session, unsigned char *buf, size_t buf_len, size_t *olen)
+{
+    *olen = 0;
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_session_load(mbedtls_ssl_session *session, const unsigned char *buf, size_t len)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
 void mbedtls_strerror(int ret, char *buf, size_t buflen)
 {
 }
 
+void mbedtls_platform_zeroize(void *buf, size_t len)
+{
+    memset(buf, 0, len);
+}
+
 int mbedtls_platform_setup(mbedtls_platform_context *ctx)
 {
     (void)ctx;
@@ -203,6 +203,25 @@ protected:
      */
     nsapi_size_or_error_t socket_recvfrom(void *handle, SocketAddress *address, void *buffer, nsapi_size_t size) override;
 
+    /** Send a scatter-gather list over a socket
+     *
+     *  TCP data is written in one call from up to 8 buffers, a UDP datagram
+     *  can have up to 8 buffers.
+     *
+     *  @copydetails NetworkStack::socket_sendmsg
+     */
+    nsapi_size_or_error_t socket_sendmsg(void *handle, const SocketAddress *address,
+                                         const nsapi_iovec_t *iov, unsigned iovcnt) override;
+
+    /** Receive data over a socket into a scatter-gather list
+     *
+     *  Up to 8 buffers are filled in one call.
+     *
+     *  @copydetails NetworkStack::socket_recvmsg
+     */
+    nsapi_size_or_error_t socket_recvmsg(void *handle, SocketAddress *address,
+                                         const nsapi_iovec_t *iov, unsigned iovcnt) override;
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -286,6 +305,7 @@ private:
     };
 
     nsapi_size_or_error_t do_sendto(void *handle, const struct ns_address *address, const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t do_sendmsg(void *handle, const struct ns_address *address, const nsapi_iovec_t *iov, unsigned iovcnt);
     static void call_event_tasklet_main(arm_event_s *event);
     char text_ip_address[40];
     NanostackMemoryManager memory_manager;
@@ -83,6 +83,10 @@ typedef struct {
     uint16_t etx_2nd_parent;    /*<! Secondary parent ETX. */
     uint32_t asynch_tx_count;   /*<! Asynch TX counter */
     uint32_t asynch_rx_count;   /*<! Asynch RX counter */
+    uint32_t rpl_dao_targets;   /*<! RPL DAO targets stored, the downward routes of a border router. */
+    uint32_t rpl_dao_refresh;   /*<! RPL DAO refreshes leaving the downward routes unchanged. */
+    uint32_t rpl_topo_sort;     /*<! RPL downward topology sorts of a border router. */
+    uint32_t rpl_route_compute; /*<! RPL downward path computations of a border router. */
 } mesh_nw_statistics_t;
 
 /**
@@ -19,6 +19,7 @@ public:
 
     int8_t address_write(phy_address_type_e, uint8_t *);
     int8_t tx(uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data_protocol_e data_flow);
+    int8_t tx_buffer(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data_protocol_e data_flow);
 
     void emac_phy_rx(emac_mem_buf_t *mem);
 
@@ -50,6 +51,11 @@ extern "C"
         return single_phy->tx(data_ptr, data_len, tx_handle, data_flow);
     }
 
+    static int8_t emac_phy_tx_buffer(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data_protocol_e data_flow)
+    {
+        return single_phy->tx_buffer(block_ptr, data_ptr, data_len, tx_handle, data_flow);
+    }
+
     EMACPhy::EMACPhy(NanostackMemoryManager &mem, EMAC &m) : memory_manager(mem), emac(m)
     {
         /* Same default address logic as lwIP glue uses */
@@ -75,6 +81,13 @@ extern "C"
         uint8_t *tmpbuf = NULL;
         uint32_t total_len;
 
+        // Our buffers are heap blocks, so Nanostack can keep the frame in place
+        void *block = memory_manager.get_block(mem);
+        if (block && phy.phy_rx_buffer_cb) {
+            phy.phy_rx_buffer_cb(block, static_cast<uint8_t *>(memory_manager.get_ptr(mem)), memory_manager.get_len(mem), 0xff, 0, device_id);
+            return;
+        }
+
         if (memory_manager.get_next(mem) == NULL) {
             // Easy contiguous case
             ptr = static_cast<const uint8_t *>(memory_manager.get_ptr(mem));
@@ -121,6 +134,21 @@ int8_t EMACPhy::tx(uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data
     return 0;
 }
 
+int8_t EMACPhy::tx_buffer(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t tx_handle, data_protocol_e data_flow)
+{
+    // The frame stays in the block Nanostack built it in
+    emac_mem_buf_t *mem = memory_manager.wrap(block_ptr, data_ptr, data_len);
+    if (!mem) {
+        ns_dyn_mem_free(block_ptr);
+        return -1;
+    }
+
+    // They take ownership - their responsibility to free
+    emac.link_out(mem);
+
+    return 0;
+}
+
 int8_t EMACPhy::phy_register()
 {
     if (device_id < 0) {
@@ -134,8 +162,10 @@ int8_t EMACPhy::phy_register()
         phy.phy_tail_length = 0;
         phy.state_control = emac_phy_interface_state_control;
         phy.tx = emac_phy_tx;
+        phy.tx_buffer = emac_phy_tx_buffer;
         phy.phy_rx_cb = NULL;
         phy.phy_tx_done_cb = NULL;
+        phy.phy_rx_buffer_cb = NULL;
 
         emac.set_memory_manager(memory_manager);
         emac.set_link_input_cb(mbed::callback(this, &EMACPhy::emac_phy_rx));
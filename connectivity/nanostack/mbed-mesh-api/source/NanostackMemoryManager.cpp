@@ -23,6 +23,7 @@ struct ns_stack_mem_t {
     ns_stack_mem_t *next;
     void *payload;
     uint32_t len;
+    void *block; // Wrapped block holding the payload, freed with the buffer
     uint8_t mem[];
 };
 
@@ -36,6 +37,7 @@ emac_mem_buf_t *NanostackMemoryManager::alloc_heap(uint32_t size, uint32_t align
     buf->next = NULL;
     buf->payload = buf->mem;
     buf->len = size;
+    buf->block = NULL;
 
     if (align) {
         uint32_t remainder = reinterpret_cast<uint32_t>(buf->payload) % align;
@@ -62,9 +64,41 @@ uint32_t NanostackMemoryManager::get_pool_alloc_unit(uint32_t align) const
     return 1536; // arbitrary nicely-aligned number big enough for Ethernet
 }
 
-void NanostackMemoryManager::free(emac_mem_buf_t *mem)
+void NanostackMemoryManager::free(emac_mem_buf_t *buf)
 {
-    ns_dyn_mem_free(mem);
+    ns_stack_mem_t *mem = static_cast<ns_stack_mem_t *>(buf);
+
+    while (mem) {
+        ns_stack_mem_t *next = mem->next;
+        ns_dyn_mem_free(mem->block);
+        ns_dyn_mem_free(mem);
+        mem = next;
+    }
+}
+
+emac_mem_buf_t *NanostackMemoryManager::wrap(void *block, void *payload, uint32_t len)
+{
+    ns_stack_mem_t *buf = static_cast<ns_stack_mem_t *>(ns_dyn_mem_temporary_alloc(sizeof(ns_stack_mem_t)));
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    buf->next = NULL;
+    buf->payload = payload;
+    buf->len = len;
+    buf->block = block;
+
+    return static_cast<emac_mem_buf_t *>(buf);
+}
+
+void *NanostackMemoryManager::get_block(emac_mem_buf_t *buf) const
+{
+    ns_stack_mem_t *mem = static_cast<ns_stack_mem_t *>(buf);
+
+    if (mem->next || mem->block) {
+        return NULL;
+    }
+    return mem;
 }
 
 uint32_t NanostackMemoryManager::get_total_len(const emac_mem_buf_t *buf) const
@@ -276,8 +276,10 @@ int8_t PPPPhy::phy_register()
         phy.phy_tail_length = 0;
         phy.state_control = ppp_phy_interface_state_control;
         phy.tx = ppp_phy_tx;
+        phy.tx_buffer = NULL;
         phy.phy_rx_cb = NULL;
         phy.phy_tx_done_cb = NULL;
+        phy.phy_rx_buffer_cb = NULL;
 
         ppp.set_memory_manager(memory_manager);
         ppp.set_link_input_cb(mbed::callback(this, &PPPPhy::ppp_phy_rx));
@@ -136,6 +136,30 @@ public:
      * @param len      Payload size, must be less or equal allocated size
      */
     void set_len(emac_mem_buf_t *buf, uint32_t len) override;
+
+    /**
+     * Wrap a Nanostack heap block into a memory buffer, without copying it
+     *
+     * The buffer takes over the block, which is freed with the buffer.
+     *
+     * @param block    Block from ns_dyn_mem_alloc() or ns_dyn_mem_temporary_alloc()
+     * @param payload  Start of the payload, within the block
+     * @param len      Payload size in bytes
+     * @return         Memory buffer, or NULL in case of error, the block being then left to the caller
+     */
+    emac_mem_buf_t *wrap(void *block, void *payload, uint32_t len);
+
+    /**
+     * Get the Nanostack heap block of a memory buffer
+     *
+     * A buffer that is not chained is a single heap block, which can be
+     * freed with ns_dyn_mem_free() instead of free().
+     *
+     * @param buf      Memory buffer
+     * @return         The block holding the buffer and its payload, or NULL
+     *                 for a chained or wrapping buffer
+     */
+    void *get_block(emac_mem_buf_t *buf) const;
 };
 
 #endif /* NANOSTACK_MEMORY_MANAGER_H */
@@ -619,6 +619,10 @@ int wisun_tasklet_statistics_nw_read(mesh_nw_statistics_t *stats)
     stats->etx_2nd_parent = statistics->nwk_stats.etx_2nd_parent;
     stats->asynch_tx_count = statistics->ws_statistics.asynch_tx_count;
     stats->asynch_rx_count = statistics->ws_statistics.asynch_rx_count;
+    stats->rpl_dao_targets = statistics->nwk_stats.rpl_dao_targets;
+    stats->rpl_dao_refresh = statistics->nwk_stats.rpl_dao_refresh;
+    stats->rpl_topo_sort = statistics->nwk_stats.rpl_topo_sort;
+    stats->rpl_route_compute = statistics->nwk_stats.rpl_route_compute;
 
     return 0;
 }
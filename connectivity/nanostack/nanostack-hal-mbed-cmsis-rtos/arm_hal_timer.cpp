@@ -105,6 +105,13 @@ int8_t platform_tick_timer_stop(void)
 }
 #endif // NS_EVENTLOOP_USE_TICK_TIMER
 
+#if defined(NS_EVENTLOOP_EVENT_STATS)
+uint32_t platform_timer_get_timestamp_us(void)
+{
+    return duration_cast<microseconds>(HighResClock::now().time_since_epoch()).count();
+}
+#endif // NS_EVENTLOOP_EVENT_STATS
+
 
 // Called once at boot
 void platform_timer_enable(void)
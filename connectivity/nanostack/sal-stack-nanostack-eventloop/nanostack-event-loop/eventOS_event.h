@@ -191,6 +191,7 @@ extern "C" {
 
 #include "ns_types.h"
 #include "ns_list.h"
+#include "platform/eventloop_config.h"
 
 /**
  * \enum arm_library_event_priority_e
@@ -252,6 +253,9 @@ typedef struct arm_event_storage {
         ARM_LIB_EVENT_RUNNING,
     } state;
     ns_list_link_t link;
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    uint32_t queued_time; /**< Timestamp of event_core_write(), for the statistics */
+#endif
 } arm_event_storage_t;
 
 /**
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENTOS_EVENT_STATS_H_
+#define EVENTOS_EVENT_STATS_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \file eventOS_event_stats.h
+ * \ingroup nanostack-eventloop
+ * \brief Statistics of the event dispatching.
+ *
+ * Statistics are collected when the event loop is built with
+ * NS_EVENTLOOP_EVENT_STATS, "nanostack-eventloop.event_stats" in mbed OS.
+ * Times are measured with platform_timer_get_timestamp_us() and given in
+ * microseconds. A tasklet running for long delays the events of all the
+ * others, which shows up as queue wait of their events.
+ */
+
+#include "ns_types.h"
+
+/**
+ * \struct eventOS_tasklet_stats_t
+ * \brief Statistics of the events of one tasklet.
+ */
+typedef struct eventOS_tasklet_stats {
+    uint32_t events;            /**< Events dispatched to the tasklet */
+    uint32_t run_time;          /**< Total time spent in the tasklet handler */
+    uint32_t run_time_max;      /**< Longest run of the handler */
+    uint8_t run_time_max_event_type; /**< Event type of the longest run */
+    uint32_t queue_wait;        /**< Total time events waited in the queue before dispatch */
+    uint32_t queue_wait_max;    /**< Longest wait of an event in the queue */
+} eventOS_tasklet_stats_t;
+
+/**
+ * \struct eventOS_event_queue_stats_t
+ * \brief Statistics of the event queue.
+ */
+typedef struct eventOS_event_queue_stats {
+    uint16_t depth;             /**< Events currently queued */
+    uint16_t depth_max;         /**< Most events queued at once */
+    uint32_t events;            /**< Events dispatched, all tasklets */
+} eventOS_event_queue_stats_t;
+
+/**
+ * \brief Read the statistics of a tasklet.
+ *
+ * \param tasklet_id Tasklet ID given by eventOS_event_handler_create().
+ * \param stats Where to copy the statistics.
+ *
+ * \return 0 statistics copied
+ * \return -1 unknown tasklet, or statistics not built in
+ */
+extern int8_t eventOS_event_stats_tasklet_get(int8_t tasklet_id, eventOS_tasklet_stats_t *stats);
+
+/**
+ * \brief Read the statistics of the event queue.
+ *
+ * \param stats Where to copy the statistics.
+ *
+ * \return 0 statistics copied
+ * \return -1 statistics not built in
+ */
+extern int8_t eventOS_event_stats_queue_get(eventOS_event_queue_stats_t *stats);
+
+/**
+ * \brief Clear the statistics of all the tasklets and the maximum depth of the queue.
+ */
+extern void eventOS_event_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENTOS_EVENT_STATS_H_ */
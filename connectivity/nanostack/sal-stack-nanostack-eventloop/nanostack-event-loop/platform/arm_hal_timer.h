@@ -88,6 +88,17 @@ extern int8_t platform_tick_timer_stop(void);
 
 #endif // NS_EVENTLOOP_USE_TICK_TIMER
 
+#ifdef NS_EVENTLOOP_EVENT_STATS
+/**
+ * \brief This function is API for reading a free running microsecond timestamp,
+ *        used to time the events dispatched. Wrapping around at 32 bits is fine.
+ *
+ * \return current time in microseconds
+ */
+extern uint32_t platform_timer_get_timestamp_us(void);
+
+#endif // NS_EVENTLOOP_EVENT_STATS
+
 #ifdef __cplusplus
 }
 #endif
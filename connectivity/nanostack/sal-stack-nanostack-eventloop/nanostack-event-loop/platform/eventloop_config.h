@@ -27,6 +27,8 @@
 #undef NS_EVENTLOOP_USE_TICK_TIMER
 /* Exclude high resolution timer from build (removes need for "platform_timer" API) */
 #undef NS_EXCLUDE_HIGHRES_TIMER
+/* Collect event dispatching statistics (requires "platform_timer_get_timestamp_us" API) */
+#undef NS_EVENTLOOP_EVENT_STATS
 
 /*
  * mbedOS 5 specific configuration flag mapping to internal flags
@@ -39,6 +41,10 @@
 #define NS_EXCLUDE_HIGHRES_TIMER        1
 #endif
 
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_EVENT_STATS
+#define NS_EVENTLOOP_EVENT_STATS        1
+#endif
+
 /*
  * Include the user config file if defined
  */
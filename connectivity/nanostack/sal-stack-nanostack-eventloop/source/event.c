@@ -22,13 +22,18 @@
 #include "nsdynmemLIB.h"
 #include "ns_timer.h"
 #include "event.h"
+#include "eventOS_event_stats.h"
 #include "platform/arm_hal_interrupt.h"
+#include "platform/arm_hal_timer.h"
 
 
 typedef struct arm_core_tasklet {
     int8_t id; /**< Event handler Tasklet ID */
     void (*func_ptr)(arm_event_s *);
     ns_list_link_t link;
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    eventOS_tasklet_stats_t stats;
+#endif
 } arm_core_tasklet_t;
 
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
@@ -42,6 +47,11 @@ static arm_event_storage_t startup_event_pool[STARTUP_EVENT_POOL_SIZE];
 /** Curr_tasklet tell to core and platform which task_let is active, Core Update this automatic when switch Tasklet. */
 int8_t curr_tasklet = 0;
 
+#ifdef NS_EVENTLOOP_EVENT_STATS
+// Depth and maximum updated with lock held
+static eventOS_event_queue_stats_t event_queue_stats;
+#endif
+
 
 static arm_core_tasklet_t *tasklet_dynamically_allocate(void);
 static arm_event_storage_t *event_dynamically_allocate(void);
@@ -101,6 +111,9 @@ int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_s *), uin
     }
 
     //Fill in tasklet; add to list
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    memset(&new->stats, 0, sizeof(new->stats));
+#endif
     new->id = tasklet_get_free_id();
     new->func_ptr = handler_func_ptr;
     ns_list_add_to_end(&arm_core_tasklet_list, new);
@@ -143,6 +156,9 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
     ns_list_remove(&event_queue_active, event);
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    event_queue_stats.depth--;
+#endif
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
@@ -211,6 +227,9 @@ static arm_event_storage_t *event_core_read(void)
     if (event) {
         event->state = ARM_LIB_EVENT_RUNNING;
         ns_list_remove(&event_queue_active, event);
+#ifdef NS_EVENTLOOP_EVENT_STATS
+        event_queue_stats.depth--;
+#endif
     }
     platform_exit_critical();
     return event;
@@ -232,6 +251,12 @@ void event_core_write(arm_event_storage_t *event)
         ns_list_add_to_end(&event_queue_active, event);
     }
     event->state = ARM_LIB_EVENT_QUEUED;
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    event->queued_time = platform_timer_get_timestamp_us();
+    if (++event_queue_stats.depth > event_queue_stats.depth_max) {
+        event_queue_stats.depth_max = event_queue_stats.depth;
+    }
+#endif
 
     /* Wake From Idle */
     platform_exit_critical();
@@ -315,6 +340,27 @@ int eventOS_scheduler_timer_synch_after_sleep(uint32_t sleep_ticks)
  * Function Read and handle Cores Event and switch/enable tasklet which are event receiver. WhenEvent queue is empty it goes to sleep
  *
  */
+#ifdef NS_EVENTLOOP_EVENT_STATS
+static void event_stats_update_wait(eventOS_tasklet_stats_t *stats, uint32_t wait)
+{
+    stats->events++;
+    stats->queue_wait += wait;
+    if (wait > stats->queue_wait_max) {
+        stats->queue_wait_max = wait;
+    }
+    event_queue_stats.events++;
+}
+
+static void event_stats_update_run(eventOS_tasklet_stats_t *stats, uint32_t run_time, uint8_t event_type)
+{
+    stats->run_time += run_time;
+    if (run_time > stats->run_time_max) {
+        stats->run_time_max = run_time;
+        stats->run_time_max_event_type = event_type;
+    }
+}
+#endif
+
 bool eventOS_scheduler_dispatch_event(void)
 {
     curr_tasklet = 0;
@@ -338,7 +384,15 @@ bool eventOS_scheduler_dispatch_event(void)
      */
 
     /* Tasklet Scheduler Call */
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    uint8_t event_type = cur_event->data.event_type;
+    uint32_t start = platform_timer_get_timestamp_us();
+    event_stats_update_wait(&tasklet->stats, start - cur_event->queued_time);
     tasklet->func_ptr(&cur_event->data);
+    event_stats_update_run(&tasklet->stats, platform_timer_get_timestamp_us() - start, event_type);
+#else
+    tasklet->func_ptr(&cur_event->data);
+#endif
     event_core_free_push(cur_event);
 
     /* Set Current Tasklet to Idle state */
@@ -368,6 +422,48 @@ NS_NORETURN void eventOS_scheduler_run(void)
     }
 }
 
+int8_t eventOS_event_stats_tasklet_get(int8_t tasklet_id, eventOS_tasklet_stats_t *stats)
+{
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    arm_core_tasklet_t *tasklet = event_tasklet_handler_get(tasklet_id);
+    if (!tasklet) {
+        return -1;
+    }
+    *stats = tasklet->stats;
+    return 0;
+#else
+    (void) tasklet_id;
+    (void) stats;
+    return -1;
+#endif
+}
+
+int8_t eventOS_event_stats_queue_get(eventOS_event_queue_stats_t *stats)
+{
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    platform_enter_critical();
+    *stats = event_queue_stats;
+    platform_exit_critical();
+    return 0;
+#else
+    (void) stats;
+    return -1;
+#endif
+}
+
+void eventOS_event_stats_reset(void)
+{
+#ifdef NS_EVENTLOOP_EVENT_STATS
+    ns_list_foreach(arm_core_tasklet_t, cur, &arm_core_tasklet_list) {
+        memset(&cur->stats, 0, sizeof(cur->stats));
+    }
+    platform_enter_critical();
+    event_queue_stats.depth_max = event_queue_stats.depth;
+    event_queue_stats.events = 0;
+    platform_exit_critical();
+#endif
+}
+
 void eventOS_cancel(arm_event_storage_t *event)
 {
     if (!event) {
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string.h>
 #include "ns_types.h"
 #include "ns_list.h"
 #include "timer_sys.h"
@@ -41,12 +42,25 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 static volatile uint32_t timer_sys_ticks;
 
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+
+/*
+ * Pending timers are kept in a binary min-heap ordered by launch time, then by
+ * order of request, so adding and removing a timer is O(log n) instead of a
+ * walk of a sorted list. The heap grows with the number of timers allocated,
+ * which are never freed, so a timer always finds a place in it.
+ */
+static sys_timer_struct_s *startup_sys_timer_heap[ST_MAX];
+static sys_timer_struct_s **system_timer_heap = startup_sys_timer_heap;
+static uint16_t system_timer_heap_size;
+static uint16_t system_timer_heap_capacity = ST_MAX;
+static uint16_t system_timer_count;
+static uint32_t system_timer_sequence;
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
 static void timer_sys_interrupt(void);
 static void timer_sys_add(sys_timer_struct_s *timer);
+static void timer_sys_remove(sys_timer_struct_s *timer);
 
 #ifndef NS_EVENTLOOP_USE_TICK_TIMER
 static int8_t platform_tick_timer_start(uint32_t period_ms);
@@ -91,8 +105,10 @@ static int8_t platform_tick_timer_stop(void)
 void timer_sys_init(void)
 {
     for (uint8_t i = 0; i < ST_MAX; i++) {
+        startup_sys_timer_pool[i].heap_index = SYS_TIMER_NOT_QUEUED;
         ns_list_add_to_start(&system_timer_free, &startup_sys_timer_pool[i]);
     }
+    system_timer_count = ST_MAX;
 
     platform_tick_timer_register(timer_sys_interrupt);
     platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
@@ -124,9 +140,33 @@ static void timer_sys_interrupt(void)
 
 /* * * * * * * * * */
 
+/* Called internally with lock held */
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void)
 {
-    return ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
+    if (system_timer_count == system_timer_heap_capacity) {
+        if (system_timer_heap_capacity > (SYS_TIMER_NOT_QUEUED - 1) / 2) {
+            return NULL;
+        }
+        // Make room in the heap for the new timer
+        uint16_t capacity = system_timer_heap_capacity * 2;
+        sys_timer_struct_s **heap = ns_dyn_mem_alloc(capacity * sizeof(sys_timer_struct_s *));
+        if (!heap) {
+            return NULL;
+        }
+        memcpy(heap, system_timer_heap, system_timer_heap_size * sizeof(sys_timer_struct_s *));
+        if (system_timer_heap != startup_sys_timer_heap) {
+            ns_dyn_mem_free(system_timer_heap);
+        }
+        system_timer_heap = heap;
+        system_timer_heap_capacity = capacity;
+    }
+
+    sys_timer_struct_s *timer = ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
+    if (timer) {
+        timer->heap_index = SYS_TIMER_NOT_QUEUED;
+        system_timer_count++;
+    }
+    return timer;
 }
 
 static sys_timer_struct_s *timer_struct_get(void)
@@ -168,9 +208,9 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
 {
     sys_timer_struct_s *timer = NS_CONTAINER_OF(event, sys_timer_struct_s, event);
     timer->period = 0;
-    // If its unqueued it is on my timer list, otherwise it is in event-loop.
-    if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+    // If its unqueued it is on my timer heap, otherwise it is in event-loop.
+    if (event->state == ARM_LIB_EVENT_UNQUEUED && timer->heap_index != SYS_TIMER_NOT_QUEUED) {
+        timer_sys_remove(timer);
     }
 }
 
@@ -185,22 +225,80 @@ uint32_t eventOS_event_timer_ticks(void)
     return ret_val;
 }
 
-/* Called internally with lock held */
-static void timer_sys_add(sys_timer_struct_s *timer)
+/* Timers scheduled for same time run in order of request */
+static bool timer_sys_before(const sys_timer_struct_s *a, const sys_timer_struct_s *b)
+{
+    if (a->launch_time != b->launch_time) {
+        return TICKS_BEFORE(a->launch_time, b->launch_time);
+    }
+    return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+static void timer_sys_heap_set(uint16_t index, sys_timer_struct_s *timer)
+{
+    system_timer_heap[index] = timer;
+    timer->heap_index = index;
+}
+
+static void timer_sys_heap_up(uint16_t index)
+{
+    sys_timer_struct_s *timer = system_timer_heap[index];
+    while (index > 0) {
+        uint16_t parent = (index - 1) / 2;
+        if (!timer_sys_before(timer, system_timer_heap[parent])) {
+            break;
+        }
+        timer_sys_heap_set(index, system_timer_heap[parent]);
+        index = parent;
+    }
+    timer_sys_heap_set(index, timer);
+}
+
+static void timer_sys_heap_down(uint16_t index)
 {
-    uint32_t at = timer->launch_time;
-
-    // Find first timer scheduled to run after us, and insert before it.
-    // (This means timers scheduled for same time run in order of request)
-    ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
-        if (TICKS_BEFORE(at, t->launch_time)) {
-            ns_list_add_before(&system_timer_list, t, timer);
-            return;
+    sys_timer_struct_s *timer = system_timer_heap[index];
+    while (true) {
+        uint16_t child = 2 * index + 1;
+        if (child >= system_timer_heap_size) {
+            break;
+        }
+        if (child + 1 < system_timer_heap_size && timer_sys_before(system_timer_heap[child + 1], system_timer_heap[child])) {
+            child++;
         }
+        if (!timer_sys_before(system_timer_heap[child], timer)) {
+            break;
+        }
+        timer_sys_heap_set(index, system_timer_heap[child]);
+        index = child;
     }
+    timer_sys_heap_set(index, timer);
+}
 
-    // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
+/* Called internally with lock held */
+static void timer_sys_add(sys_timer_struct_s *timer)
+{
+    timer->sequence = system_timer_sequence++;
+    timer_sys_heap_set(system_timer_heap_size++, timer);
+    timer_sys_heap_up(timer->heap_index);
+}
+
+/* Called internally with lock held */
+static void timer_sys_remove(sys_timer_struct_s *timer)
+{
+    uint16_t index = timer->heap_index;
+    sys_timer_struct_s *last = system_timer_heap[--system_timer_heap_size];
+
+    timer->heap_index = SYS_TIMER_NOT_QUEUED;
+    if (last == timer) {
+        return;
+    }
+    // Move the last timer into the hole, then restore the heap order
+    timer_sys_heap_set(index, last);
+    if (index > 0 && timer_sys_before(last, system_timer_heap[(index - 1) / 2])) {
+        timer_sys_heap_up(index);
+    } else {
+        timer_sys_heap_down(index);
+    }
 }
 
 /* Called internally with lock held */
@@ -306,13 +404,20 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
 {
     platform_enter_critical();
 
-    /* First check pending timers */
-    ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
+    /* First check pending timers, cancelling the first one due */
+    sys_timer_struct_s *first = NULL;
+    for (uint16_t i = 0; i < system_timer_heap_size; i++) {
+        sys_timer_struct_s *cur = system_timer_heap[i];
         if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
-            eventOS_cancel(&cur->event);
-            goto done;
+            if (!first || timer_sys_before(cur, first)) {
+                first = cur;
+            }
         }
     }
+    if (first) {
+        eventOS_cancel(&first->event);
+        goto done;
+    }
 
     /* No pending timer, so check for already-pending event */
     arm_event_storage_t *event = eventOS_event_find_by_id_critical(tasklet_id, event_id);
@@ -335,7 +440,7 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
+    sys_timer_struct_s *first = system_timer_heap_size ? system_timer_heap[0] : NULL;
     if (first == NULL) {
         // Weird API has 0 for "no events"
         ret_val = 0;
@@ -355,17 +460,17 @@ void system_timer_tick_update(uint32_t ticks)
     platform_enter_critical();
     //Keep runtime time
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
-            // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
-            // Make it an event (can't fail - no allocation)
-            // event system will call our timer_sys_event_free on event delivery.
-            eventOS_event_send_timer_allocated(&cur->event);
-        } else {
-            // List is ordered, so as soon as we see a later event, we're done.
+    while (system_timer_heap_size) {
+        sys_timer_struct_s *cur = system_timer_heap[0];
+        if (!TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
+            // Heap top is the next timer due, so we're done.
             break;
         }
+        // Take it off our heap
+        timer_sys_remove(cur);
+        // Make it an event (can't fail - no allocation)
+        // event system will call our timer_sys_event_free on event delivery.
+        eventOS_event_send_timer_allocated(&cur->event);
     }
 
     platform_exit_critical();
@@ -27,8 +27,12 @@ typedef struct sys_timer_struct_s {
     arm_event_storage_t event;
     uint32_t launch_time; // tick value
     uint32_t period;
+    uint32_t sequence; // order of request, for timers with same launch time
+    uint16_t heap_index; // position in timer heap, SYS_TIMER_NOT_QUEUED if not in it
 } sys_timer_struct_s;
 
+#define SYS_TIMER_NOT_QUEUED    0xffff
+
 
 /**
  * Initialize system timer
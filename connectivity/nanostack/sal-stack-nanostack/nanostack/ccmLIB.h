@@ -77,6 +77,7 @@ typedef struct {
     uint8_t *mic;               /**< Encrypt process writes MIC. Decrypt reads it and compares it with the MIC obtained from data. */
     const uint8_t *key_ptr;     /**< Encyption key pointer to 128-bit key. */
     arm_aes_context_t *aes_context; /**< Allocated AES context. */
+    void *ccm_hw_context;       /**< Allocated accelerated CCM context, instead of aes_context. */
 } ccm_globals_t;
 
 
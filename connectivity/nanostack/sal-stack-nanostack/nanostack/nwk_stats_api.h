@@ -62,6 +62,10 @@ typedef struct nwk_stats_t {
     uint32_t rpl_malformed_message; /**< RPL malformed message count. */
     uint32_t rpl_time_no_next_hop;  /**< RPL seconds without a next hop. */
     uint32_t rpl_total_memory;      /**< RPL current memory usage total. */
+    uint32_t rpl_dao_targets;       /**< RPL DAO targets currently stored (downward route table size). */
+    uint32_t rpl_dao_refresh;       /**< RPL DAO transit refreshes leaving downward routes unchanged. */
+    uint32_t rpl_topo_sort;         /**< RPL root downward topology sorts. */
+    uint32_t rpl_route_compute;     /**< RPL root downward path computations. */
     /* Buffers */
     uint32_t buf_alloc;             /**< Buffer allocation count. */
     uint32_t buf_headroom_realloc;  /**< Buffer headroom realloc count. */
@@ -230,6 +230,21 @@ typedef struct virtual_data_req_s {
  */
 typedef int8_t arm_net_phy_rx_fn(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id);
 
+/**
+ * @brief arm_net_phy_rx_buffer RX callback set by upper layer, taking over the heap block holding the data
+ * received, so that the upper layer keeps the data in place instead of copying it. Drivers receiving
+ * into Nanostack heap blocks may call it when set instead of arm_net_phy_rx.
+ * @param block_ptr Block from ns_dyn_mem_alloc() or ns_dyn_mem_temporary_alloc() holding the data,
+ *                  freed by the upper layer with ns_dyn_mem_free(), whether it succeeds or not
+ * @param data_ptr Data received, within the block
+ * @param data_len Length of the data received
+ * @param link_quality Link quality
+ * @param dbm Power ratio in decibels
+ * @param driver_id ID of driver which received data
+ * @return 0 if success, error otherwise
+ */
+typedef int8_t arm_net_phy_rx_buffer_fn(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id);
+
 /**
  * @brief arm_net_phy_tx_done TX done callback set by upper layer. Called when tx sent by upper layer has been handled
  * @param driver_id Id of the driver which handled TX request
@@ -311,6 +326,8 @@ typedef struct phy_device_driver_s {
     arm_net_virtual_confirmation_rx_fn *virtual_confirmation_rx_cb; /**< Virtual confirmation receive callback. Initialized by \ref arm_net_phy_register(). */
     uint16_t tunnel_type; /**< Tun driver type. */
     phy_rf_statistics_s *phy_rf_statistics;                         /**< PHY statistics. */
+    int8_t (*tx_buffer)(void *, uint8_t *, uint16_t, uint8_t, data_protocol_e); /**< Optional function pointer for PHY driver write operation taking over the heap block holding the data, given first, to free it with ns_dyn_mem_free() when sent or on failure. NULL if not supported. */
+    arm_net_phy_rx_buffer_fn *phy_rx_buffer_cb;                     /**< PHY RX callback taking over the data block, NULL if the upper layer only supports phy_rx_cb. Initialized by \ref arm_net_phy_register(). */
 } phy_device_driver_s;
 
 
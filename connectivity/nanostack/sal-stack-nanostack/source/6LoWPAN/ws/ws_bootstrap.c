@@ -205,7 +205,7 @@ ws_neighbor_class_entry_t *ws_bootstrap_eapol_tx_temporary_set(struct protocol_i
         return NULL;
     }
 
-    memcpy(mac_entry->mac64, src64, 8);
+    mac_neighbor_table_entry_mac64_set(mac_neighbor_info(interface), mac_entry, src64);
     mac_helper_device_description_write(interface, &device_desc, src64, 0xffff, 0, false);
     mac_helper_devicetable_direct_set(interface->mac_api, &device_desc, interface->ws_info->eapol_tx_index);
     return ws_neighbor_class_entry_get(&interface->ws_info->neighbor_storage, mac_entry->index);
@@ -83,6 +83,7 @@ typedef struct mac_pre_build_frame {
     uint16_t mac_header_length_with_security;
     uint8_t msduHandle;
     uint16_t buffer_ttl;
+    uint16_t indirect_sequence; //Indirect queue order
     struct mcps_data_req_ie_list ie_elements;
     struct channel_list_s asynch_channel_list;
     uint8_t *mac_payload;
@@ -131,6 +131,8 @@ typedef struct mac_active_scan {
 } mac_active_scan;
 
 #define MAC_EXT_ADDLIST_SIZE 8
+
+#define MAC_INDIRECT_HASH_SIZE 16 // Indirect queue buckets by destination address, power of 2
 typedef struct mac_extented_address_table_t {
     uint8_t short_addr[2];
     uint8_t addr[8];
@@ -249,7 +251,9 @@ typedef struct protocol_interface_rf_mac_setup {
     uint16_t phy_mtu_size;
     phy_802_15_4_mode_t current_mac_mode;
     /* Indirect queue parameters */
-    struct mac_pre_build_frame *indirect_pd_data_request_queue;
+    struct mac_pre_build_frame *indirect_pd_data_request_queue[MAC_INDIRECT_HASH_SIZE];
+    uint16_t indirect_pd_data_request_count;
+    uint16_t indirect_sequence;
     struct mac_pre_build_frame enhanced_ack_buffer;
     uint32_t enhanced_ack_handler_timestamp;
     arm_event_t mac_mcps_timer_event;
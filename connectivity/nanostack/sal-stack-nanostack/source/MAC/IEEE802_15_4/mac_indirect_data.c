@@ -41,6 +41,44 @@
 #define TRACE_GROUP_MAC_INDIR "mInD"
 #define TRACE_GROUP "mInD"
 
+static uint8_t mac_indirect_hash(uint8_t addr_mode, const uint8_t *address)
+{
+    uint8_t len = (addr_mode == MAC_ADDR_MODE_16_BIT) ? 2 : (addr_mode == MAC_ADDR_MODE_64_BIT) ? 8 : 0;
+    uint8_t hash = addr_mode;
+    for (uint8_t i = 0; i < len; i++) {
+        hash = (hash * 31) + address[i];
+    }
+    return hash & (MAC_INDIRECT_HASH_SIZE - 1);
+}
+
+static mac_pre_build_frame_t *mac_indirect_queue_discover(protocol_interface_rf_mac_setup_s *rf_mac_setup, uint8_t addr_mode, const uint8_t *address)
+{
+    uint8_t len = (addr_mode == MAC_ADDR_MODE_16_BIT) ? 2 : 8;
+    mac_pre_build_frame_t *b = rf_mac_setup->indirect_pd_data_request_queue[mac_indirect_hash(addr_mode, address)];
+    while (b) {
+        if (b->fcf_dsn.DstAddrMode == addr_mode && memcmp(b->DstAddr, address, len) == 0) {
+            return b;
+        }
+        b = b->next;
+    }
+    return NULL;
+}
+
+static void mac_indirect_queue_remove(protocol_interface_rf_mac_setup_s *rf_mac_setup, mac_pre_build_frame_t *buffer)
+{
+    mac_pre_build_frame_t **next = &rf_mac_setup->indirect_pd_data_request_queue[mac_indirect_hash(buffer->fcf_dsn.DstAddrMode, buffer->DstAddr)];
+    while (*next) {
+        if (*next == buffer) {
+            *next = buffer->next;
+            buffer->next = NULL;
+            rf_mac_setup->indirect_pd_data_request_count--;
+            rf_mac_setup->indirect_pending_bytes -= buffer->mac_payload_length;
+            return;
+        }
+        next = &(*next)->next;
+    }
+}
+
 void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16_t tick_value)
 {
     if (!cur || !cur->dev_driver) {
@@ -50,7 +88,7 @@ void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16
     memset(&confirm, 0, sizeof(mcps_data_conf_t));
 
     phy_device_driver_s *dev_driver = cur->dev_driver->phy_driver;
-    if (!cur->indirect_pd_data_request_queue) {
+    if (!cur->indirect_pd_data_request_count) {
         uint8_t value = 0;
         if (dev_driver && dev_driver->extension) {
             dev_driver->extension(PHY_EXTENSION_CTRL_PENDING_BIT, &value);
@@ -58,37 +96,33 @@ void mac_indirect_data_ttl_handle(protocol_interface_rf_mac_setup_s *cur, uint16
         cur->mac_frame_pending = false;
         return;
     }
-    mac_pre_build_frame_t *buf, *buf_prev = 0, *buf_temp = 0;
+    mac_pre_build_frame_t *buf, *buf_temp = 0;
 
     mac_api_t *api = get_sw_mac_api(cur);
     if (!api) {
         return;
     }
 
-    buf = cur->indirect_pd_data_request_queue;
-
     tick_value /= 20; //Covert time ms
     if (tick_value == 0) {
         tick_value = 1;
     }
 
-    while (buf) {
-        if (buf->buffer_ttl > tick_value) {
-            buf->buffer_ttl -= tick_value;
-            buf_prev = buf;
-            buf = buf->next;
-        } else {
-            buf->buffer_ttl = 0;
-            if (buf_prev) {
-                buf_prev->next = buf->next;
-            } else {
-                cur->indirect_pd_data_request_queue = buf->next;
+    for (uint8_t i = 0; i < MAC_INDIRECT_HASH_SIZE; i++) {
+        mac_pre_build_frame_t **next = &cur->indirect_pd_data_request_queue[i];
+        while ((buf = *next) != NULL) {
+            if (buf->buffer_ttl > tick_value) {
+                buf->buffer_ttl -= tick_value;
+                next = &buf->next;
+                continue;
             }
 
+            buf->buffer_ttl = 0;
+            *next = buf->next;
             confirm.msduHandle = buf->msduHandle;
             buf_temp = buf;
-            buf = buf->next;
             buf_temp->next = NULL;
+            cur->indirect_pd_data_request_count--;
             cur->indirect_pending_bytes -= buf_temp->mac_payload_length;
 
             confirm.status = MLME_TRANSACTION_EXPIRED;
@@ -148,64 +182,36 @@ uint8_t mac_indirect_data_req_handle(mac_pre_parsed_frame_t *buf, protocol_inter
 
     /* If the Ack we sent for the Data Request didn't have frame pending set, we shouldn't transmit - child may have slept */
     if (!buf->ack_pendinfg_status) {
-        if (mac_ptr->indirect_pd_data_request_queue) {
+        if (mac_ptr->indirect_pd_data_request_count) {
             tr_error("Wrongly dropped");
         }
         //Free Buffer
         return 1;
     }
 
-    uint8_t address_cmp_ok = 0;
-    uint8_t len;
-    mac_pre_build_frame_t *b_prev = NULL;
+    mac_pre_build_frame_t *b;
 
-    if (buf->fcf_dsn.SrcAddrMode == MAC_ADDR_MODE_16_BIT) {
-        len = 2;
+    if (buf->neigh_info) {
+        // Neighbour may be addressed by both addresses: oldest frame first
+        uint8_t short_address[2];
+        common_write_16_bit(buf->neigh_info->ShortAddress, short_address);
+        b = mac_indirect_queue_discover(mac_ptr, MAC_ADDR_MODE_16_BIT, short_address);
+        mac_pre_build_frame_t *b_ext = mac_indirect_queue_discover(mac_ptr, MAC_ADDR_MODE_64_BIT, buf->neigh_info->ExtAddress);
+        if (!b || (b_ext && (int16_t)(b_ext->indirect_sequence - b->indirect_sequence) < 0)) {
+            b = b_ext;
+        }
     } else {
-        len = 8;
+        b = mac_indirect_queue_discover(mac_ptr, buf->fcf_dsn.SrcAddrMode, srcAddress);
     }
 
-    mac_pre_build_frame_t *b = mac_ptr->indirect_pd_data_request_queue;
-    while (b) {
-
-        if (buf->neigh_info) {
-            uint16_t compare_short;
-            if (b->fcf_dsn.DstAddrMode == MAC_ADDR_MODE_16_BIT) {
-
-                compare_short = common_read_16_bit(b->DstAddr);
-                if (compare_short == buf->neigh_info->ShortAddress) {
-                    address_cmp_ok = 1;
-                }
-            } else {
-                if (memcmp(b->DstAddr, buf->neigh_info->ExtAddress, 8) == 0) {
-                    address_cmp_ok = 1;
-                }
-            }
-        } else {
-            if (b->fcf_dsn.DstAddrMode == buf->fcf_dsn.SrcAddrMode) {
-                if (memcmp(b->DstAddr, srcAddress, len) == 0) {
-                    address_cmp_ok = 1;
-                }
-            }
-        }
-
-        if (address_cmp_ok) {
-            if (b_prev) {
-                b_prev->next = b->next;
-
-            } else {
-                mac_ptr->indirect_pd_data_request_queue = b->next;
-            }
-            b->next = NULL;
-            b->priority = MAC_PD_DATA_MEDIUM_PRIORITY;
-            mcps_sap_pd_req_queue_write(mac_ptr, b);
-            return 1;
-        } else {
-            b_prev = b;
-            b = b->next;
-        }
+    if (!b) {
+        return 0;
     }
-    return 0;
+
+    mac_indirect_queue_remove(mac_ptr, b);
+    b->priority = MAC_PD_DATA_MEDIUM_PRIORITY;
+    mcps_sap_pd_req_queue_write(mac_ptr, b);
+    return 1;
 }
 
 void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, mac_pre_build_frame_t *buffer)
@@ -216,9 +222,15 @@ void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, m
     rf_mac_setup->indirect_pending_bytes += buffer->mac_payload_length;
     buffer->next = NULL;
     buffer->buffer_ttl = 7100;
-    //Push to queue
-    if (!rf_mac_setup->indirect_pd_data_request_queue) {
-        rf_mac_setup->indirect_pd_data_request_queue = buffer;
+    buffer->indirect_sequence = rf_mac_setup->indirect_sequence++;
+    //Push to end of destination bucket
+    mac_pre_build_frame_t **next = &rf_mac_setup->indirect_pd_data_request_queue[mac_indirect_hash(buffer->fcf_dsn.DstAddrMode, buffer->DstAddr)];
+    while (*next) {
+        next = &(*next)->next;
+    }
+    *next = buffer;
+
+    if (rf_mac_setup->indirect_pd_data_request_count++ == 0) {
         //Trig timer and set pending flag to radio
         eventOS_callback_timer_stop(rf_mac_setup->mac_mcps_timer);
         eventOS_callback_timer_start(rf_mac_setup->mac_mcps_timer, MAC_INDIRECT_TICK_IN_MS * 20);
@@ -227,16 +239,34 @@ void mac_indirect_queue_write(protocol_interface_rf_mac_setup_s *rf_mac_setup, m
             uint8_t value = 1;
             rf_mac_setup->dev_driver->phy_driver->extension(PHY_EXTENSION_CTRL_PENDING_BIT, &value);
         }
-        return;
     }
+}
 
-    mac_pre_build_frame_t *cur = rf_mac_setup->indirect_pd_data_request_queue;
-    while (cur) {
-        if (cur->next == NULL) {
-            cur->next = buffer;
-            cur = NULL;
-        } else {
-            cur = cur->next;
+bool mac_indirect_queue_purge(protocol_interface_rf_mac_setup_s *rf_mac_setup, uint8_t msduhandle)
+{
+    for (uint8_t i = 0; i < MAC_INDIRECT_HASH_SIZE; i++) {
+        mac_pre_build_frame_t *b = rf_mac_setup->indirect_pd_data_request_queue[i];
+        while (b) {
+            if (b->fcf_dsn.frametype == MAC_FRAME_DATA && b->msduHandle == msduhandle) {
+                mac_indirect_queue_remove(rf_mac_setup, b);
+                mcps_sap_prebuild_frame_buffer_free(b);
+                return true;
+            }
+            b = b->next;
+        }
+    }
+    return false;
+}
+
+void mac_indirect_queue_flush(protocol_interface_rf_mac_setup_s *rf_mac_setup)
+{
+    for (uint8_t i = 0; i < MAC_INDIRECT_HASH_SIZE; i++) {
+        while (rf_mac_setup->indirect_pd_data_request_queue[i]) {
+            mac_pre_build_frame_t *buffer = rf_mac_setup->indirect_pd_data_request_queue[i];
+            rf_mac_setup->indirect_pd_data_request_queue[i] = buffer->next;
+            mcps_sap_prebuild_frame_buffer_free(buffer);
         }
     }
+    rf_mac_setup->indirect_pd_data_request_count = 0;
+    rf_mac_setup->indirect_pending_bytes = 0;
 }
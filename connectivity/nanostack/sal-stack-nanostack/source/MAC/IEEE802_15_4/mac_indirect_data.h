@@ -33,5 +33,7 @@ struct mac_pre_parsed_frame_s;
 void mac_indirect_data_ttl_handle(struct protocol_interface_rf_mac_setup *cur, uint16_t tick_value);
 uint8_t mac_indirect_data_req_handle(struct mac_pre_parsed_frame_s *buf, struct protocol_interface_rf_mac_setup *mac_ptr);
 void mac_indirect_queue_write(struct protocol_interface_rf_mac_setup *rf_mac_setup, struct mac_pre_build_frame *buffer);
+bool mac_indirect_queue_purge(struct protocol_interface_rf_mac_setup *rf_mac_setup, uint8_t msduhandle);
+void mac_indirect_queue_flush(struct protocol_interface_rf_mac_setup *rf_mac_setup);
 
 #endif /* MAC_INDIRECT_DATA_H_ */
@@ -2547,13 +2547,7 @@ void mac_mcps_buffer_queue_free(protocol_interface_rf_mac_setup_s *rf_mac_setup)
         }
     }
 
-    while (rf_mac_setup->indirect_pd_data_request_queue) {
-        mac_pre_build_frame_t *buffer = rf_mac_setup->indirect_pd_data_request_queue;
-        if (buffer) {
-            rf_mac_setup->indirect_pd_data_request_queue = buffer->next;
-            mcps_sap_prebuild_frame_buffer_free(buffer);
-        }
-    }
+    mac_indirect_queue_flush(rf_mac_setup);
 }
 /**
  * Function return list start pointer
@@ -2592,7 +2586,7 @@ static bool mcps_sap_purge_req_from_queue(protocol_interface_rf_mac_setup_s *rf_
     rf_mac_setup->pd_data_request_queue_to_go = mcps_sap_purge_from_list(rf_mac_setup->pd_data_request_queue_to_go, msduhandle, &status);
 
     if (!status) {
-        rf_mac_setup->indirect_pd_data_request_queue = mcps_sap_purge_from_list(rf_mac_setup->indirect_pd_data_request_queue, msduhandle, &status);
+        status = mac_indirect_queue_purge(rf_mac_setup, msduhandle);
     }
 
     return status;
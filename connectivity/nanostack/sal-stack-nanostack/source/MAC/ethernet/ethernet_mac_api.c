@@ -39,6 +39,12 @@ static eth_mac_internal_t mac_store = { //Hack only at this point, later put int
     .tasklet_id = -1
 };
 
+/* Indication of a received frame, keeping the block of the driver if the msdu is in it */
+typedef struct eth_mac_data_ind_s {
+    eth_data_ind_t data_ind;
+    void *block;
+} eth_mac_data_ind_t;
+
 #define ETH_INIT_EVENT 0
 #define ETH_DATA_IND_EVENT 1
 #define ETH_DATA_CNF_EVENT 2
@@ -57,6 +63,7 @@ static int8_t iid64_address_set(const eth_mac_api_t *api, const uint8_t *iid64);
 static int8_t iid64_address_get(const eth_mac_api_t *api, uint8_t *iid64_buf);
 
 static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id);
+static int8_t eth_mac_net_phy_rx_buffer(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id);
 static int8_t eth_mac_net_phy_tx_done(int8_t driver_id, uint8_t tx_handle, phy_link_tx_status_e status, uint8_t cca_retry, uint8_t tx_retry);
 static void ethernet_mac_tasklet(arm_event_s *event);
 
@@ -164,6 +171,7 @@ eth_mac_api_t *ethernet_mac_create(int8_t driver_id)
         mac_store.tasklet_id = eventOS_event_handler_create(&ethernet_mac_tasklet, ETH_INIT_EVENT);
     }
     arm_net_phy_init(driver->phy_driver, &eth_mac_net_phy_rx, &eth_mac_net_phy_tx_done);
+    arm_net_phy_rx_buffer_cb_set(driver->phy_driver, &eth_mac_net_phy_rx_buffer);
 
     return this;
 }
@@ -174,10 +182,10 @@ static void ethernet_mac_tasklet(arm_event_s *event)
 
     switch (event_type) {
         case ETH_DATA_IND_EVENT: {
-            eth_data_ind_t *data_ind = event->data_ptr;
-            mac_store.mac_api->data_ind_cb(mac_store.mac_api, data_ind);
-            ns_dyn_mem_free(((eth_data_ind_t *)event->data_ptr)->msdu);
-            ns_dyn_mem_free(event->data_ptr);
+            eth_mac_data_ind_t *ind = event->data_ptr;
+            mac_store.mac_api->data_ind_cb(mac_store.mac_api, &ind->data_ind);
+            ns_dyn_mem_free(ind->block ? ind->block : ind->data_ind.msdu);
+            ns_dyn_mem_free(ind);
             break;
         }
         case ETH_DATA_CNF_EVENT: {
@@ -207,6 +215,16 @@ static int8_t eth_mac_api_init(eth_mac_api_t *api, eth_mac_data_confirm *conf_cb
     return 0;
 }
 
+/* Drivers taking over blocks get a new one for each frame, others get the MTU buffer */
+static uint8_t *eth_mac_tx_frame_get(const phy_device_driver_s *phy_driver, uint16_t length, void **block)
+{
+    if (!phy_driver->tx_buffer) {
+        return mac_store.mtu_ptr;
+    }
+    *block = ns_dyn_mem_temporary_alloc(length);
+    return *block;
+}
+
 static void data_req(const eth_mac_api_t *api, const eth_data_req_t *data)
 {
     if (mac_store.mac_api != api || !mac_store.dev_driver->phy_driver || !data  || !data->msduLength) {
@@ -214,18 +232,24 @@ static void data_req(const eth_mac_api_t *api, const eth_data_req_t *data)
     }
 
 
+    phy_device_driver_s *phy_driver = mac_store.dev_driver->phy_driver;
     uint8_t *data_ptr;
     uint16_t data_length;
+    // Frame built in a block handed over to the driver, instead of a copy of the MTU buffer
+    void *block = NULL;
 
     //Build header
-    switch (mac_store.dev_driver->phy_driver->link_type) {
+    switch (phy_driver->link_type) {
         case PHY_LINK_ETHERNET_TYPE:
 
             if (data->msduLength + ETHERNET_HDRLEN > mac_store.mtu_size || !data->dstAddress || !data->srcAddress) {
                 return;
             }
 
-            data_ptr = mac_store.mtu_ptr;
+            data_ptr = eth_mac_tx_frame_get(phy_driver, data->msduLength + ETHERNET_HDRLEN, &block);
+            if (!data_ptr) {
+                return;
+            }
             data_length = data->msduLength + ETHERNET_HDRLEN;
             memcpy(data_ptr + ETHERNET_HDROFF_DST_ADDR, data->dstAddress, 6);
             memcpy(data_ptr + ETHERNET_HDROFF_SRC_ADDR, data->srcAddress, 6);
@@ -237,7 +261,10 @@ static void data_req(const eth_mac_api_t *api, const eth_data_req_t *data)
             if (data->msduLength + 4 > mac_store.mtu_size) {
                 return;
             }
-            data_ptr = mac_store.mtu_ptr;
+            data_ptr = eth_mac_tx_frame_get(phy_driver, data->msduLength + 4, &block);
+            if (!data_ptr) {
+                return;
+            }
             /* TUN header
              * [ TUN FLAGS 2B | PROTOCOL 2B | PAYLOAD ]
              * Tun flags may be 0, and protocol is same as in ether-type field, so
@@ -256,35 +283,41 @@ static void data_req(const eth_mac_api_t *api, const eth_data_req_t *data)
     }
 
     mac_store.active_data_request = true;
-    mac_store.dev_driver->phy_driver->tx(data_ptr, data_length, 0, PHY_LAYER_PAYLOAD);
+    if (block) {
+        phy_driver->tx_buffer(block, data_ptr, data_length, 0, PHY_LAYER_PAYLOAD);
+    } else {
+        phy_driver->tx(data_ptr, data_length, 0, PHY_LAYER_PAYLOAD);
+    }
 }
 
-static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
+/* Takes over block, free or keeps it in all cases */
+static int8_t eth_mac_rx(void *block, const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
 {
     arm_device_driver_list_s *driver = arm_net_phy_driver_pointer(driver_id);
     if (!data_ptr || !driver || driver != mac_store.dev_driver) {
-        return -1;
+        goto fail;
     }
 
     if (data_len == 0) {
-        return -1;
+        goto fail;
     }
 
     if (!ns_monitor_packet_allocation_allowed()) {
         // stack can not handle new packets for routing
-        return -1;
+        goto fail;
     }
 
-    eth_data_ind_t *data_ind = ns_dyn_mem_temporary_alloc(sizeof(eth_data_ind_t));
-    if (!data_ind) {
-        return -1;
+    eth_mac_data_ind_t *ind = ns_dyn_mem_temporary_alloc(sizeof(eth_mac_data_ind_t));
+    if (!ind) {
+        goto fail;
     }
-    memset(data_ind, 0, sizeof(eth_data_ind_t));
+    memset(ind, 0, sizeof(eth_mac_data_ind_t));
+    eth_data_ind_t *data_ind = &ind->data_ind;
 
     if (driver->phy_driver->link_type == PHY_LINK_ETHERNET_TYPE) {
         if (data_len < ETHERNET_HDRLEN + 1) {
-            ns_dyn_mem_free(data_ind);
-            return -1;
+            ns_dyn_mem_free(ind);
+            goto fail;
         }
 
         memcpy(data_ind->dstAddress, data_ptr +  ETHERNET_HDROFF_DST_ADDR, 6);
@@ -297,8 +330,8 @@ static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uin
 
     } else if (driver->phy_driver->link_type == PHY_LINK_TUN) {
         if (data_len < 5) {
-            ns_dyn_mem_free(data_ind);
-            return -1;
+            ns_dyn_mem_free(ind);
+            goto fail;
         }
         /* TUN header
          * [ TUN FLAGS 2B | PROTOCOL 2B | PAYLOAD ]
@@ -312,12 +345,18 @@ static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uin
         data_ind->etehernet_type = ETHERTYPE_IPV6;
     }
 
-    data_ind->msdu = ns_dyn_mem_temporary_alloc(data_len);
-    if (!data_ind->msdu) {
-        ns_dyn_mem_free(data_ind);
-        return -1;
+    if (block) {
+        // Frame stays in the block of the driver
+        ind->block = block;
+        data_ind->msdu = (uint8_t *) data_ptr;
+    } else {
+        data_ind->msdu = ns_dyn_mem_temporary_alloc(data_len);
+        if (!data_ind->msdu) {
+            ns_dyn_mem_free(ind);
+            return -1;
+        }
+        memcpy(data_ind->msdu, data_ptr, data_len);
     }
-    memcpy(data_ind->msdu, data_ptr, data_len);
     data_ind->msduLength = data_len;
     data_ind->dbm = dbm;
     data_ind->link_quality = link_quality;
@@ -326,18 +365,32 @@ static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uin
         .receiver = mac_store.tasklet_id,
         .sender = 0,
         .event_id = 0,
-        .data_ptr = data_ind,
+        .data_ptr = ind,
         .event_type = ETH_DATA_IND_EVENT,
         .priority = ARM_LIB_HIGH_PRIORITY_EVENT,
     };
 
     if (eventOS_event_send(&event)) {
-        ns_dyn_mem_free(data_ind->msdu);
-        ns_dyn_mem_free(data_ind);
+        ns_dyn_mem_free(block ? block : data_ind->msdu);
+        ns_dyn_mem_free(ind);
         return -1;
     }
 
     return 0;
+
+fail:
+    ns_dyn_mem_free(block);
+    return -1;
+}
+
+static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
+{
+    return eth_mac_rx(NULL, data_ptr, data_len, link_quality, dbm, driver_id);
+}
+
+static int8_t eth_mac_net_phy_rx_buffer(void *block_ptr, uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
+{
+    return eth_mac_rx(block_ptr, data_ptr, data_len, link_quality, dbm, driver_id);
 }
 
 static int8_t eth_mac_net_phy_tx_done(int8_t driver_id, uint8_t tx_handle, phy_link_tx_status_e status, uint8_t cca_retry, uint8_t tx_retry)
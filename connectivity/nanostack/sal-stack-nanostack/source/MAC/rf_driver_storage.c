@@ -156,9 +156,18 @@ int8_t arm_net_phy_init(phy_device_driver_s *phy_driver, arm_net_phy_rx_fn *rx_c
     }
     phy_driver->phy_rx_cb = rx_cb;
     phy_driver->phy_tx_done_cb = done_cb;
+    phy_driver->phy_rx_buffer_cb = NULL;
     return 0;
 }
 
+void arm_net_phy_rx_buffer_cb_set(phy_device_driver_s *phy_driver, arm_net_phy_rx_buffer_fn *rx_buffer_cb)
+{
+    if (!phy_driver) {
+        return;
+    }
+    phy_driver->phy_rx_buffer_cb = rx_buffer_cb;
+}
+
 void arm_net_observer_cb_set(int8_t id, internal_mib_observer *observer_cb)
 {
     arm_device_driver_list_s *driver = arm_net_phy_driver_pointer(id);
@@ -38,6 +38,11 @@ typedef enum {
     STATS_RPL_TIME_NO_NEXT_HOP,
     STATS_RPL_MEMORY_ALLOC,
     STATS_RPL_MEMORY_FREE,
+    STATS_RPL_DAO_TARGET_ADD,
+    STATS_RPL_DAO_TARGET_REMOVE,
+    STATS_RPL_DAO_REFRESH,
+    STATS_RPL_TOPO_SORT,
+    STATS_RPL_ROUTE_COMPUTE,
     STATS_BUFFER_ALLOC,
     STATS_BUFFER_HEADROOM_REALLOC,
     STATS_BUFFER_HEADROOM_SHUFFLE,
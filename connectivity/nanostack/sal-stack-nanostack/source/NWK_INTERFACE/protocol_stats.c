@@ -123,6 +123,26 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->rpl_total_memory -= update_val;
                 break;
 
+            case STATS_RPL_DAO_TARGET_ADD:
+                nwk_stats_ptr->rpl_dao_targets += update_val;
+                break;
+
+            case STATS_RPL_DAO_TARGET_REMOVE:
+                nwk_stats_ptr->rpl_dao_targets -= update_val;
+                break;
+
+            case STATS_RPL_DAO_REFRESH:
+                nwk_stats_ptr->rpl_dao_refresh += update_val;
+                break;
+
+            case STATS_RPL_TOPO_SORT:
+                nwk_stats_ptr->rpl_topo_sort += update_val;
+                break;
+
+            case STATS_RPL_ROUTE_COMPUTE:
+                nwk_stats_ptr->rpl_route_compute += update_val;
+                break;
+
             case STATS_BUFFER_ALLOC:
                 nwk_stats_ptr->buf_alloc++;
                 break;
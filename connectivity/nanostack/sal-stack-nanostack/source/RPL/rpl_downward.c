@@ -90,6 +90,7 @@
 
 #include "Common_Protocols/icmpv6.h"
 #include "NWK_INTERFACE/Include/protocol.h"
+#include "NWK_INTERFACE/Include/protocol_stats.h"
 #include "ipv6_stack/ipv6_routing_table.h"
 
 #include "net_rpl.h"
@@ -266,6 +267,15 @@ void rpl_downward_process_dao_parent_changes(rpl_instance_t *instance)
     }
 }
 
+static rpl_dao_target_t **rpl_downward_target_bucket(rpl_instance_t *instance, const uint8_t *address)
+{
+    /* Interface IDs are what vary between the targets of a mesh */
+    uint32_t hash = common_read_32_bit(address + 8) ^ common_read_32_bit(address + 12);
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &instance->dao_target_hash[hash & (RPL_DAO_TARGET_HASH_SIZE - 1)];
+}
+
 rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len, bool root)
 {
     rpl_dao_target_t *target = rpl_alloc(sizeof(rpl_dao_target_t));
@@ -287,6 +297,17 @@ rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t
 #endif
 
     ns_list_add_to_end(&instance->dao_targets, target);
+    if (prefix_len == 128) {
+        /* Added at the end of the chain, so lookups find targets in list order */
+        rpl_dao_target_t **next = rpl_downward_target_bucket(instance, prefix);
+        while (*next) {
+            next = &(*next)->hash_next;
+        }
+        *next = target;
+    } else {
+        instance->dao_prefix_target_count++;
+    }
+    protocol_stats_update(STATS_RPL_DAO_TARGET_ADD, 1);
     return target;
 }
 
@@ -297,9 +318,26 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
     /* TODO - should send a No-Path to root */
 
     ns_list_remove(&instance->dao_targets, target);
+    if (target->prefix_len == 128) {
+        rpl_dao_target_t **next = rpl_downward_target_bucket(instance, target->prefix);
+        while (*next != target) {
+            next = &(*next)->hash_next;
+        }
+        *next = target->hash_next;
+    } else {
+        instance->dao_prefix_target_count--;
+    }
+    protocol_stats_update(STATS_RPL_DAO_TARGET_REMOVE, 1);
 
 #ifdef HAVE_RPL_ROOT
     if (target->root) {
+        if (target->transits_stale) {
+            rpl_dao_target_t **next = &instance->dao_stale_targets;
+            while (*next != target) {
+                next = &(*next)->stale_next;
+            }
+            *next = target->stale_next;
+        }
         ns_list_foreach_safe(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
             ns_list_remove(&target->info.root.transits, transit);
             rpl_free(transit, sizeof * transit);
@@ -313,6 +351,15 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
 
 rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (prefix_len == 128) {
+        for (rpl_dao_target_t *target = *rpl_downward_target_bucket(instance, prefix); target; target = target->hash_next) {
+            if (target->published && addr_ipv6_equal(target->prefix, prefix)) {
+                return target;
+            }
+        }
+        return NULL;
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->published && target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -324,6 +371,15 @@ rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *insta
 
 rpl_dao_target_t *rpl_instance_lookup_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (prefix_len == 128) {
+        for (rpl_dao_target_t *target = *rpl_downward_target_bucket(instance, prefix); target; target = target->hash_next) {
+            if (addr_ipv6_equal(target->prefix, prefix)) {
+                return target;
+            }
+        }
+        return NULL;
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -335,6 +391,14 @@ rpl_dao_target_t *rpl_instance_lookup_dao_target(rpl_instance_t *instance, const
 
 rpl_dao_target_t *rpl_instance_match_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    /* Host routes are the bulk of a large mesh - an exact match wins outright */
+    if (prefix_len == 128) {
+        rpl_dao_target_t *target = rpl_instance_lookup_dao_target(instance, prefix, 128);
+        if (target || instance->dao_prefix_target_count == 0) {
+            return target;
+        }
+    }
+
     rpl_dao_target_t *longest = NULL;
     int_fast16_t longest_len = -1;
 
@@ -940,36 +1004,43 @@ static uint_fast8_t rpl_downward_path_control_to_preference(uint8_t pc)
 static rpl_dao_root_transit_t *rpl_downward_add_root_transit(rpl_dao_target_t *target, const uint8_t parent[16], uint8_t path_control)
 {
     //rpl_dao_root_transit_t *old_first = ns_list_get_first(&target->info.root.transits);
-    rpl_dao_root_transit_t *transit = NULL;
     ns_list_foreach(rpl_dao_root_transit_t, t, &target->info.root.transits) {
         if (addr_ipv6_equal(t->transit, parent)) {
-            ns_list_remove(&target->info.root.transits, t);
-            transit = t;
-            /* Updating existing transit - invalidates costs only */
-            rpl_downward_paths_invalidate(target->instance);
-            break;
+            /* A new path sequence restarts the Path Control accumulation */
+            uint8_t new_path_control = t->stale ? path_control : t->path_control | path_control;
+            /* Initial transit cost is 1-4, depending on preference in Path Control.
+             * Source routing errors from intermediate nodes may increase this,
+             * and a refresh resets it. For directly connected nodes,
+             * rpl_downward_compute_paths asks policy to modify according to
+             * ETX (or whatever).
+             */
+            uint16_t new_cost = rpl_downward_path_control_to_preference(new_path_control);
+            t->stale = false;
+            if (t->path_control == new_path_control && t->cost == new_cost) {
+                /* Periodic refresh of an unchanged path - keep computed paths */
+                protocol_stats_update(STATS_RPL_DAO_REFRESH, 1);
+            } else {
+                /* Updating existing transit - invalidates costs only */
+                t->path_control = new_path_control;
+                t->cost = new_cost;
+                rpl_downward_paths_invalidate(target->instance);
+            }
+            return ns_list_get_first(&target->info.root.transits);
         }
     }
 
+    rpl_dao_root_transit_t *transit = rpl_alloc(sizeof(rpl_dao_root_transit_t));
     if (!transit) {
-        transit = rpl_alloc(sizeof(rpl_dao_root_transit_t));
-        if (!transit) {
-            tr_warn("RPL DAO overflow (target=%s,transit=%s)", trace_ipv6_prefix(target->prefix, target->prefix_len), trace_ipv6(parent));
-            goto out;
-        }
-        transit->path_control = 0;
-        /* A new transit invalidates the topo sort */
-        rpl_downward_topo_sort_invalidate(target->instance);
+        tr_warn("RPL DAO overflow (target=%s,transit=%s)", trace_ipv6_prefix(target->prefix, target->prefix_len), trace_ipv6(parent));
+        goto out;
     }
+    /* A new transit invalidates the topo sort */
+    rpl_downward_topo_sort_invalidate(target->instance);
 
     transit->target = target;
-    transit->path_control |= path_control;
-    /* Initial transit cost is 1-4, depending on preference in Path Control.
-     * Source routing errors from intermediate nodes may increase this. For
-     * directly connected nodes, rpl_downward_compute_paths asks policy
-     * to modify according to ETX (or whatever).
-     */
+    transit->path_control = path_control;
     transit->cost = rpl_downward_path_control_to_preference(transit->path_control);
+    transit->stale = false;
 
     memcpy(transit->transit, parent, 16);
     ns_list_add_to_end(&target->info.root.transits, transit);
@@ -978,6 +1049,27 @@ out:
     return ns_list_get_first(&target->info.root.transits);
 }
 
+/* A new path sequence replaces the transits of a target. Rather than deleting
+ * them straight away, mark them stale: the transits the DAO carries again are
+ * then refreshed in place, and only the ones it drops are deleted once the
+ * whole DAO is processed, so DAOs repeating the same paths leave the topology
+ * and paths computed intact.
+ */
+static void rpl_downward_mark_root_transits_stale(rpl_dao_target_t *target)
+{
+    if (ns_list_is_empty(&target->info.root.transits)) {
+        return;
+    }
+    ns_list_foreach(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
+        transit->stale = true;
+    }
+    if (!target->transits_stale) {
+        target->transits_stale = true;
+        target->stale_next = target->instance->dao_stale_targets;
+        target->instance->dao_stale_targets = target;
+    }
+}
+
 static rpl_dao_target_t *rpl_downward_delete_root_transit(rpl_dao_target_t *target, rpl_dao_root_transit_t *transit)
 {
     ns_list_remove(&target->info.root.transits, transit);
@@ -991,6 +1083,23 @@ static rpl_dao_target_t *rpl_downward_delete_root_transit(rpl_dao_target_t *targ
     return target;
 }
 
+static void rpl_downward_delete_stale_root_transits(rpl_instance_t *instance)
+{
+    while (instance->dao_stale_targets) {
+        rpl_dao_target_t *target = instance->dao_stale_targets;
+        instance->dao_stale_targets = target->stale_next;
+        target->transits_stale = false;
+        ns_list_foreach_safe(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
+            if (transit->stale) {
+                if (!rpl_downward_delete_root_transit(target, transit)) {
+                    /* Target deleted with its last transit */
+                    break;
+                }
+            }
+        }
+    }
+}
+
 void rpl_downward_transit_error(rpl_instance_t *instance, const uint8_t *target_addr, const uint8_t *transit_addr)
 {
     ns_list_foreach_safe(rpl_dao_target_t, target, &instance->dao_targets) {
@@ -1126,10 +1235,7 @@ static bool rpl_downward_process_targets_for_transit(rpl_dodag_t *dodag, bool st
                     /* If path sequence is different, we clear existing transits for this target */
                     if (!(seq_cmp & RPL_CMP_EQUAL)) {
                         if (target->root) {
-                            ns_list_foreach_safe(rpl_dao_root_transit_t, transit, &target->info.root.transits) {
-                                ns_list_remove(&target->info.root.transits, transit);
-                                rpl_free(transit, sizeof * transit);
-                            }
+                            rpl_downward_mark_root_transits_stale(target);
                         }
                         if (storing) {
                             ipv6_route_table_remove_info(-1, ROUTE_RPL_DAO, target);
@@ -1349,6 +1455,7 @@ static void rpl_downward_topo_sort(rpl_instance_t *instance)
         return;
     }
 
+    protocol_stats_update(STATS_RPL_TOPO_SORT, 1);
     rpl_downward_link_transits_to_targets(instance);
 
     rpl_dao_target_list_t sorted = NS_LIST_INIT(sorted);
@@ -1430,6 +1537,8 @@ void rpl_downward_compute_paths(rpl_instance_t *instance)
         return;
     }
 
+    protocol_stats_update(STATS_RPL_ROUTE_COMPUTE, 1);
+
     /* First get targets into a topological sort - also breaks loops */
     rpl_downward_topo_sort(instance);
 
@@ -1529,6 +1638,10 @@ bool rpl_instance_dao_received(rpl_instance_t *instance, const uint8_t src[16],
         start += 2 + start[1];
     }
 
+#ifdef HAVE_RPL_ROOT
+    rpl_downward_delete_stale_root_transits(instance);
+#endif
+
     if (new_info && storing) {
         rpl_instance_dao_trigger(instance, 0);
     }
@@ -105,6 +105,7 @@ typedef struct rpl_dao_root_transit {
     rpl_dao_target_t *target;
     uint8_t path_control;
     uint16_t cost;
+    bool stale;                         /* Replaced by a new path sequence, deleted unless the DAO refreshes it */
     ns_list_link_t parent_link;
     ns_list_link_t target_link;
 } rpl_dao_root_transit_t;
@@ -149,6 +150,9 @@ struct rpl_dao_target {
     bool connected: 1;                  /* We know this target has a path to the root */
     bool trig_confirmation_state: 1;         /* Enable confirmation to parent's */
     bool active_confirmation_state: 1;
+    bool transits_stale: 1;             /* Some transits are stale - in instance's stale list (root) */
+    rpl_dao_target_t *hash_next;        /* Next /128 target in the same instance hash bucket */
+    rpl_dao_target_t *stale_next;       /* Next target in the instance's stale list */
     union {
 #ifdef HAVE_RPL_ROOT
         rpl_dao_root_t root;            /* Info specific to a non-storing root */
@@ -160,6 +164,9 @@ struct rpl_dao_target {
 
 typedef NS_LIST_HEAD(rpl_dao_target_t, link) rpl_dao_target_list_t;
 
+/* Buckets of the hash of /128 DAO targets - must be a power of 2 */
+#define RPL_DAO_TARGET_HASH_SIZE 32
+
 /* Descriptor for a RPL Instance. An instance can have multiple DODAGs.
  *
  * If top bit of instance_id is set then it's a local DODAG, and the dodags
@@ -195,6 +202,9 @@ struct rpl_instance {
     trickle_t dio_timer;                            /* Trickle timer for DIO transmission */
     rpl_dao_root_transit_children_list_t root_children;
     rpl_dao_target_list_t dao_targets;              /* List of DAO targets */
+    rpl_dao_target_t *dao_target_hash[RPL_DAO_TARGET_HASH_SIZE]; /* /128 DAO targets, by address */
+    uint16_t dao_prefix_target_count;               /* DAO targets shorter than /128, not in hash */
+    rpl_dao_target_t *dao_stale_targets;            /* Targets with stale transits while processing a DAO */
     uint8_t dao_sequence;                           /* Next DAO sequence to use */
     uint8_t dao_sequence_in_transit;                /* DAO sequence in transit (if dao_in_transit) */
     uint16_t delay_dao_timer;
@@ -42,6 +42,28 @@
 #include <string.h>
 #include "ccmLIB.h"
 #include "platform/arm_hal_aes.h"
+#include "platform/arm_hal_interrupt.h"
+
+#ifdef NS_USE_EXTERNAL_MBED_TLS
+#include "mbedtls/ccm.h"
+#endif
+
+#if defined(MBEDTLS_CCM_C) && defined(MBEDTLS_CCM_ALT)
+/* With an accelerated CCM in mbed TLS, the levels with encryption and MIC
+ * process whole frames in it, and the other levels use the AES block path.
+ * CCM contexts stay keyed between frames, like the AES contexts.
+ */
+#define CCM_HW_CONTEXT_COUNT ARM_AES_MBEDTLS_CONTEXT_MIN
+
+typedef struct {
+    mbedtls_ccm_context ctx;
+    uint8_t key[16];
+    bool keyed;
+    bool reserved;
+} ccm_hw_context_t;
+
+static ccm_hw_context_t ccm_hw_context_list[CCM_HW_CONTEXT_COUNT];
+#endif
 
 static void ccm_generate_A0(uint8_t *ptr, ccm_globals_t *ccm_pramters);
 static void ccm_auth_generate_B0(uint8_t *ptr, ccm_globals_t *ccm_params);
@@ -50,6 +72,80 @@ static uint8_t ccm_mic_len_calc(uint8_t sec_level);
 static void ccm_encode(ccm_globals_t *ccm_params);
 static int8_t ccm_calc_auth_MIC(ccm_globals_t *ccm_params);
 
+#ifdef CCM_HW_CONTEXT_COUNT
+static ccm_hw_context_t *ccm_hw_context_start(const uint8_t *ccm_key)
+{
+    ccm_hw_context_t *context = NULL;
+
+    platform_enter_critical();
+    for (int i = 0; i < CCM_HW_CONTEXT_COUNT; i++) {
+        ccm_hw_context_t *cur = &ccm_hw_context_list[i];
+        if (cur->reserved) {
+            continue;
+        }
+        if (cur->keyed && memcmp(cur->key, ccm_key, 16) == 0) {
+            context = cur;
+            break;
+        }
+        //Prefer a context not keyed yet
+        if (!context || context->keyed) {
+            context = cur;
+        }
+    }
+    if (context) {
+        context->reserved = true;
+    }
+    platform_exit_critical();
+
+    if (!context || (context->keyed && memcmp(context->key, ccm_key, 16) == 0)) {
+        return context;
+    }
+
+    if (context->keyed) {
+        mbedtls_ccm_free(&context->ctx);
+        context->keyed = false;
+    }
+    mbedtls_ccm_init(&context->ctx);
+    if (mbedtls_ccm_setkey(&context->ctx, MBEDTLS_CIPHER_ID_AES, ccm_key, 128) != 0) {
+        mbedtls_ccm_free(&context->ctx);
+        context->reserved = false;
+        return NULL;
+    }
+    memcpy(context->key, ccm_key, 16);
+    context->keyed = true;
+    return context;
+}
+
+static void ccm_hw_context_finish(ccm_hw_context_t *context)
+{
+    platform_enter_critical();
+    context->reserved = false;
+    platform_exit_critical();
+}
+
+static int8_t ccm_hw_process(ccm_globals_t *ccm_params)
+{
+    ccm_hw_context_t *context = ccm_params->ccm_hw_context;
+    size_t nonce_len = 15 - ccm_params->ccm_l_param;
+    int ret;
+
+    if (ccm_params->ccm_encode_mode == AES_CCM_ENCRYPT) {
+        ret = mbedtls_ccm_star_encrypt_and_tag(&context->ctx, ccm_params->data_len,
+                                               ccm_params->exp_nonce, nonce_len,
+                                               ccm_params->adata_ptr, ccm_params->adata_len,
+                                               ccm_params->data_ptr, ccm_params->data_ptr,
+                                               ccm_params->mic, ccm_params->mic_len);
+    } else {
+        ret = mbedtls_ccm_star_auth_decrypt(&context->ctx, ccm_params->data_len,
+                                            ccm_params->exp_nonce, nonce_len,
+                                            ccm_params->adata_ptr, ccm_params->adata_len,
+                                            ccm_params->data_ptr, ccm_params->data_ptr,
+                                            ccm_params->mic, ccm_params->mic_len);
+    }
+    return ret == 0 ? 0 : -1;
+}
+#endif
+
 /**
  * \brief A function to init CCM library.
  * \param sec_level Used CCM security level (0-7).
@@ -65,11 +161,21 @@ bool ccm_sec_init(ccm_globals_t *ccm_context, uint8_t sec_level, const uint8_t *
     memset(ccm_context, 0, sizeof(ccm_globals_t));
 
     if ((ccm_l == 2 || ccm_l == 3) && (sec_level < 8)) {
-        void *aes_context = arm_aes_start(ccm_key);
-        if (!aes_context) {
-            return false;
+#ifdef CCM_HW_CONTEXT_COUNT
+        if (sec_level > AES_SECURITY_LEVEL_ENC) {
+            ccm_context->ccm_hw_context = ccm_hw_context_start(ccm_key);
+            if (!ccm_context->ccm_hw_context) {
+                return false;
+            }
+        }
+#endif
+        if (!ccm_context->ccm_hw_context) {
+            void *aes_context = arm_aes_start(ccm_key);
+            if (!aes_context) {
+                return false;
+            }
+            ccm_context->aes_context = aes_context;
         }
-        ccm_context->aes_context = aes_context;
         ccm_context->ccm_encode_mode = mode;
         ccm_context->ccm_sec_level = sec_level;
         ccm_context->ccm_l_param = ccm_l;
@@ -115,6 +221,13 @@ int8_t ccm_process_run(ccm_globals_t *ccm_params)
         goto END;
     }
 
+#ifdef CCM_HW_CONTEXT_COUNT
+    if (ccm_params->ccm_hw_context) {
+        ret_val = ccm_hw_process(ccm_params);
+        goto END;
+    }
+#endif
+
     if (ccm_params->ccm_encode_mode == AES_CCM_ENCRYPT) {
         if (ccm_params->mic_len) {
             //Calc
@@ -149,6 +262,12 @@ void ccm_free(ccm_globals_t *ccm_params)
     if (ccm_params && ccm_params->aes_context) {
         arm_aes_finish(ccm_params->aes_context);
     }
+#ifdef CCM_HW_CONTEXT_COUNT
+    if (ccm_params && ccm_params->ccm_hw_context) {
+        ccm_hw_context_finish(ccm_params->ccm_hw_context);
+        ccm_params->ccm_hw_context = NULL;
+    }
+#endif
 }
 
 
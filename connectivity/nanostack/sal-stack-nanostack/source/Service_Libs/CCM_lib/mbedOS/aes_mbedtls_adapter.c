@@ -42,6 +42,8 @@
  *     of arm_hal_aes.h, and other users of mbed TLS.
  */
 
+#include <string.h>
+
 /* Get the API we are implementing from libService */
 #include "platform/arm_hal_aes.h"
 #include "platform/arm_hal_interrupt.h"
@@ -55,37 +57,63 @@
 #include "aes_mbedtls.c"
 #endif /* NS_USE_EXTERNAL_MBED_TLS */
 
+/* Contexts stay keyed when finished: a frame secured with the key of the
+ * previous one skips the key schedule, and with MBEDTLS_AES_ALT leaves the
+ * key loaded in the accelerator.
+ */
 struct arm_aes_context {
     mbedtls_aes_context ctx;
+    uint8_t key[16];
+    bool keyed;
     bool reserved;
 };
 
 static arm_aes_context_t context_list[ARM_AES_MBEDTLS_CONTEXT_MIN];
 
-static arm_aes_context_t *mbed_tls_context_get(void)
+static arm_aes_context_t *mbed_tls_context_get(const uint8_t key[static 16], bool *keyed)
 {
+    arm_aes_context_t *free_context = NULL;
+
     platform_enter_critical();
     for (int i = 0; i < ARM_AES_MBEDTLS_CONTEXT_MIN; i++) {
-        if (!context_list[i].reserved) {
-            //Reserve context
-            context_list[i].reserved = true;
-            platform_exit_critical();
-            return &context_list[i];
+        if (context_list[i].reserved) {
+            continue;
+        }
+        if (context_list[i].keyed && memcmp(context_list[i].key, key, 16) == 0) {
+            free_context = &context_list[i];
+            break;
+        }
+        //Prefer a context not keyed yet
+        if (!free_context || free_context->keyed) {
+            free_context = &context_list[i];
         }
     }
 
+    if (free_context) {
+        //Reserve context
+        free_context->reserved = true;
+        *keyed = free_context->keyed && memcmp(free_context->key, key, 16) == 0;
+    }
     platform_exit_critical();
-    return NULL;
+    return free_context;
 }
 
 arm_aes_context_t *arm_aes_start(const uint8_t key[static 16])
 {
-    arm_aes_context_t *context = mbed_tls_context_get();
-    if (context) {
+    bool keyed;
+    arm_aes_context_t *context = mbed_tls_context_get(key, &keyed);
+    if (context && !keyed) {
+        if (context->keyed) {
+            mbedtls_aes_free(&context->ctx);
+            context->keyed = false;
+        }
         mbedtls_aes_init(&context->ctx);
         if (0 != mbedtls_aes_setkey_enc(&context->ctx, key, 128)) {
+            arm_aes_finish(context);
             return NULL;
         }
+        memcpy(context->key, key, 16);
+        context->keyed = true;
     }
     return context;
 }
@@ -97,7 +125,6 @@ void arm_aes_encrypt(arm_aes_context_t *aes_context, const uint8_t src[static 16
 
 void arm_aes_finish(arm_aes_context_t *aes_context)
 {
-    mbedtls_aes_free(&aes_context->ctx);
     platform_enter_critical();
     aes_context->reserved = false;
     platform_exit_critical();
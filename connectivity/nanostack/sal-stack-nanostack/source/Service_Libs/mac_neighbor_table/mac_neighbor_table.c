@@ -26,6 +26,35 @@
 #include "Core/include/ns_address_internal.h"
 #include "platform/topo_trace.h"
 
+static uint8_t neighbor_table_class_mac64_hash(const uint8_t *mac64)
+{
+    uint8_t hash = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        hash = (hash * 31) + mac64[i];
+    }
+    return hash & (MAC_NEIGHBOR_TABLE_HASH_SIZE - 1);
+}
+
+static void neighbor_table_class_hash_add(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *entry)
+{
+    uint8_t *bucket = &table_class->mac64_hash[neighbor_table_class_mac64_hash(entry->mac64)];
+    entry->hash_next = *bucket;
+    *bucket = entry->index;
+}
+
+static void neighbor_table_class_hash_remove(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *entry)
+{
+    uint8_t *next = &table_class->mac64_hash[neighbor_table_class_mac64_hash(entry->mac64)];
+    while (*next != MAC_NEIGHBOR_TABLE_HASH_END) {
+        if (*next == entry->index) {
+            *next = entry->hash_next;
+            break;
+        }
+        next = &table_class->neighbor_entry_buffer[*next].hash_next;
+    }
+    entry->hash_next = MAC_NEIGHBOR_TABLE_HASH_END;
+}
+
 mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_entry_remove_notify *remove_cb, neighbor_entry_nud_notify *nud_cb, void *user_indentifier)
 {
     mac_neighbor_table_t *table_class = ns_dyn_mem_alloc(sizeof(mac_neighbor_table_t) + sizeof(mac_neighbor_table_entry_t) * table_size);
@@ -33,6 +62,7 @@ mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_ent
         return NULL;
     }
     memset(table_class, 0, sizeof(mac_neighbor_table_t));
+    memset(table_class->mac64_hash, MAC_NEIGHBOR_TABLE_HASH_END, sizeof(table_class->mac64_hash));
 
     mac_neighbor_table_entry_t *cur_ptr = &table_class->neighbor_entry_buffer[0];
     table_class->list_total_size = table_size;
@@ -44,6 +74,7 @@ mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_ent
     for (uint8_t i = 0; i < table_size; i++) {
         memset(cur_ptr, 0, sizeof(mac_neighbor_table_entry_t));
         cur_ptr->index = i;
+        cur_ptr->hash_next = MAC_NEIGHBOR_TABLE_HASH_END;
         //Add to list
         ns_list_add_to_end(&table_class->free_list, cur_ptr);
         cur_ptr++;
@@ -73,10 +104,11 @@ static void neighbor_table_class_remove_entry(mac_neighbor_table_t *table_class,
     }
     topo_trace(TOPOLOGY_MLE, entry->mac64, TOPO_REMOVE);
 
-
+    neighbor_table_class_hash_remove(table_class, entry);
     uint8_t index = entry->index;
     memset(entry, 0, sizeof(mac_neighbor_table_entry_t));
     entry->index = index;
+    entry->hash_next = MAC_NEIGHBOR_TABLE_HASH_END;
     ns_list_add_to_end(&table_class->free_list, entry);
 }
 
@@ -137,6 +169,8 @@ mac_neighbor_table_entry_t *mac_neighbor_table_entry_allocate(mac_neighbor_table
     ns_list_add_to_end(&table_class->neighbour_list, entry);
     table_class->neighbour_list_size++;
     memcpy(entry->mac64, mac64, 8);
+    neighbor_table_class_hash_add(table_class, entry);
+    entry->allocated = true;
     entry->mac16 = 0xffff;
     entry->rx_on_idle = true;
     entry->ffd_device = true;
@@ -153,13 +187,12 @@ mac_neighbor_table_entry_t *mac_neighbor_table_entry_allocate(mac_neighbor_table
 
 static mac_neighbor_table_entry_t *neighbor_table_class_entry_validate(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry)
 {
-    ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->neighbour_list) {
-        if (cur == neighbor_entry) {
-            return cur;
-        }
+    if (neighbor_entry < table_class->neighbor_entry_buffer ||
+            neighbor_entry >= table_class->neighbor_entry_buffer + table_class->list_total_size ||
+            !neighbor_entry->allocated) {
+        return NULL;
     }
-    return NULL;
-
+    return neighbor_entry;
 }
 
 void mac_neighbor_table_neighbor_remove(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry)
@@ -197,29 +230,39 @@ void mac_neighbor_table_trusted_neighbor(mac_neighbor_table_t *table_class, mac_
     neighbor_entry->trusted_device = trusted_device;
 }
 
+void mac_neighbor_table_entry_mac64_set(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, const uint8_t *mac64)
+{
+    neighbor_table_class_hash_remove(table_class, neighbor_entry);
+    memcpy(neighbor_entry->mac64, mac64, 8);
+    neighbor_table_class_hash_add(table_class, neighbor_entry);
+}
+
 mac_neighbor_table_entry_t *mac_neighbor_table_address_discover(mac_neighbor_table_t *table_class, const uint8_t *address, uint8_t address_type)
 {
     if (!table_class) {
         return NULL;
     }
-    uint16_t short_address;
-    if (address_type == ADDR_802_15_4_SHORT) {
-        short_address = common_read_16_bit(address);
-    } else if (address_type == ADDR_802_15_4_LONG) {
+    if (address_type == ADDR_802_15_4_LONG) {
+        uint8_t index = table_class->mac64_hash[neighbor_table_class_mac64_hash(address)];
+        while (index != MAC_NEIGHBOR_TABLE_HASH_END) {
+            mac_neighbor_table_entry_t *cur = &table_class->neighbor_entry_buffer[index];
+            if (memcmp(cur->mac64, address, 8) == 0) {
+                return cur;
+            }
+            index = cur->hash_next;
+        }
+        return NULL;
+    }
 
-    } else {
+    if (address_type != ADDR_802_15_4_SHORT) {
         return NULL;
     }
 
+    // MAC16 is written directly by the users: not indexed
+    uint16_t short_address = common_read_16_bit(address);
     ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->neighbour_list) {
-        if (address_type == ADDR_802_15_4_SHORT) {
-            if (cur->mac16 != 0xffff && cur->mac16 == short_address) {
-                return cur;
-            }
-        } else {
-            if (memcmp(cur->mac64, address, 8) == 0) {
-                return cur;
-            }
+        if (cur->mac16 != 0xffff && cur->mac16 == short_address) {
+            return cur;
         }
     }
 
@@ -228,13 +271,10 @@ mac_neighbor_table_entry_t *mac_neighbor_table_address_discover(mac_neighbor_tab
 
 mac_neighbor_table_entry_t *mac_neighbor_table_attribute_discover(mac_neighbor_table_t *table_class, uint8_t index)
 {
-    ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->neighbour_list) {
-
-        if (cur->index == index) {
-            return cur;
-        }
+    if (index >= table_class->list_total_size || !table_class->neighbor_entry_buffer[index].allocated) {
+        return NULL;
     }
-    return NULL;
+    return &table_class->neighbor_entry_buffer[index];
 }
 
 mac_neighbor_table_entry_t *mac_neighbor_entry_get_by_ll64(mac_neighbor_table_t *table_class, const uint8_t *ipv6Address, bool allocateNew, bool *new_entry_allocated)
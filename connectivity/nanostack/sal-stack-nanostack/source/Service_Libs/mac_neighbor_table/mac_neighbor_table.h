@@ -25,6 +25,9 @@
 
 #define ACTIVE_NUD_PROCESS_MAX 3 //Limit That how many activate NUD process is active in same time
 
+#define MAC_NEIGHBOR_TABLE_HASH_SIZE 32 //Buckets of the MAC64 index, power of 2
+#define MAC_NEIGHBOR_TABLE_HASH_END 0xff //End of a bucket chain
+
 #define NORMAL_NEIGHBOUR                0
 #define SECONDARY_PARENT_NEIGHBOUR      1
 #define CHILD_NEIGHBOUR                 2
@@ -45,6 +48,8 @@ typedef struct mac_neighbor_table_entry {
     bool            trusted_device: 1;      /*!< True mean use normal group key, false for enable pairwise key */
     bool            nud_active: 1;          /*!< True Neighbor NUD process is active, false not active process */
     unsigned        link_role: 2;           /*!< Link role: NORMAL_NEIGHBOUR, PRIORITY_PARENT_NEIGHBOUR, SECONDARY_PARENT_NEIGHBOUR, CHILD_NEIGHBOUR */
+    bool            allocated: 1;           /*!< True entry is in neighbour list, false in free list */
+    uint8_t         hash_next;              /*!< Index of next entry in same MAC64 hash bucket */
     ns_list_link_t  link;
 } mac_neighbor_table_entry_t;
 
@@ -85,6 +90,7 @@ typedef struct mac_neighbor_table_class {
     void *table_user_identifier;                            /*!< Table user identifier like interface pointer */
     neighbor_entry_remove_notify *user_remove_notify_cb;    /*!< Neighbor Remove Callback notify */
     neighbor_entry_nud_notify *user_nud_notify_cb;          /*!< Trig NUD process for neighbor */
+    uint8_t mac64_hash[MAC_NEIGHBOR_TABLE_HASH_SIZE];       /*!< First entry index of each MAC64 hash bucket */
     mac_neighbor_table_entry_t neighbor_entry_buffer[];     /*!< Pointer for allocated neighbor table entries*/
 } mac_neighbor_table_t;
 
@@ -177,6 +183,17 @@ void mac_neighbor_table_neighbor_connected(mac_neighbor_table_t *table_class, ma
  */
 void mac_neighbor_table_trusted_neighbor(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, bool trusted_device);
 
+/**
+ * mac_neighbor_table_entry_mac64_set Change MAC64 of an allocated entry
+ *
+ * Entry MAC64 is indexed for discover so it must be changed only by this function
+ *
+ * \param table_class pointer to table class
+ * \param neighbor_entry pointer to changed entry
+ * \param mac64 new MAC64
+ */
+void mac_neighbor_table_entry_mac64_set(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *neighbor_entry, const uint8_t *mac64);
+
 /**
  * mac_neighbor_table_address_discover Discover neighbor from list by address
  *
@@ -587,6 +587,14 @@ nsapi_error_t Nanostack::socket_close(void *handle)
 }
 
 nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *address, const void *data, nsapi_size_t size)
+{
+    nsapi_iovec_t iov;
+    iov.iov_base = const_cast<void *>(data);
+    iov.iov_len = size;
+    return do_sendmsg(handle, address, &iov, 1);
+}
+
+nsapi_size_or_error_t Nanostack::do_sendmsg(void *handle, const ns_address_t *address, const nsapi_iovec_t *iov, unsigned iovcnt)
 {
     // Validate parameters
     NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
@@ -610,28 +618,31 @@ nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *add
         goto out;
     }
 
+    // A stream can be written in part, a datagram can't
+    if (iovcnt > 8 && socket->proto != SOCKET_TCP) {
+        ret = NSAPI_ERROR_PARAMETER;
+        goto out;
+    }
+
     int retcode;
-#if 0
-    retcode = ::socket_sendto(socket->socket_id, address,
-                              data, size);
-#else
-    // Use sendmsg purely to get the new return style
+    // Use sendmsg to get the new return style
     // of returning data written rather than 0 on success,
     // which means TCP can do partial writes. (Sadly,
     // it's the only call which takes flags so we can
     // leave the NS_MSG_LEGACY0 flag clear).
     ns_msghdr_t msg;
-    ns_iovec_t iov;
-    iov.iov_base = const_cast<void *>(data);
-    iov.iov_len = size;
+    ns_iovec_t ns_iov[8];
+    msg.msg_iovlen = 0;
+    for (; msg.msg_iovlen < iovcnt && msg.msg_iovlen < 8; msg.msg_iovlen++) {
+        ns_iov[msg.msg_iovlen].iov_base = iov[msg.msg_iovlen].iov_base;
+        ns_iov[msg.msg_iovlen].iov_len = iov[msg.msg_iovlen].iov_len;
+    }
     msg.msg_name = const_cast<ns_address_t *>(address);
     msg.msg_namelen = address ? sizeof * address : 0;
-    msg.msg_iov = &iov;
-    msg.msg_iovlen = 1;
+    msg.msg_iov = ns_iov;
     msg.msg_control = NULL;
     msg.msg_controllen = 0;
     retcode = ::socket_sendmsg(socket->socket_id, &msg, 0);
-#endif
 
     /*
      * \return length if entire amount written (which could be 0)
@@ -737,6 +748,77 @@ out:
     return ret;
 }
 
+nsapi_size_or_error_t Nanostack::socket_sendmsg(void *handle, const SocketAddress *address,
+                                                const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (!address) {
+        return do_sendmsg(handle, NULL, iov, iovcnt);
+    }
+
+    if (address->get_ip_version() != NSAPI_IPv6) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    ns_address_t ns_address;
+    convert_mbed_addr_to_ns(&ns_address, address);
+    /*No lock gaurd needed here as do_sendmsg() will handle locks.*/
+    return do_sendmsg(handle, &ns_address, iov, iovcnt);
+}
+
+nsapi_size_or_error_t Nanostack::socket_recvmsg(void *handle, SocketAddress *address,
+                                                const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    // Validate parameters
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_size_or_error_t ret;
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+        goto out;
+    }
+
+    ns_address_t ns_address;
+    ns_msghdr_t msg;
+    ns_iovec_t ns_iov[8];
+    msg.msg_iovlen = 0;
+    for (; msg.msg_iovlen < iovcnt && msg.msg_iovlen < 8; msg.msg_iovlen++) {
+        ns_iov[msg.msg_iovlen].iov_base = iov[msg.msg_iovlen].iov_base;
+        ns_iov[msg.msg_iovlen].iov_len = iov[msg.msg_iovlen].iov_len;
+    }
+    msg.msg_name = &ns_address;
+    msg.msg_namelen = sizeof ns_address;
+    msg.msg_iov = ns_iov;
+    msg.msg_control = NULL;
+    msg.msg_controllen = 0;
+    msg.msg_flags = 0;
+
+    int retcode;
+    retcode = ::socket_recvmsg(socket->socket_id, &msg, 0);
+
+    if (retcode == NS_EWOULDBLOCK) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else if (retcode < 0) {
+        ret = NSAPI_ERROR_PARAMETER;
+    } else {
+        ret = retcode;
+        if (address != NULL) {
+            convert_ns_addr_to_mbed(address, &ns_address);
+        }
+    }
+
+out:
+    tr_debug("socket_recvmsg(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
 nsapi_error_t Nanostack::socket_bind(void *handle, const SocketAddress &address)
 {
     // Validate parameters
@@ -0,0 +1,171 @@
+/** @file AsyncSocket.h AsyncSocket */
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @addtogroup netsocket
+* @{
+*/
+
+#ifndef ASYNC_SOCKET_H
+#define ASYNC_SOCKET_H
+
+#include "netsocket/Socket.h"
+#include "netsocket/SocketAddress.h"
+#include "netsocket/nsapi_types.h"
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+
+/**
+ * \brief Asynchronous operations on a socket, completed on an EventQueue.
+ *
+ * The socket is switched to non-blocking mode and its sigio() callback is
+ * taken over. Each operation is attempted on the queue, then again whenever
+ * the socket signals an event, until it completes or fails; its callback is
+ * then called on the queue with the result. Many sockets can share the
+ * thread dispatching the queue, instead of one blocking thread each.
+ *
+ * One operation of each kind (connect, send, recv) can be pending at a
+ * time, and a new one can be started from the callback of the previous one.
+ *
+ * @code
+ * AsyncSocket async(&socket, mbed::mbed_event_queue());
+ *
+ * void received(nsapi_size_or_error_t size)
+ * {
+ *     if (size > 0) {
+ *         // ... handle size bytes of buf
+ *         async.async_recv(buf, sizeof(buf), received);
+ *     }
+ * }
+ *
+ * void connected(nsapi_error_t error)
+ * {
+ *     if (error == NSAPI_ERROR_OK) {
+ *         async.async_recv(buf, sizeof(buf), received);
+ *     }
+ * }
+ *
+ * async.async_connect(address, connected);
+ * @endcode
+ *
+ * @note Synchronization level: Thread safe. Callbacks are called on the queue.
+ */
+class AsyncSocket : private mbed::NonCopyable<AsyncSocket> {
+public:
+    /** Completion of a connection, with NSAPI_ERROR_OK or a negative error code */
+    typedef mbed::Callback<void(nsapi_error_t)> connect_cb_t;
+
+    /** Completion of a transfer, with the number of bytes or a negative error code */
+    typedef mbed::Callback<void(nsapi_size_or_error_t)> transfer_cb_t;
+
+    /** Take over a socket
+     *
+     *  @param socket   Opened socket, left in non-blocking mode
+     *  @param queue    Queue the operations are attempted and completed on
+     */
+    AsyncSocket(Socket *socket, events::EventQueue *queue);
+
+    /** Give the socket back, without calling the callbacks of pending operations
+     *
+     *  The socket is not closed, nor switched back to blocking mode.
+     */
+    ~AsyncSocket();
+
+    /** Connect the socket to a remote host
+     *
+     *  @param address  Remote address
+     *  @param cb       Called with the result once connected or failed
+     *  @return         NSAPI_ERROR_OK if the connection was started,
+     *                  NSAPI_ERROR_BUSY if a connection is already pending
+     */
+    nsapi_error_t async_connect(const SocketAddress &address, connect_cb_t cb);
+
+    /** Send data over the socket
+     *
+     *  Stream data is sent in as many send() calls as needed, the callback
+     *  gets the whole size once all of it is sent.
+     *
+     *  @param data     Buffer of data to send, must stay valid until the callback
+     *  @param size     Size of the data in bytes
+     *  @param cb       Called with the size sent or an error
+     *  @return         NSAPI_ERROR_OK if the send was started,
+     *                  NSAPI_ERROR_BUSY if a send is already pending
+     */
+    nsapi_error_t async_send(const void *data, nsapi_size_t size, transfer_cb_t cb);
+
+    /** Receive data from the socket
+     *
+     *  The callback gets the size of the first data available, 0 once the
+     *  connection is closed by the peer.
+     *
+     *  @param data     Destination buffer, must stay valid until the callback
+     *  @param size     Size of the buffer in bytes
+     *  @param cb       Called with the size received or an error
+     *  @return         NSAPI_ERROR_OK if the receive was started,
+     *                  NSAPI_ERROR_BUSY if a receive is already pending
+     */
+    nsapi_error_t async_recv(void *data, nsapi_size_t size, transfer_cb_t cb);
+
+    /** Drop the pending operations, without calling their callbacks
+     */
+    void cancel();
+
+    /** Get the socket
+     *
+     *  @return Socket taken over
+     */
+    Socket *get_socket() const
+    {
+        return _socket;
+    }
+
+private:
+    /* Called by the socket from the network stack context */
+    void event();
+
+    /* Attempt the pending operations, on the queue */
+    void process();
+
+    nsapi_error_t try_connect();
+    nsapi_size_or_error_t try_send();
+    nsapi_size_or_error_t try_recv();
+
+    Socket *_socket;
+    events::EventQueue *_queue;
+    PlatformMutex _mutex;
+
+    // Id of the event posted to process the operations, 0 if none
+    int _event_id;
+    bool _event_pending;
+
+    SocketAddress _connect_address;
+    connect_cb_t _connect_cb;
+
+    const uint8_t *_send_data;
+    nsapi_size_t _send_size;
+    nsapi_size_t _send_done;
+    transfer_cb_t _send_cb;
+
+    void *_recv_data;
+    nsapi_size_t _recv_size;
+    transfer_cb_t _recv_cb;
+};
+
+#endif // ASYNC_SOCKET_H
+
+/** @} */
@@ -40,6 +40,24 @@ public:
      * @param control      Transport control mode. See @ref control_transport.
      */
     DTLSSocketWrapper(Socket *transport, const char *hostname = NULL, control_transport control = TRANSPORT_CONNECT_AND_CLOSE);
+
+    /** Check whether the records sent carry a Connection ID
+     *
+     *  With the Connection ID extension, the server recognizes the session
+     *  by the CID it gave rather than by the address and port of the
+     *  client, so the session survives NAT rebinding without a new
+     *  handshake. Needs mbedtls.dtls-connection-id, and a server that
+     *  supports the extension.
+     *
+     *  @return True if the handshake has completed and the server gave a CID.
+     */
+    bool is_cid_negotiated();
+
+protected:
+#ifndef DOXYGEN_ONLY
+    virtual int setup_ssl_context();
+#endif
+
 private:
     static void timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms);
     static int timing_get_delay(void *ctx);
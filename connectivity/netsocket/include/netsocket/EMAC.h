@@ -47,6 +47,14 @@ public:
     //typedef void (*emac_link_input_fn)(void *data, emac_mem_buf_t *buf);
     typedef mbed::Callback<void (emac_mem_buf_t *buf)> emac_link_input_cb_t;
 
+    /**
+     * Callback to be register with EMAC interface and to be called for batches of received packets
+     *
+     * @param bufs   Received packets, the array is only valid during the call
+     * @param count  Number of packets
+     */
+    typedef mbed::Callback<void (emac_mem_buf_t **bufs, uint32_t count)> emac_link_input_batch_cb_t;
+
     /**
      * Callback to be register with EMAC interface and to be called for link status changes
      *
@@ -144,6 +152,31 @@ public:
      */
     virtual void set_link_input_cb(emac_link_input_cb_t input_cb) = 0;
 
+    /**
+     * Sets a callback to be called with batches of received packets
+     *
+     * A driver that supports it hands over the packets it has received since
+     * the previous call in one call, rather than one call per packet. This
+     * lets the stack process them with a single wake-up of its thread.
+     *
+     * The budget bounds the packets per call. While it has packets pending,
+     * the driver should keep its receive interrupt masked and poll for more,
+     * up to the budget, and only unmask the interrupt once it receives fewer
+     * packets than the budget: under load, interrupts are then coalesced.
+     *
+     * Packets keep being delivered to the callback set by set_link_input_cb()
+     * by drivers that don't support batches, and after this is called with
+     * a null callback.
+     *
+     * @param input_cb Function to be register as a callback
+     * @param budget   Maximum number of packets per call
+     * @return         True if the driver delivers batches, False otherwise
+     */
+    virtual bool set_link_input_batch_cb(emac_link_input_batch_cb_t input_cb, uint32_t budget)
+    {
+        return false;
+    }
+
     /**
      * Sets a callback that needs to be called on link status changes for given interface
      *
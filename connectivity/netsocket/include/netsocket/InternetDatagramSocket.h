@@ -73,6 +73,129 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                    void *data, nsapi_size_t size) override;
 
+    /** Send a scatter-gather list as a datagram to the specified address.
+     *
+     *  Like sendto(), for a datagram that is split in several buffers, for
+     *  example the header, payload and trailer of a message. The data isn't
+     *  copied to a contiguous buffer first.
+     *
+     *  @param address  The SocketAddress of the remote host.
+     *  @param iov      Buffers of the datagram.
+     *  @param iovcnt   Number of buffers.
+     *  @retval         int Number of sent bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack can't send several buffers.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_sendmsg.
+     */
+    nsapi_size_or_error_t sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive a datagram into a scatter-gather list and store the source
+     *  address in address if it's not NULL.
+     *
+     *  Like recvfrom(), but the datagram fills the buffers in order. A
+     *  datagram larger than the buffers is truncated.
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param iov      Destination buffers for the datagram.
+     *  @param iovcnt   Number of buffers.
+     *  @retval         int Number of received bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack can't receive into several buffers.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_recvmsg.
+     */
+    nsapi_size_or_error_t recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Send a batch of datagrams, each to its own address.
+     *
+     *  Like sendto() for each datagram, in one call. The length of each
+     *  datagram sent is set.
+     *
+     *  By default, sendmmsg blocks until all datagrams are sent. If socket
+     *  is set to nonblocking or times out, a part of them can be sent.
+     *  NSAPI_ERROR_WOULD_BLOCK is returned if none was sent.
+     *
+     *  @param msgs     Datagrams to send.
+     *  @param count    Number of datagrams.
+     *  @retval         int Number of datagrams sent on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_sendmmsg.
+     */
+    nsapi_size_or_error_t sendmmsg(nsapi_datagram_t *msgs, unsigned count);
+
+    /** Receive a batch of datagrams.
+     *
+     *  Like recvfrom() for each datagram pending on the socket, up to count,
+     *  in one call. The source address and length of each datagram received
+     *  are set.
+     *
+     *  By default, recvmmsg blocks until at least one datagram is received.
+     *  If socket is set to nonblocking or times out with no datagram,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @note When the socket is connected, datagrams from other addresses
+     *        are dropped, and the entries are reordered to put the datagrams
+     *        received first.
+     *
+     *  @param msgs     Datagrams to receive into.
+     *  @param count    Number of datagrams.
+     *  @retval         int Number of datagrams received on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_recvmmsg.
+     */
+    nsapi_size_or_error_t recvmmsg(nsapi_datagram_t *msgs, unsigned count);
+
+    /** Send a memory buffer chain as a datagram to the specified address.
+     *
+     *  Like sendto(), for a datagram that is already in a buffer chain
+     *  allocated with the memory manager of the stack, see
+     *  get_memory_manager(). The chain is sent without copy.
+     *
+     *  @note On success the stack takes ownership of the chain, on failure
+     *        the chain stays owned by the caller.
+     *
+     *  @param address  The SocketAddress of the remote host.
+     *  @param buf      Buffer chain of the datagram.
+     *  @retval         int Number of sent bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack has no zero-copy support.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_sendto_buf.
+     */
+    nsapi_size_or_error_t sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf);
+
+    /** Receive a datagram as a memory buffer chain and store the source address
+     *  in address if it's not NULL.
+     *
+     *  Like recvfrom(), but the datagram is handed over in a buffer chain of
+     *  the stack instead of being copied, so it's never truncated. The caller
+     *  frees the chain with the memory manager, see get_memory_manager().
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param buf      Destination for the buffer chain of the datagram.
+     *  @retval         int Number of received bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack has no zero-copy support.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_recvfrom_buf.
+     */
+    nsapi_size_or_error_t recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf);
+
     /** Set the remote address for next send() call and filtering
      *  of incoming packets. To reset the address, zero initialized
      *  SocketAddress must be in the address parameter.
@@ -153,6 +153,16 @@ public:
      */
     nsapi_error_t getpeername(SocketAddress *address) override;
 
+    /** Get the memory manager of the buffers of the zero-copy functions.
+     *
+     *  Buffers passed to send_buf() and sendto_buf() are allocated with it,
+     *  and buffers returned by recv_buf() and recvfrom_buf() are freed with it.
+     *
+     *  @return         Memory manager of the stack, or NULL if the socket is
+     *                  not open or the stack has no zero-copy support.
+     */
+    NetStackMemoryManager *get_memory_manager();
+
 
 #if !defined(DOXYGEN_ONLY)
 
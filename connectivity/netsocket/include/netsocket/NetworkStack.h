@@ -30,6 +30,19 @@
 
 // Predeclared classes
 class OnboardNetworkStack;
+class NetStackMemoryManager;
+typedef void net_stack_mem_buf_t;
+
+/** nsapi_datagram structure
+ *
+ *  Datagram of the batched socket functions
+ */
+typedef struct nsapi_datagram {
+    SocketAddress address;  /* Destination address to send to, or source address received from */
+    void *data;             /* Buffer of the datagram */
+    nsapi_size_t size;      /* Size of the datagram to send, or of the buffer to receive into */
+    nsapi_size_t length;    /* [OUT] Number of bytes sent or received */
+} nsapi_datagram_t;
 
 /** NetworkStack class
  *
@@ -394,6 +407,158 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size) = 0;
 
+    /** Send a scatter-gather list over a socket
+     *
+     *  Sends the data of the buffers in order, as one datagram for
+     *  datagram sockets, without assembling it in a contiguous buffer first.
+     *
+     *  The default implementation calls socket_send once per buffer for
+     *  connection-oriented sockets, and socket_sendto for datagrams of a
+     *  single buffer. Stacks override it to send datagrams of several
+     *  buffers.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, NULL for a
+     *                  connection-oriented socket
+     *  @param iov      Buffers of data to send to the host
+     *  @param iovcnt   Number of buffers
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure. Connection-oriented sockets can
+     *                  send a part of the data.
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data over a socket into a scatter-gather list
+     *
+     *  Fills the buffers in order. A datagram larger than the buffers is
+     *  truncated.
+     *
+     *  The default implementation calls socket_recv once per buffer for
+     *  connection-oriented sockets, and socket_recvfrom for a single buffer.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, NULL for a
+     *                  connection-oriented socket
+     *  @param iov      Destination buffers for data received from the host
+     *  @param iovcnt   Number of buffers
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Send a batch of datagrams over a UDP socket
+     *
+     *  Sends the datagrams in order, each to its own address, and sets
+     *  their length. Stops at the first datagram that can't be sent.
+     *
+     *  The default implementation calls socket_sendto for each datagram.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Datagrams to send
+     *  @param count    Number of datagrams
+     *  @return         Number of datagrams sent on success, negative error
+     *                  code if the first datagram can't be sent
+     */
+    virtual nsapi_size_or_error_t socket_sendmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count);
+
+    /** Receive a batch of datagrams over a UDP socket
+     *
+     *  Receives the datagrams pending on the socket, up to count, and sets
+     *  their source address and length. A datagram larger than its buffer
+     *  is truncated.
+     *
+     *  The default implementation calls socket_recvfrom for each datagram.
+     *
+     *  @param handle   Socket handle
+     *  @param msgs     Datagrams to receive into
+     *  @param count    Number of datagrams
+     *  @return         Number of datagrams received on success, negative
+     *                  error code if none is received
+     */
+    virtual nsapi_size_or_error_t socket_recvmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count);
+
+    /** Get the memory manager of the buffers of the zero-copy socket functions
+     *
+     *  @return         Memory manager, or NULL if the stack doesn't support
+     *                  the zero-copy socket functions
+     */
+    virtual NetStackMemoryManager *get_memory_manager()
+    {
+        return NULL;
+    }
+
+    /** Send data of a memory buffer chain over a TCP socket
+     *
+     *  Like socket_send, for the data of the chain starting at the given
+     *  offset, without copying it to a contiguous buffer first. The chain
+     *  stays owned by the caller.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Buffer chain of data to send to the host
+     *  @param offset   Offset in the chain of the data to send
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf,
+                                                  nsapi_size_t offset)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Receive data over a TCP socket as a memory buffer chain
+     *
+     *  Like socket_recv, but the data received is handed over in the buffer
+     *  chain of the stack, without copy. The caller frees the chain with the
+     *  memory manager of the stack.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received buffer chain
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Send a memory buffer chain as a packet over a UDP socket
+     *
+     *  Like socket_sendto, without copy. On success, the stack takes
+     *  ownership of the chain. On failure, the caller keeps it.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Buffer chain of the packet, allocated with the memory
+     *                  manager of the stack
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                    net_stack_mem_buf_t *buf)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Receive a packet over a UDP socket as a memory buffer chain
+     *
+     *  Like socket_recvfrom, but the packet is handed over in the buffer
+     *  chain of the stack, without copy. The caller frees the chain with the
+     *  memory manager of the stack.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Destination for the received buffer chain
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                      net_stack_mem_buf_t **buf)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
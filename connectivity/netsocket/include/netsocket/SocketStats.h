@@ -27,6 +27,10 @@
 #define MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT      10
 #endif
 
+#ifndef MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW
+#define MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW    1000
+#endif
+
 /** Enum of socket states
   *
   * Can be used to specify current state of socket - open, closed, connected or listen.
@@ -50,8 +54,23 @@ typedef struct {
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
+    uint32_t sent_rate;             /**< Bytes per second sent over the last complete rate window */
+    uint32_t recv_rate;             /**< Bytes per second received over the last complete rate window */
+    uint32_t rtt_ms;                /**< Smoothed round trip time estimated from connection handshakes, 0 if unknown */
+    char interface_name[NSAPI_INTERFACE_NAME_MAX_SIZE]; /**< Interface the socket is bound to, empty if none */
 } mbed_stats_socket_t;
 
+/** Structure to parse statistics aggregated over the sockets of an interface
+  */
+typedef struct {
+    uint32_t sockets;               /**< Sockets in the statistics, active or closed */
+    uint32_t open_sockets;          /**< Sockets not closed */
+    uint64_t sent_bytes;            /**< Data sent through these sockets */
+    uint64_t recv_bytes;            /**< Data received through these sockets */
+    uint32_t sent_rate;             /**< Bytes per second sent over the last complete rate window */
+    uint32_t recv_rate;             /**< Bytes per second received over the last complete rate window */
+} mbed_stats_socket_totals_t;
+
 /**  SocketStats class
  *
  *   Class to get the network socket statistics
@@ -82,6 +101,19 @@ public:
      */
     static size_t mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_t count);
 
+    /**
+     *  Sum the statistics of the sockets bound to an interface.
+     *
+     *  Rates are measured over windows of `nsapi.socket-stats-rate-window`
+     *  milliseconds, when statistics are fetched: fetch them at least once a
+     *  window to follow the throughput.
+     *
+     *  @param interface_name   Name of the interface, "" for the sockets not bound to any,
+     *                          NULL for all the sockets
+     *  @param totals           Structure to fill
+     */
+    static void mbed_stats_socket_get_totals(const char *interface_name, mbed_stats_socket_totals_t *totals);
+
 #if !defined(DOXYGEN_ONLY)
     /** Add entry of newly created socket in statistics array.
      *  API used by socket (TCP or UDP) layers only, not to be used by application.
@@ -140,12 +172,56 @@ public:
      */
     void stats_update_recv_bytes(const Socket *reference_id, size_t recv_bytes);
 
+    /** Update the interface the socket is bound to.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param interface_name Name of the interface, empty if none.
+     *
+     */
+    void stats_update_interface(const Socket *reference_id, const char *interface_name);
+
+    /** Record the start of a connection handshake.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *
+     */
+    void stats_connect_started(const Socket *reference_id);
+
+    /** Record the end of a connection handshake, its duration being a round trip time sample.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *
+     */
+    void stats_connect_finished(const Socket *reference_id);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 private:
+    /* State of the rate windows and handshake timing of an entry */
+    struct window_t {
+        size_t sent_bytes;
+        size_t recv_bytes;
+        uint64_t start_tick;
+        uint64_t connect_tick;
+    };
+
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+    static window_t _windows[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
     static SingletonPtr<PlatformMutex> _mutex;
     static uint32_t _size;
 
+    // Entry of the socket, so that the byte counters are updated without
+    // looking it up under the mutex
+    mbed_stats_socket_t *_entry = nullptr;
+
+    /* Entry of the socket, looked up if not cached yet */
+    mbed_stats_socket_t *get_entry(const Socket *reference_id);
+
+    /* Measure the rates of the entries whose window is complete */
+    static void update_rates();
+
     /** Internal function to scan the array and get the position of the element in the list.
      *
      *  @param reference_id   ID to identify the socket in the data array.
@@ -162,6 +238,11 @@ inline size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *, siz
     return 0;
 }
 
+inline void SocketStats::mbed_stats_socket_get_totals(const char *, mbed_stats_socket_totals_t *totals)
+{
+    *totals = {};
+}
+
 inline void SocketStats::stats_new_socket_entry(Socket *)
 {
 }
@@ -185,6 +266,18 @@ inline void SocketStats::stats_update_sent_bytes(const Socket *, size_t)
 inline void SocketStats::stats_update_recv_bytes(const Socket *, size_t)
 {
 }
+
+inline void SocketStats::stats_update_interface(const Socket *, const char *)
+{
+}
+
+inline void SocketStats::stats_connect_started(const Socket *)
+{
+}
+
+inline void SocketStats::stats_connect_finished(const Socket *)
+{
+}
 #endif // !MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 
 #endif
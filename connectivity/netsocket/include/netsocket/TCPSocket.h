@@ -101,6 +101,72 @@ public:
      */
     nsapi_size_or_error_t recv(void *data, nsapi_size_t size) override;
 
+    /** Send a scatter-gather list over a TCP socket
+     *
+     *  Like send(), for data that is split in several buffers, for example
+     *  the header, payload and trailer of a message. The data isn't copied
+     *  to a contiguous buffer first.
+     *
+     *  @param iov      Buffers of data to send to the host
+     *  @param iovcnt   Number of buffers
+     *  @retval         int Number of sent bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_sendmsg.
+     */
+    nsapi_size_or_error_t sendmsg(const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data over a TCP socket into a scatter-gather list
+     *
+     *  Like recv(), but the data received fills the buffers in order.
+     *
+     *  @param iov      Destination buffers for data received from the host
+     *  @param iovcnt   Number of buffers
+     *  @retval         int Number of received bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recvmsg.
+     */
+    nsapi_size_or_error_t recvmsg(const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Send the data of a memory buffer chain over a TCP socket
+     *
+     *  Like send(), for data that is already in a buffer chain of the
+     *  stack, see get_memory_manager(). The data isn't copied to a contiguous
+     *  buffer first, and the chain stays owned by the caller.
+     *
+     *  @param buf      Buffer chain of data to send to the host
+     *  @retval         int Number of sent bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack has no zero-copy support
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_send_buf.
+     */
+    nsapi_size_or_error_t send_buf(net_stack_mem_buf_t *buf);
+
+    /** Receive data over a TCP socket as a memory buffer chain
+     *
+     *  Like recv(), but the data is handed over in a buffer chain of the
+     *  stack instead of being copied. The caller frees the chain with the
+     *  memory manager, see get_memory_manager().
+     *
+     *  @param buf      Destination for the buffer chain received from the host
+     *  @retval         int Number of received bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack has no zero-copy support
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recv_buf.
+     */
+    nsapi_size_or_error_t recv_buf(net_stack_mem_buf_t **buf);
+
     /** Send data on a socket.
      *
      * TCP socket is connection oriented protocol, so address is ignored.
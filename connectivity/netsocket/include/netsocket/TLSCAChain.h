@@ -0,0 +1,115 @@
+/** @file TLSCAChain.h TLSCAChain */
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @addtogroup netsocket
+* @{
+*/
+
+#ifndef TLS_CA_CHAIN_H
+#define TLS_CA_CHAIN_H
+
+#include <stddef.h>
+#include "netsocket/nsapi_types.h"
+#include "platform/IntrusivePtr.h"
+#include "platform/NonCopyable.h"
+#include "mbedtls/x509_crt.h"
+
+// This class requires Mbed TLS certificate parsing
+#if defined(MBEDTLS_X509_CRT_PARSE_C) || defined(DOXYGEN_ONLY)
+
+/**
+ * \brief Parsed CA certificate chain, shared by several TLS sockets.
+ *
+ * TLSSocketWrapper::set_root_ca_cert() parses the certificates again for each
+ * socket, and each socket holds its own copy of them. A TLSCAChain is parsed
+ * once, and sockets refer to it through a mbed::IntrusivePtr: it is freed when the
+ * last socket and the application have released it. The reference count is
+ * part of the chain, sharing it doesn't allocate.
+ *
+ * @code
+ * mbed::IntrusivePtr<TLSCAChain> ca(new TLSCAChain());
+ * ca->add(root_ca_pem);
+ * socket1.set_ca_chain(ca);
+ * socket2.set_ca_chain(ca);
+ * @endcode
+ *
+ * Certificates in DER format can also be referenced in place by add_der_nocopy(),
+ * for example from flash, instead of being copied to the heap.
+ *
+ * @note Synchronization level: Not protected. Add all the certificates before
+ * handing the chain to a socket, it is then only read.
+ */
+class TLSCAChain : public mbed::RefCounted<TLSCAChain>, private mbed::NonCopyable<TLSCAChain> {
+public:
+    /** Create an empty chain
+     */
+    TLSCAChain();
+
+    /** Free the certificates of the chain
+     */
+    ~TLSCAChain();
+
+    /** Parse and add certificates to the chain
+     *
+     *  @param ca       One or more PEM certificates, or a single DER certificate.
+     *                  A PEM buffer must be null-terminated, the terminator
+     *                  counting in @p len.
+     *  @param len      Length of the buffer
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_PARAMETER if a certificate can't be parsed
+     */
+    nsapi_error_t add(const void *ca, size_t len);
+
+    /** Parse and add PEM certificates to the chain
+     *
+     *  @param ca_pem   One or more null-terminated PEM certificates
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_PARAMETER if a certificate can't be parsed
+     */
+    nsapi_error_t add(const char *ca_pem);
+
+    /** Parse and add a DER certificate without copying it
+     *
+     *  The chain refers to the certificate in place: the buffer must remain
+     *  valid and unchanged as long as the chain exists, which makes this
+     *  mostly useful for certificates in flash.
+     *
+     *  @param ca_der   DER certificate
+     *  @param len      Length of the certificate
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_PARAMETER if the certificate can't be parsed
+     */
+    nsapi_error_t add_der_nocopy(const void *ca_der, size_t len);
+
+    /** Get the Mbed TLS chain
+     *
+     *  @return         Chain of the certificates added, or NULL if it is empty
+     */
+    mbedtls_x509_crt *get_chain();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    mbedtls_x509_crt _crt;
+    bool _empty;
+#endif
+};
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
+
+#endif // TLS_CA_CHAIN_H
+
+/** @} */
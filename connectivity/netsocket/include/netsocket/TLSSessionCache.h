@@ -0,0 +1,138 @@
+/** @file TLSSessionCache.h TLSSessionCache */
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @addtogroup netsocket
+* @{
+*/
+
+#ifndef TLS_SESSION_CACHE_H
+#define TLS_SESSION_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "netsocket/nsapi_types.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+
+namespace mbed {
+class KVStore;
+}
+
+/**
+ * \brief Bounded cache of TLS sessions, keyed by host name.
+ *
+ * TLSSocketWrapper stores the session of each completed handshake in the
+ * cache and offers it to the server when it connects again to the same host.
+ * A server that accepts it resumes the session with an abbreviated handshake,
+ * without the key exchange and certificate verification of a full one.
+ *
+ * Sessions are held as serialized blobs, see mbedtls_ssl_session_save().
+ * When the cache is full, the least recently used session is evicted.
+ *
+ * Sessions can also be persisted in a KVStore, so that they survive a reset.
+ * A serialized session contains its master secret: use a KVStore that
+ * encrypts and authenticates its data, such as SecureStore.
+ *
+ * @note Synchronization level: Thread safe
+ */
+class TLSSessionCache : private mbed::NonCopyable<TLSSessionCache> {
+public:
+    /** Create a session cache
+     *
+     *  @param max_entries  Maximum number of sessions held in RAM
+     *  @param kvstore      KVStore to persist the sessions in, or NULL to keep them in RAM only
+     */
+    TLSSessionCache(size_t max_entries, mbed::KVStore *kvstore = NULL);
+
+    /** Destroy the cache and free the sessions held in RAM
+     */
+    ~TLSSessionCache();
+
+    /** Store the session of a host
+     *
+     *  Replaces the previous session of the host. Failing to persist the
+     *  session in the KVStore isn't an error, it is then held in RAM only.
+     *
+     *  @param host     Host name
+     *  @param data     Serialized session
+     *  @param size     Size of the serialized session
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_PARAMETER if the host or session is empty
+     *                  NSAPI_ERROR_NO_MEMORY if the session can't be allocated
+     */
+    nsapi_error_t store(const char *host, const void *data, size_t size);
+
+    /** Load the session of a host
+     *
+     *  The session is copied only if it fits in the buffer. Call it with a
+     *  NULL buffer to get the size of the session.
+     *
+     *  @param host     Host name
+     *  @param buffer   Buffer to copy the session to, may be NULL
+     *  @param size     Size of the buffer
+     *  @return         Size of the session, or 0 if there is none
+     */
+    size_t load(const char *host, void *buffer, size_t size);
+
+    /** Remove the session of a host
+     *
+     *  @param host     Host name
+     */
+    void remove(const char *host);
+
+    /** Remove all the sessions held in RAM
+     *
+     *  Sessions persisted in the KVStore are only removed one at a time
+     *  by remove().
+     */
+    void clear();
+
+    /** Get the default session cache
+     *
+     *  Its size is set by the nsapi.tls-session-cache-size configuration,
+     *  and it is held in RAM only.
+     *
+     *  @return         Default session cache, or NULL if its size is 0
+     */
+    static TLSSessionCache *get_default_instance();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    struct entry {
+        uint8_t *buffer;    // host name followed by the session
+        size_t host_len;
+        size_t size;
+        uint32_t last_use;
+    };
+
+    entry *find(const char *host);
+    entry *insert(const char *host, const void *data, size_t size);
+    void free_entry(entry *e);
+    void kv_key(const char *host, char *key);
+    size_t kv_load(const char *host);
+
+    entry *_entries;
+    size_t _max_entries;
+    uint32_t _use_count;
+    mbed::KVStore *_kvstore;
+    PlatformMutex _mutex;
+#endif
+};
+
+#endif // TLS_SESSION_CACHE_H
+
+/** @} */
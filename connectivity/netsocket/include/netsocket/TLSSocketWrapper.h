@@ -23,8 +23,11 @@
 #define _MBED_HTTPS_TLS_SOCKET_WRAPPER_H_
 
 #include "netsocket/Socket.h"
+#include "netsocket/TLSSessionCache.h"
+#include "netsocket/TLSCAChain.h"
 #include "rtos/EventFlags.h"
 #include "platform/Callback.h"
+#include "platform/IntrusivePtr.h"
 #include "mbedtls/platform.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/entropy.h"
@@ -142,6 +145,10 @@ public:
      *  The socket must be connected to a remote host. Returns the number of
      *  bytes sent from the buffer.
      *
+     *  By default, send blocks until all data is sent, in as many TLS records
+     *  as needed. If socket is set to non-blocking or times out, a partial
+     *  amount can be written.
+     *
      *  @param data     Buffer of data to send to the host.
      *  @param size     Size of the buffer in bytes.
      *  @retval         int Number of sent bytes on success
@@ -220,6 +227,16 @@ public:
      * @param crt Mbed TLS X509 certificate chain.
      */
     void set_ca_chain(mbedtls_x509_crt *crt);
+
+    /** Set a CA chain shared with other sockets.
+     *
+     * Unlike set_root_ca_cert(), the certificates aren't parsed again: the
+     * socket holds a reference to the chain until another CA chain is set
+     * or the socket is destroyed.
+     *
+     * @param chain CA chain, or NULL to remove the CA chain.
+     */
+    void set_ca_chain(mbed::IntrusivePtr<TLSCAChain> chain);
 #endif
 
     /** Get internal Mbed TLS configuration structure.
@@ -240,6 +257,22 @@ public:
      */
     mbedtls_ssl_context *get_ssl_context();
 
+    /** Set the cache of sessions to resume.
+     *
+     * @note Must be called before calling connect()
+     *
+     * @note Sessions are keyed by the hostname, so they are only cached
+     * when it is set, and when following defines are set:
+     * #if defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_X509_REMOVE_HOSTNAME_VERIFICATION)
+     *
+     * The session of a completed handshake is stored in the cache, and
+     * offered to the server by the next handshake with the same host.
+     * Defaults to TLSSessionCache::get_default_instance().
+     *
+     * @param cache   Session cache, or nullptr to always do a full handshake.
+     */
+    void set_session_cache(TLSSessionCache *cache);
+
 protected:
 #ifndef DOXYGEN_ONLY
     /** Initiates TLS Handshake.
@@ -266,6 +299,14 @@ protected:
     bool is_handshake_started() const;
 
     void event();
+
+    /** Complete the setup of the SSL context for the handshake
+     *
+     *  Called after mbedtls_ssl_setup(), before the handshake starts.
+     *
+     *  @return 0 on success, or an Mbed TLS error code.
+     */
+    virtual int setup_ssl_context();
 #endif
 
 
@@ -304,6 +345,12 @@ private:
      */
     static int ssl_send(void *ctx, const unsigned char *buf, size_t len);
 
+    /** Offer the cached session of the host to the server */
+    void load_session();
+
+    /** Store the session of the completed handshake in the cache */
+    void store_session();
+
     mbedtls_ssl_context _ssl;
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     mbedtls_pk_context _pkctx;
@@ -321,8 +368,10 @@ private:
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     mbedtls_x509_crt *_cacert = nullptr;
     mbedtls_x509_crt *_clicert = nullptr;
+    mbed::IntrusivePtr<TLSCAChain> _shared_cacert;
 #endif
     mbedtls_ssl_config *_ssl_conf = nullptr;
+    TLSSessionCache *_session_cache;
 
     bool _connect_transport: 1;
     bool _close_transport: 1;
@@ -272,6 +272,8 @@ typedef enum nsapi_socket_option {
     NSAPI_BIND_TO_DEVICE,    /*!< Bind socket network interface name*/
     NSAPI_LATENCY,           /*!< Read estimated latency to destination */
     NSAPI_STAGGER,           /*!< Read estimated stagger value to destination */
+    NSAPI_TCP_NODELAY,       /*!< Disables the Nagle algorithm of a TCP socket */
+    NSAPI_SNDBUF_AUTOTUNE,   /*!< Grows the send buffer of a TCP socket with its bandwidth-delay product */
 } nsapi_socket_option_t;
 
 typedef enum nsapi_tlssocket_level {
@@ -359,6 +361,15 @@ typedef struct nsapi_stagger_req {
     uint16_t stagger_rand;  /* [OUT] Randomized stagger value in seconds */
 } nsapi_stagger_req_t;
 
+/** nsapi_iovec structure
+ *
+ *  Buffer of a scatter-gather list, for socket sendmsg and recvmsg
+ */
+typedef struct nsapi_iovec {
+    void *iov_base;         /* Start of the buffer */
+    nsapi_size_t iov_len;   /* Size of the buffer in bytes */
+} nsapi_iovec_t;
+
 /** nsapi_stack_api structure
  *
  *  Common api structure for network stack operations. A network stack
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/AsyncSocket.h"
+#include "platform/mbed_atomic.h"
+
+#define TRACE_GROUP "ASOC"
+#include "mbed-trace/mbed_trace.h"
+
+AsyncSocket::AsyncSocket(Socket *socket, events::EventQueue *queue) :
+    _socket(socket),
+    _queue(queue),
+    _event_id(0),
+    _event_pending(false),
+    _send_data(NULL),
+    _send_size(0),
+    _send_done(0),
+    _recv_data(NULL),
+    _recv_size(0)
+{
+    _socket->set_blocking(false);
+    _socket->sigio(mbed::callback(this, &AsyncSocket::event));
+}
+
+AsyncSocket::~AsyncSocket()
+{
+    _socket->sigio(nullptr);
+    if (_event_id) {
+        _queue->cancel(_event_id);
+    }
+}
+
+nsapi_error_t AsyncSocket::async_connect(const SocketAddress &address, connect_cb_t cb)
+{
+    if (!cb) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    if (_connect_cb) {
+        _mutex.unlock();
+        return NSAPI_ERROR_BUSY;
+    }
+    _connect_address = address;
+    _connect_cb = cb;
+    _mutex.unlock();
+
+    event();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t AsyncSocket::async_send(const void *data, nsapi_size_t size, transfer_cb_t cb)
+{
+    if (!cb) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    if (_send_cb) {
+        _mutex.unlock();
+        return NSAPI_ERROR_BUSY;
+    }
+    _send_data = static_cast<const uint8_t *>(data);
+    _send_size = size;
+    _send_done = 0;
+    _send_cb = cb;
+    _mutex.unlock();
+
+    event();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t AsyncSocket::async_recv(void *data, nsapi_size_t size, transfer_cb_t cb)
+{
+    if (!cb) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    if (_recv_cb) {
+        _mutex.unlock();
+        return NSAPI_ERROR_BUSY;
+    }
+    _recv_data = data;
+    _recv_size = size;
+    _recv_cb = cb;
+    _mutex.unlock();
+
+    event();
+    return NSAPI_ERROR_OK;
+}
+
+void AsyncSocket::cancel()
+{
+    _mutex.lock();
+    _connect_cb = nullptr;
+    _send_cb = nullptr;
+    _recv_cb = nullptr;
+    _mutex.unlock();
+}
+
+void AsyncSocket::event()
+{
+    // Signals coalesce until the queue processes them: one pass attempts
+    // all the pending operations
+    if (core_util_atomic_exchange_bool(&_event_pending, true)) {
+        return;
+    }
+
+    int id = _queue->call(this, &AsyncSocket::process);
+    if (!id) {
+        // Queue full, the next signal of the socket tries again
+        core_util_atomic_store_bool(&_event_pending, false);
+        tr_warn("No event for socket %p", _socket);
+        return;
+    }
+    _event_id = id;
+}
+
+void AsyncSocket::process()
+{
+    // Signals from now on need another pass
+    core_util_atomic_store_bool(&_event_pending, false);
+
+    connect_cb_t connect_cb;
+    transfer_cb_t send_cb;
+    transfer_cb_t recv_cb;
+    nsapi_error_t connect_result = NSAPI_ERROR_OK;
+    nsapi_size_or_error_t send_result = 0;
+    nsapi_size_or_error_t recv_result = 0;
+
+    _mutex.lock();
+
+    if (_connect_cb) {
+        connect_result = try_connect();
+        if (connect_result != NSAPI_ERROR_IN_PROGRESS) {
+            connect_cb = _connect_cb;
+            _connect_cb = nullptr;
+        }
+    }
+
+    if (_send_cb) {
+        send_result = try_send();
+        if (send_result != NSAPI_ERROR_WOULD_BLOCK) {
+            send_cb = _send_cb;
+            _send_cb = nullptr;
+        }
+    }
+
+    if (_recv_cb) {
+        recv_result = try_recv();
+        if (recv_result != NSAPI_ERROR_WOULD_BLOCK) {
+            recv_cb = _recv_cb;
+            _recv_cb = nullptr;
+        }
+    }
+
+    _mutex.unlock();
+
+    // Completed operations are cleared first, so callbacks can start new ones
+    if (connect_cb) {
+        connect_cb(connect_result);
+    }
+    if (send_cb) {
+        send_cb(send_result);
+    }
+    if (recv_cb) {
+        recv_cb(recv_result);
+    }
+}
+
+nsapi_error_t AsyncSocket::try_connect()
+{
+    nsapi_error_t ret = _socket->connect(_connect_address);
+    if (ret == NSAPI_ERROR_IN_PROGRESS || ret == NSAPI_ERROR_ALREADY) {
+        return NSAPI_ERROR_IN_PROGRESS;
+    }
+    // A non-blocking connection in progress reports its completion that way
+    if (ret == NSAPI_ERROR_IS_CONNECTED) {
+        return NSAPI_ERROR_OK;
+    }
+    return ret;
+}
+
+nsapi_size_or_error_t AsyncSocket::try_send()
+{
+    do {
+        nsapi_size_or_error_t ret = _socket->send(_send_data + _send_done, _send_size - _send_done);
+        if (ret < 0) {
+            return ret;
+        }
+        if (ret == 0 && _send_done < _send_size) {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+        _send_done += ret;
+    } while (_send_done < _send_size);
+
+    return _send_size;
+}
+
+nsapi_size_or_error_t AsyncSocket::try_recv()
+{
+    return _socket->recv(_recv_data, _recv_size);
+}
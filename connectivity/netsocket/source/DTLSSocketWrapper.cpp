@@ -27,6 +27,16 @@ DTLSSocketWrapper::DTLSSocketWrapper(Socket *transport, const char *hostname, co
     TLSSocketWrapper(transport, hostname, control)
 {
     mbedtls_ssl_conf_transport(get_ssl_config(), MBEDTLS_SSL_TRANSPORT_DATAGRAM);
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    // Retransmissions start after the min timeout, which doubles on each
+    // one until the max timeout, when the handshake fails
+    mbedtls_ssl_conf_handshake_timeout(get_ssl_config(),
+                                       MBED_CONF_NSAPI_DTLS_HANDSHAKE_TIMEOUT_MIN,
+                                       MBED_CONF_NSAPI_DTLS_HANDSHAKE_TIMEOUT_MAX);
+#endif
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    mbedtls_ssl_conf_cid(get_ssl_config(), MBED_CONF_NSAPI_DTLS_CID_LENGTH, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE);
+#endif
 
     // Defines MBEDTLS_SSL_CONF_SET_TIMER/GET_TIMER define global functions which should be the same for all
     // callers of mbedtls_ssl_set_timer_cb and there should be only one ssl context. If these rules don't apply,
@@ -36,6 +46,40 @@ DTLSSocketWrapper::DTLSSocketWrapper(Socket *transport, const char *hostname, co
 #endif /* !defined(MBEDTLS_SSL_CONF_SET_TIMER) && !defined(MBEDTLS_SSL_CONF_GET_TIMER) */
 }
 
+int DTLSSocketWrapper::setup_ssl_context()
+{
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    // Ask the server for a CID, and give it ours if the records it sends
+    // should carry one. The CID length is that of the config in use, which
+    // may have been replaced by set_ssl_config().
+    mbedtls_ssl_config *conf = get_ssl_config();
+    unsigned char own_cid[MBEDTLS_SSL_CID_IN_LEN_MAX];
+    size_t own_cid_len = conf->cid_len;
+    if (own_cid_len > 0) {
+        int ret = conf->f_rng(conf->p_rng, own_cid, own_cid_len);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return mbedtls_ssl_set_cid(get_ssl_context(), MBEDTLS_SSL_CID_ENABLED, own_cid, own_cid_len);
+#else
+    return 0;
+#endif
+}
+
+bool DTLSSocketWrapper::is_cid_negotiated()
+{
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    int enabled = MBEDTLS_SSL_CID_DISABLED;
+    if (mbedtls_ssl_get_peer_cid(get_ssl_context(), &enabled, nullptr, nullptr) != 0) {
+        return false;
+    }
+    return enabled == MBEDTLS_SSL_CID_ENABLED;
+#else
+    return false;
+#endif
+}
+
 void DTLSSocketWrapper::timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms)
 {
     DTLSSocketWrapper *context = static_cast<DTLSSocketWrapper *>(ctx);
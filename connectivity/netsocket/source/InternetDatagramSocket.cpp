@@ -15,6 +15,7 @@
  */
 
 #include "netsocket/InternetDatagramSocket.h"
+#include "netsocket/NetStackMemoryManager.h"
 #include "Timer.h"
 #include "mbed_assert.h"
 
@@ -142,6 +143,366 @@ nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, v
     return ret;
 }
 
+nsapi_size_or_error_t InternetDatagramSocket::sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, address);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendmsg(_socket, &address, iov, iovcnt);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            _socket_stats.stats_update_sent_bytes(this, sent);
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvmsg(SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress ignored;
+
+    if (!address) {
+        address = &ignored;
+    }
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvmsg(_socket, address, iov, iovcnt);
+
+        // Filter incomming packets using connected peer address
+        if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            continue;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::sendmmsg(nsapi_datagram_t *msgs, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    unsigned sent = 0;
+    nsapi_size_t sent_bytes = 0;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_sendmmsg(_socket, msgs + sent, count - sent);
+        if (ret >= 0) {
+            for (unsigned i = sent; i < sent + ret; i++) {
+                sent_bytes += msgs[i].length;
+            }
+            sent += ret;
+            if (sent >= count) {
+                break;
+            }
+        }
+        if (0 == _timeout) {
+            break;
+        } else if (NSAPI_ERROR_WOULD_BLOCK == ret) {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        } else if (ret < 0) {
+            break;
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return sent ? sent : ret;
+    } else if (sent == 0 && count) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _socket_stats.stats_update_sent_bytes(this, sent_bytes);
+        return sent;
+    }
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvmmsg(nsapi_datagram_t *msgs, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvmmsg(_socket, msgs, count);
+
+        // Filter incomming packets using connected peer address, the
+        // entries are swapped to keep the buffers of the caller
+        if (recv > 0 && _remote_peer) {
+            unsigned kept = 0;
+            for (unsigned i = 0; i < (unsigned)recv; i++) {
+                if (msgs[i].address != _remote_peer) {
+                    continue;
+                }
+                if (i != kept) {
+                    nsapi_datagram_t tmp = msgs[kept];
+                    msgs[kept] = msgs[i];
+                    msgs[i] = tmp;
+                }
+                kept++;
+            }
+            if (!kept) {
+                continue;
+            }
+            recv = kept;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            if (recv > 0) {
+                nsapi_size_t recv_bytes = 0;
+                for (unsigned i = 0; i < (unsigned)recv; i++) {
+                    recv_bytes += msgs[i].length;
+                }
+                _socket_stats.stats_update_recv_bytes(this, recv_bytes);
+            }
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, address);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendto_buf(_socket, address, buf);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            _socket_stats.stats_update_sent_bytes(this, sent);
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress ignored;
+
+    if (!address) {
+        address = &ignored;
+    }
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvfrom_buf(_socket, address, buf);
+
+        // Filter incomming packets using connected peer address, the
+        // dropped ones are ours to free
+        if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            _stack->get_memory_manager()->free(*buf);
+            *buf = NULL;
+            continue;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t InternetDatagramSocket::recv(void *buffer, nsapi_size_t size)
 {
     return recvfrom(NULL, buffer, size);
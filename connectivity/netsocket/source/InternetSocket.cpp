@@ -215,6 +215,7 @@ nsapi_error_t InternetSocket::setsockopt(int level, int optname, const void *opt
         ret = _stack->setsockopt(_socket, level, optname, optval, optlen);
         if (optname == NSAPI_BIND_TO_DEVICE && level == NSAPI_SOCKET) {
             strncpy(_interface_name, static_cast<const char *>(optval), optlen);
+            _socket_stats.stats_update_interface(this, _interface_name);
         }
     }
 
@@ -237,6 +238,14 @@ nsapi_error_t InternetSocket::getsockopt(int level, int optname, void *optval, u
     return ret;
 
 }
+NetStackMemoryManager *InternetSocket::get_memory_manager()
+{
+    _lock.lock();
+    NetStackMemoryManager *ret = _socket ? _stack->get_memory_manager() : NULL;
+    _lock.unlock();
+    return ret;
+}
+
 void InternetSocket::event()
 {
     _event_flag.set(READ_FLAG | WRITE_FLAG);
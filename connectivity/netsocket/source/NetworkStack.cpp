@@ -190,6 +190,82 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address) {
+        // A datagram can't be split over several calls
+        if (iovcnt > 1) {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+        return socket_sendto(handle, *address, iovcnt ? iov[0].iov_base : NULL, iovcnt ? iov[0].iov_len : 0);
+    }
+
+    nsapi_size_t written = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        nsapi_size_or_error_t ret = socket_send(handle, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return written ? written : ret;
+        }
+        written += ret;
+        if ((nsapi_size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return written;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address) {
+        // A datagram can't be split over several calls
+        if (iovcnt > 1) {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+        return socket_recvfrom(handle, address, iovcnt ? iov[0].iov_base : NULL, iovcnt ? iov[0].iov_len : 0);
+    }
+
+    nsapi_size_t received = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        nsapi_size_or_error_t ret = socket_recv(handle, iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return received ? received : ret;
+        }
+        received += ret;
+        if ((nsapi_size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return received;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    unsigned i = 0;
+    for (; i < count; i++) {
+        nsapi_size_or_error_t ret = socket_sendto(handle, msgs[i].address, msgs[i].data, msgs[i].size);
+        if (ret < 0) {
+            return i ? i : ret;
+        }
+        msgs[i].length = ret;
+    }
+    return i;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmmsg(nsapi_socket_t handle, nsapi_datagram_t *msgs, unsigned count)
+{
+    unsigned i = 0;
+    for (; i < count; i++) {
+        nsapi_size_or_error_t ret = socket_recvfrom(handle, &msgs[i].address, msgs[i].data, msgs[i].size);
+        if (ret < 0) {
+            return i ? i : ret;
+        }
+        msgs[i].length = ret;
+    }
+    return i;
+}
+
 nsapi_error_t NetworkStack::call_in(int delay, mbed::Callback<void()> func)
 {
     static events::EventQueue *event_queue = mbed::mbed_event_queue();
@@ -17,15 +17,18 @@
 #include "netsocket/SocketStats.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
 #endif
 
 #include <stdlib.h>
+#include <string.h>
 
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 SingletonPtr<PlatformMutex> SocketStats::_mutex;
 mbed_stats_socket_t SocketStats::_stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+SocketStats::window_t SocketStats::_windows[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
 uint32_t SocketStats::_size = 0;
 
 int SocketStats::get_entry_position(const Socket *const reference_id)
@@ -38,11 +41,49 @@ int SocketStats::get_entry_position(const Socket *const reference_id)
     return -1;
 }
 
+mbed_stats_socket_t *SocketStats::get_entry(const Socket *const reference_id)
+{
+    // The entry of a closed socket can be handed to a new socket
+    mbed_stats_socket_t *entry = _entry;
+    if (entry && entry->reference_id == reference_id) {
+        return entry;
+    }
+
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    entry = position >= 0 ? &_stats[position] : NULL;
+    _entry = entry;
+    _mutex->unlock();
+    return entry;
+}
+
+void SocketStats::update_rates()
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    uint64_t now = rtos::Kernel::get_ms_count();
+    for (uint32_t j = 0; j < _size; j++) {
+        window_t &window = _windows[j];
+        uint64_t elapsed = now - window.start_tick;
+        if (elapsed < MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW) {
+            continue;
+        }
+        size_t sent_bytes = core_util_atomic_load(&_stats[j].sent_bytes);
+        size_t recv_bytes = core_util_atomic_load(&_stats[j].recv_bytes);
+        _stats[j].sent_rate = (uint64_t)(sent_bytes - window.sent_bytes) * 1000 / elapsed;
+        _stats[j].recv_rate = (uint64_t)(recv_bytes - window.recv_bytes) * 1000 / elapsed;
+        window.sent_bytes = sent_bytes;
+        window.recv_bytes = recv_bytes;
+        window.start_tick = now;
+    }
+#endif
+}
+
 size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
     size_t j;
     _mutex->lock();
+    update_rates();
     for (j = 0; j < count && j < _size; j++) {
         stats[j] = _stats[j];
     }
@@ -50,18 +91,42 @@ size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_
     return j;
 }
 
+void SocketStats::mbed_stats_socket_get_totals(const char *interface_name, mbed_stats_socket_totals_t *totals)
+{
+    MBED_ASSERT(totals != NULL);
+    *totals = {};
+    _mutex->lock();
+    update_rates();
+    for (uint32_t j = 0; j < _size; j++) {
+        const mbed_stats_socket_t &entry = _stats[j];
+        if (interface_name && strncmp(entry.interface_name, interface_name, NSAPI_INTERFACE_NAME_MAX_SIZE) != 0) {
+            continue;
+        }
+        totals->sockets++;
+        if (entry.state != SOCK_CLOSED) {
+            totals->open_sockets++;
+        }
+        totals->sent_bytes += entry.sent_bytes;
+        totals->recv_bytes += entry.recv_bytes;
+        totals->sent_rate += entry.sent_rate;
+        totals->recv_rate += entry.recv_rate;
+    }
+    _mutex->unlock();
+}
+
 void SocketStats::stats_new_socket_entry(Socket *const reference_id)
 {
+    int position = -1;
     _mutex->lock();
     if (get_entry_position(reference_id) >= 0) {
         // Duplicate entry
         MBED_WARNING1(MBED_MAKE_ERROR(MBED_MODULE_NETWORK_STATS, MBED_ERROR_CODE_INVALID_INDEX), "Duplicate socket Reference ID ", reference_id);
     } else if (_size < MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT) {
         // Add new entry
+        position = _size;
         _stats[_size].reference_id = reference_id;
         _size++;
     } else {
-        int position = -1;
         uint64_t oldest_time = 0;
         // Determine which entry in the list shall be over-written
         for (uint32_t j = 0; j < MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT; j++) {
@@ -78,6 +143,13 @@ void SocketStats::stats_new_socket_entry(Socket *const reference_id)
         _stats[position] = {};
         _stats[position].reference_id = reference_id;
     }
+    if (position >= 0) {
+        _entry = &_stats[position];
+        _windows[position] = {};
+#ifdef MBED_CONF_RTOS_PRESENT
+        _windows[position].start_tick = rtos::Kernel::get_ms_count();
+#endif
+    }
     _mutex->unlock();
 }
 
@@ -115,22 +187,66 @@ void SocketStats::stats_update_proto(const Socket *const reference_id, nsapi_pro
 }
 
 void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size_t sent_bytes)
+{
+    if ((int32_t)sent_bytes <= 0) {
+        return;
+    }
+    mbed_stats_socket_t *entry = get_entry(reference_id);
+    if (entry) {
+        core_util_atomic_fetch_add(&entry->sent_bytes, sent_bytes);
+    }
+}
+
+void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes)
+{
+    if ((int32_t)recv_bytes <= 0) {
+        return;
+    }
+    mbed_stats_socket_t *entry = get_entry(reference_id);
+    if (entry) {
+        core_util_atomic_fetch_add(&entry->recv_bytes, recv_bytes);
+    }
+}
+
+void SocketStats::stats_update_interface(const Socket *const reference_id, const char *interface_name)
 {
     _mutex->lock();
     int position = get_entry_position(reference_id);
-    if ((position >= 0) && ((int32_t)sent_bytes > 0)) {
-        _stats[position].sent_bytes += sent_bytes;
+    if (position >= 0) {
+        strncpy(_stats[position].interface_name, interface_name, NSAPI_INTERFACE_NAME_MAX_SIZE - 1);
+        _stats[position].interface_name[NSAPI_INTERFACE_NAME_MAX_SIZE - 1] = '\0';
     }
     _mutex->unlock();
 }
 
-void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes)
+void SocketStats::stats_connect_started(const Socket *const reference_id)
 {
+#ifdef MBED_CONF_RTOS_PRESENT
     _mutex->lock();
     int position = get_entry_position(reference_id);
-    if ((position >= 0) && ((int32_t)recv_bytes > 0)) {
-        _stats[position].recv_bytes += recv_bytes;
+    if (position >= 0) {
+        _windows[position].connect_tick = rtos::Kernel::get_ms_count();
     }
     _mutex->unlock();
+#endif
+}
+
+void SocketStats::stats_connect_finished(const Socket *const reference_id)
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0 && _windows[position].connect_tick) {
+        // The handshake takes one round trip, smooth the samples as TCP does (RFC 6298)
+        uint32_t sample = rtos::Kernel::get_ms_count() - _windows[position].connect_tick;
+        uint32_t &rtt = _stats[position].rtt_ms;
+        if (sample == 0) {
+            sample = 1;
+        }
+        rtt = rtt ? (7 * rtt + sample) / 8 : sample;
+        _windows[position].connect_tick = 0;
+    }
+    _mutex->unlock();
+#endif
 }
 #endif // MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
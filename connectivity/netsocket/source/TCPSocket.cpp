@@ -15,6 +15,7 @@
  */
 
 #include "netsocket/TCPSocket.h"
+#include "netsocket/NetStackMemoryManager.h"
 #include "Timer.h"
 #include "mbed_assert.h"
 
@@ -63,6 +64,9 @@ nsapi_error_t TCPSocket::connect(const SocketAddress &address)
             _socket_stats.stats_update_socket_state(this, SOCK_CONNECTED);
             break;
         } else {
+            if (!blocking_connect_in_progress) {
+                _socket_stats.stats_connect_started(this);
+            }
             blocking_connect_in_progress = true;
 
             uint32_t flag;
@@ -90,6 +94,10 @@ nsapi_error_t TCPSocket::connect(const SocketAddress &address)
         ret = NSAPI_ERROR_OK;
     }
 
+    if (ret == NSAPI_ERROR_OK && blocking_connect_in_progress) {
+        _socket_stats.stats_connect_finished(this);
+    }
+
     if (ret == NSAPI_ERROR_OK || ret == NSAPI_ERROR_IN_PROGRESS) {
         _remote_peer = address;
         _socket_stats.stats_update_peer(this, _remote_peer);
@@ -219,6 +227,255 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
     return ret;
 }
 
+nsapi_size_or_error_t TCPSocket::sendmsg(const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    nsapi_size_t written = 0;
+    nsapi_size_t size = 0;
+
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    // Same as send, a partial write resumes in the buffer it stopped in
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        unsigned index = 0;
+        nsapi_size_t skip = written;
+        while (index < iovcnt && skip >= iov[index].iov_len) {
+            skip -= iov[index].iov_len;
+            index++;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        if (skip) {
+            nsapi_iovec_t rest;
+            rest.iov_base = static_cast<uint8_t *>(iov[index].iov_base) + skip;
+            rest.iov_len = iov[index].iov_len - skip;
+            ret = _stack->socket_sendmsg(_socket, NULL, &rest, 1);
+        } else {
+            ret = _stack->socket_sendmsg(_socket, NULL, iov + index, iovcnt - index);
+        }
+        if (ret >= 0) {
+            written += ret;
+            if (written >= size) {
+                break;
+            }
+        }
+        if (_timeout == 0) {
+            break;
+        } else if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        } else if (ret < 0) {
+            break;
+        }
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return ret;
+    } else if (written == 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _socket_stats.stats_update_sent_bytes(this, written);
+        return written;
+    }
+}
+
+nsapi_size_or_error_t TCPSocket::recvmsg(const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recvmsg(_socket, NULL, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::send_buf(net_stack_mem_buf_t *buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    nsapi_size_t written = 0;
+    nsapi_size_t size = 0;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    if (_socket) {
+        NetStackMemoryManager *memory_manager = _stack->get_memory_manager();
+        if (memory_manager) {
+            size = memory_manager->get_total_len(buf);
+        }
+    }
+
+    // Same as send, the offset in the chain resumes a partial write
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_send_buf(_socket, buf, written);
+        if (ret >= 0) {
+            written += ret;
+            if (written >= size) {
+                break;
+            }
+        }
+        if (_timeout == 0) {
+            break;
+        } else if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        } else if (ret < 0) {
+            break;
+        }
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return ret;
+    } else if (written == 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _socket_stats.stats_update_sent_bytes(this, written);
+        return written;
+    }
+}
+
+nsapi_size_or_error_t TCPSocket::recv_buf(net_stack_mem_buf_t **buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recv_buf(_socket, buf);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t TCPSocket::recvfrom(SocketAddress *address, void *data, nsapi_size_t size)
 {
     if (address) {
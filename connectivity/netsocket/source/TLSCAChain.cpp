@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/TLSCAChain.h"
+#include <string.h>
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+
+#define TRACE_GROUP "TLSC"
+#include "mbed-trace/mbed_trace.h"
+
+TLSCAChain::TLSCAChain() : _empty(true)
+{
+    mbedtls_x509_crt_init(&_crt);
+}
+
+TLSCAChain::~TLSCAChain()
+{
+    mbedtls_x509_crt_free(&_crt);
+}
+
+nsapi_error_t TLSCAChain::add(const void *ca, size_t len)
+{
+    int ret = mbedtls_x509_crt_parse(&_crt, static_cast<const unsigned char *>(ca), len);
+    if (ret != 0) {
+        tr_error("mbedtls_x509_crt_parse() failed: -0x%04X", -ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _empty = false;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSCAChain::add(const char *ca_pem)
+{
+    return add(ca_pem, strlen(ca_pem) + 1);
+}
+
+nsapi_error_t TLSCAChain::add_der_nocopy(const void *ca_der, size_t len)
+{
+    int ret = mbedtls_x509_crt_parse_der_nocopy(&_crt, static_cast<const unsigned char *>(ca_der), len);
+    if (ret != 0) {
+        tr_error("mbedtls_x509_crt_parse_der_nocopy() failed: -0x%04X", -ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _empty = false;
+    return NSAPI_ERROR_OK;
+}
+
+mbedtls_x509_crt *TLSCAChain::get_chain()
+{
+    return _empty ? NULL : &_crt;
+}
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/TLSSessionCache.h"
+#include "kvstore/KVStore.h"
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+// KVStore key of a host: the prefix and a hash of the host name
+#define TLS_SESSION_KV_PREFIX   "tls_sess_"
+#define TLS_SESSION_KV_KEY_SIZE (sizeof(TLS_SESSION_KV_PREFIX) + 8)
+
+TLSSessionCache::TLSSessionCache(size_t max_entries, mbed::KVStore *kvstore)
+    : _max_entries(max_entries), _use_count(0), _kvstore(kvstore)
+{
+    _entries = new (std::nothrow) entry[_max_entries]();
+    if (!_entries) {
+        _max_entries = 0;
+    }
+}
+
+TLSSessionCache::~TLSSessionCache()
+{
+    clear();
+    delete[] _entries;
+}
+
+nsapi_error_t TLSSessionCache::store(const char *host, const void *data, size_t size)
+{
+    if (!host || !*host || !data || !size) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    entry *e = insert(host, data, size);
+    if (!e && !_kvstore) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    if (_kvstore) {
+        // the value is the host name followed by the session, so that a hash
+        // collision doesn't hand a session to another host
+        size_t host_len = strlen(host) + 1;
+        uint8_t *value = e ? e->buffer : new (std::nothrow) uint8_t[host_len + size];
+        if (value) {
+            if (!e) {
+                memcpy(value, host, host_len);
+                memcpy(value + host_len, data, size);
+            }
+            char key[TLS_SESSION_KV_KEY_SIZE];
+            kv_key(host, key);
+            _kvstore->set(key, value, host_len + size, 0);
+            if (!e) {
+                delete[] value;
+            }
+        }
+    }
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+size_t TLSSessionCache::load(const char *host, void *buffer, size_t size)
+{
+    if (!host || !*host) {
+        return 0;
+    }
+
+    _mutex.lock();
+    entry *e = find(host);
+    if (!e && _kvstore && kv_load(host)) {
+        e = find(host);
+    }
+
+    size_t session_size = 0;
+    if (e) {
+        e->last_use = ++_use_count;
+        session_size = e->size;
+        if (buffer && size >= session_size) {
+            memcpy(buffer, e->buffer + e->host_len, session_size);
+        }
+    }
+    _mutex.unlock();
+
+    return session_size;
+}
+
+void TLSSessionCache::remove(const char *host)
+{
+    if (!host || !*host) {
+        return;
+    }
+
+    _mutex.lock();
+    entry *e = find(host);
+    if (e) {
+        free_entry(e);
+    }
+
+    if (_kvstore) {
+        char key[TLS_SESSION_KV_KEY_SIZE];
+        kv_key(host, key);
+        _kvstore->remove(key);
+    }
+    _mutex.unlock();
+}
+
+void TLSSessionCache::clear()
+{
+    _mutex.lock();
+    for (size_t i = 0; i < _max_entries; i++) {
+        free_entry(&_entries[i]);
+    }
+    _mutex.unlock();
+}
+
+TLSSessionCache *TLSSessionCache::get_default_instance()
+{
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0
+    static TLSSessionCache cache(MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE);
+    return &cache;
+#else
+    return NULL;
+#endif
+}
+
+TLSSessionCache::entry *TLSSessionCache::find(const char *host)
+{
+    for (size_t i = 0; i < _max_entries; i++) {
+        if (_entries[i].buffer && strcmp((const char *)_entries[i].buffer, host) == 0) {
+            return &_entries[i];
+        }
+    }
+    return NULL;
+}
+
+TLSSessionCache::entry *TLSSessionCache::insert(const char *host, const void *data, size_t size)
+{
+    if (!_max_entries) {
+        return NULL;
+    }
+
+    size_t host_len = strlen(host) + 1;
+    uint8_t *buffer = new (std::nothrow) uint8_t[host_len + size];
+    if (!buffer) {
+        return NULL;
+    }
+    memcpy(buffer, host, host_len);
+    memcpy(buffer + host_len, data, size);
+
+    // replace the session of the host, else a free or the least recently used entry
+    entry *e = find(host);
+    for (size_t i = 0; !e && i < _max_entries; i++) {
+        if (!_entries[i].buffer) {
+            e = &_entries[i];
+        }
+    }
+    if (!e) {
+        e = &_entries[0];
+        for (size_t i = 1; i < _max_entries; i++) {
+            if ((int32_t)(_entries[i].last_use - e->last_use) < 0) {
+                e = &_entries[i];
+            }
+        }
+    }
+
+    free_entry(e);
+    e->buffer = buffer;
+    e->host_len = host_len;
+    e->size = size;
+    e->last_use = ++_use_count;
+    return e;
+}
+
+void TLSSessionCache::free_entry(entry *e)
+{
+    delete[] e->buffer;
+    e->buffer = NULL;
+    e->host_len = 0;
+    e->size = 0;
+}
+
+void TLSSessionCache::kv_key(const char *host, char *key)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for (const char *c = host; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    snprintf(key, TLS_SESSION_KV_KEY_SIZE, TLS_SESSION_KV_PREFIX "%08lx", (unsigned long)hash);
+}
+
+size_t TLSSessionCache::kv_load(const char *host)
+{
+    char key[TLS_SESSION_KV_KEY_SIZE];
+    kv_key(host, key);
+
+    mbed::KVStore::info_t info;
+    size_t host_len = strlen(host) + 1;
+    if (_kvstore->get_info(key, &info) != 0 || info.size <= host_len) {
+        return 0;
+    }
+
+    uint8_t *value = new (std::nothrow) uint8_t[info.size];
+    if (!value) {
+        return 0;
+    }
+
+    size_t actual_size = 0;
+    size_t size = 0;
+    if (_kvstore->get(key, value, info.size, &actual_size) == 0 && actual_size == info.size
+            && memcmp(value, host, host_len) == 0) {
+        if (insert(host, value + host_len, info.size - host_len)) {
+            size = info.size - host_len;
+        }
+    }
+    delete[] value;
+    return size;
+}
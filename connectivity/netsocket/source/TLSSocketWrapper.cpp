@@ -24,8 +24,15 @@
 #include "mbed-trace/mbed_trace.h"
 #include "mbedtls/debug.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "mbed_error.h"
 #include "rtos/Kernel.h"
+#include <new>
+
+#if MBED_CONF_NSAPI_TLS_SHARED_DRBG && defined(MBEDTLS_CTR_DRBG_C)
+#include "shared_rng.h"
+#define TLS_SHARED_DRBG 1
+#endif
 
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
@@ -40,6 +47,8 @@ TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, cont
     _clicert_allocated(false),
     _ssl_conf_allocated(false)
 {
+    _session_cache = TLSSessionCache::get_default_instance();
+
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(nullptr);
     if (ret != 0) {
@@ -180,7 +189,13 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     /*
      * Initialize TLS-related stuf.
      */
-#if defined(MBEDTLS_CTR_DRBG_C)
+#if defined(TLS_SHARED_DRBG)
+    // Seeded by the first handshake, then reused by all the sockets
+    if ((ret = mbed_shared_ctr_drbg_init()) != 0) {
+        print_mbedtls_error("mbed_shared_ctr_drbg_init", ret);
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+#elif defined(MBEDTLS_CTR_DRBG_C)
     if ((ret = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
                                      (const unsigned char *) DRBG_PERS,
                                      sizeof(DRBG_PERS))) != 0) {
@@ -199,7 +214,9 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
 #error "CTR or HMAC must be defined for TLSSocketWrapper!"
 #endif
 
-#if !defined(MBEDTLS_SSL_CONF_RNG)
+#if !defined(MBEDTLS_SSL_CONF_RNG) && defined(TLS_SHARED_DRBG)
+    mbedtls_ssl_conf_rng(get_ssl_config(), mbed_shared_ctr_drbg_random, nullptr);
+#elif !defined(MBEDTLS_SSL_CONF_RNG)
     mbedtls_ssl_conf_rng(get_ssl_config(), DRBG_RANDOM, &_drbg);
 #endif
 
@@ -216,6 +233,13 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
+    if ((ret = setup_ssl_context()) != 0) {
+        print_mbedtls_error("setup_ssl_context", ret);
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+
+    load_session();
+
     _transport->set_blocking(false);
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
 
@@ -242,6 +266,11 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     return ret;
 }
 
+int TLSSocketWrapper::setup_ssl_context()
+{
+    return 0;
+}
+
 nsapi_error_t TLSSocketWrapper::continue_handshake()
 {
     int ret;
@@ -303,6 +332,8 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     delete[] buf;
 #endif
 
+    store_session();
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
@@ -311,6 +342,7 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
 nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
 {
     int ret;
+    nsapi_size_t written = 0;
 
     if (!_transport) {
         return NSAPI_ERROR_NO_SOCKET;
@@ -328,7 +360,15 @@ nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
             }
         }
 
-        ret = mbedtls_ssl_write(&_ssl, (const unsigned char *) data, size);
+        // mbedtls_ssl_write writes at most one record. Like TCPSocket::send,
+        // a blocking send writes the whole buffer, one record after the other.
+        ret = mbedtls_ssl_write(&_ssl, (const unsigned char *) data + written, size - written);
+        if (ret >= 0) {
+            written += ret;
+            if (written >= size || ret == 0) {
+                break;
+            }
+        }
 
         if (_timeout == 0) {
             break;
@@ -339,11 +379,15 @@ nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
                 // Timeout break
                 break;
             }
-        } else {
+        } else if (ret < 0) {
             break;
         }
     }
 
+    if (written) {
+        return written;
+    }
+
     if (ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
             ret == MBEDTLS_ERR_SSL_WANT_READ) {
         // translate to socket error
@@ -558,11 +602,18 @@ void TLSSocketWrapper::set_ca_chain(mbedtls_x509_crt *crt)
         delete _cacert;
         _cacert_allocated = false;
     }
+    _shared_cacert.reset();
     _cacert = crt;
     tr_debug("mbedtls_ssl_conf_ca_chain()");
     mbedtls_ssl_conf_ca_chain(get_ssl_config(), _cacert, nullptr);
 }
 
+void TLSSocketWrapper::set_ca_chain(mbed::IntrusivePtr<TLSCAChain> chain)
+{
+    set_ca_chain(chain ? chain->get_chain() : nullptr);
+    _shared_cacert = chain;
+}
+
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 mbedtls_ssl_config *TLSSocketWrapper::get_ssl_config()
@@ -605,6 +656,71 @@ mbedtls_ssl_context *TLSSocketWrapper::get_ssl_context()
     return &_ssl;
 }
 
+void TLSSocketWrapper::set_session_cache(TLSSessionCache *cache)
+{
+    _session_cache = cache;
+}
+
+void TLSSocketWrapper::load_session()
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_X509_REMOVE_HOSTNAME_VERIFICATION)
+    if (!_session_cache || !_ssl.hostname) {
+        return;
+    }
+
+    size_t size = _session_cache->load(_ssl.hostname, nullptr, 0);
+    if (!size) {
+        return;
+    }
+
+    unsigned char *buf = new (std::nothrow) unsigned char[size];
+    if (!buf) {
+        return;
+    }
+
+    // a session that doesn't load only costs a full handshake
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (_session_cache->load(_ssl.hostname, buf, size) == size
+            && mbedtls_ssl_session_load(&session, buf, size) == 0
+            && mbedtls_ssl_set_session(&_ssl, &session) == 0) {
+        tr_debug("Resuming TLS session with %s", _ssl.hostname);
+    } else {
+        _session_cache->remove(_ssl.hostname);
+    }
+    mbedtls_ssl_session_free(&session);
+    mbedtls_platform_zeroize(buf, size);
+    delete[] buf;
+#endif
+}
+
+void TLSSocketWrapper::store_session()
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_X509_REMOVE_HOSTNAME_VERIFICATION)
+    // a session whose peer isn't verified must not skip verification next time
+    if (!_session_cache || !_ssl.hostname || mbedtls_ssl_get_verify_result(&_ssl) != 0) {
+        return;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    size_t size = 0;
+    if (mbedtls_ssl_get_session(&_ssl, &session) == 0
+            && mbedtls_ssl_session_save(&session, nullptr, 0, &size) == MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL
+            && size) {
+        unsigned char *buf = new (std::nothrow) unsigned char[size];
+        if (buf) {
+            if (mbedtls_ssl_session_save(&session, buf, size, &size) == 0) {
+                _session_cache->store(_ssl.hostname, buf, size);
+            }
+            mbedtls_platform_zeroize(buf, size);
+            delete[] buf;
+        }
+    }
+    mbedtls_ssl_session_free(&session);
+#endif
+}
+
 nsapi_error_t TLSSocketWrapper::close()
 {
     if (!_transport) {
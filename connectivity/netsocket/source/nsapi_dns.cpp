@@ -37,8 +37,11 @@ using rtos::Kernel::Clock;
 #define CLASS_IN 1
 
 #define RR_A 1
+#define RR_SOA 6
 #define RR_AAAA 28
 
+#define RCODE_NXDOMAIN 3
+
 // DNS options
 #define DNS_BUFFER_SIZE 512
 #define DNS_SERVERS_SIZE 5
@@ -47,6 +50,8 @@ using rtos::Kernel::Clock;
 #define DNS_QUERY_QUEUE_SIZE 5
 #define DNS_HOST_NAME_MAX_LEN 255
 #define DNS_TIMER_TIMEOUT 100
+// Cache entries are refreshed in the background in the last 1/8 of their TTL
+#define DNS_CACHE_PREFETCH_DIVISOR 8
 #if !defined(MIN)
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
@@ -56,7 +61,11 @@ struct DNS_CACHE {
     char *host;
     Clock::time_point expires;      /*!< time to live in milliseconds */
     Clock::time_point accessed;     /*!< last accessed */
-    uint8_t count;                  /*!< number of IP addresses */
+    Clock::time_point refresh;      /*!< refreshed when accessed after this */
+    uint32_t hash;                  /*!< hash of the host name */
+    nsapi_version_t version;        /*!< IP version, NSAPI_UNSPEC if the host name does not exist */
+    uint8_t count;                  /*!< number of IP addresses, 0 for a negative entry */
+    bool refreshing;                /*!< refresh query ongoing */
 };
 
 struct SOCKET_CB_DATA {
@@ -80,6 +89,7 @@ struct DNS_QUERY {
     call_in_callback_cb_t call_in_cb;
     nsapi_size_t addr_count;
     nsapi_version_t version;
+    nsapi_version_t qtype_version;
     UDPSocket *socket;
     SOCKET_CB_DATA *socket_cb_data;
     nsapi_addr_t *addrs;
@@ -95,12 +105,15 @@ struct DNS_QUERY {
     dns_state state;
 };
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count);
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static void nsapi_dns_cache_add(const char *host, nsapi_version_t version, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count);
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh);
 static void nsapi_dns_cache_reset();
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name);
 
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version);
 static void nsapi_dns_query_async_create(void *ptr);
 static nsapi_error_t nsapi_dns_query_async_delete(intptr_t unique_id);
 static void nsapi_dns_query_async_send(void *ptr);
@@ -230,10 +243,32 @@ static int dns_append_question(uint8_t *ptr, uint16_t id, const char *host, nsap
     return *p - s_ptr;
 }
 
-static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint32_t> *ttl, nsapi_addr_t *addr, unsigned addr_count)
+static void dns_scan_name(const uint8_t **p)
 {
+    while (true) {
+        uint8_t len = dns_scan_byte(p);
+        if (len == 0) {
+            break;
+        } else if (len & 0xc0) { // this is link
+            dns_scan_byte(p);
+            break;
+        }
+
+        *p += len;
+    }
+}
+
+// Returns the number of addresses, or -1 if the response is not for the query.
+// When a response without addresses can be cached (RFC 2308), ttl is its
+// negative caching time, otherwise zero.
+static int dns_scan_response(const uint8_t *ptr, nsapi_size_t size, uint16_t exp_id, duration<uint32_t> *ttl, nsapi_addr_t *addr, unsigned addr_count, bool *nxdomain)
+{
+    const uint8_t *end = ptr + size;
     const uint8_t **p = &ptr;
 
+    *ttl = ttl->zero();
+    *nxdomain = false;
+
     // scan header
     uint16_t id    = dns_scan_word(p);
     uint16_t flags = dns_scan_word(p);
@@ -243,7 +278,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
 
     uint16_t qdcount = dns_scan_word(p); // qdcount
     uint16_t ancount = dns_scan_word(p); // ancount
-    dns_scan_word(p);                    // nscount
+    uint16_t nscount = dns_scan_word(p); // nscount
     dns_scan_word(p);                    // arcount
 
     // verify header is response to query
@@ -251,20 +286,13 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
         return -1;
     }
 
-    if (rcode != 0) {
+    if (rcode != 0 && rcode != RCODE_NXDOMAIN) {
         return 0;
     }
 
     // skip questions
     for (int i = 0; i < qdcount; i++) {
-        while (true) {
-            uint8_t len = dns_scan_byte(p);
-            if (len == 0) {
-                break;
-            }
-
-            *p += len;
-        }
+        dns_scan_name(p);
 
         dns_scan_word(p); // qtype
         dns_scan_word(p); // qclass
@@ -274,17 +302,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
     unsigned count = 0;
 
     for (int i = 0; i < ancount && count < addr_count; i++) {
-        while (true) {
-            uint8_t len = dns_scan_byte(p);
-            if (len == 0) {
-                break;
-            } else if (len & 0xc0) { // this is link
-                dns_scan_byte(p);
-                break;
-            }
-
-            *p += len;
-        }
+        dns_scan_name(p);
 
         uint16_t rtype    = dns_scan_word(p);    // rtype
         uint16_t rclass   = dns_scan_word(p);    // rclass
@@ -323,10 +341,65 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
         }
     }
 
-    return count;
+    if (rcode == 0 && count) {
+        return count;
+    }
+
+    // Name error or no data: negative caching time is the lesser of the SOA
+    // record TTL and its MINIMUM field, no SOA record means no caching
+    *ttl = ttl->zero();
+    *nxdomain = (rcode == RCODE_NXDOMAIN);
+
+    for (int i = 0; i < nscount && *p < end; i++) {
+        dns_scan_name(p);
+
+        if (*p + 10 > end) {
+            break;
+        }
+        uint16_t rtype    = dns_scan_word(p);    // rtype
+        dns_scan_word(p);                        // rclass
+        uint32_t ttl_val  = dns_scan_word32(p);  // ttl
+        uint16_t rdlength = dns_scan_word(p);    // rdlength
+
+        if (*p + rdlength > end) {
+            break;
+        }
+
+        if (rtype == RR_SOA && rdlength >= 22) {
+            *p += rdlength - 4;
+            uint32_t minimum = dns_scan_word32(p);
+            uint32_t neg_ttl = MIN(MIN(ttl_val, minimum), (uint32_t)MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL);
+            *ttl = duration<uint32_t>(neg_ttl);
+            break;
+        }
+
+        *p += rdlength;
+    }
+
+    return 0;
+}
+
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+static uint32_t nsapi_dns_cache_hash(const char *host)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for (const char *c = host; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    return hash;
 }
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count)
+static void nsapi_dns_cache_free(int index)
+{
+    delete[] dns_cache[index]->host;
+    delete[] dns_cache[index]->address;
+    delete dns_cache[index];
+    dns_cache[index] = NULL;
+}
+#endif
+
+static void nsapi_dns_cache_add(const char *host, nsapi_version_t version, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count)
 {
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     // RFC 1034: if TTL is zero, entry is not added to cache
@@ -334,19 +407,22 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duratio
         return;
     }
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
-    }
+    uint32_t hash = nsapi_dns_cache_hash(host);
 
     dns_cache_mutex->lock();
 
     int index = -1;
     Clock::time_point accessed = Clock::time_point::max();
 
-    // Finds free or last accessed entry
+    // Finds the entry of the host, or free or last accessed entry
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (!dns_cache[i]) {
+            if (accessed != Clock::time_point::min()) {
+                accessed = Clock::time_point::min();
+                index = i;
+            }
+        } else if (dns_cache[i]->hash == hash && dns_cache[i]->version == version &&
+                   strcmp(dns_cache[i]->host, host) == 0) {
             index = i;
             break;
         } else if (dns_cache[i]->accessed <= accessed) {
@@ -360,58 +436,83 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duratio
         return;
     }
 
-    // Allocates in case entry is free, otherwise reuses
-    if (!dns_cache[index]) {
-        dns_cache[index] = new (std::nothrow) DNS_CACHE;
-    } else {
-        delete dns_cache[index]->host;
-        delete dns_cache[index]->address;
-    }
-
+    // Replaces the entry, so that a refresh doesn't leave the old one behind
     if (dns_cache[index]) {
-        dns_cache[index]->address = new (std::nothrow) nsapi_addr_t[count];
+        nsapi_dns_cache_free(index);
+    }
+
+    DNS_CACHE *entry = new (std::nothrow) DNS_CACHE;
+    if (entry) {
+        entry->address = count ? new (std::nothrow) nsapi_addr_t[count] : NULL;
+        entry->host = new (std::nothrow) char[strlen(host) + 1];
+        if ((count && !entry->address) || !entry->host) {
+            delete[] entry->address;
+            delete[] entry->host;
+            delete entry;
+            dns_cache_mutex->unlock();
+            return;
+        }
         for (int i = 0; i < count; i++) {
-            dns_cache[index]->address[i] = address[i];
+            entry->address[i] = address[i];
         }
-        dns_cache[index]->count = count;
-        dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
-        strcpy(dns_cache[index]->host, host);
+        entry->count = count;
+        strcpy(entry->host, host);
+        entry->hash = hash;
+        entry->version = version;
         auto now = Clock::now();
-        dns_cache[index]->expires = now + ttl;
-        dns_cache[index]->accessed = now;
+        entry->expires = now + ttl;
+        entry->accessed = now;
+        entry->refresh = entry->expires - ttl / DNS_CACHE_PREFETCH_DIVISOR;
+        entry->refreshing = false;
+        dns_cache[index] = entry;
     }
 
     dns_cache_mutex->unlock();
 #endif
 }
 
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address)
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh)
 {
     nsapi_error_t ret_val = NSAPI_ERROR_NO_ADDRESS;
 
+    if (refresh) {
+        *refresh = false;
+    }
+
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
     dns_cache_mutex->lock();
 
+    auto now = Clock::now();
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (dns_cache[i]) {
-            auto now = Clock::now();
             // Checks all entries for expired entries
             if (now > dns_cache[i]->expires) {
-                delete dns_cache[i]->host;
-                delete dns_cache[i]->address;
-                delete dns_cache[i];
-                dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address[0].version) && //only first IP address version check, others have the same version
-                       strcmp(dns_cache[i]->host, host) == 0) {
+                nsapi_dns_cache_free(i);
+            } else if ((version == NSAPI_UNSPEC || dns_cache[i]->version == NSAPI_UNSPEC || version == dns_cache[i]->version) &&
+                       dns_cache[i]->hash == hash && strcmp(dns_cache[i]->host, host) == 0) {
+                dns_cache[i]->accessed = now;
+                if (!dns_cache[i]->count) {
+                    // Negative entry, an address of the other version is still preferred
+                    if (ret_val < 0) {
+                        ret_val = NSAPI_ERROR_DNS_FAILURE;
+                    }
+                    continue;
+                }
+                ret_val = 0;
                 if (address) {
-                    ret_val = 0;
                     for (int count = 0; count < dns_cache[i]->count; count++) {
                         address[count] = dns_cache[i]->address[count];
                         ret_val++;
                     }
                 }
-                dns_cache[i]->accessed = now;
-
+                // Refreshes the entry once before it expires
+                if (refresh && !dns_cache[i]->refreshing && now >= dns_cache[i]->refresh) {
+                    dns_cache[i]->refreshing = true;
+                    *refresh = true;
+                }
+                break;
             }
         }
     }
@@ -428,11 +529,7 @@ static void nsapi_dns_cache_reset()
     dns_cache_mutex->lock();
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
         if (dns_cache[i]) {
-            delete[] dns_cache[i]->host;
-            dns_cache[i]->host = NULL;
-            delete[] dns_cache[i]->address;
-            delete dns_cache[i];
-            dns_cache[i] = NULL;
+            nsapi_dns_cache_free(i);
         }
     }
     dns_cache_mutex->unlock();
@@ -475,6 +572,30 @@ static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *ind
     return NSAPI_ERROR_OK;
 }
 
+// Runs the prefetch of blocking queries, that have no call in callback of the stack
+static nsapi_error_t nsapi_dns_shared_queue_call_in(int delay, mbed::Callback<void()> func)
+{
+    events::EventQueue *event_queue = mbed::mbed_event_queue();
+
+    if (!event_queue) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    int id = delay > 0 ? event_queue->call_in(milliseconds(delay), func) : event_queue->call(func);
+
+    return id ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_MEMORY;
+}
+
+// Queries an entry nearing expiry in the background, the response replaces it
+static void nsapi_dns_cache_prefetch(NetworkStack *stack, const char *host, nsapi_version_t version,
+                                     call_in_callback_cb_t call_in_cb, const char *interface_name)
+{
+    dns_mutex->lock();
+    nsapi_dns_query_async_queue(stack, host, NetworkStack::hostbyname_cb_t(), MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT,
+                                call_in_cb, interface_name, version);
+    dns_mutex->unlock();
+}
+
 // core query function
 static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
                                                       nsapi_addr_t *addr, unsigned addr_count,  const char *interface_name, nsapi_version_t version)
@@ -487,16 +608,24 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 
     // check cache
     nsapi_addr *tmp = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, tmp);
+    bool refresh;
+    int cached = nsapi_dns_cache_find(host, version, tmp, &refresh);
     if (cached > 0) {
         unsigned int us_cached = cached;
         for (unsigned int i = 0;  i < MIN(us_cached, addr_count); i++) {
             addr[i] = tmp[i];
         }
+        if (refresh) {
+            nsapi_dns_cache_prefetch(stack, host, tmp[0].version, nsapi_dns_shared_queue_call_in, interface_name);
+        }
         delete [] tmp;
         return MIN(us_cached, addr_count);
     }
     delete [] tmp;
+    if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        // Host name does not exist or has no addresses of the version
+        return cached;
+    }
     // create a udp socket
     UDPSocket socket;
     int err = socket.open(stack);
@@ -572,12 +701,15 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 
         const uint8_t *response = packet;
         duration<uint32_t> ttl;
-        int resp = dns_scan_response(response, 1, &ttl, addr, addr_count);
+        bool nxdomain;
+        int resp = dns_scan_response(response, err, 1, &ttl, addr, addr_count, &nxdomain);
         if (resp > 0) {
-            nsapi_dns_cache_add(host, addr, ttl, resp);
+            nsapi_dns_cache_add(host, addr[0].version, addr, ttl, resp);
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else {
+            nsapi_dns_cache_add(host, nxdomain ? NSAPI_UNSPEC : dns_addr.get_ip_version(), NULL, ttl, 0);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -695,6 +827,7 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     dns_mutex->lock();
 
     if (!stack) {
+        dns_mutex->unlock();
         return NSAPI_ERROR_PARAMETER;
     }
 
@@ -706,7 +839,13 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     nsapi_addr *address = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, address);
+    bool refresh;
+    int cached = nsapi_dns_cache_find(host, version, address, &refresh);
+    if (refresh) {
+        nsapi_dns_query_async_queue(stack, host, NetworkStack::hostbyname_cb_t(), MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT,
+                                    call_in_cb, interface_name, address[0].version);
+    }
+
     if (!addr_count) {
         if (cached > 0) {
             SocketAddress addr(*address);
@@ -731,6 +870,24 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
         }
     }
     delete[] address;
+
+    if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        // Host name does not exist or has no addresses of the version
+        dns_mutex->unlock();
+        return cached;
+    }
+
+    nsapi_value_or_error_t ret = nsapi_dns_query_async_queue(stack, host, callback, addr_count, call_in_cb, interface_name, version);
+
+    dns_mutex->unlock();
+
+    return ret;
+}
+
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
+{
     int index = -1;
 
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
@@ -741,21 +898,18 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     if (index < 0) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
     DNS_QUERY *query = new (std::nothrow) DNS_QUERY;
 
     if (!query) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
-    query->host = new (std::nothrow) char[host_len + 1];
+    query->host = new (std::nothrow) char[strlen(host) + 1];
     if (!query->host) {
         delete query;
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
     strcpy(query->host, host);
@@ -765,6 +919,7 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     query->stack = stack;
     query->addr_count = addr_count;
     query->version = version;
+    query->qtype_version = version;
     query->socket = NULL;
     query->socket_cb_data = NULL;
     query->addrs = NULL;
@@ -805,7 +960,6 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
             delete[] query->host;
             delete query;
             dns_query_queue[index] = NULL;
-            dns_mutex->unlock();
             return NSAPI_ERROR_NO_MEMORY;
         }
         dns_timer_running = true;
@@ -814,35 +968,41 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     // Initiates query
     nsapi_dns_query_async_initiate_next();
 
-    dns_mutex->unlock();
-
     return query->unique_id;
 }
 
 static void nsapi_dns_query_async_initiate_next(void)
 {
-    intptr_t id = INTPTR_MAX;
-    DNS_QUERY *query = NULL;
+    int ongoing = 0;
 
-    // Trigger next query to start, find one that has been on queue longest
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
-        if (dns_query_queue[i]) {
-            if (dns_query_queue[i]->state == DNS_CREATED) {
-                if (dns_query_queue[i]->unique_id <= id) {
-                    query = dns_query_queue[i];
-                    id = dns_query_queue[i]->unique_id;
-                }
-                // If some query is already ongoing do not trigger
-            } else if (dns_query_queue[i]->state == DNS_INITIATED) {
-                query = NULL;
-                break;
-            }
+        if (dns_query_queue[i] && dns_query_queue[i]->state == DNS_INITIATED) {
+            ongoing++;
         }
     }
 
-    if (query) {
+    // Trigger next queries to start, up to the limit of queries sent at the
+    // same time, the ones that have been on queue longest first. Responses are
+    // matched to the queries by the message id.
+    while (ongoing < MBED_CONF_NSAPI_DNS_PARALLEL_QUERIES) {
+        intptr_t id = INTPTR_MAX;
+        DNS_QUERY *query = NULL;
+
+        for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
+            if (dns_query_queue[i] && dns_query_queue[i]->state == DNS_CREATED &&
+                    dns_query_queue[i]->unique_id <= id) {
+                query = dns_query_queue[i];
+                id = dns_query_queue[i]->unique_id;
+            }
+        }
+
+        if (!query) {
+            break;
+        }
+
         query->state = DNS_INITIATED;
         nsapi_dns_call_in(query->call_in_cb, 0, mbed::callback(nsapi_dns_query_async_create, reinterpret_cast<void *>(query->unique_id)));
+        ongoing++;
     }
 }
 
@@ -1106,7 +1266,8 @@ static void nsapi_dns_query_async_send(void *ptr)
             continue;
         }
         // send the question
-        int len = dns_append_question(packet, query->dns_message_id, query->host, dns_addr.get_ip_version());
+        query->qtype_version = dns_addr.get_ip_version();
+        int len = dns_append_question(packet, query->dns_message_id, query->host, query->qtype_version);
 
         err = query->socket->sendto(dns_addr, packet, len);
 
@@ -1198,13 +1359,17 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
 
             query->addrs = new (std::nothrow) nsapi_addr_t[requested_count];
 
-            int resp = dns_scan_response(packet, id, &(query->ttl), query->addrs, requested_count);
+            bool nxdomain;
+            int resp = dns_scan_response(packet, size, id, &(query->ttl), query->addrs, requested_count, &nxdomain);
 
             // Ignore invalid responses
             if (resp < 0) {
                 delete[] query->addrs;
                 query->addrs = 0;
             } else {
+                if (resp == 0) {
+                    nsapi_dns_cache_add(query->host, nxdomain ? NSAPI_UNSPEC : query->qtype_version, NULL, query->ttl, 0);
+                }
                 query->count = resp;
                 query->status = NSAPI_ERROR_DNS_FAILURE; // Used in case failure, otherwise ok
                 query->socket_timeout = 0;
@@ -1245,7 +1410,7 @@ static void nsapi_dns_query_async_response(void *ptr)
             }
 
             // Adds address to cache
-            nsapi_dns_cache_add(query->host, &(query->addrs[0]), query->ttl, query->count);
+            nsapi_dns_cache_add(query->host, query->addrs[0].version, &(query->addrs[0]), query->ttl, query->count);
             status = query->count;
         }
 
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Throughput of the default network interface.
+ *
+ * The client cases stream data for THROUGHPUT_DURATION to and from the
+ * discard, chargen and echo services of the echo server, the same services
+ * the tcp and udp tests use. When throughput-server-port is set, the server
+ * cases then accept a TCP connection and receive UDP datagrams on that
+ * port, for `iperf -c <board> -p <port>` and `iperf -u -c <board> -p <port>`.
+ *
+ * Every case reports bytes per second, packets per second, the share of
+ * the time the CPU was idle (with MBED_CPU_STATS_ENABLED) and the heap
+ * high-water mark (with MBED_HEAP_STATS_ENABLED), printed and sent to the
+ * host as a `throughput` key-value pair:
+ *   name,bytes,duration_us,bytes_per_s,packets_per_s,idle_percent,heap_max
+ * with -1 for the figures unavailable.
+ */
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] throughput test cases require a RTOS to run
+#else
+
+#define WIFI 2
+#if !defined(MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE) || \
+    (MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == WIFI && !defined(MBED_CONF_NSAPI_DEFAULT_WIFI_SSID))
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "utest/utest_stack_trace.h"
+#include "throughput_tests.h"
+
+#ifndef ECHO_SERVER_ADDR
+#error [NOT_SUPPORTED] Requires parameters for echo server
+#else
+
+using namespace utest::v1;
+
+char throughput_global::buffer[BUFF_SIZE];
+
+static void _ifup()
+{
+    NetworkInterface *net = NetworkInterface::get_default_instance();
+    nsapi_error_t err = net->connect();
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    SocketAddress address;
+    net->get_ip_address(&address);
+
+#define MESH 3
+#if MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == MESH
+    printf("Waiting for GLOBAL_UP\n");
+    while (net->get_connection_status() != NSAPI_STATUS_GLOBAL_UP) {
+        ThisThread::sleep_for(500);
+    }
+#endif
+    printf("MBED: Throughput IP address is '%s'\n", address ? address.get_ip_address() : "null");
+}
+
+static void _ifdown()
+{
+    NetworkInterface::get_default_instance()->disconnect();
+    tr_info("MBED: ifdown");
+}
+
+nsapi_error_t get_server_address(SocketAddress &address, uint16_t port)
+{
+    nsapi_error_t err = NetworkInterface::get_default_instance()->gethostbyname(ECHO_SERVER_ADDR, &address);
+    if (err != NSAPI_ERROR_OK) {
+        tr_error("Error from gethostbyname: %d", err);
+        return err;
+    }
+    address.set_port(port);
+    tr_info("MBED: Server '%s', port %d", address.get_ip_address(), address.get_port());
+    return NSAPI_ERROR_OK;
+}
+
+void fill_tx_buffer_ascii(char *buff, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        buff[i] = (rand() % 43) + '0';
+    }
+}
+
+void ThroughputMeter::start()
+{
+    _bytes = 0;
+    _packets = 0;
+    _idle_start = 0;
+    _uptime_start = 0;
+#if MBED_CPU_STATS_ENABLED
+    mbed_stats_cpu_t cpu;
+    mbed_stats_cpu_get(&cpu);
+    _idle_start = cpu.idle_time;
+    _uptime_start = cpu.uptime;
+#endif
+    _timer.reset();
+    _timer.start();
+}
+
+bool ThroughputMeter::expired() const
+{
+    return _timer.elapsed_time() >= THROUGHPUT_DURATION;
+}
+
+void ThroughputMeter::report(const char *name)
+{
+    _timer.stop();
+    uint64_t duration_us = _timer.elapsed_time().count();
+    if (duration_us == 0) {
+        duration_us = 1;
+    }
+
+    long idle_percent = -1;
+#if MBED_CPU_STATS_ENABLED
+    mbed_stats_cpu_t cpu;
+    mbed_stats_cpu_get(&cpu);
+    if (cpu.uptime > _uptime_start) {
+        idle_percent = (long)(((cpu.idle_time - _idle_start) * 100) / (cpu.uptime - _uptime_start));
+    }
+#endif
+
+    long heap_max = -1;
+#if MBED_HEAP_STATS_ENABLED
+    mbed_stats_heap_t heap;
+    mbed_stats_heap_get(&heap);
+    heap_max = (long)heap.max_size;
+#endif
+
+    unsigned long bytes_per_s = (unsigned long)((_bytes * 1000000) / duration_us);
+    unsigned long packets_per_s = (unsigned long)(((uint64_t)_packets * 1000000) / duration_us);
+
+    printf("MBED: %s: %llu bytes in %llu ms, %lu kbit/s, %lu packets/s, idle %ld%%, heap max %ld\n",
+           name, (unsigned long long)_bytes, (unsigned long long)(duration_us / 1000),
+           bytes_per_s * 8 / 1000, packets_per_s, idle_percent, heap_max);
+
+    char value[128];
+    snprintf(value, sizeof(value), "%s,%llu,%llu,%lu,%lu,%ld,%ld", name,
+             (unsigned long long)_bytes, (unsigned long long)duration_us,
+             bytes_per_s, packets_per_s, idle_percent, heap_max);
+    greentea_send_kv("throughput", value);
+}
+
+// Test setup
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(throughput_global::TESTS_TIMEOUT, "default_auto");
+    _ifup();
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+void greentea_teardown(const size_t passed, const size_t failed, const failure_t failure)
+{
+    _ifdown();
+    return greentea_test_teardown_handler(passed, failed, failure);
+}
+
+static void test_failure_handler(const failure_t failure)
+{
+    UTEST_LOG_FUNCTION();
+    if (failure.location == LOCATION_TEST_SETUP || failure.location == LOCATION_TEST_TEARDOWN) {
+        verbose_test_failure_handler(failure);
+        GREENTEA_TESTSUITE_RESULT(false);
+        while (1) ;
+    }
+}
+
+Case cases[] = {
+    Case("THROUGHPUT_TCP_UPLOAD", THROUGHPUT_TCP_UPLOAD),
+    Case("THROUGHPUT_TCP_DOWNLOAD", THROUGHPUT_TCP_DOWNLOAD),
+    Case("THROUGHPUT_UDP_UPLOAD", THROUGHPUT_UDP_UPLOAD),
+    Case("THROUGHPUT_UDP_ROUND_TRIP", THROUGHPUT_UDP_ROUND_TRIP),
+#ifdef THROUGHPUT_SERVER_PORT
+    Case("THROUGHPUT_TCP_SERVER", THROUGHPUT_TCP_SERVER),
+    Case("THROUGHPUT_UDP_SERVER", THROUGHPUT_UDP_SERVER),
+#endif
+};
+
+handlers_t throughput_test_case_handlers = {
+    default_greentea_test_setup_handler,
+    greentea_test_teardown_handler,
+    test_failure_handler,
+    greentea_case_setup_handler,
+    greentea_case_teardown_handler,
+    greentea_case_failure_continue_handler
+};
+
+Specification specification(greentea_setup, cases, greentea_teardown, throughput_test_case_handlers);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // ECHO_SERVER_ADDR
+#endif // !defined(MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE) || (MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == WIFI && !defined(MBED_CONF_NSAPI_DEFAULT_WIFI_SSID))
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "throughput_tests.h"
+
+using namespace std::chrono;
+using namespace utest::v1;
+
+namespace {
+static constexpr seconds SOCKET_TIMEOUT = 10s;
+}
+
+static bool _tcp_connect(TCPSocket &sock, uint16_t port)
+{
+    SocketAddress address;
+    if (get_server_address(address, port) != NSAPI_ERROR_OK) {
+        return false;
+    }
+    nsapi_error_t err = sock.open(NetworkInterface::get_default_instance());
+    if (err == NSAPI_ERROR_UNSUPPORTED) {
+        return false;
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.connect(address));
+    sock.set_timeout(duration_cast<milliseconds>(SOCKET_TIMEOUT).count());
+    return true;
+}
+
+void THROUGHPUT_TCP_UPLOAD()
+{
+    TCPSocket sock;
+    if (!_tcp_connect(sock, ECHO_SERVER_DISCARD_PORT)) {
+        TEST_SKIP_MESSAGE("TCP not supported");
+    }
+
+    fill_tx_buffer_ascii(throughput_global::buffer, throughput_global::BUFF_SIZE);
+
+    ThroughputMeter meter;
+    meter.start();
+    while (!meter.expired()) {
+        nsapi_size_or_error_t sent = sock.send(throughput_global::buffer, throughput_global::BUFF_SIZE);
+        if (sent < 0) {
+            TEST_FAIL_MESSAGE("send failed");
+            break;
+        }
+        meter.add(sent);
+    }
+    meter.report("tcp_upload");
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
+
+void THROUGHPUT_TCP_DOWNLOAD()
+{
+    TCPSocket sock;
+    if (!_tcp_connect(sock, THROUGHPUT_CHARGEN_PORT)) {
+        TEST_SKIP_MESSAGE("TCP not supported");
+    }
+
+    // Requesting the stream, as in TCPSOCKET_RECV_100K
+    TEST_ASSERT_EQUAL(1, sock.send("a", 1));
+
+    ThroughputMeter meter;
+    meter.start();
+    while (!meter.expired()) {
+        nsapi_size_or_error_t recvd = sock.recv(throughput_global::buffer, throughput_global::BUFF_SIZE);
+        if (recvd <= 0) {
+            TEST_FAIL_MESSAGE("recv failed");
+            break;
+        }
+        meter.add(recvd);
+    }
+    meter.report("tcp_download");
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
+
+#ifdef THROUGHPUT_SERVER_PORT
+void THROUGHPUT_TCP_SERVER()
+{
+    TCPSocket server;
+    nsapi_error_t err = server.open(NetworkInterface::get_default_instance());
+    if (err == NSAPI_ERROR_UNSUPPORTED) {
+        TEST_SKIP_MESSAGE("TCP not supported");
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, server.bind(THROUGHPUT_SERVER_PORT));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, server.listen(1));
+
+    printf("MBED: Waiting for a TCP client on port %d\n", THROUGHPUT_SERVER_PORT);
+    Socket *client = server.accept(&err);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    TEST_ASSERT_NOT_NULL(client);
+    client->set_timeout(duration_cast<milliseconds>(SOCKET_TIMEOUT).count());
+
+    // Until the client closes the connection
+    ThroughputMeter meter;
+    meter.start();
+    while (true) {
+        nsapi_size_or_error_t recvd = client->recv(throughput_global::buffer, throughput_global::BUFF_SIZE);
+        if (recvd <= 0) {
+            break;
+        }
+        meter.add(recvd);
+    }
+    meter.report("tcp_server");
+
+    client->close();
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, server.close());
+    TEST_ASSERT_TRUE(meter.bytes() > 0);
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THROUGHPUT_TESTS_H
+#define THROUGHPUT_TESTS_H
+
+#include "../test_params.h"
+#include "mbed_trace.h"
+
+#define TRACE_GROUP "GRNT"
+
+#ifndef MBED_CONF_APP_THROUGHPUT_DURATION
+#define THROUGHPUT_DURATION std::chrono::seconds(10)
+#else
+#define THROUGHPUT_DURATION std::chrono::seconds(MBED_CONF_APP_THROUGHPUT_DURATION)
+#endif
+
+#ifndef MBED_CONF_APP_THROUGHPUT_CHARGEN_PORT
+#define THROUGHPUT_CHARGEN_PORT 19
+#else
+#define THROUGHPUT_CHARGEN_PORT MBED_CONF_APP_THROUGHPUT_CHARGEN_PORT
+#endif
+
+/* Port the server cases listen on, for an iperf client.
+ * The server cases only run when it is set.
+ */
+#ifdef MBED_CONF_APP_THROUGHPUT_SERVER_PORT
+#define THROUGHPUT_SERVER_PORT MBED_CONF_APP_THROUGHPUT_SERVER_PORT
+#endif
+
+namespace throughput_global {
+static const int TESTS_TIMEOUT = (15 * 60);
+
+static const int BUFF_SIZE = 1220;
+static const int SMALL_PACKET_SIZE = 64;
+
+extern char buffer[BUFF_SIZE];
+}
+
+/** Measurement of a throughput case: time, CPU idle time and heap use */
+class ThroughputMeter {
+public:
+    /** Start measuring, after the connection is set up */
+    void start();
+
+    /** Count data moved */
+    void add(size_t bytes)
+    {
+        _bytes += bytes;
+        _packets++;
+    }
+
+    /** Whether the case ran for THROUGHPUT_DURATION */
+    bool expired() const;
+
+    /** Stop measuring, print the results and send them to the host
+     *
+     *  @param name Name of the case, without commas
+     */
+    void report(const char *name);
+
+    uint64_t bytes() const
+    {
+        return _bytes;
+    }
+
+private:
+    mbed::Timer _timer;
+    uint64_t _bytes;
+    uint32_t _packets;
+    us_timestamp_t _idle_start;
+    us_timestamp_t _uptime_start;
+};
+
+nsapi_error_t get_server_address(SocketAddress &address, uint16_t port);
+void fill_tx_buffer_ascii(char *buff, size_t len);
+
+/*
+ * Test cases
+ */
+void THROUGHPUT_TCP_UPLOAD();
+void THROUGHPUT_TCP_DOWNLOAD();
+void THROUGHPUT_UDP_UPLOAD();
+void THROUGHPUT_UDP_ROUND_TRIP();
+#ifdef THROUGHPUT_SERVER_PORT
+void THROUGHPUT_TCP_SERVER();
+void THROUGHPUT_UDP_SERVER();
+#endif
+
+#endif //THROUGHPUT_TESTS_H
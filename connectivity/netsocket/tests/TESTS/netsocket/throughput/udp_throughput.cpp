@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "throughput_tests.h"
+
+using namespace std::chrono;
+using namespace utest::v1;
+
+namespace {
+static constexpr milliseconds ECHO_TIMEOUT = 1000ms;
+static constexpr seconds SERVER_IDLE_TIMEOUT = 3s;
+}
+
+static bool _udp_open(UDPSocket &sock)
+{
+    nsapi_error_t err = sock.open(NetworkInterface::get_default_instance());
+    if (err == NSAPI_ERROR_UNSUPPORTED) {
+        return false;
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, err);
+    return true;
+}
+
+void THROUGHPUT_UDP_UPLOAD()
+{
+    SocketAddress address;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, get_server_address(address, ECHO_SERVER_DISCARD_PORT));
+
+    UDPSocket sock;
+    if (!_udp_open(sock)) {
+        TEST_SKIP_MESSAGE("UDP not supported");
+    }
+
+    // The datagrams are sent as fast as the stack takes them; the stack
+    // answers NSAPI_ERROR_NO_MEMORY when its buffers are full, not counted.
+    fill_tx_buffer_ascii(throughput_global::buffer, throughput_global::BUFF_SIZE);
+    ThroughputMeter meter;
+    meter.start();
+    while (!meter.expired()) {
+        nsapi_size_or_error_t sent = sock.sendto(address, throughput_global::buffer, throughput_global::BUFF_SIZE);
+        if (sent == NSAPI_ERROR_NO_MEMORY || sent == NSAPI_ERROR_WOULD_BLOCK) {
+            ThisThread::yield();
+            continue;
+        }
+        if (sent < 0) {
+            TEST_FAIL_MESSAGE("sendto failed");
+            break;
+        }
+        meter.add(sent);
+    }
+    meter.report("udp_upload");
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
+
+void THROUGHPUT_UDP_ROUND_TRIP()
+{
+    SocketAddress address;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, get_server_address(address, ECHO_SERVER_PORT));
+
+    UDPSocket sock;
+    if (!_udp_open(sock)) {
+        TEST_SKIP_MESSAGE("UDP not supported");
+    }
+    sock.set_timeout(ECHO_TIMEOUT.count());
+
+    // One small datagram in flight at a time, for the packet rate and
+    // the round trip time of the stack rather than its bandwidth.
+    fill_tx_buffer_ascii(throughput_global::buffer, throughput_global::SMALL_PACKET_SIZE);
+    char rx_buffer[throughput_global::SMALL_PACKET_SIZE];
+    int lost = 0;
+    uint32_t replies = 0;
+    microseconds rtt_max = 0us;
+    microseconds rtt_total = 0us;
+    Timer rtt;
+
+    ThroughputMeter meter;
+    meter.start();
+    while (!meter.expired()) {
+        rtt.reset();
+        rtt.start();
+        nsapi_size_or_error_t sent = sock.sendto(address, throughput_global::buffer, throughput_global::SMALL_PACKET_SIZE);
+        if (sent != throughput_global::SMALL_PACKET_SIZE) {
+            lost++;
+            continue;
+        }
+        nsapi_size_or_error_t recvd = sock.recvfrom(NULL, rx_buffer, sizeof(rx_buffer));
+        rtt.stop();
+        if (recvd != throughput_global::SMALL_PACKET_SIZE) {
+            lost++;
+            continue;
+        }
+        meter.add(2 * recvd);
+        replies++;
+        rtt_total += rtt.elapsed_time();
+        rtt_max = std::max(rtt_max, duration_cast<microseconds>(rtt.elapsed_time()));
+    }
+    meter.report("udp_round_trip");
+
+    if (replies) {
+        printf("MBED: UDP round trip %lu us average, %lu us max, %d lost\n",
+               (unsigned long)(rtt_total.count() / replies), (unsigned long)rtt_max.count(), lost);
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+    TEST_ASSERT_TRUE(replies > 0);
+}
+
+#ifdef THROUGHPUT_SERVER_PORT
+void THROUGHPUT_UDP_SERVER()
+{
+    UDPSocket sock;
+    if (!_udp_open(sock)) {
+        TEST_SKIP_MESSAGE("UDP not supported");
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.bind(THROUGHPUT_SERVER_PORT));
+
+    printf("MBED: Waiting for UDP datagrams on port %d\n", THROUGHPUT_SERVER_PORT);
+    sock.set_blocking(true);
+    nsapi_size_or_error_t recvd = sock.recvfrom(NULL, throughput_global::buffer, throughput_global::BUFF_SIZE);
+    TEST_ASSERT_TRUE(recvd > 0);
+
+    // Measured from the first datagram until the client has been silent
+    // for SERVER_IDLE_TIMEOUT, which is not counted.
+    sock.set_timeout(duration_cast<milliseconds>(SERVER_IDLE_TIMEOUT).count());
+    ThroughputMeter meter;
+    meter.start();
+    meter.add(recvd);
+    while (true) {
+        recvd = sock.recvfrom(NULL, throughput_global::buffer, throughput_global::BUFF_SIZE);
+        if (recvd <= 0) {
+            break;
+        }
+        meter.add(recvd);
+    }
+    meter.report("udp_server");
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "netsocket/AsyncSocket.h"
+#include "netsocket/TCPSocket.h"
+#include "NetworkStack_stub.h"
+#include "equeue_stub.h"
+
+// Control the rtos EventFlags stub. See EventFlags_stub.cpp
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+// Lets the tests signal the socket as the network stack does
+class TCPSocketFriend : public TCPSocket {
+public:
+    using TCPSocket::event;
+};
+
+static nsapi_error_t connect_result;
+static int connect_calls;
+static nsapi_size_or_error_t send_result;
+static int send_calls;
+static nsapi_size_or_error_t recv_result;
+static int recv_calls;
+
+static void connect_cb(nsapi_error_t result)
+{
+    connect_result = result;
+    connect_calls++;
+}
+
+static void send_cb(nsapi_size_or_error_t result)
+{
+    send_result = result;
+    send_calls++;
+}
+
+static void recv_cb(nsapi_size_or_error_t result)
+{
+    recv_result = result;
+    recv_calls++;
+}
+
+class TestAsyncSocket : public testing::Test {
+protected:
+    TCPSocketFriend *socket;
+    AsyncSocket *async;
+    events::EventQueue *queue;
+    NetworkStackstub stack;
+    // Storage of the event posted by EventQueue::call()
+    uint64_t event_storage[32];
+    char buf[10];
+
+    virtual void SetUp()
+    {
+        connect_calls = send_calls = recv_calls = 0;
+        // The stub runs posted events at once
+        equeue_stub.void_ptr = event_storage;
+        equeue_stub.call_cb_immediately = true;
+
+        queue = new events::EventQueue();
+        socket = new TCPSocketFriend();
+        socket->open(&stack);
+        async = new AsyncSocket(socket, queue);
+    }
+
+    virtual void TearDown()
+    {
+        delete async;
+        delete socket;
+        delete queue;
+        stack.return_values.clear();
+        eventFlagsStubNextRetval.clear();
+        equeue_stub.void_ptr = NULL;
+        equeue_stub.call_cb_immediately = false;
+    }
+};
+
+TEST_F(TestAsyncSocket, constructor)
+{
+    EXPECT_EQ(async->get_socket(), socket);
+}
+
+TEST_F(TestAsyncSocket, connect_in_progress)
+{
+    const SocketAddress a("127.0.0.1", 1024);
+    stack.return_values.push_back(NSAPI_ERROR_IN_PROGRESS);
+    EXPECT_EQ(async->async_connect(a, connect_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(connect_calls, 0);
+    EXPECT_EQ(async->async_connect(a, connect_cb), NSAPI_ERROR_BUSY);
+
+    // Still connecting when the socket signals
+    stack.return_values.push_back(NSAPI_ERROR_ALREADY);
+    socket->event();
+    EXPECT_EQ(connect_calls, 0);
+
+    stack.return_values.push_back(NSAPI_ERROR_IS_CONNECTED);
+    socket->event();
+    EXPECT_EQ(connect_calls, 1);
+    EXPECT_EQ(connect_result, NSAPI_ERROR_OK);
+}
+
+TEST_F(TestAsyncSocket, connect_error)
+{
+    const SocketAddress a("127.0.0.1", 1024);
+    stack.return_values.push_back(NSAPI_ERROR_NO_CONNECTION);
+    EXPECT_EQ(async->async_connect(a, connect_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(connect_calls, 1);
+    EXPECT_EQ(connect_result, NSAPI_ERROR_NO_CONNECTION);
+}
+
+TEST_F(TestAsyncSocket, send_partial)
+{
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(async->async_send(buf, sizeof(buf), send_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(send_calls, 0);
+    EXPECT_EQ(async->async_send(buf, sizeof(buf), send_cb), NSAPI_ERROR_BUSY);
+
+    stack.return_values.push_back(6);
+    socket->event();
+    EXPECT_EQ(send_calls, 1);
+    EXPECT_EQ(send_result, sizeof(buf));
+}
+
+TEST_F(TestAsyncSocket, send_error)
+{
+    stack.return_values.push_back(NSAPI_ERROR_NO_CONNECTION);
+    EXPECT_EQ(async->async_send(buf, sizeof(buf), send_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(send_calls, 1);
+    EXPECT_EQ(send_result, NSAPI_ERROR_NO_CONNECTION);
+}
+
+TEST_F(TestAsyncSocket, recv)
+{
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(async->async_recv(buf, sizeof(buf), recv_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(recv_calls, 0);
+
+    stack.return_values.push_back(3);
+    socket->event();
+    EXPECT_EQ(recv_calls, 1);
+    EXPECT_EQ(recv_result, 3);
+
+    // Closed by the peer
+    stack.return_values.push_back(0);
+    EXPECT_EQ(async->async_recv(buf, sizeof(buf), recv_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(recv_calls, 2);
+    EXPECT_EQ(recv_result, 0);
+}
+
+TEST_F(TestAsyncSocket, cancel)
+{
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(async->async_recv(buf, sizeof(buf), recv_cb), NSAPI_ERROR_OK);
+    async->cancel();
+
+    stack.return_values.push_back(3);
+    socket->event();
+    EXPECT_EQ(recv_calls, 0);
+    EXPECT_EQ(async->async_recv(buf, sizeof(buf), recv_cb), NSAPI_ERROR_OK);
+    EXPECT_EQ(recv_calls, 1);
+}
+
+TEST_F(TestAsyncSocket, no_callback)
+{
+    EXPECT_EQ(async->async_recv(buf, sizeof(buf), nullptr), NSAPI_ERROR_PARAMETER);
+}
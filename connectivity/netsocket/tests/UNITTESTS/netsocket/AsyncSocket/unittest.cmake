@@ -0,0 +1,36 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT=10")
+
+set(unittest-sources
+  ../connectivity/netsocket/source/SocketAddress.cpp
+  ../connectivity/netsocket/source/NetworkStack.cpp
+  ../connectivity/netsocket/source/InternetSocket.cpp
+  ../connectivity/netsocket/source/TCPSocket.cpp
+  ../connectivity/netsocket/source/AsyncSocket.cpp
+  ../connectivity/libraries/nanostack-libservice/source/libip4string/ip4tos.c
+  ../connectivity/libraries/nanostack-libservice/source/libip6string/ip6tos.c
+  ../connectivity/libraries/nanostack-libservice/source/libip4string/stoip4.c
+  ../connectivity/libraries/nanostack-libservice/source/libip6string/stoip6.c
+  ../connectivity/libraries/nanostack-libservice/source/libBits/common_functions.c
+)
+
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/test_AsyncSocket.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+  stubs/equeue_stub.c
+  stubs/EventQueue_stub.cpp
+  stubs/mbed_error.c
+  stubs/mbed_shared_queues_stub.cpp
+  stubs/nsapi_dns_stub.cpp
+  stubs/EventFlags_stub.cpp
+  stubs/stoip4_stub.c
+  stubs/ip4tos_stub.c
+  stubs/SocketStats_Stub.cpp
+)
@@ -11,6 +11,8 @@ set(unittest-sources
   ../connectivity/netsocket/source/UDPSocket.cpp
   ../connectivity/netsocket/source/DTLSSocketWrapper.cpp
   ../connectivity/netsocket/source/TLSSocketWrapper.cpp
+  ../connectivity/netsocket/source/TLSSessionCache.cpp
+  ../connectivity/netsocket/source/TLSCAChain.cpp
   ../connectivity/libraries/nanostack-libservice/source/libip4string/ip4tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip6string/ip6tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip4string/stoip4.c
@@ -36,6 +38,9 @@ set(unittest-test-sources
   stubs/SocketStats_Stub.cpp
 )
 
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_DTLS_HANDSHAKE_TIMEOUT_MIN=1000 -DMBED_CONF_NSAPI_DTLS_HANDSHAKE_TIMEOUT_MAX=60000 -DMBED_CONF_NSAPI_DTLS_CID_LENGTH=0")
+
 set(MBEDTLS_USER_CONFIG_FILE_PATH "\"${CMAKE_CURRENT_LIST_DIR}/dtls_test_config.h\"")
 set_source_files_properties(${CMAKE_CURRENT_LIST_DIR}/test_DTLSSocketWrapper.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
 set_source_files_properties(../connectivity/netsocket/source/DTLSSocketWrapper.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../connectivity/netsocket/source/TLSCAChain.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
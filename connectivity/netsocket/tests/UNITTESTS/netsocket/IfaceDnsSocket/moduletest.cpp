@@ -113,6 +113,8 @@ protected:
     static const unsigned char packet_ip6[packet_ip6_size];
     static constexpr unsigned int packet_ip4_3addresses_size = 76;
     static const unsigned char packet_ip4_3addresses[packet_ip4_3addresses_size];
+    static constexpr unsigned int packet_nxdomain_size = 64;
+    static const unsigned char packet_nxdomain[packet_nxdomain_size];
 };
 
 std::list<std::future<void>> Test_IfaceDnsSocket::eventQueue;
@@ -215,6 +217,38 @@ const unsigned char Test_IfaceDnsSocket::packet_ip4_3addresses[Test_IfaceDnsSock
     0x01, 0x02, 0x03, 0x04       // Address bytes
 };
 
+// Name error response for google.com, with the SOA record of com in the authority section.
+const unsigned char Test_IfaceDnsSocket::packet_nxdomain[Test_IfaceDnsSocket::packet_nxdomain_size] = {
+    0x00, 0x01, // ID
+    0x81, 0x83, // Flags, rcode = 3 (name error)
+    0x00, 0x01, // qdcount
+    0x00, 0x00, // ancount
+    0x00, 0x01, // nscount
+    0x00, 0x00, // arcount
+
+    0x06,                               // question, qdcount = 1, first byte is len = 6
+    0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, // body of the question
+    0x03,                               // len = 3
+    0x63, 0x6f, 0x6d,                   // body of the question qtype and qclass of the question
+    0x00,                               // len = 0
+    0x00, 0x01,                         // qtype
+    0x00, 0x01,                         // qclass
+
+    0xc0,                        // authority len = 192 (means this is a link)
+    0x13,                        // link to com in the question
+    0x00, 0x06,                  // rtype: RR_SOA = 6
+    0x00, 0x01,                  // rclass
+    0x00, 0x00, 0x03, 0x84,      // ttl
+    0x00, 0x18,                  // rdlength
+    0xc0, 0x13,                  // mname
+    0xc0, 0x13,                  // rname
+    0x00, 0x00, 0x00, 0x01,      // serial
+    0x00, 0x00, 0x07, 0x08,      // refresh
+    0x00, 0x00, 0x03, 0x84,      // retry
+    0x00, 0x09, 0x3a, 0x80,      // expire
+    0x00, 0x00, 0x00, 0x3c       // minimum, negative caching time
+};
+
 // We cannot use SetArgArray, because this is void* type.
 // Use a manual for loop, to avoid depending on local implementation of strncpy (had some issues with it).
 ACTION_P2(SetArg2ToCharPtr, value, size)
@@ -331,6 +365,33 @@ TEST_F(Test_IfaceDnsSocket, multiple_queries)
     delete[] addr_cache;
 }
 
+TEST_F(Test_IfaceDnsSocket, single_query_nxdomain)
+{
+    SocketAddress addr;
+    // Make sure socket opens successfully
+    EXPECT_CALL(stackMock(), socket_open(_, NSAPI_UDP))
+    .Times(1)
+    .WillOnce(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
+
+    EXPECT_CALL(stackMock(), get_dns_server(_, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_UNSUPPORTED));
+
+    EXPECT_CALL(stackMock(), socket_sendto(_, _, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+
+    EXPECT_CALL(stackMock(), socket_recvfrom(_, _, _, _))
+    .Times(1)
+    .WillOnce(DoAll(SetArg2ToCharPtr(Test_IfaceDnsSocket::packet_nxdomain, Test_IfaceDnsSocket::packet_nxdomain_size), Return(Test_IfaceDnsSocket::packet_nxdomain_size)));
+
+    EXPECT_CALL(stackMock(), socket_close(_)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr));
+
+    // Do not set any return values. The name error is cached, for any IP version.
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr));
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr, NSAPI_IPv6));
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query_async(&stackMock(), "www.google.com", &Test_IfaceDnsSocket::hostbyname_cb, Test_IfaceDnsSocket::call_in, NSAPI_IPv4));
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, Test_IfaceDnsSocket::hostname_cb_result);
+}
+
 TEST_F(Test_IfaceDnsSocket, single_query_errors)
 {
     testing::InSequence s;
@@ -356,9 +417,10 @@ TEST_F(Test_IfaceDnsSocket, simultaneous_query_async)
     .Times(1)
     .WillOnce(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
 
-    EXPECT_CALL(stackMock(), get_dns_server(_, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_UNSUPPORTED));
+    // Both queries are sent at the same time, over the same socket.
+    EXPECT_CALL(stackMock(), get_dns_server(_, _, _)).Times(2).WillRepeatedly(Return(NSAPI_ERROR_UNSUPPORTED));
 
-    EXPECT_CALL(stackMock(), socket_sendto(_, _, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+    EXPECT_CALL(stackMock(), socket_sendto(_, _, _, _)).Times(2).WillRepeatedly(Return(NSAPI_ERROR_OK));
 
     {
         testing::InSequence s;
@@ -405,6 +467,9 @@ TEST_F(Test_IfaceDnsSocket, simultaneous_query_async)
     delete[] Test_IfaceDnsSocket::hostname_cb_address;
 
     EXPECT_EQ(NSAPI_ERROR_OK, nsapi_dns_query_async_cancel((intptr_t)Test_IfaceDnsSocket::query_id + 1));
+
+    // The timer deletes the cancelled query and closes the socket.
+    executeEventQueueCallbacks();
 }
 
 // Imitate the getaddrinfo to make the example more real-life.
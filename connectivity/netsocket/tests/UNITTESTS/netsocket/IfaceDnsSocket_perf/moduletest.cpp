@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "perf_test.h"
+#include "netsocket/nsapi_dns.h"
+#include "netsocket/EthernetInterface.h"
+#include "netsocket/SocketAddress.h"
+#include "EMAC_mock.h"
+#include "OnboardNetworkStack_mock.h"
+#include <stdio.h>
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::DoAll;
+
+OnboardNetworkStack &OnboardNetworkStack::get_default_instance()
+{
+    return OnboardNetworkStackMock::get_instance();
+}
+
+static OnboardNetworkStackMock &stackMock()
+{
+    return OnboardNetworkStackMock::get_instance();
+}
+
+// A google.com resolution, answering any question with the ID of the blocking queries
+static const unsigned char packet_ip4[] = {
+    0x00, 0x01, // ID
+    0x81, 0x80, // Flags
+    0x00, 0x01, // qdcount
+    0x00, 0x01, // ancount
+    0x00, 0x00, // nscount
+    0x00, 0x00, // arcount
+
+    0x06, 0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, // google
+    0x03, 0x63, 0x6f, 0x6d,                   // com
+    0x00,
+    0x00, 0x01,                  // qtype
+    0x00, 0x01,                  // qclass
+
+    0xc0, 0x0c,                  // name of the answer, link to the question
+    0x00, 0x01,                  // rtype: RR_A
+    0x00, 0x01,                  // rclass
+    0x00, 0x00, 0x00, 0x22,      // ttl
+    0x00, 0x04,                  // rdlength
+    0xd8, 0x3a, 0xcf, 0xee       // address
+};
+
+ACTION_P2(SetArg2ToCharPtr, value, size)
+{
+    for (int i = 0; i < size; i++) {
+        static_cast<char *>(arg2)[i] = reinterpret_cast<const char *>(value)[i];
+    }
+}
+
+class Test_IfaceDnsSocketPerf : public testing::Test {
+protected:
+    EthernetInterface *iface;
+    int queries;
+
+    virtual void SetUp()
+    {
+        iface = new EthernetInterface(MockEMAC::get_instance(), OnboardNetworkStackMock::get_instance());
+        nsapi_dns_reset();
+        queries = 0;
+
+        // Every query sent is answered
+        EXPECT_CALL(stackMock(), socket_open(_, NSAPI_UDP))
+        .WillRepeatedly(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
+        EXPECT_CALL(stackMock(), get_dns_server(_, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(SocketAddress("1.2.3.4", 53)), Return(NSAPI_ERROR_OK)));
+        EXPECT_CALL(stackMock(), socket_sendto(_, _, _, _))
+        .WillRepeatedly(::testing::InvokeWithoutArgs([this]() {
+            queries++;
+            return NSAPI_ERROR_OK;
+        }));
+        EXPECT_CALL(stackMock(), socket_recvfrom(_, _, _, _))
+        .WillRepeatedly(DoAll(SetArg2ToCharPtr(packet_ip4, sizeof(packet_ip4)), Return(sizeof(packet_ip4))));
+        EXPECT_CALL(stackMock(), socket_close(_)).WillRepeatedly(Return(NSAPI_ERROR_OK));
+    }
+
+    virtual void TearDown()
+    {
+        ::testing::Mock::VerifyAndClearExpectations(&stackMock());
+        delete iface;
+    }
+
+    static void host_name(char *host, size_t i)
+    {
+        sprintf(host, "host%zu.example.com", i);
+    }
+};
+
+TEST_F(Test_IfaceDnsSocketPerf, cache_hit)
+{
+    SocketAddress addr;
+    EXPECT_EQ(NSAPI_ERROR_OK, nsapi_dns_query(iface, "www.google.com", &addr));
+    EXPECT_EQ(1, queries);
+
+    auto workload = [this, &addr](size_t lookups) {
+        for (size_t i = 0; i < lookups; i++) {
+            EXPECT_EQ(NSAPI_ERROR_OK, nsapi_dns_query(iface, "www.google.com", &addr));
+        }
+    };
+    EXPECT_TRUE(perf::scales_linearly("cache_hit", 1 << 10, 1 << 14, workload));
+
+    // Served from the cache only
+    EXPECT_EQ(1, queries);
+    EXPECT_FALSE(strncmp(addr.get_ip_address(), "216.58.207.238", sizeof("216.58.207.238")));
+}
+
+TEST_F(Test_IfaceDnsSocketPerf, cache_replacement)
+{
+    // More names than the cache holds, each resolved once then looked up
+    // again, so the entries keep being replaced
+    auto workload = [this](size_t names) {
+        char host[32];
+        SocketAddress addr;
+        for (size_t i = 0; i < names; i++) {
+            host_name(host, i);
+            EXPECT_EQ(NSAPI_ERROR_OK, nsapi_dns_query(iface, host, &addr));
+            EXPECT_EQ(NSAPI_ERROR_OK, nsapi_dns_query(iface, host, &addr));
+        }
+        nsapi_dns_reset();
+    };
+    EXPECT_TRUE(perf::scales_linearly("cache_replacement", 1 << 6, 1 << 10, workload));
+}
+
+TEST_F(Test_IfaceDnsSocketPerf, literal_address)
+{
+    auto workload = [this](size_t lookups) {
+        SocketAddress addr;
+        for (size_t i = 0; i < lookups; i++) {
+            EXPECT_EQ(NSAPI_ERROR_OK, iface->gethostbyname("192.168.0.1", &addr));
+        }
+    };
+    EXPECT_TRUE(perf::scales_linearly("literal_address", 1 << 10, 1 << 14, workload));
+    EXPECT_EQ(0, queries);
+}
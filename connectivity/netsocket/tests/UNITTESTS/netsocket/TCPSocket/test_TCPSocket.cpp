@@ -199,6 +199,53 @@ TEST_F(TestTCPSocket, send_to)
     EXPECT_EQ(socket->sendto(a, dataBuf, dataSize), dataSize);
 }
 
+TEST_F(TestTCPSocket, sendmsg_no_open)
+{
+    nsapi_iovec_t iov[2] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    EXPECT_EQ(socket->sendmsg(iov, 2), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, sendmsg_all_buffers)
+{
+    socket->open(&stack);
+    nsapi_iovec_t iov[2] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(dataSize - 4);
+    EXPECT_EQ(socket->sendmsg(iov, 2), dataSize);
+}
+
+TEST_F(TestTCPSocket, sendmsg_resume_in_buffer)
+{
+    socket->open(&stack);
+    nsapi_iovec_t iov[2] = {{dataBuf, 6}, {dataBuf + 6, dataSize - 6}};
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(2);
+    stack.return_values.push_back(dataSize - 6);
+    EXPECT_EQ(socket->sendmsg(iov, 2), dataSize);
+    EXPECT_TRUE(stack.return_values.empty());
+}
+
+TEST_F(TestTCPSocket, sendmsg_error_would_block)
+{
+    socket->open(&stack);
+    nsapi_iovec_t iov[2] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->sendmsg(iov, 2), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestTCPSocket, send_buf_no_open)
+{
+    EXPECT_EQ(socket->send_buf(NULL), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, send_buf_unsupported)
+{
+    socket->open(&stack);
+    EXPECT_TRUE(socket->get_memory_manager() == NULL);
+    EXPECT_EQ(socket->send_buf(NULL), NSAPI_ERROR_UNSUPPORTED);
+}
+
 /* recv */
 
 TEST_F(TestTCPSocket, recv_no_open)
@@ -231,6 +278,35 @@ TEST_F(TestTCPSocket, recv_would_block)
     EXPECT_EQ(socket->recv(dataBuf, dataSize), NSAPI_ERROR_WOULD_BLOCK);
 }
 
+TEST_F(TestTCPSocket, recvmsg_no_open)
+{
+    nsapi_iovec_t iov[2] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    EXPECT_EQ(socket->recvmsg(iov, 2), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, recvmsg_less_than_expected)
+{
+    socket->open(&stack);
+    nsapi_iovec_t iov[2] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(2);
+    EXPECT_EQ(socket->recvmsg(iov, 2), 6);
+}
+
+TEST_F(TestTCPSocket, recv_buf_no_open)
+{
+    net_stack_mem_buf_t *buf = NULL;
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, recv_buf_unsupported)
+{
+    socket->open(&stack);
+    net_stack_mem_buf_t *buf = NULL;
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_UNSUPPORTED);
+    EXPECT_TRUE(buf == NULL);
+}
+
 TEST_F(TestTCPSocket, recv_from_no_socket)
 {
     stack.return_value = NSAPI_ERROR_OK;
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "netsocket/TLSSessionCache.h"
+#include "kvstore/KVStore.h"
+#include <map>
+#include <string>
+#include <string.h>
+
+// KVStore holding its values in a map, without the incremental set and iterators
+class KVStoreFake : public mbed::KVStore {
+public:
+    int init() override
+    {
+        return 0;
+    }
+    int deinit() override
+    {
+        return 0;
+    }
+    int reset() override
+    {
+        values.clear();
+        return 0;
+    }
+    int set(const char *key, const void *buffer, size_t size, uint32_t create_flags) override
+    {
+        values[key] = std::string((const char *)buffer, size);
+        return 0;
+    }
+    int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL, size_t offset = 0) override
+    {
+        auto it = values.find(key);
+        if (it == values.end()) {
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        }
+        size_t size = it->second.size() < buffer_size ? it->second.size() : buffer_size;
+        memcpy(buffer, it->second.data(), size);
+        if (actual_size) {
+            *actual_size = size;
+        }
+        return 0;
+    }
+    int get_info(const char *key, info_t *info = NULL) override
+    {
+        auto it = values.find(key);
+        if (it == values.end()) {
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        }
+        if (info) {
+            info->size = it->second.size();
+            info->flags = 0;
+        }
+        return 0;
+    }
+    int remove(const char *key) override
+    {
+        return values.erase(key) ? 0 : MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    int set_add_data(set_handle_t handle, const void *value_data, size_t data_size) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    int set_finalize(set_handle_t handle) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    int iterator_open(iterator_t *it, const char *prefix = NULL) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    int iterator_next(iterator_t it, char *key, size_t key_size) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    int iterator_close(iterator_t it) override
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    std::map<std::string, std::string> values;
+};
+
+class TestTLSSessionCache : public testing::Test {
+protected:
+    TLSSessionCache *cache;
+    char buf[16];
+
+    virtual void SetUp()
+    {
+        cache = new TLSSessionCache(2);
+        memset(buf, 0, sizeof(buf));
+    }
+
+    virtual void TearDown()
+    {
+        delete cache;
+    }
+};
+
+TEST_F(TestTLSSessionCache, constructor)
+{
+    EXPECT_TRUE(cache);
+}
+
+TEST_F(TestTLSSessionCache, store_load)
+{
+    EXPECT_EQ(cache->store("a.example.com", "session", 7), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->load("a.example.com", NULL, 0), 7);
+    EXPECT_EQ(cache->load("a.example.com", buf, sizeof(buf)), 7);
+    EXPECT_EQ(std::string(buf, 7), "session");
+    EXPECT_EQ(cache->load("b.example.com", buf, sizeof(buf)), 0);
+}
+
+TEST_F(TestTLSSessionCache, store_invalid)
+{
+    EXPECT_EQ(cache->store(NULL, "session", 7), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(cache->store("", "session", 7), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(cache->store("a.example.com", "session", 0), NSAPI_ERROR_PARAMETER);
+}
+
+TEST_F(TestTLSSessionCache, load_buffer_too_small)
+{
+    EXPECT_EQ(cache->store("a.example.com", "session", 7), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->load("a.example.com", buf, 3), 7);
+    EXPECT_EQ(buf[0], 0);
+}
+
+TEST_F(TestTLSSessionCache, store_replaces)
+{
+    EXPECT_EQ(cache->store("a.example.com", "first", 5), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->store("a.example.com", "second", 6), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->load("a.example.com", buf, sizeof(buf)), 6);
+    EXPECT_EQ(std::string(buf, 6), "second");
+    // replacing doesn't take the slot of another host
+    EXPECT_EQ(cache->store("b.example.com", "other", 5), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->load("a.example.com", NULL, 0), 6);
+}
+
+TEST_F(TestTLSSessionCache, evicts_least_recently_used)
+{
+    EXPECT_EQ(cache->store("a.example.com", "a", 1), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->store("b.example.com", "b", 1), NSAPI_ERROR_OK);
+    // a is used after b
+    EXPECT_EQ(cache->load("a.example.com", NULL, 0), 1);
+    EXPECT_EQ(cache->store("c.example.com", "c", 1), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->load("a.example.com", NULL, 0), 1);
+    EXPECT_EQ(cache->load("b.example.com", NULL, 0), 0);
+    EXPECT_EQ(cache->load("c.example.com", NULL, 0), 1);
+}
+
+TEST_F(TestTLSSessionCache, remove_clear)
+{
+    EXPECT_EQ(cache->store("a.example.com", "a", 1), NSAPI_ERROR_OK);
+    EXPECT_EQ(cache->store("b.example.com", "b", 1), NSAPI_ERROR_OK);
+    cache->remove("a.example.com");
+    EXPECT_EQ(cache->load("a.example.com", NULL, 0), 0);
+    EXPECT_EQ(cache->load("b.example.com", NULL, 0), 1);
+    cache->clear();
+    EXPECT_EQ(cache->load("b.example.com", NULL, 0), 0);
+}
+
+TEST_F(TestTLSSessionCache, kvstore_persists)
+{
+    KVStoreFake kv;
+    TLSSessionCache *persistent = new TLSSessionCache(1, &kv);
+    EXPECT_EQ(persistent->store("a.example.com", "session", 7), NSAPI_ERROR_OK);
+    EXPECT_EQ(kv.values.size(), 1);
+    delete persistent;
+
+    // a new cache finds the session in the KVStore
+    persistent = new TLSSessionCache(1, &kv);
+    EXPECT_EQ(persistent->load("a.example.com", buf, sizeof(buf)), 7);
+    EXPECT_EQ(std::string(buf, 7), "session");
+    EXPECT_EQ(persistent->load("b.example.com", NULL, 0), 0);
+
+    persistent->remove("a.example.com");
+    EXPECT_EQ(kv.values.size(), 0);
+    delete persistent;
+}
+
+TEST_F(TestTLSSessionCache, kvstore_host_mismatch)
+{
+    KVStoreFake kv;
+    TLSSessionCache persistent(1, &kv);
+    EXPECT_EQ(persistent.store("a.example.com", "session", 7), NSAPI_ERROR_OK);
+    persistent.clear();
+
+    // a value whose host name doesn't match isn't given out
+    std::string value = "b.example.com";
+    value.push_back('\0');
+    value += "session";
+    kv.values.begin()->second = value;
+    EXPECT_EQ(persistent.load("a.example.com", NULL, 0), 0);
+}
+
+TEST_F(TestTLSSessionCache, default_instance)
+{
+    TLSSessionCache *def = TLSSessionCache::get_default_instance();
+    EXPECT_TRUE(def);
+    EXPECT_EQ(def, TLSSessionCache::get_default_instance());
+}
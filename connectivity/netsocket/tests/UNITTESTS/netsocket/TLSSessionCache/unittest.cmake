@@ -0,0 +1,19 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Unit test suite name
+set(TEST_SUITE_NAME "features_netsocket_TLSSessionCache")
+
+# Source files
+set(unittest-sources
+  ../connectivity/netsocket/source/TLSSessionCache.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/test_TLSSessionCache.cpp
+)
+
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE=2")
@@ -10,6 +10,8 @@ set(unittest-sources
   ../connectivity/netsocket/source/TCPSocket.cpp
   ../connectivity/netsocket/source/TLSSocket.cpp
   ../connectivity/netsocket/source/TLSSocketWrapper.cpp
+  ../connectivity/netsocket/source/TLSSessionCache.cpp
+  ../connectivity/netsocket/source/TLSCAChain.cpp
   ../connectivity/libraries/nanostack-libservice/source/libip4string/ip4tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip6string/ip6tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip4string/stoip4.c
@@ -39,3 +41,4 @@ set(MBEDTLS_USER_CONFIG_FILE_PATH "\"${CMAKE_CURRENT_LIST_DIR}/tls_test_config.h
 set_source_files_properties(${CMAKE_CURRENT_LIST_DIR}/test_TLSSocket.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
 set_source_files_properties(../connectivity/netsocket/source/TLSSocket.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
 set_source_files_properties(../connectivity/netsocket/source/TLSSocketWrapper.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
+set_source_files_properties(../connectivity/netsocket/source/TLSCAChain.cpp PROPERTIES COMPILE_DEFINITIONS MBEDTLS_USER_CONFIG_FILE=${MBEDTLS_USER_CONFIG_FILE_PATH})
@@ -129,6 +129,22 @@ TEST_F(TestTLSSocketWrapper, connect)
     EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_IS_CONNECTED);
 }
 
+TEST_F(TestTLSSocketWrapper, connect_with_session_cache)
+{
+    TLSSessionCache cache(1);
+    EXPECT_EQ(cache.store("localhost", "session", 7), NSAPI_ERROR_OK);
+    wrapper->set_session_cache(&cache);
+    // the stub doesn't copy the hostname
+    wrapper->get_ssl_context()->hostname = (char *)"localhost";
+
+    transport->open(&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    // the session is kept, as it was loaded
+    EXPECT_EQ(cache.load("localhost", NULL, 0), 7);
+    wrapper->get_ssl_context()->hostname = NULL;
+}
+
 /* connect: TCP-related errors */
 
 TEST_F(TestTLSSocketWrapper, connect_no_open)
@@ -256,6 +272,29 @@ TEST_F(TestTLSSocketWrapper, send_in_two_chunks)
     EXPECT_EQ(wrapper->send(dataBuf, dataSize), dataSize);
 }
 
+TEST_F(TestTLSSocketWrapper, send_in_two_records)
+{
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = 4; // mbedtls_ssl_write, first record
+    mbedtls_stub.retArray[4] = dataSize - 4; // mbedtls_ssl_write, second record
+    transport->open(&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), dataSize);
+}
+
+TEST_F(TestTLSSocketWrapper, send_partial_non_blocking)
+{
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = 4; // mbedtls_ssl_write, first record
+    mbedtls_stub.retArray[4] = MBEDTLS_ERR_SSL_WANT_WRITE;
+    transport->open(&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    wrapper->set_blocking(false);
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), 4);
+}
+
 TEST_F(TestTLSSocketWrapper, send_error_would_block)
 {
     transport->open(&stack);
@@ -399,6 +438,35 @@ TEST_F(TestTLSSocketWrapper, set_root_ca_cert_invalid)
     EXPECT_EQ(wrapper->set_root_ca_cert(cert, strlen(cert)), NSAPI_ERROR_PARAMETER);
 }
 
+TEST_F(TestTLSSocketWrapper, set_shared_ca_chain)
+{
+    mbed::IntrusivePtr<TLSCAChain> ca(new TLSCAChain());
+    EXPECT_EQ(ca->get_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+    EXPECT_EQ(ca->add(cert), NSAPI_ERROR_OK);
+    EXPECT_NE(ca->get_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+
+    EXPECT_EQ(transport->open(&stack), NSAPI_ERROR_OK);
+    wrapper->set_ca_chain(ca);
+    EXPECT_EQ(wrapper->get_ca_chain(), ca->get_chain());
+    EXPECT_EQ(ca.use_count(), 2u);
+
+    // a chain parsed by the socket releases the shared one
+    EXPECT_EQ(wrapper->set_root_ca_cert(cert), NSAPI_ERROR_OK);
+    EXPECT_NE(wrapper->get_ca_chain(), ca->get_chain());
+    EXPECT_EQ(ca.use_count(), 1u);
+}
+
+TEST_F(TestTLSSocketWrapper, shared_ca_chain_invalid)
+{
+    TLSCAChain ca;
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[0] = 1; // mbedtls_x509_crt_parse error
+    mbedtls_stub.retArray[1] = 1; // mbedtls_x509_crt_parse_der_nocopy error
+    EXPECT_EQ(ca.add(cert), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(ca.add_der_nocopy(cert, strlen(cert)), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(ca.get_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+}
+
 TEST_F(TestTLSSocketWrapper, set_client_cert_key)
 {
     EXPECT_EQ(wrapper->get_own_cert(), static_cast<mbedtls_x509_crt *>(NULL));
@@ -145,6 +145,83 @@ TEST_F(TestUDPSocket, recv_address_filtering)
     EXPECT_EQ(socket->recvfrom(&a1, &dataBuf, dataSize), 100);
 }
 
+TEST_F(TestUDPSocket, sendmmsg)
+{
+    const SocketAddress a("127.0.0.1", 1024);
+    nsapi_datagram_t msgs[3];
+    for (int i = 0; i < 3; i++) {
+        msgs[i].address = a;
+        msgs[i].data = dataBuf;
+        msgs[i].size = dataSize;
+        msgs[i].length = 0;
+    }
+
+    EXPECT_EQ(socket->sendmmsg(msgs, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+
+    stack.return_value = NSAPI_ERROR_NO_MEMORY;
+    EXPECT_EQ(socket->sendmmsg(msgs, 3), NSAPI_ERROR_NO_MEMORY);
+
+    stack.return_value = dataSize;
+    EXPECT_EQ(socket->sendmmsg(msgs, 3), 3);
+    EXPECT_EQ(msgs[2].length, dataSize);
+}
+
+TEST_F(TestUDPSocket, recvmmsg)
+{
+    nsapi_datagram_t msgs[4];
+    for (int i = 0; i < 4; i++) {
+        msgs[i].data = dataBuf;
+        msgs[i].size = dataSize;
+        msgs[i].length = 0;
+    }
+
+    EXPECT_EQ(socket->recvmmsg(msgs, 4), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+
+    stack.return_values.push_back(10);
+    stack.return_values.push_back(5);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvmmsg(msgs, 4), 2);
+    EXPECT_EQ(msgs[0].length, 10);
+    EXPECT_EQ(msgs[1].length, 5);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recvmmsg(msgs, 4), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvmmsg_address_filtering)
+{
+    socket->open(&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    SocketAddress a1(addr1, 1024);
+    SocketAddress a2(addr2, 1024);
+    nsapi_datagram_t msgs[2];
+    for (int i = 0; i < 2; i++) {
+        msgs[i].data = dataBuf;
+        msgs[i].size = dataSize;
+    }
+
+    EXPECT_EQ(socket->connect(a1), NSAPI_ERROR_OK);
+
+    stack.return_socketAddress = a2;
+    stack.return_values.push_back(10); //This will not return, because wrong address is used.
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    stack.return_value = NSAPI_ERROR_NO_MEMORY; //Break the loop of waiting for data from a1.
+    EXPECT_EQ(socket->recvmmsg(msgs, 2), NSAPI_ERROR_NO_MEMORY);
+
+    stack.return_socketAddress = a1;
+    stack.return_values.push_back(10);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvmmsg(msgs, 2), 1);
+    EXPECT_EQ(msgs[0].address, a1);
+}
+
 TEST_F(TestUDPSocket, unsupported_api)
 {
     nsapi_error_t error;
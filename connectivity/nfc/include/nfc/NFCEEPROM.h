@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include "events/EventQueue.h"
+#include "platform/Span.h"
 
 #include "NFCDefinitions.h"
 #include "NFCTarget.h"
@@ -78,6 +79,17 @@ public:
          */
         virtual void on_ndef_message_read(nfc_err_t result) {}
 
+        /**
+         * Bytes of the NDEF message have been read.
+         *
+         * The buffer holds all the bytes read since the beginning of the
+         * message; it can be given to ndef::MessageParser::parse_available()
+         * to parse the records before the end of the read, without copy.
+         *
+         * @param[in] buffer The bytes read so far, valid until the next read
+         */
+        virtual void on_ndef_message_data_read(const Span<const uint8_t> &buffer) {}
+
     protected:
         ~Delegate() {}
     };
@@ -117,6 +129,8 @@ private:
     void continue_write();
     void continue_read();
     void continue_erase();
+    void continue_transfer(void (NFCEEPROM::*step)());
+    size_t transfer_size(size_t remaining);
 
     // NFCNDEFCapable implementation
     virtual NFCNDEFCapable::Delegate *ndef_capable_delegate();
@@ -145,6 +159,7 @@ private:
     NFCEEPROMDriver *_driver;
     events::EventQueue *_event_queue;
     bool _initialized;
+    bool _driver_call;
 
     nfc_eeprom_operation_t _current_op;
     ac_buffer_t _ndef_buffer_reader;
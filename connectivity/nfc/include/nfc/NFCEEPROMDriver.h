@@ -184,6 +184,17 @@ public:
      */
     virtual void erase_bytes(uint32_t address, size_t size) = 0;
 
+    /**
+     * Get the largest number of bytes read or written in a single transfer.
+     * Reads and writes are then requested in blocks of up to that size, aligned on its
+     * multiples, so that a driver can move each of them as one bus transaction
+     * (for instance one page with an asynchronous I2C transfer) and complete the request
+     * in full.
+     * @return the page size of the EEPROM, or 0 (default) to request all the remaining bytes
+     * at once and let the driver report how many it transferred.
+     */
+    virtual size_t read_max_transfer_size();
+
 protected:
     Delegate *delegate();
     events::EventQueue *event_queue();
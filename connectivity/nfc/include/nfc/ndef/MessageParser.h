@@ -33,6 +33,10 @@ class Record;
 
 /**
  * Event driven NDEF Message parser
+ *
+ * Records are reported as views into the buffer parsed, no data is copied.
+ * A message can be parsed at once with parse() or as it is received with
+ * begin_parsing(), parse_available() and end_parsing().
  */
 class MessageParser {
 public:
@@ -143,10 +147,43 @@ public:
      */
     void parse(const Span<const uint8_t> &data_buffer);
 
+    /**
+     * Start the parsing of an NDEF Message received progressively.
+     *
+     * The data of the message is then given to parse_available() as it is
+     * received and the parsing completed with end_parsing().
+     */
+    void begin_parsing();
+
+    /**
+     * Parse the data of the NDEF Message received so far.
+     *
+     * The records completely present in the buffer are reported to the
+     * handler; a record partially received is reported by a later call, once
+     * the buffer holds all of it. The records reported are views into the
+     * buffer, which must remain valid while the handler uses them.
+     *
+     * @param data_buffer The data received from the beginning of the message.
+     * Each call extends the data of the previous one: the tag data is received
+     * in a single buffer.
+     *
+     * @return true if more data is expected: the last record of the message
+     * has not been parsed and no error has been found.
+     */
+    bool parse_available(const Span<const uint8_t> &data_buffer);
+
+    /**
+     * Complete the parsing started by begin_parsing().
+     *
+     * An incomplete record or a missing message end is reported as an error.
+     */
+    void end_parsing();
+
 private:
     struct parsing_state_t;
 
     // parser
+    void parse_records(bool complete);
     bool parse_record(parsing_state_t &it);
 
     static uint8_t compute_lengths_size(uint8_t header);
@@ -158,9 +195,15 @@ private:
     void report_parsing_started();
     void report_record_parsed(const Record &record);
     void report_parsing_terminated();
-    void report_parsing_error(error_t error, parsing_state_t &parsing_state);
+    void report_parsing_error(error_t error);
+    void report_insufficient_data(parsing_state_t &parsing_state);
 
     Delegate *_delegate;
+    Span<const uint8_t> _buffer;
+    size_t _position;
+    bool _first_record_parsed: 1;
+    bool _last_record_parsed: 1;
+    bool _error: 1;
 };
 /** @}*/
 } // namespace ndef
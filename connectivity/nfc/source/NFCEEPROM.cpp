@@ -22,7 +22,7 @@ using namespace mbed::nfc;
 
 NFCEEPROM::NFCEEPROM(NFCEEPROMDriver *driver, events::EventQueue *queue, const Span<uint8_t> &ndef_buffer)
     :
-    NFCTarget(ndef_buffer), _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false),
+    NFCTarget(ndef_buffer), _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false), _driver_call(false),
     _current_op(nfc_eeprom_idle), _ndef_buffer_reader { nullptr, 0, nullptr }, _ndef_buffer_read_sz(0),
     _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN)
 {
@@ -229,8 +229,13 @@ void NFCEEPROM::on_bytes_read(size_t count)
             ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
             ac_buffer_builder_write_n_skip(buffer_builder, count);
 
+            if (_delegate != NULL) {
+                ac_buffer_t *buffer = ac_buffer_builder_buffer(buffer_builder);
+                _delegate->on_ndef_message_data_read(make_const_Span(ac_buffer_data(buffer), ac_buffer_size(buffer)));
+            }
+
             // Continue reading
-            _event_queue->call(this, &NFCEEPROM::continue_read);
+            continue_transfer(&NFCEEPROM::continue_read);
             break;
         }
         default:
@@ -254,7 +259,7 @@ void NFCEEPROM::on_bytes_written(size_t count)
             ac_buffer_read_n_skip(&_ndef_buffer_reader, count);
 
             // Continue writing
-            _event_queue->call(this, &NFCEEPROM::continue_write);
+            continue_transfer(&NFCEEPROM::continue_write);
             break;
         default:
             // Should not happen, state machine is broken or driver is doing something wrong
@@ -355,7 +360,7 @@ void NFCEEPROM::on_bytes_erased(size_t count)
             _eeprom_address += count;
 
             // Continue erasing
-            _event_queue->call(this, &NFCEEPROM::continue_erase);
+            continue_transfer(&NFCEEPROM::continue_erase);
             break;
         default:
             // Should not happen, state machine is broken or driver is doing something wrong
@@ -368,7 +373,9 @@ void NFCEEPROM::continue_write()
 {
     if (ac_buffer_reader_readable(&_ndef_buffer_reader) > 0) {
         // Continue writing
-        _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader));
+        _driver_call = true;
+        _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), transfer_size(ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader)));
+        _driver_call = false;
     } else {
         // we are done
         _current_op = nfc_eeprom_write_end_session;
@@ -381,7 +388,9 @@ void NFCEEPROM::continue_erase()
 {
     if (_eeprom_address < _driver->read_max_size()) {
         // Continue erasing
+        _driver_call = true;
         _driver->erase_bytes(_eeprom_address, _driver->read_max_size() - _eeprom_address);
+        _driver_call = false;
     } else {
         // Now update size
         _current_op = nfc_eeprom_erase_write_0_size;
@@ -394,7 +403,9 @@ void NFCEEPROM::continue_read()
     if (_eeprom_address < _ndef_buffer_read_sz) {
         // Continue reading
         ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
-        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), _ndef_buffer_read_sz - _eeprom_address);
+        _driver_call = true;
+        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), transfer_size(_ndef_buffer_read_sz - _eeprom_address));
+        _driver_call = false;
     } else {
         // Done, close session
         _current_op = nfc_eeprom_read_end_session;
@@ -403,6 +414,29 @@ void NFCEEPROM::continue_read()
     }
 }
 
+void NFCEEPROM::continue_transfer(void (NFCEEPROM::*step)())
+{
+    if (_driver_call) {
+        // The driver completed synchronously, unwind its call before the next transfer
+        _event_queue->call(this, step);
+    } else {
+        // The driver completed from the event queue, no need to go through it again
+        (this->*step)();
+    }
+}
+
+size_t NFCEEPROM::transfer_size(size_t remaining)
+{
+    size_t block_size = _driver->read_max_transfer_size();
+    if (block_size == 0) {
+        return remaining;
+    }
+
+    // Stop at the end of the current block so that the following transfers are aligned
+    size_t block_remaining = block_size - (_eeprom_address % block_size);
+    return (remaining < block_remaining) ? remaining : block_remaining;
+}
+
 void NFCEEPROM::handle_error(nfc_err_t ret)
 {
     // Save & reset current op
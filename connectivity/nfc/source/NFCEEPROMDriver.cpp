@@ -29,6 +29,11 @@ NFCEEPROMDriver::~NFCEEPROMDriver()
 
 }
 
+size_t NFCEEPROMDriver::read_max_transfer_size()
+{
+    return 0;
+}
+
 void NFCEEPROMDriver::set_delegate(Delegate *delegate)
 {
     _delegate = delegate;
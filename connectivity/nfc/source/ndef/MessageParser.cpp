@@ -21,9 +21,9 @@
 
 namespace {
 struct buffer_iterator_t {
-    buffer_iterator_t(const mbed::Span<const uint8_t> &buffer) :
+    buffer_iterator_t(const mbed::Span<const uint8_t> &buffer, size_t position = 0) :
         buffer(buffer),
-        position(0)
+        position(position)
     { }
 
     uint8_t operator*()
@@ -82,6 +82,11 @@ struct buffer_iterator_t {
         return buffer.last(buffer.size() - position);
     }
 
+    size_t get_position() const
+    {
+        return position;
+    }
+
 private:
     mbed::Span<const uint8_t> buffer;
     mbed::Span<const uint8_t>::index_type position;
@@ -94,21 +99,22 @@ namespace nfc {
 namespace ndef {
 
 struct MessageParser::parsing_state_t {
-    parsing_state_t(const Span<const uint8_t> &data_buffer) :
-        it(data_buffer),
-        first_record_parsed(false),
-        last_record_parsed(false),
-        error(false)
+    parsing_state_t(const Span<const uint8_t> &data_buffer, size_t position, bool complete) :
+        it(data_buffer, position),
+        complete(complete)
     { }
 
     buffer_iterator_t it;
-    bool first_record_parsed: 1;
-    bool last_record_parsed: 1;
-    bool error: 1;
+    // false while more data can follow the buffer
+    bool complete;
 };
 
 MessageParser::MessageParser() :
-    _delegate(NULL)
+    _delegate(NULL),
+    _position(0),
+    _first_record_parsed(false),
+    _last_record_parsed(false),
+    _error(false)
 { }
 
 void MessageParser::set_delegate(Delegate *delegate)
@@ -118,24 +124,57 @@ void MessageParser::set_delegate(Delegate *delegate)
 
 void MessageParser::parse(const Span<const uint8_t> &data_buffer)
 {
-    parsing_state_t parsing_state(data_buffer);
+    begin_parsing();
+    _buffer = data_buffer;
+    end_parsing();
+}
+
+void MessageParser::begin_parsing()
+{
+    _buffer = Span<const uint8_t>();
+    _position = 0;
+    _first_record_parsed = false;
+    _last_record_parsed = false;
+    _error = false;
     report_parsing_started();
-    while (parsing_state.it && parse_record(parsing_state));
-    if (!parsing_state.error && !parsing_state.last_record_parsed) {
-        report_parsing_error(MISSING_MESSAGE_END, parsing_state);
+}
+
+bool MessageParser::parse_available(const Span<const uint8_t> &data_buffer)
+{
+    _buffer = data_buffer;
+    parse_records(/* complete */ false);
+    return !_error && !_last_record_parsed;
+}
+
+void MessageParser::end_parsing()
+{
+    // the record left incomplete, if any, is now an error
+    parse_records(/* complete */ true);
+    if (!_error && !_last_record_parsed) {
+        report_parsing_error(MISSING_MESSAGE_END);
     }
+    _buffer = Span<const uint8_t>();
     report_parsing_terminated();
 }
 
+void MessageParser::parse_records(bool complete)
+{
+    parsing_state_t s(_buffer, _position, complete);
+    // records are only consumed once complete
+    while (s.it && parse_record(s)) {
+        _position = s.it.get_position();
+    }
+}
+
 bool MessageParser::parse_record(parsing_state_t &s)
 {
-    if (s.error || s.last_record_parsed) {
+    if (_error || _last_record_parsed) {
         return false;
     }
 
     // ensure that the header can be extracted
     if (s.it.remaining_size() < 1) {
-        report_parsing_error(INSUFICIENT_DATA, s);
+        report_insufficient_data(s);
         return false;
     }
 
@@ -143,33 +182,21 @@ bool MessageParser::parse_record(parsing_state_t &s)
 
     // NOTE: report an error until the chunk parsing design is sorted out
     if (header & Header::chunk_flag_bit) {
-        report_parsing_error(CHUNK_RECORD_NOT_SUPPORTED, s);
+        report_parsing_error(CHUNK_RECORD_NOT_SUPPORTED);
         return false;
     }
 
     // handle first record cases
-    if (s.first_record_parsed == false) {
-        if (header & Header::message_begin_bit) {
-            s.first_record_parsed = true;
-        } else {
-            report_parsing_error(INVALID_MESSAGE_START, s);
-            return false;
-        }
-    } else if (header & Header::message_begin_bit) {
-        report_parsing_error(INVALID_MESSAGE_START, s);
+    if ((_first_record_parsed == false) != ((header & Header::message_begin_bit) != 0)) {
+        report_parsing_error(INVALID_MESSAGE_START);
         return false;
     }
 
-    // handle last record
-    if (header & Header::message_end_bit) {
-        s.last_record_parsed = true;
-    }
-
     // ensure their is enough space to contain the type length, payload
     // length and id length
     uint8_t lengths_size = compute_lengths_size(header);
     if (s.it.remaining_size() < lengths_size) {
-        report_parsing_error(INSUFICIENT_DATA, s);
+        report_insufficient_data(s);
         return false;
     }
 
@@ -180,15 +207,22 @@ bool MessageParser::parse_record(parsing_state_t &s)
 
     // there should be enough bytes left in the buffer
     if (s.it.remaining_size() < (type_length + id_length + payload_length)) {
-        report_parsing_error(INSUFICIENT_DATA, s);
+        report_insufficient_data(s);
         return false;
     }
 
+    _first_record_parsed = true;
+
+    // handle last record
+    if (header & Header::message_end_bit) {
+        _last_record_parsed = true;
+    }
+
     // validate the Type Name Format of the header
     switch (header & Header::tnf_bits) {
         case RecordType::empty:
             if (type_length || payload_length || id_length) {
-                report_parsing_error(INVALID_EMPTY_RECORD, s);
+                report_parsing_error(INVALID_EMPTY_RECORD);
                 return false;
             }
             break;
@@ -197,22 +231,22 @@ bool MessageParser::parse_record(parsing_state_t &s)
         case RecordType::absolute_uri:
         case RecordType::external_type:
             if (!type_length) {
-                report_parsing_error(MISSING_TYPE_VALUE, s);
+                report_parsing_error(MISSING_TYPE_VALUE);
                 return false;
             }
             break;
         case RecordType::unknown:
             if (type_length) {
-                report_parsing_error(INVALID_UNKNOWN_TYPE_LENGTH, s);
+                report_parsing_error(INVALID_UNKNOWN_TYPE_LENGTH);
                 return false;
             }
             break;
         case RecordType::unchanged:
             // shouldn't be handled outside of chunk handling
-            report_parsing_error(INVALID_UNCHANGED_TYPE, s);
+            report_parsing_error(INVALID_UNCHANGED_TYPE);
             return false;
         default:
-            report_parsing_error(INVALID_TYPE_NAME_FORMAT, s);
+            report_parsing_error(INVALID_TYPE_NAME_FORMAT);
             return false;
     }
 
@@ -241,8 +275,6 @@ bool MessageParser::parse_record(parsing_state_t &s)
         s.it += payload_length;
     }
 
-    s.it += payload_length;
-
     report_record_parsed(record);
 
     return true;
@@ -300,14 +332,22 @@ void MessageParser::report_parsing_terminated()
     }
 }
 
-void MessageParser::report_parsing_error(error_t error, parsing_state_t &parsing_state)
+void MessageParser::report_parsing_error(error_t error)
 {
-    parsing_state.error = true;
+    _error = true;
     if (_delegate) {
         _delegate->on_parsing_error(error);
     }
 }
 
+void MessageParser::report_insufficient_data(parsing_state_t &s)
+{
+    // wait for the rest of the record unless the message is complete
+    if (s.complete) {
+        report_parsing_error(INSUFICIENT_DATA);
+    }
+}
+
 } // namespace ndef
 } // namespace nfc
 } // namespace mbed
@@ -19,6 +19,7 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
 
 #define DEVICEKEY_ENABLED 1
 
@@ -41,6 +42,9 @@ namespace mbed {
 #define DEVICE_KEY_16BYTE 16
 #define DEVICE_KEY_32BYTE 32
 
+// Longest salt whose derived key can be cached, longer salts are always derived
+#define DEVICE_KEY_CACHE_SALT_SIZE 48
+
 enum DeviceKeyStatus {
     DEVICEKEY_SUCCESS                     =  0,
     DEVICEKEY_INVALID_KEY_SIZE            = -1,
@@ -120,6 +124,14 @@ public:
      */
     int generate_root_of_trust(size_t key_size = DEVICE_KEY_16BYTE);
 
+    /** Forget the cached root of trust and derived keys.
+     *
+     * The caches follow the root of trust set through this class. Call this
+     * method after erasing the internal KVStore directly, so that the next
+     * derivation reads the root of trust again.
+     */
+    void clear_cache();
+
 private:
     // Private constructor, as class is a singleton
     DeviceKey();
@@ -139,6 +151,31 @@ private:
      */
     int write_key_to_kvstore(uint32_t *input, size_t isize);
 
+    /** Get the device key, from the RAM copy once read from the KVStore
+     * @param output Buffer for the returned key.
+     * @param size Input: The size of the output buffer.
+     *             Output: The actual size of the written data
+     * @return 0 on success, negative error code on failure
+     */
+    int read_root_of_trust(uint32_t *output, size_t &size);
+
+    /** Look a derived key up in the cache
+     * @param isalt Salt the key was derived from.
+     * @param isalt_size Size of the salt.
+     * @param output Buffer for the derived key.
+     * @param ikey_type Size of the derived key.
+     * @return true if the key was found and copied to output
+     */
+    bool find_derived_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+
+    /** Store a derived key in the cache, in place of the least recently used one
+     * @param isalt Salt the key was derived from.
+     * @param isalt_size Size of the salt.
+     * @param key Derived key.
+     * @param ikey_type Size of the derived key.
+     */
+    void cache_derived_key(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type);
+
     /** Get a derived key base on a salt string. The methods implements Section 5.1
      *  in NIST SP 800-108, Recommendation for Key Derivation Using Pseudorandom Functions
      * @param ikey_buff Input buffer holding the ROT key
@@ -152,6 +189,8 @@ private:
     int get_derived_key(uint32_t *ikey_buff, size_t ikey_size, const unsigned char *isalt, size_t isalt_size,
                         unsigned char *output, uint32_t ikey_type);
 
+    // Protects the cached root of trust and derived keys
+    PlatformMutex _cache_mutex;
 };
 
 /** @}*/
@@ -19,6 +19,7 @@
 #if DEVICEKEY_ENABLED
 #include "mbedtls/cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "kvstore/KVStore.h"
 #include "kvstore/TDBStore.h"
 #include "kvstore/KVMap.h"
@@ -26,6 +27,7 @@
 #include "mbed_wait_api.h"
 #include <stdlib.h>
 #include "platform/mbed_error.h"
+#include "platform/mbed_toolchain.h"
 #include <string.h>
 #include "entropy.h"
 #include "mbed_trace.h"
@@ -54,9 +56,41 @@ namespace mbed {
         (dst)[0] = (src) & 0xFF;                                        \
     } while( 0 )
 
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE
+typedef struct {
+    uint32_t last_use;          // 0 for a free entry
+    uint8_t salt_size;
+    uint8_t key_type;
+    unsigned char salt[DEVICE_KEY_CACHE_SALT_SIZE];
+    unsigned char key[DEVICE_KEY_32BYTE];
+} derived_key_entry_t;
+#endif
+
+// The root of trust once read from the KVStore, so that derivations don't
+// read the internal storage, and the keys last derived, by salt and size.
+// Both can be placed in a dedicated RAM region, such as an SRAM2 page
+// protected by the firewall on STM32L4, with the cache-section option.
+typedef struct {
+#if MBED_CONF_DEVICE_KEY_ROT_CACHE
+    uint32_t rot[DEVICE_KEY_32BYTE / sizeof(uint32_t)];
+    size_t rot_size;            // 0 until read
+#endif
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE
+    derived_key_entry_t derived[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE];
+    uint32_t use_count;
+#endif
+} devkey_cache_t;
+
+#ifdef MBED_CONF_DEVICE_KEY_CACHE_SECTION
+MBED_SECTION(MBED_CONF_DEVICE_KEY_CACHE_SECTION)
+#endif
+static devkey_cache_t devkey_cache;
+
 
 DeviceKey::DeviceKey()
 {
+    // The cache section may not be zeroed at startup
+    memset(&devkey_cache, 0, sizeof(devkey_cache));
 
     int ret = kv_init_storage_config();
     if (ret != MBED_SUCCESS) {
@@ -73,6 +107,7 @@ DeviceKey::DeviceKey()
 
 DeviceKey::~DeviceKey()
 {
+    mbedtls_platform_zeroize(&devkey_cache, sizeof(devkey_cache));
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
@@ -91,13 +126,26 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
 
     actual_size = DEVICE_KEY_16BYTE != ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
 
+    _cache_mutex.lock();
+
+    if (find_derived_key(salt, isalt_size, output, ikey_type)) {
+        _cache_mutex.unlock();
+        return DEVICEKEY_SUCCESS;
+    }
+
     //First try to read the key from KVStore
-    int ret = read_key_from_kvstore(key_buff, actual_size);
-    if (DEVICEKEY_SUCCESS != ret) {
-        return ret;
+    int ret = read_root_of_trust(key_buff, actual_size);
+    if (DEVICEKEY_SUCCESS == ret) {
+        ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    }
+
+    if (DEVICEKEY_SUCCESS == ret) {
+        cache_derived_key(salt, isalt_size, output, ikey_type);
     }
 
-    ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    _cache_mutex.unlock();
+
+    mbedtls_platform_zeroize(key_buff, sizeof(key_buff));
     return ret;
 }
 
@@ -138,7 +186,82 @@ int DeviceKey::write_key_to_kvstore(uint32_t *input, size_t isize)
         return DEVICEKEY_KVSTORE_UNPREDICTED_ERROR;
     }
 
+    // Keys derived from a previous root of trust are stale
+    clear_cache();
+
+    return DEVICEKEY_SUCCESS;
+}
+
+void DeviceKey::clear_cache()
+{
+    _cache_mutex.lock();
+    mbedtls_platform_zeroize(&devkey_cache, sizeof(devkey_cache));
+    _cache_mutex.unlock();
+}
+
+int DeviceKey::read_root_of_trust(uint32_t *output, size_t &size)
+{
+#if MBED_CONF_DEVICE_KEY_ROT_CACHE
+    if (!devkey_cache.rot_size) {
+        size_t rot_size = sizeof(devkey_cache.rot);
+        int ret = read_key_from_kvstore(devkey_cache.rot, rot_size);
+        if (DEVICEKEY_SUCCESS != ret) {
+            return ret;
+        }
+        devkey_cache.rot_size = rot_size;
+    }
+
+    // As when reading from the KVStore, the buffer must fit the whole key
+    if (devkey_cache.rot_size > size) {
+        return DEVICEKEY_READ_FAILED;
+    }
+
+    memcpy(output, devkey_cache.rot, devkey_cache.rot_size);
+    size = devkey_cache.rot_size;
     return DEVICEKEY_SUCCESS;
+#else
+    return read_key_from_kvstore(output, size);
+#endif
+}
+
+bool DeviceKey::find_derived_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output,
+                                 uint16_t ikey_type)
+{
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE
+    for (size_t i = 0; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE; i++) {
+        derived_key_entry_t &entry = devkey_cache.derived[i];
+        if (entry.last_use && entry.key_type == ikey_type && entry.salt_size == isalt_size
+                && !memcmp(entry.salt, isalt, isalt_size)) {
+            memcpy(output, entry.key, ikey_type);
+            entry.last_use = ++devkey_cache.use_count;
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+void DeviceKey::cache_derived_key(const unsigned char *isalt, size_t isalt_size, const unsigned char *key,
+                                  uint16_t ikey_type)
+{
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE
+    if (isalt_size > DEVICE_KEY_CACHE_SALT_SIZE) {
+        return;
+    }
+
+    derived_key_entry_t *lru = &devkey_cache.derived[0];
+    for (size_t i = 1; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE; i++) {
+        if (devkey_cache.derived[i].last_use < lru->last_use) {
+            lru = &devkey_cache.derived[i];
+        }
+    }
+
+    lru->salt_size = isalt_size;
+    lru->key_type = ikey_type;
+    memcpy(lru->salt, isalt, isalt_size);
+    memcpy(lru->key, key, ikey_type);
+    lru->last_use = ++devkey_cache.use_count;
+#endif
 }
 
 int DeviceKey::read_key_from_kvstore(uint32_t *output, size_t &size)
@@ -460,6 +460,50 @@ void generate_derived_key_key_type_32_test()
     TEST_ASSERT(memcmp(output + DEVICE_KEY_32BYTE - sizeof(expectedString), expectedString, sizeof(expectedString)) != 0);
 }
 
+/*
+ * Test that cached derived keys match the keys derived again from the root of trust.
+ */
+void generate_derived_key_cache_test()
+{
+    unsigned char keys[6][DEVICE_KEY_16BYTE];
+    unsigned char output[DEVICE_KEY_16BYTE];
+    unsigned char salt[] = "Salt 0";
+    int key_type = DEVICE_KEY_16BYTE;
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = DeviceKey::get_instance().generate_root_of_trust();
+    if (ret != DEVICEKEY_SUCCESS) {
+        ret = inject_dummy_rot_key();
+    }
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    // More salts than cache entries, so that some keys get evicted
+    for (int i = 0; i < 6; i++) {
+        salt[5] = '0' + i;
+        ret = devkey.generate_derived_key(salt, sizeof(salt), keys[i], key_type);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+    }
+
+    for (int j = 0; j < 2; j++) {
+        for (int i = 5; i >= 0; i--) {
+            salt[5] = '0' + i;
+            memset(output, 0, sizeof(output));
+            ret = devkey.generate_derived_key(salt, sizeof(salt), output, key_type);
+            TEST_ASSERT_EQUAL_INT32(0, ret);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(keys[i], output, DEVICE_KEY_16BYTE);
+        }
+        devkey.clear_cache();
+    }
+
+    TEST_ASSERT(memcmp(keys[0], keys[1], DEVICE_KEY_16BYTE) != 0);
+}
+
 /*
  * Test request for unknown key size returns an error
  */
@@ -509,6 +553,7 @@ Case cases[] = {
 #ifndef MBEDTLS_AES_ONLY_128_BIT_KEY_LENGTH
     Case("Device Key - derived key key type 32",             generate_derived_key_key_type_32_test,             greentea_failure_handler),
 #endif
+    Case("Device Key - derived key cache",                   generate_derived_key_cache_test,                   greentea_failure_handler),
     Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler)
 };
 
@@ -0,0 +1,247 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_PIPELINE_H
+#define MBED_ANALOGIN_PIPELINE_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGIN_STREAM || defined(DOXYGEN_ONLY)
+
+#include "drivers/AnalogInStream.h"
+#include "platform/mbed_dsp.h"
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_AnalogInPipeline AnalogInPipeline class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** Signal processing of an analog input sampled by an AnalogInStream
+ *
+ * Each half of the stream buffer is converted to q15 samples and run through a
+ * chain of stages, in place: the half is processed while the DMA fills the
+ * other one, and no copy of the samples is made. The output of the last stage
+ * is passed to the callback.
+ *
+ * The stages are FIRDecimateStage, FFTStage, or classes implementing
+ * AnalogInPipeline::Stage, such as ones calling CMSIS-DSP functions for an
+ * application linking its library.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * // Low-pass filter before a decimation by 4, coefficients in time reversed order
+ * static const int16_t lowpass[16] = { ... };
+ * static FIRDecimateStage<16, 4, 1024> decimate(lowpass);
+ * static FFTStage<256> fft(true);
+ * static uint16_t samples[2 * 1024];
+ * static EventQueue queue;
+ *
+ * void spectrum(Span<const int16_t> magnitudes)
+ * {
+ *     // 128 bins of 0 to 2.5 kHz
+ * }
+ *
+ * int main()
+ * {
+ *     AnalogInPipeline pipeline(A0);
+ *     pipeline.add_stage(decimate);
+ *     pipeline.add_stage(fft);
+ *     pipeline.start(20000, samples, callback(spectrum), &queue);
+ *     queue.dispatch_forever();
+ * }
+ * @endcode
+ */
+class AnalogInPipeline : private NonCopyable<AnalogInPipeline> {
+
+public:
+
+    /** A processing stage of a pipeline
+     */
+    class Stage {
+    public:
+        /** Process a block of samples in place
+         *
+         * @param block The samples, replaced by the output of the stage
+         * @param count The number of samples
+         * @return The number of output samples at the start of block, 0 to
+         *         stop the processing of the block
+         */
+        virtual size_t process(int16_t *block, size_t count) = 0;
+
+    protected:
+        ~Stage() = default;
+    };
+
+    /** Create an AnalogInPipeline sampling the specified pin
+     *
+     * @param pin The analog input
+     */
+    AnalogInPipeline(PinName pin);
+
+    /** Stop sampling and release the ADC
+     */
+    ~AnalogInPipeline();
+
+    /** Append a stage to the pipeline
+     *
+     * @param stage The stage, which must stay valid while the pipeline runs
+     * @return 0 on success, -1 if the pipeline is running or full
+     */
+    int add_stage(Stage &stage);
+
+    /** Start sampling
+     *
+     * @param rate   The number of samples per second
+     * @param buffer The buffer the samples are processed in, its size a multiple
+     *               of 2 and of what the stages require
+     * @param func   The callback receiving the output of the last stage
+     * @param queue  The queue the processing and the callback are posted to,
+     *               nullptr to run them in interrupt context
+     * @return 0 on success, -1 on failure
+     */
+    int start(uint32_t rate, Span<uint16_t> buffer, Callback<void(Span<const int16_t>)> func,
+              events::EventQueue *queue = nullptr);
+
+    /** Stop sampling
+     */
+    void stop();
+
+    /** Get the stream sampling the input, to configure its oversampling
+     *
+     * @return The stream
+     */
+    AnalogInStream &stream()
+    {
+        return _stream;
+    }
+
+    /** Get the number of buffer halves not processed in time
+     *
+     * @return The number of overruns since start()
+     */
+    uint32_t overruns() const
+    {
+        return _stream.overruns();
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    void process(Span<const uint16_t> samples);
+
+    PinName _pin;
+    AnalogInStream _stream;
+    Stage *_stages[MBED_CONF_DRIVERS_ANALOGIN_PIPELINE_STAGES];
+    size_t _stage_count = 0;
+    uint8_t _bits = 0;
+    bool _running = false;
+    Callback<void(Span<const int16_t>)> _func;
+    PlatformMutex _mutex;
+#endif
+};
+
+/** FIR filter followed by a decimation, see mbed_dsp_fir_decimate_q15()
+ *
+ * @tparam taps      The number of coefficients
+ * @tparam factor    The decimation factor, 1 to only filter
+ * @tparam max_block The largest number of samples of a block, half the
+ *                   stream buffer for a first stage
+ */
+template <uint16_t taps, uint16_t factor, uint32_t max_block>
+class FIRDecimateStage : public AnalogInPipeline::Stage, private NonCopyable<FIRDecimateStage<taps, factor, max_block> > {
+    MBED_STATIC_ASSERT(taps > 0 && factor > 0 && max_block % factor == 0, "Invalid FIRDecimateStage parameters");
+
+public:
+    /** Create the stage
+     *
+     * @param coeffs The coefficients in time reversed order, kept by the stage
+     */
+    FIRDecimateStage(const int16_t (&coeffs)[taps])
+    {
+        mbed_dsp_fir_decimate_q15_init(&_fir, coeffs, taps, factor, _state, max_block);
+    }
+
+    /** Clear the samples kept from the previous block
+     */
+    void reset()
+    {
+        mbed_dsp_fir_decimate_q15_init(&_fir, _fir.coeffs, taps, factor, _state, max_block);
+    }
+
+    size_t process(int16_t *block, size_t count) override
+    {
+        return mbed_dsp_fir_decimate_q15(&_fir, block, block, count);
+    }
+
+private:
+    mbed_dsp_fir_decimate_q15_t _fir;
+    int16_t _state[taps - 1 + max_block];
+};
+
+/** Real FFT of blocks of n samples, see mbed_dsp_rfft_q15()
+ *
+ * The output is the packed spectrum of n samples, or the n / 2 magnitudes of
+ * the bins.
+ *
+ * @tparam n The size of the transform, a power of 2 from 4 to 4096, which must
+ *           be the number of samples of the blocks
+ */
+template <uint32_t n>
+class FFTStage : public AnalogInPipeline::Stage, private NonCopyable<FFTStage<n> > {
+    MBED_STATIC_ASSERT(n >= 4 && n <= 4096 && (n & (n - 1)) == 0, "FFTStage size must be a power of 2 from 4 to 4096");
+
+public:
+    /** Create the stage
+     *
+     * @param magnitude True to output the magnitudes of the bins
+     */
+    FFTStage(bool magnitude = false) : _magnitude(magnitude)
+    {
+        mbed_dsp_rfft_q15_init(_twiddles, n);
+    }
+
+    size_t process(int16_t *block, size_t count) override
+    {
+        MBED_ASSERT(count == n);
+        if (count != n) {
+            return 0;
+        }
+        mbed_dsp_rfft_q15(block, n, _twiddles);
+        if (_magnitude) {
+            mbed_dsp_rfft_mag_q15(block, n);
+            return n / 2;
+        }
+        return n;
+    }
+
+private:
+    int16_t _twiddles[n];
+    bool _magnitude;
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
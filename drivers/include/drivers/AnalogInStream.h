@@ -0,0 +1,152 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_STREAM_H
+#define MBED_ANALOGIN_STREAM_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGIN_STREAM || defined(DOXYGEN_ONLY)
+
+#include "hal/analogin_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/Span.h"
+#include "events/EventQueue.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_AnalogInStream AnalogInStream class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** Continuous sampling of a set of analog inputs
+ *
+ * The inputs are converted together at a fixed rate, the conversions being
+ * triggered and stored by the hardware into a user buffer. The buffer is
+ * used as two halves: when the hardware has filled one half it is passed to
+ * the callback while the other half is being filled.
+ *
+ * When an EventQueue is given to start(), the callback runs from the thread
+ * dispatching that queue. Otherwise it runs in interrupt context.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * static const PinName pins[] = {A0, A1};
+ * static uint16_t samples[2 * 2 * 64];
+ * static EventQueue queue;
+ *
+ * void process(Span<const uint16_t> block)
+ * {
+ *     // block holds 64 interleaved A0, A1 pairs
+ * }
+ *
+ * int main()
+ * {
+ *     AnalogInStream stream(pins, 2);
+ *     stream.start(10000, samples, callback(process), &queue);
+ *     queue.dispatch_forever();
+ * }
+ * @endcode
+ */
+class AnalogInStream : private NonCopyable<AnalogInStream> {
+
+public:
+
+    /** Create an AnalogInStream sampling the specified pins
+     *
+     * @param pins  The pins to sample, which must be on the same ADC
+     * @param count The number of pins
+     */
+    AnalogInStream(const PinName *pins, size_t count);
+
+    /** Stop sampling and release the ADC
+     */
+    ~AnalogInStream();
+
+    /** Configure the hardware oversampling
+     *
+     * Each sample becomes the sum of 2^ratio_log2 conversions shifted right
+     * by shift, which averages out noise without CPU processing.
+     *
+     * @param ratio_log2 log2 of the number of conversions per sample, 0 to disable
+     * @param shift      The right shift applied to the sum
+     * @return 0 on success, -1 if not supported or the stream is running
+     */
+    int set_oversampling(uint8_t ratio_log2, uint8_t shift = 0);
+
+    /** Get the number of significant bits of the samples
+     *
+     * @return The sample width with the current oversampling configuration
+     */
+    uint8_t sample_bits();
+
+    /** Start sampling
+     *
+     * @param rate   The number of times per second all the pins are sampled
+     * @param buffer The buffer filled with interleaved samples, its size a
+     *               multiple of twice the number of pins
+     * @param func   The callback receiving each filled half of the buffer
+     * @param queue  The queue the callback is posted to, nullptr to call it
+     *               from interrupt context
+     * @return 0 on success, -1 on failure
+     */
+    int start(uint32_t rate, Span<uint16_t> buffer, Callback<void(Span<const uint16_t>)> func,
+              events::EventQueue *queue = nullptr);
+
+    /** Stop sampling
+     *
+     * Callbacks already posted to the queue are still delivered.
+     */
+    void stop();
+
+    /** Get the number of buffer halves delivered while the previous one was
+     *  still being processed or could not be posted
+     *
+     * @return The number of overruns since start()
+     */
+    uint32_t overruns() const
+    {
+        return _overruns;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void irq_handler(uint32_t id, uint16_t *samples, size_t count);
+    void process(Span<const uint16_t> samples);
+
+    analogin_stream_t _stream;
+    Callback<void(Span<const uint16_t>)> _func;
+    events::EventQueue *_queue = nullptr;
+    volatile uint32_t _pending = 0;
+    volatile uint32_t _overruns = 0;
+    PlatformMutex _mutex;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
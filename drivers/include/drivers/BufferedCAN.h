@@ -0,0 +1,215 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUFFEREDCAN_H
+#define MBED_BUFFEREDCAN_H
+
+#include "platform/platform.h"
+
+#if DEVICE_CAN || defined(DOXYGEN_ONLY)
+
+#include "drivers/CAN.h"
+#include "drivers/HighResClock.h"
+#include "platform/LockFreeQueue.h"
+
+#include <chrono>
+
+#ifndef MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE  32
+#endif
+
+#ifndef MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE  16
+#endif
+
+namespace mbed {
+/**
+ * \defgroup drivers_BufferedCAN BufferedCAN class
+ * \ingroup drivers-public-api-can
+ * @{
+ */
+
+/** A CAN interface receiving and sending in the background
+ *
+ * The receive interrupt drains the hardware FIFO into a software queue of
+ * MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE frames, each stamped with the
+ * HighResClock time it was taken from the FIFO, so a burst longer than the
+ * three hardware mailboxes isn't lost while the application is busy.
+ * The frames are then read one at a time or in batches.
+ *
+ * The frames written wait in a queue of MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE
+ * frames when the transmit mailboxes are busy, and the transmit interrupt
+ * moves them to the mailboxes as they free up. The queue is ordered as the
+ * bus arbitration is, lowest identifier first, so a frame of high priority
+ * doesn't wait behind frames of lower priority written before it, apart from
+ * the ones already in the mailboxes.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * BufferedCAN can(PD_0, PD_1, 500000);
+ *
+ * int main()
+ * {
+ *     const unsigned int ids[] = { 0x100, 0x101, 0x200, 0x201, 0x300 };
+ *     can.filter_list(ids, 5);
+ *
+ *     CANMessage msgs[8];
+ *     while (true) {
+ *         size_t count = can.read_many(msgs, 8);
+ *         for (size_t i = 0; i < count; i++) {
+ *             printf("ID %x\n", msgs[i].id);
+ *         }
+ *         ThisThread::sleep_for(10ms);
+ *     }
+ * }
+ * @endcode
+ *
+ * @note Synchronization level: One reading thread, the other functions are thread safe
+ */
+class BufferedCAN : public CAN {
+public:
+    /** Creates a BufferedCAN interface connected to specific pins.
+     *
+     *  @param rd read from transmitter
+     *  @param td transmit to transmitter
+     *  @param hz the bus frequency in hertz
+     */
+    BufferedCAN(PinName rd, PinName td, int hz);
+
+    /** Creates a BufferedCAN interface connected to specific pins.
+     *
+     *  @param pinmap reference to structure which holds static pinmap
+     *  @param hz the bus frequency in hertz
+     */
+    BufferedCAN(const can_pinmap_t &pinmap, int hz);
+    BufferedCAN(const can_pinmap_t &&, int) = delete; // prevent passing of temporary objects
+
+    ~BufferedCAN() override;
+
+    /** Write a CANMessage to the bus, or to the transmit queue
+     *
+     *  @param msg The CANMessage to write.
+     *
+     *  @returns
+     *    0 if the transmit queue is full,
+     *    1 if the message is sent or queued
+     */
+    int write(CANMessage msg);
+
+    /** Write a CANMessage, waiting for room in the transmit queue
+     *
+     *  @param msg The CANMessage to write.
+     *  @param timeout The longest time to wait for room in the queue
+     *
+     *  @returns
+     *    0 if the transmit queue stayed full until the timeout,
+     *    1 if the message is sent or queued
+     */
+    int write(CANMessage msg, std::chrono::milliseconds timeout);
+
+    /** Get the room in the transmit queue
+     *
+     *  @returns the number of messages that can be written without waiting
+     */
+    size_t writable() const;
+
+    /** Read a CANMessage from the receive queue
+     *
+     *  @param msg A CANMessage to read to.
+     *  @param handle message filter handle, only messages of any filter (0) are buffered
+     *
+     *  @returns
+     *    0 if no message arrived,
+     *    1 if message arrived
+     */
+    int read(CANMessage &msg, int handle = 0);
+
+    /** Read a CANMessage and the time it was received
+     *
+     *  @param msg A CANMessage to read to.
+     *  @param timestamp Set to the time the message was taken from the hardware
+     *
+     *  @returns
+     *    0 if no message arrived,
+     *    1 if message arrived
+     */
+    int read(CANMessage &msg, HighResClock::time_point &timestamp);
+
+    /** Read several CANMessages from the receive queue
+     *
+     *  @param msgs buffer for the messages
+     *  @param count size of msgs
+     *  @param timestamps buffer of count time points, for the times the
+     *         messages were received (Optional)
+     *
+     *  @returns the number of messages read, 0 if none arrived
+     */
+    size_t read_many(CANMessage *msgs, size_t count, HighResClock::time_point *timestamps = nullptr);
+
+    /** Get the number of messages in the receive queue
+     *
+     *  @returns the number of messages that can be read
+     */
+    size_t readable() const;
+
+    /** Get the number of messages lost because the receive queue was full
+     *
+     *  @returns the number of messages dropped since the interface was created
+     */
+    uint32_t overruns() const;
+
+    /** Attach a function to call on CAN interrupts
+     *
+     *  The RxIrq function is called from the interrupt, once per batch of
+     *  messages queued, instead of once per message received. The TxIrq
+     *  function is called once the messages queued are moved to the mailboxes.
+     *
+     *  @param func A pointer to a void function, or 0 to set as none
+     *  @param type Which CAN interrupt to attach the member function to
+     */
+    void attach(Callback<void()> func, IrqType type = RxIrq);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    struct rx_frame {
+        CANMessage msg;
+        HighResClock::time_point timestamp;
+    };
+
+    void rx_irq();
+    void tx_irq();
+    void tx_insert(const CANMessage &msg);
+    void tx_fill();
+
+    SPSCQueue<rx_frame, MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE> _rx;
+    Callback<void()> _rx_cb;
+    // Ordered by decreasing priority value, the next frame is the last one
+    CANMessage _tx[MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE];
+    uint32_t _tx_count;
+    Callback<void()> _tx_cb;
+    uint32_t _overruns;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif // MBED_BUFFEREDCAN_H
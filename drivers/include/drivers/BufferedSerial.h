@@ -37,6 +37,22 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_BUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_BUF_SIZE  128
+#endif
+
+#if DEVICE_SERIAL_DMA && MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA
+#define MBED_BUFFERED_SERIAL_RX_DMA 1
+#else
+#define MBED_BUFFERED_SERIAL_RX_DMA 0
+#endif
+
+#if DEVICE_SERIAL_DMA && MBED_CONF_DRIVERS_UART_SERIAL_TX_DMA
+#define MBED_BUFFERED_SERIAL_TX_DMA 1
+#else
+#define MBED_BUFFERED_SERIAL_TX_DMA 0
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_BufferedSerial BufferedSerial class
@@ -89,6 +105,13 @@ public:
      */
     short poll(short events) const final;
 
+    /** The changes of the poll events are notified with mbed::poll_notify().
+     *  Derived from FileHandle.
+     *
+     *  @returns true
+     */
+    bool poll_notifies() const final;
+
     /* Resolve ambiguities versus our private SerialBase
      * (for writable, spelling differs, but just in case)
      */
@@ -321,6 +344,30 @@ private:
      */
     void disable_tx_irq();
 
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    /** Start receiving into the DMA ring, if a DMA channel is available.
+     *  On failure the per-character RX IRQ is used.
+     */
+    void rx_dma_start();
+
+    /** Move what is left in the DMA ring to the receive buffer and stop the
+     *  DMA reception.
+     */
+    void rx_dma_stop();
+#endif
+
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    /** Send the transmit buffer with DMA, if a DMA channel is available.
+     *  On failure the per-character TX IRQ is used.
+     */
+    void tx_dma_start();
+
+    /** Wait for the DMA to send what is in the transmit buffer and release
+     *  the DMA channel.
+     */
+    void tx_dma_stop();
+#endif
+
     /** Software serial buffers
      *  By default buffer size is 256 for TX and 256 for RX. Configurable
      *  through mbed_app.json
@@ -328,6 +375,23 @@ private:
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
 
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    /** Ring written by the receive DMA, drained into _rxbuf from rx_irq()
+     *  when the line goes idle or the ring is half or completely full.
+     */
+    char _rx_dma_buf[MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_BUF_SIZE];
+    size_t _rx_dma_tail = 0;
+    bool _rx_dma_active = false;
+#endif
+
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    /** Length of the _txbuf span the DMA is reading, released from tx_irq()
+     *  once the transfer completes.
+     */
+    size_t _tx_dma_len = 0;
+    bool _tx_dma_active = false;
+#endif
+
     PlatformMutex _mutex;
 
     Callback<void()> _sigio_cb;
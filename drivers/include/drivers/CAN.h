@@ -265,6 +265,37 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+    /** Accept a list of identifiers, using as many filters as needed
+     *
+     *  Each filter holds up to four standard, or two extended, identifiers.
+     *
+     *  @param ids the identifiers to accept
+     *  @param count the number of identifiers
+     *  @param format format of the identifiers, CANStandard or CANExtended (Default CANStandard)
+     *  @param handle first message filter handle used (Optional)
+     *
+     *  @returns
+     *    0 if filter change failed or unsupported,
+     *    number of filter handles used, from handle, if successful
+     */
+    int filter_list(const unsigned int *ids, int count, CANFormat format = CANStandard, int handle = 0);
+
+    /** Stop accepting the messages of a filter
+     *
+     *  @param handle message filter handle
+     *
+     *  @returns
+     *    0 if filter change failed or unsupported,
+     *    1 if the filter was disabled
+     */
+    int filter_disable(int handle);
+
+    /** Get the number of message filter handles
+     *
+     *  @returns the number of handles, from 0, accepted by filter() and filter_list()
+     */
+    int filter_count();
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -0,0 +1,263 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTGPIO_H
+#define MBED_FASTGPIO_H
+
+#include "platform/platform.h"
+
+#include "hal/gpio_fast_api.h"
+
+#if GPIO_FAST_READY || defined(DOXYGEN_ONLY)
+
+#include "hal/port_api.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_FastGPIO Fast GPIO classes
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A digital output whose pin is known at compile time
+ *
+ * Unlike DigitalOut, the object holds no state: write and read compile to
+ * a single access to the GPIO registers, for bit-banged protocols or chip
+ * selects toggled around short transfers. Only available on targets
+ * defining GPIO_FAST_READY, see hal/gpio_fast_api.h.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * FastDigitalOut<PA_4> cs(1);
+ *
+ * cs = 0;
+ * spi.write(0x9F);
+ * cs = 1;
+ * @endcode
+ */
+template <PinName Pin>
+class FastDigitalOut {
+    static_assert(Pin != NC, "FastDigitalOut needs a pin");
+
+public:
+    /** Initialize the pin as an output
+     *
+     *  @param value Initial value of the output
+     */
+    explicit FastDigitalOut(int value = 0)
+    {
+        gpio_t gpio;
+        gpio_init_out_ex(&gpio, Pin, value);
+    }
+
+    /** Set the output
+     *
+     *  @param value 0 for logical 0, 1 (or any other non-zero value) for logical 1
+     */
+    void write(int value)
+    {
+        gpio_fast_write(Pin, value);
+    }
+
+    /** Return the output setting, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    an integer representing the output setting of the pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read()
+    {
+        return gpio_fast_read(Pin);
+    }
+
+    /** A shorthand for write()
+     * \sa FastDigitalOut::write()
+     */
+    FastDigitalOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa FastDigitalOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+};
+
+/** A digital input whose pin is known at compile time
+ *
+ * Unlike DigitalIn, the object holds no state: read compiles to a single
+ * access to the GPIO registers.
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+template <PinName Pin>
+class FastDigitalIn {
+    static_assert(Pin != NC, "FastDigitalIn needs a pin");
+
+public:
+    /** Initialize the pin as an input
+     *
+     *  @param mode The initial mode of the pin
+     */
+    explicit FastDigitalIn(PinMode mode = PullDefault)
+    {
+        gpio_t gpio;
+        gpio_init_in_ex(&gpio, Pin, mode);
+    }
+
+    /** Read the input, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    An integer representing the state of the input pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read()
+    {
+        return gpio_fast_read(Pin);
+    }
+
+    /** Set the input pin mode
+     *
+     *  @param pull PullUp, PullDown, PullNone, OpenDrain
+     */
+    void mode(PinMode pull)
+    {
+        pin_mode(Pin, pull);
+    }
+
+    /** A shorthand for read()
+     * \sa FastDigitalIn::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+};
+
+#if DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
+/** A multiple pin digital output whose port and pins are known at compile time
+ *
+ * Unlike PortOut, the object holds no state and the masks are computed at
+ * compile time: write sets and clears the pins in a single register write,
+ * which also leaves the other pins of the port untouched when interrupted.
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+template <PortName Port, uint32_t Mask = 0xFFFFFFFF>
+class FastPortOut {
+public:
+    /** Initialize the pins of the port as outputs
+     */
+    FastPortOut()
+    {
+        port_t port;
+        port_init(&port, Port, Mask, PIN_OUTPUT);
+    }
+
+    /** Write the value to the output port
+     *
+     *  @param value An integer specifying a bit to write for every corresponding pin
+     */
+    void write(int value)
+    {
+        port_fast_write(Port, Mask, value);
+    }
+
+    /** Read the value currently output on the port
+     *
+     *  @returns
+     *    An integer with each bit corresponding to associated pin value
+     */
+    int read()
+    {
+        return port_fast_read(Port, Mask);
+    }
+
+    /** A shorthand for write()
+     * \sa FastPortOut::write()
+     */
+    FastPortOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa FastPortOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+};
+#endif
+
+#if DEVICE_PORTIN || defined(DOXYGEN_ONLY)
+/** A multiple pin digital input whose port and pins are known at compile time
+ *
+ * Unlike PortIn, the object holds no state: read compiles to a single
+ * register read and a constant mask.
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+template <PortName Port, uint32_t Mask = 0xFFFFFFFF>
+class FastPortIn {
+public:
+    /** Initialize the pins of the port as inputs
+     *
+     *  @param mode The initial mode of the pins
+     */
+    explicit FastPortIn(PinMode mode = PullDefault)
+    {
+        port_t port;
+        port_init(&port, Port, Mask, PIN_INPUT);
+        port_mode(&port, mode);
+    }
+
+    /** Read the value input to the port
+     *
+     *  @returns
+     *    An integer with each bit corresponding to the associated pin value
+     */
+    int read()
+    {
+        return port_fast_read(Port, Mask);
+    }
+
+    /** A shorthand for read()
+     * \sa FastPortIn::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+};
+#endif
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -30,6 +30,12 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#if DEVICE_FLASH_ASYNCH
+#include "platform/Callback.h"
+#if TRANSACTION_QUEUE_SIZE_FLASH
+#include "platform/CircularBuffer.h"
+#endif
+#endif
 #include <algorithm>
 
 // Export ROM end address
@@ -151,6 +157,51 @@ public:
      */
     uint8_t get_erase_value() const;
 
+#if DEVICE_FLASH_ASYNCH || defined(DOXYGEN_ONLY)
+    /** Program data to pages without blocking
+     *
+     *  The sectors must have been erased prior to being programmed. The
+     *  program and erase functions fail until the callback has been called.
+     *  While an asynchronous operation is ongoing, the request is queued,
+     *  whatever the instance, and started from interrupt context when the
+     *  operations queued before it have completed. The queue holds
+     *  TRANSACTION_QUEUE_SIZE_FLASH requests.
+     *
+     *  @note The CPU stalls when reading from the flash bank being programmed.
+     *        On dual-bank devices, program the bank the code is not running from.
+     *
+     *  @param buffer   Buffer of data to be written, valid until the callback is called
+     *  @param addr     Address of a page to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program size
+     *  @param callback Called from interrupt context with 0 on success, negative error code on failure
+     *  @return         0 if programming started or was queued, negative error code on failure
+     */
+    int program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Erase sectors without blocking
+     *
+     *  The program and erase functions fail until the callback has been called.
+     *  Requests made while an asynchronous operation is ongoing are queued,
+     *  as for program_async.
+     *
+     *  @note The CPU stalls when reading from the flash bank being erased.
+     *        On dual-bank devices, erase the bank the code is not running from.
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param callback Called from interrupt context with 0 on success, negative error code on failure
+     *  @return         0 if erasing started or was queued, negative error code on failure
+     */
+    int erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Check whether an asynchronous program or erase is in progress
+     *
+     *  @return true until the callback of the last asynchronous operation,
+     *          queued ones included, has been called
+     */
+    bool async_busy() const;
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -162,8 +213,35 @@ private:
      */
     bool is_aligned_to_sector(uint32_t addr, uint32_t size);
 
+#if DEVICE_FLASH_ASYNCH
+    struct async_request {
+        FlashIAP *flash;
+        Callback<void(int)> callback;
+        const uint8_t *buf;
+        uint32_t addr;
+        uint32_t size;
+    };
+
+    static void async_handler(uint32_t id, int32_t status);
+    int async_submit(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+    int async_start(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+    int async_next();
+    static void async_dequeue();
+#endif
+
     flash_t _flash;
     uint8_t *_page_buf;
+#if DEVICE_FLASH_ASYNCH
+    // The flash controller runs a single operation at a time, whatever the instance
+    static Callback<void(int)> _async_callback;
+    static const uint8_t *_async_buf; // nullptr when erasing
+    static uint32_t _async_addr;
+    static uint32_t _async_size;
+    static volatile bool _async_busy;
+#if TRANSACTION_QUEUE_SIZE_FLASH
+    static SingletonPtr<CircularBuffer<async_request, TRANSACTION_QUEUE_SIZE_FLASH> > _async_queue;
+#endif
+#endif
     static SingletonPtr<PlatformMutex> _mutex;
 #endif
 };
@@ -58,7 +58,7 @@ public:
     /** Read the current time */
     static time_point now()
     {
-        return time_point{duration{ticker_read_us(get_us_ticker_data())}};
+        return time_point{duration{us_ticker_read_us()}};
     }
 
     /** Lock the clock to ensure it stays running */
@@ -27,9 +27,14 @@
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
+#if DEVICE_CLOCK_SCALING
+#include "platform/mbed_clock_scaling.h"
+#endif
+
 #if DEVICE_I2C_ASYNCH
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
+#include "platform/CircularBuffer.h"
 #include "platform/Callback.h"
 #endif
 
@@ -186,7 +191,9 @@ public:
 
     virtual ~I2C()
     {
-        // Do nothing
+#if DEVICE_CLOCK_SCALING
+        mbed_clock_notifier_remove(&_clock_notifier);
+#endif
     }
 
 #if DEVICE_I2C_ASYNCH
@@ -195,6 +202,13 @@ public:
      *
      * This function locks the deep sleep until any event has occurred
      *
+     * A write then read transfer is a single job: the repeated start and the
+     * read are issued from the interrupt once the write completes.
+     *
+     * If a transfer of any I2C object is ongoing, the transfer is put on a
+     * queue shared by all the I2C objects, like their lock, and started from
+     * the interrupt when the previous one completes.
+     *
      * @param address   8/10 bit I2C slave address
      * @param tx_buffer The TX buffer with data to be transferred
      * @param tx_length The length of TX buffer in bytes
@@ -205,14 +219,32 @@ public:
      * @param repeated Repeated start, true - do not send stop at end
      *        default value is false.
      *
-     * @returns Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @returns Zero if the transfer has started or was queued, or -1 if I2C peripheral is busy and the queue is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
-    /** Abort the ongoing I2C transfer
+    /** Abort the ongoing I2C transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
 
+    /** Clear the queued transfers of this I2C object.
+     */
+    void clear_transfer_buffer();
+
+    /** Clear the queued transfers of this I2C object and abort the ongoing transfer.
+     */
+    void abort_all_transfers();
+
+    /** Configure DMA usage suggestion for non-blocking transfers.
+     *
+     *  @param usage The usage DMA hint for peripheral.
+     *
+     *  @return Result of the operation.
+     *  @retval 0 The usage was set.
+     *  @retval -1 Usage cannot be set as there is an ongoing transaction.
+     */
+    int set_dma_usage(DMAUsage usage);
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -221,11 +253,55 @@ protected:
     /** Unlock deep sleep only if it has been locked */
     void unlock_deep_sleep();
 
+    /** Put a transfer on the transfer queue, started at once if the bus is idle.
+     *
+     * @return Operation success.
+     * @retval 0 A transfer was added to the queue.
+     * @retval -1 Transfer can't be added because queue is full.
+     */
+    int queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
+    /** Configure a callback, the bus frequency, and initiate a new transfer.
+     *
+     * Does not take the lock, as it is also called from the interrupt.
+     */
+    void start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
+    /** Release the bus once the HAL is idle and start the next queued transfer. */
+    void finish_transfer();
+
     void irq_handler_asynch(void);
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+
+    /* Object whose nonblocking transfer is ongoing */
+    static I2C *volatile _transfer_owner;
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+    /* Pending nonblocking transfer */
+    struct transfer_s {
+        I2C *object;
+        int address;
+        const char *tx_buffer;
+        int tx_length;
+        char *rx_buffer;
+        int rx_length;
+        event_callback_t callback;
+        int event;
+        bool repeated;
+    };
+
+    /** Dequeue a transfer and start it if there was one pending.
+     *
+     * Called with interrupts disabled.
+     */
+    static void dequeue_transaction();
+
+    /* Queue of pending transfers */
+    static SingletonPtr<CircularBuffer<transfer_s, TRANSACTION_QUEUE_SIZE_I2C> > _transaction_buffer;
+#endif
 #endif
 #endif
 
@@ -239,8 +315,15 @@ protected:
     static SingletonPtr<PlatformMutex> _mutex;
     PinName _sda;
     PinName _scl;
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_t _clock_notifier;
+#endif
 
 private:
+#if DEVICE_CLOCK_SCALING
+    static void clock_changed(void *context, uint32_t frequency_hz);
+#endif
+
     /** Recover I2C bus, when stuck with SDA low
      *  @note : Initialization of I2C bus is required after this API.
      *
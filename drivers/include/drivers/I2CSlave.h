@@ -23,6 +23,11 @@
 
 #include "hal/i2c_api.h"
 
+#if DEVICE_I2CSLAVE_REGMAP || defined(DOXYGEN_ONLY)
+#include "platform/Callback.h"
+#include "platform/Span.h"
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_I2CSlave I2CSlave class
@@ -149,6 +154,10 @@ public:
     I2CSlave(const i2c_pinmap_t &static_pinmap);
     I2CSlave(const i2c_pinmap_t &&) = delete; // prevent passing of temporary objects
 
+    /** Stop serving the register map, if any
+     */
+    ~I2CSlave();
+
     /** Set the frequency of the I2C interface.
      *
      *  @param hz The bus frequency in Hertz.
@@ -214,15 +223,71 @@ public:
     void address(int address);
 
     /** Reset the I2C slave back into the known ready receiving state.
+     *
+     *  The register map, if served, is stopped.
      */
     void stop(void);
 
+#if DEVICE_I2CSLAVE_REGMAP || defined(DOXYGEN_ONLY)
+    /** Function called after the master wrote registers, with the offset of
+     *  the first one and the number written
+     */
+    typedef Callback<void(size_t offset, size_t length)> write_callback_t;
+
+    /** Emulate a register mapped device
+     *
+     * The transfers are served from interrupts, and DMA where available,
+     * with no polling: the master writes the register pointer as the first
+     * byte of a write, followed by the values to store from there, and reads
+     * from the pointer, with a repeated start or in a separate transfer. The
+     * pointer increments with each byte transferred. Past the end of the map
+     * writes are dropped and reads return 0xFF.
+     *
+     * Only writes call back, from interrupt context once the master ends the
+     * transfer. The application updates the registers the master reads
+     * directly in the map; to keep multi-byte values consistent, update them
+     * in a critical section. receive(), read() and write() must not be used
+     * until stop_register_map().
+     *
+     * @note address() must be called first.
+     *
+     * @param registers Register map, at most 256 bytes, valid until stop_register_map()
+     * @param on_write  Function called from interrupt context after writes, may be empty
+     * @return 0 on success, -1 if the map is invalid or already served
+     *
+     * @code
+     * I2CSlave slave(I2C_SDA, I2C_SCL);
+     * uint8_t regs[32] = { 0x5A };   // WHO_AM_I at 0x00
+     *
+     * void on_write(size_t offset, size_t length)
+     * {
+     *     // regs[offset] to regs[offset + length - 1] were written
+     * }
+     *
+     * slave.address(0xA0);
+     * slave.start_register_map(regs, on_write);
+     * @endcode
+     */
+    int start_register_map(Span<uint8_t> registers, write_callback_t on_write);
+
+    /** Stop emulating the register map, the polled functions can be used again
+     */
+    void stop_register_map();
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 
 protected:
     /* Internal i2c object identifying the resources */
     i2c_t _i2c;
 
+#if DEVICE_I2CSLAVE_REGMAP
+    static void _register_write_irq(uint32_t id, uint32_t offset, uint32_t length);
+
+    write_callback_t _write_callback;
+    bool _register_map_started = false;
+#endif
+
 #endif //!defined(DOXYGEN_ONLY)
 };
 
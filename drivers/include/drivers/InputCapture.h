@@ -0,0 +1,170 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INPUT_CAPTURE_H
+#define MBED_INPUT_CAPTURE_H
+
+#include "platform/platform.h"
+
+#if DEVICE_INPUT_CAPTURE || defined(DOXYGEN_ONLY)
+
+#include "hal/input_capture_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/Span.h"
+#include "events/EventQueue.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_InputCapture InputCapture class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** Hardware timestamping of the edges of a digital input
+ *
+ * A timer latches its counter on each edge and the DMA stores the values
+ * into a user buffer, so edges a few timer clocks apart are measured without
+ * any interrupt per edge. The buffer is used as two halves: when the hardware
+ * has filled one half it is passed to the callback while the other half is
+ * being filled.
+ *
+ * The buffer holds either the counter values, or the periods between two
+ * consecutive edges, in ticks of tick_hz().
+ *
+ * When an EventQueue is given to start(), the callback runs from the thread
+ * dispatching that queue. Otherwise it runs in interrupt context.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * static uint32_t periods[2 * 32];
+ * static EventQueue queue;
+ *
+ * void process(Span<const uint32_t> block)
+ * {
+ *     // block holds 32 periods of the flow meter pulses, in us
+ * }
+ *
+ * int main()
+ * {
+ *     InputCapture flow(D9);
+ *     flow.start(1000000, periods, callback(process), InputCapture::Rising,
+ *                InputCapture::Periods, &queue);
+ *     queue.dispatch_forever();
+ * }
+ * @endcode
+ */
+class InputCapture : private NonCopyable<InputCapture> {
+
+public:
+    /** Edges captured */
+    enum Edge {
+        Rising = INPUT_CAPTURE_RISING,
+        Falling = INPUT_CAPTURE_FALLING,
+        Both = INPUT_CAPTURE_BOTH
+    };
+
+    /** Content of the buffer */
+    enum Mode {
+        Timestamps, ///< The counter value at each edge
+        Periods     ///< The ticks since the previous edge, 0 for the first one
+    };
+
+    /** Create an InputCapture on the specified pin
+     *
+     * @param pin The pin, on a timer channel
+     */
+    InputCapture(PinName pin);
+
+    /** Stop capturing and release the timer
+     */
+    ~InputCapture();
+
+    /** Start capturing
+     *
+     * @param tick_hz The counter rate wished, 0 for the timer clock
+     * @param buffer  The buffer filled with captures, its size a multiple of 2
+     * @param func    The callback receiving each filled half of the buffer
+     * @param edge    The edges captured
+     * @param mode    The content of the buffer
+     * @param queue   The queue the callback is posted to, nullptr to call it
+     *                from interrupt context
+     * @return 0 on success, -1 on failure
+     */
+    int start(uint32_t tick_hz, Span<uint32_t> buffer, Callback<void(Span<const uint32_t>)> func,
+              Edge edge = Rising, Mode mode = Timestamps, events::EventQueue *queue = nullptr);
+
+    /** Stop capturing
+     *
+     * Callbacks already posted to the queue are still delivered.
+     */
+    void stop();
+
+    /** Get the counter rate
+     *
+     * @return The rate of the captures in Hz since start(), the closest to
+     *         the one asked that the timer allows
+     */
+    uint32_t tick_hz();
+
+    /** Get the value after which the counter wraps to 0
+     *
+     * Periods longer than that are reported modulo the counter range.
+     *
+     * @return 0xFFFF or 0xFFFFFFFF, depending on the timer width
+     */
+    uint32_t max_count();
+
+    /** Get the number of buffer halves delivered while the previous one was
+     *  still being processed or could not be posted
+     *
+     * @return The number of overruns since start()
+     */
+    uint32_t overruns() const
+    {
+        return _overruns;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void irq_handler(uint32_t id, uint32_t *captures, size_t count);
+    void process(Span<const uint32_t> captures);
+
+    input_capture_t _capture;
+    Callback<void(Span<const uint32_t>)> _func;
+    events::EventQueue *_queue = nullptr;
+    Mode _mode = Timestamps;
+    uint32_t _mask = 0;
+    uint32_t _last = 0;
+    bool _first = true;
+    volatile uint32_t _pending = 0;
+    volatile uint32_t _overruns = 0;
+    PlatformMutex _mutex;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
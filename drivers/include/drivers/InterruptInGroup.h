@@ -0,0 +1,175 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INTERRUPTIN_GROUP_H
+#define MBED_INTERRUPTIN_GROUP_H
+
+#include "platform/platform.h"
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+
+#include "hal/gpio_api.h"
+#include "hal/gpio_irq_api.h"
+#include "drivers/HighResClock.h"
+#include "drivers/Timeout.h"
+#include "platform/Callback.h"
+#include "platform/CircularBuffer.h"
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+#include "events/EventQueue.h"
+
+#include <chrono>
+
+#ifndef MBED_CONF_DRIVERS_INTERRUPTIN_GROUP_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_INTERRUPTIN_GROUP_BUFFER_SIZE  32
+#endif
+
+namespace mbed {
+/**
+ * \defgroup drivers_InterruptInGroup InterruptInGroup class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A set of digital interrupt inputs, whose edges are delivered in batches
+ *
+ * The interrupts only timestamp the edges of the pins, into a queue of
+ * MBED_CONF_DRIVERS_INTERRUPTIN_GROUP_BUFFER_SIZE edges, and the callback
+ * receives the edges queued from the thread dispatching an EventQueue, once
+ * per batch instead of once per edge.
+ *
+ * With debouncing, the interrupt of a pin is masked during the debounce time
+ * after each edge, so the bounces take no CPU time. The pin is then sampled
+ * again, and an edge is reported if its level had changed meanwhile, so the
+ * edges reported always alternate and end at the level of the pin.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * static const PinName keys[] = {D2, D3, D4, D5};
+ * static EventQueue queue;
+ *
+ * void keys_changed(Span<const InterruptInGroup::Edge> edges)
+ * {
+ *     for (const InterruptInGroup::Edge &edge : edges) {
+ *         printf("key %u %s\n", edge.pin, edge.rising ? "released" : "pressed");
+ *     }
+ * }
+ *
+ * int main()
+ * {
+ *     InterruptInGroup group(keys, 4, PullUp);
+ *     group.debounce(20ms);
+ *     group.attach(callback(keys_changed), &queue);
+ *     queue.dispatch_forever();
+ * }
+ * @endcode
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+class InterruptInGroup : private NonCopyable<InterruptInGroup> {
+
+public:
+    /** An edge of one of the pins */
+    struct Edge {
+        /** When the edge was taken by the interrupt or, after a debounce
+         *  time, sampled */
+        HighResClock::time_point time;
+        /** Index of the pin given to the constructor */
+        uint8_t pin;
+        /** true for a rising edge, false for a falling one */
+        bool rising;
+    };
+
+    /** Create an InterruptInGroup on the specified pins
+     *
+     *  @param pins  The pins to watch, up to 255
+     *  @param count The number of pins
+     *  @param mode  The pull mode of the pins
+     */
+    InterruptInGroup(const PinName *pins, size_t count, PinMode mode = PullDefault);
+
+    ~InterruptInGroup();
+
+    /** Set the time ignoring the bounces of a pin after each of its edges
+     *
+     *  @param time The debounce time, 0 to report all the edges
+     */
+    void debounce(std::chrono::microseconds time);
+
+    /** Start delivering the edges
+     *
+     *  @param func  The callback receiving the edges queued, in the order of
+     *               their timestamps, nullptr to stop watching the pins
+     *  @param queue The queue the callback is posted to
+     */
+    void attach(Callback<void(Span<const Edge>)> func, events::EventQueue *queue);
+
+    /** Read a pin
+     *
+     *  @param pin Index of the pin given to the constructor
+     *  @returns the level of the pin, 0 or 1
+     */
+    int read(size_t pin);
+
+    /** Get the number of edges lost because the queue was full
+     *
+     *  @returns the number of edges dropped since the group was created
+     */
+    uint32_t overruns() const
+    {
+        return _overruns;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    struct pin_state {
+        InterruptInGroup *group;
+        gpio_t gpio;
+        gpio_irq_t irq;
+        HighResClock::time_point until;
+        uint8_t index;
+        bool level;
+        bool masked;
+    };
+
+    static void irq_handler(uint32_t id, gpio_irq_event event);
+    void edge(pin_state *pin, bool rising);
+    void push(pin_state *pin, bool rising, HighResClock::time_point time);
+    void debounce_expired();
+    void process();
+
+    pin_state *_pins;
+    size_t _count;
+    CircularBuffer<Edge, MBED_CONF_DRIVERS_INTERRUPTIN_GROUP_BUFFER_SIZE> _edges;
+    Callback<void(Span<const Edge>)> _func;
+    events::EventQueue *_queue;
+    Timeout _timeout;
+    std::chrono::microseconds _debounce;
+    bool _timeout_armed;
+    bool _posted;
+    uint32_t _overruns;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -22,6 +22,15 @@
 #if DEVICE_PWMOUT || defined(DOXYGEN_ONLY)
 #include "hal/pwmout_api.h"
 
+#if DEVICE_CLOCK_SCALING
+#include "platform/mbed_clock_scaling.h"
+#endif
+
+#if DEVICE_PWMOUT_WAVEFORM
+#include "platform/Callback.h"
+#include "platform/Span.h"
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_PwmOut PwmOut class
@@ -155,6 +164,48 @@ public:
      */
     void resume();
 
+#if DEVICE_PWMOUT_WAVEFORM || defined(DOXYGEN_ONLY)
+    /** Set the period of each pulse of the waveforms
+     *
+     *  The period and duty cycle set by the other functions are applied
+     *  again by stop_waveform(). Other PwmOut on the same timer get the
+     *  same period.
+     *
+     *  @param ns The period in nanoseconds, for example 1250 for WS2812 LEDs
+     *  @returns
+     *    The pulse width of a duty cycle of 100%, in the unit of the pulses
+     *    of write_waveform(), 0 if the period is not supported
+     */
+    uint32_t waveform_period_ns(uint32_t ns);
+
+    /** Output a sequence of pulse widths, one per period, copied to the
+     *  timer by DMA with no CPU work per pulse
+     *
+     *  The output stays low for two periods, then outputs the pulses.
+     *  Without repeat, the last pulse is kept after the sequence, so a
+     *  sequence ending with 0 leaves the output low; func is called once
+     *  the last pulse is written to the timer. With repeat, the sequence
+     *  restarts from the first pulse, and func is called with each half of
+     *  it once it is written to the timer, so that it can be refilled
+     *  while the other half is output.
+     *
+     *  @param pulses The pulse widths, left in place until func is called.
+     *    Its size is a multiple of 2 with repeat
+     *  @param func   The callback, called in interrupt context (Optional)
+     *  @param repeat Restart from the first pulse after the last one
+     *  @returns
+     *    0 on success, -1 if the pin doesn't support waveforms or no DMA
+     *    channel is available
+     */
+    int write_waveform(Span<uint16_t> pulses, Callback<void(Span<uint16_t>)> func = nullptr, bool repeat = false);
+
+    /** Stop the waveform, and apply the period and duty cycle set by the
+     *  other functions again
+     */
+    void stop_waveform();
+
+#endif
+
     /** A operator shorthand for write()
      *  \sa PwmOut::write()
      */
@@ -198,6 +249,20 @@ protected:
     /** Power down this instance */
     void deinit();
 
+#if DEVICE_CLOCK_SCALING
+    /** Apply the period again after a clock change */
+    static void clock_changed(void *context, uint32_t frequency_hz);
+
+    mbed_clock_notifier_t _clock_notifier;
+#endif
+
+#if DEVICE_PWMOUT_WAVEFORM
+    static void waveform_irq(uint32_t id, uint16_t *pulses, size_t count);
+
+    Callback<void(Span<uint16_t>)> _waveform_cb;
+    bool _waveform;
+#endif
+
     pwmout_t _pwm;
     PinName _pin;
     bool _deep_sleep_locked;
@@ -25,6 +25,8 @@
 #include "platform/PlatformMutex.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
+#include "platform/Callback.h"
 
 #define ONE_MHZ     1000000
 
@@ -211,6 +213,97 @@ public:
      */
     qspi_status_t command_transfer(qspi_inst_t instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED || defined(DOXYGEN_ONLY)
+    /** Map the QSPI peripheral into the address space
+     *
+     *  The peripheral is then read by the CPU (or DMA) as plain memory, using the
+     *  given read instruction and the current format. Any other operation on
+     *  this bus switches the peripheral back to indirect mode, which
+     *  invalidates the region.
+     *
+     *  @param instruction Read instruction issued on each access
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param region On success, set to the mapped window, starting at peripheral address 0
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR on failure.
+     */
+    qspi_status_t memory_map(qspi_inst_t instruction, int alt, Span<const uint8_t> &region);
+
+    /** Switch the QSPI peripheral back to indirect mode
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR on failure.
+     */
+    qspi_status_t memory_unmap();
+#endif
+
+#if DEVICE_QSPI_ASYNCH || defined(DOXYGEN_ONLY)
+    /** Function called from interrupt context at the end of an asynchronous
+     *  operation, with QSPI_STATUS_OK if it completed
+     */
+    typedef Callback<void(qspi_status_t)> async_callback_t;
+
+    /** Read from QSPI peripheral using custom read instruction, the data moved by DMA
+     *
+     *  The function returns once the transfer started. Until callback is
+     *  called, the buffer must stay valid and other operations on this bus fail.
+     *
+     *  @param instruction Instruction value to be used in instruction phase. Use QSPI_NO_INST to skip the instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param rx_buffer Buffer for data to be read from the peripheral
+     *  @param rx_length Number of bytes to read
+     *  @param callback Function called at the end of the transfer
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS if the transfer started, callback is not called otherwise.
+     */
+    qspi_status_t read_async(qspi_inst_t instruction, int alt, int address, char *rx_buffer, size_t rx_length,
+                             const async_callback_t &callback);
+
+    /** Write to QSPI peripheral using custom write instruction, the data moved by DMA
+     *
+     *  The function returns once the transfer started. Until callback is
+     *  called, the buffer must stay valid and other operations on this bus fail.
+     *
+     *  @param instruction Instruction value to be used in instruction phase. Use QSPI_NO_INST to skip the instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param tx_buffer Buffer containing data to be sent to peripheral
+     *  @param tx_length Number of bytes to write
+     *  @param callback Function called at the end of the transfer
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS if the transfer started, callback is not called otherwise.
+     */
+    qspi_status_t write_async(qspi_inst_t instruction, int alt, int address, const char *tx_buffer, size_t tx_length,
+                              const async_callback_t &callback);
+
+    /** Read a status register repeatedly, in hardware, until it matches
+     *
+     *  Typically waits for the write-in-progress bit of a flash to clear
+     *  without involving the CPU. Other operations on this bus fail until
+     *  callback is called or abort_async() is.
+     *
+     *  @param instruction Status register read instruction
+     *  @param status_size Number of status bytes read, 1 to 4
+     *  @param mask Status bits compared
+     *  @param match Expected value of the compared bits
+     *  @param interval Bus clock cycles between two reads
+     *  @param callback Function called once (status & mask) == match
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS if polling started, callback is not called otherwise.
+     */
+    qspi_status_t poll_status_async(qspi_inst_t instruction, size_t status_size, uint32_t mask, uint32_t match,
+                                    uint32_t interval, const async_callback_t &callback);
+
+    /** Abort the asynchronous operation started by this object, its callback is not called
+     */
+    void abort_async();
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
@@ -240,6 +333,12 @@ protected:
     PinName _qspi_io0, _qspi_io1, _qspi_io2, _qspi_io3, _qspi_clk, _qspi_cs; //IO lines, clock and chip select
     const qspi_pinmap_t *_static_pinmap;
     bool (QSPI::* _init_func)(void);
+#if DEVICE_QSPI_ASYNCH
+    static void _async_irq(uint32_t id, qspi_status_t status);
+    // An asynchronous operation owns the bus, shared by all instances like _owner
+    static volatile bool _async_busy;
+    async_callback_t _async_callback;
+#endif
 
 private:
     /* Private acquire function without locking/unlocking
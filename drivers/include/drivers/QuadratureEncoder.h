@@ -0,0 +1,97 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_QUADRATURE_ENCODER_H
+#define MBED_QUADRATURE_ENCODER_H
+
+#include "platform/platform.h"
+
+#if DEVICE_INPUT_CAPTURE || defined(DOXYGEN_ONLY)
+
+#include "hal/input_capture_api.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_QuadratureEncoder QuadratureEncoder class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A quadrature encoder counted by a timer
+ *
+ * The timer counts the four edges of each cycle of the outputs A and B, up
+ * or down depending on their phase, with no CPU work per edge. The count is
+ * extended in software to 32 bits when the position is read, so a 16-bit
+ * timer must be read at least once per 32768 edges.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * int main()
+ * {
+ *     QuadratureEncoder wheel(D9, D10);
+ *
+ *     while (true) {
+ *         printf("position %ld\n", wheel.read());
+ *         ThisThread::sleep_for(100ms);
+ *     }
+ * }
+ * @endcode
+ */
+class QuadratureEncoder : private NonCopyable<QuadratureEncoder> {
+
+public:
+    /** Create a QuadratureEncoder on the specified pins, and start counting
+     *
+     * @param pin_a The output A, on the channel 1 of a timer
+     * @param pin_b The output B, on the channel 2 of the same timer
+     */
+    QuadratureEncoder(PinName pin_a, PinName pin_b);
+
+    /** Stop counting and release the timer
+     */
+    ~QuadratureEncoder();
+
+    /** Read the position
+     *
+     * @return The number of edges counted since the creation or the last
+     *         reset(), positive when A leads B
+     */
+    int32_t read();
+
+    /** Set the position to 0
+     */
+    void reset();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    input_capture_t _capture;
+    PlatformMutex _mutex;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
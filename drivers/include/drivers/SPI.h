@@ -27,6 +27,10 @@
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
 
+#if DEVICE_CLOCK_SCALING
+#include "platform/mbed_clock_scaling.h"
+#endif
+
 #if defined MBED_CONF_DRIVERS_SPI_COUNT_MAX && DEVICE_SPI_COUNT > MBED_CONF_DRIVERS_SPI_COUNT_MAX
 #define SPI_PERIPHERALS_USED MBED_CONF_DRIVERS_SPI_COUNT_MAX
 #elif defined DEVICE_SPI_COUNT
@@ -241,6 +245,7 @@ public:
     /** Start non-blocking SPI transfer using 8bit buffers.
      *
      * This function locks the deep sleep until any event has occurred.
+     * Between select() and deselect(), the chip select is left asserted.
      *
      * @param tx_buffer The TX buffer with data to be transferred. If NULL is passed,
      *                  the default SPI value is sent.
@@ -265,6 +270,25 @@ public:
         return 0;
     }
 
+    /** Start non-blocking SPI transfer of the same length in both directions.
+     *
+     * TX and RX lengths must match on some targets: a read transmits its own
+     * buffer, filled beforehand with the default SPI value.
+     *
+     * @param tx_buffer The TX buffer with data to be transferred. If NULL is passed,
+     *                  rx_buffer is filled with the default SPI value and sent.
+     * @param rx_buffer The RX buffer which is used for received data. If NULL is passed,
+     *                  received data are ignored.
+     * @param length    The length of the transfer in bytes.
+     * @param callback  The event callback function.
+     * @param event     The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the transfer has started.
+     * @retval -1 If SPI peripheral is busy.
+     */
+    int transfer_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, int length, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE);
+
     /** Abort the on-going SPI transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
@@ -443,6 +467,10 @@ protected:
     SPIName _peripheral_name;
     /* Pointer to spi init function */
     void (*_init_func)(SPI *);
+#if DEVICE_CLOCK_SCALING
+    /* Clock change notifier */
+    mbed_clock_notifier_t _clock_notifier;
+#endif
 
 private:
     void _do_construct();
@@ -462,6 +490,9 @@ private:
 
     static void _do_init(SPI *obj);
     static void _do_init_direct(SPI *obj);
+#if DEVICE_CLOCK_SCALING
+    static void _clock_changed(void *context, uint32_t frequency_hz);
+#endif
 
 
 #endif //!defined(DOXYGEN_ONLY)
@@ -24,6 +24,11 @@
 
 #include "hal/spi_api.h"
 
+#if DEVICE_SPISLAVE_DMA || defined(DOXYGEN_ONLY)
+#include "platform/Callback.h"
+#include "platform/Span.h"
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_SPISlave SPISlave class
@@ -80,6 +85,10 @@ public:
     SPISlave(const spi_pinmap_t &pinmap);
     SPISlave(const spi_pinmap_t &&) = delete; // prevent passing of temporary objects
 
+    /** Stop the DMA reception, if any
+     */
+    ~SPISlave();
+
     /** Configure the data transmission format.
      *
      *  @param bits Number of bits per SPI frame (4 - 16).
@@ -123,6 +132,76 @@ public:
      */
     void reply(int value);
 
+#if DEVICE_SPISLAVE_DMA || defined(DOXYGEN_ONLY)
+    /** Function called at the end of each transaction
+     *
+     * data holds the bytes received, in the buffer given to
+     * start_transactions(). When the transaction wrapped around the end of
+     * the buffer, wrapped holds the bytes stored back at its start,
+     * otherwise it is empty. Both are valid until the buffer comes around
+     * again, so either process them in the callback or keep the buffer large
+     * enough for the transactions that may arrive meanwhile.
+     */
+    typedef Callback<void(Span<const uint8_t> data, Span<const uint8_t> wrapped)> transaction_callback_t;
+
+    /** Receive whole transactions into a circular buffer through DMA
+     *
+     * The DMA writes every frame into the buffer with no CPU involvement,
+     * and the rising edge of the chip select, which ends a transaction,
+     * calls callback with the bytes received. receive(), read() and reply()
+     * must not be used until stop_transactions().
+     *
+     * Transactions longer than the buffer are dropped and counted by
+     * overruns(). The chip select must stay high for at least the latency of
+     * its interrupt between transactions: frames received before callback
+     * runs are reported with the previous transaction.
+     *
+     * @note The slave must have been created with a chip select pin, and
+     *       format() must not be called while transactions are received.
+     *
+     * @param buffer   Circular buffer, valid until stop_transactions()
+     * @param callback Function called from interrupt context at the end of each transaction
+     * @return 0 on success, -1 if the SPI, its chip select or its DMA channel cannot be used
+     *
+     * @code
+     * SPISlave device(SPI_MOSI, SPI_MISO, SPI_SCLK, SPI_CS);
+     * uint8_t rx[256];
+     *
+     * void on_transaction(Span<const uint8_t> data, Span<const uint8_t> wrapped)
+     * {
+     *     // data.size() + wrapped.size() bytes were received
+     * }
+     *
+     * device.start_transactions(rx, on_transaction);
+     * @endcode
+     */
+    int start_transactions(Span<uint8_t> buffer, transaction_callback_t callback);
+
+    /** Set the bytes sent to the master during the following transactions
+     *
+     * The reply is loaded again at the end of each transaction, so every
+     * transaction starts clocking it out from its first byte. Past its end,
+     * the content of MISO is undefined.
+     *
+     * @note Call it from the transaction callback, or while the chip select
+     *       is high, as it resets the transmit FIFO.
+     *
+     * @param reply Bytes to send, valid until replaced, empty to send none
+     * @return 0 on success, -1 if transactions are not started or MISO is not connected
+     */
+    int set_reply(Span<const uint8_t> reply);
+
+    /** Stop receiving transactions, the polled functions can be used again
+     */
+    void stop_transactions();
+
+    /** Number of transactions dropped because they were longer than the buffer
+     *
+     * @return Transactions dropped since start_transactions()
+     */
+    uint32_t overruns() const;
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 
 protected:
@@ -136,6 +215,22 @@ protected:
     /* Clock frequency */
     int _hz;
 
+#if DEVICE_SPISLAVE_DMA
+    static void _transaction_irq(uint32_t id);
+
+    /* Circular buffer written by the DMA */
+    Span<uint8_t> _rx_buffer;
+    /* Bytes sent in each transaction */
+    Span<const uint8_t> _reply;
+    transaction_callback_t _transaction_callback;
+    /* Last value of spi_slave_dma_count() */
+    uint32_t _rx_count = 0;
+    /* Offset of the next transaction in _rx_buffer */
+    size_t _rx_pos = 0;
+    uint32_t _overruns = 0;
+    bool _transactions_started = false;
+#endif
+
 #endif //!defined(DOXYGEN_ONLY)
 };
 
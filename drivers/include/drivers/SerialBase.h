@@ -31,6 +31,10 @@
 #include "hal/dma_api.h"
 #endif
 
+#if DEVICE_CLOCK_SCALING
+#include "platform/mbed_clock_scaling.h"
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_SerialBase SerialBase class
@@ -302,6 +306,12 @@ protected:
      */
     void _deinit();
 
+#if DEVICE_CLOCK_SCALING
+    /** Apply the baud rate again after a clock change
+     */
+    static void _clock_changed(void *context, uint32_t frequency_hz);
+#endif
+
 #if DEVICE_SERIAL_ASYNCH
     CThunk<SerialBase> _thunk_irq;
     DMAUsage _tx_usage = DMA_USAGE_NEVER;
@@ -322,6 +332,10 @@ protected:
     const serial_pinmap_t *_static_pinmap = NULL;
     void (SerialBase::*_set_flow_control_dp_func)(Flow, PinName, PinName) = NULL;
 
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_t _clock_notifier { &SerialBase::_clock_changed, this, nullptr };
+#endif
+
 #if DEVICE_SERIAL_FC
     Flow                           _flow_type = Disabled;
     PinName                        _flow1 = NC;
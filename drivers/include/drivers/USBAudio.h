@@ -350,6 +350,9 @@ private:
     uint8_t *_tx_packet_buf;
     uint8_t *_rx_packet_buf;
 
+    // Half of _rx_packet_buf being received
+    uint8_t _rx_packet_next;
+
     // Holding buffer
     ByteBuffer _tx_queue;
     ByteBuffer _rx_queue;
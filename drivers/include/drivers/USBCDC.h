@@ -25,6 +25,14 @@
 #include "USBDevice.h"
 #include "OperationList.h"
 
+#ifndef MBED_CONF_DRIVERS_USB_CDC_TX_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_USB_CDC_TX_BUFFER_SIZE 64
+#endif
+
+#ifndef MBED_CONF_DRIVERS_USB_CDC_RX_BUFFER_SIZE
+#define MBED_CONF_DRIVERS_USB_CDC_RX_BUFFER_SIZE 64
+#endif
+
 class AsyncOp;
 
 /**
@@ -217,15 +225,18 @@ protected:
     OperationList<AsyncWait> _connected_list;
     bool _terminal_connected;
 
+    // The bytes from _tx_buf to _tx_buffer + _tx_size are left to send
     OperationList<AsyncWrite> _tx_list;
     bool _tx_in_progress;
-    uint8_t _tx_buffer[64];
+    bool _tx_zlp;
+    uint8_t _tx_buffer[MBED_CONF_DRIVERS_USB_CDC_TX_BUFFER_SIZE];
     uint8_t *_tx_buf;
     uint32_t _tx_size;
 
+    // The _rx_size bytes from _rx_buf are received, the next packet follows them
     OperationList<AsyncRead> _rx_list;
     bool _rx_in_progress;
-    uint8_t _rx_buffer[64];
+    uint8_t _rx_buffer[MBED_CONF_DRIVERS_USB_CDC_RX_BUFFER_SIZE];
     uint8_t *_rx_buf;
     uint32_t _rx_size;
 };
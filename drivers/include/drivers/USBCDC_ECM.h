@@ -242,6 +242,60 @@ protected:
     */
     virtual void callback_reset();
 
+    /*
+    * Get the buffer the next bulk OUT packet is read into
+    *
+    * The default implementation returns an internal buffer, whose
+    * contents callback_rx_packet() copies to the receive queue. Derived
+    * classes return their own buffer of at least MAX_PACKET_SIZE_BULK bytes
+    * to receive packets in place, or NULL to hold reception, the host
+    * being NAKed, until restart_rx() is called.
+    *
+    * @returns buffer to read the next packet into, or NULL
+    *
+    * Warning: Called in ISR context
+    */
+    virtual uint8_t *rx_buffer();
+
+    /*
+    * Called when a packet has been read on the bulk OUT endpoint
+    *
+    * @param buffer buffer returned by rx_buffer()
+    * @param size number of bytes read
+    * @param end true if the packet ends the ethernet frame
+    *
+    * Warning: Called in ISR context
+    */
+    virtual void callback_rx_packet(uint8_t *buffer, uint32_t size, bool end);
+
+    /*
+    * Resume reception held by rx_buffer() returning NULL
+    */
+    void restart_rx();
+
+    /*
+    * Lock the bulk IN endpoint for a sequence of write_packet() calls
+    */
+    void write_lock();
+
+    /*
+    * Unlock the bulk IN endpoint
+    */
+    void write_unlock();
+
+    /*
+    * Send a single packet on the bulk IN endpoint
+    *
+    * A packet shorter than MAX_PACKET_SIZE_BULK, or of zero length, ends
+    * the ethernet frame. This function blocks until the packet has been
+    * sent and must be called between write_lock() and write_unlock().
+    *
+    * @param buffer packet to be sent
+    * @param size length of the packet, at most MAX_PACKET_SIZE_BULK
+    * @returns true if successful false if interrupted due to a state change
+    */
+    bool write_packet(const uint8_t *buffer, uint32_t size);
+
     uint8_t device_descriptor[18];
 
 private:
@@ -254,6 +308,8 @@ private:
     uint8_t _string_imac_addr[26];
 
     uint8_t _bulk_buf[MAX_PACKET_SIZE_BULK];
+    uint8_t *_rx_buf;
+    bool _rx_held;
     uint16_t _packet_filter;
     ByteBuffer _rx_queue;
 
@@ -269,6 +325,7 @@ private:
     void _int_callback();
     void _bulk_in_callback();
     void _bulk_out_callback();
+    void _rx_start();
     bool _notify_network_connection(uint8_t value);
     bool _notify_connection_speed_change(uint32_t up, uint32_t down);
     bool _write_bulk(uint8_t *buffer, uint32_t size);
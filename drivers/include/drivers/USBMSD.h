@@ -239,9 +239,14 @@ private:
     // memory OK (after a memoryVerify)
     bool _mem_ok;
 
-    // cache in RAM before writing in memory. Useful also to read a block.
+    // cache in RAM before writing in memory. Useful also to read blocks.
     uint8_t *_page;
 
+    // blocks _page holds, and the bytes of the disk it holds from _page_addr
+    uint32_t _page_blocks;
+    uint32_t _page_addr;
+    uint32_t _page_valid;
+
     int _block_size;
     uint64_t _memory_size;
     uint64_t _block_count;
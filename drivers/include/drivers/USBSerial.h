@@ -108,6 +108,27 @@ public:
     */
     virtual int _getc();
 
+    /**
+    * Write a buffer: blocking
+    *
+    * The data is sent in as few bulk transfers as the transmit buffer allows.
+    *
+    * @param buffer data to send
+    * @param size number of bytes to send
+    * @returns size, or -EIO if the terminal was disconnected
+    */
+    ssize_t write(const void *buffer, size_t size) override;
+
+    /**
+    * Read a buffer: blocking until at least one byte is received
+    *
+    * @param buffer buffer where the bytes are stored
+    * @param size maximum number of bytes to read
+    * @returns the number of bytes read, all the ones buffered up to size,
+    *          or -EIO if the terminal was disconnected
+    */
+    ssize_t read(void *buffer, size_t size) override;
+
     /**
     * Check the number of bytes available.
     *
@@ -36,6 +36,8 @@ namespace mbed {
 constexpr int SFDP_HEADER_SIZE = 8; ///< Size of an SFDP header in bytes, 2 DWORDS
 constexpr int SFDP_BASIC_PARAMS_TBL_SIZE = 80; ///< Basic Parameter Table size in bytes, 20 DWORDS
 constexpr int SFDP_SECTOR_MAP_MAX_REGIONS = 10; ///< Maximum number of regions with different erase granularity
+constexpr int SFDP_SECTOR_MAP_MAX_SIZE = 4 * (SFDP_SECTOR_MAP_MAX_REGIONS + 1); ///< Single map descriptor with its regions, in bytes
+constexpr int SFDP_CACHE_VERSION = 1; ///< Layout version of sfdp_cache
 
 // Erase Types Per Region BitMask
 constexpr int SFDP_ERASE_BITMASK_TYPE4 = 0x08; ///< Erase type 4 (erase granularity) identifier
@@ -53,6 +55,12 @@ struct sfdp_bptbl_info {
     size_t size; ///< Size
     bd_size_t device_size_bytes;
     int legacy_erase_instruction; ///< Legacy 4K erase instruction
+    int erase_suspend_inst; ///< Erase suspend instruction, -1 if suspend/resume isn't supported
+    int erase_resume_inst; ///< Erase resume instruction
+    int program_suspend_inst; ///< Program suspend instruction
+    int program_resume_inst; ///< Program resume instruction
+    int suspend_latency_us; ///< Maximum time for a program or an erase to be suspended
+    int resume_to_suspend_us; ///< Minimum time between a resume and the next suspend
 };
 
 /** JEDEC Sector Map Table info */
@@ -74,6 +82,21 @@ struct sfdp_hdr_info {
     sfdp_smptbl_info smptbl;
 };
 
+/** SFDP tables of a device, kept to skip their discovery on the next initialization
+ *
+ * The structure holds no pointer, so it can be stored as is, for example in a KVStore.
+ */
+struct sfdp_cache {
+    uint8_t version; ///< SFDP_CACHE_VERSION when the tables are valid, 0 otherwise
+    uint8_t jedec_id[3]; ///< Manufacturer ID and device ID of the device the tables were read from
+    uint32_t bptbl_addr; ///< Basic Parameter Table address
+    uint32_t bptbl_size; ///< Basic Parameter Table size
+    uint32_t smptbl_addr; ///< Sector Map Table address, 0 if the device has none
+    uint32_t smptbl_size; ///< Sector Map Table size
+    uint8_t bptbl[SFDP_BASIC_PARAMS_TBL_SIZE]; ///< Basic Parameter Table content
+    uint8_t smptbl[SFDP_SECTOR_MAP_MAX_SIZE]; ///< Sector Map Table content
+};
+
 /** Parse SFDP Database
  * Retrieves all headers from within a memory device and parses the information contained by the headers
  *
@@ -96,6 +119,43 @@ int sfdp_parse_headers(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
  */
 int sfdp_parse_sector_map_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
 
+/** Store the SFDP tables of a device in a cache
+ *
+ * The tables found by sfdp_parse_headers are read again through sfdp_reader.
+ *
+ * @param      sfdp_reader Callback function used to read the tables from within a device
+ * @param      sfdp_info   Results of sfdp_parse_headers
+ * @param      jedec_id    Manufacturer ID and device ID of the device, 3 bytes
+ * @param[out] cache       Filled with the tables, its version is 0 on failure
+ *
+ * @return MBED_SUCCESS on success, negative error code on failure
+ */
+int sfdp_cache_tables(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, const sfdp_hdr_info &sfdp_info,
+                      const uint8_t *jedec_id, sfdp_cache &cache);
+
+/** Check that a cache holds the SFDP tables of a device, and set the table locations from it
+ *
+ * @param      cache     Cache filled by sfdp_cache_tables
+ * @param      jedec_id  Manufacturer ID and device ID of the device, 3 bytes
+ * @param[out] sfdp_info Table addresses and sizes, as sfdp_parse_headers sets them
+ *
+ * @return MBED_SUCCESS if the cache can be used, negative error code otherwise
+ */
+int sfdp_cache_lookup(const sfdp_cache &cache, const uint8_t *jedec_id, sfdp_hdr_info &sfdp_info);
+
+/** Read the SFDP data of a device from a cache
+ *
+ * Can be bound as the sfdp_reader of the table parsing functions.
+ *
+ * @param      cache     Cache filled by sfdp_cache_tables
+ * @param      addr      Address of the table in the SFDP database
+ * @param[out] rx_buffer Buffer for the data
+ * @param      rx_length Size of the data, up to the size of the table
+ *
+ * @return MBED_SUCCESS on success, negative error code if the data isn't in the cache
+ */
+int sfdp_cache_read(const sfdp_cache *cache, bd_addr_t addr, void *rx_buffer, bd_size_t rx_length);
+
 /** Detect page size used for writing on flash
  *
  * @param bptbl_ptr  Pointer to memory holding a Basic Parameter Table structure
@@ -159,6 +219,18 @@ int sfdp_detect_device_density(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
  */
 int sfdp_detect_addressability(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
 
+/** Detect the suspend and resume instructions of program and erase
+ *
+ * The instructions are set to -1 if the device doesn't support suspend/resume
+ * or if the Basic Parameter Table predates it (JESD216A).
+ *
+ * @param bptbl_ptr Pointer to memory holding a Basic Parameter Table structure
+ * @param bptbl_info Basic Parameter Table information structure
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int sfdp_detect_suspend_resume(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
+
 /** @}*/
 } /* namespace mbed */
 #endif
@@ -0,0 +1,86 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/AnalogInPipeline.h"
+
+#if DEVICE_ANALOGIN_STREAM
+
+namespace mbed {
+
+AnalogInPipeline::AnalogInPipeline(PinName pin) :
+    _pin(pin),
+    _stream(&_pin, 1)
+{
+}
+
+AnalogInPipeline::~AnalogInPipeline()
+{
+    stop();
+}
+
+int AnalogInPipeline::add_stage(Stage &stage)
+{
+    _mutex.lock();
+    if (_running || _stage_count == MBED_CONF_DRIVERS_ANALOGIN_PIPELINE_STAGES) {
+        _mutex.unlock();
+        return -1;
+    }
+    _stages[_stage_count++] = &stage;
+    _mutex.unlock();
+    return 0;
+}
+
+int AnalogInPipeline::start(uint32_t rate, Span<uint16_t> buffer, Callback<void(Span<const int16_t>)> func,
+                            events::EventQueue *queue)
+{
+    _mutex.lock();
+    _stream.stop();
+    _func = func;
+    _bits = _stream.sample_bits();
+    int ret = _stream.start(rate, buffer, callback(this, &AnalogInPipeline::process), queue);
+    _running = (ret == 0);
+    _mutex.unlock();
+    return ret;
+}
+
+void AnalogInPipeline::stop()
+{
+    _mutex.lock();
+    _stream.stop();
+    _running = false;
+    _mutex.unlock();
+}
+
+void AnalogInPipeline::process(Span<const uint16_t> samples)
+{
+    // The half belongs to the buffer given to start(), and is not written by
+    // the DMA until the other half is full: it's processed in place
+    int16_t *block = reinterpret_cast<int16_t *>(const_cast<uint16_t *>(samples.data()));
+    size_t count = samples.size();
+
+    mbed_dsp_adc_to_q15(samples.data(), block, count, _bits);
+    for (size_t i = 0; i < _stage_count && count > 0; i++) {
+        count = _stages[i]->process(block, count);
+    }
+
+    if (count > 0) {
+        _func(Span<const int16_t>(block, count));
+    }
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,112 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/AnalogInStream.h"
+
+#if DEVICE_ANALOGIN_STREAM
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_error.h"
+
+namespace mbed {
+
+AnalogInStream::AnalogInStream(const PinName *pins, size_t count)
+{
+    _mutex.lock();
+    if (analogin_stream_init(&_stream, pins, count) != 0) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_ANALOG, MBED_ERROR_CODE_INVALID_ARGUMENT),
+                   "AnalogInStream pins cannot be sampled together");
+    }
+    _mutex.unlock();
+}
+
+AnalogInStream::~AnalogInStream()
+{
+    _mutex.lock();
+    analogin_stream_free(&_stream);
+    _mutex.unlock();
+}
+
+int AnalogInStream::set_oversampling(uint8_t ratio_log2, uint8_t shift)
+{
+    _mutex.lock();
+    int ret = analogin_stream_set_oversampling(&_stream, ratio_log2, shift);
+    _mutex.unlock();
+    return ret;
+}
+
+uint8_t AnalogInStream::sample_bits()
+{
+    _mutex.lock();
+    uint8_t bits = analogin_stream_sample_bits(&_stream);
+    _mutex.unlock();
+    return bits;
+}
+
+int AnalogInStream::start(uint32_t rate, Span<uint16_t> buffer, Callback<void(Span<const uint16_t>)> func,
+                          events::EventQueue *queue)
+{
+    _mutex.lock();
+    analogin_stream_stop(&_stream);
+    _func = func;
+    _queue = queue;
+    _pending = 0;
+    _overruns = 0;
+    int ret = analogin_stream_start(&_stream, rate, buffer.data(), buffer.size(),
+                                    &AnalogInStream::irq_handler, (uint32_t)this);
+    _mutex.unlock();
+    return ret;
+}
+
+void AnalogInStream::stop()
+{
+    _mutex.lock();
+    analogin_stream_stop(&_stream);
+    _mutex.unlock();
+}
+
+void AnalogInStream::irq_handler(uint32_t id, uint16_t *samples, size_t count)
+{
+    AnalogInStream *handler = (AnalogInStream *)id;
+    Span<const uint16_t> block(samples, count);
+
+    // The other half is due: the previous one now gets overwritten
+    if (handler->_pending != 0) {
+        handler->_overruns++;
+    }
+
+    if (handler->_queue == nullptr) {
+        handler->_func(block);
+        return;
+    }
+
+    core_util_atomic_incr_u32(&handler->_pending, 1);
+    if (handler->_queue->call(handler, &AnalogInStream::process, block) == 0) {
+        core_util_atomic_decr_u32(&handler->_pending, 1);
+        handler->_overruns++;
+    }
+}
+
+void AnalogInStream::process(Span<const uint16_t> samples)
+{
+    _func(samples);
+    core_util_atomic_decr_u32(&_pending, 1);
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,197 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/BufferedCAN.h"
+
+#if DEVICE_CAN
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_thread.h"
+
+namespace mbed {
+
+BufferedCAN::BufferedCAN(PinName rd, PinName td, int hz) : CAN(rd, td, hz), _tx_count(0), _overruns(0)
+{
+    CAN::attach(callback(this, &BufferedCAN::rx_irq), RxIrq);
+    CAN::attach(callback(this, &BufferedCAN::tx_irq), TxIrq);
+}
+
+BufferedCAN::BufferedCAN(const can_pinmap_t &pinmap, int hz) : CAN(pinmap, hz), _tx_count(0), _overruns(0)
+{
+    CAN::attach(callback(this, &BufferedCAN::rx_irq), RxIrq);
+    CAN::attach(callback(this, &BufferedCAN::tx_irq), TxIrq);
+}
+
+BufferedCAN::~BufferedCAN()
+{
+    CAN::attach(nullptr, RxIrq);
+    CAN::attach(nullptr, TxIrq);
+}
+
+/*  Arbitration order: lower identifiers first, then standard frames before
+ *  extended frames of the same base identifier, then data before remote frames */
+static uint32_t tx_priority(const CANMessage &msg)
+{
+    uint32_t id = (msg.format == CANStandard) ? (msg.id & 0x7FF) << 18 : (msg.id & 0x1FFFFFFF);
+    return (id << 2) | ((msg.format == CANStandard) ? 0 : 2) | ((msg.type == CANRemote) ? 1 : 0);
+}
+
+void BufferedCAN::tx_insert(const CANMessage &msg)
+{
+    uint32_t priority = tx_priority(msg);
+    uint32_t i = _tx_count;
+
+    // Frames of the same priority are sent in the order they were written
+    while (i > 0 && tx_priority(_tx[i - 1]) <= priority) {
+        _tx[i] = _tx[i - 1];
+        i--;
+    }
+    _tx[i] = msg;
+    _tx_count++;
+}
+
+void BufferedCAN::tx_fill()
+{
+    while (_tx_count && can_write(&_can, _tx[_tx_count - 1], 0)) {
+        _tx_count--;
+    }
+}
+
+void BufferedCAN::tx_irq()
+{
+    core_util_critical_section_enter();
+    tx_fill();
+    bool empty = _tx_count == 0;
+    core_util_critical_section_exit();
+
+    if (empty && _tx_cb) {
+        _tx_cb();
+    }
+}
+
+void BufferedCAN::rx_irq()
+{
+    rx_frame frame;
+    bool received = false;
+
+    // Drain the hardware FIFO, so the callback runs once per batch
+    while (can_read(&_can, &frame.msg, 0)) {
+        frame.timestamp = HighResClock::now();
+        received = true;
+        if (!_rx.push(frame)) {
+            core_util_atomic_incr_u32(&_overruns, 1);
+        }
+    }
+
+    if (received && _rx_cb) {
+        _rx_cb();
+    }
+}
+
+int BufferedCAN::write(CANMessage msg)
+{
+    int ret = 0;
+
+    core_util_critical_section_enter();
+    if (_tx_count < MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE) {
+        tx_insert(msg);
+        tx_fill();
+        ret = 1;
+    }
+    core_util_critical_section_exit();
+    return ret;
+}
+
+int BufferedCAN::write(CANMessage msg, std::chrono::milliseconds timeout)
+{
+    HighResClock::time_point deadline = HighResClock::now() + timeout;
+
+    while (!write(msg)) {
+        if (HighResClock::now() >= deadline) {
+            return 0;
+        }
+        thread_sleep_for(1);
+    }
+    return 1;
+}
+
+size_t BufferedCAN::writable() const
+{
+    return MBED_CONF_DRIVERS_CAN_TX_BUFFER_SIZE - core_util_atomic_load_u32(&_tx_count);
+}
+
+int BufferedCAN::read(CANMessage &msg, int handle)
+{
+    HighResClock::time_point timestamp;
+    (void)handle;
+    return read(msg, timestamp);
+}
+
+int BufferedCAN::read(CANMessage &msg, HighResClock::time_point &timestamp)
+{
+    rx_frame frame;
+    if (!_rx.pop(frame)) {
+        return 0;
+    }
+    msg = frame.msg;
+    timestamp = frame.timestamp;
+    return 1;
+}
+
+size_t BufferedCAN::read_many(CANMessage *msgs, size_t count, HighResClock::time_point *timestamps)
+{
+    size_t read = 0;
+    rx_frame frame;
+
+    while (read < count && _rx.pop(frame)) {
+        msgs[read] = frame.msg;
+        if (timestamps) {
+            timestamps[read] = frame.timestamp;
+        }
+        read++;
+    }
+    return read;
+}
+
+size_t BufferedCAN::readable() const
+{
+    return _rx.size();
+}
+
+uint32_t BufferedCAN::overruns() const
+{
+    return core_util_atomic_load_u32(&_overruns);
+}
+
+void BufferedCAN::attach(Callback<void()> func, IrqType type)
+{
+    if (type != RxIrq && type != TxIrq) {
+        CAN::attach(func, type);
+        return;
+    }
+    core_util_critical_section_enter();
+    if (type == RxIrq) {
+        _rx_cb = func;
+    } else {
+        _tx_cb = func;
+    }
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed
+
+#endif // DEVICE_CAN
@@ -18,6 +18,8 @@
 
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN)
 
+#include <string.h>
+#include <algorithm>
 #include "platform/mbed_poll.h"
 #include "platform/mbed_thread.h"
 
@@ -26,17 +28,36 @@ namespace mbed {
 BufferedSerial::BufferedSerial(PinName tx, PinName rx, int baud):
     SerialBase(tx, rx, baud)
 {
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    rx_dma_start();
+#endif
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    tx_dma_start();
+#endif
     enable_rx_irq();
 }
 
 BufferedSerial::BufferedSerial(const serial_pinmap_t &static_pinmap, int baud):
     SerialBase(static_pinmap, baud)
 {
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    rx_dma_start();
+#endif
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    tx_dma_start();
+#endif
     enable_rx_irq();
 }
 
 BufferedSerial::~BufferedSerial()
 {
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    // The DMA must not outlive _rx_dma_buf
+    serial_rx_dma_stop(&_serial);
+#endif
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    serial_tx_dma_disable(&_serial);
+#endif
     delete _dcd_irq;
 }
 
@@ -47,7 +68,14 @@ void BufferedSerial::dcd_irq()
 
 void BufferedSerial::set_baud(int baud)
 {
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    // The UART is reinitialized, restart the DMA reception around it
+    rx_dma_stop();
+    SerialBase::baud(baud);
+    rx_dma_start();
+#else
     SerialBase::baud(baud);
+#endif
 }
 
 void BufferedSerial::set_data_carrier_detect(PinName dcd_pin, bool active_high)
@@ -68,7 +96,13 @@ void BufferedSerial::set_data_carrier_detect(PinName dcd_pin, bool active_high)
 void BufferedSerial::set_format(int bits, Parity parity, int stop_bits)
 {
     api_lock();
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    rx_dma_stop();
     SerialBase::format(bits, parity, stop_bits);
+    rx_dma_start();
+#else
+    SerialBase::format(bits, parity, stop_bits);
+#endif
     api_unlock();
 }
 
@@ -76,7 +110,13 @@ void BufferedSerial::set_format(int bits, Parity parity, int stop_bits)
 void BufferedSerial::set_flow_control(Flow type, PinName flow1, PinName flow2)
 {
     api_lock();
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    rx_dma_stop();
     SerialBase::set_flow_control(type, flow1, flow2);
+    rx_dma_start();
+#else
+    SerialBase::set_flow_control(type, flow1, flow2);
+#endif
     api_unlock();
 }
 #endif
@@ -179,9 +219,14 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
             } while (_txbuf.full());
         }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
+        // Copy straight into the free space, which wraps at most once
+        for (int i = 0; i < 2 && data_written < length; i++) {
+            Span<char> space = _txbuf.reserve_contiguous();
+            size_t data_len = std::min<size_t>(length - data_written, space.size());
+            memcpy(space.data(), buf_ptr, data_len);
+            _txbuf.commit(data_len);
+            buf_ptr += data_len;
+            data_written += data_len;
         }
 
         core_util_critical_section_enter();
@@ -223,10 +268,7 @@ ssize_t BufferedSerial::read(void *buffer, size_t length)
         api_lock();
     }
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
-    }
+    data_read = _rxbuf.pop(Span<char>(ptr, length));
 
     core_util_critical_section_enter();
     if (_rx_enabled && !_rx_irq_enabled) {
@@ -250,11 +292,17 @@ bool BufferedSerial::hup() const
 
 void BufferedSerial::wake()
 {
+    poll_notify(this);
     if (_sigio_cb) {
         _sigio_cb();
     }
 }
 
+bool BufferedSerial::poll_notifies() const
+{
+    return true;
+}
+
 short BufferedSerial::poll(short events) const
 {
 
@@ -290,11 +338,33 @@ void BufferedSerial::rx_irq(void)
 {
     bool was_empty = _rxbuf.empty();
 
-    // Fill in the receive buffer if the peripheral is readable
-    // and receive buffer is not full.
-    while (!_rxbuf.full() && SerialBase::readable()) {
-        char data = SerialBase::_base_getc();
-        _rxbuf.push(data);
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    if (_rx_dma_active) {
+        // Move the span written by the DMA since the last call
+        size_t head = serial_rx_dma_position(&_serial);
+        while (_rx_dma_tail != head) {
+            Span<char> space = _rxbuf.reserve_contiguous();
+            size_t data_len = (head > _rx_dma_tail ? head : sizeof(_rx_dma_buf)) - _rx_dma_tail;
+            data_len = std::min<size_t>(data_len, space.size());
+            if (data_len == 0) {
+                break;
+            }
+            memcpy(space.data(), &_rx_dma_buf[_rx_dma_tail], data_len);
+            _rxbuf.commit(data_len);
+            _rx_dma_tail += data_len;
+            if (_rx_dma_tail == sizeof(_rx_dma_buf)) {
+                _rx_dma_tail = 0;
+            }
+        }
+    } else
+#endif
+    {
+        // Fill in the receive buffer if the peripheral is readable
+        // and receive buffer is not full.
+        while (!_rxbuf.full() && SerialBase::readable()) {
+            char data = SerialBase::_base_getc();
+            _rxbuf.push(data);
+        }
     }
 
     if (_rx_irq_enabled && _rxbuf.full()) {
@@ -311,12 +381,33 @@ void BufferedSerial::rx_irq(void)
 void BufferedSerial::tx_irq(void)
 {
     bool was_full = _txbuf.full();
-    char data;
 
-    // Write to the peripheral if there is something to write
-    // and if the peripheral is available to write.
-    while (SerialBase::writeable() && _txbuf.pop(data)) {
-        SerialBase::_base_putc(data);
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    if (_tx_dma_active) {
+        if (_tx_dma_len != 0) {
+            if (serial_tx_dma_active(&_serial)) {
+                // Called from write() while a span is still being sent
+                return;
+            }
+            _txbuf.consume(_tx_dma_len);
+            _tx_dma_len = 0;
+        }
+
+        // The DMA reads _txbuf in place, a wrapped buffer takes two transfers
+        Span<const char> span = _txbuf.peek_contiguous();
+        if (!span.empty() && serial_tx_dma_write(&_serial, span.data(), span.size()) == 0) {
+            _tx_dma_len = span.size();
+        }
+    } else
+#endif
+    {
+        char data;
+
+        // Write to the peripheral if there is something to write
+        // and if the peripheral is available to write.
+        while (SerialBase::writeable() && _txbuf.pop(data)) {
+            SerialBase::_base_putc(data);
+        }
     }
 
     if (_tx_irq_enabled && _txbuf.empty()) {
@@ -356,10 +447,88 @@ void BufferedSerial::disable_tx_irq()
     _tx_irq_enabled = false;
 }
 
+#if MBED_BUFFERED_SERIAL_RX_DMA
+void BufferedSerial::rx_dma_start()
+{
+    if (_rx_dma_active || !SerialBase::_rx_enabled) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    _rx_dma_tail = 0;
+    _rx_dma_active = (serial_rx_dma_start(&_serial, _rx_dma_buf, sizeof(_rx_dma_buf)) == 0);
+    core_util_critical_section_exit();
+}
+
+void BufferedSerial::rx_dma_stop()
+{
+    if (!_rx_dma_active) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    bool was_empty = _rxbuf.empty();
+    rx_irq();
+    serial_rx_dma_stop(&_serial);
+    _rx_dma_active = false;
+    core_util_critical_section_exit();
+
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+#endif
+
+#if MBED_BUFFERED_SERIAL_TX_DMA
+void BufferedSerial::tx_dma_start()
+{
+    if (_tx_dma_active || !SerialBase::_tx_enabled) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    _tx_dma_len = 0;
+    _tx_dma_active = (serial_tx_dma_enable(&_serial) == 0);
+    core_util_critical_section_exit();
+}
+
+void BufferedSerial::tx_dma_stop()
+{
+    if (!_tx_dma_active) {
+        return;
+    }
+
+    // Completion may start the next span, so poll until the DMA is idle
+    // with interrupts masked
+    core_util_critical_section_enter();
+    while (serial_tx_dma_active(&_serial)) {
+        core_util_critical_section_exit();
+        core_util_critical_section_enter();
+    }
+    if (_tx_dma_len != 0) {
+        _txbuf.consume(_tx_dma_len);
+        _tx_dma_len = 0;
+    }
+    serial_tx_dma_disable(&_serial);
+    _tx_dma_active = false;
+    core_util_critical_section_exit();
+}
+#endif
+
 int BufferedSerial::enable_input(bool enabled)
 {
     api_lock();
+#if MBED_BUFFERED_SERIAL_RX_DMA
+    if (!enabled) {
+        rx_dma_stop();
+    }
     SerialBase::enable_input(enabled);
+    if (enabled) {
+        rx_dma_start();
+    }
+#else
+    SerialBase::enable_input(enabled);
+#endif
     api_unlock();
 
     return 0;
@@ -368,7 +537,17 @@ int BufferedSerial::enable_input(bool enabled)
 int BufferedSerial::enable_output(bool enabled)
 {
     api_lock();
+#if MBED_BUFFERED_SERIAL_TX_DMA
+    if (!enabled) {
+        tx_dma_stop();
+    }
+    SerialBase::enable_output(enabled);
+    if (enabled) {
+        tx_dma_start();
+    }
+#else
     SerialBase::enable_output(enabled);
+#endif
     api_unlock();
 
     return 0;
@@ -132,6 +132,30 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
     return ret;
 }
 
+int CAN::filter_list(const unsigned int *ids, int count, CANFormat format, int handle)
+{
+    lock();
+    int ret = can_filter_list(&_can, ids, count, format, handle);
+    unlock();
+    return ret;
+}
+
+int CAN::filter_disable(int handle)
+{
+    lock();
+    int ret = can_filter_disable(&_can, handle);
+    unlock();
+    return ret;
+}
+
+int CAN::filter_count()
+{
+    lock();
+    int ret = can_filter_count(&_can);
+    unlock();
+    return ret;
+}
+
 void CAN::attach(Callback<void()> func, IrqType type)
 {
     lock();
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include "FlashIAP.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/ScopedRomWriteLock.h"
 
@@ -39,6 +40,17 @@ const unsigned int num_write_retries = 16;
 
 SingletonPtr<PlatformMutex> FlashIAP::_mutex;
 
+#if DEVICE_FLASH_ASYNCH
+Callback<void(int)> FlashIAP::_async_callback;
+const uint8_t *FlashIAP::_async_buf;
+uint32_t FlashIAP::_async_addr;
+uint32_t FlashIAP::_async_size;
+volatile bool FlashIAP::_async_busy;
+#if TRANSACTION_QUEUE_SIZE_FLASH
+SingletonPtr<CircularBuffer<FlashIAP::async_request, TRANSACTION_QUEUE_SIZE_FLASH> > FlashIAP::_async_queue;
+#endif
+#endif
+
 static inline bool is_aligned(uint32_t number, uint32_t alignment)
 {
     if ((number % alignment) != 0) {
@@ -213,6 +225,160 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
     return ret;
 }
 
+#if DEVICE_FLASH_ASYNCH
+int FlashIAP::program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+
+    // There is no page buffer to complete a partial page: the user buffer is programmed as is
+    if (!is_aligned(addr, page_size) || !is_aligned(size, page_size) || !size || (!buffer) ||
+            ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    return async_submit((const uint8_t *) buffer, addr, size, callback);
+}
+
+int FlashIAP::erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+    uint32_t erase_end_addr = addr + size;
+
+    if (!size || (erase_end_addr > flash_end_addr) || !is_aligned_to_sector(addr, size)) {
+        return -1;
+    } else if (erase_end_addr < flash_end_addr) {
+        uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
+        if (!is_aligned(erase_end_addr, following_sector_size)) {
+            return -1;
+        }
+    }
+
+    return async_submit(nullptr, addr, size, callback);
+}
+
+bool FlashIAP::async_busy() const
+{
+    return _async_busy;
+}
+
+int FlashIAP::async_submit(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    int ret = 0;
+    _mutex->lock();
+#if TRANSACTION_QUEUE_SIZE_FLASH
+    // Constructed here, async_dequeue runs from interrupt context
+    CircularBuffer<async_request, TRANSACTION_QUEUE_SIZE_FLASH> *queue = _async_queue.get();
+#endif
+    core_util_critical_section_enter();
+    bool idle = !_async_busy;
+    if (idle) {
+        _async_busy = true;
+    } else {
+#if TRANSACTION_QUEUE_SIZE_FLASH
+        if (queue->full()) {
+            ret = -1; // the queue is full
+        } else {
+            async_request request = { this, callback, buf, addr, size };
+            queue->push(request);
+        }
+#else
+        ret = -1; // operation ongoing
+#endif
+    }
+    core_util_critical_section_exit();
+
+    if (idle) {
+        ret = async_start(buf, addr, size, callback);
+        if (ret) {
+            // requests are only queued while an operation is ongoing
+            _async_busy = false;
+        }
+    }
+    _mutex->unlock();
+
+    return ret;
+}
+
+int FlashIAP::async_start(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    _async_callback = callback;
+    _async_buf = buf;
+    _async_addr = addr;
+    _async_size = size;
+    // Released by async_handler once the whole operation completes
+    mbed_mpu_manager_lock_rom_write();
+    int ret = async_next();
+    if (ret) {
+        mbed_mpu_manager_unlock_rom_write();
+    }
+
+    return ret;
+}
+
+int FlashIAP::async_next()
+{
+    uint32_t addr = _async_addr;
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
+    int32_t ret;
+
+    // The state is advanced first as the operation may complete before the HAL call returns
+    if (_async_buf == nullptr) {
+        _async_addr += current_sector_size;
+        _async_size -= current_sector_size;
+        ret = flash_erase_sector_async(&_flash, addr, &FlashIAP::async_handler, (uint32_t) this);
+    } else {
+        const uint8_t *buf = _async_buf;
+        uint32_t chunk = std::min(current_sector_size - (addr % current_sector_size), _async_size);
+        _async_addr += chunk;
+        _async_buf += chunk;
+        _async_size -= chunk;
+        ret = flash_program_page_async(&_flash, addr, buf, chunk, &FlashIAP::async_handler, (uint32_t) this);
+    }
+
+    return ret ? -1 : 0;
+}
+
+void FlashIAP::async_handler(uint32_t id, int32_t status)
+{
+    FlashIAP *flash = (FlashIAP *) id;
+
+    if ((status == 0) && (_async_size != 0)) {
+        if (flash->async_next() == 0) {
+            return;
+        }
+        status = -1;
+    }
+
+    mbed_mpu_manager_unlock_rom_write();
+    // The next request may start before this callback is called
+    Callback<void(int)> callback = _async_callback;
+    async_dequeue();
+    if (callback) {
+        callback(status ? -1 : 0);
+    }
+}
+
+void FlashIAP::async_dequeue()
+{
+#if TRANSACTION_QUEUE_SIZE_FLASH
+    async_request request;
+    while (_async_queue->pop(request)) {
+        if (request.flash->async_start(request.buf, request.addr, request.size, request.callback) == 0) {
+            return;
+        }
+        if (request.callback) {
+            request.callback(-1);
+        }
+    }
+#endif
+    _async_busy = false;
+}
+#endif
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
@@ -22,6 +22,7 @@
 #if DEVICE_I2C
 
 #if DEVICE_I2C_ASYNCH
+#include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 #endif
 
@@ -30,6 +31,13 @@ namespace mbed {
 I2C *I2C::_owner = NULL;
 SingletonPtr<PlatformMutex> I2C::_mutex;
 
+#if DEVICE_I2C_ASYNCH
+I2C *volatile I2C::_transfer_owner = NULL;
+#if TRANSACTION_QUEUE_SIZE_I2C
+SingletonPtr<CircularBuffer<I2C::transfer_s, TRANSACTION_QUEUE_SIZE_I2C> > I2C::_transaction_buffer;
+#endif
+#endif
+
 I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
     _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
@@ -45,6 +53,11 @@ I2C::I2C(PinName sda, PinName scl) :
     // Used to avoid unnecessary frequency updates
     _owner = this;
     unlock();
+#if DEVICE_CLOCK_SCALING
+    _clock_notifier.handler = &I2C::clock_changed;
+    _clock_notifier.context = this;
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 I2C::I2C(const i2c_pinmap_t &static_pinmap) :
@@ -62,6 +75,11 @@ I2C::I2C(const i2c_pinmap_t &static_pinmap) :
     // Used to avoid unnecessary frequency updates
     _owner = this;
     unlock();
+#if DEVICE_CLOCK_SCALING
+    _clock_notifier.handler = &I2C::clock_changed;
+    _clock_notifier.context = this;
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 void I2C::frequency(int hz)
@@ -87,6 +105,16 @@ void I2C::aquire()
     unlock();
 }
 
+#if DEVICE_CLOCK_SCALING
+void I2C::clock_changed(void *context, uint32_t frequency_hz)
+{
+    // Interrupts are disabled, the next aquire applies the frequency again
+    if (_owner == (I2C *)context) {
+        _owner = NULL;
+    }
+}
+#endif
+
 // write - Master Transmitter Mode
 int I2C::write(int address, const char *data, int length, bool repeated)
 {
@@ -209,17 +237,20 @@ int I2C::recover(PinName sda, PinName scl)
 int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
 {
     lock();
-    if (i2c_active(&_i2c)) {
+    core_util_critical_section_enter();
+    bool idle = (_transfer_owner == NULL);
+    if (idle) {
+        _transfer_owner = this;
+    }
+    core_util_critical_section_exit();
+
+    if (!idle) {
+        int ret = queue_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
         unlock();
-        return -1; // transaction ongoing
+        return ret;
     }
-    lock_deep_sleep();
-    aquire();
 
-    _callback = callback;
-    int stop = (repeated) ? 0 : 1;
-    _irq.callback(&I2C::irq_handler_asynch);
-    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
+    start_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
     unlock();
     return 0;
 }
@@ -229,9 +260,118 @@ void I2C::abort_transfer(void)
     lock();
     i2c_abort_asynch(&_i2c);
     unlock_deep_sleep();
+    // the HAL may complete the abort from the interrupt, which then releases the bus
+    finish_transfer();
     unlock();
 }
 
+void I2C::clear_transfer_buffer()
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    // the queue is shared by all the I2C objects, keep the transfers of the others
+    core_util_critical_section_enter();
+    size_t count = _transaction_buffer->size();
+    transfer_s t;
+    while (count--) {
+        _transaction_buffer->pop(t);
+        if (t.object != this) {
+            _transaction_buffer->push(t);
+        }
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
+void I2C::abort_all_transfers()
+{
+    clear_transfer_buffer();
+    abort_transfer();
+}
+
+int I2C::set_dma_usage(DMAUsage usage)
+{
+    if (_transfer_owner == this || i2c_active(&_i2c)) {
+        return -1;
+    }
+    _usage = usage;
+    return 0;
+}
+
+int I2C::queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    transfer_s t;
+
+    t.object = this;
+    t.address = address;
+    t.tx_buffer = tx_buffer;
+    t.tx_length = tx_length;
+    t.rx_buffer = rx_buffer;
+    t.rx_length = rx_length;
+    t.callback = callback;
+    t.event = event;
+    t.repeated = repeated;
+
+    core_util_critical_section_enter();
+    if (_transaction_buffer->full()) {
+        core_util_critical_section_exit();
+        return -1; // the buffer is full
+    }
+    _transaction_buffer->push(t);
+    // the ongoing transfer may have completed meanwhile
+    if (_transfer_owner == NULL) {
+        dequeue_transaction();
+    }
+    core_util_critical_section_exit();
+    return 0;
+#else
+    return -1; // transaction ongoing
+#endif
+}
+
+void I2C::start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
+    lock_deep_sleep();
+    if (_owner != this) {
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+    }
+
+    _callback = callback;
+    int stop = (repeated) ? 0 : 1;
+    _irq.callback(&I2C::irq_handler_asynch);
+    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
+}
+
+void I2C::finish_transfer()
+{
+    if (i2c_active(&_i2c)) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    if (_transfer_owner == this) {
+        _transfer_owner = NULL;
+#if TRANSACTION_QUEUE_SIZE_I2C
+        dequeue_transaction();
+#endif
+    }
+    core_util_critical_section_exit();
+}
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::dequeue_transaction()
+{
+    transfer_s t;
+    if (_transaction_buffer->pop(t)) {
+        _transfer_owner = t.object;
+        t.object->start_transfer(t.address, t.tx_buffer, t.tx_length, t.rx_buffer, t.rx_length, t.callback, t.event, t.repeated);
+    }
+}
+
+#endif
+
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
@@ -242,6 +382,12 @@ void I2C::irq_handler_asynch(void)
     if (event) {
         unlock_deep_sleep();
     }
+
+    // the bus is free once the HAL is back to idle, even for events not asked for
+    if (!i2c_active(&_i2c)) {
+        unlock_deep_sleep();
+        finish_transfer();
+    }
 }
 
 void I2C::lock_deep_sleep()
@@ -34,6 +34,13 @@ I2CSlave::I2CSlave(const i2c_pinmap_t &static_pinmap) : _i2c()
     i2c_slave_mode(&_i2c, 1);
 }
 
+I2CSlave::~I2CSlave()
+{
+#if DEVICE_I2CSLAVE_REGMAP
+    stop_register_map();
+#endif
+}
+
 void I2CSlave::frequency(int hz)
 {
     i2c_frequency(&_i2c, hz);
@@ -72,9 +79,47 @@ int I2CSlave::write(int data)
 
 void I2CSlave::stop(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    stop_register_map();
+#endif
     i2c_stop(&_i2c);
 }
 
+#if DEVICE_I2CSLAVE_REGMAP
+int I2CSlave::start_register_map(Span<uint8_t> registers, write_callback_t on_write)
+{
+    if (_register_map_started || registers.empty()) {
+        return -1;
+    }
+
+    _write_callback = on_write;
+    if (i2c_slave_regmap_start(&_i2c, registers.data(), registers.size(), &I2CSlave::_register_write_irq,
+                               (uint32_t)this) != 0) {
+        return -1;
+    }
+    _register_map_started = true;
+    return 0;
+}
+
+void I2CSlave::stop_register_map()
+{
+    if (!_register_map_started) {
+        return;
+    }
+    i2c_slave_regmap_stop(&_i2c);
+    _register_map_started = false;
+}
+
+void I2CSlave::_register_write_irq(uint32_t id, uint32_t offset, uint32_t length)
+{
+    I2CSlave *slave = reinterpret_cast<I2CSlave *>(id);
+
+    if (slave->_write_callback) {
+        slave->_write_callback(offset, length);
+    }
+}
+#endif
+
 }
 
 #endif
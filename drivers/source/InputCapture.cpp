@@ -0,0 +1,124 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/InputCapture.h"
+
+#if DEVICE_INPUT_CAPTURE
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_error.h"
+
+namespace mbed {
+
+InputCapture::InputCapture(PinName pin)
+{
+    _mutex.lock();
+    if (input_capture_init(&_capture, pin) != 0) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_PWM, MBED_ERROR_CODE_INVALID_ARGUMENT),
+                   "InputCapture pin cannot be captured");
+    }
+    _mask = input_capture_max_count(&_capture);
+    _mutex.unlock();
+}
+
+InputCapture::~InputCapture()
+{
+    _mutex.lock();
+    input_capture_free(&_capture);
+    _mutex.unlock();
+}
+
+int InputCapture::start(uint32_t tick_hz, Span<uint32_t> buffer, Callback<void(Span<const uint32_t>)> func,
+                        Edge edge, Mode mode, events::EventQueue *queue)
+{
+    _mutex.lock();
+    input_capture_stop(&_capture);
+    _func = func;
+    _queue = queue;
+    _mode = mode;
+    _first = true;
+    _pending = 0;
+    _overruns = 0;
+    int ret = input_capture_start(&_capture, tick_hz, (input_capture_edge_t)edge, buffer.data(), buffer.size(),
+                                  &InputCapture::irq_handler, (uint32_t)this);
+    _mutex.unlock();
+    return ret;
+}
+
+void InputCapture::stop()
+{
+    _mutex.lock();
+    input_capture_stop(&_capture);
+    _mutex.unlock();
+}
+
+uint32_t InputCapture::tick_hz()
+{
+    _mutex.lock();
+    uint32_t hz = input_capture_tick_hz(&_capture);
+    _mutex.unlock();
+    return hz;
+}
+
+uint32_t InputCapture::max_count()
+{
+    return _mask;
+}
+
+void InputCapture::irq_handler(uint32_t id, uint32_t *captures, size_t count)
+{
+    InputCapture *handler = (InputCapture *)id;
+    Span<const uint32_t> block(captures, count);
+
+    // Once per half buffer, the differences span the boundary of the halves
+    if (handler->_mode == Periods) {
+        uint32_t last = handler->_first ? captures[0] : handler->_last;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t capture = captures[i];
+            captures[i] = (capture - last) & handler->_mask;
+            last = capture;
+        }
+        handler->_last = last;
+        handler->_first = false;
+    }
+
+    // The other half is due: the previous one now gets overwritten
+    if (handler->_pending != 0) {
+        handler->_overruns++;
+    }
+
+    if (handler->_queue == nullptr) {
+        handler->_func(block);
+        return;
+    }
+
+    core_util_atomic_incr_u32(&handler->_pending, 1);
+    if (handler->_queue->call(handler, &InputCapture::process, block) == 0) {
+        core_util_atomic_decr_u32(&handler->_pending, 1);
+        handler->_overruns++;
+    }
+}
+
+void InputCapture::process(Span<const uint32_t> captures)
+{
+    _func(captures);
+    core_util_atomic_decr_u32(&_pending, 1);
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,203 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/InterruptInGroup.h"
+
+#if DEVICE_INTERRUPTIN
+
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+using namespace std::chrono;
+
+namespace mbed {
+
+// Edges handed to the callback at once, copied on the stack of the queue
+#define INTERRUPTIN_GROUP_BATCH  8
+
+InterruptInGroup::InterruptInGroup(const PinName *pins, size_t count, PinMode mode) :
+    _pins(new pin_state[count]),
+    _count(count),
+    _queue(nullptr),
+    _debounce(0),
+    _timeout_armed(false),
+    _posted(false),
+    _overruns(0)
+{
+    MBED_ASSERT(count <= 255);
+
+    // No lock needed in the constructor
+    for (size_t i = 0; i < count; i++) {
+        pin_state *pin = &_pins[i];
+        pin->group = this;
+        pin->index = i;
+        pin->masked = false;
+        gpio_irq_init(&pin->irq, pins[i], &InterruptInGroup::irq_handler, (uint32_t)pin);
+        gpio_init_in_ex(&pin->gpio, pins[i], mode);
+        pin->level = gpio_read(&pin->gpio);
+    }
+}
+
+InterruptInGroup::~InterruptInGroup()
+{
+    // No lock needed in the destructor
+    _timeout.detach();
+    for (size_t i = 0; i < _count; i++) {
+        gpio_irq_free(&_pins[i].irq);
+    }
+    delete[] _pins;
+}
+
+void InterruptInGroup::debounce(microseconds time)
+{
+    core_util_critical_section_enter();
+    _debounce = time;
+    core_util_critical_section_exit();
+}
+
+void InterruptInGroup::attach(Callback<void(Span<const Edge>)> func, events::EventQueue *queue)
+{
+    core_util_critical_section_enter();
+    _func = func;
+    _queue = func ? queue : nullptr;
+    for (size_t i = 0; i < _count; i++) {
+        pin_state *pin = &_pins[i];
+        gpio_irq_set(&pin->irq, IRQ_RISE, _queue != nullptr);
+        gpio_irq_set(&pin->irq, IRQ_FALL, _queue != nullptr);
+        if (pin->masked) {
+            // The debounce timeout unmasks it with the new edges
+            gpio_irq_disable(&pin->irq);
+        }
+        pin->level = gpio_read(&pin->gpio);
+    }
+    core_util_critical_section_exit();
+}
+
+int InterruptInGroup::read(size_t pin)
+{
+    MBED_ASSERT(pin < _count);
+    // Read only
+    return gpio_read(&_pins[pin].gpio);
+}
+
+void InterruptInGroup::irq_handler(uint32_t id, gpio_irq_event event)
+{
+    pin_state *pin = (pin_state *)id;
+    pin->group->edge(pin, event == IRQ_RISE);
+}
+
+void InterruptInGroup::edge(pin_state *pin, bool rising)
+{
+    HighResClock::time_point now = HighResClock::now();
+
+    core_util_critical_section_enter();
+    if (_debounce == 0us) {
+        push(pin, rising, now);
+    } else if (!pin->masked) {
+        // A bounce back to the previous level before the interrupt ran
+        if (rising != pin->level) {
+            push(pin, rising, now);
+        }
+        gpio_irq_disable(&pin->irq);
+        pin->masked = true;
+        pin->until = now + _debounce;
+        // All windows have the same length: the armed one expires first
+        if (!_timeout_armed) {
+            _timeout_armed = true;
+            _timeout.attach(callback(this, &InterruptInGroup::debounce_expired), _debounce);
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+void InterruptInGroup::push(pin_state *pin, bool rising, HighResClock::time_point time)
+{
+    pin->level = rising;
+
+    if (_edges.full()) {
+        _overruns++;
+        return;
+    }
+    _edges.push(Edge{time, pin->index, rising});
+
+    if (!_posted && _queue != nullptr) {
+        // When the queue is out of events, the edges wait for the next one
+        _posted = _queue->call(this, &InterruptInGroup::process) != 0;
+    }
+}
+
+void InterruptInGroup::debounce_expired()
+{
+    HighResClock::time_point now = HighResClock::now();
+    HighResClock::time_point next = HighResClock::time_point::max();
+
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < _count; i++) {
+        pin_state *pin = &_pins[i];
+        if (!pin->masked) {
+            continue;
+        }
+        if (pin->until <= now) {
+            bool level = gpio_read(&pin->gpio);
+            if (level != pin->level) {
+                // The level settled elsewhere: an edge was masked
+                push(pin, level, now);
+                pin->until = now + _debounce;
+            } else {
+                pin->masked = false;
+                gpio_irq_enable(&pin->irq);
+                continue;
+            }
+        }
+        if (pin->until < next) {
+            next = pin->until;
+        }
+    }
+
+    if (next == HighResClock::time_point::max()) {
+        _timeout_armed = false;
+    } else {
+        _timeout.attach(callback(this, &InterruptInGroup::debounce_expired), next - now);
+    }
+    core_util_critical_section_exit();
+}
+
+void InterruptInGroup::process()
+{
+    Edge batch[INTERRUPTIN_GROUP_BATCH];
+
+    while (true) {
+        core_util_critical_section_enter();
+        uint32_t count = _edges.pop(batch, INTERRUPTIN_GROUP_BATCH);
+        if (count == 0) {
+            _posted = false;
+        }
+        Callback<void(Span<const Edge>)> func = _func;
+        core_util_critical_section_exit();
+
+        if (count == 0) {
+            break;
+        }
+        if (func) {
+            func(Span<const Edge>(batch, count));
+        }
+    }
+}
+
+} // namespace mbed
+
+#endif
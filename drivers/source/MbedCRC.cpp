@@ -26,6 +26,9 @@ SingletonPtr<PlatformMutex> mbed_crc_mutex;
 MBED_STATIC_ASSERT(MBED_CRC_TABLE_SIZE == 0 || MBED_CRC_TABLE_SIZE == 16 || MBED_CRC_TABLE_SIZE == 256,
                    "Configuration setting drivers.crc-table-size must be set to 0, 16 or 256");
 
+MBED_STATIC_ASSERT(MBED_CRC_SLICES == 0 || MBED_CRC_SLICES == 4 || MBED_CRC_SLICES == 8,
+                   "Configuration setting drivers.crc-slices must be set to 0, 4 or 8");
+
 #if MBED_CRC_TABLE_SIZE > 0
 
 /* Tables are arranged for LSB first input. This means they're optimised
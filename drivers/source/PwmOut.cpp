@@ -32,19 +32,40 @@ PwmOut::PwmOut(PinName pin) :
     _initialized(false),
     _duty_cycle(0),
     _period_us(0)
+#if DEVICE_PWMOUT_WAVEFORM
+    , _waveform(false)
+#endif
 {
     PwmOut::init();
+#if DEVICE_CLOCK_SCALING
+    _clock_notifier.handler = &PwmOut::clock_changed;
+    _clock_notifier.context = this;
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 PwmOut::PwmOut(const PinMap &pinmap) : _deep_sleep_locked(false)
+#if DEVICE_PWMOUT_WAVEFORM
+    , _waveform(false)
+#endif
 {
     core_util_critical_section_enter();
     pwmout_init_direct(&_pwm, &pinmap);
     core_util_critical_section_exit();
+#if DEVICE_CLOCK_SCALING
+    // Not suspended, the period is applied again after a clock change
+    _initialized = true;
+    _clock_notifier.handler = &PwmOut::clock_changed;
+    _clock_notifier.context = this;
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 PwmOut::~PwmOut()
 {
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_remove(&_clock_notifier);
+#endif
     PwmOut::deinit();
 }
 
@@ -143,6 +164,65 @@ void PwmOut::resume()
     core_util_critical_section_exit();
 }
 
+#if DEVICE_PWMOUT_WAVEFORM
+uint32_t PwmOut::waveform_period_ns(uint32_t ns)
+{
+    core_util_critical_section_enter();
+    _waveform = true;
+    uint32_t full_scale = pwmout_waveform_init(&_pwm, ns);
+    core_util_critical_section_exit();
+    return full_scale;
+}
+
+int PwmOut::write_waveform(Span<uint16_t> pulses, Callback<void(Span<uint16_t>)> func, bool repeat)
+{
+    core_util_critical_section_enter();
+    _waveform_cb = func;
+    int ret = pwmout_waveform_start(&_pwm, pulses.data(), pulses.size(), repeat,
+                                    &PwmOut::waveform_irq, (uint32_t)this);
+    core_util_critical_section_exit();
+    return ret;
+}
+
+void PwmOut::stop_waveform()
+{
+    core_util_critical_section_enter();
+    if (_waveform) {
+        pwmout_waveform_stop(&_pwm);
+        _waveform = false;
+    }
+    core_util_critical_section_exit();
+}
+
+void PwmOut::waveform_irq(uint32_t id, uint16_t *pulses, size_t count)
+{
+    PwmOut *pwm = (PwmOut *)id;
+    if (pwm->_waveform_cb) {
+        pwm->_waveform_cb(Span<uint16_t>(pulses, count));
+    }
+}
+#endif
+
+#if DEVICE_CLOCK_SCALING
+void PwmOut::clock_changed(void *context, uint32_t frequency_hz)
+{
+    PwmOut *pwm = (PwmOut *)context;
+    // Interrupts are disabled, the prescaler is computed from the new clock
+#if DEVICE_PWMOUT_WAVEFORM
+    // The pulses were computed for the previous clock
+    if (pwm->_waveform) {
+        pwmout_waveform_stop(&pwm->_pwm);
+        pwm->_waveform = false;
+    }
+#endif
+    if (pwm->_initialized) {
+        float duty_cycle = pwmout_read(&pwm->_pwm);
+        pwmout_period_us(&pwm->_pwm, pwmout_read_period_us(&pwm->_pwm));
+        pwmout_write(&pwm->_pwm, duty_cycle);
+    }
+}
+#endif
+
 void PwmOut::lock_deep_sleep()
 {
     if (_deep_sleep_locked == false) {
@@ -177,6 +257,9 @@ void PwmOut::deinit()
     core_util_critical_section_enter();
 
     if (_initialized) {
+#if DEVICE_PWMOUT_WAVEFORM
+        _waveform = false;
+#endif
         pwmout_free(&_pwm);
         unlock_deep_sleep();
         _initialized = false;
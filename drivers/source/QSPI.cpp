@@ -25,6 +25,9 @@ namespace mbed {
 
 QSPI *QSPI::_owner = NULL;
 SingletonPtr<PlatformMutex> QSPI::_mutex;
+#if DEVICE_QSPI_ASYNCH
+volatile bool QSPI::_async_busy = false;
+#endif
 
 uint8_t convert_bus_width_to_line_count(qspi_bus_width_t width)
 {
@@ -255,6 +258,142 @@ qspi_status_t QSPI::command_transfer(qspi_inst_t instruction, int address, const
     return ret_status;
 }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+qspi_status_t QSPI::memory_map(qspi_inst_t instruction, int alt, Span<const uint8_t> &region)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        lock();
+        if (true == _acquire()) {
+            const void *base;
+            size_t size;
+            _build_qspi_command(instruction, 0, alt);
+            if (QSPI_STATUS_OK == qspi_memory_mapped_enable(&_qspi, &_qspi_command, &base, &size)) {
+                region = Span<const uint8_t>(static_cast<const uint8_t *>(base), size);
+                ret_status = QSPI_STATUS_OK;
+            }
+        }
+        unlock();
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::memory_unmap()
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        lock();
+        // Another owner has already re-initialized the peripheral in indirect mode
+        if (_owner != this || QSPI_STATUS_OK == qspi_memory_mapped_disable(&_qspi)) {
+            ret_status = QSPI_STATUS_OK;
+        }
+        unlock();
+    }
+
+    return ret_status;
+}
+#endif
+
+#if DEVICE_QSPI_ASYNCH
+qspi_status_t QSPI::read_async(qspi_inst_t instruction, int alt, int address, char *rx_buffer, size_t rx_length,
+                               const async_callback_t &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((rx_buffer != NULL) && (rx_length != 0)) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, address, alt);
+                _async_callback = callback;
+                _async_busy = true;
+                ret_status = qspi_read_async(&_qspi, &_qspi_command, rx_buffer, rx_length, &QSPI::_async_irq, (uint32_t)this);
+                if (QSPI_STATUS_OK != ret_status) {
+                    _async_busy = false;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::write_async(qspi_inst_t instruction, int alt, int address, const char *tx_buffer, size_t tx_length,
+                                const async_callback_t &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((tx_buffer != NULL) && (tx_length != 0)) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, address, alt);
+                _async_callback = callback;
+                _async_busy = true;
+                ret_status = qspi_write_async(&_qspi, &_qspi_command, tx_buffer, tx_length, &QSPI::_async_irq, (uint32_t)this);
+                if (QSPI_STATUS_OK != ret_status) {
+                    _async_busy = false;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::poll_status_async(qspi_inst_t instruction, size_t status_size, uint32_t mask, uint32_t match,
+                                      uint32_t interval, const async_callback_t &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        lock();
+        if (true == _acquire()) {
+            _build_qspi_command(instruction, -1, -1);
+            _async_callback = callback;
+            _async_busy = true;
+            ret_status = qspi_poll_status_async(&_qspi, &_qspi_command, status_size, mask, match, interval,
+                                                &QSPI::_async_irq, (uint32_t)this);
+            if (QSPI_STATUS_OK != ret_status) {
+                _async_busy = false;
+            }
+        }
+        unlock();
+    }
+
+    return ret_status;
+}
+
+void QSPI::abort_async()
+{
+    lock();
+    if (_async_busy && _owner == this) {
+        qspi_abort_async(&_qspi);
+        _async_busy = false;
+    }
+    unlock();
+}
+
+void QSPI::_async_irq(uint32_t id, qspi_status_t status)
+{
+    QSPI *qspi = reinterpret_cast<QSPI *>(id);
+
+    _async_busy = false;
+    if (qspi->_async_callback) {
+        qspi->_async_callback(status);
+    }
+}
+#endif
+
 void QSPI::lock()
 {
     _mutex->lock();
@@ -306,6 +445,11 @@ bool QSPI::_initialize_direct()
 // Note: Private function with no locking
 bool QSPI::_acquire()
 {
+#if DEVICE_QSPI_ASYNCH
+    if (_async_busy) {
+        return false;
+    }
+#endif
     if (_owner != this) {
         //This will set freq as well
         (this->*_init_func)();
@@ -0,0 +1,60 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/QuadratureEncoder.h"
+
+#if DEVICE_INPUT_CAPTURE
+
+#include "platform/mbed_error.h"
+
+namespace mbed {
+
+QuadratureEncoder::QuadratureEncoder(PinName pin_a, PinName pin_b)
+{
+    _mutex.lock();
+    if (input_capture_encoder_init(&_capture, pin_a, pin_b) != 0) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_PWM, MBED_ERROR_CODE_INVALID_ARGUMENT),
+                   "QuadratureEncoder pins cannot be counted together");
+    }
+    _mutex.unlock();
+}
+
+QuadratureEncoder::~QuadratureEncoder()
+{
+    _mutex.lock();
+    input_capture_free(&_capture);
+    _mutex.unlock();
+}
+
+int32_t QuadratureEncoder::read()
+{
+    _mutex.lock();
+    int32_t position = input_capture_encoder_read(&_capture);
+    _mutex.unlock();
+    return position;
+}
+
+void QuadratureEncoder::reset()
+{
+    _mutex.lock();
+    input_capture_encoder_reset(&_capture);
+    _mutex.unlock();
+}
+
+} // namespace mbed
+
+#endif
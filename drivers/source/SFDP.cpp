@@ -316,6 +316,69 @@ int sfdp_parse_sector_map_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp
     return 0;
 }
 
+int sfdp_cache_tables(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, const sfdp_hdr_info &sfdp_info,
+                      const uint8_t *jedec_id, sfdp_cache &cache)
+{
+    cache.version = 0;
+
+    if (!sfdp_info.bptbl.size || sfdp_info.bptbl.size > sizeof(cache.bptbl) ||
+            sfdp_info.smptbl.size > sizeof(cache.smptbl)) {
+        tr_debug("SFDP tables don't fit in the cache");
+        return -1;
+    }
+
+    cache.bptbl_addr = sfdp_info.bptbl.addr;
+    cache.bptbl_size = sfdp_info.bptbl.size;
+    if (sfdp_reader(cache.bptbl_addr, cache.bptbl, cache.bptbl_size) < 0) {
+        tr_error("Caching Basic Param Table failed");
+        return -1;
+    }
+
+    cache.smptbl_addr = sfdp_info.smptbl.size ? sfdp_info.smptbl.addr : 0;
+    cache.smptbl_size = sfdp_info.smptbl.addr ? sfdp_info.smptbl.size : 0;
+    if (cache.smptbl_size && sfdp_reader(cache.smptbl_addr, cache.smptbl, cache.smptbl_size) < 0) {
+        tr_error("Caching Sector Map Table failed");
+        return -1;
+    }
+
+    memcpy(cache.jedec_id, jedec_id, sizeof(cache.jedec_id));
+    cache.version = SFDP_CACHE_VERSION;
+
+    return 0;
+}
+
+int sfdp_cache_lookup(const sfdp_cache &cache, const uint8_t *jedec_id, sfdp_hdr_info &sfdp_info)
+{
+    if (cache.version != SFDP_CACHE_VERSION || memcmp(cache.jedec_id, jedec_id, sizeof(cache.jedec_id)) != 0 ||
+            !cache.bptbl_size || cache.bptbl_size > sizeof(cache.bptbl) || cache.smptbl_size > sizeof(cache.smptbl)) {
+        return -1;
+    }
+
+    tr_debug("Using cached SFDP tables");
+    sfdp_info.bptbl.addr = cache.bptbl_addr;
+    sfdp_info.bptbl.size = cache.bptbl_size;
+    sfdp_info.smptbl.addr = cache.smptbl_addr;
+    sfdp_info.smptbl.size = cache.smptbl_size;
+
+    return 0;
+}
+
+int sfdp_cache_read(const sfdp_cache *cache, bd_addr_t addr, void *rx_buffer, bd_size_t rx_length)
+{
+    if (addr == cache->bptbl_addr && rx_length <= cache->bptbl_size) {
+        memcpy(rx_buffer, cache->bptbl, rx_length);
+        return 0;
+    }
+
+    if (cache->smptbl_size && addr == cache->smptbl_addr && rx_length <= cache->smptbl_size) {
+        memcpy(rx_buffer, cache->smptbl, rx_length);
+        return 0;
+    }
+
+    tr_error("SFDP data at 0x%" PRIx32 " is not cached", (uint32_t)addr);
+    return -1;
+}
+
 size_t sfdp_detect_page_size(uint8_t *basic_param_table_ptr, size_t basic_param_table_size)
 {
     constexpr int SFDP_BASIC_PARAM_TABLE_PAGE_SIZE = 40;
@@ -443,6 +506,64 @@ int sfdp_detect_device_density(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
     return 0;
 }
 
+int sfdp_detect_suspend_resume(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
+{
+    constexpr int SFDP_BASIC_PARAM_TABLE_SUSPEND_LATENCY_DWORD = 44; ///< 12th DWORD, suspend/resume support and timings
+    constexpr int SFDP_BASIC_PARAM_TABLE_SUSPEND_INST_DWORD = 48; ///< 13th DWORD, suspend/resume instructions
+    // Latency units of 128ns, 1us, 8us and 64us, in nanoseconds
+    static const uint32_t latency_units_ns[] = {128, 1000, 8000, 64000};
+
+    bptbl_info.erase_suspend_inst = -1;
+    bptbl_info.erase_resume_inst = -1;
+    bptbl_info.program_suspend_inst = -1;
+    bptbl_info.program_resume_inst = -1;
+    bptbl_info.suspend_latency_us = 0;
+    bptbl_info.resume_to_suspend_us = 0;
+
+    if (bptbl_info.size < SFDP_BASIC_PARAM_TABLE_SUSPEND_INST_DWORD + 4) {
+        tr_debug("Suspend/resume is not described by the Basic Parameter Table");
+        return 0;
+    }
+
+    const uint8_t *dword = &bptbl_ptr[SFDP_BASIC_PARAM_TABLE_SUSPEND_LATENCY_DWORD];
+    uint32_t timings = (dword[3] << 24) | (dword[2] << 16) | (dword[1] << 8) | dword[0];
+    if (timings & 0x80000000) {
+        tr_debug("Suspend/resume is not supported");
+        return 0;
+    }
+
+    // Maximum latency of the suspend of a program (bits 19:13) and of an erase (bits 30:24)
+    uint32_t program_latency_ns = (((timings >> 13) & 0x1F) + 1) * latency_units_ns[(timings >> 18) & 0x3];
+    uint32_t erase_latency_ns = (((timings >> 24) & 0x1F) + 1) * latency_units_ns[(timings >> 29) & 0x3];
+    uint32_t latency_ns = program_latency_ns > erase_latency_ns ? program_latency_ns : erase_latency_ns;
+    bptbl_info.suspend_latency_us = (latency_ns + 999) / 1000;
+
+    // Resume to suspend interval of a program (bits 12:9) and of an erase (bits 23:20), in units of 64us
+    uint32_t program_interval = (timings >> 9) & 0xF;
+    uint32_t erase_interval = (timings >> 20) & 0xF;
+    bptbl_info.resume_to_suspend_us = ((program_interval > erase_interval ? program_interval : erase_interval) + 1) * 64;
+
+    const uint8_t *inst = &bptbl_ptr[SFDP_BASIC_PARAM_TABLE_SUSPEND_INST_DWORD];
+    if (inst[0] == 0x00 || inst[0] == 0xFF || inst[1] == 0x00 || inst[1] == 0xFF ||
+            inst[2] == 0x00 || inst[2] == 0xFF || inst[3] == 0x00 || inst[3] == 0xFF) {
+        tr_debug("Suspend/resume instructions are not valid");
+        return 0;
+    }
+
+    bptbl_info.program_resume_inst = inst[0];
+    bptbl_info.program_suspend_inst = inst[1];
+    bptbl_info.erase_resume_inst = inst[2];
+    bptbl_info.erase_suspend_inst = inst[3];
+
+    tr_debug("Erase Suspend Inst: 0x%xh, Resume Inst: 0x%xh, Program Suspend Inst: 0x%xh, Resume Inst: 0x%xh",
+             bptbl_info.erase_suspend_inst, bptbl_info.erase_resume_inst,
+             bptbl_info.program_suspend_inst, bptbl_info.program_resume_inst);
+    tr_debug("Suspend latency: %dus, resume to suspend: %dus",
+             bptbl_info.suspend_latency_us, bptbl_info.resume_to_suspend_us);
+
+    return 0;
+}
+
 #if DEVICE_QSPI
 int sfdp_detect_addressability(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
 {
@@ -16,6 +16,7 @@
  */
 #include "drivers/SPI.h"
 #include "platform/mbed_critical.h"
+#include <string.h>
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/mbed_power_mgmt.h"
@@ -144,10 +145,19 @@ void SPI::_do_construct()
 #endif
     // we don't need to _acquire at this stage.
     // this will be done anyway before any operation.
+
+#if DEVICE_CLOCK_SCALING
+    _clock_notifier.handler = &SPI::_clock_changed;
+    _clock_notifier.context = this;
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 SPI::~SPI()
 {
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_remove(&_clock_notifier);
+#endif
     lock();
     /* Make sure a stale pointer isn't left in peripheral's owner field */
     if (_peripheral->owner == this) {
@@ -156,6 +166,17 @@ SPI::~SPI()
     unlock();
 }
 
+#if DEVICE_CLOCK_SCALING
+void SPI::_clock_changed(void *context, uint32_t frequency_hz)
+{
+    SPI *obj = (SPI *)context;
+    // Interrupts are disabled, the next acquire applies the frequency again
+    if (obj->_peripheral->owner == obj) {
+        obj->_peripheral->owner = nullptr;
+    }
+}
+#endif
+
 SPI::spi_peripheral_s *SPI::_lookup(SPI::SPIName name)
 {
     SPI::spi_peripheral_s *result = nullptr;
@@ -287,6 +308,17 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_burst(const uint8_t *tx_buffer, uint8_t *rx_buffer, int length, const event_callback_t &callback, int event)
+{
+    MBED_ASSERT(tx_buffer || rx_buffer);
+
+    if (!tx_buffer) {
+        memset(rx_buffer, _write_fill, length);
+        tx_buffer = rx_buffer;
+    }
+    return transfer(tx_buffer, length, rx_buffer, rx_buffer ? length : 0, callback, event);
+}
+
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_peripheral->spi);
@@ -351,7 +383,10 @@ void SPI::start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer,
 {
     lock_deep_sleep();
     _acquire();
-    _set_ssel(0);
+    // Within select()/deselect(), the selection spans the whole transaction
+    if (_select_count == 0) {
+        _set_ssel(0);
+    }
     _callback = callback;
     _irq.callback(&SPI::irq_handler_asynch);
     spi_master_transfer(&_peripheral->spi, tx_buffer, tx_length, rx_buffer, rx_length, bit_width, _irq.entry(), event, _usage);
@@ -396,7 +431,9 @@ void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_peripheral->spi);
     if (_callback && (event & SPI_EVENT_ALL)) {
-        _set_ssel(1);
+        if (_select_count == 0) {
+            _set_ssel(1);
+        }
         unlock_deep_sleep();
         _callback.call(event & SPI_EVENT_ALL);
     }
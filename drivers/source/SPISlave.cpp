@@ -43,6 +43,13 @@ SPISlave::SPISlave(const spi_pinmap_t &pinmap) :
     spi_frequency(&_spi, _hz);
 }
 
+SPISlave::~SPISlave()
+{
+#if DEVICE_SPISLAVE_DMA
+    stop_transactions();
+#endif
+}
+
 void SPISlave::format(int bits, int mode)
 {
     _bits = bits;
@@ -71,6 +78,79 @@ void SPISlave::reply(int value)
     spi_slave_write(&_spi, value);
 }
 
+#if DEVICE_SPISLAVE_DMA
+int SPISlave::start_transactions(Span<uint8_t> buffer, transaction_callback_t callback)
+{
+    if (_transactions_started || buffer.empty()) {
+        return -1;
+    }
+
+    _rx_buffer = buffer;
+    _transaction_callback = callback;
+    _rx_count = 0;
+    _rx_pos = 0;
+    _overruns = 0;
+    if (spi_slave_dma_start(&_spi, buffer.data(), buffer.size(), &SPISlave::_transaction_irq, (uint32_t)this) != 0) {
+        return -1;
+    }
+    _transactions_started = true;
+
+    if (!_reply.empty()) {
+        spi_slave_dma_reply(&_spi, _reply.data(), _reply.size());
+    }
+    return 0;
+}
+
+int SPISlave::set_reply(Span<const uint8_t> reply)
+{
+    _reply = reply;
+    if (!_transactions_started) {
+        return -1;
+    }
+    return spi_slave_dma_reply(&_spi, _reply.data(), _reply.size());
+}
+
+void SPISlave::stop_transactions()
+{
+    if (!_transactions_started) {
+        return;
+    }
+    spi_slave_dma_stop(&_spi);
+    _transactions_started = false;
+}
+
+uint32_t SPISlave::overruns() const
+{
+    return _overruns;
+}
+
+void SPISlave::_transaction_irq(uint32_t id)
+{
+    SPISlave *slave = reinterpret_cast<SPISlave *>(id);
+    size_t length = slave->_rx_buffer.size();
+
+    // Differences of the wrapping counter stay exact, positions are kept
+    // modulo the buffer length so they never overflow
+    uint32_t count = spi_slave_dma_count(&slave->_spi);
+    size_t received = count - slave->_rx_count;
+    size_t pos = slave->_rx_pos;
+    slave->_rx_count = count;
+    slave->_rx_pos = (pos + received) % length;
+
+    // Load the reply first, the master may start the next transaction soon
+    spi_slave_dma_reply(&slave->_spi, slave->_reply.data(), slave->_reply.size());
+
+    if (received > length) {
+        // The end of the transaction overwrote its start
+        slave->_overruns++;
+    } else if (received > 0 && slave->_transaction_callback) {
+        size_t first = (received < length - pos) ? received : length - pos;
+        Span<const uint8_t> rx = slave->_rx_buffer;
+        slave->_transaction_callback(rx.subspan(pos, first), rx.subspan(0, received - first));
+    }
+}
+#endif
+
 } // namespace mbed
 
 #endif
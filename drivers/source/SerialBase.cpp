@@ -35,6 +35,9 @@ SerialBase::SerialBase(PinName tx, PinName rx, int baud) :
     // No lock needed in the constructor
 
     (this->*_init_func)();
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 SerialBase::SerialBase(const serial_pinmap_t &static_pinmap, int baud) :
@@ -50,6 +53,9 @@ SerialBase::SerialBase(const serial_pinmap_t &static_pinmap, int baud) :
     // No lock needed in the constructor
 
     (this->*_init_func)();
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_add(&_clock_notifier);
+#endif
 }
 
 void SerialBase::baud(int baudrate)
@@ -122,6 +128,17 @@ void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type)
     }
 }
 
+#if DEVICE_CLOCK_SCALING
+void SerialBase::_clock_changed(void *context, uint32_t frequency_hz)
+{
+    SerialBase *handler = (SerialBase *)context;
+    // Interrupts are disabled, the divider is computed from the new clock
+    if (handler->_rx_enabled || handler->_tx_enabled) {
+        serial_baud(&handler->_serial, handler->_baud);
+    }
+}
+#endif
+
 int SerialBase::_base_getc()
 {
     // Mutex is already held
@@ -283,6 +300,10 @@ SerialBase::~SerialBase()
 {
     // No lock needed in destructor
 
+#if DEVICE_CLOCK_SCALING
+    mbed_clock_notifier_remove(&_clock_notifier);
+#endif
+
     // Detaching interrupts releases the sleep lock if it was locked
     for (int irq = 0; irq < IrqCnt; irq++) {
         attach(nullptr, (IrqType)irq);
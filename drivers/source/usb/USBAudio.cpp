@@ -165,12 +165,15 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
     _tx_whole_frames_per_xfer = _tx_freq / XFER_FREQUENCY_HZ;
     _tx_fract_frames_per_xfer = _tx_freq % XFER_FREQUENCY_HZ;
 
-    uint32_t max_frames = _tx_whole_frames_per_xfer + (_tx_fract_frames_per_xfer ? 1 : 0);
+    // One more frame than needed at the nominal rate, for the rate matching
+    uint32_t max_frames = _tx_whole_frames_per_xfer + (_tx_fract_frames_per_xfer ? 1 : 0) + 1;
     _tx_packet_size_max = max_frames * SAMPLE_SIZE * _tx_channel_count;
     _rx_packet_size_max = (_rx_freq + 1000 - 1) / 1000 * _rx_channel_count * 2;
 
     _tx_packet_buf = new uint8_t[_tx_packet_size_max]();
-    _rx_packet_buf = new uint8_t[_rx_packet_size_max]();
+    // Two packets, one being received while the other is queued
+    _rx_packet_buf = new uint8_t[2 * _rx_packet_size_max]();
+    _rx_packet_next = 0;
 
     _tx_queue.resize(buffer_ms * _tx_channel_count * SAMPLE_SIZE * _tx_freq / XFER_FREQUENCY_HZ);
     _rx_queue.resize(buffer_ms * _rx_channel_count * SAMPLE_SIZE * _rx_freq / XFER_FREQUENCY_HZ);
@@ -180,8 +183,8 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
 
     EndpointResolver resolver(endpoint_table());
     resolver.endpoint_ctrl(64);
-    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _tx_packet_size_max);
-    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _tx_packet_size_max);
     MBED_ASSERT(resolver.valid());
 
     _channel_config_rx = (_rx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
@@ -547,6 +550,7 @@ void USBAudio::callback_set_configuration(uint8_t configuration)
         endpoint_add(_episo_in, _tx_packet_size_max, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_send_isr));
 
         // activate readings on this endpoint
+        _rx_packet_next = 0;
         read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
         ret = true;
     }
@@ -835,7 +839,7 @@ void USBAudio::_build_configuration_desc()
         ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
         ENDPOINT_DESCRIPTOR,                    // bDescriptorType
         _episo_in,                              // bEndpointAddress
-        E_ISOCHRONOUS,                          // bmAttributes
+        E_ISOCHRONOUS | E_ASYNCHRONOUS,         // bmAttributes
         (uint8_t)(LSB(_tx_packet_size_max)),    // wMaxPacketSize
         (uint8_t)(MSB(_tx_packet_size_max)),    // wMaxPacketSize
         0x01,                                   // bInterval
@@ -890,13 +894,18 @@ void USBAudio::_receive_isr()
     assert_locked();
 
     uint32_t size = read_finish(_episo_out);
+    uint8_t *packet = _rx_packet_buf + _rx_packet_next * _rx_packet_size_max;
+
+    // Receive the next packet first, so the callbacks can't delay it
+    _rx_packet_next ^= 1;
+    read_start(_episo_out, _rx_packet_buf + _rx_packet_next * _rx_packet_size_max, _rx_packet_size_max);
 
     if (size > _rx_queue.free()) {
         _rx_overflow++;
     } else {
 
         // Copy data over
-        _rx_queue.write(_rx_packet_buf, size);
+        _rx_queue.write(packet, size);
 
         // Signal that there is more data available
         _read_list.process();
@@ -904,8 +913,6 @@ void USBAudio::_receive_isr()
             _rx_done.call(Transfer);
         }
     }
-
-    read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
 }
 
 void USBAudio::_send_change(ChannelState new_state)
@@ -955,7 +962,6 @@ void USBAudio::_send_isr_next_sync()
         _tx_frame_fract -= XFER_FREQUENCY_HZ;
         fames += 1;
     }
-    uint32_t send_size = fames * _tx_channel_count * 2;
 
     // Check if this is the initial TX packet
     if (_tx_idle && !_tx_queue.full()) {
@@ -963,6 +969,21 @@ void USBAudio::_send_isr_next_sync()
         return;
     }
 
+    /*  The frames are produced by the application clock, not the host one:
+     *  follow its rate as an asynchronous endpoint does, by sending a frame
+     *  more when the queue fills up and a frame less when it runs low */
+    if (!_tx_idle) {
+        uint32_t frame_size = _tx_channel_count * SAMPLE_SIZE;
+        uint32_t queued = _tx_queue.size() / frame_size;
+        uint32_t capacity = (_tx_queue.size() + _tx_queue.free()) / frame_size;
+        if (queued > capacity * 3 / 4) {
+            fames += 1;
+        } else if (queued < capacity / 4 && fames > 1) {
+            fames -= 1;
+        }
+    }
+    uint32_t send_size = fames * _tx_channel_count * 2;
+
     // Check if this stream was closed
     if (_tx_state != Opened) {
         _tx_idle = true;
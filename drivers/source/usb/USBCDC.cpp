@@ -36,6 +36,8 @@ static const uint8_t cdc_line_coding_default[7] = {0x80, 0x25, 0x00, 0x00, 0x00,
 
 #define CDC_MAX_PACKET_SIZE    64
 
+MBED_STATIC_ASSERT(MBED_CONF_DRIVERS_USB_CDC_RX_BUFFER_SIZE >= CDC_MAX_PACKET_SIZE, "The receive buffer must hold a packet");
+
 class USBCDC::AsyncWrite: public AsyncOp {
 public:
     AsyncWrite(USBCDC *serial, uint8_t *buf, uint32_t size):
@@ -182,6 +184,7 @@ void USBCDC::_init()
     _terminal_connected = false;
 
     _tx_in_progress = false;
+    _tx_zlp = false;
     _tx_buf = _tx_buffer;
     _tx_size = 0;
 
@@ -296,7 +299,9 @@ void USBCDC::callback_set_configuration(uint8_t configuration)
         endpoint_add(_bulk_in, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_send_isr);
         endpoint_add(_bulk_out, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_receive_isr);
 
-        read_start(_bulk_out, _rx_buf, sizeof(_rx_buffer));
+        _rx_buf = _rx_buffer;
+        _rx_size = 0;
+        read_start(_bulk_out, _rx_buffer, CDC_MAX_PACKET_SIZE);
         _rx_in_progress = true;
 
         ret = true;
@@ -322,6 +327,7 @@ void USBCDC::_change_terminal_connected(bool connected)
             endpoint_abort(_bulk_in);
             _tx_in_progress = false;
         }
+        _tx_zlp = false;
         _tx_buf = _tx_buffer;
         _tx_size = 0;
         _tx_list.process();
@@ -329,7 +335,7 @@ void USBCDC::_change_terminal_connected(bool connected)
 
         // Abort RX
         if (_rx_in_progress) {
-            endpoint_abort(_bulk_in);
+            endpoint_abort(_bulk_out);
             _rx_in_progress = false;
         }
         _rx_buf = _rx_buffer;
@@ -381,11 +387,12 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
     lock();
 
     *actual = 0;
-    if (_terminal_connected && !_tx_in_progress) {
+    if (_terminal_connected) {
+        // Appended to the transfer in progress, if any
         uint32_t free = sizeof(_tx_buffer) - _tx_size;
         uint32_t write_size = free > size ? size : free;
         if (size > 0) {
-            memcpy(_tx_buf, buffer, write_size);
+            memcpy(_tx_buffer + _tx_size, buffer, write_size);
         }
         _tx_size += write_size;
         *actual = write_size;
@@ -401,9 +408,17 @@ void USBCDC::_send_isr_start()
 {
     assert_locked();
 
-    if (!_tx_in_progress && _tx_size) {
-        if (USBDevice::write_start(_bulk_in, _tx_buffer, _tx_size)) {
+    if (_tx_in_progress) {
+        return;
+    }
+
+    uint32_t size = _tx_buffer + _tx_size - _tx_buf;
+    if (size || _tx_zlp) {
+        // A transfer ending with a full packet is terminated by a zero length one
+        size = size > CDC_MAX_PACKET_SIZE ? CDC_MAX_PACKET_SIZE : size;
+        if (USBDevice::write_start(_bulk_in, _tx_buf, size)) {
             _tx_in_progress = true;
+            _tx_zlp = false;
         }
     }
 }
@@ -416,11 +431,18 @@ void USBCDC::_send_isr()
 {
     assert_locked();
 
-    write_finish(_bulk_in);
-    _tx_buf = _tx_buffer;
-    _tx_size = 0;
+    uint32_t sent = write_finish(_bulk_in);
+    _tx_buf += sent;
     _tx_in_progress = false;
 
+    if (_tx_buf == _tx_buffer + _tx_size) {
+        // The transfer is over, unless the last packet was full
+        _tx_zlp = (sent == CDC_MAX_PACKET_SIZE);
+        _tx_buf = _tx_buffer;
+        _tx_size = 0;
+    }
+    _send_isr_start();
+
     _tx_list.process();
     if (!_tx_in_progress) {
         data_tx();
@@ -448,26 +470,34 @@ void USBCDC::receive_nb(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
 {
 
     *size_read = 0;
-    if (_terminal_connected && !_rx_in_progress) {
-        // Copy data over
+    if (_terminal_connected) {
+        // Copy all the packets received so far, up to size
         uint32_t copy_size = _rx_size > size ? size : _rx_size;
         memcpy(buffer, _rx_buf, copy_size);
         *size_read = copy_size;
         _rx_buf += copy_size;
         _rx_size -= copy_size;
-        if (_rx_size == 0) {
-            _receive_isr_start();
-        }
+        _receive_isr_start();
     }
 }
 
 void USBCDC::_receive_isr_start()
 {
-    if ((_rx_size == 0) && !_rx_in_progress) {
-        // Refill the buffer
-        _rx_in_progress = true;
-        read_start(_bulk_out, _rx_buffer, sizeof(_rx_buffer));
+    if (_rx_in_progress) {
+        return;
     }
+
+    // Make room for the next packet
+    if (_rx_buf + _rx_size + CDC_MAX_PACKET_SIZE > _rx_buffer + sizeof(_rx_buffer)) {
+        if (_rx_buf == _rx_buffer) {
+            // Full, wait for the data to be read
+            return;
+        }
+        memmove(_rx_buffer, _rx_buf, _rx_size);
+        _rx_buf = _rx_buffer;
+    }
+    _rx_in_progress = true;
+    read_start(_bulk_out, _rx_buf + _rx_size, CDC_MAX_PACKET_SIZE);
 }
 
 /*
@@ -478,12 +508,15 @@ void USBCDC::_receive_isr()
 {
     assert_locked();
 
-    MBED_ASSERT(_rx_size == 0);
-    _rx_buf = _rx_buffer;
-    _rx_size = read_finish(_bulk_out);
+    _rx_size += read_finish(_bulk_out);
     _rx_in_progress = false;
+    if (_rx_size == 0) {
+        _rx_buf = _rx_buffer;
+    }
+    // Keep receiving while the data waits to be read
+    _receive_isr_start();
     _rx_list.process();
-    if (!_rx_in_progress) {
+    if (_rx_size) {
         data_rx();
     }
 
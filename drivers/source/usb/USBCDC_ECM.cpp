@@ -43,7 +43,7 @@
 #define LINK_SPEED                  (10000000)
 
 USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _rx_buf(NULL), _rx_held(false), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
 {
     _init();
 
@@ -57,7 +57,7 @@ USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t produ
 }
 
 USBCDC_ECM::USBCDC_ECM(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(phy, vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(phy, vendor_id, product_id, product_release), _rx_buf(NULL), _rx_held(false), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
 {
 
     _init();
@@ -233,6 +233,23 @@ bool USBCDC_ECM::send(uint8_t *buffer, uint32_t size)
     return ret;
 }
 
+void USBCDC_ECM::write_lock()
+{
+    _write_mutex.lock();
+}
+
+void USBCDC_ECM::write_unlock()
+{
+    _write_mutex.unlock();
+}
+
+bool USBCDC_ECM::write_packet(const uint8_t *buffer, uint32_t size)
+{
+    MBED_ASSERT(size <= MAX_PACKET_SIZE_BULK);
+
+    return _write_bulk(const_cast<uint8_t *>(buffer), size);
+}
+
 void USBCDC_ECM::receive_nb(uint8_t *buffer, uint32_t size, uint32_t *actual)
 {
     lock();
@@ -322,7 +339,8 @@ void USBCDC_ECM::callback_set_interface(uint16_t interface, uint8_t alternate)
         endpoint_add(_bulk_in, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_in_callback);
         endpoint_add(_bulk_out, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_out_callback);
 
-        read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
+        _rx_held = false;
+        _rx_start();
 
         _queue.call(static_cast<USBCDC_ECM *>(this), &USBCDC_ECM::_notify_connect);
     }
@@ -341,6 +359,7 @@ void USBCDC_ECM::callback_state_change(DeviceState new_state)
     } else {
         _flags.set(FLAG_DISCONNECT);
         _flags.clear(FLAG_CONNECT | FLAG_WRITE_DONE | FLAG_INT_DONE);
+        _rx_held = false;
     }
 }
 
@@ -543,17 +562,53 @@ void USBCDC_ECM::_bulk_out_callback()
     assert_locked();
 
     uint32_t read_size = read_finish(_bulk_out);
+    bool end = read_size < USBDevice::endpoint_max_packet_size(_bulk_out);
+
+    callback_rx_packet(_rx_buf, read_size, end);
+    _rx_start();
+}
+
+void USBCDC_ECM::_rx_start()
+{
+    assert_locked();
+
+    _rx_buf = rx_buffer();
+    if (_rx_buf) {
+        read_start(_bulk_out, _rx_buf, MAX_PACKET_SIZE_BULK);
+    } else {
+        _rx_held = true;
+    }
+}
+
+void USBCDC_ECM::restart_rx()
+{
+    lock();
+
+    if (_rx_held) {
+        _rx_held = false;
+        _rx_start();
+    }
+
+    unlock();
+}
+
+uint8_t *USBCDC_ECM::rx_buffer()
+{
+    return _bulk_buf;
+}
 
-    if (read_size <= _rx_queue.free()) {
+void USBCDC_ECM::callback_rx_packet(uint8_t *buffer, uint32_t size, bool end)
+{
+    assert_locked();
+
+    if (size <= _rx_queue.free()) {
         // Copy data over
-        _rx_queue.write(_bulk_buf, read_size);
+        _rx_queue.write(buffer, size);
     }
 
     // Signal that there is ethernet packet available
-    if (_callback_rx && (read_size < USBDevice::endpoint_max_packet_size(_bulk_out))) {
+    if (_callback_rx && end) {
         _callback_rx();
     }
-
-    read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
 }
 #endif // defined(MBED_CONF_RTOS_PRESENT)
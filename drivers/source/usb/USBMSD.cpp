@@ -58,6 +58,10 @@
 // max packet size
 #define MAX_PACKET  64
 
+#ifndef MBED_CONF_DRIVERS_USB_MSD_BUFFER_BLOCKS
+#define MBED_CONF_DRIVERS_USB_MSD_BUFFER_BLOCKS 8
+#endif
+
 // CSW Status
 enum Status {
     CSW_PASSED,
@@ -68,7 +72,8 @@ enum Status {
 USBMSD::USBMSD(BlockDevice *bd, bool connect_blocking, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
     : USBDevice(get_usb_phy(), vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
-      _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
+      _addr(0), _length(0), _mem_ok(false), _page_blocks(0), _page_addr(0), _page_valid(0),
+      _block_size(0), _memory_size(0), _block_count(0),
       _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
@@ -84,7 +89,8 @@ USBMSD::USBMSD(BlockDevice *bd, bool connect_blocking, uint16_t vendor_id, uint1
 USBMSD::USBMSD(USBPhy *phy, BlockDevice *bd, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
     : USBDevice(phy, vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
-      _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
+      _addr(0), _length(0), _mem_ok(false), _page_blocks(0), _page_addr(0), _page_valid(0),
+      _block_size(0), _memory_size(0), _block_count(0),
       _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
@@ -154,7 +160,14 @@ bool USBMSD::connect()
         _block_size = _memory_size / _block_count;
         if (_block_size != 0) {
             free(_page);
-            _page = (uint8_t *)malloc(_block_size * sizeof(uint8_t));
+            // Several blocks per access to the block device, or at least one
+            _page_blocks = MBED_CONF_DRIVERS_USB_MSD_BUFFER_BLOCKS;
+            _page = (uint8_t *)malloc(_page_blocks * _block_size * sizeof(uint8_t));
+            if (_page == NULL) {
+                _page_blocks = 1;
+                _page = (uint8_t *)malloc(_block_size * sizeof(uint8_t));
+            }
+            _page_valid = 0;
             if (_page == NULL) {
                 _mutex.unlock();
                 _mutex_init.unlock();
@@ -586,22 +599,24 @@ void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
         endpoint_stall(_bulk_out);
     }
 
-    // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++) {
-        _page[_addr % _block_size + i] = buf[i];
-    }
-
-    // if the array is filled, write it in memory
-    if (!((_addr + size) % _block_size)) {
-        if (!(disk_status() & WRITE_PROTECT)) {
-            disk_write(_page, _addr / _block_size, 1);
-        }
-    }
+    // we fill an array in RAM of up to _page_blocks blocks before writing it in memory
+    memcpy(&_page[_page_valid], buf, size);
+    _page_valid += size;
 
     _addr += size;
     _length -= size;
     _csw.DataResidue -= size;
 
+    // if the array is filled, or the transfer over, write its whole blocks in memory
+    if ((_page_valid == _page_blocks * _block_size) || (!_length) || (_stage != PROCESS_CBW)) {
+        uint32_t blocks = _page_valid / _block_size;
+        if (blocks && !(disk_status() & WRITE_PROTECT)) {
+            disk_write(_page, _page_addr / _block_size, blocks);
+        }
+        _page_addr += _page_valid;
+        _page_valid = 0;
+    }
+
     if ((!_length) || (_stage != PROCESS_CBW)) {
         _csw.Status = (_stage == ERROR) ? CSW_FAILED : CSW_PASSED;
         sendCSW();
@@ -890,13 +905,19 @@ void USBMSD::memoryRead(void)
     }
 
     if (n > 0) {
-        // we read an entire block
-        if (!(_addr % _block_size)) {
-            disk_read(_page, _addr / _block_size, 1);
+        // we read as many blocks as the array holds, at most the ones left
+        if (_addr >= _page_addr + _page_valid) {
+            uint32_t blocks = _length / _block_size;
+            if (blocks > _page_blocks) {
+                blocks = _page_blocks;
+            }
+            disk_read(_page, _addr / _block_size, blocks);
+            _page_addr = _addr;
+            _page_valid = blocks * _block_size;
         }
 
         // write data which are in RAM
-        _write_next(&_page[_addr % _block_size], MAX_PACKET);
+        _write_next(&_page[_addr - _page_addr], MAX_PACKET);
 
         _addr += n;
         _length -= n;
@@ -920,6 +941,10 @@ bool USBMSD::infoTransfer(void)
 
     _addr = addr_block * _block_size;
 
+    // The array starts empty at the first block of each transfer
+    _page_addr = _addr;
+    _page_valid = 0;
+
     if ((addr_block >= _block_count) || (_addr >= _memory_size)) {
         _csw.Status = CSW_FAILED;
         sendCSW();
@@ -16,6 +16,7 @@
  */
 
 #include "stdint.h"
+#include <errno.h>
 #include "USBSerial.h"
 #include "usb_phy_api.h"
 
@@ -63,6 +64,23 @@ int USBSerial::_getc()
     }
 }
 
+ssize_t USBSerial::write(const void *buffer, size_t size)
+{
+    if (!send((uint8_t *)buffer, size)) {
+        return -EIO;
+    }
+    return size;
+}
+
+ssize_t USBSerial::read(void *buffer, size_t size)
+{
+    uint32_t size_read = 0;
+    if (size && !receive((uint8_t *)buffer, size, &size_read)) {
+        return -EIO;
+    }
+    return size_read;
+}
+
 void USBSerial::data_rx()
 {
     assert_locked();
@@ -77,10 +95,7 @@ uint8_t USBSerial::available()
 {
     USBCDC::lock();
 
-    uint8_t size = 0;
-    if (!_rx_in_progress) {
-        size = _rx_size > 0xFF ? 0xFF : _rx_size;
-    }
+    uint8_t size = _rx_size > 0xFF ? 0xFF : _rx_size;
 
     USBCDC::unlock();
     return size;
@@ -159,6 +159,11 @@ void test_mode_limit()
         TEST_ASSERT_EQUAL(0, ct.compute(test, strlen(test), &crc));
         TEST_ASSERT_EQUAL(0xCBF43926, crc);
     }
+    {
+        MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICED> ct;
+        TEST_ASSERT_EQUAL(0, ct.compute(test, strlen(test), &crc));
+        TEST_ASSERT_EQUAL(0xCBF43926, crc);
+    }
     {
         MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::HARDWARE> ct;
         TEST_ASSERT_EQUAL(0, ct.compute(test, strlen(test), &crc));
@@ -205,6 +210,61 @@ void test_sd_crc()
     TEST_ASSERT_EQUAL(0x7FA1, crc);
 }
 
+void test_large_buffer()
+{
+    static uint8_t test[1027];
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < sizeof test; i++) {
+        seed = seed * 1103515245 + 12345;
+        test[i] = seed >> 24;
+    }
+
+    // unaligned starts and splits, with a block large enough for DMA feeding
+    for (size_t offset = 0; offset < 4; offset++) {
+        const size_t size = sizeof test - offset;
+        uint32_t expected, crc;
+        {
+            MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> ref;
+            MbedCRC<POLY_32BIT_ANSI, 32> ct;
+            TEST_ASSERT_EQUAL(0, ref.compute(&test[offset], size, &expected));
+            TEST_ASSERT_EQUAL(0, ct.compute(&test[offset], size, &crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+
+            TEST_ASSERT_EQUAL(0, ct.compute_partial_start(&crc));
+            TEST_ASSERT_EQUAL(0, ct.compute_partial(&test[offset], 7, &crc));
+            TEST_ASSERT_EQUAL(0, ct.compute_partial(&test[offset + 7], size - 7, &crc));
+            TEST_ASSERT_EQUAL(0, ct.compute_partial_stop(&crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+        }
+        {
+            MbedCRC<POLY_16BIT_CCITT, 16, CrcMode::BITWISE> ref(0xFFFF, 0, false, false);
+            MbedCRC<POLY_16BIT_CCITT, 16> ct(0xFFFF, 0, false, false);
+            TEST_ASSERT_EQUAL(0, ref.compute(&test[offset], size, &expected));
+            TEST_ASSERT_EQUAL(0, ct.compute(&test[offset], size, &crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+        }
+        {
+            MbedCRC<POLY_16BIT_CCITT, 16, CrcMode::SLICED> ct(0xFFFF, 0, false, false);
+            TEST_ASSERT_EQUAL(0, ct.compute(&test[offset], size, &crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+        }
+        {
+            MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::BITWISE> ref(0, 0, true, false);
+            MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICED> ct(0, 0, true, false);
+            TEST_ASSERT_EQUAL(0, ref.compute(&test[offset], size, &expected));
+            TEST_ASSERT_EQUAL(0, ct.compute(&test[offset], size, &crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+        }
+        {
+            MbedCRC<POLY_8BIT_CCITT, 8, CrcMode::BITWISE> ref(0, 0xFF, true, false);
+            MbedCRC<POLY_8BIT_CCITT, 8> ct(0, 0xFF, true, false);
+            TEST_ASSERT_EQUAL(0, ref.compute(&test[offset], size, &expected));
+            TEST_ASSERT_EQUAL(0, ct.compute(&test[offset], size, &crc));
+            TEST_ASSERT_EQUAL_HEX32(expected, crc);
+        }
+    }
+}
+
 void test_any_polynomial()
 {
     char  test[] = "123456789";
@@ -257,6 +317,7 @@ Case cases[] = {
     Case("Test partial CRC", test_partial_crc),
     Case("Test mode-limited CRC", test_mode_limit),
     Case("Test SD CRC polynomials", test_sd_crc),
+    Case("Test large unaligned buffers", test_large_buffer),
 #if defined(MBED_CONF_RTOS_PRESENT)
     Case("Test thread safety", test_thread_safety),
 #endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include "drivers/MbedCRC.h"
+#include <vector>
+
+using namespace mbed;
+
+#define SMALL_SIZE  (1 << 10)
+#define LARGE_SIZE  (1 << 14)
+
+class TestMbedCRCPerf : public testing::Test {
+protected:
+    std::vector<uint8_t> data;
+
+    virtual void SetUp()
+    {
+        data.resize(LARGE_SIZE);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = i * 31 + 7;
+        }
+    }
+
+    // Time a CRC over the buffer, byte by byte, and check it does not depend on the mode
+    template <uint32_t polynomial, uint8_t width, CrcMode mode>
+    double time_crc(const char *name, uint32_t expected)
+    {
+        MbedCRC<polynomial, width, mode> ct;
+        uint32_t crc = 0;
+        auto workload = [this, &ct, &crc](size_t bytes) {
+            EXPECT_EQ(0, ct.compute(data.data(), bytes, &crc));
+        };
+
+        EXPECT_TRUE(perf::scales_linearly(name, SMALL_SIZE, LARGE_SIZE, workload));
+        ct.compute(data.data(), LARGE_SIZE, &crc);
+        EXPECT_EQ(expected, crc);
+        return perf::ns_per_item(LARGE_SIZE, workload);
+    }
+};
+
+TEST_F(TestMbedCRCPerf, crc32_modes)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::BITWISE> bitwise;
+    uint32_t expected;
+    bitwise.compute(data.data(), LARGE_SIZE, &expected);
+
+    double bitwise_ns = time_crc<POLY_32BIT_ANSI, 32, CrcMode::BITWISE>("crc32_bitwise", expected);
+    double table_ns = time_crc<POLY_32BIT_ANSI, 32, CrcMode::TABLE>("crc32_table", expected);
+    double sliced_ns = time_crc<POLY_32BIT_ANSI, 32, CrcMode::SLICED>("crc32_sliced", expected);
+
+    // A table mode falling back to the bitwise computation is a regression
+    EXPECT_LT(table_ns, bitwise_ns);
+    EXPECT_LT(sliced_ns, bitwise_ns);
+}
+
+TEST_F(TestMbedCRCPerf, crc16_modes)
+{
+    MbedCRC<POLY_16BIT_CCITT, 16, CrcMode::BITWISE> bitwise;
+    uint32_t expected;
+    bitwise.compute(data.data(), LARGE_SIZE, &expected);
+
+    double bitwise_ns = time_crc<POLY_16BIT_CCITT, 16, CrcMode::BITWISE>("crc16_bitwise", expected);
+    double table_ns = time_crc<POLY_16BIT_CCITT, 16, CrcMode::TABLE>("crc16_table", expected);
+    double sliced_ns = time_crc<POLY_16BIT_CCITT, 16, CrcMode::SLICED>("crc16_sliced", expected);
+
+    EXPECT_LT(table_ns, bitwise_ns);
+    EXPECT_LT(sliced_ns, bitwise_ns);
+}
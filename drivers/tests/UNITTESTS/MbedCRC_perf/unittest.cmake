@@ -0,0 +1,24 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../drivers/source/MbedCRC.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ../drivers/tests/UNITTESTS/MbedCRC_perf/test_MbedCRC_perf.cpp
+  stubs/mbed_assert_stub.cpp
+)
+
+set(unittest-test-flags
+  -DMBED_CRC_TABLE_SIZE=256
+  -DMBED_CRC_SLICES=8
+)
+
+set(unittest-test-labels
+  perf
+)
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "drivers/SPI.h"
+#include "spi_api_stub.h"
+
+using namespace mbed;
+
+void sleep_manager_unlock_deep_sleep(void)
+{
+}
+
+void sleep_manager_lock_deep_sleep(void)
+{
+}
+
+static void transfer_done(int event)
+{
+}
+
+class TestSPI : public testing::Test {
+protected:
+    SPI *spi;
+
+    void SetUp()
+    {
+        spi = new SPI(PTC0, PTC1, PTC0);
+        memset(&spi_api_stub, 0, sizeof(spi_api_stub));
+    }
+
+    void TearDown()
+    {
+        delete spi;
+    }
+};
+
+/** Test that a burst read transmits its own buffer, filled with the default SPI value
+ *
+ *  Given an SPI.
+ *  When a burst without TX buffer is started.
+ *  Then the RX buffer is filled with the default SPI value and transmitted, the lengths matching.
+ */
+TEST_F(TestSPI, test_transfer_burst_read)
+{
+    uint8_t rx[8];
+    memset(rx, 0x5A, sizeof(rx));
+
+    EXPECT_EQ(0, spi->transfer_burst(NULL, rx, sizeof(rx), transfer_done));
+    EXPECT_EQ(1, spi_api_stub.transfer_count);
+    EXPECT_EQ(rx, spi_api_stub.tx);
+    EXPECT_EQ(rx, spi_api_stub.rx);
+    EXPECT_EQ(sizeof(rx), spi_api_stub.tx_length);
+    EXPECT_EQ(sizeof(rx), spi_api_stub.rx_length);
+    for (size_t i = 0; i < sizeof(rx); i++) {
+        EXPECT_EQ(SPI_FILL_CHAR, rx[i]);
+    }
+
+    spi->set_default_write_value(0x00);
+    EXPECT_EQ(0, spi->transfer_burst(NULL, rx, sizeof(rx), transfer_done));
+    for (size_t i = 0; i < sizeof(rx); i++) {
+        EXPECT_EQ(0x00, rx[i]);
+    }
+}
+
+/** Test that a burst write receives nothing
+ *
+ *  Given an SPI.
+ *  When a burst without RX buffer is started.
+ *  Then the TX buffer is transmitted and left unchanged, with no RX length.
+ */
+TEST_F(TestSPI, test_transfer_burst_write)
+{
+    const uint8_t tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+    EXPECT_EQ(0, spi->transfer_burst(tx, NULL, sizeof(tx), transfer_done));
+    EXPECT_EQ(1, spi_api_stub.transfer_count);
+    EXPECT_EQ(tx, spi_api_stub.tx);
+    EXPECT_EQ(NULL, spi_api_stub.rx);
+    EXPECT_EQ(sizeof(tx), spi_api_stub.tx_length);
+    EXPECT_EQ(0u, spi_api_stub.rx_length);
+    EXPECT_EQ(0x01, tx[0]);
+    EXPECT_EQ(0x04, tx[3]);
+}
+
+/** Test that a full duplex burst transfers both buffers
+ *
+ *  Given an SPI.
+ *  When a burst with both buffers is started.
+ *  Then both are passed with the same length, the TX buffer sent as is.
+ */
+TEST_F(TestSPI, test_transfer_burst_duplex)
+{
+    const uint8_t tx[4] = {0x01, 0x02, 0x03, 0x04};
+    uint8_t rx[4] = {0};
+
+    EXPECT_EQ(0, spi->transfer_burst(tx, rx, sizeof(rx), transfer_done));
+    EXPECT_EQ(tx, spi_api_stub.tx);
+    EXPECT_EQ(rx, spi_api_stub.rx);
+    EXPECT_EQ(sizeof(tx), spi_api_stub.tx_length);
+    EXPECT_EQ(sizeof(rx), spi_api_stub.rx_length);
+}
@@ -0,0 +1,31 @@
+
+####################
+# UNIT TESTS
+####################
+set(TEST_SUITE_NAME "SPI")
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  .
+  ../hal
+)
+
+# Source files
+set(unittest-sources
+  ../drivers/source/SPI.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ../drivers/tests/UNITTESTS/SPI/test_spi.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/Mutex_stub.cpp
+  stubs/gpio_api_stub.c
+  stubs/spi_api_stub.c
+)
+
+set(unittest-test-flags
+  -DDEVICE_SPI
+  -DDEVICE_SPI_ASYNCH
+)
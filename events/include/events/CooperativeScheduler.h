@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COOPERATIVE_SCHEDULER_H
+#define COOPERATIVE_SCHEDULER_H
+
+#include "events/EventQueue.h"
+#include "events/UserAllocatedEvent.h"
+#include "events/internal/equeue_platform.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+// Defaults of the configuration, for builds without it
+#ifndef MBED_CONF_EVENTS_COOPERATIVE_EVENTSIZE
+#define MBED_CONF_EVENTS_COOPERATIVE_EVENTSIZE 256
+#endif
+
+#ifndef MBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES
+#define MBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES 6
+#endif
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_CooperativeScheduler CooperativeScheduler class
+ * @{
+ */
+
+/** CooperativeScheduler
+ *
+ *  Run-to-completion scheduler of event queues for the bare-metal profile,
+ *  where there are no threads to give work different priorities. main
+ *  hands over to run, which dispatches the queues that have events due by
+ *  priority level and sleeps, deep sleep permitting, until the next one is
+ *  due or an interrupt posts an event.
+ *
+ *  Each level has its own queue of MBED_CONF_EVENTS_COOPERATIVE_EVENTSIZE
+ *  bytes, and existing queues such as mbed_event_queue() can be attached
+ *  at a level. Between two batches of events, the highest level with
+ *  events due runs first. Events are not preempted: keep them short, they
+ *  hold up the other levels.
+ *
+ *  Delays are timed by the OS timer, which runs on the low power ticker
+ *  when the target has one, so the device can deep sleep until the next
+ *  timed event.
+ *
+ *  Interrupt handlers, such as FileHandle::sigio, post to a level through
+ *  a Signal, coalescing the interrupts that fire before it runs.
+ *
+ *  @note Synchronization level: run must be called from a single context.
+ *        Events can be posted and signals raised from interrupts.
+ *
+ *  Example:
+ *  @code
+ *  CooperativeScheduler scheduler;
+ *  BufferedSerial serial(USBTX, USBRX);
+ *
+ *  void on_serial()
+ *  {
+ *      char c;
+ *      while (serial.readable() && serial.read(&c, 1) == 1) {
+ *          // ...
+ *      }
+ *  }
+ *
+ *  int main()
+ *  {
+ *      CooperativeScheduler::Signal serial_signal(&scheduler, on_serial, CooperativeScheduler::PriorityHigh);
+ *      serial.set_blocking(false);
+ *      serial.sigio(callback(&serial_signal, &CooperativeScheduler::Signal::raise));
+ *
+ *      scheduler.queue(CooperativeScheduler::PriorityLow)->call_every(1s, blink);
+ *      scheduler.attach(mbed_event_queue(), CooperativeScheduler::PriorityNormal);
+ *      scheduler.run();
+ *  }
+ *  @endcode
+ */
+class CooperativeScheduler : private mbed::NonCopyable<CooperativeScheduler> {
+public:
+    /** Priority levels */
+    enum Priority {
+        PriorityHigh,
+        PriorityNormal,
+        PriorityLow,
+    };
+
+    /** Coalesced notification from interrupts
+     *
+     *  Raising a signal posts its function to a level of the scheduler,
+     *  unless it is already pending: the function should handle everything
+     *  that is ready. Posting never allocates.
+     */
+    class Signal : private mbed::NonCopyable<Signal> {
+    public:
+        /** Create a signal
+         *
+         *  @param scheduler    Scheduler running the function
+         *  @param func         Function run once raised
+         *  @param priority     Level the function runs at
+         */
+        Signal(CooperativeScheduler *scheduler, mbed::Callback<void()> func, Priority priority = PriorityNormal)
+            : _event(scheduler->queue(priority), func)
+        {
+        }
+
+        /** Raise the signal
+         *
+         *  @note Can be called from interrupt context
+         */
+        void raise()
+        {
+            _event.try_call();
+        }
+
+        /** Cancel the signal if it is pending
+         */
+        void cancel()
+        {
+            _event.cancel();
+        }
+
+    private:
+        UserAllocatedEvent<mbed::Callback<void()>, void()> _event;
+    };
+
+    /** Create a scheduler
+     */
+    CooperativeScheduler();
+
+    /** Destroy the scheduler, detaching the attached queues
+     */
+    ~CooperativeScheduler();
+
+    /** Get the queue of a level
+     *
+     *  @param priority     Level
+     *  @return             Queue dispatched at that level
+     */
+    EventQueue *queue(Priority priority);
+
+    /** Dispatch an event queue at a level
+     *
+     *  The queue is backgrounded onto the scheduler, it must not be
+     *  dispatched elsewhere nor backgrounded or chained to another one
+     *  until detached.
+     *
+     *  @param queue        Queue to dispatch
+     *  @param priority     Level of its events
+     *  @return             0 on success, -ENOMEM if the
+     *                      MBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES queues,
+     *                      including the one of each level, are in use
+     */
+    int attach(EventQueue *queue, Priority priority);
+
+    /** Stop dispatching an attached queue
+     *
+     *  @param queue        Queue to detach
+     */
+    void detach(EventQueue *queue);
+
+    /** Dispatch events until break_dispatch is called
+     */
+    void run()
+    {
+        run_for(-1);
+    }
+
+    /** Dispatch events for a given time
+     *
+     *  @param ms           Time to dispatch for in milliseconds, 0 to run
+     *                      the events due only, negative to run until
+     *                      break_dispatch is called
+     */
+    void run_for(int ms);
+
+    /** Return from run once the current event completes
+     *
+     *  @note Can be called from interrupt context
+     */
+    void break_dispatch();
+
+private:
+    struct slot_t {
+        CooperativeScheduler *scheduler;
+        EventQueue *queue;
+        Priority priority;
+        volatile bool armed;
+        volatile unsigned wakeup;
+
+        void update(int ms);
+    };
+
+    slot_t *next_due(unsigned tick, int *deadline);
+    void wake();
+
+    unsigned char _buffers[PriorityLow + 1][MBED_CONF_EVENTS_COOPERATIVE_EVENTSIZE];
+    EventQueue _high;
+    EventQueue _normal;
+    EventQueue _low;
+
+    // Queues of the levels first, then the attached ones. Unused slots
+    // have no queue.
+    slot_t _slots[MBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES];
+
+    equeue_sema_t _sema;
+    volatile bool _break_requested;
+};
+
+/** @}*/
+/** @}*/
+}
+
+#endif
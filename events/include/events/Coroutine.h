@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENTS_COROUTINE_H
+#define EVENTS_COROUTINE_H
+
+#include <chrono>
+#include <stdint.h>
+#include "events/EventQueue.h"
+#include "events/UserAllocatedEvent.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/EventFlags.h"
+#endif
+
+namespace mbed {
+class FileHandle;
+}
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_Coroutine Coroutine class
+ * @{
+ */
+
+/** Start the body of Coroutine::run() */
+#define MBED_CO_BEGIN()     switch (_co_line) { case 0:
+
+/** Suspend Coroutine::run() until an asynchronous operation completes
+ *
+ *  op starts the operation and returns 0 once it is started, its completion
+ *  resumes the coroutine after the macro. Any other value means it is done
+ *  or failed, the coroutine goes on without suspending. In both cases
+ *  result() gives the outcome.
+ *
+ *  @note At most one MBED_CO_AWAIT per source line.
+ */
+#define MBED_CO_AWAIT(op) \
+    do { \
+        _co_line = __LINE__; \
+        await_begin(); \
+        if (await_end(op)) { \
+            return; \
+        } \
+        case __LINE__:; \
+    } while (0)
+
+/** Let the other events of the queue run, then resume Coroutine::run() */
+#define MBED_CO_YIELD()     MBED_CO_AWAIT(yield())
+
+/** End the body of Coroutine::run() */
+#define MBED_CO_END()       } finish()
+
+/** Coroutine
+ *
+ *  Stackless coroutine run by an EventQueue. The body of run() is written
+ *  as straight-line code between MBED_CO_BEGIN() and MBED_CO_END(). Each
+ *  MBED_CO_AWAIT() returns from run() while an operation is pending, and
+ *  its completion posts run() again, going on after the await. Many
+ *  coroutines share the stack of the thread dispatching the queue instead
+ *  of each blocking a thread.
+ *
+ *  As run() returns at each await, local variables don't survive across
+ *  awaits: keep the state of the coroutine in members of the derived class.
+ *
+ *  Awaitables are functions returning 0 once an operation has started: the
+ *  ones of Coroutine for time, file handles and event flags, and the
+ *  asynchronous driver calls that take an event_callback_t, given
+ *  completion():
+ *
+ *  @code
+ *  class SensorReader : public Coroutine {
+ *  public:
+ *      SensorReader(EventQueue *queue, SPI &spi) : Coroutine(queue), _spi(spi) { }
+ *
+ *  private:
+ *      void run() override
+ *      {
+ *          MBED_CO_BEGIN();
+ *          for (_count = 0; _count < 10; _count++) {
+ *              MBED_CO_AWAIT(_spi.transfer(_tx, 4, _rx, 4, completion()));
+ *              if (result() & SPI_EVENT_COMPLETE) {
+ *                  process(_rx);
+ *              }
+ *              MBED_CO_AWAIT(sleep_for(100ms));
+ *          }
+ *          MBED_CO_END();
+ *      }
+ *
+ *      SPI &_spi;
+ *      int _count;
+ *      uint8_t _tx[4], _rx[4];
+ *  };
+ *
+ *  SensorReader reader(mbed_event_queue(), spi);
+ *  reader.start();
+ *  @endcode
+ *
+ *  @note Synchronization level: Not protected, resume() is IRQ safe
+ */
+class Coroutine : private mbed::NonCopyable<Coroutine> {
+public:
+    /** Create a coroutine run by an event queue
+     *
+     *  @param queue    Event queue dispatching the coroutine
+     */
+    Coroutine(EventQueue *queue);
+
+    /** Destroy a coroutine
+     *
+     *  Cancels its pending resumption, it must not be running.
+     */
+    virtual ~Coroutine();
+
+    /** Start the coroutine from the beginning of run()
+     *
+     *  @param done     Called on the queue once run() reaches MBED_CO_END()
+     *  @return         False if the coroutine is already running
+     */
+    bool start(mbed::Callback<void()> done = nullptr);
+
+    /** Check if the coroutine has started and not reached MBED_CO_END()
+     *
+     *  @return True while running
+     */
+    bool running() const
+    {
+        return _started;
+    }
+
+    /** Resume the coroutine waiting for an operation
+     *
+     *  Completion of custom awaitables. Does nothing if the coroutine isn't
+     *  waiting, so spurious calls are harmless.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param result   Outcome of the operation, returned by result()
+     */
+    void resume(int result = 0);
+
+protected:
+    /** Body of the coroutine, between MBED_CO_BEGIN() and MBED_CO_END() */
+    virtual void run() = 0;
+
+    /** Outcome of the last MBED_CO_AWAIT()
+     *
+     *  The event of a driver completion(), the flags of wait_flags(), or
+     *  the value returned by an awaitable that didn't suspend.
+     */
+    int result() const
+    {
+        return _result;
+    }
+
+    /** Completion callback for the asynchronous driver calls
+     *
+     *  For the event_callback_t of SPI::transfer, I2C::transfer or
+     *  SerialBase::read: result() is the event.
+     */
+    mbed::Callback<void(int)> completion()
+    {
+        return mbed::callback(this, &Coroutine::resume);
+    }
+
+    /** Awaitable waiting for a duration
+     *
+     *  @param rel_time Time to wait
+     *  @return         0
+     */
+    int sleep_for(std::chrono::milliseconds rel_time);
+
+    /** Awaitable letting the events already queued run
+     *
+     *  @return         0
+     */
+    int yield()
+    {
+        return sleep_for(std::chrono::milliseconds(0));
+    }
+
+    /** Awaitable waiting for a file handle, such as a BufferedSerial, to be readable
+     *
+     *  The coroutine is resumed on a sigio of the file handle, which may be
+     *  for another change of state: await it in a loop with non-blocking
+     *  reads. The sigio callback of the file handle is used while waiting.
+     *
+     *  @param fh       File handle
+     *  @return         0, or 1 if the file handle is already readable
+     */
+    int wait_readable(mbed::FileHandle &fh);
+
+#if MBED_CONF_RTOS_PRESENT
+    /** Awaitable waiting for any of a set of event flags
+     *
+     *  EventFlags only wake threads, so the flags are polled from the event
+     *  queue. They aren't cleared: result() gives all the flags set.
+     *
+     *  @param flags    Event flags
+     *  @param mask     Flags to wait for
+     *  @param poll     Polling period
+     *  @return         0, or the flags if some of mask are already set
+     */
+    int wait_flags(rtos::EventFlags &flags, uint32_t mask, std::chrono::milliseconds poll = std::chrono::milliseconds(1));
+#endif
+
+    /** Used by MBED_CO_AWAIT() */
+    void await_begin();
+
+    /** Used by MBED_CO_AWAIT() */
+    bool await_end(int status);
+
+    /** Used by MBED_CO_END() */
+    void finish();
+
+    /** Resumption point of run(), used by the MBED_CO macros */
+    int _co_line;
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    typedef UserAllocatedEvent<mbed::Callback<void()>, void()> step_event;
+
+    void post(int delay);
+    void step();
+    void on_sigio();
+
+    // Alternated, as an event can't be posted again while it runs
+    step_event _steps[2];
+    uint8_t _next_step;
+    volatile bool _waiting;
+    bool _started;
+    int _result;
+    mbed::Callback<void()> _done;
+    mbed::FileHandle *_fh;
+#if MBED_CONF_RTOS_PRESENT
+    rtos::EventFlags *_flags;
+    uint32_t _flags_mask;
+    int _flags_poll;
+#endif
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
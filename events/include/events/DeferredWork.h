@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+#include <stdint.h>
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_DeferredWork DeferredWork class
+ * @{
+ */
+
+/** DeferredWork
+ *
+ *  Bottom half of an interrupt handler: a work item that the handler
+ *  schedules, to be run soon after in thread context. All the work items
+ *  are run by a single thread of priority events.deferred-work-priority,
+ *  above the shared event queues, so their latency doesn't depend on
+ *  unrelated events.
+ *
+ *  Work items have one of three priority levels. Once the current item
+ *  returns, the oldest pending item of the highest level runs next.
+ *  Scheduling an item that is already pending does nothing, so an
+ *  interrupt firing again before its work has run is coalesced: the work
+ *  should handle everything that is ready.
+ *
+ *  Work items are allocated by their owner, scheduling never allocates.
+ *  Keep them short, they hold up the items of lower levels.
+ *
+ *  In bare-metal builds, the pending items are run by an event of
+ *  mbed_event_queue().
+ *
+ *  @note Synchronization level: Interrupt safe
+ *
+ *  Example:
+ *  @code
+ *  class Sensor {
+ *  public:
+ *      Sensor(PinName irq) : _irq(irq), _work(callback(this, &Sensor::read_samples), DeferredWork::PriorityHigh)
+ *      {
+ *          _irq.fall(callback(&_work, &DeferredWork::schedule));
+ *      }
+ *
+ *  private:
+ *      void read_samples();
+ *
+ *      InterruptIn _irq;
+ *      DeferredWork _work;
+ *  };
+ *  @endcode
+ */
+class DeferredWork : private mbed::NonCopyable<DeferredWork> {
+public:
+    /** Priority levels of the work items */
+    enum Priority {
+        PriorityHigh,
+        PriorityNormal,
+        PriorityLow,
+    };
+
+    /** Create a work item
+     *
+     *  The first work item created starts the thread running them, so
+     *  create them from thread context.
+     *
+     *  @param func     Callback run by the work item
+     *  @param priority Priority level of the work item
+     */
+    DeferredWork(mbed::Callback<void()> func, Priority priority = PriorityNormal);
+
+    /** Destroy a work item
+     *
+     *  Cancels it if it is pending, it must not be running.
+     */
+    ~DeferredWork();
+
+    /** Schedule the work item
+     *
+     *  This function is IRQ safe.
+     *
+     *  @return True if scheduled, false if it was already pending
+     */
+    bool schedule();
+
+    /** Cancel the work item
+     *
+     *  This function is IRQ safe.
+     *
+     *  @return True if it was pending, false otherwise
+     */
+    bool cancel();
+
+    /** Check if the work item is pending
+     *
+     *  @return True if scheduled and not yet run
+     */
+    bool pending() const
+    {
+        return _pending;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void start_thread();
+    static void thread_main();
+    static void run_pending();
+
+    DeferredWork *_next;
+    mbed::Callback<void()> _func;
+    uint8_t _priority;
+    volatile bool _pending;
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
@@ -68,6 +68,7 @@ public:
             _event->id = 0;
             _event->delay = duration(0);
             _event->period = duration(-1);
+            _event->slack = duration(0);
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -158,6 +159,20 @@ public:
         period(duration(p));
     }
 
+    /** Configure the slack of an event
+     *
+     *  The event may be dispatched up to the slack after it is due, letting
+     *  the queue wake up once for events due at close times.
+     *
+     *  @param s   Millisecond tolerance on the dispatching of the event
+     */
+    void slack(duration s)
+    {
+        if (_event) {
+            _event->slack = s;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -236,6 +251,7 @@ private:
 
         duration delay;
         duration period;
+        duration slack;
 
         int (*post)(struct event *, ArgTs... args);
         void (*dtor)(struct event *);
@@ -256,6 +272,7 @@ private:
         new (p) C(*(F *)(e + 1), args...);
         equeue_event_delay(p, e->delay.count());
         equeue_event_period(p, e->period.count());
+        equeue_event_slack(p, e->slack.count());
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
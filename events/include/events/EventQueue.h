@@ -226,6 +226,41 @@ public:
         return equeue_timeleft_user_allocated(&_equeue, &event->_e);
     }
 
+    /** Get the statistics of the event queue
+     *
+     *  The queue records the latency and run time of the dispatched events,
+     *  its depth and the use of its buffer when the events.stats-enabled
+     *  option or MBED_ALL_STATS_ENABLED is set. Otherwise all the fields
+     *  are zero.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param stats    Filled with the statistics since the queue was
+     *                  created or reset_stats was last called
+     */
+    void get_stats(equeue_stats_t *stats);
+
+    /** Reset the statistics of the event queue
+     *
+     *  Clears the counters, latencies and run times, and sets the maximum
+     *  depth and buffer use to their current values.
+     *
+     *  This function is IRQ safe.
+     */
+    void reset_stats();
+
+    /** Get a description of the free memory of the event queue
+     *
+     *  Reports how much of the event buffer is free and how fragmented it
+     *  is, see the events.allocator-buckets option to avoid fragmentation.
+     *
+     *  This function is IRQ safe, but takes a time linear in the number of
+     *  freed events.
+     *
+     *  @param info     Filled with the description of the free memory
+     */
+    void get_mem_info(equeue_mem_info_t *info);
+
     /** Background an event queue onto a single-shot timer-interrupt
      *
      *  When updated, the event queue will call the provided update function
@@ -839,6 +874,38 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue after a specified delay, within a tolerance
+     *
+     *  The event is dispatched between ms and ms + slack after the call,
+     *  when the dispatch loop wakes up for this or another event. Giving
+     *  slack to events lets the queue serve close deadlines with a single
+     *  wake up, so the device sleeps longer.
+     *
+     *  The call_in_with_slack function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param slack    Time the dispatching can additionally be delayed by
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in_with_slack(duration ms, duration slack, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_delay(e, ms.count());
+        equeue_event_slack(e, slack.count());
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
     /** Calls an event on the queue after a specified delay
      *  @see                        EventQueue::call_in
      *  @param ms                   Time to delay in milliseconds
@@ -993,6 +1060,38 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue periodically, within a tolerance
+     *
+     *  Each occurrence is dispatched up to slack after it is due, when the
+     *  dispatch loop wakes up for this or another event. The period is kept
+     *  from the due times, so the slack does not accumulate.
+     *
+     *  The call_every_with_slack function is IRQ safe and can act as a
+     *  mechanism for moving events out of IRQ contexts.
+     *
+     *  @param ms       Period of the event in milliseconds
+     *  @param slack    Time the dispatching can additionally be delayed by
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_every_with_slack(duration ms, duration slack, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_delay(e, ms.count());
+        equeue_event_period(e, ms.count());
+        equeue_event_slack(e, slack.count());
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
     /** Calls an event on the queue periodically
      *  @see                    EventQueue::call_every
      *  @param f                Function to execute in the context of the dispatch loop
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STARTUP_TASK_H
+#define STARTUP_TASK_H
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#include "events/WorkerPool.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "rtos/Kernel.h"
+#include <initializer_list>
+#include <stdint.h>
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_StartupTask StartupTask class
+ * @{
+ */
+
+/** StartupTask
+ *
+ *  Initialization of a subsystem deferred to a pool of threads, so that
+ *  independent subsystems initialize concurrently and main() runs before
+ *  they are all up.
+ *
+ *  Tasks are objects of static storage duration, registered when they are
+ *  constructed. A task runs once all its dependencies have succeeded, a
+ *  result of 0, and fails with MBED_ERROR_INITIALIZATION_FAILED without
+ *  running if one of them fails or if they depend on each other.
+ *
+ *  The tasks start with StartupTask::start(), or on the first wait() or
+ *  wait_for() of any task, which then initializes the subsystems lazily.
+ *
+ *  @note Synchronization level: Thread safe
+ *
+ *  Example:
+ *  @code
+ *  #include "mbed.h"
+ *  #include "kv_config.h"
+ *
+ *  static int network_up()
+ *  {
+ *      return NetworkInterface::get_default_instance()->connect();
+ *  }
+ *
+ *  static StartupTask storage("kvstore", kv_init_storage_config);
+ *  static StartupTask network("network", network_up);
+ *  static StartupTask cloud("cloud", cloud_connect, {&storage, &network});
+ *
+ *  int main()
+ *  {
+ *      StartupTask::start();
+ *      // serve the local UI while storage and network come up
+ *      ui_start();
+ *      if (cloud.wait() != 0) {
+ *          ...
+ *      }
+ *  }
+ *  @endcode
+ */
+class StartupTask : private mbed::NonCopyable<StartupTask> {
+public:
+    /** Register a startup task
+     *
+     *  @param name         Name of the task
+     *  @param init         Initialization of the subsystem, returning 0 on success
+     *  @param dependencies Tasks which must succeed before this one runs, at most
+     *                      events.startup-max-dependencies
+     */
+    StartupTask(const char *name, mbed::Callback<int()> init,
+                std::initializer_list<StartupTask *> dependencies = {});
+
+    /** Start the registered tasks
+     *
+     *  The tasks without pending dependencies are posted to the pool at once,
+     *  the others as their dependencies complete. Calls after the first have no
+     *  effect.
+     *
+     *  @param pool Pool running the tasks, or nullptr to create one of
+     *              events.startup-threads threads, released by wait_all()
+     */
+    static void start(WorkerPool *pool = nullptr);
+
+    /** Wait until the registered tasks have all completed
+     *
+     *  Also releases the pool created by start(). Not to be called from a task.
+     *
+     *  @return True if every task succeeded
+     */
+    static bool wait_all();
+
+    /** Wait until the task has completed, starting the tasks if needed
+     *
+     *  @return Result of the initialization, or MBED_ERROR_INITIALIZATION_FAILED
+     *          if it did not run
+     */
+    int wait();
+
+    /** Wait until the task has completed or a timeout, starting the tasks if needed
+     *
+     *  @param rel_time Timeout
+     *  @return         True if the task has completed, its result given by result()
+     */
+    bool wait_for(rtos::Kernel::Clock::duration rel_time);
+
+    /** Check if the task has completed
+     *
+     *  @return True if the task has completed, successfully or not
+     */
+    bool is_ready() const
+    {
+        return _state == DONE;
+    }
+
+    /** Get the result of a completed task
+     *
+     *  @return Result of the initialization, or MBED_ERROR_INITIALIZATION_FAILED
+     *          if it did not run
+     */
+    int result() const
+    {
+        return _result;
+    }
+
+    /** Get the name of the task
+     *
+     *  @return Name of the task
+     */
+    const char *name() const
+    {
+        return _name;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    enum state_t : uint8_t {
+        PENDING,
+        RUNNING,
+        DONE
+    };
+
+    void run();
+    static void schedule(StartupTask **ready);
+    static void post(StartupTask *ready);
+
+    StartupTask *_next;
+    StartupTask *_ready_next;
+    const char *_name;
+    mbed::Callback<int()> _init;
+    StartupTask *_dependencies[MBED_CONF_EVENTS_STARTUP_MAX_DEPENDENCIES];
+    uint8_t _dependency_count;
+    volatile state_t _state;
+    int _result;
+
+    // Constant initialized, so tasks register from any static constructor
+    static StartupTask *_head;
+    static WorkerPool *_pool;
+    static WorkerPool *_own_pool;
+    static uint32_t _running;
+    static bool _started;
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
+
+#endif
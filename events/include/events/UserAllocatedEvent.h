@@ -191,6 +191,33 @@ public:
         return post_on(queue);
     }
 
+    /** Posts an event onto the underlying event queue without locking
+    *
+    *  The event is posted as with try_call, but without entering a
+    *  critical section: it is handed to the dispatch loop through a
+    *  lock-free list. This suits interrupt handlers that cannot afford
+    *  disabling interrupts, and queues dispatched by a thread.
+    *
+    *  @return     False if the event was already posted
+    *              true otherwise
+    *
+    */
+    bool try_call_lockfree()
+    {
+        MBED_ASSERT(_equeue);
+        uint8_t expected = 0;
+        if (!core_util_atomic_cas_u8(&_post_ref, &expected, 1)) {
+            return false;
+        }
+        equeue_event_delay(&_e + 1, _delay);
+        equeue_event_period(&_e + 1, _period);
+        if (!equeue_post_user_allocated_lockfree(_equeue, &EventQueue::function_call<C>, &_e)) {
+            core_util_atomic_decr_u8(&_post_ref, 1);
+            return false;
+        }
+        return true;
+    }
+
     /** Posts an event onto the underlying event queue, returning void
      *
      *  The event is posted to the underlying queue and is executed in the
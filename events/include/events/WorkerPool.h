@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#include "events/equeue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Thread.h"
+#include <cstddef>
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/** WORKER_POOL_JOB_SIZE
+ *  Minimum size of a job
+ *  This size fits a job whose callback is a function or a member function
+ *  with its object pointer
+ */
+#define WORKER_POOL_JOB_SIZE (EQUEUE_EVENT_SIZE + 4 * sizeof(void *))
+
+/**
+ * \defgroup events_WorkerPool WorkerPool class
+ * @{
+ */
+
+/** WorkerPool
+ *
+ *  Flexible pool of threads running jobs, for callbacks that take long
+ *  enough to hold up an EventQueue. Jobs have no affinity: the first idle
+ *  thread runs the oldest pending job. The memory of pending jobs comes
+ *  from an equeue buffer, so posting a job is IRQ safe and bounded in time.
+ *
+ *  fork_join() splits a buffer operation into chunks that are run by the
+ *  calling thread and the idle threads of the pool.
+ *
+ *  @note Synchronization level: Thread safe
+ *
+ *  Example:
+ *  @code
+ *  #include "mbed.h"
+ *
+ *  static WorkerPool pool(2, 8 * WORKER_POOL_JOB_SIZE);
+ *  static uint8_t data[4096];
+ *
+ *  void scramble(size_t offset, size_t length)
+ *  {
+ *      for (size_t i = offset; i < offset + length; i++) {
+ *          data[i] ^= 0x5a;
+ *      }
+ *  }
+ *
+ *  int main()
+ *  {
+ *      // runs scramble on 512 byte chunks, on this thread and the pool
+ *      pool.fork_join(sizeof data, 512, scramble);
+ *  }
+ *  @endcode
+ */
+class WorkerPool : private mbed::NonCopyable<WorkerPool> {
+public:
+    /** Create a worker pool and start its threads
+     *
+     *  @param workers      Number of threads
+     *  @param size         Size of the buffer of pending jobs in bytes,
+     *                      WORKER_POOL_JOB_SIZE per job
+     *  @param stack_size   Stack size of each thread in bytes
+     *  @param priority     Priority of the threads
+     *  @param name         Name of the threads
+     */
+    WorkerPool(size_t workers, size_t size, uint32_t stack_size = OS_STACK_SIZE,
+               osPriority priority = osPriorityNormal, const char *name = nullptr);
+
+    /** Stop the threads and destroy the pool
+     *
+     *  The running jobs complete, the pending ones are discarded.
+     */
+    ~WorkerPool();
+
+    /** Post a job to the pool
+     *
+     *  The callback is run by the first thread of the pool to become idle.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param job  Callback to run
+     *  @return     True if the job was posted, false if the buffer of
+     *              pending jobs is full
+     */
+    bool call(mbed::Callback<void()> job);
+
+    /** Post a member function job to the pool
+     *
+     *  @see WorkerPool::call
+     */
+    template <typename T, typename R>
+    bool call(T *obj, R(T::*method)())
+    {
+        return call(mbed::callback(obj, method));
+    }
+
+    /** Run a buffer operation in parallel chunks
+     *
+     *  Splits the range [0, size) into chunks of chunk_size, the last one
+     *  possibly shorter, and calls func once for each chunk. The chunks are
+     *  taken in order by the calling thread and by idle threads of the pool,
+     *  which returns once all of them have completed.
+     *
+     *  The calling thread takes part in the work, so fork_join also completes
+     *  when the pool is busy or when called from one of its jobs.
+     *
+     *  @param size         Size of the range
+     *  @param chunk_size   Size of the chunks, not 0
+     *  @param func         Callback called with the offset and length of each chunk
+     */
+    void fork_join(size_t size, size_t chunk_size, mbed::Callback<void(size_t, size_t)> func);
+
+    /** Get the number of threads of the pool
+     *
+     *  @return Number of threads
+     */
+    size_t workers() const
+    {
+        return _workers;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    struct fork_state;
+
+    struct job {
+        job *next;
+        fork_state *owner;
+        mbed::Callback<void()> func;
+    };
+
+    struct fork_state {
+        mbed::Callback<void(size_t, size_t)> func;
+        size_t size;
+        size_t chunk_size;
+        uint32_t chunks;
+        volatile uint32_t next;
+        rtos::Semaphore done;
+    };
+
+    job *alloc_job();
+    void free_job(job *j);
+    void push(job *j);
+    job *pop();
+    void worker();
+    static void run_chunks(fork_state *f);
+
+    equeue_t _equeue;
+    rtos::Thread **_threads;
+    size_t _workers;
+    job *_head;
+    job *_tail;
+    volatile bool _stopping;
+    rtos::Semaphore _pending;
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
+
+#endif
@@ -34,11 +34,75 @@ extern "C" {
  * @{
  */
 
+// Scheduler of the pending events
+//
+// By default pending events are kept in a list sorted by target, which makes
+// posting an event linear in the number of pending events. When set to 1, a
+// pairing heap is used instead, for logarithmic posting and cancelling.
+#ifndef EQUEUE_SCHEDULER_HEAP
+#ifdef MBED_CONF_EVENTS_SCHEDULER_HEAP
+#define EQUEUE_SCHEDULER_HEAP MBED_CONF_EVENTS_SCHEDULER_HEAP
+#else
+#define EQUEUE_SCHEDULER_HEAP 0
+#endif
+#endif
+
+// Event queue statistics
+//
+// When set to 1, the event queue records the dispatch latency and run time
+// of events, its depth and the use of its buffer, see equeue_stats_get.
+#ifndef EQUEUE_STATS
+#if defined(MBED_ALL_STATS_ENABLED)
+#define EQUEUE_STATS 1
+#elif defined(MBED_CONF_EVENTS_STATS_ENABLED)
+#define EQUEUE_STATS MBED_CONF_EVENTS_STATS_ENABLED
+#else
+#define EQUEUE_STATS 0
+#endif
+#endif
+
+// Batch dispatch
+//
+// When set to 1, the dispatch loop reads the clock once per batch of ready
+// events and runs the next batch straight away if it is already due,
+// instead of going through the semaphore.
+#ifndef EQUEUE_DISPATCH_BATCH
+#ifdef MBED_CONF_EVENTS_DISPATCH_BATCH
+#define EQUEUE_DISPATCH_BATCH MBED_CONF_EVENTS_DISPATCH_BATCH
+#else
+#define EQUEUE_DISPATCH_BATCH 0
+#endif
+#endif
+
+// Size-class allocator
+//
+// By default freed events are kept in a list sorted by size and reused for
+// allocations they fit, which can leave the buffer fragmented when events
+// of mixed sizes are posted. When set to 1, allocations are rounded up to a
+// power of two and freed events are kept in a free list per size, making
+// allocation and deallocation constant time and letting any freed event be
+// reused by an allocation of the same size class.
+#ifndef EQUEUE_ALLOCATOR_BUCKETS
+#ifdef MBED_CONF_EVENTS_ALLOCATOR_BUCKETS
+#define EQUEUE_ALLOCATOR_BUCKETS MBED_CONF_EVENTS_ALLOCATOR_BUCKETS
+#else
+#define EQUEUE_ALLOCATOR_BUCKETS 0
+#endif
+#endif
+
+// Size classes of the size-class allocator, 2^EQUEUE_BUCKET_MIN_NPW2 bytes
+// and the following powers of two
+#define EQUEUE_BUCKET_MIN_NPW2 5
+#define EQUEUE_BUCKET_COUNT 12
+
 // The minimum size of an event
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
 // Internal event structure
+//
+// With the heap scheduler, sibling is the first child of an event and next
+// its next sibling, while seq orders the events posted for the same target.
 struct equeue_event {
     unsigned size;
     uint8_t id;
@@ -53,21 +117,66 @@ struct equeue_event {
     void (*dtor)(void *);
 
     void (*cb)(void *);
+    unsigned slack;
+#if EQUEUE_SCHEDULER_HEAP
+    unsigned seq;
+#endif
     // data follows
 };
 
+// Event queue statistics structure
+//
+// Times are in milliseconds, with the granularity of equeue_tick. The
+// latency of an event is the time between its due time, the posting time
+// for events without delay, and the start of its callback.
+typedef struct equeue_stats {
+    uint32_t dispatch_cnt;      // number of callbacks run
+    uint32_t max_latency;       // longest latency of an event
+    uint64_t total_latency;     // sum of the latencies of the events
+    uint32_t max_run_time;      // longest run time of a callback
+    uint64_t total_run_time;    // sum of the run times of the callbacks
+    uint32_t current_depth;     // number of events in the queue
+    uint32_t max_depth;         // maximum number of events in the queue
+    uint32_t current_size;      // bytes of the buffer allocated to events
+    uint32_t max_size;          // maximum bytes of the buffer allocated to events
+    uint32_t reserved_size;     // size of the buffer
+    uint32_t alloc_fail_cnt;    // number of failed allocations
+} equeue_stats_t;
+
+// Event queue memory structure
+//
+// Describes the free memory of the buffer. The allocatable size is the
+// largest allocation, event overhead included, that can currently succeed.
+// The fragmentation is the percentage of the free memory that cannot be
+// used by an allocation of the allocatable size.
+typedef struct equeue_mem_info {
+    size_t slab_size;           // bytes never allocated yet
+    size_t free_size;           // bytes in freed events
+    size_t free_cnt;            // number of freed events
+    size_t allocatable_size;    // largest possible allocation
+    unsigned fragmentation;     // percentage of free memory
+} equeue_mem_info_t;
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    struct equeue_event *volatile pending;
     unsigned tick;
     bool break_requested;
     uint8_t generation;
+#if EQUEUE_SCHEDULER_HEAP
+    unsigned seq;
+#endif
 
     unsigned char *buffer;
     unsigned npw2;
     void *allocated;
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+    struct equeue_event *buckets[EQUEUE_BUCKET_COUNT];
+#else
     struct equeue_event *chunks;
+#endif
     struct equeue_slab {
         size_t size;
         unsigned char *data;
@@ -79,6 +188,10 @@ typedef struct equeue {
         void *timer;
     } background;
 
+#if EQUEUE_STATS
+    equeue_stats_t stats;
+#endif
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
@@ -160,9 +273,13 @@ void equeue_dealloc(equeue_t *queue, void *event);
 //
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
+// equeue_event_slack  - Millisecond delay the dispatching of an event can
+//                       additionally take, letting the dispatch loop wake
+//                       up once for events due at different times
 // equeue_event_dtor   - Destructor to run when the event is deallocated
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
+void equeue_event_slack(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
 
 // Post an event onto the event queue
@@ -190,6 +307,21 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // a mechanism for moving events out of irq contexts.
 void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post an user allocated event onto the event queue without locking
+//
+// The equeue_post_user_allocated_lockfree function behaves as
+// equeue_post_user_allocated but never enters the queue's mutex section.
+// The event is pushed on a lock-free list that the dispatch loop moves
+// into the queue, so posting keeps interrupts enabled and takes a bounded
+// number of atomic operations, at the cost of the event being scheduled
+// only once the dispatch loop wakes up.
+//
+// Events posted this way are picked up by equeue_dispatch only, the
+// background timer of a chained queue is not notified.
+//
+// Returns false if the event is already posted.
+bool equeue_post_user_allocated_lockfree(equeue_t *queue, void (*cb)(void *), void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -237,6 +369,23 @@ int equeue_timeleft(equeue_t *q, int id);
 //
 int equeue_timeleft_user_allocated(equeue_t *q, void *event);
 
+// Get the statistics of an event queue
+//
+// The equeue_stats_get function fills stats with the statistics recorded
+// since the queue was created or equeue_stats_reset was last called. All
+// the fields are zero if EQUEUE_STATS is disabled.
+//
+// The equeue_stats_reset function clears the counters, latencies and run
+// times, and sets the maximums to the current values.
+void equeue_stats_get(equeue_t *queue, equeue_stats_t *stats);
+void equeue_stats_reset(equeue_t *queue);
+
+// Get a description of the free memory of an event queue
+//
+// The equeue_mem_info function walks the freed events, in a time linear in
+// their number, to report how much memory is free and how fragmented it is.
+void equeue_mem_info(equeue_t *queue, equeue_mem_info_t *info);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
@@ -96,6 +96,23 @@ void equeue_mutex_lock(equeue_mutex_t *mutex);
 void equeue_mutex_unlock(equeue_mutex_t *mutex);
 
 
+// Platform atomic operations
+//
+// The equeue library requires lock-free compare-and-swap and exchange
+// operations that are safe in interrupt contexts. They are used to post
+// user allocated events without entering the mutex section.
+//
+// The equeue_atomic_cas_ptr and equeue_atomic_cas_u8 functions store
+// desired in *ptr if it contains *expected and return true. Otherwise
+// they update *expected with the current value and return false.
+//
+// The equeue_atomic_exchange_ptr function stores desired in *ptr and
+// returns the previous value.
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired);
+bool equeue_atomic_cas_u8(volatile uint8_t *ptr, uint8_t *expected, uint8_t desired);
+void *equeue_atomic_exchange_ptr(void *volatile *ptr, void *desired);
+
+
 // Platform semaphore type
 //
 // The equeue library requires a binary semaphore type that can be safely
@@ -21,6 +21,11 @@
 #include "events/EventQueue.h"
 #include "events/Event.h"
 #include "events/UserAllocatedEvent.h"
+#include "events/WorkerPool.h"
+#include "events/DeferredWork.h"
+#include "events/Coroutine.h"
+#include "events/StartupTask.h"
+#include "events/CooperativeScheduler.h"
 
 #include "events/mbed_shared_queues.h"
 
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "events/CooperativeScheduler.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include <errno.h>
+
+using mbed::callback;
+
+namespace events {
+
+MBED_STATIC_ASSERT(MBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES > CooperativeScheduler::PriorityLow,
+                   "events.cooperative-max-queues must leave room for the queue of each level");
+
+CooperativeScheduler::CooperativeScheduler()
+    : _high(sizeof _buffers[PriorityHigh], _buffers[PriorityHigh]),
+      _normal(sizeof _buffers[PriorityNormal], _buffers[PriorityNormal]),
+      _low(sizeof _buffers[PriorityLow], _buffers[PriorityLow]),
+      _break_requested(false)
+{
+    MBED_UNUSED int err = equeue_sema_create(&_sema);
+    MBED_ASSERT(!err);
+
+    for (slot_t &slot : _slots) {
+        slot.scheduler = this;
+        slot.queue = nullptr;
+        slot.armed = false;
+    }
+    attach(&_high, PriorityHigh);
+    attach(&_normal, PriorityNormal);
+    attach(&_low, PriorityLow);
+}
+
+CooperativeScheduler::~CooperativeScheduler()
+{
+    for (slot_t &slot : _slots) {
+        if (slot.queue) {
+            detach(slot.queue);
+        }
+    }
+    equeue_sema_destroy(&_sema);
+}
+
+EventQueue *CooperativeScheduler::queue(Priority priority)
+{
+    MBED_ASSERT(priority <= PriorityLow);
+    return _slots[priority].queue;
+}
+
+int CooperativeScheduler::attach(EventQueue *queue, Priority priority)
+{
+    MBED_ASSERT(priority <= PriorityLow);
+    for (slot_t &slot : _slots) {
+        if (!slot.queue) {
+            slot.queue = queue;
+            slot.priority = priority;
+            slot.armed = false;
+            // Calls update with the next event of the queue, if any
+            queue->background(callback(&slot, &slot_t::update));
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+void CooperativeScheduler::detach(EventQueue *queue)
+{
+    for (slot_t &slot : _slots) {
+        if (slot.queue == queue) {
+            queue->background(nullptr);
+            core_util_critical_section_enter();
+            slot.queue = nullptr;
+            slot.armed = false;
+            core_util_critical_section_exit();
+        }
+    }
+}
+
+// Background timer of a queue: ms until its next event, negative if none.
+// Called by the queue, from interrupts too, when this changes.
+void CooperativeScheduler::slot_t::update(int ms)
+{
+    core_util_critical_section_enter();
+    if (ms >= 0) {
+        wakeup = equeue_tick() + ms;
+        armed = true;
+    } else {
+        armed = false;
+    }
+    core_util_critical_section_exit();
+
+    if (ms >= 0) {
+        scheduler->wake();
+    }
+}
+
+void CooperativeScheduler::wake()
+{
+    equeue_sema_signal(&_sema);
+}
+
+// Highest priority queue with events due. Otherwise deadline is set to the
+// time until the next events, or -1 if there are none.
+CooperativeScheduler::slot_t *CooperativeScheduler::next_due(unsigned tick, int *deadline)
+{
+    slot_t *due = nullptr;
+    *deadline = -1;
+
+    core_util_critical_section_enter();
+    for (slot_t &slot : _slots) {
+        if (!slot.queue || !slot.armed) {
+            continue;
+        }
+        int diff = (int)(slot.wakeup - tick);
+        if (diff <= 0) {
+            if (!due || slot.priority < due->priority) {
+                due = &slot;
+            }
+        } else if ((unsigned)diff < (unsigned)*deadline) {
+            *deadline = diff;
+        }
+    }
+    if (due) {
+        // Rearmed by the queue once dispatched
+        due->armed = false;
+    }
+    core_util_critical_section_exit();
+    return due;
+}
+
+void CooperativeScheduler::run_for(int ms)
+{
+    unsigned timeout = equeue_tick() + ms;
+
+    while (true) {
+        unsigned tick = equeue_tick();
+        int deadline;
+        slot_t *slot = next_due(tick, &deadline);
+        if (slot) {
+            slot->queue->dispatch(0);
+        }
+
+        if (_break_requested) {
+            core_util_critical_section_enter();
+            _break_requested = false;
+            core_util_critical_section_exit();
+            return;
+        }
+        if (slot) {
+            // Other levels may have become due meanwhile
+            continue;
+        }
+
+        if (ms >= 0) {
+            int left = (int)(timeout - tick);
+            if (left <= 0) {
+                return;
+            }
+            if ((unsigned)left < (unsigned)deadline) {
+                deadline = left;
+            }
+        }
+
+        // Sleeps until the deadline or a post, see EventFlags in
+        // bare-metal builds
+        equeue_sema_wait(&_sema, deadline);
+    }
+}
+
+void CooperativeScheduler::break_dispatch()
+{
+    _break_requested = true;
+    wake();
+}
+
+}
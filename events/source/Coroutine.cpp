@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "events/Coroutine.h"
+#include "platform/FileHandle.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+
+using mbed::Callback;
+
+namespace events {
+
+Coroutine::Coroutine(EventQueue *queue)
+    : _co_line(0),
+      _steps{ step_event(queue, mbed::callback(this, &Coroutine::step)), step_event(queue, mbed::callback(this, &Coroutine::step)) },
+      _next_step(0), _waiting(false), _started(false), _result(0), _fh(nullptr)
+#if MBED_CONF_RTOS_PRESENT
+    , _flags(nullptr), _flags_mask(0), _flags_poll(0)
+#endif
+{
+}
+
+Coroutine::~Coroutine()
+{
+    _steps[0].cancel();
+    _steps[1].cancel();
+    if (_fh) {
+        _fh->sigio(nullptr);
+    }
+}
+
+bool Coroutine::start(Callback<void()> done)
+{
+    if (_started) {
+        return false;
+    }
+    _started = true;
+    _co_line = 0;
+    _result = 0;
+    _done = done;
+    post(0);
+    return true;
+}
+
+void Coroutine::resume(int result)
+{
+    if (core_util_atomic_exchange_bool(&_waiting, false)) {
+        _result = result;
+        post(0);
+    }
+}
+
+void Coroutine::post(int delay)
+{
+    // A single resumption is pending at a time, guarded by _waiting
+    step_event &e = _steps[_next_step];
+    _next_step ^= 1;
+    e.delay(delay);
+    MBED_UNUSED bool posted = e.try_call();
+    MBED_ASSERT(posted);
+}
+
+void Coroutine::step()
+{
+#if MBED_CONF_RTOS_PRESENT
+    if (_flags) {
+        uint32_t flags = _flags->get();
+        if (!(flags & _flags_mask)) {
+            post(_flags_poll);
+            return;
+        }
+        _flags = nullptr;
+        _result = flags;
+    }
+#endif
+    if (_fh) {
+        _fh->sigio(nullptr);
+        _fh = nullptr;
+    }
+
+    run();
+
+    if (!_started && _done) {
+        _done();
+    }
+}
+
+void Coroutine::await_begin()
+{
+    core_util_atomic_store_bool(&_waiting, true);
+}
+
+bool Coroutine::await_end(int status)
+{
+    if (status == 0) {
+        return true;
+    }
+    // Nothing was started, so nothing can resume the coroutine
+    core_util_atomic_store_bool(&_waiting, false);
+    _result = status;
+    return false;
+}
+
+void Coroutine::finish()
+{
+    _co_line = -1;
+    _started = false;
+}
+
+int Coroutine::sleep_for(std::chrono::milliseconds rel_time)
+{
+    core_util_atomic_store_bool(&_waiting, false);
+    _result = 0;
+    post(rel_time.count());
+    return 0;
+}
+
+void Coroutine::on_sigio()
+{
+    resume(1);
+}
+
+int Coroutine::wait_readable(mbed::FileHandle &fh)
+{
+    // Registered before the check, so data arriving in between isn't missed
+    _fh = &fh;
+    fh.sigio(mbed::callback(this, &Coroutine::on_sigio));
+    if (fh.readable()) {
+        fh.sigio(nullptr);
+        _fh = nullptr;
+        // Unless a sigio already resumed the coroutine
+        return core_util_atomic_exchange_bool(&_waiting, false) ? 1 : 0;
+    }
+    return 0;
+}
+
+#if MBED_CONF_RTOS_PRESENT
+int Coroutine::wait_flags(rtos::EventFlags &flags, uint32_t mask, std::chrono::milliseconds poll)
+{
+    uint32_t set = flags.get();
+    if (set & mask) {
+        return set;
+    }
+    core_util_atomic_store_bool(&_waiting, false);
+    _flags = &flags;
+    _flags_mask = mask;
+    _flags_poll = poll.count();
+    post(_flags_poll);
+    return 0;
+}
+#endif
+
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "events/DeferredWork.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+#else
+#include "events/mbed_shared_queues.h"
+#endif
+
+using mbed::Callback;
+
+namespace events {
+
+namespace {
+const int levels = DeferredWork::PriorityLow + 1;
+
+// FIFO of pending items of each level
+DeferredWork *pending_head[levels];
+DeferredWork *pending_tail[levels];
+
+#if MBED_CONF_RTOS_PRESENT
+const uint32_t work_flag = 1;
+
+rtos::Thread *work_thread;
+#else
+bool drain_posted;
+#endif
+}
+
+#if MBED_CONF_RTOS_PRESENT
+void DeferredWork::thread_main()
+{
+    while (true) {
+        rtos::ThisThread::flags_wait_any(work_flag);
+        run_pending();
+    }
+}
+
+void DeferredWork::start_thread()
+{
+    static uint64_t stack[MBED_CONF_EVENTS_DEFERRED_WORK_STACKSIZE / sizeof(uint64_t)];
+    static rtos::Thread thread(MBED_CONF_EVENTS_DEFERRED_WORK_PRIORITY, sizeof stack, (unsigned char *) stack, "deferred_work");
+
+    // Static initialization is thread safe, this runs once
+    static bool started = [] {
+        MBED_UNUSED osStatus status = thread.start(thread_main);
+        MBED_ASSERT(status == osOK);
+        work_thread = &thread;
+        return true;
+    }();
+    (void)started;
+}
+#endif
+
+DeferredWork::DeferredWork(Callback<void()> func, Priority priority)
+    : _next(nullptr), _func(func), _priority(priority), _pending(false)
+{
+    MBED_ASSERT(priority < levels);
+#if MBED_CONF_RTOS_PRESENT
+    start_thread();
+#endif
+}
+
+DeferredWork::~DeferredWork()
+{
+    cancel();
+}
+
+bool DeferredWork::schedule()
+{
+    core_util_critical_section_enter();
+    if (_pending) {
+        core_util_critical_section_exit();
+        return false;
+    }
+    _pending = true;
+    _next = nullptr;
+    if (pending_tail[_priority]) {
+        pending_tail[_priority]->_next = this;
+    } else {
+        pending_head[_priority] = this;
+    }
+    pending_tail[_priority] = this;
+#if !MBED_CONF_RTOS_PRESENT
+    bool post = !drain_posted;
+    drain_posted = true;
+#endif
+    core_util_critical_section_exit();
+
+#if MBED_CONF_RTOS_PRESENT
+    work_thread->flags_set(work_flag);
+#else
+    if (post) {
+        MBED_UNUSED int id = mbed::mbed_event_queue()->call(&DeferredWork::run_pending);
+        MBED_ASSERT(id);
+    }
+#endif
+    return true;
+}
+
+bool DeferredWork::cancel()
+{
+    core_util_critical_section_enter();
+    if (!_pending) {
+        core_util_critical_section_exit();
+        return false;
+    }
+    DeferredWork *prev = nullptr;
+    for (DeferredWork *w = pending_head[_priority]; w != this; w = w->_next) {
+        prev = w;
+    }
+    if (prev) {
+        prev->_next = _next;
+    } else {
+        pending_head[_priority] = _next;
+    }
+    if (pending_tail[_priority] == this) {
+        pending_tail[_priority] = prev;
+    }
+    _pending = false;
+    core_util_critical_section_exit();
+    return true;
+}
+
+void DeferredWork::run_pending()
+{
+    while (true) {
+        core_util_critical_section_enter();
+        DeferredWork *w = nullptr;
+        for (int i = 0; i < levels && !w; i++) {
+            w = pending_head[i];
+        }
+        if (!w) {
+#if !MBED_CONF_RTOS_PRESENT
+            drain_posted = false;
+#endif
+            core_util_critical_section_exit();
+            return;
+        }
+        pending_head[w->_priority] = w->_next;
+        if (!w->_next) {
+            pending_tail[w->_priority] = nullptr;
+        }
+        // Cleared before running, so the item can schedule itself again
+        w->_pending = false;
+        core_util_critical_section_exit();
+
+        w->_func();
+    }
+}
+
+}
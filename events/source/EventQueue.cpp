@@ -66,14 +66,30 @@ int EventQueue::time_left(int id)
     return equeue_timeleft(&_equeue, id);
 }
 
+void EventQueue::get_stats(equeue_stats_t *stats)
+{
+    equeue_stats_get(&_equeue, stats);
+}
+
+void EventQueue::reset_stats()
+{
+    equeue_stats_reset(&_equeue);
+}
+
+void EventQueue::get_mem_info(equeue_mem_info_t *info)
+{
+    equeue_mem_info(&_equeue, info);
+}
+
 void EventQueue::background(Callback<void(int)> update)
 {
+    // The previous update is notified through _update, so it is removed
+    // before _update is replaced
+    equeue_background(&_equeue, 0, 0);
     _update = update;
 
     if (_update) {
         equeue_background(&_equeue, &Callback<void(int)>::thunk, &_update);
-    } else {
-        equeue_background(&_equeue, 0, 0);
     }
 }
 
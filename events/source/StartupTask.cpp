@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "events/StartupTask.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#include "platform/mbed_assert.h"
+#include "platform/mbed_error.h"
+#include "platform/SingletonPtr.h"
+#include "rtos/ConditionVariable.h"
+#include "rtos/Mutex.h"
+
+using mbed::Callback;
+using rtos::ConditionVariable;
+using rtos::Mutex;
+
+namespace events {
+
+namespace {
+struct startup_sync {
+    startup_sync() : done(mutex)
+    {
+    }
+
+    Mutex mutex;
+    ConditionVariable done;
+};
+
+SingletonPtr<startup_sync> startup;
+}
+
+StartupTask *StartupTask::_head;
+WorkerPool *StartupTask::_pool;
+WorkerPool *StartupTask::_own_pool;
+uint32_t StartupTask::_running;
+bool StartupTask::_started;
+
+StartupTask::StartupTask(const char *name, Callback<int()> init, std::initializer_list<StartupTask *> dependencies)
+    : _ready_next(nullptr), _name(name), _init(init), _dependency_count(0), _state(PENDING),
+      _result(MBED_ERROR_INITIALIZATION_FAILED)
+{
+    MBED_ASSERT(dependencies.size() <= MBED_CONF_EVENTS_STARTUP_MAX_DEPENDENCIES);
+    for (StartupTask *dependency : dependencies) {
+        if (_dependency_count < MBED_CONF_EVENTS_STARTUP_MAX_DEPENDENCIES) {
+            _dependencies[_dependency_count++] = dependency;
+        }
+    }
+
+    // Static constructors run before any other thread, later tasks join in
+    if (!_started) {
+        _next = _head;
+        _head = this;
+        return;
+    }
+
+    StartupTask *ready = nullptr;
+    startup->mutex.lock();
+    _next = _head;
+    _head = this;
+    schedule(&ready);
+    startup->mutex.unlock();
+    post(ready);
+}
+
+void StartupTask::start(WorkerPool *pool)
+{
+    StartupTask *ready = nullptr;
+
+    startup->mutex.lock();
+    if (_started) {
+        startup->mutex.unlock();
+        return;
+    }
+    _started = true;
+
+    if (!pool) {
+        size_t tasks = 0;
+        for (StartupTask *t = _head; t; t = t->_next) {
+            tasks++;
+        }
+        _own_pool = new WorkerPool(MBED_CONF_EVENTS_STARTUP_THREADS, (tasks ? tasks : 1) * WORKER_POOL_JOB_SIZE,
+                                   MBED_CONF_EVENTS_STARTUP_STACKSIZE, osPriorityNormal, "startup");
+        pool = _own_pool;
+    }
+    _pool = pool;
+
+    schedule(&ready);
+    startup->mutex.unlock();
+    post(ready);
+}
+
+bool StartupTask::wait_all()
+{
+    start();
+
+    startup->mutex.lock();
+    bool succeeded = true;
+    for (StartupTask *t = _head; t; t = t->_next) {
+        startup->done.wait([t] { return t->_state == DONE; });
+        if (t->_result != 0) {
+            succeeded = false;
+        }
+    }
+    WorkerPool *pool = _own_pool;
+    if (pool) {
+        _own_pool = nullptr;
+        _pool = nullptr;
+    }
+    startup->mutex.unlock();
+
+    // The tasks registered from now on run on the registering thread
+    delete pool;
+    return succeeded;
+}
+
+int StartupTask::wait()
+{
+    start();
+
+    startup->mutex.lock();
+    startup->done.wait([this] { return _state == DONE; });
+    int result = _result;
+    startup->mutex.unlock();
+    return result;
+}
+
+bool StartupTask::wait_for(rtos::Kernel::Clock::duration rel_time)
+{
+    start();
+
+    startup->mutex.lock();
+    bool done = startup->done.wait_for(rel_time, [this] { return _state == DONE; });
+    startup->mutex.unlock();
+    return done;
+}
+
+void StartupTask::run()
+{
+    int result = _init();
+
+    StartupTask *ready = nullptr;
+    startup->mutex.lock();
+    _result = result;
+    _state = DONE;
+    _running--;
+    schedule(&ready);
+    startup->done.notify_all();
+    startup->mutex.unlock();
+    post(ready);
+}
+
+void StartupTask::schedule(StartupTask **ready)
+{
+    bool failed_any = false;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (StartupTask *t = _head; t; t = t->_next) {
+            if (t->_state != PENDING) {
+                continue;
+            }
+
+            bool runnable = true;
+            bool failed = false;
+            for (uint8_t i = 0; i < t->_dependency_count; i++) {
+                const StartupTask *d = t->_dependencies[i];
+                if (d->_state != DONE) {
+                    runnable = false;
+                } else if (d->_result != 0) {
+                    failed = true;
+                }
+            }
+
+            if (failed) {
+                t->_state = DONE;
+                changed = true;
+                failed_any = true;
+            } else if (runnable) {
+                t->_state = RUNNING;
+                t->_ready_next = *ready;
+                *ready = t;
+                _running++;
+            }
+        }
+    }
+
+    // Nothing running nor about to run: the pending tasks wait on each other
+    if (_running == 0) {
+        for (StartupTask *t = _head; t; t = t->_next) {
+            if (t->_state == PENDING) {
+                t->_state = DONE;
+                failed_any = true;
+            }
+        }
+    }
+
+    if (failed_any) {
+        startup->done.notify_all();
+    }
+}
+
+void StartupTask::post(StartupTask *ready)
+{
+    while (ready) {
+        StartupTask *t = ready;
+        ready = t->_ready_next;
+        if (!_pool || !_pool->call(t, &StartupTask::run)) {
+            t->run();
+        }
+    }
+}
+
+}
+
+#endif
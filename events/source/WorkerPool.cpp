@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "events/WorkerPool.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_error.h"
+#include <new>
+
+using mbed::Callback;
+using rtos::Thread;
+
+namespace events {
+
+WorkerPool::WorkerPool(size_t workers, size_t size, uint32_t stack_size, osPriority priority, const char *name)
+    : _workers(workers), _head(nullptr), _tail(nullptr), _stopping(false)
+{
+    static_assert(sizeof(struct equeue_event) + sizeof(job) <= WORKER_POOL_JOB_SIZE,
+                  "WORKER_POOL_JOB_SIZE does not fit a job");
+
+    if (equeue_create(&_equeue, size) < 0) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_APPLICATION, MBED_ERROR_CODE_OUT_OF_MEMORY),
+                   "WorkerPool buffer allocation failed");
+    }
+
+    _threads = new Thread *[_workers];
+    for (size_t i = 0; i < _workers; i++) {
+        _threads[i] = new Thread(priority, stack_size, nullptr, name);
+        osStatus status = _threads[i]->start(mbed::callback(this, &WorkerPool::worker));
+        MBED_ASSERT(status == osOK);
+        (void)status;
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    _stopping = true;
+    for (size_t i = 0; i < _workers; i++) {
+        _pending.release();
+    }
+
+    for (size_t i = 0; i < _workers; i++) {
+        _threads[i]->join();
+        delete _threads[i];
+    }
+    delete[] _threads;
+
+    while (job *j = pop()) {
+        free_job(j);
+    }
+    equeue_destroy(&_equeue);
+}
+
+bool WorkerPool::call(Callback<void()> func)
+{
+    job *j = alloc_job();
+    if (!j) {
+        return false;
+    }
+
+    j->func = func;
+    push(j);
+    return true;
+}
+
+void WorkerPool::fork_join(size_t size, size_t chunk_size, Callback<void(size_t, size_t)> func)
+{
+    MBED_ASSERT(chunk_size);
+
+    fork_state f;
+    f.func = func;
+    f.size = size;
+    f.chunk_size = chunk_size;
+    f.chunks = (size + chunk_size - 1) / chunk_size;
+    f.next = 0;
+
+    // one helper job per idle thread that may join in
+    size_t helpers = f.chunks > _workers ? _workers : (f.chunks ? f.chunks - 1 : 0);
+    size_t posted = 0;
+    for (; posted < helpers; posted++) {
+        job *j = alloc_job();
+        if (!j) {
+            break;
+        }
+        j->owner = &f;
+        push(j);
+    }
+
+    run_chunks(&f);
+
+    // take back the helpers no thread has started, the others only have
+    // their last chunk left to complete
+    job *unstarted = nullptr;
+    core_util_critical_section_enter();
+    job *prev = nullptr;
+    for (job *j = _head; j;) {
+        job *next = j->next;
+        if (j->owner == &f) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                _head = next;
+            }
+            if (_tail == j) {
+                _tail = prev;
+            }
+            j->next = unstarted;
+            unstarted = j;
+            posted--;
+        } else {
+            prev = j;
+        }
+        j = next;
+    }
+    core_util_critical_section_exit();
+
+    while (unstarted) {
+        job *j = unstarted;
+        unstarted = j->next;
+        free_job(j);
+    }
+
+    while (posted--) {
+        f.done.acquire();
+    }
+}
+
+WorkerPool::job *WorkerPool::alloc_job()
+{
+    void *p = equeue_alloc(&_equeue, sizeof(job));
+    if (!p) {
+        return nullptr;
+    }
+
+    job *j = new (p) job;
+    j->next = nullptr;
+    j->owner = nullptr;
+    return j;
+}
+
+void WorkerPool::free_job(job *j)
+{
+    j->~job();
+    equeue_dealloc(&_equeue, j);
+}
+
+void WorkerPool::push(job *j)
+{
+    core_util_critical_section_enter();
+    if (_tail) {
+        _tail->next = j;
+    } else {
+        _head = j;
+    }
+    _tail = j;
+    core_util_critical_section_exit();
+
+    _pending.release();
+}
+
+WorkerPool::job *WorkerPool::pop()
+{
+    core_util_critical_section_enter();
+    job *j = _head;
+    if (j) {
+        _head = j->next;
+        if (!_head) {
+            _tail = nullptr;
+        }
+    }
+    core_util_critical_section_exit();
+    return j;
+}
+
+void WorkerPool::worker()
+{
+    while (true) {
+        _pending.acquire();
+        if (_stopping) {
+            return;
+        }
+
+        // jobs taken back by fork_join leave a count behind
+        job *j = pop();
+        if (!j) {
+            continue;
+        }
+
+        if (j->owner) {
+            fork_state *f = j->owner;
+            run_chunks(f);
+            free_job(j);
+            f->done.release();
+        } else {
+            j->func();
+            free_job(j);
+        }
+    }
+}
+
+void WorkerPool::run_chunks(fork_state *f)
+{
+    uint32_t i;
+    while ((i = core_util_atomic_fetch_add_u32(&f->next, 1)) < f->chunks) {
+        size_t offset = i * f->chunk_size;
+        size_t length = f->size - offset < f->chunk_size ? f->size - offset : f->chunk_size;
+        f->func(offset, length);
+    }
+}
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 
 // for user allocated events use event id to track event state
 enum {
+    EQUEUE_USER_ALLOCATED_EVENT_STATE_PENDING = 2,      // posted lock-free, not yet in the queue
     EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS = 1,
     EQUEUE_USER_ALLOCATED_EVENT_STATE_DONE = 0          // event canceled or dispatching done
 };
@@ -45,6 +46,126 @@ static inline int equeue_clampdiff(unsigned a, unsigned b)
     return diff > 0 ? diff : 0;
 }
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+// size class fitting an allocation, EQUEUE_BUCKET_COUNT if none does
+static inline unsigned equeue_bucket(size_t size)
+{
+    unsigned b = 0;
+    while (b < EQUEUE_BUCKET_COUNT && ((size_t)1 << (b + EQUEUE_BUCKET_MIN_NPW2)) < size) {
+        b++;
+    }
+    return b;
+}
+
+// largest size class a chunk fits
+static inline unsigned equeue_bucket_of(size_t size)
+{
+    unsigned b = 0;
+    while (b + 1 < EQUEUE_BUCKET_COUNT && ((size_t)1 << (b + 1 + EQUEUE_BUCKET_MIN_NPW2)) <= size) {
+        b++;
+    }
+    return b;
+}
+#endif
+
+#if EQUEUE_STATS
+// statistics of the buffer, called with the memlock held
+static inline void equeue_stats_alloc(equeue_t *q, size_t size)
+{
+    q->stats.current_size += size;
+    if (q->stats.current_size > q->stats.max_size) {
+        q->stats.max_size = q->stats.current_size;
+    }
+}
+
+// statistics of the queue, called with the queuelock held
+static inline void equeue_stats_depth(equeue_t *q, int n)
+{
+    q->stats.current_depth += n;
+    if (q->stats.current_depth > q->stats.max_depth) {
+        q->stats.max_depth = q->stats.current_depth;
+    }
+}
+
+// statistics of the callbacks, only updated by the dispatch loop
+static inline void equeue_stats_dispatch(equeue_t *q, unsigned latency, unsigned run_time)
+{
+    q->stats.dispatch_cnt++;
+    q->stats.total_latency += latency;
+    if (latency > q->stats.max_latency) {
+        q->stats.max_latency = latency;
+    }
+    q->stats.total_run_time += run_time;
+    if (run_time > q->stats.max_run_time) {
+        q->stats.max_run_time = run_time;
+    }
+}
+#endif
+
+#if EQUEUE_SCHEDULER_HEAP
+// depth of the search for the wake up time in the heap
+#define EQUEUE_WAKEUP_DEPTH 8
+
+// pairing heap ordered by target, then by posting order
+static inline bool equeue_heap_before(struct equeue_event *a, struct equeue_event *b)
+{
+    int diff = equeue_tickdiff(a->target, b->target);
+    return diff < 0 || (diff == 0 && (int)(a->seq - b->seq) < 0);
+}
+
+// link two heaps, the root of the later one becoming the first child of the
+// other one, whose next and ref are left to the caller
+static struct equeue_event *equeue_heap_link(struct equeue_event *a, struct equeue_event *b)
+{
+    if (equeue_heap_before(b, a)) {
+        struct equeue_event *t = a;
+        a = b;
+        b = t;
+    }
+
+    b->next = a->sibling;
+    if (b->next) {
+        b->next->ref = &b->next;
+    }
+    a->sibling = b;
+    b->ref = &a->sibling;
+    return a;
+}
+
+// merge a list of siblings into one heap, linking them by pairs from the
+// front and then the pairs from the back
+static struct equeue_event *equeue_heap_merge_pairs(struct equeue_event *e)
+{
+    struct equeue_event *pairs = 0;
+    while (e) {
+        struct equeue_event *a = e;
+        struct equeue_event *b = e->next;
+        if (!b) {
+            a->next = pairs;
+            pairs = a;
+            break;
+        }
+
+        e = b->next;
+        a->next = 0;
+        b->next = 0;
+        a = equeue_heap_link(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    struct equeue_event *root = 0;
+    while (pairs) {
+        struct equeue_event *a = pairs;
+        pairs = a->next;
+        a->next = 0;
+        root = root ? equeue_heap_link(root, a) : a;
+    }
+
+    return root;
+}
+#endif
+
 // Increment the unique id in an event, hiding the event from cancel
 static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
 {
@@ -90,16 +211,31 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
         q->npw2++;
     }
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+    for (unsigned i = 0; i < EQUEUE_BUCKET_COUNT; i++) {
+        q->buckets[i] = 0;
+    }
+#else
     q->chunks = 0;
+#endif
     q->slab.size = size;
     q->slab.data = q->buffer;
 
     q->queue = 0;
+    q->pending = 0;
     equeue_tick_init();
     q->tick = equeue_tick();
     q->generation = 0;
+#if EQUEUE_SCHEDULER_HEAP
+    q->seq = 0;
+#endif
     q->break_requested = false;
 
+#if EQUEUE_STATS
+    memset(&q->stats, 0, sizeof(q->stats));
+    q->stats.reserved_size = size;
+#endif
+
     q->background.active = false;
     q->background.update = 0;
     q->background.timer = 0;
@@ -127,6 +263,24 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
 void equeue_destroy(equeue_t *q)
 {
     // call destructors on pending events
+#if EQUEUE_SCHEDULER_HEAP
+    // visit the children of an event before it, by rotating them in front of it
+    struct equeue_event *e = q->queue;
+    while (e) {
+        if (e->sibling) {
+            struct equeue_event *c = e->sibling;
+            e->sibling = c->next;
+            c->next = e;
+            e = c;
+        } else {
+            struct equeue_event *next = e->next;
+            if (e->dtor) {
+                e->dtor(e + 1);
+            }
+            e = next;
+        }
+    }
+#else
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
             if (e->dtor) {
@@ -137,6 +291,13 @@ void equeue_destroy(equeue_t *q)
             es->dtor(es + 1);
         }
     }
+#endif
+    for (struct equeue_event *e = q->pending; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -157,8 +318,29 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
     size += sizeof(struct equeue_event);
     size = (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+    // round up to the size class, larger allocations only come from the slab
+    unsigned bucket = equeue_bucket(size);
+    if (bucket < EQUEUE_BUCKET_COUNT) {
+        size = (size_t)1 << (bucket + EQUEUE_BUCKET_MIN_NPW2);
+    }
+#endif
+
     equeue_mutex_lock(&q->memlock);
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+    // check if an event of the size class is available
+    if (bucket < EQUEUE_BUCKET_COUNT && q->buckets[bucket]) {
+        struct equeue_event *e = q->buckets[bucket];
+        q->buckets[bucket] = e->next;
+
+#if EQUEUE_STATS
+        equeue_stats_alloc(q, e->size);
+#endif
+        equeue_mutex_unlock(&q->memlock);
+        return e;
+    }
+#else
     // check if a good chunk is available
     for (struct equeue_event **p = &q->chunks; *p; p = &(*p)->next) {
         if ((*p)->size >= size) {
@@ -170,10 +352,14 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
                 *p = e->next;
             }
 
+#if EQUEUE_STATS
+            equeue_stats_alloc(q, e->size);
+#endif
             equeue_mutex_unlock(&q->memlock);
             return e;
         }
     }
+#endif
 
     // otherwise allocate a new chunk out of the slab
     if (q->slab.size >= size) {
@@ -183,10 +369,32 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
         e->size = size;
         e->id = 1;
 
+#if EQUEUE_STATS
+        equeue_stats_alloc(q, e->size);
+#endif
         equeue_mutex_unlock(&q->memlock);
         return e;
     }
 
+#if EQUEUE_ALLOCATOR_BUCKETS
+    // otherwise fall back to an event of a larger size class
+    for (unsigned i = bucket + 1; i < EQUEUE_BUCKET_COUNT; i++) {
+        if (q->buckets[i]) {
+            struct equeue_event *e = q->buckets[i];
+            q->buckets[i] = e->next;
+
+#if EQUEUE_STATS
+            equeue_stats_alloc(q, e->size);
+#endif
+            equeue_mutex_unlock(&q->memlock);
+            return e;
+        }
+    }
+#endif
+
+#if EQUEUE_STATS
+    q->stats.alloc_fail_cnt++;
+#endif
     equeue_mutex_unlock(&q->memlock);
     return 0;
 }
@@ -195,6 +403,16 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
 {
     equeue_mutex_lock(&q->memlock);
 
+#if EQUEUE_STATS
+    q->stats.current_size -= e->size;
+#endif
+
+#if EQUEUE_ALLOCATOR_BUCKETS
+    // stick chunk into the list of the largest size class it fits
+    unsigned bucket = equeue_bucket_of(e->size);
+    e->next = q->buckets[bucket];
+    q->buckets[bucket] = e;
+#else
     // stick chunk into list of chunks
     struct equeue_event **p = &q->chunks;
     while (*p && (*p)->size < e->size) {
@@ -209,8 +427,41 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
         e->next = *p;
     }
     *p = e;
+#endif
+
+    equeue_mutex_unlock(&q->memlock);
+}
 
+void equeue_mem_info(equeue_t *q, equeue_mem_info_t *info)
+{
+    info->free_size = 0;
+    info->free_cnt = 0;
+    info->allocatable_size = 0;
+
+    equeue_mutex_lock(&q->memlock);
+    info->slab_size = q->slab.size;
+#if EQUEUE_ALLOCATOR_BUCKETS
+    for (unsigned i = 0; i < EQUEUE_BUCKET_COUNT; i++) {
+        for (struct equeue_event *e = q->buckets[i]; e; e = e->next) {
+#else
+    for (struct equeue_event *es = q->chunks; es; es = es->next) {
+        for (struct equeue_event *e = es; e; e = e->sibling) {
+#endif
+            info->free_size += e->size;
+            info->free_cnt += 1;
+            if (e->size > info->allocatable_size) {
+                info->allocatable_size = e->size;
+            }
+        }
+    }
     equeue_mutex_unlock(&q->memlock);
+
+    if (info->slab_size > info->allocatable_size) {
+        info->allocatable_size = info->slab_size;
+    }
+
+    size_t total = info->slab_size + info->free_size;
+    info->fragmentation = total ? 100 - (unsigned)((uint64_t)100 * info->allocatable_size / total) : 0;
 }
 
 void *equeue_alloc(equeue_t *q, size_t size)
@@ -222,6 +473,7 @@ void *equeue_alloc(equeue_t *q, size_t size)
 
     e->target = 0;
     e->period = -1;
+    e->slack = 0;
     e->dtor = 0;
 
     return e + 1;
@@ -242,6 +494,61 @@ void equeue_dealloc(equeue_t *q, void *p)
     }
 }
 
+// find the latest tick the dispatch loop can wake up at, the earliest target
+// plus slack of the events, called with the queuelock held
+static bool equeue_wakeup(equeue_t *q, unsigned *wakeup)
+{
+    if (!q->queue) {
+        return false;
+    }
+
+    // only events due before the current wake up can move it earlier
+    unsigned wake = q->queue->target + q->queue->slack;
+#if EQUEUE_SCHEDULER_HEAP
+    // the children of an event are due after it, so the search is pruned to
+    // the subtrees due before wake, the ones beyond the stack waking up at
+    // their root's target
+    struct equeue_event *stack[EQUEUE_WAKEUP_DEPTH];
+    unsigned n = 0;
+    stack[n++] = q->queue;
+    while (n) {
+        struct equeue_event *es = stack[--n];
+        for (struct equeue_event *e = es->sibling; e; e = e->next) {
+            if (equeue_tickdiff(e->target, wake) >= 0) {
+                continue;
+            }
+
+            if (equeue_tickdiff(e->target + e->slack, wake) < 0) {
+                wake = e->target + e->slack;
+            }
+
+            if (e->sibling) {
+                if (n < EQUEUE_WAKEUP_DEPTH) {
+                    stack[n++] = e;
+                } else {
+                    wake = e->target;
+                }
+            }
+        }
+    }
+#else
+    for (struct equeue_event *es = q->queue; es; es = es->next) {
+        if (equeue_tickdiff(es->target, wake) >= 0) {
+            break;
+        }
+
+        for (struct equeue_event *e = es; e; e = e->sibling) {
+            if (equeue_tickdiff(e->target + e->slack, wake) < 0) {
+                wake = e->target + e->slack;
+            }
+        }
+    }
+#endif
+
+    *wakeup = wake;
+    return true;
+}
+
 void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 {
     e->target = tick + equeue_clampdiff(e->target, tick);
@@ -249,6 +556,20 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     equeue_mutex_lock(&q->queuelock);
 
+#if EQUEUE_STATS
+    equeue_stats_depth(q, 1);
+#endif
+
+#if EQUEUE_SCHEDULER_HEAP
+    e->seq = q->seq++;
+    e->next = 0;
+    e->sibling = 0;
+    q->queue = q->queue ? equeue_heap_link(q->queue, e) : e;
+    q->queue->ref = &q->queue;
+
+    // ties go to the events posted earlier, so e is only the root if it is the earliest
+    bool head = (q->queue == e);
+#else
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -275,11 +596,18 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
     *p = e;
     e->ref = p;
 
-    // notify background timer
-    if ((q->background.update && q->background.active) &&
-            (q->queue == e && !e->sibling)) {
-        q->background.update(q->background.timer,
-                             equeue_clampdiff(e->target, tick));
+    bool head = (q->queue == e && !e->sibling);
+#endif
+
+    // notify background timer if the event moved the wake up earlier, either
+    // as the new head or by being due before the slack of the head runs out
+    if (q->background.update && q->background.active) {
+        unsigned wakeup;
+        equeue_wakeup(q, &wakeup);
+        if (head || wakeup == e->target + e->slack) {
+            q->background.update(q->background.timer,
+                                 equeue_clampdiff(wakeup, tick));
+        }
     }
     equeue_mutex_unlock(&q->queuelock);
 }
@@ -305,6 +633,19 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
     }
 
     // disentangle from queue
+#if EQUEUE_SCHEDULER_HEAP
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    }
+
+    // the children of the event go back in the heap
+    struct equeue_event *children = equeue_heap_merge_pairs(e->sibling);
+    if (children) {
+        q->queue = q->queue ? equeue_heap_link(q->queue, children) : children;
+        q->queue->ref = &q->queue;
+    }
+#else
     if (e->sibling) {
         e->sibling->next = e->next;
         if (e->sibling->next) {
@@ -319,6 +660,10 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
             e->next->ref = e->ref;
         }
     }
+#endif
+#if EQUEUE_STATS
+    equeue_stats_depth(q, -1);
+#endif
     equeue_mutex_unlock(&q->queuelock);
     return e;
 }
@@ -356,6 +701,24 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         q->tick = target;
     }
 
+#if EQUEUE_SCHEDULER_HEAP
+    // pop the expired events, already in dispatch order
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    while (q->queue && equeue_tickdiff(q->queue->target, target) <= 0) {
+        struct equeue_event *e = q->queue;
+        q->queue = equeue_heap_merge_pairs(e->sibling);
+        if (q->queue) {
+            q->queue->ref = &q->queue;
+        }
+
+        *tail = e;
+        tail = &e->next;
+    }
+    *tail = 0;
+
+    equeue_mutex_unlock(&q->queuelock);
+#else
     struct equeue_event *head = q->queue;
     struct equeue_event **p = &head;
     while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
@@ -387,6 +750,7 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         *tail = prev;
         tail = &es->next;
     }
+#endif
 
     return head;
 }
@@ -416,6 +780,60 @@ void equeue_post_user_allocated(equeue_t *q, void (*cb)(void *), void *p)
     equeue_sema_signal(&q->eventsema);
 }
 
+bool equeue_post_user_allocated_lockfree(equeue_t *q, void (*cb)(void *), void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p;
+    uint8_t state = EQUEUE_USER_ALLOCATED_EVENT_STATE_DONE;
+    if (!equeue_atomic_cas_u8(&e->id, &state, EQUEUE_USER_ALLOCATED_EVENT_STATE_PENDING)) {
+        return false;
+    }
+
+    e->cb = cb;
+    e->target = equeue_tick() + e->target;
+
+    void *head = q->pending;
+    do {
+        e->next = head;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->pending, &head, e));
+
+    equeue_sema_signal(&q->eventsema);
+    return true;
+}
+
+// move the events posted lock-free into the queue
+static void equeue_enqueue_pending(equeue_t *q, unsigned tick)
+{
+    struct equeue_event *es = equeue_atomic_exchange_ptr((void *volatile *)&q->pending, 0);
+
+    // the list is in reverse posting order
+    struct equeue_event *fifo = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = fifo;
+        fifo = e;
+    }
+
+    while (fifo) {
+        struct equeue_event *e = fifo;
+        fifo = e->next;
+
+        equeue_mutex_lock(&q->queuelock);
+        bool canceled = !e->cb;
+        equeue_mutex_unlock(&q->queuelock);
+        if (canceled) {
+            equeue_dealloc(q, e + 1);
+            continue;
+        }
+
+        // an event canceled from here on is dispatched as a no-op
+        equeue_enqueue(q, e, tick);
+        equeue_mutex_lock(&q->queuelock);
+        e->id = EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS;
+        equeue_mutex_unlock(&q->queuelock);
+    }
+}
+
 bool equeue_cancel(equeue_t *q, int id)
 {
     if (!id) {
@@ -437,6 +855,16 @@ bool equeue_cancel_user_allocated(equeue_t *q, void *e)
         return false;
     }
 
+    // not in the queue yet, leave it to the dispatch loop
+    equeue_mutex_lock(&q->queuelock);
+    if (((struct equeue_event *)e)->id == EQUEUE_USER_ALLOCATED_EVENT_STATE_PENDING) {
+        ((struct equeue_event *)e)->cb = 0;
+        ((struct equeue_event *)e)->period = -1;
+        equeue_mutex_unlock(&q->queuelock);
+        return true;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
     struct equeue_event *_e = equeue_unqueue_by_address(q, e);
     if (_e) {
         equeue_dealloc(q, _e + 1);
@@ -481,6 +909,42 @@ int equeue_timeleft_user_allocated(equeue_t *q, void *e)
     return ret;
 }
 
+void equeue_stats_get(equeue_t *q, equeue_stats_t *stats)
+{
+#if EQUEUE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_mutex_lock(&q->memlock);
+    stats->current_size = q->stats.current_size;
+    stats->max_size = q->stats.max_size;
+    stats->alloc_fail_cnt = q->stats.alloc_fail_cnt;
+    equeue_mutex_unlock(&q->memlock);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void equeue_stats_reset(equeue_t *q)
+{
+#if EQUEUE_STATS
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.dispatch_cnt = 0;
+    q->stats.max_latency = 0;
+    q->stats.total_latency = 0;
+    q->stats.max_run_time = 0;
+    q->stats.total_run_time = 0;
+    q->stats.max_depth = q->stats.current_depth;
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_mutex_lock(&q->memlock);
+    q->stats.max_size = q->stats.current_size;
+    q->stats.alloc_fail_cnt = 0;
+    equeue_mutex_unlock(&q->memlock);
+#endif
+}
+
 void equeue_break(equeue_t *q)
 {
     equeue_mutex_lock(&q->queuelock);
@@ -496,9 +960,25 @@ void equeue_dispatch(equeue_t *q, int ms)
     q->background.active = false;
 
     while (1) {
+        if (q->pending) {
+            equeue_enqueue_pending(q, tick);
+        }
+
         // collect all the available events and next deadline
         struct equeue_event *es = equeue_dequeue(q, tick);
 
+#if EQUEUE_STATS
+        if (es) {
+            int n = 0;
+            for (struct equeue_event *e = es; e; e = e->next) {
+                n++;
+            }
+            equeue_mutex_lock(&q->queuelock);
+            equeue_stats_depth(q, -n);
+            equeue_mutex_unlock(&q->queuelock);
+        }
+#endif
+
         // dispatch events
         while (es) {
             struct equeue_event *e = es;
@@ -507,13 +987,24 @@ void equeue_dispatch(equeue_t *q, int ms)
             // actually dispatch the callbacks
             void (*cb)(void *) = e->cb;
             if (cb) {
+#if EQUEUE_STATS
+                unsigned start = equeue_tick();
+                unsigned latency = equeue_clampdiff(start, e->target);
                 cb(e + 1);
+                equeue_stats_dispatch(q, latency, equeue_clampdiff(equeue_tick(), start));
+#else
+                cb(e + 1);
+#endif
             }
 
             // reenqueue periodic events or deallocate
             if (e->period >= 0) {
                 e->target += e->period;
+#if EQUEUE_DISPATCH_BATCH
+                equeue_enqueue(q, e, tick);
+#else
                 equeue_enqueue(q, e, equeue_tick());
+#endif
             } else {
                 if (!EQUEUE_IS_USER_ALLOCATED_EVENT(e)) {
                     equeue_incid(q, e);
@@ -532,9 +1023,10 @@ void equeue_dispatch(equeue_t *q, int ms)
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
+                    unsigned wakeup;
+                    if (q->background.update && equeue_wakeup(q, &wakeup)) {
                         q->background.update(q->background.timer,
-                                             equeue_clampdiff(q->queue->target, tick));
+                                             equeue_clampdiff(wakeup, tick));
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -546,14 +1038,22 @@ void equeue_dispatch(equeue_t *q, int ms)
 
         // find closest deadline
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
+        unsigned wakeup;
+        if (equeue_wakeup(q, &wakeup)) {
+            int diff = equeue_clampdiff(wakeup, tick);
             if ((unsigned)diff < (unsigned)deadline) {
                 deadline = diff;
             }
         }
         equeue_mutex_unlock(&q->queuelock);
 
+#if EQUEUE_DISPATCH_BATCH
+        // the next batch is already due
+        if (deadline == 0 && !q->break_requested) {
+            continue;
+        }
+#endif
+
         // wait for events
         equeue_sema_wait(&q->eventsema, deadline);
 
@@ -587,6 +1087,12 @@ void equeue_event_period(void *p, int ms)
     e->period = ms;
 }
 
+void equeue_event_slack(void *p, int ms)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->slack = ms > 0 ? ms : 0;
+}
+
 void equeue_event_dtor(void *p, void (*dtor)(void *))
 {
     struct equeue_event *e = (struct equeue_event *)p - 1;
@@ -658,9 +1164,10 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
+    unsigned wakeup;
+    if (q->background.update && equeue_wakeup(q, &wakeup)) {
         q->background.update(q->background.timer,
-                             equeue_clampdiff(q->queue->target, equeue_tick()));
+                             equeue_clampdiff(wakeup, equeue_tick()));
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
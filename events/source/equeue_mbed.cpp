@@ -23,6 +23,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include "cmsis.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 #include "drivers/Timer.h"
@@ -65,7 +66,7 @@ unsigned equeue_tick()
         // current alternative!
         d = std::chrono::duration_cast<unsigned_ms_t>(mbed::internal::os_timer->get_time().time_since_epoch());
     } else {
-        d = rtos::Kernel::Clock::now().time_since_epoch();
+        d = std::chrono::duration_cast<unsigned_ms_t>(rtos::Kernel::Clock::now().time_since_epoch());
     }
 #else
     // And this is the legacy behaviour - if running in
@@ -73,7 +74,7 @@ unsigned equeue_tick()
     // documentation saying no. (Most recent CMSIS-RTOS
     // permits `ososKernelGetTickCount` from IRQ, and our
     // `rtos::Kernel` wrapper copes too).
-    d = rtos::Kernel::Clock::now().time_since_epoch();
+    d = std::chrono::duration_cast<unsigned_ms_t>(rtos::Kernel::Clock::now().time_since_epoch());
 #endif
     return d.count();
 }
@@ -150,6 +151,23 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired)
+{
+    return core_util_atomic_cas_ptr(ptr, expected, desired);
+}
+
+bool equeue_atomic_cas_u8(volatile uint8_t *ptr, uint8_t *expected, uint8_t desired)
+{
+    return core_util_atomic_cas_u8(ptr, expected, desired);
+}
+
+void *equeue_atomic_exchange_ptr(void *volatile *ptr, void *desired)
+{
+    return core_util_atomic_exchange_ptr(ptr, desired);
+}
+
+
 // Semaphore operations
 #ifdef MBED_CONF_RTOS_API_PRESENT
 
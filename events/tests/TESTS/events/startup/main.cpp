@@ -0,0 +1,130 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_events.h"
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define TASK_DURATION 100ms
+
+static volatile bool both_ready_before_join;
+static volatile bool dependent_ran;
+
+static int slow_init()
+{
+    ThisThread::sleep_for(TASK_DURATION);
+    return 0;
+}
+
+static int failing_init()
+{
+    return -1;
+}
+
+static StartupTask first("first", slow_init);
+static StartupTask second("second", slow_init);
+static StartupTask join("join", [] {
+    both_ready_before_join = first.is_ready() && second.is_ready();
+    return 0;
+}, {&first, &second});
+
+static StartupTask failing("failing", failing_init);
+static StartupTask dependent("dependent", [] {
+    dependent_ran = true;
+    return 0;
+}, {&failing, &join});
+
+/** Test that independent tasks run in parallel, before the tasks depending on them.
+ *
+ *  Given two slow tasks and a third depending on both.
+ *  When the third is waited for, before the tasks are started.
+ *  Then the tasks start, the slow ones complete in about the time of one,
+ *  and the third runs when both have completed.
+ */
+void parallel_test()
+{
+    TEST_ASSERT_FALSE(first.is_ready());
+
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(0, join.wait());
+    timer.stop();
+
+    TEST_ASSERT_TRUE(both_ready_before_join);
+    TEST_ASSERT_EQUAL(0, first.result());
+    TEST_ASSERT_EQUAL(0, second.result());
+    TEST_ASSERT_TRUE(timer.elapsed_time() >= TASK_DURATION);
+    TEST_ASSERT_TRUE(timer.elapsed_time() < 2 * TASK_DURATION);
+}
+
+/** Test that a failed task fails the tasks depending on it.
+ *
+ *  Given a failing task and a task depending on it.
+ *  When both complete.
+ *  Then the dependent task fails without running.
+ */
+void failure_test()
+{
+    TEST_ASSERT_TRUE(failing.wait_for(1s));
+    TEST_ASSERT_EQUAL(-1, failing.result());
+    TEST_ASSERT_EQUAL(MBED_ERROR_INITIALIZATION_FAILED, dependent.wait());
+    TEST_ASSERT_FALSE(dependent_ran);
+}
+
+/** Test that tasks registered once started run.
+ *
+ *  Given the tasks completed.
+ *  When a task is registered, and wait_all called.
+ *  Then the late task runs and wait_all reports the failed task.
+ */
+void late_task_test()
+{
+    static StartupTask late("late", [] {
+        return 0;
+    }, {&first});
+    TEST_ASSERT_EQUAL(0, late.wait());
+    TEST_ASSERT_FALSE(StartupTask::wait_all());
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+const Case cases[] = {
+    Case("Testing startup tasks in parallel", parallel_test),
+    Case("Testing startup task failure", failure_test),
+    Case("Testing startup task registered late", late_task_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
@@ -0,0 +1,159 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_events.h"
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define TEST_WORKERS 2
+#define TEST_STACK_SIZE 768
+#define TEST_JOBS 8
+
+static volatile uint32_t counter;
+
+static void count_job()
+{
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+static void sleep_job()
+{
+    ThisThread::sleep_for(50ms);
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+/** Test that the jobs posted to a pool all run.
+ *
+ *  Given a pool of worker threads.
+ *  When jobs are posted until the job buffer is full.
+ *  Then each posted job runs once, and the buffer can be filled again.
+ */
+void call_test()
+{
+    WorkerPool pool(TEST_WORKERS, TEST_JOBS * WORKER_POOL_JOB_SIZE, TEST_STACK_SIZE);
+    TEST_ASSERT_EQUAL(TEST_WORKERS, pool.workers());
+
+    for (int round = 0; round < 2; round++) {
+        counter = 0;
+        uint32_t posted = 0;
+        while (pool.call(count_job)) {
+            posted++;
+        }
+        // the workers may take jobs while they are posted
+        TEST_ASSERT_TRUE(posted >= TEST_JOBS);
+
+        ThisThread::sleep_for(10ms);
+        TEST_ASSERT_EQUAL(posted, counter);
+    }
+}
+
+/** Test that blocking jobs run in parallel.
+ *
+ *  Given a pool of worker threads.
+ *  When as many sleeping jobs as threads are posted.
+ *  Then they complete in about the time of a single job.
+ */
+void parallel_test()
+{
+    WorkerPool pool(TEST_WORKERS, TEST_JOBS * WORKER_POOL_JOB_SIZE, TEST_STACK_SIZE);
+
+    counter = 0;
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < TEST_WORKERS; i++) {
+        TEST_ASSERT_TRUE(pool.call(sleep_job));
+    }
+    while (counter < TEST_WORKERS) {
+        ThisThread::sleep_for(1ms);
+    }
+    timer.stop();
+
+    TEST_ASSERT_INT_WITHIN(20000, 50000, timer.elapsed_time().count());
+}
+
+static uint8_t buffer[1000];
+
+static void fill_chunk(size_t offset, size_t length)
+{
+    for (size_t i = offset; i < offset + length; i++) {
+        buffer[i]++;
+    }
+}
+
+/** Test fork_join covers each element of a buffer exactly once.
+ *
+ *  Given a pool of worker threads.
+ *  When fork_join is called with various chunk sizes, including from a job of the pool.
+ *  Then each element is processed once and fork_join returns when all of them are.
+ */
+void fork_join_test()
+{
+    WorkerPool pool(TEST_WORKERS, TEST_JOBS * WORKER_POOL_JOB_SIZE, TEST_STACK_SIZE);
+
+    const size_t chunk_sizes[] = {1, 7, 100, 999, 1000, 4096};
+    for (size_t chunk_size : chunk_sizes) {
+        memset(buffer, 0, sizeof buffer);
+        pool.fork_join(sizeof buffer, chunk_size, fill_chunk);
+        for (size_t i = 0; i < sizeof buffer; i++) {
+            TEST_ASSERT_EQUAL(1, buffer[i]);
+        }
+    }
+
+    // from a job, with the other thread busy
+    memset(buffer, 0, sizeof buffer);
+    counter = 0;
+    TEST_ASSERT_TRUE(pool.call(sleep_job));
+    TEST_ASSERT_TRUE(pool.call([&pool] {
+        pool.fork_join(sizeof buffer, 10, fill_chunk);
+        core_util_atomic_incr_u32(&counter, 1);
+    }));
+    while (counter < 2) {
+        ThisThread::sleep_for(1ms);
+    }
+    for (size_t i = 0; i < sizeof buffer; i++) {
+        TEST_ASSERT_EQUAL(1, buffer[i]);
+    }
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+const Case cases[] = {
+    Case("Testing worker pool calls", call_test),
+    Case("Testing worker pool parallel jobs", parallel_test),
+    Case("Testing worker pool fork_join", fork_join_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
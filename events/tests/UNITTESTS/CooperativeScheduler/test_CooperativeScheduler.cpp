@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/CooperativeScheduler.h"
+#include <errno.h>
+#include <string>
+
+using namespace events;
+
+extern "C" unsigned int equeue_global_time;
+
+static std::string trace;
+
+static void record(char c)
+{
+    trace += c;
+}
+
+class TestCooperativeScheduler : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        trace.clear();
+    }
+
+    EventQueue *high()
+    {
+        return scheduler.queue(CooperativeScheduler::PriorityHigh);
+    }
+
+    EventQueue *normal()
+    {
+        return scheduler.queue(CooperativeScheduler::PriorityNormal);
+    }
+
+    EventQueue *low()
+    {
+        return scheduler.queue(CooperativeScheduler::PriorityLow);
+    }
+
+    CooperativeScheduler scheduler;
+};
+
+TEST_F(TestCooperativeScheduler, priority_order)
+{
+    low()->call(record, 'l');
+    normal()->call(record, 'n');
+    high()->call(record, 'h');
+
+    scheduler.run_for(0);
+    EXPECT_EQ("hnl", trace);
+}
+
+TEST_F(TestCooperativeScheduler, higher_level_between_batches)
+{
+    // The high event posted by the first low one runs before the low one
+    // posted along
+    low()->call([this] {
+        record('1');
+        low()->call(record, '2');
+        high()->call(record, 'h');
+    });
+
+    scheduler.run_for(0);
+    EXPECT_EQ("1h2", trace);
+}
+
+TEST_F(TestCooperativeScheduler, timed_events)
+{
+    unsigned start = equeue_global_time;
+    low()->call_in(std::chrono::milliseconds(50), record, 'b');
+    high()->call_in(std::chrono::milliseconds(20), record, 'a');
+
+    scheduler.run_for(10);
+    EXPECT_EQ("", trace);
+    scheduler.run_for(100);
+    EXPECT_EQ("ab", trace);
+    EXPECT_GE(equeue_global_time - start, 100u);
+}
+
+TEST_F(TestCooperativeScheduler, attached_queue)
+{
+    EventQueue queue(256);
+    EXPECT_EQ(0, scheduler.attach(&queue, CooperativeScheduler::PriorityHigh));
+
+    EventQueue other(256);
+    EXPECT_EQ(-ENOMEM, scheduler.attach(&other, CooperativeScheduler::PriorityLow));
+
+    // Posted before and after attaching
+    normal()->call(record, 'n');
+    queue.call(record, 'q');
+    scheduler.run_for(0);
+    EXPECT_EQ("qn", trace);
+
+    scheduler.detach(&queue);
+    queue.call(record, 'q');
+    scheduler.run_for(0);
+    EXPECT_EQ("qn", trace);
+    queue.dispatch(0);
+    EXPECT_EQ("qnq", trace);
+
+    EXPECT_EQ(0, scheduler.attach(&other, CooperativeScheduler::PriorityLow));
+    scheduler.detach(&other);
+}
+
+TEST_F(TestCooperativeScheduler, signal_coalesced)
+{
+    CooperativeScheduler::Signal signal(&scheduler, [] { record('s'); }, CooperativeScheduler::PriorityHigh);
+
+    signal.raise();
+    signal.raise();
+    scheduler.run_for(0);
+    EXPECT_EQ("s", trace);
+
+    signal.raise();
+    scheduler.run_for(0);
+    EXPECT_EQ("ss", trace);
+
+    signal.raise();
+    signal.cancel();
+    scheduler.run_for(0);
+    EXPECT_EQ("ss", trace);
+}
+
+TEST_F(TestCooperativeScheduler, break_dispatch)
+{
+    normal()->call_every(std::chrono::milliseconds(10), record, 'e');
+    low()->call_in(std::chrono::milliseconds(35), [this] {
+        scheduler.break_dispatch();
+    });
+
+    scheduler.run();
+    EXPECT_EQ("eee", trace);
+}
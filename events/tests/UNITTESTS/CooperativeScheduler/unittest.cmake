@@ -0,0 +1,31 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../events/source
+  ../events/include/events
+  ../events/include/events/internal
+)
+
+set(unittest-sources
+  ../events/source/CooperativeScheduler.cpp
+  ../events/source/EventQueue.cpp
+  ../events/source/equeue.c
+)
+
+set(unittest-test-sources
+  ../events/tests/UNITTESTS/CooperativeScheduler/test_CooperativeScheduler.cpp
+  ../events/tests/UNITTESTS/stubs/EqueuePosix_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -pthread
+  -DEQUEUE_PLATFORM_POSIX
+  -DMBED_CONF_EVENTS_COOPERATIVE_EVENTSIZE=256
+  -DMBED_CONF_EVENTS_COOPERATIVE_MAX_QUEUES=4
+)
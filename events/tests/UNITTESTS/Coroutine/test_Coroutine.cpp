@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/Coroutine.h"
+#include "FileHandle_stub.h"
+
+using namespace events;
+using namespace std::chrono;
+
+#define TEST_EQUEUE_SIZE 1024
+
+// Sleeps twice, counting its steps
+class Sleeper : public Coroutine {
+public:
+    Sleeper(EventQueue *queue) : Coroutine(queue), steps(0) { }
+    int steps;
+
+private:
+    void run() override
+    {
+        MBED_CO_BEGIN();
+        steps++;
+        MBED_CO_AWAIT(sleep_for(10ms));
+        steps++;
+        MBED_CO_AWAIT(sleep_for(10ms));
+        steps++;
+        MBED_CO_END();
+    }
+};
+
+// Waits for an operation completed by the test, as by an interrupt handler
+class Waiter : public Coroutine {
+public:
+    Waiter(EventQueue *queue) : Coroutine(queue), start_status(0), results{0, 0} { }
+    mbed::Callback<void(int)> pending;
+    int start_status;
+    int results[2];
+
+private:
+    int start_op()
+    {
+        pending = completion();
+        return start_status;
+    }
+
+    void run() override
+    {
+        MBED_CO_BEGIN();
+        MBED_CO_AWAIT(start_op());
+        results[0] = result();
+        MBED_CO_YIELD();
+        MBED_CO_AWAIT(start_op());
+        results[1] = result();
+        MBED_CO_END();
+    }
+};
+
+class TestFileHandle : public mbed::FileHandle_stub {
+public:
+    bool can_read = false;
+    mbed::Callback<void()> cb;
+
+    short poll(short events) const override
+    {
+        return can_read ? POLLIN : 0;
+    }
+
+    void sigio(mbed::Callback<void()> func) override
+    {
+        cb = func;
+    }
+};
+
+class Reader : public Coroutine {
+public:
+    Reader(EventQueue *queue, mbed::FileHandle &fh) : Coroutine(queue), fh(fh), wakeups(0) { }
+    mbed::FileHandle &fh;
+    int wakeups;
+
+private:
+    void run() override
+    {
+        MBED_CO_BEGIN();
+        do {
+            MBED_CO_AWAIT(wait_readable(fh));
+            wakeups++;
+        } while (!fh.readable());
+        MBED_CO_END();
+    }
+};
+
+static int done_count;
+
+static void on_done()
+{
+    done_count++;
+}
+
+TEST(TestCoroutine, sleep)
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Sleeper co(&queue);
+    done_count = 0;
+
+    EXPECT_TRUE(co.start(on_done));
+    EXPECT_TRUE(co.running());
+    EXPECT_FALSE(co.start());
+
+    queue.dispatch(0);
+    EXPECT_EQ(1, co.steps);
+    queue.dispatch(5);
+    EXPECT_EQ(1, co.steps);
+    queue.dispatch(30);
+    EXPECT_EQ(3, co.steps);
+    EXPECT_FALSE(co.running());
+    EXPECT_EQ(1, done_count);
+
+    // Restarted from the beginning
+    EXPECT_TRUE(co.start());
+    queue.dispatch(30);
+    EXPECT_EQ(6, co.steps);
+    EXPECT_EQ(1, done_count);
+}
+
+TEST(TestCoroutine, completion)
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Waiter co(&queue);
+
+    co.start();
+    queue.dispatch(0);
+    EXPECT_TRUE(co.running());
+    EXPECT_EQ(0, co.results[0]);
+
+    co.pending(7);
+    // Spurious completions are ignored
+    co.pending(8);
+    queue.dispatch(0);
+    EXPECT_EQ(7, co.results[0]);
+    EXPECT_TRUE(co.running());
+
+    // Past the yield, waiting again
+    queue.dispatch(0);
+    co.pending(9);
+    queue.dispatch(0);
+    EXPECT_EQ(9, co.results[1]);
+    EXPECT_FALSE(co.running());
+}
+
+TEST(TestCoroutine, failed_start)
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Waiter co(&queue);
+    co.start_status = -1;
+
+    co.start();
+    queue.dispatch(10);
+    EXPECT_EQ(-1, co.results[0]);
+    EXPECT_EQ(-1, co.results[1]);
+    EXPECT_FALSE(co.running());
+}
+
+TEST(TestCoroutine, wait_readable)
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    TestFileHandle fh;
+    Reader co(&queue, fh);
+
+    co.start();
+    queue.dispatch(0);
+    EXPECT_TRUE(co.running());
+    ASSERT_TRUE(fh.cb);
+
+    // Woken up for something else, waits again
+    fh.cb();
+    queue.dispatch(0);
+    EXPECT_EQ(1, co.wakeups);
+    EXPECT_TRUE(co.running());
+
+    fh.can_read = true;
+    fh.cb();
+    queue.dispatch(0);
+    EXPECT_EQ(2, co.wakeups);
+    EXPECT_FALSE(co.running());
+    EXPECT_FALSE(fh.cb);
+
+    // Already readable, doesn't suspend
+    co.start();
+    queue.dispatch(0);
+    EXPECT_EQ(3, co.wakeups);
+    EXPECT_FALSE(co.running());
+}
+
+TEST(TestCoroutine, interleaved)
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    Sleeper a(&queue);
+    Sleeper b(&queue);
+
+    a.start();
+    queue.dispatch(5);
+    b.start();
+    queue.dispatch(0);
+    EXPECT_EQ(1, a.steps);
+    EXPECT_EQ(1, b.steps);
+    queue.dispatch(10);
+    EXPECT_EQ(2, a.steps);
+    EXPECT_EQ(2, b.steps);
+    queue.dispatch(30);
+    EXPECT_EQ(3, a.steps);
+    EXPECT_EQ(3, b.steps);
+}
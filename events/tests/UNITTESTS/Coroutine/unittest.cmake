@@ -0,0 +1,28 @@
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../events/source
+  ../events/include/events
+  ../events/include/events/internal
+)
+
+set(unittest-sources
+  ../events/source/Coroutine.cpp
+  ../events/source/EventQueue.cpp
+  ../events/source/equeue.c
+)
+
+set(unittest-test-sources
+  ../events/tests/UNITTESTS/Coroutine/test_Coroutine.cpp
+  ../events/tests/UNITTESTS/stubs/EqueuePosix_stub.c
+  stubs/FileHandle_stub.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+)
+
+set(unittest-test-flags
+  -pthread
+  -DEQUEUE_PLATFORM_POSIX
+)
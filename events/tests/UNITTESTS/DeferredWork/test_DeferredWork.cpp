@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/DeferredWork.h"
+#include "events/mbed_shared_queues.h"
+#include <string>
+
+using namespace events;
+
+static std::string trace;
+
+static void record(char c)
+{
+    trace += c;
+}
+
+class TestDeferredWork : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        trace.clear();
+    }
+
+    void run_pending()
+    {
+        mbed::mbed_event_queue()->dispatch(0);
+    }
+};
+
+TEST_F(TestDeferredWork, priority_order)
+{
+    DeferredWork low([] { record('l'); }, DeferredWork::PriorityLow);
+    DeferredWork normal1([] { record('1'); });
+    DeferredWork normal2([] { record('2'); });
+    DeferredWork high([] { record('h'); }, DeferredWork::PriorityHigh);
+
+    EXPECT_TRUE(low.schedule());
+    EXPECT_TRUE(normal1.schedule());
+    EXPECT_TRUE(normal2.schedule());
+    EXPECT_TRUE(high.schedule());
+    EXPECT_TRUE(normal1.pending());
+
+    run_pending();
+    EXPECT_EQ("h12l", trace);
+    EXPECT_FALSE(normal1.pending());
+}
+
+TEST_F(TestDeferredWork, coalesced)
+{
+    DeferredWork work([] { record('w'); });
+
+    EXPECT_TRUE(work.schedule());
+    EXPECT_FALSE(work.schedule());
+    run_pending();
+    EXPECT_EQ("w", trace);
+
+    // Scheduled again once run
+    EXPECT_TRUE(work.schedule());
+    run_pending();
+    EXPECT_EQ("ww", trace);
+}
+
+TEST_F(TestDeferredWork, cancel)
+{
+    DeferredWork a([] { record('a'); });
+    DeferredWork b([] { record('b'); });
+    DeferredWork c([] { record('c'); });
+
+    EXPECT_FALSE(b.cancel());
+    a.schedule();
+    b.schedule();
+    c.schedule();
+    EXPECT_TRUE(b.cancel());
+    EXPECT_TRUE(c.cancel());
+    EXPECT_FALSE(c.pending());
+
+    // The queue is still consistent after removing the middle and the tail
+    c.schedule();
+    run_pending();
+    EXPECT_EQ("ac", trace);
+}
+
+TEST_F(TestDeferredWork, destroyed_pending)
+{
+    DeferredWork a([] { record('a'); });
+    {
+        DeferredWork b([] { record('b'); });
+        b.schedule();
+        a.schedule();
+    }
+    run_pending();
+    EXPECT_EQ("a", trace);
+}
+
+static DeferredWork *chained;
+
+TEST_F(TestDeferredWork, scheduled_from_work)
+{
+    DeferredWork second([] { record('2'); }, DeferredWork::PriorityHigh);
+    DeferredWork first([] {
+        record('1');
+        chained->schedule();
+    }, DeferredWork::PriorityLow);
+    chained = &second;
+
+    first.schedule();
+    run_pending();
+    EXPECT_EQ("12", trace);
+}
@@ -0,0 +1,29 @@
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../events/source
+  ../events/include/events
+  ../events/include/events/internal
+)
+
+set(unittest-sources
+  ../events/source/DeferredWork.cpp
+  ../events/source/mbed_shared_queues.cpp
+  ../events/source/EventQueue.cpp
+  ../events/source/equeue.c
+)
+
+set(unittest-test-sources
+  ../events/tests/UNITTESTS/DeferredWork/test_DeferredWork.cpp
+  ../events/tests/UNITTESTS/stubs/EqueuePosix_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -pthread
+  -DEQUEUE_PLATFORM_POSIX
+  -DMBED_CONF_EVENTS_SHARED_EVENTSIZE=768
+)
@@ -28,6 +28,20 @@
 
 extern unsigned int equeue_global_time;
 
+// buffer size taken by an event, rounded up by the size-class allocator
+static size_t test_event_size(size_t size)
+{
+#if EQUEUE_ALLOCATOR_BUCKETS
+    size_t bucket = (size_t)1 << EQUEUE_BUCKET_MIN_NPW2;
+    while (bucket < size) {
+        bucket <<= 1;
+    }
+    return bucket;
+#else
+    return size;
+#endif
+}
+
 class TestEqueue : public testing::Test {
     virtual void SetUp()
     {
@@ -428,7 +442,7 @@ TEST_F(TestEqueue, test_equeue_allocation_failure)
 TEST_F(TestEqueue, test_equeue_cancel)
 {
     equeue_t q;
-    int err = equeue_create(&q, (2 * ITERATION_TIMES * EVENTS_EVENT_SIZE));
+    int err = equeue_create(&q, (2 * ITERATION_TIMES * test_event_size(EVENTS_EVENT_SIZE)));
     ASSERT_EQ(0, err);
 
     uint8_t touched = 0;
@@ -896,7 +910,7 @@ TEST_F(TestEqueue, test_equeue_unchain)
 TEST_F(TestEqueue, test_equeue_simple_barrage)
 {
     equeue_t q;
-    int err = equeue_create(&q, 2 * ITERATION_TIMES * (EQUEUE_EVENT_SIZE + sizeof(struct timing)));
+    int err = equeue_create(&q, 2 * ITERATION_TIMES * test_event_size(EQUEUE_EVENT_SIZE + sizeof(struct timing)));
     ASSERT_EQ(0, err);
 
     for (int i = 0; i < 2 * ITERATION_TIMES; i++) {
@@ -959,7 +973,7 @@ TEST_F(TestEqueue, test_equeue_fragmenting_barrage)
 TEST_F(TestEqueue, test_equeue_multithreaded_barrage)
 {
     equeue_t q;
-    int err = equeue_create(&q, ITERATION_TIMES * (EQUEUE_EVENT_SIZE + sizeof(struct timing)));
+    int err = equeue_create(&q, ITERATION_TIMES * test_event_size(EQUEUE_EVENT_SIZE + sizeof(struct timing)));
     ASSERT_EQ(0, err);
 
     struct ethread t;
@@ -1021,6 +1035,7 @@ TEST_F(TestEqueue, test_equeue_break_request_cleared_on_timeout)
     equeue_destroy(&q);
 }
 
+#if !EQUEUE_SCHEDULER_HEAP
 /** Test that siblings events don't have next pointers.
  *
  *  Given queue is initialized.
@@ -1049,6 +1064,7 @@ TEST_F(TestEqueue, test_equeue_sibling)
     equeue_cancel(&q, id2);
     equeue_destroy(&q);
 }
+#endif
 
 /** Test that equeue executes user allocated events passed by equeue_post.
  *
@@ -1067,7 +1083,7 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
         uint8_t touched;
     };
     equeue_t q;
-    int err = equeue_create(&q, EQUEUE_EVENT_SIZE);
+    int err = equeue_create(&q, test_event_size(EQUEUE_EVENT_SIZE));
     ASSERT_EQ(0, err);
 
     uint8_t touched = 0;
@@ -1112,3 +1128,344 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
 
     equeue_destroy(&q);
 }
+
+struct order {
+    unsigned *log;
+    unsigned *count;
+    unsigned value;
+};
+
+static void order_func(void *p)
+{
+    struct order *o = reinterpret_cast<struct order *>(p);
+    o->log[(*o->count)++] = o->value;
+}
+
+/** Test that equeue dispatches many timed events in order of target, then of posting.
+ *
+ *  Given queue is initialized.
+ *  When events are posted with scattered delays, some of them sharing a delay, and some are canceled.
+ *  Then the remaining events are all executed, by increasing delay and in posting order for equal delays.
+ */
+TEST_F(TestEqueue, test_equeue_ordering)
+{
+    const unsigned N = 100;
+    equeue_t q;
+    int err = equeue_create(&q, N * test_event_size(EQUEUE_EVENT_SIZE + sizeof(struct order)));
+    ASSERT_EQ(0, err);
+
+    unsigned log[N];
+    unsigned count = 0;
+    int ids[N];
+    for (unsigned i = 0; i < N; i++) {
+        struct order *o = reinterpret_cast<struct order *>(equeue_alloc(&q, sizeof(struct order)));
+        ASSERT_TRUE(o != NULL);
+        o->log = log;
+        o->count = &count;
+        // delays 1 to 20 in scattered order, each shared by several events
+        o->value = ((i * 7) % 20 + 1) * N + i;
+        equeue_event_delay(o, (i * 7) % 20 + 1);
+        ids[i] = equeue_post(&q, order_func, o);
+        ASSERT_NE(0, ids[i]);
+    }
+
+    for (unsigned i = 0; i < N; i += 3) {
+        EXPECT_TRUE(equeue_cancel(&q, ids[i]));
+    }
+
+    equeue_dispatch(&q, 30);
+
+    EXPECT_EQ(N - (N + 2) / 3, count);
+    for (unsigned i = 1; i < count; i++) {
+        EXPECT_LT(log[i - 1], log[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+/** Test that equeue executes user allocated events posted lock-free.
+ *
+ *  Given queue is initialized.
+ *  When user allocated events are posted lock-free, one of them twice and another canceled before dispatch.
+ *  Then the events are executed once in posting order, the canceled one is not executed and can be posted again.
+ */
+TEST_F(TestEqueue, test_equeue_user_allocated_event_post_lockfree)
+{
+    struct user_allocated_event {
+        struct equeue_event e;
+        struct order o;
+    };
+    equeue_t q;
+    int err = equeue_create(&q, EQUEUE_EVENT_SIZE);
+    ASSERT_EQ(0, err);
+
+    unsigned log[8];
+    unsigned count = 0;
+    user_allocated_event e1 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, { log, &count, 1 } };
+    user_allocated_event e2 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, { log, &count, 2 } };
+    user_allocated_event e3 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, { log, &count, 3 } };
+    user_allocated_event e4 = { { 0, 0, 0, NULL, NULL, NULL, 5, -1, NULL, NULL }, { log, &count, 4 } };
+
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e1.e));
+    EXPECT_FALSE(equeue_post_user_allocated_lockfree(&q, order_func, &e1.e));
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e2.e));
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e3.e));
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e4.e));
+    EXPECT_TRUE(equeue_cancel_user_allocated(&q, &e2.e));
+    EXPECT_LT(0, equeue_timeleft_user_allocated(&q, &e4.e));
+
+    equeue_dispatch(&q, 10);
+
+    ASSERT_EQ(3u, count);
+    EXPECT_EQ(1u, log[0]);
+    EXPECT_EQ(3u, log[1]);
+    EXPECT_EQ(4u, log[2]);
+
+    e1.e.target = 0; // reset targets as they're modified by the post
+    e2.e.target = 0;
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e2.e));
+    EXPECT_TRUE(equeue_post_user_allocated_lockfree(&q, order_func, &e1.e));
+    equeue_dispatch(&q, 0);
+
+    ASSERT_EQ(5u, count);
+    EXPECT_EQ(2u, log[3]);
+    EXPECT_EQ(1u, log[4]);
+
+    equeue_destroy(&q);
+}
+
+struct slack {
+    unsigned *tick;
+};
+
+static void slack_func(void *p)
+{
+    struct slack *slack = reinterpret_cast<struct slack *>(p);
+    *slack->tick = equeue_tick();
+}
+
+/** Test that events given a slack are dispatched together with the events due within it.
+ *
+ *  Given queue is initialized.
+ *  When events with overlapping deadlines and slack are posted.
+ *  Then they are dispatched on a single wake up, neither before they are due nor after their slack.
+ */
+TEST_F(TestEqueue, test_equeue_slack)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    const unsigned delay[] = {10, 25, 30, 100, 120};
+    const unsigned slack[] = {30, 0, 20, 50, 0};
+    unsigned tick[5] = {0};
+    unsigned start = equeue_tick();
+    for (unsigned i = 0; i < 5; i++) {
+        struct slack *e = reinterpret_cast<struct slack *>(equeue_alloc(&q, sizeof(struct slack)));
+        ASSERT_TRUE(e != NULL);
+        e->tick = &tick[i];
+        equeue_event_delay(e, delay[i]);
+        equeue_event_slack(e, slack[i]);
+        equeue_post(&q, slack_func, e);
+    }
+
+    equeue_dispatch(&q, 200);
+
+    EXPECT_EQ(25u, tick[0] - start);
+    EXPECT_EQ(25u, tick[1] - start);
+    EXPECT_EQ(50u, tick[2] - start);
+    EXPECT_EQ(120u, tick[3] - start);
+    EXPECT_EQ(120u, tick[4] - start);
+
+    // a periodic event keeps its period from the due times
+    uint8_t *touched = reinterpret_cast<uint8_t *>(equeue_alloc(&q, sizeof(uint8_t)));
+    ASSERT_TRUE(touched != NULL);
+    *touched = 0;
+    equeue_event_delay(touched, 10);
+    equeue_event_period(touched, 10);
+    equeue_event_slack(touched, 5);
+    equeue_post(&q, simple_func, touched);
+    equeue_dispatch(&q, 48);
+    EXPECT_EQ(4, *touched);
+
+    equeue_destroy(&q);
+}
+
+/** Test that equeue_background is updated by events due within the slack of the next one.
+ *
+ *  Given queue is initialized and backgrounded, with an event given a slack.
+ *  When an event without slack is posted due before the slack runs out.
+ *  Then the background timer is moved earlier to the new event.
+ */
+TEST_F(TestEqueue, test_equeue_background_slack)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    int ms;
+    equeue_background(&q, background_func, &ms);
+
+    void *e = equeue_alloc(&q, 1);
+    ASSERT_TRUE(e != NULL);
+    equeue_event_delay(e, 100);
+    equeue_event_slack(e, 50);
+    equeue_post(&q, pass_func, e);
+    EXPECT_EQ(150, ms);
+
+    e = equeue_alloc(&q, 1);
+    ASSERT_TRUE(e != NULL);
+    equeue_event_delay(e, 120);
+    equeue_post(&q, pass_func, e);
+    EXPECT_EQ(120, ms);
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_STATS
+/** Test that equeue records the statistics of its events.
+ *
+ *  Given queue is initialized.
+ *  When events are posted until the buffer is exhausted and some of them are dispatched.
+ *  Then the depth, buffer use, latency and run time of the events are reported, and the maximums can be reset.
+ */
+TEST_F(TestEqueue, test_equeue_stats)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 3 * test_event_size(EQUEUE_EVENT_SIZE));
+    ASSERT_EQ(0, err);
+
+    equeue_stats_t stats;
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(0u, stats.current_depth);
+    EXPECT_EQ(0u, stats.current_size);
+    EXPECT_EQ(3 * test_event_size(EQUEUE_EVENT_SIZE), stats.reserved_size);
+
+    uint8_t touched = 0;
+    EXPECT_NE(0, equeue_call(&q, sloth_func, &touched));
+    EXPECT_NE(0, equeue_call(&q, sloth_func, &touched));
+    int id = equeue_call_in(&q, 100, pass_func, 0);
+    EXPECT_NE(0, id);
+    EXPECT_EQ(0, equeue_call(&q, pass_func, 0));
+
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(3u, stats.current_depth);
+    EXPECT_EQ(3 * test_event_size(EQUEUE_EVENT_SIZE), stats.current_size);
+    EXPECT_EQ(1u, stats.alloc_fail_cnt);
+
+    equeue_dispatch(&q, 0);
+    EXPECT_EQ(2, touched);
+
+    // the second event waits for the first one to run
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(2u, stats.dispatch_cnt);
+    EXPECT_EQ(10u, stats.max_latency);
+    EXPECT_EQ(10u, stats.total_latency);
+    EXPECT_EQ(10u, stats.max_run_time);
+    EXPECT_EQ(20u, stats.total_run_time);
+    EXPECT_EQ(1u, stats.current_depth);
+    EXPECT_EQ(3u, stats.max_depth);
+    EXPECT_EQ(test_event_size(EQUEUE_EVENT_SIZE), stats.current_size);
+    EXPECT_EQ(3 * test_event_size(EQUEUE_EVENT_SIZE), stats.max_size);
+
+    equeue_stats_reset(&q);
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(0u, stats.dispatch_cnt);
+    EXPECT_EQ(0u, stats.max_latency);
+    EXPECT_EQ(0u, stats.total_run_time);
+    EXPECT_EQ(0u, stats.alloc_fail_cnt);
+    EXPECT_EQ(1u, stats.max_depth);
+    EXPECT_EQ(test_event_size(EQUEUE_EVENT_SIZE), stats.max_size);
+
+    EXPECT_TRUE(equeue_cancel(&q, id));
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(0u, stats.current_depth);
+    EXPECT_EQ(0u, stats.current_size);
+
+    equeue_destroy(&q);
+}
+#endif
+
+/** Test that equeue describes its free memory.
+ *
+ *  Given queue is initialized.
+ *  When events are allocated and some of them deallocated.
+ *  Then the free memory reported adds up to the buffer size, with the fragmentation left by the deallocated events.
+ */
+TEST_F(TestEqueue, test_equeue_mem_info)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    equeue_mem_info_t info;
+    equeue_mem_info(&q, &info);
+    EXPECT_EQ(TEST_EQUEUE_SIZE, info.slab_size);
+    EXPECT_EQ(0u, info.free_size);
+    EXPECT_EQ(0u, info.free_cnt);
+    EXPECT_EQ(TEST_EQUEUE_SIZE, info.allocatable_size);
+    EXPECT_EQ(0u, info.fragmentation);
+
+    void *p1 = equeue_alloc(&q, 16);
+    void *p2 = equeue_alloc(&q, 16);
+    void *p3 = equeue_alloc(&q, 16);
+    ASSERT_TRUE(p1 != NULL && p2 != NULL && p3 != NULL);
+    equeue_dealloc(&q, p1);
+    equeue_dealloc(&q, p3);
+
+    equeue_mem_info(&q, &info);
+    EXPECT_EQ(2u, info.free_cnt);
+    EXPECT_EQ(TEST_EQUEUE_SIZE, info.slab_size + info.free_size + info.free_size / 2);
+    EXPECT_EQ(info.slab_size, info.allocatable_size);
+    EXPECT_EQ(100 - 100 * info.slab_size / (info.slab_size + info.free_size), info.fragmentation);
+
+    equeue_dealloc(&q, p2);
+    equeue_mem_info(&q, &info);
+    EXPECT_EQ(3u, info.free_cnt);
+    EXPECT_EQ(TEST_EQUEUE_SIZE, info.slab_size + info.free_size);
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_ALLOCATOR_BUCKETS
+/** Test that the size-class allocator reuses events of mixed sizes.
+ *
+ *  Given queue is initialized with a buffer fitting a few events of one size class.
+ *  When events of varying sizes within the class are repeatedly allocated and deallocated in varying orders.
+ *  Then no allocation fails and the buffer ends up split in events of the class size.
+ */
+TEST_F(TestEqueue, test_equeue_bucket_churn)
+{
+    const unsigned N = 8;
+    size_t bucket = 1;
+    while (bucket < EQUEUE_EVENT_SIZE + 32) {
+        bucket <<= 1;
+    }
+    size_t min = bucket / 2 - sizeof(struct equeue_event) + sizeof(void *);
+    size_t max = bucket - sizeof(struct equeue_event);
+
+    equeue_t q;
+    int err = equeue_create(&q, N * bucket);
+    ASSERT_EQ(0, err);
+
+    void *p[N];
+    for (unsigned round = 0; round < 100; round++) {
+        for (unsigned i = 0; i < N; i++) {
+            p[i] = equeue_alloc(&q, min + (round * 7 + i * 13) % (max - min + 1));
+            ASSERT_TRUE(p[i] != NULL);
+        }
+        for (unsigned i = 0; i < N; i++) {
+            equeue_dealloc(&q, p[(i * 3 + round) % N]);
+        }
+    }
+
+    equeue_mem_info_t info;
+    equeue_mem_info(&q, &info);
+    EXPECT_EQ(0u, info.slab_size);
+    EXPECT_EQ(N, info.free_cnt);
+    EXPECT_EQ(N * bucket, info.free_size);
+    EXPECT_EQ(bucket, info.allocatable_size);
+
+    equeue_destroy(&q);
+}
+#endif
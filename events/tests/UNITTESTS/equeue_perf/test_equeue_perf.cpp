@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include "events/equeue.h"
+#include <vector>
+
+// Room for an event in the queue, rounded up by the allocator buckets
+#define PERF_EVENT_SIZE 128
+
+extern unsigned int equeue_global_time;
+
+static void count_func(void *p)
+{
+    (*(uint32_t *)p)++;
+}
+
+class TestEqueuePerf : public testing::Test {
+protected:
+    equeue_t q;
+    uint32_t touched;
+
+    virtual void SetUp()
+    {
+        touched = 0;
+        equeue_global_time = 0;
+    }
+
+    void create(size_t events)
+    {
+        ASSERT_EQ(0, equeue_create(&q, events * PERF_EVENT_SIZE));
+    }
+
+    void dispatch_all(size_t events)
+    {
+        // Jump past every deadline so a single dispatch runs all the events
+        equeue_global_time += events + 1;
+        equeue_dispatch(&q, 0);
+    }
+};
+
+TEST_F(TestEqueuePerf, call_dispatch)
+{
+    auto workload = [this](size_t events) {
+        create(events);
+        for (size_t i = 0; i < events; i++) {
+            equeue_call(&q, count_func, &touched);
+        }
+        dispatch_all(events);
+        equeue_destroy(&q);
+    };
+    EXPECT_TRUE(perf::scales_linearly("call_dispatch", 1 << 10, 1 << 14, workload));
+    EXPECT_NE(0, touched);
+}
+
+TEST_F(TestEqueuePerf, call_in_distinct_deadlines)
+{
+    auto workload = [this](size_t events) {
+        create(events);
+        // Every event in its own slot, in an order defeating a sorted insertion
+        for (size_t i = 0; i < events; i++) {
+            int delay = (i * 7919) % events + 1;
+            equeue_call_in(&q, delay, count_func, &touched);
+        }
+        dispatch_all(events);
+        equeue_destroy(&q);
+    };
+    EXPECT_TRUE(perf::scales_linearly("call_in_distinct_deadlines", 1 << 10, 1 << 14, workload));
+    EXPECT_NE(0, touched);
+}
+
+TEST_F(TestEqueuePerf, cancel)
+{
+    std::vector<int> ids;
+    auto workload = [this, &ids](size_t events) {
+        create(events);
+        ids.resize(events);
+        for (size_t i = 0; i < events; i++) {
+            int delay = (i * 7919) % events + 1;
+            ids[i] = equeue_call_in(&q, delay, count_func, &touched);
+        }
+        for (size_t i = 0; i < events; i++) {
+            EXPECT_TRUE(equeue_cancel(&q, ids[i]));
+        }
+        equeue_destroy(&q);
+    };
+    EXPECT_TRUE(perf::scales_linearly("cancel", 1 << 10, 1 << 14, workload));
+    EXPECT_EQ(0, touched);
+}
+
+TEST_F(TestEqueuePerf, alloc_dealloc)
+{
+    std::vector<void *> allocs;
+    auto workload = [this, &allocs](size_t events) {
+        create(events);
+        allocs.resize(events);
+        // Mixed sizes, freed in another order than allocated to fragment the pool
+        for (size_t i = 0; i < events; i++) {
+            allocs[i] = equeue_alloc(&q, 8 + (i % 4) * 16);
+            ASSERT_TRUE(allocs[i]);
+        }
+        for (size_t i = 0; i < events; i += 2) {
+            equeue_dealloc(&q, allocs[i]);
+        }
+        for (size_t i = 0; i < events; i += 2) {
+            allocs[i] = equeue_alloc(&q, 8 + (i % 4) * 16);
+            ASSERT_TRUE(allocs[i]);
+        }
+        for (size_t i = 0; i < events; i++) {
+            equeue_dealloc(&q, allocs[i]);
+        }
+        equeue_destroy(&q);
+    };
+    EXPECT_TRUE(perf::scales_linearly("alloc_dealloc", 1 << 10, 1 << 14, workload));
+}
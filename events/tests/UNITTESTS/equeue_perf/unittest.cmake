@@ -0,0 +1,34 @@
+
+####################
+# UNIT TESTS
+####################
+
+list(REMOVE_ITEM unittest-includes ${PROJECT_SOURCE_DIR}/../events/tests/UNITTESTS/target_h ${PROJECT_SOURCE_DIR}/../events/test/UNITTESTS/target_h/equeue)
+
+set(unittest-includes ${unittest-includes}
+  ../events/source
+  ../events/include/events
+  ../events/include/events/internal
+)
+
+set(unittest-sources
+  ../events/source/equeue.c
+)
+
+set(unittest-test-sources
+  ../events/tests/UNITTESTS/equeue_perf/test_equeue_perf.cpp
+  ../events/tests/UNITTESTS/stubs/EqueuePosix_stub.c
+)
+
+# The scheduler heap and the allocator buckets are the configuration in
+# which every operation scales with the number of pending events
+set(unittest-test-flags
+  -pthread
+  -DEQUEUE_PLATFORM_POSIX
+  -DEQUEUE_SCHEDULER_HEAP=1
+  -DEQUEUE_ALLOCATOR_BUCKETS=1
+)
+
+set(unittest-test-labels
+  perf
+)
@@ -0,0 +1,95 @@
+"""
+Copyright (c) 2021 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+from __future__ import print_function
+
+import json
+import os
+
+from mbed_host_tests import BaseHostTest
+
+MSG_KEY_BENCHMARK = 'benchmark'
+
+MSG_VALUE_OK = 'ok'
+MSG_VALUE_NEW = 'new'
+MSG_VALUE_REGRESSION = 'regression'
+
+FIELDS = ('iterations', 'min_cycles', 'median_cycles', 'p99_cycles',
+          'max_cycles', 'wall_time_us', 'bytes_per_second')
+
+DEFAULT_TOLERANCE = 10.0
+
+
+class BenchmarkTest(BaseHostTest):
+    """Collect the timings of utest::v1::benchmark_report().
+
+    The environment configures the comparisons:
+      MBED_BENCHMARK_BASELINE   JSON file of the baseline timings, per name
+      MBED_BENCHMARK_RESULTS    JSON file the timings are merged into, in the
+                                same format, to make the next baseline
+      MBED_BENCHMARK_TOLERANCE  Percentage the median may exceed the baseline
+                                by before it is a regression, 10 by default
+
+    Each benchmark is answered with 'ok', 'new' (no baseline) or 'regression',
+    which benchmark_report() turns into its return value.
+    """
+
+    def setup(self):
+        self.results = {}
+        self.baseline = {}
+        self.tolerance = float(os.environ.get('MBED_BENCHMARK_TOLERANCE', DEFAULT_TOLERANCE))
+        path = os.environ.get('MBED_BENCHMARK_BASELINE')
+        if path:
+            try:
+                with open(path) as baseline:
+                    self.baseline = json.load(baseline)
+            except (IOError, ValueError) as exc:
+                self.log('Cannot read baseline {}: {}'.format(path, exc))
+        self.register_callback(MSG_KEY_BENCHMARK, self.cb_benchmark)
+
+    def cb_benchmark(self, key, value, timestamp):
+        name, _, values = value.partition(',')
+        try:
+            result = dict(zip(FIELDS, (int(v) for v in values.split(','))))
+        except ValueError:
+            self.log('Malformed benchmark {}'.format(value))
+            self.send_kv(MSG_KEY_BENCHMARK, MSG_VALUE_NEW)
+            return
+        self.results[name] = result
+
+        verdict = MSG_VALUE_NEW
+        base = self.baseline.get(name, {}).get('median_cycles')
+        if base:
+            change = 100.0 * (result['median_cycles'] - base) / base
+            verdict = MSG_VALUE_REGRESSION if change > self.tolerance else MSG_VALUE_OK
+            self.log('{}: median {} cycles, {:+.1f}% from baseline {} [{}]'.format(
+                name, result['median_cycles'], change, base, verdict))
+        self.send_kv(MSG_KEY_BENCHMARK, verdict)
+
+    def teardown(self):
+        path = os.environ.get('MBED_BENCHMARK_RESULTS')
+        if not path or not self.results:
+            return
+        results = {}
+        if os.path.exists(path):
+            try:
+                with open(path) as previous:
+                    results = json.load(previous)
+            except (IOError, ValueError):
+                pass
+        results.update(self.results)
+        with open(path, 'w') as output:
+            json.dump(results, output, indent=4, sort_keys=True)
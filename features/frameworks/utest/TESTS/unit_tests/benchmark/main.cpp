@@ -0,0 +1,88 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "utest/utest_benchmark.h"
+#include "unity/unity.h"
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 1024
+
+static uint8_t source_buffer[BUFFER_SIZE];
+static uint8_t destination_buffer[BUFFER_SIZE];
+
+static void copy_buffer()
+{
+    memcpy(destination_buffer, source_buffer, BUFFER_SIZE);
+}
+
+void test_statistics()
+{
+    const benchmark_t benchmark = { "memcpy_1k", 100, 10, BUFFER_SIZE };
+    benchmark_result_t result = benchmark_run(benchmark, copy_buffer);
+
+    TEST_ASSERT_EQUAL(100, result.iterations);
+    TEST_ASSERT_TRUE(result.min_cycles > 0);
+    TEST_ASSERT_TRUE(result.min_cycles <= result.median_cycles);
+    TEST_ASSERT_TRUE(result.median_cycles <= result.p99_cycles);
+    TEST_ASSERT_TRUE(result.p99_cycles <= result.max_cycles);
+    TEST_ASSERT_TRUE(result.bytes_per_second > 0);
+    TEST_ASSERT_TRUE(benchmark_report(benchmark, result));
+}
+
+void test_crc()
+{
+    static MbedCRC<POLY_32BIT_ANSI, 32> crc;
+
+    const benchmark_t benchmark = { "crc32_1k", 50, 2, BUFFER_SIZE };
+    benchmark_result_t result = benchmark_run(benchmark, []() {
+        uint32_t checksum;
+        crc.compute(source_buffer, BUFFER_SIZE, &checksum);
+    });
+
+    TEST_ASSERT_EQUAL(50, result.iterations);
+    TEST_ASSERT_TRUE(benchmark_report(benchmark, result));
+}
+
+void test_no_iterations()
+{
+    const benchmark_t benchmark = { "empty", 0, 0, 0 };
+    benchmark_result_t result = benchmark_run(benchmark, copy_buffer);
+
+    TEST_ASSERT_EQUAL(0, result.iterations);
+    TEST_ASSERT_EQUAL(0, result.max_cycles);
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "benchmark_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark statistics", test_statistics),
+    Case("Benchmark of a lambda", test_crc),
+    Case("Benchmark without runs", test_no_iterations)
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#include "utest/utest_benchmark.h"
+#include "utest/utest_print.h"
+#include "greentea-client/test_env.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
+#include <algorithm>
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+using namespace utest::v1;
+
+static void benchmark_counter_init()
+{
+#ifdef DWT
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
+
+static inline uint32_t benchmark_cycles()
+{
+#ifdef DWT
+    return DWT->CYCCNT;
+#else
+    // Microsecond resolution only, wrapping with the ticker
+    return (uint32_t)(ticker_read_us(get_us_ticker_data()) * (SystemCoreClock / 1000000));
+#endif
+}
+
+benchmark_result_t utest::v1::benchmark_run(const benchmark_t &benchmark, mbed::Callback<void()> body)
+{
+    benchmark_result_t result;
+    memset(&result, 0, sizeof(result));
+
+    if (benchmark.iterations == 0) {
+        return result;
+    }
+    uint32_t *runs = new (std::nothrow) uint32_t[benchmark.iterations];
+    if (!runs) {
+        utest_printf(">>> Benchmark '%s': out of memory for %lu runs\n", benchmark.name, (unsigned long)benchmark.iterations);
+        return result;
+    }
+
+    benchmark_counter_init();
+
+    // Cost of the two reads around an empty body
+    uint32_t overhead = 0xFFFFFFFF;
+    for (int i = 0; i < 8; i++) {
+        uint32_t start = benchmark_cycles();
+        uint32_t elapsed = benchmark_cycles() - start;
+        overhead = std::min(overhead, elapsed);
+    }
+
+    for (uint32_t i = 0; i < benchmark.warmup; i++) {
+        body();
+    }
+
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    us_timestamp_t wall_start = ticker_read_us(ticker);
+    for (uint32_t i = 0; i < benchmark.iterations; i++) {
+        uint32_t start = benchmark_cycles();
+        body();
+        uint32_t elapsed = benchmark_cycles() - start;
+        runs[i] = elapsed > overhead ? elapsed - overhead : 0;
+    }
+    result.wall_time_us = ticker_read_us(ticker) - wall_start;
+
+    std::sort(runs, runs + benchmark.iterations);
+    result.iterations = benchmark.iterations;
+    result.min_cycles = runs[0];
+    result.median_cycles = runs[benchmark.iterations / 2];
+    // Smallest run not shorter than 99% of the runs
+    result.p99_cycles = runs[(benchmark.iterations * 99 + 99) / 100 - 1];
+    result.max_cycles = runs[benchmark.iterations - 1];
+    if (benchmark.bytes && result.median_cycles) {
+        result.bytes_per_second = (uint32_t)(((uint64_t)benchmark.bytes * SystemCoreClock) / result.median_cycles);
+    }
+
+    delete[] runs;
+    return result;
+}
+
+bool utest::v1::benchmark_report(const benchmark_t &benchmark, const benchmark_result_t &result)
+{
+    utest_printf(">>> Benchmark '%s': %lu runs, cycles min %lu median %lu p99 %lu max %lu, %llu us",
+                 benchmark.name, (unsigned long)result.iterations,
+                 (unsigned long)result.min_cycles, (unsigned long)result.median_cycles,
+                 (unsigned long)result.p99_cycles, (unsigned long)result.max_cycles,
+                 (unsigned long long)result.wall_time_us);
+    if (result.bytes_per_second) {
+        utest_printf(", %lu bytes/s", (unsigned long)result.bytes_per_second);
+    }
+    utest_printf("\n");
+
+    char value[128];
+    snprintf(value, sizeof(value), "%s,%lu,%lu,%lu,%lu,%lu,%llu,%lu", benchmark.name,
+             (unsigned long)result.iterations,
+             (unsigned long)result.min_cycles, (unsigned long)result.median_cycles,
+             (unsigned long)result.p99_cycles, (unsigned long)result.max_cycles,
+             (unsigned long long)result.wall_time_us, (unsigned long)result.bytes_per_second);
+    greentea_send_kv("benchmark", value);
+
+    char key[20];
+    char verdict[20];
+    if (!greentea_parse_kv(key, verdict, sizeof(key), sizeof(verdict)) ||
+            strcmp(key, "benchmark") != 0) {
+        // No verdict: the host has no baseline to compare with
+        return true;
+    }
+    return strcmp(verdict, "regression") != 0;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#ifndef UTEST_BENCHMARK_H
+#define UTEST_BENCHMARK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/Callback.h"
+
+
+namespace utest {
+/** \addtogroup frameworks */
+/** @{*/
+namespace v1 {
+    /**
+     * Parameters of a benchmark.
+     */
+    struct benchmark_t
+    {
+        /**
+         * Name of the benchmark, reported to the host. It must not contain commas.
+         */
+        const char *name;
+
+        /**
+         * Number of timed runs of the benchmark body.
+         */
+        uint32_t iterations;
+
+        /**
+         * Number of runs before the timed ones, to warm up the caches and
+         * the lazily initialized state.
+         */
+        uint32_t warmup;
+
+        /**
+         * Bytes processed by one run, to report a throughput, or 0.
+         */
+        size_t bytes;
+    };
+
+    /**
+     * Timings of a benchmark. The cycles are counted with the DWT cycle counter
+     * on the cores having one, and derived from the microsecond ticker otherwise.
+     */
+    struct benchmark_result_t
+    {
+        uint32_t iterations;        ///< Timed runs
+        uint32_t min_cycles;        ///< Shortest run
+        uint32_t median_cycles;     ///< Median run
+        uint32_t p99_cycles;        ///< 99th percentile run
+        uint32_t max_cycles;        ///< Longest run
+        uint64_t wall_time_us;      ///< Wall time of all the timed runs
+        uint32_t bytes_per_second;  ///< Throughput at the median run, 0 without benchmark_t::bytes
+    };
+
+    /** Run a benchmark.
+     *
+     * The body is called benchmark_t::warmup times, then benchmark_t::iterations times
+     * with each call timed. The cost of reading the counters is taken off the timings.
+     *
+     * @param benchmark The parameters of the benchmark
+     * @param body      The code timed, called once per run
+     * @returns the timings of the runs, all 0 if the runs could not be recorded
+     */
+    benchmark_result_t benchmark_run(const benchmark_t &benchmark, mbed::Callback<void()> body);
+
+    /** Report the timings of a benchmark to the host.
+     *
+     * The timings are printed, and sent as a `benchmark` key-value pair to the
+     * `benchmark_auto` host test, which records them and compares the median
+     * with a baseline. The test must be set up with `GREENTEA_SETUP(timeout, "benchmark_auto")`.
+     *
+     * @param benchmark The parameters of the benchmark
+     * @param result    The timings returned by benchmark_run()
+     * @returns false if the host found the median slower than its baseline, true otherwise
+     */
+    bool benchmark_report(const benchmark_t &benchmark, const benchmark_result_t &result);
+
+}   // namespace v1
+}   // namespace utest
+
+#endif // UTEST_BENCHMARK_H
+
+/** @}*/
@@ -109,6 +109,99 @@ const PinMap *analogin_pinmap(void);
 
 /**@}*/
 
+#if DEVICE_ANALOGIN_STREAM
+
+/** Analogin stream hal structure. analogin_stream_s is declared in the target's hal
+ */
+typedef struct analogin_stream_s analogin_stream_t;
+
+/** Handler called when half of the stream buffer has been filled
+ *
+ * @param id      The id given to ::analogin_stream_start
+ * @param samples The filled half of the buffer
+ * @param count   The number of samples in that half
+ */
+typedef void (*analogin_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/**
+ * \defgroup hal_analogin_stream Analogin stream hal functions
+ *
+ * A stream converts a sequence of channels of one ADC at a fixed rate, the
+ * conversions being triggered by a timer and the results written by DMA into
+ * a buffer split in two halves. While the DMA fills one half, the other half
+ * is handed to the application.
+ *
+ * # Defined behaviour
+ * * The function ::analogin_stream_init fails if the pins are not all on the same ADC,
+ *   or if that ADC is already used by another stream
+ * * The samples are interleaved in the order of the pins given to ::analogin_stream_init
+ * * The samples are right aligned, ::analogin_stream_sample_bits gives their width
+ * * The handler is called from interrupt context each time a half of the buffer is filled
+ * * The DMA keeps writing the other half meanwhile: a half not processed within
+ *   the time needed to fill one half is overwritten
+ *
+ * # Undefined behaviour
+ * * Using analogin objects on the same ADC while a stream is active
+ * @{
+ */
+
+/** Initialize a stream on a set of analog pins
+ *
+ * @param obj   The analogin stream object to initialize
+ * @param pins  The pins to sample, all on the same ADC
+ * @param count The number of pins
+ * @return 0 on success, -1 if the pins cannot be sampled together
+ */
+int analogin_stream_init(analogin_stream_t *obj, const PinName *pins, size_t count);
+
+/** Stop the stream and release its ADC
+ *
+ * @param obj The analogin stream object
+ */
+void analogin_stream_free(analogin_stream_t *obj);
+
+/** Configure the hardware oversampling applied to each sample
+ *
+ * Each sample is the sum of 2^ratio_log2 conversions shifted right by shift.
+ * Must be called while the stream is stopped.
+ *
+ * @param obj        The analogin stream object
+ * @param ratio_log2 log2 of the number of conversions per sample, 0 to disable oversampling
+ * @param shift      The right shift applied to the sum
+ * @return 0 on success, -1 if the configuration is not supported
+ */
+int analogin_stream_set_oversampling(analogin_stream_t *obj, uint8_t ratio_log2, uint8_t shift);
+
+/** Get the number of significant bits of the samples
+ *
+ * @param obj The analogin stream object
+ * @return The sample width with the current oversampling configuration
+ */
+uint8_t analogin_stream_sample_bits(analogin_stream_t *obj);
+
+/** Start sampling into a double buffer
+ *
+ * @param obj     The analogin stream object
+ * @param rate    The number of sequences converted per second
+ * @param buffer  The buffer written by the DMA
+ * @param length  The number of samples in buffer, a multiple of twice the number of pins
+ * @param handler The handler called when a half of the buffer is filled
+ * @param id      The argument passed to handler
+ * @return 0 on success, -1 if the rate or buffer are not supported or no DMA channel is available
+ */
+int analogin_stream_start(analogin_stream_t *obj, uint32_t rate, uint16_t *buffer, size_t length,
+                          analogin_stream_handler handler, uint32_t id);
+
+/** Stop sampling
+ *
+ * @param obj The analogin stream object
+ */
+void analogin_stream_stop(analogin_stream_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
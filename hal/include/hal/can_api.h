@@ -87,6 +87,32 @@ unsigned char can_rderror(can_t *obj);
 unsigned char can_tderror(can_t *obj);
 void          can_monitor(can_t *obj, int silent);
 
+/** Get the number of filter handles
+ *
+ * @param obj The CAN object
+ * @return    The handles from 0 to the count minus 1 are valid for can_filter() and can_filter_list()
+ */
+int           can_filter_count(can_t *obj);
+
+/** Accept only the identifiers of a list, in one or more filter handles
+ *
+ * @param obj    The CAN object
+ * @param ids    The identifiers to accept
+ * @param count  The number of identifiers
+ * @param format The format of the identifiers, CANStandard or CANExtended
+ * @param handle The first filter handle used
+ * @return       The number of filter handles used, 0 if unsupported or if there aren't enough handles
+ */
+int           can_filter_list(can_t *obj, const uint32_t *ids, int count, CANFormat format, int32_t handle);
+
+/** Stop a filter set by can_filter() or can_filter_list()
+ *
+ * @param obj    The CAN object
+ * @param handle The filter handle
+ * @return       1 if successful, 0 if unsupported
+ */
+int           can_filter_disable(can_t *obj, int32_t handle);
+
 /** Get the pins that support CAN RD
  *
  * Return a PinMap array of pins that support CAN RD. The
@@ -0,0 +1,88 @@
+/** \addtogroup hal */
+/** @{*/
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CLOCK_SCALING_API_H
+#define MBED_CLOCK_SCALING_API_H
+
+#if DEVICE_CLOCK_SCALING
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_clock_scaling Clock scaling HAL functions
+ * Low-level interface to change the core clock, and the voltage range it
+ * needs, at runtime.
+ *
+ * # Defined behavior
+ * * The first frequency of ::clock_scaling_get_frequencies is the one
+ * configured at boot, the others are in decreasing order.
+ * * ::clock_scaling_set switches to one of these frequencies, and updates
+ * SystemCoreClock and the bus clocks accordingly.
+ * * The us ticker keeps counting microseconds across the change.
+ * * The clock set is kept across hal_deepsleep().
+ *
+ * # Undefined behavior
+ * * Calling ::clock_scaling_set with interrupts enabled.
+ * * Peripheral transfers in progress during ::clock_scaling_set.
+ *
+ * # Notes
+ * * Peripherals whose prescalers derive from the bus clocks, such as serial,
+ * SPI, I2C and PWM, must be configured again after the change: this is done
+ * by the drivers, notified by mbed_clock_set_frequency().
+ *
+ * @{
+ */
+
+/** Get the core clock frequencies supported
+ *
+ * @param frequencies Filled with up to size frequencies in Hz
+ * @param size        Size of frequencies
+ * @return            Number of frequencies supported
+ */
+uint8_t clock_scaling_get_frequencies(uint32_t *frequencies, uint8_t size);
+
+/** Switch the core clock
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param frequency_hz One of the frequencies of ::clock_scaling_get_frequencies
+ * @return             0 on success, -1 if the frequency isn't supported
+ */
+int clock_scaling_set(uint32_t frequency_hz);
+
+/** Get the core clock frequency
+ *
+ * @return The core clock frequency in Hz
+ */
+uint32_t clock_scaling_get(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
@@ -22,6 +22,7 @@
 
 #include "device.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 #if DEVICE_FLASH
 
@@ -127,6 +128,67 @@ uint8_t flash_get_erase_value(const flash_t *obj);
 
 /**@}*/
 
+#if DEVICE_FLASH_ASYNCH
+
+/** Handler called when an asynchronous flash operation completes
+ *
+ * @param id     The id given when starting the operation
+ * @param status 0 for success, -1 for error
+ */
+typedef void (*flash_async_handler)(uint32_t id, int32_t status);
+
+/**
+ * \defgroup hal_flash_async Asynchronous flash HAL functions
+ *
+ * The operation runs in the background, its completion being signaled by an
+ * interrupt. The CPU only stalls when it reads from the flash bank being
+ * modified: on dual-bank parts, code running from one bank can keep executing
+ * while the other bank is erased or programmed.
+ *
+ * # Defined behaviour
+ * * Only one operation can be pending at a time
+ * * ::flash_erase_sector and ::flash_program_page fail while an operation is pending
+ * * The handler is called from interrupt context, once per started operation
+ * @{
+ */
+
+/** Start erasing one sector
+ *
+ * @param obj     The flash object
+ * @param address The sector starting address
+ * @param handler The handler called on completion
+ * @param id      The argument passed to handler
+ * @return 0 if the operation started, -1 for error
+ */
+int32_t flash_erase_sector_async(flash_t *obj, uint32_t address, flash_async_handler handler, uint32_t id);
+
+/** Start programming pages
+ *
+ * The pages should not cross multiple sectors. The data buffer must stay
+ * valid until the handler is called.
+ *
+ * @param obj     The flash object
+ * @param address The page starting address
+ * @param data    The data buffer to be programmed
+ * @param size    The number of bytes to program
+ * @param handler The handler called on completion
+ * @param id      The argument passed to handler
+ * @return 0 if the operation started, -1 for error
+ */
+int32_t flash_program_page_async(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size,
+                                 flash_async_handler handler, uint32_t id);
+
+/** Check whether an asynchronous operation is pending
+ *
+ * @param obj The flash object
+ * @return true if an operation is pending
+ */
+bool flash_async_busy(const flash_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
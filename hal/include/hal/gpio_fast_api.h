@@ -0,0 +1,87 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_GPIO_FAST_API_H
+#define MBED_GPIO_FAST_API_H
+
+#include <stdint.h>
+#include "device.h"
+#include "hal/gpio_api.h"
+
+/**
+ * \defgroup hal_gpio_fast Fast GPIO HAL functions
+ *
+ * Access to pins and ports named by constants, without a gpio_t or port_t.
+ * Targets defining GPIO_FAST_READY provide these functions as static
+ * inline in their gpio_object.h: called with a constant pin or port, as
+ * FastDigitalOut and the other fast GPIO drivers do, each one compiles to
+ * a single register access.
+ *
+ * # Defined behavior
+ * * The pin or port has been initialized with the regular GPIO or port HAL
+ * * ::gpio_fast_write sets or clears the output without affecting the
+ *   other pins of the port, it is interrupt safe
+ * * ::port_fast_write sets and clears the masked pins in a single write
+ *
+ * # Undefined behavior
+ * * Calling the functions with NC or a pin that is not a GPIO
+ * * Calling the functions on a target that doesn't define GPIO_FAST_READY
+ *
+ * @{
+ */
+
+#if defined(DOXYGEN_ONLY)
+
+/** Set the output of a pin
+ *
+ * @param pin   Pin, a constant
+ * @param value 0 to clear, any other value to set
+ */
+static inline void gpio_fast_write(PinName pin, int value);
+
+/** Read the input of a pin
+ *
+ * @param pin   Pin, a constant
+ * @return      1 if the pin is high, 0 otherwise
+ */
+static inline int gpio_fast_read(PinName pin);
+
+/** Set and clear pins of a port
+ *
+ * @param port  Port, a constant
+ * @param mask  Pins to update, a constant
+ * @param value Value of the pins, bits outside mask are ignored
+ */
+static inline void port_fast_write(PortName port, uint32_t mask, uint32_t value);
+
+/** Read pins of a port
+ *
+ * @param port  Port, a constant
+ * @param mask  Pins to read, a constant
+ * @return      Input of the pins, bits outside mask cleared
+ */
+static inline uint32_t port_fast_read(PortName port, uint32_t mask);
+
+#endif
+
+/**@}*/
+
+#endif
+
+/** @}*/
@@ -320,6 +320,52 @@ void i2c_slave_address(i2c_t *obj, int idx, uint32_t address, uint32_t mask);
 
 /**@}*/
 
+#if DEVICE_I2CSLAVE_REGMAP
+/**
+ * \defgroup RegmapI2C I2C slave register map Hardware Abstraction Layer
+ *
+ * Emulation of a register mapped device, served from interrupts and DMA:
+ * the first byte the master writes sets the register pointer, the following
+ * bytes are stored from there. Reads return the registers from the pointer,
+ * including reads after a repeated start. The pointer advances with each
+ * byte transferred and stays where the last transfer left it.
+ *
+ * @{
+ */
+
+/** Handler called when the master wrote registers
+ *
+ * @param id     The id given to i2c_slave_regmap_start()
+ * @param offset Offset of the first register written
+ * @param length Number of registers written
+ */
+typedef void (*i2c_slave_regmap_handler)(uint32_t id, uint32_t offset, uint32_t length);
+
+/** Serve a register map to the master
+ *
+ * The slave address must have been set. The polled slave functions must not
+ * be used until i2c_slave_regmap_stop(). Past the end of the map, writes are
+ * dropped and reads return 0xFF. The handler is called from interrupt
+ * context, at the stop or repeated start ending a write of registers.
+ *
+ * @param obj     The I2C object
+ * @param map     The registers, at most 256 bytes
+ * @param size    The size of the map in bytes
+ * @param handler Handler called after writes, NULL for none
+ * @param id      Argument of the handler
+ * @return 0 on success, -1 if the I2C is not a slave or the map is invalid
+ */
+int i2c_slave_regmap_start(i2c_t *obj, void *map, size_t size, i2c_slave_regmap_handler handler, uint32_t id);
+
+/** Stop serving the register map, back to the polled slave functions
+ *
+ * @param obj The I2C object
+ */
+void i2c_slave_regmap_stop(i2c_t *obj);
+
+/**@}*/
+#endif
+
 #if DEVICE_I2C_ASYNCH
 
 /**
@@ -0,0 +1,171 @@
+/** \addtogroup hal */
+/** @{*/
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INPUT_CAPTURE_API_H
+#define MBED_INPUT_CAPTURE_API_H
+
+#include "device.h"
+#include "pinmap.h"
+
+#if DEVICE_INPUT_CAPTURE
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Input capture hal structure. input_capture_s is declared in the target's hal
+ */
+typedef struct input_capture_s input_capture_t;
+
+/** Edges captured */
+typedef enum {
+    INPUT_CAPTURE_RISING,
+    INPUT_CAPTURE_FALLING,
+    INPUT_CAPTURE_BOTH
+} input_capture_edge_t;
+
+/** Handler called when half of the capture buffer has been filled
+ *
+ * @param id       The id given to ::input_capture_start
+ * @param captures The filled half of the buffer
+ * @param count    The number of captures in that half
+ */
+typedef void (*input_capture_handler)(uint32_t id, uint32_t *captures, size_t count);
+
+/**
+ * \defgroup hal_input_capture Input capture hal functions
+ *
+ * A timer channel latches its counter on each edge of its pin, and the DMA
+ * writes the values latched into a buffer split in two halves. While the DMA
+ * fills one half, the other half is handed to the application. No CPU work
+ * is done per edge.
+ *
+ * The same timers count the edges of a quadrature encoder on their channels
+ * 1 and 2, without DMA nor interrupts.
+ *
+ * # Defined behaviour
+ * * The function ::input_capture_init fails if the pin is not on a timer channel,
+ *   or if that timer is already used by another input capture object
+ * * The captures are counter values, at the rate given by ::input_capture_tick_hz
+ *   and wrapping after ::input_capture_max_count
+ * * The handler is called from interrupt context each time a half of the buffer is filled
+ * * The DMA keeps writing the other half meanwhile: a half not processed within
+ *   the time needed to fill one half is overwritten
+ * * The encoder position counts the four edges of each cycle, up in one
+ *   direction and down in the other
+ *
+ * # Undefined behaviour
+ * * Using a PwmOut on the same timer
+ * * Reading the encoder position less than once per half turn of the counter
+ * @{
+ */
+
+/** Initialize the capture of the edges of a pin
+ *
+ * @param obj The input capture object to initialize
+ * @param pin The pin, on a timer channel 1 to 4
+ * @return 0 on success, -1 if the pin cannot be captured
+ */
+int input_capture_init(input_capture_t *obj, PinName pin);
+
+/** Initialize the counting of a quadrature encoder, and start it
+ *
+ * @param obj   The input capture object to initialize
+ * @param pin_a The encoder output A, on the channel 1 of a timer
+ * @param pin_b The encoder output B, on the channel 2 of the same timer
+ * @return 0 on success, -1 if the pins cannot be counted together
+ */
+int input_capture_encoder_init(input_capture_t *obj, PinName pin_a, PinName pin_b);
+
+/** Stop the capture or the counting, and release the timer
+ *
+ * @param obj The input capture object
+ */
+void input_capture_free(input_capture_t *obj);
+
+/** Get the value after which the counter wraps to 0
+ *
+ * @param obj The input capture object
+ * @return 0xFFFF or 0xFFFFFFFF, depending on the timer width
+ */
+uint32_t input_capture_max_count(input_capture_t *obj);
+
+/** Start capturing into a double buffer
+ *
+ * @param obj     The input capture object
+ * @param tick_hz The counter rate wished, 0 for the timer clock
+ * @param edge    The edges captured
+ * @param buffer  The buffer written by the DMA
+ * @param length  The number of captures in buffer, a multiple of 2
+ * @param handler The handler called when a half of the buffer is filled
+ * @param id      The argument passed to handler
+ * @return 0 on success, -1 if the rate or buffer are not supported or no DMA channel is available
+ */
+int input_capture_start(input_capture_t *obj, uint32_t tick_hz, input_capture_edge_t edge,
+                        uint32_t *buffer, size_t length, input_capture_handler handler, uint32_t id);
+
+/** Get the counter rate
+ *
+ * @param obj The input capture object
+ * @return The rate of the counter in Hz, the closest to the one given to
+ *         ::input_capture_start that the timer prescaler allows
+ */
+uint32_t input_capture_tick_hz(input_capture_t *obj);
+
+/** Stop capturing
+ *
+ * @param obj The input capture object
+ */
+void input_capture_stop(input_capture_t *obj);
+
+/** Get the position of a quadrature encoder
+ *
+ * @param obj The input capture object, initialized by ::input_capture_encoder_init
+ * @return The number of edges counted since the initialization or the last reset
+ */
+int32_t input_capture_encoder_read(input_capture_t *obj);
+
+/** Set the position of a quadrature encoder to 0
+ *
+ * @param obj The input capture object, initialized by ::input_capture_encoder_init
+ */
+void input_capture_encoder_reset(input_capture_t *obj);
+
+/** Get the pins that support input capture
+ *
+ * Return a PinMap array of pins that support input capture.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *input_capture_pinmap(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
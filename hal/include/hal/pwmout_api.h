@@ -23,6 +23,9 @@
 #include "device.h"
 #include "pinmap.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #if DEVICE_PWMOUT
 
 #ifdef __cplusplus
@@ -173,6 +176,73 @@ const PinMap *pwmout_pinmap(void);
 
 /**@}*/
 
+#if DEVICE_PWMOUT_WAVEFORM
+
+/** Handler called when pulses of a waveform have been written to the timer
+ *
+ * @param id     The id given to ::pwmout_waveform_start
+ * @param pulses The pulses written
+ * @param count  The number of pulses written
+ */
+typedef void (*pwmout_waveform_handler)(uint32_t id, uint16_t *pulses, size_t count);
+
+/**
+ * \defgroup hal_pwmout_waveform Pwmout waveform hal functions
+ *
+ * A waveform is a sequence of pulse widths, one per period, copied by DMA
+ * into the compare register of the channel on each timer update. Each value
+ * is output during one whole period, with no CPU work per period.
+ *
+ * # Defined behaviour
+ * * The pulse widths are in ticks of the timer, the value returned by
+ *   ::pwmout_waveform_init giving a duty cycle of 100%
+ * * The output stays low during the two periods after ::pwmout_waveform_start,
+ *   then outputs the pulses in order
+ * * Without repeat, the handler is called once all the pulses are written to
+ *   the timer, one period before the last one is output, which then stays
+ *   until ::pwmout_waveform_stop or the next waveform
+ * * With repeat, the handler is called each time a half of the pulses is
+ *   written to the timer, and the sequence restarts from the beginning
+ * * ::pwmout_waveform_stop sets the period and duty cycle back to the ones
+ *   of ::pwmout_period_us and ::pwmout_write
+ *
+ * # Undefined behaviour
+ * * Changing the period or duty cycle of a channel of the same timer while
+ *   a waveform is configured
+ * @{
+ */
+
+/** Set the period of the waveform steps
+ *
+ * @param obj       The pwmout object
+ * @param period_ns The period of each pulse, in nanoseconds
+ * @return The pulse width of a duty cycle of 100%, 0 if the period is not supported
+ */
+uint32_t pwmout_waveform_init(pwmout_t *obj, uint32_t period_ns);
+
+/** Start a waveform, once pwmout_waveform_init() has set its period
+ *
+ * @param obj     The pwmout object
+ * @param pulses  The pulse widths, left in place until the handler is called
+ * @param length  The number of pulses, a multiple of 2 with repeat
+ * @param repeat  Restart from the first pulse after the last one
+ * @param handler The handler called when the pulses are written
+ * @param id      The argument passed to handler
+ * @return 0 on success, -1 if the waveform is not supported or no DMA channel is available
+ */
+int pwmout_waveform_start(pwmout_t *obj, uint16_t *pulses, size_t length, bool repeat,
+                          pwmout_waveform_handler handler, uint32_t id);
+
+/** Stop a waveform, and set the period and duty cycle back
+ *
+ * @param obj The pwmout object
+ */
+void pwmout_waveform_stop(pwmout_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
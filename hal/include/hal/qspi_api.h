@@ -215,6 +215,113 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+
+/** Enter memory mapped mode
+ *
+ * The memory is then read through a window of the address space: each access
+ * to the window sends command, with the offset in the window as address.
+ * Any other operation on obj switches back to indirect mode first.
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command, the address value is ignored
+ * @param[out] base Start of the mapped window
+ * @param[out] size Size of the mapped window in bytes
+ * @return QSPI_STATUS_OK if the memory is mapped
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_enable(qspi_t *obj, const qspi_command_t *command, const void **base, size_t *size);
+
+/** Leave memory mapped mode
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if the interface is back in indirect mode
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_disable(qspi_t *obj);
+
+#endif
+
+#if DEVICE_QSPI_ASYNCH
+
+/** Asynchronous QSPI operation handler
+ *
+ * Called from interrupt context once the operation ended
+ *
+ * @param id     Value given to the function that started the operation
+ * @param status QSPI_STATUS_OK if the operation completed, QSPI_STATUS_ERROR otherwise
+ */
+typedef void (*qspi_async_handler)(uint32_t id, qspi_status_t status);
+
+/** Send a command and a block of data, moved by DMA
+ *
+ * Only one asynchronous operation runs at a time, and no other function is
+ * called on obj until handler is.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data TX buffer, valid until handler is called
+ * @param length TX buffer length in bytes
+ * @param handler Function called at the end of the transfer
+ * @param id Argument of handler
+ * @return QSPI_STATUS_OK if the transfer started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise, handler is not called
+ */
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length,
+                               qspi_async_handler handler, uint32_t id);
+
+/** Send a command and receive a block of data, moved by DMA
+ *
+ * Only one asynchronous operation runs at a time, and no other function is
+ * called on obj until handler is.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data RX buffer, valid until handler is called
+ * @param length RX buffer length in bytes
+ * @param handler Function called at the end of the transfer
+ * @param id Argument of handler
+ * @return QSPI_STATUS_OK if the transfer started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise, handler is not called
+ */
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length,
+                              qspi_async_handler handler, uint32_t id);
+
+/** Send a status read command repeatedly until the status matches
+ *
+ * The peripheral polls the device by itself, handler is called once
+ * (status & mask) == match. Typically used to wait for the end of a flash
+ * program or erase without involving the CPU.
+ *
+ * @param obj QSPI object
+ * @param command QSPI status read command
+ * @param status_size Number of status bytes read, 1 to 4
+ * @param mask Status bits compared
+ * @param match Expected value of the compared bits
+ * @param interval Bus clock cycles between two polls, limited to what the peripheral supports
+ * @param handler Function called when the status matches
+ * @param id Argument of handler
+ * @return QSPI_STATUS_OK if polling started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise, handler is not called
+ */
+qspi_status_t qspi_poll_status_async(qspi_t *obj, const qspi_command_t *command, size_t status_size,
+                                     uint32_t mask, uint32_t match, uint32_t interval,
+                                     qspi_async_handler handler, uint32_t id);
+
+/** Abort the ongoing asynchronous operation
+ *
+ * The handler of the operation is not called.
+ *
+ * @param obj QSPI object
+ */
+void qspi_abort_async(qspi_t *obj);
+
+#endif
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
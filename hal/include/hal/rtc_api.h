@@ -177,6 +177,19 @@ time_t rtc_read(void);
  */
 void rtc_write(time_t t);
 
+#if DEVICE_RTC_SUBSECOND
+
+/** Get the current time from the RTC peripheral, with the fraction of the second
+ *
+ * The seconds and the fraction come from the same reading of the counters.
+ *
+ * @param usec Set to the microseconds elapsed in the current second
+ * @return The current time in seconds
+ */
+time_t rtc_read_subsecond(uint32_t *usec);
+
+#endif
+
 /**@}*/
 
 #ifdef __cplusplus
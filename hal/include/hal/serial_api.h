@@ -379,6 +379,92 @@ const PinMap *serial_cts_pinmap(void);
 const PinMap *serial_rts_pinmap(void);
 #endif
 
+#if DEVICE_SERIAL_DMA
+
+/**
+ * \defgroup hal_DmaSerial Serial DMA Hardware Abstraction Layer
+ * @{
+ */
+
+/** Start continuous reception into a circular buffer filled by DMA
+ *
+ * While the reception is active, the RxIrq handler registered with
+ * serial_irq_handler() is no longer called for every received character.
+ * It is called when the line goes idle after a burst, and when the DMA
+ * reaches the middle or the end of the buffer. serial_irq_set() with RxIrq
+ * enables or disables these notifications.
+ *
+ * The DMA wraps around at the end of the buffer: data not consumed before it
+ * is written again is lost.
+ *
+ * @param obj    The serial object
+ * @param buffer The circular buffer written by the DMA
+ * @param length The size of the buffer in bytes
+ * @return 0 on success, -1 if no DMA channel is available
+ */
+int serial_rx_dma_start(serial_t *obj, void *buffer, size_t length);
+
+/** Get the index in the circular buffer that the DMA will write next
+ *
+ * @param obj The serial object
+ * @return The write index, in range [0, length)
+ */
+size_t serial_rx_dma_position(serial_t *obj);
+
+/** Stop the circular reception and release its DMA channel
+ *
+ * RxIrq notifications are per character again afterwards.
+ *
+ * @param obj The serial object
+ */
+void serial_rx_dma_stop(serial_t *obj);
+
+/** Allocate a DMA channel for transmission
+ *
+ * While enabled, the TxIrq handler registered with serial_irq_handler() is
+ * no longer called when the transmit register is empty. It is called when a
+ * transfer started with serial_tx_dma_write() completes, the buffer can then
+ * be reused. serial_irq_set() with TxIrq enables or disables these
+ * notifications.
+ *
+ * @param obj The serial object
+ * @return 0 on success, -1 if no DMA channel is available
+ */
+int serial_tx_dma_enable(serial_t *obj);
+
+/** Start transmitting a buffer with the DMA
+ *
+ * The buffer must stay valid until the transfer completes.
+ *
+ * @param obj    The serial object
+ * @param buffer The data to send
+ * @param length The number of bytes to send
+ * @return 0 on success, -1 if a transfer is already active or DMA is not enabled
+ */
+int serial_tx_dma_write(serial_t *obj, const void *buffer, size_t length);
+
+/** Check whether a DMA transmission is in progress
+ *
+ * The state is read from the hardware, so a transfer that completed while
+ * interrupts are masked is reported as finished.
+ *
+ * @param obj The serial object
+ * @return Non-zero if the DMA is still reading the buffer, 0 otherwise
+ */
+int serial_tx_dma_active(serial_t *obj);
+
+/** Release the transmission DMA channel
+ *
+ * TxIrq notifications are per character again afterwards.
+ *
+ * @param obj The serial object
+ */
+void serial_tx_dma_disable(serial_t *obj);
+
+/**@}*/
+
+#endif
+
 #if DEVICE_SERIAL_ASYNCH
 
 /**@}*/
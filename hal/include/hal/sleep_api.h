@@ -21,6 +21,8 @@
 #define MBED_SLEEP_API_H
 
 #include "device.h"
+#include <stdbool.h>
+#include <stdint.h>
 
 #if DEVICE_SLEEP
 
@@ -90,6 +92,35 @@ void hal_sleep(void);
  */
 void hal_deepsleep(void);
 
+/** Description of a sleep depth of the target, see hal_sleep_get_depths()
+ */
+typedef struct {
+    uint32_t exit_latency_us;   /**< Time in microseconds to wake up from the depth, including the clock restoration */
+    uint32_t min_residency_us;  /**< Shortest time in microseconds worth spending in the depth rather than in a shallower one */
+    bool deep;                  /**< The depth has the limitations of deep sleep, allowed only when deep sleep isn't locked */
+} hal_sleep_depth_t;
+
+/** Get the sleep depths of the target
+ *
+ * The depths are ordered from the shallowest, which is hal_sleep(), to the deepest.
+ * By default there are two depths, hal_sleep() and hal_deepsleep(), the latter with
+ * the target.deep-sleep-latency exit latency. Targets able to stop in more
+ * intermediate modes override it, and hal_sleep_depth().
+ *
+ * @param count Set to the number of depths
+ * @return      The array of depths
+ */
+const hal_sleep_depth_t *hal_sleep_get_depths(uint8_t *count);
+
+/** Send the microcontroller to a sleep depth
+ *
+ * Same as hal_sleep() for depth 0, and as hal_deepsleep() for the deep depths,
+ * but in the mode of the given depth.
+ *
+ * @param depth Index of the depth in hal_sleep_get_depths()
+ */
+void hal_sleep_depth(uint8_t depth);
+
 /**@}*/
 
 #ifdef __cplusplus
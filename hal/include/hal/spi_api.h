@@ -412,6 +412,77 @@ uint8_t spi_active(spi_t *obj);
 void spi_abort_asynch(spi_t *obj);
 
 
+#endif
+
+#if DEVICE_SPISLAVE_DMA
+/**
+ * \defgroup DmaSPISlave SPI slave DMA Hardware Abstraction Layer
+ *
+ * Continuous reception in slave mode, framed by the chip select: the DMA
+ * writes every received frame to a circular buffer, and a handler is called
+ * each time the master releases the chip select. A reply can be preloaded
+ * for the next transaction.
+ *
+ * @{
+ */
+
+/** Handler called when the master ends a transaction
+ *
+ * @param id The id given to spi_slave_dma_start()
+ */
+typedef void (*spi_slave_dma_handler)(uint32_t id);
+
+/** Start continuous reception into a circular buffer filled by DMA
+ *
+ * The SPI must be in slave mode with a hardware chip select. The handler is
+ * called from interrupt context on each rising edge of the chip select;
+ * spi_slave_dma_count() then tells how much was received.
+ *
+ * The DMA wraps around at the end of the buffer: data not consumed before it
+ * is written again is lost.
+ *
+ * @param obj     The SPI object
+ * @param buffer  The circular buffer written by the DMA
+ * @param length  The size of the buffer in bytes
+ * @param handler Handler called at the end of each transaction
+ * @param id      Argument of the handler
+ * @return 0 on success, -1 if there is no chip select or no DMA channel is available
+ */
+int spi_slave_dma_start(spi_t *obj, void *buffer, size_t length, spi_slave_dma_handler handler, uint32_t id);
+
+/** Get the number of bytes received since the reception started
+ *
+ * The count wraps around at 2^32, only differences between two counts are
+ * meaningful.
+ *
+ * @param obj The SPI object
+ * @return Bytes written to the buffer by the DMA
+ */
+uint32_t spi_slave_dma_count(spi_t *obj);
+
+/** Set the data sent to the master from the start of the next transaction
+ *
+ * Must be called while the chip select is released, usually from the
+ * handler. Whatever the previous reply left in the transmit FIFO is
+ * discarded. The buffer must stay valid until the reply is changed or the
+ * reception stops. Once it has been sent, the content of the frames sent is
+ * undefined.
+ *
+ * @param obj    The SPI object
+ * @param buffer The reply, NULL for none
+ * @param length The size of the reply in bytes
+ * @return 0 on success, -1 if the reception isn't started or MISO is not connected
+ */
+int spi_slave_dma_reply(spi_t *obj, const void *buffer, size_t length);
+
+/** Stop the reception and release its DMA channels
+ *
+ * @param obj The SPI object
+ */
+void spi_slave_dma_stop(spi_t *obj);
+
+/**@}*/
+
 #endif
 
 /**@}*/
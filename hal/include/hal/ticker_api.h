@@ -70,6 +70,19 @@ typedef struct {
     bool runs_in_deep_sleep;                      /**< Whether ticker operates in deep sleep */
 } ticker_interface_t;
 
+/** Statistics of the dispatching of a ticker's events
+ *
+ * Only maintained when MBED_TICKER_STATS_ENABLED is set
+ */
+typedef struct {
+    uint32_t irq_count;                 /**< Interrupts handled */
+    uint32_t event_count;               /**< Events dispatched */
+    uint32_t max_batch;                 /**< Most events dispatched by one interrupt */
+    uint32_t max_late_us;               /**< Longest time from the timestamp of an event to its dispatch */
+    uint32_t max_isr_us;                /**< Longest time spent in ticker_irq_handler */
+    us_timestamp_t total_isr_us;        /**< Total time spent in ticker_irq_handler */
+} ticker_stats_t;
+
 /** Ticker's event queue structure
  */
 typedef struct {
@@ -86,6 +99,8 @@ typedef struct {
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
     uint8_t frequency_shifts;           /**< If frequency is a value of 2^n, this is n, otherwise 0 */
+    ticker_stats_t stats;               /**< Dispatching statistics */
+    volatile uint32_t update_count;     /**< Incremented before and after updates of the present time, see ticker_read_us */
 } ticker_event_queue_t;
 
 /** Ticker's data structure
@@ -152,6 +167,10 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  * timestamp then the event will be scheduled immediately resulting in
  * an instant call to event handler.
  *
+ * @note With platform.ticker-slack-us set, the event may be delayed by up to
+ * that time so that it is dispatched by the same interrupt as the events
+ * falling just after it.
+ *
  * @param ticker    The ticker object.
  * @param obj       The event object to be inserted to the queue
  * @param timestamp The event's timestamp
@@ -216,6 +235,17 @@ void ticker_suspend(const ticker_data_t *const ticker);
  */
 void ticker_resume(const ticker_data_t *const ticker);
 
+/** Get the statistics of the dispatching of the events of this ticker
+ *
+ * The statistics are all 0 unless MBED_TICKER_STATS_ENABLED is set.
+ *
+ * @param ticker        The ticker object.
+ * @param stats         The structure filled with the statistics since the
+ *                      ticker was initialized or the last call with reset set
+ * @param reset         Set the statistics to 0 once read
+ */
+void ticker_get_stats(const ticker_data_t *const ticker, ticker_stats_t *stats, bool reset);
+
 /* Private functions
  *
  * @cond PRIVATE
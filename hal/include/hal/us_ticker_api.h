@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include "hal/ticker_api.h"
+#include "platform/mbed_toolchain.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -147,6 +148,51 @@ const ticker_data_t *get_us_ticker_data(void);
  */
 void us_ticker_irq_handler(void);
 
+/** Read the microsecond ticker in microseconds
+ *
+ * Same as ticker_read_us(get_us_ticker_data()). Targets defining the
+ * compile-time optimization macros for a 32-bit 1MHz ticker get an inline
+ * version, which extends the counter read by us_ticker_read() without calling
+ * through the ticker interface.
+ *
+ * @return The current time of the microsecond ticker in microseconds
+ */
+us_timestamp_t (us_ticker_read_us)(void);
+
+#if DEVICE_USTICKER && defined US_TICKER_PERIOD_NUM
+#if US_TICKER_PERIOD_NUM == 1 && US_TICKER_PERIOD_DEN == 1 && US_TICKER_MASK == 0xFFFFFFFF
+extern ticker_event_queue_t _us_ticker_events;
+
+/* Lock-free read, see read_present_time in mbed_ticker_api.c */
+MBED_FORCEINLINE us_timestamp_t _us_ticker_read_us_inline(void)
+{
+    ticker_event_queue_t *queue = &_us_ticker_events;
+    uint32_t count;
+    us_timestamp_t ret;
+
+    if (!queue->initialized) {
+        return ticker_read_us(get_us_ticker_data());
+    }
+
+    do {
+        count = queue->update_count;
+        MBED_BARRIER();
+
+        ret = queue->present_time;
+        if (!queue->suspended) {
+            ret += (uint32_t)(us_ticker_read() - queue->tick_last_read);
+        }
+
+        MBED_BARRIER();
+    } while ((count & 1) || count != queue->update_count);
+
+    return ret;
+}
+
+#define us_ticker_read_us() _us_ticker_read_us_inline()
+#endif
+#endif
+
 /* HAL us ticker */
 
 /** Initialize the ticker
@@ -16,10 +16,12 @@
  */
 
 #include "analogin_api.h"
+#include "can_api.h"
 #include "i2c_api.h"
 #include "spi_api.h"
 #include "gpio_api.h"
 #include "reset_reason_api.h"
+#include "sleep_api.h"
 #include "mbed_toolchain.h"
 
 // To be re-implemented in the target layer if required
@@ -94,6 +96,24 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
 
 #endif
 
+#if DEVICE_CAN
+// To be re-implemented in the target layer if it has several filters
+MBED_WEAK int can_filter_count(can_t *obj)
+{
+    return 1;
+}
+
+MBED_WEAK int can_filter_list(can_t *obj, const uint32_t *ids, int count, CANFormat format, int32_t handle)
+{
+    return 0;
+}
+
+MBED_WEAK int can_filter_disable(can_t *obj, int32_t handle)
+{
+    return 0;
+}
+#endif
+
 #if DEVICE_RESET_REASON
 // To be re-implemented in the target layer if required
 MBED_WEAK void hal_reset_reason_get_capabilities(reset_reason_capabilities_t *cap)
@@ -104,3 +124,25 @@ MBED_WEAK void hal_reset_reason_get_capabilities(reset_reason_capabilities_t *ca
 #endif
 }
 #endif
+
+#if DEVICE_SLEEP
+// To be re-implemented in the target layer if it has intermediate sleep modes
+MBED_WEAK const hal_sleep_depth_t *hal_sleep_get_depths(uint8_t *count)
+{
+    static const hal_sleep_depth_t depths[] = {
+        { 0, 0, false },
+        { MBED_CONF_TARGET_DEEP_SLEEP_LATENCY * 1000, MBED_CONF_TARGET_DEEP_SLEEP_LATENCY * 2000, true },
+    };
+    *count = sizeof(depths) / sizeof(depths[0]);
+    return depths;
+}
+
+MBED_WEAK void hal_sleep_depth(uint8_t depth)
+{
+    if (depth == 0) {
+        hal_sleep();
+    } else {
+        hal_deepsleep();
+    }
+}
+#endif
@@ -16,10 +16,17 @@
  */
 #include <stdio.h>
 #include <stddef.h>
+#include <string.h>
 #include "hal/ticker_api.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_error.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_toolchain.h"
+
+#ifndef MBED_CONF_PLATFORM_TICKER_SLACK_US
+#define MBED_CONF_PLATFORM_TICKER_SLACK_US 0
+#endif
 
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
@@ -94,6 +101,7 @@ static void initialize(const ticker_data_t *ticker)
     ticker->queue->present_time = 0;
     ticker->queue->dispatching = false;
     ticker->queue->suspended = false;
+    memset(&ticker->queue->stats, 0, sizeof(ticker->queue->stats));
     ticker->queue->initialized = true;
 
     update_present_time(ticker);
@@ -139,6 +147,26 @@ static us_timestamp_t convert_timestamp(us_timestamp_t ref, timestamp_t timestam
     return result;
 }
 
+/**
+ * Mark the start of an update of the present time, which must be done with
+ * interrupts disabled. Lock-free readers retry their read if the count
+ * changes under them.
+ */
+static void present_time_update_begin(ticker_event_queue_t *queue)
+{
+    queue->update_count++;
+    MBED_BARRIER();
+}
+
+/**
+ * Mark the end of an update of the present time.
+ */
+static void present_time_update_end(ticker_event_queue_t *queue)
+{
+    MBED_BARRIER();
+    queue->update_count++;
+}
+
 /**
  * Update the present timestamp value of a ticker.
  */
@@ -154,6 +182,8 @@ static void update_present_time(const ticker_data_t *const ticker)
         return;
     }
 
+    present_time_update_begin(queue);
+
     uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
     queue->tick_last_read = ticker_time;
 
@@ -189,6 +219,45 @@ static void update_present_time(const ticker_data_t *const ticker)
 
     // Update current time
     queue->present_time += elapsed_us;
+
+    present_time_update_end(queue);
+}
+
+/**
+ * Read the present time of a ticker whose counter is 32 bits wide, without
+ * updating it nor disabling interrupts.
+ *
+ * The elapsed ticks since the last update are converted as
+ * update_present_time would, and the read is retried if an update happened
+ * meanwhile. The interrupt scheduled at most max_delta ticks ahead updates the
+ * present time well before a 32-bit counter can wrap.
+ */
+static us_timestamp_t read_present_time(const ticker_data_t *const ticker)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+    uint32_t count;
+    us_timestamp_t ret;
+
+    do {
+        count = queue->update_count;
+        MBED_BARRIER();
+
+        ret = queue->present_time;
+        if (!queue->suspended) {
+            uint64_t elapsed_ticks = ticker->interface->read() - queue->tick_last_read;
+            if (1000000 == queue->frequency) {
+                ret += elapsed_ticks;
+            } else if (0 != queue->frequency_shifts) {
+                ret += (elapsed_ticks * 1000000 + queue->tick_remainder) >> queue->frequency_shifts;
+            } else {
+                ret += (elapsed_ticks * 1000000 + queue->tick_remainder) / queue->frequency;
+            }
+        }
+
+        MBED_BARRIER();
+    } while ((count & 1) || count != queue->update_count);
+
+    return ret;
 }
 
 /**
@@ -276,6 +345,15 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
             return;
         }
 
+#if MBED_CONF_PLATFORM_TICKER_SLACK_US
+        // Delay the interrupt to the last event within the slack of the
+        // head, so that a single interrupt dispatches all of them
+        us_timestamp_t latest = match_time + MBED_CONF_PLATFORM_TICKER_SLACK_US;
+        for (ticker_event_t *p = ticker->queue->head->next; p != NULL && p->timestamp <= latest; p = p->next) {
+            match_time = p->timestamp;
+        }
+#endif
+
         timestamp_t match_tick = compute_tick_round_up(ticker, match_time);
 
         // The same tick should never occur since match_tick is rounded up.
@@ -314,6 +392,13 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
         return;
     }
 
+#if MBED_TICKER_STATS_ENABLED
+    ticker_stats_t *stats = &ticker->queue->stats;
+    uint32_t batch = 0;
+    update_present_time(ticker);
+    us_timestamp_t start = ticker->queue->present_time;
+#endif
+
     /* Go through all the pending TimerEvents */
     ticker->queue->dispatching = true;
     while (1) {
@@ -329,6 +414,13 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
             ticker->queue->head = ticker->queue->head->next;
+#if MBED_TICKER_STATS_ENABLED
+            us_timestamp_t late = ticker->queue->present_time - p->timestamp;
+            if (late > stats->max_late_us) {
+                stats->max_late_us = late > UINT32_MAX ? UINT32_MAX : (uint32_t)late;
+            }
+            batch++;
+#endif
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -342,6 +434,20 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
 
     schedule_interrupt(ticker);
 
+#if MBED_TICKER_STATS_ENABLED
+    update_present_time(ticker);
+    us_timestamp_t isr_us = ticker->queue->present_time - start;
+    stats->irq_count++;
+    stats->event_count += batch;
+    if (batch > stats->max_batch) {
+        stats->max_batch = batch;
+    }
+    if (isr_us > stats->max_isr_us) {
+        stats->max_isr_us = isr_us > UINT32_MAX ? UINT32_MAX : (uint32_t)isr_us;
+    }
+    stats->total_isr_us += isr_us;
+#endif
+
     core_util_critical_section_exit();
 }
 
@@ -403,6 +509,12 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     if (prev == NULL || timestamp <= ticker->queue->present_time) {
         schedule_interrupt(ticker);
     }
+#if MBED_CONF_PLATFORM_TICKER_SLACK_US
+    else if (timestamp <= ticker->queue->head->timestamp + MBED_CONF_PLATFORM_TICKER_SLACK_US) {
+        // Joins the batch of the head: the interrupt moves to it
+        schedule_interrupt(ticker);
+    }
+#endif
 
     core_util_critical_section_exit();
 }
@@ -442,6 +554,10 @@ us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 
     initialize(ticker);
 
+    if (ticker->queue->bitmask == UINT32_MAX) {
+        return read_present_time(ticker);
+    }
+
     core_util_critical_section_enter();
     update_present_time(ticker);
     ret = ticker->queue->present_time;
@@ -484,7 +600,9 @@ void ticker_suspend(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    present_time_update_begin(ticker->queue);
     ticker->queue->suspended = true;
+    present_time_update_end(ticker->queue);
 
     core_util_critical_section_exit();
 }
@@ -493,15 +611,30 @@ void ticker_resume(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    present_time_update_begin(ticker->queue);
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
         ticker->queue->tick_last_read = ticker->interface->read();
+        present_time_update_end(ticker->queue);
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
     } else {
+        present_time_update_end(ticker->queue);
         initialize(ticker);
     }
 
     core_util_critical_section_exit();
 }
+
+void ticker_get_stats(const ticker_data_t *const ticker, ticker_stats_t *stats, bool reset)
+{
+    core_util_critical_section_enter();
+
+    *stats = ticker->queue->stats;
+    if (reset) {
+        memset(&ticker->queue->stats, 0, sizeof(ticker->queue->stats));
+    }
+
+    core_util_critical_section_exit();
+}
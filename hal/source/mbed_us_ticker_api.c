@@ -21,7 +21,7 @@
 
 #if DEVICE_USTICKER
 
-static ticker_event_queue_t events = { 0 };
+ticker_event_queue_t _us_ticker_events = { 0 };
 
 static ticker_irq_handler_type irq_handler = ticker_irq_handler;
 
@@ -78,7 +78,7 @@ static const ticker_interface_t us_interface = {
 
 static const ticker_data_t us_data = {
     .interface = &us_interface,
-    .queue = &events
+    .queue = &_us_ticker_events
 };
 
 const ticker_data_t *get_us_ticker_data(void)
@@ -102,6 +102,16 @@ void us_ticker_irq_handler(void)
     }
 }
 
+us_timestamp_t (us_ticker_read_us)(void)
+{
+#ifdef us_ticker_read_us
+    /* Invoke the macro */
+    return us_ticker_read_us();
+#else
+    return ticker_read_us(&us_data);
+#endif
+}
+
 #else
 
 const ticker_data_t *get_us_ticker_data(void)
@@ -109,4 +119,9 @@ const ticker_data_t *get_us_ticker_data(void)
     return NULL;
 }
 
+us_timestamp_t (us_ticker_read_us)(void)
+{
+    return 0;
+}
+
 #endif  // DEVICE_USTICKER
@@ -44,6 +44,21 @@ MBED_STATIC_ASSERT(
     MBED_MPU_ROM_END == 0x20000000 - 1,
     "Unsupported value for MBED_MPU_ROM_END");
 
+#if defined(MBED_RAMFUNC_SIZE) && (MBED_RAMFUNC_SIZE > 0) && (defined(__GNUC__) || defined(__clang__))
+MBED_STATIC_ASSERT(
+    MBED_RAMFUNC_SIZE >= 32 && (MBED_RAMFUNC_SIZE & (MBED_RAMFUNC_SIZE - 1)) == 0,
+    "MBED_RAMFUNC_SIZE must be a power of 2 of at least 32");
+
+// Start of the .ramfunc section, aligned on its size by the linker scripts
+#if defined(__ARMCC_VERSION)
+extern uint32_t Image$$RW_RAMFUNC$$Base[];
+#define MBED_MPU_RAMFUNC_START      ((uint32_t)Image$$RW_RAMFUNC$$Base)
+#else
+extern uint32_t __ramfunc_start__[];
+#define MBED_MPU_RAMFUNC_START      ((uint32_t)__ramfunc_start__)
+#endif
+#endif
+
 void mbed_mpu_init()
 {
     // Flush memory writes before configuring the MPU.
@@ -58,6 +73,9 @@ void mbed_mpu_init()
 #else
     MBED_ASSERT(regions >= 4);
 #endif
+#ifdef MBED_MPU_RAMFUNC_START
+    MBED_ASSERT(regions >= 5);
+#endif
 
     // Disable the MCU
     MPU->CTRL = 0;
@@ -136,6 +154,25 @@ void mbed_mpu_init()
 #define LAST_RAM_REGION 2
 #endif
 
+#ifdef MBED_MPU_RAMFUNC_START
+    // Select region 4 and use it for the functions declared with MBED_RAMFUNC
+    // - Executable and read only whatever the RAM execute never setting
+    ARM_MPU_SetRegion(
+        ARM_MPU_RBAR(
+            4,                          // Region
+            MBED_MPU_RAMFUNC_START),    // Base
+        ARM_MPU_RASR(
+            0,                          // DisableExec
+            ARM_MPU_AP_RO,              // AccessPermission
+            0,                          // TypeExtField
+            0,                          // IsShareable
+            1,                          // IsCacheable
+            0,                          // IsBufferable
+            0U,                         // SubRegionDisable
+            __builtin_ctz(MBED_RAMFUNC_SIZE) - 1)   // Size
+    );
+#endif
+
     // Select region 1 and use it for WBWA ram regions
     // - SRAM 0x20000000 to 0x3FFFFFFF
     // - RAM  0x60000000 to 0x7FFFFFFF
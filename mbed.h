@@ -59,14 +59,20 @@
 #include "drivers/PortIn.h"
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
+#include "drivers/FastGPIO.h"
 #include "drivers/AnalogIn.h"
+#include "drivers/AnalogInStream.h"
+#include "drivers/AnalogInPipeline.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
+#include "drivers/InputCapture.h"
+#include "drivers/QuadratureEncoder.h"
 #include "drivers/SPI.h"
 #include "drivers/SPISlave.h"
 #include "drivers/I2C.h"
 #include "drivers/I2CSlave.h"
 #include "drivers/CAN.h"
+#include "drivers/BufferedCAN.h"
 #include "drivers/UnbufferedSerial.h"
 #include "drivers/BufferedSerial.h"
 #include "drivers/FlashIAP.h"
@@ -87,11 +93,13 @@
 #include "drivers/RealTimeClock.h"
 #include "platform/LocalFileSystem.h"
 #include "drivers/InterruptIn.h"
+#include "drivers/InterruptInGroup.h"
 #include "platform/mbed_wait_api.h"
 #include "platform/mbed_thread.h"
 #include "hal/sleep_api.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_clock_scaling.h"
 #include "platform/mbed_rtc_time.h"
 #include "platform/mbed_poll.h"
 #include "platform/ATCmdParser.h"
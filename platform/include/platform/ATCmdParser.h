@@ -26,6 +26,10 @@
 #include "platform/NonCopyable.h"
 #include "platform/FileHandle.h"
 
+#ifndef ATCMDPARSER_OOB_BUCKETS
+#define ATCMDPARSER_OOB_BUCKETS 8
+#endif
+
 namespace mbed {
 /** \addtogroup platform-public-api Platform */
 /** @{*/
@@ -77,7 +81,15 @@ private:
         mbed::Callback<void()> cb;
         oob *next;
     };
-    oob *_oobs;
+    // OOB prefixes hashed on their length and first character, so that
+    // each received character is compared with at most a few of them
+    oob *_oobs[ATCMDPARSER_OOB_BUCKETS];
+    unsigned _oob_max_len;
+
+    static int oob_bucket(unsigned len, char first)
+    {
+        return (len * 31 + (unsigned char)first) % ATCMDPARSER_OOB_BUCKETS;
+    }
 
     /**
      * Receive an AT response
@@ -110,7 +122,7 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
                 int buffer_size = 256, int timeout = 8000, bool debug = false)
-        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(NULL)
+        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(), _oob_max_len(0)
     {
         _buffer = new char[buffer_size];
         set_timeout(timeout);
@@ -123,10 +135,12 @@ public:
      */
     ~ATCmdParser()
     {
-        while (_oobs) {
-            struct oob *oob = _oobs;
-            _oobs = oob->next;
-            delete oob;
+        for (int i = 0; i < ATCMDPARSER_OOB_BUCKETS; i++) {
+            while (_oobs[i]) {
+                struct oob *oob = _oobs[i];
+                _oobs[i] = oob->next;
+                delete oob;
+            }
         }
         delete[] _buffer;
     }
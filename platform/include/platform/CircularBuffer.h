@@ -18,8 +18,10 @@
 #define MBED_CIRCULARBUFFER_H
 
 #include <stdint.h>
+#include <algorithm>
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
+#include "platform/Span.h"
 
 namespace mbed {
 
@@ -108,6 +110,50 @@ public:
         core_util_critical_section_exit();
     }
 
+    /** Push elements to the buffer. This overwrites the oldest elements if
+     *  the buffer gets full
+     *
+     * The elements are copied in at most two contiguous parts. If there are
+     * more than BufferSize elements, only the last BufferSize are kept.
+     *
+     * @param src Elements to be pushed to the buffer
+     */
+    void push(Span<const T> src)
+    {
+        const T *ptr = src.data();
+        core_util_critical_section_enter();
+        if ((size_t) src.size() >= BufferSize) {
+            ptr += src.size() - BufferSize;
+            std::copy(ptr, ptr + BufferSize, _pool);
+            _head = 0;
+            _tail = 0;
+            _full = true;
+        } else if (!src.empty()) {
+            CounterType len = src.size();
+            CounterType space = BufferSize - size();
+            CounterType first = std::min<CounterType>(len, BufferSize - _head);
+            std::copy(ptr, ptr + first, &_pool[_head]);
+            std::copy(ptr + first, ptr + len, _pool);
+            _head = (_head + len) % BufferSize;
+            if (len >= space) {
+                _tail = _head;
+                _full = true;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** Push elements to the buffer. This overwrites the oldest elements if
+     *  the buffer gets full
+     *
+     * @param src Elements to be pushed to the buffer
+     * @param len Number of elements
+     */
+    void push(const T *src, CounterType len)
+    {
+        push(Span<const T>(src, len));
+    }
+
     /** Pop the transaction from the buffer
      *
      * @param data Data to be popped from the buffer
@@ -129,6 +175,42 @@ public:
         return data_popped;
     }
 
+    /** Pop elements from the buffer
+     *
+     * The elements are copied out in at most two contiguous parts.
+     *
+     * @param dest Buffer for the elements popped
+     * @return Number of elements popped, less than dest.size() if the buffer had fewer elements
+     */
+    CounterType pop(Span<T> dest)
+    {
+        core_util_critical_section_enter();
+        CounterType len = size();
+        if ((size_t) dest.size() < len) {
+            len = dest.size();
+        }
+        CounterType first = std::min<CounterType>(len, BufferSize - _tail);
+        std::copy(&_pool[_tail], &_pool[_tail] + first, dest.data());
+        std::copy(_pool, _pool + len - first, dest.data() + first);
+        if (len != 0) {
+            _tail = (_tail + len) % BufferSize;
+            _full = false;
+        }
+        core_util_critical_section_exit();
+        return len;
+    }
+
+    /** Pop elements from the buffer
+     *
+     * @param dest Buffer for the elements popped
+     * @param len Maximum number of elements to pop
+     * @return Number of elements popped
+     */
+    CounterType pop(T *dest, CounterType len)
+    {
+        return pop(Span<T>(dest, len));
+    }
+
     /** Check if the buffer is empty
      *
      * @return True if the buffer is empty, false if not
@@ -200,6 +282,80 @@ public:
         return data_updated;
     }
 
+    /** Get the oldest elements which are stored contiguously in memory
+     *
+     * The stored elements wrap at the end of the internal array, so this may
+     * be only the first part of them. The elements stay in the buffer until
+     * they are released with consume(), which lets a DMA engine read them in
+     * place.
+     *
+     * @return A view of the contiguous elements starting at the oldest one,
+     *         empty if the buffer is empty
+     */
+    Span<const T> peek_contiguous() const
+    {
+        core_util_critical_section_enter();
+        CounterType elements = 0;
+        if (!empty()) {
+            elements = (_head > _tail) ? _head - _tail : BufferSize - _tail;
+        }
+        Span<const T> data(&_pool[_tail], elements);
+        core_util_critical_section_exit();
+        return data;
+    }
+
+    /** Remove the oldest elements from the buffer without copying them
+     *
+     * @param count Number of elements to remove, at most size()
+     */
+    void consume(CounterType count)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(count <= size());
+        if (count != 0) {
+            _tail = (_tail + count) % BufferSize;
+            _full = false;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** Get the free space which follows the newest element contiguously in memory
+     *
+     * The free space wraps at the end of the internal array, so this may be
+     * only the first part of it. Elements written there with a DMA engine or
+     * a copy are added to the buffer with commit().
+     *
+     * @return A view of the contiguous free space, empty if the buffer is full
+     */
+    Span<T> reserve_contiguous()
+    {
+        core_util_critical_section_enter();
+        CounterType space = 0;
+        if (!full()) {
+            space = (_tail > _head) ? _tail - _head : BufferSize - _head;
+        }
+        Span<T> data(&_pool[_head], space);
+        core_util_critical_section_exit();
+        return data;
+    }
+
+    /** Add the elements written in the space given by reserve_contiguous()
+     *
+     * @param count Number of elements written, at most the size of the reserved space
+     */
+    void commit(CounterType count)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(count <= BufferSize - size());
+        if (count != 0) {
+            _head = (_head + count) % BufferSize;
+            if (_head == _tail) {
+                _full = true;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
 private:
     T _pool[BufferSize];
     CounterType _head;
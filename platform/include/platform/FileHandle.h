@@ -216,7 +216,8 @@ public:
      * You can use or ignore the input parameter. You can return all events
      * or check just the events listed in events.
      * Call is nonblocking - returns instantaneous state of events.
-     * Whenever an event occurs, the derived class should call the sigio() callback).
+     * Whenever an event occurs, the derived class should call the sigio() callback,
+     * and mbed::poll_notify() if it returns true from poll_notifies().
      *
      * @param events        bitmask of poll events we're interested in - POLLIN/POLLOUT etc.
      *
@@ -228,6 +229,18 @@ public:
         return POLLIN | POLLOUT;
     }
 
+    /** Tell whether the file handle calls mbed::poll_notify() on each change of its poll events.
+     *
+     *  poll() and PollSet block until the notification of a file handle that notifies its
+     *  changes, and examine the other ones again every millisecond.
+     *
+     *  @returns            true if the changes are notified with mbed::poll_notify()
+     */
+    virtual bool poll_notifies() const
+    {
+        return false;
+    }
+
     /** Definition depends on the subclass implementing FileHandle.
      *  For example, if the FileHandle is of type Stream, writable() could return
      *  true when there is ample buffer space available for write() calls.
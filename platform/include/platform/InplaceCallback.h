@@ -0,0 +1,245 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INPLACECALLBACK_H
+#define MBED_INPLACECALLBACK_H
+
+#include <cstring>
+#include <mstd_cstddef>
+#include <mstd_new>
+#include "platform/Callback.h"
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_InplaceCallback InplaceCallback class
+ * @{
+ */
+
+/** Callback with storage for function objects of up to Size bytes
+ *
+ * Callback only has room for a member function pointer and an object
+ * pointer. InplaceCallback stores larger function objects, such as lambdas
+ * capturing several values, in the object itself: it never allocates, so it
+ * can be created, copied and called from interrupt handlers.
+ *
+ * Function objects don't need to be trivially copyable, whatever the
+ * platform.callback-nontrivial setting. A function object larger than Size
+ * bytes fails to compile.
+ *
+ * InplaceCallback is a function object itself, so it can be posted with
+ * EventQueue::call() or held by a UserAllocatedEvent, and wrapped by a
+ * Callback as long as it outlives it:
+ *
+ * @code
+ * InplaceCallback<void(), 24> cb = [=] { send(address, port, 3 * count); };
+ * queue.call(cb);
+ * Callback<void()> wrapped(&cb, &InplaceCallback<void(), 24>::call);
+ * @endcode
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename Signature, size_t Size>
+class InplaceCallback;
+
+template <typename R, typename... ArgTs, size_t Size>
+class InplaceCallback<R(ArgTs...), Size> {
+public:
+    using result_type = R;
+
+    /** Create an empty InplaceCallback
+     */
+    InplaceCallback() noexcept : _ops(nullptr) { }
+
+    /** Create an empty InplaceCallback
+     */
+    InplaceCallback(std::nullptr_t) noexcept : InplaceCallback() { }
+
+    /** Copy an InplaceCallback
+     *  @param other    The InplaceCallback to copy
+     */
+    InplaceCallback(const InplaceCallback &other) : _ops(nullptr)
+    {
+        copy(other);
+    }
+
+    // *INDENT-OFF*
+    /** Create an InplaceCallback with a function object or a function pointer
+     *  @param f    Function object to attach
+     */
+    template <typename F,
+              typename std::enable_if_t<
+                  !std::is_same<std::decay_t<F>, InplaceCallback>::value &&
+                  mstd::is_invocable_r<R, std::decay_t<F>, ArgTs...>::value, int> = 0>
+    InplaceCallback(F &&f) : _ops(nullptr)
+    {
+        generate(std::forward<F>(f));
+    }
+    // *INDENT-ON*
+
+    /** Destroy an InplaceCallback
+     */
+    ~InplaceCallback()
+    {
+        destroy();
+    }
+
+    /** Assign an InplaceCallback
+     */
+    InplaceCallback &operator=(const InplaceCallback &that)
+    {
+        if (this != &that) {
+            destroy();
+            copy(that);
+        }
+        return *this;
+    }
+
+    /** Empty an InplaceCallback
+     */
+    InplaceCallback &operator=(std::nullptr_t) noexcept
+    {
+        destroy();
+        return *this;
+    }
+
+    /** Call the attached function
+     */
+    R call(ArgTs... args) const
+    {
+        MBED_ASSERT(_ops);
+        return _ops->call(_storage, std::forward<ArgTs>(args)...);
+    }
+
+    /** Call the attached function
+     */
+    R operator()(ArgTs... args) const
+    {
+        return call(std::forward<ArgTs>(args)...);
+    }
+
+    /** Test if function has been assigned
+     */
+    explicit operator bool() const noexcept
+    {
+        return _ops != nullptr;
+    }
+
+    /** Static thunk for passing as C-style function
+     *  @param func InplaceCallback to call passed as void pointer
+     *  @param args Arguments to be called with function func
+     *  @return the value as determined by func which is of
+     *      type and determined by the signature of func
+     */
+    static R thunk(void *func, ArgTs... args)
+    {
+        return static_cast<InplaceCallback *>(func)->call(args...);
+    }
+
+private:
+    struct ops {
+        R(*call)(const void *, ArgTs...);
+        // Null for trivial function objects, which are copied with memcpy
+        void (*copy)(void *, const void *);
+        void (*dtor)(void *);
+    };
+
+    template <typename F>
+    void generate(F &&f)
+    {
+        using T = std::decay_t<F>;
+        static_assert(std::is_copy_constructible<T>::value, "InplaceCallback F must be CopyConstructible");
+        static_assert(sizeof(T) <= Size, "Type F must not exceed the Size of the InplaceCallback");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Type F must not be over-aligned");
+
+        if (!null_check(f)) {
+            return;
+        }
+
+        static const ops ops = {
+            target_call<T>,
+            std::is_trivially_copy_constructible<T>::value ? nullptr : target_copy<T>,
+            std::is_trivially_destructible<T>::value ? nullptr : target_dtor<T>,
+        };
+        new (_storage) T(std::forward<F>(f));
+        _ops = &ops;
+    }
+
+    void copy(const InplaceCallback &other)
+    {
+        if (!other._ops) {
+            return;
+        }
+        if (other._ops->copy) {
+            other._ops->copy(_storage, other._storage);
+        } else {
+            std::memcpy(_storage, other._storage, Size);
+        }
+        _ops = other._ops;
+    }
+
+    void destroy()
+    {
+        if (_ops && _ops->dtor) {
+            _ops->dtor(_storage);
+        }
+        _ops = nullptr;
+    }
+
+    template <typename F, typename std::enable_if_t<detail::can_null_check<F>::value, int> = 0>
+    static bool null_check(const F &f)
+    {
+        return f != nullptr;
+    }
+
+    template <typename F, typename std::enable_if_t<!detail::can_null_check<F>::value, int> = 0>
+    static bool null_check(const F &)
+    {
+        return true;
+    }
+
+    template <typename F>
+    static R target_call(const void *p, ArgTs... args)
+    {
+        F &f = const_cast<F &>(*static_cast<const F *>(p));
+        return detail::invoke_r<R>(f, std::forward<ArgTs>(args)...);
+    }
+
+    template <typename F>
+    static void target_copy(void *d, const void *p)
+    {
+        new (d) F(*static_cast<const F *>(p));
+    }
+
+    template <typename F>
+    static void target_dtor(void *p)
+    {
+        static_cast<F *>(p)->~F();
+    }
+
+    const ops *_ops;
+    alignas(std::max_align_t) char _storage[Size];
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,353 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_INTRUSIVEPTR_H
+#define MBED_INTRUSIVEPTR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_IntrusivePtr IntrusivePtr class
+ * @{
+ */
+
+/** Reference count embedded in an object, for IntrusivePtr.
+ *
+ * Derive from RefCounted<T> to make T shareable through IntrusivePtr<T>.
+ * Once the last reference is released, T::destroy() is called, which
+ * deletes the object by default. A class whose objects come from an
+ * ObjectPool or a static buffer declares its own destroy() to give them
+ * back instead:
+ *
+ * @code
+ * struct Packet : mbed::RefCounted<Packet> {
+ *     uint8_t data[128];
+ *
+ *     void destroy()
+ *     {
+ *         pool.destroy(this);
+ *     }
+ *
+ *     static mbed::ObjectPool<Packet, 8> pool;
+ * };
+ *
+ * mbed::IntrusivePtr<Packet> packet(Packet::pool.construct());
+ * @endcode
+ *
+ * The count is updated with the atomic operations of mbed_atomic.h, so
+ * references can be taken and released from threads and interrupts.
+ */
+template <class T>
+class RefCounted : private NonCopyable<RefCounted<T> > {
+public:
+    /** Take a reference to the object
+     */
+    void add_ref() const
+    {
+        core_util_atomic_incr_u32(&_ref_count, 1);
+    }
+
+    /** Release a reference to the object, destroying it with the last one
+     */
+    void release() const
+    {
+        if (core_util_atomic_decr_u32(&_ref_count, 1) == 0) {
+            static_cast<T *>(const_cast<RefCounted *>(this))->destroy();
+        }
+    }
+
+    /** Number of references to the object
+     *
+     * @return Reference count
+     */
+    uint32_t use_count() const
+    {
+        return core_util_atomic_load_u32(&_ref_count);
+    }
+
+protected:
+    constexpr RefCounted() : _ref_count(0)
+    {
+    }
+
+    ~RefCounted() = default;
+
+    /** Called once the last reference is released
+     */
+    void destroy()
+    {
+        delete static_cast<T *>(this);
+    }
+
+private:
+    mutable uint32_t _ref_count;
+};
+
+/** Smart pointer to an object carrying its own reference count.
+ *
+ * Unlike SharedPtr, which allocates a counter on the heap beside each
+ * object, the count is part of the object: sharing an object doesn't
+ * allocate, and an IntrusivePtr is the size of a raw pointer. A raw pointer
+ * to a shared object can also be turned back into an IntrusivePtr, as the
+ * count travels with the object.
+ *
+ * T provides add_ref() and release(), usually by deriving from
+ * RefCounted<T>.
+ *
+ * @code
+ * struct Buffer : mbed::RefCounted<Buffer> {
+ *     uint8_t data[256];
+ * };
+ *
+ * mbed::IntrusivePtr<Buffer> buf = mbed::make_intrusive<Buffer>();
+ * mbed::IntrusivePtr<Buffer> buf2 = buf;   // no allocation
+ * @endcode
+ */
+template <class T>
+class IntrusivePtr {
+public:
+    /** Create an empty IntrusivePtr
+     */
+    constexpr IntrusivePtr() : _ptr()
+    {
+    }
+
+    /** Create an empty IntrusivePtr
+     */
+    constexpr IntrusivePtr(std::nullptr_t) : _ptr()
+    {
+    }
+
+    /** Create an IntrusivePtr taking a reference to an object
+     *
+     * @param ptr Object to refer to, may be null
+     */
+    IntrusivePtr(T *ptr) : _ptr(ptr)
+    {
+        if (_ptr) {
+            _ptr->add_ref();
+        }
+    }
+
+    /** Copy constructor, taking another reference
+     *
+     * @param source Object being copied from
+     */
+    IntrusivePtr(const IntrusivePtr &source) : IntrusivePtr(source._ptr)
+    {
+    }
+
+    /** Conversion from a pointer to a derived class
+     *
+     * @param source Object being copied from
+     */
+    template <class U>
+    IntrusivePtr(const IntrusivePtr<U> &source) : IntrusivePtr(source.get())
+    {
+    }
+
+    /** Move constructor, taking over the reference of source
+     *
+     * @param source Object being moved from, left empty
+     */
+    IntrusivePtr(IntrusivePtr &&source) : _ptr(source._ptr)
+    {
+        source._ptr = nullptr;
+    }
+
+    /** Destructor, releasing the reference
+     */
+    ~IntrusivePtr()
+    {
+        if (_ptr) {
+            _ptr->release();
+        }
+    }
+
+    /** Copy assignment operator
+     *
+     * @param source Object being assigned from
+     * @return This object
+     */
+    IntrusivePtr &operator=(const IntrusivePtr &source)
+    {
+        IntrusivePtr(source).swap(*this);
+        return *this;
+    }
+
+    /** Move assignment operator
+     *
+     * @param source Object being moved from, left empty
+     * @return This object
+     */
+    IntrusivePtr &operator=(IntrusivePtr &&source)
+    {
+        IntrusivePtr(std::move(source)).swap(*this);
+        return *this;
+    }
+
+    /** Assign a raw pointer, taking a reference to it
+     *
+     * @param ptr Object to refer to, may be null
+     * @return This object
+     */
+    IntrusivePtr &operator=(T *ptr)
+    {
+        IntrusivePtr(ptr).swap(*this);
+        return *this;
+    }
+
+    /** Release the reference, leaving the pointer empty
+     */
+    void reset()
+    {
+        IntrusivePtr().swap(*this);
+    }
+
+    /** Refer to another object
+     *
+     * @param ptr Object to refer to, may be null
+     */
+    void reset(T *ptr)
+    {
+        IntrusivePtr(ptr).swap(*this);
+    }
+
+    /** Exchange the objects of two pointers
+     *
+     * @param other Pointer to exchange with
+     */
+    void swap(IntrusivePtr &other)
+    {
+        T *tmp = _ptr;
+        _ptr = other._ptr;
+        other._ptr = tmp;
+    }
+
+    /** Give up the reference without releasing it
+     *
+     * @return Object referred to, whose reference the caller now holds
+     */
+    T *detach()
+    {
+        T *ptr = _ptr;
+        _ptr = nullptr;
+        return ptr;
+    }
+
+    /** Raw pointer accessor
+     *
+     * @return Object referred to
+     */
+    T *get() const
+    {
+        return _ptr;
+    }
+
+    /** Reference count accessor
+     *
+     * @return Reference count of the object, 0 if empty
+     */
+    uint32_t use_count() const
+    {
+        return _ptr ? _ptr->use_count() : 0;
+    }
+
+    /** Dereference object operator
+     */
+    T &operator*() const
+    {
+        return *_ptr;
+    }
+
+    /** Dereference object member operator
+     */
+    T *operator->() const
+    {
+        return _ptr;
+    }
+
+    /** Boolean conversion operator
+     *
+     * @return Whether or not the pointer is null
+     */
+    explicit operator bool() const
+    {
+        return _ptr != nullptr;
+    }
+
+private:
+    T *_ptr;
+};
+
+/** Allocate an object with new and refer to it
+ *
+ * @param args Arguments of the constructor of T
+ * @return Pointer to the new object, empty if the allocation failed
+ */
+template <class T, typename... Args>
+IntrusivePtr<T> make_intrusive(Args &&... args)
+{
+    return IntrusivePtr<T>(new (std::nothrow) T(std::forward<Args>(args)...));
+}
+
+template <class T, class U>
+bool operator==(const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return lhs.get() == rhs.get();
+}
+
+template <class T, class U>
+bool operator!=(const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return lhs.get() != rhs.get();
+}
+
+template <class T>
+bool operator==(const IntrusivePtr<T> &lhs, std::nullptr_t)
+{
+    return lhs.get() == nullptr;
+}
+
+template <class T>
+bool operator!=(const IntrusivePtr<T> &lhs, std::nullptr_t)
+{
+    return lhs.get() != nullptr;
+}
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::IntrusivePtr;
+using mbed::RefCounted;
+#endif
+
+#endif // MBED_INTRUSIVEPTR_H
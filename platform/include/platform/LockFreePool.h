@@ -0,0 +1,205 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_LOCKFREEPOOL_H
+#define MBED_LOCKFREEPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_LockFreePool LockFreePool class
+ * @{
+ */
+
+/** Lock-free pool of fixed size memory blocks
+ *
+ * A drop-in for rtos::MemoryPool where blocks are allocated or freed from
+ * interrupt handlers: the free blocks form a stack whose top is swapped
+ * with a single compare and swap, so neither the interrupts are disabled
+ * nor the call is deferred to the RTOS kernel as osMemoryPoolAlloc does
+ * from an interrupt.
+ *
+ * The top of the stack packs the index of the first free block with a
+ * counter incremented on every change. A thread preempted in try_alloc()
+ * after reading the top would otherwise take it back with a stale next
+ * block, had the interrupt allocated that block and freed the first one
+ * in the meantime (the ABA problem).
+ *
+ * The pool doesn't construct or destroy objects, see ObjectPool.
+ *
+ * @code
+ * mbed::LockFreePool<Buffer, 8> buffers;
+ *
+ * void dma_complete()
+ * {
+ *     Buffer *buf = buffers.try_alloc();
+ *     if (buf) {
+ *         // ... fill and hand over to a thread, which frees it
+ *     }
+ * }
+ * @endcode
+ *
+ * @note Synchronization level: Interrupt safe
+ * @note The pool holds fewer than 65535 blocks
+ */
+template <typename T, uint32_t pool_sz>
+class LockFreePool : private NonCopyable<LockFreePool<T, pool_sz> > {
+    MBED_STATIC_ASSERT(pool_sz > 0 && pool_sz < 0xFFFF, "Invalid LockFreePool size");
+
+public:
+    LockFreePool()
+    {
+        for (uint32_t i = 0; i < pool_sz - 1; i++) {
+            _blocks[i].next = i + 1;
+        }
+        _blocks[pool_sz - 1].next = NONE;
+        _top = 0;
+    }
+
+    /** Destroy the pool
+     *
+     * @note Blocks still allocated become invalid
+     */
+    ~LockFreePool() = default;
+
+    /** Allocate a memory block, without blocking
+     *
+     * @return Memory block, nullptr if the pool is exhausted
+     */
+    T *try_alloc()
+    {
+        uint32_t top = core_util_atomic_load_explicit(&_top, mbed_memory_order_acquire);
+        uint32_t index;
+        do {
+            index = top & INDEX_MASK;
+            if (index == NONE) {
+                return nullptr;
+            }
+            // If another context took the block meanwhile, next may be stale
+            // but the counter of the top has changed and the swap fails
+            uint32_t next = _blocks[index].next;
+            if (core_util_atomic_cas_u32(&_top, &top, tagged(top, next))) {
+                break;
+            }
+        } while (true);
+        return reinterpret_cast<T *>(_blocks[index].storage);
+    }
+
+    /** Allocate a memory block set to zero, without blocking
+     *
+     * @return Memory block, nullptr if the pool is exhausted
+     */
+    T *try_calloc()
+    {
+        T *block = try_alloc();
+        if (block) {
+            memset(block, 0, sizeof(T));
+        }
+        return block;
+    }
+
+    /** Give a memory block back to the pool
+     *
+     * @param block Block allocated from this pool, or nullptr
+     */
+    void free(T *block)
+    {
+        if (!block) {
+            return;
+        }
+        MBED_ASSERT(owns(block));
+        uint32_t index = reinterpret_cast<block_t *>(block) - _blocks;
+
+        uint32_t top = core_util_atomic_load_explicit(&_top, mbed_memory_order_relaxed);
+        do {
+            _blocks[index].next = top & INDEX_MASK;
+        } while (!core_util_atomic_cas_u32(&_top, &top, tagged(top, index)));
+    }
+
+    /** Check if a memory block belongs to the pool
+     *
+     * @param block Memory block
+     * @return True if block points to a block of the pool
+     */
+    bool owns(const T *block) const
+    {
+        const char *p = reinterpret_cast<const char *>(block);
+        const char *begin = reinterpret_cast<const char *>(&_blocks[0]);
+        const char *end = reinterpret_cast<const char *>(&_blocks[pool_sz]);
+        return p >= begin && p < end && (p - begin) % sizeof(block_t) == 0;
+    }
+
+    /** Check if all the blocks are allocated
+     *
+     * It may be outdated by the time it's used.
+     *
+     * @return True if try_alloc() would fail
+     */
+    bool empty() const
+    {
+        return (core_util_atomic_load_explicit(&_top, mbed_memory_order_relaxed) & INDEX_MASK) == NONE;
+    }
+
+    /** Number of blocks the pool holds
+     *
+     * @return pool_sz
+     */
+    static constexpr uint32_t capacity()
+    {
+        return pool_sz;
+    }
+
+private:
+    static constexpr uint32_t INDEX_MASK = 0xFFFF;
+    static constexpr uint32_t NONE = 0xFFFF;
+
+    /* New top holding index, with the counter of the current one incremented */
+    static uint32_t tagged(uint32_t top, uint32_t index)
+    {
+        return ((top & ~INDEX_MASK) + (INDEX_MASK + 1)) | index;
+    }
+
+    union block_t {
+        alignas(T) char storage[sizeof(T)];
+        uint32_t next;
+    };
+
+    block_t _blocks[pool_sz];
+    // Counter in the upper 16 bits, index of the first free block in the lower ones
+    volatile uint32_t _top;
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::LockFreePool;
+#endif
+
+#endif // MBED_LOCKFREEPOOL_H
@@ -0,0 +1,326 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_LOCKFREEQUEUE_H
+#define MBED_LOCKFREEQUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_LockFreeQueue LockFreeQueue functions
+ * @{
+ */
+
+/** Lock-free queue of one producer and one consumer
+ *
+ * Unlike CircularBuffer, the queue doesn't disable the interrupts: the
+ * producer only writes the head index and the consumer only writes the tail
+ * index, so an interrupt handler can push while a thread pops, or the
+ * other way round. The bulk operations copy as many elements as fit in one
+ * go and publish them with a single index update.
+ *
+ * The queue doesn't overwrite the oldest elements when it's full, push fails
+ * instead.
+ *
+ * @note Synchronization level: One producer and one consumer, interrupt safe
+ * @note BufferSize must be a power of two
+ */
+template<typename T, uint32_t BufferSize>
+class SPSCQueue : private NonCopyable<SPSCQueue<T, BufferSize> > {
+    MBED_STATIC_ASSERT(BufferSize != 0 && (BufferSize & (BufferSize - 1)) == 0, "BufferSize must be a power of two");
+
+public:
+    SPSCQueue() : _head(0), _tail(0)
+    {
+    }
+
+    /** Push an element to the queue, from the producer
+     *
+     * @param data Element to be pushed
+     * @return True if the element was pushed, false if the queue is full
+     */
+    bool push(const T &data)
+    {
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_relaxed);
+        uint32_t tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        if (head - tail == BufferSize) {
+            return false;
+        }
+        _pool[head & (BufferSize - 1)] = data;
+        core_util_atomic_store_explicit(&_head, head + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Push elements to the queue, from the producer
+     *
+     * @param data Elements to be pushed
+     * @return Number of elements pushed, less than data.size() if the queue is full
+     */
+    uint32_t push(Span<const T> data)
+    {
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_relaxed);
+        uint32_t tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        uint32_t count = BufferSize - (head - tail);
+        if (count > data.size()) {
+            count = data.size();
+        }
+        uint32_t index = head & (BufferSize - 1);
+        uint32_t first = (count < BufferSize - index) ? count : BufferSize - index;
+        for (uint32_t i = 0; i < first; i++) {
+            _pool[index + i] = data[i];
+        }
+        for (uint32_t i = first; i < count; i++) {
+            _pool[i - first] = data[i];
+        }
+        core_util_atomic_store_explicit(&_head, head + count, mbed_memory_order_release);
+        return count;
+    }
+
+    /** Pop an element from the queue, from the consumer
+     *
+     * @param data Element popped
+     * @return True if an element was popped, false if the queue is empty
+     */
+    bool pop(T &data)
+    {
+        uint32_t tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        data = _pool[tail & (BufferSize - 1)];
+        core_util_atomic_store_explicit(&_tail, tail + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Pop elements from the queue, from the consumer
+     *
+     * @param data Buffer for the elements popped
+     * @return Number of elements popped, less than data.size() if the queue had fewer elements
+     */
+    uint32_t pop(Span<T> data)
+    {
+        uint32_t tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        uint32_t count = head - tail;
+        if (count > data.size()) {
+            count = data.size();
+        }
+        uint32_t index = tail & (BufferSize - 1);
+        uint32_t first = (count < BufferSize - index) ? count : BufferSize - index;
+        for (uint32_t i = 0; i < first; i++) {
+            data[i] = _pool[index + i];
+        }
+        for (uint32_t i = first; i < count; i++) {
+            data[i] = _pool[i - first];
+        }
+        core_util_atomic_store_explicit(&_tail, tail + count, mbed_memory_order_release);
+        return count;
+    }
+
+    /** Get the number of elements in the queue
+     *
+     * The value is exact when called from the producer or the consumer and
+     * the other side is idle, otherwise it may be outdated by the time it's used.
+     */
+    uint32_t size() const
+    {
+        uint32_t tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        return head - tail;
+    }
+
+    /** Check if the queue is empty
+     *
+     * @return True if the queue is empty, false if not
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check if the queue is full
+     *
+     * @return True if the queue is full, false if not
+     */
+    bool full() const
+    {
+        return size() == BufferSize;
+    }
+
+    /** Empty the queue, from the consumer
+     */
+    void reset()
+    {
+        core_util_atomic_store_explicit(&_tail, core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire), mbed_memory_order_release);
+    }
+
+private:
+    T _pool[BufferSize];
+    // Free running counters, the difference is the number of elements
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+/** Lock-free queue of several producers and one consumer
+ *
+ * The producers, threads or interrupt handlers, claim slots by a compare and
+ * swap of the head index, and each slot has a sequence number telling the
+ * consumer when its element is written. A producer interrupted between
+ * claiming a slot and filling it never blocks the others: their elements
+ * just stay unavailable to the consumer until the interrupted one is done.
+ *
+ * The sequence numbers take 4 extra bytes per element.
+ *
+ * @note Synchronization level: Several producers and one consumer, interrupt safe
+ * @note BufferSize must be a power of two
+ */
+template<typename T, uint32_t BufferSize>
+class MPSCQueue : private NonCopyable<MPSCQueue<T, BufferSize> > {
+    MBED_STATIC_ASSERT(BufferSize != 0 && (BufferSize & (BufferSize - 1)) == 0, "BufferSize must be a power of two");
+
+public:
+    MPSCQueue() : _head(0), _tail(0)
+    {
+        for (uint32_t i = 0; i < BufferSize; i++) {
+            _slots[i].sequence = i;
+        }
+    }
+
+    /** Push an element to the queue, from any producer
+     *
+     * @param data Element to be pushed
+     * @return True if the element was pushed, false if the queue is full
+     */
+    bool push(const T &data)
+    {
+        return push(Span<const T>(&data, 1)) == 1;
+    }
+
+    /** Push elements to the queue, from any producer
+     *
+     * The elements are pushed contiguously, they are not interleaved with
+     * the elements of the other producers.
+     *
+     * @param data Elements to be pushed
+     * @return Number of elements pushed, less than data.size() if the queue is full
+     */
+    uint32_t push(Span<const T> data)
+    {
+        uint32_t head = core_util_atomic_load_explicit(&_head, mbed_memory_order_relaxed);
+        uint32_t count;
+        do {
+            // The consumer frees the slots in order, so the first ones are free
+            // if the last one is
+            count = data.size() < BufferSize ? data.size() : BufferSize;
+            while (count > 0) {
+                uint32_t sequence = core_util_atomic_load_explicit(&_slots[(head + count - 1) & (BufferSize - 1)].sequence, mbed_memory_order_acquire);
+                if (sequence == head + count - 1) {
+                    break;
+                }
+                count--;
+            }
+            if (count == 0) {
+                return 0;
+            }
+        } while (!core_util_atomic_cas_u32(&_head, &head, head + count));
+
+        for (uint32_t i = 0; i < count; i++) {
+            Slot &slot = _slots[(head + i) & (BufferSize - 1)];
+            slot.data = data[i];
+            core_util_atomic_store_explicit(&slot.sequence, head + i + 1, mbed_memory_order_release);
+        }
+        return count;
+    }
+
+    /** Pop an element from the queue, from the consumer
+     *
+     * @param data Element popped
+     * @return True if an element was popped, false if the queue is empty
+     */
+    bool pop(T &data)
+    {
+        return pop(Span<T>(&data, 1)) == 1;
+    }
+
+    /** Pop elements from the queue, from the consumer
+     *
+     * @param data Buffer for the elements popped
+     * @return Number of elements popped, less than data.size() if fewer elements are available
+     */
+    uint32_t pop(Span<T> data)
+    {
+        uint32_t tail = _tail;
+        uint32_t count = 0;
+        while (count < (uint32_t)data.size()) {
+            Slot &slot = _slots[tail & (BufferSize - 1)];
+            if (core_util_atomic_load_explicit(&slot.sequence, mbed_memory_order_acquire) != tail + 1) {
+                break;
+            }
+            data[count++] = slot.data;
+            core_util_atomic_store_explicit(&slot.sequence, tail + BufferSize, mbed_memory_order_release);
+            tail++;
+        }
+        _tail = tail;
+        return count;
+    }
+
+    /** Check if the queue has no element available to the consumer
+     *
+     * @return True if the queue is empty, false if not
+     */
+    bool empty() const
+    {
+        return core_util_atomic_load_explicit(&_slots[_tail & (BufferSize - 1)].sequence, mbed_memory_order_acquire) != _tail + 1;
+    }
+
+    /** Get the number of elements pushed or being pushed and not popped yet
+     *
+     * It may be outdated by the time it's used.
+     */
+    uint32_t size() const
+    {
+        return core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire) - _tail;
+    }
+
+private:
+    struct Slot {
+        volatile uint32_t sequence;
+        T data;
+    };
+
+    Slot _slots[BufferSize];
+    volatile uint32_t _head;
+    // Only used by the consumer
+    uint32_t _tail;
+};
+
+/**@}*/
+
+/**@}*/
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_OBJECTPOOL_H
+#define MBED_OBJECTPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_ObjectPool ObjectPool class
+ * @{
+ */
+
+/** Fixed number of objects constructed in static storage
+ *
+ * The storage of the N objects is part of the pool, so a pool declared
+ * at namespace scope takes no heap, and construct and destroy take
+ * constant time. Free objects are kept in a list, updated with the
+ * interrupts disabled for a few instructions only, so objects can be
+ * constructed and destroyed from interrupts.
+ *
+ * Combined with RefCounted, objects shared through IntrusivePtr are
+ * neither allocated nor carry a separate counter, see IntrusivePtr.h.
+ *
+ * @code
+ * mbed::ObjectPool<Message, 4> messages;
+ *
+ * Message *msg = messages.construct(id, payload);
+ * if (msg) {
+ *     // ...
+ *     messages.destroy(msg);
+ * }
+ * @endcode
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+template <typename T, uint32_t N>
+class ObjectPool : private NonCopyable<ObjectPool<T, N> > {
+    static_assert(N > 0, "ObjectPool must hold at least one object");
+
+public:
+    ObjectPool() : _free(&_slots[0]), _available(N)
+    {
+        for (uint32_t i = 0; i < N - 1; i++) {
+            _slots[i].next = &_slots[i + 1];
+        }
+        _slots[N - 1].next = nullptr;
+    }
+
+    /** Destroy the pool
+     *
+     * @note Objects still constructed are not destroyed
+     */
+    ~ObjectPool() = default;
+
+    /** Construct an object in the pool
+     *
+     * @param args Arguments of the constructor of T
+     * @return Object constructed, NULL if the pool is exhausted
+     */
+    template <typename... Args>
+    T *construct(Args &&... args)
+    {
+        core_util_critical_section_enter();
+        slot_t *slot = _free;
+        if (slot) {
+            _free = slot->next;
+            _available--;
+        }
+        core_util_critical_section_exit();
+
+        if (!slot) {
+            return nullptr;
+        }
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /** Destroy an object of the pool and give its storage back
+     *
+     * @param obj Object constructed by this pool, or NULL
+     */
+    void destroy(T *obj)
+    {
+        if (!obj) {
+            return;
+        }
+        MBED_ASSERT(owns(obj));
+        obj->~T();
+
+        slot_t *slot = reinterpret_cast<slot_t *>(obj);
+        core_util_critical_section_enter();
+        slot->next = _free;
+        _free = slot;
+        _available++;
+        core_util_critical_section_exit();
+    }
+
+    /** Check if an object is stored in the pool
+     *
+     * @param obj Object
+     * @return True if obj points to a slot of the pool
+     */
+    bool owns(const T *obj) const
+    {
+        const char *p = reinterpret_cast<const char *>(obj);
+        const char *begin = reinterpret_cast<const char *>(&_slots[0]);
+        const char *end = reinterpret_cast<const char *>(&_slots[N]);
+        return p >= begin && p < end && (p - begin) % sizeof(slot_t) == 0;
+    }
+
+    /** Number of objects that can still be constructed
+     *
+     * @return Free slots
+     */
+    uint32_t available() const
+    {
+        return _available;
+    }
+
+    /** Number of objects the pool holds
+     *
+     * @return N
+     */
+    static constexpr uint32_t capacity()
+    {
+        return N;
+    }
+
+private:
+    union slot_t {
+        alignas(T) char storage[sizeof(T)];
+        slot_t *next;
+    };
+
+    slot_t _slots[N];
+    slot_t *_free;
+    volatile uint32_t _available;
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::ObjectPool;
+#endif
+
+#endif // MBED_OBJECTPOOL_H
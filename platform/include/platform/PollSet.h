@@ -0,0 +1,168 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_POLLSET_H
+#define MBED_POLLSET_H
+
+#include <stdint.h>
+#include "platform/mbed_poll.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+class PollSetBase;
+
+namespace internal {
+/* A poll() call or a PollSet, woken by poll_notify() */
+struct poll_waiter {
+    poll_waiter *next;
+    uint32_t flag;          // Event flag of the waiter, 0 if none was free
+    bool waiting;           // Blocked, the flag has to be set on a notification
+    pollfh *fhs;            // File handles of a poll() call
+    unsigned nfhs;
+    PollSetBase *set;       // Or of a PollSet
+};
+}
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_PollSet PollSet class
+ * @{
+ */
+
+/** Base class of PollSet, independent of the capacity
+ */
+class PollSetBase : private NonCopyable<PollSetBase> {
+public:
+    /** File handle of a set and its state */
+    struct entry {
+        FileHandle *fh;
+        short events;
+        short revents;      // Events of the last poll, kept while the file handle has not notified a change
+        bool notifies;      // FileHandle::poll_notifies()
+        bool pending;       // Notified since the last poll
+    };
+
+    /** Watch a file handle.
+     *
+     * @param fh     The file handle
+     * @param events The events watched, POLLIN and POLLOUT. POLLERR, POLLHUP and POLLNVAL are always watched
+     * @return 0 on success, -EINVAL if fh is NULL, -EEXIST if it is already in the set, -ENOMEM if the set is full
+     */
+    int add(FileHandle *fh, short events);
+
+    /** Change the events watched of a file handle.
+     *
+     * @param fh     The file handle
+     * @param events The events watched
+     * @return 0 on success, -ENOENT if the file handle is not in the set
+     */
+    int modify(FileHandle *fh, short events);
+
+    /** Stop watching a file handle.
+     *
+     * @param fh     The file handle
+     * @return 0 on success, -ENOENT if the file handle is not in the set
+     */
+    int remove(FileHandle *fh);
+
+    /** Number of file handles watched.
+     *
+     * @return the number of file handles in the set
+     */
+    unsigned size() const
+    {
+        return _count;
+    }
+
+    /** Wait for file handles of the set to be ready.
+     *
+     * The events are level triggered, like in poll(): a ready file handle is returned by each wait
+     * until it is no longer ready. When more than max file handles are ready, the next wait starts
+     * after the last one returned, so that every file handle is served.
+     *
+     * @param ready   Array filled with the ready file handles, their events watched and their events
+     * @param max     Size of the array
+     * @param timeout Time to wait for in milliseconds, 0 to return immediately, -1 to wait forever
+     * @return the number of ready file handles, 0 on timeout, -EINVAL if max is 0
+     */
+    int wait(pollfh ready[], unsigned max, int timeout);
+
+protected:
+    PollSetBase(entry *entries, unsigned capacity);
+    ~PollSetBase();
+
+private:
+    friend void poll_notify(const FileHandle *fh);
+
+    bool mark_pending(const FileHandle *fh);
+    entry *find(const FileHandle *fh);
+
+    entry *_entries;
+    unsigned _capacity;
+    unsigned _count;
+    unsigned _next;
+    internal::poll_waiter _waiter;
+};
+
+/** Set of file handles watched together, a scalable alternative to poll().
+ *
+ * The file handles are added once, instead of being passed to each call. Between the waits,
+ * a file handle notifying its changes (see FileHandle::poll_notifies()) is only polled again
+ * once it notified a change or while it is ready, so a wait over many idle file handles does
+ * not poll each of them. The other file handles are polled on each wait, and every millisecond
+ * while waiting.
+ *
+ * Example:
+ * @code
+ * PollSet<8> set;
+ * set.add(&serial, POLLIN);
+ * set.add(&mux_channel, POLLIN);
+ *
+ * pollfh ready[4];
+ * while (true) {
+ *     int n = set.wait(ready, 4, -1);
+ *     for (int i = 0; i < n; i++) {
+ *         handle(ready[i].fh, ready[i].revents);
+ *     }
+ * }
+ * @endcode
+ *
+ * @note Synchronization level: Not protected. A PollSet is used by one thread, the file handles
+ *       may notify from any thread or interrupt.
+ *
+ * @tparam Capacity Maximum number of file handles watched
+ */
+template <unsigned Capacity>
+class PollSet : public PollSetBase {
+public:
+    PollSet() : PollSetBase(_storage, Capacity)
+    {
+    }
+
+private:
+    entry _storage[Capacity];
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif // MBED_POLLSET_H
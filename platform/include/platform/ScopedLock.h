@@ -80,6 +80,46 @@ private:
     Lockable &_lockable;
 };
 
+/** RAII-style mechanism for owning a shared lock of SharedLockable object for the duration of a scoped block
+ *
+ * @tparam SharedLockable The type implementing the shared part of the SharedLockable concept
+ *
+ * @note For type SharedLockable, the following conditions have to be satisfied:
+ *        - has public member function @a lock_shared which blocks until a shared lock can be obtained for the current execution context
+ *        - has public member function @a unlock_shared which releases the shared lock
+ *
+ * Usage:
+ *
+ * Example with rtos::SharedMutex
+ *
+ * @code
+ * void foo(SharedMutex &m) {
+ *     ScopedSharedLock<SharedMutex> lock(m);
+ *     // Other readers may run this block concurrently, no writer can
+ * }
+ * @endcode
+ */
+template <typename SharedLockable>
+class ScopedSharedLock : private NonCopyable<ScopedSharedLock<SharedLockable> > {
+public:
+    /** Locks given lockable object for shared access
+     *
+     * @param lockable reference to the instance of SharedLockable object
+     * @note lockable object should outlive the ScopedSharedLock object
+     */
+    ScopedSharedLock(SharedLockable &lockable): _lockable(lockable)
+    {
+        _lockable.lock_shared();
+    }
+
+    ~ScopedSharedLock()
+    {
+        _lockable.unlock_shared();
+    }
+private:
+    SharedLockable &_lockable;
+};
+
 /**@}*/
 
 /**@}*/
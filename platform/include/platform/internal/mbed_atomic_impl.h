@@ -74,6 +74,17 @@ extern "C" {
 
 
 
+#if MBED_EXCLUSIVE_ACCESS
+/* The lock-free operations are a few instructions around LDREX/STREX, no
+ * more than the call sequence, so they are forced inline like the explicit
+ * forms: a plain inline definition leaves the compiler free to call the
+ * out-of-line definition instead, as it often does when optimising for size.
+ */
+#define MBED_INLINE_LOCKFREE MBED_FORCEINLINE
+#else
+#define MBED_INLINE_LOCKFREE inline
+#endif
+
 #if MBED_EXCLUSIVE_ACCESS
 
 /* This header file provides C inline definitions for atomic functions. */
@@ -341,7 +352,8 @@ extern "C" {
  * an operation.
  */
 #define DO_MBED_LOCKFREE_EXCHG_OP(T, fn_suffix, M)                              \
-inline T core_util_atomic_exchange_##fn_suffix(volatile T *valuePtr, T newValue) \
+MBED_INLINE_LOCKFREE T core_util_atomic_exchange_##fn_suffix(                   \
+        volatile T *valuePtr, T newValue)                                       \
 {                                                                               \
     T oldValue;                                                                 \
     uint32_t fail;                                                              \
@@ -363,7 +375,7 @@ MBED_FORCEINLINE T core_util_atomic_exchange_explicit_##fn_suffix(
 }
 
 #define DO_MBED_LOCKFREE_CAS_WEAK_OP(T, fn_suffix, M)                           \
-inline bool core_util_atomic_compare_exchange_weak_##fn_suffix(volatile T *ptr, T *expectedCurrentValue, T desiredValue) \
+MBED_INLINE_LOCKFREE bool core_util_atomic_compare_exchange_weak_##fn_suffix(volatile T *ptr, T *expectedCurrentValue, T desiredValue) \
 {                                                                               \
     MBED_BARRIER();                                                             \
     T oldValue;                                                                 \
@@ -391,7 +403,7 @@ MBED_FORCEINLINE bool core_util_atomic_compare_exchange_weak_explicit_##fn_suffi
 }
 
 #define DO_MBED_LOCKFREE_CAS_STRONG_OP(T, fn_suffix, M)                         \
-inline bool core_util_atomic_cas_##fn_suffix(volatile T *ptr, T *expectedCurrentValue, T desiredValue) \
+MBED_INLINE_LOCKFREE bool core_util_atomic_cas_##fn_suffix(volatile T *ptr, T *expectedCurrentValue, T desiredValue) \
 {                                                                               \
     MBED_BARRIER();                                                             \
     T oldValue;                                                                 \
@@ -420,7 +432,8 @@ MBED_FORCEINLINE bool core_util_atomic_cas_explicit_##fn_suffix(volatile T *ptr,
 
 
 #define DO_MBED_LOCKFREE_NEWVAL_2OP(name, OP, Constants, T, fn_suffix, M)       \
-inline T core_util_atomic_##name##_##fn_suffix(volatile T *valuePtr, T arg)     \
+MBED_INLINE_LOCKFREE T core_util_atomic_##name##_##fn_suffix(                   \
+        volatile T *valuePtr, T arg)                                            \
 {                                                                               \
     uint32_t fail, newValue;                                                    \
     MBED_BARRIER();                                                             \
@@ -444,7 +457,8 @@ MBED_FORCEINLINE T core_util_atomic_##name##_explicit_##fn_suffix(
 }                                                                               \
 
 #define DO_MBED_LOCKFREE_OLDVAL_2OP(name, OP, Constants, T, fn_suffix, M)       \
-inline T core_util_atomic_##name##_##fn_suffix(volatile T *valuePtr, T arg)     \
+MBED_INLINE_LOCKFREE T core_util_atomic_##name##_##fn_suffix(                   \
+        volatile T *valuePtr, T arg)                                            \
 {                                                                               \
     T oldValue;                                                                 \
     uint32_t fail, newValue;                                                    \
@@ -470,7 +484,8 @@ MBED_FORCEINLINE T core_util_atomic_##name##_explicit_##fn_suffix(
 }                                                                               \
 
 #define DO_MBED_LOCKFREE_OLDVAL_3OP(name, OP, Constants, T, fn_suffix, M)       \
-inline T core_util_atomic_##name##_##fn_suffix(volatile T *valuePtr, T arg) {   \
+MBED_INLINE_LOCKFREE T core_util_atomic_##name##_##fn_suffix(                   \
+        volatile T *valuePtr, T arg) {                                          \
     T oldValue;                                                                 \
     uint32_t fail, newValue;                                                    \
     MBED_BARRIER();                                                             \
@@ -494,7 +509,7 @@ MBED_FORCEINLINE T core_util_atomic_##name##_explicit_##fn_suffix(
     return oldValue;                                                            \
 }                                                                               \
 
-inline bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *valuePtr)
+MBED_INLINE_LOCKFREE bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *valuePtr)
 {
     MBED_BARRIER();
     bool oldValue, newValue = true;
@@ -775,7 +790,7 @@ MBED_FORCEINLINE bool core_util_atomic_cas_explicit_bool(volatile bool *ptr, boo
     return core_util_atomic_cas_explicit_u8((volatile uint8_t *)ptr, (uint8_t *)expectedCurrentValue, desiredValue, success, failure);
 }
 
-inline bool core_util_atomic_cas_ptr(void *volatile *ptr, void **expectedCurrentValue, void *desiredValue)
+MBED_INLINE_LOCKFREE bool core_util_atomic_cas_ptr(void *volatile *ptr, void **expectedCurrentValue, void *desiredValue)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
     return core_util_atomic_cas_u32(
@@ -893,7 +908,7 @@ MBED_FORCEINLINE bool core_util_atomic_exchange_explicit_bool(volatile bool *val
     return (bool)core_util_atomic_exchange_explicit_u8((volatile uint8_t *)valuePtr, desiredValue, order);
 }
 
-inline void *core_util_atomic_exchange_ptr(void *volatile *valuePtr, void *desiredValue)
+MBED_INLINE_LOCKFREE void *core_util_atomic_exchange_ptr(void *volatile *valuePtr, void *desiredValue)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
     return (void *)core_util_atomic_exchange_u32((volatile uint32_t *)valuePtr, (uint32_t)desiredValue);
@@ -911,7 +926,7 @@ MBED_FORCEINLINE void *core_util_atomic_exchange_explicit_ptr(void *volatile *va
 #endif
 }
 
-inline void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
+MBED_INLINE_LOCKFREE void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
     return (void *)core_util_atomic_incr_u32((volatile uint32_t *)valuePtr, (uint32_t)delta);
@@ -920,7 +935,7 @@ inline void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta
 #endif
 }
 
-inline void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
+MBED_INLINE_LOCKFREE void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
     return (void *)core_util_atomic_decr_u32((volatile uint32_t *)valuePtr, (uint32_t)delta);
@@ -1346,6 +1361,7 @@ DO_MBED_ATOMIC_PRE_OP_TEMPLATES(xor_fetch, fetch_xor, ^ arg)
 #undef MBED_ACQUIRE_BARRIER
 #undef MBED_RELEASE_BARRIER
 #undef MBED_SEQ_CST_BARRIER
+#undef MBED_INLINE_LOCKFREE
 #undef DO_MBED_ATOMIC_LOAD_TEMPLATE
 #undef DO_MBED_ATOMIC_STORE_TEMPLATE
 #undef DO_MBED_ATOMIC_EXCHANGE_TEMPLATE
@@ -0,0 +1,145 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TLSF_H
+#define MBED_TLSF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \ingroup mbed-os-internal */
+/** \addtogroup platform-internal-api */
+/** @{*/
+
+/*
+ * Two-Level Segregated Fit allocator, used in place of the toolchain malloc
+ * when platform.tlsf-heap-enabled is set.
+ *
+ * Free blocks are kept in lists indexed by size class: the first level is the
+ * power of two of the size, the second level splits it in MBED_TLSF_SL_COUNT
+ * ranges. Two bitmaps tell which lists are not empty, so allocation and
+ * release take a bounded time whatever the state of the heap, and a block
+ * is always taken from a class that fits, which limits fragmentation.
+ *
+ * The functions are not thread safe, the caller serializes the calls.
+ */
+
+#define MBED_TLSF_ALIGN_SHIFT   3
+#define MBED_TLSF_ALIGN         (1 << MBED_TLSF_ALIGN_SHIFT)
+#define MBED_TLSF_SL_SHIFT      4
+#define MBED_TLSF_SL_COUNT      (1 << MBED_TLSF_SL_SHIFT)
+#define MBED_TLSF_FL_MAX        20
+#define MBED_TLSF_FL_SHIFT      (MBED_TLSF_SL_SHIFT + MBED_TLSF_ALIGN_SHIFT)
+#define MBED_TLSF_FL_COUNT      (MBED_TLSF_FL_MAX - MBED_TLSF_FL_SHIFT + 1)
+
+struct mbed_tlsf_block;
+
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[MBED_TLSF_FL_COUNT];
+    struct mbed_tlsf_block *blocks[MBED_TLSF_FL_COUNT][MBED_TLSF_SL_COUNT];
+} mbed_tlsf_t;
+
+/*
+ * Initializes an empty allocator
+ *
+ * @param  tlsf                 allocator
+ */
+void mbed_tlsf_init(mbed_tlsf_t *tlsf);
+
+/*
+ * Gives a memory area to the allocator
+ *
+ * Areas larger than 2^MBED_TLSF_FL_MAX bytes are managed as several blocks.
+ *
+ * @param  tlsf                 allocator
+ * @param  mem                  start of the area
+ * @param  size                 size of the area in bytes
+ * @return                      bytes available for allocations, including the block headers,
+ *                              0 if the area is too small
+ */
+size_t mbed_tlsf_add_pool(mbed_tlsf_t *tlsf, void *mem, size_t size);
+
+/*
+ * Allocates memory aligned on MBED_TLSF_ALIGN bytes
+ *
+ * @param  tlsf                 allocator
+ * @param  size                 size in bytes
+ * @return                      allocated memory, NULL if there is no free block large enough
+ */
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size);
+
+/*
+ * Allocates aligned memory
+ *
+ * @param  tlsf                 allocator
+ * @param  alignment            alignment in bytes, a power of two
+ * @param  size                 size in bytes
+ * @return                      allocated memory, NULL if there is no free block large enough
+ */
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t alignment, size_t size);
+
+/*
+ * Resizes an allocation, in place when the block or its free neighbour is large enough
+ *
+ * @param  tlsf                 allocator
+ * @param  ptr                  allocated memory or NULL
+ * @param  size                 new size in bytes, 0 frees the memory
+ * @return                      resized memory, NULL on failure in which case ptr is left allocated
+ */
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size);
+
+/*
+ * Releases memory
+ *
+ * @param  tlsf                 allocator
+ * @param  ptr                  allocated memory or NULL
+ */
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr);
+
+/*
+ * Gets the size of the block holding an allocation
+ *
+ * @param  ptr                  allocated memory
+ * @return                      size of the block, including its header
+ */
+size_t mbed_tlsf_block_total_size(const void *ptr);
+
+typedef struct {
+    size_t free_size;                   // bytes in the free blocks, headers excluded
+    size_t largest_free;                // payload of the largest free block
+    size_t free_blocks;                 // number of free blocks
+} mbed_tlsf_free_info_t;
+
+/*
+ * Walks the free lists, in a time proportional to the number of free blocks
+ *
+ * @param  tlsf                 allocator
+ * @param  info                 filled with the free space of the allocator
+ */
+void mbed_tlsf_free_info(const mbed_tlsf_t *tlsf, mbed_tlsf_free_info_t *info);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ARENA_H
+#define MBED_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_arena Arena allocator
+ *
+ * Region allocator for the transient allocations of a subsystem.
+ *
+ * Allocations are taken in sequence from a buffer given by the owner and,
+ * when it is full, from chunks allocated on the heap. Individual allocations
+ * are not freed, the whole arena is released at once by mbed_arena_reset(),
+ * so a burst of allocations, such as those of a TLS handshake, doesn't
+ * fragment the heap.
+ *
+ * An arena is not thread safe, it is meant to be used by one thread or under
+ * the lock of the subsystem that owns it.
+ *
+ * When heap statistics are enabled, the arenas are reported by
+ * mbed_stats_arena_get_each().
+ * @{
+ */
+
+/** Alignment of the allocations from an arena */
+#define MBED_ARENA_ALIGN    8
+
+typedef struct mbed_arena_chunk mbed_arena_chunk_t;
+
+/**
+ * struct mbed_arena_t definition, its fields are private
+ */
+typedef struct mbed_arena {
+    const char *name;
+    uint8_t *buffer;                /* Buffer given by the owner */
+    size_t buffer_size;
+    size_t chunk_size;              /* Size of the heap chunks, 0 for no heap chunks */
+    mbed_arena_chunk_t *chunks;     /* Heap chunks, the current one first */
+    uint8_t *ptr;                   /* Free space in the current buffer or chunk */
+    uint8_t *end;
+    uint8_t *last;                  /* Last allocation, which can be given back */
+    uint32_t current_size;
+    uint32_t max_size;
+    uint32_t reserved_size;
+    uint32_t alloc_cnt;
+    uint32_t alloc_fail_cnt;
+    struct mbed_arena *next;        /* Arenas reported in the statistics */
+} mbed_arena_t;
+
+/**
+ *  Initialize an arena
+ *
+ *  @param arena        Arena to initialize
+ *  @param name         Name reported in the statistics, can be NULL
+ *  @param buffer       Buffer used first for the allocations, can be NULL
+ *  @param size         Size of buffer in bytes
+ *  @param chunk_size   Size of the chunks allocated on the heap once buffer is full,
+ *                      0 if the arena only uses buffer. Larger allocations get a chunk of their own.
+ */
+void mbed_arena_init(mbed_arena_t *arena, const char *name, void *buffer, size_t size, size_t chunk_size);
+
+/**
+ *  Release the memory of an arena and stop reporting it in the statistics
+ *
+ *  @param arena        Arena to deinitialize
+ */
+void mbed_arena_deinit(mbed_arena_t *arena);
+
+/**
+ *  Allocate memory from an arena
+ *
+ *  @param arena        Arena to allocate from
+ *  @param size         Size in bytes
+ *  @return             Memory aligned on MBED_ARENA_ALIGN bytes, NULL if the arena is full
+ *                      and no heap chunk can be allocated
+ */
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size);
+
+/**
+ *  Allocate zero-initialized memory from an arena
+ *
+ *  @param arena        Arena to allocate from
+ *  @param nmemb        Number of elements
+ *  @param size         Size of an element in bytes
+ *  @return             Memory aligned on MBED_ARENA_ALIGN bytes, NULL on failure
+ */
+void *mbed_arena_calloc(mbed_arena_t *arena, size_t nmemb, size_t size);
+
+/**
+ *  Give back memory allocated from an arena
+ *
+ *  The space is only reused when ptr is the last allocation of the arena,
+ *  otherwise it stays allocated until mbed_arena_reset().
+ *
+ *  @param arena        Arena ptr was allocated from
+ *  @param ptr          Allocated memory, can be NULL
+ */
+void mbed_arena_free(mbed_arena_t *arena, void *ptr);
+
+/**
+ *  Release all the allocations of an arena and its heap chunks
+ *
+ *  @param arena        Arena to reset
+ */
+void mbed_arena_reset(mbed_arena_t *arena);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CLOCK_SCALING_H
+#define MBED_CLOCK_SCALING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_clock_scaling Clock scaling functions
+ *
+ * Switch the core clock at runtime, for example to run crypto bursts at the
+ * highest frequency and idle sensing at a low one, in a lower voltage range.
+ * The drivers whose prescalers derive from the core clock, such as
+ * SerialBase, SPI, I2C and PwmOut, register a notifier and apply their
+ * configuration again after each change, the us ticker keeps its rate.
+ *
+ * Example:
+ * @code
+ * uint32_t frequencies[4];
+ * uint8_t count = mbed_clock_get_frequencies(frequencies, 4);
+ *
+ * // Lowest frequency while waiting for the sensor
+ * mbed_clock_set_frequency(frequencies[count - 1]);
+ * ...
+ * // Back to the boot frequency
+ * mbed_clock_set_frequency(frequencies[0]);
+ * @endcode
+ *
+ * @note Peripheral transfers in progress during the change are corrupted.
+ * @{
+ */
+
+/** Clock change notifier
+ *
+ * Owned by the caller of mbed_clock_notifier_add(), until it is removed.
+ */
+typedef struct mbed_clock_notifier {
+    /** Called after each change of the core clock, with interrupts disabled */
+    void (*handler)(void *context, uint32_t frequency_hz);
+    /** Passed to handler */
+    void *context;
+    /** Used by the notifier list */
+    struct mbed_clock_notifier *next;
+} mbed_clock_notifier_t;
+
+/** Register a clock change notifier
+ *
+ * The notifiers are called in the order they are added.
+ *
+ * @param notifier  Notifier, with handler and context set
+ */
+void mbed_clock_notifier_add(mbed_clock_notifier_t *notifier);
+
+/** Unregister a clock change notifier
+ *
+ * @param notifier  Notifier added, or not
+ */
+void mbed_clock_notifier_remove(mbed_clock_notifier_t *notifier);
+
+/** Get the core clock frequencies supported
+ *
+ * The first one is the boot frequency, the others are in decreasing order.
+ * Targets without DEVICE_CLOCK_SCALING only support the boot frequency.
+ *
+ * @param frequencies   Filled with up to size frequencies in Hz
+ * @param size          Size of frequencies
+ * @return              Number of frequencies supported
+ */
+uint8_t mbed_clock_get_frequencies(uint32_t *frequencies, uint8_t size);
+
+/** Switch the core clock, then call the notifiers
+ *
+ * The switch and the notifiers run in a critical section.
+ *
+ * @param frequency_hz  One of the frequencies of mbed_clock_get_frequencies()
+ * @return              0 on success, -1 if the frequency isn't supported
+ */
+int mbed_clock_set_frequency(uint32_t frequency_hz);
+
+/** Get the core clock frequency
+ *
+ * @return  The core clock frequency in Hz
+ */
+uint32_t mbed_clock_get_frequency(void);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
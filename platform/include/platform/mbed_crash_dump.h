@@ -0,0 +1,145 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRASH_DUMP_H
+#define MBED_CRASH_DUMP_H
+
+#include <stdint.h>
+#include "platform/mbed_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_crash_dump Crash dump functions
+ *
+ * Binary crash dump written to a reserved flash area on fatal errors.
+ *
+ * With platform.crash-dump-enabled, mbed_error() writes the registers, the
+ * stacks and control blocks of the threads, and the RAM window set by
+ * platform.crash-dump-ram-start and platform.crash-dump-ram-size to the flash
+ * area set by platform.crash-dump-address and platform.crash-dump-size,
+ * before printing the error report and rebooting. After the reboot, the
+ * application reads the dump with mbed_crash_dump_read() to upload it, and
+ * tools/debug_tools/crash_dump opens it in GDB.
+ *
+ * The dump is a header slot of MBED_CRASH_DUMP_HEADER_SIZE bytes, holding a
+ * mbed_crash_dump_header_t, followed by records: a mbed_crash_dump_record_t
+ * and its data. The header is programmed last, so an interrupted dump is
+ * never valid. When the area is full the remaining records are cut and
+ * MBED_CRASH_DUMP_FLAG_TRUNCATED is set; the current stack comes first.
+ * @{
+ */
+
+#define MBED_CRASH_DUMP_MAGIC           0x4443424D  /**< "MBCD" */
+#define MBED_CRASH_DUMP_VERSION         1
+#define MBED_CRASH_DUMP_HEADER_SIZE     256         /**< Size of the header slot, the records follow */
+#define MBED_CRASH_DUMP_REG_COUNT       21          /**< R0-R12, SP, LR, PC, xPSR, PSP, MSP, EXC_RETURN, CONTROL */
+
+#define MBED_CRASH_DUMP_FLAG_TRUNCATED  0x0001      /**< Records were left out, the flash area was full */
+#define MBED_CRASH_DUMP_FLAG_FAULT      0x0002      /**< The registers are the ones of a fault exception */
+
+#define MBED_CRASH_DUMP_RECORD_MEMORY   1           /**< Data is a copy of the memory at address */
+#define MBED_CRASH_DUMP_RECORD_THREAD   2           /**< Data is a mbed_crash_dump_thread_t, address is the thread ID */
+
+/**
+ * Header of a crash dump
+ */
+typedef struct {
+    uint32_t magic;                             /**< MBED_CRASH_DUMP_MAGIC */
+    uint16_t version;                           /**< MBED_CRASH_DUMP_VERSION */
+    uint16_t flags;                             /**< MBED_CRASH_DUMP_FLAG_* */
+    uint32_t size;                              /**< Size in bytes of the records */
+    uint32_t crc;                               /**< CRC-32 (as zlib) of the records */
+    mbed_error_status_t error_status;           /**< Error status given to mbed_error() */
+    uint32_t error_value;                       /**< Error value given to mbed_error() */
+    uint32_t error_address;                     /**< Address of the caller of mbed_error(), or of the fault */
+    uint32_t thread_id;                         /**< ID of the current thread, 0 without RTOS */
+    uint32_t regs[MBED_CRASH_DUMP_REG_COUNT];   /**< Registers, in the order of mbed_fault_context_t */
+} mbed_crash_dump_header_t;
+
+/**
+ * Header of a crash dump record, followed by size bytes of data
+ */
+typedef struct {
+    uint32_t type;                              /**< MBED_CRASH_DUMP_RECORD_* */
+    uint32_t address;                           /**< Memory address or thread ID */
+    uint32_t size;                              /**< Size in bytes of the data, a multiple of 4 */
+} mbed_crash_dump_record_t;
+
+/**
+ * Data of a MBED_CRASH_DUMP_RECORD_THREAD record
+ */
+typedef struct {
+    uint32_t sp;                                /**< Stack pointer, live for the current thread */
+    uint32_t stack_mem;                         /**< Start of the stack */
+    uint32_t stack_size;                        /**< Size of the stack */
+    uint32_t entry;                             /**< Entry function */
+    uint8_t state;                              /**< RTX state */
+    uint8_t stack_frame;                        /**< RTX stack frame, EXC_RETURN[7..0] */
+    int8_t priority;                            /**< Priority */
+    uint8_t is_current;                         /**< 1 for the current thread */
+    char name[16];                              /**< Name, truncated and not always null-terminated */
+} mbed_crash_dump_thread_t;
+
+/**
+ * Write a crash dump of the current state
+ *
+ * Called by mbed_error() on fatal errors, it can also be called from an
+ * error hook. It erases the previous dump. Interrupts must be disabled.
+ *
+ * @param ctx   Error context, as given to mbed_error_hook()
+ * @return      MBED_SUCCESS, or an error if the dump isn't enabled or couldn't be written
+ */
+mbed_error_status_t mbed_crash_dump_save(const mbed_error_ctx *ctx);
+
+/**
+ * Get the size of the crash dump stored in flash
+ *
+ * @return      Size in bytes of the dump, header slot included, 0 if there is no valid dump
+ */
+uint32_t mbed_crash_dump_get_size(void);
+
+/**
+ * Read the crash dump stored in flash
+ *
+ * @param offset    Offset in the dump, 0 for the header
+ * @param buffer    Buffer for the data
+ * @param size      Number of bytes to read
+ * @return          MBED_SUCCESS, or an error if the dump isn't enabled or the read is out of the area
+ */
+mbed_error_status_t mbed_crash_dump_read(uint32_t offset, void *buffer, uint32_t size);
+
+/**
+ * Erase the crash dump stored in flash, once uploaded
+ *
+ * @return      MBED_SUCCESS, or an error if the dump isn't enabled or the erase failed
+ */
+mbed_error_status_t mbed_crash_dump_erase(void);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
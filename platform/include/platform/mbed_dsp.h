@@ -0,0 +1,139 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_DSP_H
+#define MBED_DSP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_dsp dsp functions
+ *
+ * Fixed point signal processing of q15 samples, in place.
+ *
+ * The samples are signed 16-bit fractions, as in CMSIS-DSP, and the functions
+ * follow its conventions for the coefficient order and the scaling, so that
+ * blocks can be handed to its functions as well. On cores with the DSP extension,
+ * such as the Cortex-M4, the inner loops use the SIMD instructions operating on
+ * two samples at once.
+ *
+ * @{
+ */
+
+/**
+ * struct mbed_dsp_fir_decimate_q15_t definition
+ */
+typedef struct {
+    const int16_t *coeffs;  /**< Coefficients, in time reversed order */
+    int16_t *state;         /**< taps - 1 + max_block samples */
+    uint16_t taps;          /**< Number of coefficients */
+    uint16_t factor;        /**< Decimation factor, 1 to only filter */
+    uint32_t max_block;     /**< Largest block processed */
+} mbed_dsp_fir_decimate_q15_t;
+
+/**
+ * Convert right aligned ADC samples to q15, in place.
+ *
+ * The middle of the ADC range becomes 0.
+ *
+ * @param src   ADC samples
+ * @param dst   q15 samples, may be src
+ * @param count Number of samples
+ * @param bits  Width of the ADC samples, from 1 to 16
+ */
+void mbed_dsp_adc_to_q15(const uint16_t *src, int16_t *dst, size_t count, uint8_t bits);
+
+/**
+ * Initialize a FIR filter followed by a decimation.
+ *
+ * As with arm_fir_decimate_init_q15(), the coefficients are stored in time
+ * reversed order: coeffs[taps - 1] applies to the newest sample.
+ *
+ * @param fir       Filter to initialize
+ * @param coeffs    taps coefficients, kept by the filter
+ * @param taps      Number of coefficients
+ * @param factor    Decimation factor, the filter outputs one sample for factor input samples
+ * @param state     Buffer of taps - 1 + max_block samples, kept by the filter
+ * @param max_block Largest number of samples given to mbed_dsp_fir_decimate_q15()
+ */
+void mbed_dsp_fir_decimate_q15_init(mbed_dsp_fir_decimate_q15_t *fir, const int16_t *coeffs, uint16_t taps,
+                                    uint16_t factor, int16_t *state, uint32_t max_block);
+
+/**
+ * Filter and decimate a block of samples.
+ *
+ * The filter keeps the last taps - 1 samples for the next block. Accumulation is
+ * on 64 bits, the outputs are saturated.
+ *
+ * @param fir   Filter
+ * @param src   Input samples
+ * @param dst   Output samples, may be src
+ * @param count Number of input samples, a multiple of the factor up to max_block
+ * @return      Number of output samples, count / factor
+ */
+size_t mbed_dsp_fir_decimate_q15(mbed_dsp_fir_decimate_q15_t *fir, const int16_t *src, int16_t *dst, size_t count);
+
+/**
+ * Compute the twiddle factors of mbed_dsp_rfft_q15().
+ *
+ * @param twiddles Buffer of n samples
+ * @param n        Size of the transform, a power of 2 from 4 to 4096
+ */
+void mbed_dsp_rfft_q15_init(int16_t *twiddles, size_t n);
+
+/**
+ * Fast Fourier transform of real samples, in place.
+ *
+ * The spectrum is packed in the n samples: data[0] is the DC bin and data[1] the
+ * Nyquist bin, both real, then data[2k] and data[2k + 1] are the real and imaginary
+ * parts of bin k, for k from 1 to n / 2 - 1. Each stage halves its results so that
+ * they can't overflow: the bins are the DFT divided by n.
+ *
+ * @param data     n samples, replaced by the spectrum
+ * @param n        Size of the transform, a power of 2 from 4 to 4096
+ * @param twiddles Twiddle factors computed by mbed_dsp_rfft_q15_init() for n
+ */
+void mbed_dsp_rfft_q15(int16_t *data, size_t n, const int16_t *twiddles);
+
+/**
+ * Replace a spectrum computed by mbed_dsp_rfft_q15() with the magnitudes of its bins.
+ *
+ * data[k] becomes the magnitude of bin k, for k from 0 to n / 2 - 1. The Nyquist
+ * bin is dropped.
+ *
+ * @param data Spectrum of n samples
+ * @param n    Size of the transform
+ */
+void mbed_dsp_rfft_mag_q15(int16_t *data, size_t n);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_DSP_H
@@ -0,0 +1,331 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_FORMAT_H
+#define MBED_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_format Compiled format strings
+ *
+ * Format strings parsed at compile time for the minimal-printf engine.
+ *
+ * MBED_FORMAT() turns a format string literal into a compact program of
+ * opcodes, evaluated by the compiler and stored in flash. The printing
+ * functions below run the program without parsing the format again, which
+ * suits the fixed formats used in hot paths:
+ *
+ * @code
+ * mbed_printf_compiled(MBED_FORMAT("rx %u bytes from %s\n"), len, name);
+ * @endcode
+ *
+ * Only the conversions supported by minimal-printf are accepted: %d %i %u %x
+ * %X %c %s %p, %f %F %g %G when floating point is enabled and the ll length
+ * modifier when 64-bit integers are enabled. Any other conversion fails to
+ * compile instead of being printed as is. As with minimal-printf, the flags,
+ * the width and the precision of numbers are ignored.
+ * @{
+ */
+
+#if !TARGET_LIKE_MBED
+/* Linux implementation is for debug only */
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 1
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+/* Opcodes of a compiled format. A conversion is its conversion character
+ * ('d', 'u', 'x', 'X', 'f', 'c', 's' or 'p'), followed by the length modifier
+ * and the precision.
+ */
+#define MBED_FORMAT_OP_END              0x00    /**< End of the program */
+#define MBED_FORMAT_OP_TEXT             0x01    /**< Followed by a length of 1 to 255 and the characters */
+#define MBED_FORMAT_OP_SKIP             0x02    /**< Discard an int argument, a '*' width */
+
+/* Length modifiers, the low nibble is the number of characters */
+#define MBED_FORMAT_LENGTH_NONE         0x00
+#define MBED_FORMAT_LENGTH_H            0x11
+#define MBED_FORMAT_LENGTH_L            0x21
+#define MBED_FORMAT_LENGTH_J            0x31
+#define MBED_FORMAT_LENGTH_Z            0x41
+#define MBED_FORMAT_LENGTH_T            0x51
+#define MBED_FORMAT_LENGTH_CAPITAL_L    0x61
+#define MBED_FORMAT_LENGTH_HH           0x72
+#define MBED_FORMAT_LENGTH_LL           0x82
+
+#define MBED_FORMAT_PRECISION_DEFAULT   0xFF    /**< No precision given */
+#define MBED_FORMAT_PRECISION_ARG       0xFE    /**< '*' precision, read from an int argument */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Print a compiled format to stdout
+ *
+ * @param program   Compiled format, from MBED_FORMAT()
+ * @return          Number of characters written, or a negative value on error
+ */
+int mbed_printf_compiled(const uint8_t *program, ...);
+
+/**
+ * Print a compiled format to a stream
+ *
+ * @param stream    Stream to write to
+ * @param program   Compiled format, from MBED_FORMAT()
+ * @return          Number of characters written, or a negative value on error
+ */
+int mbed_fprintf_compiled(FILE *stream, const uint8_t *program, ...);
+
+/**
+ * Print a compiled format to a buffer
+ *
+ * @param buffer    Buffer to write to, always null-terminated when length is not 0
+ * @param length    Size of buffer in bytes
+ * @param program   Compiled format, from MBED_FORMAT()
+ * @return          Number of characters the whole output takes, not counting the terminator
+ */
+int mbed_snprintf_compiled(char *buffer, size_t length, const uint8_t *program, ...);
+
+/**
+ * Print a compiled format to a buffer, with a va_list
+ *
+ * @param buffer    Buffer to write to, always null-terminated when length is not 0
+ * @param length    Size of buffer in bytes
+ * @param program   Compiled format, from MBED_FORMAT()
+ * @param arguments Arguments of the format
+ * @return          Number of characters the whole output takes, not counting the terminator
+ */
+int mbed_vsnprintf_compiled(char *buffer, size_t length, const uint8_t *program, va_list arguments);
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+namespace impl {
+
+/* Not defined: reaching it while compiling a format makes the constant
+ * evaluation fail, the name tells why in the compiler error.
+ */
+void mbed_format_unsupported_conversion();
+void mbed_format_precision_too_large();
+
+struct FormatSize {
+    size_t size = 0;
+
+    constexpr void put(uint8_t)
+    {
+        size++;
+    }
+
+    constexpr void patch(size_t, uint8_t)
+    {
+    }
+};
+
+template <size_t N>
+struct CompiledFormat {
+    uint8_t program[N] = {};
+    size_t size = 0;
+
+    constexpr void put(uint8_t op)
+    {
+        program[size++] = op;
+    }
+
+    constexpr void patch(size_t pos, uint8_t op)
+    {
+        program[pos] = op;
+    }
+};
+
+/* Same parsing as mbed_minimal_formatted_string */
+template <typename Out>
+constexpr void compile_format(const char *format, Out &out)
+{
+    size_t text_pos = 0;
+    uint8_t text_len = 0;
+
+    for (size_t index = 0; format[index] != '\0'; index++) {
+        char literal = format[index];
+
+        if (format[index] == '%' && format[index + 1] != '%') {
+            size_t next_index = index + 1;
+
+            if (format[next_index] == '-' || format[next_index] == '+' || format[next_index] == ' ' ||
+                    format[next_index] == '#' || format[next_index] == '0') {
+                next_index++;
+            }
+
+            if (format[next_index] == '*') {
+                next_index++;
+                out.put(MBED_FORMAT_OP_SKIP);
+                text_len = 0;
+            } else {
+                while (format[next_index] >= '0' && format[next_index] <= '9') {
+                    next_index++;
+                }
+            }
+
+            unsigned precision = MBED_FORMAT_PRECISION_DEFAULT;
+            if (format[next_index] == '.' && format[next_index + 1] == '*') {
+                next_index += 2;
+                precision = MBED_FORMAT_PRECISION_ARG;
+            } else if (format[next_index] == '.') {
+                next_index++;
+                precision = 0;
+                while (format[next_index] >= '0' && format[next_index] <= '9') {
+                    precision = precision * 10 + (format[next_index] - '0');
+                    if (precision >= MBED_FORMAT_PRECISION_ARG) {
+                        mbed_format_precision_too_large();
+                    }
+                    next_index++;
+                }
+            }
+
+            uint8_t length = MBED_FORMAT_LENGTH_NONE;
+            if (format[next_index] == 'h' && format[next_index + 1] == 'h') {
+                length = MBED_FORMAT_LENGTH_HH;
+            } else if (format[next_index] == 'l' && format[next_index + 1] == 'l') {
+                length = MBED_FORMAT_LENGTH_LL;
+            } else if (format[next_index] == 'h') {
+                length = MBED_FORMAT_LENGTH_H;
+            } else if (format[next_index] == 'l') {
+                length = MBED_FORMAT_LENGTH_L;
+            } else if (format[next_index] == 'j') {
+                length = MBED_FORMAT_LENGTH_J;
+            } else if (format[next_index] == 'z') {
+                length = MBED_FORMAT_LENGTH_Z;
+            } else if (format[next_index] == 't') {
+                length = MBED_FORMAT_LENGTH_T;
+            } else if (format[next_index] == 'L') {
+                length = MBED_FORMAT_LENGTH_CAPITAL_L;
+            }
+            next_index += (length & 0x0F);
+
+            char conversion = format[next_index];
+            switch (conversion) {
+                case 'i':
+                    conversion = 'd';
+                    break;
+                case 'd':
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'c':
+                case 's':
+                case 'p':
+                    break;
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+                case 'F':
+                case 'g':
+                case 'G':
+                case 'f':
+                    conversion = 'f';
+                    break;
+#endif
+                default:
+                    mbed_format_unsupported_conversion();
+                    break;
+            }
+#if !MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+            if (length == MBED_FORMAT_LENGTH_LL) {
+                mbed_format_unsupported_conversion();
+            }
+#endif
+
+            out.put(conversion);
+            out.put(length);
+            out.put(precision);
+            text_len = 0;
+            index = next_index;
+            continue;
+        }
+
+        if (format[index] == '%') {
+            // "%%"
+            index++;
+        }
+        if (text_len == 0 || text_len == 255) {
+            out.put(MBED_FORMAT_OP_TEXT);
+            text_pos = out.size;
+            out.put(0);
+            text_len = 0;
+        }
+        out.put(literal);
+        out.patch(text_pos, ++text_len);
+    }
+    out.put(MBED_FORMAT_OP_END);
+}
+
+constexpr size_t compiled_format_size(const char *format)
+{
+    FormatSize out;
+    compile_format(format, out);
+    return out.size;
+}
+
+template <size_t N>
+constexpr CompiledFormat<N> compile_format(const char *format)
+{
+    CompiledFormat<N> out;
+    compile_format(format, out);
+    return out;
+}
+
+} // namespace impl
+} // namespace mbed
+
+/**
+ * Compile a format string literal into a program for the compiled printing functions
+ *
+ * @param fmt   Format string literal
+ * @return      Pointer to the compiled format, a constant stored in flash
+ */
+#define MBED_FORMAT(fmt) \
+    ([]() -> const uint8_t * { \
+        static constexpr size_t size = ::mbed::impl::compiled_format_size(fmt); \
+        static constexpr ::mbed::impl::CompiledFormat<size> compiled = ::mbed::impl::compile_format<size>(fmt); \
+        return compiled.program; \
+    }())
+
+#endif // __cplusplus
+
+/** @}*/
+
+/** @}*/
+
+#endif
@@ -162,6 +162,64 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/**
+ * Binary record of a memory operation, as stored by 'mbed_mem_trace_ring_callback'.
+ *
+ * The fields are in the target byte order, little-endian on Cortex-M.
+ * tools/debug_tools/mem_trace_decoder decodes a stream of these records.
+ */
+typedef struct {
+    uint32_t timestamp;     /**< us ticker value at the time of the operation */
+    uint16_t seq;           /**< Sequence number, a gap tells that records were dropped */
+    uint8_t op;             /**< MBED_MEM_TRACE_MALLOC, _REALLOC, _CALLOC or _FREE */
+    uint8_t reserved;       /**< Always 0 */
+    uint32_t res;           /**< Result of the operation, 0 for 'free' */
+    uint32_t caller;        /**< Caller of the operation */
+    uint32_t arg1;          /**< 'size' for malloc, 'ptr' for realloc and free, 'nmemb' for calloc */
+    uint32_t arg2;          /**< 'size' for realloc and calloc, 0 otherwise */
+} mbed_mem_trace_record_t;
+
+/**
+ * Set the ring buffer used by 'mbed_mem_trace_ring_callback', and empty it.
+ *
+ * Call it before setting the callback.
+ *
+ * @param buffer    records of the ring buffer.
+ * @param count     number of records, a power of two.
+ */
+void mbed_mem_trace_ring_init(mbed_mem_trace_record_t *buffer, size_t count);
+
+/**
+ * Binary memory trace callback. DO NOT CALL DIRECTLY. It is meant to be used
+ * as the argument of 'mbed_mem_trace_set_callback'.
+ *
+ * Instead of formatting the operation, the callback stores a
+ * 'mbed_mem_trace_record_t' in the ring buffer, so the timing of the traced
+ * code is barely changed. A thread of the application drains the ring with
+ * 'mbed_mem_trace_ring_read' and sends the records to the host, for example
+ * over SWO with SerialWireOutput. When the ring is full, the records are dropped.
+ */
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Take records out of the ring buffer.
+ *
+ * It can be called from another thread than the traced ones, while the
+ * tracing goes on.
+ *
+ * @param records   where to copy the records.
+ * @param count     maximum number of records to copy.
+ * @return          number of records copied.
+ */
+size_t mbed_mem_trace_ring_read(mbed_mem_trace_record_t *records, size_t count);
+
+/**
+ * Get the number of records dropped because the ring buffer was full.
+ *
+ * @return          records dropped since 'mbed_mem_trace_ring_init'.
+ */
+uint32_t mbed_mem_trace_ring_dropped(void);
+
 /** @}*/
 
 #ifdef __cplusplus
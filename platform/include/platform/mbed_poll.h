@@ -45,6 +45,11 @@ struct pollfh {
  * For every file handle provided, poll() examines it for any events registered for that particular
  * file handle.
  *
+ * While nothing is selected, the call blocks until one of the file handles notifies a change
+ * with poll_notify(). When one of them does not notify its changes, see FileHandle::poll_notifies(),
+ * the file handles are examined again every millisecond. To watch many file handles, PollSet
+ * avoids examining all of them on each call.
+ *
  * @param fhs     an array of PollFh struct carrying a FileHandle and bitmasks of events
  * @param nfhs    number of file handles
  * @param timeout timer value to timeout or -1 for loop forever
@@ -53,6 +58,19 @@ struct pollfh {
  */
 int poll(pollfh fhs[], unsigned nfhs, int timeout);
 
+/** Wake the poll() calls and the PollSet waits watching a file handle.
+ *
+ * FileHandle implementations returning true from FileHandle::poll_notifies() call it each time
+ * the events their poll() returns may have changed, next to their sigio() callback. poll()
+ * then blocks until a notification or the timeout, instead of polling the file handles
+ * every millisecond.
+ *
+ * This function can be called from an interrupt.
+ *
+ * @param fh the file handle whose events may have changed
+ */
+void poll_notify(const FileHandle *fh);
+
 /**@}*/
 
 /**@}*/
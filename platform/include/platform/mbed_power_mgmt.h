@@ -171,6 +171,25 @@ bool sleep_manager_can_deep_sleep_test_check(void);
  */
 void sleep_manager_sleep_auto(void);
 
+/** Enter the deepest sleep depth worth its exit latency before a deadline
+ *
+ * With platform.idle-governor-enabled, the idle loop calls it instead of
+ * sleep_manager_sleep_auto(). Of the depths of hal_sleep_get_depths() allowed
+ * by the deep sleep lock, it picks the deepest whose exit latency fits before
+ * the deadline, and whose minimum residency fits in the predicted idle time.
+ * The prediction is the time to the deadline, scaled by how much earlier than
+ * their deadlines the previous sleeps were woken up. The exit latencies are
+ * also measured, from sleeps woken up past their deadline.
+ *
+ * Without the governor or an LP ticker to measure the sleeps, same as
+ * sleep_manager_sleep_auto().
+ *
+ * This function is IRQ and thread safe
+ *
+ * @param idle_us   Time in microseconds to the next timer deadline, UINT32_MAX if none
+ */
+void sleep_manager_sleep_governed(uint32_t idle_us);
+
 /** Send the microcontroller to sleep
  *
  * @note This function can be a noop if not implemented by the platform.
@@ -0,0 +1,182 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_profiler profiler functions
+ *
+ * Statistical profiler, sampling the program counter of the interrupted code.
+ *
+ * A periodic timer interrupt at the lowest priority records the address of the
+ * instruction it interrupted in a hash table of platform.profiler-entries addresses.
+ * mbed_profiler_dump() prints the table for tools/debug_tools/profiler_decoder, which
+ * names the functions from the ELF file and sums their samples. The time spent in the
+ * other interrupt handlers is attributed to the code they interrupted, as the
+ * sampling interrupt is pending while they run.
+ *
+ * The timer is provided by the target, through mbed_profiler_timer_start(),
+ * mbed_profiler_timer_clear() and mbed_profiler_timer_stop(). Without a target
+ * timer, the samples can be fed from another periodic interrupt with mbed_profiler_sample(),
+ * or taken by the DWT unit and sent over SWO with mbed_profiler_itm_start().
+ *
+ * @{
+ */
+
+/* Prefix of the lines printed by mbed_profiler_dump() */
+#define MBED_PROFILER_PREFIX "#p:"
+
+/**
+ * struct mbed_profiler_entry_t definition
+ */
+typedef struct {
+    uint32_t pc;        /**< Address of the sampled instruction */
+    uint32_t count;     /**< Number of samples at the address */
+} mbed_profiler_entry_t;
+
+/**
+ * struct mbed_profiler_stats_t definition
+ */
+typedef struct {
+    uint32_t samples;   /**< Samples taken since the last reset */
+    uint32_t dropped;   /**< Samples at new addresses not recorded because the table was full */
+    uint32_t entries;   /**< Addresses recorded */
+    uint32_t period_us; /**< Sampling period of the running profiler, 0 when stopped */
+} mbed_profiler_stats_t;
+
+/**
+ * Start sampling.
+ *
+ * The table of samples is kept, call mbed_profiler_reset() to clear it.
+ *
+ * @param period_us Sampling period in microseconds. A prime period avoids
+ *                  sampling in lock step with periodic activities.
+ * @return 0 on success, -1 if the profiler is disabled, already running or if the
+ *         target has no sampling timer
+ */
+int mbed_profiler_start(uint32_t period_us);
+
+/**
+ * Stop sampling. The table of samples is kept.
+ */
+void mbed_profiler_stop(void);
+
+/**
+ * Clear the table of samples and the statistics.
+ */
+void mbed_profiler_reset(void);
+
+/**
+ * Record a sample.
+ *
+ * Called from the sampling interrupt. This function can also be called from
+ * another periodic interrupt handler, with the program counter stacked on its entry.
+ *
+ * @param pc Address of the interrupted instruction
+ */
+void mbed_profiler_sample(uint32_t pc);
+
+/**
+ * Fill the passed in structure with the statistics of the profiler.
+ *
+ * @param stats A pointer to the mbed_profiler_stats_t structure to fill
+ */
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats);
+
+/**
+ * Fill the passed array with the recorded addresses and their sample counts.
+ *
+ * The entries are not sorted.
+ *
+ * @param entries A pointer to an array of mbed_profiler_entry_t structures to fill
+ * @param count   The number of mbed_profiler_entry_t structures in the provided array
+ * @return        The number of mbed_profiler_entry_t structures that have been filled.
+ *                If the number of addresses is less than or equal to count, it will equal the number of addresses.
+ *                If the number of addresses is greater than count, it will equal count.
+ */
+size_t mbed_profiler_get_each(mbed_profiler_entry_t *entries, size_t count);
+
+/**
+ * Print the statistics and the table of samples, one line per address.
+ *
+ * The lines are "#p:<samples>;<dropped>;<period us>" followed by "#p:<pc>;<count>"
+ * for each address, with the addresses in hexadecimal. Sampling goes on during the
+ * dump.
+ *
+ * @param stream The stream to print to, for example one opened with mbed::fdopen() on a
+ *               SerialWireOutput, or NULL for stdout
+ */
+void mbed_profiler_dump(FILE *stream);
+
+/**
+ * Start the sampling of the program counter by the DWT unit, sent over SWO.
+ *
+ * The samples are not recorded in the table: the host tool aggregates the DWT
+ * PC sample packets of the SWO capture. The DWT unit samples every 16384 cycles,
+ * as set by mbed_itm_init(). Available when the target supports ITM.
+ *
+ * @return 0 on success, -1 if the target has no ITM or no DWT PC sampling
+ */
+int mbed_profiler_itm_start(void);
+
+/**
+ * Stop the sampling started by mbed_profiler_itm_start().
+ */
+void mbed_profiler_itm_stop(void);
+
+/**
+ * Target hook starting a periodic interrupt for the profiler.
+ *
+ * The default implementation has no timer and returns -1.
+ *
+ * @param period_us Period of the interrupt in microseconds
+ * @return the IRQ number of the interrupt, which the profiler sets the vector and the priority of
+ *         and enables, or -1 if the target has no timer for the profiler or can't run it at that period
+ */
+int mbed_profiler_timer_start(uint32_t period_us);
+
+/**
+ * Target hook clearing the interrupt of the profiler timer, called on each sample.
+ */
+void mbed_profiler_timer_clear(void);
+
+/**
+ * Target hook stopping the profiler timer, after the profiler disabled its interrupt.
+ */
+void mbed_profiler_timer_stop(void);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_PROFILER_H
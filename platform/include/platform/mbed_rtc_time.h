@@ -40,6 +40,19 @@ struct timeval {
 };
 #endif
 
+/* clock_gettime() is provided with the GCC_ARM C library types */
+#if defined(__GNUC__) && !defined(__clang__)
+#define MBED_RTC_TIME_CLOCK_GETTIME 1
+#ifndef CLOCK_REALTIME
+#define CLOCK_REALTIME  ((clockid_t)1)
+#endif
+#ifndef CLOCK_MONOTONIC
+#define CLOCK_MONOTONIC ((clockid_t)4)
+#endif
+#else
+#define MBED_RTC_TIME_CLOCK_GETTIME 0
+#endif
+
 /** Implementation of the C time.h functions
  *
  * Provides mechanisms to set and read the current time, based
@@ -104,8 +117,12 @@ void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init
 
 /** Standard lib retarget, get time since Epoch
  *
- * @param tv    Structure containing time_t seconds and useconds_t microseconds. Due to
- *              separate target specific RTC implementations only the seconds component is used.
+ * The microseconds are set on targets with RTC_SUBSECOND and LPTICKER, where the
+ * RTC is read once per platform.rtc-time-resync-period and the low power ticker
+ * elapsed since is added, and on targets emulating the RTC with the low power
+ * ticker. Otherwise, and with an RTC attached by attach_rtc(), they are 0.
+ *
+ * @param tv    Structure containing time_t seconds and useconds_t microseconds.
  * @param tz    DEPRECATED IN THE STANDARD: This parameter is left in for legacy code. It is
  *              not used.
  * @return      0 on success, -1 on a failure.
@@ -114,6 +131,20 @@ void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init
  */
 int gettimeofday(struct timeval *tv, void *tz);
 
+#if MBED_RTC_TIME_CLOCK_GETTIME || defined(DOXYGEN_ONLY)
+/** Standard lib retarget, get the time of a clock
+ *
+ * CLOCK_REALTIME is the time of gettimeofday(). CLOCK_MONOTONIC is the low power
+ * ticker, or the microsecond ticker on targets without one, since boot.
+ *
+ * @param clock_id  CLOCK_REALTIME or CLOCK_MONOTONIC
+ * @param tp        Set to the time of the clock
+ * @return          0 on success, -1 with errno set to EINVAL for other clocks.
+ * @note Synchronization level: Thread safe
+ */
+int clock_gettime(clockid_t clock_id, struct timespec *tp);
+#endif
+
 /** Standard lib retarget, set time since Epoch
  *
  * @param tv    Structure containing time_t seconds and useconds_t microseconds. Due to
@@ -49,9 +49,19 @@ extern "C" {
 #ifndef MBED_THREAD_STATS_ENABLED
 #define MBED_THREAD_STATS_ENABLED   1
 #endif
+#ifndef MBED_TICKER_STATS_ENABLED
+#define MBED_TICKER_STATS_ENABLED   1
+#endif
 
 #endif // MBED_ALL_STATS_ENABLED
 
+/** Number of allocation sites accounted by the heap stats, 0 when not accounted */
+#if MBED_HEAP_STATS_ENABLED && MBED_CONF_PLATFORM_HEAP_STATS_SITES
+#define MBED_HEAP_STATS_SITES       MBED_CONF_PLATFORM_HEAP_STATS_SITES
+#else
+#define MBED_HEAP_STATS_SITES       0
+#endif
+
 /** Maximum memory regions reported by mbed-os memory statistics */
 #define MBED_MAX_MEM_REGIONS     4
 
@@ -75,6 +85,79 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ * struct mbed_stats_heap_fragmentation_t definition
+ */
+typedef struct {
+    uint32_t free_size;         /**< Bytes free in the heap, including the part not yet claimed by the allocator */
+    uint32_t largest_free_size; /**< Bytes of the largest free block, about the largest allocation that can succeed */
+    uint32_t free_block_cnt;    /**< Number of free blocks the free bytes are split into */
+    uint32_t fragmentation;     /**< Fragmentation index in percent: 0 when the free bytes are in one block, towards 100 as they are split into small blocks */
+} mbed_stats_heap_fragmentation_t;
+
+/**
+ *  Fill the passed in structure with the fragmentation of the heap.
+ *
+ *  The free blocks of the allocator are walked with the heap locked, in a time proportional
+ *  to their number. The free blocks are known with the TLSF allocator (platform.tlsf-heap-enabled)
+ *  and the newlib-nano one. With the full newlib allocator only free_size is filled, from
+ *  mallinfo(). With the ARM and IAR toolchains the structure is all 0.
+ *
+ *  @param stats    A pointer to the mbed_stats_heap_fragmentation_t structure to fill,
+ *                  all 0 when heap stats are disabled
+ */
+void mbed_stats_heap_fragmentation_get(mbed_stats_heap_fragmentation_t *stats);
+
+/**
+ * struct mbed_stats_heap_site_t definition
+ */
+typedef struct {
+    void *caller;               /**< Return address of the allocation call, identifying the code that allocates */
+    uint32_t current_size;      /**< Bytes currently allocated by the site */
+    uint32_t max_size;          /**< Maximum bytes allocated by the site at one time */
+    uint32_t alloc_cnt;         /**< Current number of allocations of the site that have not been freed */
+    uint32_t total_cnt;         /**< Number of allocations made by the site */
+} mbed_stats_heap_site_t;
+
+/**
+ *  Fill the passed array of structures with the statistics of each allocation site.
+ *
+ *  The sites are accounted when heap stats are enabled and platform.heap-stats-sites is not 0.
+ *  Each allocation is attributed to the address its malloc, calloc, realloc or new was called
+ *  from, looked up in a hash table of platform.heap-stats-sites entries. Once the table is full,
+ *  the allocations of the new sites are only counted in mbed_stats_heap_get(). Resolve the
+ *  addresses with the map file, or with addr2line on the ELF file.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_heap_site_t structures to fill
+ *  @param count    The number of mbed_stats_heap_site_t structures in the provided array
+ *  @return         The number of mbed_stats_heap_site_t structures that have been filled.
+ *                  If the number of sites is less than or equal to count, it will equal the number of sites.
+ *                  If the number of sites is greater than count, it will equal count.
+ */
+size_t mbed_stats_heap_site_get_each(mbed_stats_heap_site_t *stats, size_t count);
+
+/**
+ * struct mbed_stats_arena_t definition
+ */
+typedef struct {
+    const char *name;           /**< Name of the arena */
+    uint32_t current_size;      /**< Bytes currently allocated from the arena */
+    uint32_t max_size;          /**< Maximum bytes allocated from the arena at one time since it was initialized */
+    uint32_t reserved_size;     /**< Current number of bytes of the buffer and heap chunks of the arena */
+    uint32_t alloc_cnt;         /**< Number of allocations since the arena was reset */
+    uint32_t alloc_fail_cnt;    /**< Number of failed allocations since the arena was initialized */
+} mbed_stats_arena_t;
+
+/**
+ *  Fill the passed array of structures with the statistics of each arena, see mbed_arena.h.
+ *  @param stats    A pointer to an array of mbed_stats_arena_t structures to fill
+ *  @param count    The number of mbed_stats_arena_t structures in the provided array
+ *  @return         The number of mbed_stats_arena_t structures that have been filled.
+ *                  If the number of arenas is less than or equal to count, it will equal the number of arenas.
+ *                  If the number of arenas is greater than count, it will equal count.
+ */
+size_t mbed_stats_arena_get_each(mbed_stats_arena_t *stats, size_t count);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -104,6 +187,47 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats);
  */
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count);
 
+/**
+ * struct mbed_stats_stack_peak_t definition
+ */
+typedef struct {
+    uint32_t name_hash;         /**< Hash of the thread name, identifying the thread across reboots */
+    const char *name;           /**< Name of the thread, or NULL if it hasn't been sampled since the peaks were restored */
+    uint32_t max_size;          /**< Peak number of bytes used on the stack, over the samples and the restored peaks */
+    uint32_t reserved_size;     /**< Number of bytes reserved for the stack when last sampled */
+    uint32_t recommended_size;  /**< Stack size recommended for the thread: the peak plus platform.stack-stats-margin percent */
+} mbed_stats_stack_peak_t;
+
+/**
+ *  Sample the stack watermark of each thread, updating its peak.
+ *
+ *  When platform.stack-stats-sample-interval is set, the idle thread calls it at that interval,
+ *  so the peaks of threads that have since terminated are kept. Threads are identified by
+ *  name, so threads with the same name share a peak. At most platform.stack-stats-peaks-max
+ *  threads are tracked.
+ */
+void mbed_stats_stack_sample(void);
+
+/**
+ *  Fill the passed array of structures with the stack peaks of the sampled threads.
+ *
+ *  The array can be stored, for example with kv_set(), and restored with
+ *  mbed_stats_stack_peak_restore() after a reboot, to track the peaks over many runs.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_stack_peak_t structures to fill
+ *  @param count    The number of mbed_stats_stack_peak_t structures in the provided array
+ *  @return         The number of mbed_stats_stack_peak_t structures that have been filled.
+ */
+size_t mbed_stats_stack_peak_get_each(mbed_stats_stack_peak_t *stats, size_t count);
+
+/**
+ *  Merge the stack peaks of a previous run, as given by mbed_stats_stack_peak_get_each().
+ *
+ *  @param stats    A pointer to an array of mbed_stats_stack_peak_t structures
+ *  @param count    The number of mbed_stats_stack_peak_t structures in the provided array
+ */
+void mbed_stats_stack_peak_restore(const mbed_stats_stack_peak_t *stats, size_t count);
+
 /**
  * struct mbed_stats_cpu_t definition
  */
@@ -144,6 +268,152 @@ typedef struct {
  */
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
 
+/** Number of buckets of the scheduling latency histogram */
+#define MBED_STATS_LATENCY_BUCKETS  16
+
+/**
+ * struct mbed_stats_thread_cpu_t definition
+ */
+typedef struct {
+    uint32_t id;                /**< ID of the thread */
+    uint64_t cpu_cycles;        /**< CPU cycles spent running the thread since it was created */
+    uint32_t switch_cnt;        /**< Number of times the thread was switched in */
+    uint32_t max_latency_us;    /**< Longest time in microseconds from the thread being unblocked to it running */
+} mbed_stats_thread_cpu_t;
+
+/**
+ * struct mbed_stats_latency_t definition
+ */
+typedef struct {
+    uint32_t bucket[MBED_STATS_LATENCY_BUCKETS];    /**< Count of latencies of less than 2^(n+1) microseconds, the last bucket counts all the longer ones */
+    uint32_t max_us;                                /**< Longest latency in microseconds */
+} mbed_stats_latency_t;
+
+/**
+ *  Fill the passed array of stat structures with the CPU time statistics for each thread.
+ *
+ *  The cycles are counted with the DWT cycle counter on context switches, which is only
+ *  available on Cortex-M3 and above. Threads not started while the statistics are
+ *  tracked, beyond platform.thread-cpu-stats-max, are not reported.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_thread_cpu_t structures to fill
+ *  @param count    The number of mbed_stats_thread_cpu_t structures in the provided array
+ *  @return         The number of mbed_stats_thread_cpu_t structures that have been filled.
+ */
+size_t mbed_stats_thread_cpu_get_each(mbed_stats_thread_cpu_t *stats, size_t count);
+
+/**
+ *  Fill the passed in structure with the histogram of the time from a thread being
+ *  unblocked to it running, for the threads of priority platform.latency-stats-priority and above.
+ *
+ *  @param stats    A pointer to the mbed_stats_latency_t structure to fill
+ */
+void mbed_stats_latency_get(mbed_stats_latency_t *stats);
+
+/**
+ * struct mbed_stats_critical_section_t definition
+ */
+typedef struct {
+    void *caller;               /**< Return address of the call to core_util_critical_section_enter() opening the section */
+    uint32_t cycles;            /**< Longest time in CPU cycles the section kept interrupts masked */
+    uint32_t max_us;            /**< The same time in microseconds */
+} mbed_stats_critical_section_t;
+
+/**
+ *  Fill the passed array of stat structures with the longest critical sections, longest first.
+ *
+ *  Only the outermost core_util_critical_section_enter() and core_util_critical_section_exit()
+ *  of nested sections are timed, with the DWT cycle counter, when platform.critical-stats-enabled
+ *  is set. A caller keeps its longest section, among the platform.critical-stats-max longest
+ *  recorded. Interrupts masked without the critical section API are not seen.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_critical_section_t structures to fill
+ *  @param count    The number of mbed_stats_critical_section_t structures in the provided array
+ *  @return         The number of mbed_stats_critical_section_t structures that have been filled.
+ */
+size_t mbed_stats_critical_section_get_each(mbed_stats_critical_section_t *stats, size_t count);
+
+/**
+ *  Fill the passed in structure with the histogram of the time interrupts were kept
+ *  masked by critical sections.
+ *
+ *  @param stats    A pointer to the mbed_stats_latency_t structure to fill
+ */
+void mbed_stats_critical_section_histogram_get(mbed_stats_latency_t *stats);
+
+/**
+ *  Clear the longest critical sections and their histogram.
+ */
+void mbed_stats_critical_section_reset(void);
+
+/**
+ * struct mbed_stats_boot_mark_t definition
+ */
+typedef struct {
+    const char *name;           /**< Name of the boot phase ended by the mark */
+    uint32_t cycles;            /**< CPU cycles since the first mark, in mbed_init() */
+    uint32_t time_us;           /**< The same time in microseconds */
+} mbed_stats_boot_mark_t;
+
+/**
+ * struct mbed_stats_boot_initializer_t definition
+ */
+typedef struct {
+    void (*initializer)(void);  /**< Address of the static initializer, to look up in the map file */
+    uint32_t cycles;            /**< CPU cycles the initializer took */
+    uint32_t time_us;           /**< The same time in microseconds */
+} mbed_stats_boot_initializer_t;
+
+/**
+ *  Record the end of a boot phase, when platform.boot-stats-enabled is set.
+ *
+ *  The boot code marks its own phases: "mbed_init" when it starts, "sdk_init" after
+ *  mbed_sdk_init(), "us_ticker",
+ *  "rtos_init", "rtos_start" once the main thread runs, "static_init" after the C++
+ *  static initializers, "mbed_main" and "main" just before main() is called.
+ *  kv_init_storage_config() marks "kvstore". The application marks its own
+ *  phases, such as the network being up, with names of static storage duration.
+ *  Marks are dropped once platform.boot-stats-max-marks are recorded.
+ *
+ *  Times are counted with the DWT cycle counter, started by the first mark and wrapping
+ *  after 2^32 cycles. The time spent before mbed_init(), in the reset handler and
+ *  SystemInit(), is not seen. They are
+ *  converted to microseconds with the core clock at the start of each phase, so the
+ *  phase switching the clock, mbed_sdk_init() on most targets, is approximate.
+ *
+ *  @param name     Name of the phase ended
+ */
+void mbed_stats_boot_mark(const char *name);
+
+/**
+ *  Fill the passed array of stat structures with the boot marks, in order.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_boot_mark_t structures to fill
+ *  @param count    The number of mbed_stats_boot_mark_t structures in the provided array
+ *  @return         The number of mbed_stats_boot_mark_t structures that have been filled.
+ */
+size_t mbed_stats_boot_get_each(mbed_stats_boot_mark_t *stats, size_t count);
+
+/**
+ *  Run a C++ static initializer, timing it when platform.boot-stats-enabled is set.
+ *
+ *  Called by the boot code of the toolchains able to walk the initializers one by one,
+ *  GCC with the RTOS.
+ *
+ *  @param initializer  The initializer to run
+ */
+void mbed_stats_boot_initializer_run(void (*initializer)(void));
+
+/**
+ *  Fill the passed array of stat structures with the longest static initializers,
+ *  longest first, among the platform.boot-stats-max-initializers longest recorded.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_boot_initializer_t structures to fill
+ *  @param count    The number of mbed_stats_boot_initializer_t structures in the provided array
+ *  @return         The number of mbed_stats_boot_initializer_t structures that have been filled.
+ */
+size_t mbed_stats_boot_initializer_get_each(mbed_stats_boot_initializer_t *stats, size_t count);
+
 /**
  * enum mbed_compiler_id_t definition
  */
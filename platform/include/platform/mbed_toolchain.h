@@ -455,6 +455,37 @@
 #endif
 #endif
 
+/** MBED_RAMFUNC
+ *  Declare a function to be executed from RAM.
+ *
+ *  On targets setting MBED_RAMFUNC_SIZE, the function is placed in the
+ *  .ramfunc section, which the linker scripts reserve in RAM and fill from
+ *  flash at boot. The function then runs with no flash wait states and keeps
+ *  running while the flash is programmed or erased. The MPU leaves that
+ *  section executable, it doesn't need a ScopedRamExecutionLock.
+ *  On other targets, the function stays in flash.
+ *
+ *  @note
+ *  Only the function itself is moved: the functions it calls and the
+ *  constants it reads must be in RAM too, or inlined, for it to run while
+ *  the flash is busy.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_RAMFUNC void timer_irq_handler(void) {
+ *
+ *  }
+ *  @endcode
+ */
+#ifndef MBED_RAMFUNC
+#if defined(MBED_RAMFUNC_SIZE) && (MBED_RAMFUNC_SIZE > 0) && (defined(__GNUC__) || defined(__clang__))
+#define MBED_RAMFUNC MBED_SECTION(".ramfunc") MBED_NOINLINE
+#else
+#define MBED_RAMFUNC
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
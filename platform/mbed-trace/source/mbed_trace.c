@@ -49,6 +49,16 @@
 #endif
 #endif /* YOTTA_CFG_MEMLIB */
 
+#if MBED_CONF_MBED_TRACE_DEFERRED_ITM
+#if !DEVICE_ITM
+#error mbed-trace.deferred-itm requires a target with ITM
+#endif
+#include <stdbool.h>
+#include "cmsis.h"
+#include "hal/itm_api.h"
+#include "platform/mbed_critical.h"
+#endif
+
 #define VT100_COLOR_ERROR "\x1b[31m"
 #define VT100_COLOR_WARN  "\x1b[33m"
 #define VT100_COLOR_INFO  "\x1b[39m"
@@ -85,6 +95,14 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** default max deferred trace record size in bytes, the arguments
+    which don't fit are dropped */
+#ifdef MBED_TRACE_DEFERRED_RECORD_LENGTH
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH MBED_TRACE_DEFERRED_RECORD_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH 128
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -96,6 +114,9 @@
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+#if MBED_CONF_MBED_TRACE_DEFERRED_ITM
+static void mbed_trace_deferred(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#endif
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -183,6 +204,11 @@ int mbed_trace_init(void)
     memset(m_trace.filters_include, 0, m_trace.filters_length);
     memset(m_trace.line, 0, m_trace.line_length);
 
+#if MBED_CONF_MBED_TRACE_DEFERRED_ITM
+    mbed_itm_init();
+    ITM->TER |= 1UL << MBED_CONF_MBED_TRACE_DEFERRED_ITM_PORT;
+#endif
+
     return 0;
 }
 void mbed_trace_free(void)
@@ -331,6 +357,13 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
         goto end;
     }
     if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+#if MBED_CONF_MBED_TRACE_DEFERRED_ITM
+        if (dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_deferred(dlevel, grp, fmt, ap);
+            mbed_trace_reset_tmp();
+            goto end;
+        }
+#endif
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
@@ -494,6 +527,200 @@ end:
         } while (--count > 0);
     }
 }
+#if MBED_CONF_MBED_TRACE_DEFERRED_ITM
+/* Deferred trace record, in 32-bit words:
+ *   header     sync 0xA5 << 24 | level << 16 | truncated flag 0x8000 | number of words after the header
+ *   timestamp  DWT cycle counter
+ *   grp        address of the group string
+ *   fmt        address of the format string
+ *   arguments  in the order of the format, 64-bit ones in two words, low word first,
+ *              strings copied as their length followed by the characters padded to a word,
+ *              0xFFFFFFFF for a NULL string
+ * The group and format strings are read by the host from the ELF file.
+ */
+#define DEFERRED_RECORD_SYNC        0xA5UL
+#define DEFERRED_RECORD_TRUNCATED   0x8000UL
+#define DEFERRED_RECORD_WORDS       (DEFAULT_TRACE_DEFERRED_RECORD_LENGTH / 4)
+
+typedef struct {
+    uint32_t *ptr;
+    uint32_t *end;
+    bool truncated;
+} trace_record_t;
+
+static void mbed_trace_record_word(trace_record_t *rec, uint32_t word)
+{
+    if (rec->ptr < rec->end) {
+        *rec->ptr++ = word;
+    } else {
+        rec->truncated = true;
+    }
+}
+static void mbed_trace_record_value(trace_record_t *rec, uint64_t value, size_t size)
+{
+    mbed_trace_record_word(rec, (uint32_t)value);
+    if (size > 4) {
+        mbed_trace_record_word(rec, (uint32_t)(value >> 32));
+    }
+}
+static void mbed_trace_record_string(trace_record_t *rec, const char *str)
+{
+    if (str == NULL) {
+        mbed_trace_record_word(rec, 0xFFFFFFFF);
+        return;
+    }
+    if (rec->end - rec->ptr < 2) {
+        rec->truncated = true;
+        return;
+    }
+    size_t len = strlen(str);
+    size_t room = (rec->end - rec->ptr - 1) * 4;
+    if (len > room) {
+        len = room;
+        rec->truncated = true;
+    }
+    *rec->ptr++ = len;
+    memcpy(rec->ptr, str, len);
+    rec->ptr += (len + 3) / 4;
+}
+#define RECORD_ARG(rec, ap, type) mbed_trace_record_value(rec, (uint64_t)va_arg(ap, type), sizeof(type))
+static void mbed_trace_record_args(trace_record_t *rec, const char *fmt, va_list ap)
+{
+    while (*fmt) {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        while (*fmt && strchr("-+ #0", *fmt)) {
+            fmt++;
+        }
+        if (*fmt == '*') {
+            RECORD_ARG(rec, ap, int);
+            fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9') {
+            fmt++;
+        }
+        if (*fmt == '.') {
+            fmt++;
+            if (*fmt == '*') {
+                RECORD_ARG(rec, ap, int);
+                fmt++;
+            }
+            while (*fmt >= '0' && *fmt <= '9') {
+                fmt++;
+            }
+        }
+        // 'q' stands for ll, hh and h are promoted to int
+        char length = 0;
+        while (*fmt && strchr("hljztL", *fmt)) {
+            length = (length == 'l' && *fmt == 'l') ? 'q' : *fmt;
+            fmt++;
+        }
+        switch (*fmt) {
+            case 'd':
+            case 'i':
+                switch (length) {
+                    case 'q':
+                        RECORD_ARG(rec, ap, long long);
+                        break;
+                    case 'l':
+                        RECORD_ARG(rec, ap, long);
+                        break;
+                    case 'j':
+                        RECORD_ARG(rec, ap, intmax_t);
+                        break;
+                    case 'z':
+                        RECORD_ARG(rec, ap, size_t);
+                        break;
+                    case 't':
+                        RECORD_ARG(rec, ap, ptrdiff_t);
+                        break;
+                    default:
+                        RECORD_ARG(rec, ap, int);
+                        break;
+                }
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+                switch (length) {
+                    case 'q':
+                        RECORD_ARG(rec, ap, unsigned long long);
+                        break;
+                    case 'l':
+                        RECORD_ARG(rec, ap, unsigned long);
+                        break;
+                    case 'j':
+                        RECORD_ARG(rec, ap, uintmax_t);
+                        break;
+                    case 'z':
+                        RECORD_ARG(rec, ap, size_t);
+                        break;
+                    case 't':
+                        RECORD_ARG(rec, ap, ptrdiff_t);
+                        break;
+                    default:
+                        RECORD_ARG(rec, ap, unsigned int);
+                        break;
+                }
+                break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double d = (length == 'L') ? (double)va_arg(ap, long double) : va_arg(ap, double);
+                uint64_t bits;
+                memcpy(&bits, &d, sizeof(bits));
+                mbed_trace_record_value(rec, bits, sizeof(bits));
+                break;
+            }
+            case 's':
+                mbed_trace_record_string(rec, va_arg(ap, const char *));
+                break;
+            case 'p':
+                mbed_trace_record_value(rec, (uintptr_t)va_arg(ap, void *), sizeof(void *));
+                break;
+            case 'n':
+                (void)va_arg(ap, void *);
+                break;
+            case '\0':
+                return;
+            default:
+                break;
+        }
+        fmt++;
+    }
+}
+static void mbed_trace_deferred(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint32_t record[DEFERRED_RECORD_WORDS];
+    trace_record_t rec = {
+        .ptr = record + 1,
+        .end = record + DEFERRED_RECORD_WORDS,
+        .truncated = false
+    };
+
+    mbed_trace_record_word(&rec, DWT->CYCCNT);
+    mbed_trace_record_word(&rec, (uint32_t)(uintptr_t)grp);
+    mbed_trace_record_word(&rec, (uint32_t)(uintptr_t)fmt);
+    mbed_trace_record_args(&rec, fmt, ap);
+
+    uint32_t words = rec.ptr - record - 1;
+    record[0] = (DEFERRED_RECORD_SYNC << 24) | ((uint32_t)dlevel << 16) |
+                (rec.truncated ? DEFERRED_RECORD_TRUNCATED : 0) | words;
+
+    // Records of other threads and interrupts must not interleave on the port
+    core_util_critical_section_enter();
+    mbed_itm_send_block(MBED_CONF_MBED_TRACE_DEFERRED_ITM_PORT, record, (words + 1) * sizeof(uint32_t));
+    core_util_critical_section_exit();
+}
+#endif
 static void mbed_trace_reset_tmp(void)
 {
     m_trace.tmp_data_ptr = m_trace.tmp_data;
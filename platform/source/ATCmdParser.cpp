@@ -22,6 +22,7 @@
 #include "ATCmdParser.h"
 #include "mbed_poll.h"
 #include "mbed_debug.h"
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,6 +43,187 @@
 
 namespace mbed {
 
+#define MATCH_FAIL          -1
+#define MATCH_UNSUPPORTED   -2
+
+static bool match_set(const char *set, const char *set_end, char c)
+{
+    bool invert = *set == '^';
+    if (invert) {
+        set++;
+    }
+    bool found = false;
+    for (const char *p = set; p < set_end; p++) {
+        if (p[1] == '-' && p + 2 < set_end) {
+            if ((unsigned char)c >= (unsigned char)p[0] && (unsigned char)c <= (unsigned char)p[2]) {
+                found = true;
+            }
+            p += 2;
+        } else if (*p == c) {
+            found = true;
+        }
+    }
+    return found != invert;
+}
+
+static int match_digits(const char *in, int avail, int base)
+{
+    int n = 0;
+    while (n < avail) {
+        int c = (unsigned char)in[n];
+        int v = isdigit(c) ? c - '0' : isxdigit(c) ? (tolower(c) - 'a' + 10) : 16;
+        if (v >= base) {
+            break;
+        }
+        n++;
+    }
+    return n;
+}
+
+/* Match a line of input against the validity format built by vrecvscanf(),
+ * where all conversions are suppressed (%*) and the final %n is the only
+ * store. Returns the number of characters matched up to %n, MATCH_FAIL if
+ * it isn't reached, or MATCH_UNSUPPORTED for conversions left to sscanf. */
+static int match_format(const char *in, const char *fmt)
+{
+    const char *start = in;
+
+    while (*fmt) {
+        if (isspace((unsigned char)*fmt)) {
+            while (isspace((unsigned char)*fmt)) {
+                fmt++;
+            }
+            while (isspace((unsigned char)*in)) {
+                in++;
+            }
+            continue;
+        }
+
+        if (*fmt != '%') {
+            if (*in != *fmt) {
+                return MATCH_FAIL;
+            }
+            in++;
+            fmt++;
+            continue;
+        }
+
+        fmt++;
+        if (*fmt == '%') {
+            while (isspace((unsigned char)*in)) {
+                in++;
+            }
+            if (*in != '%') {
+                return MATCH_FAIL;
+            }
+            in++;
+            fmt++;
+            continue;
+        }
+
+        if (*fmt == 'n') {
+            if (fmt[1] == 0) {
+                return in - start;
+            }
+            return MATCH_UNSUPPORTED;
+        }
+
+        if (*fmt != '*') {
+            return MATCH_UNSUPPORTED;
+        }
+        fmt++;
+
+        int width = 0;
+        while (isdigit((unsigned char)*fmt)) {
+            width = width * 10 + (*fmt++ - '0');
+        }
+        while (*fmt == 'h' || *fmt == 'l' || *fmt == 'z' || *fmt == 'j' || *fmt == 't') {
+            fmt++;
+        }
+
+        char conv = *fmt++;
+        if (conv != 'c' && conv != '[') {
+            while (isspace((unsigned char)*in)) {
+                in++;
+            }
+        }
+        int avail = strlen(in);
+        if (width > 0 && width < avail) {
+            avail = width;
+        }
+        if (avail == 0) {
+            return MATCH_FAIL;
+        }
+
+        int n = 0;
+        switch (conv) {
+            case 'd':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'i': {
+                if (in[0] == '+' || in[0] == '-') {
+                    n++;
+                }
+                int base = conv == 'o' ? 8 : (conv == 'x' || conv == 'X') ? 16 : 10;
+                if ((conv == 'i' || base == 16) && in[n] == '0' && n + 1 < avail && tolower((unsigned char)in[n + 1]) == 'x') {
+                    // a "0x" prefix without hex digits after it is left to sscanf
+                    if (match_digits(in + n + 2, avail - n - 2, 16) == 0) {
+                        return MATCH_UNSUPPORTED;
+                    }
+                    base = 16;
+                    n += 2;
+                } else if (conv == 'i' && in[n] == '0') {
+                    base = 8;
+                }
+                int digits = match_digits(in + n, avail - n, base);
+                if (digits == 0) {
+                    return MATCH_FAIL;
+                }
+                n += digits;
+                break;
+            }
+            case 's':
+                while (n < avail && !isspace((unsigned char)in[n])) {
+                    n++;
+                }
+                break;
+            case 'c':
+                n = width > 0 ? avail : 1;
+                break;
+            case '[': {
+                const char *set = fmt;
+                if (*fmt == '^') {
+                    fmt++;
+                }
+                if (*fmt == ']') {
+                    fmt++;
+                }
+                while (*fmt && *fmt != ']') {
+                    fmt++;
+                }
+                if (!*fmt) {
+                    return MATCH_UNSUPPORTED;
+                }
+                while (n < avail && match_set(set, fmt, in[n])) {
+                    n++;
+                }
+                fmt++;
+                if (n == 0) {
+                    return MATCH_FAIL;
+                }
+                break;
+            }
+            default:
+                return MATCH_UNSUPPORTED;
+        }
+        in += n;
+    }
+
+    return MATCH_FAIL;
+}
+
 // getc/putc handling with timeouts
 int ATCmdParser::putc(char c)
 {
@@ -195,6 +377,16 @@ restart:
         _buffer[offset++] = 'n';
         _buffer[offset++] = 0;
 
+        // The line can't match before its literal prefix (up to the first
+        // conversion or whitespace) has been received, so the received
+        // characters are checked against it before running the matcher.
+        int prefix_len = 0;
+        while (_buffer[prefix_len] != '%' && !isspace((unsigned char)_buffer[prefix_len])) {
+            prefix_len++;
+        }
+        bool prefix_ok = true;
+        bool use_scanf = false;
+
         debug_if(_dbg_on, "AT? %s\n", _buffer);
         // To workaround scanf's lack of error reporting, we actually
         // make two passes. One checks the validity with the modified
@@ -243,10 +435,13 @@ restart:
             }
             _buffer[offset + j++] = c;
             _buffer[offset + j] = 0;
+            if (j <= prefix_len && (char)c != _buffer[j - 1]) {
+                prefix_ok = false;
+            }
 
             // Check for oob data
-            if (multiline) {
-                for (struct oob *oob = _oobs; oob; oob = oob->next) {
+            if (multiline && (unsigned)j <= _oob_max_len) {
+                for (struct oob *oob = _oobs[oob_bucket(j, _buffer[offset])]; oob; oob = oob->next) {
                     if ((unsigned)j == oob->len && memcmp(
                                 oob->prefix, _buffer + offset, oob->len) == 0) {
                         debug_if(_dbg_on, "AT! %s\n", oob->prefix);
@@ -269,8 +464,17 @@ restart:
             if (whole_line_wanted && c != '\n') {
                 // Don't attempt scanning until we get delimiter if they included it in format
                 // This allows recv("Foo: %s\n") to work, and not match with just the first character of a string
-            } else if (response) {
-                sscanf(_buffer + offset, _buffer, &count);
+            } else if (response && prefix_ok && j >= prefix_len) {
+                if (!use_scanf) {
+                    count = match_format(_buffer + offset, _buffer);
+                    if (count == MATCH_UNSUPPORTED) {
+                        use_scanf = true;
+                        count = -1;
+                    }
+                }
+                if (use_scanf) {
+                    sscanf(_buffer + offset, _buffer, &count);
+                }
             }
 
             // We only succeed if all characters in the response are matched
@@ -297,6 +501,7 @@ restart:
             if (c == '\n' || j + 1 >= _buffer_size - offset) {
                 debug_if(_dbg_on, "AT< %s", _buffer + offset);
                 j = 0;
+                prefix_ok = true;
             }
         }
     }
@@ -358,26 +563,36 @@ void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
     oob->len = strlen(prefix);
     oob->prefix = prefix;
     oob->cb = cb;
-    oob->next = _oobs;
-    _oobs = oob;
+    struct oob **bucket = &_oobs[oob_bucket(oob->len, prefix[0])];
+    oob->next = *bucket;
+    *bucket = oob;
+    if (oob->len > _oob_max_len) {
+        _oob_max_len = oob->len;
+    }
 }
 
 void ATCmdParser::remove_oob(const char *prefix)
 {
-    struct oob *prev = NULL;
-    struct oob *oob = _oobs;
-    while (oob) {
-        if (memcmp(oob->prefix, prefix, strlen(prefix)) == 0) {
-            if (prev) {
-                prev->next = oob->next;
-            } else {
-                _oobs = oob->next;
+    size_t len = strlen(prefix);
+    // start with the bucket of an exact match
+    int first = oob_bucket(len, prefix[0]);
+    for (int n = 0; n < ATCMDPARSER_OOB_BUCKETS; n++) {
+        int i = (first + n) % ATCMDPARSER_OOB_BUCKETS;
+        struct oob *prev = NULL;
+        struct oob *oob = _oobs[i];
+        while (oob) {
+            if (memcmp(oob->prefix, prefix, len) == 0) {
+                if (prev) {
+                    prev->next = oob->next;
+                } else {
+                    _oobs[i] = oob->next;
+                }
+                delete oob;
+                return;
             }
-            delete oob;
-            return;
+            prev = oob;
+            oob = oob->next;
         }
-        prev = oob;
-        oob = oob->next;
     }
 }
 
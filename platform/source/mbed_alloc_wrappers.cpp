@@ -20,6 +20,8 @@
 #include "platform/mbed_toolchain.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/internal/mbed_tlsf.h"
+#include <errno.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -44,6 +46,10 @@ are active, the second one (MBED_MEM_TRACING_ENABLED) will trace the first one's
 typedef struct {
     uint32_t size;
     uint32_t signature;
+#if MBED_HEAP_STATS_SITES
+    uint32_t site;      // Index of the allocation site plus 1, 0 when not accounted
+    uint32_t padding;   // Keeps the allocations 8-byte aligned
+#endif
 } alloc_info_t;
 
 #if MBED_HEAP_STATS_ENABLED
@@ -59,6 +65,9 @@ typedef struct mbed_heap_overhead  {
 
 static int get_malloc_block_total_size(void *ptr)
 {
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    return mbed_tlsf_block_total_size(ptr);
+#else
     mbed_heap_overhead_t *c = (mbed_heap_overhead_t *)((char *)ptr - offsetof(mbed_heap_overhead, next));
 
     // Skip the padding area
@@ -67,7 +76,61 @@ static int get_malloc_block_total_size(void *ptr)
     }
     //  Mask LSB as it is used for usage flags
     return (c->size & ~0x1);
+#endif
+}
+
+#if MBED_HEAP_STATS_SITES
+static mbed_stats_heap_site_t heap_sites[MBED_HEAP_STATS_SITES];
+
+// Find or add the entry of a site, with malloc_stats_mutex held.
+// Return its index plus 1, or 0 if the table is full
+static uint32_t heap_site_get(void *caller)
+{
+    if (caller == NULL) {
+        return 0;
+    }
+    uint32_t index = ((uint32_t)(uintptr_t)caller * 2654435761u) % MBED_HEAP_STATS_SITES;
+    for (uint32_t i = 0; i < MBED_HEAP_STATS_SITES; i++) {
+        mbed_stats_heap_site_t *site = &heap_sites[index];
+        if (site->caller == caller) {
+            return index + 1;
+        }
+        if (site->caller == NULL) {
+            site->caller = caller;
+            return index + 1;
+        }
+        index = (index + 1) % MBED_HEAP_STATS_SITES;
+    }
+    return 0;
 }
+
+static void heap_site_alloc(alloc_info_t *alloc_info, void *caller, size_t size)
+{
+    alloc_info->site = heap_site_get(caller);
+    alloc_info->padding = 0;
+    if (alloc_info->site != 0) {
+        mbed_stats_heap_site_t *site = &heap_sites[alloc_info->site - 1];
+        site->current_size += size;
+        site->alloc_cnt += 1;
+        site->total_cnt += 1;
+        if (site->current_size > site->max_size) {
+            site->max_size = site->current_size;
+        }
+    }
+}
+
+static void heap_site_free(alloc_info_t *alloc_info)
+{
+    if (alloc_info->site != 0) {
+        mbed_stats_heap_site_t *site = &heap_sites[alloc_info->site - 1];
+        site->current_size -= alloc_info->size;
+        site->alloc_cnt -= 1;
+    }
+}
+#else
+#define heap_site_alloc(alloc_info, caller, size)
+#define heap_site_free(alloc_info)
+#endif // MBED_HEAP_STATS_SITES
 #endif
 
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
@@ -84,6 +147,25 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+size_t mbed_stats_heap_site_get_each(mbed_stats_heap_site_t *stats, size_t count)
+{
+    size_t filled = 0;
+#if MBED_HEAP_STATS_SITES
+    malloc_stats_mutex->lock();
+    for (size_t i = 0; i < MBED_HEAP_STATS_SITES && filled < count; i++) {
+        if (heap_sites[i].caller != NULL) {
+            memcpy(&stats[filled], &heap_sites[i], sizeof(mbed_stats_heap_site_t));
+            filled++;
+        }
+    }
+    malloc_stats_mutex->unlock();
+#else
+    (void)stats;
+    (void)count;
+#endif
+    return filled;
+}
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
@@ -101,6 +183,97 @@ extern "C" {
 }
 
 
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+/* TLSF allocator used instead of the newlib one, over the same heap area and
+ * with the same lock. newlib functions that are not wrapped, such as mallinfo,
+ * don't see its allocations. */
+extern "C" {
+    void __malloc_lock(struct _reent *r);
+    void __malloc_unlock(struct _reent *r);
+}
+
+static mbed_tlsf_t tlsf_heap;
+static bool tlsf_heap_ready = false;
+
+static void tlsf_heap_lock(struct _reent *r)
+{
+    __malloc_lock(r);
+    if (!tlsf_heap_ready) {
+        mbed_tlsf_init(&tlsf_heap);
+#if defined(MBED_SPLIT_HEAP)
+        extern uint32_t __mbed_sbrk_start, __mbed_krbs_start;
+        extern uint32_t __mbed_sbrk_start_0, __mbed_krbs_start_0;
+        mbed_tlsf_add_pool(&tlsf_heap, &__mbed_sbrk_start_0, (uintptr_t) &__mbed_krbs_start_0 - (uintptr_t) &__mbed_sbrk_start_0);
+        mbed_tlsf_add_pool(&tlsf_heap, &__mbed_sbrk_start, (uintptr_t) &__mbed_krbs_start - (uintptr_t) &__mbed_sbrk_start);
+#else
+        extern unsigned char *mbed_heap_start;
+        extern uint32_t mbed_heap_size;
+        mbed_tlsf_add_pool(&tlsf_heap, mbed_heap_start, mbed_heap_size);
+#endif
+        tlsf_heap_ready = true;
+    }
+}
+
+static void *tlsf_heap_result(struct _reent *r, void *ptr)
+{
+    __malloc_unlock(r);
+    if (ptr == NULL) {
+        r->_errno = ENOMEM;
+    }
+    return ptr;
+}
+
+static void *heap_malloc_r(struct _reent *r, size_t size)
+{
+    tlsf_heap_lock(r);
+    return tlsf_heap_result(r, mbed_tlsf_malloc(&tlsf_heap, size));
+}
+
+static void *heap_memalign_r(struct _reent *r, size_t alignment, size_t bytes)
+{
+    tlsf_heap_lock(r);
+    return tlsf_heap_result(r, mbed_tlsf_memalign(&tlsf_heap, alignment, bytes));
+}
+
+static void *heap_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    tlsf_heap_lock(r);
+    void *new_ptr = mbed_tlsf_realloc(&tlsf_heap, ptr, size);
+    __malloc_unlock(r);
+    if (new_ptr == NULL && size != 0) {
+        r->_errno = ENOMEM;
+    }
+    return new_ptr;
+}
+
+static void heap_free_r(struct _reent *r, void *ptr)
+{
+    tlsf_heap_lock(r);
+    mbed_tlsf_free(&tlsf_heap, ptr);
+    __malloc_unlock(r);
+}
+
+static void *heap_calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+    size_t total = nmemb * size;
+    if (size != 0 && total / size != nmemb) {
+        r->_errno = ENOMEM;
+        return NULL;
+    }
+    void *ptr = heap_malloc_r(r, total);
+    if (ptr != NULL) {
+        memset(ptr, 0, total);
+    }
+    return ptr;
+}
+#else
+#define heap_malloc_r   __real__malloc_r
+#define heap_memalign_r __real__memalign_r
+#define heap_realloc_r  __real__realloc_r
+#define heap_free_r     __real__free_r
+#define heap_calloc_r   __real__calloc_r
+#endif // MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+
 extern "C" void *__wrap__malloc_r(struct _reent *r, size_t size)
 {
     return malloc_wrapper(r, size, MBED_CALLER_ADDR());
@@ -114,10 +287,11 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
 #endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
-    alloc_info_t *alloc_info = (alloc_info_t *)__real__malloc_r(r, size + sizeof(alloc_info_t));
+    alloc_info_t *alloc_info = (alloc_info_t *)heap_malloc_r(r, size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
         alloc_info->signature = MBED_HEAP_STATS_SIGNATURE;
+        heap_site_alloc(alloc_info, caller, size);
         ptr = (void *)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -131,7 +305,7 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
     }
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = __real__malloc_r(r, size);
+    ptr = heap_malloc_r(r, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_malloc(ptr, size, caller);
@@ -163,7 +337,7 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(r, size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -174,7 +348,7 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
         free(ptr);
     }
 #else // #if MBED_HEAP_STATS_ENABLED
-    new_ptr = __real__realloc_r(r, ptr, size);
+    new_ptr = heap_realloc_r(r, ptr, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
@@ -201,19 +375,20 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
         if (MBED_HEAP_STATS_SIGNATURE == alloc_info->signature) {
             size_t user_size = alloc_info->size;
             size_t alloc_size = get_malloc_block_total_size((void *)alloc_info);
+            heap_site_free(alloc_info);
             alloc_info->signature = 0x0;
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
             heap_stats.overhead_size -= (alloc_size - user_size);
-            __real__free_r(r, (void *)alloc_info);
+            heap_free_r(r, (void *)alloc_info);
         } else {
-            __real__free_r(r, ptr);
+            heap_free_r(r, ptr);
         }
     }
 
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    __real__free_r(r, ptr);
+    heap_free_r(r, ptr);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_free(ptr, caller);
@@ -230,12 +405,12 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
 
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(r, nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = __real__calloc_r(r, nmemb, size);
+    ptr = heap_calloc_r(r, nmemb, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
@@ -246,7 +421,7 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 
 extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t bytes)
 {
-    return __real__memalign_r(r, alignment, bytes);
+    return heap_memalign_r(r, alignment, bytes);
 }
 
 
@@ -305,6 +480,7 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
     if (alloc_info != NULL) {
         alloc_info->size = size;
         alloc_info->signature = MBED_HEAP_STATS_SIGNATURE;
+        heap_site_alloc(alloc_info, caller, size);
         ptr = (void *)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -346,7 +522,7 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -384,7 +560,7 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
 #endif
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
@@ -426,6 +602,7 @@ extern "C" void free_wrapper(void *ptr, void *caller)
         if (MBED_HEAP_STATS_SIGNATURE == alloc_info->signature) {
             size_t user_size = alloc_info->size;
             size_t alloc_size = get_malloc_block_total_size((void *)alloc_info);
+            heap_site_free(alloc_info);
             alloc_info->signature = 0x0;
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
@@ -458,8 +635,83 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #error Memory tracing is not supported with the current toolchain.
 #endif
 
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+#error The TLSF heap is not supported with the current toolchain.
+#endif
+
 #if MBED_HEAP_STATS_ENABLED
 #error Heap statistics are not supported with the current toolchain.
 #endif
 
 #endif // #if defined(TOOLCHAIN_GCC)
+
+/******************************************************************************/
+/* Heap fragmentation                                                         */
+/******************************************************************************/
+
+#if MBED_HEAP_STATS_ENABLED && defined(TOOLCHAIN_GCC) && !MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+#include <malloc.h>
+#include <sys/types.h>
+
+extern "C" {
+    void __malloc_lock(struct _reent *r);
+    void __malloc_unlock(struct _reent *r);
+    // Free list of the newlib-nano allocator, absent with the full newlib one
+    extern mbed_heap_overhead_t *__malloc_free_list __attribute__((weak));
+    caddr_t _sbrk(int incr);
+}
+#endif
+
+void mbed_stats_heap_fragmentation_get(mbed_stats_heap_fragmentation_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_heap_fragmentation_t));
+#if MBED_HEAP_STATS_ENABLED
+#if defined(TOOLCHAIN_GCC) && MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    mbed_tlsf_free_info_t info;
+    tlsf_heap_lock(_REENT);
+    mbed_tlsf_free_info(&tlsf_heap, &info);
+    __malloc_unlock(_REENT);
+    stats->free_size = info.free_size;
+    stats->largest_free_size = info.largest_free;
+    stats->free_block_cnt = info.free_blocks;
+#elif defined(TOOLCHAIN_GCC)
+    if (&__malloc_free_list == NULL) {
+        stats->free_size = mallinfo().fordblks;
+    } else {
+        __malloc_lock(_REENT);
+        char *brk = (char *)_sbrk(0);
+        uint32_t tail = 0;
+#if !defined(MBED_SPLIT_HEAP)
+        // The end of the heap not claimed yet with sbrk is free too
+        extern unsigned char *mbed_heap_start;
+        extern uint32_t mbed_heap_size;
+        tail = (uint32_t)(mbed_heap_start + mbed_heap_size - (unsigned char *)brk);
+#endif
+        for (mbed_heap_overhead_t *c = __malloc_free_list; c != NULL; c = c->next) {
+            uint32_t size = c->size;
+            if ((char *)c + c->size == brk) {
+                // The last free block grows into the tail when more is claimed
+                size += tail;
+                tail = 0;
+            }
+            stats->free_size += size;
+            stats->free_block_cnt += 1;
+            if (size > stats->largest_free_size) {
+                stats->largest_free_size = size;
+            }
+        }
+        __malloc_unlock(_REENT);
+        if (tail != 0) {
+            stats->free_size += tail;
+            stats->free_block_cnt += 1;
+            if (tail > stats->largest_free_size) {
+                stats->largest_free_size = tail;
+            }
+        }
+    }
+#endif
+    if (stats->free_size != 0 && stats->largest_free_size != 0) {
+        stats->fragmentation = 100 - (uint32_t)(((uint64_t)stats->largest_free_size * 100) / stats->free_size);
+    }
+#endif // MBED_HEAP_STATS_ENABLED
+}
@@ -0,0 +1,195 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_arena.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_stats.h"
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+struct mbed_arena_chunk {
+    mbed_arena_chunk_t *next;
+    size_t size;
+};
+
+#define ARENA_ALIGN_UP(x)   (((x) + (MBED_ARENA_ALIGN - 1)) & ~(size_t)(MBED_ARENA_ALIGN - 1))
+#define CHUNK_HEADER_SIZE   ARENA_ALIGN_UP(sizeof(mbed_arena_chunk_t))
+
+#if MBED_HEAP_STATS_ENABLED
+static mbed_arena_t *arena_list = NULL;
+#endif
+
+static void arena_rewind(mbed_arena_t *arena)
+{
+    arena->ptr = arena->buffer;
+    arena->end = arena->buffer + arena->buffer_size;
+    arena->last = NULL;
+    arena->current_size = 0;
+    arena->reserved_size = arena->buffer_size;
+    arena->alloc_cnt = 0;
+}
+
+void mbed_arena_init(mbed_arena_t *arena, const char *name, void *buffer, size_t size, size_t chunk_size)
+{
+    MBED_ASSERT(arena != NULL);
+    memset(arena, 0, sizeof(mbed_arena_t));
+    arena->name = name;
+    arena->chunk_size = ARENA_ALIGN_UP(chunk_size);
+
+    if (buffer != NULL) {
+        uintptr_t start = ARENA_ALIGN_UP((uintptr_t)buffer);
+        uintptr_t end = (uintptr_t)buffer + size;
+        if (end > start) {
+            arena->buffer = (uint8_t *)start;
+            arena->buffer_size = (end - start) & ~(size_t)(MBED_ARENA_ALIGN - 1);
+        }
+    }
+    arena_rewind(arena);
+
+#if MBED_HEAP_STATS_ENABLED
+    core_util_critical_section_enter();
+    arena->next = arena_list;
+    arena_list = arena;
+    core_util_critical_section_exit();
+#endif
+}
+
+void mbed_arena_deinit(mbed_arena_t *arena)
+{
+    mbed_arena_reset(arena);
+
+#if MBED_HEAP_STATS_ENABLED
+    core_util_critical_section_enter();
+    mbed_arena_t **link = &arena_list;
+    while (*link != NULL && *link != arena) {
+        link = &(*link)->next;
+    }
+    if (*link != NULL) {
+        *link = arena->next;
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size)
+{
+    size_t aligned = ARENA_ALIGN_UP(size);
+    uint8_t *ptr;
+
+    if (aligned < size) {
+        arena->alloc_fail_cnt++;
+        return NULL;
+    }
+
+    if ((size_t)(arena->end - arena->ptr) >= aligned) {
+        ptr = arena->ptr;
+        arena->ptr += aligned;
+        arena->last = ptr;
+    } else {
+        if (arena->chunk_size == 0 || aligned > SIZE_MAX - CHUNK_HEADER_SIZE) {
+            arena->alloc_fail_cnt++;
+            return NULL;
+        }
+
+        // Larger allocations get a chunk of their own, the current one stays in use
+        bool dedicated = aligned > arena->chunk_size;
+        size_t chunk_size = dedicated ? aligned : arena->chunk_size;
+        mbed_arena_chunk_t *chunk = (mbed_arena_chunk_t *)malloc(CHUNK_HEADER_SIZE + chunk_size);
+        if (chunk == NULL) {
+            arena->alloc_fail_cnt++;
+            return NULL;
+        }
+        chunk->size = chunk_size;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        arena->reserved_size += CHUNK_HEADER_SIZE + chunk_size;
+
+        ptr = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+        if (dedicated) {
+            arena->last = NULL;
+        } else {
+            arena->ptr = ptr + aligned;
+            arena->end = ptr + chunk_size;
+            arena->last = ptr;
+        }
+    }
+
+    arena->current_size += aligned;
+    if (arena->current_size > arena->max_size) {
+        arena->max_size = arena->current_size;
+    }
+    arena->alloc_cnt++;
+    return ptr;
+}
+
+void *mbed_arena_calloc(mbed_arena_t *arena, size_t nmemb, size_t size)
+{
+    size_t total = nmemb * size;
+    if (size != 0 && total / size != nmemb) {
+        arena->alloc_fail_cnt++;
+        return NULL;
+    }
+
+    void *ptr = mbed_arena_alloc(arena, total);
+    if (ptr != NULL) {
+        memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+void mbed_arena_free(mbed_arena_t *arena, void *ptr)
+{
+    if (ptr != NULL && ptr == arena->last) {
+        arena->current_size -= arena->ptr - arena->last;
+        arena->ptr = arena->last;
+        arena->last = NULL;
+    }
+}
+
+void mbed_arena_reset(mbed_arena_t *arena)
+{
+    while (arena->chunks != NULL) {
+        mbed_arena_chunk_t *chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        free(chunk);
+    }
+    arena_rewind(arena);
+}
+
+size_t mbed_stats_arena_get_each(mbed_stats_arena_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_arena_t));
+    size_t i = 0;
+
+#if MBED_HEAP_STATS_ENABLED
+    core_util_critical_section_enter();
+    for (mbed_arena_t *arena = arena_list; arena != NULL && i < count; arena = arena->next, i++) {
+        stats[i].name = arena->name;
+        stats[i].current_size = arena->current_size;
+        stats[i].max_size = arena->max_size;
+        stats[i].reserved_size = arena->reserved_size;
+        stats[i].alloc_cnt = arena->alloc_cnt;
+        stats[i].alloc_fail_cnt = arena->alloc_fail_cnt;
+    }
+    core_util_critical_section_exit();
+#endif
+
+    return i;
+}
@@ -0,0 +1,97 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_clock_scaling.h"
+#include "platform/mbed_critical.h"
+#include <stddef.h>
+
+#if DEVICE_CLOCK_SCALING
+#include "hal/clock_scaling_api.h"
+#else
+#include "cmsis.h"
+#endif
+
+static mbed_clock_notifier_t *notifiers;
+
+void mbed_clock_notifier_add(mbed_clock_notifier_t *notifier)
+{
+    mbed_clock_notifier_t **last = &notifiers;
+
+    notifier->next = NULL;
+    core_util_critical_section_enter();
+    while (*last) {
+        last = &(*last)->next;
+    }
+    *last = notifier;
+    core_util_critical_section_exit();
+}
+
+void mbed_clock_notifier_remove(mbed_clock_notifier_t *notifier)
+{
+    core_util_critical_section_enter();
+    for (mbed_clock_notifier_t **n = &notifiers; *n; n = &(*n)->next) {
+        if (*n == notifier) {
+            *n = notifier->next;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+uint8_t mbed_clock_get_frequencies(uint32_t *frequencies, uint8_t size)
+{
+#if DEVICE_CLOCK_SCALING
+    return clock_scaling_get_frequencies(frequencies, size);
+#else
+    if (size) {
+        frequencies[0] = SystemCoreClock;
+    }
+    return 1;
+#endif
+}
+
+int mbed_clock_set_frequency(uint32_t frequency_hz)
+{
+    int ret = 0;
+
+    core_util_critical_section_enter();
+#if DEVICE_CLOCK_SCALING
+    if (frequency_hz != clock_scaling_get()) {
+        ret = clock_scaling_set(frequency_hz);
+        if (ret == 0) {
+            for (mbed_clock_notifier_t *n = notifiers; n; n = n->next) {
+                n->handler(n->context, frequency_hz);
+            }
+        }
+    }
+#else
+    if (frequency_hz != SystemCoreClock) {
+        ret = -1;
+    }
+#endif
+    core_util_critical_section_exit();
+    return ret;
+}
+
+uint32_t mbed_clock_get_frequency(void)
+{
+#if DEVICE_CLOCK_SCALING
+    return clock_scaling_get();
+#else
+    return SystemCoreClock;
+#endif
+}
@@ -0,0 +1,380 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_crash_dump.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/internal/mbed_fault_handler.h"
+
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+
+#if !DEVICE_FLASH
+#error "platform.crash-dump-enabled needs a target with the FLASH device"
+#endif
+#if !defined(MBED_CONF_PLATFORM_CRASH_DUMP_ADDRESS) || !defined(MBED_CONF_PLATFORM_CRASH_DUMP_SIZE)
+#error "platform.crash-dump-address and platform.crash-dump-size must be set to use platform.crash-dump-enabled"
+#endif
+
+#include "hal/flash_api.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtx_os.h"
+#endif
+
+#define CRASH_DUMP_START    ((uint32_t) MBED_CONF_PLATFORM_CRASH_DUMP_ADDRESS)
+#define CRASH_DUMP_END      (CRASH_DUMP_START + (uint32_t) MBED_CONF_PLATFORM_CRASH_DUMP_SIZE)
+
+MBED_STATIC_ASSERT(sizeof(mbed_crash_dump_header_t) <= MBED_CRASH_DUMP_HEADER_SIZE, "Crash dump header doesn't fit its slot");
+
+// Set at boot, by mbed_boot.c or mbed_sdk_boot.c
+extern unsigned char *mbed_stack_isr_start;
+extern uint32_t mbed_stack_isr_size;
+
+// Flash pages are programmed from this buffer, its size must be a multiple of the page size
+#define WRITE_BUFFER_SIZE   MBED_CRASH_DUMP_HEADER_SIZE
+
+// Static rather than on the stack, the stack may be what overflowed
+static struct {
+    flash_t flash;
+    uint32_t address;           // Flash address the buffer is programmed to
+    uint32_t used;              // Bytes in the buffer
+    uint32_t size;              // Bytes of records written
+    uint32_t crc;
+    bool truncated;
+    bool failed;
+    uint8_t buffer[WRITE_BUFFER_SIZE];
+} writer;
+
+// Bitwise CRC-32 as zlib, slow but small: a dump is written once
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, uint32_t size)
+{
+    crc = ~crc;
+    while (size--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void writer_flush(void)
+{
+    if (writer.used == 0 || writer.failed) {
+        return;
+    }
+    uint32_t page_size = flash_get_page_size(&writer.flash);
+    uint32_t size = (writer.used + page_size - 1) / page_size * page_size;
+    memset(writer.buffer + writer.used, flash_get_erase_value(&writer.flash), size - writer.used);
+    if (flash_program_page(&writer.flash, writer.address, writer.buffer, size) != 0) {
+        writer.failed = true;
+    }
+    writer.address += WRITE_BUFFER_SIZE;
+    writer.used = 0;
+}
+
+static void writer_put(const void *data, uint32_t size)
+{
+    const uint8_t *ptr = (const uint8_t *) data;
+    writer.crc = crc32_update(writer.crc, ptr, size);
+    writer.size += size;
+    while (size) {
+        uint32_t len = WRITE_BUFFER_SIZE - writer.used;
+        if (len > size) {
+            len = size;
+        }
+        memcpy(writer.buffer + writer.used, ptr, len);
+        writer.used += len;
+        ptr += len;
+        size -= len;
+        if (writer.used == WRITE_BUFFER_SIZE) {
+            writer_flush();
+        }
+    }
+}
+
+// Bytes of data a record can still take
+static uint32_t writer_space(void)
+{
+    uint32_t used = MBED_CRASH_DUMP_HEADER_SIZE + writer.size + sizeof(mbed_crash_dump_record_t);
+    uint32_t total = CRASH_DUMP_END - CRASH_DUMP_START;
+    return used < total ? (total - used) & ~3 : 0;
+}
+
+static void write_record(uint32_t type, uint32_t address, const void *data, uint32_t size)
+{
+    uint32_t space = writer_space();
+    if (size > space) {
+        writer.truncated = true;
+        if (space == 0 || type != MBED_CRASH_DUMP_RECORD_MEMORY) {
+            return;
+        }
+        size = space;
+    }
+    mbed_crash_dump_record_t record = { type, address, size };
+    writer_put(&record, sizeof(record));
+    writer_put(data, size);
+}
+
+static void write_memory(uint32_t start, uint32_t end)
+{
+    start &= ~3;
+    end = (end + 3) & ~3;
+    if (start < end) {
+        write_record(MBED_CRASH_DUMP_RECORD_MEMORY, start, (const void *) start, end - start);
+    }
+}
+
+static void capture_registers(mbed_crash_dump_header_t *header, const mbed_error_ctx *ctx)
+{
+    uint32_t *regs = header->regs;
+    if (ctx->error_status == MBED_ERROR_MEMMANAGE_EXCEPTION ||
+            ctx->error_status == MBED_ERROR_BUSFAULT_EXCEPTION ||
+            ctx->error_status == MBED_ERROR_USAGEFAULT_EXCEPTION ||
+            ctx->error_status == MBED_ERROR_HARDFAULT_EXCEPTION) {
+        memcpy(regs, (const void *) ctx->error_value, sizeof(mbed_fault_context_t));
+        header->flags |= MBED_CRASH_DUMP_FLAG_FAULT;
+        return;
+    }
+
+    // Registers of this function, a debugger unwinds from here to the caller of mbed_error
+#if defined(__GNUC__) && defined(__arm__)
+    __asm volatile(
+        "stmia  %0, {r0-r12}    \n"
+        "str    sp, [%0, #52]   \n"
+        "str    lr, [%0, #56]   \n"
+        "mov    r1, pc          \n"
+        "str    r1, [%0, #60]   \n"
+        : : "r"(regs) : "r1", "memory");
+#else
+    regs[13] = ctx->thread_current_sp;
+    regs[15] = ctx->error_address;
+#endif
+    regs[16] = __get_xPSR();
+    regs[17] = __get_PSP();
+    regs[18] = __get_MSP();
+    regs[19] = 0;
+    regs[20] = __get_CONTROL();
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+static void write_thread(const osRtxThread_t *thread, const mbed_crash_dump_header_t *header)
+{
+    mbed_crash_dump_thread_t info;
+    memset(&info, 0, sizeof(info));
+    info.sp = thread->sp;
+    info.stack_mem = (uint32_t) thread->stack_mem;
+    info.stack_size = thread->stack_size;
+    info.entry = thread->thread_addr;
+    info.state = thread->state;
+    info.stack_frame = thread->stack_frame;
+    info.priority = thread->priority;
+    if (thread == osRtxInfo.thread.run.curr) {
+        info.sp = header->regs[17];
+        info.is_current = 1;
+    }
+    if (thread->name) {
+        strncpy(info.name, thread->name, sizeof(info.name));
+    }
+    write_record(MBED_CRASH_DUMP_RECORD_THREAD, (uint32_t) thread, &info, sizeof(info));
+    write_memory((uint32_t) thread, (uint32_t) thread + sizeof(osRtxThread_t));
+}
+
+static void write_thread_stack(const osRtxThread_t *thread, uint32_t sp)
+{
+    uint32_t stack_start = (uint32_t) thread->stack_mem;
+    uint32_t stack_end = stack_start + thread->stack_size;
+    if (sp < stack_start || sp >= stack_end) {
+        // Overflowed or corrupted, only the stack contents are known to be readable
+        sp = stack_start;
+    }
+    write_memory(sp, stack_end);
+}
+
+typedef void (*thread_visitor_t)(const osRtxThread_t *thread, const mbed_crash_dump_header_t *header);
+
+static void visit_list(const osRtxThread_t *thread, bool delay_links, thread_visitor_t visitor, const mbed_crash_dump_header_t *header)
+{
+    // Bounded, the lists may be corrupted
+    for (int i = 0; thread != NULL && i < 64; i++) {
+        if (thread != osRtxInfo.thread.run.curr) {
+            visitor(thread, header);
+        }
+        thread = delay_links ? thread->delay_next : thread->thread_next;
+    }
+}
+
+static void visit_threads(thread_visitor_t visitor, const mbed_crash_dump_header_t *header)
+{
+    if (osRtxInfo.thread.run.curr != NULL) {
+        visitor(osRtxInfo.thread.run.curr, header);
+    }
+    visit_list(osRtxInfo.thread.ready.thread_list, false, visitor, header);
+    visit_list(osRtxInfo.thread.delay_list, true, visitor, header);
+    visit_list(osRtxInfo.thread.wait_list, true, visitor, header);
+}
+
+static void visit_stack(const osRtxThread_t *thread, const mbed_crash_dump_header_t *header)
+{
+    write_thread_stack(thread, thread->sp);
+}
+#endif
+
+mbed_error_status_t mbed_crash_dump_save(const mbed_error_ctx *ctx)
+{
+    static mbed_crash_dump_header_t header;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = MBED_CRASH_DUMP_MAGIC;
+    header.version = MBED_CRASH_DUMP_VERSION;
+    header.error_status = ctx->error_status;
+    header.error_value = ctx->error_value;
+    header.error_address = ctx->error_address;
+    header.thread_id = ctx->thread_id;
+    capture_registers(&header, ctx);
+
+    memset(&writer, 0, sizeof(writer));
+    if (flash_init(&writer.flash) != 0) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_INITIALIZATION_FAILED);
+    }
+    uint32_t page_size = flash_get_page_size(&writer.flash);
+    if (page_size > WRITE_BUFFER_SIZE || WRITE_BUFFER_SIZE % page_size != 0) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_UNSUPPORTED);
+    }
+    for (uint32_t address = CRASH_DUMP_START; address < CRASH_DUMP_END;) {
+        uint32_t sector_size = flash_get_sector_size(&writer.flash, address);
+        if (sector_size == 0 || flash_erase_sector(&writer.flash, address) != 0) {
+            return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_WRITE_FAILED);
+        }
+        address += sector_size;
+    }
+    writer.address = CRASH_DUMP_START + MBED_CRASH_DUMP_HEADER_SIZE;
+
+    // Most useful first, in case the area gets full: the stack which was running
+    uint32_t sp = header.regs[13];
+    bool on_msp;
+    if (header.flags & MBED_CRASH_DUMP_FLAG_FAULT) {
+        on_msp = !(header.regs[19] & 0x4);
+    } else {
+        on_msp = (header.regs[16] & 0x1FF) != 0 || !(header.regs[20] & 0x2);
+    }
+    if (on_msp) {
+        uint32_t isr_stack_start = (uint32_t) mbed_stack_isr_start;
+        uint32_t isr_stack_end = isr_stack_start + mbed_stack_isr_size;
+        write_memory(sp >= isr_stack_start && sp < isr_stack_end ? sp : isr_stack_start, isr_stack_end);
+    }
+#ifdef MBED_CONF_RTOS_PRESENT
+    if (osRtxInfo.thread.run.curr != NULL) {
+        write_thread_stack(osRtxInfo.thread.run.curr, on_msp ? header.regs[17] : sp);
+    }
+    visit_threads(write_thread, &header);
+    visit_threads(visit_stack, &header);
+#endif
+#if MBED_CONF_PLATFORM_CRASH_DUMP_RAM_SIZE > 0
+    write_memory(MBED_CONF_PLATFORM_CRASH_DUMP_RAM_START, MBED_CONF_PLATFORM_CRASH_DUMP_RAM_START + MBED_CONF_PLATFORM_CRASH_DUMP_RAM_SIZE);
+#endif
+    writer_flush();
+
+    // The header goes last, it makes the dump valid
+    header.size = writer.size;
+    header.crc = writer.crc;
+    if (writer.truncated) {
+        header.flags |= MBED_CRASH_DUMP_FLAG_TRUNCATED;
+    }
+    writer.address = CRASH_DUMP_START;
+    memset(writer.buffer, 0, sizeof(writer.buffer));
+    memcpy(writer.buffer, &header, sizeof(header));
+    writer.used = WRITE_BUFFER_SIZE;
+    writer_flush();
+
+    flash_free(&writer.flash);
+    if (writer.failed) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_WRITE_FAILED);
+    }
+    return MBED_SUCCESS;
+}
+
+uint32_t mbed_crash_dump_get_size(void)
+{
+    mbed_crash_dump_header_t header;
+    if (mbed_crash_dump_read(0, &header, sizeof(header)) != MBED_SUCCESS ||
+            header.magic != MBED_CRASH_DUMP_MAGIC || header.version != MBED_CRASH_DUMP_VERSION ||
+            header.size > CRASH_DUMP_END - CRASH_DUMP_START - MBED_CRASH_DUMP_HEADER_SIZE) {
+        return 0;
+    }
+
+    uint8_t buffer[64];
+    uint32_t crc = 0;
+    for (uint32_t offset = 0; offset < header.size; offset += sizeof(buffer)) {
+        uint32_t len = header.size - offset < sizeof(buffer) ? header.size - offset : sizeof(buffer);
+        if (mbed_crash_dump_read(MBED_CRASH_DUMP_HEADER_SIZE + offset, buffer, len) != MBED_SUCCESS) {
+            return 0;
+        }
+        crc = crc32_update(crc, buffer, len);
+    }
+    return crc == header.crc ? MBED_CRASH_DUMP_HEADER_SIZE + header.size : 0;
+}
+
+mbed_error_status_t mbed_crash_dump_read(uint32_t offset, void *buffer, uint32_t size)
+{
+    if (offset > CRASH_DUMP_END - CRASH_DUMP_START || size > CRASH_DUMP_END - CRASH_DUMP_START - offset) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_INVALID_ARGUMENT);
+    }
+    flash_t flash;
+    if (flash_init(&flash) != 0) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_INITIALIZATION_FAILED);
+    }
+    int32_t ret = flash_read(&flash, CRASH_DUMP_START + offset, (uint8_t *) buffer, size);
+    flash_free(&flash);
+    return ret == 0 ? MBED_SUCCESS : MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_READ_FAILED);
+}
+
+mbed_error_status_t mbed_crash_dump_erase(void)
+{
+    flash_t flash;
+    if (flash_init(&flash) != 0) {
+        return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_INITIALIZATION_FAILED);
+    }
+    // Erasing the header is enough to invalidate the dump
+    int32_t ret = flash_erase_sector(&flash, CRASH_DUMP_START);
+    flash_free(&flash);
+    return ret == 0 ? MBED_SUCCESS : MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_WRITE_FAILED);
+}
+
+#else
+
+mbed_error_status_t mbed_crash_dump_save(const mbed_error_ctx *ctx)
+{
+    return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_UNSUPPORTED);
+}
+
+uint32_t mbed_crash_dump_get_size(void)
+{
+    return 0;
+}
+
+mbed_error_status_t mbed_crash_dump_read(uint32_t offset, void *buffer, uint32_t size)
+{
+    return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_UNSUPPORTED);
+}
+
+mbed_error_status_t mbed_crash_dump_erase(void)
+{
+    return MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_UNSUPPORTED);
+}
+
+#endif // MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
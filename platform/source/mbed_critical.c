@@ -22,9 +22,57 @@
 #include "cmsis.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_toolchain.h"
+#include <string.h>
+
+#if defined(MBED_CRITICAL_STATS_ENABLED) && !defined(DWT)
+#error Critical section statistics require the DWT cycle counter (Cortex-M3 and above).
+#endif
 
 static uint32_t critical_section_reentrancy_counter = 0;
 
+#ifdef MBED_CRITICAL_STATS_ENABLED
+// All accessed with interrupts masked
+static uint32_t critical_stats_enter_stamp;
+static void *critical_stats_enter_caller;
+// Sorted, longest first
+static mbed_stats_critical_section_t critical_stats_longest[MBED_CONF_PLATFORM_CRITICAL_STATS_MAX];
+static mbed_stats_latency_t critical_stats_histogram;
+
+static void critical_stats_record(uint32_t cycles, void *caller)
+{
+    uint32_t us = (uint32_t)(((uint64_t)cycles * 1000000U) / SystemCoreClock);
+
+    unsigned bucket = 0;
+    while ((us >> (bucket + 1)) != 0 && bucket < MBED_STATS_LATENCY_BUCKETS - 1) {
+        bucket++;
+    }
+    critical_stats_histogram.bucket[bucket]++;
+    if (us > critical_stats_histogram.max_us) {
+        critical_stats_histogram.max_us = us;
+    }
+
+    // A caller keeps a single entry, its longest section
+    int i;
+    for (i = 0; i < MBED_CONF_PLATFORM_CRITICAL_STATS_MAX - 1; i++) {
+        if (critical_stats_longest[i].caller == caller || critical_stats_longest[i].cycles == 0) {
+            break;
+        }
+    }
+    if (cycles <= critical_stats_longest[i].cycles) {
+        return;
+    }
+    while (i > 0 && critical_stats_longest[i - 1].cycles < cycles) {
+        critical_stats_longest[i] = critical_stats_longest[i - 1];
+        i--;
+    }
+    critical_stats_longest[i].caller = caller;
+    critical_stats_longest[i].cycles = cycles;
+    critical_stats_longest[i].max_us = us;
+}
+#endif
+
 bool core_util_are_interrupts_enabled(void)
 {
 #if defined(__CORTEX_A9)
@@ -63,6 +111,18 @@ void core_util_critical_section_enter(void)
     MBED_ASSERT(critical_section_reentrancy_counter < UINT32_MAX);
 
     ++critical_section_reentrancy_counter;
+
+#ifdef MBED_CRITICAL_STATS_ENABLED
+    if (critical_section_reentrancy_counter == 1) {
+        if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+            CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+            DWT->CYCCNT = 0;
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        }
+        critical_stats_enter_caller = MBED_CALLER_ADDR();
+        critical_stats_enter_stamp = DWT->CYCCNT;
+    }
+#endif
 }
 
 void core_util_critical_section_exit(void)
@@ -76,6 +136,50 @@ void core_util_critical_section_exit(void)
     --critical_section_reentrancy_counter;
 
     if (critical_section_reentrancy_counter == 0) {
+#ifdef MBED_CRITICAL_STATS_ENABLED
+        critical_stats_record(DWT->CYCCNT - critical_stats_enter_stamp, critical_stats_enter_caller);
+#endif
         hal_critical_section_exit();
     }
 }
+
+size_t mbed_stats_critical_section_get_each(mbed_stats_critical_section_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_critical_section_t));
+    size_t i = 0;
+
+#ifdef MBED_CRITICAL_STATS_ENABLED
+    core_util_critical_section_enter();
+    for (; i < count && i < MBED_CONF_PLATFORM_CRITICAL_STATS_MAX; i++) {
+        if (critical_stats_longest[i].cycles == 0) {
+            break;
+        }
+        stats[i] = critical_stats_longest[i];
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
+
+void mbed_stats_critical_section_histogram_get(mbed_stats_latency_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_latency_t));
+
+#ifdef MBED_CRITICAL_STATS_ENABLED
+    core_util_critical_section_enter();
+    *stats = critical_stats_histogram;
+    core_util_critical_section_exit();
+#endif
+}
+
+void mbed_stats_critical_section_reset(void)
+{
+#ifdef MBED_CRITICAL_STATS_ENABLED
+    core_util_critical_section_enter();
+    memset(critical_stats_longest, 0, sizeof(critical_stats_longest));
+    memset(&critical_stats_histogram, 0, sizeof(critical_stats_histogram));
+    core_util_critical_section_exit();
+#endif
+}
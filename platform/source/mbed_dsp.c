@@ -0,0 +1,280 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_dsp.h"
+#include "platform/mbed_assert.h"
+#include "cmsis.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Pairs of samples are processed with the SIMD instructions of the DSP extension
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_SIMD    1
+#else
+#define DSP_SIMD    0
+#endif
+
+#define DSP_PI      3.14159265358979f
+
+/* Two samples, the first one in the lower half */
+static inline uint32_t read_x2(const void *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void write_x2(void *p, uint32_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline int16_t sat_q15(int64_t v)
+{
+    if (v > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (v < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)v;
+}
+
+static bool valid_fft_size(size_t n)
+{
+    return n >= 4 && n <= 4096 && (n & (n - 1)) == 0;
+}
+
+void mbed_dsp_adc_to_q15(const uint16_t *src, int16_t *dst, size_t count, uint8_t bits)
+{
+    MBED_ASSERT(bits >= 1 && bits <= 16);
+
+    const unsigned shift = 16 - bits;
+    const uint32_t mask = ((1UL << bits) - 1) * 0x00010001UL;
+
+    // Once masked, a pair of samples shifts without carrying from one to the other,
+    // and flipping the sign bits subtracts the middle of the range
+    for (; count >= 2; count -= 2, src += 2, dst += 2) {
+        write_x2(dst, ((read_x2(src) & mask) << shift) ^ 0x80008000UL);
+    }
+    if (count) {
+        *dst = (int16_t)(((uint16_t)(*src << shift)) ^ 0x8000);
+    }
+}
+
+void mbed_dsp_fir_decimate_q15_init(mbed_dsp_fir_decimate_q15_t *fir, const int16_t *coeffs, uint16_t taps,
+                                    uint16_t factor, int16_t *state, uint32_t max_block)
+{
+    MBED_ASSERT(taps > 0 && factor > 0);
+
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->factor = factor;
+    fir->max_block = max_block;
+    memset(state, 0, (taps - 1) * sizeof(int16_t));
+}
+
+static int64_t dot_q15(const int16_t *a, const int16_t *b, size_t n)
+{
+    int64_t acc = 0;
+#if DSP_SIMD
+    for (; n >= 4; n -= 4, a += 4, b += 4) {
+        acc = (int64_t)__SMLALD(read_x2(a), read_x2(b), (uint64_t)acc);
+        acc = (int64_t)__SMLALD(read_x2(a + 2), read_x2(b + 2), (uint64_t)acc);
+    }
+    if (n >= 2) {
+        acc = (int64_t)__SMLALD(read_x2(a), read_x2(b), (uint64_t)acc);
+        n -= 2;
+        a += 2;
+        b += 2;
+    }
+#endif
+    for (; n > 0; n--) {
+        acc += (int32_t)*a++ * *b++;
+    }
+    return acc;
+}
+
+size_t mbed_dsp_fir_decimate_q15(mbed_dsp_fir_decimate_q15_t *fir, const int16_t *src, int16_t *dst, size_t count)
+{
+    MBED_ASSERT(count <= fir->max_block && count % fir->factor == 0);
+
+    // The block follows the last samples of the previous one, so that src can be overwritten
+    int16_t *state = fir->state;
+    const size_t history = fir->taps - 1;
+    memcpy(state + history, src, count * sizeof(int16_t));
+
+    // The output for the input sample i covers state[i] to the sample, state[history + i]
+    size_t out = 0;
+    for (size_t i = fir->factor - 1; i < count; i += fir->factor) {
+        dst[out++] = sat_q15(dot_q15(fir->coeffs, state + i, fir->taps) >> 15);
+    }
+
+    memmove(state, state + count, history * sizeof(int16_t));
+    return out;
+}
+
+static int16_t float_to_q15(float v)
+{
+    return sat_q15((int64_t)(v * 32768.0f + (v >= 0 ? 0.5f : -0.5f)));
+}
+
+void mbed_dsp_rfft_q15_init(int16_t *twiddles, size_t n)
+{
+    MBED_ASSERT(valid_fft_size(n));
+
+    // cos and sin of 2 pi k / n, for k up to n / 2
+    for (size_t k = 0; k < n / 2; k++) {
+        float angle = 2 * DSP_PI * k / n;
+        twiddles[2 * k] = float_to_q15(cosf(angle));
+        twiddles[2 * k + 1] = float_to_q15(sinf(angle));
+    }
+}
+
+/* u, v = (u + w v) / 2, (u - w v) / 2 with w = c - j s */
+static inline void butterfly_q15(int16_t *u, int16_t *v, const int16_t *w)
+{
+#if DSP_SIMD
+    uint32_t a = read_x2(v);
+    uint32_t cs = read_x2(w);
+    int32_t re = __SSAT((int32_t)__SMUAD(a, cs) >> 15, 16);
+    int32_t im = __SSAT((int32_t)__SMUSDX(cs, a) >> 15, 16);
+    uint32_t t = __PKHBT(re, im, 16);
+    uint32_t b = read_x2(u);
+    write_x2(u, __SHADD16(b, t));
+    write_x2(v, __SHSUB16(b, t));
+#else
+    int32_t c = w[0];
+    int32_t s = w[1];
+    int32_t re = sat_q15((v[0] * c + v[1] * s) >> 15);
+    int32_t im = sat_q15((v[1] * c - v[0] * s) >> 15);
+    int32_t ur = u[0];
+    int32_t ui = u[1];
+    u[0] = (int16_t)((ur + re) >> 1);
+    u[1] = (int16_t)((ui + im) >> 1);
+    v[0] = (int16_t)((ur - re) >> 1);
+    v[1] = (int16_t)((ui - im) >> 1);
+#endif
+}
+
+/* Complex FFT of the m points of z, the twiddles being those of a transform of n */
+static void cfft_q15(int16_t *z, size_t m, const int16_t *twiddles, size_t n)
+{
+    for (size_t i = 1, j = 0; i < m; i++) {
+        size_t bit = m >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            uint32_t t = read_x2(z + 2 * i);
+            write_x2(z + 2 * i, read_x2(z + 2 * j));
+            write_x2(z + 2 * j, t);
+        }
+    }
+
+    for (size_t len = 2; len <= m; len <<= 1) {
+        const size_t half = len / 2;
+        const size_t step = n / len;
+        for (size_t j = 0; j < half; j++) {
+            const int16_t *w = twiddles + 2 * j * step;
+            for (size_t i = j; i < m; i += len) {
+                butterfly_q15(z + 2 * i, z + 2 * (i + half), w);
+            }
+        }
+    }
+}
+
+/* Spectrum of the n real samples from the complex FFT of their n / 2 pairs */
+static void rfft_split_q15(int16_t *z, size_t n, const int16_t *twiddles)
+{
+    const size_t m = n / 2;
+
+    int32_t r0 = z[0];
+    int32_t i0 = z[1];
+    z[0] = (int16_t)((r0 + i0) >> 1);
+    z[1] = (int16_t)((r0 - i0) >> 1);
+
+    // Bins k and m - k come from the same two points, as the even and the odd samples
+    for (size_t k = 1; k <= m / 2; k++) {
+        int16_t *p = z + 2 * k;
+        int16_t *q = z + 2 * (m - k);
+        int32_t ar = p[0];
+        int32_t ai = p[1];
+        int32_t br = q[0];
+        int32_t bi = -q[1];
+
+        int32_t er = (ar + br) >> 1;
+        int32_t ei = (ai + bi) >> 1;
+        int32_t or_ = (ai - bi) >> 1;
+        int32_t oi = (br - ar) >> 1;
+
+        int32_t c = twiddles[2 * k];
+        int32_t s = twiddles[2 * k + 1];
+        int32_t wr = (c * or_ + s * oi) >> 15;
+        int32_t wi = (c * oi - s * or_) >> 15;
+
+        if (q != p) {
+            q[0] = sat_q15((er - wr) >> 1);
+            q[1] = sat_q15(-((ei - wi) >> 1));
+        }
+        p[0] = sat_q15((er + wr) >> 1);
+        p[1] = sat_q15((ei + wi) >> 1);
+    }
+}
+
+void mbed_dsp_rfft_q15(int16_t *data, size_t n, const int16_t *twiddles)
+{
+    MBED_ASSERT(valid_fft_size(n));
+
+    cfft_q15(data, n / 2, twiddles, n);
+    rfft_split_q15(data, n, twiddles);
+}
+
+static uint32_t isqrt(uint32_t v)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void mbed_dsp_rfft_mag_q15(int16_t *data, size_t n)
+{
+    int32_t dc = data[0];
+    data[0] = sat_q15(dc < 0 ? -dc : dc);
+
+    // Bin k is read from data[2k] before data[k] is written
+    for (size_t k = 1; k < n / 2; k++) {
+        int32_t re = data[2 * k];
+        int32_t im = data[2 * k + 1];
+        data[k] = sat_q15(isqrt((uint32_t)(re * re) + (uint32_t)(im * im)));
+    }
+}
@@ -21,6 +21,7 @@
 #include "platform/source/mbed_crash_data_offsets.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_crash_dump.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_interface.h"
 #include "platform/mbed_power_mgmt.h"
@@ -93,6 +94,11 @@ WEAK MBED_NORETURN void error(const char *format, ...)
     // Prevent recursion if error is called again during store+print attempt
     if (!core_util_atomic_exchange_bool(&mbed_error_in_progress, true)) {
         handle_error(MBED_ERROR_UNKNOWN, 0, NULL, 0, MBED_CALLER_ADDR());
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+        core_util_critical_section_enter();
+        mbed_crash_dump_save(&last_error_ctx);
+        core_util_critical_section_exit();
+#endif
         ERROR_REPORT(&last_error_ctx, "Fatal Run-time error", NULL, 0);
 
 #ifndef NDEBUG
@@ -298,6 +304,13 @@ WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_stat
         //set the error reported
         (void) handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
 
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+        //Dump before the report, printing is much slower
+        core_util_critical_section_enter();
+        mbed_crash_dump_save(&last_error_ctx);
+        core_util_critical_section_exit();
+#endif
+
         //On fatal errors print the error context/report
         ERROR_REPORT(&last_error_ctx, error_msg, filename, line_number);
     }
@@ -19,6 +19,9 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include "platform/mbed_mem_trace.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "hal/us_ticker_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
@@ -37,6 +40,16 @@ static SingletonPtr<PlatformMutex> mem_trace_mutex;
 
 #define TRACE_FIRST_LOCK() (trace_lock_count < 2)
 
+/* Ring buffer of 'mbed_mem_trace_ring_callback'. The callback runs under
+ * 'mem_trace_mutex' so there is a single writer, which only updates
+ * 'ring_head', and a single reader, which only updates 'ring_tail'. */
+static mbed_mem_trace_record_t *ring_buffer;
+static uint32_t ring_mask;
+static uint32_t ring_head;
+static uint32_t ring_tail;
+static uint32_t ring_dropped;
+static uint16_t ring_seq;
+
 
 /******************************************************************************
  * Public interface
@@ -151,3 +164,84 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...)
     }
     va_end(va);
 }
+
+void mbed_mem_trace_ring_init(mbed_mem_trace_record_t *buffer, size_t count)
+{
+    MBED_ASSERT(count > 0 && (count & (count - 1)) == 0);
+    mbed_mem_trace_lock();
+    ring_buffer = buffer;
+    ring_mask = count - 1;
+    ring_head = 0;
+    core_util_atomic_store_u32(&ring_tail, 0);
+    ring_dropped = 0;
+    ring_seq = 0;
+    mbed_mem_trace_unlock();
+}
+
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...)
+{
+    uint16_t seq = ring_seq++;
+    uint32_t head = ring_head;
+    if (!ring_buffer || head - core_util_atomic_load_u32(&ring_tail) > ring_mask) {
+        ring_dropped++;
+        return;
+    }
+
+    mbed_mem_trace_record_t *record = &ring_buffer[head & ring_mask];
+    record->timestamp = us_ticker_read();
+    record->seq = seq;
+    record->op = op;
+    record->reserved = 0;
+    record->res = (uint32_t)(uintptr_t)res;
+    record->caller = (uint32_t)(uintptr_t)caller;
+
+    va_list va;
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            record->arg1 = va_arg(va, size_t);
+            record->arg2 = 0;
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            record->arg1 = (uint32_t)(uintptr_t)va_arg(va, void *);
+            record->arg2 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            record->arg1 = va_arg(va, size_t);
+            record->arg2 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            record->arg1 = (uint32_t)(uintptr_t)va_arg(va, void *);
+            record->arg2 = 0;
+            break;
+
+        default:
+            record->arg1 = 0;
+            record->arg2 = 0;
+    }
+    va_end(va);
+
+    // Publish the record once it is complete
+    core_util_atomic_store_u32(&ring_head, head + 1);
+}
+
+size_t mbed_mem_trace_ring_read(mbed_mem_trace_record_t *records, size_t count)
+{
+    uint32_t tail = ring_tail;
+    uint32_t available = core_util_atomic_load_u32(&ring_head) - tail;
+    size_t n = available < count ? available : count;
+
+    for (size_t i = 0; i < n; i++) {
+        records[i] = ring_buffer[(tail + i) & ring_mask];
+    }
+    core_util_atomic_store_u32(&ring_tail, tail + n);
+    return n;
+}
+
+uint32_t mbed_mem_trace_ring_dropped(void)
+{
+    return ring_dropped;
+}
@@ -100,6 +100,18 @@ struct timed_predicate_op {
         return wake_time == wake_time.max() || os_timer->wake_time_set();
     }
 
+    uint32_t idle_time_us() const
+    {
+        if (wake_time == wake_time.max()) {
+            return UINT32_MAX;
+        }
+        auto idle = std::chrono::duration_cast<std::chrono::microseconds>(wake_time - OsClock::reported_ticks());
+        if (idle <= idle.zero()) {
+            return 0;
+        }
+        return idle.count() < UINT32_MAX ? (uint32_t) idle.count() : UINT32_MAX - 1;
+    }
+
 private:
     OsClock::time_point wake_time;
     bool (*orig_predicate)(void *);
@@ -126,6 +138,11 @@ struct untimed_op {
         return true;
     }
 
+    uint32_t idle_time_us() const
+    {
+        return UINT32_MAX;
+    }
+
 private:
     bool (*orig_predicate)(void *);
     void *orig_handle;
@@ -151,6 +168,9 @@ void do_sleep_operation(OpT &op)
         // If no target sleep function, nothing else to do - just keep
         // rechecking the wake condition.
 #if DEVICE_SLEEP
+#if MBED_CONF_PLATFORM_IDLE_GOVERNOR_ENABLED
+        uint32_t idle_us = op.idle_time_us();
+#endif
         // Now we need to enter the critical section for the race-free sleep
         {
             CriticalSectionLock lock;
@@ -166,7 +186,11 @@ void do_sleep_operation(OpT &op)
             // we go round to set the timer again.
             if (op.sleep_prepared()) {
                 // Enter HAL sleep (normal or deep)
+#if MBED_CONF_PLATFORM_IDLE_GOVERNOR_ENABLED
+                sleep_manager_sleep_governed(idle_us);
+#else
                 sleep();
+#endif
             }
         }
 
@@ -16,35 +16,171 @@
  */
 #include "mbed_poll.h"
 #include "FileHandle.h"
+#include "PollSet.h"
+#include "mbed_critical.h"
 #include "mbed_thread.h"
+#include <errno.h>
+#ifdef MBED_CONF_RTOS_API_PRESENT
+#include "platform/SingletonPtr.h"
+#include "rtos/EventFlags.h"
+#endif
 
 namespace mbed {
 
+using internal::poll_waiter;
+
+/*
+ * The poll() calls and the PollSets register a waiter. poll_notify() runs in any
+ * context: it only walks the waiters in a critical section and sets the event flags
+ * of those watching the file handle, out of the critical section as an RTOS call
+ * from a thread can't be made with the interrupts disabled. A waiter examines its
+ * file handles again when woken, after clearing its flag, so a notification racing
+ * with the examination is not lost.
+ */
+
+// Period of the examination of the file handles that don't notify their changes
+#define POLL_RESCAN_MS      1
+
+// Flags of the waiters, bit 31 of the RTOS event flags is reserved
+#define POLL_FLAGS_ALL      0x7FFFFFFFu
+
+static poll_waiter *poll_waiters;
+static uint32_t poll_flags_used;
+
+#ifdef MBED_CONF_RTOS_API_PRESENT
+static SingletonPtr<rtos::EventFlags> poll_flags;
+#endif
+
+static void waiter_register(poll_waiter *waiter)
+{
+    waiter->waiting = false;
+    core_util_critical_section_enter();
+    uint32_t free = ~poll_flags_used & POLL_FLAGS_ALL;
+    waiter->flag = free & -free;
+    poll_flags_used |= waiter->flag;
+    waiter->next = poll_waiters;
+    poll_waiters = waiter;
+    core_util_critical_section_exit();
+}
+
+static void waiter_unregister(poll_waiter *waiter)
+{
+    core_util_critical_section_enter();
+    for (poll_waiter **p = &poll_waiters; *p; p = &(*p)->next) {
+        if (*p == waiter) {
+            *p = waiter->next;
+            break;
+        }
+    }
+    poll_flags_used &= ~waiter->flag;
+    core_util_critical_section_exit();
+}
+
+/* Start of an examination of the file handles, before blocking in waiter_wait */
+static void waiter_arm(poll_waiter *waiter)
+{
+#ifdef MBED_CONF_RTOS_API_PRESENT
+    if (waiter->flag) {
+        poll_flags->clear(waiter->flag);
+    }
+#endif
+    core_util_critical_section_enter();
+    waiter->waiting = true;
+    core_util_critical_section_exit();
+}
+
+static void waiter_disarm(poll_waiter *waiter)
+{
+    core_util_critical_section_enter();
+    waiter->waiting = false;
+    core_util_critical_section_exit();
+}
+
+/* Block until a notification or for timeout milliseconds, timeout -1 forever */
+static void waiter_wait(poll_waiter *waiter, int timeout, bool rescan)
+{
+#ifdef MBED_CONF_RTOS_API_PRESENT
+    if (waiter->flag) {
+        if (rescan && (timeout < 0 || timeout > POLL_RESCAN_MS)) {
+            timeout = POLL_RESCAN_MS;
+        }
+        poll_flags->wait_any_for(waiter->flag, timeout < 0 ? rtos::Kernel::wait_for_u32_forever :
+                                 rtos::Kernel::Clock::duration_u32(timeout));
+        return;
+    }
+#endif
+    // Not woken by the notifications, examine the file handles periodically
+    thread_sleep_for(timeout < 0 || timeout > POLL_RESCAN_MS ? POLL_RESCAN_MS : timeout);
+}
+
+/* Remaining time of a timeout started at start_time, -1 forever, 0 when expired */
+static int remaining_time(int timeout, uint64_t start_time)
+{
+    if (timeout < 0) {
+        return -1;
+    }
+    int64_t elapsed = get_ms_count() - start_time;
+    return elapsed >= timeout ? 0 : int(timeout - elapsed);
+}
+
+void poll_notify(const FileHandle *fh)
+{
+    uint32_t flags = 0;
+    core_util_critical_section_enter();
+    for (poll_waiter *waiter = poll_waiters; waiter; waiter = waiter->next) {
+        bool watched = false;
+        if (waiter->set) {
+            watched = waiter->set->mark_pending(fh);
+        } else {
+            for (unsigned n = 0; n < waiter->nfhs && !watched; n++) {
+                watched = waiter->fhs[n].fh == fh;
+            }
+        }
+        if (watched && waiter->waiting) {
+            flags |= waiter->flag;
+        }
+    }
+    core_util_critical_section_exit();
+#ifdef MBED_CONF_RTOS_API_PRESENT
+    // Only set once a waiter created the flags
+    if (flags) {
+        poll_flags->set(flags);
+    }
+#endif
+}
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
-    /*
-     * TODO Proper wake-up mechanism.
-     * In order to correctly detect availability of read/write a FileHandle, we needed
-     * a select or poll mechanisms. We opted for poll as POSIX defines in
-     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html Currently,
-     * mbed::poll() just spins and scans filehandles looking for any events we are
-     * interested in. In future, his spinning behaviour will be replaced with
-     * condition variables.
-     */
     uint64_t start_time = 0;
     if (timeout > 0) {
         start_time = get_ms_count();
     }
 
+    poll_waiter waiter;
+    waiter.fhs = fhs;
+    waiter.nfhs = nfhs;
+    waiter.set = nullptr;
+    if (timeout != 0) {
+        waiter_register(&waiter);
+    }
+
     int count = 0;
     for (;;) {
+        if (timeout != 0) {
+            waiter_arm(&waiter);
+        }
+
         /* Scan the file handles */
+        bool rescan = false;
         for (unsigned n = 0; n < nfhs; n++) {
             FileHandle *fh = fhs[n].fh;
             short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
             if (fh) {
                 fhs[n].revents = fh->poll(mask) & mask;
+                if (!fh->poll_notifies()) {
+                    rescan = true;
+                }
             } else {
                 fhs[n].revents = POLLNVAL;
             }
@@ -57,14 +193,162 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
             break;
         }
 
-        /* Nothing selected - this is where timeout handling would be needed */
-        if (timeout == 0 || (timeout > 0 && int64_t(get_ms_count() - start_time) > timeout)) {
+        int remaining = remaining_time(timeout, start_time);
+        if (remaining == 0) {
             break;
         }
-        // TODO - proper blocking
-        // wait for condition variable, wait queue whatever here
-        thread_sleep_for(1);
+        waiter_wait(&waiter, remaining, rescan);
     }
+
+    if (timeout != 0) {
+        waiter_disarm(&waiter);
+        waiter_unregister(&waiter);
+    }
+    return count;
+}
+
+PollSetBase::PollSetBase(entry *entries, unsigned capacity) :
+    _entries(entries), _capacity(capacity), _count(0), _next(0)
+{
+    _waiter.fhs = nullptr;
+    _waiter.nfhs = 0;
+    _waiter.set = this;
+    // Registered for its lifetime, to keep the notifications received between the waits
+    waiter_register(&_waiter);
+}
+
+PollSetBase::~PollSetBase()
+{
+    waiter_unregister(&_waiter);
+}
+
+PollSetBase::entry *PollSetBase::find(const FileHandle *fh)
+{
+    for (unsigned i = 0; i < _count; i++) {
+        if (_entries[i].fh == fh) {
+            return &_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+// Called from poll_notify(), in a critical section
+bool PollSetBase::mark_pending(const FileHandle *fh)
+{
+    entry *e = find(fh);
+    if (e) {
+        e->pending = true;
+    }
+    return e != nullptr;
+}
+
+int PollSetBase::add(FileHandle *fh, short events)
+{
+    if (fh == nullptr) {
+        return -EINVAL;
+    }
+    if (find(fh)) {
+        return -EEXIST;
+    }
+    if (_count == _capacity) {
+        return -ENOMEM;
+    }
+
+    entry e;
+    e.fh = fh;
+    e.events = events;
+    e.revents = 0;
+    e.notifies = fh->poll_notifies();
+    e.pending = true;
+    core_util_critical_section_enter();
+    _entries[_count++] = e;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int PollSetBase::modify(FileHandle *fh, short events)
+{
+    entry *e = find(fh);
+    if (e == nullptr) {
+        return -ENOENT;
+    }
+    core_util_critical_section_enter();
+    e->events = events;
+    e->pending = true;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+int PollSetBase::remove(FileHandle *fh)
+{
+    entry *e = find(fh);
+    if (e == nullptr) {
+        return -ENOENT;
+    }
+    core_util_critical_section_enter();
+    *e = _entries[--_count];
+    core_util_critical_section_exit();
+    if (_next >= _count) {
+        _next = 0;
+    }
+    return 0;
+}
+
+int PollSetBase::wait(pollfh ready[], unsigned max, int timeout)
+{
+    if (max == 0) {
+        return -EINVAL;
+    }
+
+    uint64_t start_time = 0;
+    if (timeout > 0) {
+        start_time = get_ms_count();
+    }
+
+    int count = 0;
+    for (;;) {
+        waiter_arm(&_waiter);
+
+        bool rescan = false;
+        unsigned last = _next;
+        for (unsigned n = 0; n < _count; n++) {
+            unsigned i = (_next + n) % _count;
+            entry *e = &_entries[i];
+
+            core_util_critical_section_enter();
+            bool check = e->pending || e->revents || !e->notifies;
+            e->pending = false;
+            core_util_critical_section_exit();
+
+            if (check) {
+                short mask = e->events | POLLERR | POLLHUP | POLLNVAL;
+                e->revents = e->fh->poll(mask) & mask;
+            }
+            if (!e->notifies) {
+                rescan = true;
+            }
+            if (e->revents && unsigned(count) < max) {
+                ready[count].fh = e->fh;
+                ready[count].events = e->events;
+                ready[count].revents = e->revents;
+                count++;
+                last = i;
+            }
+        }
+
+        if (count) {
+            _next = (last + 1) % _count;
+            break;
+        }
+
+        int remaining = remaining_time(timeout, start_time);
+        if (remaining == 0) {
+            break;
+        }
+        waiter_wait(&_waiter, remaining, rescan);
+    }
+
+    waiter_disarm(&_waiter);
     return count;
 }
 
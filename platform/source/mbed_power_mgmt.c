@@ -254,6 +254,93 @@ void sleep_manager_sleep_auto(void)
     core_util_critical_section_exit();
 }
 
+#if MBED_CONF_PLATFORM_IDLE_GOVERNOR_ENABLED && DEVICE_LPTICKER
+#define GOVERNOR_DEPTHS_MAX 8
+
+// Average ratio of the time slept to the time to the deadline, in 1/1024:
+// below 1024 when interrupts tend to wake up the target before its deadlines
+static uint32_t governor_residency_ratio = 1024;
+// Exit latencies measured from the wakes past the deadline
+static uint32_t governor_latency_us[GOVERNOR_DEPTHS_MAX];
+
+static uint8_t governor_select(const hal_sleep_depth_t *depths, uint8_t count, uint32_t idle_us)
+{
+    uint64_t predicted_us = ((uint64_t)idle_us * governor_residency_ratio) >> 10;
+#ifdef MBED_DEBUG
+    bool can_deep = false;
+#else
+    bool can_deep = sleep_manager_can_deep_sleep();
+#endif
+    uint8_t depth = 0;
+
+    for (uint8_t i = 1; i < count; i++) {
+        uint32_t latency_us = depths[i].exit_latency_us;
+        if (governor_latency_us[i] > latency_us) {
+            latency_us = governor_latency_us[i];
+        }
+        if ((depths[i].deep && !can_deep) || predicted_us < depths[i].min_residency_us || latency_us >= idle_us) {
+            break;
+        }
+        depth = i;
+    }
+    return depth;
+}
+
+void sleep_manager_sleep_governed(uint32_t idle_us)
+{
+#ifdef MBED_SLEEP_TRACING_ENABLED
+    sleep_tracker_print_stats();
+#endif
+    uint8_t count;
+    const hal_sleep_depth_t *depths = hal_sleep_get_depths(&count);
+    if (count > GOVERNOR_DEPTHS_MAX) {
+        count = GOVERNOR_DEPTHS_MAX;
+    }
+    const ticker_data_t *ticker = get_lp_ticker_data();
+
+    core_util_critical_section_enter();
+    uint8_t depth = governor_select(depths, count, idle_us);
+
+    us_timestamp_t start = ticker_read_us(ticker);
+    hal_sleep_depth(depth);
+    us_timestamp_t slept_us = ticker_read_us(ticker) - start;
+
+    if (idle_us != 0 && idle_us != UINT32_MAX) {
+        uint32_t ratio = slept_us >= idle_us ? 1024 : (uint32_t)((slept_us << 10) / idle_us);
+        governor_residency_ratio = (governor_residency_ratio * 7 + ratio) / 8;
+
+        // Woken up by the deadline: the lateness is the exit latency. Decays
+        // slowly, so that occasional fast wakes don't hide the slow ones.
+        if (slept_us > idle_us) {
+            uint32_t late_us = (uint32_t)(slept_us - idle_us);
+            if (late_us > governor_latency_us[depth]) {
+                governor_latency_us[depth] = late_us;
+            } else {
+                governor_latency_us[depth] -= (governor_latency_us[depth] - late_us) / 16;
+            }
+        }
+    }
+
+#if defined(MBED_CPU_STATS_ENABLED)
+    if (depths[depth].deep) {
+        deep_sleep_time += slept_us;
+    } else {
+        sleep_time += slept_us;
+    }
+#endif
+    core_util_critical_section_exit();
+}
+
+#else
+
+void sleep_manager_sleep_governed(uint32_t idle_us)
+{
+    (void)idle_us;
+    sleep_manager_sleep_auto();
+}
+
+#endif // MBED_CONF_PLATFORM_IDLE_GOVERNOR_ENABLED && DEVICE_LPTICKER
+
 #else
 
 // locking is valid only if DEVICE_SLEEP is defined
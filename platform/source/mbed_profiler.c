@@ -0,0 +1,271 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+#include "hal/itm_api.h"
+#include "cmsis.h"
+#include <string.h>
+
+#if MBED_CONF_PLATFORM_PROFILER_ENTRIES
+
+// Slots probed for a new address before its sample is dropped, bounding the time in the interrupt
+#define PROFILER_MAX_PROBES     8
+
+// The sampling interrupt handler needs GCC-style inline assembly to read the stacked PC
+#if defined(__CORTEX_M) && defined(__GNUC__)
+#define PROFILER_TIMER_HANDLER  1
+#else
+#define PROFILER_TIMER_HANDLER  0
+#endif
+
+static mbed_profiler_entry_t profiler_table[MBED_CONF_PLATFORM_PROFILER_ENTRIES];
+static mbed_profiler_stats_t profiler_stats;
+
+void mbed_profiler_sample(uint32_t pc)
+{
+    core_util_critical_section_enter();
+    profiler_stats.samples++;
+    // Thumb instructions are halfword aligned
+    uint32_t index = ((pc >> 1) * 2654435761u) % MBED_CONF_PLATFORM_PROFILER_ENTRIES;
+    for (uint32_t i = 0; i < PROFILER_MAX_PROBES && i < MBED_CONF_PLATFORM_PROFILER_ENTRIES; i++) {
+        mbed_profiler_entry_t *entry = &profiler_table[index];
+        if (entry->count == 0) {
+            entry->pc = pc;
+            entry->count = 1;
+            profiler_stats.entries++;
+            core_util_critical_section_exit();
+            return;
+        }
+        if (entry->pc == pc) {
+            entry->count++;
+            core_util_critical_section_exit();
+            return;
+        }
+        index = (index + 1) % MBED_CONF_PLATFORM_PROFILER_ENTRIES;
+    }
+    profiler_stats.dropped++;
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_reset(void)
+{
+    core_util_critical_section_enter();
+    memset(profiler_table, 0, sizeof(profiler_table));
+    profiler_stats.samples = 0;
+    profiler_stats.dropped = 0;
+    profiler_stats.entries = 0;
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    memcpy(stats, &profiler_stats, sizeof(mbed_profiler_stats_t));
+    core_util_critical_section_exit();
+}
+
+size_t mbed_profiler_get_each(mbed_profiler_entry_t *entries, size_t count)
+{
+    size_t filled = 0;
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_PROFILER_ENTRIES && filled < count; i++) {
+        // One entry at a time, not to hold off the sampling for the whole table
+        core_util_critical_section_enter();
+        entries[filled] = profiler_table[i];
+        core_util_critical_section_exit();
+        if (entries[filled].count != 0) {
+            filled++;
+        }
+    }
+    return filled;
+}
+
+void mbed_profiler_dump(FILE *stream)
+{
+    if (stream == NULL) {
+        stream = stdout;
+    }
+
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    fprintf(stream, MBED_PROFILER_PREFIX "%lu;%lu;%lu\n", (unsigned long)stats.samples,
+            (unsigned long)stats.dropped, (unsigned long)stats.period_us);
+
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_PROFILER_ENTRIES; i++) {
+        core_util_critical_section_enter();
+        mbed_profiler_entry_t entry = profiler_table[i];
+        core_util_critical_section_exit();
+        if (entry.count != 0) {
+            fprintf(stream, MBED_PROFILER_PREFIX "%lx;%lu\n", (unsigned long)entry.pc, (unsigned long)entry.count);
+        }
+    }
+    fflush(stream);
+}
+
+#if PROFILER_TIMER_HANDLER
+static int profiler_irq = -1;
+
+void mbed_profiler_timer_sample(uint32_t pc);
+
+MBED_USED void mbed_profiler_timer_sample(uint32_t pc)
+{
+    mbed_profiler_timer_clear();
+    mbed_profiler_sample(pc);
+}
+
+/* Interrupt handler of the profiler timer. It finds the exception frame of the
+ * interrupted code on the stack named by EXC_RETURN, and branches with the
+ * stacked PC to mbed_profiler_timer_sample. LR still holds EXC_RETURN, so
+ * returning from mbed_profiler_timer_sample returns from the exception.
+ * Written for ARMv6-M, to run on all the Cortex-M cores. */
+__attribute__((naked)) static void profiler_timer_handler(void)
+{
+    __asm volatile(
+        ".syntax unified\n"
+        "    movs    r0, #4\n"
+        "    mov     r1, lr\n"
+        "    tst     r0, r1\n"
+        "    beq     1f\n"
+        "    mrs     r0, psp\n"
+        "    b       2f\n"
+        "1:  mrs     r0, msp\n"
+        "2:  ldr     r0, [r0, #24]\n"
+        "    ldr     r1, =mbed_profiler_timer_sample\n"
+        "    bx      r1\n"
+        "    .ltorg\n"
+    );
+}
+#endif // PROFILER_TIMER_HANDLER
+
+int mbed_profiler_start(uint32_t period_us)
+{
+#if PROFILER_TIMER_HANDLER
+    if (period_us == 0 || profiler_irq >= 0) {
+        return -1;
+    }
+    int irq = mbed_profiler_timer_start(period_us);
+    if (irq < 0) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    profiler_irq = irq;
+    profiler_stats.period_us = period_us;
+    core_util_critical_section_exit();
+
+    NVIC_SetVector((IRQn_Type)irq, (uint32_t)profiler_timer_handler);
+    NVIC_SetPriority((IRQn_Type)irq, (1UL << __NVIC_PRIO_BITS) - 1);
+    NVIC_EnableIRQ((IRQn_Type)irq);
+    return 0;
+#else
+    (void)period_us;
+    return -1;
+#endif
+}
+
+void mbed_profiler_stop(void)
+{
+#if PROFILER_TIMER_HANDLER
+    if (profiler_irq < 0) {
+        return;
+    }
+    NVIC_DisableIRQ((IRQn_Type)profiler_irq);
+    mbed_profiler_timer_stop();
+    NVIC_ClearPendingIRQ((IRQn_Type)profiler_irq);
+
+    core_util_critical_section_enter();
+    profiler_irq = -1;
+    profiler_stats.period_us = 0;
+    core_util_critical_section_exit();
+#endif
+}
+
+#else // MBED_CONF_PLATFORM_PROFILER_ENTRIES
+
+void mbed_profiler_sample(uint32_t pc)
+{
+    (void)pc;
+}
+
+void mbed_profiler_reset(void)
+{
+}
+
+void mbed_profiler_get_stats(mbed_profiler_stats_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_profiler_stats_t));
+}
+
+size_t mbed_profiler_get_each(mbed_profiler_entry_t *entries, size_t count)
+{
+    (void)entries;
+    (void)count;
+    return 0;
+}
+
+void mbed_profiler_dump(FILE *stream)
+{
+    (void)stream;
+}
+
+int mbed_profiler_start(uint32_t period_us)
+{
+    (void)period_us;
+    return -1;
+}
+
+void mbed_profiler_stop(void)
+{
+}
+
+#endif // MBED_CONF_PLATFORM_PROFILER_ENTRIES
+
+int mbed_profiler_itm_start(void)
+{
+#if DEVICE_ITM && defined(DWT_CTRL_PCSAMPLENA_Msk)
+    if (DWT->CTRL & DWT_CTRL_NOTRCPKT_Msk) {
+        return -1;
+    }
+    mbed_itm_init();
+    DWT->CTRL |= DWT_CTRL_PCSAMPLENA_Msk;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void mbed_profiler_itm_stop(void)
+{
+#if DEVICE_ITM && defined(DWT_CTRL_PCSAMPLENA_Msk)
+    DWT->CTRL &= ~DWT_CTRL_PCSAMPLENA_Msk;
+#endif
+}
+
+MBED_WEAK int mbed_profiler_timer_start(uint32_t period_us)
+{
+    (void)period_us;
+    return -1;
+}
+
+MBED_WEAK void mbed_profiler_timer_clear(void)
+{
+}
+
+MBED_WEAK void mbed_profiler_timer_stop(void)
+{
+}
@@ -16,6 +16,7 @@
  */
 
 #include <mstd_mutex>
+#include <new>
 #include <time.h>
 #include "platform/platform.h"
 #include "platform/FilePath.h"
@@ -30,6 +31,8 @@
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_poll.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_thread.h"
 #include "drivers/BufferedSerial.h"
 #include "hal/us_ticker_api.h"
 #include "hal/lp_ticker_api.h"
@@ -108,14 +111,121 @@ uint32_t mbed_heap_size = 0;
 
 /* newlib has the filehandle field in the FILE struct as a short, so
  * we can't just return a Filehandle* from _open and instead have to
- * put it in a filehandles array and return the index into that array
+ * put it in a filehandles table and return the index into that table.
+ *
+ * The first RETARGET_OPEN_MAX descriptors are static. Further descriptors
+ * live in chunks of platform.fd-table-chunk-size entries, allocated when the
+ * lower descriptors are all in use and never freed, so looking a descriptor
+ * up needs no lock; only allocating one takes filehandle_mutex.
+ *
+ * Each call on a descriptor holds a reference on its entry for the duration
+ * of the call. If close() finds the descriptor in use, the FileHandle is
+ * closed by the last user to drop its reference, and the descriptor is not
+ * reused until then.
  */
-static FileHandle *filehandles[RETARGET_OPEN_MAX] = { FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED };
+struct filehandle_entry {
+    FileHandle *volatile fh;
+    FileHandle *closing_fh;
+    volatile uint32_t state;    // references, and FILE_HANDLE_CLOSING
+    char in_prev;
+    char out_prev;
+};
+
+#define FILE_HANDLE_CLOSING     0x80000000u
+
+static filehandle_entry filehandles[RETARGET_OPEN_MAX] = {
+    { FILE_HANDLE_RESERVED }, { FILE_HANDLE_RESERVED }, { FILE_HANDLE_RESERVED }
+};
+#if MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS > 0
+static filehandle_entry *volatile filehandle_chunks[MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS];
+#endif
 static SingletonPtr<PlatformMutex> filehandle_mutex;
-#endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 
-static char stdio_in_prev[RETARGET_OPEN_MAX];
-static char stdio_out_prev[RETARGET_OPEN_MAX];
+static filehandle_entry *filehandle_lookup(int fd)
+{
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fd < RETARGET_OPEN_MAX) {
+        return &filehandles[fd];
+    }
+#if MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS > 0
+    unsigned idx = fd - RETARGET_OPEN_MAX;
+    if (idx / MBED_CONF_PLATFORM_FD_TABLE_CHUNK_SIZE < MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS) {
+        filehandle_entry *chunk = core_util_atomic_load(&filehandle_chunks[idx / MBED_CONF_PLATFORM_FD_TABLE_CHUNK_SIZE]);
+        if (chunk) {
+            return &chunk[idx % MBED_CONF_PLATFORM_FD_TABLE_CHUNK_SIZE];
+        }
+    }
+#endif
+    return NULL;
+}
+
+/* Finish a close() deferred to the last user, unless another user did */
+static int filehandle_finish_close(filehandle_entry *entry)
+{
+    FileHandle *fh = entry->closing_fh;
+    uint32_t expected = FILE_HANDLE_CLOSING;
+    if (!core_util_atomic_cas_u32(&entry->state, &expected, 0)) {
+        return 0;
+    }
+    return fh->close();
+}
+
+namespace {
+/* Reference on the FileHandle bound to a descriptor, held for one call */
+class FileHandleRef {
+public:
+    explicit FileHandleRef(int fd) : _entry(filehandle_lookup(fd)), _fh(NULL)
+    {
+        if (_entry) {
+            core_util_atomic_incr_u32(&_entry->state, 1);
+            _fh = mbed_file_handle(fd);
+        }
+    }
+
+    ~FileHandleRef()
+    {
+        if (_entry && core_util_atomic_decr_u32(&_entry->state, 1) == FILE_HANDLE_CLOSING) {
+            filehandle_finish_close(_entry);
+        }
+    }
+
+    FileHandle *get() const
+    {
+        return _fh;
+    }
+
+private:
+    filehandle_entry *_entry;
+    FileHandle *_fh;
+};
+}
+
+static char &stdio_in_prev(int fd)
+{
+    return filehandle_lookup(fd)->in_prev;
+}
+
+static char &stdio_out_prev(int fd)
+{
+    return filehandle_lookup(fd)->out_prev;
+}
+
+#else
+static char stdio_in_prev_table[RETARGET_OPEN_MAX];
+static char stdio_out_prev_table[RETARGET_OPEN_MAX];
+
+static char &stdio_in_prev(int fd)
+{
+    return stdio_in_prev_table[fd];
+}
+
+static char &stdio_out_prev(int fd)
+{
+    return stdio_out_prev_table[fd];
+}
+#endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 
 namespace mbed {
 void mbed_set_unbuffered_stream(std::FILE *_file);
@@ -123,14 +233,11 @@ void mbed_set_unbuffered_stream(std::FILE *_file);
 void remove_filehandle(FileHandle *file)
 {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
-    filehandle_mutex->lock();
     /* Remove all open filehandles for this */
-    for (unsigned int fh_i = 0; fh_i < sizeof(filehandles) / sizeof(*filehandles); fh_i++) {
-        if (filehandles[fh_i] == file) {
-            filehandles[fh_i] = NULL;
-        }
+    for (int fd = 0; filehandle_entry *entry = filehandle_lookup(fd); fd++) {
+        FileHandle *expected = file;
+        core_util_atomic_compare_exchange_strong(&entry->fh, &expected, NULL);
     }
-    filehandle_mutex->unlock();
 #endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 }
 }
@@ -240,6 +347,197 @@ short DirectSerial::poll(short events) const
     }
     return revents;
 }
+
+#if MBED_CONF_PLATFORM_STDIO_ASYNC_TXBUF_SIZE && !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+/* Private FileHandle for stdout/stderr writes that don't wait for the UART.
+ * Output is copied to a ring drained by the TX interrupt, or by DMA on
+ * targets with SERIAL_DMA. When the ring is full, writes wait for space or
+ * drop the output, as set by platform.stdio-async-drop.
+ *
+ * Writes from a critical section empty the ring and complete before
+ * returning, so that the error reports written by mbed_error_puts follow
+ * the pending output and are out before the system halts.
+ */
+class AsyncSerial : public DirectSerial {
+public:
+    AsyncSerial(const serial_pinmap_t &static_pinmap, int baud);
+    virtual ssize_t write(const void *buffer, size_t size);
+    virtual int sync();
+    virtual short poll(short events) const;
+
+private:
+    static void irq_handler(uint32_t id, SerialIrq event);
+    void start_tx();
+    void tx_irq();
+    void drain();
+
+    static const uint32_t BufferSize = MBED_CONF_PLATFORM_STDIO_ASYNC_TXBUF_SIZE;
+    static_assert((BufferSize & (BufferSize - 1)) == 0, "platform.stdio-async-txbuf-size must be a power of two");
+
+    char _buf[BufferSize];
+    /* Free-running, the ring holds _head - _tail bytes */
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+    /* Bytes read by the active DMA transfer */
+    volatile uint32_t _tx_len;
+    volatile bool _tx_active;
+    bool _dma;
+};
+
+AsyncSerial::AsyncSerial(const serial_pinmap_t &static_pinmap, int baud) :
+    DirectSerial(static_pinmap, baud),
+    _head(0), _tail(0), _tx_len(0), _tx_active(false), _dma(false)
+{
+#if DEVICE_SERIAL_DMA
+    _dma = serial_tx_dma_enable(&stdio_uart) == 0;
+#endif
+    serial_irq_handler(&stdio_uart, irq_handler, (uint32_t)this);
+}
+
+void AsyncSerial::irq_handler(uint32_t id, SerialIrq event)
+{
+    if (event == TxIrq) {
+        ((AsyncSerial *)id)->tx_irq();
+    }
+}
+
+/* Called with interrupts disabled */
+void AsyncSerial::start_tx()
+{
+    if (_tx_active || _head == _tail) {
+        return;
+    }
+    _tx_active = true;
+#if DEVICE_SERIAL_DMA
+    if (_dma) {
+        uint32_t offset = _tail & (BufferSize - 1);
+        uint32_t len = _head - _tail;
+        if (len > BufferSize - offset) {
+            len = BufferSize - offset;
+        }
+        _tx_len = len;
+        serial_tx_dma_write(&stdio_uart, &_buf[offset], len);
+    }
+#endif
+    /* Without DMA, the interrupt fires right away if the UART is ready */
+    serial_irq_set(&stdio_uart, TxIrq, 1);
+}
+
+void AsyncSerial::tx_irq()
+{
+#if DEVICE_SERIAL_DMA
+    if (_dma) {
+        if (!_tx_active || serial_tx_dma_active(&stdio_uart)) {
+            return;
+        }
+        _tail += _tx_len;
+        _tx_len = 0;
+        _tx_active = false;
+        start_tx();
+        if (!_tx_active) {
+            serial_irq_set(&stdio_uart, TxIrq, 0);
+        }
+        return;
+    }
+#endif
+    while (_head != _tail && serial_writable(&stdio_uart)) {
+        serial_putc(&stdio_uart, _buf[_tail & (BufferSize - 1)]);
+        _tail++;
+    }
+    if (_head == _tail) {
+        serial_irq_set(&stdio_uart, TxIrq, 0);
+        _tx_active = false;
+    }
+}
+
+/* Send the whole ring before returning, called with interrupts disabled */
+void AsyncSerial::drain()
+{
+#if DEVICE_SERIAL_DMA
+    if (_dma) {
+        for (;;) {
+            if (_tx_active) {
+                while (serial_tx_dma_active(&stdio_uart)) {
+                }
+                _tail += _tx_len;
+                _tx_len = 0;
+                _tx_active = false;
+            }
+            if (_head == _tail) {
+                break;
+            }
+            start_tx();
+        }
+        serial_irq_set(&stdio_uart, TxIrq, 0);
+        return;
+    }
+#endif
+    serial_irq_set(&stdio_uart, TxIrq, 0);
+    _tx_active = false;
+    while (_head != _tail) {
+        serial_putc(&stdio_uart, _buf[_tail & (BufferSize - 1)]);
+        _tail++;
+    }
+}
+
+ssize_t AsyncSerial::write(const void *buffer, size_t size)
+{
+    const char *buf = static_cast<const char *>(buffer);
+    const bool in_critical = core_util_in_critical_section();
+    size_t written = 0;
+
+    while (written < size) {
+        core_util_critical_section_enter();
+        uint32_t offset = _head & (BufferSize - 1);
+        uint32_t len = BufferSize - (_head - _tail);
+        if (len > size - written) {
+            len = size - written;
+        }
+        uint32_t first = len < BufferSize - offset ? len : BufferSize - offset;
+        memcpy(&_buf[offset], buf + written, first);
+        memcpy(&_buf[0], buf + written + first, len - first);
+        _head += len;
+        written += len;
+        if (in_critical) {
+            drain();
+        } else {
+            start_tx();
+        }
+        core_util_critical_section_exit();
+
+        if (written < size && !in_critical) {
+            if (MBED_CONF_PLATFORM_STDIO_ASYNC_DROP || core_util_is_isr_active()) {
+                break;
+            }
+            thread_sleep_for(1);
+        }
+    }
+
+    return size;
+}
+
+int AsyncSerial::sync()
+{
+    if (core_util_in_critical_section()) {
+        drain();
+        return 0;
+    }
+    while (_head != _tail) {
+        thread_sleep_for(1);
+    }
+    return 0;
+}
+
+short AsyncSerial::poll(short events) const
+{
+    short revents = DirectSerial::poll(events & ~POLLOUT);
+    if ((events & POLLOUT) && _head - _tail < BufferSize) {
+        revents |= POLLOUT;
+    }
+    return revents;
+}
+#endif // MBED_CONF_PLATFORM_STDIO_ASYNC_TXBUF_SIZE && !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+
 #if MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 #   if MBED_CONF_TARGET_CONSOLE_UART
 
@@ -327,7 +625,10 @@ static FileHandle *default_console()
 {
 #if MBED_CONF_TARGET_CONSOLE_UART && DEVICE_SERIAL
 
-#  if MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL
+#  if MBED_CONF_PLATFORM_STDIO_ASYNC_TXBUF_SIZE
+    static const serial_pinmap_t console_pinmap = get_uart_pinmap(STDIO_UART_TX, STDIO_UART_RX);
+    static AsyncSerial console(console_pinmap, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
+#  elif MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL
     static const serial_pinmap_t console_pinmap = get_uart_pinmap(STDIO_UART_TX, STDIO_UART_RX);
     static BufferedSerial console(console_pinmap, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
 #   if   CONSOLE_FLOWCONTROL == CONSOLE_FLOWCONTROL_RTS
@@ -370,14 +671,19 @@ namespace mbed {
 FileHandle *mbed_file_handle(int fd)
 {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
-    if (fd >= RETARGET_OPEN_MAX) {
+    filehandle_entry *entry = filehandle_lookup(fd);
+    if (entry == NULL) {
         return NULL;
     }
-    FileHandle *fh = filehandles[fd];
+    FileHandle *fh = core_util_atomic_load(&entry->fh);
     if (fh == FILE_HANDLE_RESERVED && fd < 3) {
-        filehandles[fd] = fh = get_console(fd);
+        FileHandle *expected = FILE_HANDLE_RESERVED;
+        fh = get_console(fd);
+        if (!core_util_atomic_compare_exchange_strong(&entry->fh, &expected, fh)) {
+            fh = expected;
+        }
     }
-    return fh;
+    return fh == FILE_HANDLE_RESERVED ? NULL : fh;
 #else
     return nullptr;
 #endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
@@ -397,7 +703,7 @@ static int handle_open_errors(int error, unsigned filehandle_idx)
 {
     errno = -error;
     // Free file handle
-    filehandles[filehandle_idx] = NULL;
+    core_util_atomic_store(&filehandle_lookup(filehandle_idx)->fh, (FileHandle *)NULL);
     return -1;
 }
 
@@ -454,19 +760,32 @@ static int reserve_filehandle()
     // find the first empty slot in filehandles, after the slots reserved for stdin/stdout/stderr
     filehandle_mutex->lock();
     int fh_i;
-    for (fh_i = 3; fh_i < RETARGET_OPEN_MAX; fh_i++) {
-        /* Take a next free filehandle slot available. */
-        if (filehandles[fh_i] == NULL) {
+    filehandle_entry *entry;
+    for (fh_i = 3; (entry = filehandle_lookup(fh_i)) != NULL; fh_i++) {
+        /* Take a next free filehandle slot available, not still being closed. */
+        if (core_util_atomic_load(&entry->fh) == NULL && core_util_atomic_load(&entry->state) == 0) {
             break;
         }
     }
-    if (fh_i >= RETARGET_OPEN_MAX) {
+#if MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS > 0
+    if (entry == NULL) {
+        unsigned chunk_i = (fh_i - RETARGET_OPEN_MAX) / MBED_CONF_PLATFORM_FD_TABLE_CHUNK_SIZE;
+        if (chunk_i < MBED_CONF_PLATFORM_FD_TABLE_MAX_CHUNKS) {
+            filehandle_entry *chunk = new (std::nothrow) filehandle_entry[MBED_CONF_PLATFORM_FD_TABLE_CHUNK_SIZE]();
+            if (chunk) {
+                core_util_atomic_store(&filehandle_chunks[chunk_i], chunk);
+                entry = chunk;
+            }
+        }
+    }
+#endif
+    if (entry == NULL) {
         /* Too many file handles have been opened */
         errno = EMFILE;
         filehandle_mutex->unlock();
         return -1;
     }
-    filehandles[fh_i] = FILE_HANDLE_RESERVED;
+    core_util_atomic_store(&entry->fh, FILE_HANDLE_RESERVED);
     filehandle_mutex->unlock();
 
     return fh_i;
@@ -480,17 +799,18 @@ int mbed::bind_to_fd(FileHandle *fh)
         return fildes;
     }
 
-    filehandles[fildes] = fh;
-    stdio_in_prev[fildes] = 0;
-    stdio_out_prev[fildes] = 0;
+    filehandle_entry *entry = filehandle_lookup(fildes);
+    entry->in_prev = 0;
+    entry->out_prev = 0;
+    core_util_atomic_store(&entry->fh, fh);
 
     return fildes;
 }
 
 static int unbind_from_fd(int fd, FileHandle *fh)
 {
-    if (filehandles[fd] == fh) {
-        filehandles[fd] = NULL;
+    FileHandle *expected = fh;
+    if (core_util_atomic_compare_exchange_strong(&filehandle_lookup(fd)->fh, &expected, NULL)) {
         return 0;
     } else {
         errno = EBADF;
@@ -625,9 +945,10 @@ extern "C" int open(const char *name, int oflag, ...)
         }
     }
 
-    filehandles[fildes] = res;
-    stdio_in_prev[fildes] = 0;
-    stdio_out_prev[fildes] = 0;
+    filehandle_entry *entry = filehandle_lookup(fildes);
+    entry->in_prev = 0;
+    entry->out_prev = 0;
+    core_util_atomic_store(&entry->fh, res);
 
     return fildes;
 }
@@ -645,14 +966,20 @@ extern "C" int PREFIX(_close)(FILEHANDLE fh)
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 extern "C" int close(int fildes)
 {
+    filehandle_entry *entry = filehandle_lookup(fildes);
     FileHandle *fhc = mbed_file_handle(fildes);
-    filehandles[fildes] = NULL;
-    if (fhc == NULL) {
+    if (fhc == NULL || !core_util_atomic_compare_exchange_strong(&entry->fh, &fhc, (FileHandle *)NULL)) {
         errno = EBADF;
         return -1;
     }
 
-    int err = fhc->close();
+    /* Leave the close to the last call still using the descriptor, if any */
+    entry->closing_fh = fhc;
+    if (core_util_atomic_fetch_or_u32(&entry->state, FILE_HANDLE_CLOSING) != 0) {
+        return 0;
+    }
+
+    int err = filehandle_finish_close(entry);
     if (err < 0) {
         errno = -err;
         return -1;
@@ -697,8 +1024,8 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
 
     if (convert_crlf(fh)) {
         // local prev is previous in buffer during seek
-        // stdio_out_prev[fh] is last thing actually written
-        char prev = stdio_out_prev[fh];
+        // stdio_out_prev(fh) is last thing actually written
+        char prev = stdio_out_prev(fh);
         // Seek for '\n' without preceding '\r'; if found flush
         // preceding and insert '\r'. Continue until end of input.
         for (ssize_t cur = 0; cur < slength; cur++) {
@@ -715,7 +1042,7 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
                         // For some reason, didn't write all - give up now
                         goto finish;
                     }
-                    stdio_out_prev[fh] = prev;
+                    stdio_out_prev(fh) = prev;
                 }
                 // insert a \r now, leaving the \n still to be written
                 r = write(fh, "\r", 1);
@@ -725,7 +1052,7 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
                 if (r < 1) {
                     goto finish;
                 }
-                stdio_out_prev[fh] = '\r';
+                stdio_out_prev(fh) = '\r';
             }
             prev = buffer[cur];
         }
@@ -739,7 +1066,7 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
         }
         written += r;
         if (written > 0) {
-            stdio_out_prev[fh] = buffer[written - 1];
+            stdio_out_prev(fh) = buffer[written - 1];
         }
     }
 
@@ -771,7 +1098,8 @@ extern "C" ssize_t write(int fildes, const void *buf, size_t length)
 
     ssize_t ret = length;
 #else
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -843,17 +1171,17 @@ extern "C" int PREFIX(_read)(FILEHANDLE fh, unsigned char *buffer, unsigned int
             if (r == 0) {
                 return bytes_read;
             }
-            if ((c == '\r' && stdio_in_prev[fh] != '\n') ||
-                    (c == '\n' && stdio_in_prev[fh] != '\r')) {
-                stdio_in_prev[fh] = c;
+            if ((c == '\r' && stdio_in_prev(fh) != '\n') ||
+                    (c == '\n' && stdio_in_prev(fh) != '\r')) {
+                stdio_in_prev(fh) = c;
                 *buffer = '\n';
                 break;
-            } else if ((c == '\r' && stdio_in_prev[fh] == '\n') ||
-                       (c == '\n' && stdio_in_prev[fh] == '\r')) {
-                stdio_in_prev[fh] = c;
+            } else if ((c == '\r' && stdio_in_prev(fh) == '\n') ||
+                       (c == '\n' && stdio_in_prev(fh) == '\r')) {
+                stdio_in_prev(fh) = c;
                 continue;
             } else {
-                stdio_in_prev[fh] = c;
+                stdio_in_prev(fh) = c;
                 *buffer = c;
                 break;
             }
@@ -895,7 +1223,8 @@ extern "C" ssize_t read(int fildes, void *buf, size_t length)
     ssize_t ret = 1;
 
 #else
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -938,7 +1267,8 @@ extern "C" int _isatty(FILEHANDLE fh)
 extern "C" int isatty(int fildes)
 {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return 0;
@@ -989,7 +1319,8 @@ int _lseek(FILEHANDLE fh, int offset, int whence)
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 extern "C" off_t lseek(int fildes, off_t offset, int whence)
 {
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1005,7 +1336,8 @@ extern "C" off_t lseek(int fildes, off_t offset, int whence)
 
 extern "C" int ftruncate(int fildes, off_t length)
 {
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1031,7 +1363,8 @@ extern "C" int PREFIX(_ensure)(FILEHANDLE fh)
 extern "C" int fsync(int fildes)
 {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1054,7 +1387,8 @@ extern "C" int fsync(int fildes)
 extern "C" long PREFIX(_flen)(FILEHANDLE fh)
 {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
-    FileHandle *fhc = mbed_file_handle(fh);
+    FileHandleRef ref(fh);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1152,7 +1486,8 @@ extern "C" int _fstat(int fh, struct stat *st)
 
 extern "C" int fstat(int fildes, struct stat *st)
 {
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1165,7 +1500,8 @@ extern "C" int fstat(int fildes, struct stat *st)
 
 extern "C" int fcntl(int fildes, int cmd, ...)
 {
-    FileHandle *fhc = mbed_file_handle(fildes);
+    FileHandleRef ref(fildes);
+    FileHandle *fhc = ref.get();
     if (fhc == NULL) {
         errno = EBADF;
         return -1;
@@ -1700,10 +2036,10 @@ extern "C" void __cxa_guard_abort(int *guard_object_p)
 
 #endif
 
-#if defined(MBED_MEM_TRACING_ENABLED) && (defined(__ARMCC_VERSION) || defined(__ICCARM__))
+#if (defined(MBED_MEM_TRACING_ENABLED) || MBED_HEAP_STATS_SITES) && (defined(__ARMCC_VERSION) || defined(__ICCARM__))
 
-// If the memory tracing is enabled, the wrappers in mbed_alloc_wrappers.cpp
-// provide the implementation for these. Note: this needs to use the wrappers
+// If the memory tracing or the heap stats of the allocation sites are enabled,
+// the wrappers in mbed_alloc_wrappers.cpp provide the implementation for these. Note: this needs to use the wrappers
 // instead of malloc()/free() as the caller address would point to wrappers,
 // not the caller of "new" or "delete".
 extern "C" void *malloc_wrapper(size_t size, const void *caller);
@@ -1757,7 +2093,7 @@ void operator delete[](void *ptr, std::size_t)
     free_wrapper(ptr, MBED_CALLER_ADDR());
 }
 
-#elif defined(MBED_MEM_TRACING_ENABLED) && defined(__GNUC__)
+#elif (defined(MBED_MEM_TRACING_ENABLED) || MBED_HEAP_STATS_SITES) && defined(__GNUC__)
 
 #include <reent.h>
 
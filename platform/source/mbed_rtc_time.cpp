@@ -15,7 +15,10 @@
  * limitations under the License.
  */
 #include "hal/rtc_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
 
+#include <errno.h>
 #include "platform/mbed_rtc_time.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
@@ -29,6 +32,44 @@ static int (*_rtc_isenabled)(void) = rtc_isenabled;
 static time_t (*_rtc_read)(void) = rtc_read;
 static void (*_rtc_write)(time_t t) = rtc_write;
 
+#if DEVICE_RTC_SUBSECOND && DEVICE_LPTICKER
+
+#define RTC_TIME_SUBSECOND 1
+
+static const us_timestamp_t _rtc_resync_period = MBED_CONF_PLATFORM_RTC_TIME_RESYNC_PERIOD * 1000000ULL;
+
+// Time since the epoch minus the low power ticker time, in microseconds
+static int64_t _rtc_offset;
+static us_timestamp_t _rtc_synced_at;
+static bool _rtc_synced;
+
+/* The calendar of the RTC is only read and converted once per resync period,
+ * the low power ticker elapsed since is added to that reading in between */
+static bool _rtc_read_timeval(struct timeval *tv)
+{
+    // An attached RTC has seconds only
+    if (_rtc_read != rtc_read) {
+        return false;
+    }
+
+    us_timestamp_t now = ticker_read_us(get_lp_ticker_data());
+    if (!_rtc_synced || now - _rtc_synced_at >= _rtc_resync_period) {
+        uint32_t usec;
+        time_t t = rtc_read_subsecond(&usec);
+        now = ticker_read_us(get_lp_ticker_data());
+        _rtc_offset = (int64_t)t * 1000000 + usec - (int64_t)now;
+        _rtc_synced_at = now;
+        _rtc_synced = true;
+    }
+
+    int64_t t = (int64_t)now + _rtc_offset;
+    tv->tv_sec = t / 1000000;
+    tv->tv_usec = t % 1000000;
+    return true;
+}
+
+#endif /* DEVICE_RTC_SUBSECOND && DEVICE_LPTICKER */
+
 #elif DEVICE_LPTICKER
 
 #include "drivers/LowPowerTimer.h"
@@ -66,6 +107,20 @@ static int (*_rtc_isenabled)(void) = _rtc_lpticker_isenabled;
 static time_t (*_rtc_read)(void) = _rtc_lpticker_read;
 static void (*_rtc_write)(time_t t) = _rtc_lpticker_write;
 
+static bool _rtc_read_timeval(struct timeval *tv)
+{
+    if (_rtc_read != _rtc_lpticker_read) {
+        return false;
+    }
+
+    microseconds t = _rtc_lp_timer->elapsed_time();
+    tv->tv_sec = duration_cast<seconds>(t).count() + _rtc_lp_base;
+    tv->tv_usec = (t % seconds(1)).count();
+    return true;
+}
+
+#define RTC_TIME_SUBSECOND 1
+
 #else /* DEVICE_LPTICKER */
 
 static void (*_rtc_init)(void) = NULL;
@@ -87,6 +142,9 @@ int settimeofday(const struct timeval *tv, MBED_UNUSED const struct timezone *tz
     if (_rtc_write != NULL) {
         _rtc_write(tv->tv_sec);
     }
+#if DEVICE_RTC && RTC_TIME_SUBSECOND
+    _rtc_synced = false;
+#endif
     _mutex->unlock();
 
     return 0;
@@ -101,6 +159,13 @@ int gettimeofday(struct timeval *tv, MBED_UNUSED void *tz)
         }
     }
 
+#if RTC_TIME_SUBSECOND
+    if (_rtc_read_timeval(tv)) {
+        _mutex->unlock();
+        return 0;
+    }
+#endif
+
     time_t t = (time_t) - 1;
     if (_rtc_read != NULL) {
         t = _rtc_read();
@@ -130,6 +195,33 @@ time_t time(time_t *timer)
     return tv.tv_sec;
 }
 
+#if MBED_RTC_TIME_CLOCK_GETTIME
+int clock_gettime(clockid_t clock_id, struct timespec *tp)
+{
+    if (clock_id == CLOCK_REALTIME) {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        tp->tv_sec = tv.tv_sec;
+        tp->tv_nsec = tv.tv_usec * 1000;
+        return 0;
+    }
+
+    if (clock_id == CLOCK_MONOTONIC) {
+#if DEVICE_LPTICKER
+        us_timestamp_t t = ticker_read_us(get_lp_ticker_data());
+#else
+        us_timestamp_t t = us_ticker_read_us();
+#endif
+        tp->tv_sec = t / 1000000;
+        tp->tv_nsec = (t % 1000000) * 1000;
+        return 0;
+    }
+
+    errno = EINVAL;
+    return -1;
+}
+#endif /* MBED_RTC_TIME_CLOCK_GETTIME */
+
 
 void set_time(time_t t)
 {
@@ -144,6 +236,9 @@ void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init
     _rtc_write = write_rtc;
     _rtc_init = init_rtc;
     _rtc_isenabled = isenabled_rtc;
+#if DEVICE_RTC && RTC_TIME_SUBSECOND
+    _rtc_synced = false;
+#endif
     _mutex->unlock();
 }
 
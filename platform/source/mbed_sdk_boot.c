@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "cmsis.h"
 #include "hal/us_ticker_api.h"
+#include "platform/mbed_stats.h"
 
 /* This startup is for baremetal. There is no RTOS in baremetal,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT.
@@ -87,10 +88,13 @@ void mbed_init(void)
     SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 #endif
 #endif
+    mbed_stats_boot_mark("mbed_init");
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark("sdk_init");
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
+    mbed_stats_boot_mark("us_ticker");
 #endif
 }
 
@@ -137,8 +141,11 @@ int $Sub$$main(void)
     _platform_post_stackheap_init();
 #endif
     mbed_toolchain_init();
+    mbed_stats_boot_mark("static_init");
     mbed_main();
+    mbed_stats_boot_mark("mbed_main");
     mbed_error_initialize();
+    mbed_stats_boot_mark("main");
     return $Super$$main();
 }
 
@@ -172,8 +179,12 @@ void software_init_hook(void)
 
 int __wrap_main(void)
 {
+    // The C library has run the static initializers
+    mbed_stats_boot_mark("static_init");
     mbed_main();
+    mbed_stats_boot_mark("mbed_main");
     mbed_error_initialize();
+    mbed_stats_boot_mark("main");
     return __real_main();
 }
 
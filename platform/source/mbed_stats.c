@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 #include "platform/mbed_stats.h"
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_version.h"
@@ -24,7 +25,8 @@
 #include "device.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
-#elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED)
+#include "rtx_os.h"
+#elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_THREAD_CPU_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
 
@@ -32,6 +34,14 @@
 #warning CPU statistics are not supported without sleep support.
 #endif
 
+#if defined(MBED_THREAD_CPU_STATS_ENABLED) && !defined(DWT)
+#error Thread CPU statistics require the DWT cycle counter (Cortex-M3 and above).
+#endif
+
+#if defined(MBED_BOOT_STATS_ENABLED) && !defined(DWT)
+#error Boot statistics require the DWT cycle counter (Cortex-M3 and above).
+#endif
+
 void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -45,6 +55,7 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 }
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+// note: mbed_stats_critical_section_* defined in mbed_critical.c
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -110,6 +121,117 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     return i;
 }
 
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+static mbed_stats_stack_peak_t stack_peaks[MBED_CONF_PLATFORM_STACK_STATS_PEAKS_MAX];
+
+/* FNV-1a, the name pointer itself may change from one build to the next */
+static uint32_t stack_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261U;
+    if (name != NULL) {
+        while (*name) {
+            hash = (hash ^ (uint8_t)*name++) * 16777619U;
+        }
+    }
+    return hash;
+}
+
+/* Free slots have a 0 reserved size */
+static mbed_stats_stack_peak_t *stack_peak_find(uint32_t name_hash)
+{
+    mbed_stats_stack_peak_t *free_slot = NULL;
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_STACK_STATS_PEAKS_MAX; i++) {
+        if (stack_peaks[i].reserved_size == 0) {
+            if (free_slot == NULL) {
+                free_slot = &stack_peaks[i];
+            }
+        } else if (stack_peaks[i].name_hash == name_hash) {
+            return &stack_peaks[i];
+        }
+    }
+    if (free_slot != NULL) {
+        free_slot->name_hash = name_hash;
+        free_slot->name = NULL;
+        free_slot->max_size = 0;
+    }
+    return free_slot;
+}
+#endif
+
+void mbed_stats_stack_sample(void)
+{
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    // Also called by the idle thread, which must not block: no malloc
+    osThreadId_t threads[MBED_CONF_PLATFORM_STACK_STATS_PEAKS_MAX];
+
+    osKernelLock();
+    uint32_t thread_n = osThreadEnumerate(threads, MBED_CONF_PLATFORM_STACK_STATS_PEAKS_MAX);
+
+    for (uint32_t i = 0; i < thread_n; i++) {
+        const char *name = osThreadGetName(threads[i]);
+        mbed_stats_stack_peak_t *peak = stack_peak_find(stack_name_hash(name));
+        if (peak == NULL) {
+            continue;
+        }
+        uint32_t stack_size = osThreadGetStackSize(threads[i]);
+        uint32_t used = stack_size - osThreadGetStackSpace(threads[i]);
+        peak->name = name;
+        peak->reserved_size = stack_size;
+        if (used > peak->max_size) {
+            peak->max_size = used;
+        }
+    }
+    osKernelUnlock();
+#endif
+}
+
+size_t mbed_stats_stack_peak_get_each(mbed_stats_stack_peak_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_stack_peak_t));
+    size_t i = 0;
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    osKernelLock();
+    for (size_t n = 0; n < MBED_CONF_PLATFORM_STACK_STATS_PEAKS_MAX && i < count; n++) {
+        if (stack_peaks[n].reserved_size == 0) {
+            continue;
+        }
+        stats[i] = stack_peaks[n];
+        // Rounded up to the 8 bytes alignment of the stacks
+        stats[i].recommended_size = ((stats[i].max_size * (100U + MBED_CONF_PLATFORM_STACK_STATS_MARGIN) / 100U) + 7U) & ~7U;
+        i++;
+    }
+    osKernelUnlock();
+#endif
+    return i;
+}
+
+void mbed_stats_stack_peak_restore(const mbed_stats_stack_peak_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL || count == 0);
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    osKernelLock();
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].reserved_size == 0) {
+            continue;
+        }
+        mbed_stats_stack_peak_t *peak = stack_peak_find(stats[i].name_hash);
+        if (peak == NULL) {
+            break;
+        }
+        if (peak->reserved_size == 0) {
+            peak->reserved_size = stats[i].reserved_size;
+        }
+        if (stats[i].max_size > peak->max_size) {
+            peak->max_size = stats[i].max_size;
+        }
+    }
+    osKernelUnlock();
+#endif
+}
+
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
@@ -139,6 +261,255 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
     return i;
 }
 
+#if defined(MBED_THREAD_CPU_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+typedef struct {
+    osThreadId_t id;
+    uint64_t cpu_cycles;
+    uint32_t switch_cnt;
+    uint32_t ready_stamp;       /* Cycle count when the thread was unblocked, 0 if not pending */
+    uint32_t max_latency_us;
+} thread_cpu_slot_t;
+
+static thread_cpu_slot_t thread_cpu_slots[MBED_CONF_PLATFORM_THREAD_CPU_STATS_MAX];
+static thread_cpu_slot_t *thread_cpu_running;
+static uint32_t thread_cpu_last_switch;
+static mbed_stats_latency_t thread_latency;
+
+static thread_cpu_slot_t *thread_cpu_find(osThreadId_t id)
+{
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_THREAD_CPU_STATS_MAX; i++) {
+        if (thread_cpu_slots[i].id == id) {
+            return &thread_cpu_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/* The RTX event recorder hooks below replace the weak ones of rtx_evr.c. They are
+ * called by the kernel with the scheduler locked, so they don't need a critical section.
+ */
+void EvrRtxThreadCreated(osThreadId_t thread_id, uint32_t thread_addr, const char *name)
+{
+    (void)thread_addr;
+    (void)name;
+
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    thread_cpu_slot_t *slot = thread_cpu_find(NULL);
+    if (slot != NULL) {
+        memset(slot, 0, sizeof(thread_cpu_slot_t));
+        slot->id = thread_id;
+    }
+}
+
+void EvrRtxThreadDestroyed(osThreadId_t thread_id)
+{
+    thread_cpu_slot_t *slot = thread_cpu_find(thread_id);
+    if (slot != NULL) {
+        if (slot == thread_cpu_running) {
+            thread_cpu_running = NULL;
+        }
+        slot->id = NULL;
+    }
+}
+
+void EvrRtxThreadUnblocked(osThreadId_t thread_id, uint32_t ret_val)
+{
+    (void)ret_val;
+
+    thread_cpu_slot_t *slot = thread_cpu_find(thread_id);
+    if (slot != NULL) {
+        // 0 marks no pending stamp, losing one cycle of latency when the counter is 0
+        slot->ready_stamp = DWT->CYCCNT | 1;
+    }
+}
+
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    // Unsigned arithmetic copes with a single counter wrap between two switches
+    if (thread_cpu_running != NULL) {
+        thread_cpu_running->cpu_cycles += now - thread_cpu_last_switch;
+    }
+    thread_cpu_last_switch = now;
+
+    thread_cpu_slot_t *slot = thread_cpu_find(thread_id);
+    thread_cpu_running = slot;
+    if (slot == NULL) {
+        return;
+    }
+    slot->switch_cnt++;
+
+    if (slot->ready_stamp != 0) {
+        uint32_t latency_us = (uint32_t)(((uint64_t)(now - slot->ready_stamp) * 1000000U) / SystemCoreClock);
+        slot->ready_stamp = 0;
+        if (latency_us > slot->max_latency_us) {
+            slot->max_latency_us = latency_us;
+        }
+
+        if (((osRtxThread_t *)thread_id)->priority >= MBED_CONF_PLATFORM_LATENCY_STATS_PRIORITY) {
+            unsigned bucket = 0;
+            while ((latency_us >> (bucket + 1)) != 0 && bucket < MBED_STATS_LATENCY_BUCKETS - 1) {
+                bucket++;
+            }
+            thread_latency.bucket[bucket]++;
+            if (latency_us > thread_latency.max_us) {
+                thread_latency.max_us = latency_us;
+            }
+        }
+    }
+}
+#endif
+
+size_t mbed_stats_thread_cpu_get_each(mbed_stats_thread_cpu_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_thread_cpu_t));
+    size_t i = 0;
+
+#if defined(MBED_THREAD_CPU_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    core_util_critical_section_enter();
+    for (size_t n = 0; n < MBED_CONF_PLATFORM_THREAD_CPU_STATS_MAX && i < count; n++) {
+        thread_cpu_slot_t *slot = &thread_cpu_slots[n];
+        if (slot->id == NULL) {
+            continue;
+        }
+        stats[i].id = (uint32_t)slot->id;
+        stats[i].cpu_cycles = slot->cpu_cycles;
+        // Include the running time of the calling thread
+        if (slot == thread_cpu_running) {
+            stats[i].cpu_cycles += DWT->CYCCNT - thread_cpu_last_switch;
+        }
+        stats[i].switch_cnt = slot->switch_cnt;
+        stats[i].max_latency_us = slot->max_latency_us;
+        i++;
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
+
+void mbed_stats_latency_get(mbed_stats_latency_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_latency_t));
+
+#if defined(MBED_THREAD_CPU_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    core_util_critical_section_enter();
+    *stats = thread_latency;
+    core_util_critical_section_exit();
+#endif
+}
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+static mbed_stats_boot_mark_t boot_marks[MBED_CONF_PLATFORM_BOOT_STATS_MAX_MARKS];
+static size_t boot_mark_count;
+static uint32_t boot_origin;
+static uint32_t boot_clock;         /* Core clock at the last mark */
+static mbed_stats_boot_initializer_t boot_initializers[MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS];
+
+static uint32_t boot_cycles_to_us(uint32_t cycles, uint32_t clock)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000U) / clock);
+}
+#endif
+
+void mbed_stats_boot_mark(const char *name)
+{
+#if defined(MBED_BOOT_STATS_ENABLED)
+    core_util_critical_section_enter();
+    if (boot_mark_count == 0) {
+        // The counter may already run for other stats: keep it going
+        if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+            CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+            DWT->CYCCNT = 0;
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        }
+        boot_origin = DWT->CYCCNT;
+    }
+    if (boot_mark_count < MBED_CONF_PLATFORM_BOOT_STATS_MAX_MARKS) {
+        mbed_stats_boot_mark_t *mark = &boot_marks[boot_mark_count];
+        mark->name = name;
+        mark->cycles = DWT->CYCCNT - boot_origin;
+        mark->time_us = 0;
+        if (boot_mark_count > 0) {
+            const mbed_stats_boot_mark_t *previous = mark - 1;
+            mark->time_us = previous->time_us + boot_cycles_to_us(mark->cycles - previous->cycles, boot_clock);
+        }
+        boot_clock = SystemCoreClock;
+        boot_mark_count++;
+    }
+    core_util_critical_section_exit();
+#else
+    (void)name;
+#endif
+}
+
+size_t mbed_stats_boot_get_each(mbed_stats_boot_mark_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_boot_mark_t));
+    size_t i = 0;
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+    core_util_critical_section_enter();
+    for (; i < boot_mark_count && i < count; i++) {
+        stats[i] = boot_marks[i];
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
+
+void mbed_stats_boot_initializer_run(void (*initializer)(void))
+{
+#if defined(MBED_BOOT_STATS_ENABLED)
+    // Not in a critical section: initializers may block, and run before other threads
+    uint32_t start = DWT->CYCCNT;
+    initializer();
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    // The table is kept longest first, its free slots have 0 cycles
+    size_t i = MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS;
+    while (i > 0 && boot_initializers[i - 1].cycles < cycles) {
+        i--;
+    }
+    if (i < MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS) {
+        memmove(&boot_initializers[i + 1], &boot_initializers[i],
+                (MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS - 1 - i) * sizeof(mbed_stats_boot_initializer_t));
+        boot_initializers[i].initializer = initializer;
+        boot_initializers[i].cycles = cycles;
+        boot_initializers[i].time_us = boot_cycles_to_us(cycles, SystemCoreClock);
+    }
+#else
+    initializer();
+#endif
+}
+
+size_t mbed_stats_boot_initializer_get_each(mbed_stats_boot_initializer_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_boot_initializer_t));
+    size_t i = 0;
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+    core_util_critical_section_enter();
+    for (; i < MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS && i < count; i++) {
+        if (boot_initializers[i].initializer == NULL) {
+            break;
+        }
+        stats[i] = boot_initializers[i];
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
+
 void mbed_stats_sys_get(mbed_stats_sys_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -37,7 +37,7 @@ extern "C" {
 #else
         mbed::internal::OsClock::time_point tp = mbed::internal::OsClock::now();
 #endif
-        return duration<uint64_t, std::milli>(tp.time_since_epoch()).count();
+        return duration_cast<duration<uint64_t, std::milli>>(tp.time_since_epoch()).count();
     }
 
     void thread_sleep_for(uint32_t millisec)
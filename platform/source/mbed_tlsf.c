@@ -0,0 +1,397 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/internal/mbed_tlsf.h"
+#include <string.h>
+
+/* Every block starts with a header giving its physically previous block and
+ * its size. The free list links are only used by free blocks, they overlap
+ * the payload of allocated blocks. Each pool ends with a zero-sized allocated
+ * block so that no block has to check for the end of its pool. */
+typedef struct mbed_tlsf_block {
+    struct mbed_tlsf_block *prev_phys;
+    size_t size;                        // Payload size, BLOCK_FREE in the free bits
+    struct mbed_tlsf_block *next_free;
+    struct mbed_tlsf_block *prev_free;
+} mbed_tlsf_block_t;
+
+#define BLOCK_FREE          1
+#define BLOCK_HEADER_SIZE   offsetof(mbed_tlsf_block_t, next_free)
+#define BLOCK_SIZE_MIN      (sizeof(mbed_tlsf_block_t) - BLOCK_HEADER_SIZE)
+#define BLOCK_SIZE_MAX      (((size_t)1 << MBED_TLSF_FL_MAX) - MBED_TLSF_ALIGN)
+#define SMALL_BLOCK_SIZE    ((size_t)1 << MBED_TLSF_FL_SHIFT)
+
+#define ALIGN_UP(x, a)      (((x) + ((a) - 1)) & ~((uintptr_t)(a) - 1))
+#define ALIGN_DOWN(x, a)    ((x) & ~((uintptr_t)(a) - 1))
+
+static int tlsf_fls(size_t word)
+{
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned long) * 8) - 1 - __builtin_clzl((unsigned long)word);
+#else
+    int bit = 0;
+    while (word >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static int tlsf_ffs(uint32_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static size_t block_size(const mbed_tlsf_block_t *block)
+{
+    return block->size & ~(size_t)(MBED_TLSF_ALIGN - 1);
+}
+
+static int block_is_free(const mbed_tlsf_block_t *block)
+{
+    return block->size & BLOCK_FREE;
+}
+
+static void *block_payload(const mbed_tlsf_block_t *block)
+{
+    return (char *)block + BLOCK_HEADER_SIZE;
+}
+
+static mbed_tlsf_block_t *block_from_payload(const void *ptr)
+{
+    return (mbed_tlsf_block_t *)((char *)ptr - BLOCK_HEADER_SIZE);
+}
+
+static mbed_tlsf_block_t *block_next(const mbed_tlsf_block_t *block)
+{
+    return (mbed_tlsf_block_t *)((char *)block_payload(block) + block_size(block));
+}
+
+/* Rounds a requested size up to a valid payload size, 0 if it is too large */
+static size_t block_adjust_size(size_t size)
+{
+    if (size > BLOCK_SIZE_MAX) {
+        return 0;
+    }
+    size = ALIGN_UP(size, MBED_TLSF_ALIGN);
+    return size < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : size;
+}
+
+/* Gets the list of the blocks of this size */
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (int)(size >> MBED_TLSF_ALIGN_SHIFT);
+    } else {
+        int bit = tlsf_fls(size);
+        *sl = (int)(size >> (bit - MBED_TLSF_SL_SHIFT)) ^ MBED_TLSF_SL_COUNT;
+        *fl = bit - MBED_TLSF_FL_SHIFT + 1;
+    }
+}
+
+/* Gets the first list whose blocks are all at least of this size */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLOCK_SIZE) {
+        size += ((size_t)1 << (tlsf_fls(size) - MBED_TLSF_SL_SHIFT)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+static void block_insert_free(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    mbed_tlsf_block_t *head = tlsf->blocks[fl][sl];
+    block->prev_free = NULL;
+    block->next_free = head;
+    if (head) {
+        head->prev_free = block;
+    }
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= 1U << fl;
+    tlsf->sl_bitmap[fl] |= 1U << sl;
+}
+
+static void block_remove_free(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        tlsf->blocks[fl][sl] = block->next_free;
+        if (!block->next_free) {
+            tlsf->sl_bitmap[fl] &= ~(1U << sl);
+            if (!tlsf->sl_bitmap[fl]) {
+                tlsf->fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+}
+
+/* Takes a free block of at least this size out of its list */
+static mbed_tlsf_block_t *block_take_free(mbed_tlsf_t *tlsf, size_t size)
+{
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= MBED_TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0U << (fl + 1));
+        if (!fl_map) {
+            return NULL;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    mbed_tlsf_block_t *block = tlsf->blocks[fl][sl];
+    block_remove_free(tlsf, block);
+    block->size = block_size(block);
+    return block;
+}
+
+/* Frees an allocated block, merging it with its free neighbours */
+static void block_release(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *block)
+{
+    mbed_tlsf_block_t *prev = block->prev_phys;
+    if (prev && block_is_free(prev) &&
+            block_size(prev) + BLOCK_HEADER_SIZE + block_size(block) <= BLOCK_SIZE_MAX) {
+        block_remove_free(tlsf, prev);
+        prev->size = block_size(prev) + BLOCK_HEADER_SIZE + block_size(block);
+        block = prev;
+        block_next(block)->prev_phys = block;
+    }
+
+    mbed_tlsf_block_t *next = block_next(block);
+    if (block_is_free(next) &&
+            block_size(block) + BLOCK_HEADER_SIZE + block_size(next) <= BLOCK_SIZE_MAX) {
+        block_remove_free(tlsf, next);
+        block->size = block_size(block) + BLOCK_HEADER_SIZE + block_size(next);
+        block_next(block)->prev_phys = block;
+    }
+
+    block->size |= BLOCK_FREE;
+    block_insert_free(tlsf, block);
+}
+
+/* Gives back the end of an allocated block that isn't needed for this size */
+static void block_trim(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *block, size_t size)
+{
+    if (block_size(block) < size + BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN) {
+        return;
+    }
+
+    mbed_tlsf_block_t *rest = (mbed_tlsf_block_t *)((char *)block_payload(block) + size);
+    rest->prev_phys = block;
+    rest->size = block_size(block) - size - BLOCK_HEADER_SIZE;
+    block_next(rest)->prev_phys = rest;
+    block->size = size;
+    block_release(tlsf, rest);
+}
+
+void mbed_tlsf_init(mbed_tlsf_t *tlsf)
+{
+    memset(tlsf, 0, sizeof(*tlsf));
+}
+
+size_t mbed_tlsf_add_pool(mbed_tlsf_t *tlsf, void *mem, size_t size)
+{
+    uintptr_t start = ALIGN_UP((uintptr_t)mem, MBED_TLSF_ALIGN);
+    uintptr_t end = ALIGN_DOWN((uintptr_t)mem + size, MBED_TLSF_ALIGN);
+    if (end < start + 2 * BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN) {
+        return 0;
+    }
+    // Room for the end of pool block
+    end -= BLOCK_HEADER_SIZE;
+
+    mbed_tlsf_block_t *prev = NULL;
+    size_t total = 0;
+    while (end - start >= BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN) {
+        size_t payload = end - start - BLOCK_HEADER_SIZE;
+        if (payload > BLOCK_SIZE_MAX) {
+            payload = BLOCK_SIZE_MAX;
+        }
+        mbed_tlsf_block_t *block = (mbed_tlsf_block_t *)start;
+        block->prev_phys = prev;
+        block->size = payload | BLOCK_FREE;
+        block_insert_free(tlsf, block);
+
+        start += BLOCK_HEADER_SIZE + payload;
+        total += BLOCK_HEADER_SIZE + payload;
+        prev = block;
+    }
+
+    mbed_tlsf_block_t *last = (mbed_tlsf_block_t *)start;
+    last->prev_phys = prev;
+    last->size = 0;
+
+    return total;
+}
+
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size)
+{
+    size_t adjusted = block_adjust_size(size);
+    if (!adjusted) {
+        return NULL;
+    }
+
+    mbed_tlsf_block_t *block = block_take_free(tlsf, adjusted);
+    if (!block) {
+        return NULL;
+    }
+    block_trim(tlsf, block, adjusted);
+    return block_payload(block);
+}
+
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t alignment, size_t size)
+{
+    if (alignment <= MBED_TLSF_ALIGN) {
+        return mbed_tlsf_malloc(tlsf, size);
+    }
+    if (alignment & (alignment - 1)) {
+        return NULL;
+    }
+
+    size_t adjusted = block_adjust_size(size);
+    if (!adjusted || alignment > BLOCK_SIZE_MAX) {
+        return NULL;
+    }
+
+    // Enough for an aligned payload after a leading free block
+    const size_t gap_min = BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN;
+    size_t request = block_adjust_size(adjusted + alignment + gap_min);
+    if (!request) {
+        return NULL;
+    }
+
+    mbed_tlsf_block_t *block = block_take_free(tlsf, request);
+    if (!block) {
+        return NULL;
+    }
+
+    uintptr_t payload = (uintptr_t)block_payload(block);
+    uintptr_t aligned = ALIGN_UP(payload, alignment);
+    if (aligned != payload) {
+        if (aligned - payload < gap_min) {
+            aligned = ALIGN_UP(payload + gap_min, alignment);
+        }
+        size_t gap = aligned - payload;
+
+        mbed_tlsf_block_t *aligned_block = block_from_payload((void *)aligned);
+        aligned_block->prev_phys = block;
+        aligned_block->size = block_size(block) - gap;
+        block_next(aligned_block)->prev_phys = aligned_block;
+
+        block->size = gap - BLOCK_HEADER_SIZE;
+        block_release(tlsf, block);
+        block = aligned_block;
+    }
+
+    block_trim(tlsf, block, adjusted);
+    return block_payload(block);
+}
+
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size)
+{
+    if (!ptr) {
+        return mbed_tlsf_malloc(tlsf, size);
+    }
+    if (size == 0) {
+        mbed_tlsf_free(tlsf, ptr);
+        return NULL;
+    }
+
+    size_t adjusted = block_adjust_size(size);
+    if (!adjusted) {
+        return NULL;
+    }
+
+    mbed_tlsf_block_t *block = block_from_payload(ptr);
+    size_t current = block_size(block);
+    if (adjusted > current) {
+        mbed_tlsf_block_t *next = block_next(block);
+        size_t merged = current + BLOCK_HEADER_SIZE + block_size(next);
+        if (block_is_free(next) && merged >= adjusted && merged <= BLOCK_SIZE_MAX) {
+            block_remove_free(tlsf, next);
+            block->size = merged;
+            block_next(block)->prev_phys = block;
+        } else {
+            void *new_ptr = mbed_tlsf_malloc(tlsf, size);
+            if (new_ptr) {
+                memcpy(new_ptr, ptr, current);
+                mbed_tlsf_free(tlsf, ptr);
+            }
+            return new_ptr;
+        }
+    }
+
+    block_trim(tlsf, block, adjusted);
+    return ptr;
+}
+
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr)
+{
+    if (ptr) {
+        block_release(tlsf, block_from_payload(ptr));
+    }
+}
+
+size_t mbed_tlsf_block_total_size(const void *ptr)
+{
+    return block_size(block_from_payload(ptr)) + BLOCK_HEADER_SIZE;
+}
+
+void mbed_tlsf_free_info(const mbed_tlsf_t *tlsf, mbed_tlsf_free_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    for (int fl = 0; fl < MBED_TLSF_FL_COUNT; fl++) {
+        if (!(tlsf->fl_bitmap & (1U << fl))) {
+            continue;
+        }
+        for (int sl = 0; sl < MBED_TLSF_SL_COUNT; sl++) {
+            for (const mbed_tlsf_block_t *block = tlsf->blocks[fl][sl]; block; block = block->next_free) {
+                size_t size = block_size(block);
+                info->free_size += size;
+                info->free_blocks++;
+                if (size > info->largest_free) {
+                    info->largest_free = size;
+                }
+            }
+        }
+    }
+}
@@ -16,31 +16,13 @@
  */
 
 #include "mbed_printf_implementation.h"
+#include "platform/mbed_format.h"
 
 #include <stdbool.h>
 #include <limits.h>
 #include <stdint.h>
 #include <stddef.h>
 
-#if !TARGET_LIKE_MBED
-/* Linux implementation is for debug only */
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 1
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
-#endif
-
 /**
  * Check architecture and choose storage data type.
  * On 32 bit machines, the default storage type is 32 bit wide
@@ -75,15 +57,15 @@
  * Enum for storing width modifier.
  */
 typedef enum {
-    LENGTH_NONE         = 0x00,
-    LENGTH_H            = 0x11,
-    LENGTH_L            = 0x21,
-    LENGTH_J            = 0x31,
-    LENGTH_Z            = 0x41,
-    LENGTH_T            = 0x51,
-    LENGTH_CAPITAL_L    = 0x61,
-    LENGTH_HH           = 0x72,
-    LENGTH_LL           = 0x82
+    LENGTH_NONE         = MBED_FORMAT_LENGTH_NONE,
+    LENGTH_H            = MBED_FORMAT_LENGTH_H,
+    LENGTH_L            = MBED_FORMAT_LENGTH_L,
+    LENGTH_J            = MBED_FORMAT_LENGTH_J,
+    LENGTH_Z            = MBED_FORMAT_LENGTH_Z,
+    LENGTH_T            = MBED_FORMAT_LENGTH_T,
+    LENGTH_CAPITAL_L    = MBED_FORMAT_LENGTH_CAPITAL_L,
+    LENGTH_HH           = MBED_FORMAT_LENGTH_HH,
+    LENGTH_LL           = MBED_FORMAT_LENGTH_LL
 } length_t;
 
 /**
@@ -331,6 +313,161 @@ static void mbed_minimal_formatted_string_string(char *buffer, size_t length, in
     }
 }
 
+/**
+ * @brief      Print one conversion, reading its argument.
+ *
+ * @param      buffer           The buffer to store output (NULL for stdout).
+ * @param[in]  length           The length of the buffer.
+ * @param      result           The current output location.
+ * @param[in]  next             The conversion character.
+ * @param[in]  length_modifier  The length modifier of the conversion.
+ * @param[in]  precision        The precision of the conversion.
+ * @param      arguments        The va_list arguments.
+ *
+ * @return     false if the conversion is not supported, nothing is printed then.
+ */
+static bool mbed_minimal_formatted_conversion(char *buffer, size_t length, int *result, char next, length_t length_modifier, int precision, va_list *arguments, FILE *stream)
+{
+    /* signed integer */
+    if ((next == 'd') || (next == 'i')) {
+        MBED_SIGNED_STORAGE value = 0;
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+        /* if 64 bit is enabled and the integer types are larger than the native type */
+        if (((length_modifier == LENGTH_LL)   && (sizeof(long long int) > sizeof(MBED_SIGNED_NATIVE_TYPE))) ||
+                ((length_modifier == LENGTH_L)    && (sizeof(long int)      > sizeof(MBED_SIGNED_NATIVE_TYPE))) ||
+                ((length_modifier == LENGTH_NONE) && (sizeof(int)           > sizeof(MBED_SIGNED_NATIVE_TYPE)))) {
+            /* use 64 bit storage type for readout */
+            value = va_arg(*arguments, MBED_SIGNED_STORAGE);
+        } else
+#else
+        /* If 64 bit is not enabled, print %ll[di] rather than truncated value */
+        if (length_modifier == LENGTH_LL) {
+            return false;
+        }
+#endif
+        {
+            /* use native storage type (which can be 32 or 64 bit) */
+            value = va_arg(*arguments, MBED_SIGNED_NATIVE_TYPE);
+        }
+
+        /* constrict value based on length modifier */
+        switch (length_modifier) {
+            case LENGTH_NONE:
+                value = (int) value;
+                break;
+            case LENGTH_HH:
+                value = (signed char) value;
+                break;
+            case LENGTH_H:
+                value = (short int) value;
+                break;
+            case LENGTH_L:
+                value = (long int) value;
+                break;
+            case LENGTH_LL:
+                value = (long long int) value;
+                break;
+            case LENGTH_J:
+                value = (intmax_t) value;
+                break;
+            case LENGTH_T:
+                value = (ptrdiff_t) value;
+                break;
+            default:
+                break;
+        }
+
+        mbed_minimal_formatted_string_signed(buffer, length, result, value, stream);
+    }
+    /* unsigned integer */
+    else if ((next == 'u') || (next == 'x') || (next == 'X')) {
+        MBED_UNSIGNED_STORAGE value = 0;
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+        /* if 64 bit is enabled and the integer types are larger than the native type */
+        if (((length_modifier == LENGTH_LL)   && (sizeof(unsigned long long int) > sizeof(MBED_UNSIGNED_NATIVE_TYPE))) ||
+                ((length_modifier == LENGTH_L)    && (sizeof(unsigned long int)      > sizeof(MBED_UNSIGNED_NATIVE_TYPE))) ||
+                ((length_modifier == LENGTH_NONE) && (sizeof(unsigned int)           > sizeof(MBED_UNSIGNED_NATIVE_TYPE)))) {
+            /* use 64 bit storage type for readout */
+            value = va_arg(*arguments, MBED_UNSIGNED_STORAGE);
+        } else
+#else
+        /* If 64 bit is not enabled, print %ll[uxX] rather than truncated value */
+        if (length_modifier == LENGTH_LL) {
+            return false;
+        }
+#endif
+        {
+            /* use native storage type (which can be 32 or 64 bit) */
+            value = va_arg(*arguments, MBED_UNSIGNED_NATIVE_TYPE);
+        }
+
+        /* constrict value based on length modifier */
+        switch (length_modifier) {
+            case LENGTH_NONE:
+                value = (unsigned int) value;
+                break;
+            case LENGTH_HH:
+                value = (unsigned char) value;
+                break;
+            case LENGTH_H:
+                value = (unsigned short int) value;
+                break;
+            case LENGTH_L:
+                value = (unsigned long int) value;
+                break;
+            case LENGTH_LL:
+                value = (unsigned long long int) value;
+                break;
+            case LENGTH_J:
+                value = (uintmax_t) value;
+                break;
+            case LENGTH_Z:
+                value = (size_t) value;
+                break;
+            case LENGTH_T:
+                value = (ptrdiff_t) value;
+                break;
+            default:
+                break;
+        }
+
+        /* write unsigned or hexadecimal */
+        if (next == 'u') {
+            mbed_minimal_formatted_string_unsigned(buffer, length, result, value, stream);
+        } else {
+            mbed_minimal_formatted_string_hexadecimal(buffer, length, result, value, stream, next == 'X');
+        }
+    }
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+    /* treat all floating points the same */
+    else if ((next == 'f') || (next == 'F') || (next == 'g') || (next == 'G')) {
+        double value = va_arg(*arguments, double);
+        mbed_minimal_formatted_string_double(buffer, length, result, value, stream);
+    }
+#endif
+    /* character */
+    else if (next == 'c') {
+        char value = va_arg(*arguments, MBED_SIGNED_NATIVE_TYPE);
+        mbed_minimal_putchar(buffer, length, result, value, stream);
+    }
+    /* string */
+    else if (next == 's') {
+        char *value = va_arg(*arguments, char *);
+        mbed_minimal_formatted_string_string(buffer, length, result, value, precision, stream);
+    }
+    /* pointer */
+    else if (next == 'p') {
+        void *value = va_arg(*arguments, void *);
+        mbed_minimal_formatted_string_void_pointer(buffer, length, result, value, stream);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief      Parse formatted string and invoke write handlers based on type.
  *
@@ -357,6 +494,10 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
             /* the buffer is empty, there's no place to write the terminator */
             empty_buffer = true;
         }
+        /* the conversions take the arguments by pointer */
+        va_list args;
+        va_copy(args, arguments);
+
         /* parse string */
         for (size_t index = 0; format[index] != '\0'; index++) {
             /* format specifier begin */
@@ -383,7 +524,7 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
                     next_index++;
 
                     /* discard argument */
-                    va_arg(arguments, MBED_SIGNED_NATIVE_TYPE);
+                    va_arg(args, MBED_SIGNED_NATIVE_TYPE);
                 } else {
                     while ((format[next_index] >= '0') &&
                             (format[next_index] <= '9')) {
@@ -402,7 +543,7 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
                     next_index += 2;
 
                     /* read precision from argument list */
-                    precision = va_arg(arguments, MBED_SIGNED_NATIVE_TYPE);
+                    precision = va_arg(args, MBED_SIGNED_NATIVE_TYPE);
                 } else if (format[next_index] == '.') {
                     /* precision modifier found, reset default to 0 and increment index */
                     next_index++;
@@ -457,161 +598,8 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
                  *************************************************************/
                 char next = format[next_index];
 
-                /* signed integer */
-                if ((next == 'd') || (next == 'i')) {
-                    MBED_SIGNED_STORAGE value = 0;
-
-#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
-                    /* if 64 bit is enabled and the integer types are larger than the native type */
-                    if (((length_modifier == LENGTH_LL)   && (sizeof(long long int) > sizeof(MBED_SIGNED_NATIVE_TYPE))) ||
-                            ((length_modifier == LENGTH_L)    && (sizeof(long int)      > sizeof(MBED_SIGNED_NATIVE_TYPE))) ||
-                            ((length_modifier == LENGTH_NONE) && (sizeof(int)           > sizeof(MBED_SIGNED_NATIVE_TYPE)))) {
-                        /* use 64 bit storage type for readout */
-                        value = va_arg(arguments, MBED_SIGNED_STORAGE);
-                    } else
-#else
-                    /* If 64 bit is not enabled, print %ll[di] rather than truncated value */
-                    if (length_modifier == LENGTH_LL) {
-                        mbed_minimal_putchar(buffer, length, &result, '%', stream);
-                        if (next == '%') {
-                            // Continue printing loop after `%`
-                            index = next_index;
-                        }
-                        continue;
-                    }
-#endif
-                    {
-                        /* use native storage type (which can be 32 or 64 bit) */
-                        value = va_arg(arguments, MBED_SIGNED_NATIVE_TYPE);
-                    }
-
-                    /* constrict value based on length modifier */
-                    switch (length_modifier) {
-                        case LENGTH_NONE:
-                            value = (int) value;
-                            break;
-                        case LENGTH_HH:
-                            value = (signed char) value;
-                            break;
-                        case LENGTH_H:
-                            value = (short int) value;
-                            break;
-                        case LENGTH_L:
-                            value = (long int) value;
-                            break;
-                        case LENGTH_LL:
-                            value = (long long int) value;
-                            break;
-                        case LENGTH_J:
-                            value = (intmax_t) value;
-                            break;
-                        case LENGTH_T:
-                            value = (ptrdiff_t) value;
-                            break;
-                        default:
-                            break;
-                    }
-
+                if (mbed_minimal_formatted_conversion(buffer, length, &result, next, length_modifier, precision, &args, stream)) {
                     index = next_index;
-
-                    mbed_minimal_formatted_string_signed(buffer, length, &result, value, stream);
-                }
-                /* unsigned integer */
-                else if ((next == 'u') || (next == 'x') || (next == 'X')) {
-                    MBED_UNSIGNED_STORAGE value = 0;
-
-#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
-                    /* if 64 bit is enabled and the integer types are larger than the native type */
-                    if (((length_modifier == LENGTH_LL)   && (sizeof(unsigned long long int) > sizeof(MBED_UNSIGNED_NATIVE_TYPE))) ||
-                            ((length_modifier == LENGTH_L)    && (sizeof(unsigned long int)      > sizeof(MBED_UNSIGNED_NATIVE_TYPE))) ||
-                            ((length_modifier == LENGTH_NONE) && (sizeof(unsigned int)           > sizeof(MBED_UNSIGNED_NATIVE_TYPE)))) {
-                        /* use 64 bit storage type for readout */
-                        value = va_arg(arguments, MBED_UNSIGNED_STORAGE);
-                    } else
-#else
-                    /* If 64 bit is not enabled, print %ll[uxX] rather than truncated value */
-                    if (length_modifier == LENGTH_LL) {
-                        mbed_minimal_putchar(buffer, length, &result, '%', stream);
-                        if (next == '%') {
-                            // Continue printing loop after `%`
-                            index = next_index;
-                        }
-                        continue;
-                    }
-#endif
-                    {
-                        /* use native storage type (which can be 32 or 64 bit) */
-                        value = va_arg(arguments, MBED_UNSIGNED_NATIVE_TYPE);
-                    }
-
-                    /* constrict value based on length modifier */
-                    switch (length_modifier) {
-                        case LENGTH_NONE:
-                            value = (unsigned int) value;
-                            break;
-                        case LENGTH_HH:
-                            value = (unsigned char) value;
-                            break;
-                        case LENGTH_H:
-                            value = (unsigned short int) value;
-                            break;
-                        case LENGTH_L:
-                            value = (unsigned long int) value;
-                            break;
-                        case LENGTH_LL:
-                            value = (unsigned long long int) value;
-                            break;
-                        case LENGTH_J:
-                            value = (uintmax_t) value;
-                            break;
-                        case LENGTH_Z:
-                            value = (size_t) value;
-                            break;
-                        case LENGTH_T:
-                            value = (ptrdiff_t) value;
-                            break;
-                        default:
-                            break;
-                    }
-
-                    index = next_index;
-
-                    /* write unsigned or hexadecimal */
-                    if (next == 'u') {
-                        mbed_minimal_formatted_string_unsigned(buffer, length, &result, value, stream);
-                    } else {
-                        mbed_minimal_formatted_string_hexadecimal(buffer, length, &result, value, stream, next == 'X');
-                    }
-                }
-#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
-                /* treat all floating points the same */
-                else if ((next == 'f') || (next == 'F') || (next == 'g') || (next == 'G')) {
-                    double value = va_arg(arguments, double);
-                    index = next_index;
-
-                    mbed_minimal_formatted_string_double(buffer, length, &result, value, stream);
-                }
-#endif
-                /* character */
-                else if (next == 'c') {
-                    char value = va_arg(arguments, MBED_SIGNED_NATIVE_TYPE);
-                    index = next_index;
-
-                    mbed_minimal_putchar(buffer, length, &result, value, stream);
-                }
-                /* string */
-                else if (next == 's') {
-                    char *value = va_arg(arguments, char *);
-                    index = next_index;
-
-                    mbed_minimal_formatted_string_string(buffer, length, &result, value, precision, stream);
-                }
-                /* pointer */
-                else if (next == 'p') {
-                    void *value = va_arg(arguments, void *);
-                    index = next_index;
-
-                    mbed_minimal_formatted_string_void_pointer(buffer, length, &result, value, stream);
                 } else {
                     // Unrecognised, or `%%`. Print the `%` that led us in.
                     mbed_minimal_putchar(buffer, length, &result, '%', stream);
@@ -629,6 +617,7 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
                 mbed_minimal_putchar(buffer, length, &result, format[index], stream);
             }
         }
+        va_end(args);
 
         if (buffer && !empty_buffer) {
             /* NULL-terminate the buffer no matter what. We use '<=' to compare instead of '<'
@@ -644,3 +633,103 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
     return result;
 }
 
+
+/**
+ * @brief      Run a format compiled by MBED_FORMAT and invoke write handlers based on type.
+ *
+ * @param      buffer     The buffer to write to, write to stdout if NULL.
+ * @param[in]  length     The length of the buffer.
+ * @param[in]  program    The compiled format.
+ * @param[in]  arguments  The va_list arguments.
+ *
+ * @return     Number of characters written.
+ */
+static int mbed_minimal_formatted_program(char *buffer, size_t length, const uint8_t *program, va_list arguments, FILE *stream)
+{
+    int result = 0;
+    bool empty_buffer = false;
+
+    if (program && length <= INT_MAX) {
+        /* Make sure that there's always space for the NULL terminator */
+        if (length > 0) {
+            length --;
+        } else {
+            /* the buffer is empty, there's no place to write the terminator */
+            empty_buffer = true;
+        }
+        /* the conversions take the arguments by pointer */
+        va_list args;
+        va_copy(args, arguments);
+
+        /* the format was parsed and checked by MBED_FORMAT */
+        for (uint8_t op = *program++; op != MBED_FORMAT_OP_END; op = *program++) {
+            if (op == MBED_FORMAT_OP_TEXT) {
+                for (uint8_t count = *program++; count > 0; count--) {
+                    mbed_minimal_putchar(buffer, length, &result, *program++, stream);
+                }
+            } else if (op == MBED_FORMAT_OP_SKIP) {
+                /* discard width argument */
+                va_arg(args, MBED_SIGNED_NATIVE_TYPE);
+            } else {
+                length_t length_modifier = (length_t) program[0];
+                int precision = program[1];
+                program += 2;
+
+                if (precision == MBED_FORMAT_PRECISION_ARG) {
+                    precision = va_arg(args, MBED_SIGNED_NATIVE_TYPE);
+                } else if (precision == MBED_FORMAT_PRECISION_DEFAULT) {
+                    precision = PRECISION_DEFAULT;
+                }
+
+                mbed_minimal_formatted_conversion(buffer, length, &result, op, length_modifier, precision, &args, stream);
+            }
+        }
+        va_end(args);
+
+        if (buffer && !empty_buffer) {
+            /* NULL-terminate the buffer no matter what */
+            if ((size_t)result <= length) {
+                buffer[result] = '\0';
+            } else {
+                buffer[length] = '\0';
+            }
+        }
+    }
+
+    return result;
+}
+
+int mbed_printf_compiled(const uint8_t *program, ...)
+{
+    va_list arguments;
+    va_start(arguments, program);
+    int result = mbed_minimal_formatted_program(NULL, INT_MAX, program, arguments, stdout);
+    va_end(arguments);
+
+    return result;
+}
+
+int mbed_fprintf_compiled(FILE *stream, const uint8_t *program, ...)
+{
+    va_list arguments;
+    va_start(arguments, program);
+    int result = mbed_minimal_formatted_program(NULL, INT_MAX, program, arguments, stream);
+    va_end(arguments);
+
+    return result;
+}
+
+int mbed_snprintf_compiled(char *buffer, size_t length, const uint8_t *program, ...)
+{
+    va_list arguments;
+    va_start(arguments, program);
+    int result = mbed_minimal_formatted_program(buffer, length, program, arguments, NULL);
+    va_end(arguments);
+
+    return result;
+}
+
+int mbed_vsnprintf_compiled(char *buffer, size_t length, const uint8_t *program, va_list arguments)
+{
+    return mbed_minimal_formatted_program(buffer, length, program, arguments, NULL);
+}
@@ -236,6 +236,42 @@ void test_atomic_struct()
     TEST_ASSERT_EQUAL(uint8_t(add_iterations(data)), final_val.c);
 }
 
+/*
+ * Compare an increment compiled from the header with a call to the
+ * out-of-line definition in mbed_atomic_impl.c, as a SharedPtr or
+ * equeue reference count update would be. On targets with exclusive
+ * access the inline form must not be slower.
+ */
+void test_atomic_inline_cost()
+{
+    const long iterations = ADD_UNLOCKED_ITERATIONS;
+    /* Calling through a volatile pointer prevents inlining */
+    uint32_t (*volatile incr_call)(volatile uint32_t *, uint32_t) = core_util_atomic_incr_u32;
+    volatile uint32_t count = 0;
+    Timer timer;
+
+    timer.start();
+    for (long i = iterations; i > 0; i--) {
+        core_util_atomic_incr_u32(&count, 1);
+    }
+    const auto inline_time = timer.elapsed_time();
+
+    timer.reset();
+    for (long i = iterations; i > 0; i--) {
+        incr_call(&count, 1);
+    }
+    const auto call_time = timer.elapsed_time();
+    timer.stop();
+
+    utest_printf("%ld increments: inline %lld us, call %lld us\n", iterations,
+                 (long long) inline_time.count(), (long long) call_time.count());
+
+    TEST_ASSERT_EQUAL_UINT32(2 * iterations, count);
+#if MBED_EXCLUSIVE_ACCESS
+    TEST_ASSERT_TRUE(inline_time <= call_time);
+#endif
+}
+
 } // namespace
 
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -271,7 +307,8 @@ Case cases[] = {
     Case("Test atomic compare exchange strong 32-bit", test_atomic_add<uint32_t, strong_incrementer>),
     Case("Test atomic compare exchange strong 64-bit", test_atomic_add<uint64_t, strong_incrementer>),
     Case("Test small atomic custom structure", test_atomic_struct<small, 4>),
-    Case("Test large atomic custom structure", test_atomic_struct<large, 11>)
+    Case("Test large atomic custom structure", test_atomic_struct<large, 11>),
+    Case("Test atomic inline vs call cost", test_atomic_inline_cost)
 };
 
 utest::v1::Specification specification(test_setup, cases);
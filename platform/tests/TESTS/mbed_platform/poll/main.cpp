@@ -0,0 +1,233 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "platform/PollSet.h"
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define EVENT_DELAY     50ms
+#define POLL_TIMEOUT_MS 500
+
+/* File handle becoming readable from an interrupt */
+class EventFile : public FileHandle {
+public:
+    EventFile(bool notifies = true) : _readable(false), _notifies(notifies), _polls(0)
+    {
+    }
+
+    ssize_t read(void *buffer, size_t size) override
+    {
+        _readable = false;
+        return 0;
+    }
+
+    ssize_t write(const void *buffer, size_t size) override
+    {
+        return size;
+    }
+
+    off_t seek(off_t offset, int whence) override
+    {
+        return -ESPIPE;
+    }
+
+    int close() override
+    {
+        return 0;
+    }
+
+    short poll(short events) const override
+    {
+        _polls++;
+        return _readable ? POLLIN : 0;
+    }
+
+    bool poll_notifies() const override
+    {
+        return _notifies;
+    }
+
+    void set_readable()
+    {
+        _readable = true;
+        if (_notifies) {
+            poll_notify(this);
+        }
+    }
+
+    unsigned polls() const
+    {
+        return _polls;
+    }
+
+private:
+    volatile bool _readable;
+    bool _notifies;
+    mutable volatile unsigned _polls;
+};
+
+void test_poll_wakes_on_notify()
+{
+    EventFile file(true);
+    Timeout timeout;
+    pollfh fhs = { &file, POLLIN, 0 };
+
+    timeout.attach(callback(&file, &EventFile::set_readable), EVENT_DELAY);
+    Timer timer;
+    timer.start();
+    int ret = poll(&fhs, 1, POLL_TIMEOUT_MS);
+    timer.stop();
+
+    TEST_ASSERT_EQUAL(1, ret);
+    TEST_ASSERT_EQUAL(POLLIN, fhs.revents);
+    TEST_ASSERT_INT_WITHIN(10000, 50000, timer.elapsed_time().count());
+    // Blocked until the notification, instead of examining the file every millisecond
+    TEST_ASSERT(file.polls() <= 4);
+}
+
+void test_poll_rescans_without_notify()
+{
+    EventFile file(false);
+    Timeout timeout;
+    pollfh fhs = { &file, POLLIN, 0 };
+
+    timeout.attach(callback(&file, &EventFile::set_readable), EVENT_DELAY);
+    int ret = poll(&fhs, 1, POLL_TIMEOUT_MS);
+
+    TEST_ASSERT_EQUAL(1, ret);
+    TEST_ASSERT_EQUAL(POLLIN, fhs.revents);
+    TEST_ASSERT(file.polls() > 4);
+}
+
+void test_poll_timeout()
+{
+    EventFile file(true);
+    pollfh fhs = { &file, POLLIN, 0 };
+
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(0, poll(&fhs, 1, 20));
+    timer.stop();
+    TEST_ASSERT_INT_WITHIN(5000, 22000, timer.elapsed_time().count());
+    TEST_ASSERT_EQUAL(0, poll(&fhs, 1, 0));
+}
+
+void test_pollset_add_remove()
+{
+    PollSet<2> set;
+    EventFile a(true), b(true), c(true);
+
+    TEST_ASSERT_EQUAL(-EINVAL, set.add(NULL, POLLIN));
+    TEST_ASSERT_EQUAL(0, set.add(&a, POLLIN));
+    TEST_ASSERT_EQUAL(-EEXIST, set.add(&a, POLLIN));
+    TEST_ASSERT_EQUAL(0, set.add(&b, POLLIN));
+    TEST_ASSERT_EQUAL(-ENOMEM, set.add(&c, POLLIN));
+    TEST_ASSERT_EQUAL(2, set.size());
+
+    TEST_ASSERT_EQUAL(-ENOENT, set.modify(&c, POLLOUT));
+    TEST_ASSERT_EQUAL(0, set.modify(&b, POLLOUT));
+    TEST_ASSERT_EQUAL(-ENOENT, set.remove(&c));
+    TEST_ASSERT_EQUAL(0, set.remove(&a));
+    TEST_ASSERT_EQUAL(1, set.size());
+    TEST_ASSERT_EQUAL(0, set.add(&c, POLLIN));
+
+    pollfh ready[2];
+    TEST_ASSERT_EQUAL(-EINVAL, set.wait(ready, 0, 0));
+}
+
+void test_pollset_wait()
+{
+    PollSet<8> set;
+    EventFile files[8];
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(0, set.add(&files[i], POLLIN));
+    }
+
+    pollfh ready[8];
+    TEST_ASSERT_EQUAL(0, set.wait(ready, 8, 0));
+
+    Timeout timeout;
+    timeout.attach(callback(&files[5], &EventFile::set_readable), EVENT_DELAY);
+    TEST_ASSERT_EQUAL(1, set.wait(ready, 8, POLL_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_PTR(&files[5], ready[0].fh);
+    TEST_ASSERT_EQUAL(POLLIN, ready[0].revents);
+
+    // The idle files are not polled again after the first wait
+    for (int i = 0; i < 8; i++) {
+        if (i != 5) {
+            TEST_ASSERT_EQUAL(1, files[i].polls());
+        }
+    }
+
+    // Level triggered: ready until read
+    TEST_ASSERT_EQUAL(1, set.wait(ready, 8, 0));
+    files[5].read(NULL, 0);
+    TEST_ASSERT_EQUAL(0, set.wait(ready, 8, 0));
+}
+
+void test_pollset_round_robin()
+{
+    PollSet<3> set;
+    EventFile files[3];
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(0, set.add(&files[i], POLLIN));
+        files[i].set_readable();
+    }
+
+    // One at a time, each file is served in turn
+    pollfh ready[1];
+    FileHandle *served[3];
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(1, set.wait(ready, 1, 0));
+        served[i] = ready[0].fh;
+    }
+    TEST_ASSERT(served[0] != served[1]);
+    TEST_ASSERT(served[1] != served[2]);
+    TEST_ASSERT(served[0] != served[2]);
+}
+
+Case cases[] = {
+    Case("poll wakes on notify", test_poll_wakes_on_notify),
+    Case("poll rescans without notify", test_poll_rescans_without_notify),
+    Case("poll timeout", test_poll_timeout),
+    Case("PollSet add and remove", test_pollset_add_remove),
+    Case("PollSet wait", test_pollset_wait),
+    Case("PollSet round robin", test_pollset_round_robin),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
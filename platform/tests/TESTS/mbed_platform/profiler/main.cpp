@@ -0,0 +1,115 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "platform/mbed_profiler.h"
+
+#if !MBED_CONF_PLATFORM_PROFILER_ENTRIES
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define SAMPLE_PERIOD_US    97
+#define BUSY_TIME_US        100000
+
+static volatile uint32_t busy_counter;
+
+static MBED_NOINLINE void busy_loop()
+{
+    Timer timer;
+    timer.start();
+    while (timer.elapsed_time().count() < BUSY_TIME_US) {
+        busy_counter++;
+    }
+}
+
+void test_start_stop()
+{
+    mbed_profiler_reset();
+    if (mbed_profiler_start(SAMPLE_PERIOD_US) != 0) {
+        TEST_IGNORE_MESSAGE("Target has no profiler timer");
+    }
+    TEST_ASSERT_EQUAL(-1, mbed_profiler_start(SAMPLE_PERIOD_US));
+
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLE_PERIOD_US, stats.period_us);
+
+    busy_loop();
+    mbed_profiler_stop();
+
+    mbed_profiler_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.period_us);
+    // Allow for the FIFO of the interrupts and the timer granularity
+    TEST_ASSERT_UINT32_WITHIN(BUSY_TIME_US / SAMPLE_PERIOD_US / 4, BUSY_TIME_US / SAMPLE_PERIOD_US, stats.samples);
+    TEST_ASSERT(stats.entries > 0);
+
+    // No more samples once stopped
+    uint32_t samples = stats.samples;
+    busy_loop();
+    mbed_profiler_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(samples, stats.samples);
+}
+
+void test_samples_in_busy_loop()
+{
+    mbed_profiler_reset();
+    if (mbed_profiler_start(SAMPLE_PERIOD_US) != 0) {
+        TEST_IGNORE_MESSAGE("Target has no profiler timer");
+    }
+    busy_loop();
+    mbed_profiler_stop();
+
+    static mbed_profiler_entry_t entries[MBED_CONF_PLATFORM_PROFILER_ENTRIES];
+    size_t count = mbed_profiler_get_each(entries, MBED_CONF_PLATFORM_PROFILER_ENTRIES);
+    TEST_ASSERT(count > 0);
+
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT(entries[i].count > 0);
+        total += entries[i].count;
+    }
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats.samples, total + stats.dropped);
+
+    mbed_profiler_dump(NULL);
+}
+
+Case cases[] = {
+    Case("profiler start and stop", test_start_stop),
+    Case("profiler samples in busy loop", test_samples_in_busy_loop),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !MBED_CONF_PLATFORM_PROFILER_ENTRIES
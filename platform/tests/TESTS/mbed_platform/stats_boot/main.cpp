@@ -0,0 +1,137 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include <string.h>
+
+#if !defined(MBED_BOOT_STATS_ENABLED)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define MAX_MARKS           MBED_CONF_PLATFORM_BOOT_STATS_MAX_MARKS
+#define MAX_INITIALIZERS    MBED_CONF_PLATFORM_BOOT_STATS_MAX_INITIALIZERS
+#define SLOW_INIT_US        500
+
+class SlowInit {
+public:
+    SlowInit()
+    {
+        wait_us(SLOW_INIT_US);
+    }
+};
+
+static SlowInit slow_init;
+
+static const mbed_stats_boot_mark_t *find_mark(const mbed_stats_boot_mark_t *marks, size_t count, const char *name)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(marks[i].name, name) == 0) {
+            return &marks[i];
+        }
+    }
+    return NULL;
+}
+
+void test_case_boot_marks()
+{
+    mbed_stats_boot_mark_t marks[MAX_MARKS];
+
+    size_t count = mbed_stats_boot_get_each(marks, MAX_MARKS);
+    TEST_ASSERT_TRUE(count >= 4);
+    TEST_ASSERT_EQUAL_STRING("mbed_init", marks[0].name);
+    TEST_ASSERT_EQUAL_UINT32(0, marks[0].time_us);
+    for (size_t i = 1; i < count; i++) {
+        printf("%-12s %10lu cycles %8lu us\r\n", marks[i].name,
+               (unsigned long)marks[i].cycles, (unsigned long)marks[i].time_us);
+        TEST_ASSERT_TRUE(marks[i].cycles >= marks[i - 1].cycles);
+        TEST_ASSERT_TRUE(marks[i].time_us >= marks[i - 1].time_us);
+    }
+
+    const mbed_stats_boot_mark_t *sdk_init = find_mark(marks, count, "sdk_init");
+    const mbed_stats_boot_mark_t *static_init = find_mark(marks, count, "static_init");
+    const mbed_stats_boot_mark_t *main_mark = find_mark(marks, count, "main");
+    TEST_ASSERT_NOT_NULL(sdk_init);
+    TEST_ASSERT_NOT_NULL(static_init);
+    TEST_ASSERT_NOT_NULL(main_mark);
+    TEST_ASSERT_TRUE(static_init < main_mark);
+
+    // The phase includes the constructor of slow_init
+    const mbed_stats_boot_mark_t *before_static_init = static_init - 1;
+    TEST_ASSERT_TRUE(static_init->time_us - before_static_init->time_us >= SLOW_INIT_US);
+}
+
+void test_case_application_mark()
+{
+    mbed_stats_boot_mark_t marks[MAX_MARKS];
+
+    size_t before = mbed_stats_boot_get_each(marks, MAX_MARKS);
+    if (before == MAX_MARKS) {
+        TEST_IGNORE_MESSAGE("Boot marks table full");
+        return;
+    }
+    mbed_stats_boot_mark("test");
+    TEST_ASSERT_EQUAL(before + 1, mbed_stats_boot_get_each(marks, MAX_MARKS));
+    TEST_ASSERT_EQUAL_STRING("test", marks[before].name);
+}
+
+void test_case_initializers()
+{
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) && defined(MBED_CONF_RTOS_PRESENT)
+    mbed_stats_boot_initializer_t stats[MAX_INITIALIZERS];
+
+    size_t count = mbed_stats_boot_initializer_get_each(stats, MAX_INITIALIZERS);
+    TEST_ASSERT_TRUE(count >= 1);
+    for (size_t i = 0; i < count; i++) {
+        printf("initializer %p %10lu cycles %8lu us\r\n", (void *)stats[i].initializer,
+               (unsigned long)stats[i].cycles, (unsigned long)stats[i].time_us);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(stats[i].cycles <= stats[i - 1].cycles);
+        }
+    }
+    // The initializer of this file, running slow_init's constructor, is the longest one
+    TEST_ASSERT_TRUE(stats[0].time_us >= SLOW_INIT_US);
+#else
+    TEST_IGNORE_MESSAGE("Static initializers timed with GCC and the RTOS only");
+#endif
+}
+
+Case cases[] = {
+    Case("Boot phase marks", test_case_boot_marks),
+    Case("Application boot mark", test_case_application_mark),
+    Case("Static initializer times", test_case_initializers),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(MBED_BOOT_STATS_ENABLED)
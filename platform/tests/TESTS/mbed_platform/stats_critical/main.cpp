@@ -0,0 +1,115 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_CRITICAL_STATS_ENABLED)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define LONG_SECTION_US     300
+#define MAX_SECTION_STATS   MBED_CONF_PLATFORM_CRITICAL_STATS_MAX
+
+static MBED_NOINLINE void long_section(uint32_t us)
+{
+    core_util_critical_section_enter();
+    // Nested sections are timed as a whole
+    core_util_critical_section_enter();
+    wait_us(us);
+    core_util_critical_section_exit();
+    core_util_critical_section_exit();
+}
+
+void test_case_longest_section()
+{
+    mbed_stats_critical_section_t stats[MAX_SECTION_STATS];
+
+    mbed_stats_critical_section_reset();
+    long_section(LONG_SECTION_US);
+
+    size_t count = mbed_stats_critical_section_get_each(stats, MAX_SECTION_STATS);
+    TEST_ASSERT_TRUE(count >= 1);
+    TEST_ASSERT_NOT_NULL(stats[0].caller);
+    TEST_ASSERT_TRUE(stats[0].max_us >= LONG_SECTION_US);
+    TEST_ASSERT_TRUE(stats[0].max_us < 2 * LONG_SECTION_US);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT_TRUE(stats[i].cycles <= stats[i - 1].cycles);
+        TEST_ASSERT_TRUE(stats[i].caller != stats[0].caller);
+    }
+
+    // A shorter section of the same caller keeps its longest one
+    long_section(LONG_SECTION_US / 2);
+    mbed_stats_critical_section_get_each(stats, MAX_SECTION_STATS);
+    TEST_ASSERT_TRUE(stats[0].max_us >= LONG_SECTION_US);
+}
+
+void test_case_histogram()
+{
+    mbed_stats_latency_t histogram;
+
+    mbed_stats_critical_section_reset();
+    mbed_stats_critical_section_histogram_get(&histogram);
+    // The section of the call itself may already be counted
+    TEST_ASSERT_TRUE(histogram.max_us < LONG_SECTION_US);
+
+    long_section(LONG_SECTION_US);
+    mbed_stats_critical_section_histogram_get(&histogram);
+    TEST_ASSERT_TRUE(histogram.max_us >= LONG_SECTION_US);
+
+    // 300 us is counted in the bucket of 256 to 511 us
+    TEST_ASSERT_TRUE(histogram.bucket[8] >= 1);
+}
+
+void test_case_reset()
+{
+    mbed_stats_critical_section_t stats[MAX_SECTION_STATS];
+
+    long_section(LONG_SECTION_US);
+    mbed_stats_critical_section_reset();
+
+    size_t count = mbed_stats_critical_section_get_each(stats, MAX_SECTION_STATS);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(stats[i].max_us < LONG_SECTION_US);
+    }
+}
+
+Case cases[] = {
+    Case("Longest critical sections", test_case_longest_section),
+    Case("Critical section histogram", test_case_histogram),
+    Case("Critical section stats reset", test_case_reset),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(MBED_CRITICAL_STATS_ENABLED)
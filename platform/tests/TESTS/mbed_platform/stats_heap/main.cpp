@@ -188,11 +188,109 @@ void test_case_realloc_size()
     TEST_ASSERT_EQUAL_UINT32(stats_start.current_size, stats_current.current_size);
 }
 
+#define FRAGMENT_BLOCKS 16
+
+void test_case_fragmentation()
+{
+    mbed_stats_heap_fragmentation_t frag_start;
+    mbed_stats_heap_fragmentation_t frag_current;
+    void *data[FRAGMENT_BLOCKS];
+
+    mbed_stats_heap_fragmentation_get(&frag_start);
+    if (frag_start.free_block_cnt == 0) {
+        TEST_IGNORE_MESSAGE("Free blocks not known with this allocator");
+    }
+    TEST_ASSERT(frag_start.largest_free_size <= frag_start.free_size);
+
+    for (uint32_t i = 0; i < FRAGMENT_BLOCKS; i++) {
+        data[i] = malloc(ALLOCATION_SIZE_SMALL);
+        TEST_ASSERT(data[i] != NULL);
+    }
+
+    // Free every other block, leaving holes between the blocks kept
+    for (uint32_t i = 0; i < FRAGMENT_BLOCKS; i += 2) {
+        free(data[i]);
+    }
+    mbed_stats_heap_fragmentation_get(&frag_current);
+    TEST_ASSERT(frag_current.free_block_cnt > frag_start.free_block_cnt);
+    TEST_ASSERT(frag_current.largest_free_size <= frag_current.free_size);
+    TEST_ASSERT(frag_current.fragmentation >= frag_start.fragmentation);
+
+    for (uint32_t i = 1; i < FRAGMENT_BLOCKS; i += 2) {
+        free(data[i]);
+    }
+    mbed_stats_heap_fragmentation_get(&frag_current);
+    TEST_ASSERT_EQUAL_UINT32(frag_start.free_size, frag_current.free_size);
+}
+
+#if MBED_HEAP_STATS_SITES
+static mbed_stats_heap_site_t sites_start[MBED_HEAP_STATS_SITES];
+static mbed_stats_heap_site_t sites_current[MBED_HEAP_STATS_SITES];
+
+static const mbed_stats_heap_site_t *find_site(const mbed_stats_heap_site_t *sites, size_t count, void *caller)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (sites[i].caller == caller) {
+            return &sites[i];
+        }
+    }
+    return NULL;
+}
+
+void test_case_sites()
+{
+    void *data[3];
+
+    size_t count_start = mbed_stats_heap_site_get_each(sites_start, MBED_HEAP_STATS_SITES);
+
+    // One call site for the three allocations
+    for (uint32_t i = 0; i < 3; i++) {
+        data[i] = malloc(ALLOCATION_SIZE_DEFAULT);
+        TEST_ASSERT(data[i] != NULL);
+    }
+    size_t count = mbed_stats_heap_site_get_each(sites_current, MBED_HEAP_STATS_SITES);
+    TEST_ASSERT(count > 0);
+
+    const mbed_stats_heap_site_t *site = NULL;
+    uint32_t alloc_cnt_start = 0;
+    uint32_t total_cnt_start = 0;
+    uint32_t size_start = 0;
+    for (size_t i = 0; i < count && site == NULL; i++) {
+        const mbed_stats_heap_site_t *before = find_site(sites_start, count_start, sites_current[i].caller);
+        alloc_cnt_start = before ? before->alloc_cnt : 0;
+        total_cnt_start = before ? before->total_cnt : 0;
+        size_start = before ? before->current_size : 0;
+        if (sites_current[i].alloc_cnt == alloc_cnt_start + 3 &&
+                sites_current[i].current_size == size_start + 3 * ALLOCATION_SIZE_DEFAULT) {
+            site = &sites_current[i];
+        }
+    }
+    TEST_ASSERT(site != NULL);
+    TEST_ASSERT_EQUAL_UINT32(total_cnt_start + 3, site->total_cnt);
+    TEST_ASSERT(site->max_size >= site->current_size);
+    void *caller = site->caller;
+
+    for (uint32_t i = 0; i < 3; i++) {
+        free(data[i]);
+    }
+    count = mbed_stats_heap_site_get_each(sites_current, MBED_HEAP_STATS_SITES);
+    site = find_site(sites_current, count, caller);
+    TEST_ASSERT(site != NULL);
+    TEST_ASSERT_EQUAL_UINT32(alloc_cnt_start, site->alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(size_start, site->current_size);
+    TEST_ASSERT_EQUAL_UINT32(total_cnt_start + 3, site->total_cnt);
+}
+#endif // MBED_HEAP_STATS_SITES
+
 Case cases[] = {
     Case("malloc and free size", test_case_malloc_free_size),
     Case("allocate size zero", test_case_allocate_zero),
     Case("allocation failure", test_case_allocate_fail),
     Case("realloc size", test_case_realloc_size),
+    Case("fragmentation", test_case_fragmentation),
+#if MBED_HEAP_STATS_SITES
+    Case("allocation sites", test_case_sites),
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -351,6 +351,86 @@ TEST_F(test_ATCmdParser, test_ATCmdParser_recv)
 
 }
 
+TEST_F(test_ATCmdParser, test_ATCmdParser_recv_prefix)
+{
+    FileHandle_stub fh1;
+    ATCmdParser at(&fh1);
+
+    // lines not starting with the literal prefix are skipped
+    char table1[] = "busy p...\r\n+IPD,1,5:hello\r\n";
+    int id;
+    int len;
+    char data[6] = {0};
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    EXPECT_TRUE(at.recv("+IPD,%d,%d:%5c\n", &id, &len, data));
+    EXPECT_EQ(id, 1);
+    EXPECT_EQ(len, 5);
+    EXPECT_EQ(memcmp(data, "hello", 5), 0);
+
+    char table2[] = "+CWJAP:\"my ap\",-70\r\n";
+    char ssid[16] = {0};
+    int rssi;
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    EXPECT_TRUE(at.recv("+CWJAP:\"%15[^\"]\",%d\n", ssid, &rssi));
+    EXPECT_EQ(strcmp(ssid, "my ap"), 0);
+    EXPECT_EQ(rssi, -70);
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
+static int oob_a_count;
+static int oob_b_count;
+
+static void oob_a()
+{
+    oob_a_count++;
+}
+
+static void oob_b()
+{
+    oob_b_count++;
+}
+
+TEST_F(test_ATCmdParser, test_ATCmdParser_oob_table)
+{
+    FileHandle_stub fh1;
+    ATCmdParser at(&fh1);
+    at.set_timeout(10);
+
+    // more prefixes than hash buckets, some of the same length
+    const char *prefixes[] = { "+A", "+B", "+C", "+D", "+E", "+F", "+G", "+H", "+IPD", "WIFI ", "ready" };
+    for (unsigned i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+        at.oob(prefixes[i], &oob_b);
+    }
+    at.oob("+IPD", &oob_a);
+
+    char table[] = "+IPD,0,1:x\r\nOK\r\n";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    oob_a_count = 0;
+    oob_b_count = 0;
+    EXPECT_TRUE(at.recv("OK"));
+    EXPECT_EQ(oob_a_count, 1);
+    EXPECT_EQ(oob_b_count, 0);
+
+    // the last registered +IPD handler is removed, the previous one is used again
+    at.remove_oob("+IPD");
+    filehandle_stub_table_pos = 0;
+    EXPECT_TRUE(at.recv("OK"));
+    EXPECT_EQ(oob_a_count, 1);
+    EXPECT_EQ(oob_b_count, 1);
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
 TEST_F(test_ATCmdParser, test_ATCmdParser_scanf)
 {
     FileHandle_stub fh1;
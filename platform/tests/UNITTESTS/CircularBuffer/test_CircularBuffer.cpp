@@ -37,3 +37,102 @@ TEST_F(TestCircularBuffer, constructor)
 {
     EXPECT_TRUE(buf);
 }
+
+TEST_F(TestCircularBuffer, peek_contiguous_empty)
+{
+    EXPECT_TRUE(buf->peek_contiguous().empty());
+}
+
+TEST_F(TestCircularBuffer, peek_contiguous_wrap)
+{
+    for (int i = 0; i < 8; i++) {
+        buf->push(i);
+    }
+    buf->consume(6);
+    for (int i = 8; i < 16; i++) {
+        buf->push(i);
+    }
+    EXPECT_TRUE(buf->full());
+
+    // 6..9 are at the end of the pool, 10..15 wrapped to the beginning
+    mbed::Span<const int> first = buf->peek_contiguous();
+    ASSERT_EQ(4, first.size());
+    EXPECT_EQ(6, first[0]);
+    EXPECT_EQ(9, first[3]);
+
+    buf->consume(first.size());
+    EXPECT_FALSE(buf->full());
+    EXPECT_EQ(6, buf->size());
+
+    mbed::Span<const int> second = buf->peek_contiguous();
+    ASSERT_EQ(6, second.size());
+    EXPECT_EQ(10, second[0]);
+    EXPECT_EQ(15, second[5]);
+
+    buf->consume(second.size());
+    EXPECT_TRUE(buf->empty());
+}
+
+TEST_F(TestCircularBuffer, push_pop_span)
+{
+    int input[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    int output[10] = {};
+
+    buf->push(input, 8);
+    EXPECT_EQ(3, buf->pop(output, 3));
+    EXPECT_EQ(2, output[2]);
+
+    // Wraps around and overwrites the oldest elements
+    buf->push(mbed::Span<const int>(input, 8));
+    EXPECT_TRUE(buf->full());
+    EXPECT_EQ(10, buf->pop(mbed::Span<int>(output, 10)));
+    const int expected[10] = {6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(expected[i], output[i]);
+    }
+    EXPECT_TRUE(buf->empty());
+    EXPECT_EQ(0, buf->pop(output, 10));
+}
+
+TEST_F(TestCircularBuffer, push_span_larger_than_buffer)
+{
+    int input[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    int output[10] = {};
+
+    buf->push(input, 12);
+    EXPECT_TRUE(buf->full());
+    EXPECT_EQ(10, buf->pop(output, 10));
+    EXPECT_EQ(2, output[0]);
+    EXPECT_EQ(11, output[9]);
+}
+
+TEST_F(TestCircularBuffer, reserve_commit)
+{
+    for (int i = 0; i < 7; i++) {
+        buf->push(i);
+    }
+    buf->consume(5);
+
+    // 3 free elements at the end of the pool, then 5 at the beginning
+    mbed::Span<int> first = buf->reserve_contiguous();
+    ASSERT_EQ(3, first.size());
+    for (int i = 0; i < 3; i++) {
+        first[i] = 7 + i;
+    }
+    buf->commit(first.size());
+
+    mbed::Span<int> second = buf->reserve_contiguous();
+    ASSERT_EQ(5, second.size());
+    for (int i = 0; i < 5; i++) {
+        second[i] = 10 + i;
+    }
+    buf->commit(second.size());
+    EXPECT_TRUE(buf->full());
+    EXPECT_TRUE(buf->reserve_contiguous().empty());
+
+    int data;
+    for (int i = 5; i < 15; i++) {
+        ASSERT_TRUE(buf->pop(data));
+        EXPECT_EQ(i, data);
+    }
+}
@@ -8,4 +8,6 @@ set(unittest-sources
 
 set(unittest-test-sources
   ../platform/tests/UNITTESTS/CircularBuffer/test_CircularBuffer.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
 )
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include "platform/CircularBuffer.h"
+
+#define BUFFER_SIZE 256
+#define CHUNK_SIZE  64
+
+class TestCircularBufferPerf : public testing::Test {
+protected:
+    mbed::CircularBuffer<uint32_t, BUFFER_SIZE> buf;
+    // Sum of the items popped, checked so the work is not optimized out
+    uint64_t sum;
+
+    virtual void SetUp()
+    {
+        sum = 0;
+    }
+};
+
+TEST_F(TestCircularBufferPerf, push_pop)
+{
+    auto workload = [this](size_t items) {
+        for (size_t i = 0; i < items; i++) {
+            buf.push(i);
+            // Keep the buffer half full so the indexes wrap
+            if (buf.size() > BUFFER_SIZE / 2) {
+                uint32_t data;
+                buf.pop(data);
+                sum += data;
+            }
+        }
+        buf.reset();
+    };
+    EXPECT_TRUE(perf::scales_linearly("push_pop", 1 << 14, 1 << 18, workload));
+    EXPECT_NE(0, sum);
+}
+
+TEST_F(TestCircularBufferPerf, push_pop_chunks)
+{
+    uint32_t chunk[CHUNK_SIZE];
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = i;
+    }
+
+    auto workload = [this, &chunk](size_t items) {
+        for (size_t i = 0; i < items; i += CHUNK_SIZE) {
+            buf.push(chunk, CHUNK_SIZE);
+            if (buf.size() > BUFFER_SIZE / 2) {
+                uint32_t data[CHUNK_SIZE];
+                EXPECT_EQ(CHUNK_SIZE, buf.pop(data, CHUNK_SIZE));
+                sum += data[CHUNK_SIZE - 1];
+            }
+        }
+        buf.reset();
+    };
+    EXPECT_TRUE(perf::scales_linearly("push_pop_chunks", 1 << 16, 1 << 20, workload));
+    EXPECT_NE(0, sum);
+}
+
+TEST_F(TestCircularBufferPerf, peek_consume)
+{
+    auto workload = [this](size_t items) {
+        for (size_t i = 0; i < items; i++) {
+            buf.push(i);
+            if (buf.full()) {
+                // Drain the contiguous part without copying
+                mbed::Span<const uint32_t> data = buf.peek_contiguous();
+                sum += data[0];
+                buf.consume(data.size());
+            }
+        }
+        buf.reset();
+    };
+    EXPECT_TRUE(perf::scales_linearly("peek_consume", 1 << 14, 1 << 18, workload));
+    EXPECT_NE(0, sum);
+}
@@ -0,0 +1,17 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/CircularBuffer_perf/test_CircularBuffer_perf.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-labels
+  perf
+)
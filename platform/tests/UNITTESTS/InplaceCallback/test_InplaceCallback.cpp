@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/InplaceCallback.h"
+
+using mbed::Callback;
+using mbed::InplaceCallback;
+
+static int add(int a, int b)
+{
+    return a + b;
+}
+
+// Counts the live copies, to check the copies and the destructions
+struct Counted {
+    static int live;
+    int value;
+
+    Counted(int v) : value(v)
+    {
+        live++;
+    }
+    Counted(const Counted &other) : value(other.value)
+    {
+        live++;
+    }
+    ~Counted()
+    {
+        live--;
+    }
+    int operator()(int a) const
+    {
+        return a * value;
+    }
+};
+
+int Counted::live = 0;
+
+TEST(InplaceCallbackTest, empty)
+{
+    InplaceCallback<int(int, int), 16> cb;
+    EXPECT_FALSE(cb);
+
+    int (*null_func)(int, int) = nullptr;
+    InplaceCallback<int(int, int), 16> null_cb(null_func);
+    EXPECT_FALSE(null_cb);
+
+    InplaceCallback<int(int, int), 16> copy(cb);
+    EXPECT_FALSE(copy);
+}
+
+TEST(InplaceCallbackTest, function_pointer)
+{
+    InplaceCallback<int(int, int), 16> cb(add);
+    EXPECT_TRUE(cb);
+    EXPECT_EQ(5, cb(2, 3));
+    using Thunked = InplaceCallback<int(int, int), 16>;
+    EXPECT_EQ(7, Thunked::thunk(&cb, 3, 4));
+
+    cb = nullptr;
+    EXPECT_FALSE(cb);
+}
+
+TEST(InplaceCallbackTest, large_lambda)
+{
+    uint32_t a = 1, b = 2, c = 3, d = 4, e = 5, f = 6;
+    InplaceCallback<uint32_t(), 24> cb = [ = ] {
+        return a + b + c + d + e + f;
+    };
+    EXPECT_EQ(21u, cb());
+
+    InplaceCallback<uint32_t(), 24> copy;
+    copy = cb;
+    cb = nullptr;
+    EXPECT_EQ(21u, copy());
+
+    // Wrapped by a Callback, which only keeps a pointer to it
+    Callback<uint32_t()> wrapped(&copy, &InplaceCallback<uint32_t(), 24>::call);
+    EXPECT_EQ(21u, wrapped());
+}
+
+TEST(InplaceCallbackTest, nontrivial)
+{
+    {
+        InplaceCallback<int(int), 8> cb = Counted(3);
+        EXPECT_EQ(1, Counted::live);
+        EXPECT_EQ(6, cb(2));
+
+        InplaceCallback<int(int), 8> copy(cb);
+        EXPECT_EQ(2, Counted::live);
+        EXPECT_EQ(9, copy(3));
+
+        cb = [](int a) {
+            return a + 1;
+        };
+        EXPECT_EQ(1, Counted::live);
+        EXPECT_EQ(3, cb(2));
+    }
+    EXPECT_EQ(0, Counted::live);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/IntrusivePtr.h"
+#include "platform/ObjectPool.h"
+
+using mbed::IntrusivePtr;
+using mbed::ObjectPool;
+using mbed::RefCounted;
+using mbed::make_intrusive;
+
+namespace {
+
+struct Counted : RefCounted<Counted> {
+    explicit Counted(int value = 0) : value(value)
+    {
+        instances++;
+    }
+
+    virtual ~Counted()
+    {
+        instances--;
+    }
+
+    int value;
+    static int instances;
+};
+
+int Counted::instances = 0;
+
+struct Derived : Counted {
+    Derived() : Counted(2)
+    {
+    }
+};
+
+struct Pooled : RefCounted<Pooled> {
+    explicit Pooled(int value) : value(value)
+    {
+    }
+
+    void destroy()
+    {
+        pool.destroy(this);
+    }
+
+    int value;
+    static ObjectPool<Pooled, 2> pool;
+};
+
+ObjectPool<Pooled, 2> Pooled::pool;
+
+}
+
+TEST(IntrusivePtrTest, size)
+{
+    EXPECT_EQ(sizeof(IntrusivePtr<Counted>), sizeof(Counted *));
+}
+
+TEST(IntrusivePtrTest, empty)
+{
+    IntrusivePtr<Counted> ptr;
+    EXPECT_FALSE(ptr);
+    EXPECT_TRUE(ptr == nullptr);
+    EXPECT_EQ(ptr.get(), nullptr);
+    EXPECT_EQ(ptr.use_count(), 0u);
+    ptr.reset();
+    EXPECT_EQ(ptr.get(), nullptr);
+}
+
+TEST(IntrusivePtrTest, copy_and_release)
+{
+    {
+        IntrusivePtr<Counted> ptr(new Counted(1));
+        EXPECT_EQ(Counted::instances, 1);
+        EXPECT_EQ(ptr.use_count(), 1u);
+        EXPECT_EQ(ptr->value, 1);
+
+        IntrusivePtr<Counted> copy = ptr;
+        EXPECT_EQ(ptr.use_count(), 2u);
+        EXPECT_TRUE(copy == ptr);
+
+        IntrusivePtr<Counted> other;
+        other = copy;
+        EXPECT_EQ(ptr.use_count(), 3u);
+
+        copy.reset();
+        other = nullptr;
+        EXPECT_EQ(ptr.use_count(), 1u);
+        EXPECT_EQ(Counted::instances, 1);
+    }
+    EXPECT_EQ(Counted::instances, 0);
+}
+
+TEST(IntrusivePtrTest, move)
+{
+    IntrusivePtr<Counted> ptr = make_intrusive<Counted>(3);
+    Counted *raw = ptr.get();
+
+    IntrusivePtr<Counted> moved(std::move(ptr));
+    EXPECT_EQ(ptr.get(), nullptr);
+    EXPECT_EQ(moved.get(), raw);
+    EXPECT_EQ(moved.use_count(), 1u);
+
+    IntrusivePtr<Counted> assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(moved.get(), nullptr);
+    EXPECT_EQ(assigned.use_count(), 1u);
+
+    assigned = assigned;
+    EXPECT_EQ(assigned.use_count(), 1u);
+    EXPECT_EQ(Counted::instances, 1);
+
+    assigned.reset();
+    EXPECT_EQ(Counted::instances, 0);
+}
+
+TEST(IntrusivePtrTest, raw_pointer_shares_count)
+{
+    IntrusivePtr<Counted> ptr(new Counted());
+    // the count travels with the object: a raw pointer can be shared again
+    IntrusivePtr<Counted> again(ptr.get());
+    EXPECT_EQ(ptr.use_count(), 2u);
+
+    Counted *raw = again.detach();
+    EXPECT_EQ(ptr.use_count(), 2u);
+    raw->release();
+    EXPECT_EQ(ptr.use_count(), 1u);
+}
+
+TEST(IntrusivePtrTest, derived_to_base)
+{
+    IntrusivePtr<Derived> derived(new Derived());
+    IntrusivePtr<Counted> base = derived;
+    EXPECT_EQ(base.use_count(), 2u);
+    EXPECT_EQ(base->value, 2);
+
+    derived.reset();
+    base.reset();
+    EXPECT_EQ(Counted::instances, 0);
+}
+
+TEST(IntrusivePtrTest, pooled_objects)
+{
+    EXPECT_EQ(Pooled::pool.available(), 2u);
+    {
+        IntrusivePtr<Pooled> a(Pooled::pool.construct(1));
+        IntrusivePtr<Pooled> b(Pooled::pool.construct(2));
+        EXPECT_EQ(Pooled::pool.available(), 0u);
+        EXPECT_EQ(Pooled::pool.construct(3), nullptr);
+
+        IntrusivePtr<Pooled> c = a;
+        a.reset();
+        EXPECT_EQ(Pooled::pool.available(), 0u);
+        EXPECT_EQ(c->value, 1);
+        c.reset();
+        EXPECT_EQ(Pooled::pool.available(), 1u);
+    }
+    EXPECT_EQ(Pooled::pool.available(), 2u);
+}
@@ -0,0 +1,14 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/IntrusivePtr/test_IntrusivePtr.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+)
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/LockFreePool.h"
+
+#include <stdint.h>
+
+using mbed::LockFreePool;
+
+namespace {
+
+struct Block {
+    uint32_t id;
+    char data[6];
+};
+
+struct alignas(16) Aligned {
+    char c;
+};
+
+}
+
+TEST(LockFreePoolTest, alloc_free)
+{
+    LockFreePool<Block, 3> pool;
+    EXPECT_EQ(pool.capacity(), 3u);
+    EXPECT_FALSE(pool.empty());
+
+    Block *blocks[3];
+    for (int i = 0; i < 3; i++) {
+        blocks[i] = pool.try_alloc();
+        ASSERT_NE(blocks[i], nullptr);
+        EXPECT_TRUE(pool.owns(blocks[i]));
+        blocks[i]->id = i;
+        for (int j = 0; j < i; j++) {
+            EXPECT_NE(blocks[i], blocks[j]);
+        }
+    }
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.try_alloc(), nullptr);
+
+    // the last block given back is the first reused
+    pool.free(blocks[1]);
+    pool.free(blocks[2]);
+    EXPECT_FALSE(pool.empty());
+    EXPECT_EQ(pool.try_alloc(), blocks[2]);
+    EXPECT_EQ(pool.try_alloc(), blocks[1]);
+    EXPECT_EQ(pool.try_alloc(), nullptr);
+    EXPECT_EQ(blocks[0]->id, 0u);
+
+    pool.free(nullptr);
+    for (int i = 0; i < 3; i++) {
+        pool.free(blocks[i]);
+    }
+    EXPECT_FALSE(pool.empty());
+}
+
+TEST(LockFreePoolTest, calloc)
+{
+    LockFreePool<Block, 1> pool;
+    Block *block = pool.try_alloc();
+    ASSERT_NE(block, nullptr);
+    memset(block, 0xA5, sizeof(Block));
+    pool.free(block);
+
+    block = pool.try_calloc();
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->id, 0u);
+    for (size_t i = 0; i < sizeof(block->data); i++) {
+        EXPECT_EQ(block->data[i], 0);
+    }
+}
+
+TEST(LockFreePoolTest, counter_wraps)
+{
+    LockFreePool<Block, 2> pool;
+    // Each operation increments the counter of the top, more than it holds
+    for (uint32_t i = 0; i < 0x10000; i++) {
+        Block *block = pool.try_alloc();
+        ASSERT_NE(block, nullptr);
+        pool.free(block);
+    }
+    Block *first = pool.try_alloc();
+    Block *second = pool.try_alloc();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.try_alloc(), nullptr);
+}
+
+TEST(LockFreePoolTest, owns)
+{
+    LockFreePool<Block, 2> pool;
+    Block outside;
+    EXPECT_FALSE(pool.owns(&outside));
+
+    Block *block = pool.try_alloc();
+    EXPECT_TRUE(pool.owns(block));
+    EXPECT_FALSE(pool.owns(reinterpret_cast<Block *>(reinterpret_cast<char *>(block) + 1)));
+    pool.free(block);
+}
+
+TEST(LockFreePoolTest, alignment)
+{
+    LockFreePool<Aligned, 3> pool;
+    for (int i = 0; i < 3; i++) {
+        Aligned *block = pool.try_alloc();
+        ASSERT_NE(block, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(Aligned), 0u);
+    }
+}
@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/LockFreePool/test_LockFreePool.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+)
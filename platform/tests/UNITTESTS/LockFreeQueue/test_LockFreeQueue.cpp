@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/LockFreeQueue.h"
+
+using mbed::SPSCQueue;
+using mbed::MPSCQueue;
+using mbed::Span;
+
+TEST(SPSCQueueTest, push_pop)
+{
+    SPSCQueue<int, 4> queue;
+    int data = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(data));
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(4u, queue.size());
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.pop(data));
+        EXPECT_EQ(i, data);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, bulk_wrap_around)
+{
+    SPSCQueue<int, 8> queue;
+    int input[6] = {1, 2, 3, 4, 5, 6};
+    int output[8] = {};
+
+    // Move the indices towards the end of the buffer
+    EXPECT_EQ(6u, queue.push(Span<const int>(input, 6)));
+    EXPECT_EQ(5u, queue.pop(Span<int>(output, 5)));
+
+    // Wraps around and only partially fits
+    EXPECT_EQ(6u, queue.push(Span<const int>(input, 6)));
+    EXPECT_EQ(1u, queue.push(Span<const int>(input, 6)));
+    EXPECT_TRUE(queue.full());
+
+    EXPECT_EQ(8u, queue.pop(Span<int>(output, 8)));
+    const int expected[8] = {6, 1, 2, 3, 4, 5, 6, 1};
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(expected[i], output[i]);
+    }
+    EXPECT_EQ(0u, queue.pop(Span<int>(output, 8)));
+}
+
+TEST(SPSCQueueTest, reset)
+{
+    SPSCQueue<char, 2> queue;
+
+    queue.push('a');
+    queue.reset();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(2u, queue.push(Span<const char>("bc", 2)));
+}
+
+TEST(MPSCQueueTest, push_pop)
+{
+    MPSCQueue<int, 4> queue;
+    int data = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(data));
+
+    // Several laps over the buffer
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(queue.push(lap * 10 + i));
+        }
+        EXPECT_FALSE(queue.push(-1));
+        EXPECT_EQ(4u, queue.size());
+
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(queue.pop(data));
+            EXPECT_EQ(lap * 10 + i, data);
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(MPSCQueueTest, bulk)
+{
+    MPSCQueue<int, 8> queue;
+    int input[6] = {1, 2, 3, 4, 5, 6};
+    int output[8] = {};
+
+    EXPECT_EQ(6u, queue.push(Span<const int>(input, 6)));
+    EXPECT_EQ(3u, queue.pop(Span<int>(output, 3)));
+
+    // Only the free slots are claimed
+    EXPECT_EQ(5u, queue.push(Span<const int>(input, 6)));
+    EXPECT_EQ(0u, queue.push(Span<const int>(input, 6)));
+
+    EXPECT_EQ(8u, queue.pop(Span<int>(output, 8)));
+    const int expected[8] = {4, 5, 6, 1, 2, 3, 4, 5};
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(expected[i], output[i]);
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/LockFreeQueue/test_LockFreeQueue.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+)
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/ObjectPool.h"
+
+#include <stdint.h>
+
+using mbed::ObjectPool;
+
+namespace {
+
+struct Tracked {
+    Tracked(int a, int b) : sum(a + b)
+    {
+        instances++;
+    }
+
+    ~Tracked()
+    {
+        instances--;
+    }
+
+    int sum;
+    static int instances;
+};
+
+int Tracked::instances = 0;
+
+struct alignas(16) Aligned {
+    char c;
+};
+
+}
+
+TEST(ObjectPoolTest, construct_destroy)
+{
+    ObjectPool<Tracked, 3> pool;
+    EXPECT_EQ(pool.capacity(), 3u);
+    EXPECT_EQ(pool.available(), 3u);
+
+    Tracked *objs[3];
+    for (int i = 0; i < 3; i++) {
+        objs[i] = pool.construct(i, 10);
+        ASSERT_NE(objs[i], nullptr);
+        EXPECT_EQ(objs[i]->sum, i + 10);
+        EXPECT_TRUE(pool.owns(objs[i]));
+    }
+    EXPECT_EQ(Tracked::instances, 3);
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(pool.construct(0, 0), nullptr);
+    EXPECT_EQ(Tracked::instances, 3);
+
+    pool.destroy(objs[1]);
+    EXPECT_EQ(Tracked::instances, 2);
+    EXPECT_EQ(pool.available(), 1u);
+
+    // the storage given back is reused
+    Tracked *again = pool.construct(5, 5);
+    EXPECT_EQ(again, objs[1]);
+    EXPECT_EQ(again->sum, 10);
+
+    pool.destroy(objs[0]);
+    pool.destroy(again);
+    pool.destroy(objs[2]);
+    pool.destroy(nullptr);
+    EXPECT_EQ(Tracked::instances, 0);
+    EXPECT_EQ(pool.available(), 3u);
+}
+
+TEST(ObjectPoolTest, owns)
+{
+    ObjectPool<Tracked, 2> pool;
+    Tracked outside(0, 0);
+    EXPECT_FALSE(pool.owns(&outside));
+
+    Tracked *obj = pool.construct(1, 1);
+    EXPECT_TRUE(pool.owns(obj));
+    EXPECT_FALSE(pool.owns(reinterpret_cast<Tracked *>(reinterpret_cast<char *>(obj) + 1)));
+    pool.destroy(obj);
+}
+
+TEST(ObjectPoolTest, alignment)
+{
+    ObjectPool<Aligned, 3> pool;
+    for (int i = 0; i < 3; i++) {
+        Aligned *obj = pool.construct();
+        ASSERT_NE(obj, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(obj) % alignof(Aligned), 0u);
+    }
+}
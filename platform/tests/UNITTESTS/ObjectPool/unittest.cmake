@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/ObjectPool/test_ObjectPool.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_arena.h"
+#include "platform/mbed_stats.h"
+#include <string.h>
+
+class TestArena : public testing::Test {
+protected:
+    mbed_arena_t arena;
+    alignas(8) uint8_t buffer[256];
+
+    virtual void TearDown()
+    {
+        mbed_arena_deinit(&arena);
+    }
+
+    bool in_buffer(const void *ptr, size_t size)
+    {
+        return (const uint8_t *)ptr >= buffer && (const uint8_t *)ptr + size <= buffer + sizeof(buffer);
+    }
+};
+
+TEST_F(TestArena, buffer_only)
+{
+    mbed_arena_init(&arena, "buffer", buffer, sizeof(buffer), 0);
+
+    void *a = mbed_arena_alloc(&arena, 10);
+    void *b = mbed_arena_alloc(&arena, 1);
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(b != NULL);
+    EXPECT_TRUE(in_buffer(a, 10));
+    EXPECT_EQ((uint8_t *)a + 16, (uint8_t *)b);
+    EXPECT_EQ(0, (uintptr_t)b % MBED_ARENA_ALIGN);
+
+    EXPECT_TRUE(mbed_arena_alloc(&arena, 232) != NULL);
+    EXPECT_EQ(NULL, mbed_arena_alloc(&arena, 1));
+
+    mbed_arena_reset(&arena);
+    EXPECT_EQ(a, mbed_arena_alloc(&arena, 256));
+}
+
+TEST_F(TestArena, free_last)
+{
+    mbed_arena_init(&arena, "free", buffer, sizeof(buffer), 0);
+
+    void *a = mbed_arena_alloc(&arena, 32);
+    void *b = mbed_arena_alloc(&arena, 32);
+
+    // Only the last allocation is given back
+    mbed_arena_free(&arena, a);
+    EXPECT_EQ((uint8_t *)b + 32, mbed_arena_alloc(&arena, 8));
+    void *c = mbed_arena_alloc(&arena, 64);
+    mbed_arena_free(&arena, c);
+    EXPECT_EQ(c, mbed_arena_alloc(&arena, 64));
+
+    mbed_arena_free(&arena, NULL);
+}
+
+TEST_F(TestArena, heap_chunks)
+{
+    mbed_arena_init(&arena, "chunks", NULL, 0, 200);
+
+    uint8_t *a = (uint8_t *)mbed_arena_alloc(&arena, 50);
+    uint8_t *b = (uint8_t *)mbed_arena_alloc(&arena, 50);
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(b != NULL);
+    memset(a, 1, 50);
+    memset(b, 2, 50);
+    EXPECT_EQ(a + 56, b);
+
+    // Larger than a chunk, the current chunk stays in use
+    uint8_t *large = (uint8_t *)mbed_arena_alloc(&arena, 1000);
+    ASSERT_TRUE(large != NULL);
+    memset(large, 3, 1000);
+    mbed_arena_free(&arena, large);
+
+    uint8_t *c = (uint8_t *)mbed_arena_alloc(&arena, 50);
+    ASSERT_TRUE(c != NULL);
+    EXPECT_EQ(a + 112, c);
+    memset(c, 4, 50);
+
+    EXPECT_EQ(1, a[49]);
+    EXPECT_EQ(2, b[49]);
+    EXPECT_EQ(3, large[999]);
+
+    mbed_arena_reset(&arena);
+}
+
+TEST_F(TestArena, calloc)
+{
+    mbed_arena_init(&arena, "calloc", buffer, sizeof(buffer), 0);
+    memset(buffer, 0xFF, sizeof(buffer));
+
+    uint8_t *ptr = (uint8_t *)mbed_arena_calloc(&arena, 10, 4);
+    ASSERT_TRUE(ptr != NULL);
+    for (int i = 0; i < 40; i++) {
+        EXPECT_EQ(0, ptr[i]);
+    }
+
+    EXPECT_EQ(NULL, mbed_arena_calloc(&arena, SIZE_MAX / 2, 4));
+}
+
+TEST_F(TestArena, stats)
+{
+    mbed_arena_t other;
+    mbed_arena_init(&other, "other", NULL, 0, 64);
+    mbed_arena_init(&arena, "arena", buffer, sizeof(buffer), 128);
+
+    mbed_arena_alloc(&arena, 200);
+    mbed_arena_alloc(&arena, 100);
+    mbed_arena_alloc(&arena, 1000);
+    mbed_arena_calloc(&arena, SIZE_MAX / 2, 4);
+
+    mbed_stats_arena_t stats[4];
+    ASSERT_EQ(2, mbed_stats_arena_get_each(stats, 4));
+    EXPECT_STREQ("arena", stats[0].name);
+    EXPECT_EQ(200 + 104 + 1000, stats[0].current_size);
+    EXPECT_EQ(stats[0].current_size, stats[0].max_size);
+    EXPECT_GE(stats[0].reserved_size, 256 + 128 + 1000);
+    EXPECT_EQ(3, stats[0].alloc_cnt);
+    EXPECT_EQ(1, stats[0].alloc_fail_cnt);
+    EXPECT_STREQ("other", stats[1].name);
+    EXPECT_EQ(0, stats[1].current_size);
+
+    ASSERT_EQ(1, mbed_stats_arena_get_each(stats, 1));
+    EXPECT_STREQ("arena", stats[0].name);
+
+    mbed_arena_reset(&arena);
+    mbed_stats_arena_get_each(stats, 4);
+    EXPECT_EQ(0, stats[0].current_size);
+    EXPECT_EQ(200 + 104 + 1000, stats[0].max_size);
+    EXPECT_EQ(256, stats[0].reserved_size);
+    EXPECT_EQ(0, stats[0].alloc_cnt);
+
+    mbed_arena_deinit(&other);
+    ASSERT_EQ(1, mbed_stats_arena_get_each(stats, 4));
+    EXPECT_STREQ("arena", stats[0].name);
+}
@@ -0,0 +1,20 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/mbed_arena.c
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_arena/test_mbed_arena.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_HEAP_STATS_ENABLED=1
+)
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_clock_scaling.h"
+#include "hal/clock_scaling_api.h"
+#include <vector>
+
+static const uint32_t test_frequencies[] = { 80000000, 48000000, 16000000 };
+static uint32_t test_clock_hz = 80000000;
+static int test_set_calls;
+
+uint8_t clock_scaling_get_frequencies(uint32_t *frequencies, uint8_t size)
+{
+    for (uint8_t i = 0; i < 3 && i < size; i++) {
+        frequencies[i] = test_frequencies[i];
+    }
+    return 3;
+}
+
+int clock_scaling_set(uint32_t frequency_hz)
+{
+    test_set_calls++;
+    for (uint32_t f : test_frequencies) {
+        if (f == frequency_hz) {
+            test_clock_hz = frequency_hz;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+uint32_t clock_scaling_get(void)
+{
+    return test_clock_hz;
+}
+
+class TestClockScaling : public testing::Test {
+protected:
+    struct record {
+        int id;
+        uint32_t frequency_hz;
+    };
+
+    static std::vector<record> calls;
+    mbed_clock_notifier_t notifiers[3];
+    int ids[3] = { 0, 1, 2 };
+
+    static void handler(void *context, uint32_t frequency_hz)
+    {
+        calls.push_back({ *(int *)context, frequency_hz });
+    }
+
+    virtual void SetUp()
+    {
+        test_clock_hz = 80000000;
+        test_set_calls = 0;
+        calls.clear();
+        for (int i = 0; i < 3; i++) {
+            notifiers[i].handler = handler;
+            notifiers[i].context = &ids[i];
+            mbed_clock_notifier_add(&notifiers[i]);
+        }
+    }
+
+    virtual void TearDown()
+    {
+        for (int i = 0; i < 3; i++) {
+            mbed_clock_notifier_remove(&notifiers[i]);
+        }
+    }
+};
+
+std::vector<TestClockScaling::record> TestClockScaling::calls;
+
+TEST_F(TestClockScaling, frequencies)
+{
+    uint32_t frequencies[2];
+
+    EXPECT_EQ(3, mbed_clock_get_frequencies(frequencies, 2));
+    EXPECT_EQ(80000000u, frequencies[0]);
+    EXPECT_EQ(48000000u, frequencies[1]);
+    EXPECT_EQ(80000000u, mbed_clock_get_frequency());
+}
+
+TEST_F(TestClockScaling, notifiers_in_order)
+{
+    EXPECT_EQ(0, mbed_clock_set_frequency(16000000));
+    EXPECT_EQ(16000000u, mbed_clock_get_frequency());
+
+    ASSERT_EQ(3u, calls.size());
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(i, calls[i].id);
+        EXPECT_EQ(16000000u, calls[i].frequency_hz);
+    }
+}
+
+TEST_F(TestClockScaling, remove)
+{
+    mbed_clock_notifier_remove(&notifiers[1]);
+    // Removing twice is harmless
+    mbed_clock_notifier_remove(&notifiers[1]);
+
+    EXPECT_EQ(0, mbed_clock_set_frequency(48000000));
+    ASSERT_EQ(2u, calls.size());
+    EXPECT_EQ(0, calls[0].id);
+    EXPECT_EQ(2, calls[1].id);
+}
+
+TEST_F(TestClockScaling, unsupported)
+{
+    EXPECT_EQ(-1, mbed_clock_set_frequency(12345678));
+    EXPECT_EQ(80000000u, mbed_clock_get_frequency());
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST_F(TestClockScaling, same_frequency)
+{
+    EXPECT_EQ(0, mbed_clock_set_frequency(80000000));
+    EXPECT_EQ(0, test_set_calls);
+    EXPECT_TRUE(calls.empty());
+}
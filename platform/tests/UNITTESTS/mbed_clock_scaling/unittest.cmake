@@ -0,0 +1,18 @@
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/mbed_clock_scaling.c
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_clock_scaling/test_mbed_clock_scaling.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -DDEVICE_CLOCK_SCALING=1
+)
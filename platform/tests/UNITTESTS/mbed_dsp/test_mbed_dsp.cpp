@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_dsp.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define TAPS    15
+#define BLOCK   48
+#define MAX_FFT 1024
+
+class TestDsp : public testing::Test {
+protected:
+    int16_t random_q15()
+    {
+        return (int16_t)((rand() % 65536) - 32768);
+    }
+
+    /* DFT divided by n, the bins as packed by mbed_dsp_rfft_q15 */
+    void reference_rfft(const int16_t *x, size_t n, double *re, double *im)
+    {
+        for (size_t k = 0; k <= n / 2; k++) {
+            re[k] = 0;
+            im[k] = 0;
+            for (size_t i = 0; i < n; i++) {
+                double angle = 2 * M_PI * k * i / n;
+                re[k] += x[i] * cos(angle) / n;
+                im[k] -= x[i] * sin(angle) / n;
+            }
+        }
+    }
+
+    void check_rfft(size_t n, const int16_t *x, double tolerance)
+    {
+        int16_t twiddles[MAX_FFT];
+        int16_t data[MAX_FFT];
+        double re[MAX_FFT / 2 + 1];
+        double im[MAX_FFT / 2 + 1];
+
+        memcpy(data, x, n * sizeof(int16_t));
+        reference_rfft(x, n, re, im);
+        mbed_dsp_rfft_q15_init(twiddles, n);
+        mbed_dsp_rfft_q15(data, n, twiddles);
+
+        EXPECT_NEAR(re[0], data[0], tolerance);
+        EXPECT_NEAR(re[n / 2], data[1], tolerance);
+        for (size_t k = 1; k < n / 2; k++) {
+            EXPECT_NEAR(re[k], data[2 * k], tolerance) << "bin " << k;
+            EXPECT_NEAR(im[k], data[2 * k + 1], tolerance) << "bin " << k;
+        }
+    }
+};
+
+TEST_F(TestDsp, adc_to_q15)
+{
+    const uint16_t adc[] = {0, 2048, 4095, 1024, 3072};
+    int16_t q15[5];
+
+    mbed_dsp_adc_to_q15(adc, q15, 5, 12);
+    EXPECT_EQ(-32768, q15[0]);
+    EXPECT_EQ(0, q15[1]);
+    EXPECT_EQ(32752, q15[2]);
+    EXPECT_EQ(-16384, q15[3]);
+    EXPECT_EQ(16384, q15[4]);
+}
+
+TEST_F(TestDsp, adc_to_q15_in_place)
+{
+    uint16_t samples[] = {0x8000, 0xFFFF, 0x0000, 0x7FFF};
+    int16_t *q15 = reinterpret_cast<int16_t *>(samples);
+
+    mbed_dsp_adc_to_q15(samples, q15, 4, 16);
+    EXPECT_EQ(0, q15[0]);
+    EXPECT_EQ(32767, q15[1]);
+    EXPECT_EQ(-32768, q15[2]);
+    EXPECT_EQ(-1, q15[3]);
+}
+
+TEST_F(TestDsp, fir_decimate_matches_reference)
+{
+    int16_t coeffs[TAPS];
+    int16_t state[TAPS - 1 + BLOCK];
+    int16_t input[3 * BLOCK];
+    int16_t block[BLOCK];
+    mbed_dsp_fir_decimate_q15_t fir;
+
+    srand(1);
+    for (int i = 0; i < TAPS; i++) {
+        coeffs[i] = random_q15() / 8;
+    }
+    for (int i = 0; i < 3 * BLOCK; i++) {
+        input[i] = random_q15();
+    }
+
+    const int factor = 3;
+    mbed_dsp_fir_decimate_q15_init(&fir, coeffs, TAPS, factor, state, BLOCK);
+
+    // The blocks are processed in place, the filter carrying the history between them
+    for (int b = 0; b < 3; b++) {
+        memcpy(block, &input[b * BLOCK], sizeof(block));
+        ASSERT_EQ((size_t)(BLOCK / factor), mbed_dsp_fir_decimate_q15(&fir, block, block, BLOCK));
+
+        for (int o = 0; o < BLOCK / factor; o++) {
+            int n = b * BLOCK + o * factor + factor - 1;
+            int64_t acc = 0;
+            for (int k = 0; k < TAPS; k++) {
+                if (n - k >= 0) {
+                    acc += (int32_t)coeffs[TAPS - 1 - k] * input[n - k];
+                }
+            }
+            acc >>= 15;
+            int16_t expected = acc > 32767 ? 32767 : acc < -32768 ? -32768 : (int16_t)acc;
+            EXPECT_EQ(expected, block[o]) << "block " << b << " output " << o;
+        }
+    }
+}
+
+TEST_F(TestDsp, fir_without_decimation_saturates)
+{
+    const int16_t coeffs[2] = {32767, 32767};
+    int16_t state[1 + 4];
+    int16_t block[4] = {30000, 30000, -30000, -30000};
+    mbed_dsp_fir_decimate_q15_t fir;
+
+    mbed_dsp_fir_decimate_q15_init(&fir, coeffs, 2, 1, state, 4);
+    ASSERT_EQ(4u, mbed_dsp_fir_decimate_q15(&fir, block, block, 4));
+    EXPECT_EQ(29999, block[0]);
+    EXPECT_EQ(32767, block[1]);
+    EXPECT_EQ(0, block[2]);
+    EXPECT_EQ(-32768, block[3]);
+}
+
+TEST_F(TestDsp, rfft_of_sines)
+{
+    const size_t n = 256;
+    int16_t x[n];
+    for (size_t i = 0; i < n; i++) {
+        x[i] = (int16_t)(12000 * sin(2 * M_PI * 5 * i / n) + 6000 * cos(2 * M_PI * 40 * i / n) + 3000);
+    }
+
+    check_rfft(n, x, 8);
+
+    int16_t twiddles[n];
+    mbed_dsp_rfft_q15_init(twiddles, n);
+    mbed_dsp_rfft_q15(x, n, twiddles);
+    mbed_dsp_rfft_mag_q15(x, n);
+    EXPECT_NEAR(3000, x[0], 8);
+    EXPECT_NEAR(6000, x[5], 8);
+    EXPECT_NEAR(3000, x[40], 8);
+    EXPECT_NEAR(0, x[20], 8);
+}
+
+TEST_F(TestDsp, rfft_of_noise)
+{
+    srand(2);
+    for (size_t n = 4; n <= 1024; n *= 2) {
+        int16_t x[MAX_FFT];
+        for (size_t i = 0; i < n; i++) {
+            x[i] = random_q15();
+        }
+        check_rfft(n, x, 8);
+    }
+}
+
+TEST_F(TestDsp, rfft_of_full_scale)
+{
+    const size_t n = 64;
+    int16_t x[n];
+    for (size_t i = 0; i < n; i++) {
+        x[i] = (i & 1) ? -32768 : 32767;
+    }
+    check_rfft(n, x, 8);
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = -32768;
+    }
+    check_rfft(n, x, 8);
+}
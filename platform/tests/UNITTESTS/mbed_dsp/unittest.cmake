@@ -0,0 +1,15 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/mbed_dsp.c
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_dsp/test_mbed_dsp.cpp
+  stubs/mbed_assert_stub.cpp
+)
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_format.h"
+#include <string.h>
+
+extern "C" int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream);
+
+// Output of the runtime parser, for comparison
+static std::string runtime_format(const char *format, ...)
+{
+    char buffer[512];
+    va_list arguments;
+    va_start(arguments, format);
+    mbed_minimal_formatted_string(buffer, sizeof(buffer), format, arguments, NULL);
+    va_end(arguments);
+    return buffer;
+}
+
+static std::string compiled_format(const uint8_t *program, ...)
+{
+    char buffer[512];
+    va_list arguments;
+    va_start(arguments, program);
+    mbed_vsnprintf_compiled(buffer, sizeof(buffer), program, arguments);
+    va_end(arguments);
+    return buffer;
+}
+
+#define EXPECT_SAME_FORMAT(fmt, ...) \
+    EXPECT_EQ(runtime_format(fmt, __VA_ARGS__), compiled_format(MBED_FORMAT(fmt), __VA_ARGS__))
+
+TEST(TestFormat, program)
+{
+    static constexpr auto compiled = mbed::impl::compile_format<12>("a%%b%5lu\n");
+    static_assert(mbed::impl::compiled_format_size("a%%b%5lu\n") == 12, "compiled size");
+    static_assert(compiled.program[0] == MBED_FORMAT_OP_TEXT && compiled.program[1] == 3, "text run");
+    static_assert(compiled.program[2] == 'a' && compiled.program[3] == '%' && compiled.program[4] == 'b', "text");
+    static_assert(compiled.program[5] == 'u' && compiled.program[6] == MBED_FORMAT_LENGTH_L, "conversion");
+    static_assert(compiled.program[7] == MBED_FORMAT_PRECISION_DEFAULT, "precision");
+    static_assert(compiled.program[8] == MBED_FORMAT_OP_TEXT && compiled.program[10] == '\n', "newline");
+
+    static_assert(mbed::impl::compiled_format_size("") == 1, "empty format");
+}
+
+TEST(TestFormat, integers)
+{
+    EXPECT_SAME_FORMAT("%d %i %u", -42, 17, 4000000000u);
+    EXPECT_SAME_FORMAT("%hhd %hd %ld %lld", 300, 70000, -5L, -1234567890123LL);
+    EXPECT_SAME_FORMAT("%x %X %lx %llX", 0xbeefu, 0xbeefu, 0x12345678UL, 0x123456789abcdefULL);
+    EXPECT_SAME_FORMAT("%zu %jd %td", (size_t)99, (intmax_t) -7, (ptrdiff_t)3);
+    EXPECT_SAME_FORMAT("%-5d|%05d|%+d", 1, 2, 3);
+    EXPECT_EQ("-42 4000000000", compiled_format(MBED_FORMAT("%d %u"), -42, 4000000000u));
+}
+
+TEST(TestFormat, others)
+{
+    EXPECT_SAME_FORMAT("%c%c %s %p", 'o', 'k', "text", (void *)0x1234);
+    EXPECT_SAME_FORMAT("%.3s|%.*s|%*d", "abcdef", 2, "xyz", 8, 5);
+    EXPECT_SAME_FORMAT("%f %g", 3.25, -0.5);
+    EXPECT_SAME_FORMAT("100%% %s", "done");
+    EXPECT_EQ("a*b 100%", compiled_format(MBED_FORMAT("a%cb %d%%"), '*', 100));
+}
+
+TEST(TestFormat, long_text)
+{
+    // Text runs are split every 255 characters
+#define FORMAT_100 "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+#define FORMAT_300 FORMAT_100 FORMAT_100 FORMAT_100
+    static_assert(mbed::impl::compiled_format_size(FORMAT_300 "%d") == 2 + 255 + 2 + 45 + 3 + 1, "two text runs");
+    EXPECT_EQ(std::string(300, 'x') + "7", compiled_format(MBED_FORMAT(FORMAT_300 "%d"), 7));
+}
+
+TEST(TestFormat, buffer)
+{
+    char buffer[8];
+    memset(buffer, 'z', sizeof(buffer));
+    EXPECT_EQ(11, mbed_snprintf_compiled(buffer, 6, MBED_FORMAT("%s %d"), "hello", 12345));
+    EXPECT_STREQ("hello", buffer);
+    EXPECT_EQ('z', buffer[6]);
+
+    EXPECT_EQ(4, mbed_snprintf_compiled(NULL, 0, MBED_FORMAT("%d"), 1234));
+}
@@ -0,0 +1,13 @@
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/minimal-printf/mbed_printf_implementation.c
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_format/test_mbed_format.cpp
+)
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_mem_trace.h"
+
+class TestMemTraceRing : public testing::Test {
+protected:
+    mbed_mem_trace_record_t ring[4];
+
+    virtual void SetUp()
+    {
+        mbed_mem_trace_ring_init(ring, 4);
+        mbed_mem_trace_set_callback(mbed_mem_trace_ring_callback);
+    }
+
+    virtual void TearDown()
+    {
+        mbed_mem_trace_set_callback(NULL);
+    }
+
+    void trace_malloc(uint32_t res, size_t size)
+    {
+        mbed_mem_trace_lock();
+        mbed_mem_trace_malloc((void *)(uintptr_t)res, size, (void *)0x600d);
+        mbed_mem_trace_unlock();
+    }
+};
+
+TEST_F(TestMemTraceRing, records)
+{
+    mbed_mem_trace_lock();
+    mbed_mem_trace_malloc((void *)0x1000, 50, (void *)0x600d);
+    mbed_mem_trace_realloc((void *)0x2000, (void *)0x1000, 80, (void *)0x600e);
+    mbed_mem_trace_calloc((void *)0x3000, 4, 8, (void *)0x600f);
+    mbed_mem_trace_free((void *)0x2000, (void *)0x6010);
+    mbed_mem_trace_unlock();
+
+    mbed_mem_trace_record_t records[8];
+    ASSERT_EQ(4, mbed_mem_trace_ring_read(records, 8));
+
+    EXPECT_EQ(MBED_MEM_TRACE_MALLOC, records[0].op);
+    EXPECT_EQ(0, records[0].seq);
+    EXPECT_EQ(0x1000, records[0].res);
+    EXPECT_EQ(0x600d, records[0].caller);
+    EXPECT_EQ(50, records[0].arg1);
+    EXPECT_EQ(0, records[0].arg2);
+
+    EXPECT_EQ(MBED_MEM_TRACE_REALLOC, records[1].op);
+    EXPECT_EQ(1, records[1].seq);
+    EXPECT_EQ(0x2000, records[1].res);
+    EXPECT_EQ(0x1000, records[1].arg1);
+    EXPECT_EQ(80, records[1].arg2);
+
+    EXPECT_EQ(MBED_MEM_TRACE_CALLOC, records[2].op);
+    EXPECT_EQ(4, records[2].arg1);
+    EXPECT_EQ(8, records[2].arg2);
+
+    EXPECT_EQ(MBED_MEM_TRACE_FREE, records[3].op);
+    EXPECT_EQ(0, records[3].res);
+    EXPECT_EQ(0x6010, records[3].caller);
+    EXPECT_EQ(0x2000, records[3].arg1);
+
+    EXPECT_EQ(0, mbed_mem_trace_ring_read(records, 8));
+    EXPECT_EQ(0, mbed_mem_trace_ring_dropped());
+}
+
+TEST_F(TestMemTraceRing, full)
+{
+    for (uint32_t i = 0; i < 6; i++) {
+        trace_malloc(0x1000 + i, i);
+    }
+    EXPECT_EQ(2, mbed_mem_trace_ring_dropped());
+
+    mbed_mem_trace_record_t records[8];
+    ASSERT_EQ(2, mbed_mem_trace_ring_read(records, 2));
+    EXPECT_EQ(0x1000, records[0].res);
+    EXPECT_EQ(0x1001, records[1].res);
+
+    // The sequence numbers show the records that were dropped
+    trace_malloc(0x2000, 1);
+    ASSERT_EQ(3, mbed_mem_trace_ring_read(records, 8));
+    EXPECT_EQ(3, records[1].seq);
+    EXPECT_EQ(6, records[2].seq);
+    EXPECT_EQ(0x2000, records[2].res);
+}
+
+TEST_F(TestMemTraceRing, nested)
+{
+    // An operation traced inside another one, such as malloc inside realloc, isn't recorded
+    mbed_mem_trace_lock();
+    mbed_mem_trace_lock();
+    mbed_mem_trace_malloc((void *)0x1000, 50, (void *)0x600d);
+    mbed_mem_trace_unlock();
+    mbed_mem_trace_realloc((void *)0x1000, NULL, 50, (void *)0x600d);
+    mbed_mem_trace_unlock();
+
+    mbed_mem_trace_record_t records[4];
+    ASSERT_EQ(1, mbed_mem_trace_ring_read(records, 4));
+    EXPECT_EQ(MBED_MEM_TRACE_REALLOC, records[0].op);
+}
@@ -0,0 +1,18 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/mbed_mem_trace.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_mem_trace/test_mbed_mem_trace.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+  stubs/us_ticker_stub.cpp
+)
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ENTRIES 16
+
+class TestProfiler : public testing::Test {
+protected:
+    mbed_profiler_entry_t entries[ENTRIES];
+
+    virtual void SetUp()
+    {
+        mbed_profiler_reset();
+    }
+
+    uint32_t count_of(uint32_t pc, size_t filled)
+    {
+        for (size_t i = 0; i < filled; i++) {
+            if (entries[i].pc == pc) {
+                return entries[i].count;
+            }
+        }
+        return 0;
+    }
+};
+
+TEST_F(TestProfiler, samples_aggregate)
+{
+    for (int i = 0; i < 5; i++) {
+        mbed_profiler_sample(0x08001000);
+    }
+    mbed_profiler_sample(0x08001002);
+    mbed_profiler_sample(0x08002468);
+
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    EXPECT_EQ(7, stats.samples);
+    EXPECT_EQ(0, stats.dropped);
+    EXPECT_EQ(3, stats.entries);
+    EXPECT_EQ(0, stats.period_us);
+
+    size_t filled = mbed_profiler_get_each(entries, ENTRIES);
+    ASSERT_EQ(3, filled);
+    EXPECT_EQ(5, count_of(0x08001000, filled));
+    EXPECT_EQ(1, count_of(0x08001002, filled));
+    EXPECT_EQ(1, count_of(0x08002468, filled));
+
+    EXPECT_EQ(2, mbed_profiler_get_each(entries, 2));
+}
+
+TEST_F(TestProfiler, reset)
+{
+    mbed_profiler_sample(0x08001000);
+    mbed_profiler_reset();
+
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    EXPECT_EQ(0, stats.samples);
+    EXPECT_EQ(0, stats.entries);
+    EXPECT_EQ(0, mbed_profiler_get_each(entries, ENTRIES));
+}
+
+TEST_F(TestProfiler, full_table_drops)
+{
+    for (uint32_t i = 0; i < 4 * ENTRIES; i++) {
+        mbed_profiler_sample(0x08000000 + 2 * i);
+    }
+
+    mbed_profiler_stats_t stats;
+    mbed_profiler_get_stats(&stats);
+    EXPECT_EQ(4 * ENTRIES, stats.samples);
+    EXPECT_LE(stats.entries, ENTRIES);
+    EXPECT_EQ(4 * ENTRIES, stats.entries + stats.dropped);
+    EXPECT_EQ(stats.entries, mbed_profiler_get_each(entries, ENTRIES));
+
+    // The addresses recorded are still counted
+    uint32_t pc = entries[0].pc;
+    mbed_profiler_sample(pc);
+    EXPECT_EQ(2, count_of(pc, mbed_profiler_get_each(entries, ENTRIES)));
+}
+
+TEST_F(TestProfiler, dump)
+{
+    mbed_profiler_sample(0x0800abcd);
+    mbed_profiler_sample(0x0800abcd);
+
+    FILE *stream = tmpfile();
+    ASSERT_TRUE(stream != NULL);
+    mbed_profiler_dump(stream);
+    rewind(stream);
+
+    char line[64];
+    ASSERT_TRUE(fgets(line, sizeof(line), stream) != NULL);
+    EXPECT_STREQ(MBED_PROFILER_PREFIX "2;0;0\n", line);
+    ASSERT_TRUE(fgets(line, sizeof(line), stream) != NULL);
+    EXPECT_STREQ(MBED_PROFILER_PREFIX "800abcd;2\n", line);
+    EXPECT_EQ(NULL, fgets(line, sizeof(line), stream));
+    fclose(stream);
+}
+
+TEST_F(TestProfiler, no_timer)
+{
+    // The host has no sampling timer
+    EXPECT_EQ(-1, mbed_profiler_start(997));
+    EXPECT_EQ(-1, mbed_profiler_itm_start());
+    mbed_profiler_stop();
+}
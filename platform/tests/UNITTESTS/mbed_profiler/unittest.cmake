@@ -0,0 +1,19 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Source files
+set(unittest-sources
+  ../platform/source/mbed_profiler.c
+)
+
+# Test files
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_profiler/test_mbed_profiler.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_PLATFORM_PROFILER_ENTRIES=16
+)
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/internal/mbed_tlsf.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_SIZE 16384
+
+class TestTlsf : public testing::Test {
+protected:
+    mbed_tlsf_t tlsf;
+    alignas(8) uint8_t pool[POOL_SIZE];
+    size_t pool_total;
+
+    virtual void SetUp()
+    {
+        mbed_tlsf_init(&tlsf);
+        pool_total = mbed_tlsf_add_pool(&tlsf, pool, sizeof(pool));
+    }
+
+    bool in_pool(const void *ptr, size_t size)
+    {
+        return (const uint8_t *)ptr >= pool && (const uint8_t *)ptr + size <= pool + sizeof(pool);
+    }
+
+    // Largest single allocation that currently succeeds
+    size_t largest_free()
+    {
+        size_t low = 0;
+        size_t high = sizeof(pool);
+        while (low < high) {
+            size_t mid = (low + high + 1) / 2;
+            void *ptr = mbed_tlsf_malloc(&tlsf, mid);
+            if (ptr) {
+                mbed_tlsf_free(&tlsf, ptr);
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+        return low;
+    }
+};
+
+TEST_F(TestTlsf, add_pool)
+{
+    EXPECT_GT(pool_total, (size_t)POOL_SIZE - 64);
+    EXPECT_LE(pool_total, (size_t)POOL_SIZE);
+
+    mbed_tlsf_t small;
+    uint8_t mem[8];
+    mbed_tlsf_init(&small);
+    EXPECT_EQ(0, mbed_tlsf_add_pool(&small, mem, sizeof(mem)));
+    EXPECT_EQ(NULL, mbed_tlsf_malloc(&small, 1));
+}
+
+TEST_F(TestTlsf, malloc_free)
+{
+    void *ptr = mbed_tlsf_malloc(&tlsf, 100);
+    ASSERT_TRUE(ptr != NULL);
+    EXPECT_TRUE(in_pool(ptr, 100));
+    EXPECT_EQ(0, (uintptr_t)ptr % MBED_TLSF_ALIGN);
+    EXPECT_GE(mbed_tlsf_block_total_size(ptr), (size_t)100);
+    memset(ptr, 0xA5, 100);
+    mbed_tlsf_free(&tlsf, ptr);
+
+    mbed_tlsf_free(&tlsf, NULL);
+
+    ptr = mbed_tlsf_malloc(&tlsf, 0);
+    EXPECT_TRUE(ptr != NULL);
+    mbed_tlsf_free(&tlsf, ptr);
+}
+
+TEST_F(TestTlsf, exhaust)
+{
+    EXPECT_EQ(NULL, mbed_tlsf_malloc(&tlsf, POOL_SIZE));
+    EXPECT_EQ(NULL, mbed_tlsf_malloc(&tlsf, (size_t) -1));
+
+    void *ptrs[POOL_SIZE / 32];
+    int count = 0;
+    while (count < POOL_SIZE / 32 && (ptrs[count] = mbed_tlsf_malloc(&tlsf, 16)) != NULL) {
+        count++;
+    }
+    EXPECT_GT(count, POOL_SIZE / 64);
+    EXPECT_EQ(NULL, mbed_tlsf_malloc(&tlsf, 16));
+
+    for (int i = 0; i < count; i++) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+}
+
+TEST_F(TestTlsf, coalesce)
+{
+    // Requests are rounded up to the next size class, 1/16 of the size at most
+    size_t initial = largest_free();
+    EXPECT_GT(initial, (size_t)POOL_SIZE * 15 / 16 - 128);
+
+    void *ptrs[32];
+    for (int i = 0; i < 32; i++) {
+        ptrs[i] = mbed_tlsf_malloc(&tlsf, 200);
+        ASSERT_TRUE(ptrs[i] != NULL);
+    }
+    // Free every other block first so that merges happen on both sides
+    for (int i = 0; i < 32; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    for (int i = 1; i < 32; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+
+    EXPECT_EQ(initial, largest_free());
+}
+
+TEST_F(TestTlsf, free_info)
+{
+    mbed_tlsf_free_info_t info;
+    mbed_tlsf_free_info(&tlsf, &info);
+    EXPECT_EQ(1, info.free_blocks);
+    EXPECT_EQ(info.free_size, info.largest_free);
+    EXPECT_GE(info.largest_free, largest_free());
+    size_t initial = info.free_size;
+
+    void *ptrs[32];
+    for (int i = 0; i < 32; i++) {
+        ptrs[i] = mbed_tlsf_malloc(&tlsf, 200);
+        ASSERT_TRUE(ptrs[i] != NULL);
+    }
+    // Holes between allocated blocks, and the rest of the pool
+    for (int i = 0; i < 32; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    mbed_tlsf_free_info(&tlsf, &info);
+    EXPECT_EQ(17, info.free_blocks);
+    EXPECT_GE(info.largest_free, largest_free());
+    EXPECT_LT(info.largest_free, info.free_size);
+
+    for (int i = 1; i < 32; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    mbed_tlsf_free_info(&tlsf, &info);
+    EXPECT_EQ(1, info.free_blocks);
+    EXPECT_EQ(initial, info.free_size);
+}
+
+TEST_F(TestTlsf, memalign)
+{
+    size_t initial = largest_free();
+
+    for (size_t alignment = 1; alignment <= 1024; alignment <<= 1) {
+        void *ptr = mbed_tlsf_memalign(&tlsf, alignment, 40);
+        ASSERT_TRUE(ptr != NULL);
+        EXPECT_EQ(0, (uintptr_t)ptr % alignment);
+        EXPECT_TRUE(in_pool(ptr, 40));
+        memset(ptr, 0x5A, 40);
+        mbed_tlsf_free(&tlsf, ptr);
+    }
+    EXPECT_EQ(NULL, mbed_tlsf_memalign(&tlsf, 24, 40));
+
+    EXPECT_EQ(initial, largest_free());
+}
+
+TEST_F(TestTlsf, realloc)
+{
+    uint8_t *ptr = (uint8_t *)mbed_tlsf_realloc(&tlsf, NULL, 64);
+    ASSERT_TRUE(ptr != NULL);
+    for (int i = 0; i < 64; i++) {
+        ptr[i] = i;
+    }
+
+    // Grows in place into the free space after it
+    uint8_t *grown = (uint8_t *)mbed_tlsf_realloc(&tlsf, ptr, 1000);
+    EXPECT_EQ(ptr, grown);
+
+    // Moves when the next block is in use
+    void *blocker = mbed_tlsf_malloc(&tlsf, 16);
+    ASSERT_TRUE(blocker != NULL);
+    uint8_t *some = (uint8_t *)mbed_tlsf_realloc(&tlsf, grown, 64);
+    EXPECT_EQ(grown, some);
+    uint8_t *moved = (uint8_t *)mbed_tlsf_realloc(&tlsf, some, 4000);
+    ASSERT_TRUE(moved != NULL);
+    for (int i = 0; i < 64; i++) {
+        EXPECT_EQ(i, moved[i]);
+    }
+
+    // Failure leaves the memory allocated
+    EXPECT_EQ(NULL, mbed_tlsf_realloc(&tlsf, moved, POOL_SIZE));
+    EXPECT_EQ(0, moved[10] - 10);
+
+    EXPECT_EQ(NULL, mbed_tlsf_realloc(&tlsf, moved, 0));
+    mbed_tlsf_free(&tlsf, blocker);
+}
+
+TEST_F(TestTlsf, random)
+{
+    size_t initial = largest_free();
+
+    struct {
+        uint8_t *ptr;
+        size_t size;
+    } allocs[64] = {};
+    srand(1);
+
+    for (int i = 0; i < 20000; i++) {
+        int n = rand() % 64;
+        if (allocs[n].ptr) {
+            for (size_t j = 0; j < allocs[n].size; j++) {
+                ASSERT_EQ((uint8_t)n, allocs[n].ptr[j]);
+            }
+            if (rand() % 4 == 0) {
+                size_t size = rand() % 600;
+                uint8_t *ptr = (uint8_t *)mbed_tlsf_realloc(&tlsf, allocs[n].ptr, size);
+                if (ptr || size == 0) {
+                    allocs[n].ptr = ptr;
+                    allocs[n].size = ptr ? size : 0;
+                }
+            } else {
+                mbed_tlsf_free(&tlsf, allocs[n].ptr);
+                allocs[n].ptr = NULL;
+            }
+        } else {
+            size_t size = rand() % 600;
+            size_t alignment = (size_t)1 << (rand() % 8);
+            allocs[n].ptr = (uint8_t *)mbed_tlsf_memalign(&tlsf, alignment, size);
+            allocs[n].size = size;
+            if (allocs[n].ptr) {
+                ASSERT_TRUE(in_pool(allocs[n].ptr, size));
+                ASSERT_EQ(0, (uintptr_t)allocs[n].ptr % alignment);
+            }
+        }
+        if (allocs[n].ptr) {
+            memset(allocs[n].ptr, n, allocs[n].size);
+        }
+    }
+
+    for (int n = 0; n < 64; n++) {
+        mbed_tlsf_free(&tlsf, allocs[n].ptr);
+    }
+    EXPECT_EQ(initial, largest_free());
+}
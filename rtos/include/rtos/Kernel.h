@@ -50,30 +50,39 @@ namespace impl {
 uint64_t get_tick_count();
 }
 
-/** Read the current RTOS kernel millisecond tick count.
-     The tick count corresponds to the tick count the RTOS uses for timing
-     purposes. It increments monotonically from 0 at boot, so it effectively
-     never wraps. If the underlying RTOS only provides a 32-bit tick count,
-     this method expands it to 64 bits.
-     @return  RTOS kernel current tick count
-     @note Mbed OS always uses millisecond RTOS ticks, and this could only wrap
-           after half a billion years.
+/** Read the current RTOS kernel millisecond count.
+     It is derived from the tick count the RTOS uses for timing purposes.
+     It increments monotonically from 0 at boot, so it effectively never
+     wraps. If the underlying RTOS only provides a 32-bit tick count, this
+     method expands it to 64 bits.
+     @return  RTOS kernel current millisecond count
+     @note This could only wrap after half a billion years.
      @note You cannot call this function from ISR context.
      @deprecated Use `Kernel::Clock::now()` to get a chrono time_point instead of an integer millisecond count.
  */
 MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Use `Kernel::Clock::now()` to get a chrono time_point instead of an integer millisecond count.")
 uint64_t get_ms_count();
 
-/** A C++11 chrono TrivialClock for the kernel millisecond tick count
+/** A C++11 chrono TrivialClock for the kernel tick count
+ *
+ * The tick is 1 millisecond unless rtos.tick-freq is set to a higher rate,
+ * in which case the RTOS timeouts taking a Kernel::Clock::duration_u32 have
+ * the resolution of the tick. Durations of the clock only convert implicitly
+ * to milliseconds at the default rate, use std::chrono::duration_cast
+ * otherwise.
  *
  * @note To fit better into the chrono framework, Kernel::Clock uses
- *       std::chrono::milliseconds as its representation, which makes it signed
+ *       the representation of std::chrono::milliseconds, which makes it signed
  *       and at least 45 bits (so it will be int64_t or equivalent).
  */
 struct Clock {
     Clock() = delete;
     /* Standard TrivialClock fields */
+#if MBED_CONF_RTOS_PRESENT && defined(MBED_CONF_RTOS_TICK_FREQ)
+    using duration = std::chrono::duration<std::chrono::milliseconds::rep, std::ratio<1, MBED_CONF_RTOS_TICK_FREQ>>;
+#else
     using duration = std::chrono::milliseconds;
+#endif
     using rep = duration::rep;
     using period = duration::period;
 #if MBED_CONF_RTOS_PRESENT
@@ -109,7 +118,8 @@ struct Clock {
  *
  * @note As duration_u32-based APIs pass through straight to CMSIS-RTOS, they will
  *       interpret duration_u32(0xFFFFFFFF) as "wait forever". Indicate maximum
- *       wait time of 0xFFFFFFFE for these calls (which is ~49 days).
+ *       wait time of 0xFFFFFFFE ticks for these calls (which is ~49 days
+ *       with the default 1 millisecond tick).
  */
 constexpr Clock::duration_u32 wait_for_u32_max{osWaitForever - 1};
 
@@ -0,0 +1,188 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef LOCK_FREE_MAIL_H
+#define LOCK_FREE_MAIL_H
+
+#include <stdint.h>
+
+#include "rtos/Queue.h"
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/internal/mbed_rtos1_types.h"
+
+#include "platform/LockFreePool.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_LockFreeMail LockFreeMail class
+ * @{
+ */
+
+/** Mail whose memory blocks are allocated without the RTOS kernel.
+ *
+ * The same as Mail, except that the blocks come from an mbed::LockFreePool
+ * instead of a MemoryPool: allocating or freeing a block from an interrupt
+ * handler is a compare and swap, instead of a call deferred to the kernel.
+ * For interrupt handlers handing buffers to a thread at a high rate, such
+ * as DMA completions.
+ *
+ * Allocation doesn't block: there is no try_alloc_for or try_alloc_until.
+ *
+ * @tparam  T         Data type of a single mail message element.
+ * @tparam  queue_sz  Maximum number of mail messages in queue.
+ *
+ * @note
+ * Bare metal profile: This class is not supported.
+ */
+template<typename T, uint32_t queue_sz>
+class LockFreeMail : private mbed::NonCopyable<LockFreeMail<T, queue_sz> > {
+public:
+    /** Create and initialize Mail queue.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    LockFreeMail() = default;
+
+    /** Check if the mail queue is empty.
+     *
+     * @return True if the mail queue is empty.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const
+    {
+        return _queue.empty();
+    }
+
+    /** Check if the mail queue is full.
+     *
+     * @return True if the mail queue is full.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const
+    {
+        return _queue.full();
+    }
+
+    /** Allocate a memory block of type T, without blocking.
+     *
+     * @return  Pointer to memory block that you can fill with mail or nullptr if none is free.
+     *
+     * @note You may call this function from ISR context.
+     */
+    T *try_alloc()
+    {
+        return _pool.try_alloc();
+    }
+
+    /** Allocate a memory block of type T, and set memory block to zero.
+     *
+     * @return  Pointer to memory block that you can fill with mail or nullptr if none is free.
+     *
+     * @note You may call this function from ISR context.
+     */
+    T *try_calloc()
+    {
+        return _pool.try_calloc();
+    }
+
+    /** Put a mail in the queue.
+     *
+     * @param   mptr  Memory block previously allocated with try_alloc or try_calloc.
+     *
+     * @note You may call this function from ISR context.
+     * @note The queue has room for every block of the pool, so it always succeeds.
+     */
+    void put(T *mptr)
+    {
+        MBED_ASSERT(_pool.owns(mptr));
+        bool ok = _queue.try_put(mptr);
+        MBED_ASSERT(ok);
+        (void)ok;
+    }
+
+    /** Get a mail from the queue.
+     *
+     * @return Pointer to received mail, or nullptr if none was received.
+     *
+     * @note You may call this function from ISR context.
+     */
+    T *try_get()
+    {
+        T *mptr = nullptr;
+        _queue.try_get(&mptr);
+        return mptr;
+    }
+
+    /** Get a mail from the queue.
+     *
+     * @param rel_time Timeout value or Kernel::wait_for_u32_forever.
+     *
+     * @return Pointer to received mail, or nullptr if none was received.
+     *
+     * @note You may call this function from ISR context if the rel_time parameter is set to 0.
+     */
+    T *try_get_for(Kernel::Clock::duration_u32 rel_time)
+    {
+        T *mptr = nullptr;
+        _queue.try_get_for(rel_time, &mptr);
+        return mptr;
+    }
+
+    /** Free a memory block from a mail.
+     *
+     * @param mptr Pointer to the memory block that was obtained with try_get or try_get_for.
+     *
+     * @return osOK, or osErrorParameter if the block is not from this mail queue.
+     *
+     * @note You may call this function from ISR context.
+     */
+    osStatus free(T *mptr)
+    {
+        if (!_pool.owns(mptr)) {
+            return osErrorParameter;
+        }
+        _pool.free(mptr);
+        return osOK;
+    }
+
+private:
+    Queue<T, queue_sz> _queue;
+    mbed::LockFreePool<T, queue_sz> _pool;
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef SHARED_MUTEX_H
+#define SHARED_MUTEX_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/Kernel.h"
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+
+#include "platform/NonCopyable.h"
+#include "platform/ScopedLock.h"
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+class SharedMutex;
+/** Typedef for the shared (reader) lock of a SharedMutex
+ *
+ * Usage:
+ * @code
+ * void foo(SharedMutex &m) {
+ *     ScopedSharedMutexLock lock(m);
+ *     // Reads of the protected data in this block
+ * }
+ * @endcode
+ */
+typedef mbed::ScopedSharedLock<SharedMutex> ScopedSharedMutexLock;
+
+/**
+ * \defgroup rtos_SharedMutex SharedMutex class
+ * @{
+ */
+
+/** The SharedMutex class is a reader/writer lock.
+
+ Many threads can hold it shared with lock_shared() to read the protected data concurrently, while
+ a single thread holds it exclusive with lock() to modify it. It is meant for read-mostly data, such as
+ configuration or routing tables, where a Mutex would serialize the readers.
+
+ Writers have the preference: once a writer is waiting, new readers wait until it has finished,
+ so a stream of readers can't starve it.
+
+ The exclusive lock is an RTX mutex with priority inheritance, that readers also take briefly
+ when a writer is active: a reader waiting for a writer boosts it, so a high-priority reader isn't
+ held back by a low-priority writer being preempted. Readers don't take it when no writer is active,
+ so they proceed in parallel. Readers aren't boosted by a waiting writer, as a shared lock has no
+ single owner: keep the read sections short.
+
+ The exclusive lock is recursive, the shared lock isn't. A thread holding the shared lock must
+ not take the exclusive one, and a thread holding the exclusive lock must not take the shared one.
+
+ In bare-metal builds, the SharedMutex class is a dummy, so all operations are no-ops.
+
+ @note You cannot use member functions of this class in ISR context.
+
+ @note
+ Memory considerations: The lock control structures are created on the current thread's stack, both for the Mbed OS
+ and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
+*/
+class SharedMutex : private mbed::NonCopyable<SharedMutex> {
+public:
+    /** Create and Initialize a SharedMutex object
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    SharedMutex();
+
+    /** Create and Initialize a SharedMutex object
+
+     @param name name to be used for the exclusive lock. It has to stay allocated for the lifetime of the lock.
+     @note You cannot call this function from ISR context.
+    */
+    SharedMutex(const char *name);
+
+    /**
+      Wait until the lock is available for exclusive access.
+
+      Blocks new readers, then waits for the current ones to release it.
+
+      @note You cannot call this function from ISR context.
+     */
+    void lock();
+
+    /** Try to lock for exclusive access, and return immediately
+      @return true if the lock was acquired, false otherwise.
+      @note equivalent to trylock_for(0)
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock();
+
+    /** Try to lock for exclusive access for a specified time
+      @param   rel_time  timeout value.
+      @return true if the lock was acquired, false otherwise.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_for(Kernel::Clock::duration_u32 rel_time);
+
+    /**
+      Unlock the exclusive lock that has previously been locked by the same thread
+
+      @note You cannot call this function from ISR context.
+     */
+    void unlock();
+
+    /**
+      Wait until the lock is available for shared access.
+
+      @note You cannot call this function from ISR context.
+     */
+    void lock_shared();
+
+    /** Try to lock for shared access, and return immediately
+      @return true if the lock was acquired, false otherwise.
+      @note equivalent to trylock_shared_for(0)
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_shared();
+
+    /** Try to lock for shared access for a specified time
+      @param   rel_time  timeout value.
+      @return true if the lock was acquired, false otherwise.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool trylock_shared_for(Kernel::Clock::duration_u32 rel_time);
+
+    /**
+      Unlock a shared lock that has previously been locked by the same thread
+
+      @note You cannot call this function from ISR context.
+     */
+    void unlock_shared();
+
+    /** SharedMutex destructor
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~SharedMutex();
+
+private:
+#if MBED_CONF_RTOS_PRESENT
+    bool enter_shared();
+    void exit_shared();
+    bool wait_readers(Kernel::Clock::time_point abs_time);
+
+    Mutex             _write;
+    Semaphore         _drained;
+    volatile uint32_t _readers;
+    volatile bool     _writer;
+    uint32_t          _write_count;
+#endif
+};
+
+#if !MBED_CONF_RTOS_PRESENT
+inline SharedMutex::SharedMutex()
+{
+}
+
+inline SharedMutex::SharedMutex(const char *)
+{
+}
+
+inline SharedMutex::~SharedMutex()
+{
+}
+
+inline void SharedMutex::lock()
+{
+}
+
+inline bool SharedMutex::trylock()
+{
+    return true;
+}
+
+inline bool SharedMutex::trylock_for(Kernel::Clock::duration_u32)
+{
+    return true;
+}
+
+inline void SharedMutex::unlock()
+{
+}
+
+inline void SharedMutex::lock_shared()
+{
+}
+
+inline bool SharedMutex::trylock_shared()
+{
+    return true;
+}
+
+inline bool SharedMutex::trylock_shared_for(Kernel::Clock::duration_u32)
+{
+    return true;
+}
+
+inline void SharedMutex::unlock_shared()
+{
+}
+#endif
+
+/** @}*/
+/** @}*/
+}
+#endif
@@ -0,0 +1,171 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREAD_FACTORY_H
+#define THREAD_FACTORY_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/internal/mbed_rtos1_types.h"
+#include "rtos/internal/mbed_rtos_storage.h"
+#include "platform/Callback.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_ThreadFactory ThreadFactory class
+ * @{
+ */
+
+namespace impl {
+/* Slot management shared by all the ThreadFactory sizes */
+class ThreadFactoryBase : private mbed::NonCopyable<ThreadFactoryBase> {
+public:
+    /** Start a thread running a task, on a free stack and control block.
+     *
+     * The thread ends when the task returns, or when it is terminated. Its
+     * slot is reused once the kernel is done with it.
+     *
+     * @param  task  Function run by the thread.
+     * @param  id    Where to store the id of the thread, or nullptr.
+     * @return osOK on success, osErrorResource if all the slots are in use.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    osStatus spawn(mbed::Callback<void()> task, osThreadId_t *id = nullptr);
+
+    /** Get the number of threads that can be spawned right now.
+     *
+     * A thread that has just ended may still hold its slot for a while.
+     *
+     * @return Number of free slots.
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t available() const;
+
+protected:
+    ThreadFactoryBase(mbed_rtos_storage_thread_t *tcbs, mbed::Callback<void()> *tasks, uint64_t *stacks,
+                      uint32_t stack_size, uint32_t threads, osPriority priority, const char *name);
+    ~ThreadFactoryBase();
+
+private:
+    static void thunk(void *task);
+    static void thread_terminated(osThreadId_t id);
+    bool slot_idle(uint32_t index) const;
+
+    mbed_rtos_storage_thread_t *const _tcbs;
+    mbed::Callback<void()> *const _tasks;
+    uint64_t *const _stacks;
+    const uint32_t _stack_size;
+    const uint32_t _threads;
+    const osPriority _priority;
+    const char *const _name;
+    // Bit set for each slot spawned, cleared when its thread ends
+    volatile uint32_t _busy;
+    ThreadFactoryBase *_next;
+
+    // Every factory, searched by the terminate hook
+    static ThreadFactoryBase *_factories;
+};
+}
+
+/** Cheap thread creation from statically allocated stacks and control blocks.
+ *
+ * Creating a Thread allocates its stack on the heap and fills it for the
+ * stack statistics before calling osThreadNew. Code starting short lived
+ * threads, such as one per connection, pays that every time and fragments
+ * the heap. A ThreadFactory holds the stacks and control blocks of a fixed
+ * number of threads of one stack size: spawning a thread only picks a free
+ * slot and calls osThreadNew on it, and the slot is reused as soon as the
+ * thread ends. Use one factory per size class.
+ *
+ * The slots are reclaimed through Kernel::attach_thread_terminate_hook,
+ * which ThreadFactory takes over: attaching another hook stops the reuse.
+ *
+ * @code
+ * ThreadFactory<1024, 4> handlers(osPriorityNormal, "handler");
+ *
+ * void accept_loop()
+ * {
+ *     while (true) {
+ *         TCPSocket *client = server.accept();
+ *         if (handlers.spawn(callback(serve_client, client)) != osOK) {
+ *             client->close();
+ *         }
+ *     }
+ * }
+ * @endcode
+ *
+ * @tparam stack_size  Stack size of each thread in bytes, multiple of 8.
+ * @tparam threads     Number of threads running at once, at most 32.
+ *
+ * @note Memory considerations: The stacks and control blocks are part of
+ *       the factory object, which is best a static object.
+ * @note Bare metal profile: This class is not supported.
+ */
+template<uint32_t stack_size, uint32_t threads>
+class ThreadFactory : public impl::ThreadFactoryBase {
+    MBED_STATIC_ASSERT(threads > 0 && threads <= 32, "ThreadFactory holds 1 to 32 threads");
+    MBED_STATIC_ASSERT(stack_size > 0 && stack_size % 8 == 0, "ThreadFactory stack size must be a multiple of 8");
+
+public:
+    /** Create a factory, no thread is started.
+     *
+     * @param priority  Priority of the threads spawned.
+     * @param name      Name of the threads spawned, or nullptr.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ThreadFactory(osPriority priority = osPriorityNormal, const char *name = nullptr)
+        : ThreadFactoryBase(_tcb_mem, _task_mem, &_stack_mem[0][0], stack_size, threads, priority, name),
+          _tcb_mem()
+    {
+    }
+
+    /** Destroy the factory.
+     *
+     * @note The threads spawned must have ended.
+     * @note You cannot call this function from ISR context.
+     */
+    ~ThreadFactory() = default;
+
+private:
+    mbed_rtos_storage_thread_t _tcb_mem[threads];
+    mbed::Callback<void()> _task_mem[threads];
+    uint64_t _stack_mem[threads][stack_size / sizeof(uint64_t)];
+};
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif // THREAD_FACTORY_H
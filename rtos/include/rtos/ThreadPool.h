@@ -0,0 +1,463 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <new>
+#include "rtos/Mail.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Thread.h"
+#include "rtos/Kernel.h"
+#include "platform/Callback.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_stats.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_ThreadPool ThreadPool class
+ * @{
+ */
+
+template<uint32_t workers, uint32_t queue_sz>
+class ThreadPool;
+
+template<typename R>
+class Promise;
+
+namespace impl {
+/* Completion shared by Future<R> and Future<void> */
+class FutureBase : private mbed::NonCopyable<FutureBase> {
+public:
+    /** Check if the result is available.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool ready() const
+    {
+        return core_util_atomic_load_bool(&_ready);
+    }
+
+    /** Wait for the result.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void wait()
+    {
+        _done.acquire();
+        _done.release();
+    }
+
+    /** Wait for the result, up to a timeout.
+     *
+     * @param rel_time  Timeout, as for Semaphore::try_acquire_for.
+     * @return true if the result is available.
+     *
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    bool wait_for(Kernel::Clock::duration_u32 rel_time)
+    {
+        if (!_done.try_acquire_for(rel_time)) {
+            return false;
+        }
+        _done.release();
+        return true;
+    }
+
+protected:
+    FutureBase() : _done(0, 1), _ready(false) { }
+
+    void reset()
+    {
+        _done.try_acquire();
+        core_util_atomic_store_bool(&_ready, false);
+    }
+
+    void complete()
+    {
+        core_util_atomic_store_bool(&_ready, true);
+        _done.release();
+    }
+
+    Semaphore _done;
+    volatile bool _ready;
+};
+}
+
+/** Result of a job run by a ThreadPool, or set through a Promise.
+ *
+ * The Future is owned by the caller, which must keep it alive until the
+ * result is set: it allocates nothing. A Future can be reused once its
+ * result is available.
+ *
+ * @tparam R  Type of the result, default constructible and copy assignable.
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<typename R>
+class Future : public impl::FutureBase {
+public:
+    Future() : _value() { }
+
+    /** Wait for the result and return it.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    R get()
+    {
+        wait();
+        return _value;
+    }
+
+private:
+    template<uint32_t, uint32_t>
+    friend class ThreadPool;
+    friend class Promise<R>;
+
+    void set_value(const R &value)
+    {
+        _value = value;
+        complete();
+    }
+
+    void run()
+    {
+        set_value(_task());
+    }
+
+    mbed::Callback<R()> _task;
+    R _value;
+};
+
+/** Completion of a job run by a ThreadPool, or set through a Promise.
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<>
+class Future<void> : public impl::FutureBase {
+public:
+    /** Wait for the completion.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void get()
+    {
+        wait();
+    }
+
+private:
+    template<uint32_t, uint32_t>
+    friend class ThreadPool;
+    friend class Promise<void>;
+
+    void set_value()
+    {
+        complete();
+    }
+
+    void run()
+    {
+        _task();
+        set_value();
+    }
+
+    mbed::Callback<void()> _task;
+};
+
+/** Write end of a Future, for results produced outside of a ThreadPool.
+ *
+ * Creating the Promise resets the Future; the thread or interrupt handler
+ * producing the result then sets it once.
+ *
+ * @code
+ * Future<int> reading;
+ * Promise<int> promise(reading);   // given to the ADC interrupt handler
+ * ...
+ * promise.set_value(adc_value);    // in the interrupt handler
+ * ...
+ * int value = reading.get();       // in the waiting thread
+ * @endcode
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<typename R>
+class Promise {
+public:
+    /** Create a Promise for a Future, resetting it
+     *
+     * @note You may call this function from ISR context.
+     */
+    explicit Promise(Future<R> &future) : _future(&future)
+    {
+        _future->reset();
+    }
+
+    /** Set the result of the Future, waking up its waiters
+     *
+     * @note You may call this function from ISR context.
+     */
+    void set_value(const R &value)
+    {
+        _future->set_value(value);
+    }
+
+private:
+    Future<R> *_future;
+};
+
+/** Write end of a Future<void>, for completions signalled outside of a ThreadPool.
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<>
+class Promise<void> {
+public:
+    /** Create a Promise for a Future, resetting it
+     *
+     * @note You may call this function from ISR context.
+     */
+    explicit Promise(Future<void> &future) : _future(&future)
+    {
+        _future->reset();
+    }
+
+    /** Signal the completion of the Future, waking up its waiters
+     *
+     * @note You may call this function from ISR context.
+     */
+    void set_value()
+    {
+        _future->set_value();
+    }
+
+private:
+    Future<void> *_future;
+};
+
+/** The ThreadPool class runs jobs on a fixed number of worker threads.
+ *
+ * Jobs are callbacks queued in a bounded Mail queue and run in FIFO order by
+ * the first free worker. Many short activities can share the stacks of a
+ * few workers instead of each having its own Thread.
+ *
+ * @code
+ * ThreadPool<2, 8> pool(osPriorityNormal, 1024, "pool");
+ *
+ * pool.try_submit(callback(blink_led));
+ *
+ * Future<int> sum;
+ * if (pool.try_submit(sum, callback(compute_checksum, &buffer))) {
+ *     printf("checksum %d\n", sum.get());
+ * }
+ * @endcode
+ *
+ * @tparam workers   Number of worker threads.
+ * @tparam queue_sz  Maximum number of jobs waiting for a worker.
+ *
+ * @note Memory considerations: The job queue is part of this class. The
+ *       worker threads and their stacks are allocated on the heap, as for
+ *       Thread.
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<uint32_t workers, uint32_t queue_sz>
+class ThreadPool : private mbed::NonCopyable<ThreadPool<workers, queue_sz> > {
+    static_assert(workers > 0, "ThreadPool must have at least one worker");
+
+public:
+    /** Create the pool and start its workers.
+     *
+     * @param priority    Priority of the workers (default: osPriorityNormal).
+     * @param stack_size  Stack size in bytes of each worker (default: OS_STACK_SIZE).
+     * @param name        Name of the workers (default: nullptr).
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ThreadPool(osPriority priority = osPriorityNormal, uint32_t stack_size = OS_STACK_SIZE, const char *name = nullptr)
+    {
+        for (uint32_t i = 0; i < workers; i++) {
+            _threads[i] = new Thread(priority, stack_size, nullptr, name);
+            osStatus status = _threads[i]->start(mbed::callback(this, &ThreadPool::worker));
+            MBED_ASSERT(status == osOK);
+            (void) status;
+        }
+    }
+
+    /** Stop the workers once the queued jobs have run, and destroy the pool.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~ThreadPool()
+    {
+        // An empty job stops the worker taking it
+        for (uint32_t i = 0; i < workers; i++) {
+            post(Kernel::wait_for_u32_forever, nullptr);
+        }
+        for (uint32_t i = 0; i < workers; i++) {
+            _threads[i]->join();
+            delete _threads[i];
+        }
+    }
+
+    /** Queue a job.
+     *
+     * The function does not block, and returns immediately if the queue is full.
+     *
+     * @param  task  Job to run on a worker.
+     * @return true if the job was queued, false otherwise.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool try_submit(mbed::Callback<void()> task)
+    {
+        return try_submit_for(Kernel::Clock::duration_u32::zero(), task);
+    }
+
+    /** Queue a job, waiting for room in the queue.
+     *
+     * @param  rel_time  Timeout, as for Mail::try_alloc_for.
+     * @param  task      Job to run on a worker.
+     * @return true if the job was queued, false otherwise.
+     *
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    bool try_submit_for(Kernel::Clock::duration_u32 rel_time, mbed::Callback<void()> task)
+    {
+        MBED_ASSERT(task);
+        return post(rel_time, task);
+    }
+
+    /** Queue a job whose result is set in a Future.
+     *
+     * The Future must not have a job pending, and must outlive the job.
+     *
+     * @param  future  Future receiving the result, reset by the call.
+     * @param  task    Job to run on a worker.
+     * @return true if the job was queued, false otherwise.
+     *
+     * @note You may call this function from ISR context.
+     */
+    template<typename R>
+    bool try_submit(Future<R> &future, mbed::Callback<R()> task)
+    {
+        return try_submit_for(Kernel::Clock::duration_u32::zero(), future, task);
+    }
+
+    /** Queue a job whose result is set in a Future, waiting for room in the queue.
+     *
+     * The Future must not have a job pending, and must outlive the job.
+     *
+     * @param  rel_time  Timeout, as for Mail::try_alloc_for.
+     * @param  future    Future receiving the result, reset by the call.
+     * @param  task      Job to run on a worker.
+     * @return true if the job was queued, false otherwise.
+     *
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    template<typename R>
+    bool try_submit_for(Kernel::Clock::duration_u32 rel_time, Future<R> &future, mbed::Callback<R()> task)
+    {
+        MBED_ASSERT(task);
+        future.reset();
+        future._task = task;
+        return post(rel_time, mbed::callback(&future, &Future<R>::run));
+    }
+
+    /** Get the stack usage of the workers.
+     *
+     * The statistics are accumulated over the workers: thread_id is 0,
+     * max_size is the highest stack usage of a worker, reserved_size the
+     * total size of their stacks and stack_cnt the number of workers. The
+     * workers are also reported one by one by mbed_stats_stack_get_each.
+     *
+     * @param stats  Statistics to fill.
+     *
+     * @note max_size is only available with MBED_STACK_STATS_ENABLED.
+     * @note You cannot call this function from ISR context.
+     */
+    void get_stack_stats(mbed_stats_stack_t *stats) const
+    {
+        stats->thread_id = 0;
+        stats->max_size = 0;
+        stats->reserved_size = 0;
+        stats->stack_cnt = workers;
+        for (uint32_t i = 0; i < workers; i++) {
+            uint32_t used = _threads[i]->max_stack();
+            if (used > stats->max_size) {
+                stats->max_size = used;
+            }
+            stats->reserved_size += _threads[i]->stack_size();
+        }
+    }
+
+private:
+    struct job_t {
+        mbed::Callback<void()> task;
+    };
+
+    bool post(Kernel::Clock::duration_u32 rel_time, mbed::Callback<void()> task)
+    {
+        job_t *job = _jobs.try_alloc_for(rel_time);
+        if (!job) {
+            return false;
+        }
+        new (job) job_t{task};
+        _jobs.put(job);
+        return true;
+    }
+
+    void worker()
+    {
+        while (true) {
+            job_t *job = _jobs.try_get_for(Kernel::wait_for_u32_forever);
+            MBED_ASSERT(job);
+            mbed::Callback<void()> task = job->task;
+            job->~job_t();
+            _jobs.free(job);
+            if (!task) {
+                return;
+            }
+            task();
+        }
+    }
+
+    Mail<job_t, queue_sz> _jobs;
+    Thread *_threads[workers];
+};
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif // THREAD_POOL_H
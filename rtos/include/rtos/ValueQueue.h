@@ -0,0 +1,309 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef VALUE_QUEUE_H
+#define VALUE_QUEUE_H
+
+#include <type_traits>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/internal/mbed_rtos_storage.h"
+#include "rtos/Kernel.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_ValueQueue ValueQueue class
+ * @{
+ */
+
+/** The ValueQueue class is a message queue storing copies of the messages.
+ *
+ * Unlike Queue, which only passes pointers and needs a MemoryPool or a Mail
+ * to hold the messages, ValueQueue copies the messages into the RTOS
+ * message queue itself: a message takes a single kernel call each way and
+ * no pool allocation. Messages are retrieved in descending priority order,
+ * then in first-in, first-out (FIFO) order.
+ *
+ * It suits small messages, such as sensor samples or event codes, which
+ * are copied twice; large messages are better passed with Mail.
+ *
+ * @tparam T        Type of the messages, trivially copyable.
+ * @tparam queue_sz Maximum number of messages that you can store in the queue.
+ *
+ * @note Memory considerations: The queue control structures and messages are
+ *       stored in the object, both for the Mbed OS and underlying RTOS
+ *       objects (static or dynamic RTOS memory pools are not being used).
+ *
+ * @note Bare metal profile: This class is not supported.
+ */
+template<typename T, uint32_t queue_sz>
+class ValueQueue : private mbed::NonCopyable<ValueQueue<T, queue_sz> > {
+    static_assert(std::is_trivially_copyable<T>::value, "ValueQueue messages must be trivially copyable");
+    static_assert(queue_sz > 0, "ValueQueue must have at least one slot");
+
+public:
+    /** Create and initialize a ValueQueue of messages of type `T` and maximum
+     * capacity specified by `queue_sz`.
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    ValueQueue()
+    {
+        osMessageQueueAttr_t attr = { 0 };
+        attr.mq_mem = _queue_mem;
+        attr.mq_size = sizeof(_queue_mem);
+        attr.cb_mem = &_obj_mem;
+        attr.cb_size = sizeof(_obj_mem);
+        _id = osMessageQueueNew(queue_sz, sizeof(T), &attr);
+        MBED_ASSERT(_id);
+    }
+
+    /** ValueQueue destructor
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~ValueQueue()
+    {
+        osMessageQueueDelete(_id);
+    }
+
+    /** Check if the queue is empty.
+     *
+     * @return True if the queue is empty, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const
+    {
+        return osMessageQueueGetCount(_id) == 0;
+    }
+
+    /** Check if the queue is full.
+     *
+     * @return True if the queue is full, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const
+    {
+        return osMessageQueueGetSpace(_id) == 0;
+    }
+
+    /** Get number of queued messages in the queue.
+     *
+     * @return Number of items in the queue
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t count() const
+    {
+        return osMessageQueueGetCount(_id);
+    }
+
+    /** Copy a message to the end of the queue.
+     *
+     * The function does not block, and returns immediately if the queue is full.
+     *
+     * @param  data      Message to copy into the queue.
+     * @param  prio      Priority of the message, higher numbers indicate higher
+     *                   priority. (default: 0)
+     *
+     * @return true if the message was inserted, false otherwise.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool try_put(const T &data, uint8_t prio = 0)
+    {
+        return try_put_for(Kernel::Clock::duration_u32::zero(), data, prio);
+    }
+
+    /** Copy a message to the end of the queue, waiting for a free slot.
+     *
+     * The parameter `rel_time` can have the following values:
+     *  - When the duration is 0, the function returns instantly. You could use
+     *    `try_put` instead.
+     *  - When the duration is Kernel::wait_for_u32_forever, the function waits for an
+     *    infinite time.
+     *  - For all other values, the function waits for the given duration.
+     *
+     * @param  rel_time  Timeout for the operation to be executed.
+     * @param  data      Message to copy into the queue.
+     * @param  prio      Priority of the message, higher numbers indicate higher
+     *                   priority. (default: 0)
+     *
+     * @return true if the message was inserted, false otherwise.
+     *
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    bool try_put_for(Kernel::Clock::duration_u32 rel_time, const T &data, uint8_t prio = 0)
+    {
+        return osMessageQueuePut(_id, &data, prio, rel_time.count()) == osOK;
+    }
+
+    /** Copy messages to the end of the queue, as many as fit.
+     *
+     * The function does not block; it stops at the first message that doesn't fit.
+     *
+     * @param  data      Messages to copy into the queue.
+     * @param  count     Number of messages.
+     * @param  prio      Priority of the messages, higher numbers indicate higher
+     *                   priority. (default: 0)
+     *
+     * @return Number of messages inserted, from the start of `data`.
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t try_put_many(const T *data, uint32_t count, uint8_t prio = 0)
+    {
+        return try_put_many_for(Kernel::Clock::duration_u32::zero(), data, count, prio);
+    }
+
+    /** Copy messages to the end of the queue, waiting for the first free slot.
+     *
+     * The function waits up to `rel_time` for the first message to fit, then
+     * copies the following ones without waiting, as many as fit.
+     *
+     * @param  rel_time  Timeout for the first message, as for try_put_for.
+     * @param  data      Messages to copy into the queue.
+     * @param  count     Number of messages.
+     * @param  prio      Priority of the messages, higher numbers indicate higher
+     *                   priority. (default: 0)
+     *
+     * @return Number of messages inserted, from the start of `data`.
+     *
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    uint32_t try_put_many_for(Kernel::Clock::duration_u32 rel_time, const T *data, uint32_t count, uint8_t prio = 0)
+    {
+        uint32_t n = 0;
+        if (count > 0 && osMessageQueuePut(_id, &data[0], prio, rel_time.count()) == osOK) {
+            n = 1;
+            while (n < count && osMessageQueuePut(_id, &data[n], prio, 0) == osOK) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    /** Get a message from the queue.
+     *
+     * The function does not block, and returns immediately if the queue is empty.
+     *
+     * @param[out] data_out Location the message is copied to.
+     *
+     * @return true if a message was received and written to data_out.
+     *
+     * @note  You may call this function from ISR context.
+     */
+    bool try_get(T *data_out)
+    {
+        return try_get_for(Kernel::Clock::duration_u32::zero(), data_out);
+    }
+
+    /** Get a message or wait for a message from the queue.
+     *
+     * The timeout parameter can have the following values:
+     *  - When the timeout is 0, the function returns instantly.
+     *  - When the timeout is Kernel::wait_for_u32_forever, the function waits
+     *    infinite time until the message is retrieved.
+     *  - When the timeout is any other value, the function waits for the
+     *    specified time before returning a timeout error.
+     *
+     * @param   rel_time  Timeout value.
+     * @param[out] data_out Location the message is copied to.
+     *
+     * @return true if a message was received and written to data_out.
+     *
+     * @note  You may call this function from ISR context if the rel_time
+     *        parameter is set to 0.
+     */
+    bool try_get_for(Kernel::Clock::duration_u32 rel_time, T *data_out)
+    {
+        return osMessageQueueGet(_id, data_out, nullptr, rel_time.count()) == osOK;
+    }
+
+    /** Get the queued messages, up to `count`.
+     *
+     * The function does not block, and returns 0 if the queue is empty.
+     *
+     * @param[out] data_out Location the messages are copied to.
+     * @param      count    Maximum number of messages.
+     *
+     * @return Number of messages received and written to data_out.
+     *
+     * @note  You may call this function from ISR context.
+     */
+    uint32_t try_get_many(T *data_out, uint32_t count)
+    {
+        return try_get_many_for(Kernel::Clock::duration_u32::zero(), data_out, count);
+    }
+
+    /** Wait for a message, then get the queued messages, up to `count`.
+     *
+     * The function waits up to `rel_time` for the first message, then gets
+     * the following ones without waiting.
+     *
+     * @param      rel_time Timeout for the first message, as for try_get_for.
+     * @param[out] data_out Location the messages are copied to.
+     * @param      count    Maximum number of messages.
+     *
+     * @return Number of messages received and written to data_out.
+     *
+     * @note  You may call this function from ISR context if the rel_time
+     *        parameter is set to 0.
+     */
+    uint32_t try_get_many_for(Kernel::Clock::duration_u32 rel_time, T *data_out, uint32_t count)
+    {
+        uint32_t n = 0;
+        if (count > 0 && osMessageQueueGet(_id, &data_out[0], nullptr, rel_time.count()) == osOK) {
+            n = 1;
+            while (n < count && osMessageQueueGet(_id, &data_out[n], nullptr, 0) == osOK) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+private:
+    // RTX rounds the message size up to a word and aligns the memory on a word
+    static constexpr uint32_t msg_words = (sizeof(T) + 3) / 4 + (sizeof(mbed_rtos_storage_message_t) + 3) / 4;
+
+    osMessageQueueId_t            _id;
+    uint32_t                      _queue_mem[queue_sz * msg_words];
+    mbed_rtos_storage_msg_queue_t _obj_mem;
+};
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif // VALUE_QUEUE_H
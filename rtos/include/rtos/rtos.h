@@ -29,10 +29,15 @@
 #include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
 #include "rtos/Mutex.h"
+#include "rtos/SharedMutex.h"
 #include "rtos/Semaphore.h"
 #include "rtos/Mail.h"
+#include "rtos/LockFreeMail.h"
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
+#include "rtos/ValueQueue.h"
+#include "rtos/ThreadPool.h"
+#include "rtos/ThreadFactory.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
 
@@ -37,10 +37,15 @@ namespace rtos {
 
 constexpr bool Kernel::Clock::is_steady;
 
+#if MBED_CONF_RTOS_PRESENT
+static_assert(std::is_same<Kernel::Clock::period, mbed::internal::OsClock::period>::value,
+              "Kernel::Clock must tick at OS_TICK_FREQ");
+#endif
+
 uint64_t Kernel::get_ms_count()
 {
-    return impl::get_tick_count();
-
+    auto ticks = Clock::duration(impl::get_tick_count());
+    return std::chrono::duration_cast<std::chrono::duration<uint64_t, std::milli>>(ticks).count();
 }
 uint64_t Kernel::impl::get_tick_count()
 {
@@ -0,0 +1,159 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/SharedMutex.h"
+#include "rtos/Kernel.h"
+
+#include "platform/mbed_atomic.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+
+SharedMutex::SharedMutex()
+    : _drained(0, 1), _readers(0), _writer(false), _write_count(0)
+{
+}
+
+SharedMutex::SharedMutex(const char *name)
+    : _write(name), _drained(0, 1), _readers(0), _writer(false), _write_count(0)
+{
+}
+
+bool SharedMutex::enter_shared()
+{
+    // Pairs with the writer storing _writer then loading _readers: with
+    // sequentially consistent atomics, either the writer sees this reader,
+    // or this reader sees the writer and backs off.
+    core_util_atomic_incr_u32(&_readers, 1);
+    if (!core_util_atomic_load_bool(&_writer)) {
+        return true;
+    }
+    exit_shared();
+    return false;
+}
+
+void SharedMutex::exit_shared()
+{
+    if (core_util_atomic_decr_u32(&_readers, 1) == 0 && core_util_atomic_load_bool(&_writer)) {
+        _drained.release();
+    }
+}
+
+bool SharedMutex::wait_readers(Kernel::Clock::time_point abs_time)
+{
+    // A release may be left over from a writer that gave up, so the
+    // count is what tells if readers remain
+    while (core_util_atomic_load_u32(&_readers) != 0) {
+        if (abs_time == Kernel::Clock::time_point::max()) {
+            _drained.acquire();
+        } else if (!_drained.try_acquire_until(abs_time)) {
+            return core_util_atomic_load_u32(&_readers) == 0;
+        }
+    }
+    return true;
+}
+
+void SharedMutex::lock()
+{
+    _write.lock();
+    if (_write_count++ == 0) {
+        core_util_atomic_store_bool(&_writer, true);
+        wait_readers(Kernel::Clock::time_point::max());
+    }
+}
+
+bool SharedMutex::trylock()
+{
+    return trylock_for(Kernel::Clock::duration_u32::zero());
+}
+
+bool SharedMutex::trylock_for(Kernel::Clock::duration_u32 rel_time)
+{
+    Kernel::Clock::time_point abs_time = Kernel::Clock::now() + rel_time;
+
+    if (!_write.trylock_for(rel_time)) {
+        return false;
+    }
+    if (_write_count == 0) {
+        core_util_atomic_store_bool(&_writer, true);
+        if (!wait_readers(abs_time)) {
+            // Readers that backed off are waiting for _write
+            core_util_atomic_store_bool(&_writer, false);
+            _write.unlock();
+            return false;
+        }
+    }
+    _write_count++;
+    return true;
+}
+
+void SharedMutex::unlock()
+{
+    if (--_write_count == 0) {
+        core_util_atomic_store_bool(&_writer, false);
+    }
+    _write.unlock();
+}
+
+void SharedMutex::lock_shared()
+{
+    if (enter_shared()) {
+        return;
+    }
+    // A writer is active or waiting: wait for it on the mutex, so that its
+    // priority is raised to ours while it holds the lock
+    _write.lock();
+    core_util_atomic_incr_u32(&_readers, 1);
+    _write.unlock();
+}
+
+bool SharedMutex::trylock_shared()
+{
+    return trylock_shared_for(Kernel::Clock::duration_u32::zero());
+}
+
+bool SharedMutex::trylock_shared_for(Kernel::Clock::duration_u32 rel_time)
+{
+    if (enter_shared()) {
+        return true;
+    }
+    if (!_write.trylock_for(rel_time)) {
+        return false;
+    }
+    core_util_atomic_incr_u32(&_readers, 1);
+    _write.unlock();
+    return true;
+}
+
+void SharedMutex::unlock_shared()
+{
+    exit_shared();
+}
+
+SharedMutex::~SharedMutex()
+{
+}
+
+}
+
+#endif
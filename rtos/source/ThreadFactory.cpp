@@ -0,0 +1,157 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+#include "rtos/ThreadFactory.h"
+#include "rtos/Kernel.h"
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+namespace impl {
+
+ThreadFactoryBase *ThreadFactoryBase::_factories = nullptr;
+
+ThreadFactoryBase::ThreadFactoryBase(mbed_rtos_storage_thread_t *tcbs, mbed::Callback<void()> *tasks,
+                                     uint64_t *stacks, uint32_t stack_size, uint32_t threads,
+                                     osPriority priority, const char *name)
+    : _tcbs(tcbs), _tasks(tasks), _stacks(stacks), _stack_size(stack_size), _threads(threads),
+      _priority(priority), _name(name ? name : "application_unnamed_thread"), _busy(0)
+{
+    core_util_critical_section_enter();
+    _next = _factories;
+    _factories = this;
+    core_util_critical_section_exit();
+
+    Kernel::attach_thread_terminate_hook(&ThreadFactoryBase::thread_terminated);
+}
+
+ThreadFactoryBase::~ThreadFactoryBase()
+{
+    MBED_ASSERT(_busy == 0);
+
+    core_util_critical_section_enter();
+    ThreadFactoryBase **link = &_factories;
+    while (*link != this) {
+        link = &(*link)->_next;
+    }
+    *link = _next;
+    core_util_critical_section_exit();
+}
+
+osStatus ThreadFactoryBase::spawn(mbed::Callback<void()> task, osThreadId_t *id)
+{
+    uint32_t index;
+    uint32_t busy = core_util_atomic_load_u32(&_busy);
+
+    // Claim the first slot both free and released by the kernel
+    for (index = 0; index < _threads; index++) {
+        uint32_t bit = 1u << index;
+        if (!(busy & bit) && slot_idle(index)) {
+            if (core_util_atomic_cas_u32(&_busy, &busy, busy | bit)) {
+                break;
+            }
+            // Another spawn or a thread end changed the mask, start over
+            index = UINT32_MAX;
+        }
+    }
+    if (index >= _threads) {
+        return osErrorResource;
+    }
+
+    uint64_t *stack = _stacks + index * (_stack_size / sizeof(uint64_t));
+#if MBED_STACK_STATS_ENABLED
+    // Fill the stack with a magic word for maximum usage checking, as Thread does
+    for (uint32_t i = 0; i < _stack_size / sizeof(uint32_t); i++) {
+        reinterpret_cast<uint32_t *>(stack)[i] = osRtxStackMagicWord;
+    }
+#endif
+
+    osThreadAttr_t attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.name = _name;
+    attr.priority = _priority;
+    attr.cb_mem = &_tcbs[index];
+    attr.cb_size = sizeof(mbed_rtos_storage_thread_t);
+    attr.stack_mem = stack;
+    attr.stack_size = _stack_size;
+
+    _tasks[index] = task;
+    osThreadId_t tid = osThreadNew(&ThreadFactoryBase::thunk, &_tasks[index], &attr);
+    if (tid == nullptr) {
+        _tasks[index] = nullptr;
+        core_util_atomic_fetch_and_u32(&_busy, ~(1u << index));
+        return osErrorResource;
+    }
+
+    if (id) {
+        *id = tid;
+    }
+    return osOK;
+}
+
+uint32_t ThreadFactoryBase::available() const
+{
+    uint32_t busy = core_util_atomic_load_u32(&_busy);
+    uint32_t count = 0;
+    for (uint32_t index = 0; index < _threads; index++) {
+        if (!(busy & (1u << index)) && slot_idle(index)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void ThreadFactoryBase::thunk(void *task)
+{
+    // Returning ends the thread through osThreadExit
+    (*static_cast<mbed::Callback<void()> *>(task))();
+}
+
+void ThreadFactoryBase::thread_terminated(osThreadId_t id)
+{
+    // Called as a thread exits or is terminated, either from the ending
+    // thread itself, still running on its stack, or from the kernel
+    for (ThreadFactoryBase *factory = _factories; factory; factory = factory->_next) {
+        mbed_rtos_storage_thread_t *tcb = static_cast<mbed_rtos_storage_thread_t *>(id);
+        if (tcb >= factory->_tcbs && tcb < factory->_tcbs + factory->_threads) {
+            core_util_atomic_fetch_and_u32(&factory->_busy, ~(1u << (tcb - factory->_tcbs)));
+            return;
+        }
+    }
+}
+
+bool ThreadFactoryBase::slot_idle(uint32_t index) const
+{
+    // A thread exiting by itself clears its bit before the kernel is done
+    // with its stack and control block: they are released once the kernel
+    // has invalidated the control block
+    return _tcbs[index].id == osRtxIdInvalid;
+}
+
+} // namespace impl
+} // namespace rtos
+
+#endif
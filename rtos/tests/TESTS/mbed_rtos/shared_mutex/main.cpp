@@ -0,0 +1,219 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] SharedMutex test cases require RTOS with multithread to run
+#else
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] UsTicker need to be enabled for this test.
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define TEST_ASSERT_DURATION_WITHIN(delta, expected, actual) \
+    do { \
+        using ct = std::common_type_t<decltype(delta), decltype(expected), decltype(actual)>; \
+        TEST_ASSERT_INT_WITHIN(ct(delta).count(), ct(expected).count(), ct(actual).count()); \
+    } while (0)
+
+#define THREAD_STACK_SIZE 512
+#define TEST_DELAY 20ms
+
+SharedMutex shared_mutex;
+volatile int readers_inside;
+volatile int max_readers_inside;
+
+void reader_thread()
+{
+    ScopedSharedMutexLock lock(shared_mutex);
+    int inside = core_util_atomic_incr_s32((volatile int32_t *)&readers_inside, 1);
+    if (inside > max_readers_inside) {
+        max_readers_inside = inside;
+    }
+    ThisThread::sleep_for(TEST_DELAY);
+    core_util_atomic_decr_s32((volatile int32_t *)&readers_inside, 1);
+}
+
+void writer_thread()
+{
+    ScopedLock<SharedMutex> lock(shared_mutex);
+    TEST_ASSERT_EQUAL(0, readers_inside);
+    ThisThread::sleep_for(TEST_DELAY);
+}
+
+/** Test concurrent readers
+
+    Given a SharedMutex
+    When three threads lock it shared and hold it for a while
+    Then they hold it at the same time
+ */
+void test_concurrent_readers()
+{
+    Thread t1(osPriorityNormal, THREAD_STACK_SIZE);
+    Thread t2(osPriorityNormal, THREAD_STACK_SIZE);
+    Thread t3(osPriorityNormal, THREAD_STACK_SIZE);
+    Timer timer;
+
+    readers_inside = 0;
+    max_readers_inside = 0;
+    timer.start();
+    t1.start(reader_thread);
+    t2.start(reader_thread);
+    t3.start(reader_thread);
+    t1.join();
+    t2.join();
+    t3.join();
+
+    TEST_ASSERT_EQUAL(3, max_readers_inside);
+    TEST_ASSERT_DURATION_WITHIN(TEST_DELAY / 2, TEST_DELAY, timer.elapsed_time());
+}
+
+/** Test writer exclusion
+
+    Given a SharedMutex locked shared by a reader thread
+    When a writer and then another reader lock it
+    Then the writer waits for the first reader, and the second reader waits for the writer
+ */
+void test_writer_exclusion()
+{
+    Thread r1(osPriorityNormal, THREAD_STACK_SIZE);
+    Thread w(osPriorityNormal, THREAD_STACK_SIZE);
+    Timer timer;
+
+    readers_inside = 0;
+    timer.start();
+    r1.start(reader_thread);
+    ThisThread::sleep_for(TEST_DELAY / 4);
+    w.start(writer_thread);
+    ThisThread::sleep_for(TEST_DELAY / 4);
+
+    // Writer waiting: new readers wait, writer preference
+    TEST_ASSERT_FALSE(shared_mutex.trylock_shared());
+    shared_mutex.lock_shared();
+    TEST_ASSERT_DURATION_WITHIN(TEST_DELAY / 2, 2 * TEST_DELAY, timer.elapsed_time());
+    TEST_ASSERT_EQUAL(0, readers_inside);
+    shared_mutex.unlock_shared();
+
+    r1.join();
+    w.join();
+}
+
+/** Test lock timeouts
+
+    Given a SharedMutex locked shared by a reader thread
+    When the lock is tried exclusive with and without timeout
+    Then it fails, and shared locks still succeed afterwards
+ */
+void test_timeouts()
+{
+    Thread r1(osPriorityNormal, THREAD_STACK_SIZE);
+    Timer timer;
+
+    readers_inside = 0;
+    r1.start(reader_thread);
+    ThisThread::sleep_for(TEST_DELAY / 4);
+
+    TEST_ASSERT_FALSE(shared_mutex.trylock());
+    timer.start();
+    TEST_ASSERT_FALSE(shared_mutex.trylock_for(TEST_DELAY / 4));
+    TEST_ASSERT_DURATION_WITHIN(TEST_DELAY / 8, TEST_DELAY / 4, timer.elapsed_time());
+
+    // The failed writer doesn't block readers
+    TEST_ASSERT_TRUE(shared_mutex.trylock_shared());
+    shared_mutex.unlock_shared();
+
+    r1.join();
+    TEST_ASSERT_TRUE(shared_mutex.trylock_for(TEST_DELAY));
+    shared_mutex.unlock();
+}
+
+/** Test recursive exclusive lock
+
+    Given a SharedMutex
+    When it is locked exclusive twice by the same thread
+    Then readers wait until it has been unlocked twice
+ */
+void test_recursive()
+{
+    shared_mutex.lock();
+    TEST_ASSERT_TRUE(shared_mutex.trylock());
+    shared_mutex.unlock();
+
+    Thread r(osPriorityNormal, THREAD_STACK_SIZE);
+    r.start([] {
+        TEST_ASSERT_FALSE(shared_mutex.trylock_shared());
+    });
+    r.join();
+
+    shared_mutex.unlock();
+    TEST_ASSERT_TRUE(shared_mutex.trylock_shared());
+    shared_mutex.unlock_shared();
+}
+
+/** Test priority inheritance
+
+    Given a SharedMutex locked exclusive by a low priority thread
+    When a higher priority thread waits for a shared lock
+    Then the writer runs at the priority of the reader until it unlocks
+ */
+void test_priority_inheritance()
+{
+    Thread w(osPriorityLow, THREAD_STACK_SIZE);
+    Thread r(osPriorityHigh, THREAD_STACK_SIZE);
+
+    w.start(writer_thread);
+    ThisThread::sleep_for(TEST_DELAY / 4);
+    r.start([] {
+        ScopedSharedMutexLock lock(shared_mutex);
+    });
+    ThisThread::sleep_for(TEST_DELAY / 4);
+
+    TEST_ASSERT_EQUAL(osPriorityHigh, w.get_priority());
+    w.join();
+    r.join();
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test concurrent readers", test_concurrent_readers),
+    Case("Test writer exclusion", test_writer_exclusion),
+    Case("Test lock timeouts", test_timeouts),
+    Case("Test recursive exclusive lock", test_recursive),
+    Case("Test priority inheritance", test_priority_inheritance)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
+#endif // defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
@@ -0,0 +1,140 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] ThreadFactory test cases require RTOS with multithread to run
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define THREAD_STACK_SIZE 512
+#define THREADS 2
+#define TEST_TIMEOUT 50ms
+
+// Created by each test: the factories take over the thread terminate hook,
+// which the test setup may attach for its own metrics
+typedef ThreadFactory<THREAD_STACK_SIZE, THREADS> TestFactory;
+
+static volatile uint32_t counter;
+
+static void increment()
+{
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+static void wait_semaphore(Semaphore *sem)
+{
+    sem->acquire();
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+/* Wait until the slots of the threads spawned are released */
+static void wait_available(TestFactory &factory)
+{
+    for (int i = 0; i < 100 && factory.available() != THREADS; i++) {
+        ThisThread::sleep_for(1ms);
+    }
+    TEST_ASSERT_EQUAL(THREADS, factory.available());
+}
+
+/** Test threads run
+
+    Given a factory of two threads
+    When many threads are spawned one after the other
+    Then each runs its task and its slot is reused
+ */
+void test_spawn()
+{
+    TestFactory factory;
+    counter = 0;
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(osOK, factory.spawn(callback(increment)));
+        wait_available(factory);
+    }
+    TEST_ASSERT_EQUAL(10, counter);
+}
+
+/** Test the pool is bounded
+
+    Given a factory of two threads
+    When both are running and a third is spawned
+    Then the spawn fails until one of them ends
+ */
+void test_exhausted()
+{
+    TestFactory factory;
+    Semaphore sem(0, THREADS);
+    counter = 0;
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQUAL(osOK, factory.spawn(callback(wait_semaphore, &sem)));
+    }
+    TEST_ASSERT_EQUAL(0, factory.available());
+    TEST_ASSERT_EQUAL(osErrorResource, factory.spawn(callback(increment)));
+
+    sem.release();
+    ThisThread::sleep_for(TEST_TIMEOUT);
+    TEST_ASSERT_EQUAL(1, factory.available());
+    TEST_ASSERT_EQUAL(osOK, factory.spawn(callback(wait_semaphore, &sem)));
+
+    sem.release();
+    sem.release();
+    wait_available(factory);
+    TEST_ASSERT_EQUAL(THREADS + 1, counter);
+}
+
+/** Test terminated threads
+
+    Given a thread spawned by the factory
+    When it is terminated before its task returns
+    Then its slot is reused
+ */
+void test_terminate()
+{
+    TestFactory factory;
+    Semaphore sem(0, 1);
+    osThreadId_t id;
+    TEST_ASSERT_EQUAL(osOK, factory.spawn(callback(wait_semaphore, &sem), &id));
+    TEST_ASSERT_EQUAL(osOK, osThreadTerminate(id));
+    wait_available(factory);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test threads run", test_spawn),
+    Case("Test bounded pool", test_exhausted),
+    Case("Test terminated threads", test_terminate)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
@@ -0,0 +1,184 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] ThreadPool test cases require RTOS with multithread to run
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define THREAD_STACK_SIZE 512
+#define TEST_TIMEOUT 50ms
+
+static volatile uint32_t counter;
+
+static void increment()
+{
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+static int square(int *value)
+{
+    return *value * *value;
+}
+
+static void sleep_job()
+{
+    ThisThread::sleep_for(TEST_TIMEOUT);
+}
+
+/** Test jobs run
+
+    Given a pool of two workers
+    When ten jobs are submitted
+    Then all of them have run once the pool is destroyed
+ */
+void test_run_jobs()
+{
+    counter = 0;
+    {
+        ThreadPool<2, 4> pool(osPriorityNormal, THREAD_STACK_SIZE);
+        for (int i = 0; i < 10; i++) {
+            TEST_ASSERT_TRUE(pool.try_submit_for(Kernel::wait_for_u32_forever, callback(increment)));
+        }
+    }
+    TEST_ASSERT_EQUAL(10, counter);
+}
+
+/** Test futures
+
+    Given a pool of two workers
+    When jobs returning a value are submitted with futures
+    Then each future gets the value of its job
+ */
+void test_future()
+{
+    ThreadPool<2, 4> pool(osPriorityNormal, THREAD_STACK_SIZE);
+    int a = 3, b = 7;
+    Future<int> fa, fb;
+    TEST_ASSERT_TRUE(pool.try_submit(fa, callback(square, &a)));
+    TEST_ASSERT_TRUE(pool.try_submit(fb, callback(square, &b)));
+    TEST_ASSERT_EQUAL(49, fb.get());
+    TEST_ASSERT_EQUAL(9, fa.get());
+    TEST_ASSERT_TRUE(fa.ready());
+
+    // Reused once ready
+    TEST_ASSERT_TRUE(pool.try_submit(fa, callback(square, &b)));
+    TEST_ASSERT_EQUAL(49, fa.get());
+}
+
+/** Test future timeout
+
+    Given a pool of one worker running a 50ms job
+    When waiting for the job with a shorter timeout
+    Then the wait times out, and a longer wait succeeds
+ */
+void test_future_timeout()
+{
+    ThreadPool<1, 1> pool(osPriorityNormal, THREAD_STACK_SIZE);
+    Future<void> done;
+    TEST_ASSERT_TRUE(pool.try_submit(done, callback(sleep_job)));
+    TEST_ASSERT_FALSE(done.wait_for(TEST_TIMEOUT / 5));
+    TEST_ASSERT_FALSE(done.ready());
+    TEST_ASSERT_TRUE(done.wait_for(TEST_TIMEOUT * 2));
+    TEST_ASSERT_TRUE(done.ready());
+}
+
+/** Test bounded queue
+
+    Given a pool of one worker with one queue slot
+    When the worker is busy and the slot is taken
+    Then another job can't be submitted without waiting
+ */
+void test_queue_full()
+{
+    ThreadPool<1, 1> pool(osPriorityNormal, THREAD_STACK_SIZE);
+    TEST_ASSERT_TRUE(pool.try_submit(callback(sleep_job)));
+    ThisThread::sleep_for(TEST_TIMEOUT / 5);
+    TEST_ASSERT_TRUE(pool.try_submit(callback(sleep_job)));
+    TEST_ASSERT_FALSE(pool.try_submit(callback(sleep_job)));
+    TEST_ASSERT_TRUE(pool.try_submit_for(TEST_TIMEOUT * 2, callback(sleep_job)));
+}
+
+/** Test promise
+
+    Given a future and a promise set from a Ticker interrupt
+    When waiting for the future
+    Then it gets the value set by the interrupt
+ */
+static Promise<int> *test_promise;
+
+static void set_promise()
+{
+    test_promise->set_value(42);
+}
+
+void test_promise_from_isr()
+{
+    Future<int> future;
+    Promise<int> promise(future);
+    test_promise = &promise;
+    Timeout timeout;
+    timeout.attach(set_promise, 10ms);
+    TEST_ASSERT_EQUAL(42, future.get());
+}
+
+/** Test stack statistics
+
+    Given a pool of two workers
+    Then the stack statistics account for both stacks
+ */
+void test_stack_stats()
+{
+    ThreadPool<2, 1> pool(osPriorityNormal, THREAD_STACK_SIZE);
+    mbed_stats_stack_t stats;
+    pool.get_stack_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.thread_id);
+    TEST_ASSERT_EQUAL(2, stats.stack_cnt);
+    TEST_ASSERT_EQUAL(2 * THREAD_STACK_SIZE, stats.reserved_size);
+    TEST_ASSERT_TRUE(stats.max_size <= THREAD_STACK_SIZE);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test jobs run", test_run_jobs),
+    Case("Test futures", test_future),
+    Case("Test future timeout", test_future_timeout),
+    Case("Test bounded queue", test_queue_full),
+    Case("Test promise from interrupt", test_promise_from_isr),
+    Case("Test stack statistics", test_stack_stats)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
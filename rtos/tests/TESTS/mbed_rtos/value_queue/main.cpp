@@ -0,0 +1,180 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] ValueQueue test cases require RTOS with multithread to run
+#else
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] UsTicker need to be enabled for this test.
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define TEST_ASSERT_DURATION_WITHIN(delta, expected, actual) \
+    do { \
+        using ct = std::common_type_t<decltype(delta), decltype(expected), decltype(actual)>; \
+        TEST_ASSERT_INT_WITHIN(ct(delta).count(), ct(expected).count(), ct(actual).count()); \
+    } while (0)
+
+#define THREAD_STACK_SIZE 512
+#define TEST_TIMEOUT 50ms
+
+struct sample_t {
+    uint16_t channel;
+    int32_t value;
+};
+
+void thread_put_samples(ValueQueue<sample_t, 4> *q)
+{
+    ThisThread::sleep_for(TEST_TIMEOUT);
+    sample_t samples[2] = { { 1, 10 }, { 2, 20 } };
+    TEST_ASSERT_EQUAL(2, q->try_put_many(samples, 2));
+}
+
+/** Test pass msg by value
+
+    Given a queue of samples with one slot
+    When a sample is inserted into the queue and modified afterwards
+        and a message is extracted from the queue
+    Then the extracted message is a copy of the inserted sample
+ */
+void test_pass()
+{
+    ValueQueue<sample_t, 1> q;
+    sample_t sample = { 3, -7 };
+    TEST_ASSERT_TRUE(q.try_put(sample));
+    sample.value = 0;
+
+    sample_t v;
+    TEST_ASSERT_TRUE(q.try_get_for(Kernel::wait_for_u32_forever, &v));
+    TEST_ASSERT_EQUAL(3, v.channel);
+    TEST_ASSERT_EQUAL(-7, v.value);
+}
+
+/** Test get from empty queue with timeout
+
+    Given an empty queue
+    When @a try_get_for is called with a timeout of 50ms
+    Then it returns false after about 50ms wait
+ */
+void test_get_empty_timeout()
+{
+    ValueQueue<uint8_t, 1> q;
+    Timer timer;
+    timer.start();
+
+    uint8_t v;
+    TEST_ASSERT_FALSE(q.try_get_for(TEST_TIMEOUT, &v));
+    TEST_ASSERT_DURATION_WITHIN(5ms, TEST_TIMEOUT, timer.elapsed_time());
+}
+
+/** Test message priority
+
+    Given a queue of bytes
+    When two messages are inserted with ascending priority
+    Then messages should be returned in descending priority order
+ */
+void test_msg_prio()
+{
+    ValueQueue<uint8_t, 2> q;
+    TEST_ASSERT_TRUE(q.try_put(1, 0));
+    TEST_ASSERT_TRUE(q.try_put(2, 1));
+
+    uint8_t v;
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(2, v);
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(1, v);
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+/** Test bulk put and get
+
+    Given a queue with four slots
+    When six messages are put at once
+    Then the first four are inserted and the queue is full
+    When eight messages are got at once
+    Then the four messages are returned in order
+ */
+void test_many()
+{
+    ValueQueue<uint32_t, 4> q;
+    uint32_t in[6] = { 1, 2, 3, 4, 5, 6 };
+    TEST_ASSERT_EQUAL(4, q.try_put_many(in, 6));
+    TEST_ASSERT_TRUE(q.full());
+    TEST_ASSERT_EQUAL(4, q.count());
+
+    uint32_t out[8];
+    TEST_ASSERT_EQUAL(4, q.try_get_many(out, 8));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(in, out, 4);
+    TEST_ASSERT_EQUAL(0, q.try_get_many(out, 8));
+}
+
+/** Test bulk get wait
+
+    Given two threads A & B and an empty queue
+    When thread A waits for messages with @a try_get_many_for
+    Then thread A wakes up when thread B puts two messages and gets both
+ */
+void test_get_many_wait()
+{
+    Thread t(osPriorityNormal, THREAD_STACK_SIZE);
+    ValueQueue<sample_t, 4> q;
+
+    t.start(callback(thread_put_samples, &q));
+
+    Timer timer;
+    timer.start();
+    sample_t out[4];
+    TEST_ASSERT_EQUAL(2, q.try_get_many_for(Kernel::wait_for_u32_forever, out, 4));
+    TEST_ASSERT_DURATION_WITHIN(TEST_TIMEOUT / 10, TEST_TIMEOUT, timer.elapsed_time());
+    TEST_ASSERT_EQUAL(1, out[0].channel);
+    TEST_ASSERT_EQUAL(20, out[1].value);
+
+    t.join();
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(5, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test pass msg by value", test_pass),
+    Case("Test get from empty queue timeout", test_get_empty_timeout),
+    Case("Test message priority", test_msg_prio),
+    Case("Test bulk put and get", test_many),
+    Case("Test bulk get wait", test_get_many_wait)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
+#endif // defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
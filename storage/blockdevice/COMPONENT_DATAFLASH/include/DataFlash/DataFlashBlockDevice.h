@@ -195,8 +195,10 @@ private:
     uint16_t _get_register(uint8_t opcode);
     void _write_command(uint32_t command, const uint8_t *buffer, uint32_t size);
     void _write_enable(bool enable);
-    int _sync(void);
+    int _sync(uint32_t interval);
     int _write_page(const uint8_t *buffer, uint32_t addr, uint32_t offset, uint32_t size);
+    int _write_buffered_page(const uint8_t *buffer, uint32_t page, int sram_buffer);
+    uint32_t _page_address(uint32_t page, uint32_t offset);
     uint32_t _translate_address(bd_addr_t addr);
 
     // Mutex for thread safety
@@ -61,6 +61,10 @@ enum opcode {
     DATAFLASH_OP_READ_LOW_FREQUENCY        = 0x03,
     DATAFLASH_OP_PROGRAM_DIRECT            = 0x02, // Program through Buffer 1 without Built-In Erase
     DATAFLASH_OP_PROGRAM_DIRECT_WITH_ERASE = 0x82,
+    DATAFLASH_OP_WRITE_BUFFER_1            = 0x84,
+    DATAFLASH_OP_WRITE_BUFFER_2            = 0x87,
+    DATAFLASH_OP_PROGRAM_BUFFER_1          = 0x88, // Buffer 1 to Main Memory Page Program without Built-In Erase
+    DATAFLASH_OP_PROGRAM_BUFFER_2          = 0x89, // Buffer 2 to Main Memory Page Program without Built-In Erase
     DATAFLASH_OP_ERASE_BLOCK               = 0x50,
     DATAFLASH_OP_ERASE_PAGE                = 0x81,
 };
@@ -208,7 +212,7 @@ int DataFlashBlockDevice::init()
             _write_command(DATAFLASH_COMMAND_DATAFLASH_PAGE_SIZE, NULL, 0);
 
             /* wait for device to be ready and update return code */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* set binary flag */
             binary_page_size = false;
@@ -224,7 +228,7 @@ int DataFlashBlockDevice::init()
             _write_command(DATAFLASH_COMMAND_BINARY_PAGE_SIZE, NULL, 0);
 
             /* wait for device to be ready and update return code */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* set binary flag */
             binary_page_size = true;
@@ -345,10 +349,9 @@ int DataFlashBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
         _spi.write((address >>  8) & 0xFF);
         _spi.write(address & 0xFF);
 
-        /* clock out one byte at a time and store in external buffer */
-        for (uint32_t index = 0; index < size; index++) {
-            external_buffer[index] = _spi.write(DATAFLASH_OP_NOP);
-        }
+        /* the continuous array read crosses the page boundaries,
+           clock out the whole range in a single transfer */
+        _spi.write(NULL, 0, reinterpret_cast<char *>(external_buffer), size);
 
         _spi.deselect();
 
@@ -385,6 +388,12 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
         /* disable write protection */
         _write_enable(true);
 
+        /* Full pages alternate between the two SRAM buffers: a page is loaded
+           while the previous one is programmed from the other buffer.
+         */
+        bool programming = false;
+        int sram_buffer = 0;
+
         /* continue until all bytes have been written */
         uint32_t bytes_written = 0;
         while (bytes_written < size) {
@@ -401,10 +410,27 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
                page_number is the page address, and page_offset is non-zero for
                unaligned writes.
              */
-            result = _write_page(&external_buffer[bytes_written],
-                                 page_number,
-                                 page_offset,
-                                 bytes_remaining);
+            if (page_offset == 0 && bytes_remaining == _page_size) {
+                result = _write_buffered_page(&external_buffer[bytes_written],
+                                              page_number,
+                                              sram_buffer);
+                sram_buffer = 1 - sram_buffer;
+                programming = true;
+            } else {
+                /* Partial pages are programmed directly, through buffer 1 */
+                if (programming) {
+                    programming = false;
+                    result = _sync(DATAFLASH_TIMING_PROGRAM_PAGE);
+                    if (result != BD_ERROR_OK) {
+                        break;
+                    }
+                }
+
+                result = _write_page(&external_buffer[bytes_written],
+                                     page_number,
+                                     page_offset,
+                                     bytes_remaining);
+            }
 
             /* update loop variables upon success otherwise break loop */
             if (result == BD_ERROR_OK) {
@@ -420,6 +446,14 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
             }
         }
 
+        /* wait for the last page programmed from a buffer */
+        if (programming) {
+            int err = _sync(DATAFLASH_TIMING_PROGRAM_PAGE);
+            if (result == BD_ERROR_OK) {
+                result = err;
+            }
+        }
+
         /* enable write protection */
         _write_enable(false);
     }
@@ -465,7 +499,7 @@ int DataFlashBlockDevice::erase(bd_addr_t addr, bd_size_t size)
             _write_command(command, NULL, 0);
 
             /* wait until device is ready and update return value */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* if erase failed, break loop */
             if (result != BD_ERROR_OK) {
@@ -584,9 +618,7 @@ void DataFlashBlockDevice::_write_command(uint32_t command, const uint8_t *buffe
 
     /* send optional data */
     if (buffer && size) {
-        for (uint32_t index = 0; index < size; index++) {
-            _spi.write(buffer[index]);
-        }
+        _spi.write(reinterpret_cast<const char *>(buffer), size, NULL, 0);
     }
 
     _spi.deselect();
@@ -625,21 +657,20 @@ void DataFlashBlockDevice::_write_enable(bool enable)
 /**
  * @brief Sleep and poll status register until device is ready for next command.
  *
+ * @param interval Polling interval in milliseconds, the typical duration of the operation.
  * @return BlockDevice compatible error code.
  */
-int DataFlashBlockDevice::_sync(void)
+int DataFlashBlockDevice::_sync(uint32_t interval)
 {
     DEBUG_PRINTF("_sync\r\n");
 
     /* default return value if operation times out */
     int result = BD_ERROR_DEVICE_ERROR;
 
-    /* Poll device until a hard coded timeout is reached.
-       The polling interval is based on the typical page program time.
-     */
+    /* Poll device until a hard coded timeout is reached. */
     for (uint32_t timeout = 0;
             timeout < DATAFLASH_TIMEOUT;
-            timeout += DATAFLASH_TIMING_ERASE_PROGRAM_PAGE) {
+            timeout += interval) {
 
         /* get status register */
         uint16_t status = _get_register(DATAFLASH_OP_STATUS);
@@ -655,8 +686,8 @@ int DataFlashBlockDevice::_sync(void)
             break;
             /* wait the typical write period before trying again */
         } else {
-            DEBUG_PRINTF("sleep_for: %d\r\n", DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
-            rtos::ThisThread::sleep_for(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
+            DEBUG_PRINTF("sleep_for: %" PRIu32 "\r\n", interval);
+            rtos::ThisThread::sleep_for(interval);
         }
     }
 
@@ -686,16 +717,7 @@ int DataFlashBlockDevice::_write_page(const uint8_t *buffer,
      */
     command = DATAFLASH_OP_PROGRAM_DIRECT;
 
-    uint32_t address = 0;
-
-    /* convert page number and offset into device address based on address format */
-    if (_page_size == DATAFLASH_PAGE_SIZE_264) {
-        address = (page << DATAFLASH_PAGE_BIT_264) | offset;
-    } else if (_page_size == DATAFLASH_PAGE_SIZE_528) {
-        address = (page << DATAFLASH_PAGE_BIT_528) | offset;
-    } else {
-        address = (page * _page_size) | offset;
-    }
+    uint32_t address = _page_address(page, offset);
 
     /* set write address */
     command = (command << 8) | ((address >> 16) & 0xFF);
@@ -706,11 +728,70 @@ int DataFlashBlockDevice::_write_page(const uint8_t *buffer,
     _write_command(command, buffer, size);
 
     /* wait until device is ready before continuing */
-    int result = _sync();
+    int result = _sync(DATAFLASH_TIMING_PROGRAM_PAGE);
 
     return result;
 }
 
+/**
+ * @brief Write a full page through an SRAM buffer.
+ * @details The buffer is loaded while the device may still be programming
+ *          a page from the other buffer, then the page is programmed from it
+ *          without waiting: the next _sync waits for its completion.
+ *
+ * @param buffer Data to write, a full page.
+ * @param page Page to write.
+ * @param sram_buffer SRAM buffer to write through, 0 or 1.
+ * @return BlockDevice error code.
+ */
+int DataFlashBlockDevice::_write_buffered_page(const uint8_t *buffer,
+                                               uint32_t page,
+                                               int sram_buffer)
+{
+    DEBUG_PRINTF("_write_buffered_page: %p %" PRIX32 " %d\r\n", buffer, page, sram_buffer);
+
+    /* load the buffer from its start */
+    uint32_t command = sram_buffer ? DATAFLASH_OP_WRITE_BUFFER_2 : DATAFLASH_OP_WRITE_BUFFER_1;
+    _write_command(command << 24, buffer, _page_size);
+
+    /* wait for the page programmed from the other buffer */
+    int result = _sync(DATAFLASH_TIMING_PROGRAM_PAGE);
+    if (result != BD_ERROR_OK) {
+        return result;
+    }
+
+    uint32_t address = _page_address(page, 0);
+
+    /* start programming the page from the buffer */
+    command = sram_buffer ? DATAFLASH_OP_PROGRAM_BUFFER_2 : DATAFLASH_OP_PROGRAM_BUFFER_1;
+    command = (command << 8) | ((address >> 16) & 0xFF);
+    command = (command << 8) | ((address >>  8) & 0xFF);
+    command = (command << 8) | (address & 0xFF);
+
+    _write_command(command, NULL, 0);
+
+    return BD_ERROR_OK;
+}
+
+/**
+ * @brief Convert a page number and offset into a device address.
+ *
+ * @param page Page number.
+ * @param offset Offset in the page.
+ * @return Address in format expected by device.
+ */
+uint32_t DataFlashBlockDevice::_page_address(uint32_t page, uint32_t offset)
+{
+    /* convert page number and offset into device address based on address format */
+    if (_page_size == DATAFLASH_PAGE_SIZE_264) {
+        return (page << DATAFLASH_PAGE_BIT_264) | offset;
+    } else if (_page_size == DATAFLASH_PAGE_SIZE_528) {
+        return (page << DATAFLASH_PAGE_BIT_528) | offset;
+    } else {
+        return (page * _page_size) | offset;
+    }
+}
+
 /**
  * @brief Translate address.
  * @details If the device is configured for non-binary page sizes,
@@ -82,6 +82,36 @@ public:
      */
     virtual int erase(mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+#if DEVICE_FLASH_ASYNCH || defined(DOXYGEN_ONLY)
+    /** Program blocks to a block device without blocking
+     *
+     *  The request is queued while another asynchronous operation is ongoing.
+     *
+     *  @see FlashIAP::program_async
+     *
+     *  @param buffer   Buffer of data to write to blocks, valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Called from interrupt context with 0 on success or a negative error code on failure
+     *  @return         0 if programming was started or a negative error code on failure
+     */
+    virtual int program_async(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size,
+                              mbed::bd_callback_t callback);
+
+    /** Erase blocks on a block device without blocking
+     *
+     *  The request is queued while another asynchronous operation is ongoing.
+     *
+     *  @see FlashIAP::erase_async
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Called from interrupt context with 0 on success or a negative error code on failure
+     *  @return         0 if erasing was started or a negative error code on failure
+     */
+    virtual int erase_async(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::bd_callback_t callback);
+#endif
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -122,6 +152,15 @@ public:
      */
     virtual mbed::bd_size_t size() const;
 
+    /** Get the address of the storage in the CPU address space
+     *
+     *  @param addr     Address of the storage to map
+     *  @param size     Size of the storage to map in bytes
+     *  @return         Pointer to the contents of the storage at addr, or NULL
+     *                  if the range is not mapped in the address space
+     */
+    virtual const void *get_mapped_address(mbed::bd_addr_t addr, mbed::bd_size_t size) const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
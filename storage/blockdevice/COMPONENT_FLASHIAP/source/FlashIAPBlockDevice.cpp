@@ -185,6 +185,43 @@ int FlashIAPBlockDevice::erase(bd_addr_t virtual_address,
     return result;
 }
 
+#if DEVICE_FLASH_ASYNCH
+int FlashIAPBlockDevice::program_async(const void *buffer,
+                                       bd_addr_t virtual_address,
+                                       bd_size_t size,
+                                       bd_callback_t callback)
+{
+    DEBUG_PRINTF("program_async: %" PRIX64 " %" PRIX64 "\r\n", virtual_address, size);
+
+    /* Check that the address and size are properly aligned and fit. */
+    if (!_is_initialized || !is_valid_program(virtual_address, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    /* Convert virtual address to the physical address for the device. */
+    bd_addr_t physical_address = _base + virtual_address;
+
+    return _flash.program_async(buffer, physical_address, size, callback) ? BD_ERROR_DEVICE_ERROR : BD_ERROR_OK;
+}
+
+int FlashIAPBlockDevice::erase_async(bd_addr_t virtual_address,
+                                     bd_size_t size,
+                                     bd_callback_t callback)
+{
+    DEBUG_PRINTF("erase_async: %" PRIX64 " %" PRIX64 "\r\n", virtual_address, size);
+
+    /* Check that the address and size are properly aligned and fit. */
+    if (!_is_initialized || !is_valid_erase(virtual_address, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    /* Convert virtual address to the physical address for the device. */
+    bd_addr_t physical_address = _base + virtual_address;
+
+    return _flash.erase_async(physical_address, size, callback) ? BD_ERROR_DEVICE_ERROR : BD_ERROR_OK;
+}
+#endif
+
 bd_size_t FlashIAPBlockDevice::get_read_size() const
 {
     DEBUG_PRINTF("get_read_size: %d\r\n", FLASHIAP_READ_SIZE);
@@ -252,6 +289,16 @@ bd_size_t FlashIAPBlockDevice::size() const
     return _size;
 }
 
+const void *FlashIAPBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized || addr + size > _size) {
+        return NULL;
+    }
+
+    /* The internal flash is read in place at its physical address. */
+    return reinterpret_cast<const void *>(static_cast<uintptr_t>(_base + addr));
+}
+
 const char *FlashIAPBlockDevice::get_type() const
 {
     return "FLASHIAP";
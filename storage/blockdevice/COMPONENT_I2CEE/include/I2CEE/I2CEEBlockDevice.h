@@ -20,9 +20,19 @@
 #include "blockdevice/BlockDevice.h"
 #include "drivers/I2C.h"
 
+#if DEVICE_I2C_ASYNCH && MBED_CONF_I2CEE_ASYNC_TRANSFER
+#include "rtos/Semaphore.h"
+#endif
+
 /** BlockDevice for I2C based flash device such as
  *  Microchip's 24LC or ATMEL's AT24C ranges
  *
+ *  Contiguous programs are gathered into a page buffer and written one page
+ *  at a time. A page is written when it is full, when a program leaves it,
+ *  and on read, sync and deinit, so call sync() to make sure the data is on
+ *  the chip. The write cycle of a page is not waited for until the chip is
+ *  accessed again, and it is detected by polling the chip for an ACK.
+ *
  *  @code
  *  // Here's an example using a 24LC256 on a GR PEACH
  *  #include "mbed.h"
@@ -109,6 +119,12 @@ public:
      */
     virtual int deinit();
 
+    /** Write the buffered page and wait for the chip to complete it
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
     /** Read blocks from a block device
      *
      *  @param buffer   Buffer to write blocks to
@@ -179,7 +195,23 @@ private:
     uint32_t _size;
     uint32_t _block;
 
+    // address bytes followed by one page of data
+    uint8_t *_page;
+    bd_addr_t _page_addr;
+    uint32_t _page_count;
+    bool _write_pending;
+
     int _sync();
+    int _wait_transfer();
+    int _wait_ready();
+    int _program_page();
+
+#if DEVICE_I2C_ASYNCH && MBED_CONF_I2CEE_ASYNC_TRANSFER
+    void _transfer_done(int event);
+    rtos::Semaphore _transfer_sem;
+    volatile int _transfer_event;
+    bool _transfer_ongoing;
+#endif
 
     /**
      * Gets the device's I2C address with respect to the requested page.
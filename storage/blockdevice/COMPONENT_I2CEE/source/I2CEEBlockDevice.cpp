@@ -15,10 +15,23 @@
  * limitations under the License.
  */
 #include "I2CEEBlockDevice.h"
+#include "drivers/Timer.h"
 #include "rtos/ThisThread.h"
+#include <string.h>
 using namespace mbed;
+using namespace std::chrono;
 
-#define I2CEE_TIMEOUT 10000
+#ifndef MBED_CONF_I2CEE_ASYNC_TRANSFER
+#define MBED_CONF_I2CEE_ASYNC_TRANSFER 0   /*!< Write pages with the asynchronous I2C API */
+#endif
+
+#define I2CEE_ASYNC_TRANSFER (DEVICE_I2C_ASYNCH && MBED_CONF_I2CEE_ASYNC_TRANSFER)
+
+#define I2CEE_TIMEOUT 10000ms
+// Write cycles complete within 5-10ms: poll back to back for that long before sleeping between polls
+#define I2CEE_BUSY_POLL_TIME 10ms
+// Room for the address bytes in front of the page data
+#define I2CEE_HEADER_SIZE 2
 
 
 I2CEEBlockDevice::I2CEEBlockDevice(
@@ -29,6 +42,14 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _page(NULL)
+    , _page_addr(0)
+    , _page_count(0)
+    , _write_pending(false)
+#if I2CEE_ASYNC_TRANSFER
+    , _transfer_event(0)
+    , _transfer_ongoing(false)
+#endif
 {
     _i2c = new (_i2c_buffer) I2C(sda, scl);
     _i2c->frequency(freq);
@@ -42,6 +63,14 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _page(NULL)
+    , _page_addr(0)
+    , _page_count(0)
+    , _write_pending(false)
+#if I2CEE_ASYNC_TRANSFER
+    , _transfer_event(0)
+    , _transfer_ongoing(false)
+#endif
 {
     _i2c = i2c_obj;
 }
@@ -50,16 +79,37 @@ I2CEEBlockDevice::~I2CEEBlockDevice()
     if (_i2c == (I2C *)_i2c_buffer) {
         _i2c->~I2C();
     }
+    delete[] _page;
 }
 
 int I2CEEBlockDevice::init()
 {
+    if (!_page) {
+        _page = new uint8_t[I2CEE_HEADER_SIZE + _block];
+    }
+    _page_count = 0;
+    _write_pending = false;
+
     return _sync();
 }
 
 int I2CEEBlockDevice::deinit()
 {
-    return 0;
+    int err = sync();
+
+    delete[] _page;
+    _page = NULL;
+    return err;
+}
+
+int I2CEEBlockDevice::sync()
+{
+    int err = _program_page();
+    if (err) {
+        return err;
+    }
+
+    return _wait_ready();
 }
 
 int I2CEEBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
@@ -69,6 +119,12 @@ int I2CEEBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
     auto *pBuffer = static_cast<char *>(buffer);
 
+    // The chip must have completed the buffered data before reading it back
+    int err = sync();
+    if (err) {
+        return err;
+    }
+
     _i2c->start();
 
     if (1 != _i2c->write(get_paged_device_address(addr))) {
@@ -104,32 +160,30 @@ int I2CEEBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
         uint32_t off = addr % _block;
         uint32_t chunk = (off + size < _block) ? size : (_block - off);
 
-        _i2c->start();
-
-        if (1 != _i2c->write(get_paged_device_address(addr))) {
-            return BD_ERROR_DEVICE_ERROR;
+        // Only contiguous data of the same page is gathered
+        int err = 0;
+        if (_page_count && addr != _page_addr + _page_count) {
+            err = _program_page();
         }
-
-        if (!_address_is_eight_bit && 1 != _i2c->write((char)(addr >> 8u))) {
-            return BD_ERROR_DEVICE_ERROR;
+        if (!err) {
+            err = _wait_transfer();
         }
-
-        if (1 != _i2c->write((char)(addr & 0xffu))) {
-            return BD_ERROR_DEVICE_ERROR;
+        if (err) {
+            return err;
         }
 
-        for (unsigned i = 0; i < chunk; i++) {
-            if (1 != _i2c->write(pBuffer[i])) {
-                return BD_ERROR_DEVICE_ERROR;
-            }
+        if (_page_count == 0) {
+            _page_addr = addr;
         }
-
-        _i2c->stop();
-
-        int err = _sync();
-
-        if (err) {
-            return err;
+        memcpy(&_page[I2CEE_HEADER_SIZE + _page_count], pBuffer, chunk);
+        _page_count += chunk;
+
+        // Write the page as soon as it is complete
+        if (off + chunk == _block) {
+            err = _program_page();
+            if (err) {
+                return err;
+            }
         }
 
         addr += chunk;
@@ -151,17 +205,107 @@ int I2CEEBlockDevice::_sync()
     // The chip doesn't ACK while writing to the actual EEPROM
     // so loop trying to do a zero byte write until it is ACKed
     // by the chip.
-    for (int i = 0; i < I2CEE_TIMEOUT; i++) {
+    Timer timer;
+    timer.start();
+
+    while (timer.elapsed_time() < I2CEE_TIMEOUT) {
         if (_i2c->write(_i2c_addr | 0, 0, 0) < 1) {
             return 0;
         }
 
-        rtos::ThisThread::sleep_for(1);
+        if (timer.elapsed_time() > I2CEE_BUSY_POLL_TIME) {
+            rtos::ThisThread::sleep_for(1ms);
+        }
     }
 
     return BD_ERROR_DEVICE_ERROR;
 }
 
+int I2CEEBlockDevice::_wait_transfer()
+{
+#if I2CEE_ASYNC_TRANSFER
+    if (_transfer_ongoing) {
+        _transfer_ongoing = false;
+        if (!_transfer_sem.try_acquire_for(I2CEE_TIMEOUT)) {
+            _i2c->abort_transfer();
+            _write_pending = false;
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        if (_transfer_event & I2C_EVENT_ERROR) {
+            _write_pending = false;
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    }
+#endif
+
+    return 0;
+}
+
+int I2CEEBlockDevice::_wait_ready()
+{
+    int err = _wait_transfer();
+    if (err) {
+        return err;
+    }
+
+    if (!_write_pending) {
+        return 0;
+    }
+    _write_pending = false;
+
+    return _sync();
+}
+
+int I2CEEBlockDevice::_program_page()
+{
+    if (_page_count == 0) {
+        return 0;
+    }
+
+    // The previous page must have been written before the chip accepts this one
+    int err = _wait_ready();
+    if (err) {
+        _page_count = 0;
+        return err;
+    }
+
+    // The address bytes go right in front of the data,
+    // for the page to be written in a single transfer
+    uint8_t *header = &_page[I2CEE_HEADER_SIZE];
+    *--header = (uint8_t)(_page_addr & 0xffu);
+    if (!_address_is_eight_bit) {
+        *--header = (uint8_t)(_page_addr >> 8u);
+    }
+    int length = &_page[I2CEE_HEADER_SIZE + _page_count] - header;
+    int address = get_paged_device_address(_page_addr);
+    _page_count = 0;
+
+#if I2CEE_ASYNC_TRANSFER
+    // Return without waiting for the transfer, the page buffer is released in _wait_transfer()
+    if (0 == _i2c->transfer(address, (const char *)header, length, NULL, 0,
+                            callback(this, &I2CEEBlockDevice::_transfer_done), I2C_EVENT_ALL)) {
+        _transfer_ongoing = true;
+        _write_pending = true;
+        return 0;
+    }
+#endif
+
+    if (0 != _i2c->write(address, (const char *)header, length)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    _write_pending = true;
+
+    return 0;
+}
+
+#if I2CEE_ASYNC_TRANSFER
+void I2CEEBlockDevice::_transfer_done(int event)
+{
+    _transfer_event = event;
+    _transfer_sem.release();
+}
+#endif
+
 bd_size_t I2CEEBlockDevice::get_read_size() const
 {
     return 1;
@@ -156,6 +156,53 @@ void test_read_write()
     TEST_ASSERT_EQUAL(0, err);
 }
 
+void test_program_coalescing()
+{
+    I2CEEBlockDevice bd(TEST_PINS, TEST_ADDR,
+                        TEST_SIZE, TEST_BLOCK_SIZE, TEST_FREQ);
+
+    int err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Small unaligned programs, gathered into pages and crossing page boundaries
+    const bd_size_t length = 3 * TEST_BLOCK_SIZE;
+    const bd_addr_t start = TEST_BLOCK_SIZE - 5;
+    uint8_t *write_block = new uint8_t[length];
+    uint8_t *read_block = new uint8_t[length];
+
+    for (bd_size_t i = 0; i < length; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    for (bd_size_t i = 0; i < length; i += 7) {
+        bd_size_t chunk = (length - i < 7) ? length - i : 7;
+        err = bd.program(&write_block[i], start + i, chunk);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    err = bd.sync();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = bd.read(read_block, start, length);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, length);
+
+    // A read returns the data of a page not written yet
+    write_block[0] ^= 0xff;
+    err = bd.program(write_block, start, 1);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = bd.read(read_block, start, 1);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(write_block[0], read_block[0]);
+
+    delete[] write_block;
+    delete[] read_block;
+
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -166,6 +213,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("Testing read write random blocks", test_read_write),
+    Case("Testing coalesced programs", test_program_coalescing),
 };
 
 Specification specification(test_setup, cases);
@@ -21,6 +21,9 @@
 #include "drivers/internal/SFDP.h"
 #include "blockdevice/BlockDevice.h"
 #include "platform/Callback.h"
+#if DEVICE_QSPI_ASYNCH
+#include "rtos/Semaphore.h"
+#endif
 
 #ifndef MBED_CONF_QSPIF_QSPI_IO0
 #define MBED_CONF_QSPIF_QSPI_IO0 NC
@@ -248,6 +251,40 @@ public:
      */
     virtual const char *get_type() const;
 
+#if DEVICE_QSPI_MEMORY_MAPPED || defined(DOXYGEN_ONLY)
+    /** Get the device content mapped into the address space
+     *
+     *  Gives zero-copy read access to the whole device. The region is only
+     *  valid until the next operation on the block device (including a read
+     *  that cannot be served from the mapping), after which this function
+     *  must be called again.
+     *
+     *  @note The region is empty while a program or erase is ongoing in
+     *        another thread, read() suspends it instead.
+     *
+     *  @return         The mapped device content, empty if the device cannot be mapped
+     */
+    mbed::Span<const uint8_t> get_mapped_region();
+#endif
+
+    /** Get the SFDP tables read by the last init
+     *
+     *  Applications can store them, for example in a KVStore entry, and pass
+     *  them to set_sfdp_cache before the next init to skip the SFDP discovery.
+     *
+     *  @return         SFDP tables, with a version of 0 until the device is initialized
+     */
+    const mbed::sfdp_cache &get_sfdp_cache() const;
+
+    /** Provide SFDP tables stored by the application
+     *
+     *  init uses them instead of the SFDP data of the device if they were
+     *  read from a device with the same JEDEC ID.
+     *
+     *  @param cache    SFDP tables from get_sfdp_cache
+     */
+    void set_sfdp_cache(const mbed::sfdp_cache &cache);
+
 private:
     /********************************/
     /*   Different Device Csel Mgmt */
@@ -291,6 +328,19 @@ private:
     // Update the 4-byte addressing extension register with the MSB of the address if it is in use
     qspi_status_t _qspi_update_4byte_ext_addr_reg(bd_addr_t addr);
 
+#if DEVICE_QSPI_ASYNCH
+    // Sleep until the asynchronous operation started last ends, aborting it after timeout
+    qspi_status_t _qspi_wait_async(rtos::Kernel::Clock::duration_u32 timeout);
+
+    // Completion callback of the asynchronous operations, called from interrupt context
+    void _qspi_async_complete(qspi_status_t status);
+#endif
+
+#if DEVICE_QSPI_MEMORY_MAPPED
+    // Map the device with the read instruction and bus mode, if its whole address range is reachable without the extension register
+    qspi_status_t _qspi_memory_map(mbed::Span<const uint8_t> &region);
+#endif
+
     /*********************************/
     /* Flash Configuration Functions */
     /*********************************/
@@ -303,6 +353,15 @@ private:
     // Wait on status register until write not-in-progress
     bool _is_mem_ready();
 
+    // Wait until write not-in-progress, releasing the mutex between polls so reads can suspend the write
+    bool _is_mem_ready_suspendable(mbed::qspi_inst_t suspend_inst, mbed::qspi_inst_t resume_inst);
+
+    // Suspend the ongoing program or erase, if any, ahead of a read
+    int _suspend_for_read(bool &suspended);
+
+    // Resume the program or erase suspended by _suspend_for_read
+    void _resume_after_read();
+
     // Enable Fast Mode - for flash chips with low power default
     int _enable_fast_mode();
 
@@ -355,6 +414,19 @@ private:
     // e.g. (1)Set Write Enable, (2)Program, (3)Wait Memory Ready
     PlatformMutex _mutex;
 
+    // Serializes programs and erases, which release _mutex while they can be suspended
+    PlatformMutex _write_mutex;
+
+#if DEVICE_QSPI_ASYNCH
+    // Released by _qspi_async_complete
+    rtos::Semaphore _async_done;
+    volatile qspi_status_t _async_status;
+#endif
+
+    // Suspend/resume instructions of the ongoing program or erase, QSPI_NO_INST if none can be suspended
+    mbed::qspi_inst_t _busy_suspend_inst;
+    mbed::qspi_inst_t _busy_resume_inst;
+
     // Command Instructions
     mbed::qspi_inst_t _read_instruction;
 
@@ -380,6 +452,10 @@ private:
     // Data extracted from the devices SFDP structure
     mbed::sfdp_hdr_info _sfdp_info;
 
+    // SFDP tables used by init instead of the device SFDP data when the JEDEC ID matches
+    mbed::sfdp_cache _sfdp_cache;
+    uint8_t _jedec_id[3];
+
     unsigned int _page_size_bytes; // Page size - 256 Bytes default
     int _freq;
 
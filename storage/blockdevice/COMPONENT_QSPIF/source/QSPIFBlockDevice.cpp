@@ -20,6 +20,7 @@
 #include "QSPIFBlockDevice.h"
 #include <string.h>
 #include "rtos/ThisThread.h"
+#include "platform/mbed_wait_api.h"
 
 #ifndef MBED_CONF_MBED_TRACE_ENABLE
 #define MBED_CONF_MBED_TRACE_ENABLE        0
@@ -85,6 +86,16 @@ using namespace mbed;
 
 #define IS_MEM_READY_MAX_RETRIES 10000
 
+#if DEVICE_QSPI_ASYNCH
+#define QSPIF_USE_ASYNC(size) ((size) >= MBED_CONF_QSPIF_ASYNC_MIN_SIZE)
+// Generous bound of a DMA transfer, the device clocks it at its own pace
+#define QSPIF_ASYNC_TRANSFER_TIMEOUT 1s
+// Status register polls every 10us in hardware
+#define QSPIF_ASYNC_POLL_PER_SECOND 100000
+#else
+#define QSPIF_USE_ASYNC(size) false
+#endif
+
 
 // General QSPI instructions
 #define QSPIF_INST_WSR1  0x01 // Write status register 1
@@ -129,7 +140,8 @@ QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinNam
                                    int clock_mode,
                                    int freq)
     :
-    _qspi(io0, io1, io2, io3, sclk, csel, clock_mode), _csel(csel), _freq(freq),
+    _qspi(io0, io1, io2, io3, sclk, csel, clock_mode), _csel(csel),
+    _busy_suspend_inst(QSPI_NO_INST), _busy_resume_inst(QSPI_NO_INST), _freq(freq),
     _init_ref_count(0),
     _is_initialized(false)
 {
@@ -145,10 +157,16 @@ QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinNam
 
     // Initialize parameters
     _sfdp_info.bptbl.legacy_erase_instruction = QSPIF_INST_LEGACY_ERASE_DEFAULT;
+    _sfdp_info.bptbl.erase_suspend_inst = QSPI_NO_INST;
+    _sfdp_info.bptbl.erase_resume_inst = QSPI_NO_INST;
+    _sfdp_info.bptbl.program_suspend_inst = QSPI_NO_INST;
+    _sfdp_info.bptbl.program_resume_inst = QSPI_NO_INST;
     _sfdp_info.bptbl.device_size_bytes = 0;
     _sfdp_info.smptbl.regions_min_common_erase_size = 0;
     _sfdp_info.smptbl.region_cnt = 1;
     _sfdp_info.smptbl.region_erase_types_bitfld[0] = SFDP_ERASE_BITMASK_NONE;
+    _sfdp_cache.version = 0;
+    memset(_jedec_id, 0, sizeof(_jedec_id));
 
     // Until proven otherwise, assume no quad enable
     _quad_enable_register_idx = QSPIF_NO_QUAD_ENABLE;
@@ -235,29 +253,41 @@ int QSPIFBlockDevice::init()
 
     /**************************** Parse SFDP data ***********************************/
     {
+        Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader = callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command);
+        bool cached = false;
+
         _sfdp_info.bptbl.addr = 0x0;
         _sfdp_info.bptbl.size = 0;
         _sfdp_info.smptbl.addr = 0x0;
         _sfdp_info.smptbl.size = 0;
 
-        if (sfdp_parse_headers(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command), _sfdp_info) < 0) {
+        // Tables from a previous init, or stored by the application, skip the SFDP discovery
+        if (0 == sfdp_cache_lookup(_sfdp_cache, _jedec_id, _sfdp_info)) {
+            sfdp_reader = callback(sfdp_cache_read, &_sfdp_cache);
+            cached = true;
+        } else if (sfdp_parse_headers(sfdp_reader, _sfdp_info) < 0) {
             tr_error("Init - Parse SFDP Headers Failed");
             status = QSPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
 
-        if (_sfdp_parse_basic_param_table(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command),
-                                          _sfdp_info) < 0) {
+        if (_sfdp_parse_basic_param_table(sfdp_reader, _sfdp_info) < 0) {
             tr_error("Init - Parse Basic Param Table Failed");
+            _sfdp_cache.version = 0;
             status = QSPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
 
-        if (sfdp_parse_sector_map_table(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command), _sfdp_info) < 0) {
+        if (sfdp_parse_sector_map_table(sfdp_reader, _sfdp_info) < 0) {
             tr_error("Init - Parse Sector Map Table Failed");
+            _sfdp_cache.version = 0;
             status = QSPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
+
+        if (!cached) {
+            sfdp_cache_tables(sfdp_reader, _sfdp_info, _jedec_id, _sfdp_cache);
+        }
     }
 
     if (0 != _clear_block_protection()) {
@@ -314,15 +344,40 @@ int QSPIFBlockDevice::deinit()
 int QSPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 {
     int status = QSPIF_BD_ERROR_OK;
+    bool suspended = false;
     tr_debug("Read Inst: 0x%xh", _read_instruction);
 
     _mutex.lock();
 
+    // Reads take priority over an ongoing program or erase
+    status = _suspend_for_read(suspended);
+    if (status != QSPIF_BD_ERROR_OK) {
+        goto exit_point;
+    }
+
+#if DEVICE_QSPI_MEMORY_MAPPED && MBED_CONF_QSPIF_MEMORY_MAPPED_READ
+    {
+        // Program and erase commands switch the interface back to indirect mode by themselves,
+        // and so does the resume command
+        // Large reads are left to the DMA rather than copied by the CPU
+        mbed::Span<const uint8_t> region;
+        if (!QSPIF_USE_ASYNC(size) && (QSPI_STATUS_OK == _qspi_memory_map(region)) && (addr + size <= region.size())) {
+            memcpy(buffer, region.data() + addr, size);
+            goto exit_point;
+        }
+    }
+#endif
+
     if (QSPI_STATUS_OK != _qspi_send_read_command(_read_instruction, buffer, addr, size)) {
         tr_error("Read Command failed");
         status = QSPIF_BD_ERROR_DEVICE_ERROR;
     }
 
+exit_point:
+    if (suspended) {
+        _resume_after_read();
+    }
+
     _mutex.unlock();
 
     return status;
@@ -340,6 +395,8 @@ int QSPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
 
     tr_debug("Program - Buff: 0x%lxh, addr: %llu, size: %llu", (uint32_t)buffer, addr, size);
 
+    _write_mutex.lock();
+
     while (size > 0) {
         // Write on _page_size_bytes boundaries (Default 256 bytes a page)
         offset = addr % _page_size_bytes;
@@ -368,7 +425,8 @@ int QSPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
         addr += chunk;
         size -= chunk;
 
-        if (false == _is_mem_ready()) {
+        if (false == _is_mem_ready_suspendable(_sfdp_info.bptbl.program_suspend_inst,
+                                               _sfdp_info.bptbl.program_resume_inst)) {
             tr_error("Device not ready after write, failed");
             program_failed = true;
             status = QSPIF_BD_ERROR_READY_FAILED;
@@ -382,6 +440,8 @@ exit_point:
         _mutex.unlock();
     }
 
+    _write_mutex.unlock();
+
     return status;
 }
 
@@ -411,6 +471,8 @@ int QSPIFBlockDevice::erase(bd_addr_t addr, bd_size_t in_size)
         return QSPIF_BD_ERROR_INVALID_ERASE_PARAMS;
     }
 
+    _write_mutex.lock();
+
     // For each iteration erase the largest section supported by current region
     while (size > 0) {
         unsigned int eu_size;
@@ -460,7 +522,8 @@ int QSPIFBlockDevice::erase(bd_addr_t addr, bd_size_t in_size)
             bitfield = _sfdp_info.smptbl.region_erase_types_bitfld[region];
         }
 
-        if (false == _is_mem_ready()) {
+        if (false == _is_mem_ready_suspendable(_sfdp_info.bptbl.erase_suspend_inst,
+                                               _sfdp_info.bptbl.erase_resume_inst)) {
             tr_error("QSPI After Erase Device not ready - failed");
             erase_failed = true;
             status = QSPIF_BD_ERROR_READY_FAILED;
@@ -475,6 +538,8 @@ exit_point:
         _mutex.unlock();
     }
 
+    _write_mutex.unlock();
+
     return status;
 }
 
@@ -501,6 +566,34 @@ const char *QSPIFBlockDevice::get_type() const
     return "QSPIF";
 }
 
+const mbed::sfdp_cache &QSPIFBlockDevice::get_sfdp_cache() const
+{
+    return _sfdp_cache;
+}
+
+void QSPIFBlockDevice::set_sfdp_cache(const mbed::sfdp_cache &cache)
+{
+    _mutex.lock();
+    _sfdp_cache = cache;
+    _mutex.unlock();
+}
+
+#if DEVICE_QSPI_MEMORY_MAPPED
+mbed::Span<const uint8_t> QSPIFBlockDevice::get_mapped_region()
+{
+    mbed::Span<const uint8_t> region;
+
+    _mutex.lock();
+    // The content can't be read while the device is busy with a suspendable write
+    if (_is_initialized && _busy_suspend_inst == QSPI_NO_INST) {
+        _qspi_memory_map(region);
+    }
+    _mutex.unlock();
+
+    return region;
+}
+#endif
+
 // Find minimal erase size supported by the region to which the address belongs to
 bd_size_t QSPIFBlockDevice::get_erase_size(bd_addr_t addr)
 {
@@ -651,6 +744,9 @@ int QSPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void
         return -1;
     }
 
+    // Detect program/erase suspend and resume instructions, used to serve reads during long writes
+    sfdp_detect_suspend_resume(param_table, sfdp_info.bptbl);
+
     // Detect and Set fastest Bus mode (default 1-1-1)
     _sfdp_detect_best_bus_read_mode(param_table, sfdp_info.bptbl.size, shouldSetQuadEnable, is_qpi_mode);
     if (true == shouldSetQuadEnable) {
@@ -1066,6 +1162,7 @@ int QSPIFBlockDevice::_handle_vendor_quirks()
     }
 
     tr_debug("Vendor device ID = 0x%x 0x%x 0x%x", vendor_device_ids[0], vendor_device_ids[1], vendor_device_ids[2]);
+    memcpy(_jedec_id, vendor_device_ids, sizeof(_jedec_id));
 
     switch (vendor_device_ids[0]) {
         case 0xbf:
@@ -1245,6 +1342,19 @@ int QSPIFBlockDevice::_enable_fast_mode()
 
 bool QSPIFBlockDevice::_is_mem_ready()
 {
+#if DEVICE_QSPI_ASYNCH
+    // The QSPI peripheral polls the status register while the thread sleeps
+    uint32_t interval = _freq / QSPIF_ASYNC_POLL_PER_SECOND;
+    if (QSPI_STATUS_OK == _qspi.poll_status_async(QSPIF_INST_RSR1, 1, QSPIF_STATUS_BIT_WIP, 0, interval,
+                                                  mbed::callback(this, &QSPIFBlockDevice::_qspi_async_complete))) {
+        if (QSPI_STATUS_OK != _qspi_wait_async(IS_MEM_READY_MAX_RETRIES * 1ms)) {
+            tr_error("_is_mem_ready FALSE: status polling timed out");
+            return false;
+        }
+        return true;
+    }
+#endif
+
     // Check Status Register Busy Bit to Verify the Device isn't Busy
     uint8_t status_value = 0;
     int retries = 0;
@@ -1268,6 +1378,86 @@ bool QSPIFBlockDevice::_is_mem_ready()
     return mem_ready;
 }
 
+bool QSPIFBlockDevice::_is_mem_ready_suspendable(qspi_inst_t suspend_inst, qspi_inst_t resume_inst)
+{
+#if MBED_CONF_QSPIF_SUSPEND_FOR_READ
+    if (suspend_inst == QSPI_NO_INST || resume_inst == QSPI_NO_INST) {
+        return _is_mem_ready();
+    }
+
+    // Reads run between the polls, they suspend and resume the write before releasing the mutex
+    uint8_t status_value = 0;
+    int retries = 0;
+    bool mem_ready = true;
+
+    _busy_suspend_inst = suspend_inst;
+    _busy_resume_inst = resume_inst;
+    do {
+        _mutex.unlock();
+        rtos::ThisThread::sleep_for(1ms);
+        _mutex.lock();
+        retries++;
+        //Read Status Register 1 from device
+        if (QSPI_STATUS_OK != _qspi_send_general_command(QSPIF_INST_RSR1, QSPI_NO_ADDRESS_COMMAND,
+                                                         NULL, 0,
+                                                         (char *) &status_value, 1)) { // store received value in status_value
+            tr_error("Reading Status Register failed");
+        }
+    } while ((status_value & QSPIF_STATUS_BIT_WIP) != 0 && retries < IS_MEM_READY_MAX_RETRIES);
+    _busy_suspend_inst = QSPI_NO_INST;
+    _busy_resume_inst = QSPI_NO_INST;
+
+    if ((status_value & QSPIF_STATUS_BIT_WIP) != 0) {
+        tr_error("_is_mem_ready_suspendable FALSE: status value = 0x%x ", status_value);
+        mem_ready = false;
+    }
+    return mem_ready;
+#else
+    return _is_mem_ready();
+#endif
+}
+
+int QSPIFBlockDevice::_suspend_for_read(bool &suspended)
+{
+    uint8_t status_value = 0;
+
+    suspended = false;
+    if (_busy_suspend_inst == QSPI_NO_INST) {
+        return QSPIF_BD_ERROR_OK;
+    }
+
+    tr_debug("Suspend Inst: 0x%xh", _busy_suspend_inst);
+    if (QSPI_STATUS_OK != _qspi_send_general_command(_busy_suspend_inst, QSPI_NO_ADDRESS_COMMAND, NULL, 0, NULL, 0)) {
+        tr_error("Sending suspend command failed");
+        return QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    suspended = true;
+
+    // The busy bit clears once the write is suspended, or completed in the meantime
+    wait_us(_sfdp_info.bptbl.suspend_latency_us);
+    if (QSPI_STATUS_OK != _qspi_send_general_command(QSPIF_INST_RSR1, QSPI_NO_ADDRESS_COMMAND, NULL, 0,
+                                                     (char *) &status_value, 1)) {
+        tr_error("Reading Status Register failed");
+    }
+    if ((status_value & QSPIF_STATUS_BIT_WIP) != 0 && false == _is_mem_ready()) {
+        tr_error("Device not ready after suspend, failed");
+        return QSPIF_BD_ERROR_READY_FAILED;
+    }
+
+    return QSPIF_BD_ERROR_OK;
+}
+
+void QSPIFBlockDevice::_resume_after_read()
+{
+    tr_debug("Resume Inst: 0x%xh", _busy_resume_inst);
+    if (QSPI_STATUS_OK != _qspi_send_general_command(_busy_resume_inst, QSPI_NO_ADDRESS_COMMAND, NULL, 0, NULL, 0)) {
+        tr_error("Sending resume command failed");
+    }
+
+    // Let the write make progress before it can be suspended again
+    wait_us(_sfdp_info.bptbl.resume_to_suspend_us);
+}
+
 /***************************************************/
 /*********** QSPI Driver API Functions *************/
 /***************************************************/
@@ -1298,6 +1488,62 @@ qspi_status_t QSPIFBlockDevice::_qspi_update_4byte_ext_addr_reg(bd_addr_t addr)
     return status;
 }
 
+#if DEVICE_QSPI_ASYNCH
+qspi_status_t QSPIFBlockDevice::_qspi_wait_async(rtos::Kernel::Clock::duration_u32 timeout)
+{
+    if (!_async_done.try_acquire_for(timeout)) {
+        tr_error("QSPI asynchronous operation timed out");
+        _qspi.abort_async();
+        // The operation may have completed before the abort
+        _async_done.try_acquire();
+        return QSPI_STATUS_ERROR;
+    }
+
+    return _async_status;
+}
+
+void QSPIFBlockDevice::_qspi_async_complete(qspi_status_t status)
+{
+    _async_status = status;
+    _async_done.release();
+}
+#endif
+
+#if DEVICE_QSPI_MEMORY_MAPPED
+qspi_status_t QSPIFBlockDevice::_qspi_memory_map(mbed::Span<const uint8_t> &region)
+{
+    // Accesses carry the address bits only, the extension register cannot follow them
+    if ((_address_size != QSPI_CFG_ADDR_SIZE_32) && (size() > (1 << 24))) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    qspi_status_t status = _qspi.configure_format(_inst_width, _address_width, _address_size, _address_width, // Alt width should be the same as address width
+                                                  _alt_size, _data_width, _dummy_cycles);
+    if (QSPI_STATUS_OK != status) {
+        tr_error("_qspi_configure_format failed");
+        return status;
+    }
+
+    mbed::Span<const uint8_t> window;
+    status = _qspi.memory_map(_read_instruction, (_alt_size == 0) ? -1 : QSPI_ALT_DEFAULT_VALUE, window);
+
+    // The mapping keeps the read format, the driver goes back to 1-1-1 for the next commands
+    qspi_status_t format_status = _qspi.configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, _address_size, QSPI_CFG_BUS_SINGLE, 0, QSPI_CFG_BUS_SINGLE, 0);
+    if (QSPI_STATUS_OK != format_status) {
+        tr_error("_qspi_configure_format failed");
+        return format_status;
+    }
+
+    if (QSPI_STATUS_OK != status) {
+        tr_error("QSPI memory map failed");
+        return status;
+    }
+
+    region = window.first(window.size() < size() ? window.size() : size());
+    return QSPI_STATUS_OK;
+}
+#endif
+
 qspi_status_t QSPIFBlockDevice::_qspi_send_read_command(qspi_inst_t read_inst, void *buffer,
                                                         bd_addr_t addr, bd_size_t size)
 {
@@ -1322,7 +1568,17 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_read_command(qspi_inst_t read_inst, v
 
     // Don't check the read status until after we've configured the format back to 1-1-1, to avoid leaving the interface in an
     // incorrect state if the read fails.
-    status = _qspi.read(read_inst, (_alt_size == 0) ? -1 : QSPI_ALT_DEFAULT_VALUE, (unsigned int)addr, (char *)buffer, &buf_len);
+    int alt = (_alt_size == 0) ? -1 : QSPI_ALT_DEFAULT_VALUE;
+#if DEVICE_QSPI_ASYNCH
+    if (QSPIF_USE_ASYNC(size) &&
+            QSPI_STATUS_OK == _qspi.read_async(read_inst, alt, (unsigned int)addr, (char *)buffer, buf_len,
+                                               mbed::callback(this, &QSPIFBlockDevice::_qspi_async_complete))) {
+        status = _qspi_wait_async(QSPIF_ASYNC_TRANSFER_TIMEOUT);
+    } else
+#endif
+    {
+        status = _qspi.read(read_inst, alt, (unsigned int)addr, (char *)buffer, &buf_len);
+    }
 
     // All commands other than Read and RSFDP use default 1-1-1 bus mode (Program/Erase are constrained by flash memory performance more than bus performance)
     qspi_status_t format_status = _qspi.configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, _address_size, QSPI_CFG_BUS_SINGLE, 0, QSPI_CFG_BUS_SINGLE, 0);
@@ -1351,7 +1607,16 @@ qspi_status_t QSPIFBlockDevice::_qspi_send_program_command(qspi_inst_t prog_inst
     }
 
     // Send program (write) command to device driver
-    status = _qspi.write(prog_inst, -1, addr, (char *)buffer, (size_t *)size);
+#if DEVICE_QSPI_ASYNCH
+    if (QSPIF_USE_ASYNC(*size) &&
+            QSPI_STATUS_OK == _qspi.write_async(prog_inst, -1, addr, (const char *)buffer, *size,
+                                                mbed::callback(this, &QSPIFBlockDevice::_qspi_async_complete))) {
+        status = _qspi_wait_async(QSPIF_ASYNC_TRANSFER_TIMEOUT);
+    } else
+#endif
+    {
+        status = _qspi.write(prog_inst, -1, addr, (char *)buffer, (size_t *)size);
+    }
     if (QSPI_STATUS_OK != status) {
         tr_error("QSPI Write failed");
         return status;
@@ -30,6 +30,10 @@
 #include "platform/PlatformMutex.h"
 #include "hal/static_pinmap.h"
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_ASYNC_TRANSFER
+#include "rtos/Semaphore.h"
+#endif
+
 #ifndef MBED_CONF_SD_SPI_MOSI
 #define MBED_CONF_SD_SPI_MOSI NC
 #endif
@@ -271,6 +275,7 @@ private:
     int _read(uint8_t *buffer, uint32_t length);
     int _read_bytes(uint8_t *buffer, uint32_t length);
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
+    int _spi_block_transfer(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length);   /**< Transfer a data block */
     int _freq(void);
     void _preclock_then_select();
     void _postclock_then_deselect();
@@ -295,6 +300,11 @@ private:
 #if MBED_CONF_SD_CRC_ENABLED
     bool _crc_on;
 #endif
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_ASYNC_TRANSFER
+    void _spi_transfer_done(int event);
+    rtos::Semaphore _transfer_done;
+#endif
 };
 
 #endif  /* DEVICE_SPI */
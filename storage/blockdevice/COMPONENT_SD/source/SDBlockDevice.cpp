@@ -163,6 +163,12 @@ using namespace std::chrono;
 #define MBED_CONF_SD_INIT_FREQUENCY              100000 /*!< Initialization frequency Range (100KHz-400KHz) */
 #endif
 
+#ifndef MBED_CONF_SD_ASYNC_TRANSFER
+#define MBED_CONF_SD_ASYNC_TRANSFER              0      /*!< Transfer data blocks with the asynchronous SPI API */
+#endif
+
+#define SD_ASYNC_TRANSFER                        (DEVICE_SPI_ASYNCH && MBED_CONF_SD_ASYNC_TRANSFER)
+
 
 #define SD_COMMAND_TIMEOUT                       milliseconds{MBED_CONF_SD_CMD_TIMEOUT}
 #define SD_CMD0_GO_IDLE_STATE_RETRIES            MBED_CONF_SD_CMD0_IDLE_STATE_RETRIES
@@ -525,6 +531,7 @@ int SDBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             response = _write(buffer, SPI_START_BLK_MUL_WRITE, _block_size);
             if (response != SPI_DATA_ACCEPTED) {
                 debug_if(SD_DBG, "Multiple Block Write failed: 0x%x \n", response);
+                status = SD_BLOCK_DEVICE_ERROR_WRITE;
                 break;
             }
             buffer += _block_size;
@@ -535,6 +542,13 @@ int SDBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
          * of the next block
          */
         _spi.write(SPI_STOP_TRAN);
+
+        // The card is busy programming the last block after the stop token
+        _spi.write(SPI_FILL_CHAR);
+        if (false == _wait_ready(SD_COMMAND_TIMEOUT)) {
+            debug_if(SD_DBG, "Card not ready after Multiple Block Write\n");
+            status = SD_BLOCK_DEVICE_ERROR_WRITE;
+        }
     }
 
     _postclock_then_deselect();
@@ -950,7 +964,9 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     }
 
     // read data
-    _spi.write(NULL, 0, (char *)buffer, length);
+    if (0 != _spi_block_transfer(NULL, buffer, length)) {
+        return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+    }
 
     // Read the CRC16 checksum for the data block
     crc = (_spi.write(SPI_FILL_CHAR) << 8);
@@ -983,7 +999,9 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     _spi.write(token);
 
     // write the data
-    _spi.write((char *)buffer, length, NULL, 0);
+    if (0 != _spi_block_transfer(buffer, NULL, length)) {
+        return 0;
+    }
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -1083,6 +1101,34 @@ bd_size_t SDBlockDevice::_sd_sectors()
     return blocks;
 }
 
+// SPI function to transfer a data block, the other direction being ignored or filled with SPI_FILL_CHAR
+int SDBlockDevice::_spi_block_transfer(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length)
+{
+#if SD_ASYNC_TRANSFER
+    // Let the calling thread sleep, and the target use DMA, while the block is transferred.
+    // The card sees SPI_FILL_CHAR, the default write value, on MOSI while sending data
+    if (0 == _spi.transfer_burst(tx_buffer, rx_buffer, length,
+                                 callback(this, &SDBlockDevice::_spi_transfer_done), SPI_EVENT_COMPLETE)) {
+        if (!_transfer_done.try_acquire_for(SD_COMMAND_TIMEOUT)) {
+            _spi.abort_transfer();
+            debug_if(SD_DBG, "_spi_block_transfer: timeout\n");
+            return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+        }
+        return 0;
+    }
+#endif
+
+    _spi.write((const char *)tx_buffer, tx_buffer ? length : 0, (char *)rx_buffer, rx_buffer ? length : 0);
+    return 0;
+}
+
+#if SD_ASYNC_TRANSFER
+void SDBlockDevice::_spi_transfer_done(int event)
+{
+    _transfer_done.release();
+}
+#endif
+
 // SPI function to wait till chip is ready and sends start token
 bool SDBlockDevice::_wait_token(uint8_t token)
 {
@@ -1133,6 +1179,10 @@ void SDBlockDevice::_spi_init()
     _spi.frequency(_init_sck);
     _spi.format(8, 0);
     _spi.set_default_write_value(SPI_FILL_CHAR);
+#if SD_ASYNC_TRANSFER
+    // DMA for the data blocks, when the target has a free channel
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
     // Initial 74 cycles required for few cards, before selecting SPI mode
     _spi_wait(10);
     _spi.unlock();
@@ -23,6 +23,10 @@
 #include "drivers/internal/SFDP.h"
 #include "blockdevice/BlockDevice.h"
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER
+#include "rtos/Semaphore.h"
+#endif
+
 #ifndef MBED_CONF_SPIF_DRIVER_SPI_MOSI
 #define MBED_CONF_SPIF_DRIVER_SPI_MOSI NC
 #endif
@@ -216,6 +220,24 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Get the SFDP tables read by the last init
+     *
+     *  Applications can store them, for example in a KVStore entry, and pass
+     *  them to set_sfdp_cache before the next init to skip the SFDP discovery.
+     *
+     *  @return         SFDP tables, with a version of 0 until the device is initialized
+     */
+    const mbed::sfdp_cache &get_sfdp_cache() const;
+
+    /** Provide SFDP tables stored by the application
+     *
+     *  init uses them instead of the SFDP data of the device if they were
+     *  read from a device with the same JEDEC ID.
+     *
+     *  @param cache    SFDP tables from get_sfdp_cache
+     */
+    void set_sfdp_cache(const mbed::sfdp_cache &cache);
+
 private:
     /****************************************/
     /* SFDP Detection and Parsing Functions */
@@ -249,6 +271,12 @@ private:
 
     // Send set_frequency command to Driver
     spif_bd_error _spi_set_frequency(int freq);
+
+    // Transfer the data phase of a command, the selection being held
+    spif_bd_error _spi_data_transfer(const uint8_t *tx_buffer, uint8_t *rx_buffer, mbed::bd_size_t size);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER
+    void _spi_transfer_done(int event);
+#endif
     /********************************/
 
     // Soft Reset Flash Memory
@@ -260,6 +288,15 @@ private:
     // Wait on status register until write not-in-progress
     bool _is_mem_ready();
 
+    // Wait until write not-in-progress, releasing the mutex between polls so reads can suspend the write
+    bool _is_mem_ready_suspendable(int suspend_inst, int resume_inst);
+
+    // Suspend the ongoing program or erase, if any, ahead of a read
+    int _suspend_for_read(bool &suspended);
+
+    // Resume the program or erase suspended by _suspend_for_read
+    void _resume_after_read();
+
     // Query vendor ID and handle special behavior that isn't covered by SFDP data
     int _handle_vendor_quirks();
 
@@ -271,6 +308,13 @@ private:
     // e.g. (1)Set Write Enable, (2)Program, (3)Wait Memory Ready
     static SingletonPtr<PlatformMutex> _mutex;
 
+    // Serializes programs and erases, which release _mutex while they can be suspended
+    static SingletonPtr<PlatformMutex> _write_mutex;
+
+    // Suspend/resume instructions of the ongoing program or erase, -1 if none can be suspended
+    int _busy_suspend_inst;
+    int _busy_resume_inst;
+
     // Command Instructions
     int _read_instruction;
     int _prog_instruction;
@@ -279,6 +323,10 @@ private:
     // Data extracted from the devices SFDP structure
     mbed::sfdp_hdr_info _sfdp_info;
 
+    // SFDP tables used by init instead of the device SFDP data when the JEDEC ID matches
+    mbed::sfdp_cache _sfdp_cache;
+    uint8_t _jedec_id[3];
+
     unsigned int _page_size_bytes; // Page size - 256 Bytes default
     bd_size_t _device_size_bytes;
 
@@ -289,6 +337,10 @@ private:
     unsigned int _dummy_and_mode_cycles; // Number of Dummy and Mode Bits required by Current Bus Mode
     uint32_t _init_ref_count;
     bool _is_initialized;
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER
+    rtos::Semaphore _transfer_done;
+#endif
 };
 
 #endif  /* MBED_SPIF_BLOCK_DEVICE_H */
@@ -19,6 +19,7 @@
 #include "SPIFBlockDevice.h"
 #include "rtos/ThisThread.h"
 #include "mbed_critical.h"
+#include "platform/mbed_wait_api.h"
 
 #include <string.h>
 #include <inttypes.h>
@@ -45,6 +46,10 @@ using namespace mbed;
 /**********************************/
 //READ Instruction support according to BUS Configuration
 #define SPIF_BASIC_PARAM_TABLE_FAST_READ_SUPPORT_BYTE 2
+#define SPIF_FAST_READ_112_SUPPORT_BIT  0x01
+#define SPIF_FAST_READ_122_SUPPORT_BIT  0x10
+#define SPIF_FAST_READ_144_SUPPORT_BIT  0x20
+#define SPIF_FAST_READ_114_SUPPORT_BIT  0x40
 #define SPIF_BASIC_PARAM_TABLE_QPI_READ_SUPPORT_BYTE 16
 #define SPIF_BASIC_PARAM_TABLE_222_READ_INST_BYTE 23
 #define SPIF_BASIC_PARAM_TABLE_122_READ_INST_BYTE 15
@@ -57,6 +62,19 @@ using namespace mbed;
 #define SPIF_INST_READ_DEFAULT          0x03
 #define SPIF_INST_LEGACY_ERASE_DEFAULT  (-1)
 
+// Fast Read, 1-1-1 with 8 dummy cycles, supported by the devices describing themselves through SFDP
+#define SPIF_INST_FAST_READ             0x0B
+#define SPIF_FAST_READ_DUMMY_CYCLES     8
+
+#ifndef MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER
+#define MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER 0
+#endif
+#define SPIF_ASYNC_TRANSFER             (DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_ASYNC_TRANSFER)
+// Smallest data phase worth a DMA transfer, smaller ones being clocked by the CPU
+#define SPIF_ASYNC_TRANSFER_MIN_SIZE    32
+// Longest wait for a DMA data phase, allowing for a clock down to 1 MHz
+#define SPIF_ASYNC_TRANSFER_TIMEOUT(size) std::chrono::milliseconds(100 + (size) / 100)
+
 
 #define IS_MEM_READY_MAX_RETRIES 10000
 
@@ -81,13 +99,15 @@ enum spif_default_instructions {
 // Mutex is used for some SPI Driver commands that must be done sequentially with no other commands in between
 // e.g. (1)Set Write Enable, (2)Program, (3)Wait Memory Ready
 SingletonPtr<PlatformMutex> SPIFBlockDevice::_mutex;
+SingletonPtr<PlatformMutex> SPIFBlockDevice::_write_mutex;
 
 //***********************
 // SPIF Block Device APIs
 //***********************
 SPIFBlockDevice::SPIFBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName csel, int freq)
     :
-    _spi(mosi, miso, sclk, csel, use_gpio_ssel), _prog_instruction(0), _erase_instruction(0),
+    _spi(mosi, miso, sclk, csel, use_gpio_ssel), _busy_suspend_inst(-1), _busy_resume_inst(-1),
+    _prog_instruction(0), _erase_instruction(0),
     _page_size_bytes(0), _init_ref_count(0), _is_initialized(false)
 {
     _address_size = SPIF_ADDR_SIZE_3_BYTES;
@@ -99,9 +119,15 @@ SPIFBlockDevice::SPIFBlockDevice(PinName mosi, PinName miso, PinName sclk, PinNa
 
     _sfdp_info.bptbl.device_size_bytes = 0;
     _sfdp_info.bptbl.legacy_erase_instruction = SPIF_INST_LEGACY_ERASE_DEFAULT;
+    _sfdp_info.bptbl.erase_suspend_inst = -1;
+    _sfdp_info.bptbl.erase_resume_inst = -1;
+    _sfdp_info.bptbl.program_suspend_inst = -1;
+    _sfdp_info.bptbl.program_resume_inst = -1;
     _sfdp_info.smptbl.regions_min_common_erase_size = 0;
     _sfdp_info.smptbl.region_cnt = 1;
     _sfdp_info.smptbl.region_erase_types_bitfld[0] = SFDP_ERASE_BITMASK_NONE;
+    _sfdp_cache.version = 0;
+    memset(_jedec_id, 0, sizeof(_jedec_id));
 
     // Set default read/erase instructions
     _read_instruction = SPIF_INST_READ_DEFAULT;
@@ -109,6 +135,11 @@ SPIFBlockDevice::SPIFBlockDevice(PinName mosi, PinName miso, PinName sclk, PinNa
     if (SPIF_BD_ERROR_OK != _spi_set_frequency(freq)) {
         tr_error("SPI Set Frequency Failed");
     }
+
+#if SPIF_ASYNC_TRANSFER
+    // DMA for the data phases, when the target has a free channel
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
 }
 
 int SPIFBlockDevice::init()
@@ -151,28 +182,41 @@ int SPIFBlockDevice::init()
 
     /**************************** Parse SFDP headers and tables ***********************************/
     {
+        Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader = callback(this, &SPIFBlockDevice::_spi_send_read_sfdp_command);
+        bool cached = false;
+
         _sfdp_info.bptbl.addr = 0x0;
         _sfdp_info.bptbl.size = 0;
         _sfdp_info.smptbl.addr = 0x0;
         _sfdp_info.smptbl.size = 0;
 
-        if (sfdp_parse_headers(callback(this, &SPIFBlockDevice::_spi_send_read_sfdp_command), _sfdp_info) < 0) {
+        // Tables from a previous init, or stored by the application, skip the SFDP discovery
+        if (0 == sfdp_cache_lookup(_sfdp_cache, _jedec_id, _sfdp_info)) {
+            sfdp_reader = callback(sfdp_cache_read, &_sfdp_cache);
+            cached = true;
+        } else if (sfdp_parse_headers(sfdp_reader, _sfdp_info) < 0) {
             tr_error("init - Parse SFDP Headers Failed");
             status = SPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
 
-        if (_sfdp_parse_basic_param_table(callback(this, &SPIFBlockDevice::_spi_send_read_sfdp_command), _sfdp_info) < 0) {
+        if (_sfdp_parse_basic_param_table(sfdp_reader, _sfdp_info) < 0) {
             tr_error("init - Parse Basic Param Table Failed");
+            _sfdp_cache.version = 0;
             status = SPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
 
-        if (sfdp_parse_sector_map_table(callback(this, &SPIFBlockDevice::_spi_send_read_sfdp_command), _sfdp_info) < 0) {
+        if (sfdp_parse_sector_map_table(sfdp_reader, _sfdp_info) < 0) {
             tr_error("init - Parse Sector Map Table Failed");
+            _sfdp_cache.version = 0;
             status = SPIF_BD_ERROR_PARSING_FAILED;
             goto exit_point;
         }
+
+        if (!cached) {
+            sfdp_cache_tables(sfdp_reader, _sfdp_info, _jedec_id, _sfdp_cache);
+        }
     }
 
     // Configure  BUS Mode to 1_1_1 for all commands other than Read
@@ -231,16 +275,26 @@ int SPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
     }
 
     int status = SPIF_BD_ERROR_OK;
+    bool suspended = false;
     tr_debug("Read - Inst: 0x%xh", _read_instruction);
     _mutex->lock();
 
-    // Set Dummy Cycles for Specific Read Command Mode
-    _dummy_and_mode_cycles = _read_dummy_and_mode_cycles;
+    // Reads take priority over an ongoing program or erase
+    status = _suspend_for_read(suspended);
 
-    status = _spi_send_read_command(_read_instruction, static_cast<uint8_t *>(buffer), addr, size);
+    if (status == SPIF_BD_ERROR_OK) {
+        // Set Dummy Cycles for Specific Read Command Mode
+        _dummy_and_mode_cycles = _read_dummy_and_mode_cycles;
 
-    // Set Dummy Cycles for all other command modes
-    _dummy_and_mode_cycles = _write_dummy_and_mode_cycles;
+        status = _spi_send_read_command(_read_instruction, static_cast<uint8_t *>(buffer), addr, size);
+
+        // Set Dummy Cycles for all other command modes
+        _dummy_and_mode_cycles = _write_dummy_and_mode_cycles;
+    }
+
+    if (suspended) {
+        _resume_after_read();
+    }
 
     _mutex->unlock();
     return status;
@@ -259,6 +313,8 @@ int SPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
 
     tr_debug("program - Buff: 0x%" PRIx32 "h, addr: %llu, size: %llu", (uint32_t)buffer, addr, size);
 
+    _write_mutex->lock();
+
     while (size > 0) {
 
         // Write on _page_size_bytes boundaries (Default 256 bytes a page)
@@ -275,13 +331,19 @@ int SPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
             goto exit_point;
         }
 
-        _spi_send_program_command(_prog_instruction, buffer, addr, chunk);
+        if (_spi_send_program_command(_prog_instruction, buffer, addr, chunk) != SPIF_BD_ERROR_OK) {
+            tr_error("Program data transfer failed");
+            program_failed = true;
+            status = SPIF_BD_ERROR_DEVICE_ERROR;
+            goto exit_point;
+        }
 
         buffer = static_cast<const uint8_t *>(buffer) + chunk;
         addr += chunk;
         size -= chunk;
 
-        if (false == _is_mem_ready()) {
+        if (false == _is_mem_ready_suspendable(_sfdp_info.bptbl.program_suspend_inst,
+                                               _sfdp_info.bptbl.program_resume_inst)) {
             tr_error("Device not ready after write, failed");
             program_failed = true;
             status = SPIF_BD_ERROR_READY_FAILED;
@@ -295,6 +357,8 @@ exit_point:
         _mutex->unlock();
     }
 
+    _write_mutex->unlock();
+
     return status;
 }
 
@@ -332,6 +396,8 @@ int SPIFBlockDevice::erase(bd_addr_t addr, bd_size_t in_size)
         return SPIF_BD_ERROR_INVALID_ERASE_PARAMS;
     }
 
+    _write_mutex->lock();
+
     // For each iteration erase the largest section supported by current region
     while (size > 0) {
 
@@ -368,7 +434,8 @@ int SPIFBlockDevice::erase(bd_addr_t addr, bd_size_t in_size)
             bitfield = _sfdp_info.smptbl.region_erase_types_bitfld[region];
         }
 
-        if (false == _is_mem_ready()) {
+        if (false == _is_mem_ready_suspendable(_sfdp_info.bptbl.erase_suspend_inst,
+                                               _sfdp_info.bptbl.erase_resume_inst)) {
             tr_error("SPI After Erase Device not ready - failed");
             erase_failed = true;
             status = SPIF_BD_ERROR_READY_FAILED;
@@ -383,6 +450,8 @@ exit_point:
         _mutex->unlock();
     }
 
+    _write_mutex->unlock();
+
     return status;
 }
 
@@ -454,6 +523,18 @@ const char *SPIFBlockDevice::get_type() const
     return "SPIF";
 }
 
+const mbed::sfdp_cache &SPIFBlockDevice::get_sfdp_cache() const
+{
+    return _sfdp_cache;
+}
+
+void SPIFBlockDevice::set_sfdp_cache(const mbed::sfdp_cache &cache)
+{
+    _mutex->lock();
+    _sfdp_cache = cache;
+    _mutex->unlock();
+}
+
 /***************************************************/
 /*********** SPI Driver API Functions **************/
 /***************************************************/
@@ -483,14 +564,12 @@ spif_bd_error SPIFBlockDevice::_spi_send_read_command(int read_inst, uint8_t *bu
         _spi.write(dummy_byte);
     }
 
-    // Read Data
-    for (bd_size_t i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    // Read Data, in a single burst
+    spif_bd_error status = _spi_data_transfer(NULL, buffer, size);
 
     _spi.deselect();
 
-    return SPIF_BD_ERROR_OK;
+    return status;
 }
 
 int SPIFBlockDevice::_spi_send_read_sfdp_command(bd_addr_t addr, void *rx_buffer, bd_size_t rx_length)
@@ -531,16 +610,43 @@ spif_bd_error SPIFBlockDevice::_spi_send_program_command(int prog_inst, const vo
         _spi.write(dummy_byte);
     }
 
-    // Write Data
-    for (bd_size_t i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    // Write Data, in a single burst
+    spif_bd_error status = _spi_data_transfer(data, NULL, size);
 
     _spi.deselect();
 
+    return status;
+}
+
+spif_bd_error SPIFBlockDevice::_spi_data_transfer(const uint8_t *tx_buffer, uint8_t *rx_buffer, bd_size_t size)
+{
+#if SPIF_ASYNC_TRANSFER
+    if (size >= SPIF_ASYNC_TRANSFER_MIN_SIZE) {
+        // Let the calling thread sleep, the selection is held across the transfer
+        if (0 == _spi.transfer_burst(tx_buffer, rx_buffer, (int)size,
+                                     callback(this, &SPIFBlockDevice::_spi_transfer_done), SPI_EVENT_COMPLETE)) {
+            if (!_transfer_done.try_acquire_for(SPIF_ASYNC_TRANSFER_TIMEOUT(size))) {
+                _spi.abort_transfer();
+                tr_error("Data transfer timed out");
+                return SPIF_BD_ERROR_DEVICE_ERROR;
+            }
+            return SPIF_BD_ERROR_OK;
+        }
+    }
+#endif
+
+    _spi.write(reinterpret_cast<const char *>(tx_buffer), tx_buffer ? (int)size : 0,
+               reinterpret_cast<char *>(rx_buffer), rx_buffer ? (int)size : 0);
     return SPIF_BD_ERROR_OK;
 }
 
+#if SPIF_ASYNC_TRANSFER
+void SPIFBlockDevice::_spi_transfer_done(int event)
+{
+    _transfer_done.release();
+}
+#endif
+
 spif_bd_error SPIFBlockDevice::_spi_send_erase_command(int erase_inst, bd_addr_t addr, bd_size_t size)
 {
     tr_debug("Erase Inst: 0x%xh, addr: %llu, size: %llu", erase_inst, addr, size);
@@ -623,6 +729,9 @@ int SPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void
 
     _erase_instruction = sfdp_info.bptbl.legacy_erase_instruction;
 
+    // Detect program/erase suspend and resume instructions, used to serve reads during long writes
+    sfdp_detect_suspend_resume(param_table, sfdp_info.bptbl);
+
     // Detect and Set fastest Bus mode (default 1-1-1)
     _sfdp_detect_best_bus_read_mode(param_table, sfdp_info.bptbl.size, _read_instruction);
 
@@ -632,12 +741,23 @@ int SPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void
 int SPIFBlockDevice::_sfdp_detect_best_bus_read_mode(uint8_t *basic_param_table_ptr, int basic_param_table_size,
                                                      int &read_inst)
 {
-    do {
+    uint8_t fast_read_support = 0;
+    if (basic_param_table_size > SPIF_BASIC_PARAM_TABLE_FAST_READ_SUPPORT_BYTE) {
+        fast_read_support = basic_param_table_ptr[SPIF_BASIC_PARAM_TABLE_FAST_READ_SUPPORT_BYTE];
+    }
 
-        // TBD - SPIF Dual Read Modes Require SPI driver support
-        _read_dummy_and_mode_cycles = 0;
-        tr_debug("Read Bus Mode set to 1-1-1, Instruction: 0x%xh", read_inst);
-    } while (false);
+    // Dual and quad modes clock data on IO lines a standard SPI bus doesn't have,
+    // they need a QSPI bus (see QSPIFBlockDevice)
+    if (fast_read_support & (SPIF_FAST_READ_112_SUPPORT_BIT | SPIF_FAST_READ_122_SUPPORT_BIT |
+                             SPIF_FAST_READ_144_SUPPORT_BIT | SPIF_FAST_READ_114_SUPPORT_BIT)) {
+        tr_debug("Device supports multi-line reads (0x%" PRIx8 "), not available on SPI", fast_read_support);
+    }
+
+    // Fast Read, from which the SFDP read is derived, runs at the full frequency of
+    // the device, while Read is limited to a lower one on most devices
+    read_inst = SPIF_INST_FAST_READ;
+    _read_dummy_and_mode_cycles = SPIF_FAST_READ_DUMMY_CYCLES;
+    tr_debug("Read Bus Mode set to 1-1-1, Instruction: 0x%xh", read_inst);
 
     return 0;
 }
@@ -710,6 +830,84 @@ bool SPIFBlockDevice::_is_mem_ready()
     return mem_ready;
 }
 
+bool SPIFBlockDevice::_is_mem_ready_suspendable(int suspend_inst, int resume_inst)
+{
+#if MBED_CONF_SPIF_DRIVER_SUSPEND_FOR_READ
+    if (suspend_inst < 0 || resume_inst < 0) {
+        return _is_mem_ready();
+    }
+
+    // Reads run between the polls, they suspend and resume the write before releasing the mutex
+    char status_value[2];
+    int retries = 0;
+    bool mem_ready = true;
+
+    _busy_suspend_inst = suspend_inst;
+    _busy_resume_inst = resume_inst;
+    do {
+        _mutex->unlock();
+        rtos::ThisThread::sleep_for(1);
+        _mutex->lock();
+        retries++;
+        //Read the Status Register from device
+        if (SPIF_BD_ERROR_OK != _spi_send_general_command(SPIF_RDSR, SPI_NO_ADDRESS_COMMAND, NULL, 0, status_value,
+                                                          1)) {   // store received values in status_value
+            tr_error("Reading Status Register failed");
+        }
+    } while ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0 && retries < IS_MEM_READY_MAX_RETRIES);
+    _busy_suspend_inst = -1;
+    _busy_resume_inst = -1;
+
+    if ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0) {
+        tr_error("_is_mem_ready_suspendable FALSE");
+        mem_ready = false;
+    }
+    return mem_ready;
+#else
+    return _is_mem_ready();
+#endif
+}
+
+int SPIFBlockDevice::_suspend_for_read(bool &suspended)
+{
+    char status_value[2] = {0};
+
+    suspended = false;
+    if (_busy_suspend_inst < 0) {
+        return SPIF_BD_ERROR_OK;
+    }
+
+    tr_debug("Suspend - Inst: 0x%xh", _busy_suspend_inst);
+    if (SPIF_BD_ERROR_OK != _spi_send_general_command(_busy_suspend_inst, SPI_NO_ADDRESS_COMMAND, NULL, 0, NULL, 0)) {
+        tr_error("Sending suspend command failed");
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    suspended = true;
+
+    // The busy bit clears once the write is suspended, or completed in the meantime
+    wait_us(_sfdp_info.bptbl.suspend_latency_us);
+    if (SPIF_BD_ERROR_OK != _spi_send_general_command(SPIF_RDSR, SPI_NO_ADDRESS_COMMAND, NULL, 0, status_value, 1)) {
+        tr_error("Reading Status Register failed");
+    }
+    if ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0 && false == _is_mem_ready()) {
+        tr_error("Device not ready after suspend, failed");
+        return SPIF_BD_ERROR_READY_FAILED;
+    }
+
+    return SPIF_BD_ERROR_OK;
+}
+
+void SPIFBlockDevice::_resume_after_read()
+{
+    tr_debug("Resume - Inst: 0x%xh", _busy_resume_inst);
+    if (SPIF_BD_ERROR_OK != _spi_send_general_command(_busy_resume_inst, SPI_NO_ADDRESS_COMMAND, NULL, 0, NULL, 0)) {
+        tr_error("Sending resume command failed");
+    }
+
+    // Let the write make progress before it can be suspended again
+    wait_us(_sfdp_info.bptbl.resume_to_suspend_us);
+}
+
 int SPIFBlockDevice::_set_write_enable()
 {
     // Check Status Register Busy Bit to Verify the Device isn't Busy
@@ -759,6 +957,7 @@ int SPIFBlockDevice::_handle_vendor_quirks()
     }
 
     tr_debug("Vendor device ID = 0x%x 0x%x 0x%x", vendor_device_ids[0], vendor_device_ids[1], vendor_device_ids[2]);
+    memcpy(_jedec_id, vendor_device_ids, sizeof(_jedec_id));
 
     switch (vendor_device_ids[0]) {
         case 0xbf:
@@ -21,6 +21,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -41,6 +42,11 @@ typedef uint64_t bd_addr_t;
  */
 typedef uint64_t bd_size_t;
 
+/** Type representing the completion callback of an asynchronous operation,
+ *  called with 0 on success or a negative error code on failure
+ */
+typedef mbed::Callback<void(int)> bd_callback_t;
+
 
 /** A hardware device capable of writing and reading blocks
  */
@@ -138,6 +144,65 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without blocking
+     *
+     *  The callback is called once the read has completed, possibly from
+     *  interrupt context. To handle the completion in a thread, pass a
+     *  callback that posts an event, for example
+     *  callback(&event, &Event<void(int)>::call).
+     *
+     *  Block devices without hardware support for asynchronous operations
+     *  perform the read before returning, and call the callback from the
+     *  calling thread.
+     *
+     *  @param buffer   Buffer to write blocks to, valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if the read was started, in which case the callback is
+     *                  called exactly once, or a negative error code otherwise
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(read(buffer, addr, size));
+        return 0;
+    }
+
+    /** Program blocks to a block device without blocking
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @see BlockDevice::read_async
+     *
+     *  @param buffer   Buffer of data to write to blocks, valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if programming was started, in which case the callback is
+     *                  called exactly once, or a negative error code otherwise
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(program(buffer, addr, size));
+        return 0;
+    }
+
+    /** Erase blocks on a block device without blocking
+     *
+     *  @see BlockDevice::read_async
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if erasing was started, in which case the callback is
+     *                  called exactly once, or a negative error code otherwise
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(erase(addr, size));
+        return 0;
+    }
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -234,6 +299,22 @@ public:
                    addr + size <= this->size());
     }
 
+    /** Get the address of the storage in the CPU address space
+     *
+     *  Memory-mapped block devices, such as the internal flash, can be read
+     *  directly through the returned pointer instead of a read. The contents
+     *  change as the storage is programmed or erased.
+     *
+     *  @param addr     Address of the storage to map
+     *  @param size     Size of the storage to map in bytes
+     *  @return         Pointer to the contents of the storage at addr, or NULL
+     *                  if the range is not mapped in the address space
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return NULL;
+    }
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -248,6 +329,7 @@ public:
 using mbed::BlockDevice;
 using mbed::bd_addr_t;
 using mbed::bd_size_t;
+using mbed::bd_callback_t;
 using mbed::BD_ERROR_OK;
 using mbed::BD_ERROR_DEVICE_ERROR;
 #endif
@@ -32,6 +32,11 @@ namespace mbed {
 
 /** Block device for allowing minimal read and program sizes (of 1) for the underlying BD,
  *  using a buffer on the heap.
+ *
+ *  By default a single program unit is buffered, and programmed as soon as it is complete.
+ *  Alternatively, a cache of several lines can be configured: the least recently used line
+ *  is evicted on a miss, and programs are only written back on eviction or sync(), which
+ *  merges small accesses into line sized transactions to the underlying BD.
  */
 class BufferedBlockDevice : public BlockDevice {
 public:
@@ -41,6 +46,15 @@ public:
      */
     BufferedBlockDevice(BlockDevice *bd);
 
+    /** Lifetime of a memory-buffered block device caching several lines of an underlying block device
+     *
+     *  @param bd           Block device to back the BufferedBlockDevice
+     *  @param cache_lines  Number of lines in the write-back cache
+     *  @param line_size    Size of a cache line, a multiple of the program and read sizes of bd
+     *                      dividing its size, or 0 for its erase size
+     */
+    BufferedBlockDevice(BlockDevice *bd, uint32_t cache_lines, bd_size_t line_size = 0);
+
     /** Lifetime of the memory-buffered block device
      */
     virtual ~BufferedBlockDevice();
@@ -159,6 +173,18 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Get number of cache line accesses served from the cache
+     *
+     *  @return The number of hits since init, 0 without a write-back cache
+     */
+    bd_size_t get_cache_hit_count() const;
+
+    /** Get number of cache line accesses requiring the underlying block device
+     *
+     *  @return The number of misses since init, 0 without a write-back cache
+     */
+    bd_size_t get_cache_miss_count() const;
+
 protected:
     BlockDevice *_bd;
     bd_size_t _bd_program_size;
@@ -171,6 +197,22 @@ protected:
     uint32_t _init_ref_count;
     bool _is_initialized;
 
+    struct cache_line_t {
+        bd_addr_t addr;
+        uint32_t last_use;
+        bool valid;
+        uint8_t *data;
+        uint8_t *dirty;
+    };
+    uint32_t _cache_lines;
+    bd_size_t _cache_line_size;
+    bd_size_t _cache_units;
+    cache_line_t *_cache;
+    uint8_t *_cache_buf;
+    uint32_t _cache_use;
+    bd_size_t _cache_hits;
+    bd_size_t _cache_misses;
+
 #if !(DOXYGEN_ONLY)
     /** Flush data in cache
      *
@@ -183,6 +225,40 @@ protected:
      *  @return         none
      */
     void invalidate_write_cache();
+
+    /** Get the cache line holding an address, evicting the least recently used one on a miss
+     *
+     *  @param line_addr Address of the line, aligned to the line size
+     *  @param fill      Whether to read the line from the underlying BD on a miss
+     *  @param line      The cache line
+     *  @return          0 on success or a negative error code on failure
+     */
+    int cache_get_line(bd_addr_t line_addr, bool fill, cache_line_t *&line);
+
+    /** Program the dirty program units of a cache line to the underlying BD
+     *
+     *  @param line      The cache line
+     *  @return          0 on success or a negative error code on failure
+     */
+    int cache_write_back(cache_line_t *line);
+
+    /** Read through the write-back cache
+     *
+     *  @return          0 on success or a negative error code on failure
+     */
+    int cache_read(uint8_t *buf, bd_addr_t addr, bd_size_t size);
+
+    /** Program through the write-back cache
+     *
+     *  @return          0 on success or a negative error code on failure
+     */
+    int cache_program(const uint8_t *buf, bd_addr_t addr, bd_size_t size);
+
+    /** Drop the cache lines in a range about to be erased, writing back the ones only partly in it
+     *
+     *  @return          0 on success or a negative error code on failure
+     */
+    int cache_invalidate(bd_addr_t addr, bd_size_t size);
 #endif //#if !(DOXYGEN_ONLY)
 };
 } // namespace mbed
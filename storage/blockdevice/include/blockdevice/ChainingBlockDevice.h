@@ -28,6 +28,7 @@
 
 #include "BlockDevice.h"
 #include "platform/mbed_assert.h"
+#include "rtos/Semaphore.h"
 #include <stdlib.h>
 
 namespace mbed {
@@ -35,6 +36,13 @@ namespace mbed {
 /** Block device for chaining multiple block devices
  *  with the similar block sizes at sequential addresses
  *
+ *  The block devices can also be striped, interleaved by erase blocks so
+ *  that large accesses are spread over all of them, or mirrored, holding the
+ *  same contents. In both layouts, the block devices are accessed in
+ *  parallel through their asynchronous operations (see BlockDevice::read_async),
+ *  which multiplies the bandwidth for block devices performing them in the
+ *  background, such as two QSPI flash chips.
+ *
  *  @code
  *  #include "mbed.h"
  *  #include "HeapBlockDevice.h"
@@ -53,23 +61,37 @@ namespace mbed {
  */
 class ChainingBlockDevice : public BlockDevice {
 public:
+    /** Layout of the chained block devices */
+    enum layout_t {
+        SEQUENTIAL,     /**< One after the other, the size being the sum of their sizes */
+        STRIPED,        /**< Erase blocks interleaved over the block devices, the size being
+                             their number times the smallest size */
+        MIRRORED,       /**< Same contents on every block device, the size being the smallest
+                             size. Reads fall back to the other block devices on failure */
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bds         Array of block devices to chain with sequential block addresses
      *  @param bd_count    Number of block devices to chain
-     *  @note All block devices must have the same block size
+     *  @param layout      Layout of the block devices
+     *  @note All block devices must have the same block size. Striped and
+     *        mirrored block devices must have uniform erase sizes
      */
-    ChainingBlockDevice(BlockDevice **bds, size_t bd_count);
+    ChainingBlockDevice(BlockDevice **bds, size_t bd_count, layout_t layout = SEQUENTIAL);
 
     /** Lifetime of the memory block device
      *
      *  @param bds          Array of block devices to chain with sequential block addresses
-     *  @note All block devices must have the same block size
+     *  @param layout       Layout of the block devices
+     *  @note All block devices must have the same block size. Striped and
+     *        mirrored block devices must have uniform erase sizes
      */
     template <size_t Size>
-    ChainingBlockDevice(BlockDevice * (&bds)[Size])
-        : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0]))
-        , _read_size(0), _program_size(0), _erase_size(0), _size(0),  _init_ref_count(0)
+    ChainingBlockDevice(BlockDevice * (&bds)[Size], layout_t layout = SEQUENTIAL)
+        : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0])), _layout(layout)
+        , _read_size(0), _program_size(0), _erase_size(0), _size(0)
+        , _erase_value(-1), _init_ref_count(0), _is_initialized(false), _request_error(0)
     {
     }
 
@@ -127,6 +149,50 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Read blocks from a block device without blocking
+     *
+     *  Requests spanning several block devices are performed before returning.
+     *  Mirrored reads are forwarded to the first block device.
+     *
+     *  @see BlockDevice::read_async
+     *
+     *  @param buffer   Buffer to read blocks into, valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if the read was started or a negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Program blocks to a block device without blocking
+     *
+     *  Requests spanning several block devices are performed before returning,
+     *  as are mirrored requests.
+     *
+     *  @see BlockDevice::program_async
+     *
+     *  @param buffer   Buffer of data to write to blocks, valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if programming was started or a negative error code on failure
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Erase blocks on a block device without blocking
+     *
+     *  Requests spanning several block devices are performed before returning,
+     *  as are mirrored requests.
+     *
+     *  @see BlockDevice::erase_async
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if erasing was started or a negative error code on failure
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -179,8 +245,28 @@ public:
     virtual const char *get_type() const;
 
 protected:
+    enum operation_t {
+        OPERATION_READ,
+        OPERATION_PROGRAM,
+        OPERATION_ERASE,
+    };
+
+    /** Find the block device of a striped address, and the address in it */
+    size_t stripe(bd_addr_t addr, bd_addr_t *bdaddr) const;
+
+    /** Start an asynchronous operation on a block device, completed by request_done */
+    int start_request(size_t bd, operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size);
+    void request_done(int err);
+
+    /** Perform an operation of the striped, or mirrored for reads, layout in parallel */
+    int interleave(operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Perform an operation on every mirrored block device in parallel */
+    int mirror(operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size);
+
     BlockDevice **_bds;
     size_t _bd_count;
+    layout_t _layout;
     bd_size_t _read_size;
     bd_size_t _program_size;
     bd_size_t _erase_size;
@@ -188,6 +274,8 @@ protected:
     int _erase_value;
     uint32_t _init_ref_count;
     bool _is_initialized;
+    volatile int _request_error;
+    rtos::Semaphore _request_done;
 };
 
 } // namespace mbed
@@ -150,6 +150,15 @@ public:
      */
     virtual bd_size_t size() const;
 
+    /** Get the address of the storage in the CPU address space
+     *
+     *  @param addr     Address of the storage to map
+     *  @param size     Size of the storage to map in bytes
+     *  @return         Pointer to the contents of the storage at addr, or NULL
+     *                  if the range is not mapped in the address space
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -0,0 +1,195 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_PRE_ERASE_BLOCK_DEVICE_H
+#define MBED_PRE_ERASE_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "platform/PlatformMutex.h"
+
+namespace mbed {
+
+/** Block device that erases trimmed blocks ahead of their reuse
+ *
+ *  PreEraseBlockDevice tracks which erase units of the underlying device
+ *  are erased and not programmed since. Erasing such a unit returns at
+ *  once, so a program that follows one isn't delayed by the erase.
+ *
+ *  Trimmed units are erased by erase_step, which is meant to be called from
+ *  idle time, for example from a low priority EventQueue.
+ *
+ *  The erased state is only known for erases done through this block
+ *  device since it was initialized, and only for devices with a uniform
+ *  erase size. The underlying device must not be written by other means
+ *  while it is initialized.
+ *
+ *  @note Synchronization level: Thread safe
+ */
+class PreEraseBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd       Block device to erase ahead
+     */
+    PreEraseBlockDevice(BlockDevice *bd);
+    virtual ~PreEraseBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  Units already erased aren't erased again.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use
+     *
+     *  The blocks are queued for erase_step, and the hint is passed to the
+     *  underlying block device.
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of the erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Erase a bounded part of the trimmed blocks
+     *
+     *  All other operations can be performed between the calls.
+     *
+     *  @param max_size Maximum size to erase in this call in bytes, at least
+     *                  one erase unit is erased if any is pending
+     *  @param done     If not NULL, set to true once no trimmed block is left
+     *  @return         0 on success or a negative error code on failure
+     */
+    int erase_step(bd_size_t max_size, bool *done = 0);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+private:
+    bool test(const uint32_t *map, bd_size_t unit) const;
+    bd_size_t mark(uint32_t *map, bd_size_t first, bd_size_t count, bool set);
+    int erase_units(bd_size_t first, bd_size_t count);
+
+    BlockDevice *_bd;
+    bd_size_t _erase_size;      // size of the tracked units, 0 when untracked
+    bd_size_t _units;
+    uint32_t *_erased;          // units erased and not programmed since
+    uint32_t *_pending;         // trimmed units waiting for erase_step
+    bd_size_t _pending_count;
+    bd_size_t _next_pending;    // where erase_step resumes
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+    PlatformMutex _mutex;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::PreEraseBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
@@ -27,14 +27,59 @@
 #define MBED_PROFILING_BLOCK_DEVICE_H
 
 #include "BlockDevice.h"
+#include "platform/mbed_stats.h"
 
 namespace mbed {
 
+/** Number of buckets of the operation size distribution */
+#define PROFILING_BD_SIZE_BUCKETS   16
+
+/** Number of buckets of the queue depth distribution */
+#define PROFILING_BD_DEPTH_BUCKETS  8
+
+/** Statistics of one kind of operation of a ProfilingBlockDevice
+ */
+struct profiling_bd_op_stats_t {
+    uint32_t count;                                 /**< Operations, including the failed ones */
+    uint32_t errors;                                /**< Failed operations */
+    uint64_t total_us;                              /**< Time spent in the operations */
+    mbed_stats_latency_t latency;                   /**< Histogram of the durations of the operations */
+    uint32_t size_bucket[PROFILING_BD_SIZE_BUCKETS];   /**< Count of operations of 2^n to 2^(n+1) - 1 bytes, the last bucket counts all the larger ones */
+};
+
+/** Record of one operation of a ProfilingBlockDevice trace
+ *
+ *  The records are 24 bytes with no padding, in the byte order of the target,
+ *  so they are streamed to a host as they are.
+ */
+struct profiling_bd_trace_t {
+    uint64_t addr;          /**< Address of the operation */
+    uint32_t size;          /**< Size of the operation in bytes */
+    uint32_t start_us;      /**< Start of the operation, on the microsecond ticker */
+    uint32_t duration_us;   /**< Duration of the operation */
+    uint8_t op;             /**< ProfilingBlockDevice::op_t of the operation */
+    uint8_t depth;          /**< Operations in progress when it started, itself included */
+    int16_t err;            /**< Result of the operation */
+};
 
 /** Block device for measuring storage operations of another block device
+ *
+ *  Besides the bytes read, programmed and erased, it records for each kind
+ *  of operation the distribution of the durations and sizes, the number of
+ *  operations in progress together, and optionally a trace of the operations
+ *  in a buffer given with set_trace_buffer().
  */
 class ProfilingBlockDevice : public BlockDevice {
 public:
+    /** Kinds of operations profiled
+     */
+    enum op_t {
+        OP_READ = 0,
+        OP_PROGRAM,
+        OP_ERASE,
+        OP_COUNT
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bd       Block device to back the ProfilingBlockDevice
@@ -142,6 +187,8 @@ public:
     virtual bd_size_t size() const;
 
     /** Reset the current profile counts to zero
+     *
+     *  The statistics and the records of the trace are cleared too.
      */
     void reset();
 
@@ -163,6 +210,54 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get the statistics of a kind of operation
+     *
+     *  @param op       Kind of operation
+     *  @param stats    Structure to fill
+     */
+    void get_op_stats(op_t op, profiling_bd_op_stats_t *stats) const;
+
+    /** Get the number of operations started with a number of operations in progress
+     *
+     *  @param depth    Operations in progress, the started one included, from 1.
+     *                  Depths of PROFILING_BD_DEPTH_BUCKETS and more are counted together
+     *  @return         Number of operations started at that depth
+     */
+    uint32_t get_queue_depth_count(uint32_t depth) const;
+
+    /** Get the largest number of operations in progress together
+     *
+     *  @return         The deepest queue seen
+     */
+    uint32_t get_max_queue_depth() const;
+
+    /** Record a trace of the operations
+     *
+     *  The operations are recorded until the buffer is full, the next ones are
+     *  counted by get_trace_dropped() until records are taken with read_trace().
+     *
+     *  @param buffer   Buffer of records, or NULL to stop tracing
+     *  @param count    Number of records of the buffer
+     */
+    void set_trace_buffer(profiling_bd_trace_t *buffer, size_t count);
+
+    /** Take the oldest records of the trace
+     *
+     *  The records can be written as they are to a host, for example through
+     *  a FileHandle of the console.
+     *
+     *  @param records  Buffer to copy the records to
+     *  @param count    Number of records of the buffer
+     *  @return         Number of records copied
+     */
+    size_t read_trace(profiling_bd_trace_t *records, size_t count);
+
+    /** Get the number of operations left out of the trace as its buffer was full
+     *
+     *  @return         Operations not recorded since the last reset
+     */
+    uint32_t get_trace_dropped() const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -170,10 +265,21 @@ public:
     virtual const char *get_type() const;
 
 private:
+    void op_end(op_t op, bd_addr_t addr, bd_size_t size, uint32_t start_us, uint32_t depth, int err);
+
     BlockDevice *_bd;
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    profiling_bd_op_stats_t _op_stats[OP_COUNT];
+    uint32_t _depth;
+    uint32_t _max_depth;
+    uint32_t _depth_count[PROFILING_BD_DEPTH_BUCKETS];
+    profiling_bd_trace_t *_trace;
+    size_t _trace_size;
+    size_t _trace_head;
+    size_t _trace_count;
+    uint32_t _trace_dropped;
 };
 
 } // namespace mbed
@@ -90,6 +90,18 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Read blocks from a block device without blocking
+     *
+     *  @see BlockDevice::read_async
+     *
+     *  @param buffer   Buffer to read blocks into, valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if the read was started or a negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
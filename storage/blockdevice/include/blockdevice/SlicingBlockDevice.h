@@ -100,6 +100,41 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Read blocks from a block device without blocking
+     *
+     *  @see BlockDevice::read_async
+     *
+     *  @param buffer   Buffer to read blocks into, valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if the read was started or a negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Program blocks to a block device without blocking
+     *
+     *  @see BlockDevice::program_async
+     *
+     *  @param buffer   Buffer of data to write to blocks, valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if programming was started or a negative error code on failure
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Erase blocks on a block device without blocking
+     *
+     *  @see BlockDevice::erase_async
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Called with 0 on success or a negative error code on failure
+     *  @return         0 if erasing was started or a negative error code on failure
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -145,6 +180,15 @@ public:
      */
     virtual bd_size_t size() const;
 
+    /** Get the address of the storage in the CPU address space
+     *
+     *  @param addr     Address of the storage to map
+     *  @param size     Size of the storage to map in bytes
+     *  @return         Pointer to the contents of the storage at addr, or NULL
+     *                  if the range is not mapped in the address space
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
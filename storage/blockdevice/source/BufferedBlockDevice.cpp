@@ -29,7 +29,17 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
 
 BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
     : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _write_cache_addr(0), _write_cache_valid(false),
-      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
+      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false), _cache_lines(0), _cache_line_size(0),
+      _cache_units(0), _cache(0), _cache_buf(0), _cache_use(0), _cache_hits(0), _cache_misses(0)
+{
+    MBED_ASSERT(_bd);
+}
+
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_lines, bd_size_t line_size)
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _write_cache_addr(0), _write_cache_valid(false),
+      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false), _cache_lines(cache_lines),
+      _cache_line_size(line_size), _cache_units(0), _cache(0), _cache_buf(0), _cache_use(0), _cache_hits(0),
+      _cache_misses(0)
 {
     MBED_ASSERT(_bd);
 }
@@ -56,6 +66,36 @@ int BufferedBlockDevice::init()
     _bd_program_size = _bd->get_program_size();
     _bd_size = _bd->size();
 
+    if (_cache_lines) {
+        if (!_cache_line_size) {
+            _cache_line_size = _bd->get_erase_size();
+        }
+        if (!_cache_line_size || (_cache_line_size % _bd_program_size) || (_cache_line_size % _bd_read_size) ||
+                (_bd_size % _cache_line_size)) {
+            core_util_atomic_decr_u32(&_init_ref_count, 1);
+            _bd->deinit();
+            return BD_ERROR_DEVICE_ERROR;
+        }
+
+        // Line data, followed by the dirty bitmaps with one bit per program unit
+        _cache_units = _cache_line_size / _bd_program_size;
+        bd_size_t dirty_size = (_cache_units + 7) / 8;
+        if (!_cache) {
+            _cache = new cache_line_t[_cache_lines];
+            _cache_buf = new uint8_t[_cache_lines * (_cache_line_size + dirty_size)];
+        }
+        for (uint32_t i = 0; i < _cache_lines; i++) {
+            _cache[i].valid = false;
+            _cache[i].last_use = 0;
+            _cache[i].data = _cache_buf + i * _cache_line_size;
+            _cache[i].dirty = _cache_buf + _cache_lines * _cache_line_size + i * dirty_size;
+            memset(_cache[i].dirty, 0, dirty_size);
+        }
+        _cache_use = 0;
+        _cache_hits = 0;
+        _cache_misses = 0;
+    }
+
     if (!_write_cache) {
         _write_cache = new uint8_t[_bd_program_size];
     }
@@ -92,6 +132,10 @@ int BufferedBlockDevice::deinit()
     _write_cache = 0;
     delete[] _read_buf;
     _read_buf = 0;
+    delete[] _cache;
+    _cache = 0;
+    delete[] _cache_buf;
+    _cache_buf = 0;
     _is_initialized = false;
     return _bd->deinit();
 }
@@ -130,6 +174,12 @@ int BufferedBlockDevice::sync()
     if (ret) {
         return ret;
     }
+    for (uint32_t i = 0; i < _cache_lines; i++) {
+        ret = cache_write_back(&_cache[i]);
+        if (ret) {
+            return ret;
+        }
+    }
     return _bd->sync();
 }
 
@@ -145,6 +195,10 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
+    if (_cache_lines) {
+        return cache_read(static_cast<uint8_t *>(b), addr, size);
+    }
+
     // Common case - no need to involve write cache or read buffer
     if (_bd->is_valid_read(addr, size) &&
             ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
@@ -202,6 +256,13 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     MBED_ASSERT(_write_cache);
 
+    if (_cache_lines) {
+        if (!is_valid_program(addr, size)) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        return cache_program(static_cast<const uint8_t *>(b), addr, size);
+    }
+
     int ret;
 
     bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
@@ -282,6 +343,10 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
         invalidate_write_cache();
     }
+    int ret = cache_invalidate(addr, size);
+    if (ret) {
+        return ret;
+    }
     return _bd->erase(addr, size);
 }
 
@@ -298,6 +363,10 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
     if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
         invalidate_write_cache();
     }
+    int ret = cache_invalidate(addr, size);
+    if (ret) {
+        return ret;
+    }
     return _bd->trim(addr, size);
 }
 
@@ -352,4 +421,173 @@ const char *BufferedBlockDevice::get_type() const
     return _bd->get_type();
 }
 
+bd_size_t BufferedBlockDevice::get_cache_hit_count() const
+{
+    return _cache_hits;
+}
+
+bd_size_t BufferedBlockDevice::get_cache_miss_count() const
+{
+    return _cache_misses;
+}
+
+int BufferedBlockDevice::cache_get_line(bd_addr_t line_addr, bool fill, cache_line_t *&line)
+{
+    cache_line_t *victim = &_cache[0];
+
+    for (uint32_t i = 0; i < _cache_lines; i++) {
+        if (_cache[i].valid && (_cache[i].addr == line_addr)) {
+            line = &_cache[i];
+            line->last_use = ++_cache_use;
+            _cache_hits++;
+            return 0;
+        }
+        // Prefer an unused line, otherwise the least recently used one
+        if (victim->valid && (!_cache[i].valid || (_cache_use - _cache[i].last_use > _cache_use - victim->last_use))) {
+            victim = &_cache[i];
+        }
+    }
+
+    _cache_misses++;
+    int ret = cache_write_back(victim);
+    if (ret) {
+        return ret;
+    }
+    victim->valid = false;
+
+    if (fill) {
+        ret = _bd->read(victim->data, line_addr, _cache_line_size);
+        if (ret) {
+            return ret;
+        }
+    }
+
+    victim->addr = line_addr;
+    victim->valid = true;
+    victim->last_use = ++_cache_use;
+    line = victim;
+    return 0;
+}
+
+int BufferedBlockDevice::cache_write_back(cache_line_t *line)
+{
+    if (!line->valid) {
+        return 0;
+    }
+
+    // Program each run of consecutive dirty units at once, leaving the clean ones untouched
+    bd_size_t unit = 0;
+    while (unit < _cache_units) {
+        if (!(line->dirty[unit / 8] & (1 << (unit % 8)))) {
+            unit++;
+            continue;
+        }
+        bd_size_t end = unit + 1;
+        while ((end < _cache_units) && (line->dirty[end / 8] & (1 << (end % 8)))) {
+            end++;
+        }
+        int ret = _bd->program(line->data + unit * _bd_program_size, line->addr + unit * _bd_program_size,
+                               (end - unit) * _bd_program_size);
+        if (ret) {
+            return ret;
+        }
+        unit = end;
+    }
+    memset(line->dirty, 0, (_cache_units + 7) / 8);
+    return 0;
+}
+
+int BufferedBlockDevice::cache_read(uint8_t *buf, bd_addr_t addr, bd_size_t size)
+{
+    while (size) {
+        bd_addr_t line_addr = addr - addr % _cache_line_size;
+        bd_size_t offs = addr - line_addr;
+        bd_size_t chunk = std::min(size, _cache_line_size - offs);
+        cache_line_t *line = 0;
+
+        for (uint32_t i = 0; i < _cache_lines; i++) {
+            if (_cache[i].valid && (_cache[i].addr == line_addr)) {
+                line = &_cache[i];
+                break;
+            }
+        }
+
+        int ret;
+        if (!line && !offs && (chunk == _cache_line_size)) {
+            // Whole lines not in the cache are read at once, without evicting anything
+            while (chunk + _cache_line_size <= size) {
+                bool cached = false;
+                for (uint32_t i = 0; i < _cache_lines; i++) {
+                    cached |= _cache[i].valid && (_cache[i].addr == line_addr + chunk);
+                }
+                if (cached) {
+                    break;
+                }
+                chunk += _cache_line_size;
+            }
+            _cache_misses += chunk / _cache_line_size;
+            ret = _bd->read(buf, addr, chunk);
+        } else {
+            // Smaller reads fill the line, serving the following sequential reads
+            ret = cache_get_line(line_addr, true, line);
+            if (!ret) {
+                memcpy(buf, line->data + offs, chunk);
+            }
+        }
+        if (ret) {
+            return ret;
+        }
+
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+int BufferedBlockDevice::cache_program(const uint8_t *buf, bd_addr_t addr, bd_size_t size)
+{
+    while (size) {
+        bd_addr_t line_addr = addr - addr % _cache_line_size;
+        bd_size_t offs = addr - line_addr;
+        bd_size_t chunk = std::min(size, _cache_line_size - offs);
+        cache_line_t *line;
+
+        // A line entirely overwritten needs no read
+        int ret = cache_get_line(line_addr, chunk != _cache_line_size, line);
+        if (ret) {
+            return ret;
+        }
+        memcpy(line->data + offs, buf, chunk);
+        for (bd_size_t unit = offs / _bd_program_size; unit <= (offs + chunk - 1) / _bd_program_size; unit++) {
+            line->dirty[unit / 8] |= 1 << (unit % 8);
+        }
+
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+int BufferedBlockDevice::cache_invalidate(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _cache_lines; i++) {
+        cache_line_t *line = &_cache[i];
+        if (!line->valid || (line->addr >= addr + size) || (line->addr + _cache_line_size <= addr)) {
+            continue;
+        }
+        // Data programmed outside of the range must survive
+        if ((line->addr < addr) || (line->addr + _cache_line_size > addr + size)) {
+            int ret = cache_write_back(line);
+            if (ret) {
+                return ret;
+            }
+        }
+        memset(line->dirty, 0, (_cache_units + 7) / 8);
+        line->valid = false;
+    }
+    return 0;
+}
+
 } // namespace mbed
@@ -20,10 +20,10 @@
 
 namespace mbed {
 
-ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count)
-    : _bds(bds), _bd_count(bd_count)
+ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count, layout_t layout)
+    : _bds(bds), _bd_count(bd_count), _layout(layout)
     , _read_size(0), _program_size(0), _erase_size(0), _size(0)
-    , _erase_value(-1), _init_ref_count(0), _is_initialized(false)
+    , _erase_value(-1), _init_ref_count(0), _is_initialized(false), _request_error(0)
 {
 }
 
@@ -35,6 +35,7 @@ static bool is_aligned(uint64_t x, uint64_t alignment)
 int ChainingBlockDevice::init()
 {
     int err;
+    bd_size_t min_size = 0;
     uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
 
     if (val != 1) {
@@ -85,7 +86,18 @@ int ChainingBlockDevice::init()
             _erase_value = -1;
         }
 
-        _size += _bds[i]->size();
+        bd_size_t size = _bds[i]->size();
+        _size += size;
+        if (i == 0 || size < min_size) {
+            min_size = size;
+        }
+    }
+
+    if (_layout == STRIPED) {
+        // Whole erase blocks of each block device
+        _size = (min_size / _erase_size) * _erase_size * _bd_count;
+    } else if (_layout == MIRRORED) {
+        _size = min_size;
     }
 
     _is_initialized = true;
@@ -148,6 +160,17 @@ int ChainingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
     uint8_t *buffer = static_cast<uint8_t *>(b);
 
+    if (_layout == MIRRORED) {
+        int err = interleave(OPERATION_READ, buffer, addr, size);
+        // Read from one block device after the other, until one succeeds
+        for (size_t i = 0; err && i < _bd_count; i++) {
+            err = _bds[i]->read(buffer, addr, size);
+        }
+        return err;
+    } else if (_layout == STRIPED) {
+        return interleave(OPERATION_READ, buffer, addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -186,6 +209,12 @@ int ChainingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     const uint8_t *buffer = static_cast<const uint8_t *>(b);
 
+    if (_layout == MIRRORED) {
+        return mirror(OPERATION_PROGRAM, const_cast<uint8_t *>(buffer), addr, size);
+    } else if (_layout == STRIPED) {
+        return interleave(OPERATION_PROGRAM, const_cast<uint8_t *>(buffer), addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -222,6 +251,12 @@ int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
+    if (_layout == MIRRORED) {
+        return mirror(OPERATION_ERASE, NULL, addr, size);
+    } else if (_layout == STRIPED) {
+        return interleave(OPERATION_ERASE, NULL, addr, size);
+    }
+
     // Find block devices containing blocks, may span multiple block devices
     for (size_t i = 0; i < _bd_count && size > 0; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -247,6 +282,123 @@ int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return 0;
 }
 
+int ChainingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_layout == STRIPED) {
+        // Forward requests within an erase block, others are performed in parallel before returning
+        bd_addr_t bdaddr;
+        if (addr % _erase_size + size <= _erase_size) {
+            return _bds[stripe(addr, &bdaddr)]->read_async(b, bdaddr, size, callback);
+        }
+        return BlockDevice::read_async(b, addr, size, callback);
+    } else if (_layout == MIRRORED) {
+        return _bds[0]->read_async(b, addr, size, callback);
+    }
+
+    // Forward requests within a single block device, others are split synchronously
+    bd_addr_t bdaddr = addr;
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_size_t bdsize = _bds[i]->size();
+
+        if (bdaddr < bdsize) {
+            if (bdaddr + size > bdsize) {
+                break;
+            }
+            return _bds[i]->read_async(b, bdaddr, size, callback);
+        }
+
+        bdaddr -= bdsize;
+    }
+
+    return BlockDevice::read_async(b, addr, size, callback);
+}
+
+int ChainingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_layout == STRIPED) {
+        // Forward requests within an erase block, others are performed in parallel before returning
+        bd_addr_t bdaddr;
+        if (addr % _erase_size + size <= _erase_size) {
+            return _bds[stripe(addr, &bdaddr)]->program_async(b, bdaddr, size, callback);
+        }
+        return BlockDevice::program_async(b, addr, size, callback);
+    } else if (_layout == MIRRORED) {
+        return BlockDevice::program_async(b, addr, size, callback);
+    }
+
+    // Forward requests within a single block device, others are split synchronously
+    bd_addr_t bdaddr = addr;
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_size_t bdsize = _bds[i]->size();
+
+        if (bdaddr < bdsize) {
+            if (bdaddr + size > bdsize) {
+                break;
+            }
+            return _bds[i]->program_async(b, bdaddr, size, callback);
+        }
+
+        bdaddr -= bdsize;
+    }
+
+    return BlockDevice::program_async(b, addr, size, callback);
+}
+
+int ChainingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_layout == STRIPED) {
+        // Forward requests within an erase block, others are performed in parallel before returning
+        bd_addr_t bdaddr;
+        if (addr % _erase_size + size <= _erase_size) {
+            return _bds[stripe(addr, &bdaddr)]->erase_async(bdaddr, size, callback);
+        }
+        return BlockDevice::erase_async(addr, size, callback);
+    } else if (_layout == MIRRORED) {
+        return BlockDevice::erase_async(addr, size, callback);
+    }
+
+    // Forward requests within a single block device, others are split synchronously
+    bd_addr_t bdaddr = addr;
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_size_t bdsize = _bds[i]->size();
+
+        if (bdaddr < bdsize) {
+            if (bdaddr + size > bdsize) {
+                break;
+            }
+            return _bds[i]->erase_async(bdaddr, size, callback);
+        }
+
+        bdaddr -= bdsize;
+    }
+
+    return BlockDevice::erase_async(addr, size, callback);
+}
+
 bd_size_t ChainingBlockDevice::get_read_size() const
 {
     return _read_size;
@@ -268,6 +420,10 @@ bd_size_t ChainingBlockDevice::get_erase_size(bd_addr_t addr) const
         return 0;
     }
 
+    if (_layout != SEQUENTIAL) {
+        return _erase_size;
+    }
+
     bd_addr_t bd_start_addr = 0;
     for (size_t i = 0; i < _bd_count; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -297,4 +453,103 @@ const char *ChainingBlockDevice::get_type() const
     return "CHAINING";
 }
 
+size_t ChainingBlockDevice::stripe(bd_addr_t addr, bd_addr_t *bdaddr) const
+{
+    bd_addr_t block = addr / _erase_size;
+    *bdaddr = (block / _bd_count) * _erase_size + addr % _erase_size;
+    return block % _bd_count;
+}
+
+int ChainingBlockDevice::start_request(size_t bd, operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+{
+    bd_callback_t done = mbed::callback(this, &ChainingBlockDevice::request_done);
+
+    if (op == OPERATION_READ) {
+        return _bds[bd]->read_async(buffer, addr, size, done);
+    } else if (op == OPERATION_PROGRAM) {
+        return _bds[bd]->program_async(buffer, addr, size, done);
+    } else {
+        return _bds[bd]->erase_async(addr, size, done);
+    }
+}
+
+// May be called in interrupt context
+void ChainingBlockDevice::request_done(int err)
+{
+    if (err) {
+        _request_error = err;
+    }
+    _request_done.release();
+}
+
+int ChainingBlockDevice::interleave(operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+{
+    while (size > 0) {
+        size_t started = 0;
+        int err = 0;
+        _request_error = 0;
+
+        // Up to an erase block on each block device at once, consecutive erase
+        // blocks being on different block devices
+        for (size_t i = 0; i < _bd_count && size > 0; i++) {
+            bd_size_t chunk = _erase_size - addr % _erase_size;
+            if (chunk > size) {
+                chunk = size;
+            }
+
+            size_t bd = i;
+            bd_addr_t bdaddr = addr;
+            if (_layout == STRIPED) {
+                bd = stripe(addr, &bdaddr);
+            }
+
+            err = start_request(bd, op, buffer, bdaddr, chunk);
+            if (err) {
+                break;
+            }
+            started++;
+
+            if (buffer) {
+                buffer += chunk;
+            }
+            addr += chunk;
+            size -= chunk;
+        }
+
+        for (; started > 0; started--) {
+            _request_done.acquire();
+        }
+
+        if (!err) {
+            err = _request_error;
+        }
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+int ChainingBlockDevice::mirror(operation_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+{
+    size_t started = 0;
+    int err = 0;
+    _request_error = 0;
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        err = start_request(i, op, buffer, addr, size);
+        if (err) {
+            break;
+        }
+        started++;
+    }
+
+    for (; started > 0; started--) {
+        _request_done.acquire();
+    }
+
+    return err ? err : _request_error;
+}
+
 } // namespace mbed
@@ -220,6 +220,15 @@ int FlashSimBlockDevice::get_erase_value() const
     return _erase_value;
 }
 
+const void *FlashSimBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized) {
+        return NULL;
+    }
+
+    return _bd->get_mapped_address(addr, size);
+}
+
 const char *FlashSimBlockDevice::get_type() const
 {
     if (_bd != NULL) {
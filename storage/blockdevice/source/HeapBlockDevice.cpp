@@ -182,6 +182,22 @@ int HeapBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return 0;
 }
 
+const void *HeapBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized || !size || addr + size > this->size()) {
+        return NULL;
+    }
+
+    // Only mapped within an erase unit already programmed, as these are allocated separately
+    bd_addr_t hi = addr / _erase_size;
+    bd_addr_t lo = addr % _erase_size;
+    if (!_blocks[hi] || lo + size > _erase_size) {
+        return NULL;
+    }
+
+    return &_blocks[hi][lo];
+}
+
 const char *HeapBlockDevice::get_type() const
 {
     return "HEAP";
@@ -373,6 +373,45 @@ int MBRBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _offset, size);
 }
 
+int MBRBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->read_async(b, addr + _offset, size, callback);
+}
+
+int MBRBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->program_async(b, addr + _offset, size, callback);
+}
+
+int MBRBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->erase_async(addr + _offset, size, callback);
+}
+
 bd_size_t MBRBlockDevice::get_read_size() const
 {
     if (!_is_initialized) {
@@ -0,0 +1,327 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "blockdevice/PreEraseBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include <new>
+
+namespace mbed {
+
+PreEraseBlockDevice::PreEraseBlockDevice(BlockDevice *bd)
+    : _bd(bd), _erase_size(0), _units(0), _erased(0), _pending(0), _pending_count(0), _next_pending(0),
+      _init_ref_count(0), _is_initialized(false)
+{
+    MBED_ASSERT(_bd);
+}
+
+PreEraseBlockDevice::~PreEraseBlockDevice()
+{
+    deinit();
+}
+
+int PreEraseBlockDevice::init()
+{
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        core_util_atomic_decr_u32(&_init_ref_count, 1);
+        return err;
+    }
+
+    _mutex.lock();
+    // only devices with a uniform erase size are tracked
+    bd_size_t size = _bd->size();
+    _erase_size = _bd->get_erase_size();
+    bool uniform = _erase_size && (size % _erase_size == 0);
+    for (bd_addr_t addr = 0; uniform && addr < size; addr += _erase_size) {
+        uniform = (_bd->get_erase_size(addr) == _erase_size);
+    }
+
+    _units = 0;
+    if (uniform) {
+        bd_size_t words = (size / _erase_size + 31) / 32;
+        _erased = new (std::nothrow) uint32_t[2 * words]();
+        if (_erased) {
+            _pending = _erased + words;
+            _units = size / _erase_size;
+        }
+    }
+    if (!_units) {
+        _erase_size = 0;
+    }
+    _pending_count = 0;
+    _next_pending = 0;
+    _is_initialized = true;
+    _mutex.unlock();
+
+    return BD_ERROR_OK;
+}
+
+int PreEraseBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    _mutex.lock();
+    delete[] _erased;
+    _erased = 0;
+    _pending = 0;
+    _units = 0;
+    _erase_size = 0;
+    _is_initialized = false;
+    _mutex.unlock();
+
+    return _bd->deinit();
+}
+
+int PreEraseBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->sync();
+}
+
+int PreEraseBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    int err = _bd->read(buffer, addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int PreEraseBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    if (_erase_size && size) {
+        // even a failed program leaves the units programmed in part
+        bd_size_t first = addr / _erase_size;
+        bd_size_t count = (addr + size - 1) / _erase_size - first + 1;
+        mark(_erased, first, count, false);
+        _pending_count -= mark(_pending, first, count, false);
+    }
+    int err = _bd->program(buffer, addr, size);
+    _mutex.unlock();
+    return err;
+}
+
+int PreEraseBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    if (!_erase_size) {
+        int err = _bd->erase(addr, size);
+        _mutex.unlock();
+        return err;
+    }
+
+    // erase the runs of units that aren't erased yet
+    bd_size_t unit = addr / _erase_size;
+    bd_size_t end = (addr + size) / _erase_size;
+    while (unit < end) {
+        if (test(_erased, unit)) {
+            unit++;
+            continue;
+        }
+
+        bd_size_t count = 1;
+        while (unit + count < end && !test(_erased, unit + count)) {
+            count++;
+        }
+
+        int err = erase_units(unit, count);
+        if (err) {
+            _mutex.unlock();
+            return err;
+        }
+        unit += count;
+    }
+    _mutex.unlock();
+
+    return BD_ERROR_OK;
+}
+
+int PreEraseBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    int err = _bd->trim(addr, size);
+    if (!err && _erase_size) {
+        for (bd_size_t unit = addr / _erase_size; unit < (addr + size) / _erase_size; unit++) {
+            if (!test(_erased, unit)) {
+                _pending_count += mark(_pending, unit, 1, true);
+            }
+        }
+    }
+    _mutex.unlock();
+
+    return err;
+}
+
+int PreEraseBlockDevice::erase_step(bd_size_t max_size, bool *done)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    bd_size_t budget = _erase_size ? max_size / _erase_size : 0;
+    if (!budget) {
+        budget = 1;
+    }
+
+    // resumes where the previous step stopped, runs are erased at once
+    bd_size_t unit = _next_pending;
+    while (_pending_count && budget) {
+        if (unit >= _units) {
+            unit = 0;
+        }
+
+        if (!test(_pending, unit)) {
+            unit++;
+            continue;
+        }
+
+        bd_size_t count = 1;
+        while (count < budget && unit + count < _units && test(_pending, unit + count)) {
+            count++;
+        }
+
+        int err = erase_units(unit, count);
+        if (err) {
+            _next_pending = unit;
+            _mutex.unlock();
+            return err;
+        }
+        budget -= count;
+        unit += count;
+    }
+    _next_pending = unit;
+
+    if (done) {
+        *done = !_pending_count;
+    }
+    _mutex.unlock();
+
+    return BD_ERROR_OK;
+}
+
+bd_size_t PreEraseBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t PreEraseBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t PreEraseBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t PreEraseBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int PreEraseBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t PreEraseBlockDevice::size() const
+{
+    return _bd->size();
+}
+
+const char *PreEraseBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+bool PreEraseBlockDevice::test(const uint32_t *map, bd_size_t unit) const
+{
+    return map[unit / 32] & (1UL << (unit % 32));
+}
+
+bd_size_t PreEraseBlockDevice::mark(uint32_t *map, bd_size_t first, bd_size_t count, bool set)
+{
+    bd_size_t changed = 0;
+    for (bd_size_t unit = first; unit < first + count && unit < _units; unit++) {
+        if (test(map, unit) != set) {
+            map[unit / 32] ^= 1UL << (unit % 32);
+            changed++;
+        }
+    }
+    return changed;
+}
+
+int PreEraseBlockDevice::erase_units(bd_size_t first, bd_size_t count)
+{
+    int err = _bd->erase(first * _erase_size, count * _erase_size);
+    if (err) {
+        return err;
+    }
+
+    mark(_erased, first, count, true);
+    _pending_count -= mark(_pending, first, count, false);
+    return BD_ERROR_OK;
+}
+
+} // namespace mbed
@@ -15,16 +15,46 @@
  */
 
 #include "blockdevice/ProfilingBlockDevice.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 #include "stddef.h"
+#include <string.h>
 
 namespace mbed {
 
+static_assert(sizeof(profiling_bd_trace_t) == 24, "profiling_bd_trace_t must not be padded");
+
+static uint32_t profiling_now_us()
+{
+#if DEVICE_USTICKER
+    return us_ticker_read();
+#else
+    return 0;
+#endif
+}
+
+/* Bucket n counts the values of 2^n to 2^(n+1) - 1, the last one also the larger values */
+static unsigned profiling_bucket(uint64_t value, unsigned buckets)
+{
+    unsigned bucket = 0;
+    while ((value >> (bucket + 1)) != 0 && bucket < buckets - 1) {
+        bucket++;
+    }
+    return bucket;
+}
+
 ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     : _bd(bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
+    , _depth(0)
+    , _trace(NULL)
+    , _trace_size(0)
 {
+    reset();
 }
 
 int ProfilingBlockDevice::init()
@@ -44,7 +74,10 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_depth, 1);
+    uint32_t start_us = profiling_now_us();
     int err = _bd->read(b, addr, size);
+    op_end(OP_READ, addr, size, start_us, depth, err);
     if (!err) {
         _read_count += size;
     }
@@ -53,7 +86,10 @@ int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_depth, 1);
+    uint32_t start_us = profiling_now_us();
     int err = _bd->program(b, addr, size);
+    op_end(OP_PROGRAM, addr, size, start_us, depth, err);
     if (!err) {
         _program_count += size;
     }
@@ -62,7 +98,10 @@ int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    uint32_t depth = core_util_atomic_incr_u32(&_depth, 1);
+    uint32_t start_us = profiling_now_us();
     int err = _bd->erase(addr, size);
+    op_end(OP_ERASE, addr, size, start_us, depth, err);
     if (!err) {
         _erase_count += size;
     }
@@ -99,11 +138,60 @@ bd_size_t ProfilingBlockDevice::size() const
     return _bd->size();
 }
 
+void ProfilingBlockDevice::op_end(op_t op, bd_addr_t addr, bd_size_t size, uint32_t start_us, uint32_t depth, int err)
+{
+    uint32_t duration_us = profiling_now_us() - start_us;
+    core_util_atomic_decr_u32(&_depth, 1);
+
+    core_util_critical_section_enter();
+    profiling_bd_op_stats_t *stats = &_op_stats[op];
+    stats->count++;
+    if (err) {
+        stats->errors++;
+    }
+    stats->total_us += duration_us;
+    stats->latency.bucket[profiling_bucket(duration_us, MBED_STATS_LATENCY_BUCKETS)]++;
+    if (duration_us > stats->latency.max_us) {
+        stats->latency.max_us = duration_us;
+    }
+    stats->size_bucket[profiling_bucket(size, PROFILING_BD_SIZE_BUCKETS)]++;
+
+    _depth_count[(depth < PROFILING_BD_DEPTH_BUCKETS ? depth : PROFILING_BD_DEPTH_BUCKETS) - 1]++;
+    if (depth > _max_depth) {
+        _max_depth = depth;
+    }
+
+    if (_trace != NULL) {
+        if (_trace_count < _trace_size) {
+            profiling_bd_trace_t *record = &_trace[(_trace_head + _trace_count) % _trace_size];
+            record->addr = addr;
+            record->size = (uint32_t)size;
+            record->start_us = start_us;
+            record->duration_us = duration_us;
+            record->op = (uint8_t)op;
+            record->depth = (uint8_t)(depth < 0xFF ? depth : 0xFF);
+            record->err = (int16_t)err;
+            _trace_count++;
+        } else {
+            _trace_dropped++;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
 void ProfilingBlockDevice::reset()
 {
+    core_util_critical_section_enter();
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(_op_stats, 0, sizeof(_op_stats));
+    _max_depth = 0;
+    memset(_depth_count, 0, sizeof(_depth_count));
+    _trace_head = 0;
+    _trace_count = 0;
+    _trace_dropped = 0;
+    core_util_critical_section_exit();
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -121,6 +209,55 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
     return _erase_count;
 }
 
+void ProfilingBlockDevice::get_op_stats(op_t op, profiling_bd_op_stats_t *stats) const
+{
+    MBED_ASSERT(op < OP_COUNT);
+    core_util_critical_section_enter();
+    *stats = _op_stats[op];
+    core_util_critical_section_exit();
+}
+
+uint32_t ProfilingBlockDevice::get_queue_depth_count(uint32_t depth) const
+{
+    if (depth == 0) {
+        return 0;
+    }
+    return _depth_count[(depth < PROFILING_BD_DEPTH_BUCKETS ? depth : PROFILING_BD_DEPTH_BUCKETS) - 1];
+}
+
+uint32_t ProfilingBlockDevice::get_max_queue_depth() const
+{
+    return _max_depth;
+}
+
+void ProfilingBlockDevice::set_trace_buffer(profiling_bd_trace_t *buffer, size_t count)
+{
+    core_util_critical_section_enter();
+    _trace = count ? buffer : NULL;
+    _trace_size = _trace ? count : 0;
+    _trace_head = 0;
+    _trace_count = 0;
+    core_util_critical_section_exit();
+}
+
+size_t ProfilingBlockDevice::read_trace(profiling_bd_trace_t *records, size_t count)
+{
+    size_t copied = 0;
+    core_util_critical_section_enter();
+    while (copied < count && _trace_count > 0) {
+        records[copied++] = _trace[_trace_head];
+        _trace_head = (_trace_head + 1) % _trace_size;
+        _trace_count--;
+    }
+    core_util_critical_section_exit();
+    return copied;
+}
+
+uint32_t ProfilingBlockDevice::get_trace_dropped() const
+{
+    return _trace_dropped;
+}
+
 const char *ProfilingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
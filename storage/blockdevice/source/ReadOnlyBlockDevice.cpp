@@ -59,6 +59,11 @@ int ReadOnlyBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
     return _bd->read(buffer, addr, size);
 }
 
+int ReadOnlyBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    return _bd->read_async(buffer, addr, size, callback);
+}
+
 int ReadOnlyBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
 {
     return MBED_ERROR_WRITE_PROTECTED;
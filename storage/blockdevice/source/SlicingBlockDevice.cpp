@@ -105,6 +105,30 @@ int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _start, size);
 }
 
+int SlicingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->read_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->program_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->erase_async(addr + _start, size, callback);
+}
+
 bool SlicingBlockDevice::is_valid_read(bd_addr_t addr, bd_size_t size) const
 {
     return _bd->is_valid_read(_start + addr, size) && _start + addr + size <= _stop;
@@ -150,6 +174,14 @@ bd_size_t SlicingBlockDevice::size() const
     return _stop - _start;
 }
 
+const void *SlicingBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (_start + addr + size > _stop) {
+        return NULL;
+    }
+    return _bd->get_mapped_address(_start + addr, size);
+}
+
 const char *SlicingBlockDevice::get_type() const
 {
     return _bd->get_type();
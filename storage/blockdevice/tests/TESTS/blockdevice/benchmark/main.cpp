@@ -0,0 +1,209 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Throughput of the block devices of the target.
+ *
+ * Every device erases, programs and reads an area of BENCHMARK_BLOCKS erase
+ * blocks from its start, sequentially and at random addresses, in chunks of
+ * each size of CHUNK_SIZES, and reports the timings to the benchmark_auto host
+ * test. The heap block device gives the cost of the block device layer alone.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "utest/utest_benchmark.h"
+#include "BlockDevice.h"
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+
+#if COMPONENT_FLASHIAP
+#include "FlashIAPBlockDevice.h"
+#endif
+
+using namespace utest::v1;
+
+#define BENCHMARK_BLOCKS    8
+#define HEAP_BLOCK_SIZE     4096
+
+#define MAX_CHUNK_SIZE      4096
+
+static const bd_size_t CHUNK_SIZES[] = {256, MAX_CHUNK_SIZE};
+
+static BlockDevice *bd;
+static uint8_t *buffer;
+static bd_size_t chunk;
+static bd_size_t area_size;
+static bd_addr_t next_addr;
+static int bd_status;
+
+static void sequential_read()
+{
+    bd_status |= bd->read(buffer, next_addr, chunk);
+    next_addr = (next_addr + chunk) % area_size;
+}
+
+static void random_read()
+{
+    bd_addr_t addr = (rand() % (area_size / chunk)) * chunk;
+    bd_status |= bd->read(buffer, addr, chunk);
+}
+
+static void sequential_program()
+{
+    bd_status |= bd->program(buffer, next_addr, chunk);
+    next_addr += chunk;
+}
+
+static void random_program()
+{
+    // Each chunk of the area once, in a shuffled order
+    static const uint32_t step = 7;
+    uint32_t chunks = area_size / chunk;
+    bd_addr_t addr = ((next_addr / chunk * step) % chunks) * chunk;
+    bd_status |= bd->program(buffer, addr, chunk);
+    next_addr += chunk;
+}
+
+static void erase_block()
+{
+    bd_size_t erase_size = bd->get_erase_size(next_addr);
+    bd_status |= bd->erase(next_addr, erase_size);
+    next_addr += erase_size;
+}
+
+static void report(const char *operation, bd_size_t size, uint32_t runs, Callback<void()> body)
+{
+    char name[48];
+    snprintf(name, sizeof(name), "%s_%s_%lu", bd->get_type(), operation, (unsigned long)size);
+
+    const benchmark_t benchmark = { name, runs, 0, (size_t)size };
+    next_addr = 0;
+    bd_status = 0;
+    benchmark_result_t result = benchmark_run(benchmark, body);
+    TEST_ASSERT_EQUAL(0, bd_status);
+    TEST_ASSERT_EQUAL(runs, result.iterations);
+    TEST_ASSERT_TRUE(benchmark_report(benchmark, result));
+}
+
+static void erase_area()
+{
+    next_addr = 0;
+    while (next_addr < area_size) {
+        erase_block();
+    }
+    TEST_ASSERT_EQUAL(0, bd_status);
+}
+
+static void benchmark_block_device(BlockDevice *device)
+{
+    bd = device;
+    TEST_ASSERT_EQUAL(0, bd->init());
+
+    bd_size_t erase_size = bd->get_erase_size(0);
+    area_size = BENCHMARK_BLOCKS * erase_size;
+    TEST_SKIP_UNLESS_MESSAGE(area_size <= bd->size(), "Block device too small");
+
+    buffer = new (std::nothrow) uint8_t[MAX_CHUNK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "Not enough heap");
+    memset(buffer, 0x55, MAX_CHUNK_SIZE);
+
+    bd_status = 0;
+    erase_area();
+    report("erase", erase_size, BENCHMARK_BLOCKS, erase_block);
+
+    for (size_t i = 0; i < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); i++) {
+        // Whole read and program units, in the erase blocks
+        chunk = CHUNK_SIZES[i];
+        bd_size_t unit = bd->get_program_size() > bd->get_read_size() ? bd->get_program_size() : bd->get_read_size();
+        if (chunk % unit || erase_size % chunk) {
+            continue;
+        }
+        uint32_t chunks = area_size / chunk;
+
+        erase_area();
+        report("seq_program", chunk, chunks, sequential_program);
+        report("seq_read", chunk, chunks, sequential_read);
+        report("rand_read", chunk, chunks, random_read);
+        if (chunks % 7) {
+            erase_area();
+            report("rand_program", chunk, chunks, random_program);
+        }
+    }
+
+    delete[] buffer;
+    TEST_ASSERT_EQUAL(0, bd->deinit());
+}
+
+void test_default_block_device()
+{
+    BlockDevice *device = BlockDevice::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(device != NULL, "No default block device");
+    benchmark_block_device(device);
+}
+
+#if COMPONENT_FLASHIAP
+static inline uint32_t align_up(uint32_t val, uint32_t size)
+{
+    return (((val - 1) / size) + 1) * size;
+}
+
+void test_flashiap_block_device()
+{
+#if (MBED_CONF_FLASHIAP_BLOCK_DEVICE_SIZE == 0) && (MBED_CONF_FLASHIAP_BLOCK_DEVICE_BASE_ADDRESS == 0xFFFFFFFF)
+    mbed::FlashIAP flash;
+    TEST_ASSERT_EQUAL(0, flash.init());
+    // The sectors after the application
+    uint32_t bottom_address = align_up(FLASHIAP_APP_ROM_END_ADDR, flash.get_sector_size(FLASHIAP_APP_ROM_END_ADDR));
+    uint32_t end_address = flash.get_flash_start() + flash.get_flash_size();
+    TEST_ASSERT_EQUAL(0, flash.deinit());
+
+    FlashIAPBlockDevice device(bottom_address, end_address - bottom_address);
+#else
+    FlashIAPBlockDevice device;
+#endif
+    benchmark_block_device(&device);
+}
+#endif
+
+void test_heap_block_device()
+{
+    HeapBlockDevice device(BENCHMARK_BLOCKS * HEAP_BLOCK_SIZE, 1, 1, HEAP_BLOCK_SIZE);
+    benchmark_block_device(&device);
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(300, "benchmark_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Heap block device throughput", test_heap_block_device),
+    Case("Default block device throughput", test_default_block_device),
+#if COMPONENT_FLASHIAP
+    Case("FlashIAP block device throughput", test_flashiap_block_device),
+#endif
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -686,6 +686,63 @@ void test_unaligned_erase_blocks()
     TEST_ASSERT_EQUAL(0, err);
 }
 
+#if defined(MBED_CONF_RTOS_PRESENT)
+static Semaphore async_done;
+static volatile int async_result;
+
+static void async_callback(int err)
+{
+    async_result = err;
+    async_done.release();
+}
+
+static int async_wait()
+{
+    TEST_ASSERT_TRUE(async_done.try_acquire_for(std::chrono::seconds(10)));
+    return async_result;
+}
+
+void test_async_erase_program_read()
+{
+    utest_printf("\nTest asynchronous erase, program and read..\n");
+
+    TEST_SKIP_UNLESS_MESSAGE(block_device != NULL, "no block device found.");
+
+    bd_addr_t addr = sectors_addr[rand() % num_of_sectors];
+    bd_size_t erase_size = block_device->get_erase_size(addr);
+    bd_size_t prog_size = block_device->get_program_size();
+    uint8_t *prog = (uint8_t *) malloc(prog_size);
+    TEST_SKIP_UNLESS_MESSAGE(prog != NULL, "Not enough memory for test");
+    uint8_t *buf = (uint8_t *) malloc(prog_size);
+    TEST_SKIP_UNLESS_MESSAGE(buf != NULL, "Not enough memory for test");
+
+    for (bd_size_t i = 0; i < prog_size; i++) {
+        prog[i] = rand() & 0xff;
+    }
+
+    int err = block_device->erase_async(addr, erase_size, async_callback);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(0, async_wait());
+
+    err = block_device->program_async(prog, addr, prog_size, async_callback);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(0, async_wait());
+
+    err = block_device->read_async(buf, addr, prog_size, async_callback);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(0, async_wait());
+    TEST_ASSERT_EQUAL(0, memcmp(prog, buf, prog_size));
+
+    // Invalid requests are not started
+    err = block_device->erase_async(addr + 1, erase_size, async_callback);
+    TEST_ASSERT_NOT_EQUAL(0, err);
+    TEST_ASSERT_FALSE(async_done.try_acquire());
+
+    free(prog);
+    free(buf);
+}
+#endif
+
 void test_deinit_bd()
 {
     utest_printf("\nTest deinit block device.\n");
@@ -780,6 +837,9 @@ template_case_t template_cases[] = {
     {"Testing BlockDevice erase functionality", test_erase_functionality, greentea_failure_handler},
     {"Testing program read small data sizes", test_program_read_small_data_sizes, greentea_failure_handler},
     {"Testing unaligned erase blocks", test_unaligned_erase_blocks, greentea_failure_handler},
+#if defined(MBED_CONF_RTOS_PRESENT)
+    {"Testing asynchronous erase, program and read", test_async_erase_program_read, greentea_failure_handler},
+#endif
     {"Testing Deinit block device", test_deinit_bd, greentea_failure_handler},
 };
 
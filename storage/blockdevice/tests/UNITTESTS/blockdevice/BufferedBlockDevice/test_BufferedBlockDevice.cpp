@@ -316,3 +316,119 @@ TEST_F(BufferedBlockModuleTest, flush_automatically)
     .Times(1)
     .WillOnce(Return(BD_ERROR_OK));
 }
+
+#define UNIT_SIZE (16)
+#define LINE_SIZE (UNIT_SIZE*4)
+#define CACHE_DEVICE_SIZE (LINE_SIZE*16)
+
+class BufferedBlockCacheTest : public testing::Test {
+protected:
+    BlockDeviceMock bd_mock;
+    BufferedBlockDevice bd{&bd_mock, 2, LINE_SIZE};
+    uint8_t magic[LINE_SIZE * 2];
+    uint8_t buf[LINE_SIZE * 2];
+    virtual void SetUp()
+    {
+        EXPECT_CALL(bd_mock, init());
+        EXPECT_CALL(bd_mock, get_read_size()).WillOnce(Return(UNIT_SIZE));
+        EXPECT_CALL(bd_mock, get_program_size()).WillOnce(Return(UNIT_SIZE));
+        EXPECT_CALL(bd_mock, size()).WillOnce(Return(CACHE_DEVICE_SIZE));
+        ASSERT_EQ(bd.init(), 0);
+        for (int i = 0; i < LINE_SIZE * 2; i++) {
+            magic[i] = 0xaa + i;
+            buf[i] = 0;
+        }
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_CALL(bd_mock, deinit());
+        EXPECT_CALL(bd_mock, sync()); // Called on deinit
+        ASSERT_EQ(bd.deinit(), 0);
+    }
+};
+
+TEST_F(BufferedBlockCacheTest, small_reads_fill_line)
+{
+    EXPECT_CALL(bd_mock, read(_, LINE_SIZE, LINE_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, LINE_SIZE), Return(BD_ERROR_OK)));
+
+    for (int i = 0; i < LINE_SIZE; i += 8) {
+        EXPECT_EQ(bd.read(buf + i, LINE_SIZE + i, 8), 0);
+    }
+    EXPECT_EQ(0, memcmp(buf, magic, LINE_SIZE));
+    EXPECT_EQ(bd.get_cache_miss_count(), 1);
+    EXPECT_EQ(bd.get_cache_hit_count(), LINE_SIZE / 8 - 1);
+}
+
+TEST_F(BufferedBlockCacheTest, big_read_bypasses_cache)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, LINE_SIZE * 2))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, LINE_SIZE * 2), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(bd.read(buf, 0, LINE_SIZE * 2), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, LINE_SIZE * 2));
+    EXPECT_EQ(bd.get_cache_miss_count(), 2);
+}
+
+TEST_F(BufferedBlockCacheTest, write_back_on_sync)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, LINE_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, LINE_SIZE), Return(BD_ERROR_OK)));
+
+    // Units 0 and 1 are dirty, 2 is clean and 3 is partly programmed
+    EXPECT_EQ(bd.program(magic, 0, UNIT_SIZE), 0);
+    EXPECT_EQ(bd.program(magic + UNIT_SIZE, UNIT_SIZE, 1), 0);
+    EXPECT_EQ(bd.program("a", UNIT_SIZE * 3 + 2, 1), 0);
+    EXPECT_EQ(bd.read(buf, 0, LINE_SIZE), 0);
+    EXPECT_EQ('a', buf[UNIT_SIZE * 3 + 2]);
+
+    EXPECT_CALL(bd_mock, program(_, 0, UNIT_SIZE * 2))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, program(_, UNIT_SIZE * 3, UNIT_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, sync());
+
+    EXPECT_EQ(bd.sync(), 0);
+}
+
+TEST_F(BufferedBlockCacheTest, evict_least_recently_used)
+{
+    // Whole lines programmed don't need to be read
+    EXPECT_EQ(bd.program(magic, 0, LINE_SIZE), 0);
+    EXPECT_EQ(bd.program(magic, LINE_SIZE, LINE_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+
+    EXPECT_CALL(bd_mock, program(_, LINE_SIZE, LINE_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, read(_, LINE_SIZE * 2, LINE_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, LINE_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(bd.read(buf, LINE_SIZE * 2, 1), 0);
+
+    EXPECT_CALL(bd_mock, program(_, 0, LINE_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+}
+
+TEST_F(BufferedBlockCacheTest, erase_drops_lines)
+{
+    EXPECT_EQ(bd.program(magic, 0, LINE_SIZE), 0);
+
+    ON_CALL(bd_mock, get_erase_size(_)).WillByDefault(Return(LINE_SIZE));
+    EXPECT_CALL(bd_mock, erase(0, LINE_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.erase(0, LINE_SIZE), 0);
+
+    // Nothing left to write back
+    EXPECT_CALL(bd_mock, program(_, _, _)).Times(0);
+}
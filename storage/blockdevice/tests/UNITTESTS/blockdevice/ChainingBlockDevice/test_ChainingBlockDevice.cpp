@@ -16,6 +16,7 @@
 
 #include "gtest/gtest.h"
 #include "ChainingBlockDevice.cpp"
+#include "blockdevice/HeapBlockDevice.h"
 #include "stubs/BlockDevice_mock.h"
 
 using ::testing::_;
@@ -160,3 +161,123 @@ TEST_F(ChainingBlockModuleTest, memory_overlap)
 
     EXPECT_EQ(bd.erase((SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
 }
+
+struct Completion {
+    int calls = 0;
+    int result = 1;
+
+    void done(int err)
+    {
+        calls++;
+        result = err;
+    }
+};
+
+TEST_F(ChainingBlockModuleTest, async)
+{
+    Completion c;
+
+    // Forwarded to the block device containing the blocks
+    EXPECT_CALL(bd_mock2, read(_, 2 * BLOCK_SIZE, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.read_async(buf, (SECTORS_NUM / 2 + 2) * BLOCK_SIZE, 2 * BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_OK);
+    EXPECT_EQ(c.calls, 1);
+    EXPECT_EQ(c.result, BD_ERROR_OK);
+
+    // Split over the block devices
+    EXPECT_CALL(bd_mock1, erase((SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_CALL(bd_mock2, erase(0, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_DEVICE_ERROR));
+
+    EXPECT_EQ(bd.erase_async((SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 4 * BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_OK);
+    EXPECT_EQ(c.calls, 2);
+    EXPECT_EQ(c.result, BD_ERROR_DEVICE_ERROR);
+}
+
+TEST(ChainingBlockLayoutTest, striped)
+{
+    HeapBlockDevice heap1(SECTORS_NUM * BLOCK_SIZE, BLOCK_SIZE);
+    HeapBlockDevice heap2((SECTORS_NUM + 2) * BLOCK_SIZE, BLOCK_SIZE);
+    BlockDevice *bds[2] = {&heap1, &heap2};
+    ChainingBlockDevice bd(bds, ChainingBlockDevice::STRIPED);
+    uint8_t magic[BLOCK_SIZE * 4];
+    uint8_t buf[BLOCK_SIZE * 4];
+
+    for (int i = 0; i < BLOCK_SIZE * 4; i++) {
+        magic[i] = 0xaa + i;
+    }
+
+    ASSERT_EQ(bd.init(), 0);
+    EXPECT_EQ(bd.size(), 2 * SECTORS_NUM * BLOCK_SIZE);
+    EXPECT_EQ(bd.get_erase_size(BLOCK_SIZE), BLOCK_SIZE);
+
+    // Consecutive blocks alternate between the block devices
+    EXPECT_EQ(bd.program(magic, BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap2.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+    EXPECT_EQ(heap1.read(buf, BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + BLOCK_SIZE, BLOCK_SIZE));
+    EXPECT_EQ(heap2.read(buf, BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + 2 * BLOCK_SIZE, BLOCK_SIZE));
+    EXPECT_EQ(heap1.read(buf, 2 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + 3 * BLOCK_SIZE, BLOCK_SIZE));
+
+    memset(buf, 0, sizeof(buf));
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, sizeof(buf)));
+
+    // Within a block, forwarded to its block device
+    memset(buf, 0, sizeof(buf));
+    EXPECT_EQ(bd.read_async(buf, 3 * BLOCK_SIZE, BLOCK_SIZE, mbed::callback([](int err) {
+        EXPECT_EQ(err, 0);
+    })), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + 2 * BLOCK_SIZE, BLOCK_SIZE));
+
+    EXPECT_EQ(bd.erase(0, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 2 * SECTORS_NUM * BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(bd.deinit(), 0);
+}
+
+TEST(ChainingBlockLayoutTest, mirrored)
+{
+    HeapBlockDevice heap1(SECTORS_NUM * BLOCK_SIZE, BLOCK_SIZE);
+    HeapBlockDevice heap2((SECTORS_NUM + 2) * BLOCK_SIZE, BLOCK_SIZE);
+    BlockDevice *bds[2] = {&heap1, &heap2};
+    ChainingBlockDevice bd(bds, ChainingBlockDevice::MIRRORED);
+    uint8_t magic[BLOCK_SIZE * 4];
+    uint8_t buf[BLOCK_SIZE * 4];
+
+    for (int i = 0; i < BLOCK_SIZE * 4; i++) {
+        magic[i] = 0xaa + i;
+    }
+
+    ASSERT_EQ(bd.init(), 0);
+    EXPECT_EQ(bd.size(), SECTORS_NUM * BLOCK_SIZE);
+
+    // Programmed on both block devices
+    EXPECT_EQ(bd.program(magic, 2 * BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap1.read(buf, 2 * BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, sizeof(buf)));
+    memset(buf, 0, sizeof(buf));
+    EXPECT_EQ(heap2.read(buf, 2 * BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, sizeof(buf)));
+
+    memset(buf, 0, sizeof(buf));
+    EXPECT_EQ(bd.read(buf, 2 * BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, sizeof(buf)));
+
+    // A failing block device is covered by the other one
+    EXPECT_EQ(heap1.deinit(), 0);
+    memset(buf, 0, sizeof(buf));
+    EXPECT_EQ(bd.read(buf, 2 * BLOCK_SIZE, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, sizeof(buf)));
+    EXPECT_EQ(bd.program(magic, 6 * BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+
+    EXPECT_EQ(bd.deinit(), 0);
+}
@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "blockdevice/PreEraseBlockDevice.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include <string.h>
+
+#define BLOCK_SIZE (512)
+#define DEVICE_SIZE (BLOCK_SIZE*16)
+
+// Heap block device counting the erased blocks
+class CountingBlockDevice : public HeapBlockDevice {
+public:
+    CountingBlockDevice() : HeapBlockDevice(DEVICE_SIZE, 1, 1, BLOCK_SIZE), erased(0), erases(0) {}
+
+    virtual int erase(bd_addr_t addr, bd_size_t size)
+    {
+        erased += size / BLOCK_SIZE;
+        erases++;
+        return HeapBlockDevice::erase(addr, size);
+    }
+
+    int erased;
+    int erases;
+};
+
+class PreEraseBlockModuleTest : public testing::Test {
+protected:
+    CountingBlockDevice heap_bd;
+    PreEraseBlockDevice bd{&heap_bd};
+    uint8_t magic[BLOCK_SIZE];
+    uint8_t buf[BLOCK_SIZE];
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(bd.init(), 0);
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            magic[i] = 0xaa + i;
+        }
+    }
+
+    virtual void TearDown()
+    {
+        ASSERT_EQ(bd.deinit(), 0);
+    }
+};
+
+TEST_F(PreEraseBlockModuleTest, init)
+{
+    EXPECT_EQ(bd.get_erase_size(), heap_bd.get_erase_size());
+    EXPECT_EQ(bd.get_erase_size(0), heap_bd.get_erase_size(0));
+    EXPECT_EQ(bd.get_erase_value(), heap_bd.get_erase_value());
+    EXPECT_EQ(bd.get_program_size(), heap_bd.get_program_size());
+    EXPECT_EQ(bd.get_read_size(), heap_bd.get_read_size());
+    EXPECT_EQ(bd.size(), heap_bd.size());
+    EXPECT_EQ(bd.get_type(), heap_bd.get_type());
+}
+
+TEST_F(PreEraseBlockModuleTest, erase_once)
+{
+    EXPECT_EQ(bd.erase(0, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 4);
+    EXPECT_EQ(heap_bd.erases, 1);
+
+    // still erased
+    EXPECT_EQ(bd.erase(BLOCK_SIZE, 2 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 4);
+
+    // only the programmed block is erased again
+    EXPECT_EQ(bd.program(magic, 2 * BLOCK_SIZE + 8, 8), 0);
+    EXPECT_EQ(bd.erase(0, 4 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 5);
+    EXPECT_EQ(heap_bd.erases, 2);
+}
+
+TEST_F(PreEraseBlockModuleTest, trim_erase_step)
+{
+    EXPECT_EQ(bd.program(magic, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.program(magic, 5 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.program(magic, 6 * BLOCK_SIZE, BLOCK_SIZE), 0);
+
+    EXPECT_EQ(bd.trim(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.trim(5 * BLOCK_SIZE, 2 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 0);
+
+    bool done = true;
+    EXPECT_EQ(bd.erase_step(BLOCK_SIZE, &done), 0);
+    EXPECT_FALSE(done);
+    EXPECT_EQ(heap_bd.erased, 1);
+
+    // contiguous trimmed blocks are erased at once
+    EXPECT_EQ(bd.erase_step(2 * BLOCK_SIZE, &done), 0);
+    EXPECT_TRUE(done);
+    EXPECT_EQ(heap_bd.erased, 3);
+    EXPECT_EQ(heap_bd.erases, 2);
+
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.erase(5 * BLOCK_SIZE, 2 * BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 3);
+
+    EXPECT_EQ(bd.program(magic, 5 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 5 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(magic, buf, BLOCK_SIZE));
+}
+
+TEST_F(PreEraseBlockModuleTest, programmed_after_trim)
+{
+    EXPECT_EQ(bd.trim(0, 2 * BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.program(magic, BLOCK_SIZE, BLOCK_SIZE), 0);
+
+    // nothing is left to erase in the background
+    bool done = false;
+    EXPECT_EQ(bd.erase_step(DEVICE_SIZE, &done), 0);
+    EXPECT_TRUE(done);
+    EXPECT_EQ(heap_bd.erased, 1);
+}
+
+TEST_F(PreEraseBlockModuleTest, state_dropped_on_deinit)
+{
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.deinit(), 0);
+    EXPECT_EQ(bd.init(), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(heap_bd.erased, 2);
+}
+
+TEST_F(PreEraseBlockModuleTest, invalid)
+{
+    EXPECT_EQ(bd.erase(1, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(bd.trim(0, BLOCK_SIZE + 1), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(heap_bd.erased, 0);
+}
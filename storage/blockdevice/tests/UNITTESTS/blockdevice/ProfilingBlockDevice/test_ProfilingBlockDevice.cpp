@@ -92,3 +92,79 @@ TEST_F(ProfilingBlockModuleTest, count) {
     EXPECT_EQ(bd.get_program_count(), 0);
     EXPECT_EQ(bd.get_erase_count(), 0);
 }
+
+TEST_F(ProfilingBlockModuleTest, op_stats)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE)).WillRepeatedly(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, program(_, 0, 4 * BLOCK_SIZE)).WillOnce(Return(BD_ERROR_DEVICE_ERROR));
+    EXPECT_CALL(bd_mock, erase(0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.program(magic, 0, 4 * BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+
+    mbed::profiling_bd_op_stats_t stats;
+    bd.get_op_stats(ProfilingBlockDevice::OP_READ, &stats);
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.errors, 0);
+    // 512 bytes are counted in the bucket of 512 to 1023 bytes
+    EXPECT_EQ(stats.size_bucket[9], 2);
+
+    bd.get_op_stats(ProfilingBlockDevice::OP_PROGRAM, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.errors, 1);
+    EXPECT_EQ(stats.size_bucket[11], 1);
+    EXPECT_EQ(bd.get_program_count(), 0);
+
+    bd.get_op_stats(ProfilingBlockDevice::OP_ERASE, &stats);
+    EXPECT_EQ(stats.count, 1);
+
+    // One thread: every operation started alone
+    EXPECT_EQ(bd.get_queue_depth_count(1), 4);
+    EXPECT_EQ(bd.get_queue_depth_count(2), 0);
+    EXPECT_EQ(bd.get_max_queue_depth(), 1);
+
+    bd.reset();
+    bd.get_op_stats(ProfilingBlockDevice::OP_READ, &stats);
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.size_bucket[9], 0);
+    EXPECT_EQ(bd.get_queue_depth_count(1), 0);
+    EXPECT_EQ(bd.get_max_queue_depth(), 0);
+}
+
+TEST_F(ProfilingBlockModuleTest, trace)
+{
+    EXPECT_CALL(bd_mock, read(_, _, BLOCK_SIZE)).WillRepeatedly(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, erase(BLOCK_SIZE, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+
+    // Not traced without a buffer
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+
+    mbed::profiling_bd_trace_t trace[2];
+    bd.set_trace_buffer(trace, 2);
+    EXPECT_EQ(bd.read(buf, 2 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.erase(BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 3 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_trace_dropped(), 1);
+
+    mbed::profiling_bd_trace_t records[4];
+    ASSERT_EQ(bd.read_trace(records, 1), 1);
+    EXPECT_EQ(records[0].op, ProfilingBlockDevice::OP_READ);
+    EXPECT_EQ(records[0].addr, 2 * BLOCK_SIZE);
+    EXPECT_EQ(records[0].size, BLOCK_SIZE);
+    EXPECT_EQ(records[0].depth, 1);
+    EXPECT_EQ(records[0].err, 0);
+
+    // The record taken leaves room for the next operation
+    EXPECT_EQ(bd.read(buf, 4 * BLOCK_SIZE, BLOCK_SIZE), 0);
+    ASSERT_EQ(bd.read_trace(records, 4), 2);
+    EXPECT_EQ(records[0].op, ProfilingBlockDevice::OP_ERASE);
+    EXPECT_EQ(records[0].addr, BLOCK_SIZE);
+    EXPECT_EQ(records[1].addr, 4 * BLOCK_SIZE);
+    EXPECT_EQ(bd.read_trace(records, 4), 0);
+
+    bd.set_trace_buffer(NULL, 0);
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read_trace(records, 4), 0);
+}
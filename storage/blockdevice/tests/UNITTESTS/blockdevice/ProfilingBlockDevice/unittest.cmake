@@ -13,6 +13,7 @@ set(unittest-sources
   ../storage/blockdevice/source/HeapBlockDevice.cpp
   stubs/mbed_atomic_stub.c
   stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
 )
 
 set(unittest-test-sources
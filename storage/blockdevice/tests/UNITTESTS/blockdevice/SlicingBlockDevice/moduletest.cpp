@@ -218,3 +218,44 @@ TEST_F(SlicingBlockModuleTest, too_big_to_init)
     // Just a pass through
     EXPECT_EQ(slice.init(), BD_ERROR_DEVICE_ERROR);
 }
+
+struct Completion {
+    int calls = 0;
+    int result = 1;
+
+    void done(int err)
+    {
+        calls++;
+        result = err;
+    }
+};
+
+TEST_F(SlicingBlockModuleTest, async)
+{
+    Completion c;
+    mbed::SlicingBlockDevice slice(&bd, BLOCK_SIZE, BLOCK_SIZE * 3);
+    EXPECT_EQ(slice.init(), BD_ERROR_OK);
+
+    EXPECT_EQ(slice.erase_async(0, BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_OK);
+    EXPECT_EQ(c.calls, 1);
+    EXPECT_EQ(c.result, BD_ERROR_OK);
+
+    EXPECT_EQ(slice.program_async(magic, BLOCK_SIZE, BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_OK);
+    EXPECT_EQ(c.calls, 2);
+    EXPECT_EQ(c.result, BD_ERROR_OK);
+
+    // The slice is shifted by one block on the underlying device
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE * 2, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    memset(buf, 0, BLOCK_SIZE);
+    EXPECT_EQ(slice.read_async(buf, BLOCK_SIZE, BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_OK);
+    EXPECT_EQ(c.calls, 3);
+    EXPECT_EQ(c.result, BD_ERROR_OK);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    // Requests outside of the slice are not started
+    EXPECT_EQ(slice.read_async(buf, BLOCK_SIZE * 2, BLOCK_SIZE, mbed::callback(&c, &Completion::done)), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(c.calls, 3);
+    EXPECT_EQ(slice.deinit(), BD_ERROR_OK);
+}
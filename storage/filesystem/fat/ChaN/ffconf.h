@@ -290,6 +290,7 @@
 
 #define FLUSH_ON_NEW_CLUSTER    MBED_CONF_FAT_CHAN_FLUSH_ON_NEW_CLUSTER   /* Sync the file on every new cluster */
 #define FLUSH_ON_NEW_SECTOR     MBED_CONF_FAT_CHAN_FLUSH_ON_NEW_SECTOR   /* Sync the file on every new sector */
+#define FAST_SEEK_FRAGMENTS     MBED_CONF_FAT_CHAN_FAST_SEEK_FRAGMENTS   /* Fragments of the link map of a file in fast seek mode */
 /* Only one of these two defines needs to be set to 1. If both are set to 0
    the file is only sync when closed.
    Clusters are group of sectors (eg: 8 sectors). Flushing on new cluster means
@@ -165,6 +165,20 @@ protected:
      */
     virtual int file_open(fs_file_t *file, const char *path, int flags);
 
+    /** Open a file on the file system with buffering hints.
+     *
+     *  With fat_chan.ff_use_fastseek, read only files opened with the random
+     *  hint are switched to the fast seek mode of FatFs, so that seeks use a
+     *  map of the cluster chain instead of walking the FAT.
+     *
+     *  @param file     Destination of the newly created handle to the referenced file.
+     *  @param path     The name of the file to open.
+     *  @param flags    The flags that trigger opening of the file.
+     *  @param options  Buffering hints for the file.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_open(fs_file_t *file, const char *path, int flags, const file_options &options);
+
     /** Close a file
      *
      *  @param file     File handle.
@@ -236,6 +250,21 @@ protected:
      */
     virtual int file_truncate(mbed::fs_file_t file, off_t length);
 
+    /** Reserve contiguous clusters for an empty file.
+     *
+     * Needs fat_chan.ff_use_expand. The file's length is set to the
+     * specified value, with the previous contents of the clusters. With
+     * fat_chan.ff_use_fastseek the file is then in fast seek mode until
+     * it grows or is truncated.
+     *
+     *  @param file     File handle.
+     *  @param length   The length to reserve.
+     *
+     *  @return         0 on success, -ENOSPC if there is no contiguous free
+     *                  area large enough, negative error code on failure.
+     */
+    virtual int file_reserve(mbed::fs_file_t file, off_t length);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
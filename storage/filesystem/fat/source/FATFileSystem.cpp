@@ -29,6 +29,7 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <new>
 
 namespace mbed {
 
@@ -569,7 +570,54 @@ void FATFileSystem::unlock()
 
 
 ////// File operations //////
+#if FF_USE_FASTSEEK
+// Switches a file to fast seek mode, with a map of the fragments of its
+// cluster chain so that seeks don't walk the FAT. Files with too many
+// fragments stay in normal mode
+static void fat_link_map_create(FIL *fh)
+{
+    // one fragment, which fits reserved files
+    DWORD size = 4;
+    while (true) {
+        DWORD *map = new (std::nothrow) DWORD[size];
+        if (!map) {
+            return;
+        }
+
+        map[0] = size;
+        fh->cltbl = map;
+        FRESULT res = f_lseek(fh, CREATE_LINKMAP);
+        if (res == FR_OK) {
+            return;
+        }
+
+        // the first entry holds the size the map needs
+        DWORD needed = map[0];
+        fh->cltbl = NULL;
+        delete[] map;
+        if (res != FR_NOT_ENOUGH_CORE || needed <= size || needed > 2 * FAST_SEEK_FRAGMENTS + 2) {
+            return;
+        }
+        size = needed;
+    }
+}
+
+// Back to normal mode, needed before the file grows as the map only
+// covers the clusters the file has
+static void fat_link_map_drop(FIL *fh)
+{
+    delete[] fh->cltbl;
+    fh->cltbl = NULL;
+}
+#endif
+
 int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    file_options options = {};
+    return file_open(file, path, flags, options);
+}
+
+int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags, const file_options &options)
 {
     debug_if(FFS_DBG, "open(%s) on filesystem [%s], drv [%d]\n", path, getName(), _id);
 
@@ -608,6 +656,11 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
         return fat_error_remap(res);
     }
 
+#if FF_USE_FASTSEEK
+    if (options.random && !(openmode & FA_WRITE) && f_size(fh) > 0) {
+        fat_link_map_create(fh);
+    }
+#endif
     unlock();
 
     *file = fh;
@@ -620,6 +673,9 @@ int FATFileSystem::file_close(fs_file_t file)
 
     lock();
     FRESULT res = f_close(fh);
+#if FF_USE_FASTSEEK
+    fat_link_map_drop(fh);
+#endif
     unlock();
 
     delete fh;
@@ -648,6 +704,11 @@ ssize_t FATFileSystem::file_write(fs_file_t file, const void *buffer, size_t len
     FIL *fh = static_cast<FIL *>(file);
 
     lock();
+#if FF_USE_FASTSEEK
+    if (fh->cltbl && f_tell(fh) + len > f_size(fh)) {
+        fat_link_map_drop(fh);
+    }
+#endif
     UINT n;
     FRESULT res = f_write(fh, buffer, len, &n);
     unlock();
@@ -685,6 +746,12 @@ off_t FATFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
         offset += f_tell(fh);
     }
 
+#if FF_USE_FASTSEEK
+    // seeks past the end extend the file
+    if (fh->cltbl && offset > (off_t)f_size(fh) && (fh->flag & FA_WRITE)) {
+        fat_link_map_drop(fh);
+    }
+#endif
     FRESULT res = f_lseek(fh, offset);
     off_t noffset = fh->fptr;
     unlock();
@@ -724,6 +791,11 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
     FIL *fh = static_cast<FIL *>(file);
 
     lock();
+#if FF_USE_FASTSEEK
+    if (fh->cltbl) {
+        fat_link_map_drop(fh);
+    }
+#endif
     // save current position
     FSIZE_t oldoff = f_tell(fh);
 
@@ -747,7 +819,46 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
         return fat_error_remap(res);
     }
 
+    unlock();
+    return 0;
+}
+
+int FATFileSystem::file_reserve(fs_file_t file, off_t length)
+{
+#if FF_USE_EXPAND && !FF_FS_READONLY
+    FIL *fh = static_cast<FIL *>(file);
+
+    if (length <= 0) {
+        return -EINVAL;
+    }
+
+    lock();
+    if (!(fh->flag & FA_WRITE)) {
+        unlock();
+        return -EBADF;
+    }
+
+    if (f_size(fh) != 0) {
+        unlock();
+        return -EINVAL;
+    }
+
+    FRESULT res = f_expand(fh, length, 1);
+    if (res != FR_OK) {
+        unlock();
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+        // the file is writable and empty, so no contiguous area was found
+        return res == FR_DENIED ? -ENOSPC : fat_error_remap(res);
+    }
+
+#if FF_USE_FASTSEEK
+    fat_link_map_create(fh);
+#endif
+    unlock();
     return 0;
+#else
+    return -ENOSYS;
+#endif
 }
 
 
@@ -107,6 +107,64 @@ void test_read_write()
 
 
 // Simple test for iterating dir entries
+void test_reserve()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    File file;
+    err = file.open(&fs, "test_reserve.dat", O_RDWR | O_CREAT | O_TRUNC);
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.reserve(8 * BLOCK_SIZE);
+    if (err == -ENOSYS) {
+        file.close();
+        fs.unmount();
+        TEST_IGNORE_MESSAGE("fat_chan.ff_use_expand disabled. Test skipped.");
+    }
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(8 * BLOCK_SIZE, file.size());
+    TEST_ASSERT_EQUAL(-EINVAL, file.reserve(BLOCK_SIZE));
+
+    // writes within and past the reservation, then back to the written length
+    uint8_t buffer[BLOCK_SIZE / 2];
+    srand(1);
+    for (int i = 0; i < 20; i++) {
+        for (size_t j = 0; j < sizeof(buffer); j++) {
+            buffer[j] = 0xff & rand();
+        }
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.write(buffer, sizeof(buffer)));
+    }
+    err = file.truncate(20 * sizeof(buffer));
+    TEST_ASSERT_EQUAL(0, err);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    FileSystem::file_options options = {};
+    options.random = true;
+    err = file.open(&fs, "test_reserve.dat", O_RDONLY, options);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(20 * sizeof(buffer), file.size());
+    for (int i = 19; i >= 0; i--) {
+        TEST_ASSERT_EQUAL(i * sizeof(buffer), file.seek(i * sizeof(buffer), SEEK_SET));
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.read(buffer, sizeof(buffer)));
+    }
+    srand(1);
+    for (size_t j = 0; j < sizeof(buffer); j++) {
+        TEST_ASSERT_EQUAL(0xff & rand(), buffer[j]);
+    }
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.remove("test_reserve.dat");
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 void test_read_dir()
 {
     TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
@@ -185,6 +243,7 @@ Case cases[] = {
     Case("Testing read write < block", test_read_write < BLOCK_SIZE / 2 >),
     Case("Testing read write > block", test_read_write<2 * BLOCK_SIZE>),
     Case("Testing dir iteration", test_read_dir),
+    Case("Testing reserve", test_reserve),
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,340 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_IMAGE_FILE_SYSTEM_H
+#define MBED_IMAGE_FILE_SYSTEM_H
+
+#include "filesystem/FileSystem.h"
+#include "blockdevice/BlockDevice.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** Read-only file system over a packed, compressed image
+ *
+ *  Assets such as web pages, fonts or images are packed on the host by
+ *  tools/imagefs.py into an image, which is written to a block device or
+ *  to memory mapped flash, internal or QSPI, and mounted as such. Nothing
+ *  is unpacked ahead of time: blocks of a file are decompressed when read,
+ *  and the last ones are kept in a cache of MBED_CONF_IMAGEFS_CACHE_BLOCKS
+ *  blocks.
+ *
+ *  An image, little endian, is made of:
+ *  - a header, see header_t
+ *  - the entries, see entry_t, sorted by path with '/' ordered before any
+ *    other character, so that a path is found by binary search and a
+ *    directory is directly followed by its content
+ *  - the paths of the entries, without leading '/' nor terminator
+ *  - the offsets in the image of the blocks, plus one for the end of the
+ *    last one. Blocks stored uncompressed have IMAGEFS_BLOCK_RAW set.
+ *  - the blocks, of block_size bytes once decompressed, each file starting
+ *    a new block. Blocks are compressed independently with LZSS in the
+ *    heatshrink format.
+ *
+ *  The header, entries, paths and offsets are covered by a CRC-32 checked
+ *  on mount.
+ *
+ *  @code
+ *  // image programmed at the start of the memory mapped QSPI flash
+ *  ImageFileSystem assets("assets", (const void *)QSPI_BASE, QSPI_SIZE);
+ *
+ *  FILE *f = fopen("/assets/index.html", "r");
+ *  @endcode
+ *
+ *  Synchronization level: Thread safe
+ */
+class ImageFileSystem : public FileSystem, private NonCopyable<ImageFileSystem> {
+public:
+    /** Image header, little endian */
+    struct header_t {
+        uint32_t magic;             ///< IMAGEFS_MAGIC
+        uint8_t version;            ///< IMAGEFS_VERSION
+        uint8_t compression;        ///< 0: none, 1: LZSS (heatshrink)
+        uint8_t window_sz2;         ///< LZSS window size, as a power of 2
+        uint8_t lookahead_sz2;      ///< LZSS lookahead size, as a power of 2
+        uint32_t block_size;        ///< Size of a decompressed block
+        uint32_t entry_count;       ///< Number of entries, following the header
+        uint32_t names_offset;      ///< Offset of the paths in the image
+        uint32_t blocks_offset;     ///< Offset of the block offsets in the image
+        uint32_t block_count;       ///< Number of blocks
+        uint32_t image_size;        ///< Size of the image
+        uint32_t crc;               ///< CRC-32 of the metadata, computed with 0 here
+    };
+
+    /** Entry of the image, little endian */
+    struct entry_t {
+        uint32_t name_offset;       ///< Offset of the path in the paths
+        uint16_t name_len;          ///< Length of the path
+        uint8_t type;               ///< IMAGEFS_TYPE_REG or IMAGEFS_TYPE_DIR
+        uint8_t reserved;
+        uint32_t size;              ///< Files: size, directories: number of entries below
+        uint32_t first_block;       ///< Files: first block, directories: 0
+    };
+
+    /** Lifetime of the ImageFileSystem over a block device
+     *
+     *  @param name     Name of the file system in the tree.
+     *  @param bd       Block device holding the image from its start.
+     *                  Mounted immediately if not NULL.
+     */
+    ImageFileSystem(const char *name = NULL, BlockDevice *bd = NULL);
+
+    /** Lifetime of the ImageFileSystem over a memory mapped image
+     *
+     *  Data stored uncompressed is read in place.
+     *
+     *  @param name     Name of the file system in the tree.
+     *  @param image    Image, memory mapped. Mounted immediately if not NULL.
+     *  @param size     Size of the area holding the image
+     */
+    ImageFileSystem(const char *name, const void *image, size_t size);
+
+    virtual ~ImageFileSystem();
+
+    /** Mount an image from a block device
+     *
+     *  @param bd       Block device holding the image from its start
+     *  @return         0 on success, -EILSEQ if the device doesn't hold
+     *                  a valid image, or a negative error code on failure
+     */
+    virtual int mount(BlockDevice *bd);
+
+    /** Mount a memory mapped image
+     *
+     *  @param image    Image, memory mapped
+     *  @param size     Size of the area holding the image
+     *  @return         0 on success, -EILSEQ if the area doesn't hold
+     *                  a valid image, or a negative error code on failure
+     */
+    int mount(const void *image, size_t size);
+
+    /** Unmount the image
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int unmount();
+
+    /** Images are built on the host
+     *
+     *  @return         -EROFS
+     */
+    virtual int reformat(BlockDevice *bd);
+
+    /** Images are read-only
+     *
+     *  @return         -EROFS
+     */
+    virtual int remove(const char *path);
+
+    /** Images are read-only
+     *
+     *  @return         -EROFS
+     */
+    virtual int rename(const char *path, const char *newpath);
+
+    /** Images are read-only
+     *
+     *  @return         -EROFS
+     */
+    virtual int mkdir(const char *path, mode_t mode);
+
+    /** Store information about the file in a stat structure
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param st       The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int stat(const char *path, struct stat *st);
+
+    /** Store information about the mounted image in a statvfs structure
+     *
+     *  The image is reported full.
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param buf      The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int statvfs(const char *path, struct statvfs *buf);
+
+protected:
+    /** Open a file on the file system
+     *
+     *  @param file     Destination of the newly created handle to the referenced file.
+     *  @param path     The name of the file to open.
+     *  @param flags    The flags that trigger opening of the file, O_RDONLY
+     *                  only, -EROFS is returned for any flag that writes.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_open(fs_file_t *file, const char *path, int flags);
+
+    /** Close a file
+     *
+     *  @param file     File handle.
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int file_close(fs_file_t file);
+
+    /** Read the contents of a file into a buffer
+     *
+     *  @param file     File handle.
+     *  @param buffer   The buffer to read in to.
+     *  @param size     The number of bytes to read.
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size);
+
+    /** Files are read-only
+     *
+     *  @return         -EBADF
+     */
+    virtual ssize_t file_write(fs_file_t file, const void *buffer, size_t size);
+
+    /** Move the file position to a given offset from a given location
+     *
+     *  @param file     File handle.
+     *  @param offset   The offset from whence to move to.
+     *  @param whence   The start of where to seek.
+     *      SEEK_SET to start from beginning of file,
+     *      SEEK_CUR to start from current position in file,
+     *      SEEK_END to start from end of file.
+     *  @return         The new offset of the file, negative error code on failure
+     */
+    virtual off_t file_seek(fs_file_t file, off_t offset, int whence);
+
+    /** Get the file position of the file
+     *
+     *  @param file     File handle.
+     *  @return         The current offset in the file, negative error code on failure
+     */
+    virtual off_t file_tell(fs_file_t file);
+
+    /** Get the size of the file
+     *
+     *  @param file     File handle.
+     *  @return         Size of the file in bytes
+     */
+    virtual off_t file_size(fs_file_t file);
+
+    /** Open a directory on the file system
+     *
+     *  @param dir      Destination for the handle to the directory.
+     *  @param path     Name of the directory to open.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int dir_open(fs_dir_t *dir, const char *path);
+
+    /** Close a directory
+     *
+     *  @param dir      Dir handle.
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int dir_close(fs_dir_t dir);
+
+    /** Read the next directory entry
+     *
+     *  @param dir      Dir handle.
+     *  @param ent      The directory entry to fill out.
+     *  @return         1 on reading a filename, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
+
+    /** Set the current position of the directory
+     *
+     *  @param dir      Dir handle.
+     *  @param offset   Offset of the location to seek to,
+     *                  must be a value returned from dir_tell
+     */
+    virtual void dir_seek(fs_dir_t dir, off_t offset);
+
+    /** Get the current position of the directory
+     *
+     *  @param dir      Dir handle.
+     *  @return         Position of the directory that can be passed to dir_rewind
+     */
+    virtual off_t dir_tell(fs_dir_t dir);
+
+    /** Rewind the current position to the beginning of the directory
+     *
+     *  @param dir      Dir handle
+     */
+    virtual void dir_rewind(fs_dir_t dir);
+
+private:
+    struct cache_t {
+        uint32_t block;
+        uint32_t length;
+        uint32_t used;
+        uint8_t *data;
+    };
+
+    // Compressed stream of a block
+    struct bits_t {
+        uint32_t addr;
+        uint32_t end;
+        const uint8_t *ptr;
+        const uint8_t *ptr_end;
+        uint32_t acc;
+        uint8_t count;
+    };
+
+    int mount_image();
+    void release();
+    const uint8_t *fetch(uint32_t addr, uint32_t size, int *err);
+    int read_image(uint32_t addr, void *buffer, uint32_t size);
+    int read_entry(uint32_t index, entry_t *entry);
+    int compare(const entry_t &entry, const char *path, size_t len, int *err);
+    int lookup(const char *path, entry_t *entry, uint32_t *index);
+    int block_location(uint32_t block, uint32_t *start, uint32_t *end, bool *raw);
+    int get_bits(bits_t *in, uint8_t count);
+    int decompress(uint32_t addr, uint32_t end, uint8_t *out, uint32_t length);
+    const uint8_t *cached_block(uint32_t block, uint32_t length, int *err);
+    int read_block(uint32_t block, uint32_t length, uint32_t offset, uint8_t *buffer, uint32_t size);
+
+    BlockDevice *_bd;
+    const uint8_t *_image;
+    size_t _image_size;
+    bool _mounted;
+    header_t _header;
+
+    // Bounce buffer for unaligned reads from the block device
+    uint8_t *_bounce;
+    uint32_t _bounce_size;
+    uint32_t _bounce_addr;
+    uint32_t _bounce_len;
+    bd_size_t _read_size;
+
+    cache_t _cache[MBED_CONF_IMAGEFS_CACHE_BLOCKS];
+    uint8_t *_cache_data;
+    uint32_t _cache_clock;
+
+    PlatformMutex _mutex;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::ImageFileSystem;
+#endif
+
+#endif
+
+/** @}*/
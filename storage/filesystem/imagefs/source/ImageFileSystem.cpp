@@ -0,0 +1,809 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "imagefs/ImageFileSystem.h"
+#include "drivers/MbedCRC.h"
+#include "platform/mbed_assert.h"
+#include <errno.h>
+#include <string.h>
+#include <new>
+
+#define IMAGEFS_MAGIC           0x5346494D  // "MIFS"
+#define IMAGEFS_VERSION         1
+#define IMAGEFS_COMPRESSION_NONE 0
+#define IMAGEFS_COMPRESSION_LZSS 1
+#define IMAGEFS_TYPE_REG        1
+#define IMAGEFS_TYPE_DIR        2
+#define IMAGEFS_BLOCK_RAW       0x80000000
+#define IMAGEFS_NAME_MAX        NAME_MAX
+#define IMAGEFS_NO_BLOCK        0xFFFFFFFF
+
+namespace mbed {
+
+MBED_STATIC_ASSERT(sizeof(ImageFileSystem::header_t) == 36, "header_t must match the image format");
+MBED_STATIC_ASSERT(sizeof(ImageFileSystem::entry_t) == 16, "entry_t must match the image format");
+MBED_STATIC_ASSERT(MBED_CONF_IMAGEFS_CACHE_BLOCKS > 0, "imagefs.cache-blocks must be at least 1");
+
+struct imagefs_file {
+    uint32_t first_block;
+    uint32_t size;
+    off_t pos;
+};
+
+struct imagefs_dir {
+    uint32_t first;         // first entry of the directory
+    uint32_t end;           // entry following the last one below the directory
+    uint32_t pos;
+    uint16_t prefix_len;    // length of the directory path, with its '/'
+};
+
+static uint32_t align_up(uint32_t value, uint32_t align)
+{
+    return (value + align - 1) / align * align;
+}
+
+// Paths are sorted with '/' before any other character, so that the
+// entries below a directory directly follow it
+static inline int path_char(char c)
+{
+    return c == '/' ? 0 : (uint8_t)c;
+}
+
+ImageFileSystem::ImageFileSystem(const char *name, BlockDevice *bd)
+    : FileSystem(name), _bd(NULL), _image(NULL), _image_size(0), _mounted(false),
+      _bounce(NULL), _bounce_size(0), _bounce_addr(0), _bounce_len(0), _read_size(1),
+      _cache_data(NULL), _cache_clock(0)
+{
+    if (bd) {
+        mount(bd);
+    }
+}
+
+ImageFileSystem::ImageFileSystem(const char *name, const void *image, size_t size)
+    : FileSystem(name), _bd(NULL), _image(NULL), _image_size(0), _mounted(false),
+      _bounce(NULL), _bounce_size(0), _bounce_addr(0), _bounce_len(0), _read_size(1),
+      _cache_data(NULL), _cache_clock(0)
+{
+    if (image) {
+        mount(image, size);
+    }
+}
+
+ImageFileSystem::~ImageFileSystem()
+{
+    // nop if unmounted
+    unmount();
+}
+
+int ImageFileSystem::mount(BlockDevice *bd)
+{
+    _mutex.lock();
+    if (_mounted) {
+        _mutex.unlock();
+        return -EBUSY;
+    }
+
+    int err = bd->init();
+    if (err) {
+        _mutex.unlock();
+        return err;
+    }
+
+    _bd = bd;
+    _image_size = bd->size();
+    _read_size = bd->get_read_size();
+
+    // Large enough for any path at any alignment
+    _bounce_size = align_up(IMAGEFS_NAME_MAX > MBED_CONF_IMAGEFS_READ_BUFFER_SIZE ?
+                            IMAGEFS_NAME_MAX : MBED_CONF_IMAGEFS_READ_BUFFER_SIZE, _read_size) + _read_size;
+    _bounce = new (std::nothrow) uint8_t[_bounce_size];
+    _bounce_len = 0;
+    if (!_bounce) {
+        release();
+        _mutex.unlock();
+        return -ENOMEM;
+    }
+
+    err = mount_image();
+    if (err) {
+        release();
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int ImageFileSystem::mount(const void *image, size_t size)
+{
+    _mutex.lock();
+    if (_mounted) {
+        _mutex.unlock();
+        return -EBUSY;
+    }
+
+    _image = (const uint8_t *)image;
+    _image_size = size;
+
+    int err = mount_image();
+    if (err) {
+        release();
+    }
+    _mutex.unlock();
+    return err;
+}
+
+int ImageFileSystem::mount_image()
+{
+    int err = read_image(0, &_header, sizeof(_header));
+    if (err) {
+        return err;
+    }
+
+    const header_t &h = _header;
+    uint64_t entries_end = sizeof(header_t) + (uint64_t)h.entry_count * sizeof(entry_t);
+    uint64_t metadata_end = h.blocks_offset + ((uint64_t)h.block_count + 1) * sizeof(uint32_t);
+    if (h.magic != IMAGEFS_MAGIC || h.version != IMAGEFS_VERSION
+            || h.compression > IMAGEFS_COMPRESSION_LZSS || h.block_size == 0
+            || h.image_size > _image_size || entries_end > h.names_offset
+            || h.names_offset > h.blocks_offset || metadata_end > h.image_size) {
+        return -EILSEQ;
+    }
+    if (h.compression == IMAGEFS_COMPRESSION_LZSS
+            && (h.window_sz2 < 4 || h.window_sz2 > 15 || h.lookahead_sz2 < 3 || h.lookahead_sz2 >= h.window_sz2)) {
+        return -EILSEQ;
+    }
+
+    header_t header = h;
+    header.crc = 0;
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    ct.compute_partial_start(&crc);
+    ct.compute_partial(&header, sizeof(header), &crc);
+    for (uint32_t addr = sizeof(header_t); addr < metadata_end;) {
+        uint32_t chunk = _image ? metadata_end - addr : _bounce_size - _read_size;
+        if (chunk > metadata_end - addr) {
+            chunk = metadata_end - addr;
+        }
+        const uint8_t *data = fetch(addr, chunk, &err);
+        if (!data) {
+            return err;
+        }
+        ct.compute_partial(data, chunk, &crc);
+        addr += chunk;
+    }
+    ct.compute_partial_stop(&crc);
+    if (crc != h.crc) {
+        return -EILSEQ;
+    }
+
+    // Blocks stored uncompressed are read without the cache
+    if (h.compression != IMAGEFS_COMPRESSION_NONE) {
+        _cache_data = new (std::nothrow) uint8_t[MBED_CONF_IMAGEFS_CACHE_BLOCKS * h.block_size];
+        if (!_cache_data) {
+            return -ENOMEM;
+        }
+    }
+    for (int i = 0; i < MBED_CONF_IMAGEFS_CACHE_BLOCKS; i++) {
+        _cache[i].block = IMAGEFS_NO_BLOCK;
+        _cache[i].length = 0;
+        _cache[i].used = 0;
+        _cache[i].data = _cache_data ? _cache_data + i * h.block_size : NULL;
+    }
+    _cache_clock = 0;
+
+    _mounted = true;
+    return 0;
+}
+
+void ImageFileSystem::release()
+{
+    if (_bd) {
+        _bd->deinit();
+    }
+    _bd = NULL;
+    _image = NULL;
+    _image_size = 0;
+    delete[] _bounce;
+    _bounce = NULL;
+    _bounce_len = 0;
+    delete[] _cache_data;
+    _cache_data = NULL;
+    _mounted = false;
+}
+
+int ImageFileSystem::unmount()
+{
+    _mutex.lock();
+    if (_mounted) {
+        release();
+    }
+    _mutex.unlock();
+    return 0;
+}
+
+int ImageFileSystem::reformat(BlockDevice *bd)
+{
+    return -EROFS;
+}
+
+int ImageFileSystem::remove(const char *path)
+{
+    return -EROFS;
+}
+
+int ImageFileSystem::rename(const char *path, const char *newpath)
+{
+    return -EROFS;
+}
+
+int ImageFileSystem::mkdir(const char *path, mode_t mode)
+{
+    return -EROFS;
+}
+
+// Get size bytes of the image at addr, in place for memory mapped images.
+// Through the bounce buffer otherwise, so size is at most _bounce_size -
+// _read_size and the data is only valid until the next fetch.
+const uint8_t *ImageFileSystem::fetch(uint32_t addr, uint32_t size, int *err)
+{
+    if ((uint64_t)addr + size > _image_size) {
+        *err = -EILSEQ;
+        return NULL;
+    }
+    if (_image) {
+        return _image + addr;
+    }
+
+    if (_bounce_len && addr >= _bounce_addr && addr + size <= _bounce_addr + _bounce_len) {
+        return _bounce + (addr - _bounce_addr);
+    }
+
+    MBED_ASSERT(size <= _bounce_size - _read_size);
+    uint32_t start = addr - addr % _read_size;
+    uint32_t len = align_up(addr + size - start, _read_size);
+    _bounce_len = 0;
+    *err = _bd->read(_bounce, start, len);
+    if (*err) {
+        return NULL;
+    }
+    _bounce_addr = start;
+    _bounce_len = len;
+    return _bounce + (addr - start);
+}
+
+int ImageFileSystem::read_image(uint32_t addr, void *buffer, uint32_t size)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    if (!_image && addr % _read_size == 0 && size % _read_size == 0) {
+        if ((uint64_t)addr + size > _image_size) {
+            return -EILSEQ;
+        }
+        return _bd->read(out, addr, size);
+    }
+
+    while (size) {
+        uint32_t chunk = _image ? size : _bounce_size - _read_size;
+        if (chunk > size) {
+            chunk = size;
+        }
+        int err;
+        const uint8_t *data = fetch(addr, chunk, &err);
+        if (!data) {
+            return err;
+        }
+        memcpy(out, data, chunk);
+        out += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+int ImageFileSystem::read_entry(uint32_t index, entry_t *entry)
+{
+    int err;
+    const uint8_t *data = fetch(sizeof(header_t) + index * sizeof(entry_t), sizeof(entry_t), &err);
+    if (!data) {
+        return err;
+    }
+    memcpy(entry, data, sizeof(entry_t));
+    if (entry->name_len > IMAGEFS_NAME_MAX) {
+        return -EILSEQ;
+    }
+    return 0;
+}
+
+// Order of the entry against path
+int ImageFileSystem::compare(const entry_t &entry, const char *path, size_t len, int *err)
+{
+    const char *name = (const char *)fetch(_header.names_offset + entry.name_offset, entry.name_len, err);
+    if (!name) {
+        return 0;
+    }
+
+    size_t common = entry.name_len < len ? entry.name_len : len;
+    for (size_t i = 0; i < common; i++) {
+        int diff = path_char(name[i]) - path_char(path[i]);
+        if (diff) {
+            return diff;
+        }
+    }
+    return (int)entry.name_len - (int)len;
+}
+
+// Find path by binary search. next is set to the index following the
+// entry, 0 for the root directory.
+int ImageFileSystem::lookup(const char *path, entry_t *entry, uint32_t *next)
+{
+    if (!_mounted) {
+        return -ENODEV;
+    }
+
+    while (*path == '/') {
+        path++;
+    }
+    size_t len = strlen(path);
+    while (len && path[len - 1] == '/') {
+        len--;
+    }
+
+    if (len == 0) {
+        memset(entry, 0, sizeof(entry_t));
+        entry->type = IMAGEFS_TYPE_DIR;
+        entry->size = _header.entry_count;
+        *next = 0;
+        return 0;
+    }
+    if (len > IMAGEFS_NAME_MAX) {
+        return -ENAMETOOLONG;
+    }
+
+    uint32_t lo = 0;
+    uint32_t hi = _header.entry_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int err = read_entry(mid, entry);
+        if (err) {
+            return err;
+        }
+        err = 0;
+        int diff = compare(*entry, path, len, &err);
+        if (err) {
+            return err;
+        }
+        if (diff == 0) {
+            *next = mid + 1;
+            return 0;
+        } else if (diff < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return -ENOENT;
+}
+
+int ImageFileSystem::block_location(uint32_t block, uint32_t *start, uint32_t *end, bool *raw)
+{
+    if (block >= _header.block_count) {
+        return -EILSEQ;
+    }
+
+    int err;
+    const uint8_t *data = fetch(_header.blocks_offset + block * sizeof(uint32_t), 2 * sizeof(uint32_t), &err);
+    if (!data) {
+        return err;
+    }
+    uint32_t offsets[2];
+    memcpy(offsets, data, sizeof(offsets));
+
+    *start = offsets[0] & ~IMAGEFS_BLOCK_RAW;
+    *end = offsets[1] & ~IMAGEFS_BLOCK_RAW;
+    *raw = offsets[0] & IMAGEFS_BLOCK_RAW;
+    if (*start > *end || *end > _header.image_size) {
+        return -EILSEQ;
+    }
+    return 0;
+}
+
+// Get the next count bits of a compressed stream, MSB first
+int ImageFileSystem::get_bits(bits_t *in, uint8_t count)
+{
+    while (in->count < count) {
+        if (in->ptr == in->ptr_end) {
+            if (in->addr == in->end) {
+                // Truncated block
+                return -EILSEQ;
+            }
+            uint32_t chunk = in->end - in->addr;
+            if (!_image && chunk > _bounce_size - _read_size) {
+                chunk = _bounce_size - _read_size;
+            }
+            int err;
+            in->ptr = fetch(in->addr, chunk, &err);
+            if (!in->ptr) {
+                return err;
+            }
+            in->ptr_end = in->ptr + chunk;
+            in->addr += chunk;
+        }
+        in->acc = (in->acc << 8) | *in->ptr++;
+        in->count += 8;
+    }
+    in->count -= count;
+    return (in->acc >> in->count) & ((1 << count) - 1);
+}
+
+// Decompress the LZSS stream in [addr, end) into length bytes. A 1 bit is
+// followed by a literal byte, a 0 bit by a back-reference of window_sz2
+// bits of offset - 1 and lookahead_sz2 bits of count - 1. Each block is
+// compressed on its own, so the output is the window.
+int ImageFileSystem::decompress(uint32_t addr, uint32_t end, uint8_t *out, uint32_t length)
+{
+    bits_t in = { addr, end, NULL, NULL, 0, 0 };
+    uint32_t produced = 0;
+
+    while (produced < length) {
+        int tag = get_bits(&in, 1);
+        if (tag < 0) {
+            return tag;
+        }
+
+        if (tag) {
+            int literal = get_bits(&in, 8);
+            if (literal < 0) {
+                return literal;
+            }
+            out[produced++] = literal;
+            continue;
+        }
+
+        int offset = get_bits(&in, _header.window_sz2);
+        if (offset < 0) {
+            return offset;
+        }
+        int count = get_bits(&in, _header.lookahead_sz2);
+        if (count < 0) {
+            return count;
+        }
+        offset += 1;
+        count += 1;
+        if ((uint32_t)offset > produced || (uint32_t)count > length - produced) {
+            return -EILSEQ;
+        }
+        for (int i = 0; i < count; i++, produced++) {
+            out[produced] = out[produced - offset];
+        }
+    }
+    return 0;
+}
+
+// Get a decompressed block from the cache, decompressing it in place of
+// the least recently used one on a miss
+const uint8_t *ImageFileSystem::cached_block(uint32_t block, uint32_t length, int *err)
+{
+    cache_t *victim = &_cache[0];
+    for (int i = 0; i < MBED_CONF_IMAGEFS_CACHE_BLOCKS; i++) {
+        cache_t *c = &_cache[i];
+        if (c->block == block && c->length == length) {
+            c->used = ++_cache_clock;
+            return c->data;
+        }
+        if (c->used < victim->used) {
+            victim = c;
+        }
+    }
+
+    uint32_t start, end;
+    bool raw;
+    *err = block_location(block, &start, &end, &raw);
+    if (*err) {
+        return NULL;
+    }
+
+    victim->block = IMAGEFS_NO_BLOCK;
+    victim->used = 0;
+    *err = decompress(start, end, victim->data, length);
+    if (*err) {
+        return NULL;
+    }
+    victim->block = block;
+    victim->length = length;
+    victim->used = ++_cache_clock;
+    return victim->data;
+}
+
+// Read size bytes at offset of a block of length bytes once decompressed
+int ImageFileSystem::read_block(uint32_t block, uint32_t length, uint32_t offset, uint8_t *buffer, uint32_t size)
+{
+    uint32_t start, end;
+    bool raw;
+    int err = block_location(block, &start, &end, &raw);
+    if (err) {
+        return err;
+    }
+
+    if (raw) {
+        if (end - start != length) {
+            return -EILSEQ;
+        }
+        return read_image(start + offset, buffer, size);
+    }
+
+    if (_header.compression == IMAGEFS_COMPRESSION_NONE) {
+        return -EILSEQ;
+    }
+    const uint8_t *data = cached_block(block, length, &err);
+    if (!data) {
+        return err;
+    }
+    memcpy(buffer, data + offset, size);
+    return 0;
+}
+
+int ImageFileSystem::stat(const char *path, struct stat *st)
+{
+    entry_t entry;
+    uint32_t next;
+    _mutex.lock();
+    int err = lookup(path, &entry, &next);
+    _mutex.unlock();
+    if (err) {
+        return err;
+    }
+
+    memset(st, 0, sizeof(struct stat));
+    if (entry.type == IMAGEFS_TYPE_DIR) {
+        st->st_mode = S_IFDIR | S_IRUSR | S_IRGRP | S_IROTH | S_IXUSR | S_IXGRP | S_IXOTH;
+    } else {
+        st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+        st->st_size = entry.size;
+    }
+    return 0;
+}
+
+int ImageFileSystem::statvfs(const char *path, struct statvfs *buf)
+{
+    memset(buf, 0, sizeof(struct statvfs));
+
+    _mutex.lock();
+    if (!_mounted) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+    buf->f_bsize = _header.block_size;
+    buf->f_frsize = _header.block_size;
+    buf->f_blocks = _header.block_count;
+    buf->f_namemax = IMAGEFS_NAME_MAX;
+    _mutex.unlock();
+    return 0;
+}
+
+////// File operations //////
+int ImageFileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    if ((flags & O_ACCMODE) != O_RDONLY || (flags & (O_TRUNC | O_APPEND))) {
+        return -EROFS;
+    }
+
+    entry_t entry;
+    uint32_t next;
+    _mutex.lock();
+    int err = lookup(path, &entry, &next);
+    _mutex.unlock();
+    if (err == -ENOENT && (flags & O_CREAT)) {
+        return -EROFS;
+    } else if (err) {
+        return err;
+    }
+    if (entry.type == IMAGEFS_TYPE_DIR) {
+        return (flags & O_CREAT) && (flags & O_EXCL) ? -EEXIST : -EISDIR;
+    }
+    if ((flags & O_CREAT) && (flags & O_EXCL)) {
+        return -EEXIST;
+    }
+
+    imagefs_file *f = new (std::nothrow) imagefs_file;
+    if (!f) {
+        return -ENOMEM;
+    }
+    f->first_block = entry.first_block;
+    f->size = entry.size;
+    f->pos = 0;
+    *file = f;
+    return 0;
+}
+
+int ImageFileSystem::file_close(fs_file_t file)
+{
+    delete (imagefs_file *)file;
+    return 0;
+}
+
+ssize_t ImageFileSystem::file_read(fs_file_t file, void *buffer, size_t size)
+{
+    imagefs_file *f = (imagefs_file *)file;
+    if (f->pos >= (off_t)f->size) {
+        return 0;
+    }
+    if (size > (size_t)(f->size - f->pos)) {
+        size = f->size - f->pos;
+    }
+
+    uint8_t *out = (uint8_t *)buffer;
+    uint32_t block_size = _header.block_size;
+    ssize_t total = 0;
+
+    _mutex.lock();
+    if (!_mounted) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+    while (size) {
+        uint32_t index = f->pos / block_size;
+        uint32_t offset = f->pos % block_size;
+        uint32_t length = f->size - index * block_size;
+        if (length > block_size) {
+            length = block_size;
+        }
+        uint32_t chunk = length - offset;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        int err = read_block(f->first_block + index, length, offset, out, chunk);
+        if (err) {
+            _mutex.unlock();
+            return err;
+        }
+        out += chunk;
+        size -= chunk;
+        total += chunk;
+        f->pos += chunk;
+    }
+    _mutex.unlock();
+    return total;
+}
+
+ssize_t ImageFileSystem::file_write(fs_file_t file, const void *buffer, size_t size)
+{
+    return -EBADF;
+}
+
+off_t ImageFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
+{
+    imagefs_file *f = (imagefs_file *)file;
+    off_t pos;
+    if (whence == SEEK_SET) {
+        pos = offset;
+    } else if (whence == SEEK_CUR) {
+        pos = f->pos + offset;
+    } else if (whence == SEEK_END) {
+        pos = (off_t)f->size + offset;
+    } else {
+        return -EINVAL;
+    }
+
+    if (pos < 0) {
+        return -EINVAL;
+    }
+    f->pos = pos;
+    return pos;
+}
+
+off_t ImageFileSystem::file_tell(fs_file_t file)
+{
+    imagefs_file *f = (imagefs_file *)file;
+    return f->pos;
+}
+
+off_t ImageFileSystem::file_size(fs_file_t file)
+{
+    imagefs_file *f = (imagefs_file *)file;
+    return f->size;
+}
+
+////// Dir operations //////
+int ImageFileSystem::dir_open(fs_dir_t *dir, const char *path)
+{
+    entry_t entry;
+    uint32_t next;
+    _mutex.lock();
+    int err = lookup(path, &entry, &next);
+    _mutex.unlock();
+    if (err) {
+        return err;
+    }
+    if (entry.type != IMAGEFS_TYPE_DIR) {
+        return -ENOTDIR;
+    }
+
+    imagefs_dir *d = new (std::nothrow) imagefs_dir;
+    if (!d) {
+        return -ENOMEM;
+    }
+    d->first = next;
+    d->end = next + entry.size;
+    d->pos = next;
+    d->prefix_len = next ? entry.name_len + 1 : 0;
+    *dir = d;
+    return 0;
+}
+
+int ImageFileSystem::dir_close(fs_dir_t dir)
+{
+    delete (imagefs_dir *)dir;
+    return 0;
+}
+
+ssize_t ImageFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
+{
+    imagefs_dir *d = (imagefs_dir *)dir;
+    if (d->pos >= d->end) {
+        return 0;
+    }
+
+    entry_t entry;
+    _mutex.lock();
+    if (!_mounted) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+    int err = read_entry(d->pos, &entry);
+    if (err) {
+        _mutex.unlock();
+        return err;
+    }
+    if (entry.name_len <= d->prefix_len) {
+        _mutex.unlock();
+        return -EILSEQ;
+    }
+
+    uint32_t len = entry.name_len - d->prefix_len;
+    const uint8_t *name = fetch(_header.names_offset + entry.name_offset + d->prefix_len, len, &err);
+    if (!name) {
+        _mutex.unlock();
+        return err;
+    }
+    memcpy(ent->d_name, name, len);
+    ent->d_name[len] = '\0';
+    ent->d_type = entry.type == IMAGEFS_TYPE_DIR ? DT_DIR : DT_REG;
+
+    // Skip the content of subdirectories
+    d->pos += 1 + (entry.type == IMAGEFS_TYPE_DIR ? entry.size : 0);
+    _mutex.unlock();
+    return 1;
+}
+
+void ImageFileSystem::dir_seek(fs_dir_t dir, off_t offset)
+{
+    imagefs_dir *d = (imagefs_dir *)dir;
+    d->pos = d->first + offset;
+}
+
+off_t ImageFileSystem::dir_tell(fs_dir_t dir)
+{
+    imagefs_dir *d = (imagefs_dir *)dir;
+    return d->pos - d->first;
+}
+
+void ImageFileSystem::dir_rewind(fs_dir_t dir)
+{
+    imagefs_dir *d = (imagefs_dir *)dir;
+    d->pos = d->first;
+}
+
+} // namespace mbed
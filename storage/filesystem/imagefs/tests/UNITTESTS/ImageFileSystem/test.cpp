@@ -0,0 +1,369 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "filesystem/Dir.h"
+#include "filesystem/File.h"
+#include "imagefs/ImageFileSystem.h"
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#define BLOCK_SIZE 64
+#define READ_SIZE 16
+#define ERASE_SIZE 256
+#define DEVICE_SIZE (ERASE_SIZE * 16)
+
+using namespace mbed;
+
+static uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// LZSS with window_sz2 8 and lookahead_sz2 4, back-references only for
+// runs of a byte
+static std::vector<uint8_t> compress(const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> out;
+    uint32_t bits = 0;
+    int nbits = 0;
+    auto push = [&](uint32_t value, int count) {
+        bits = (bits << count) | value;
+        nbits += count;
+        while (nbits >= 8) {
+            out.push_back(bits >> (nbits - 8));
+            nbits -= 8;
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t run = 0;
+        while (pos > 0 && pos + run < data.size() && run < 16 && data[pos + run] == data[pos - 1]) {
+            run++;
+        }
+        if (run >= 2) {
+            push(0, 1);
+            push(0, 8);             // offset 1
+            push(run - 1, 4);
+            pos += run;
+        } else {
+            push(1, 1);
+            push(data[pos++], 8);
+        }
+    }
+    if (nbits) {
+        push(0, 8 - nbits);
+    }
+    return out;
+}
+
+// Image builder, as tools/imagefs.py
+static std::vector<uint8_t> build(std::map<std::string, std::vector<uint8_t>> files,
+                                  std::vector<std::string> dirs, bool compressed = true)
+{
+    struct item {
+        std::string path;
+        bool dir;
+    };
+    std::vector<item> items;
+    for (auto &f : files) {
+        items.push_back({f.first, false});
+    }
+    for (auto &d : dirs) {
+        items.push_back({d, true});
+    }
+    auto key = [](std::string path) {
+        std::replace(path.begin(), path.end(), '/', '\0');
+        return path;
+    };
+    std::sort(items.begin(), items.end(), [&](const item & a, const item & b) {
+        return key(a.path) < key(b.path);
+    });
+
+    std::vector<ImageFileSystem::entry_t> entries;
+    std::string names;
+    std::vector<std::pair<std::vector<uint8_t>, bool>> blocks;
+    for (size_t i = 0; i < items.size(); i++) {
+        ImageFileSystem::entry_t e = {(uint32_t)names.size(), (uint16_t)items[i].path.size(), 0, 0, 0, 0};
+        if (items[i].dir) {
+            e.type = 2;
+            std::string prefix = items[i].path + "/";
+            for (size_t j = i + 1; j < items.size() && items[j].path.compare(0, prefix.size(), prefix) == 0; j++) {
+                e.size++;
+            }
+        } else {
+            const std::vector<uint8_t> &data = files[items[i].path];
+            e.type = 1;
+            e.size = data.size();
+            e.first_block = blocks.size();
+            for (size_t pos = 0; pos < data.size(); pos += BLOCK_SIZE) {
+                std::vector<uint8_t> block(data.begin() + pos, data.begin() + std::min<size_t>(pos + BLOCK_SIZE, data.size()));
+                std::vector<uint8_t> packed = compress(block);
+                if (compressed && packed.size() < block.size()) {
+                    blocks.push_back({packed, false});
+                } else {
+                    blocks.push_back({block, true});
+                }
+            }
+        }
+        entries.push_back(e);
+        names += items[i].path;
+    }
+
+    ImageFileSystem::header_t h = {
+        0x5346494D, 1, (uint8_t)(compressed ? 1 : 0), 8, 4, BLOCK_SIZE, (uint32_t)entries.size(), 0, 0,
+        (uint32_t)blocks.size(), 0, 0
+    };
+    h.names_offset = sizeof(h) + entries.size() * sizeof(ImageFileSystem::entry_t);
+    h.blocks_offset = (h.names_offset + names.size() + 3) & ~3;
+
+    std::vector<uint8_t> image(h.blocks_offset + 4 * (blocks.size() + 1));
+    memcpy(&image[sizeof(h)], entries.data(), entries.size() * sizeof(ImageFileSystem::entry_t));
+    memcpy(&image[h.names_offset], names.data(), names.size());
+    uint32_t offset = image.size();
+    for (size_t i = 0; i <= blocks.size(); i++) {
+        uint32_t value = offset;
+        if (i < blocks.size()) {
+            value |= blocks[i].second ? 0x80000000 : 0;
+            offset += blocks[i].first.size();
+        }
+        memcpy(&image[h.blocks_offset + 4 * i], &value, 4);
+    }
+    for (auto &b : blocks) {
+        image.insert(image.end(), b.first.begin(), b.first.end());
+    }
+    h.image_size = image.size();
+    memcpy(&image[0], &h, sizeof(h));
+    h.crc = crc32(&image[0], h.blocks_offset + 4 * (blocks.size() + 1));
+    memcpy(&image[0], &h, sizeof(h));
+    return image;
+}
+
+class ImageFileSystemTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        for (int i = 0; i < 300; i++) {
+            text.push_back("abcdefgh"[i % 8]);
+        }
+        for (int i = 0; i < 200; i++) {
+            runs.push_back(i / 20);
+        }
+        for (int i = 0; i < 150; i++) {
+            noise.push_back(i * 37 + (i >> 2));
+        }
+        files["www/index.html"] = text;
+        files["www/img/logo.bin"] = runs;
+        files["www-old.txt"] = noise;
+        files["www/a"] = {'x'};
+        files["empty"] = {};
+        dirs = {"www", "www/img", "fonts"};
+    }
+
+    std::vector<uint8_t> read_all(ImageFileSystem &fs, const char *path, size_t chunk = 1000)
+    {
+        File f;
+        std::vector<uint8_t> data;
+        EXPECT_EQ(f.open(&fs, path), 0);
+        std::vector<uint8_t> buf(chunk);
+        ssize_t res;
+        while ((res = f.read(buf.data(), chunk)) > 0) {
+            data.insert(data.end(), buf.begin(), buf.begin() + res);
+        }
+        EXPECT_EQ(res, 0);
+        f.close();
+        return data;
+    }
+
+    std::vector<std::string> list(ImageFileSystem &fs, const char *path)
+    {
+        Dir dir;
+        std::vector<std::string> names;
+        EXPECT_EQ(dir.open(&fs, path), 0);
+        struct dirent ent;
+        while (dir.read(&ent) > 0) {
+            names.push_back(std::string(ent.d_name) + (ent.d_type == DT_DIR ? "/" : ""));
+        }
+        dir.close();
+        return names;
+    }
+
+    void program(const std::vector<uint8_t> &image)
+    {
+        std::vector<uint8_t> padded(image);
+        padded.resize((image.size() + ERASE_SIZE - 1) / ERASE_SIZE * ERASE_SIZE, 0xFF);
+        bd.init();
+        bd.program(padded.data(), 0, padded.size());
+        bd.deinit();
+    }
+
+    HeapBlockDevice bd{DEVICE_SIZE, READ_SIZE, READ_SIZE, ERASE_SIZE};
+    std::vector<uint8_t> text, runs, noise;
+    std::map<std::string, std::vector<uint8_t>> files;
+    std::vector<std::string> dirs;
+};
+
+TEST_F(ImageFileSystemTest, memory_mapped)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    ImageFileSystem fs("img", image.data(), image.size());
+
+    for (auto &f : files) {
+        EXPECT_EQ(read_all(fs, f.first.c_str()), f.second) << f.first;
+        // small reads cross block boundaries
+        EXPECT_EQ(read_all(fs, f.first.c_str(), 7), f.second) << f.first;
+    }
+}
+
+TEST_F(ImageFileSystemTest, block_device)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    program(image);
+    ImageFileSystem fs("img", &bd);
+
+    for (auto &f : files) {
+        EXPECT_EQ(read_all(fs, f.first.c_str(), 13), f.second) << f.first;
+    }
+}
+
+TEST_F(ImageFileSystemTest, uncompressed)
+{
+    std::vector<uint8_t> image = build(files, dirs, false);
+    program(image);
+    ImageFileSystem mapped("mapped", image.data(), image.size());
+    ImageFileSystem fs("img", &bd);
+
+    for (auto &f : files) {
+        EXPECT_EQ(read_all(mapped, f.first.c_str(), 11), f.second) << f.first;
+        EXPECT_EQ(read_all(fs, f.first.c_str(), 11), f.second) << f.first;
+    }
+}
+
+TEST_F(ImageFileSystemTest, directories)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    ImageFileSystem fs("img", image.data(), image.size());
+
+    std::vector<std::string> root = {"empty", "fonts/", "www/", "www-old.txt"};
+    std::vector<std::string> www = {"a", "img/", "index.html"};
+    EXPECT_EQ(list(fs, "/"), root);
+    EXPECT_EQ(list(fs, "www"), www);
+    EXPECT_EQ(list(fs, "/www/img/"), std::vector<std::string>({"logo.bin"}));
+    EXPECT_EQ(list(fs, "fonts"), std::vector<std::string>());
+
+    Dir dir;
+    EXPECT_EQ(dir.open(&fs, "www/index.html"), -ENOTDIR);
+    EXPECT_EQ(dir.open(&fs, "missing"), -ENOENT);
+
+    EXPECT_EQ(dir.open(&fs, "www"), 0);
+    struct dirent ent;
+    EXPECT_EQ(dir.read(&ent), 1);
+    off_t pos = dir.tell();
+    EXPECT_EQ(dir.read(&ent), 1);
+    EXPECT_STREQ(ent.d_name, "img");
+    dir.seek(pos);
+    EXPECT_EQ(dir.read(&ent), 1);
+    EXPECT_STREQ(ent.d_name, "img");
+    dir.rewind();
+    EXPECT_EQ(dir.read(&ent), 1);
+    EXPECT_STREQ(ent.d_name, "a");
+    dir.close();
+}
+
+TEST_F(ImageFileSystemTest, stat_and_seek)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    ImageFileSystem fs("img", image.data(), image.size());
+
+    struct mbed::stat st;
+    EXPECT_EQ(fs.stat("www/index.html", &st), 0);
+    EXPECT_TRUE(S_ISREG(st.st_mode));
+    EXPECT_EQ(st.st_size, (off_t)text.size());
+    EXPECT_EQ(fs.stat("www/img", &st), 0);
+    EXPECT_TRUE(S_ISDIR(st.st_mode));
+    EXPECT_EQ(fs.stat("www/im", &st), -ENOENT);
+    EXPECT_EQ(fs.stat("zzz", &st), -ENOENT);
+
+    File f;
+    EXPECT_EQ(f.open(&fs, "www/img/logo.bin"), 0);
+    EXPECT_EQ(f.size(), (off_t)runs.size());
+    uint8_t buf[10];
+    EXPECT_EQ(f.seek(125, SEEK_SET), 125);
+    EXPECT_EQ(f.read(buf, sizeof(buf)), 10);
+    EXPECT_EQ(0, memcmp(buf, &runs[125], 10));
+    EXPECT_EQ(f.seek(-5, SEEK_END), (off_t)runs.size() - 5);
+    EXPECT_EQ(f.read(buf, sizeof(buf)), 5);
+    EXPECT_EQ(0, memcmp(buf, &runs[runs.size() - 5], 5));
+    EXPECT_EQ(f.read(buf, sizeof(buf)), 0);
+    EXPECT_EQ(f.seek(-1000, SEEK_CUR), -EINVAL);
+    f.close();
+
+    struct mbed::statvfs vfs;
+    EXPECT_EQ(fs.statvfs("/", &vfs), 0);
+    EXPECT_EQ(vfs.f_bsize, (unsigned long)BLOCK_SIZE);
+    EXPECT_EQ(vfs.f_bfree, 0u);
+}
+
+TEST_F(ImageFileSystemTest, read_only)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    ImageFileSystem fs("img", image.data(), image.size());
+
+    File f;
+    EXPECT_EQ(f.open(&fs, "www/a", O_RDWR), -EROFS);
+    EXPECT_EQ(f.open(&fs, "new", O_WRONLY | O_CREAT), -EROFS);
+    EXPECT_EQ(f.open(&fs, "new", O_RDONLY | O_CREAT), -EROFS);
+    EXPECT_EQ(f.open(&fs, "www"), -EISDIR);
+    EXPECT_EQ(f.open(&fs, "www/a"), 0);
+    EXPECT_EQ(f.write("y", 1), -EBADF);
+    f.close();
+
+    EXPECT_EQ(fs.remove("www/a"), -EROFS);
+    EXPECT_EQ(fs.rename("www/a", "www/b"), -EROFS);
+    EXPECT_EQ(fs.mkdir("dir", 0777), -EROFS);
+    EXPECT_EQ(fs.reformat(&bd), -EROFS);
+}
+
+TEST_F(ImageFileSystemTest, corrupt)
+{
+    std::vector<uint8_t> image = build(files, dirs);
+    ImageFileSystem fs;
+    image[sizeof(ImageFileSystem::header_t) + 3] ^= 1;
+    EXPECT_EQ(fs.mount(image.data(), image.size()), -EILSEQ);
+    image[sizeof(ImageFileSystem::header_t) + 3] ^= 1;
+    EXPECT_EQ(fs.mount(image.data(), image.size()), 0);
+    EXPECT_EQ(fs.unmount(), 0);
+
+    // truncated image
+    image.resize(image.size() - 1);
+    EXPECT_EQ(fs.mount(image.data(), image.size()), -EILSEQ);
+
+    // blank device
+    EXPECT_EQ(fs.mount(&bd), -EILSEQ);
+}
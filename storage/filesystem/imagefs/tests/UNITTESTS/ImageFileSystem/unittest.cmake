@@ -0,0 +1,40 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  .
+  ..
+  ../storage/blockdevice/include
+  ../storage/filesystem/include
+  ../storage/filesystem/imagefs/include
+)
+
+set(unittest-sources
+  ../storage/blockdevice/source/HeapBlockDevice.cpp
+  ../storage/filesystem/imagefs/source/ImageFileSystem.cpp
+  ../storage/filesystem/source/Dir.cpp
+  ../storage/filesystem/source/File.cpp
+  ../storage/filesystem/source/FileSystem.cpp
+  ../platform/source/FileBase.cpp
+  ../platform/source/FileSystemHandle.cpp
+  ../platform/source/FileHandle.cpp
+  ../drivers/source/MbedCRC.cpp
+)
+
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/test.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_error.c
+  stubs/mbed_retarget_stub.cpp
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_IMAGEFS_CACHE_BLOCKS=2
+  -DMBED_CONF_IMAGEFS_READ_BUFFER_SIZE=256
+  -DMBED_CRC_TABLE_SIZE=16
+  -DMBED_CRC_SLICES=8
+)
@@ -46,6 +46,18 @@ public:
      */
     File(FileSystem *fs, const char *path, int flags = O_RDONLY);
 
+    /** Create a file on a filesystem with buffering hints
+     *
+     *  Creates and opens a file on a filesystem
+     *
+     *  @param fs       Filesystem as target for the file
+     *  @param path     The name of the file to open
+     *  @param flags    The flags to open the file in, one of O_RDONLY, O_WRONLY, O_RDWR,
+     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND
+     *  @param options  Buffering hints for the file, see FileSystem::file_options
+     */
+    File(FileSystem *fs, const char *path, int flags, const FileSystem::file_options &options);
+
     /** Destroy a file
      *
      *  Closes file if the file is still open
@@ -62,6 +74,17 @@ public:
      */
     virtual int open(FileSystem *fs, const char *path, int flags = O_RDONLY);
 
+    /** Open a file on the filesystem with buffering hints
+     *
+     *  @param fs       Filesystem as target for the file
+     *  @param path     The name of the file to open
+     *  @param flags    The flags to open the file in, one of O_RDONLY, O_WRONLY, O_RDWR,
+     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND
+     *  @param options  Buffering hints for the file, see FileSystem::file_options
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int open(FileSystem *fs, const char *path, int flags, const FileSystem::file_options &options);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -138,6 +161,19 @@ public:
      */
     virtual int truncate(off_t length);
 
+    /** Reserve contiguous storage for an empty file
+     *
+     * The file's length is set to the specified value, with undefined
+     * contents. Write the file from the start and truncate it to the
+     * written length once done, so that the writes are contiguous.
+     *
+     *  @param length   The length to reserve
+     *
+     *  @return         Zero on success, -ENOSPC if there is no contiguous
+     *                  free area large enough, negative error code on failure
+     */
+    virtual int reserve(off_t length);
+
 private:
     FileSystem *_fs;
     fs_file_t _file;
@@ -48,6 +48,31 @@ class File;
  */
 class FileSystem : public FileSystemLike {
 public:
+    /** Buffering hints given when opening a file
+     *
+     *  File systems that don't support a hint ignore it.
+     */
+    struct file_options {
+        /** Buffer for the cache of the file, or NULL to allocate it */
+        void *cache;
+
+        /** Size of the cache of the file in bytes, 0 for the default
+         *  size of the file system
+         */
+        size_t cache_size;
+
+        /** The file is mostly read or written sequentially. The file
+         *  system may then give it a larger cache, so that it is
+         *  accessed in bursts of the size of an erase block.
+         */
+        bool sequential;
+
+        /** The file is mostly read at random offsets. The file system may
+         *  then index the allocation of a file opened read only, so that
+         *  seeks don't walk it.
+         */
+        bool random;
+    };
 
     /** File system lifetime.
      *
@@ -132,6 +157,22 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Perform a bounded step of background maintenance
+     *
+     *  Passes the blocks the file system doesn't use to BlockDevice::trim,
+     *  scanning the next part of the device at each call, so that the block
+     *  device can prepare them for reuse. Meant to be called from idle time,
+     *  see StorageMaintenance.
+     *
+     *  @param max_size Maximum size of the device to scan in this call in bytes,
+     *                  at least one block is scanned
+     *  @param done     If not NULL, set to true when this call completed a pass
+     *                  over the whole device
+     *  @return         0 on success, -ENOSYS if the file system needs no maintenance,
+     *                  negative error code on failure.
+     */
+    virtual int maintenance_step(bd_size_t max_size, bool *done = NULL);
+
 protected:
     friend class File;
     friend class Dir;
@@ -147,6 +188,18 @@ protected:
      */
     virtual int file_open(fs_file_t *file, const char *path, int flags) = 0;
 
+    /** Open a file on the file system with buffering hints.
+     *
+     *  The default implementation ignores the hints.
+     *
+     *  @param file     Destination of the newly created handle to the referenced file.
+     *  @param path     The name of the file to open.
+     *  @param flags    The flags that trigger opening of the file.
+     *  @param options  Buffering hints for the file.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_open(fs_file_t *file, const char *path, int flags, const file_options &options);
+
     /** Close a file.
      *
      *  @param file     File handle.
@@ -233,6 +286,20 @@ protected:
      */
     virtual int file_truncate(fs_file_t file, off_t length);
 
+    /** Reserve contiguous storage for an empty file.
+     *
+     * The file's length is set to the specified value, with undefined
+     * contents. Write the file from the start and truncate it to the
+     * written length once done.
+     *
+     *  @param file     File handle.
+     *  @param length   The length to reserve.
+     *
+     *  @return         0 on success, -ENOSPC if there is no contiguous free
+     *                  area large enough, negative error code on failure.
+     */
+    virtual int file_reserve(fs_file_t file, off_t length);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
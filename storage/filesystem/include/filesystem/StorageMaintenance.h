@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_STORAGE_MAINTENANCE_H
+#define MBED_STORAGE_MAINTENANCE_H
+
+#include "filesystem/FileSystem.h"
+#include "blockdevice/PreEraseBlockDevice.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** Background maintenance of a file system and its block device
+ *
+ *  Each step trims the blocks the file system doesn't use in the next part
+ *  of the device, see FileSystem::maintenance_step, and erases trimmed
+ *  blocks ahead of their reuse when the file system is mounted on a
+ *  PreEraseBlockDevice. Interactive writes then find erased blocks.
+ *
+ *  Steps are bounded, and are meant to be called from idle time, for
+ *  example from a low priority EventQueue:
+ *
+ *  @code
+ *  PreEraseBlockDevice pre_erase(&flash);
+ *  LittleFileSystem2 fs("fs", &pre_erase);
+ *  StorageMaintenance maintenance(&fs, &pre_erase);
+ *
+ *  void maintain()
+ *  {
+ *      bool done;
+ *      if (maintenance.step(&done) == 0 && !done) {
+ *          low_priority_queue.call(maintain);
+ *      }
+ *  }
+ *  @endcode
+ *
+ *  Once done, a new pass over the device is started with restart.
+ *
+ *  @note Synchronization level: step is not thread safe, abort and
+ *        get_progress may be called from any thread
+ */
+class StorageMaintenance : private NonCopyable<StorageMaintenance> {
+public:
+    /** Progress of the maintenance */
+    struct progress_t {
+        uint32_t passes;        ///< Passes completed over the device
+        bd_size_t scanned;      ///< Size of the device scanned in the current pass
+        bool erase_pending;     ///< Trimmed blocks are waiting to be erased
+        bool aborted;           ///< Aborted, steps do nothing until restart
+    };
+
+    /** Create the maintenance of a file system
+     *
+     *  @param fs           Mounted file system
+     *  @param pre_erase    If not NULL, the block device under the file system
+     *                      that erases trimmed blocks
+     *  @param step_size    Size of the device scanned, and at most erased, by
+     *                      each step in bytes
+     */
+    StorageMaintenance(FileSystem *fs, PreEraseBlockDevice *pre_erase = NULL,
+                       bd_size_t step_size = MBED_CONF_FILESYSTEM_MAINTENANCE_STEP_SIZE);
+
+    /** Perform a bounded step of maintenance
+     *
+     *  @param done     If not NULL, set to true once the current pass is
+     *                  complete and no trimmed block is left to erase
+     *  @return         0 on success, -ECANCELED if aborted, or a negative
+     *                  error code on failure
+     */
+    int step(bool *done = NULL);
+
+    /** Stop the maintenance
+     *
+     *  A step in progress completes, and the following ones do nothing
+     *  until restart is called.
+     */
+    void abort();
+
+    /** Start a new pass over the device, clearing an abort
+     */
+    void restart();
+
+    /** Get the progress of the maintenance
+     *
+     *  @param progress Set to the progress
+     */
+    void get_progress(progress_t *progress) const;
+
+private:
+    FileSystem *_fs;
+    PreEraseBlockDevice *_pre_erase;
+    const bd_size_t _step_size;
+    uint32_t _passes;
+    bd_size_t _scanned;
+    bool _pass_done;
+    bool _erase_pending;
+    volatile bool _aborted;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::StorageMaintenance;
+#endif
+
+#endif
+
+/** @}*/
@@ -157,6 +157,19 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Trim the unused blocks of the next part of the block device
+     *
+     *  Each call finds the blocks in use by traversing the file system, and
+     *  trims the unused blocks in the next max_size bytes of the device.
+     *
+     *  @param max_size Maximum size of the device to scan in this call in bytes,
+     *                  at least one block is scanned
+     *  @param done     If not NULL, set to true when this call completed a pass
+     *                  over the whole device
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int maintenance_step(bd_size_t max_size, bool *done = NULL);
+
 protected:
 #if !(DOXYGEN_ONLY)
     /** Open a file on the file system.
@@ -289,6 +302,7 @@ private:
     lfs_t _lfs; // The actual file system
     struct lfs_config _config;
     mbed::BlockDevice *_bd; // The block device
+    lfs_block_t _trim_next; // Where maintenance_step resumes
 
     // default parameters
     const lfs_size_t _read_size;
@@ -125,6 +125,7 @@ static inline void lfs_cache_zero(lfs_t *lfs, lfs_cache_t *pcache) {
 static int lfs_cache_flush(lfs_t *lfs,
         lfs_cache_t *pcache, lfs_cache_t *rcache) {
     if (pcache->block != 0xffffffff) {
+        lfs_cache_drop(lfs, &lfs->fcache);
         int err = lfs->cfg->prog(lfs->cfg, pcache->block,
                 pcache->off, pcache->buffer, lfs->cfg->prog_size);
         if (err) {
@@ -186,6 +187,7 @@ static int lfs_cache_prog(lfs_t *lfs, lfs_cache_t *pcache,
                 size >= lfs->cfg->prog_size) {
             // bypass pcache?
             lfs_size_t diff = size - (size % lfs->cfg->prog_size);
+            lfs_cache_drop(lfs, &lfs->fcache);
             int err = lfs->cfg->prog(lfs->cfg, block, off, data, diff);
             if (err) {
                 return err;
@@ -244,6 +246,8 @@ static int lfs_bd_crc(lfs_t *lfs, lfs_block_t block,
 }
 
 static int lfs_bd_erase(lfs_t *lfs, lfs_block_t block) {
+    // the shared file cache only reads, so is not kept in sync otherwise
+    lfs_cache_drop(lfs, &lfs->fcache);
     return lfs->cfg->erase(lfs->cfg, block);
 }
 
@@ -505,8 +509,17 @@ struct lfs_region {
     lfs_size_t newlen;
 };
 
+static void lfs_name_cache_drop(lfs_t *lfs) {
+    for (lfs_size_t i = 0; i < lfs->cfg->name_cache_size; i++) {
+        lfs->name_cache[i].path[0] = '\0';
+    }
+}
+
 static int lfs_dir_commit(lfs_t *lfs, lfs_dir_t *dir,
         const struct lfs_region *regions, int count) {
+    // entries may move or change, forget cached lookups
+    lfs_name_cache_drop(lfs);
+
     // increment revision count
     dir->d.rev += 1;
 
@@ -902,6 +915,42 @@ nextname:
     }
 }
 
+static int lfs_dir_findcached(lfs_t *lfs, lfs_dir_t *dir,
+        lfs_entry_t *entry, const char **path) {
+    // only the pair of the directory is valid on a hit, and the
+    // path is left untouched
+    const char *key = *path;
+    lfs_size_t len = strlen(key);
+    bool cacheable = lfs->cfg->name_cache_size > 0 &&
+            len > 0 && len <= LFS_NAME_CACHE_PATH_MAX;
+
+    if (cacheable) {
+        for (lfs_size_t i = 0; i < lfs->cfg->name_cache_size; i++) {
+            lfs_name_cache_t *c = &lfs->name_cache[i];
+            if (strcmp(c->path, key) == 0) {
+                dir->pair[0] = c->pair[0];
+                dir->pair[1] = c->pair[1];
+                *entry = c->entry;
+                return 0;
+            }
+        }
+    }
+
+    int err = lfs_dir_find(lfs, dir, entry, path);
+    if (err || !cacheable) {
+        return err;
+    }
+
+    lfs_name_cache_t *c = &lfs->name_cache[lfs->name_cache_next];
+    lfs->name_cache_next = (lfs->name_cache_next + 1)
+            % lfs->cfg->name_cache_size;
+    memcpy(c->path, key, len+1);
+    c->pair[0] = dir->pair[0];
+    c->pair[1] = dir->pair[1];
+    c->entry = *entry;
+    return 0;
+}
+
 
 /// Top level directory operations ///
 int lfs_mkdir(lfs_t *lfs, const char *path) {
@@ -1305,7 +1354,7 @@ int lfs_file_opencfg(lfs_t *lfs, lfs_file_t *file,
     // allocate entry for file if it doesn't exist
     lfs_dir_t cwd;
     lfs_entry_t entry;
-    int err = lfs_dir_find(lfs, &cwd, &entry, &path);
+    int err = lfs_dir_findcached(lfs, &cwd, &entry, &path);
     if (err && (err != LFS_ERR_NOENT || strchr(path, '/') != NULL)) {
         return err;
     }
@@ -1354,6 +1403,11 @@ int lfs_file_opencfg(lfs_t *lfs, lfs_file_t *file,
     file->cache.block = 0xffffffff;
     if (file->cfg && file->cfg->buffer) {
         file->cache.buffer = file->cfg->buffer;
+    } else if ((file->flags & 3) == LFS_O_RDONLY &&
+            lfs->cfg->shared_file_cache) {
+        // read through the cache shared by read-only files
+        file->cache.buffer = NULL;
+        file->flags |= LFS_F_SHARED;
     } else if (lfs->cfg->file_buffer) {
         if (lfs->files) {
             // already in use
@@ -1402,13 +1456,18 @@ int lfs_file_close(lfs_t *lfs, lfs_file_t *file) {
     }
 
     // clean up memory
-    if (!(file->cfg && file->cfg->buffer) && !lfs->cfg->file_buffer) {
+    if (!(file->cfg && file->cfg->buffer) && !lfs->cfg->file_buffer &&
+            !(file->flags & LFS_F_SHARED)) {
         lfs_free(file->cache.buffer);
     }
 
     return err;
 }
 
+static inline lfs_cache_t *lfs_file_rcache(lfs_t *lfs, lfs_file_t *file) {
+    return (file->flags & LFS_F_SHARED) ? &lfs->fcache : &file->cache;
+}
+
 static int lfs_file_relocate(lfs_t *lfs, lfs_file_t *file) {
 relocate:
     LFS_DEBUG("Bad block at %" PRIu32, file->block);
@@ -1596,7 +1655,7 @@ lfs_ssize_t lfs_file_read(lfs_t *lfs, lfs_file_t *file,
         // check if we need a new block
         if (!(file->flags & LFS_F_READING) ||
                 file->off == lfs->cfg->block_size) {
-            int err = lfs_ctz_find(lfs, &file->cache, NULL,
+            int err = lfs_ctz_find(lfs, lfs_file_rcache(lfs, file), NULL,
                     file->head, file->size,
                     file->pos, &file->block, &file->off);
             if (err) {
@@ -1608,7 +1667,7 @@ lfs_ssize_t lfs_file_read(lfs_t *lfs, lfs_file_t *file,
 
         // read as much as we can in current block
         lfs_size_t diff = lfs_min(nsize, lfs->cfg->block_size - file->off);
-        int err = lfs_cache_read(lfs, &file->cache, NULL,
+        int err = lfs_cache_read(lfs, lfs_file_rcache(lfs, file), NULL,
                 file->block, file->off, data, diff);
         if (err) {
             return err;
@@ -1835,7 +1894,7 @@ lfs_soff_t lfs_file_size(lfs_t *lfs, lfs_file_t *file) {
 int lfs_stat(lfs_t *lfs, const char *path, struct lfs_info *info) {
     lfs_dir_t cwd;
     lfs_entry_t entry;
-    int err = lfs_dir_find(lfs, &cwd, &entry, &path);
+    int err = lfs_dir_findcached(lfs, &cwd, &entry, &path);
     if (err) {
         return err;
     }
@@ -2033,10 +2092,15 @@ static void lfs_deinit(lfs_t *lfs) {
     if (!lfs->cfg->lookahead_buffer) {
         lfs_free(lfs->free.buffer);
     }
+
+    lfs_free(lfs->fcache.buffer);
+    lfs_free(lfs->name_cache);
 }
 
 static int lfs_init(lfs_t *lfs, const struct lfs_config *cfg) {
     lfs->cfg = cfg;
+    lfs->fcache.buffer = NULL;
+    lfs->name_cache = NULL;
 
     // setup read cache
     if (lfs->cfg->read_buffer) {
@@ -2058,9 +2122,29 @@ static int lfs_init(lfs_t *lfs, const struct lfs_config *cfg) {
         }
     }
 
+    // setup cache shared by read-only files
+    if (lfs->cfg->shared_file_cache) {
+        lfs->fcache.buffer = lfs_malloc(lfs->cfg->read_size);
+        if (!lfs->fcache.buffer) {
+            goto cleanup;
+        }
+    }
+
     // zero to avoid information leaks
     lfs_cache_zero(lfs, &lfs->pcache);
     lfs_cache_drop(lfs, &lfs->rcache);
+    lfs_cache_drop(lfs, &lfs->fcache);
+
+    // setup name cache
+    if (lfs->cfg->name_cache_size) {
+        lfs->name_cache = lfs_malloc(
+                lfs->cfg->name_cache_size*sizeof(lfs_name_cache_t));
+        if (!lfs->name_cache) {
+            goto cleanup;
+        }
+    }
+    lfs->name_cache_next = 0;
+    lfs_name_cache_drop(lfs);
 
     // setup lookahead, round down to nearest 32-bits
     LFS_ASSERT(lfs->cfg->lookahead % 32 == 0);
@@ -95,6 +95,7 @@ enum lfs_open_flags {
     LFS_F_WRITING = 0x20000, // File has been written since last flush
     LFS_F_READING = 0x40000, // File has been read since last flush
     LFS_F_ERRED   = 0x80000, // An error occurred during write
+    LFS_F_SHARED  = 0x100000, // File reads through the shared file cache
 };
 
 // File seek flags
@@ -171,6 +172,19 @@ struct lfs_config {
     // Optional, statically allocated buffer for files. Must be program sized.
     // If enabled, only one file may be opened at a time.
     void *file_buffer;
+
+    // Optional, share one read cache among all files opened read-only,
+    // instead of allocating a read buffer for each of them. Files reading
+    // the same blocks then hit the same cache. Does not apply to files
+    // opened with their own buffer.
+    bool shared_file_cache;
+
+    // Optional, number of recently looked up paths whose directory entries
+    // are kept in RAM, so that opening or stat-ing them again does not
+    // fetch their directories. Any directory update forgets them. Paths
+    // longer than LFS_NAME_CACHE_PATH_MAX are not cached. Zero disables
+    // the cache.
+    lfs_size_t name_cache_size;
 };
 
 // Optional configuration provided during lfs_file_opencfg
@@ -265,6 +279,17 @@ typedef struct lfs_superblock {
     } d;
 } lfs_superblock_t;
 
+// Maximum length of a path kept in the name cache
+#ifndef LFS_NAME_CACHE_PATH_MAX
+#define LFS_NAME_CACHE_PATH_MAX 32
+#endif
+
+typedef struct lfs_name_cache {
+    lfs_block_t pair[2];
+    lfs_entry_t entry;
+    char path[LFS_NAME_CACHE_PATH_MAX+1];
+} lfs_name_cache_t;
+
 typedef struct lfs_free {
     lfs_block_t off;
     lfs_block_t size;
@@ -283,6 +308,10 @@ typedef struct lfs {
 
     lfs_cache_t rcache;
     lfs_cache_t pcache;
+    lfs_cache_t fcache;
+
+    lfs_name_cache_t *name_cache;
+    lfs_size_t name_cache_next;
 
     lfs_free_t free;
     bool deorphaned;
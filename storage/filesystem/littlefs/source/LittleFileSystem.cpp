@@ -26,9 +26,14 @@ extern "C" void lfs_crc(uint32_t *crc, const void *buffer, size_t size)
 {
     uint32_t initial_xor = lfs_rbit(*crc);
     // lfs_cache_crc calls lfs_crc for every byte individually, so can't afford
-    // start-up overhead for hardware acceleration. Limit to table-based.
-    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> ct(initial_xor, 0x0, true, true);
-    ct.compute(buffer, size, crc);
+    // start-up overhead for hardware acceleration on small buffers.
+    if (size >= MBED_LFS_CRC_HARDWARE_THRESHOLD) {
+        MbedCRC<POLY_32BIT_ANSI, 32> ct(initial_xor, 0x0, true, true);
+        ct.compute(buffer, size, crc);
+    } else {
+        MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> ct(initial_xor, 0x0, true, true);
+        ct.compute(buffer, size, crc);
+    }
 }
 
 ////// Conversion functions //////
@@ -150,6 +155,7 @@ LittleFileSystem::LittleFileSystem(const char *name, BlockDevice *bd,
     , _lfs()
     , _config()
     , _bd(NULL)
+    , _trim_next(0)
     , _read_size(read_size)
     , _prog_size(prog_size)
     , _block_size(block_size)
@@ -202,6 +208,8 @@ int LittleFileSystem::mount(BlockDevice *bd)
     if (_config.lookahead > _lookahead) {
         _config.lookahead = _lookahead;
     }
+    _config.shared_file_cache = MBED_LFS_SHARED_FILE_CACHE;
+    _config.name_cache_size = MBED_LFS_NAME_CACHE_SIZE;
 
     err = lfs_mount(&_lfs, &_config);
     if (err) {
@@ -410,6 +418,77 @@ int LittleFileSystem::statvfs(const char *name, struct statvfs *st)
     return 0;
 }
 
+// Blocks in use within the part of the device scanned by a maintenance step
+#define LFS_MAINTENANCE_WINDOW 256
+
+struct lfs_maintenance_window {
+    lfs_block_t first;
+    lfs_block_t count;
+    uint32_t used[LFS_MAINTENANCE_WINDOW / 32];
+};
+
+static int lfs_maintenance_mark(void *p, lfs_block_t b)
+{
+    lfs_maintenance_window *window = (lfs_maintenance_window *)p;
+    lfs_block_t i = b - window->first;
+    if (i < window->count) {
+        window->used[i / 32] |= 1u << (i % 32);
+    }
+    return 0;
+}
+
+int LittleFileSystem::maintenance_step(bd_size_t max_size, bool *done)
+{
+    _mutex.lock();
+    LFS_INFO("maintenance_step(%llu, %p)", max_size, done);
+    if (!_bd) {
+        _mutex.unlock();
+        return -EINVAL;
+    }
+
+    lfs_maintenance_window window;
+    memset(&window, 0, sizeof(window));
+    window.first = (_trim_next < _config.block_count) ? _trim_next : 0;
+    bd_size_t count = max_size / _config.block_size;
+    if (count < 1) {
+        count = 1;
+    }
+    if (count > LFS_MAINTENANCE_WINDOW) {
+        count = LFS_MAINTENANCE_WINDOW;
+    }
+    if (count > _config.block_count - window.first) {
+        count = _config.block_count - window.first;
+    }
+    window.count = count;
+
+    // The file system is locked from the traversal to the trims, so blocks
+    // found unused can't be allocated in between
+    int res = lfs_toerror(lfs_traverse(&_lfs, lfs_maintenance_mark, &window));
+    for (lfs_block_t i = 0; !res && i < window.count;) {
+        if (window.used[i / 32] & (1u << (i % 32))) {
+            i++;
+            continue;
+        }
+        lfs_block_t j = i + 1;
+        while (j < window.count && !(window.used[j / 32] & (1u << (j % 32)))) {
+            j++;
+        }
+        res = _bd->trim((bd_addr_t)(window.first + i) * _config.block_size,
+                        (bd_size_t)(j - i) * _config.block_size);
+        i = j;
+    }
+
+    if (!res) {
+        _trim_next = window.first + window.count;
+        if (done) {
+            *done = (_trim_next >= _config.block_count);
+        }
+    }
+    LFS_INFO("maintenance_step -> %d", res);
+    _mutex.unlock();
+    return res;
+}
+
 ////// File operations //////
 int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
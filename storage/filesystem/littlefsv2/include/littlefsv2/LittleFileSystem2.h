@@ -30,6 +30,14 @@ namespace mbed {
 /**
  * LittleFileSystem2, a little file system
  *
+ * With the littlefs2.persist_lookahead option, unmount stores the lookahead
+ * buffer in the root directory, and the next mount takes it back instead of
+ * scanning the filesystem on the first allocation.
+ *
+ * Files opened with FileSystem::file_options can have a cache of their own
+ * size, so that littlefs2.cache_size can stay small for the many small files
+ * while streamed files are read and programmed in larger bursts.
+ *
  * Synchronization level: Thread safe
  */
 class LittleFileSystem2 : public mbed::FileSystem {
@@ -159,6 +167,19 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Trim the unused blocks of the next part of the block device
+     *
+     *  Each call finds the blocks in use by traversing the file system, and
+     *  trims the unused blocks in the next max_size bytes of the device.
+     *
+     *  @param max_size Maximum size of the device to scan in this call in bytes,
+     *                  at least one block is scanned
+     *  @param done     If not NULL, set to true when this call completed a pass
+     *                  over the whole device
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int maintenance_step(bd_size_t max_size, bool *done = NULL);
+
 protected:
 #if !(DOXYGEN_ONLY)
     /** Open a file on the file system.
@@ -171,6 +192,21 @@ protected:
      */
     virtual int file_open(mbed::fs_file_t *file, const char *path, int flags);
 
+    /** Open a file on the file system with buffering hints.
+     *
+     *  A cache size, when given, must be a multiple of the read and program
+     *  sizes of the block device, and at least littlefs2.cache_size. A cache
+     *  buffer given without a size must be littlefs2.cache_size. Sequential
+     *  files without a cache of their own get a cache of the size of a block.
+     *
+     *  @param file     Destination of the newly created handle to the referenced file.
+     *  @param path     The name of the file to open.
+     *  @param flags    The flags that trigger opening of the file.
+     *  @param options  Buffering hints for the file.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_open(mbed::fs_file_t *file, const char *path, int flags, const file_options &options);
+
     /** Close a file
      *
      *  @param file     File handle.
@@ -291,6 +327,7 @@ private:
     lfs2_t _lfs; // The actual file system
     struct lfs2_config _config;
     mbed::BlockDevice *_bd; // The block device
+    lfs2_block_t _trim_next; // Where maintenance_step resumes
 
     // thread-safe locking
     PlatformMutex _mutex;
@@ -20,7 +20,8 @@ static inline void lfs2_cache_drop(lfs2_t *lfs2, lfs2_cache_t *rcache) {
 
 static inline void lfs2_cache_zero(lfs2_t *lfs2, lfs2_cache_t *pcache) {
     // zero to avoid information leak
-    memset(pcache->buffer, 0xff, lfs2->cfg->cache_size);
+    (void)lfs2;
+    memset(pcache->buffer, 0xff, pcache->buffer_size);
     pcache->block = LFS2_BLOCK_NULL;
 }
 
@@ -95,7 +96,7 @@ static int lfs2_bd_read(lfs2_t *lfs2,
                     lfs2_alignup(off+hint, lfs2->cfg->read_size),
                     lfs2->cfg->block_size)
                 - rcache->off,
-                lfs2->cfg->cache_size);
+                rcache->buffer_size);
         int err = lfs2->cfg->read(lfs2->cfg, rcache->block,
                 rcache->off, rcache->buffer, rcache->size);
         LFS2_ASSERT(err <= 0);
@@ -194,10 +195,10 @@ static int lfs2_bd_prog(lfs2_t *lfs2,
     while (size > 0) {
         if (block == pcache->block &&
                 off >= pcache->off &&
-                off < pcache->off + lfs2->cfg->cache_size) {
+                off < pcache->off + pcache->buffer_size) {
             // already fits in pcache?
             lfs2_size_t diff = lfs2_min(size,
-                    lfs2->cfg->cache_size - (off-pcache->off));
+                    pcache->buffer_size - (off-pcache->off));
             memcpy(&pcache->buffer[off-pcache->off], data, diff);
 
             data += diff;
@@ -205,7 +206,7 @@ static int lfs2_bd_prog(lfs2_t *lfs2,
             size -= diff;
 
             pcache->size = lfs2_max(pcache->size, off - pcache->off);
-            if (pcache->size == lfs2->cfg->cache_size) {
+            if (pcache->size == pcache->buffer_size) {
                 // eagerly flush out pcache if we fill up
                 int err = lfs2_bd_flush(lfs2, pcache, rcache, validate);
                 if (err) {
@@ -2487,10 +2488,21 @@ int lfs2_file_opencfg(lfs2_t *lfs2, lfs2_file_t *file,
     }
 
     // allocate buffer if needed
+    file->cache.buffer_size = lfs2->cfg->cache_size;
+    if (file->cfg->cache_size) {
+        if (file->cfg->cache_size < lfs2->cfg->cache_size ||
+                file->cfg->cache_size % lfs2->cfg->read_size != 0 ||
+                file->cfg->cache_size % lfs2->cfg->prog_size != 0) {
+            err = LFS2_ERR_INVAL;
+            goto cleanup;
+        }
+        file->cache.buffer_size = file->cfg->cache_size;
+    }
+
     if (file->cfg->buffer) {
         file->cache.buffer = file->cfg->buffer;
     } else {
-        file->cache.buffer = lfs2_malloc(lfs2->cfg->cache_size);
+        file->cache.buffer = lfs2_malloc(file->cache.buffer_size);
         if (!file->cache.buffer) {
             err = LFS2_ERR_NOMEM;
             goto cleanup;
@@ -3499,6 +3511,7 @@ static int lfs2_init(lfs2_t *lfs2, const struct lfs2_config *cfg) {
             goto cleanup;
         }
     }
+    lfs2->rcache.buffer_size = lfs2->cfg->cache_size;
 
     // setup program cache
     if (lfs2->cfg->prog_buffer) {
@@ -3510,6 +3523,7 @@ static int lfs2_init(lfs2_t *lfs2, const struct lfs2_config *cfg) {
             goto cleanup;
         }
     }
+    lfs2->pcache.buffer_size = lfs2->cfg->cache_size;
 
     // zero to avoid information leaks
     lfs2_cache_zero(lfs2, &lfs2->rcache);
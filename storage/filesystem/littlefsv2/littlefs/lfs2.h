@@ -273,8 +273,9 @@ struct lfs2_attr {
 
 // Optional configuration provided during lfs2_file_opencfg
 struct lfs2_file_config {
-    // Optional statically allocated file buffer. Must be cache_size.
-    // By default lfs2_malloc is used to allocate this buffer.
+    // Optional statically allocated file buffer. Must be cache_size, or
+    // the cache_size of this configuration when it is set. By default
+    // lfs2_malloc is used to allocate this buffer.
     void *buffer;
 
     // Optional list of custom attributes related to the file. If the file
@@ -292,6 +293,12 @@ struct lfs2_file_config {
 
     // Number of custom attributes in the list
     lfs2_size_t attr_count;
+
+    // Optional size of the file cache, 0 uses the cache_size of the
+    // filesystem. Must be a multiple of the read and program sizes, and
+    // of at least the cache_size of the filesystem. A larger cache reads
+    // and programs the file in larger bursts.
+    lfs2_size_t cache_size;
 };
 
 
@@ -301,6 +308,7 @@ typedef struct lfs2_cache {
     lfs2_off_t off;
     lfs2_size_t size;
     uint8_t *buffer;
+    lfs2_size_t buffer_size;
 } lfs2_cache_t;
 
 typedef struct lfs2_mdir {
@@ -19,15 +19,25 @@
 #include "lfs2.h"
 #include "lfs2_util.h"
 #include "MbedCRC.h"
+#include <new>
+
+#ifndef MBED_LFS2_PERSIST_LOOKAHEAD
+#define MBED_LFS2_PERSIST_LOOKAHEAD 0
+#endif
 
 namespace mbed {
 
 extern "C" uint32_t lfs2_crc(uint32_t crc, const void *buffer, size_t size)
 {
     uint32_t initial_xor = lfs2_rbit(crc);
-    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> ct(initial_xor, 0x0, true, true);
-
-    ct.compute((void *)buffer, size, &crc);
+    // small buffers can't afford the start-up overhead of the hardware
+    if (size >= MBED_LFS2_CRC_HARDWARE_THRESHOLD) {
+        MbedCRC<POLY_32BIT_ANSI, 32> ct(initial_xor, 0x0, true, true);
+        ct.compute((void *)buffer, size, &crc);
+    } else {
+        MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE> ct(initial_xor, 0x0, true, true);
+        ct.compute((void *)buffer, size, &crc);
+    }
     return crc;
 }
 
@@ -140,6 +150,125 @@ static int lfs2_bd_sync(const struct lfs2_config *c)
 }
 
 
+////// Lookahead hint //////
+
+// Root attribute holding the state of the block allocator at the last clean
+// unmount: block_count, lookahead_size, off, size and i, then the bitmap.
+// The LittleFileSystem2 API gives no access to attributes, so the type can't
+// clash with user attributes.
+static const uint8_t LFS2_LOOKAHEAD_HINT_ATTR = 0xfe;
+static const lfs2_size_t LFS2_LOOKAHEAD_HINT_HEADER = 5 * sizeof(uint32_t);
+
+static void lfs2_lookahead_tohint(lfs2_t *lfs, uint32_t *hint)
+{
+    hint[0] = lfs2_tole32(lfs->cfg->block_count);
+    hint[1] = lfs2_tole32(lfs->cfg->lookahead_size);
+    hint[2] = lfs2_tole32(lfs->free.off);
+    hint[3] = lfs2_tole32(lfs->free.size);
+    hint[4] = lfs2_tole32(lfs->free.i);
+    for (lfs2_size_t w = 0; w < lfs->cfg->lookahead_size / 4; w++) {
+        hint[5 + w] = lfs2_tole32(lfs->free.buffer[w]);
+    }
+}
+
+static void lfs2_lookahead_drop(lfs2_t *lfs)
+{
+    // as lfs2_alloc_reset, the next allocation scans the filesystem
+    lfs->free.size = 0;
+    lfs->free.i = 0;
+    lfs->free.ack = lfs->cfg->block_count;
+}
+
+#if MBED_LFS2_PERSIST_LOOKAHEAD
+// Store the allocator state, for the next mount to skip the first scan
+static int lfs2_lookahead_save(lfs2_t *lfs)
+{
+    lfs2_size_t size = LFS2_LOOKAHEAD_HINT_HEADER + lfs->cfg->lookahead_size;
+    if (lfs->free.size == 0 || size > lfs->attr_max) {
+        return 0;
+    }
+
+    uint32_t *hint = new (std::nothrow) uint32_t[2 * size / 4];
+    if (!hint) {
+        return 0;
+    }
+    uint32_t *check = &hint[size / 4];
+
+    // The commit may itself allocate blocks, which the stored state must include:
+    // it is written again until committing it leaves the allocator unchanged
+    int err = LFS2_ERR_CORRUPT;
+    lfs2_lookahead_tohint(lfs, hint);
+    for (int attempt = 0; attempt < 3; attempt++) {
+        err = lfs2_setattr(lfs, "/", LFS2_LOOKAHEAD_HINT_ATTR, hint, size);
+        if (err) {
+            break;
+        }
+
+        lfs2_lookahead_tohint(lfs, check);
+        if (memcmp(hint, check, size) == 0) {
+            break;
+        }
+        memcpy(hint, check, size);
+        err = LFS2_ERR_CORRUPT;
+    }
+
+    if (err) {
+        // a hint that doesn't match the allocator must not be left behind
+        lfs2_removeattr(lfs, "/", LFS2_LOOKAHEAD_HINT_ATTR);
+    }
+
+    delete[] hint;
+    return err;
+}
+#endif
+
+// Take the allocator state of the last clean unmount, if any, and remove it
+// before anything else is written: after an unclean shutdown there is none
+// left and the allocator scans the filesystem as usual.
+static int lfs2_lookahead_restore(lfs2_t *lfs, bool use)
+{
+    lfs2_size_t size = LFS2_LOOKAHEAD_HINT_HEADER + lfs->cfg->lookahead_size;
+    uint32_t header[LFS2_LOOKAHEAD_HINT_HEADER / 4];
+
+    // Look for a hint even when not using it, it must not outlive a mount
+    lfs2_ssize_t res = lfs2_getattr(lfs, "/", LFS2_LOOKAHEAD_HINT_ATTR, header, sizeof(header));
+    if (res == LFS2_ERR_NOATTR) {
+        return 0;
+    } else if (res < 0) {
+        return res;
+    }
+
+    if (use && (lfs2_size_t)res == size && size <= lfs->attr_max &&
+            lfs2_fromle32(header[0]) == lfs->cfg->block_count &&
+            lfs2_fromle32(header[1]) == lfs->cfg->lookahead_size) {
+        uint32_t *hint = new (std::nothrow) uint32_t[size / 4];
+        if (hint) {
+            res = lfs2_getattr(lfs, "/", LFS2_LOOKAHEAD_HINT_ATTR, hint, size);
+            lfs2_block_t off = lfs2_fromle32(hint[2]);
+            lfs2_block_t count = lfs2_fromle32(hint[3]);
+            lfs2_block_t i = lfs2_fromle32(hint[4]);
+            if ((lfs2_size_t)res == size && off < lfs->cfg->block_count &&
+                    count <= 8 * lfs->cfg->lookahead_size && i <= count) {
+                lfs->free.off = off;
+                lfs->free.size = count;
+                lfs->free.i = i;
+                lfs->free.ack = lfs->cfg->block_count;
+                for (lfs2_size_t w = 0; w < lfs->cfg->lookahead_size / 4; w++) {
+                    lfs->free.buffer[w] = lfs2_fromle32(hint[5 + w]);
+                }
+            }
+            delete[] hint;
+        }
+    }
+
+    int err = lfs2_removeattr(lfs, "/", LFS2_LOOKAHEAD_HINT_ATTR);
+    if (err) {
+        lfs2_lookahead_drop(lfs);
+    }
+    return err;
+}
+
+
 ////// Generic filesystem operations //////
 
 // Filesystem implementation (See LittleFileSystem2.h)
@@ -147,6 +276,8 @@ LittleFileSystem2::LittleFileSystem2(const char *name, BlockDevice *bd,
                                      lfs2_size_t block_size, uint32_t block_cycles,
                                      lfs2_size_t cache_size, lfs2_size_t lookahead_size)
     : FileSystem(name)
+    , _bd(NULL)
+    , _trim_next(0)
 {
     memset(&_config, 0, sizeof(_config));
     _config.block_size = block_size;
@@ -195,6 +326,14 @@ int LittleFileSystem2::mount(BlockDevice *bd)
         return lfs2_toerror(err);
     }
 
+    err = lfs2_lookahead_restore(&_lfs, MBED_LFS2_PERSIST_LOOKAHEAD);
+    if (err) {
+        lfs2_unmount(&_lfs);
+        _bd = NULL;
+        _mutex.unlock();
+        return lfs2_toerror(err);
+    }
+
     _mutex.unlock();
     return 0;
 }
@@ -204,6 +343,11 @@ int LittleFileSystem2::unmount()
     _mutex.lock();
     int res = 0;
     if (_bd) {
+#if MBED_LFS2_PERSIST_LOOKAHEAD
+        // a failure only costs the next mount a scan
+        lfs2_lookahead_save(&_lfs);
+#endif
+
         int err = lfs2_unmount(&_lfs);
         if (err && !res) {
             res = lfs2_toerror(err);
@@ -356,12 +500,101 @@ int LittleFileSystem2::statvfs(const char *name, struct statvfs *st)
     return 0;
 }
 
+// Blocks in use within the part of the device scanned by a maintenance step
+#define LFS2_MAINTENANCE_WINDOW 256
+
+struct lfs2_maintenance_window {
+    lfs2_block_t first;
+    lfs2_block_t count;
+    uint32_t used[LFS2_MAINTENANCE_WINDOW / 32];
+};
+
+static int lfs2_maintenance_mark(void *p, lfs2_block_t b)
+{
+    lfs2_maintenance_window *window = (lfs2_maintenance_window *)p;
+    lfs2_block_t i = b - window->first;
+    if (i < window->count) {
+        window->used[i / 32] |= 1u << (i % 32);
+    }
+    return 0;
+}
+
+int LittleFileSystem2::maintenance_step(bd_size_t max_size, bool *done)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -EINVAL;
+    }
+
+    lfs2_maintenance_window window;
+    memset(&window, 0, sizeof(window));
+    window.first = (_trim_next < _config.block_count) ? _trim_next : 0;
+    bd_size_t count = max_size / _config.block_size;
+    if (count < 1) {
+        count = 1;
+    }
+    if (count > LFS2_MAINTENANCE_WINDOW) {
+        count = LFS2_MAINTENANCE_WINDOW;
+    }
+    if (count > _config.block_count - window.first) {
+        count = _config.block_count - window.first;
+    }
+    window.count = count;
+
+    // The file system is locked from the traversal to the trims, so blocks
+    // found unused can't be allocated in between
+    int res = lfs2_toerror(lfs2_fs_traverse(&_lfs, lfs2_maintenance_mark, &window));
+    for (lfs2_block_t i = 0; !res && i < window.count;) {
+        if (window.used[i / 32] & (1u << (i % 32))) {
+            i++;
+            continue;
+        }
+        lfs2_block_t j = i + 1;
+        while (j < window.count && !(window.used[j / 32] & (1u << (j % 32)))) {
+            j++;
+        }
+        res = _bd->trim((bd_addr_t)(window.first + i) * _config.block_size,
+                        (bd_size_t)(j - i) * _config.block_size);
+        i = j;
+    }
+
+    if (!res) {
+        _trim_next = window.first + window.count;
+        if (done) {
+            *done = (_trim_next >= _config.block_count);
+        }
+    }
+    _mutex.unlock();
+    return res;
+}
+
 ////// File operations //////
+// Open file, with the configuration it was opened with. The file comes first
+// so that the handle is also a lfs2_file_t pointer
+struct lfs2_mbed_file {
+    lfs2_file_t file;
+    struct lfs2_file_config config;
+};
+
 int LittleFileSystem2::file_open(fs_file_t *file, const char *path, int flags)
 {
-    lfs2_file_t *f = new lfs2_file_t;
+    file_options options = {};
+    return file_open(file, path, flags, options);
+}
+
+int LittleFileSystem2::file_open(fs_file_t *file, const char *path, int flags, const file_options &options)
+{
+    lfs2_mbed_file *f = new lfs2_mbed_file;
+    memset(&f->config, 0, sizeof(f->config));
+    f->config.buffer = options.cache;
+    f->config.cache_size = options.cache_size;
     _mutex.lock();
-    int err = lfs2_file_open(&_lfs, f, path, lfs2_fromflags(flags));
+    if (!f->config.cache_size && options.sequential && !options.cache) {
+        // sequential accesses are served a block at a time
+        f->config.cache_size = _config.block_size;
+    }
+    int err = lfs2_file_opencfg(&_lfs, &f->file, path, lfs2_fromflags(flags), &f->config);
     _mutex.unlock();
     if (!err) {
         *file = f;
@@ -373,9 +606,9 @@ int LittleFileSystem2::file_open(fs_file_t *file, const char *path, int flags)
 
 int LittleFileSystem2::file_close(fs_file_t file)
 {
-    lfs2_file_t *f = (lfs2_file_t *)file;
+    lfs2_mbed_file *f = (lfs2_mbed_file *)file;
     _mutex.lock();
-    int err = lfs2_file_close(&_lfs, f);
+    int err = lfs2_file_close(&_lfs, &f->file);
     _mutex.unlock();
     delete f;
     return lfs2_toerror(err);
@@ -321,6 +321,76 @@ void test_simple_file_seek()
     TEST_ASSERT_EQUAL(0, res);
 }
 
+void test_sequential_file_seek()
+{
+    int res = bd.init();
+    TEST_ASSERT_EQUAL(0, res);
+
+    {
+        res = fs.mount(&bd);
+        TEST_ASSERT_EQUAL(0, res);
+        FileSystem::file_options options = {};
+        options.sequential = true;
+        res = file[0].open(&fs, "hello/kitty042", O_RDWR, options);
+        TEST_ASSERT_EQUAL(0, res);
+
+        off_t pos;
+        size = strlen("kittycatcat");
+        for (int i = 0; i < 4; i++) {
+            res = file[0].read(buffer, size);
+            TEST_ASSERT_EQUAL(size, res);
+            res = memcmp(buffer, "kittycatcat", size);
+            TEST_ASSERT_EQUAL(0, res);
+            pos = file[0].tell();
+        }
+        TEST_ASSERT_EQUAL(4 * size, pos);
+        res = file[0].seek(-size, SEEK_CUR);
+        TEST_ASSERT_EQUAL(3 * size, res);
+        res = file[0].read(buffer, size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = memcmp(buffer, "kittycatcat", size);
+        TEST_ASSERT_EQUAL(0, res);
+
+        // writes go where the reads stopped, not where the cache did
+        res = file[0].write("doggodogdog", size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = file[0].tell();
+        TEST_ASSERT_EQUAL(5 * size, res);
+        res = file[0].read(buffer, size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = memcmp(buffer, "kittycatcat", size);
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = file[0].seek(pos, SEEK_SET);
+        TEST_ASSERT_EQUAL(pos, res);
+        res = file[0].read(buffer, size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = memcmp(buffer, "doggodogdog", size);
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = file[0].seek(-size, SEEK_END) >= 0;
+        TEST_ASSERT_EQUAL(1, res);
+        res = file[0].read(buffer, size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = memcmp(buffer, "kittycatcat", size);
+        TEST_ASSERT_EQUAL(0, res);
+        res = file[0].read(buffer, size);
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = file[0].seek(pos, SEEK_SET);
+        TEST_ASSERT_EQUAL(pos, res);
+        res = file[0].write("kittycatcat", size);
+        TEST_ASSERT_EQUAL(size, res);
+        res = file[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+        res = fs.unmount();
+        TEST_ASSERT_EQUAL(0, res);
+    }
+
+    res = bd.deinit();
+    TEST_ASSERT_EQUAL(0, res);
+}
+
 void test_large_file_seek()
 {
     int res = bd.init();
@@ -628,6 +698,7 @@ Case cases[] = {
     Case("Simple dir seek", test_simple_dir_seek),
     Case("Large dir seek", test_large_dir_seek),
     Case("Simple file seek", test_simple_file_seek),
+    Case("Sequential file seek", test_sequential_file_seek),
     Case("Large file seek", test_large_file_seek),
     Case("Simple file seek and write", test_simple_file_seek_and_write),
     Case("Large file seek and write", test_large_file_seek_and_write),
@@ -30,6 +30,12 @@ File::File(FileSystem *fs, const char *path, int flags)
     open(fs, path, flags);
 }
 
+File::File(FileSystem *fs, const char *path, int flags, const FileSystem::file_options &options)
+    : _fs(0), _file(0)
+{
+    open(fs, path, flags, options);
+}
+
 File::~File()
 {
     if (_fs) {
@@ -51,6 +57,20 @@ int File::open(FileSystem *fs, const char *path, int flags)
     return err;
 }
 
+int File::open(FileSystem *fs, const char *path, int flags, const FileSystem::file_options &options)
+{
+    if (_fs) {
+        return -EINVAL;
+    }
+
+    int err = fs->file_open(&_file, path, flags, options);
+    if (!err) {
+        _fs = fs;
+    }
+
+    return err;
+}
+
 int File::close()
 {
     if (!_fs) {
@@ -116,4 +136,10 @@ int File::truncate(off_t length)
     return _fs->file_truncate(_file, length);
 }
 
+int File::reserve(off_t length)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_reserve(_file, length);
+}
+
 } // namespace mbed
@@ -56,6 +56,16 @@ int FileSystem::statvfs(const char *path, struct statvfs *buf)
     return -ENOSYS;
 }
 
+int FileSystem::maintenance_step(bd_size_t max_size, bool *done)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_open(fs_file_t *file, const char *path, int flags, const file_options &options)
+{
+    return file_open(file, path, flags);
+}
+
 int FileSystem::file_sync(fs_file_t file)
 {
     return 0;
@@ -89,6 +99,11 @@ int FileSystem::file_truncate(fs_file_t file, off_t length)
     return -ENOSYS;
 }
 
+int FileSystem::file_reserve(fs_file_t file, off_t length)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -0,0 +1,95 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "filesystem/StorageMaintenance.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include <errno.h>
+
+namespace mbed {
+
+StorageMaintenance::StorageMaintenance(FileSystem *fs, PreEraseBlockDevice *pre_erase, bd_size_t step_size)
+    : _fs(fs), _pre_erase(pre_erase), _step_size(step_size), _passes(0), _scanned(0),
+      _pass_done(false), _erase_pending(false), _aborted(false)
+{
+}
+
+int StorageMaintenance::step(bool *done)
+{
+    if (core_util_atomic_load_bool(&_aborted)) {
+        return -ECANCELED;
+    }
+
+    if (!_pass_done) {
+        bool pass_done = false;
+        int err = _fs->maintenance_step(_step_size, &pass_done);
+        if (err == -ENOSYS) {
+            // Nothing for the file system to trim
+            pass_done = true;
+        } else if (err) {
+            return err;
+        }
+
+        core_util_critical_section_enter();
+        _scanned += _step_size;
+        if (pass_done) {
+            _passes++;
+            _pass_done = true;
+        }
+        core_util_critical_section_exit();
+    }
+
+    bool erased = true;
+    if (_pre_erase) {
+        int err = _pre_erase->erase_step(_step_size, &erased);
+        if (err) {
+            return err;
+        }
+        _erase_pending = !erased;
+    }
+
+    if (done) {
+        *done = _pass_done && erased;
+    }
+    return 0;
+}
+
+void StorageMaintenance::abort()
+{
+    core_util_atomic_store_bool(&_aborted, true);
+}
+
+void StorageMaintenance::restart()
+{
+    core_util_critical_section_enter();
+    _scanned = 0;
+    _pass_done = false;
+    _aborted = false;
+    core_util_critical_section_exit();
+}
+
+void StorageMaintenance::get_progress(progress_t *progress) const
+{
+    core_util_critical_section_enter();
+    progress->passes = _passes;
+    progress->scanned = _scanned;
+    progress->erase_pending = _erase_pending;
+    progress->aborted = _aborted;
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed
@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* File throughput of the filesystems on the default block device.
+ *
+ * Every filesystem is formatted, then a file of FILE_SIZE bytes is written
+ * and read back whole, through buffers of each size of BUFFER_SIZES, and the
+ * timings are reported to the benchmark_auto host test.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "utest/utest_benchmark.h"
+#include "BlockDevice.h"
+#include "File.h"
+#include "FATFileSystem.h"
+#include "LittleFileSystem.h"
+#include "LittleFileSystem2.h"
+
+using namespace utest::v1;
+using namespace mbed;
+
+#define FILE_SIZE           (32 * 1024)
+#define MAX_BUFFER_SIZE     4096
+#define RUNS                5
+
+static const size_t BUFFER_SIZES[] = {64, 512, MAX_BUFFER_SIZE};
+
+static FileSystem *fs;
+static uint8_t *buffer;
+static size_t buffer_size;
+static int fs_status;
+
+static void write_file()
+{
+    File file;
+    int err = file.open(fs, "benchmark", O_WRONLY | O_CREAT | O_TRUNC);
+    for (size_t done = 0; !err && done < FILE_SIZE; done += buffer_size) {
+        if (file.write(buffer, buffer_size) != (ssize_t)buffer_size) {
+            err = -1;
+        }
+    }
+    if (file.close() != 0) {
+        err = -1;
+    }
+    fs_status |= err;
+}
+
+static void read_file()
+{
+    File file;
+    int err = file.open(fs, "benchmark", O_RDONLY);
+    for (size_t done = 0; !err && done < FILE_SIZE; done += buffer_size) {
+        if (file.read(buffer, buffer_size) != (ssize_t)buffer_size) {
+            err = -1;
+        }
+    }
+    if (file.close() != 0) {
+        err = -1;
+    }
+    fs_status |= err;
+}
+
+static void report(const char *fs_name, const char *operation, Callback<void()> body)
+{
+    char name[48];
+    snprintf(name, sizeof(name), "%s_%s_%u", fs_name, operation, (unsigned)buffer_size);
+
+    // One warm-up run writes the file the first time and fills the caches
+    const benchmark_t benchmark = { name, RUNS, 1, FILE_SIZE };
+    fs_status = 0;
+    benchmark_result_t result = benchmark_run(benchmark, body);
+    TEST_ASSERT_EQUAL(0, fs_status);
+    TEST_ASSERT_EQUAL(RUNS, result.iterations);
+    TEST_ASSERT_TRUE(benchmark_report(benchmark, result));
+}
+
+static void benchmark_filesystem(FileSystem *filesystem, const char *fs_name)
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "No default block device");
+    TEST_ASSERT_EQUAL(0, bd->init());
+    TEST_SKIP_UNLESS_MESSAGE(bd->size() >= 4 * FILE_SIZE, "Block device too small");
+
+    buffer = new (std::nothrow) uint8_t[MAX_BUFFER_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(buffer != NULL, "Not enough heap");
+    memset(buffer, 0x55, MAX_BUFFER_SIZE);
+
+    fs = filesystem;
+    TEST_ASSERT_EQUAL(0, fs->reformat(bd));
+
+    for (size_t i = 0; i < sizeof(BUFFER_SIZES) / sizeof(BUFFER_SIZES[0]); i++) {
+        buffer_size = BUFFER_SIZES[i];
+        report(fs_name, "write", write_file);
+        report(fs_name, "read", read_file);
+    }
+
+    TEST_ASSERT_EQUAL(0, fs->remove("benchmark"));
+    TEST_ASSERT_EQUAL(0, fs->unmount());
+    delete[] buffer;
+    TEST_ASSERT_EQUAL(0, bd->deinit());
+}
+
+void test_littlefs()
+{
+    LittleFileSystem filesystem("bench");
+    benchmark_filesystem(&filesystem, "littlefs");
+}
+
+void test_littlefs2()
+{
+    LittleFileSystem2 filesystem("bench");
+    benchmark_filesystem(&filesystem, "littlefs2");
+}
+
+void test_fat()
+{
+    FATFileSystem filesystem("bench");
+    benchmark_filesystem(&filesystem, "fat");
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(600, "benchmark_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("LittleFS file throughput", test_littlefs),
+    Case("LittleFS v2 file throughput", test_littlefs2),
+    Case("FAT file throughput", test_fat),
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
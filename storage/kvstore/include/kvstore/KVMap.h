@@ -77,6 +77,10 @@ typedef struct {
       * Partition name string
       */
     char *partition_name;
+    /**
+     * Partition name length, compared before the name on lookups
+     */
+    size_t partition_name_len;
     /**
      * Configuration struct.
      */
@@ -153,6 +157,19 @@ public:
      */
     int lookup(const char *full_name, mbed::KVStore **kv_instance, size_t *key_index, uint32_t *flags_mask = NULL);
 
+    /**
+     * @brief Partition name lookup, resolving a partition once for repeated accesses
+     *
+     * The returned configuration struct stays valid until the partition is detached,
+     * and avoids parsing the name and searching the partitions on each access.
+     *
+     * @param[in] partition_name String parameter contains the partition name to look for,
+     *                   formatted as "partition name", "/partition name" or "/partition name/".
+     * @param[out] kv_config Returns the configuration struct associated with the partition name.
+     * @return 0 on success, negative error code on failure
+     */
+    int partition_lookup(const char *partition_name, kvstore_config_t **kv_config);
+
     /**
      * @brief Getter for the internal KVStore instance.
      *
@@ -228,6 +245,15 @@ private:
      */
     int config_lookup(const char *full_name, kvstore_config_t **kv_config, size_t *key_index);
 
+    /**
+     * @brief Find an attached partition by name
+     *
+     * @param[in] name       Partition name, not necessarily null terminated.
+     * @param[in] name_len   Partition name length.
+     * @return the partition entry, NULL if not found
+     */
+    kv_map_entry_t *find_partition(const char *name, size_t name_len);
+
     // Attachment table
     kv_map_entry_t _kv_map_table[MAX_ATTACHED_KVS];
     int _kv_num_attached_kvs;
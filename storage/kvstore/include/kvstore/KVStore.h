@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "platform/mbed_error.h"
 
 namespace mbed {
 
@@ -190,6 +191,39 @@ public:
      */
     virtual int iterator_close(iterator_t it) = 0;
 
+    /**
+     * @brief Start a transaction. The sets and removes that follow are only applied
+     *        together, by transaction_commit, and are discarded by transaction_abort
+     *        or a power loss before the commit. Gets keep returning the committed values.
+     *        The store is locked by the calling thread until the transaction ends.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int transaction_begin()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Apply all the sets and removes of the current transaction at once.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int transaction_commit()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Discard all the sets and removes of the current transaction.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int transaction_abort()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
     /** Convenience function for checking key validity.
      *  Key must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
      *
@@ -0,0 +1,342 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PACKED_FILE_SYSTEM_STORE_H
+#define MBED_PACKED_FILE_SYSTEM_STORE_H
+
+#include "kvstore/KVStore.h"
+#include "filesystem/FileSystem.h"
+#include "filesystem/File.h"
+#include "PlatformMutex.h"
+
+namespace mbed {
+
+/** PackedFileSystemStore class
+ *
+ *  Key Value store over a FileSystem, keeping all the keys in a single log file.
+ *
+ *  Unlike FileSystemStore, which stores each key in its own file, every set or remove
+ *  appends a record to one file of the FileSystemStore folder, and a RAM index of
+ *  the key hashes and record offsets is built on init. Setting a key doesn't create,
+ *  truncate or remove files, and looking a key up doesn't search a directory.
+ *
+ *  The records superseded by a later set or remove are reclaimed by compaction, which
+ *  copies the live records to a new file replacing the log. It runs once the superseded
+ *  records exceed both the compaction threshold and the size of the live records, and
+ *  can be forced with compact().
+ *
+ *  @code
+ *  LittleFileSystem fs("fs");
+ *  PackedFileSystemStore store(&fs);
+ *  store.init();
+ *  store.set("key", "value", 6, 0);
+ *  @endcode
+ */
+class PackedFileSystemStore : public KVStore {
+
+public:
+    /** Default size of the superseded records starting a compaction */
+    static const size_t DEFAULT_COMPACTION_THRESHOLD = 4096;
+
+    /** Create PackedFileSystemStore - A Key Value API on top of FS
+     *
+     *  @param fs                   File system (FAT/LITTLE) on top of which PackedFileSystemStore is adding KV API
+     *  @param compaction_threshold Size of the superseded records in bytes above which the log is compacted
+     */
+    PackedFileSystemStore(FileSystem *fs, size_t compaction_threshold = DEFAULT_COMPACTION_THRESHOLD);
+
+    /** Destroy PackedFileSystemStore instance
+     *
+     */
+    virtual ~PackedFileSystemStore();
+
+    /**
+      * @brief Initialize PackedFileSystemStore, creating the KVStore writing folder and the log
+      *        file if they don't exist, and reading the log to build the index. A record torn
+      *        by a power loss ends the log and is truncated.
+      *
+      * @returns MBED_SUCCESS                        Success.
+      *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+      */
+    virtual int init();
+
+    /**
+      * @brief Deinitialize PackedFileSystemStore, release and free resources.
+      *
+      * @returns MBED_SUCCESS                        Success.
+      */
+    virtual int deinit();
+
+    /**
+     * @brief Reset PackedFileSystemStore contents (clear all keys)
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     */
+    virtual int reset();
+
+    /**
+     * @brief Set one PackedFileSystemStore item, given key and value.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  size                 Value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+
+    /**
+      * @brief Get one PackedFileSystemStore item by given key.
+      *
+      * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+      * @param[in]  buffer               Value data buffer.
+      * @param[in]  buffer_size          Value data buffer size.
+      * @param[out] actual_size          Actual read size.
+      * @param[in]  offset               Offset to read from in data.
+      *
+      * @returns MBED_SUCCESS                        Success.
+      *          MBED_ERROR_NOT_READY                Not initialized.
+      *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+      *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+      *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+      *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+      */
+    virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Get information of a given key. The returned info contains size and flags
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] info                 Returned information structure.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_info(const char *key, info_t *info);
+
+    /**
+     * @brief Remove a PackedFileSystemStore item by given key.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int remove(const char *key);
+
+    /**
+     * @brief Start an incremental PackedFileSystemStore set sequence. This operation is blocking other operations.
+     *        Any get/set/remove/iterator operation will be blocked until set_finalize is called.
+     *
+     * @param[out] handle               Returned incremental set handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  final_data_size      Final value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags);
+
+    /**
+     * @brief Add data to incremental PackedFileSystemStore set sequence. This operation is blocking other operations.
+     *        Any get/set/remove operation will be blocked until set_finalize is called.
+     *
+     * @param[in]  handle               Incremental set handle.
+     * @param[in]  value_data           Value data to add.
+     * @param[in]  data_size            Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     */
+    virtual int set_add_data(set_handle_t handle, const void *value_data, size_t data_size);
+
+    /**
+     * @brief Finalize an incremental PackedFileSystemStore set sequence.
+     *        The value is only visible once finalized, and discarded if the data size
+     *        doesn't match the final size given to set_start.
+     *
+     * @param[in]  handle               Incremental set handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Data size doesn't match the final size.
+     */
+    virtual int set_finalize(set_handle_t handle);
+
+    /**
+     * @brief Start an iteration over PackedFileSystemStore keys.
+     *        Keys set or removed while the iterator is open may be skipped or returned twice.
+     *
+     * @param[out] it                   Returned iterator handle.
+     * @param[in]  prefix               Key prefix (null for all keys).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int iterator_open(iterator_t *it, const char *prefix = NULL);
+
+    /**
+     * @brief Get next key in iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     * @param[in]  key                  Buffer for returned key.
+     * @param[in]  key_size             Key buffer size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Key buffer too small.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No more keys found.
+     */
+    virtual int iterator_next(iterator_t it, char *key, size_t key_size);
+
+    /**
+     * @brief Close iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int iterator_close(iterator_t it);
+
+    /**
+     * @brief Copy the live records to a new log, reclaiming the space of the superseded ones.
+     *        Compaction otherwise runs on its own once the superseded records exceed both
+     *        the compaction threshold and the size of the live records.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying file system failed operation.
+     */
+    int compact();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+
+    // RAM index entry, sorted by ascending hash
+    typedef struct {
+        uint32_t hash;
+        uint32_t offset;
+        uint32_t size;
+    } ram_table_entry_t;
+
+    /**
+     * @brief Read a record header, and optionally its key, from the log.
+     *
+     * @param[in]  offset               Record offset in the log.
+     * @param[out] header               Returned header (a record_header_t).
+     * @param[out] key                  Returned key, of at least MAX_KEY_SIZE bytes, or NULL.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _read_record(uint32_t offset, void *header, char *key);
+
+    /**
+     * @brief Find a key in the RAM index.
+     *
+     * @param[in]  key                  Key.
+     * @param[out] ind                  Index of the entry if found, else where to insert it.
+     * @param[out] hash                 Hash of the key.
+     *
+     * @returns 0 if found, MBED_ERROR_ITEM_NOT_FOUND or another negative error code on failure
+     */
+    int _find_record(const char *key, uint32_t &ind, uint32_t &hash);
+
+    /**
+     * @brief Write to the log at a given offset.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _write(uint32_t offset, const void *data, size_t size);
+
+    /**
+     * @brief Make the record appended at offset the current one of a key, or remove the key.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _index_record(const char *key, uint32_t offset, uint32_t size, bool remove);
+
+    /**
+     * @brief Compact the log if the superseded records exceed the threshold and the live ones.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _compact_if_needed();
+
+    /**
+     * @brief Read the log, building the RAM index. A torn record ending the log is truncated.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _build_ram_table();
+
+    /**
+     * @brief Open the log file, recovering it from an interrupted compaction, or create it.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _open_log();
+
+    FileSystem *_fs;
+    File _log;
+    PlatformMutex _mutex;
+    PlatformMutex _inc_data_add_mutex;
+
+    bool _is_initialized;
+    char *_log_path; /* Log file path name on FileSystem */
+    char *_tmp_path; /* Path name of the log being compacted */
+    size_t _compaction_threshold;
+    uint32_t _log_size; /* Size of the valid records of the log, where the next one is appended */
+    uint32_t _live_size; /* Size of the records in the RAM index */
+
+    ram_table_entry_t *_ram_table;
+    uint32_t _num_keys;
+    uint32_t _max_keys;
+
+    set_handle_t _cur_inc_set_handle; /* handle of the key under incremental set process */
+#endif
+};
+
+
+} //namespace mbed
+#endif //MBED_PACKED_FILE_SYSTEM_STORE_H
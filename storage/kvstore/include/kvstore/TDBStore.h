@@ -23,6 +23,7 @@
 #include "blockdevice/BlockDevice.h"
 #include "blockdevice/BufferedBlockDevice.h"
 #include "PlatformMutex.h"
+#include "platform/Span.h"
 #include "mbed_error.h"
 
 namespace mbed {
@@ -67,7 +68,7 @@ public:
     virtual int init();
 
     /**
-     * @brief Deinitialize TDBStore, release and free resources.
+     * @brief Deinitialize TDBStore, release and free resources. Views still held are released.
      *
      * @returns MBED_SUCCESS                        Success.
      */
@@ -81,6 +82,7 @@ public:
      *          MBED_ERROR_NOT_READY                Not initialized.
      *          MBED_ERROR_READ_FAILED              Unable to read from media.
      *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_OPERATION_PROHIBITED     Views are held.
      */
     virtual int reset();
 
@@ -206,6 +208,8 @@ public:
     /**
      * @brief Start an iteration over KVStore keys.
      *        There are no issues with any other operations while iterator is open.
+     *        The first characters of each key are kept in RAM, so that only the records
+     *        whose key may match the prefix are read.
      *
      * @param[out] it                   Returned iterator handle.
      * @param[in]  prefix               Key prefix (null for all keys).
@@ -259,6 +263,7 @@ public:
      *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
      *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
      *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_OPERATION_PROHIBITED     Views are held.
      */
     virtual int reserved_data_set(const void *reserved_data, size_t reserved_data_buf_size);
 
@@ -280,6 +285,92 @@ public:
     virtual int reserved_data_get(void *reserved_data, size_t reserved_data_buf_size,
                                   size_t *actual_data_size = 0);
 
+    /**
+     * @brief Perform a bounded part of a garbage collection, starting one if none is in progress.
+     *        Calling it from idle time (e.g. from a low priority EventQueue) compacts the storage
+     *        before it gets full, so that set() doesn't have to perform a whole garbage collection.
+     *        All other operations can be performed between the calls. On failure, the garbage
+     *        collection in progress is dropped.
+     *
+     * @param[in]  max_records          Maximum number of records to copy in this call.
+     * @param[out] done                 If not NULL, set to true once the garbage collection completed.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_MEDIA_FULL               No space left on media.
+     *          MBED_ERROR_OPERATION_PROHIBITED     Views are held, a garbage collection can't start.
+     */
+    int garbage_collection_step(size_t max_records, bool *done = 0);
+
+    /**
+     * @brief Get a view of the value of a key in place, without copying it. The whole record is
+     *        validated once, then the value is read directly from the storage, for large values
+     *        such as certificates. Only supported when the block device is mapped in the address
+     *        space (see BlockDevice::get_mapped_address), such as FlashIAPBlockDevice.
+     *
+     *        The view stays valid until released with release_view, even if the key is set again
+     *        or removed meanwhile, in which case it shows the former value. While views are held,
+     *        no garbage collection can start, as it would erase the records: sets needing one and
+     *        reset() fail with MBED_ERROR_OPERATION_PROHIBITED, so views should be held briefly.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] view                 View of the value.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_UNSUPPORTED              The record is not mapped in the address space.
+     */
+    int get_view(const char *key, mbed::Span<const uint8_t> &view);
+
+    /**
+     * @brief Release a view taken by get_view.
+     *
+     * @param[in,out] view                 View to release, emptied.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         No view is held.
+     */
+    int release_view(mbed::Span<const uint8_t> &view);
+
+    /**
+     * @brief Start a transaction. Its records are appended as the sets and removes are made,
+     *        and stay ignored until transaction_commit writes a single commit record after them,
+     *        so a power loss before the commit leaves none of them applied. Gets return the
+     *        committed values, and removes only apply to committed keys. The store stays locked
+     *        by the calling thread until the transaction is committed or aborted.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        A transaction is already in progress.
+     */
+    virtual int transaction_begin();
+
+    /**
+     * @brief Commit the transaction in progress, applying all its sets and removes at once.
+     *        On failure, the transaction is dropped.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_MEDIA_FULL               No space left on media.
+     */
+    virtual int transaction_commit();
+
+    /**
+     * @brief Abort the transaction in progress, discarding all its sets and removes.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     */
+    virtual int transaction_abort();
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -311,6 +402,15 @@ private:
     char *_key_buf;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    uint32_t *_gc_offsets;
+    uint32_t _gc_to_offset;
+    void *_key_prefixes;
+    bool _in_transaction;
+    uint16_t _transaction_id;
+    uint32_t *_transaction_offsets;
+    size_t _num_transaction_records;
+    size_t _max_transaction_records;
+    uint32_t _num_views;
 
     /**
      * @brief Read a block from an area.
@@ -394,10 +494,68 @@ private:
      * @param[in]  area                   Area.
      * @param[in]  version                Area version.
      * @param[out] next_offset            Offset of next record.
+     * @param[in]  index_offset           Offset of the index record, 0 if none.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                            uint32_t index_offset = 0);
+
+    /**
+     * @brief Write the RAM table as an index record.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset of record in area.
+     * @param[out] next_offset            Offset of next record.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
+    int write_index_record(uint8_t area, uint32_t offset, uint32_t &next_offset);
+
+    /**
+     * @brief Write an internal record (index or commit record), keyed like the master record.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset of record in area.
+     * @param[in]  flags                  Record flags.
+     * @param[in]  reserved               Reserved header field.
+     * @param[in]  data                   Record data.
+     * @param[in]  data_size              Record data size.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_internal_record(uint8_t area, uint32_t offset, uint32_t flags, uint16_t reserved,
+                              const void *data, uint32_t data_size, uint32_t &next_offset);
+
+    /**
+     * @brief Append the commit record of the transaction in progress to the active area.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_commit_record();
+
+    /**
+     * @brief Look for the commit record of the transaction whose first record is at a given
+     *        location, and keep its id as the last one used.
+     *
+     * @param[in]  offset                 Offset of the first record of the transaction.
+     * @param[out] commit_offset          Offset of the commit record, 0 if none.
+     * @param[out] end_offset             Offset following the records of the transaction.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int find_transaction_commit(uint32_t offset, uint32_t &commit_offset, uint32_t &end_offset);
+
+    /**
+     * @brief Load the RAM table from an index record of the active area.
+     *
+     * @param[in]  offset                 Offset of record in area.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int load_index_record(uint32_t offset, uint32_t &next_offset);
 
     /**
      * @brief Copy a record from one area to the opposite one.
@@ -406,11 +564,13 @@ private:
      * @param[in]  from_offset            Offset in source area.
      * @param[in]  to_offset              Offset in destination area.
      * @param[out] to_next_offset         Offset of next record in destination area.
+     * @param[in]  keep_transaction       Keep the record part of its transaction, rather than
+     *                                    copying a committed one as a plain record.
      *
      * @returns 0 for success, nonzero for failure.
      */
     int copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_offset,
-                    uint32_t &to_next_offset);
+                    uint32_t &to_next_offset, bool keep_transaction = false);
 
     /**
      * @brief Garbage collection (compact all records from active area to the standby one).
@@ -419,6 +579,38 @@ private:
      */
     int garbage_collection();
 
+    /**
+     * @brief Start a garbage collection, that copies records to the standby area while the active
+     *        one is still in use. _gc_offsets holds the standby offset of each RAM table entry,
+     *        0 if not copied yet.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_start();
+
+    /**
+     * @brief Copy records not yet copied by the garbage collection in progress, and complete it
+     *        once all are.
+     *
+     * @param[in]  max_records            Maximum number of records to copy.
+     * @param[out] done                   Whether the garbage collection completed.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_copy(size_t max_records, bool &done);
+
+    /**
+     * @brief Switch to the standby area once all records have been copied to it.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_finish();
+
+    /**
+     * @brief Drop the garbage collection in progress, if any.
+     */
+    void gc_abort();
+
     /**
      * @brief Return record size given key and data size.
      *
@@ -471,11 +663,42 @@ private:
     int do_set(const char *key, const void *data_buf, uint32_t data_buf_size, uint32_t flags);
 
     /**
-     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area).
+     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area,
+     *        or only the ones following the index record).
+     *
+     * @param[in]  index_offset          Offset of the index record, 0 if none.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int build_ram_table();
+    int build_ram_table(uint32_t index_offset);
+
+    /**
+     * @brief Apply a record written to the active area to the RAM table.
+     *
+     * @param[in]  ram_table_ind         Index in RAM table.
+     * @param[in]  new_key               Whether the key is added.
+     * @param[in]  flags                 Record flags.
+     * @param[in]  hash                  Key hash.
+     * @param[in]  bd_offset             Offset of record.
+     * @param[in]  key                   Key, or at least its characters kept for iterators.
+     */
+    void update_ram_table(uint32_t ram_table_ind, bool new_key, uint32_t flags, uint32_t hash,
+                          uint32_t bd_offset, const char *key);
+
+    /**
+     * @brief Keep the first characters of the key of a RAM table entry, for iterators.
+     *
+     * @param[in]  ram_table_ind         Index in RAM table.
+     * @param[in]  key                   Key.
+     */
+    void set_key_prefix(uint32_t ram_table_ind, const char *key);
+
+    /**
+     * @brief Keep the offset of a record of the transaction in progress, to apply on commit.
+     *
+     * @param[in]  bd_offset             Offset of record.
+     */
+    void add_transaction_record(uint32_t bd_offset);
 
     /**
      * @brief Increment maximum number of keys and reallocate RAM table accordingly.
@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 typedef struct _opaque_kv_key_iterator *kv_iterator_t;
+typedef struct _opaque_kv_partition *kv_partition_t;
 
 #define KV_WRITE_ONCE_FLAG                      (1 << 0)
 #define KV_REQUIRE_CONFIDENTIALITY_FLAG         (1 << 1)
@@ -138,7 +139,66 @@ int kv_iterator_close(kv_iterator_t it);
  */
 int kv_reset(const char *kvstore_path);
 
+/**
+ * @brief Resolve a partition once, for repeated accesses with the partition functions.
+ *        These skip the parsing of the full name and the search of the partition.
+ *        The partition handle stays valid until the partition is detached.
+ *
+ * @param[in]  kvstore_path         /Partition/
+ * @param[out] partition            Returned partition handle.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_partition_lookup(const char *kvstore_path, kv_partition_t *partition);
+
 #ifdef __cplusplus
 } // closing brace for extern "C"
+
+/**
+ * @brief Set one KVStore item of a partition, given key and value.
+ *
+ * @param[in]  partition            Partition handle, from kv_partition_lookup.
+ * @param[in]  key                  Key, without the partition path. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  size                 Value data size.
+ * @param[in]  create_flags         Flag mask.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_set(kv_partition_t partition, const char *key, const void *buffer, size_t size, uint32_t create_flags);
+
+/**
+ * @brief Get one KVStore item of a partition by given key.
+ *
+ * @param[in]  partition            Partition handle, from kv_partition_lookup.
+ * @param[in]  key                  Key, without the partition path. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  buffer_size          Value data buffer size.
+ * @param[out] actual_size          Actual read size.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_get(kv_partition_t partition, const char *key, void *buffer, size_t buffer_size, size_t *actual_size);
+
+/**
+ * @brief Get information of a given key of a partition. The returned info contains size and flags.
+ *
+ * @param[in]  partition            Partition handle, from kv_partition_lookup.
+ * @param[in]  key                  Key, without the partition path. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ * @param[out] info                 Returned information structure.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_get_info(kv_partition_t partition, const char *key, kv_info_t *info);
+
+/**
+ * @brief Remove a KVStore item of a partition by given key.
+ *
+ * @param[in]  partition            Partition handle, from kv_partition_lookup.
+ * @param[in]  key                  Key, without the partition path. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_remove(kv_partition_t partition, const char *key);
 #endif
 #endif
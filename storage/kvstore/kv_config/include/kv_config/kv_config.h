@@ -72,5 +72,20 @@ int kv_get_flash_bounds_from_config(mbed::bd_addr_t *start_address, mbed::bd_siz
 
 #ifdef __cplusplus
 } // closing brace for extern "C"
+
+#if MBED_CONF_RTOS_PRESENT && MBED_CONF_STORAGE_STARTUP_TASK
+#include "events/StartupTask.h"
+
+/**
+ * @brief Startup task running kv_init_storage_config(), when storage.startup-task is set.
+ *
+ * The storage initializes on the StartupTask pool, concurrently with the other
+ * subsystems; tasks depending on the storage list it in their dependencies.
+ * A call to kv_init_storage_config() meanwhile, directly or through the KVStore
+ * global API, waits for the task or initializes the storage itself if the task
+ * has not started yet.
+ */
+extern events::StartupTask kv_startup_task;
+#endif
 #endif
 #endif
@@ -20,11 +20,13 @@
 #include "blockdevice/BlockDevice.h"
 #include "filesystem/FileSystem.h"
 #include "kvstore/FileSystemStore.h"
+#include "kvstore/PackedFileSystemStore.h"
 #include "blockdevice/SlicingBlockDevice.h"
 #include "fat/FATFileSystem.h"
 #include "littlefs/LittleFileSystem.h"
 #include "kvstore/TDBStore.h"
 #include "mbed_error.h"
+#include "mbed_stats.h"
 #include "drivers/FlashIAP.h"
 #include "blockdevice/FlashSimBlockDevice.h"
 #include "mbed_trace.h"
@@ -161,6 +163,10 @@ static SingletonPtr<PlatformMutex> mutex;
 static bool is_kv_config_initialize = false;
 static kvstore_config_t kvstore_config;
 
+#if MBED_CONF_RTOS_PRESENT && MBED_CONF_STORAGE_STARTUP_TASK
+events::StartupTask kv_startup_task("kvstore", kv_init_storage_config);
+#endif
+
 #define INTERNAL_BLOCKDEVICE_NAME FLASHIAP
 
 #define STR_EXPAND(tok) #tok
@@ -248,9 +254,13 @@ FileSystem *_get_filesystem_LITTLE(const char *mount)
     return &flash;
 }
 
-FileSystemStore *_get_file_system_store(FileSystem *fs)
+KVStore *_get_file_system_store(FileSystem *fs)
 {
+#if MBED_CONF_STORAGE_FILESYSTEMSTORE_PACKED
+    static PackedFileSystemStore fss(fs);
+#else
     static FileSystemStore fss(fs);
+#endif
     return &fss;
 }
 
@@ -983,6 +993,7 @@ MBED_WEAK int kv_init_storage_config()
 
     if (ret == MBED_SUCCESS) {
         is_kv_config_initialize = true;
+        mbed_stats_boot_mark("kvstore");
     }
 
 exit:
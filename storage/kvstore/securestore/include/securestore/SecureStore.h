@@ -120,6 +120,9 @@ public:
 
     /**
      * @brief Get one KVStore item, given key.
+     *        Values read whole are kept decrypted in a RAM cache of securestore.read-cache-size
+     *        bytes, zeroized on eviction, so that reading them again skips the authentication and
+     *        decryption. The cache only follows the changes made through this SecureStore.
      *
      * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
      * @param[in]  buffer               Value data buffer.
@@ -270,17 +273,53 @@ public:
      */
     virtual int iterator_close(iterator_t it);
 
+    /**
+     * @brief Start a transaction of the underlying KVStore. Writes of keys stored in the
+     *        RBP KVStore (replay protected or write once) are rejected until it ends.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        A transaction is already in progress.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int transaction_begin();
+
+    /**
+     * @brief Commit the transaction of the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int transaction_commit();
+
+    /**
+     * @brief Abort the transaction of the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int transaction_abort();
+
 #if !defined(DOXYGEN_ONLY)
 private:
     // Forward declaration
     struct inc_set_handle_t;
+    struct cache_entry_t;
+    struct crypto_ctx_t;
 
     PlatformMutex _mutex;
     bool _is_initialized;
+    bool _in_transaction;
     KVStore *_underlying_kv, *_rbp_kv;
     mbedtls_entropy_context *_entropy;
     inc_set_handle_t *_ih;
     uint8_t *_scratch_buf;
+    cache_entry_t *_cache;
+    size_t _cache_size;
+    crypto_ctx_t *_crypto_ctxs;
+    uint32_t _crypto_use_count;
 
     /**
      * @brief Actual get function, serving get and get_info APIs.
@@ -296,6 +335,69 @@ private:
      */
     int do_get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
                size_t offset = 0, info_t *info = 0);
+
+    /**
+     * @brief Find a value in the read cache, and make it the most recently used one.
+     *
+     * @param[in]  key                  Key.
+     *
+     * @returns the cached value, or NULL if not cached.
+     */
+    cache_entry_t *cache_find(const char *key);
+
+    /**
+     * @brief Add a decrypted value to the read cache, evicting the least recently used ones
+     *        to keep within the configured size.
+     *
+     * @param[in]  key                  Key.
+     * @param[in]  data                 Value data.
+     * @param[in]  size                 Value data size.
+     * @param[in]  flags                Creation flags of the value.
+     */
+    void cache_add(const char *key, const void *data, uint32_t size, uint32_t flags);
+
+    /**
+     * @brief Remove a value from the read cache, if cached.
+     *
+     * @param[in]  key                  Key.
+     */
+    void cache_remove(const char *key);
+
+    /**
+     * @brief Remove all values from the read cache.
+     */
+    void cache_clear();
+
+    /**
+     * @brief Zeroize and free a cached value.
+     *
+     * @param[in]  entry                Cached value.
+     */
+    void cache_free(cache_entry_t *entry);
+
+    /**
+     * @brief Get the AES and CMAC contexts set up for a key, deriving its keys only if they are not
+     *        among the recently used ones. The CMAC calculation is started over.
+     *
+     * @param[in]  key                  Key.
+     * @param[in]  encrypt              Whether the AES context is needed.
+     * @param[out] ctx                  Returned contexts.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int crypto_ctx_get(const char *key, bool encrypt, crypto_ctx_t **ctx);
+
+    /**
+     * @brief Zeroize and free all the crypto contexts.
+     */
+    void crypto_ctx_clear();
+
+    /**
+     * @brief Zeroize and free crypto contexts, leaving the entry unused.
+     *
+     * @param[in]  ctx                  Crypto contexts.
+     */
+    void crypto_ctx_free(crypto_ctx_t *ctx);
 #endif
 };
 /** @}*/
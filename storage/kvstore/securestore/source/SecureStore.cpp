@@ -23,12 +23,14 @@
 #include "aes.h"
 #include "cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "entropy.h"
 #include "DeviceKey.h"
 #include "mbed_assert.h"
 #include "mbed_wait_api.h"
 #include "mbed_error.h"
 #include <algorithm>
+#include <new>
 #include <string.h>
 #include <stdio.h>
 
@@ -41,9 +43,23 @@ static const uint32_t securestore_revision = 1;
 static const uint32_t enc_block_size    = 16;
 static const uint32_t cmac_size         = 16;
 static const uint32_t iv_size           = 8;
-static const uint32_t scratch_buf_size  = 256;
 static const uint32_t derived_key_size  = 16;
 
+#ifndef MBED_CONF_SECURESTORE_READ_CACHE_SIZE
+#define MBED_CONF_SECURESTORE_READ_CACHE_SIZE 0
+#endif
+
+#ifndef MBED_CONF_SECURESTORE_CRYPTO_CONTEXTS
+#define MBED_CONF_SECURESTORE_CRYPTO_CONTEXTS 1
+#endif
+
+#ifndef MBED_CONF_SECURESTORE_CRYPTO_CHUNK_SIZE
+#define MBED_CONF_SECURESTORE_CRYPTO_CHUNK_SIZE 256
+#endif
+
+static const uint32_t scratch_buf_size  = MBED_CONF_SECURESTORE_CRYPTO_CHUNK_SIZE;
+static const uint32_t crypto_ctx_count  = MBED_CONF_SECURESTORE_CRYPTO_CONTEXTS;
+
 static const char *const enc_prefix  = "ENC";
 static const char *const auth_prefix = "AUTH";
 
@@ -71,78 +87,64 @@ struct SecureStore::inc_set_handle_t {
     char *key = nullptr;
     uint32_t offset_in_data = 0u;
     uint8_t ctr_buf[enc_block_size] = { 0u };
+    // CTR position, kept between set_add_data calls of any size
+    size_t aes_offs = 0u;
+    uint8_t stream_block[enc_block_size] = { 0u };
+    SecureStore::crypto_ctx_t *ctx = nullptr;
+    KVStore::set_handle_t underlying_handle;
+};
+
+// AES and CMAC contexts set up with the keys derived for a key name
+struct SecureStore::crypto_ctx_t {
+    char key[KVStore::MAX_KEY_SIZE + 1];
+    uint32_t last_use;
+    bool enc_ready;
     mbedtls_aes_context enc_ctx;
     mbedtls_cipher_context_t auth_ctx;
-    KVStore::set_handle_t underlying_handle;
+};
+
+// cached value, allocated along with its key and data
+struct SecureStore::cache_entry_t {
+    cache_entry_t *next;
+    size_t alloc_size;
+    uint32_t flags;
+    uint32_t size;
+    char *key;
+    uint8_t *data;
 };
 
 // -------------------------------------------------- Local Functions Declaration ----------------------------------------------------
 
 // -------------------------------------------------- Functions Implementation ----------------------------------------------------
 
-int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const char *key,
-                          uint8_t *ctr_buf, uint8_t *salt_buf, int salt_buf_size)
+int derive_key(const char *prefix, const char *key, uint8_t *salt_buf, int salt_buf_size,
+               uint8_t *derived_key)
 {
     DeviceKey &devkey = DeviceKey::get_instance();
     char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t encrypt_key[derived_key_size];
-    strcpy(salt, enc_prefix);
-    int pos = strlen(enc_prefix);
+    strcpy(salt, prefix);
+    int pos = strlen(prefix);
     strncpy(salt + pos, key, salt_buf_size - pos - 1);
     salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), encrypt_key,  DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
-    mbedtls_aes_init(&enc_aes_ctx);
-    mbedtls_aes_setkey_enc(&enc_aes_ctx, encrypt_key, enc_block_size * 8);
+    return devkey.generate_derived_key(salt_buf, strlen(salt), derived_key, DEVICE_KEY_16BYTE);
+}
 
+void encrypt_decrypt_start(const uint8_t *iv, uint8_t *ctr_buf, uint8_t *stream_block, size_t &aes_offs)
+{
     memcpy(ctr_buf, iv, iv_size);
     memset(ctr_buf + iv_size, 0, iv_size);
-
-    return 0;
+    memset(stream_block, 0, enc_block_size);
+    aes_offs = 0;
 }
 
 int encrypt_decrypt_data(mbedtls_aes_context &enc_aes_ctx, const uint8_t *in_buf,
-                         uint8_t *out_buf, uint32_t chunk_size, uint8_t *ctr_buf, size_t &aes_offs)
+                         uint8_t *out_buf, uint32_t chunk_size, uint8_t *ctr_buf,
+                         uint8_t *stream_block, size_t &aes_offs)
 {
-    uint8_t stream_block[enc_block_size] = { 0 };
-
     return mbedtls_aes_crypt_ctr(&enc_aes_ctx, chunk_size, &aes_offs, ctr_buf,
                                  stream_block, in_buf, out_buf);
 }
 
-int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const char *key, uint8_t *salt_buf, int salt_buf_size)
-{
-    DeviceKey &devkey = DeviceKey::get_instance();
-    char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t auth_key[derived_key_size];
-    strcpy(salt, auth_prefix);
-    int pos = strlen(auth_prefix);
-    strncpy(salt + pos, key, salt_buf_size - pos - 1);
-    salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), auth_key, DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    mbedtls_cipher_init(&auth_ctx);
-
-    if ((os_ret = mbedtls_cipher_setup(&auth_ctx, cipher_info)) != 0) {
-        return os_ret;
-    }
-
-    os_ret = mbedtls_cipher_cmac_starts(&auth_ctx, auth_key, cmac_size * 8);
-    if (os_ret != 0) {
-        return os_ret;
-    }
-
-    return 0;
-}
-
 int cmac_calc_data(mbedtls_cipher_context_t &auth_ctx, const void *input, size_t ilen)
 {
     int os_ret;
@@ -166,8 +168,8 @@ int cmac_calc_finish(mbedtls_cipher_context_t &auth_ctx, uint8_t *output)
 // Class member functions
 
 SecureStore::SecureStore(KVStore *underlying_kv, KVStore *rbp_kv) :
-    _is_initialized(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
-    _ih(0), _scratch_buf(0)
+    _is_initialized(false), _in_transaction(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
+    _ih(0), _scratch_buf(0), _cache(0), _cache_size(0), _crypto_ctxs(0), _crypto_use_count(0)
 {
 }
 
@@ -182,7 +184,6 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
 {
     int ret, os_ret;
     info_t info;
-    bool enc_started = false, auth_started = false;
 
     if (!_is_initialized) {
         return MBED_ERROR_NOT_READY;
@@ -194,6 +195,13 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
 
     _mutex.lock();
     *handle = reinterpret_cast<set_handle_t>(_ih);
+    cache_remove(key);
+
+    // RBP storage writes can't be part of a transaction of the underlying KV
+    if (_in_transaction && _rbp_kv && (create_flags & (REQUIRE_REPLAY_PROTECTION_FLAG | WRITE_ONCE_FLAG))) {
+        ret = MBED_ERROR_INVALID_OPERATION;
+        goto fail;
+    }
 
     // Validate internal RBP data
     if (_rbp_kv) {
@@ -244,30 +252,23 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
         }
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
-        if (os_ret) {
-            ret = MBED_ERROR_FAILED_OPERATION;
-            goto fail;
-        }
-        enc_started = true;
+        encrypt_decrypt_start(_ih->metadata.iv, _ih->ctr_buf, _ih->stream_block, _ih->aes_offs);
     } else {
         memset(_ih->metadata.iv, 0, iv_size);
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = crypto_ctx_get(key, create_flags & REQUIRE_CONFIDENTIALITY_FLAG, &_ih->ctx);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
     }
-    auth_started = true;
     // Although name is not part of the data, we calculate CMAC on it as well
-    os_ret = cmac_calc_data(_ih->auth_ctx, key, strlen(key));
+    os_ret = cmac_calc_data(_ih->ctx->auth_ctx, key, strlen(key));
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
     }
-    os_ret = cmac_calc_data(_ih->auth_ctx, &_ih->metadata, sizeof(record_metadata_t));
+    os_ret = cmac_calc_data(_ih->ctx->auth_ctx, &_ih->metadata, sizeof(record_metadata_t));
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
@@ -298,13 +299,7 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
     goto end;
 
 fail:
-    if (enc_started) {
-        mbedtls_aes_free(&_ih->enc_ctx);
-    }
-
-    if (auth_started) {
-        mbedtls_cipher_free(&_ih->auth_ctx);
-    }
+    _ih->ctx = nullptr;
 
     // mark handle as invalid by clearing metadata size field in header
     _ih->metadata.metadata_size = 0;
@@ -316,7 +311,6 @@ end:
 
 int SecureStore::set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
 {
-    size_t aes_offs = 0;
     int os_ret, ret = MBED_SUCCESS;
     const uint8_t *src_ptr;
 
@@ -346,8 +340,8 @@ int SecureStore::set_add_data(set_handle_t handle, const void *value_data, size_
             // Encrypt the data chunk by chunk
             chunk_size = std::min((uint32_t) data_size, scratch_buf_size);
             dst_ptr = _scratch_buf;
-            os_ret = encrypt_decrypt_data(_ih->enc_ctx, src_ptr, _scratch_buf,
-                                          chunk_size, _ih->ctr_buf, aes_offs);
+            os_ret = encrypt_decrypt_data(_ih->ctx->enc_ctx, src_ptr, _scratch_buf,
+                                          chunk_size, _ih->ctr_buf, _ih->stream_block, _ih->aes_offs);
             if (os_ret) {
                 ret = MBED_ERROR_FAILED_OPERATION;
                 goto fail;
@@ -357,7 +351,7 @@ int SecureStore::set_add_data(set_handle_t handle, const void *value_data, size_
             dst_ptr = static_cast <const uint8_t *>(value_data);
         }
 
-        os_ret = cmac_calc_data(_ih->auth_ctx, dst_ptr, chunk_size);
+        os_ret = cmac_calc_data(_ih->ctx->auth_ctx, dst_ptr, chunk_size);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
@@ -378,11 +372,7 @@ fail:
     if (_ih->key) {
         delete[] _ih->key;
     }
-    if (_ih->metadata.create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        mbedtls_aes_free(&_ih->enc_ctx);
-    }
-
-    mbedtls_cipher_free(&_ih->auth_ctx);
+    _ih->ctx = nullptr;
 
     // mark handle as invalid by clearing metadata size field in header
     _ih->metadata.metadata_size = 0;
@@ -410,7 +400,7 @@ int SecureStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
-    os_ret = cmac_calc_finish(_ih->auth_ctx, cmac);
+    os_ret = cmac_calc_finish(_ih->ctx->auth_ctx, cmac);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
@@ -441,11 +431,7 @@ int SecureStore::set_finalize(set_handle_t handle)
 end:
     // mark handle as invalid by clearing metadata size field in header
     _ih->metadata.metadata_size = 0;
-    if (_ih->metadata.create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        mbedtls_aes_free(&_ih->enc_ctx);
-    }
-
-    mbedtls_cipher_free(&_ih->auth_ctx);
+    _ih->ctx = nullptr;
 
     _mutex.unlock();
     return ret;
@@ -479,6 +465,7 @@ int SecureStore::remove(const char *key)
 {
     info_t info;
     _mutex.lock();
+    cache_remove(key);
 
     int ret = do_get(key, 0, 0, 0, 0, &info);
     // Allow deleting key if read error is of our own errors
@@ -492,6 +479,11 @@ int SecureStore::remove(const char *key)
         goto end;
     }
 
+    if (_in_transaction && _rbp_kv && (info.flags & REQUIRE_REPLAY_PROTECTION_FLAG)) {
+        ret = MBED_ERROR_INVALID_OPERATION;
+        goto end;
+    }
+
     ret = _underlying_kv->remove(key);
     if (ret) {
         goto end;
@@ -517,14 +509,12 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     int os_ret, ret;
     bool rbp_key_exists = false;
     uint8_t rbp_cmac[cmac_size];
-    size_t aes_offs = 0;
     uint32_t data_size;
     uint32_t actual_data_size;
     uint32_t current_offset;
     uint32_t chunk_size;
     uint32_t enc_lead_size;
     uint8_t *dest_buf;
-    bool enc_started = false, auth_started = false;
     uint32_t create_flags;
     size_t read_len;
     info_t rbp_info;
@@ -576,33 +566,26 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
         goto end;
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = crypto_ctx_get(key, create_flags & REQUIRE_CONFIDENTIALITY_FLAG, &_ih->ctx);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
     }
-    auth_started = true;
 
     // Although name is not part of the data, we calculate CMAC on it as well
-    os_ret = cmac_calc_data(_ih->auth_ctx, key, strlen(key));
+    os_ret = cmac_calc_data(_ih->ctx->auth_ctx, key, strlen(key));
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
     }
-    os_ret = cmac_calc_data(_ih->auth_ctx, &_ih->metadata, sizeof(record_metadata_t));
+    os_ret = cmac_calc_data(_ih->ctx->auth_ctx, &_ih->metadata, sizeof(record_metadata_t));
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
     }
 
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
-        if (os_ret) {
-            ret = MBED_ERROR_FAILED_OPERATION;
-            goto end;
-        }
-        enc_started = true;
+        encrypt_decrypt_start(_ih->metadata.iv, _ih->ctr_buf, _ih->stream_block, _ih->aes_offs);
     }
 
     data_size = _ih->metadata.data_size;
@@ -640,7 +623,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
             goto end;
         }
 
-        os_ret = cmac_calc_data(_ih->auth_ctx, dest_buf, chunk_size);
+        os_ret = cmac_calc_data(_ih->ctx->auth_ctx, dest_buf, chunk_size);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto end;
@@ -648,8 +631,8 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
 
         if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
             // Decrypt data in place
-            os_ret = encrypt_decrypt_data(_ih->enc_ctx, dest_buf, dest_buf, chunk_size, _ih->ctr_buf,
-                                          aes_offs);
+            os_ret = encrypt_decrypt_data(_ih->ctx->enc_ctx, dest_buf, dest_buf, chunk_size, _ih->ctr_buf,
+                                          _ih->stream_block, _ih->aes_offs);
             if (os_ret) {
                 ret = MBED_ERROR_FAILED_OPERATION;
                 goto end;
@@ -670,7 +653,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     }
 
     uint8_t calc_cmac[cmac_size], read_cmac[cmac_size];
-    os_ret = cmac_calc_finish(_ih->auth_ctx, calc_cmac);
+    os_ret = cmac_calc_finish(_ih->ctx->auth_ctx, calc_cmac);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
@@ -706,14 +689,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
 
 end:
     _ih->metadata.metadata_size = 0;
-
-    if (enc_started) {
-        mbedtls_aes_free(&_ih->enc_ctx);
-    }
-
-    if (auth_started) {
-        mbedtls_cipher_free(&_ih->auth_ctx);
-    }
+    _ih->ctx = nullptr;
 
     return ret;
 }
@@ -721,8 +697,34 @@ end:
 int SecureStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
                      size_t offset)
 {
+    info_t info;
+    size_t read_size = 0;
+    int ret;
+
     _mutex.lock();
-    int ret = do_get(key, buffer, buffer_size, actual_size, offset);
+
+    cache_entry_t *entry = cache_find(key);
+    if (entry && (offset <= entry->size)) {
+        read_size = std::min(buffer_size, (size_t)(entry->size - offset));
+        if (read_size) {
+            memcpy(buffer, entry->data + offset, read_size);
+        }
+        if (actual_size) {
+            *actual_size = read_size;
+        }
+        _mutex.unlock();
+        return MBED_SUCCESS;
+    }
+
+    ret = do_get(key, buffer, buffer_size, &read_size, offset, &info);
+    if (actual_size) {
+        *actual_size = read_size;
+    }
+
+    // Only whole values are cached
+    if ((ret == MBED_SUCCESS) && !offset && (read_size == info.size)) {
+        cache_add(key, buffer, info.size, info.flags);
+    }
     _mutex.unlock();
 
     return ret;
@@ -730,18 +732,204 @@ int SecureStore::get(const char *key, void *buffer, size_t buffer_size, size_t *
 
 int SecureStore::get_info(const char *key, info_t *info)
 {
+    int ret = MBED_SUCCESS;
+
     _mutex.lock();
-    int ret = do_get(key, 0, 0, 0, 0, info);
+    cache_entry_t *entry = cache_find(key);
+    if (!entry) {
+        ret = do_get(key, 0, 0, 0, 0, info);
+    } else if (info) {
+        info->flags = entry->flags;
+        info->size = entry->size;
+    }
     _mutex.unlock();
 
     return ret;
 }
 
+SecureStore::cache_entry_t *SecureStore::cache_find(const char *key)
+{
+    cache_entry_t *prev = 0;
+
+    if (!key) {
+        return 0;
+    }
+
+    for (cache_entry_t *entry = _cache; entry; prev = entry, entry = entry->next) {
+        if (strcmp(entry->key, key)) {
+            continue;
+        }
+        // Most recently used first
+        if (prev) {
+            prev->next = entry->next;
+            entry->next = _cache;
+            _cache = entry;
+        }
+        return entry;
+    }
+    return 0;
+}
+
+void SecureStore::cache_add(const char *key, const void *data, uint32_t size, uint32_t flags)
+{
+    size_t alloc_size = sizeof(cache_entry_t) + strlen(key) + 1 + size;
+
+    if (alloc_size > MBED_CONF_SECURESTORE_READ_CACHE_SIZE) {
+        return;
+    }
+
+    // Evict the least recently used values
+    while (_cache && (_cache_size + alloc_size > MBED_CONF_SECURESTORE_READ_CACHE_SIZE)) {
+        cache_entry_t **last = &_cache;
+        while ((*last)->next) {
+            last = &(*last)->next;
+        }
+        cache_free(*last);
+        *last = 0;
+    }
+
+    uint8_t *buf = new (std::nothrow) uint8_t[alloc_size];
+    if (!buf) {
+        return;
+    }
+    cache_entry_t *entry = reinterpret_cast<cache_entry_t *>(buf);
+    entry->alloc_size = alloc_size;
+    entry->flags = flags;
+    entry->size = size;
+    entry->key = reinterpret_cast<char *>(buf + sizeof(cache_entry_t));
+    strcpy(entry->key, key);
+    entry->data = buf + sizeof(cache_entry_t) + strlen(key) + 1;
+    if (size) {
+        memcpy(entry->data, data, size);
+    }
+
+    entry->next = _cache;
+    _cache = entry;
+    _cache_size += alloc_size;
+}
+
+void SecureStore::cache_remove(const char *key)
+{
+    if (cache_find(key)) {
+        cache_entry_t *entry = _cache;
+        _cache = entry->next;
+        cache_free(entry);
+    }
+}
+
+void SecureStore::cache_clear()
+{
+    while (_cache) {
+        cache_entry_t *entry = _cache;
+        _cache = entry->next;
+        cache_free(entry);
+    }
+}
+
+void SecureStore::cache_free(cache_entry_t *entry)
+{
+    _cache_size -= entry->alloc_size;
+    mbedtls_platform_zeroize(entry, entry->alloc_size);
+    delete[] reinterpret_cast<uint8_t *>(entry);
+}
+
+int SecureStore::crypto_ctx_get(const char *key, bool encrypt, crypto_ctx_t **ctx)
+{
+    uint8_t derived_key[derived_key_size];
+    crypto_ctx_t *entry = nullptr;
+    crypto_ctx_t *lru = &_crypto_ctxs[0];
+    int os_ret;
+
+    for (uint32_t i = 0; i < crypto_ctx_count; i++) {
+        if (_crypto_ctxs[i].key[0] && !strcmp(_crypto_ctxs[i].key, key)) {
+            entry = &_crypto_ctxs[i];
+            break;
+        }
+        // Unused entries have the lowest use count
+        if (_crypto_ctxs[i].last_use < lru->last_use) {
+            lru = &_crypto_ctxs[i];
+        }
+    }
+
+    if (entry) {
+        // Same keys, only the CMAC calculation starts over
+        os_ret = mbedtls_cipher_cmac_reset(&entry->auth_ctx);
+        if (os_ret) {
+            goto fail;
+        }
+    } else {
+        entry = lru;
+        crypto_ctx_free(entry);
+        mbedtls_aes_init(&entry->enc_ctx);
+        mbedtls_cipher_init(&entry->auth_ctx);
+        // Contexts are freed from now on, even if not set up
+        strcpy(entry->key, key);
+
+        os_ret = derive_key(auth_prefix, key, _scratch_buf, scratch_buf_size, derived_key);
+        if (os_ret) {
+            goto fail;
+        }
+        os_ret = mbedtls_cipher_setup(&entry->auth_ctx, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB));
+        if (os_ret) {
+            goto fail;
+        }
+        os_ret = mbedtls_cipher_cmac_starts(&entry->auth_ctx, derived_key, cmac_size * 8);
+        if (os_ret) {
+            goto fail;
+        }
+    }
+
+    // The encryption key is only derived once a record of that key needs it
+    if (encrypt && !entry->enc_ready) {
+        os_ret = derive_key(enc_prefix, key, _scratch_buf, scratch_buf_size, derived_key);
+        if (os_ret) {
+            goto fail;
+        }
+        os_ret = mbedtls_aes_setkey_enc(&entry->enc_ctx, derived_key, enc_block_size * 8);
+        if (os_ret) {
+            goto fail;
+        }
+        entry->enc_ready = true;
+    }
+
+    mbedtls_platform_zeroize(derived_key, sizeof(derived_key));
+    entry->last_use = ++_crypto_use_count;
+    *ctx = entry;
+    return 0;
+
+fail:
+    mbedtls_platform_zeroize(derived_key, sizeof(derived_key));
+    crypto_ctx_free(entry);
+    return os_ret;
+}
+
+void SecureStore::crypto_ctx_clear()
+{
+    for (uint32_t i = 0; i < crypto_ctx_count; i++) {
+        crypto_ctx_free(&_crypto_ctxs[i]);
+    }
+    _crypto_use_count = 0;
+}
+
+void SecureStore::crypto_ctx_free(crypto_ctx_t *ctx)
+{
+    if (ctx->key[0]) {
+        mbedtls_aes_free(&ctx->enc_ctx);
+        mbedtls_cipher_free(&ctx->auth_ctx);
+    }
+    mbedtls_platform_zeroize(ctx, sizeof(crypto_ctx_t));
+}
+
 
 int SecureStore::init()
 {
     int ret = MBED_SUCCESS;
 
+    MBED_STATIC_ASSERT(crypto_ctx_count > 0, "SecureStore needs at least one crypto context");
+    // The scratch buffer also holds the salt of the derived keys: prefix and full key name
+    MBED_STATIC_ASSERT(MBED_CONF_SECURESTORE_CRYPTO_CHUNK_SIZE > KVStore::MAX_KEY_SIZE + 4,
+                       "SecureStore crypto chunk size is too small for the key names");
+
     MBED_ASSERT(!(scratch_buf_size % enc_block_size));
     if (scratch_buf_size % enc_block_size) {
         return MBED_SYSTEM_ERROR_BASE;
@@ -760,6 +948,9 @@ int SecureStore::init()
 
     _scratch_buf = new uint8_t[scratch_buf_size];
     _ih = new inc_set_handle_t;
+    _crypto_ctxs = new crypto_ctx_t[crypto_ctx_count];
+    memset(_crypto_ctxs, 0, crypto_ctx_count * sizeof(crypto_ctx_t));
+    _crypto_use_count = 0;
 
     ret = _underlying_kv->init();
     if (ret) {
@@ -785,9 +976,18 @@ int SecureStore::deinit()
     _mutex.lock();
     int ret;
     if (_is_initialized) {
+        // A transaction left open is dropped by the underlying KV
+        if (_in_transaction) {
+            _in_transaction = false;
+            _mutex.unlock();
+        }
+        cache_clear();
         if (_entropy) {
             mbedtls_entropy_free(_entropy);
             delete _entropy;
+            crypto_ctx_clear();
+            delete[] _crypto_ctxs;
+            _crypto_ctxs = nullptr;
             delete _ih;
             delete _scratch_buf;
             _entropy = nullptr;
@@ -825,6 +1025,7 @@ int SecureStore::reset()
     }
 
     _mutex.lock();
+    cache_clear();
     ret = _underlying_kv->reset();
     if (ret) {
         goto end;
@@ -842,6 +1043,72 @@ end:
     return ret;
 }
 
+int SecureStore::transaction_begin()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    ret = _underlying_kv->transaction_begin();
+    if (ret) {
+        _mutex.unlock();
+        return ret;
+    }
+
+    // The mutex stays locked until the transaction ends
+    _in_transaction = true;
+    return MBED_SUCCESS;
+}
+
+int SecureStore::transaction_commit()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    // Values read during the transaction may have been cached
+    ret = _underlying_kv->transaction_commit();
+    _in_transaction = false;
+    cache_clear();
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return ret;
+}
+
+int SecureStore::transaction_abort()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    ret = _underlying_kv->transaction_abort();
+    _in_transaction = false;
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return ret;
+}
+
 int SecureStore::iterator_open(iterator_t *it, const char *prefix)
 {
     key_iterator_handle_t *handle;
@@ -68,6 +68,7 @@ int KVMap::attach(const char *partition_name, kvstore_config_t *kv_config)
     kv_partition_name = new char[strlen(partition_name) + 1];
     strcpy(kv_partition_name, partition_name);
     _kv_map_table[_kv_num_attached_kvs].partition_name = kv_partition_name;
+    _kv_map_table[_kv_num_attached_kvs].partition_name_len = strlen(partition_name);
     _kv_map_table[_kv_num_attached_kvs].kv_config = kv_config;
     _kv_num_attached_kvs++;
 
@@ -190,7 +191,7 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
 {
     int ret = MBED_SUCCESS;
     int delimiter_index;
-    int i;
+    kv_map_entry_t *partition;
     const char *delimiter_position;
 
     const char *temp_str = full_name;
@@ -221,19 +222,12 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
 
 
     delimiter_index = delimiter_position - temp_str;
-    for (i = 0; i < _kv_num_attached_kvs; i++) {
-
-        if (strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) != 0) {
-            continue;
-        }
-
-        *kv_config = _kv_map_table[i].kv_config;
-        break;
-    }
-    if (i == _kv_num_attached_kvs) {
+    partition = find_partition(temp_str, delimiter_index);
+    if (partition == NULL) {
         ret = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit;
     }
+    *kv_config = partition->kv_config;
 exit:
     if (ret == MBED_SUCCESS) {
         //if success extract the key
@@ -242,6 +236,60 @@ exit:
     return ret;
 }
 
+int KVMap::partition_lookup(const char *partition_name, kvstore_config_t **kv_config)
+{
+    int ret = MBED_SUCCESS;
+    const char *delimiter_position;
+    size_t name_len;
+    kv_map_entry_t *partition;
+
+    if ((partition_name == NULL) || (kv_config == NULL)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (*partition_name == '/') {
+        partition_name++;
+    }
+    delimiter_position = strchr(partition_name, '/');
+    if (delimiter_position == NULL) {
+        name_len = strlen(partition_name);
+    } else if (delimiter_position[1] == '\0') {
+        name_len = delimiter_position - partition_name;
+    } else {
+        // A key follows the partition name
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex->lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit;
+    }
+
+    partition = find_partition(partition_name, name_len);
+    if (partition == NULL) {
+        ret = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit;
+    }
+    *kv_config = partition->kv_config;
+
+exit:
+    _mutex->unlock();
+    return ret;
+}
+
+kv_map_entry_t *KVMap::find_partition(const char *name, size_t name_len)
+{
+    for (int i = 0; i < _kv_num_attached_kvs; i++) {
+        if ((_kv_map_table[i].partition_name_len == name_len) &&
+                (memcmp(name, _kv_map_table[i].partition_name, name_len) == 0)) {
+            return &_kv_map_table[i];
+        }
+    }
+    return NULL;
+}
+
 KVStore *KVMap::get_internal_kv_instance(const char *name)
 {
 
@@ -0,0 +1,924 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kvstore/PackedFileSystemStore.h"
+#include "kv_config/kv_config.h"
+#include "filesystem/Dir.h"
+#include "mbed_error.h"
+#include "MbedCRC.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mbed-trace/mbed_trace.h"
+#define TRACE_GROUP "PFST"
+
+#define PFST_REVISION 1
+#define PFST_MAGIC 0x50465354 // "PFST" hex 'magic' signature
+
+#define PFST_DEFAULT_FOLDER_PATH "kvstore" //default PackedFileSystemStore folder path on fs
+#define PFST_LOG_NAME "/packed.log"
+#define PFST_TMP_NAME "/packed.tmp"
+
+static const uint32_t delete_flag = (1UL << 31);
+// Only write once flag is supported, other two are kept in storage but ignored
+static const uint32_t supported_flags = mbed::KVStore::WRITE_ONCE_FLAG | mbed::KVStore::REQUIRE_CONFIDENTIALITY_FLAG |
+                                        mbed::KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
+
+using namespace mbed;
+
+namespace {
+
+// A record is the header, the key, the data and the CRC of the three
+typedef struct {
+    uint32_t magic;
+    uint16_t header_size;
+    uint16_t revision;
+    uint32_t flags;
+    uint16_t key_size;
+    uint16_t reserved;
+    uint32_t data_size;
+} record_header_t;
+
+// incremental set handle
+typedef struct {
+    record_header_t header;
+    uint32_t offset;
+    uint32_t data_added;
+    uint32_t crc;
+    char key[KVStore::MAX_KEY_SIZE + 1];
+} inc_set_handle_t;
+
+// iterator handle
+typedef struct {
+    uint32_t ram_table_ind;
+    char *prefix;
+} key_iterator_handle_t;
+
+} // anonymous namespace
+
+static const uint32_t work_buf_size = 64;
+static const uint32_t initial_crc = 0xFFFFFFFF;
+static const uint32_t initial_max_keys = 16;
+
+// Local Functions
+static char *string_concat(const char *src, const char *suffix);
+
+static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data_buf)
+{
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct(init_crc, 0x0, true, false);
+    ct.compute(data_buf, data_size, &crc);
+    return crc;
+}
+
+static inline uint32_t record_size(uint32_t key_size, uint32_t data_size)
+{
+    return sizeof(record_header_t) + key_size + data_size + sizeof(uint32_t);
+}
+
+// Class Functions
+PackedFileSystemStore::PackedFileSystemStore(FileSystem *fs, size_t compaction_threshold) : _fs(fs),
+    _is_initialized(false), _log_path(NULL), _tmp_path(NULL), _compaction_threshold(compaction_threshold),
+    _log_size(0), _live_size(0), _ram_table(NULL), _num_keys(0), _max_keys(0), _cur_inc_set_handle(NULL)
+{
+
+}
+
+PackedFileSystemStore::~PackedFileSystemStore()
+{
+    deinit();
+}
+
+int PackedFileSystemStore::init()
+{
+    int status = MBED_SUCCESS;
+    const char *folder_path;
+    Dir kv_dir;
+
+    _mutex.lock();
+    if (_is_initialized) {
+        goto exit_point;
+    }
+
+    folder_path = get_filesystemstore_folder_path();
+    if (folder_path == NULL) {
+        folder_path = PFST_DEFAULT_FOLDER_PATH;
+    }
+
+    if (kv_dir.open(_fs, folder_path) != 0) {
+        tr_info("KV Dir: %s, doesnt exist - creating new.. ", folder_path);
+        if (_fs->mkdir(folder_path, 0777) != 0) {
+            tr_error("KV Dir: %s, mkdir failed.. ", folder_path);
+            status = MBED_ERROR_FAILED_OPERATION;
+            goto exit_point;
+        }
+    } else {
+        kv_dir.close();
+    }
+
+    // Left over by a failed compaction, which closed the log
+    delete[] _log_path;
+    delete[] _tmp_path;
+    delete[] _ram_table;
+    _log_path = string_concat(folder_path, PFST_LOG_NAME);
+    _tmp_path = string_concat(folder_path, PFST_TMP_NAME);
+
+    status = _open_log();
+    if (status != MBED_SUCCESS) {
+        tr_error("Log: %s, open failed", _log_path);
+        goto exit_point;
+    }
+
+    _max_keys = initial_max_keys;
+    _ram_table = new ram_table_entry_t[_max_keys];
+    _num_keys = 0;
+    _live_size = 0;
+    _cur_inc_set_handle = NULL;
+
+    status = _build_ram_table();
+    if (status != MBED_SUCCESS) {
+        _log.close();
+        goto exit_point;
+    }
+
+    _is_initialized = true;
+
+exit_point:
+    if (!_is_initialized) {
+        delete[] _ram_table;
+        _ram_table = NULL;
+        delete[] _log_path;
+        _log_path = NULL;
+        delete[] _tmp_path;
+        _tmp_path = NULL;
+    }
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::deinit()
+{
+    _mutex.lock();
+    if (_is_initialized) {
+        _log.close();
+        delete[] _ram_table;
+        _ram_table = NULL;
+        delete[] _log_path;
+        _log_path = NULL;
+        delete[] _tmp_path;
+        _tmp_path = NULL;
+        _is_initialized = false;
+    }
+    _mutex.unlock();
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::reset()
+{
+    int status = MBED_SUCCESS;
+
+    _mutex.lock();
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    // Clear all the keys, even if write-onced
+    if ((_log.truncate(0) != 0) || (_log.sync() != 0)) {
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+    _num_keys = 0;
+    _log_size = 0;
+    _live_size = 0;
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
+{
+    int status = MBED_SUCCESS;
+    set_handle_t handle;
+
+    if (false == _is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if ((!is_valid_key(key)) || ((buffer == NULL) && (size > 0))) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    status = set_start(&handle, key, size, create_flags);
+    if (status != MBED_SUCCESS) {
+        return status;
+    }
+
+    status = set_add_data(handle, buffer, size);
+    if (status != MBED_SUCCESS) {
+        set_finalize(handle);
+        return status;
+    }
+
+    return set_finalize(handle);
+}
+
+int PackedFileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size, size_t offset)
+{
+    int status = MBED_SUCCESS;
+    record_header_t header;
+    uint32_t ind, hash;
+    size_t value_actual_size;
+
+    if ((buffer == NULL) && (buffer_size > 0)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    status = _find_record(key, ind, hash);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    status = _read_record(_ram_table[ind].offset, &header, NULL);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    // Actual size is the minimum of buffer_size and remainder of data (data size - offset)
+    if (offset > header.data_size) {
+        status = MBED_ERROR_INVALID_SIZE;
+        goto exit_point;
+    }
+    value_actual_size = header.data_size - offset;
+    if (value_actual_size > buffer_size) {
+        value_actual_size = buffer_size;
+    }
+
+    if (value_actual_size > 0) {
+        off_t data_offset = _ram_table[ind].offset + sizeof(record_header_t) + header.key_size + offset;
+        if ((_log.seek(data_offset, SEEK_SET) != data_offset) ||
+                (_log.read(buffer, value_actual_size) != (ssize_t)value_actual_size)) {
+            status = MBED_ERROR_FAILED_OPERATION;
+            goto exit_point;
+        }
+    }
+
+    if (actual_size != NULL) {
+        *actual_size = value_actual_size;
+    }
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::get_info(const char *key, info_t *info)
+{
+    int status = MBED_SUCCESS;
+    record_header_t header;
+    uint32_t ind, hash;
+
+    _mutex.lock();
+
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    status = _find_record(key, ind, hash);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    status = _read_record(_ram_table[ind].offset, &header, NULL);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    if (info != NULL) {
+        info->size = header.data_size;
+        info->flags = header.flags & supported_flags;
+    }
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::remove(const char *key)
+{
+    int status = MBED_SUCCESS;
+    record_header_t header;
+    uint32_t ind, hash, crc, offset, size;
+
+    _mutex.lock();
+
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    status = _find_record(key, ind, hash);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    status = _read_record(_ram_table[ind].offset, &header, NULL);
+    if (status != MBED_SUCCESS) {
+        goto exit_point;
+    }
+
+    if (header.flags & KVStore::WRITE_ONCE_FLAG) {
+        status = MBED_ERROR_WRITE_PROTECTED;
+        goto exit_point;
+    }
+
+    // Append a deletion record
+    header.flags = delete_flag;
+    header.data_size = 0;
+    crc = calc_crc(initial_crc, sizeof(record_header_t), &header);
+    crc = calc_crc(crc, header.key_size, key);
+    offset = _log_size;
+    size = record_size(header.key_size, 0);
+
+    if ((_write(offset, &header, sizeof(record_header_t)) != MBED_SUCCESS) ||
+            (_write(offset + sizeof(record_header_t), key, header.key_size) != MBED_SUCCESS) ||
+            (_write(offset + sizeof(record_header_t) + header.key_size, &crc, sizeof(crc)) != MBED_SUCCESS) ||
+            (_log.sync() != 0)) {
+        _log.truncate(offset);
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+
+    _log_size = offset + size;
+    status = _index_record(key, offset, size, true);
+    if (status == MBED_SUCCESS) {
+        _compact_if_needed();
+    }
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+// Incremental set API
+int PackedFileSystemStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size,
+                                     uint32_t create_flags)
+{
+    int status = MBED_SUCCESS;
+    inc_set_handle_t *set_handle = NULL;
+    record_header_t header;
+    uint32_t ind, hash;
+
+    if ((handle == NULL) || (!is_valid_key(key)) || (create_flags & ~supported_flags)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (final_data_size > UINT32_MAX - record_size(MAX_KEY_SIZE, 0)) {
+        return MBED_ERROR_INVALID_SIZE;
+    }
+
+    // Only a single key can be incrementally edited at a time
+    _mutex.lock();
+
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    status = _find_record(key, ind, hash);
+    if (status == MBED_SUCCESS) {
+        status = _read_record(_ram_table[ind].offset, &header, NULL);
+        if (status != MBED_SUCCESS) {
+            goto exit_point;
+        }
+        if (header.flags & KVStore::WRITE_ONCE_FLAG) {
+            status = MBED_ERROR_WRITE_PROTECTED;
+            goto exit_point;
+        }
+    } else if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+        goto exit_point;
+    }
+    status = MBED_SUCCESS;
+
+    set_handle = new inc_set_handle_t;
+    set_handle->header.magic = PFST_MAGIC;
+    set_handle->header.header_size = sizeof(record_header_t);
+    set_handle->header.revision = PFST_REVISION;
+    set_handle->header.flags = create_flags;
+    set_handle->header.key_size = strlen(key);
+    set_handle->header.reserved = 0;
+    set_handle->header.data_size = final_data_size;
+    set_handle->offset = _log_size;
+    set_handle->data_added = 0;
+    strcpy(set_handle->key, key);
+
+    // The record is appended, and only indexed by set_finalize
+    if ((_write(set_handle->offset, &set_handle->header, sizeof(record_header_t)) != MBED_SUCCESS) ||
+            (_write(set_handle->offset + sizeof(record_header_t), key, set_handle->header.key_size) != MBED_SUCCESS)) {
+        tr_error("set_start failed to append to: %s", _log_path);
+        _log.truncate(set_handle->offset);
+        delete set_handle;
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+    set_handle->crc = calc_crc(initial_crc, sizeof(record_header_t), &set_handle->header);
+    set_handle->crc = calc_crc(set_handle->crc, set_handle->header.key_size, key);
+
+    *handle = (set_handle_t)set_handle;
+    _cur_inc_set_handle = *handle;
+
+exit_point:
+    if (status != MBED_SUCCESS) {
+        _mutex.unlock();
+    }
+    return status;
+}
+
+int PackedFileSystemStore::set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
+{
+    int status = MBED_SUCCESS;
+    inc_set_handle_t *set_handle = (inc_set_handle_t *)handle;
+    uint32_t data_offset;
+
+    if (((value_data == NULL) && (data_size > 0)) || (handle == NULL) || (handle != _cur_inc_set_handle)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Single key incrementally edited, can be edited from multiple threads - lock to protect
+    _inc_data_add_mutex.lock();
+    if (data_size > set_handle->header.data_size - set_handle->data_added) {
+        tr_warning("Added Data(%d) will exceed set_start final size(%d) - not adding data to key: %s",
+                   set_handle->data_added + data_size, set_handle->header.data_size, set_handle->key);
+        status = MBED_ERROR_INVALID_SIZE;
+        goto exit_point;
+    }
+
+    data_offset = set_handle->offset + sizeof(record_header_t) + set_handle->header.key_size + set_handle->data_added;
+    if (_write(data_offset, value_data, data_size) != MBED_SUCCESS) {
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+    set_handle->crc = calc_crc(set_handle->crc, data_size, value_data);
+    set_handle->data_added += data_size;
+
+exit_point:
+    _inc_data_add_mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::set_finalize(set_handle_t handle)
+{
+    int status = MBED_SUCCESS;
+    inc_set_handle_t *set_handle = (inc_set_handle_t *)handle;
+    uint32_t size;
+
+    if ((handle == NULL) || (handle != _cur_inc_set_handle)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    size = record_size(set_handle->header.key_size, set_handle->header.data_size);
+    if (set_handle->data_added != set_handle->header.data_size) {
+        tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - key: %s",
+                 set_handle->data_added, set_handle->header.data_size, set_handle->key);
+        status = MBED_ERROR_INVALID_SIZE;
+    } else if ((_write(set_handle->offset + size - sizeof(uint32_t), &set_handle->crc, sizeof(uint32_t)) != MBED_SUCCESS) ||
+               (_log.sync() != 0)) {
+        status = MBED_ERROR_FAILED_OPERATION;
+    }
+
+    if (status == MBED_SUCCESS) {
+        _log_size = set_handle->offset + size;
+        status = _index_record(set_handle->key, set_handle->offset, size, false);
+        if (status == MBED_SUCCESS) {
+            _compact_if_needed();
+        }
+    } else {
+        // Drop the partial record, so that the next one directly follows the valid ones
+        _log.truncate(set_handle->offset);
+        _log.sync();
+    }
+
+    delete set_handle;
+    _cur_inc_set_handle = NULL;
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::iterator_open(iterator_t *it, const char *prefix)
+{
+    int status = MBED_SUCCESS;
+    key_iterator_handle_t *key_it = NULL;
+
+    if (it == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    key_it = new key_iterator_handle_t;
+    key_it->ram_table_ind = 0;
+    key_it->prefix = NULL;
+    if (prefix != NULL) {
+        key_it->prefix = string_concat(prefix, "");
+    }
+    *it = (iterator_t)key_it;
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
+{
+    int status = MBED_ERROR_ITEM_NOT_FOUND;
+    key_iterator_handle_t *key_it = (key_iterator_handle_t *)it;
+    record_header_t header;
+    char temp_key[MAX_KEY_SIZE + 1];
+
+    if ((key_it == NULL) || (key == NULL)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    while (key_it->ram_table_ind < _num_keys) {
+        if (_read_record(_ram_table[key_it->ram_table_ind].offset, &header, temp_key) != MBED_SUCCESS) {
+            status = MBED_ERROR_FAILED_OPERATION;
+            break;
+        }
+        if ((key_it->prefix != NULL) && (strncmp(temp_key, key_it->prefix, strlen(key_it->prefix)) != 0)) {
+            key_it->ram_table_ind++;
+            continue;
+        }
+        if (key_size < header.key_size + 1U) {
+            status = MBED_ERROR_INVALID_SIZE;
+            break;
+        }
+        strcpy(key, temp_key);
+        key_it->ram_table_ind++;
+        status = MBED_SUCCESS;
+        break;
+    }
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::iterator_close(iterator_t it)
+{
+    key_iterator_handle_t *key_it = (key_iterator_handle_t *)it;
+
+    if (key_it == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete[] key_it->prefix;
+    delete key_it;
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::compact()
+{
+    int status = MBED_SUCCESS;
+    File tmp_file;
+    uint8_t work_buf[work_buf_size];
+    uint32_t new_offset = 0;
+    bool replaced;
+
+    _mutex.lock();
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    if (tmp_file.open(_fs, _tmp_path, O_WRONLY | O_CREAT | O_TRUNC) != 0) {
+        tr_error("Compaction failed to open: %s", _tmp_path);
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+
+    // Copy the live records to the new log, in the order of the index
+    for (uint32_t ind = 0; ind < _num_keys && status == MBED_SUCCESS; ind++) {
+        off_t offset = _ram_table[ind].offset;
+        uint32_t remaining = _ram_table[ind].size;
+        if (_log.seek(offset, SEEK_SET) != offset) {
+            status = MBED_ERROR_FAILED_OPERATION;
+        }
+        while (remaining && status == MBED_SUCCESS) {
+            uint32_t chunk = remaining < work_buf_size ? remaining : work_buf_size;
+            if ((_log.read(work_buf, chunk) != (ssize_t)chunk) ||
+                    (tmp_file.write(work_buf, chunk) != (ssize_t)chunk)) {
+                status = MBED_ERROR_FAILED_OPERATION;
+            }
+            remaining -= chunk;
+        }
+    }
+
+    if ((tmp_file.sync() != 0) || (tmp_file.close() != 0)) {
+        status = MBED_ERROR_FAILED_OPERATION;
+    }
+    if (status != MBED_SUCCESS) {
+        tr_error("Compaction failed to write: %s", _tmp_path);
+        _fs->remove(_tmp_path);
+        goto exit_point;
+    }
+
+    _log.close();
+    replaced = (_fs->rename(_tmp_path, _log_path) == 0);
+    if (!replaced) {
+        // Not every file system renames over an existing file. The new log is recovered
+        // by _open_log if the log can't be renamed after being removed.
+        if (_fs->remove(_log_path) == 0) {
+            replaced = (_fs->rename(_tmp_path, _log_path) == 0);
+            if (!replaced) {
+                tr_error("Compaction failed to rename: %s", _tmp_path);
+                status = MBED_ERROR_FAILED_OPERATION;
+                _is_initialized = false;
+                goto exit_point;
+            }
+        }
+    }
+
+    if (_open_log() != MBED_SUCCESS) {
+        status = MBED_ERROR_FAILED_OPERATION;
+        _is_initialized = false;
+        goto exit_point;
+    }
+
+    if (!replaced) {
+        tr_error("Compaction failed to replace: %s", _log_path);
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+
+    for (uint32_t ind = 0; ind < _num_keys; ind++) {
+        _ram_table[ind].offset = new_offset;
+        new_offset += _ram_table[ind].size;
+    }
+    _log_size = new_offset;
+
+exit_point:
+    _mutex.unlock();
+    return status;
+}
+
+int PackedFileSystemStore::_compact_if_needed()
+{
+    uint32_t superseded = _log_size - _live_size;
+    if ((superseded <= _compaction_threshold) || (superseded <= _live_size)) {
+        return MBED_SUCCESS;
+    }
+
+    // The change is already committed, a failed compaction is retried on the next one
+    int status = compact();
+    if (status != MBED_SUCCESS) {
+        tr_warning("Compaction failed: %d", status);
+    }
+    return status;
+}
+
+int PackedFileSystemStore::_write(uint32_t offset, const void *data, size_t size)
+{
+    if (size == 0) {
+        return MBED_SUCCESS;
+    }
+    if ((_log.seek(offset, SEEK_SET) != (off_t)offset) ||
+            (_log.write(data, size) != (ssize_t)size)) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::_read_record(uint32_t offset, void *header, char *key)
+{
+    record_header_t *rec_header = (record_header_t *)header;
+
+    if ((_log.seek(offset, SEEK_SET) != (off_t)offset) ||
+            (_log.read(rec_header, sizeof(record_header_t)) != sizeof(record_header_t))) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    if (rec_header->key_size > MAX_KEY_SIZE) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    if (key != NULL) {
+        if (_log.read(key, rec_header->key_size) != rec_header->key_size) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+        key[rec_header->key_size] = '\0';
+    }
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::_find_record(const char *key, uint32_t &ind, uint32_t &hash)
+{
+    record_header_t header;
+    char temp_key[MAX_KEY_SIZE + 1];
+    uint32_t lo = 0, hi = _num_keys;
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    hash = calc_crc(initial_crc, strlen(key), key);
+
+    // The table is sorted by ascending hash: look for the first entry not below our hash
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (_ram_table[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    ind = lo;
+
+    // Several keys may share the same hash
+    for (uint32_t i = lo; (i < _num_keys) && (_ram_table[i].hash == hash); i++) {
+        int ret = _read_record(_ram_table[i].offset, &header, temp_key);
+        if (ret != MBED_SUCCESS) {
+            return ret;
+        }
+        if (!strcmp(temp_key, key)) {
+            ind = i;
+            return MBED_SUCCESS;
+        }
+    }
+    return MBED_ERROR_ITEM_NOT_FOUND;
+}
+
+int PackedFileSystemStore::_index_record(const char *key, uint32_t offset, uint32_t size, bool remove)
+{
+    uint32_t ind, hash;
+    int status = _find_record(key, ind, hash);
+
+    if (status == MBED_SUCCESS) {
+        _live_size -= _ram_table[ind].size;
+        if (remove) {
+            memmove(&_ram_table[ind], &_ram_table[ind + 1], sizeof(ram_table_entry_t) * (_num_keys - ind - 1));
+            _num_keys--;
+        } else {
+            _ram_table[ind].offset = offset;
+            _ram_table[ind].size = size;
+            _live_size += size;
+        }
+        return MBED_SUCCESS;
+    }
+
+    if (status != MBED_ERROR_ITEM_NOT_FOUND) {
+        return status;
+    }
+    if (remove) {
+        return MBED_SUCCESS;
+    }
+
+    if (_num_keys == _max_keys) {
+        ram_table_entry_t *new_table = new ram_table_entry_t[_max_keys * 2];
+        memcpy(new_table, _ram_table, sizeof(ram_table_entry_t) * _num_keys);
+        delete[] _ram_table;
+        _ram_table = new_table;
+        _max_keys *= 2;
+    }
+    memmove(&_ram_table[ind + 1], &_ram_table[ind], sizeof(ram_table_entry_t) * (_num_keys - ind));
+    _ram_table[ind].hash = hash;
+    _ram_table[ind].offset = offset;
+    _ram_table[ind].size = size;
+    _num_keys++;
+    _live_size += size;
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::_build_ram_table()
+{
+    record_header_t header;
+    char key[MAX_KEY_SIZE + 1];
+    uint8_t work_buf[work_buf_size];
+    off_t file_size = _log.size();
+    uint32_t offset = 0;
+    uint32_t crc, stored_crc;
+    int status;
+
+    if (file_size < 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    // Replay the records in order: the last one of a key is its current value
+    while (offset + record_size(0, 0) <= (uint32_t)file_size) {
+        if (_read_record(offset, &header, NULL) != MBED_SUCCESS) {
+            break;
+        }
+        uint32_t available = (uint32_t)file_size - offset;
+        if ((header.magic != PFST_MAGIC) || (header.header_size != sizeof(record_header_t)) ||
+                (header.revision > PFST_REVISION) || (header.key_size == 0) || (header.key_size > MAX_KEY_SIZE) ||
+                (record_size(header.key_size, 0) > available) ||
+                (header.data_size > available - record_size(header.key_size, 0))) {
+            break;
+        }
+
+        crc = calc_crc(initial_crc, sizeof(record_header_t), &header);
+        if (_log.read(key, header.key_size) != header.key_size) {
+            break;
+        }
+        key[header.key_size] = '\0';
+        crc = calc_crc(crc, header.key_size, key);
+
+        uint32_t remaining = header.data_size;
+        while (remaining) {
+            uint32_t chunk = remaining < work_buf_size ? remaining : work_buf_size;
+            if (_log.read(work_buf, chunk) != (ssize_t)chunk) {
+                break;
+            }
+            crc = calc_crc(crc, chunk, work_buf);
+            remaining -= chunk;
+        }
+        if (remaining || (_log.read(&stored_crc, sizeof(stored_crc)) != sizeof(stored_crc)) || (crc != stored_crc)) {
+            break;
+        }
+
+        uint32_t size = record_size(header.key_size, header.data_size);
+        status = _index_record(key, offset, size, header.flags & delete_flag);
+        if (status != MBED_SUCCESS) {
+            return status;
+        }
+        offset += size;
+    }
+
+    _log_size = offset;
+    if (offset != (uint32_t)file_size) {
+        // A record torn by a power loss ends the log
+        tr_warning("Log: %s, dropping %d bytes after offset %d", _log_path, (int)(file_size - offset), (int)offset);
+        if ((_log.truncate(offset) != 0) || (_log.sync() != 0)) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+    }
+    return MBED_SUCCESS;
+}
+
+int PackedFileSystemStore::_open_log()
+{
+    File tmp_file;
+
+    if (_log.open(_fs, _log_path, O_RDWR) == 0) {
+        // Drop the new log of an interrupted compaction
+        _fs->remove(_tmp_path);
+        return MBED_SUCCESS;
+    }
+
+    if (tmp_file.open(_fs, _tmp_path, O_RDONLY) == 0) {
+        // Compaction interrupted after removing the log, the new one is complete
+        tmp_file.close();
+        if ((_fs->rename(_tmp_path, _log_path) != 0) || (_log.open(_fs, _log_path, O_RDWR) != 0)) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+        return MBED_SUCCESS;
+    }
+
+    if (_log.open(_fs, _log_path, O_RDWR | O_CREAT) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    return MBED_SUCCESS;
+}
+
+// Local Functions
+static char *string_concat(const char *src, const char *suffix)
+{
+    size_t src_size = strlen(src);
+    char *string_copy = new char[src_size + strlen(suffix) + 1];
+    strcpy(string_copy, src);
+    strcpy(string_copy + src_size, suffix);
+    return string_copy;
+}
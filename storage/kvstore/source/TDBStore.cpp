@@ -32,7 +32,10 @@ using namespace mbed;
 // --------------------------------------------------------- Definitions ----------------------------------------------------------
 
 static const uint32_t delete_flag = (1UL << 31);
-static const uint32_t internal_flags = delete_flag;
+// Record of a transaction (its id in the reserved header field), only valid once followed by the
+// commit record of the transaction
+static const uint32_t transaction_flag = (1UL << 30);
+static const uint32_t internal_flags = delete_flag | transaction_flag;
 // Only write once flag is supported, other two are kept in storage but ignored
 static const uint32_t supported_flags = KVStore::WRITE_ONCE_FLAG | KVStore::REQUIRE_CONFIDENTIALITY_FLAG | KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
 
@@ -49,11 +52,20 @@ typedef struct {
     uint32_t crc;
 } record_header_t;
 
+// Also the layout of the index record data
 typedef struct {
-    uint32_t  hash;
-    bd_size_t bd_offset;
+    uint32_t hash;
+    uint32_t bd_offset;
 } ram_table_entry_t;
 
+// First characters of a key, kept along its RAM table entry so that iterators only read the
+// records whose key may match their prefix
+static const uint32_t key_prefix_size = 7;
+typedef struct {
+    uint8_t len;                    // 0 if not known yet
+    char chars[key_prefix_size];
+} key_prefix_t;
+
 static const char *master_rec_key = "TDBS";
 static const uint32_t tdbstore_magic = 0x54686683;
 static const uint32_t tdbstore_revision = 1;
@@ -61,7 +73,7 @@ static const uint32_t tdbstore_revision = 1;
 typedef struct {
     uint16_t version;
     uint16_t tdbstore_revision;
-    uint32_t reserved;
+    uint32_t index_offset;
 } master_record_data_t;
 
 typedef enum {
@@ -90,6 +102,7 @@ typedef struct {
     uint32_t ram_table_ind;
     uint32_t hash;
     bool new_key;
+    char key_prefix[key_prefix_size + 1];
 } inc_set_handle_t;
 
 // iterator handle
@@ -130,7 +143,9 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _area_params{}, _prog_size(0), _work_buf(0), _key_buf(0), _inc_set_handle(0)
+    _area_params{}, _prog_size(0), _work_buf(0), _key_buf(0), _inc_set_handle(0),
+    _gc_offsets(0), _gc_to_offset(0), _key_prefixes(0), _in_transaction(false), _transaction_id(0), _transaction_offsets(0),
+    _num_transaction_records(0), _max_transaction_records(0), _num_views(0)
 {
     for (int i = 0; i < _num_areas; i++) {
         _area_params[i] = { 0 };
@@ -405,12 +420,21 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
 
     hash = calc_crc(initial_crc, strlen(key), key);
 
-    for (ram_table_ind = 0; ram_table_ind < _num_keys; ram_table_ind++) {
+    // The table is sorted by descending hash: look for the first entry not above our hash
+    uint32_t low = 0, high = _num_keys;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ram_table[mid].hash > hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // Several keys may share the same hash
+    for (ram_table_ind = low; ram_table_ind < _num_keys; ram_table_ind++) {
         entry = &ram_table[ram_table_ind];
         offset = entry->bd_offset;
-        if (hash < entry->hash)  {
-            continue;
-        }
         if (hash > entry->hash)  {
             return MBED_ERROR_ITEM_NOT_FOUND;
         }
@@ -472,8 +496,13 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
             }
         }
 
-        // If we have no room for the record, perform garbage collection
+        // If we have no room for the record, complete the garbage collection in progress if any,
+        // or perform a whole one
         uint32_t rec_size = record_size(key, final_data_size);
+        if ((_free_space_offset + rec_size > _size) && _gc_offsets) {
+            bool done;
+            gc_copy(SIZE_MAX, done);
+        }
         if (_free_space_offset + rec_size > _size) {
             ret = garbage_collection();
             if (ret) {
@@ -529,6 +558,12 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
     ih->header.flags = create_flags;
     ih->header.key_size = strlen(key);
     ih->header.reserved = 0;
+    strncpy(ih->key_prefix, key, key_prefix_size);
+    ih->key_prefix[key_prefix_size] = '\0';
+    if (_in_transaction && (ih->bd_base_offset != _master_record_offset)) {
+        ih->header.flags |= transaction_flag;
+        ih->header.reserved = _transaction_id;
+    }
     ih->header.data_size = final_data_size;
     // Calculate CRC on header and key
     ih->header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(ih->header.crc), &ih->header);
@@ -609,8 +644,6 @@ int TDBStore::set_finalize(set_handle_t handle)
 {
     int os_ret, ret = MBED_SUCCESS;
     inc_set_handle_t *ih;
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    ram_table_entry_t *entry;
     bool need_gc = false;
     uint32_t actual_data_size, hash, flags, next_offset;
 
@@ -662,26 +695,12 @@ int TDBStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
-    // Update RAM table
-    if (ih->header.flags & delete_flag) {
-        _num_keys--;
-        if (ih->ram_table_ind < _num_keys) {
-            memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
-                    sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-        }
-        update_all_iterators(false, ih->ram_table_ind);
+    if (ih->header.flags & transaction_flag) {
+        // Applied to the RAM table by the commit
+        add_transaction_record(ih->bd_base_offset);
     } else {
-        if (ih->new_key) {
-            if (ih->ram_table_ind < _num_keys) {
-                memmove(&ram_table[ih->ram_table_ind + 1], &ram_table[ih->ram_table_ind],
-                        sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-            }
-            _num_keys++;
-            update_all_iterators(true, ih->ram_table_ind);
-        }
-        entry = &ram_table[ih->ram_table_ind];
-        entry->hash = ih->hash;
-        entry->bd_offset = ih->bd_base_offset;
+        update_ram_table(ih->ram_table_ind, ih->new_key, ih->header.flags, ih->hash, ih->bd_base_offset,
+                         ih->key_prefix);
     }
 
     _free_space_offset = align_up(ih->bd_curr_offset, _prog_size);
@@ -710,6 +729,82 @@ end:
     return ret;
 }
 
+void TDBStore::update_ram_table(uint32_t ram_table_ind, bool new_key, uint32_t flags, uint32_t hash,
+                                uint32_t bd_offset, const char *key)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    key_prefix_t *key_prefixes = (key_prefix_t *) _key_prefixes;
+    ram_table_entry_t *entry;
+
+    // A garbage collection in progress has to follow: a record already copied to the standby area
+    // is now stale, so the deletion is copied as well, and a modified record is copied again.
+    if (_gc_offsets && (flags & delete_flag) && _gc_offsets[ram_table_ind]) {
+        if (copy_record(_active_area, bd_offset, _gc_to_offset, _gc_to_offset) != MBED_SUCCESS) {
+            gc_abort();
+        }
+    }
+
+    if (flags & delete_flag) {
+        _num_keys--;
+        if (ram_table_ind < _num_keys) {
+            memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
+                    sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            memmove(&key_prefixes[ram_table_ind], &key_prefixes[ram_table_ind + 1],
+                    sizeof(key_prefix_t) * (_num_keys - ram_table_ind));
+            if (_gc_offsets) {
+                memmove(&_gc_offsets[ram_table_ind], &_gc_offsets[ram_table_ind + 1],
+                        sizeof(uint32_t) * (_num_keys - ram_table_ind));
+            }
+        }
+        update_all_iterators(false, ram_table_ind);
+    } else {
+        if (new_key) {
+            if (ram_table_ind < _num_keys) {
+                memmove(&ram_table[ram_table_ind + 1], &ram_table[ram_table_ind],
+                        sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+                memmove(&key_prefixes[ram_table_ind + 1], &key_prefixes[ram_table_ind],
+                        sizeof(key_prefix_t) * (_num_keys - ram_table_ind));
+                if (_gc_offsets) {
+                    memmove(&_gc_offsets[ram_table_ind + 1], &_gc_offsets[ram_table_ind],
+                            sizeof(uint32_t) * (_num_keys - ram_table_ind));
+                }
+            }
+            _num_keys++;
+            update_all_iterators(true, ram_table_ind);
+        }
+        entry = &ram_table[ram_table_ind];
+        entry->hash = hash;
+        entry->bd_offset = bd_offset;
+        set_key_prefix(ram_table_ind, key);
+        if (_gc_offsets) {
+            _gc_offsets[ram_table_ind] = 0;
+        }
+    }
+}
+
+void TDBStore::set_key_prefix(uint32_t ram_table_ind, const char *key)
+{
+    key_prefix_t *key_prefix = &((key_prefix_t *) _key_prefixes)[ram_table_ind];
+
+    key_prefix->len = std::min((uint32_t) strlen(key), key_prefix_size);
+    memcpy(key_prefix->chars, key, key_prefix->len);
+}
+
+void TDBStore::add_transaction_record(uint32_t bd_offset)
+{
+    if (_num_transaction_records >= _max_transaction_records) {
+        size_t new_max = _max_transaction_records + initial_max_keys;
+        uint32_t *new_offsets = new uint32_t[new_max];
+        if (_num_transaction_records) {
+            memcpy(new_offsets, _transaction_offsets, sizeof(uint32_t) * _num_transaction_records);
+        }
+        delete[] _transaction_offsets;
+        _transaction_offsets = new_offsets;
+        _max_transaction_records = new_max;
+    }
+    _transaction_offsets[_num_transaction_records++] = bd_offset;
+}
+
 int TDBStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret;
@@ -770,6 +865,72 @@ end:
     return ret;
 }
 
+int TDBStore::get_view(const char *key, Span<const uint8_t> &view)
+{
+    int ret;
+    record_header_t header;
+    uint32_t bd_offset, hash, ram_table_ind;
+    const uint8_t *mapped;
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto end;
+    }
+
+    // Validates the CRC of the whole record
+    ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
+    if (ret) {
+        goto end;
+    }
+
+    ret = read_area(_active_area, bd_offset, sizeof(header), &header);
+    if (ret) {
+        goto end;
+    }
+
+    // Map the key along the data, so that an empty value is mapped too. Records are synced
+    // to the device once written, so it can be mapped below the buffered block device.
+    mapped = static_cast<const uint8_t *>(_bd->get_mapped_address(
+                                              _area_params[_active_area].address + bd_offset + align_up(sizeof(header), _prog_size),
+                                              header.key_size + header.data_size));
+    if (!mapped) {
+        ret = MBED_ERROR_UNSUPPORTED;
+        goto end;
+    }
+
+    view = Span<const uint8_t>(mapped + header.key_size, header.data_size);
+    _num_views++;
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::release_view(Span<const uint8_t> &view)
+{
+    int ret = MBED_SUCCESS;
+
+    _mutex.lock();
+
+    if (!_num_views) {
+        ret = MBED_ERROR_INVALID_ARGUMENT;
+        goto end;
+    }
+
+    _num_views--;
+    view = Span<const uint8_t>();
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
 int TDBStore::get_info(const char *key, info_t *info)
 {
     int ret;
@@ -800,7 +961,7 @@ int TDBStore::get_info(const char *key, info_t *info)
     }
 
     if (info) {
-        info->flags = flags;
+        info->flags = flags & ~internal_flags;
         info->size = actual_data_size;
     }
 
@@ -809,30 +970,178 @@ end:
     return ret;
 }
 
-int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
+int TDBStore::transaction_begin()
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    // The mutex stays locked until the transaction ends. Id 0 is never used, so that the
+    // records of one transaction can't be taken for the ones of another.
+    _in_transaction = true;
+    _num_transaction_records = 0;
+    if (!++_transaction_id) {
+        _transaction_id++;
+    }
+    return MBED_SUCCESS;
+}
+
+int TDBStore::transaction_commit()
+{
+    int ret = MBED_SUCCESS;
+
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    if (_num_transaction_records) {
+        ret = write_commit_record();
+    }
+
+    // From this point the transaction is committed on storage, whatever happens to the RAM table
+    for (size_t ind = 0; (ret == MBED_SUCCESS) && (ind < _num_transaction_records); ind++) {
+        uint32_t bd_offset = _transaction_offsets[ind];
+        uint32_t actual_data_size, hash, flags, next_offset, dummy, ram_table_ind;
+        bool new_key = false;
+
+        ret = read_record(_active_area, bd_offset, _key_buf, 0, 0, actual_data_size, 0,
+                          true, false, false, true, hash, flags, next_offset);
+        if (ret) {
+            break;
+        }
+
+        ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
+        if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
+            ret = MBED_SUCCESS;
+            if (flags & delete_flag) {
+                continue;
+            }
+            if (_num_keys >= _max_keys) {
+                increment_max_keys();
+            }
+            new_key = true;
+        } else if (ret) {
+            break;
+        }
+
+        update_ram_table(ram_table_ind, new_key, flags, hash, bd_offset, _key_buf);
+    }
+
+    _in_transaction = false;
+    _num_transaction_records = 0;
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::transaction_abort()
+{
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    // The records written so far have no commit record, so they are ignored by init and not
+    // copied by garbage collection
+    _in_transaction = false;
+    _num_transaction_records = 0;
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return MBED_SUCCESS;
+}
+
+int TDBStore::write_commit_record()
+{
+    int ret;
+    uint32_t rec_size = record_size(master_rec_key, 0);
+    uint32_t actual_data_size, hash, flags, next_offset;
+
+    // Same room handling as set_start
+    if ((_free_space_offset + rec_size > _size) && _gc_offsets) {
+        bool done;
+        gc_copy(SIZE_MAX, done);
+    }
+    if (_free_space_offset + rec_size > _size) {
+        ret = garbage_collection();
+        if (ret) {
+            return ret;
+        }
+    }
+    if (_free_space_offset + rec_size > _size) {
+        return MBED_ERROR_MEDIA_FULL;
+    }
+
+    ret = write_internal_record(_active_area, _free_space_offset, delete_flag | transaction_flag,
+                                _transaction_id, 0, 0, next_offset);
+    if (!ret && _buff_bd->sync()) {
+        ret = MBED_ERROR_WRITE_FAILED;
+    }
+    if (!ret) {
+        ret = read_record(_active_area, _free_space_offset, 0, 0, 0, actual_data_size, 0,
+                          false, false, false, false, hash, flags, next_offset);
+    }
+    if (ret) {
+        // Moves the valid records away from the failed write, without the transaction
+        _num_transaction_records = 0;
+        garbage_collection();
+        return ret;
+    }
+
+    _free_space_offset = next_offset;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                                  uint32_t index_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.tdbstore_revision = tdbstore_revision;
-    master_rec.reserved = 0;
+    master_rec.index_offset = index_offset;
     next_offset = _master_record_offset + _master_record_size;
     return set(master_rec_key, &master_rec, sizeof(master_rec), 0);
 }
 
 int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_offset,
-                          uint32_t &to_next_offset)
+                          uint32_t &to_next_offset, bool keep_transaction)
 {
     int ret;
     record_header_t header;
-    uint32_t total_size;
+    uint32_t total_size, crc_size;
+    uint32_t header_offset = to_offset;
     uint16_t chunk_size;
+    bool strip;
 
     ret = read_area(from_area, from_offset, sizeof(header), &header);
     if (ret) {
         return ret;
     }
 
+    // A record of a committed transaction is copied as a plain one, with its CRC recalculated.
+    // The header is then written last, as set_finalize does.
+    strip = (header.flags & transaction_flag) && !keep_transaction;
+    if (strip) {
+        header.flags &= ~transaction_flag;
+        header.reserved = 0;
+        header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    }
+    crc_size = header.key_size + header.data_size;
+
     total_size = align_up(sizeof(record_header_t), _prog_size) +
                  align_up(header.key_size + header.data_size, _prog_size);;
 
@@ -847,9 +1156,11 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
     }
 
     chunk_size = align_up(sizeof(record_header_t), _prog_size);
-    ret = write_area(1 - from_area, to_offset, chunk_size, &header);
-    if (ret) {
-        return ret;
+    if (!strip) {
+        ret = write_area(1 - from_area, to_offset, chunk_size, &header);
+        if (ret) {
+            return ret;
+        }
     }
 
     from_offset += chunk_size;
@@ -863,6 +1174,11 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
             return ret;
         }
 
+        if (strip && crc_size) {
+            header.crc = calc_crc(header.crc, std::min((uint32_t) chunk_size, crc_size), _work_buf);
+            crc_size -= std::min((uint32_t) chunk_size, crc_size);
+        }
+
         ret = write_area(1 - from_area, to_offset, chunk_size, _work_buf);
         if (ret) {
             return ret;
@@ -873,16 +1189,140 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
         total_size -= chunk_size;
     }
 
+    if (strip) {
+        ret = write_area(1 - from_area, header_offset, align_up(sizeof(record_header_t), _prog_size), &header);
+        if (ret) {
+            return ret;
+        }
+    }
+
     to_next_offset = align_up(to_offset, _prog_size);
     return MBED_SUCCESS;
 }
 
-int TDBStore::garbage_collection()
+int TDBStore::write_index_record(uint8_t area, uint32_t offset, uint32_t &next_offset)
 {
+    // Only the master record at the start of the area refers to it
+    return write_internal_record(area, offset, delete_flag, 0, _ram_table,
+                                 sizeof(ram_table_entry_t) * _num_keys, next_offset);
+}
+
+int TDBStore::write_internal_record(uint8_t area, uint32_t offset, uint32_t flags, uint16_t reserved,
+                                    const void *data, uint32_t data_size, uint32_t &next_offset)
+{
+    int ret;
+    record_header_t header;
+
+    ret = check_erase_before_write(area, offset, record_size(master_rec_key, data_size));
+    if (ret) {
+        return ret;
+    }
+
+    // Same key as the master record, so that it can't collide with a user key. The delete
+    // flag makes earlier TDBStore versions ignore it when scanning.
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = flags;
+    header.key_size = strlen(master_rec_key);
+    header.reserved = reserved;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, header.key_size, master_rec_key);
+    if (data_size) {
+        header.crc = calc_crc(header.crc, data_size, data);
+    }
+
+    ret = write_area(area, offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+    offset += align_up(sizeof(header), _prog_size);
+
+    ret = write_area(area, offset, header.key_size, master_rec_key);
+    if (ret) {
+        return ret;
+    }
+    offset += header.key_size;
+
+    if (data_size) {
+        ret = write_area(area, offset, data_size, data);
+        if (ret) {
+            return ret;
+        }
+    }
+
+    next_offset = align_up(offset + data_size, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::load_index_record(uint32_t offset, uint32_t &next_offset)
+{
+    int ret;
+    record_header_t header;
+    uint32_t actual_data_size, hash, flags;
+    uint32_t num_keys;
+
+    ret = read_area(_active_area, offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+
+    if ((header.magic != tdbstore_magic) || !(header.flags & delete_flag) ||
+            (header.key_size != strlen(master_rec_key)) || (header.data_size % sizeof(ram_table_entry_t))) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    num_keys = header.data_size / sizeof(ram_table_entry_t);
+    while (_max_keys < num_keys) {
+        increment_max_keys();
+    }
+
+    // Reads the whole table at once, validating the key and CRC
+    ret = read_record(_active_area, offset, const_cast<char *>(master_rec_key), _ram_table, header.data_size,
+                      actual_data_size, 0, false, true, true, false, hash, flags, next_offset);
+    if (ret) {
+        return (ret == MBED_ERROR_ITEM_NOT_FOUND) ? MBED_ERROR_INVALID_DATA_DETECTED : ret;
+    }
+
+    // The index lists the records written before it
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    uint32_t to_offset, to_next_offset;
+    for (uint32_t ind = 0; ind < num_keys; ind++) {
+        if ((ram_table[ind].bd_offset < _master_record_offset) || (ram_table[ind].bd_offset >= offset) ||
+                (ind && (ram_table[ind].hash > ram_table[ind - 1].hash))) {
+            return MBED_ERROR_INVALID_DATA_DETECTED;
+        }
+    }
+
+    // Keys aren't part of the index, their prefixes are filled by the first iterations
+    memset(_key_prefixes, 0, sizeof(key_prefix_t) * num_keys);
+    _num_keys = num_keys;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::garbage_collection()
+{
     int ret;
-    size_t ind;
+    bool done;
+
+    // Start over, as the records copied so far may have been written by an interrupted set
+    gc_abort();
+    ret = gc_start();
+    if (ret) {
+        return ret;
+    }
+
+    return gc_copy(SIZE_MAX, done);
+}
+
+int TDBStore::gc_start()
+{
+    int ret;
+
+    // The records of the views are in either area, the standby one being erased from here on
+    if (_num_views) {
+        return MBED_ERROR_OPERATION_PROHIBITED;
+    }
 
     // Reset the standby area
     ret = reset_area(1 - _active_area);
@@ -890,24 +1330,99 @@ int TDBStore::garbage_collection()
         return ret;
     }
 
-    to_offset = _master_record_offset + _master_record_size;
+    _gc_offsets = new uint32_t[_max_keys];
+    memset(_gc_offsets, 0, sizeof(uint32_t) * _max_keys);
+    _gc_to_offset = _master_record_offset + _master_record_size;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::gc_copy(size_t max_records, bool &done)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_next_offset;
+    int ret;
+    size_t ind;
+
+    done = false;
+
+    // Go over ram table and copy the entries not copied yet to opposite area
+    for (ind = 0; ind < _num_keys; ind++) {
+        if (_gc_offsets[ind]) {
+            continue;
+        }
+        if (!max_records) {
+            // Flush the records copied by this step, as the next writes may be far away
+            return (_buff_bd->sync() == 0) ? MBED_SUCCESS : MBED_ERROR_WRITE_FAILED;
+        }
+        ret = copy_record(_active_area, ram_table[ind].bd_offset, _gc_to_offset, to_next_offset);
+        if (ret) {
+            gc_abort();
+            return ret;
+        }
+        _gc_offsets[ind] = _gc_to_offset;
+        _gc_to_offset = to_next_offset;
+        max_records--;
+    }
+
+    ret = gc_finish();
+    if (ret) {
+        return ret;
+    }
+    done = true;
+    return MBED_SUCCESS;
+}
 
-    // Initialize in case table is empty
-    to_next_offset = to_offset;
+int TDBStore::gc_finish()
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_offset = _gc_to_offset, to_next_offset = _gc_to_offset;
+    int ret;
+    size_t ind;
 
-    // Go over ram table and copy all entries to opposite area
+    // Update RAM table
     for (ind = 0; ind < _num_keys; ind++) {
-        uint32_t from_offset = ram_table[ind].bd_offset;
-        ret = copy_record(_active_area, from_offset, to_offset, to_next_offset);
+        std::swap(ram_table[ind].bd_offset, _gc_offsets[ind]);
+    }
+
+    // Checkpoint the RAM table, so that init() doesn't have to scan the records copied so far.
+    // Skip it if it would take more than half of the remaining free space, to avoid it
+    // triggering the next garbage collection.
+    uint32_t index_offset = 0;
+    uint32_t index_size = record_size(master_rec_key, sizeof(ram_table_entry_t) * _num_keys);
+    if (_num_keys && (to_offset + 2 * index_size <= _size)) {
+        ret = write_index_record(1 - _active_area, to_offset, to_next_offset);
         if (ret) {
+            for (ind = 0; ind < _num_keys; ind++) {
+                std::swap(ram_table[ind].bd_offset, _gc_offsets[ind]);
+            }
+            gc_abort();
             return ret;
         }
-        // Update RAM table
-        ram_table[ind].bd_offset = to_offset;
+        index_offset = to_offset;
         to_offset = to_next_offset;
     }
 
-    to_offset = to_next_offset;
+    // The records of the transaction in progress follow, so that its commit still applies to them
+    if (_num_transaction_records) {
+        uint32_t *transaction_offsets = new uint32_t[_max_transaction_records];
+        for (ind = 0; ind < _num_transaction_records; ind++) {
+            ret = copy_record(_active_area, _transaction_offsets[ind], to_offset, to_next_offset, true);
+            if (ret) {
+                delete[] transaction_offsets;
+                for (ind = 0; ind < _num_keys; ind++) {
+                    std::swap(ram_table[ind].bd_offset, _gc_offsets[ind]);
+                }
+                gc_abort();
+                return ret;
+            }
+            transaction_offsets[ind] = to_offset;
+            to_offset = to_next_offset;
+        }
+        delete[] _transaction_offsets;
+        _transaction_offsets = transaction_offsets;
+    }
+
+    gc_abort();
     _free_space_offset = to_next_offset;
 
     // Now we can switch to the new active area
@@ -915,7 +1430,7 @@ int TDBStore::garbage_collection()
 
     // Now write master record, with version incremented by 1.
     _active_area_version++;
-    ret = write_master_record(_active_area, _active_area_version, to_offset);
+    ret = write_master_record(_active_area, _active_area_version, to_offset, index_offset);
     if (ret) {
         return ret;
     }
@@ -923,20 +1438,66 @@ int TDBStore::garbage_collection()
     return MBED_SUCCESS;
 }
 
+void TDBStore::gc_abort()
+{
+    delete[] _gc_offsets;
+    _gc_offsets = 0;
+}
 
-int TDBStore::build_ram_table()
+int TDBStore::garbage_collection_step(size_t max_records, bool *done)
 {
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    int ret;
+    bool gc_done;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto end;
+    }
+
+    if (!_gc_offsets) {
+        ret = gc_start();
+        if (ret) {
+            goto end;
+        }
+    }
+
+    ret = gc_copy(max_records, gc_done);
+    if (done) {
+        *done = (ret == MBED_SUCCESS) && gc_done;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+
+int TDBStore::build_ram_table(uint32_t index_offset)
+{
+    ram_table_entry_t *ram_table;
+    key_prefix_t *key_prefixes;
     uint32_t offset, next_offset = 0, dummy;
     int ret = MBED_SUCCESS;
     uint32_t hash;
     uint32_t flags;
     uint32_t actual_data_size;
     uint32_t ram_table_ind;
+    uint32_t commit_offset = 0, end_offset;
 
     _num_keys = 0;
     offset = _master_record_offset;
 
+    // Start from the index checkpoint if there is a valid one, and only scan the records after it.
+    // Otherwise fall back to scanning the whole area.
+    if (index_offset && (load_index_record(index_offset, next_offset) == MBED_SUCCESS)) {
+        offset = next_offset;
+    }
+
+    ram_table = (ram_table_entry_t *) _ram_table;
+    key_prefixes = (key_prefix_t *) _key_prefixes;
+
     while (offset + sizeof(record_header_t) < _free_space_offset) {
         ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
                           true, false, false, true, hash, flags, next_offset);
@@ -945,6 +1506,26 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
+        // Index records are only meaningful when referred to by the master record, commit records
+        // only when following the records of their transaction
+        if ((flags & delete_flag) && !strcmp(_key_buf, master_rec_key)) {
+            offset = next_offset;
+            continue;
+        }
+
+        // Records of a transaction are skipped unless its commit record follows them
+        if ((flags & transaction_flag) && (offset >= commit_offset)) {
+            ret = find_transaction_commit(offset, commit_offset, end_offset);
+            if (ret) {
+                goto end;
+            }
+            if (!commit_offset) {
+                offset = next_offset = end_offset;
+            }
+            // The key buffer was used by the search, read the record again
+            continue;
+        }
+
         ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
 
         if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
@@ -965,15 +1546,20 @@ int TDBStore::build_ram_table()
                 // In order to avoid numerous reallocations of ram table,
                 // Add a chunk of entries now
                 increment_max_keys(reinterpret_cast<void **>(&ram_table));
+                key_prefixes = (key_prefix_t *) _key_prefixes;
             }
             memmove(&ram_table[ram_table_ind + 1], &ram_table[ram_table_ind],
                     sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            memmove(&key_prefixes[ram_table_ind + 1], &key_prefixes[ram_table_ind],
+                    sizeof(key_prefix_t) * (_num_keys - ram_table_ind));
 
             _num_keys++;
         } else if (flags & delete_flag) {
             _num_keys--;
             memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
                     sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            memmove(&key_prefixes[ram_table_ind], &key_prefixes[ram_table_ind + 1],
+                    sizeof(key_prefix_t) * (_num_keys - ram_table_ind));
 
             continue;
         }
@@ -981,6 +1567,7 @@ int TDBStore::build_ram_table()
         // update record parameters
         ram_table[ram_table_ind].hash = hash;
         ram_table[ram_table_ind].bd_offset = save_offset;
+        set_key_prefix(ram_table_ind, _key_buf);
     }
 
 end:
@@ -988,16 +1575,77 @@ end:
     return ret;
 }
 
+int TDBStore::find_transaction_commit(uint32_t offset, uint32_t &commit_offset, uint32_t &end_offset)
+{
+    record_header_t header;
+    uint16_t transaction_id = 0;
+    uint32_t actual_data_size, hash, flags, next_offset;
+    int ret;
+
+    commit_offset = 0;
+    while (offset + sizeof(record_header_t) < _free_space_offset) {
+        ret = read_area(_active_area, offset, sizeof(header), &header);
+        if (ret) {
+            return ret;
+        }
+
+        if ((header.magic != tdbstore_magic) || !(header.flags & transaction_flag) ||
+                (transaction_id && (header.reserved != transaction_id))) {
+            break;
+        }
+        transaction_id = header.reserved;
+
+        ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
+                          true, false, false, false, hash, flags, next_offset);
+        if (ret == MBED_ERROR_READ_FAILED) {
+            return ret;
+        }
+        if (ret) {
+            break;
+        }
+
+        if ((flags & delete_flag) && !strcmp(_key_buf, master_rec_key)) {
+            commit_offset = offset;
+            break;
+        }
+        offset = next_offset;
+    }
+
+    // Scanned in order, so the next transaction gets a different id than the last one
+    if (transaction_id) {
+        _transaction_id = transaction_id;
+    }
+    end_offset = offset;
+    return MBED_SUCCESS;
+}
+
 int TDBStore::increment_max_keys(void **ram_table)
 {
+    // Grow by half of the current size, so that adding keys one by one has an amortized constant cost
+    size_t new_max_keys = _max_keys + std::max(_max_keys / 2, (size_t) 1);
+
     // Reallocate ram table with new size
     ram_table_entry_t *old_ram_table = (ram_table_entry_t *) _ram_table;
-    ram_table_entry_t *new_ram_table = new ram_table_entry_t[_max_keys + 1];
-    memset(new_ram_table, 0, sizeof(ram_table_entry_t) * (_max_keys + 1));
+    ram_table_entry_t *new_ram_table = new ram_table_entry_t[new_max_keys];
+    memset(new_ram_table, 0, sizeof(ram_table_entry_t) * new_max_keys);
 
     // Copy old content to new table
     memcpy(new_ram_table, old_ram_table, sizeof(ram_table_entry_t) * _max_keys);
-    _max_keys++;
+
+    key_prefix_t *new_key_prefixes = new key_prefix_t[new_max_keys];
+    memset(new_key_prefixes, 0, sizeof(key_prefix_t) * new_max_keys);
+    memcpy(new_key_prefixes, _key_prefixes, sizeof(key_prefix_t) * _max_keys);
+    delete[] (key_prefix_t *) _key_prefixes;
+    _key_prefixes = new_key_prefixes;
+
+    if (_gc_offsets) {
+        uint32_t *new_gc_offsets = new uint32_t[new_max_keys];
+        memset(new_gc_offsets, 0, sizeof(uint32_t) * new_max_keys);
+        memcpy(new_gc_offsets, _gc_offsets, sizeof(uint32_t) * _max_keys);
+        delete[] _gc_offsets;
+        _gc_offsets = new_gc_offsets;
+    }
+    _max_keys = new_max_keys;
 
     _ram_table = new_ram_table;
     delete[] old_ram_table;
@@ -1018,6 +1666,7 @@ int TDBStore::init()
     uint32_t actual_data_size;
     int ret = MBED_SUCCESS;
     uint16_t versions[_num_areas];
+    uint32_t index_offsets[_num_areas];
 
     _mutex.lock();
 
@@ -1031,6 +1680,8 @@ int TDBStore::init()
     memset(ram_table, 0, sizeof(ram_table_entry_t) * _max_keys);
     _ram_table = ram_table;
     _num_keys = 0;
+    _key_prefixes = new key_prefix_t[_max_keys];
+    memset(_key_prefixes, 0, sizeof(key_prefix_t) * _max_keys);
 
     _size = (size_t) -1;
 
@@ -1060,6 +1711,7 @@ int TDBStore::init()
     for (uint8_t area = 0; area < _num_areas; area++) {
         area_state[area] = TDBSTORE_AREA_STATE_NONE;
         versions[area] = 0;
+        index_offsets[area] = 0;
 
         _size = std::min(_size, _area_params[area].size);
 
@@ -1079,6 +1731,7 @@ int TDBStore::init()
         }
 
         versions[area] = master_rec.version;
+        index_offsets[area] = master_rec.index_offset;
 
         area_state[area] = TDBSTORE_AREA_STATE_VALID;
 
@@ -1116,7 +1769,8 @@ int TDBStore::init()
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
-    ret = build_ram_table();
+    _transaction_id = 0;
+    ret = build_ram_table(index_offsets[_active_area]);
 
     // build_ram_table() scans all keys, until invalid data found.
     // Therefore INVALID_DATA is not considered error.
@@ -1129,12 +1783,14 @@ end:
     _mutex.unlock();
     return MBED_SUCCESS;
 fail:
-    delete[] ram_table;
+    delete[] (ram_table_entry_t *) _ram_table;
+    delete[] (key_prefix_t *) _key_prefixes;
     delete _buff_bd;
     delete[] _work_buf;
     delete[] _key_buf;
     delete reinterpret_cast<inc_set_handle_t *>(_inc_set_handle);
     _ram_table = nullptr;
+    _key_prefixes = nullptr;
     _buff_bd = nullptr;
     _work_buf = nullptr;
     _key_buf = nullptr;
@@ -1147,11 +1803,25 @@ int TDBStore::deinit()
 {
     _mutex.lock();
     if (_is_initialized) {
+        // A transaction left open is dropped, as on power loss
+        if (_in_transaction) {
+            _in_transaction = false;
+            _mutex.unlock();
+        }
+        delete[] _transaction_offsets;
+        _transaction_offsets = 0;
+        _num_transaction_records = 0;
+        _max_transaction_records = 0;
+
+        gc_abort();
+        _num_views = 0;
         _buff_bd->deinit();
         delete _buff_bd;
 
         ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
         delete[] ram_table;
+        delete[] (key_prefix_t *) _key_prefixes;
+        _key_prefixes = 0;
         delete[] _work_buf;
         delete[] _key_buf;
     }
@@ -1190,6 +1860,14 @@ int TDBStore::reset()
 
     _mutex.lock();
 
+    if (_num_views) {
+        ret = MBED_ERROR_OPERATION_PROHIBITED;
+        goto end;
+    }
+
+    gc_abort();
+    _num_transaction_records = 0;
+
     // Reset both areas
     for (area = 0; area < _num_areas; area++) {
         ret = check_erase_before_write(area, 0, _master_record_offset + _master_record_size + _prog_size, true);
@@ -1203,6 +1881,7 @@ int TDBStore::reset()
     _free_space_offset = _master_record_offset;
     _active_area_version = 1;
     memset(_ram_table, 0, sizeof(ram_table_entry_t) * _max_keys);
+    memset(_key_prefixes, 0, sizeof(key_prefix_t) * _max_keys);
     // Write an initial master record on active area
     ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
 
@@ -1259,9 +1938,11 @@ end:
 int TDBStore::iterator_next(iterator_t it, char *key, size_t key_size)
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    key_prefix_t *key_prefixes = (key_prefix_t *) _key_prefixes;
     key_iterator_handle_t *handle;
     int ret;
     uint32_t actual_data_size, hash, flags, next_offset;
+    uint32_t prefix_len = 0;
 
     if (!_is_initialized) {
         return MBED_ERROR_NOT_READY;
@@ -1272,13 +1953,29 @@ int TDBStore::iterator_next(iterator_t it, char *key, size_t key_size)
     handle = reinterpret_cast<key_iterator_handle_t *>(it);
 
     ret = MBED_ERROR_ITEM_NOT_FOUND;
+    if (handle->prefix) {
+        prefix_len = strlen(handle->prefix);
+    }
 
     while (ret && (handle->ram_table_ind < _num_keys)) {
+        // Skip the keys whose known first characters don't match, without reading their record.
+        // A key shorter than the kept characters is known whole.
+        key_prefix_t *key_prefix = &key_prefixes[handle->ram_table_ind];
+        if (handle->prefix && key_prefix->len &&
+                (((key_prefix->len < key_prefix_size) && (prefix_len > key_prefix->len)) ||
+                 memcmp(key_prefix->chars, handle->prefix, std::min(prefix_len, (uint32_t) key_prefix->len)))) {
+            handle->ram_table_ind++;
+            continue;
+        }
+
         ret = read_record(_active_area, ram_table[handle->ram_table_ind].bd_offset, _key_buf,
                           0, 0, actual_data_size, 0, true, false, false, false, hash, flags, next_offset);
         if (ret) {
             goto end;
         }
+        if (!key_prefix->len) {
+            set_key_prefix(handle->ram_table_ind, _key_buf);
+        }
         if (!handle->prefix || (strstr(_key_buf, handle->prefix) == _key_buf)) {
             if (strlen(_key_buf) >= key_size) {
                 ret = MBED_ERROR_INVALID_SIZE;
@@ -1353,12 +2050,18 @@ int TDBStore::reserved_data_set(const void *reserved_data, size_t reserved_data_
         goto end;
     }
 
+    if (_num_views) {
+        ret = MBED_ERROR_OPERATION_PROHIBITED;
+        goto end;
+    }
+
     trailer.trailer_size = sizeof(trailer);
     trailer.data_size = reserved_data_buf_size;
     trailer.crc = calc_crc(initial_crc, reserved_data_buf_size, reserved_data);
 
     // Erase the header of non-active area, just to make sure that we can write to it
     // In case garbage collection has not yet been run, the area can be un-erased
+    gc_abort();
     ret = reset_area(1 - _active_area);
     if (ret) {
         goto end;
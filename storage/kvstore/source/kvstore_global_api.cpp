@@ -201,3 +201,87 @@ int kv_reset(const char *kvstore_name)
     return ret;
 
 }
+
+int kv_partition_lookup(const char *kvstore_path, kv_partition_t *partition)
+{
+    if (partition == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    kvstore_config_t *kv_config = NULL;
+    ret = kv_map.partition_lookup(kvstore_path, &kv_config);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    *partition = reinterpret_cast<kv_partition_t>(kv_config);
+    return ret;
+}
+
+// The partition handle is its configuration struct, resolved by kv_partition_lookup
+static KVStore *partition_instance(kv_partition_t partition, uint32_t *flags_mask = NULL)
+{
+    if (partition == NULL) {
+        return NULL;
+    }
+
+    kvstore_config_t *kv_config = reinterpret_cast<kvstore_config_t *>(partition);
+    if (flags_mask != NULL) {
+        *flags_mask = kv_config->flags_mask;
+    }
+    return kv_config->kvstore_main_instance;
+}
+
+int kv_set(kv_partition_t partition, const char *key, const void *buffer, size_t size, uint32_t create_flags)
+{
+    uint32_t flags_mask = 0;
+    KVStore *kv_instance = partition_instance(partition, &flags_mask);
+    if (kv_instance == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return kv_instance->set(key, buffer, size, create_flags & flags_mask);
+}
+
+int kv_get(kv_partition_t partition, const char *key, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    KVStore *kv_instance = partition_instance(partition);
+    if (kv_instance == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return kv_instance->get(key, buffer, buffer_size, actual_size);
+}
+
+int kv_get_info(kv_partition_t partition, const char *key, kv_info_t *info)
+{
+    KVStore *kv_instance = partition_instance(partition);
+    if ((kv_instance == NULL) || (info == NULL)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore::info_t inner_info;
+    int ret = kv_instance->get_info(key, &inner_info);
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+    info->flags = inner_info.flags;
+    info->size = inner_info.size;
+    return ret;
+}
+
+int kv_remove(kv_partition_t partition, const char *key)
+{
+    KVStore *kv_instance = partition_instance(partition);
+    if (kv_instance == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return kv_instance->remove(key);
+}
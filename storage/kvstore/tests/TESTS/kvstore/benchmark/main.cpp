@@ -0,0 +1,172 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Latency of the KVStore operations with the number of keys stored.
+ *
+ * Every store, on the default block device, is filled with each number of
+ * keys of KEY_COUNTS, then times the update and the read of random keys and
+ * the iteration over all the keys, and reports them to the benchmark_auto
+ * host test.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "utest/utest_benchmark.h"
+#include "kvstore/TDBStore.h"
+#include "FileSystemStore.h"
+#include "FlashSimBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+#define VALUE_SIZE      16
+#define SET_RUNS        50
+#define GET_RUNS        100
+#define ITERATE_RUNS    5
+
+static const size_t KEY_COUNTS[] = {16, 64, 256};
+
+static KVStore *kvstore;
+static size_t key_count;
+static uint8_t value[VALUE_SIZE];
+static int kv_status;
+
+static void key_name(char *name, size_t index)
+{
+    sprintf(name, "key%04u", (unsigned)index);
+}
+
+static void set_key()
+{
+    char name[10];
+    key_name(name, rand() % key_count);
+    kv_status |= kvstore->set(name, value, VALUE_SIZE, 0);
+}
+
+static void get_key()
+{
+    char name[10];
+    uint8_t buffer[VALUE_SIZE];
+    size_t actual_size;
+    key_name(name, rand() % key_count);
+    kv_status |= kvstore->get(name, buffer, VALUE_SIZE, &actual_size);
+}
+
+static void iterate_keys()
+{
+    KVStore::iterator_t it;
+    char name[KVStore::MAX_KEY_SIZE];
+    size_t found = 0;
+
+    kv_status |= kvstore->iterator_open(&it, "key");
+    while (kvstore->iterator_next(it, name, sizeof(name)) == MBED_SUCCESS) {
+        found++;
+    }
+    kv_status |= kvstore->iterator_close(it);
+    if (found != key_count) {
+        kv_status |= -1;
+    }
+}
+
+static void report(const char *store_name, const char *operation, uint32_t runs, Callback<void()> body)
+{
+    char name[48];
+    snprintf(name, sizeof(name), "%s_%s_%u", store_name, operation, (unsigned)key_count);
+
+    const benchmark_t benchmark = { name, runs, 0, 0 };
+    kv_status = 0;
+    benchmark_result_t result = benchmark_run(benchmark, body);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kv_status);
+    TEST_ASSERT_EQUAL(runs, result.iterations);
+    TEST_ASSERT_TRUE(benchmark_report(benchmark, result));
+}
+
+static void benchmark_kvstore(KVStore *store, const char *store_name)
+{
+    kvstore = store;
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvstore->init());
+    memset(value, 0x55, VALUE_SIZE);
+
+    for (size_t i = 0; i < sizeof(KEY_COUNTS) / sizeof(KEY_COUNTS[0]); i++) {
+        key_count = KEY_COUNTS[i];
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvstore->reset());
+        for (size_t key = 0; key < key_count; key++) {
+            char name[10];
+            key_name(name, key);
+            int err = kvstore->set(name, value, VALUE_SIZE, 0);
+            TEST_SKIP_UNLESS_MESSAGE(err != MBED_ERROR_MEDIA_FULL, "Store too small for the keys");
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        }
+
+        report(store_name, "set", SET_RUNS, set_key);
+        report(store_name, "get", GET_RUNS, get_key);
+        report(store_name, "iterate", ITERATE_RUNS, iterate_keys);
+    }
+
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvstore->reset());
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, kvstore->deinit());
+}
+
+void test_tdbstore()
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "No default block device");
+
+    // TDBStore needs erase to set the erase value
+    if (bd->get_erase_value() == -1) {
+        FlashSimBlockDevice flash_bd(bd);
+        TDBStore store(&flash_bd);
+        benchmark_kvstore(&store, "tdbstore");
+    } else {
+        TDBStore store(bd);
+        benchmark_kvstore(&store, "tdbstore");
+    }
+}
+
+void test_filesystemstore()
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    FileSystem *fs = FileSystem::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL && fs != NULL, "No default filesystem");
+    TEST_ASSERT_EQUAL(0, fs->reformat(bd));
+
+    FileSystemStore store(fs);
+    benchmark_kvstore(&store, "filesystemstore");
+
+    TEST_ASSERT_EQUAL(0, fs->unmount());
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(600, "benchmark_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("TDBStore latency", test_tdbstore),
+    Case("FileSystemStore latency", test_filesystemstore),
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
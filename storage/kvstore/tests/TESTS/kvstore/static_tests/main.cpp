@@ -928,6 +928,66 @@ static void iterator_close_right_after_iterator_open()
     TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
 }
 
+/*----------------partition------------------*/
+
+//partition lookup with the several partition path formats
+static void partition_lookup()
+{
+    TEST_SKIP_UNLESS(!init_res);
+    kv_partition_t partition = NULL, other = NULL;
+    int res = kv_partition_lookup(def_kv, &partition);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_NOT_NULL(partition);
+
+    res = kv_partition_lookup(STR(MBED_CONF_STORAGE_DEFAULT_KV), &other);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL_PTR(partition, other);
+
+    res = kv_partition_lookup("/" STR(MBED_CONF_STORAGE_DEFAULT_KV) "_other/", &other);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, res);
+
+    res = kv_partition_lookup(key, &other);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_ARGUMENT, res);
+
+    res = kv_partition_lookup(def_kv, NULL);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_ARGUMENT, res);
+}
+
+//set, get and remove through a partition handle, visible through the full name
+static void partition_set_get_remove()
+{
+    TEST_SKIP_UNLESS(!init_res);
+    kv_partition_t partition = NULL;
+    int res = kv_partition_lookup(def_kv, &partition);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_set(partition, "key", data, data_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_get(key, buffer, buffer_size, &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL_STRING(data, buffer);
+
+    memset(buffer, 0, buffer_size);
+    res = kv_get(partition, "key", buffer, buffer_size, &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL_STRING(data, buffer);
+    TEST_ASSERT_EQUAL(data_size, actual_size);
+
+    res = kv_get_info(partition, "key", &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+    TEST_ASSERT_EQUAL(data_size, info.size);
+
+    res = kv_remove(partition, "key");
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, res);
+
+    res = kv_get(key, buffer, buffer_size, &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, res);
+
+    res = kv_get(NULL, "key", buffer, buffer_size, &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_ARGUMENT, res);
+}
+
 /*----------------setup------------------*/
 
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
@@ -998,6 +1058,9 @@ Case cases[] = {
     Case("iterator_next_remove_while_iterating", iterator_next_remove_while_iterating, greentea_failure_handler),
 
     Case("iterator_close_right_after_iterator_open", iterator_close_right_after_iterator_open, greentea_failure_handler),
+
+    Case("partition_lookup", partition_lookup, greentea_failure_handler),
+    Case("partition_set_get_remove", partition_set_get_remove, greentea_failure_handler),
 };
 
 
@@ -37,4 +37,7 @@ set(unittest-test-flags
   -DMBED_LFS_PROG_SIZE=64
   -DMBED_LFS_BLOCK_SIZE=512
   -DMBED_LFS_LOOKAHEAD=512
+  -DMBED_LFS_CRC_HARDWARE_THRESHOLD=64
+  -DMBED_LFS_SHARED_FILE_CACHE=false
+  -DMBED_LFS_NAME_CACHE_SIZE=0
 )
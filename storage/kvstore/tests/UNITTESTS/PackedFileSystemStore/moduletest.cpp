@@ -0,0 +1,254 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "kvstore/PackedFileSystemStore.h"
+#include "littlefs/LittleFileSystem.h"
+#include "filesystem/File.h"
+#include "mbed_error.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HEAPBLOCK_SIZE (16384)
+#define COMPACTION_THRESHOLD (512)
+
+using namespace mbed;
+
+class PackedFileSystemStoreModuleTest : public testing::Test {
+protected:
+    HeapBlockDevice heap{HEAPBLOCK_SIZE};
+    LittleFileSystem *fs;
+    PackedFileSystemStore *store;
+
+    virtual void SetUp()
+    {
+        fs = new LittleFileSystem("kvstore", &heap);
+        if (fs->mount(&heap) != MBED_SUCCESS) {
+            EXPECT_EQ(fs->reformat(&heap), MBED_SUCCESS);
+        }
+        store = new PackedFileSystemStore(fs, COMPACTION_THRESHOLD);
+        EXPECT_EQ(store->init(), MBED_SUCCESS);
+        EXPECT_EQ(store->reset(), MBED_SUCCESS);
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+        delete store;
+        EXPECT_EQ(fs->unmount(), MBED_SUCCESS);
+        delete fs;
+    }
+
+    off_t log_size()
+    {
+        File log;
+        EXPECT_EQ(log.open(fs, "kvstore/packed.log", O_RDONLY), 0);
+        off_t size = log.size();
+        log.close();
+        return size;
+    }
+};
+
+TEST_F(PackedFileSystemStoreModuleTest, init)
+{
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, set_get)
+{
+    char buf[100];
+    size_t size;
+    EXPECT_EQ(store->set("key", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_EQ(size, 5);
+    EXPECT_STREQ("data", buf);
+    EXPECT_EQ(store->get("key", buf, 100, &size, 2), MBED_SUCCESS);
+    EXPECT_EQ(size, 3);
+    EXPECT_STREQ("ta", buf);
+    EXPECT_EQ(store->get("key", buf, 100, &size, 6), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(store->get("other", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, set_deinit_init_get)
+{
+    char buf[100];
+    size_t size;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(store->set("key", "data", 5, 0), MBED_SUCCESS);
+        EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+        EXPECT_EQ(store->init(), MBED_SUCCESS);
+        EXPECT_EQ(store->get("key", buf, 100, &size), MBED_SUCCESS);
+        EXPECT_EQ(size, 5);
+        EXPECT_STREQ("data", buf);
+        EXPECT_EQ(store->remove("key"), MBED_SUCCESS);
+    }
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, overwrite_remove)
+{
+    char buf[100];
+    size_t size;
+    KVStore::info_t info;
+    EXPECT_EQ(store->set("key1", "first", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key2", "second", 7, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key1", "third value", 12, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->remove("key2"), MBED_SUCCESS);
+    EXPECT_EQ(store->remove("key2"), MBED_ERROR_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get_info("key1", &info), MBED_SUCCESS);
+    EXPECT_EQ(info.size, 12);
+    EXPECT_EQ(info.flags, 0);
+    EXPECT_EQ(store->get("key1", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("third value", buf);
+    EXPECT_EQ(store->get("key2", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, write_once)
+{
+    KVStore::info_t info;
+    EXPECT_EQ(store->set("key", "data", 5, KVStore::WRITE_ONCE_FLAG), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key", "other", 6, 0), MBED_ERROR_WRITE_PROTECTED);
+    EXPECT_EQ(store->remove("key"), MBED_ERROR_WRITE_PROTECTED);
+    EXPECT_EQ(store->get_info("key", &info), MBED_SUCCESS);
+    EXPECT_EQ(info.flags, KVStore::WRITE_ONCE_FLAG);
+    EXPECT_EQ(store->reset(), MBED_SUCCESS);
+    EXPECT_EQ(store->get_info("key", &info), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, incremental_set)
+{
+    char buf[100];
+    size_t size;
+    KVStore::set_handle_t handle;
+    EXPECT_EQ(store->set_start(&handle, "key", 10, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set_add_data(handle, "01234", 5), MBED_SUCCESS);
+    EXPECT_EQ(store->set_add_data(handle, "567890", 6), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(store->set_add_data(handle, "56789", 5), MBED_SUCCESS);
+    EXPECT_EQ(store->set_finalize(handle), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_EQ(size, 10);
+    EXPECT_EQ(memcmp(buf, "0123456789", 10), 0);
+
+    // An incomplete value is discarded, the previous one stays
+    off_t before = log_size();
+    EXPECT_EQ(store->set_start(&handle, "key", 10, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set_add_data(handle, "abc", 3), MBED_SUCCESS);
+    EXPECT_EQ(store->set_finalize(handle), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(log_size(), before);
+    EXPECT_EQ(store->get("key", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_EQ(memcmp(buf, "0123456789", 10), 0);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, set_multiple_iterate)
+{
+    char buf[100];
+    KVStore::iterator_t iterator;
+    EXPECT_EQ(store->set("primary_key", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("primary_second_key", "value", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("secondary_key", "value", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->iterator_open(&iterator, "primary"), MBED_SUCCESS);
+    EXPECT_EQ(store->iterator_next(iterator, buf, 100), MBED_SUCCESS);
+    EXPECT_EQ(strncmp(buf, "primary", 7), 0);
+    EXPECT_EQ(store->iterator_next(iterator, buf, 100), MBED_SUCCESS);
+    EXPECT_EQ(strncmp(buf, "primary", 7), 0);
+    EXPECT_EQ(store->iterator_next(iterator, buf, 100), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->iterator_close(iterator), MBED_SUCCESS);
+
+    EXPECT_EQ(store->iterator_open(&iterator, NULL), MBED_SUCCESS);
+    EXPECT_EQ(store->iterator_next(iterator, buf, 5), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(store->iterator_close(iterator), MBED_SUCCESS);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, compaction)
+{
+    char key[16];
+    char buf[100];
+    size_t size;
+    for (int i = 0; i < 8; ++i) {
+        sprintf(key, "key%d", i);
+        EXPECT_EQ(store->set(key, "initial", 8, 0), MBED_SUCCESS);
+    }
+    off_t live = log_size();
+
+    // The superseded records don't accumulate
+    for (int i = 0; i < 200; ++i) {
+        sprintf(key, "key%d", i % 8);
+        EXPECT_EQ(store->set(key, "updated", 8, 0), MBED_SUCCESS);
+        EXPECT_LE(log_size(), 2 * live + COMPACTION_THRESHOLD + 64);
+    }
+
+    EXPECT_EQ(store->compact(), MBED_SUCCESS);
+    EXPECT_EQ(log_size(), live);
+
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    for (int i = 0; i < 8; ++i) {
+        sprintf(key, "key%d", i);
+        EXPECT_EQ(store->get(key, buf, 100, &size), MBED_SUCCESS);
+        EXPECT_STREQ("updated", buf);
+    }
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, torn_record)
+{
+    char buf[100];
+    size_t size;
+    EXPECT_EQ(store->set("key", "data", 5, 0), MBED_SUCCESS);
+    off_t valid = log_size();
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+
+    // A record cut by a power loss
+    File log;
+    EXPECT_EQ(log.open(fs, "kvstore/packed.log", O_WRONLY | O_APPEND), 0);
+    EXPECT_EQ(log.write("PFSTtorn", 8), 8);
+    EXPECT_EQ(log.close(), 0);
+
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(log_size(), valid);
+    EXPECT_EQ(store->get("key", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("data", buf);
+    EXPECT_EQ(store->set("key2", "next", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key2", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("next", buf);
+}
+
+TEST_F(PackedFileSystemStoreModuleTest, many_keys)
+{
+    char key[16];
+    char buf[16];
+    size_t size;
+    for (int i = 0; i < 100; ++i) {
+        sprintf(key, "many%d", i);
+        EXPECT_EQ(store->set(key, key, strlen(key) + 1, 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    for (int i = 0; i < 100; ++i) {
+        sprintf(key, "many%d", i);
+        EXPECT_EQ(store->get(key, buf, 16, &size), MBED_SUCCESS);
+        EXPECT_STREQ(key, buf);
+    }
+}
@@ -19,6 +19,8 @@
 #include "blockdevice/FlashSimBlockDevice.h"
 #include "kvstore/TDBStore.h"
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 
 #define BLOCK_SIZE (512)
 #define DEVICE_SIZE (BLOCK_SIZE*200)
@@ -125,6 +127,147 @@ TEST_F(TDBStoreModuleTest, corrupted_set_deinit_init_get)
     delete[] block;
 }
 
+TEST_F(TDBStoreModuleTest, many_keys_gc_deinit_init_get)
+{
+    char key[16];
+    char data[50];
+    char buf[50];
+    size_t size;
+
+    // Rewriting the keys triggers several garbage collections, each writing an index record
+    for (int round = 0; round < 8; ++round) {
+        for (int i = 0; i < 30; ++i) {
+            snprintf(key, sizeof(key), "key%d", i);
+            memset(data, round * 30 + i, sizeof(data));
+            EXPECT_EQ(tdb.set(key, data, sizeof(data), 0), MBED_SUCCESS);
+        }
+    }
+
+    // Records following the last index record
+    EXPECT_EQ(tdb.remove("key7"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("new_key", "data", 5, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    for (int i = 0; i < 30; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i == 7) {
+            EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        memset(data, 7 * 30 + i, sizeof(data));
+        EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+        EXPECT_EQ(size, sizeof(data));
+        EXPECT_EQ(0, memcmp(buf, data, size));
+    }
+    EXPECT_EQ(tdb.get("new_key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("data", buf);
+}
+
+TEST_F(TDBStoreModuleTest, incremental_gc_set_remove_deinit_init_get)
+{
+    char key[16];
+    char data[50];
+    char buf[50];
+    size_t size;
+    bool done = false;
+
+    for (int i = 0; i < 10; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        memset(data, i, sizeof(data));
+        EXPECT_EQ(tdb.set(key, data, sizeof(data), 0), MBED_SUCCESS);
+    }
+
+    // Modify, remove and add keys between the steps, whether already copied or not
+    EXPECT_EQ(tdb.garbage_collection_step(3, &done), MBED_SUCCESS);
+    EXPECT_FALSE(done);
+    for (int i = 0; i < 10; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        memset(data, i, sizeof(data));
+        EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+        EXPECT_EQ(0, memcmp(buf, data, sizeof(data)));
+    }
+    memset(data, 100, sizeof(data));
+    for (int i = 0; i < 10; i += 3) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.set(key, data, sizeof(data), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.remove("key1"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key2"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key8"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.garbage_collection_step(2, &done), MBED_SUCCESS);
+    EXPECT_FALSE(done);
+    EXPECT_EQ(tdb.set("new_key", "data", 5, 0), MBED_SUCCESS);
+    while (!done) {
+        EXPECT_EQ(tdb.garbage_collection_step(1, &done), MBED_SUCCESS);
+    }
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    for (int i = 0; i < 10; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i == 1 || i == 2 || i == 8) {
+            EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        memset(data, (i % 3) ? i : 100, sizeof(data));
+        EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+        EXPECT_EQ(size, sizeof(data));
+        EXPECT_EQ(0, memcmp(buf, data, size));
+    }
+    EXPECT_EQ(tdb.get("new_key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("data", buf);
+}
+
+TEST_F(TDBStoreModuleTest, get_view_release_gc)
+{
+    Span<const uint8_t> view;
+    bool done = false;
+
+    EXPECT_EQ(tdb.release_view(view), MBED_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(tdb.get_view("key", view), MBED_ERROR_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(tdb.set("key", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get_view("key", view), MBED_SUCCESS);
+    EXPECT_EQ(view.size(), 5);
+    EXPECT_EQ(0, memcmp(view.data(), "data", 5));
+
+    // The record viewed stays in place while the key is set again, and no garbage collection starts
+    EXPECT_EQ(tdb.set("key", "other", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(0, memcmp(view.data(), "data", 5));
+    EXPECT_EQ(tdb.garbage_collection_step(1, &done), MBED_ERROR_OPERATION_PROHIBITED);
+    EXPECT_EQ(tdb.reset(), MBED_ERROR_OPERATION_PROHIBITED);
+
+    EXPECT_EQ(tdb.release_view(view), MBED_SUCCESS);
+    EXPECT_EQ(view.size(), 0);
+    while (!done) {
+        EXPECT_EQ(tdb.garbage_collection_step(1, &done), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.get_view("key", view), MBED_SUCCESS);
+    EXPECT_EQ(view.size(), 6);
+    EXPECT_STREQ("other", (const char *) view.data());
+    EXPECT_EQ(tdb.release_view(view), MBED_SUCCESS);
+}
+
+TEST_F(TDBStoreModuleTest, get_view_unmapped)
+{
+    Span<const uint8_t> view;
+    char data[BLOCK_SIZE];
+    char buf[BLOCK_SIZE];
+    size_t size;
+
+    // The heap block device only maps records within an erase unit
+    memset(data, 0x5A, sizeof(data));
+    EXPECT_EQ(tdb.set("key", data, sizeof(data), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get_view("key", view), MBED_ERROR_UNSUPPORTED);
+    EXPECT_EQ(tdb.release_view(view), MBED_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(tdb.get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_EQ(size, sizeof(data));
+    EXPECT_EQ(0, memcmp(buf, data, size));
+}
+
 TEST_F(TDBStoreModuleTest, set_multiple_iterate)
 {
     char buf[100];
@@ -149,3 +292,186 @@ TEST_F(TDBStoreModuleTest, reserved_data_set_get)
     EXPECT_EQ(size, 6);
     EXPECT_EQ(tdb.reserved_data_set(reserved_key, 6), MBED_ERROR_WRITE_FAILED);
 }
+
+TEST_F(TDBStoreModuleTest, transaction_commit_deinit_init_get)
+{
+    char key[16];
+    char buf[16];
+    size_t size;
+
+    EXPECT_EQ(tdb.set("removed", "old", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("key0", "old", 4, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.transaction_begin(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.transaction_begin(), MBED_ERROR_INVALID_OPERATION);
+    for (int i = 0; i < 40; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.set(key, "new", 4, 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.remove("removed"), MBED_SUCCESS);
+
+    // Nothing applied before the commit
+    EXPECT_EQ(tdb.get("key0", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("key1", buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.get("removed", buf, sizeof(buf), &size), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.transaction_commit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.transaction_commit(), MBED_ERROR_INVALID_OPERATION);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < 40; ++i) {
+            snprintf(key, sizeof(key), "key%d", i);
+            EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+            EXPECT_STREQ("new", buf);
+        }
+        EXPECT_EQ(tdb.get("removed", buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+}
+
+TEST_F(TDBStoreModuleTest, transaction_abort_uncommitted_deinit_init_get)
+{
+    char buf[16];
+    size_t size;
+
+    EXPECT_EQ(tdb.set("key", "old", 4, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.transaction_begin(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("key", "aborted", 8, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("other", "aborted", 8, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.transaction_abort(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.transaction_abort(), MBED_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(tdb.get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+
+    // Records written without their commit record, as on power loss
+    EXPECT_EQ(tdb.transaction_begin(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("key", "lost", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("other", buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+
+    // A later transaction isn't mistaken for the lost one
+    EXPECT_EQ(tdb.transaction_begin(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("other", "new", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.transaction_commit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("other", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("new", buf);
+}
+
+TEST_F(TDBStoreModuleTest, transaction_gc_commit_deinit_init_get)
+{
+    char key[16];
+    char data[50];
+    char buf[50];
+    size_t size;
+    bool done = false;
+
+    for (int i = 0; i < 10; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        memset(data, i, sizeof(data));
+        EXPECT_EQ(tdb.set(key, data, sizeof(data), 0), MBED_SUCCESS);
+    }
+
+    memset(data, 9, sizeof(data));
+    for (int i = 0; i < 30; ++i) {
+        EXPECT_EQ(tdb.set("key9", data, sizeof(data), 0), MBED_SUCCESS);
+    }
+
+    // A whole garbage collection, then an incremental one while the transaction is in progress
+    EXPECT_EQ(tdb.transaction_begin(), MBED_SUCCESS);
+    memset(data, 100, sizeof(data));
+    EXPECT_EQ(tdb.set("key0", data, sizeof(data), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key1"), MBED_SUCCESS);
+    for (int i = 0; i < 15; ++i) {
+        EXPECT_EQ(tdb.set("new_key", data, sizeof(data), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.garbage_collection_step(3, &done), MBED_SUCCESS);
+    EXPECT_FALSE(done);
+    EXPECT_EQ(tdb.set("key2", data, sizeof(data), 0), MBED_SUCCESS);
+    while (!done) {
+        EXPECT_EQ(tdb.garbage_collection_step(3, &done), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.transaction_commit(), MBED_SUCCESS);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        EXPECT_EQ(tdb.get("key1", buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+        for (int i = 0; i < 10; ++i) {
+            if (i == 1) {
+                continue;
+            }
+            snprintf(key, sizeof(key), "key%d", i);
+            memset(data, (i == 0 || i == 2) ? 100 : i, sizeof(data));
+            EXPECT_EQ(tdb.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+            EXPECT_EQ(0, memcmp(buf, data, sizeof(data)));
+        }
+        EXPECT_EQ(tdb.get("new_key", buf, sizeof(buf), &size), MBED_SUCCESS);
+
+        // Committed records are copied as plain ones
+        EXPECT_EQ(tdb.garbage_collection_step(SIZE_MAX, &done), MBED_SUCCESS);
+        EXPECT_TRUE(done);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+}
+
+TEST_F(TDBStoreModuleTest, set_many_iterate_prefix_gc_deinit_init)
+{
+    char key[32];
+    char buf[32];
+    KVStore::iterator_t iterator;
+    bool done = false;
+
+    for (int i = 0; i < 30; ++i) {
+        snprintf(key, sizeof(key), "%s%d", (i % 3) ? "config_" : "certificates_", i);
+        EXPECT_EQ(tdb.set(key, "data", 5, 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.set("cert", "data", 5, 0), MBED_SUCCESS);
+
+    // The index record written by the garbage collection doesn't hold the keys
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int iteration = 0; iteration < 2; ++iteration) {
+            int count = 0;
+            EXPECT_EQ(tdb.iterator_open(&iterator, "certificates_"), MBED_SUCCESS);
+            while (tdb.iterator_next(iterator, buf, sizeof(buf)) == MBED_SUCCESS) {
+                EXPECT_EQ(0, strncmp(buf, "certificates_", 13));
+                count++;
+            }
+            EXPECT_EQ(tdb.iterator_close(iterator), MBED_SUCCESS);
+            EXPECT_EQ(count, 10);
+
+            count = 0;
+            EXPECT_EQ(tdb.iterator_open(&iterator, "cert"), MBED_SUCCESS);
+            while (tdb.iterator_next(iterator, buf, sizeof(buf)) == MBED_SUCCESS) {
+                count++;
+            }
+            EXPECT_EQ(tdb.iterator_close(iterator), MBED_SUCCESS);
+            EXPECT_EQ(count, 11);
+
+            count = 0;
+            EXPECT_EQ(tdb.iterator_open(&iterator, "config_1"), MBED_SUCCESS);
+            while (tdb.iterator_next(iterator, buf, sizeof(buf)) == MBED_SUCCESS) {
+                count++;
+            }
+            EXPECT_EQ(tdb.iterator_close(iterator), MBED_SUCCESS);
+            // config_1, config_10, config_11, config_13, config_14, config_16, config_17, config_19
+            EXPECT_EQ(count, 8);
+        }
+
+        EXPECT_EQ(tdb.garbage_collection_step(SIZE_MAX, &done), MBED_SUCCESS);
+        EXPECT_TRUE(done);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "perf_test.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "blockdevice/FlashSimBlockDevice.h"
+#include "kvstore/TDBStore.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BLOCK_SIZE (4096)
+#define DEVICE_SIZE (BLOCK_SIZE*64)
+
+#define FEW_KEYS  32
+#define MANY_KEYS 512
+
+using namespace mbed;
+
+class TDBStorePerfTest : public testing::Test {
+protected:
+    HeapBlockDevice heap{DEVICE_SIZE, 1, 1, BLOCK_SIZE};
+    FlashSimBlockDevice flash{&heap};
+    TDBStore tdb{&flash};
+
+    virtual void SetUp()
+    {
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.reset(), MBED_SUCCESS);
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    }
+
+    static void key_name(char *key, size_t i)
+    {
+        sprintf(key, "key%05zu", i);
+    }
+
+    void fill(size_t keys)
+    {
+        char key[16];
+        EXPECT_EQ(tdb.reset(), MBED_SUCCESS);
+        for (size_t i = 0; i < keys; i++) {
+            key_name(key, i);
+            EXPECT_EQ(tdb.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+        }
+    }
+};
+
+TEST_F(TDBStorePerfTest, set)
+{
+    auto workload = [this](size_t keys) {
+        fill(keys);
+    };
+    EXPECT_TRUE(perf::scales_linearly("set", FEW_KEYS, MANY_KEYS, workload));
+}
+
+TEST_F(TDBStorePerfTest, get)
+{
+    auto workload = [this](size_t keys) {
+        char key[16];
+        for (size_t i = 0; i < keys; i++) {
+            size_t data = 0;
+            size_t size;
+            key_name(key, i);
+            EXPECT_EQ(tdb.get(key, &data, sizeof(data), &size), MBED_SUCCESS);
+            EXPECT_EQ(i, data);
+        }
+    };
+    // Look the keys up among all the keys stored, many or few
+    fill(FEW_KEYS);
+    double few_ns = perf::ns_per_item(FEW_KEYS, workload);
+    fill(MANY_KEYS);
+    double many_ns = perf::ns_per_item(MANY_KEYS, workload);
+    perf::report("get_small", few_ns, FEW_KEYS);
+    perf::report("get_large", many_ns, MANY_KEYS);
+    EXPECT_LT(many_ns, few_ns * perf::default_slack);
+}
+
+TEST_F(TDBStorePerfTest, update)
+{
+    auto workload = [this](size_t keys) {
+        char key[16];
+        for (size_t i = 0; i < keys; i++) {
+            size_t data = i + 1;
+            key_name(key, i);
+            EXPECT_EQ(tdb.set(key, &data, sizeof(data), 0), MBED_SUCCESS);
+        }
+    };
+    // Every run updates all the keys, which is when the garbage collection happens
+    fill(FEW_KEYS);
+    double few_ns = perf::ns_per_item(FEW_KEYS, workload);
+    fill(MANY_KEYS);
+    double many_ns = perf::ns_per_item(MANY_KEYS, workload);
+    perf::report("update_small", few_ns, FEW_KEYS);
+    perf::report("update_large", many_ns, MANY_KEYS);
+    EXPECT_LT(many_ns, few_ns * perf::default_slack);
+}
+
+TEST_F(TDBStorePerfTest, init)
+{
+    // Building the RAM table when mounting reads every record
+    auto workload = [this](size_t keys) {
+        fill(keys);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    };
+    EXPECT_TRUE(perf::scales_linearly("init", FEW_KEYS, MANY_KEYS, workload));
+}
@@ -0,0 +1,29 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  .
+  ..
+  ../platform/mbed-trace/mbed-trace
+)
+
+set(unittest-sources
+  ../storage/blockdevice/source/FlashSimBlockDevice.cpp
+  ../storage/blockdevice/source/HeapBlockDevice.cpp
+  ../storage/blockdevice/source/BufferedBlockDevice.cpp
+  ../storage/kvstore/source/TDBStore.cpp
+  ../platform/mbed-trace/source/mbed_trace.c
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_error.c
+)
+
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/moduletest.cpp
+)
+
+set(unittest-test-labels
+  perf
+)
@@ -0,0 +1,219 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_DELTA_UPDATE_H
+#define MBED_DELTA_UPDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "blockdevice/BlockDevice.h"
+#include "drivers/MbedCRC.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** Streaming differential firmware update
+ *
+ *  Rebuilds a new firmware image from a patch against the image currently
+ *  in flash, and writes it to a candidate block device as the patch is
+ *  received. Only the patch travels over the air, and neither it nor the
+ *  new image has to be held in RAM: the RAM used is a program buffer of
+ *  MBED_CONF_UPDATE_BUFFER_SIZE bytes and, for compressed patches, the LZSS
+ *  window.
+ *
+ *  Patches are created from the old and the new image by
+ *  tools/delta_update.py. A patch is made of:
+ *  - a header with the sizes and CRC-32 of both images, see header_t
+ *  - a body, LZSS compressed in the heatshrink format or not, made of
+ *    bsdiff-like records until the new image is complete:
+ *    - varint diff length, followed by as many bytes added to the bytes of
+ *      the old image
+ *    - varint extra length, followed by as many bytes copied as such
+ *    - zigzag varint adjustment of the position in the old image
+ *
+ *  The old image is read in place, it must be memory mapped, as internal
+ *  flash is. With the FEATURE_BOOTLOADER layout, it is the running
+ *  application and the candidate is the slot the bootloader installs from:
+ *
+ *  @code
+ *  FlashIAPBlockDevice slot(CANDIDATE_ADDRESS, CANDIDATE_SIZE);
+ *  DeltaUpdate update(&slot);      // patches the running application
+ *
+ *  update.begin();
+ *  while ((len = socket.recv(buf, sizeof(buf))) > 0) {
+ *      if (update.write(buf, len) < 0) {
+ *          break;
+ *      }
+ *  }
+ *  if (update.finish() >= 0) {
+ *      // hand over to the bootloader
+ *  }
+ *  @endcode
+ *
+ *  @note Synchronization level: Not thread safe
+ */
+class DeltaUpdate : private NonCopyable<DeltaUpdate> {
+public:
+    /** Patch header, little endian */
+    struct header_t {
+        uint32_t magic;             ///< DELTA_UPDATE_MAGIC
+        uint8_t version;            ///< DELTA_UPDATE_VERSION
+        uint8_t compression;        ///< 0: none, 1: LZSS (heatshrink)
+        uint8_t window_sz2;         ///< LZSS window size, as a power of 2
+        uint8_t lookahead_sz2;      ///< LZSS lookahead size, as a power of 2
+        uint32_t source_size;       ///< Size of the old image
+        uint32_t source_crc;        ///< CRC-32 of the old image
+        uint32_t target_size;       ///< Size of the new image
+        uint32_t target_crc;        ///< CRC-32 of the new image
+    };
+
+    /** Create a delta update
+     *
+     *  @param candidate    Block device the new image is written to, from
+     *                      its start
+     *  @param source       Old image, memory mapped
+     *  @param source_size  Size of the old image area. The patch may use
+     *                      less of it.
+     */
+    DeltaUpdate(BlockDevice *candidate, const void *source, size_t source_size);
+
+#if defined(MBED_APP_START) && defined(MBED_APP_SIZE)
+    /** Create a delta update of the running application
+     *
+     *  @param candidate    Block device the new image is written to
+     */
+    DeltaUpdate(BlockDevice *candidate);
+#endif
+
+    ~DeltaUpdate();
+
+    /** Start an update
+     *
+     *  Initializes the candidate block device. An update in progress is
+     *  abandoned.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int begin();
+
+    /** Apply the next part of the patch
+     *
+     *  @param data     Next bytes of the patch
+     *  @param size     Number of bytes
+     *  @return         0 on success
+     *                  -EINVAL if the patch is corrupt or not for this image
+     *                  -ENOSPC if the new image doesn't fit in the candidate
+     *                  -ENOMEM if the LZSS window can't be allocated
+     *                  other negative error code from the block device
+     *                  After an error, the update must be started again.
+     */
+    int write(const void *data, size_t size);
+
+    /** Complete the update
+     *
+     *  Programs the end of the new image and checks its CRC.
+     *
+     *  @return         Size of the new image on success
+     *                  -EINVAL if the patch is incomplete
+     *                  -EBADMSG if the new image doesn't have the expected CRC
+     *                  other negative error code from the block device
+     */
+    int finish();
+
+    /** Abandon the update and deinitialize the candidate block device
+     */
+    void abort();
+
+    /** Get the size of the new image written so far
+     *
+     *  @param target_size  If not NULL, set to the size of the new image
+     *                      once the header is received, 0 before
+     *  @return             Bytes of the new image produced
+     */
+    size_t get_progress(size_t *target_size = NULL) const;
+
+private:
+    enum state_t {
+        STATE_IDLE,
+        STATE_HEADER,
+        STATE_DIFF_LEN,
+        STATE_DIFF,
+        STATE_EXTRA_LEN,
+        STATE_EXTRA,
+        STATE_ADJUST,
+        STATE_DONE,
+        STATE_ERROR,
+    };
+
+    enum lzss_state_t {
+        LZSS_TAG,
+        LZSS_LITERAL,
+        LZSS_INDEX,
+        LZSS_COUNT,
+    };
+
+    int parse_header();
+    int apply(const uint8_t *data, size_t size);
+    int decompress(const uint8_t *data, size_t size);
+    int get_bits(const uint8_t *&data, const uint8_t *end);
+    void want_bits(lzss_state_t state, uint8_t count);
+    int output(const uint8_t *data, size_t size);
+    int flush_buffer(bool last);
+    int fail(int err);
+
+    BlockDevice *_candidate;
+    const uint8_t *_source;
+    size_t _source_size;
+
+    state_t _state;
+    header_t _header;
+    size_t _header_len;
+    uint32_t _varint;
+    uint8_t _varint_shift;
+    uint32_t _remaining;
+    uint32_t _source_pos;
+
+    uint8_t *_buffer;
+    size_t _buffer_size;
+    size_t _buffer_len;
+    bd_addr_t _program_addr;
+    bd_addr_t _erased_end;
+    size_t _produced;
+    // not the hardware CRC, which would stay locked for the whole update
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICED> _crc;
+    uint32_t _crc_value;
+
+    // LZSS decoder, see decompress()
+    uint8_t *_window;
+    uint16_t _window_head;
+    uint16_t _backref_offset;
+    uint16_t _backref_count;
+    uint16_t _bits;
+    uint8_t _bits_left;
+    uint8_t _in_byte;
+    uint8_t _in_mask;
+    lzss_state_t _lzss_state;
+};
+
+} // namespace mbed
+
+#endif
+
+/** @}*/
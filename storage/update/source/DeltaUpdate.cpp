@@ -0,0 +1,451 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "update/DeltaUpdate.h"
+#include <errno.h>
+#include <string.h>
+#include <new>
+
+#define DELTA_UPDATE_MAGIC      0x5055444D  // "MDUP"
+#define DELTA_UPDATE_VERSION    1
+
+#define COMPRESSION_NONE        0
+#define COMPRESSION_LZSS        1
+
+// Bytes patched or decompressed at a time, on the stack
+#define CHUNK_SIZE              32
+
+namespace mbed {
+
+DeltaUpdate::DeltaUpdate(BlockDevice *candidate, const void *source, size_t source_size)
+    : _candidate(candidate), _source(static_cast<const uint8_t *>(source)), _source_size(source_size),
+      _state(STATE_IDLE), _buffer(NULL), _buffer_size(0), _produced(0), _window(NULL)
+{
+    memset(&_header, 0, sizeof(_header));
+}
+
+#if defined(MBED_APP_START) && defined(MBED_APP_SIZE)
+DeltaUpdate::DeltaUpdate(BlockDevice *candidate)
+    : DeltaUpdate(candidate, reinterpret_cast<const void *>(MBED_APP_START), MBED_APP_SIZE)
+{
+}
+#endif
+
+DeltaUpdate::~DeltaUpdate()
+{
+    abort();
+}
+
+int DeltaUpdate::begin()
+{
+    abort();
+
+    int err = _candidate->init();
+    if (err) {
+        return err;
+    }
+
+    bd_size_t program_size = _candidate->get_program_size();
+    _buffer_size = ((MBED_CONF_UPDATE_BUFFER_SIZE + program_size - 1) / program_size) * program_size;
+    _buffer = new (std::nothrow) uint8_t[_buffer_size];
+    if (!_buffer) {
+        _candidate->deinit();
+        return -ENOMEM;
+    }
+
+    memset(&_header, 0, sizeof(_header));
+    _header_len = 0;
+    _buffer_len = 0;
+    _program_addr = 0;
+    _erased_end = 0;
+    _produced = 0;
+    _source_pos = 0;
+    _crc.compute_partial_start(&_crc_value);
+    _state = STATE_HEADER;
+    return 0;
+}
+
+int DeltaUpdate::write(const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    if (_state == STATE_IDLE || _state == STATE_ERROR) {
+        return -EINVAL;
+    }
+
+    if (_state == STATE_HEADER) {
+        size_t len = sizeof(_header) - _header_len;
+        if (len > size) {
+            len = size;
+        }
+        memcpy(reinterpret_cast<uint8_t *>(&_header) + _header_len, bytes, len);
+        _header_len += len;
+        bytes += len;
+        size -= len;
+        if (_header_len < sizeof(_header)) {
+            return 0;
+        }
+
+        int err = parse_header();
+        if (err) {
+            return fail(err);
+        }
+    }
+
+    if (_header.compression == COMPRESSION_LZSS) {
+        return decompress(bytes, size);
+    }
+    return apply(bytes, size);
+}
+
+int DeltaUpdate::finish()
+{
+    if (_state != STATE_DONE) {
+        return fail(-EINVAL);
+    }
+
+    int err = flush_buffer(true);
+    if (!err) {
+        err = _candidate->sync();
+    }
+    if (err) {
+        return fail(err);
+    }
+
+    _crc.compute_partial_stop(&_crc_value);
+    if (_crc_value != _header.target_crc) {
+        return fail(-EBADMSG);
+    }
+
+    size_t size = _produced;
+    abort();
+    return size;
+}
+
+void DeltaUpdate::abort()
+{
+    if (_state != STATE_IDLE) {
+        _candidate->deinit();
+        _state = STATE_IDLE;
+    }
+    delete[] _buffer;
+    _buffer = NULL;
+    delete[] _window;
+    _window = NULL;
+}
+
+size_t DeltaUpdate::get_progress(size_t *target_size) const
+{
+    if (target_size) {
+        *target_size = _header_len == sizeof(_header) ? _header.target_size : 0;
+    }
+    return _produced;
+}
+
+int DeltaUpdate::fail(int err)
+{
+    if (_state != STATE_IDLE) {
+        _state = STATE_ERROR;
+    }
+    return err;
+}
+
+int DeltaUpdate::parse_header()
+{
+    if (_header.magic != DELTA_UPDATE_MAGIC || _header.version != DELTA_UPDATE_VERSION) {
+        return -EINVAL;
+    }
+
+    // the patch must have been made against this very image
+    if (_header.source_size > _source_size) {
+        return -EINVAL;
+    }
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::SLICED> source_crc;
+    source_crc.compute(_source, _header.source_size, &crc);
+    if (crc != _header.source_crc) {
+        return -EINVAL;
+    }
+
+    if (_header.target_size > _candidate->size()) {
+        return -ENOSPC;
+    }
+
+    if (_header.compression == COMPRESSION_LZSS) {
+        if (_header.window_sz2 < 4 || _header.window_sz2 > MBED_CONF_UPDATE_WINDOW_SIZE_MAX ||
+                _header.lookahead_sz2 < 3 || _header.lookahead_sz2 >= _header.window_sz2) {
+            return -EINVAL;
+        }
+        _window = new (std::nothrow) uint8_t[1 << _header.window_sz2];
+        if (!_window) {
+            return -ENOMEM;
+        }
+        memset(_window, 0, 1 << _header.window_sz2);
+        _window_head = 0;
+        _backref_count = 0;
+        _in_mask = 0;
+        want_bits(LZSS_TAG, 1);
+    } else if (_header.compression != COMPRESSION_NONE) {
+        return -EINVAL;
+    }
+
+    _varint = 0;
+    _varint_shift = 0;
+    _state = _header.target_size ? STATE_DIFF_LEN : STATE_DONE;
+    return 0;
+}
+
+void DeltaUpdate::want_bits(lzss_state_t state, uint8_t count)
+{
+    _lzss_state = state;
+    _bits = 0;
+    _bits_left = count;
+}
+
+// Read the bits wanted by the current LZSS state, MSB first. Returns -1 if
+// the input runs out first, reading continues with the next input.
+int DeltaUpdate::get_bits(const uint8_t *&data, const uint8_t *end)
+{
+    while (_bits_left) {
+        if (!_in_mask) {
+            if (data == end) {
+                return -1;
+            }
+            _in_byte = *data++;
+            _in_mask = 0x80;
+        }
+        _bits = (_bits << 1) | ((_in_byte & _in_mask) ? 1 : 0);
+        _in_mask >>= 1;
+        _bits_left--;
+    }
+    return _bits;
+}
+
+// LZSS decoder for the heatshrink format: a 1 bit is followed by a literal
+// byte, a 0 bit by a back-reference of window_sz2 bits of offset - 1 and
+// lookahead_sz2 bits of count - 1
+int DeltaUpdate::decompress(const uint8_t *data, size_t size)
+{
+    const uint8_t *end = data + size;
+    const uint16_t mask = (1 << _header.window_sz2) - 1;
+    uint8_t out[CHUNK_SIZE];
+    size_t out_len = 0;
+    int err = 0;
+
+    while (true) {
+        if (_backref_count) {
+            while (_backref_count && out_len < sizeof(out)) {
+                uint8_t c = _window[(uint16_t)(_window_head - _backref_offset) & mask];
+                _window[_window_head++ & mask] = c;
+                out[out_len++] = c;
+                _backref_count--;
+            }
+        } else {
+            int bits = get_bits(data, end);
+            if (bits < 0) {
+                break;
+            }
+
+            switch (_lzss_state) {
+                case LZSS_TAG:
+                    if (bits) {
+                        want_bits(LZSS_LITERAL, 8);
+                    } else {
+                        want_bits(LZSS_INDEX, _header.window_sz2);
+                    }
+                    break;
+                case LZSS_LITERAL:
+                    _window[_window_head++ & mask] = bits;
+                    out[out_len++] = bits;
+                    want_bits(LZSS_TAG, 1);
+                    break;
+                case LZSS_INDEX:
+                    _backref_offset = bits + 1;
+                    want_bits(LZSS_COUNT, _header.lookahead_sz2);
+                    break;
+                case LZSS_COUNT:
+                    _backref_count = bits + 1;
+                    want_bits(LZSS_TAG, 1);
+                    break;
+            }
+        }
+
+        if (out_len == sizeof(out)) {
+            err = apply(out, out_len);
+            if (err) {
+                return err;
+            }
+            out_len = 0;
+        }
+    }
+
+    if (out_len) {
+        err = apply(out, out_len);
+    }
+    return err;
+}
+
+// Run the patch records over the (decompressed) body
+int DeltaUpdate::apply(const uint8_t *data, size_t size)
+{
+    while (size) {
+        switch (_state) {
+            case STATE_DIFF_LEN:
+            case STATE_EXTRA_LEN:
+            case STATE_ADJUST: {
+                uint8_t b = *data++;
+                size--;
+                if (_varint_shift > 28) {
+                    return fail(-EINVAL);
+                }
+                _varint |= (uint32_t)(b & 0x7F) << _varint_shift;
+                if (b & 0x80) {
+                    _varint_shift += 7;
+                    break;
+                }
+
+                uint32_t value = _varint;
+                _varint = 0;
+                _varint_shift = 0;
+                if (_state == STATE_ADJUST) {
+                    // zigzag encoded
+                    _source_pos += (value >> 1) ^ (0 - (value & 1));
+                    _state = _produced == _header.target_size ? STATE_DONE : STATE_DIFF_LEN;
+                } else {
+                    if (value > _header.target_size - _produced) {
+                        return fail(-EINVAL);
+                    }
+                    _remaining = value;
+                    if (_state == STATE_DIFF_LEN) {
+                        _state = value ? STATE_DIFF : STATE_EXTRA_LEN;
+                    } else {
+                        _state = value ? STATE_EXTRA : STATE_ADJUST;
+                    }
+                }
+                break;
+            }
+
+            case STATE_DIFF: {
+                size_t len = size < _remaining ? size : _remaining;
+                if (len > CHUNK_SIZE) {
+                    len = CHUNK_SIZE;
+                }
+                if (_source_pos > _header.source_size || len > _header.source_size - _source_pos) {
+                    return fail(-EINVAL);
+                }
+                uint8_t out[CHUNK_SIZE];
+                for (size_t i = 0; i < len; i++) {
+                    out[i] = data[i] + _source[_source_pos + i];
+                }
+                int err = output(out, len);
+                if (err) {
+                    return fail(err);
+                }
+                _source_pos += len;
+                data += len;
+                size -= len;
+                _remaining -= len;
+                if (!_remaining) {
+                    _state = STATE_EXTRA_LEN;
+                }
+                break;
+            }
+
+            case STATE_EXTRA: {
+                size_t len = size < _remaining ? size : _remaining;
+                int err = output(data, len);
+                if (err) {
+                    return fail(err);
+                }
+                data += len;
+                size -= len;
+                _remaining -= len;
+                if (!_remaining) {
+                    _state = STATE_ADJUST;
+                }
+                break;
+            }
+
+            default:
+                // data past the end of the new image
+                return fail(-EINVAL);
+        }
+    }
+
+    return 0;
+}
+
+int DeltaUpdate::output(const uint8_t *data, size_t size)
+{
+    _crc.compute_partial(data, size, &_crc_value);
+    _produced += size;
+
+    while (size) {
+        size_t len = _buffer_size - _buffer_len;
+        if (len > size) {
+            len = size;
+        }
+        memcpy(_buffer + _buffer_len, data, len);
+        _buffer_len += len;
+        data += len;
+        size -= len;
+
+        if (_buffer_len == _buffer_size) {
+            int err = flush_buffer(false);
+            if (err) {
+                return err;
+            }
+        }
+    }
+    return 0;
+}
+
+// Program the buffer, erasing the candidate just ahead of it
+int DeltaUpdate::flush_buffer(bool last)
+{
+    size_t len = _buffer_len;
+    if (!len) {
+        return 0;
+    }
+
+    if (last) {
+        bd_size_t program_size = _candidate->get_program_size();
+        size_t padded = ((len + program_size - 1) / program_size) * program_size;
+        int erase_value = _candidate->get_erase_value();
+        memset(_buffer + len, erase_value < 0 ? 0xFF : erase_value, padded - len);
+        len = padded;
+    }
+
+    while (_program_addr + len > _erased_end) {
+        bd_size_t erase_size = _candidate->get_erase_size(_erased_end);
+        int err = _candidate->erase(_erased_end, erase_size);
+        if (err) {
+            return err;
+        }
+        _erased_end += erase_size;
+    }
+
+    int err = _candidate->program(_buffer, _program_addr, len);
+    if (err) {
+        return err;
+    }
+    _program_addr += len;
+    _buffer_len = 0;
+    return 0;
+}
+
+} // namespace mbed
@@ -0,0 +1,233 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "update/DeltaUpdate.h"
+#include <errno.h>
+#include <string.h>
+#include <vector>
+
+#define PROGRAM_SIZE 16
+#define ERASE_SIZE 256
+#define DEVICE_SIZE (ERASE_SIZE * 8)
+
+using namespace mbed;
+
+static uint32_t crc32(const std::vector<uint8_t> &data)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t byte : data) {
+        crc ^= byte;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+class PatchWriter {
+public:
+    std::vector<uint8_t> body;
+
+    void varint(uint32_t value)
+    {
+        do {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            body.push_back(byte | (value ? 0x80 : 0));
+        } while (value);
+    }
+
+    void record(const std::vector<uint8_t> &diff, const std::vector<uint8_t> &extra, int32_t adjust)
+    {
+        varint(diff.size());
+        body.insert(body.end(), diff.begin(), diff.end());
+        varint(extra.size());
+        body.insert(body.end(), extra.begin(), extra.end());
+        varint(adjust >= 0 ? adjust << 1 : ((-adjust) << 1) - 1);
+    }
+
+    std::vector<uint8_t> patch(const std::vector<uint8_t> &source, const std::vector<uint8_t> &target,
+                               uint8_t compression = 0, uint8_t window_sz2 = 0, uint8_t lookahead_sz2 = 0)
+    {
+        DeltaUpdate::header_t header = {
+            0x5055444D, 1, compression, window_sz2, lookahead_sz2,
+            (uint32_t)source.size(), crc32(source), (uint32_t)target.size(), crc32(target)
+        };
+        std::vector<uint8_t> out((uint8_t *)&header, (uint8_t *)&header + sizeof(header));
+        out.insert(out.end(), body.begin(), body.end());
+        return out;
+    }
+};
+
+class DeltaUpdateTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        for (int i = 0; i < 1000; i++) {
+            source.push_back(i * 7 + (i >> 3));
+        }
+    }
+
+    std::vector<uint8_t> read_candidate(size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        bd.init();
+        bd.read(data.data(), 0, size);
+        bd.deinit();
+        return data;
+    }
+
+    HeapBlockDevice bd{DEVICE_SIZE, 1, PROGRAM_SIZE, ERASE_SIZE};
+    std::vector<uint8_t> source;
+};
+
+TEST_F(DeltaUpdateTest, copy_modify_insert)
+{
+    // target: source[0:300] with +1 on every byte, "hello", source[500:1000]
+    std::vector<uint8_t> target;
+    PatchWriter w;
+    std::vector<uint8_t> diff(300, 1);
+    std::vector<uint8_t> extra = {'h', 'e', 'l', 'l', 'o'};
+    for (int i = 0; i < 300; i++) {
+        target.push_back(source[i] + 1);
+    }
+    target.insert(target.end(), extra.begin(), extra.end());
+    target.insert(target.end(), source.begin() + 500, source.end());
+    w.record(diff, extra, 200);
+    w.record(std::vector<uint8_t>(500, 0), {}, 0);
+    std::vector<uint8_t> patch = w.patch(source, target);
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    // fed in odd sizes, including a split header
+    for (size_t pos = 0; pos < patch.size(); pos += 7) {
+        EXPECT_EQ(update.write(patch.data() + pos, std::min<size_t>(7, patch.size() - pos)), 0);
+    }
+    size_t target_size;
+    EXPECT_EQ(update.get_progress(&target_size), target.size());
+    EXPECT_EQ(target_size, target.size());
+    EXPECT_EQ(update.finish(), (int)target.size());
+    EXPECT_EQ(read_candidate(target.size()), target);
+}
+
+TEST_F(DeltaUpdateTest, compressed)
+{
+    // body: diff 0 bytes, extra 4 bytes "abab", adjust 0, as LZSS literals
+    // and a back-reference
+    std::vector<uint8_t> target = {'a', 'b', 'a', 'b'};
+    uint64_t bits = 0;
+    int nbits = 0;
+    auto push = [&](uint32_t value, int count) {
+        bits = (bits << count) | value;
+        nbits += count;
+    };
+    std::vector<uint8_t> stream;
+    const uint8_t literals[] = {0x00, 0x04, 'a', 'b'};
+    for (uint8_t literal : literals) {
+        push(1, 1);
+        push(literal, 8);
+    }
+    push(0, 1);
+    push(2 - 1, 8);         // offset 2, window_sz2 8
+    push(2 - 1, 4);         // count 2, lookahead_sz2 4
+    push(1, 1);
+    push(0x00, 8);          // adjust 0
+    while (nbits % 8) {
+        push(0, 1);
+    }
+    for (int i = nbits - 8; i >= 0; i -= 8) {
+        stream.push_back(bits >> i);
+    }
+
+    PatchWriter w;
+    w.body = stream;
+    std::vector<uint8_t> patch = w.patch(source, target, 1, 8, 4);
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    for (uint8_t byte : patch) {
+        EXPECT_EQ(update.write(&byte, 1), 0);
+    }
+    EXPECT_EQ(update.finish(), (int)target.size());
+    EXPECT_EQ(read_candidate(target.size()), target);
+}
+
+TEST_F(DeltaUpdateTest, wrong_source)
+{
+    PatchWriter w;
+    w.record({}, {1}, 0);
+    std::vector<uint8_t> patch = w.patch(source, {1});
+
+    source[10]++;
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    EXPECT_EQ(update.write(patch.data(), patch.size()), -EINVAL);
+    // further data is refused until the update is started again
+    EXPECT_EQ(update.write(patch.data(), patch.size()), -EINVAL);
+    EXPECT_EQ(update.finish(), -EINVAL);
+}
+
+TEST_F(DeltaUpdateTest, out_of_bounds)
+{
+    // 10 bytes patched from position 995 of the 1000 bytes of source
+    PatchWriter w;
+    w.record({}, {}, 995);
+    w.record(std::vector<uint8_t>(10, 0), {}, 0);
+    std::vector<uint8_t> patch = w.patch(source, std::vector<uint8_t>(10, 0));
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    EXPECT_EQ(update.write(patch.data(), patch.size()), -EINVAL);
+}
+
+TEST_F(DeltaUpdateTest, too_large)
+{
+    std::vector<uint8_t> target(DEVICE_SIZE + 1, 0);
+    PatchWriter w;
+    std::vector<uint8_t> patch = w.patch(source, target);
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    EXPECT_EQ(update.write(patch.data(), patch.size()), -ENOSPC);
+}
+
+TEST_F(DeltaUpdateTest, bad_crc)
+{
+    std::vector<uint8_t> target = {1, 2, 3};
+    PatchWriter w;
+    w.record({}, {1, 2, 4}, 0);
+    std::vector<uint8_t> patch = w.patch(source, target);
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    EXPECT_EQ(update.write(patch.data(), patch.size()), 0);
+    EXPECT_EQ(update.finish(), -EBADMSG);
+}
+
+TEST_F(DeltaUpdateTest, incomplete)
+{
+    std::vector<uint8_t> target = {1, 2, 3};
+    PatchWriter w;
+    w.record({}, {1, 2, 3}, 0);
+    std::vector<uint8_t> patch = w.patch(source, target);
+
+    DeltaUpdate update(&bd, source.data(), source.size());
+    EXPECT_EQ(update.begin(), 0);
+    EXPECT_EQ(update.write(patch.data(), patch.size() - 2), 0);
+    EXPECT_EQ(update.finish(), -EINVAL);
+}
@@ -0,0 +1,31 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-includes ${unittest-includes}
+  .
+  ..
+  ../storage/blockdevice/include
+  ../storage/update/include
+)
+
+set(unittest-sources
+  ../storage/blockdevice/source/HeapBlockDevice.cpp
+  ../storage/update/source/DeltaUpdate.cpp
+  ../drivers/source/MbedCRC.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-sources
+  ${CMAKE_CURRENT_LIST_DIR}/test.cpp
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_UPDATE_BUFFER_SIZE=64
+  -DMBED_CONF_UPDATE_WINDOW_SIZE_MAX=10
+  -DMBED_CRC_TABLE_SIZE=16
+  -DMBED_CRC_SLICES=8
+)
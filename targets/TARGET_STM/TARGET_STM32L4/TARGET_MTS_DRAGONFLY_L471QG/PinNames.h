@@ -37,6 +37,9 @@
 extern "C" {
 #endif
 
+/* If this macro is defined, then constexpr utility functions for pin-map seach can be used. */
+#define STATIC_PINMAP_READY 1
+
 typedef enum {
 
     PA_0 = 0x00,
@@ -37,6 +37,9 @@
 extern "C" {
 #endif
 
+/* If this macro is defined, then constexpr utility functions for pin-map seach can be used. */
+#define STATIC_PINMAP_READY 1
+
 typedef enum {
     ALT0 = 0x100,
     ALT1 = 0x200,
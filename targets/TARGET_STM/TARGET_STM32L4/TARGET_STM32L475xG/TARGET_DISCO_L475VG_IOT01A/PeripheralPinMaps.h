@@ -415,6 +415,6 @@ MSTD_CONSTEXPR_OBJ_11 const PinMap PinMap_USB_FS[] = {
 #define PINMAP_QSPI_SCLK PinMap_QSPI_SCLK
 #define PINMAP_QSPI_SSEL PinMap_QSPI_SSEL
 #define PINMAP_CAN_RD PinMap_CAN_RD
-#define PINMAP_CAN_TD PinMap_CAN_RD
+#define PINMAP_CAN_TD PinMap_CAN_TD
 
 #endif
\ No newline at end of file
@@ -133,80 +133,90 @@ void analogin_init(analogin_t *obj, PinName pin)
 }
 
 
-uint16_t adc_read(analogin_t *obj)
+// Select the ADC channel and its sampling time, returns false for an unknown channel
+static bool adc_channel_config(uint8_t channel, ADC_ChannelConfTypeDef *sConfig)
 {
-    ADC_ChannelConfTypeDef sConfig = {0};
-
-    // Configure ADC channel
-    sConfig.Rank         = ADC_REGULAR_RANK_1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_47CYCLES_5; //  default value (1.5 us for 80MHz clock)
-    sConfig.SingleDiff   = ADC_SINGLE_ENDED;
-    sConfig.OffsetNumber = ADC_OFFSET_NONE;
-    sConfig.Offset       = 0;
+    sConfig->SamplingTime = ADC_SAMPLETIME_47CYCLES_5; //  default value (1.5 us for 80MHz clock)
+    sConfig->SingleDiff   = ADC_SINGLE_ENDED;
+    sConfig->OffsetNumber = ADC_OFFSET_NONE;
+    sConfig->Offset       = 0;
 
-    switch (obj->channel) {
+    switch (channel) {
         case 0:
-            sConfig.Channel = ADC_CHANNEL_VREFINT;
-            sConfig.SamplingTime = ADC_SAMPLETIME_247CYCLES_5; // Minimum ADC sampling time when reading the internal reference voltage is 4us
+            sConfig->Channel = ADC_CHANNEL_VREFINT;
+            sConfig->SamplingTime = ADC_SAMPLETIME_247CYCLES_5; // Minimum ADC sampling time when reading the internal reference voltage is 4us
             break;
         case 1:
-            sConfig.Channel = ADC_CHANNEL_1;
+            sConfig->Channel = ADC_CHANNEL_1;
             break;
         case 2:
-            sConfig.Channel = ADC_CHANNEL_2;
+            sConfig->Channel = ADC_CHANNEL_2;
             break;
         case 3:
-            sConfig.Channel = ADC_CHANNEL_3;
+            sConfig->Channel = ADC_CHANNEL_3;
             break;
         case 4:
-            sConfig.Channel = ADC_CHANNEL_4;
+            sConfig->Channel = ADC_CHANNEL_4;
             break;
         case 5:
-            sConfig.Channel = ADC_CHANNEL_5;
+            sConfig->Channel = ADC_CHANNEL_5;
             break;
         case 6:
-            sConfig.Channel = ADC_CHANNEL_6;
+            sConfig->Channel = ADC_CHANNEL_6;
             break;
         case 7:
-            sConfig.Channel = ADC_CHANNEL_7;
+            sConfig->Channel = ADC_CHANNEL_7;
             break;
         case 8:
-            sConfig.Channel = ADC_CHANNEL_8;
+            sConfig->Channel = ADC_CHANNEL_8;
             break;
         case 9:
-            sConfig.Channel = ADC_CHANNEL_9;
+            sConfig->Channel = ADC_CHANNEL_9;
             break;
         case 10:
-            sConfig.Channel = ADC_CHANNEL_10;
+            sConfig->Channel = ADC_CHANNEL_10;
             break;
         case 11:
-            sConfig.Channel = ADC_CHANNEL_11;
+            sConfig->Channel = ADC_CHANNEL_11;
             break;
         case 12:
-            sConfig.Channel = ADC_CHANNEL_12;
+            sConfig->Channel = ADC_CHANNEL_12;
             break;
         case 13:
-            sConfig.Channel = ADC_CHANNEL_13;
+            sConfig->Channel = ADC_CHANNEL_13;
             break;
         case 14:
-            sConfig.Channel = ADC_CHANNEL_14;
+            sConfig->Channel = ADC_CHANNEL_14;
             break;
         case 15:
-            sConfig.Channel = ADC_CHANNEL_15;
+            sConfig->Channel = ADC_CHANNEL_15;
             break;
         case 16:
-            sConfig.Channel = ADC_CHANNEL_16;
+            sConfig->Channel = ADC_CHANNEL_16;
             break;
         case 17:
-            sConfig.Channel = ADC_CHANNEL_TEMPSENSOR;
-            sConfig.SamplingTime = ADC_SAMPLETIME_247CYCLES_5; // Minimum ADC sampling time when reading the temperature is 5us
+            sConfig->Channel = ADC_CHANNEL_TEMPSENSOR;
+            sConfig->SamplingTime = ADC_SAMPLETIME_247CYCLES_5; // Minimum ADC sampling time when reading the temperature is 5us
             break;
         case 18:
-            sConfig.Channel = ADC_CHANNEL_VBAT;
-            sConfig.SamplingTime = ADC_SAMPLETIME_640CYCLES_5; // Minimum ADC sampling time when reading the VBAT is 12us
+            sConfig->Channel = ADC_CHANNEL_VBAT;
+            sConfig->SamplingTime = ADC_SAMPLETIME_640CYCLES_5; // Minimum ADC sampling time when reading the VBAT is 12us
             break;
         default:
-            return 0;
+            return false;
+    }
+
+    return true;
+}
+
+uint16_t adc_read(analogin_t *obj)
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+
+    // Configure ADC channel
+    sConfig.Rank         = ADC_REGULAR_RANK_1;
+    if (!adc_channel_config(obj->channel, &sConfig)) {
+        return 0;
     }
 
     HAL_ADC_ConfigChannel(&obj->handle, &sConfig);
@@ -227,4 +237,293 @@ const PinMap *analogin_pinmap()
     return PinMap_ADC;
 }
 
+
+#if DEVICE_ANALOGIN_STREAM
+
+#include <string.h>
+#include "stm_dma_utils.h"
+
+#if defined(ADC3)
+#define ADC_NUM 3
+#elif defined(ADC2)
+#define ADC_NUM 2
+#else
+#define ADC_NUM 1
+#endif
+
+static const uint32_t adc_regular_ranks[ANALOGIN_STREAM_MAX_CHANNELS] = {
+    ADC_REGULAR_RANK_1, ADC_REGULAR_RANK_2, ADC_REGULAR_RANK_3, ADC_REGULAR_RANK_4,
+    ADC_REGULAR_RANK_5, ADC_REGULAR_RANK_6, ADC_REGULAR_RANK_7, ADC_REGULAR_RANK_8,
+    ADC_REGULAR_RANK_9, ADC_REGULAR_RANK_10, ADC_REGULAR_RANK_11, ADC_REGULAR_RANK_12,
+    ADC_REGULAR_RANK_13, ADC_REGULAR_RANK_14, ADC_REGULAR_RANK_15, ADC_REGULAR_RANK_16
+};
+
+// Streams owning each ADC
+static analogin_stream_t *adc_streams[ADC_NUM];
+// All streams are triggered by TIM6, only one of them can run at a time
+static analogin_stream_t *adc_running_stream;
+
+static int adc_get_index(ADC_TypeDef *adc)
+{
+    if (adc == ADC1) {
+        return 0;
+    }
+#if defined(ADC2)
+    if (adc == ADC2) {
+        return 1;
+    }
+#endif
+#if defined(ADC3)
+    if (adc == ADC3) {
+        return 2;
+    }
+#endif
+    return -1;
+}
+
+static void adc_stream_notify(ADC_HandleTypeDef *hadc, size_t offset)
+{
+    analogin_stream_t *obj = adc_running_stream;
+
+    if (obj != NULL && hadc == &obj->handle) {
+        ((analogin_stream_handler)obj->handler)(obj->id, obj->buffer + offset, obj->length / 2);
+    }
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    adc_stream_notify(hadc, 0);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    analogin_stream_t *obj = adc_running_stream;
+    adc_stream_notify(hadc, obj ? obj->length / 2 : 0);
+}
+
+int analogin_stream_init(analogin_stream_t *obj, const PinName *pins, size_t count)
+{
+    ADC_TypeDef *adc = NULL;
+    uint32_t functions[ANALOGIN_STREAM_MAX_CHANNELS];
+
+    if (count == 0 || count > ANALOGIN_STREAM_MAX_CHANNELS) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const PinMap *map = ((pins[i] < 0xF0) || (pins[i] >= 0x100)) ? PinMap_ADC : PinMap_ADC_Internal;
+        ADC_TypeDef *pin_adc = (ADC_TypeDef *)pinmap_find_peripheral(pins[i], map);
+        if (pin_adc == (ADC_TypeDef *)NC || (adc != NULL && pin_adc != adc)) {
+            return -1;
+        }
+        adc = pin_adc;
+        functions[i] = pinmap_find_function(pins[i], map);
+    }
+
+    int index = adc_get_index(adc);
+    if (index < 0 || adc_streams[index] != NULL) {
+        return -1;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->handle.Instance = adc;
+    obj->num_channels = count;
+    for (size_t i = 0; i < count; i++) {
+        if ((pins[i] < 0xF0) || (pins[i] >= 0x100)) {
+            pin_function(pins[i], functions[i]);
+            pin_mode(pins[i], PullNone);
+        }
+        obj->channels[i] = STM_PIN_CHANNEL(functions[i]);
+    }
+    adc_streams[index] = obj;
+
+    return 0;
+}
+
+void analogin_stream_free(analogin_stream_t *obj)
+{
+    int index = adc_get_index(obj->handle.Instance);
+
+    analogin_stream_stop(obj);
+    if (index >= 0 && adc_streams[index] == obj) {
+        adc_streams[index] = NULL;
+    }
+}
+
+int analogin_stream_set_oversampling(analogin_stream_t *obj, uint8_t ratio_log2, uint8_t shift)
+{
+    // The ADC sums up to 256 conversions and shifts the result by up to 8 bits
+    if (obj->running || ratio_log2 > 8 || shift > 8 || (ratio_log2 == 0 && shift != 0)) {
+        return -1;
+    }
+
+    obj->oversampling_ratio = ratio_log2;
+    obj->oversampling_shift = shift;
+    return 0;
+}
+
+uint8_t analogin_stream_sample_bits(analogin_stream_t *obj)
+{
+    // The oversampler output is truncated to 16 bits
+    uint8_t bits = 12 + obj->oversampling_ratio - obj->oversampling_shift;
+    return bits > 16 ? 16 : bits;
+}
+
+static int adc_stream_timer_init(analogin_stream_t *obj, uint32_t rate)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t PclkFreq;
+
+    // Get clock configuration
+    // Note: PclkFreq contains here the Latency (not used after)
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &PclkFreq);
+    PclkFreq = HAL_RCC_GetPCLK1Freq();
+
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    if (RCC_ClkInitStruct.APB1CLKDivider != RCC_HCLK_DIV1) {
+        PclkFreq *= 2;
+    }
+
+    uint32_t ticks = (rate != 0) ? PclkFreq / rate : 0;
+    if (ticks < 2) {
+        return -1;
+    }
+    uint32_t prescaler = (ticks - 1) / 0x10000;
+    if (prescaler > 0xFFFF) {
+        return -1;
+    }
+
+    __HAL_RCC_TIM6_CLK_ENABLE();
+
+    TIM_HandleTypeDef *htim = &obj->tim_handle;
+    htim->Instance = TIM6;
+    htim->State = HAL_TIM_STATE_RESET;
+    htim->Init.Prescaler = prescaler;
+    htim->Init.Period = ticks / (prescaler + 1) - 1;
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(htim) != HAL_OK) {
+        return -1;
+    }
+
+    TIM_MasterConfigTypeDef master = {0};
+    master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    master.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(htim, &master) != HAL_OK) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int adc_stream_adc_init(analogin_stream_t *obj)
+{
+    ADC_HandleTypeDef *hadc = &obj->handle;
+
+    hadc->State = HAL_ADC_STATE_RESET;
+    hadc->Init.ClockPrescaler        = ADC_CLOCK_ASYNC_DIV2;
+    hadc->Init.Resolution            = ADC_RESOLUTION_12B;
+    hadc->Init.DataAlign             = ADC_DATAALIGN_RIGHT;
+    hadc->Init.ScanConvMode          = (obj->num_channels > 1) ? ENABLE : DISABLE;
+    hadc->Init.EOCSelection          = ADC_EOC_SEQ_CONV;
+    hadc->Init.LowPowerAutoWait      = DISABLE;
+    hadc->Init.ContinuousConvMode    = DISABLE;                       // One sequence per timer trigger
+    hadc->Init.NbrOfConversion       = obj->num_channels;
+    hadc->Init.DiscontinuousConvMode = DISABLE;
+    hadc->Init.NbrOfDiscConversion   = 1;
+    hadc->Init.ExternalTrigConv      = ADC_EXTERNALTRIG_T6_TRGO;
+    hadc->Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    hadc->Init.DMAContinuousRequests = ENABLE;                        // Keep the DMA requests going in circular mode
+    hadc->Init.Overrun               = ADC_OVR_DATA_OVERWRITTEN;
+    if (obj->oversampling_ratio != 0) {
+        hadc->Init.OversamplingMode               = ENABLE;
+        hadc->Init.Oversampling.Ratio             = (uint32_t)(obj->oversampling_ratio - 1) << ADC_CFGR2_OVSR_Pos;
+        hadc->Init.Oversampling.RightBitShift     = (uint32_t)obj->oversampling_shift << ADC_CFGR2_OVSS_Pos;
+        hadc->Init.Oversampling.TriggeredMode     = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
+        hadc->Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+    } else {
+        hadc->Init.OversamplingMode      = DISABLE;
+    }
+#if defined(ADC_CFGR_DFSDMCFG) &&defined(DFSDM1_Channel0)
+    hadc->Init.DFSDMConfig           = 0;
+#endif
+
+    __HAL_RCC_ADC_CLK_ENABLE();
+    __HAL_RCC_ADC_CONFIG(RCC_ADCCLKSOURCE_SYSCLK);
+
+    if (HAL_ADC_Init(hadc) != HAL_OK) {
+        return -1;
+    }
+
+    if (!HAL_ADCEx_Calibration_GetValue(hadc, ADC_SINGLE_ENDED)) {
+        HAL_ADCEx_Calibration_Start(hadc, ADC_SINGLE_ENDED);
+    }
+
+    for (uint8_t i = 0; i < obj->num_channels; i++) {
+        ADC_ChannelConfTypeDef sConfig = {0};
+        sConfig.Rank = adc_regular_ranks[i];
+        if (!adc_channel_config(obj->channels[i], &sConfig) ||
+                HAL_ADC_ConfigChannel(hadc, &sConfig) != HAL_OK) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int analogin_stream_start(analogin_stream_t *obj, uint32_t rate, uint16_t *buffer, size_t length,
+                          analogin_stream_handler handler, uint32_t id)
+{
+    const DMALinkInfo *link = &ADCDMALinks[adc_get_index(obj->handle.Instance)];
+
+    if (obj->running || adc_running_stream != NULL || buffer == NULL ||
+            length == 0 || length > 0xFFFF || (length % (2 * obj->num_channels)) != 0) {
+        return -1;
+    }
+
+    if (!stm_dma_link_alloc(link, &obj->dma_handle, DMA_PERIPH_TO_MEMORY, false, true,
+                            DMA_PDATAALIGN_HALFWORD, DMA_MDATAALIGN_HALFWORD, DMA_CIRCULAR)) {
+        return -1;
+    }
+
+    if (adc_stream_adc_init(obj) != 0 || adc_stream_timer_init(obj, rate) != 0) {
+        stm_dma_link_free(link);
+        return -1;
+    }
+
+    obj->buffer = buffer;
+    obj->length = length;
+    obj->handler = (uint32_t)handler;
+    obj->id = id;
+    adc_running_stream = obj;
+    obj->running = 1;
+
+    __HAL_LINKDMA(&obj->handle, DMA_Handle, obj->dma_handle);
+    if (HAL_ADC_Start_DMA(&obj->handle, (uint32_t *)buffer, length) != HAL_OK ||
+            HAL_TIM_Base_Start(&obj->tim_handle) != HAL_OK) {
+        analogin_stream_stop(obj);
+        return -1;
+    }
+
+    return 0;
+}
+
+void analogin_stream_stop(analogin_stream_t *obj)
+{
+    if (!obj->running) {
+        return;
+    }
+
+    HAL_TIM_Base_Stop(&obj->tim_handle);
+    HAL_ADC_Stop_DMA(&obj->handle);
+    stm_dma_link_free(&ADCDMALinks[adc_get_index(obj->handle.Instance)]);
+    LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(obj->handle.Instance), LL_ADC_PATH_INTERNAL_NONE);
+
+    obj->running = 0;
+    adc_running_stream = NULL;
+}
+
+#endif /* DEVICE_ANALOGIN_STREAM */
+
 #endif
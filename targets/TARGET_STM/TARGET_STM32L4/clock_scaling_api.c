@@ -0,0 +1,296 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if DEVICE_CLOCK_SCALING
+
+#include "clock_scaling_api.h"
+#include "cmsis.h"
+#include <stdbool.h>
+
+/*  Besides the boot configuration, set by SetSysClock() and usually the PLL,
+ *  the core can run from MSI at 48 MHz and from HSI at 16 MHz. The I2C timings
+ *  are provided for all these frequencies, as I2C is clocked by SYSCLK. At
+ *  16 MHz the voltage range 2 is used, unless the PLLSAI, for USB or SAI, or
+ *  HSI48 are running. The AHB and APB prescalers are kept. */
+#define STM_CLOCK_MSI_HZ    48000000
+#define STM_CLOCK_HSI_HZ    16000000
+#define STM_RANGE2_MAX_HZ   26000000
+
+/*  Flash wait states, one per frequency step */
+#if defined(PWR_CR5_R1MODE) /* STM32L4+ */
+#define STM_RANGE1_WS_HZ    20000000
+#define STM_RANGE2_WS_HZ    8000000
+#define STM_RANGE2_MAX_WS   FLASH_LATENCY_2
+#else
+#define STM_RANGE1_WS_HZ    16000000
+#define STM_RANGE2_WS_HZ    6000000
+#define STM_RANGE2_MAX_WS   FLASH_LATENCY_3
+#endif
+
+#if defined(RCC_CR_PLLSAI2ON)
+#define STM_RCC_CR_PLLSAI   (RCC_CR_PLLSAI1ON | RCC_CR_PLLSAI2ON)
+#else
+#define STM_RCC_CR_PLLSAI   RCC_CR_PLLSAI1ON
+#endif
+
+extern void update_timer_prescaler(void);
+
+typedef struct {
+    uint32_t hz;
+    uint32_t cr;
+    uint32_t cfgr;
+    uint32_t vos;
+    uint32_t latency;
+} stm_clock_boot_t;
+
+static stm_clock_boot_t boot_clock;
+static uint32_t clock_hz;
+
+static void stm_clock_boot_save(void)
+{
+    if (boot_clock.hz) {
+        return;
+    }
+    __HAL_RCC_PWR_CLK_ENABLE();
+    SystemCoreClockUpdate();
+    boot_clock.hz = SystemCoreClock;
+    boot_clock.cr = RCC->CR;
+    boot_clock.cfgr = RCC->CFGR;
+    boot_clock.vos = HAL_PWREx_GetVoltageRange();
+    boot_clock.latency = __HAL_FLASH_GET_LATENCY();
+    clock_hz = boot_clock.hz;
+}
+
+static uint32_t stm_clock_core_hz(uint32_t sysclk_hz)
+{
+    return sysclk_hz >> AHBPrescTable[(boot_clock.cfgr & RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+}
+
+static uint32_t stm_clock_latency(uint32_t sysclk_hz, bool range2)
+{
+    if (range2) {
+        uint32_t ws = (sysclk_hz - 1) / STM_RANGE2_WS_HZ;
+        return ws > STM_RANGE2_MAX_WS ? STM_RANGE2_MAX_WS : ws;
+    }
+    return (sysclk_hz - 1) / STM_RANGE1_WS_HZ;
+}
+
+static void stm_clock_latency_set(uint32_t latency)
+{
+    __HAL_FLASH_SET_LATENCY(latency);
+    while (__HAL_FLASH_GET_LATENCY() != latency) {
+    }
+}
+
+static void stm_clock_switch(uint32_t sws)
+{
+    MODIFY_REG(RCC->CFGR, RCC_CFGR_SW, sws >> RCC_CFGR_SWS_Pos);
+    while ((RCC->CFGR & RCC_CFGR_SWS) != sws) {
+    }
+}
+
+static void stm_clock_osc_on(uint32_t on, uint32_t rdy)
+{
+    SET_BIT(RCC->CR, on);
+    while (!READ_BIT(RCC->CR, rdy)) {
+    }
+}
+
+static void stm_clock_osc_off(uint32_t on, uint32_t rdy)
+{
+    CLEAR_BIT(RCC->CR, on);
+    while (READ_BIT(RCC->CR, rdy)) {
+    }
+}
+
+static void stm_clock_boot_restore(void)
+{
+    // MSI may be the PLL source, at its boot range
+    if (!READ_BIT(RCC->CR, RCC_CR_MSION)) {
+        MODIFY_REG(RCC->CR, RCC_CR_MSIRANGE | RCC_CR_MSIRGSEL, boot_clock.cr & (RCC_CR_MSIRANGE | RCC_CR_MSIRGSEL));
+        if (boot_clock.cr & RCC_CR_MSION) {
+            stm_clock_osc_on(RCC_CR_MSION, RCC_CR_MSIRDY);
+        }
+    } else {
+        MODIFY_REG(RCC->CR, RCC_CR_MSIRANGE | RCC_CR_MSIRGSEL | RCC_CR_MSIPLLEN,
+                   boot_clock.cr & (RCC_CR_MSIRANGE | RCC_CR_MSIRGSEL | RCC_CR_MSIPLLEN));
+    }
+    if (boot_clock.cr & RCC_CR_HSEON) {
+        stm_clock_osc_on(RCC_CR_HSEON, RCC_CR_HSERDY);
+    }
+    if (boot_clock.cr & RCC_CR_PLLON) {
+        stm_clock_osc_on(RCC_CR_PLLON, RCC_CR_PLLRDY);
+    }
+    stm_clock_switch(boot_clock.cfgr & RCC_CFGR_SWS);
+
+    if (!(boot_clock.cr & RCC_CR_MSION)) {
+        stm_clock_osc_off(RCC_CR_MSION, RCC_CR_MSIRDY);
+    }
+    if (!(boot_clock.cr & RCC_CR_HSION)) {
+        stm_clock_osc_off(RCC_CR_HSION, RCC_CR_HSIRDY);
+    }
+}
+
+static void stm_clock_scaled(uint32_t sysclk_hz)
+{
+    // The PLLSAI share the source of the main PLL
+    bool keep_pll_source = READ_BIT(RCC->CR, STM_RCC_CR_PLLSAI);
+
+    stm_clock_osc_off(RCC_CR_PLLON, RCC_CR_PLLRDY);
+    if (sysclk_hz == STM_CLOCK_MSI_HZ) {
+        if (!READ_BIT(RCC->CR, RCC_CR_MSION)) {
+            __HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_11);
+            stm_clock_osc_on(RCC_CR_MSION, RCC_CR_MSIRDY);
+        } else if ((RCC->CR & RCC_CR_MSIRANGE) != RCC_MSIRANGE_11) {
+            __HAL_RCC_MSI_RANGE_CONFIG(RCC_MSIRANGE_11);
+        }
+        // Trimmed by LSE, when running, for the serial baud rates
+        if (__HAL_RCC_GET_FLAG(RCC_FLAG_LSERDY)) {
+            SET_BIT(RCC->CR, RCC_CR_MSIPLLEN);
+        }
+        stm_clock_switch(RCC_CFGR_SWS_MSI);
+        if (!(boot_clock.cr & RCC_CR_HSION)) {
+            stm_clock_osc_off(RCC_CR_HSION, RCC_CR_HSIRDY);
+        }
+    } else if (!(boot_clock.cr & RCC_CR_MSION)) {
+        stm_clock_osc_off(RCC_CR_MSION, RCC_CR_MSIRDY);
+    }
+    if (!keep_pll_source && READ_BIT(RCC->CR, RCC_CR_HSEON)) {
+        stm_clock_osc_off(RCC_CR_HSEON, RCC_CR_HSERDY);
+    }
+}
+
+static bool stm_clock_range2(uint32_t sysclk_hz)
+{
+    if (sysclk_hz > STM_RANGE2_MAX_HZ || READ_BIT(RCC->CR, STM_RCC_CR_PLLSAI)) {
+        return false;
+    }
+#if defined(RCC_CRRCR_HSI48ON)
+    if (READ_BIT(RCC->CRRCR, RCC_CRRCR_HSI48ON)) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+static int stm_clock_set(uint32_t frequency_hz)
+{
+    uint32_t sysclk_hz;
+    uint32_t vos;
+    uint32_t latency;
+
+    if (frequency_hz == clock_hz) {
+        return 0;
+    }
+    if (frequency_hz == boot_clock.hz) {
+        sysclk_hz = 0;
+        vos = boot_clock.vos;
+        latency = boot_clock.latency;
+    } else {
+        if (frequency_hz == stm_clock_core_hz(STM_CLOCK_MSI_HZ)) {
+            sysclk_hz = STM_CLOCK_MSI_HZ;
+        } else if (frequency_hz == stm_clock_core_hz(STM_CLOCK_HSI_HZ)) {
+            sysclk_hz = STM_CLOCK_HSI_HZ;
+        } else {
+            return -1;
+        }
+        vos = stm_clock_range2(sysclk_hz) ? PWR_REGULATOR_VOLTAGE_SCALE2 : boot_clock.vos;
+        latency = stm_clock_latency(sysclk_hz, vos == PWR_REGULATOR_VOLTAGE_SCALE2);
+    }
+
+    // Raise the voltage and the wait states before the frequency
+    if (HAL_PWREx_GetVoltageRange() == PWR_REGULATOR_VOLTAGE_SCALE2 && vos != PWR_REGULATOR_VOLTAGE_SCALE2) {
+        HAL_PWREx_ControlVoltageScaling(vos);
+    }
+    if (latency > __HAL_FLASH_GET_LATENCY()) {
+        stm_clock_latency_set(latency);
+    }
+
+    // HSI runs the core while the other clocks are reconfigured
+    if (!READ_BIT(RCC->CR, RCC_CR_HSIRDY)) {
+        stm_clock_osc_on(RCC_CR_HSION, RCC_CR_HSIRDY);
+    }
+    stm_clock_switch(RCC_CFGR_SWS_HSI);
+
+    if (sysclk_hz) {
+        stm_clock_scaled(sysclk_hz);
+    } else {
+        stm_clock_boot_restore();
+    }
+
+    // Then lower the wait states and the voltage
+    if (latency < __HAL_FLASH_GET_LATENCY()) {
+        stm_clock_latency_set(latency);
+    }
+    if (vos == PWR_REGULATOR_VOLTAGE_SCALE2) {
+        HAL_PWREx_ControlVoltageScaling(vos);
+    }
+
+    SystemCoreClockUpdate();
+    clock_hz = frequency_hz;
+    update_timer_prescaler();
+    return 0;
+}
+
+uint8_t clock_scaling_get_frequencies(uint32_t *frequencies, uint8_t size)
+{
+    const uint32_t scaled[] = { stm_clock_core_hz(STM_CLOCK_MSI_HZ), stm_clock_core_hz(STM_CLOCK_HSI_HZ) };
+    uint8_t count = 0;
+
+    stm_clock_boot_save();
+    if (count < size) {
+        frequencies[count] = boot_clock.hz;
+    }
+    count++;
+    for (size_t i = 0; i < sizeof(scaled) / sizeof(scaled[0]); i++) {
+        if (scaled[i] < boot_clock.hz) {
+            if (count < size) {
+                frequencies[count] = scaled[i];
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+int clock_scaling_set(uint32_t frequency_hz)
+{
+    stm_clock_boot_save();
+    if (frequency_hz > boot_clock.hz) {
+        return -1;
+    }
+    return stm_clock_set(frequency_hz);
+}
+
+uint32_t clock_scaling_get(void)
+{
+    stm_clock_boot_save();
+    return clock_hz;
+}
+
+/*  Called by hal_deepsleep(), once SetSysClock() has brought the boot
+ *  configuration back */
+void stm_clock_scaling_resume(void)
+{
+    if (boot_clock.hz && clock_hz != boot_clock.hz) {
+        uint32_t frequency_hz = clock_hz;
+        clock_hz = boot_clock.hz;
+        stm_clock_set(frequency_hz);
+    }
+}
+
+#endif /* DEVICE_CLOCK_SCALING */
@@ -53,6 +53,15 @@ struct pwmout_s {
     uint32_t pulse;
     uint8_t channel;
     uint8_t inverted;
+#if DEVICE_PWMOUT_WAVEFORM
+    DMA_HandleTypeDef dma_handle;
+    uint8_t wave_dma;       // Row of TIMUpdateDMALinks + 1, 0 when no channel is owned
+    uint8_t wave_repeat;
+    uint16_t *wave;
+    size_t wave_length;
+    uint32_t wave_handler;
+    uint32_t wave_id;
+#endif
 };
 
 struct spi_s {
@@ -66,6 +75,22 @@ struct spi_s {
 #if DEVICE_SPI_ASYNCH
     uint32_t event;
     uint8_t transfer_type;
+    uint8_t dma_usage;
+    uint8_t dma_allocated;
+    uint8_t dma_active;
+#endif
+#if DEVICE_SPI_ASYNCH || DEVICE_SPISLAVE_DMA
+    DMA_HandleTypeDef dma_tx_handle;
+    DMA_HandleTypeDef dma_rx_handle;
+#endif
+#if DEVICE_SPISLAVE_DMA
+    uint8_t slave_dma_rx;            // circular reception running
+    uint8_t slave_dma_tx;            // transmission channel allocated
+    uint32_t slave_dma_items;        // frames in the circular buffer
+    volatile uint32_t slave_dma_wraps;
+    void (*slave_dma_handler)(uint32_t id);
+    uint32_t slave_dma_id;
+    struct gpio_irq_s slave_nss_irq; // rising edge of the chip select
 #endif
 };
 
@@ -116,6 +141,25 @@ struct i2c_s {
     uint32_t address;
     uint8_t stop;
     uint8_t available_events;
+    uint8_t dma_usage;
+    uint8_t dma_allocated;
+    uint8_t dma_active;
+#endif
+#if DEVICE_I2C_ASYNCH || DEVICE_I2CSLAVE_REGMAP
+    DMA_HandleTypeDef dma_tx_handle;
+    DMA_HandleTypeDef dma_rx_handle;
+#endif
+#if DEVICE_I2CSLAVE_REGMAP
+    uint8_t *regmap;                 // registers served to the master, NULL when stopped
+    uint32_t regmap_size;
+    uint32_t regmap_ptr;             // register pointer
+    uint32_t regmap_start;           // register pointer at the start of the transfer
+    uint32_t regmap_dma_length;      // registers given to the TX DMA in this read, 0 if none
+    uint32_t regmap_count;           // bytes stored or loaded by the interrupt in this transfer
+    uint8_t regmap_state;
+    uint8_t regmap_dma;              // TX DMA channel allocated
+    void (*regmap_handler)(uint32_t id, uint32_t offset, uint32_t length);
+    uint32_t regmap_id;
 #endif
 };
 
@@ -130,6 +174,48 @@ struct analogin_s {
     uint8_t channel;
 };
 
+#if DEVICE_ANALOGIN_STREAM
+/* Maximum length of the ADC regular sequence */
+#define ANALOGIN_STREAM_MAX_CHANNELS 16
+
+struct analogin_stream_s {
+    ADC_HandleTypeDef handle;
+    DMA_HandleTypeDef dma_handle;
+    TIM_HandleTypeDef tim_handle;
+    uint8_t channels[ANALOGIN_STREAM_MAX_CHANNELS];
+    uint8_t num_channels;
+    uint8_t oversampling_ratio; // log2 of the ratio, 0 when disabled
+    uint8_t oversampling_shift;
+    uint8_t running;
+    uint16_t *buffer;
+    size_t length;
+    uint32_t handler;
+    uint32_t id;
+};
+#endif
+
+#if DEVICE_INPUT_CAPTURE
+struct input_capture_s {
+    TIM_HandleTypeDef handle;
+    DMA_HandleTypeDef dma_handle;
+    PinName pin;
+    PinName pin_b;          // NC unless counting an encoder
+    uint8_t index;          // Row of TIMCaptureDMALinks
+    uint8_t channel;        // 1 to 4
+    uint8_t running;
+    uint32_t tick_hz;
+    uint32_t *buffer;
+    size_t length;
+    uint32_t handler;
+    uint32_t id;
+    uint32_t encoder_count; // Counter value at the last read
+    int32_t encoder_position;
+};
+#endif
+
+/* GPIO ports are 0x400 apart from GPIOA: hal/gpio_fast_api.h is supported */
+#define GPIO_FAST_READY 1
+
 #include "gpio_object.h"
 
 struct dac_s {
@@ -165,6 +251,12 @@ struct qspi_s {
     PinName io3;
     PinName sclk;
     PinName ssel;
+#if DEVICE_QSPI_ASYNCH
+    DMA_HandleTypeDef dma_handle;
+    uint32_t async_handler;
+    uint32_t async_id;
+    uint8_t dma_allocated;
+#endif
 };
 #endif
 
@@ -159,6 +159,13 @@
   * @}
   */
 
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) // MBED
+/* Functions declared with MBED_RAMFUNC, see the .ramfunc section of the linker scripts */
+extern uint32_t __ramfunc_load__[];
+extern uint32_t __ramfunc_start__[];
+extern uint32_t __ramfunc_end__[];
+#endif
+
 /** @addtogroup STM32L4xx_System_Private_FunctionPrototypes
   * @{
   */
@@ -210,6 +217,14 @@ void SystemInit(void)
 #include "nvic_addr.h"                   // MBED
   SCB->VTOR = NVIC_FLASH_VECTOR_ADDRESS; // MBED
 #endif
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) // MBED
+  /* Copy the functions to be executed from RAM, done by scatter loading with the ARM toolchain */
+  uint32_t *src = __ramfunc_load__;
+  for (uint32_t *dst = __ramfunc_start__; dst < __ramfunc_end__; dst++, src++) {
+    *dst = *src;
+  }
+#endif
 }
 
 /**
@@ -18,10 +18,12 @@
 
 #include "flash_api.h"
 #include "mbed_critical.h"
+#include "mbed_toolchain.h"
 
 #if DEVICE_FLASH
 #include "mbed_assert.h"
 #include "cmsis.h"
+#include <string.h>
 
 /**
   * @brief  Gets the page of a given address
@@ -116,6 +118,100 @@ static int32_t flash_lock(void)
     }
 }
 
+/* The erase and program loops below run from RAM: they don't stall on the
+ * flash they are waiting for, and the interrupt handlers declared with
+ * MBED_RAMFUNC keep being served meanwhile. They only access registers. */
+
+/* Wait for the end of the current operation and clear its status */
+MBED_RAMFUNC static int32_t flash_wait_ram(void)
+{
+    uint32_t sr;
+
+    do {
+        sr = FLASH->SR;
+    } while (sr & FLASH_FLAG_BSY);
+
+    WRITE_REG(FLASH->SR, sr & (FLASH_FLAG_EOP | FLASH_FLAG_SR_ERRORS));
+
+    return (sr & FLASH_FLAG_SR_ERRORS) ? -1 : 0;
+}
+
+MBED_RAMFUNC static int32_t flash_erase_page_ram(uint32_t page)
+{
+    int32_t status;
+
+    MODIFY_REG(FLASH->CR, FLASH_CR_PNB, ((page & 0xFFU) << FLASH_CR_PNB_Pos));
+    SET_BIT(FLASH->CR, FLASH_CR_PER);
+    SET_BIT(FLASH->CR, FLASH_CR_STRT);
+    status = flash_wait_ram();
+    CLEAR_BIT(FLASH->CR, (FLASH_CR_PER | FLASH_CR_PNB));
+
+    return status;
+}
+
+/* The data may be unaligned, the addresses are double word aligned */
+MBED_RAMFUNC static int32_t flash_program_ram(uint32_t address, const uint8_t *data, uint32_t size)
+{
+    const uint32_t end = address + size;
+    int32_t status = 0;
+
+    SET_BIT(FLASH->CR, FLASH_CR_PG);
+    while ((address < end) && (status == 0)) {
+        *(__IO uint32_t *)address = __UNALIGNED_UINT32_READ(data);
+        /* Program the double word in 2 steps, in the right order */
+        __ISB();
+        *(__IO uint32_t *)(address + 4U) = __UNALIGNED_UINT32_READ(data + 4);
+        status = flash_wait_ram();
+        address += 8;
+        data += 8;
+    }
+    CLEAR_BIT(FLASH->CR, FLASH_CR_PG);
+
+    return status;
+}
+
+/* Disable the given flash caches while the flash is modified, returns the ones that were enabled */
+static uint32_t flash_caches_disable(uint32_t caches)
+{
+    uint32_t enabled = READ_BIT(FLASH->ACR, caches);
+
+    CLEAR_BIT(FLASH->ACR, enabled);
+
+    return enabled;
+}
+
+/* Reset and enable the flash caches disabled by flash_caches_disable */
+static void flash_caches_restore(uint32_t enabled)
+{
+    if (enabled & FLASH_ACR_ICEN) {
+        __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+    }
+    if (enabled & FLASH_ACR_DCEN) {
+        __HAL_FLASH_DATA_CACHE_RESET();
+    }
+    SET_BIT(FLASH->ACR, enabled);
+}
+
+static void flash_select_bank(uint32_t bank)
+{
+#if defined(FLASH_CR_BKER)
+#if defined(FLASH_OPTR_DBANK)
+    if (READ_BIT(FLASH->OPTR, FLASH_OPTR_DBANK) == 0U) {
+        /* Single bank mode */
+        CLEAR_BIT(FLASH->CR, FLASH_CR_BKER);
+        return;
+    }
+#endif
+    if (bank == FLASH_BANK_1) {
+        CLEAR_BIT(FLASH->CR, FLASH_CR_BKER);
+    } else {
+        SET_BIT(FLASH->CR, FLASH_CR_BKER);
+    }
+#else
+    (void)bank;
+#endif
+}
+
 /** Erase one sector starting at defined address
  *
  * The address should be at sector boundary. This function does not do any check for address alignments
@@ -125,9 +221,7 @@ static int32_t flash_lock(void)
  */
 int32_t flash_erase_sector(flash_t *obj, uint32_t address)
 {
-    uint32_t FirstPage = 0, BankNumber = 0;
-    uint32_t PAGEError = 0;
-    FLASH_EraseInitTypeDef EraseInitStruct;
+    uint32_t caches;
     int32_t status = 0;
 
     if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
@@ -135,6 +229,12 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address)
         return -1;
     }
 
+#if DEVICE_FLASH_ASYNCH
+    if (flash_async_busy(obj)) {
+        return -1;
+    }
+#endif
+
     if (flash_unlock() != HAL_OK) {
         return -1;
     }
@@ -142,25 +242,16 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address)
     /* Clear error programming flags */
     __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
 
-    /* Get the 1st page to erase */
-    FirstPage = GetPage(address);
-    /* MBED HAL erases 1 page  / sector at a time */
-    /* Get the bank */
-    BankNumber = GetBank(address);
-    /* Fill EraseInit structure*/
-    EraseInitStruct.TypeErase   = FLASH_TYPEERASE_PAGES;
-    EraseInitStruct.Banks       = BankNumber;
-    EraseInitStruct.Page        = FirstPage;
-    EraseInitStruct.NbPages     = 1;
-
     /* Note: If an erase operation in Flash memory also concerns data in the data or instruction cache,
      you have to make sure that these data are rewritten before they are accessed during code
-     execution. If this cannot be done safely, it is recommended to flush the caches by setting the
-     DCRST and ICRST bits in the FLASH_CR register. */
+     execution. The caches are disabled during the erase, and reset afterwards. */
+    caches = flash_caches_disable(FLASH_ACR_ICEN | FLASH_ACR_DCEN);
 
-    if (HAL_FLASHEx_Erase(&EraseInitStruct, &PAGEError) != HAL_OK) {
-        status = -1;
-    }
+    /* MBED HAL erases 1 page  / sector at a time */
+    flash_select_bank(GetBank(address));
+    status = flash_erase_page_ram(GetPage(address));
+
+    flash_caches_restore(caches);
 
     flash_lock();
 
@@ -181,8 +272,8 @@ int32_t flash_erase_sector(flash_t *obj, uint32_t address)
 int32_t flash_program_page(flash_t *obj, uint32_t address,
                            const uint8_t *data, uint32_t size)
 {
-    uint32_t StartAddress = 0;
-    int32_t status = 0;
+    uint32_t caches;
+    int32_t status;
 
     if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
         return -1;
@@ -193,6 +284,12 @@ int32_t flash_program_page(flash_t *obj, uint32_t address,
         return -1;
     }
 
+#if DEVICE_FLASH_ASYNCH
+    if (flash_async_busy(obj)) {
+        return -1;
+    }
+#endif
+
     if (flash_unlock() != HAL_OK) {
         return -1;
     }
@@ -200,44 +297,172 @@ int32_t flash_program_page(flash_t *obj, uint32_t address,
     /* Clear error programming flags */
     __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
 
-    /* Program the user Flash area word by word */
-    StartAddress = address;
-
-    /*  HW needs an aligned address to program flash, which data
-     *  parameters doesn't ensure  */
-    if ((uint32_t) data % 8 != 0) {
-        volatile uint64_t data64;
-        while ((address < (StartAddress + size)) && (status == 0)) {
-            for (uint8_t i = 0; i < 8; i++) {
-                *(((uint8_t *) &data64) + i) = *(data + i);
-            }
-
-            if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address, data64)
-                    == HAL_OK) {
-                address = address + 8;
-                data = data + 8;
-            } else {
-                status = -1;
-            }
-        }
-    } else { /*  case where data is aligned, so let's avoid any copy */
-        while ((address < (StartAddress + size)) && (status == 0)) {
-            if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address,
-                                  *((uint64_t *) data))
-                    == HAL_OK) {
-                address = address + 8;
-                data = data + 8;
-            } else {
-                status = -1;
-            }
+    /* Program the user Flash area double word by double word */
+    caches = flash_caches_disable(FLASH_ACR_DCEN);
+    status = flash_program_ram(address, data, size);
+    flash_caches_restore(caches);
+
+    flash_lock();
+
+    return status;
+}
+
+#if DEVICE_FLASH_ASYNCH
+
+/* There is a single flash interface, whatever the number of flash_t objects */
+static struct {
+    flash_async_handler handler;
+    uint32_t id;
+    const uint8_t *data;
+    uint32_t address;
+    uint32_t end;
+    volatile bool busy;
+} flash_async;
+
+static void flash_async_complete(int32_t status)
+{
+    flash_async_handler handler = flash_async.handler;
+
+    flash_lock();
+    flash_async.busy = false;
+    handler(flash_async.id, status);
+}
+
+/* Program the next double word, the HAL only programs one per interrupt */
+static int32_t flash_async_program_next(void)
+{
+    uint64_t data64;
+
+    /* Also takes care of unaligned data buffers */
+    memcpy(&data64, flash_async.data, sizeof(data64));
+    if (HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_DOUBLEWORD, flash_async.address, data64) != HAL_OK) {
+        return -1;
+    }
+    flash_async.address += 8;
+    flash_async.data += 8;
+
+    return 0;
+}
+
+static void flash_async_irq(void)
+{
+    HAL_FLASH_IRQHandler();
+
+    if (!flash_async.busy || (pFlash.ProcedureOnGoing != FLASH_PROC_NONE)) {
+        return;
+    }
+
+    if (pFlash.ErrorCode != HAL_FLASH_ERROR_NONE) {
+        flash_async_complete(-1);
+    } else if (flash_async.address < flash_async.end) {
+        if (flash_async_program_next() != 0) {
+            flash_async_complete(-1);
         }
+    } else {
+        flash_async_complete(0);
+    }
+}
+
+static int32_t flash_async_begin(flash_async_handler handler, uint32_t id)
+{
+    core_util_critical_section_enter();
+    if (flash_async.busy) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    flash_async.busy = true;
+    core_util_critical_section_exit();
+
+    if (flash_unlock() != HAL_OK) {
+        flash_async.busy = false;
+        return -1;
     }
 
+    /* Clear error programming flags */
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+    flash_async.handler = handler;
+    flash_async.id = id;
+
+    NVIC_SetVector(FLASH_IRQn, (uint32_t)flash_async_irq);
+    NVIC_EnableIRQ(FLASH_IRQn);
+
+    return 0;
+}
+
+static void flash_async_abort(void)
+{
     flash_lock();
+    flash_async.busy = false;
+}
 
-    return status;
+int32_t flash_erase_sector_async(flash_t *obj, uint32_t address, flash_async_handler handler, uint32_t id)
+{
+    FLASH_EraseInitTypeDef EraseInitStruct;
+
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if (flash_async_begin(handler, id) != 0) {
+        return -1;
+    }
+
+    /* Nothing left to program on completion */
+    flash_async.address = 0;
+    flash_async.end = 0;
+
+    EraseInitStruct.TypeErase   = FLASH_TYPEERASE_PAGES;
+    EraseInitStruct.Banks       = GetBank(address);
+    EraseInitStruct.Page        = GetPage(address);
+    EraseInitStruct.NbPages     = 1;
+
+    if (HAL_FLASHEx_Erase_IT(&EraseInitStruct) != HAL_OK) {
+        flash_async_abort();
+        return -1;
+    }
+
+    return 0;
 }
 
+int32_t flash_program_page_async(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size,
+                                 flash_async_handler handler, uint32_t id)
+{
+    if ((address >= (FLASH_BASE + FLASH_SIZE)) || (address < FLASH_BASE)) {
+        return -1;
+    }
+
+    if (((size % 8) != 0) || (size == 0)) {
+        /* L4 flash devices can only be programmed 64bits/8 bytes at a time */
+        return -1;
+    }
+
+    if (flash_async_begin(handler, id) != 0) {
+        return -1;
+    }
+
+    flash_async.data = data;
+    flash_async.address = address;
+    flash_async.end = address + size;
+
+    /* The first double word may complete before this returns: the state is set beforehand */
+    if (flash_async_program_next() != 0) {
+        flash_async_abort();
+        return -1;
+    }
+
+    return 0;
+}
+
+bool flash_async_busy(const flash_t *obj)
+{
+    (void)obj;
+
+    return flash_async.busy;
+}
+
+#endif
+
 /** Get sector size
  *
  * @param obj The flash object
@@ -98,6 +98,21 @@ static inline uint32_t get_i2c_timing(int hz)
             default:
                 break;
         }
+    } else if (SystemCoreClock == 16000000) {
+        // Common settings: I2C clock = 16 MHz, Analog filter = ON, Digital filter coefficient = 0
+        switch (hz) {
+            case 100000:
+                tim = 0x00303D5B; // Standard mode with Rise Time = 400ns and Fall Time = 100ns
+                break;
+            case 400000:
+                tim = 0x0010061A; // Fast mode with Rise Time = 250ns and Fall Time = 100ns
+                break;
+            case 1000000:
+                tim = 0x00000107; // Fast mode Plus with Rise Time = 60ns and Fall Time = 100ns
+                break;
+            default:
+                break;
+        }
     } else {
         error("get_i2c_timing error\n");
     }
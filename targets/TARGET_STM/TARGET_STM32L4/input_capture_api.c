@@ -0,0 +1,388 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_capture_api.h"
+
+#if DEVICE_INPUT_CAPTURE
+
+#include <string.h>
+#include "cmsis.h"
+#include "pinmap.h"
+#include "PeripheralPins.h"
+#include "pwmout_device.h"
+#include "stm_dma_utils.h"
+#include "us_ticker_data.h"
+
+/*  The timers are those muxed on the PWM pins, in the order of
+ *  TIMCaptureDMALinks. The one running the us ticker is never used. */
+#define CAPTURE_TIMERS  (sizeof(TIMCaptureDMALinks) / sizeof(TIMCaptureDMALinks[0]))
+
+static input_capture_t *capture_timers[CAPTURE_TIMERS];
+
+static int capture_timer_enable(TIM_TypeDef *tim)
+{
+    if (tim == TIM_MST) {
+        return -1;
+    }
+#if defined(TIM1_BASE)
+    if (tim == TIM1) {
+        __HAL_RCC_TIM1_CLK_ENABLE();
+        return 0;
+    }
+#endif
+#if defined(TIM2_BASE)
+    if (tim == TIM2) {
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        return 1;
+    }
+#endif
+#if defined(TIM3_BASE)
+    if (tim == TIM3) {
+        __HAL_RCC_TIM3_CLK_ENABLE();
+        return 2;
+    }
+#endif
+#if defined(TIM4_BASE)
+    if (tim == TIM4) {
+        __HAL_RCC_TIM4_CLK_ENABLE();
+        return 3;
+    }
+#endif
+#if defined(TIM5_BASE)
+    if (tim == TIM5) {
+        __HAL_RCC_TIM5_CLK_ENABLE();
+        return 4;
+    }
+#endif
+#if defined(TIM8_BASE)
+    if (tim == TIM8) {
+        __HAL_RCC_TIM8_CLK_ENABLE();
+        return 5;
+    }
+#endif
+#if defined(TIM15_BASE)
+    if (tim == TIM15) {
+        __HAL_RCC_TIM15_CLK_ENABLE();
+        return 6;
+    }
+#endif
+#if defined(TIM16_BASE)
+    if (tim == TIM16) {
+        __HAL_RCC_TIM16_CLK_ENABLE();
+        return 7;
+    }
+#endif
+#if defined(TIM17_BASE)
+    if (tim == TIM17) {
+        __HAL_RCC_TIM17_CLK_ENABLE();
+        return 8;
+    }
+#endif
+    return -1;
+}
+
+static uint32_t capture_timer_clock(TIM_TypeDef *tim)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t PclkFreq;
+    uint32_t APBxCLKDivider;
+    uint8_t i = 0;
+
+    // Get clock configuration
+    // Note: PclkFreq contains here the Latency (not used after)
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &PclkFreq);
+
+    /*  Parse the pwm / apb mapping table to find the right entry */
+    while (pwm_apb_map_table[i].pwm != 0 && pwm_apb_map_table[i].pwm != (PWMName)tim) {
+        i++;
+    }
+
+    if (pwm_apb_map_table[i].pwmoutApb == PWMOUT_ON_APB1) {
+        PclkFreq = HAL_RCC_GetPCLK1Freq();
+        APBxCLKDivider = RCC_ClkInitStruct.APB1CLKDivider;
+    } else {
+        PclkFreq = HAL_RCC_GetPCLK2Freq();
+        APBxCLKDivider = RCC_ClkInitStruct.APB2CLKDivider;
+    }
+
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    return (APBxCLKDivider == RCC_HCLK_DIV1) ? PclkFreq : PclkFreq * 2;
+}
+
+static int capture_pin_init(PinName pin, TIM_TypeDef **tim, uint8_t *channel)
+{
+    TIM_TypeDef *pin_tim = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
+    int function = (int)pinmap_find_function(pin, PinMap_PWM);
+
+    // The complementary outputs have no input stage
+    if (pin_tim == (TIM_TypeDef *)NC || function == (int)NC || STM_PIN_INVERTED(function)) {
+        return -1;
+    }
+    if (*tim != NULL && pin_tim != *tim) {
+        return -1;
+    }
+
+    *tim = pin_tim;
+    *channel = STM_PIN_CHANNEL(function);
+    return 0;
+}
+
+static int capture_claim(input_capture_t *obj, TIM_TypeDef *tim)
+{
+    int index = capture_timer_enable(tim);
+
+    if (index < 0 || capture_timers[index] != NULL) {
+        return -1;
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->handle.Instance = tim;
+    obj->index = index;
+    obj->pin_b = NC;
+    capture_timers[index] = obj;
+    return 0;
+}
+
+int input_capture_init(input_capture_t *obj, PinName pin)
+{
+    TIM_TypeDef *tim = NULL;
+    uint8_t channel;
+
+    if (capture_pin_init(pin, &tim, &channel) != 0 || channel < 1 || channel > 4 ||
+            capture_claim(obj, tim) != 0) {
+        return -1;
+    }
+
+    obj->pin = pin;
+    obj->channel = channel;
+    pinmap_pinout(pin, PinMap_PWM);
+    pin_mode(pin, PullNone);
+    return 0;
+}
+
+int input_capture_encoder_init(input_capture_t *obj, PinName pin_a, PinName pin_b)
+{
+    TIM_TypeDef *tim = NULL;
+    uint8_t channel_a;
+    uint8_t channel_b;
+
+    if (capture_pin_init(pin_a, &tim, &channel_a) != 0 || capture_pin_init(pin_b, &tim, &channel_b) != 0 ||
+            channel_a != 1 || channel_b != 2 || !IS_TIM_ENCODER_INTERFACE_INSTANCE(tim) ||
+            capture_claim(obj, tim) != 0) {
+        return -1;
+    }
+
+    obj->pin = pin_a;
+    obj->pin_b = pin_b;
+    pinmap_pinout(pin_a, PinMap_PWM);
+    pinmap_pinout(pin_b, PinMap_PWM);
+    pin_mode(pin_a, PullNone);
+    pin_mode(pin_b, PullNone);
+
+    TIM_HandleTypeDef *htim = &obj->handle;
+    htim->State = HAL_TIM_STATE_RESET;
+    htim->Init.Prescaler = 0;
+    htim->Init.Period = input_capture_max_count(obj);
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+    // Both edges of both inputs, filtered over 4 timer clocks against contact bounce
+    TIM_Encoder_InitTypeDef encoder = {0};
+    encoder.EncoderMode = TIM_ENCODERMODE_TI12;
+    encoder.IC1Polarity = TIM_ICPOLARITY_RISING;
+    encoder.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+    encoder.IC1Prescaler = TIM_ICPSC_DIV1;
+    encoder.IC1Filter = 2;
+    encoder.IC2Polarity = TIM_ICPOLARITY_RISING;
+    encoder.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+    encoder.IC2Prescaler = TIM_ICPSC_DIV1;
+    encoder.IC2Filter = 2;
+    if (HAL_TIM_Encoder_Init(htim, &encoder) != HAL_OK ||
+            HAL_TIM_Encoder_Start(htim, TIM_CHANNEL_ALL) != HAL_OK) {
+        input_capture_free(obj);
+        return -1;
+    }
+    obj->running = 1;
+
+    return 0;
+}
+
+void input_capture_free(input_capture_t *obj)
+{
+    if (obj->pin_b != NC) {
+        HAL_TIM_Encoder_Stop(&obj->handle, TIM_CHANNEL_ALL);
+        obj->running = 0;
+        pin_function(obj->pin_b, STM_PIN_DATA(STM_MODE_INPUT, GPIO_NOPULL, 0));
+    } else {
+        input_capture_stop(obj);
+    }
+    pin_function(obj->pin, STM_PIN_DATA(STM_MODE_INPUT, GPIO_NOPULL, 0));
+
+    if (capture_timers[obj->index] == obj) {
+        capture_timers[obj->index] = NULL;
+    }
+}
+
+uint32_t input_capture_max_count(input_capture_t *obj)
+{
+    return IS_TIM_32B_COUNTER_INSTANCE(obj->handle.Instance) ? 0xFFFFFFFF : 0xFFFF;
+}
+
+static void capture_dma_half(DMA_HandleTypeDef *hdma)
+{
+    input_capture_t *obj = (input_capture_t *)hdma->Parent;
+
+    ((input_capture_handler)obj->handler)(obj->id, obj->buffer, obj->length / 2);
+}
+
+static void capture_dma_complete(DMA_HandleTypeDef *hdma)
+{
+    input_capture_t *obj = (input_capture_t *)hdma->Parent;
+
+    ((input_capture_handler)obj->handler)(obj->id, obj->buffer + obj->length / 2, obj->length / 2);
+}
+
+static const uint32_t capture_channels[4] = {
+    TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4
+};
+
+static const uint32_t capture_dma_requests[4] = {
+    TIM_DMA_CC1, TIM_DMA_CC2, TIM_DMA_CC3, TIM_DMA_CC4
+};
+
+int input_capture_start(input_capture_t *obj, uint32_t tick_hz, input_capture_edge_t edge,
+                        uint32_t *buffer, size_t length, input_capture_handler handler, uint32_t id)
+{
+    const DMALinkInfo *link = &TIMCaptureDMALinks[obj->index][obj->channel - 1];
+    TIM_HandleTypeDef *htim = &obj->handle;
+    uint32_t channel = capture_channels[obj->channel - 1];
+
+    if (obj->running || obj->pin_b != NC || link->dma_idx == 0 || buffer == NULL ||
+            length == 0 || length > 0xFFFF || (length % 2) != 0) {
+        return -1;
+    }
+
+    uint32_t clock_hz = capture_timer_clock(htim->Instance);
+    uint32_t prescaler = (tick_hz != 0 && tick_hz < clock_hz) ? (clock_hz + tick_hz / 2) / tick_hz - 1 : 0;
+    if (prescaler > 0xFFFF) {
+        return -1;
+    }
+
+    if (!stm_dma_link_alloc(link, &obj->dma_handle, DMA_PERIPH_TO_MEMORY, false, true,
+                            DMA_PDATAALIGN_WORD, DMA_MDATAALIGN_WORD, DMA_CIRCULAR)) {
+        return -1;
+    }
+    obj->dma_handle.Parent = obj;
+    obj->dma_handle.XferHalfCpltCallback = capture_dma_half;
+    obj->dma_handle.XferCpltCallback = capture_dma_complete;
+
+    htim->State = HAL_TIM_STATE_RESET;
+    htim->Init.Prescaler = prescaler;
+    htim->Init.Period = input_capture_max_count(obj);
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+    TIM_IC_InitTypeDef ic = {0};
+    switch (edge) {
+        case INPUT_CAPTURE_FALLING:
+            ic.ICPolarity = TIM_ICPOLARITY_FALLING;
+            break;
+        case INPUT_CAPTURE_BOTH:
+            ic.ICPolarity = TIM_ICPOLARITY_BOTHEDGE;
+            break;
+        default:
+            ic.ICPolarity = TIM_ICPOLARITY_RISING;
+            break;
+    }
+    ic.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    ic.ICPrescaler = TIM_ICPSC_DIV1;
+    ic.ICFilter = 0;
+    if (HAL_TIM_IC_Init(htim) != HAL_OK || HAL_TIM_IC_ConfigChannel(htim, &ic, channel) != HAL_OK) {
+        stm_dma_link_free(link);
+        return -1;
+    }
+
+    obj->tick_hz = clock_hz / (prescaler + 1);
+    obj->buffer = buffer;
+    obj->length = length;
+    obj->handler = (uint32_t)handler;
+    obj->id = id;
+
+    // Each capture requests a DMA transfer of the CCR register latched
+    volatile uint32_t *ccr = &htim->Instance->CCR1 + (obj->channel - 1);
+    if (HAL_DMA_Start_IT(&obj->dma_handle, (uint32_t)ccr, (uint32_t)buffer, length) != HAL_OK) {
+        stm_dma_link_free(link);
+        return -1;
+    }
+    obj->running = 1;
+
+    __HAL_TIM_ENABLE_DMA(htim, capture_dma_requests[obj->channel - 1]);
+    TIM_CCxChannelCmd(htim->Instance, channel, TIM_CCx_ENABLE);
+    __HAL_TIM_ENABLE(htim);
+
+    return 0;
+}
+
+uint32_t input_capture_tick_hz(input_capture_t *obj)
+{
+    return obj->tick_hz;
+}
+
+void input_capture_stop(input_capture_t *obj)
+{
+    TIM_HandleTypeDef *htim = &obj->handle;
+
+    if (!obj->running || obj->pin_b != NC) {
+        return;
+    }
+
+    __HAL_TIM_DISABLE(htim);
+    TIM_CCxChannelCmd(htim->Instance, capture_channels[obj->channel - 1], TIM_CCx_DISABLE);
+    __HAL_TIM_DISABLE_DMA(htim, capture_dma_requests[obj->channel - 1]);
+    stm_dma_link_free(&TIMCaptureDMALinks[obj->index][obj->channel - 1]);
+
+    obj->running = 0;
+}
+
+int32_t input_capture_encoder_read(input_capture_t *obj)
+{
+    uint32_t count = obj->handle.Instance->CNT;
+
+    // The difference to the last read is within half a turn of the counter
+    if (input_capture_max_count(obj) == 0xFFFF) {
+        obj->encoder_position += (int16_t)(count - obj->encoder_count);
+    } else {
+        obj->encoder_position += (int32_t)(count - obj->encoder_count);
+    }
+    obj->encoder_count = count;
+    return obj->encoder_position;
+}
+
+void input_capture_encoder_reset(input_capture_t *obj)
+{
+    obj->encoder_count = obj->handle.Instance->CNT;
+    obj->encoder_position = 0;
+}
+
+const PinMap *input_capture_pinmap()
+{
+    return PinMap_PWM;
+}
+
+#endif /* DEVICE_INPUT_CAPTURE */
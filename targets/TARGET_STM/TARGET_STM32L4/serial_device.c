@@ -31,6 +31,11 @@
 #if DEVICE_SERIAL
 
 #include "serial_api_hal.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_SERIAL_DMA
+#include "stm_dma_utils.h"
+#endif
 
 #if defined (TARGET_STM32L432xC)
 #define UART_NUM (3)
@@ -45,6 +50,14 @@ UART_HandleTypeDef uart_handlers[UART_NUM];
 
 static uart_irq_handler irq_handler;
 
+#if DEVICE_SERIAL_DMA
+static DMA_HandleTypeDef uart_rx_dma_handles[UART_NUM];
+static uint8_t uart_rx_dma_active[UART_NUM];
+static DMA_HandleTypeDef uart_tx_dma_handles[UART_NUM];
+static uint8_t uart_tx_dma_enabled[UART_NUM];
+static uint8_t uart_tx_dma_notify[UART_NUM];
+#endif
+
 // Defined in serial_api.c
 extern int8_t get_uart_index(UARTName uart_name);
 
@@ -52,7 +65,7 @@ extern int8_t get_uart_index(UARTName uart_name);
  * INTERRUPTS HANDLING
  ******************************************************************************/
 
-static void uart_irq(UARTName uart_name)
+MBED_RAMFUNC static void uart_irq(UARTName uart_name)
 {
     int8_t id = get_uart_index(uart_name);
 
@@ -75,47 +88,59 @@ static void uart_irq(UARTName uart_name)
                     volatile uint32_t tmpval __attribute__((unused)) = huart->Instance->RDR; // Clear ORE flag
                 }
             }
+#if DEVICE_SERIAL_DMA
+            if (uart_rx_dma_active[id]) {
+                if (__HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE) != RESET) {
+                    __HAL_UART_CLEAR_IDLEFLAG(huart);
+                    if (__HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE)) {
+                        irq_handler(serial_irq_ids[id], RxIrq);
+                    }
+                }
+                // Reception errors don't stop the DMA, just clear them
+                __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_PEF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_OREF);
+            }
+#endif
         }
     }
 }
 
 #if defined(USART1_BASE)
-static void uart1_irq(void)
+MBED_RAMFUNC static void uart1_irq(void)
 {
     uart_irq(UART_1);
 }
 #endif
 
 #if defined(USART2_BASE)
-static void uart2_irq(void)
+MBED_RAMFUNC static void uart2_irq(void)
 {
     uart_irq(UART_2);
 }
 #endif
 
 #if defined(USART3_BASE)
-static void uart3_irq(void)
+MBED_RAMFUNC static void uart3_irq(void)
 {
     uart_irq(UART_3);
 }
 #endif
 
 #if defined(UART4_BASE)
-static void uart4_irq(void)
+MBED_RAMFUNC static void uart4_irq(void)
 {
     uart_irq(UART_4);
 }
 #endif
 
 #if defined(UART5_BASE)
-static void uart5_irq(void)
+MBED_RAMFUNC static void uart5_irq(void)
 {
     uart_irq(UART_5);
 }
 #endif
 
 #if defined(LPUART1_BASE)
-static void lpuart1_irq(void)
+MBED_RAMFUNC static void lpuart1_irq(void)
 {
     uart_irq(LPUART_1);
 }
@@ -177,9 +202,25 @@ void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
 
     if (enable) {
         if (irq == RxIrq) {
-            __HAL_UART_ENABLE_IT(huart, UART_IT_RXNE);
+#if DEVICE_SERIAL_DMA
+            if (uart_rx_dma_active[obj_s->index]) {
+                // The DMA reads RDR, only notify at the end of a burst
+                __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+            } else
+#endif
+            {
+                __HAL_UART_ENABLE_IT(huart, UART_IT_RXNE);
+            }
         } else { // TxIrq
-            __HAL_UART_ENABLE_IT(huart, UART_IT_TXE);
+#if DEVICE_SERIAL_DMA
+            if (uart_tx_dma_enabled[obj_s->index]) {
+                // Notified from the DMA channel when a transmission completes
+                uart_tx_dma_notify[obj_s->index] = 1;
+            } else
+#endif
+            {
+                __HAL_UART_ENABLE_IT(huart, UART_IT_TXE);
+            }
         }
         NVIC_SetVector(irq_n, vector);
         NVIC_EnableIRQ(irq_n);
@@ -188,14 +229,19 @@ void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
         int all_disabled = 0;
         if (irq == RxIrq) {
             __HAL_UART_DISABLE_IT(huart, UART_IT_RXNE);
+            __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
             // Check if TxIrq is disabled too
             if (LL_LPUART_IsEnabledIT_TXE(huart->Instance) == 0) {
                 all_disabled = 1;
             }
         } else { // TxIrq
             __HAL_UART_DISABLE_IT(huart, UART_IT_TXE);
+#if DEVICE_SERIAL_DMA
+            uart_tx_dma_notify[obj_s->index] = 0;
+#endif
             // Check if RxIrq is disabled too
-            if (LL_LPUART_IsEnabledIT_RXNE(huart->Instance) == 0) {
+            if (LL_LPUART_IsEnabledIT_RXNE(huart->Instance) == 0 &&
+                    LL_LPUART_IsEnabledIT_IDLE(huart->Instance) == 0) {
                 all_disabled = 1;
             }
         }
@@ -258,6 +304,243 @@ void serial_break_set(serial_t *obj)
     HAL_LIN_SendBreak(huart);
 }
 
+#if DEVICE_SERIAL_DMA
+
+/******************************************************************************
+ * DMA RECEPTION
+ ******************************************************************************/
+
+static const DMALinkInfo *serial_get_dma_link(UARTName uart_name, const DMALinkInfo *links)
+{
+    switch (uart_name) {
+#if defined(USART1_BASE)
+        case UART_1:
+            return &links[0];
+#endif
+#if defined(USART2_BASE)
+        case UART_2:
+            return &links[1];
+#endif
+#if defined(USART3_BASE)
+        case UART_3:
+            return &links[2];
+#endif
+#if defined(UART4_BASE)
+        case UART_4:
+            return &links[3];
+#endif
+#if defined(UART5_BASE)
+        case UART_5:
+            return &links[4];
+#endif
+#if defined(LPUART1_BASE)
+        case LPUART_1:
+            return &links[5];
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static void serial_rx_dma_notify(UART_HandleTypeDef *huart)
+{
+    int id = huart - uart_handlers;
+
+    // IDLEIE doubles as the RxIrq enable while the DMA reception is active
+    if (uart_rx_dma_active[id] && serial_irq_ids[id] != 0 && __HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE)) {
+        irq_handler(serial_irq_ids[id], RxIrq);
+    }
+}
+
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+    serial_rx_dma_notify(huart);
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    serial_rx_dma_notify(huart);
+}
+
+int serial_rx_dma_start(serial_t *obj, void *buffer, size_t length)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    DMA_HandleTypeDef *hdma = &uart_rx_dma_handles[obj_s->index];
+    const DMALinkInfo *link = serial_get_dma_link(obj_s->uart, UARTRxDMALinks);
+
+    if (link == NULL || length == 0 || length > 0xFFFF || uart_rx_dma_active[obj_s->index]) {
+        return -1;
+    }
+
+    if (!stm_dma_link_alloc(link, hdma, DMA_PERIPH_TO_MEMORY, false, true,
+                            DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_CIRCULAR)) {
+        return -1;
+    }
+    __HAL_LINKDMA(huart, hdmarx, *hdma);
+
+    // Keep the RxIrq notifications enabled state across the switch
+    uint32_t notify = __HAL_UART_GET_IT_SOURCE(huart, UART_IT_RXNE);
+    __HAL_UART_DISABLE_IT(huart, UART_IT_RXNE);
+    __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_PEF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_OREF | UART_CLEAR_IDLEF);
+
+    huart->RxState = HAL_UART_STATE_READY;
+    if (HAL_UART_Receive_DMA(huart, (uint8_t *)buffer, length) != HAL_OK) {
+        huart->hdmarx = NULL;
+        stm_dma_link_free(link);
+        if (notify) {
+            __HAL_UART_ENABLE_IT(huart, UART_IT_RXNE);
+        }
+        return -1;
+    }
+
+    // Errors are cleared from uart_irq(), the DMA carries on after them
+    __HAL_UART_DISABLE_IT(huart, UART_IT_PE);
+    __HAL_UART_DISABLE_IT(huart, UART_IT_ERR);
+
+    uart_rx_dma_active[obj_s->index] = 1;
+    if (notify) {
+        __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+    }
+
+    return 0;
+}
+
+size_t serial_rx_dma_position(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+
+    if (!uart_rx_dma_active[obj_s->index]) {
+        return 0;
+    }
+
+    size_t pos = huart->RxXferSize - __HAL_DMA_GET_COUNTER(huart->hdmarx);
+    return (pos >= huart->RxXferSize) ? 0 : pos;
+}
+
+void serial_rx_dma_stop(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+
+    if (!uart_rx_dma_active[obj_s->index]) {
+        return;
+    }
+
+    // Keep the RxIrq notifications enabled state across the switch
+    uint32_t notify = __HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE);
+
+    uart_rx_dma_active[obj_s->index] = 0;
+    __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+    HAL_UART_AbortReceive(huart);
+    huart->hdmarx = NULL;
+    stm_dma_link_free(serial_get_dma_link(obj_s->uart, UARTRxDMALinks));
+
+    if (notify) {
+        __HAL_UART_ENABLE_IT(huart, UART_IT_RXNE);
+    }
+}
+
+/******************************************************************************
+ * DMA TRANSMISSION
+ ******************************************************************************/
+
+static void serial_tx_dma_complete(DMA_HandleTypeDef *hdma)
+{
+    int id = hdma - uart_tx_dma_handles;
+    UART_HandleTypeDef *huart = &uart_handlers[id];
+
+    CLEAR_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+    if (uart_tx_dma_notify[id] && serial_irq_ids[id] != 0) {
+        irq_handler(serial_irq_ids[id], TxIrq);
+    }
+}
+
+int serial_tx_dma_enable(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    DMA_HandleTypeDef *hdma = &uart_tx_dma_handles[obj_s->index];
+    const DMALinkInfo *link = serial_get_dma_link(obj_s->uart, UARTTxDMALinks);
+
+    if (uart_tx_dma_enabled[obj_s->index]) {
+        return 0;
+    }
+    if (link == NULL || !stm_dma_link_alloc(link, hdma, DMA_MEMORY_TO_PERIPH, false, true,
+                                            DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_NORMAL)) {
+        return -1;
+    }
+
+    // Keep the TxIrq notifications enabled state across the switch
+    uart_tx_dma_notify[obj_s->index] = __HAL_UART_GET_IT_SOURCE(huart, UART_IT_TXE) ? 1 : 0;
+    __HAL_UART_DISABLE_IT(huart, UART_IT_TXE);
+    uart_tx_dma_enabled[obj_s->index] = 1;
+
+    return 0;
+}
+
+int serial_tx_dma_write(serial_t *obj, const void *buffer, size_t length)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+    DMA_HandleTypeDef *hdma = &uart_tx_dma_handles[obj_s->index];
+
+    if (!uart_tx_dma_enabled[obj_s->index] || length == 0 || length > 0xFFFF || serial_tx_dma_active(obj)) {
+        return -1;
+    }
+
+    // The previous transfer completed while interrupts were masked
+    if (hdma->State != HAL_DMA_STATE_READY) {
+        HAL_DMA_Abort(hdma);
+    }
+
+    hdma->XferCpltCallback = serial_tx_dma_complete;
+    hdma->XferHalfCpltCallback = NULL;
+    hdma->XferErrorCallback = serial_tx_dma_complete;
+    hdma->XferAbortCallback = NULL;
+
+    if (HAL_DMA_Start_IT(hdma, (uint32_t)buffer, (uint32_t)&huart->Instance->TDR, length) != HAL_OK) {
+        return -1;
+    }
+    SET_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+
+    return 0;
+}
+
+int serial_tx_dma_active(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+
+    if (!uart_tx_dma_enabled[obj_s->index] || !READ_BIT(huart->Instance->CR3, USART_CR3_DMAT)) {
+        return 0;
+    }
+    // Read the channel directly so that completion is seen with interrupts masked
+    return __HAL_DMA_GET_COUNTER(&uart_tx_dma_handles[obj_s->index]) != 0;
+}
+
+void serial_tx_dma_disable(serial_t *obj)
+{
+    struct serial_s *obj_s = SERIAL_S(obj);
+    UART_HandleTypeDef *huart = &uart_handlers[obj_s->index];
+
+    if (!uart_tx_dma_enabled[obj_s->index]) {
+        return;
+    }
+
+    uart_tx_dma_enabled[obj_s->index] = 0;
+    CLEAR_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+    stm_dma_link_free(serial_get_dma_link(obj_s->uart, UARTTxDMALinks));
+
+    if (uart_tx_dma_notify[obj_s->index]) {
+        uart_tx_dma_notify[obj_s->index] = 0;
+        __HAL_UART_ENABLE_IT(huart, UART_IT_TXE);
+    }
+}
+
+#endif /* DEVICE_SERIAL_DMA */
+
 #if DEVICE_SERIAL_ASYNCH
 
 /******************************************************************************
@@ -0,0 +1,190 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2021 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_STM_DMA_INFO_H
+#define MBED_STM_DMA_INFO_H
+
+#include "cmsis.h"
+
+/* All STM32L4 parts have two DMA controllers with 7 channels each */
+#define STM_DMA_SUPPORTED        1
+#define STM_DMA_NUM_CONTROLLERS  2
+#define STM_DMA_MAX_CHANNELS     7
+
+/*
+ * On parts without DMAMUX the request map is fixed by the DMAx_CSELR registers
+ * (RM0351 "DMA1/DMA2 requests for each channel"). On STM32L4R/L4S the DMAMUX
+ * can route any request to any channel; the same channel assignment is kept so
+ * that the two families behave the same regarding channel sharing.
+ */
+#if defined(DMAMUX1)
+#define STM_DMA_REQ(cselr, dmamux) (dmamux)
+#else
+#define STM_DMA_REQ(cselr, dmamux) (cselr)
+#endif
+
+/* SPI, indexed by SPI instance number - 1 */
+static const DMALinkInfo SPITxDMALinks[] = {
+    {1, 3, STM_DMA_REQ(DMA_REQUEST_1, DMA_REQUEST_SPI1_TX)},
+#if defined(SPI2_BASE)
+    {1, 5, STM_DMA_REQ(DMA_REQUEST_1, DMA_REQUEST_SPI2_TX)},
+#else
+    {0, 0, 0},
+#endif
+    {2, 2, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_SPI3_TX)},
+};
+
+static const DMALinkInfo SPIRxDMALinks[] = {
+    {1, 2, STM_DMA_REQ(DMA_REQUEST_1, DMA_REQUEST_SPI1_RX)},
+#if defined(SPI2_BASE)
+    {1, 4, STM_DMA_REQ(DMA_REQUEST_1, DMA_REQUEST_SPI2_RX)},
+#else
+    {0, 0, 0},
+#endif
+    {2, 1, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_SPI3_RX)},
+};
+
+/* ADC, indexed by ADC instance number - 1 */
+static const DMALinkInfo ADCDMALinks[] = {
+    {1, 1, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_ADC1)},
+#if defined(ADC2)
+    {1, 2, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_ADC2)},
+#endif
+#if defined(ADC3)
+    {1, 3, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_ADC3)},
+#endif
+};
+
+/* I2C, indexed by I2C instance number - 1 */
+static const DMALinkInfo I2CTxDMALinks[] = {
+    {1, 6, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C1_TX)},
+#if defined(I2C2_BASE)
+    {1, 4, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C2_TX)},
+#else
+    {0, 0, 0},
+#endif
+    {1, 2, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C3_TX)},
+#if defined(I2C4_BASE)
+    {2, 2, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_I2C4_TX)},
+#endif
+};
+
+static const DMALinkInfo I2CRxDMALinks[] = {
+    {1, 7, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C1_RX)},
+#if defined(I2C2_BASE)
+    {1, 5, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C2_RX)},
+#else
+    {0, 0, 0},
+#endif
+    {1, 3, STM_DMA_REQ(DMA_REQUEST_3, DMA_REQUEST_I2C3_RX)},
+#if defined(I2C4_BASE)
+    {2, 1, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_I2C4_RX)},
+#endif
+};
+
+/* U(S)ART, in order USART1, USART2, USART3, UART4, UART5, LPUART1 */
+static const DMALinkInfo UARTRxDMALinks[] = {
+    {1, 5, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART1_RX)},
+    {1, 6, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART2_RX)},
+    {1, 3, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART3_RX)},
+    {2, 5, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_UART4_RX)},
+    {2, 2, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_UART5_RX)},
+    {2, 7, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_LPUART1_RX)},
+};
+
+static const DMALinkInfo UARTTxDMALinks[] = {
+    {1, 4, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART1_TX)},
+    {1, 7, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART2_TX)},
+    {1, 2, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_USART3_TX)},
+    {2, 3, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_UART4_TX)},
+    {2, 1, STM_DMA_REQ(DMA_REQUEST_2, DMA_REQUEST_UART5_TX)},
+    {2, 6, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_LPUART1_TX)},
+};
+
+/* Timer capture/compare channels 1 to 4, in order TIM1, TIM2, TIM3, TIM4, TIM5, TIM8, TIM15, TIM16, TIM17 */
+static const DMALinkInfo TIMCaptureDMALinks[][4] = {
+    {
+        {1, 2, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM1_CH1)},
+        {1, 3, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM1_CH2)},
+        {1, 7, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM1_CH3)},
+        {1, 4, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM1_CH4)},
+    },
+    {
+        {1, 5, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM2_CH1)},
+        {1, 7, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM2_CH2)},
+        {1, 1, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM2_CH3)},
+        {1, 7, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM2_CH4)},
+    },
+    {
+        {1, 6, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM3_CH1)},
+        {0, 0, 0},
+        {1, 2, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM3_CH3)},
+        {1, 3, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM3_CH4)},
+    },
+    {
+        {1, 1, STM_DMA_REQ(DMA_REQUEST_6, DMA_REQUEST_TIM4_CH1)},
+        {1, 4, STM_DMA_REQ(DMA_REQUEST_6, DMA_REQUEST_TIM4_CH2)},
+        {1, 5, STM_DMA_REQ(DMA_REQUEST_6, DMA_REQUEST_TIM4_CH3)},
+        {0, 0, 0},
+    },
+    {
+        {2, 5, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM5_CH1)},
+        {2, 4, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM5_CH2)},
+        {2, 2, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM5_CH3)},
+        {2, 1, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM5_CH4)},
+    },
+    {
+        {2, 6, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM8_CH1)},
+        {2, 7, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM8_CH2)},
+        {2, 1, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM8_CH3)},
+        {2, 2, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM8_CH4)},
+    },
+    {
+        {1, 5, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM15_CH1)},
+        {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+    },
+    {
+        {1, 3, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM16_CH1)},
+        {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+    },
+    {
+        {1, 1, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM17_CH1)},
+        {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+    },
+};
+
+/* Timer update events, in the order of TIMCaptureDMALinks */
+static const DMALinkInfo TIMUpdateDMALinks[] = {
+    {1, 6, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM1_UP)},
+    {1, 2, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM2_UP)},
+    {1, 3, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM3_UP)},
+    {1, 7, STM_DMA_REQ(DMA_REQUEST_6, DMA_REQUEST_TIM4_UP)},
+    {2, 2, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM5_UP)},
+    {2, 1, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM8_UP)},
+    {1, 5, STM_DMA_REQ(DMA_REQUEST_7, DMA_REQUEST_TIM15_UP)},
+    {1, 6, STM_DMA_REQ(DMA_REQUEST_4, DMA_REQUEST_TIM16_UP)},
+    {1, 7, STM_DMA_REQ(DMA_REQUEST_5, DMA_REQUEST_TIM17_UP)},
+};
+
+#if defined(QUADSPI)
+/* QUADSPI, one channel for both directions */
+static const DMALinkInfo QSPIDMALink = {2, 7, DMA_REQUEST_3};
+#endif
+
+/* CRC unit fed memory to memory, on the channel left free by the requests above */
+static const DMALinkInfo CRCDMALink = {2, 4, STM_DMA_REQ(DMA_REQUEST_0, DMA_REQUEST_MEM2MEM)};
+
+#endif
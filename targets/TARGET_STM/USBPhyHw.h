@@ -97,6 +97,11 @@ public:
 
     uint8_t epComplete[2 * NB_ENDPOINT];
     PCD_HandleTypeDef hpcd;
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+    // Next free packet memory address, and endpoints holding buffers
+    uint16_t pma_next;
+    uint16_t pma_endpoints;
+#endif
 
 private:
 
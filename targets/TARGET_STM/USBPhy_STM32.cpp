@@ -39,6 +39,22 @@ static const uint32_t tx_ep_sizes[NUM_ENDPOINTS] = {
     MAX_PACKET_SIZE_ISO
 };
 
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+/*  Packet memory: the buffer descriptor table of the NB_ENDPOINT endpoints,
+ *  then endpoint 0, then the buffers of the other endpoints, allocated as
+ *  they are added */
+#define PMA_SIZE            1024
+#define PMA_EP0_OUT_ADDR    (NB_ENDPOINT * 8)
+#define PMA_EP0_IN_ADDR     (PMA_EP0_OUT_ADDR + MAX_PACKET_SIZE_EP0)
+#define PMA_EP_BASE         (PMA_EP0_IN_ADDR + MAX_PACKET_SIZE_EP0)
+
+static uint32_t pma_buffer_size(uint32_t max_packet)
+{
+    // The reception counters have a 32 byte granularity above 62 bytes
+    return (max_packet > 62) ? (max_packet + 31) & ~31U : (max_packet + 1) & ~1U;
+}
+#endif
+
 #if (MBED_CONF_TARGET_USB_SPEED != USE_USB_NO_OTG)
 uint32_t HAL_PCDEx_GetTxFiFo(PCD_HandleTypeDef *hpcd, uint8_t fifo)
 {
@@ -147,6 +163,10 @@ void HAL_PCD_ResetCallback(PCD_HandleTypeDef *hpcd)
         HAL_PCD_EP_Flush(hpcd, IDX_TO_EP(2 * i + 1));
 
     }
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+    obj->pma_next = PMA_EP_BASE;
+    obj->pma_endpoints = 0;
+#endif
     obj->endpoint_add(0x80, MAX_PACKET_SIZE_EP0, USB_EP_TYPE_CTRL);
     obj->endpoint_add(0x00, MAX_PACKET_SIZE_EP0, USB_EP_TYPE_CTRL);
     obj->events->reset();
@@ -282,32 +302,10 @@ void USBPhyHw::init(USBPhyEvents *events)
     // Configure FIFOs
 #if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
 
-    // EP0
-#define PMA_EP0_OUT_ADDR    (8 * 4)
-#define PMA_EP0_IN_ADDR     (PMA_EP0_OUT_ADDR + MAX_PACKET_SIZE_EP0)
     HAL_PCDEx_PMAConfig(&hpcd, LOG_OUT_TO_EP(0), PCD_SNG_BUF, PMA_EP0_OUT_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
     HAL_PCDEx_PMAConfig(&hpcd, LOG_IN_TO_EP(0),  PCD_SNG_BUF, PMA_EP0_IN_ADDR);   // HAL_PCDEx_PMAConfig always returns HAL_OK
-    // EP1
-#define PMA_EP1_OUT_BASE    (PMA_EP0_IN_ADDR + MAX_PACKET_SIZE_EP0)
-#define PMA_EP1_OUT_ADDR   ((PMA_EP1_OUT_BASE + MAX_PACKET_SIZE_NON_ISO) | (PMA_EP1_OUT_BASE << 16U))
-#define PMA_EP1_IN_ADDR     (PMA_EP1_OUT_BASE + MAX_PACKET_SIZE_NON_ISO)
-#define PMA_EP1_CMD_ADDR    (PMA_EP1_IN_ADDR + MAX_PACKET_SIZE_NON_ISO)
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_OUT_TO_EP(1), PCD_SNG_BUF, PMA_EP1_OUT_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_IN_TO_EP(1),  PCD_SNG_BUF, PMA_EP1_CMD_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
-    // EP2
-#define PMA_EP2_OUT_BASE    (PMA_EP1_IN_ADDR + MAX_PACKET_SIZE_NON_ISO)
-#define PMA_EP2_OUT_ADDR   ((PMA_EP2_OUT_BASE + MAX_PACKET_SIZE_NON_ISO) | (PMA_EP2_OUT_BASE << 16U))
-#define PMA_EP2_IN_ADDR     (PMA_EP2_OUT_BASE + MAX_PACKET_SIZE_NON_ISO)
-#define PMA_EP2_CMD_ADDR    (PMA_EP2_IN_ADDR + MAX_PACKET_SIZE_NON_ISO)
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_OUT_TO_EP(2), PCD_SNG_BUF, PMA_EP2_OUT_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_IN_TO_EP(2),  PCD_SNG_BUF, PMA_EP2_CMD_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
-    // EP3
-#define PMA_EP3_OUT_BASE    (PMA_EP2_IN_ADDR + MAX_PACKET_SIZE_NON_ISO)
-#define PMA_EP3_OUT_ADDR   ((PMA_EP3_OUT_BASE + MAX_PACKET_SIZE_ISO) | (PMA_EP3_OUT_BASE << 16U))
-#define PMA_EP3_IN_ADDR     (PMA_EP3_OUT_BASE + MAX_PACKET_SIZE_ISO)
-#define PMA_EP3_CMD_ADDR    (PMA_EP3_IN_ADDR + MAX_PACKET_SIZE_ISO)
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_OUT_TO_EP(3), PCD_SNG_BUF, PMA_EP3_OUT_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
-    HAL_PCDEx_PMAConfig(&hpcd, LOG_IN_TO_EP(3),  PCD_SNG_BUF, PMA_EP3_CMD_ADDR);  // HAL_PCDEx_PMAConfig always returns HAL_OK
+    pma_next = PMA_EP_BASE;
+    pma_endpoints = 0;
 
 #else
     uint32_t total_bytes = 0;
@@ -419,6 +417,32 @@ void USBPhyHw::remote_wakeup()
 
 const usb_ep_table_t *USBPhyHw::endpoint_table()
 {
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+    /*  Isochronous endpoints take both buffers of their endpoint number, for
+     *  one direction, so the next packet is transferred while the class
+     *  handles the previous one */
+    static const usb_ep_table_t table = {
+        PMA_SIZE - PMA_EP_BASE,
+        {
+            {USB_EP_ATTR_ALLOW_CTRL                         | USB_EP_ATTR_DIR_IN_AND_OUT, 0, 0},
+            {USB_EP_ATTR_ALLOW_BULK | USB_EP_ATTR_ALLOW_INT | USB_EP_ATTR_DIR_IN_AND_OUT, 0, 1},
+            {USB_EP_ATTR_ALLOW_BULK | USB_EP_ATTR_ALLOW_INT | USB_EP_ATTR_DIR_IN_AND_OUT, 0, 1},
+            {USB_EP_ATTR_ALLOW_ALL                          | USB_EP_ATTR_DIR_IN_OR_OUT,  0, 2},
+            {USB_EP_ATTR_ALLOW_ALL                          | USB_EP_ATTR_DIR_IN_OR_OUT,  0, 2},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0},
+            {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0}
+        }
+    };
+#else
     static const usb_ep_table_t table = {
         1280, // 1.25K for endpoint buffers but space is allocated up front
         {
@@ -440,6 +464,7 @@ const usb_ep_table_t *USBPhyHw::endpoint_table()
             {0                     | USB_EP_ATTR_DIR_IN_AND_OUT,  0, 0}
         }
     };
+#endif
     return &table;
 }
 
@@ -499,6 +524,27 @@ bool USBPhyHw::endpoint_add(usb_ep_t endpoint, uint32_t max_packet, usb_ep_type_
         len = HAL_PCDEx_GetTxFiFo(&hpcd, endpoint & 0x7f);
         MBED_ASSERT(len >= max_packet);
     }
+#else
+    if (EP_TO_LOG(endpoint) != 0) {
+        uint32_t size = pma_buffer_size(max_packet);
+        uint32_t bit = 1 << EP_TO_IDX(endpoint);
+
+        if (type == USB_EP_TYPE_ISO) {
+            if (pma_next + 2 * size > PMA_SIZE) {
+                return false;
+            }
+            HAL_PCDEx_PMAConfig(&hpcd, endpoint, PCD_DBL_BUF, pma_next | ((pma_next + size) << 16));
+            size *= 2;
+        } else {
+            if (pma_next + size > PMA_SIZE) {
+                return false;
+            }
+            HAL_PCDEx_PMAConfig(&hpcd, endpoint, PCD_SNG_BUF, pma_next);
+        }
+        // Buffers are reclaimed once all the endpoints are removed
+        pma_next += size;
+        pma_endpoints |= bit;
+    }
 #endif
 
     HAL_StatusTypeDef ret = HAL_PCD_EP_Open(&hpcd, endpoint, max_packet, type);
@@ -510,6 +556,12 @@ void USBPhyHw::endpoint_remove(usb_ep_t endpoint)
 {
     HAL_StatusTypeDef ret = HAL_PCD_EP_Close(&hpcd, endpoint);
     MBED_ASSERT(ret == HAL_OK);
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+    pma_endpoints &= ~(1 << EP_TO_IDX(endpoint));
+    if (pma_endpoints == 0) {
+        pma_next = PMA_EP_BASE;
+    }
+#endif
 }
 
 void USBPhyHw::endpoint_stall(usb_ep_t endpoint)
@@ -1131,6 +1131,85 @@ int can_filter(can_t *obj, uint32_t id, uint32_t mask, CANFormat format, int32_t
     return success;
 }
 
+int can_filter_count(can_t *obj)
+{
+    // Banks shared by CAN1 and CAN2 on dual CAN devices
+#if defined(CAN2)
+    return 28;
+#else
+    return 14;
+#endif
+}
+
+/*  In list mode a bank holds two identifiers at 32-bit scale, or four
+ *  standard identifiers at 16-bit scale. The identifiers match data frames. */
+int can_filter_list(can_t *obj, const uint32_t *ids, int count, CANFormat format, int32_t handle)
+{
+    int per_bank = (format == CANStandard) ? 4 : 2;
+    int banks = (count + per_bank - 1) / per_bank;
+
+    if ((format != CANStandard && format != CANExtended) || count <= 0 ||
+            handle < 0 || handle + banks > can_filter_count(obj)) {
+        return 0;
+    }
+
+    for (int bank = 0; bank < banks; bank++) {
+        CAN_FilterConfTypeDef sFilterConfig;
+        uint32_t fr[4];
+
+        for (int i = 0; i < per_bank; i++) {
+            // The last identifier fills the unused entries of the last bank
+            int index = bank * per_bank + i;
+            uint32_t id = ids[(index < count) ? index : count - 1];
+            if (format == CANStandard) {
+                fr[i] = (id & 0x7FF) << 5;
+            } else {
+                fr[2 * i] = (id & 0x1FFFFFFF) >> 13; // EXTID[28:13]
+                fr[2 * i + 1] = (0xFFFF & (id << 3)) | (1 << 2); // EXTID[12:0] + IDE
+            }
+        }
+
+        sFilterConfig.FilterNumber = handle + bank;
+        sFilterConfig.FilterMode = CAN_FILTERMODE_IDLIST;
+        if (format == CANStandard) {
+            sFilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+            sFilterConfig.FilterIdLow = fr[0];
+            sFilterConfig.FilterMaskIdLow = fr[1];
+            sFilterConfig.FilterIdHigh = fr[2];
+            sFilterConfig.FilterMaskIdHigh = fr[3];
+        } else {
+            sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+            sFilterConfig.FilterIdHigh = fr[0];
+            sFilterConfig.FilterIdLow = fr[1];
+            sFilterConfig.FilterMaskIdHigh = fr[2];
+            sFilterConfig.FilterMaskIdLow = fr[3];
+        }
+        sFilterConfig.FilterFIFOAssignment = 0;
+        sFilterConfig.FilterActivation = ENABLE;
+        sFilterConfig.BankNumber = 14;
+
+        if (HAL_CAN_ConfigFilter(&obj->CanHandle, &sFilterConfig) != HAL_OK) {
+            return 0;
+        }
+    }
+
+    return banks;
+}
+
+int can_filter_disable(can_t *obj, int32_t handle)
+{
+    if (handle < 0 || handle >= can_filter_count(obj)) {
+        return 0;
+    }
+
+    // Filter banks are only in CAN1, as in HAL_CAN_ConfigFilter()
+    CAN1->FMR |= CAN_FMR_FINIT;
+    CAN1->FA1R &= ~(1UL << handle);
+    CAN1->FMR &= ~CAN_FMR_FINIT;
+
+    return 1;
+}
+
 static void can_irq(CANName name, int id)
 {
     uint32_t tmp1 = 0, tmp2 = 0, tmp3 = 0;
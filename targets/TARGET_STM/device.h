@@ -37,4 +37,9 @@
 
 #include "objects.h"
 
+#if defined(TARGET_STM32L4) && DEVICE_USTICKER
+/* us ticker rate and width, for the inline reads of us_ticker_api.h */
+#include "us_ticker_defines.h"
+#endif
+
 #endif
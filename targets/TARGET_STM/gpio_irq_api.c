@@ -50,10 +50,9 @@ typedef struct gpio_channel {
     uint32_t channel_ids[MAX_PIN_LINE];  // mbed "gpio_irq_t gpio_irq" field of instance
     GPIO_TypeDef *channel_gpio[MAX_PIN_LINE]; // base address of gpio port group
     uint32_t channel_pin[MAX_PIN_LINE];  // pin number in port group
+    gpio_irq_handler channel_handlers[MAX_PIN_LINE]; // handler given to gpio_irq_init
 } gpio_channel_t;
 
-static gpio_irq_handler irq_handler;
-
 static gpio_channel_t channels[CHANNEL_NUM] = {
 #ifdef EXTI_IRQ0_NUM_LINES
     {.pin_mask = 0},
@@ -128,9 +127,7 @@ static void handle_interrupt_in(uint32_t irq_index, uint32_t max_num_pin_line)
                 }
 
                 gpio_irq_event event = IRQ_RISE;
-                irq_handler(gpio_channel->channel_ids[gpio_idx], event);
-
-                return;
+                gpio_channel->channel_handlers[gpio_idx](gpio_channel->channel_ids[gpio_idx], event);
             }
 
             if (LL_EXTI_IsActiveFallingFlag_0_31(pin) != RESET) {
@@ -141,9 +138,7 @@ static void handle_interrupt_in(uint32_t irq_index, uint32_t max_num_pin_line)
                 }
 
                 gpio_irq_event event = IRQ_FALL;
-                irq_handler(gpio_channel->channel_ids[gpio_idx], event);
-
-                return;
+                gpio_channel->channel_handlers[gpio_idx](gpio_channel->channel_ids[gpio_idx], event);
             }
 
 #else /* TARGET_STM32L5 */
@@ -178,14 +173,15 @@ static void handle_interrupt_in(uint32_t irq_index, uint32_t max_num_pin_line)
                     }
                 }
 
-                irq_handler(gpio_channel->channel_ids[gpio_idx], event);
-
-                return;
+                gpio_channel->channel_handlers[gpio_idx](gpio_channel->channel_ids[gpio_idx], event);
             }
 #endif /* TARGET_STM32L5 */
         }
     }
-    error("Unexpected Spurious interrupt index %" PRIu32 "\n", irq_index);
+    // All the lines pending are served in one pass, so the lines sharing this
+    // IRQ do not each take an exception entry. An edge served here after the
+    // IRQ was latched again leaves it pending without any line flagged, so an
+    // entry finding no flag is not an error.
 }
 
 
@@ -428,8 +424,9 @@ int gpio_irq_init(gpio_irq_t *obj, PinName pin, gpio_irq_handler handler, uint32
     gpio_channel->channel_ids[gpio_idx] = id;
     gpio_channel->channel_gpio[gpio_idx] = gpio_add;
     gpio_channel->channel_pin[gpio_idx] = pin_index;
-
-    irq_handler = handler;
+    // Each line has its own handler: HAL drivers, such as the SPI slave
+    // DMA framing, share the EXTI lines with InterruptIn
+    gpio_channel->channel_handlers[gpio_idx] = handler;
 
     // Enable EXTI interrupt
     NVIC_SetVector(obj->irq_n, vector);
@@ -452,6 +449,7 @@ void gpio_irq_free(gpio_irq_t *obj)
     gpio_channel->channel_ids[gpio_idx] = 0;
     gpio_channel->channel_gpio[gpio_idx] = 0;
     gpio_channel->channel_pin[gpio_idx] = 0;
+    gpio_channel->channel_handlers[gpio_idx] = 0;
 
     core_util_critical_section_exit();
 }
@@ -87,6 +87,37 @@ static inline int gpio_is_connected(const gpio_t *obj)
     return obj->pin != (PinName)NC;
 }
 
+#if GPIO_FAST_READY && !defined(DUAL_CORE)
+/*
+ * Fast GPIO, see hal/gpio_fast_api.h: with a constant pin or port the
+ * register address and the mask are folded at compile time, leaving a
+ * single BSRR write or IDR read. Families defining GPIO_FAST_READY have
+ * their GPIO ports evenly spaced from GPIOA and a BSRR register.
+ */
+#define GPIO_FAST_PORT(port) ((GPIO_TypeDef *)(GPIOA_BASE + (uint32_t)(port) * (GPIOB_BASE - GPIOA_BASE)))
+
+static inline void gpio_fast_write(PinName pin, int value)
+{
+    GPIO_FAST_PORT(STM_PORT(pin))->BSRR = value ? (1U << STM_PIN(pin)) : (1U << (STM_PIN(pin) + 16));
+}
+
+static inline int gpio_fast_read(PinName pin)
+{
+    return (GPIO_FAST_PORT(STM_PORT(pin))->IDR >> STM_PIN(pin)) & 1;
+}
+
+static inline void port_fast_write(PortName port, uint32_t mask, uint32_t value)
+{
+    mask &= 0xFFFF;
+    GPIO_FAST_PORT(port)->BSRR = (value & mask) | ((~value & mask) << 16);
+}
+
+static inline uint32_t port_fast_read(PortName port, uint32_t mask)
+{
+    return GPIO_FAST_PORT(port)->IDR & mask;
+}
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -41,6 +41,7 @@
 #include "PeripheralPins.h"
 #include "i2c_device.h" // family specific defines
 #include "mbed_error.h"
+#include "stm_dma_utils.h"
 
 #ifndef DEBUG_STDIO
 #   define DEBUG_STDIO 0
@@ -81,14 +82,31 @@ static I2C_HandleTypeDef *i2c_handles[I2C_NUM];
 */
 #define FLAG_TIMEOUT ((int)0x1000)
 
+/* With DMA_USAGE_OPPORTUNISTIC, shorter transfers are not worth the DMA setup cost */
+#ifndef I2C_DMA_OPPORTUNISTIC_MIN_LENGTH
+#define I2C_DMA_OPPORTUNISTIC_MIN_LENGTH 8
+#endif
+
 /* Declare i2c_init_internal to be used in this file */
 void i2c_init_internal(i2c_t *obj, const i2c_pinmap_t *pinmap);
 
+#if DEVICE_I2CSLAVE_REGMAP
+/* Instances serving a register map, their interrupts bypass the HAL driver */
+static struct i2c_s *i2c_regmaps[I2C_NUM];
+static void i2c_regmap_irq(struct i2c_s *obj_s);
+#endif
+
 /* GENERIC INIT and HELPERS FUNCTIONS */
 
 #if defined(I2C1_BASE)
 static void i2c1_irq(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    if (i2c_regmaps[0]) {
+        i2c_regmap_irq(i2c_regmaps[0]);
+        return;
+    }
+#endif
     I2C_HandleTypeDef *handle = i2c_handles[0];
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
@@ -97,6 +115,12 @@ static void i2c1_irq(void)
 #if defined(I2C2_BASE)
 static void i2c2_irq(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    if (i2c_regmaps[1]) {
+        i2c_regmap_irq(i2c_regmaps[1]);
+        return;
+    }
+#endif
     I2C_HandleTypeDef *handle = i2c_handles[1];
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
@@ -105,6 +129,12 @@ static void i2c2_irq(void)
 #if defined(I2C3_BASE)
 static void i2c3_irq(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    if (i2c_regmaps[2]) {
+        i2c_regmap_irq(i2c_regmaps[2]);
+        return;
+    }
+#endif
     I2C_HandleTypeDef *handle = i2c_handles[2];
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
@@ -113,6 +143,12 @@ static void i2c3_irq(void)
 #if defined(I2C4_BASE)
 static void i2c4_irq(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    if (i2c_regmaps[3]) {
+        i2c_regmap_irq(i2c_regmaps[3]);
+        return;
+    }
+#endif
     I2C_HandleTypeDef *handle = i2c_handles[3];
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
@@ -121,6 +157,12 @@ static void i2c4_irq(void)
 #if defined(FMPI2C1_BASE)
 static void i2c5_irq(void)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    if (i2c_regmaps[4]) {
+        i2c_regmap_irq(i2c_regmaps[4]);
+        return;
+    }
+#endif
     I2C_HandleTypeDef *handle = i2c_handles[4];
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
@@ -284,6 +326,9 @@ void i2c_init_internal(i2c_t *obj, const i2c_pinmap_t *pinmap)
 #endif
         obj_s->i2c = (I2CName)pinmap->peripheral;
         MBED_ASSERT(obj_s->i2c != (I2CName)NC);
+#if DEVICE_I2CSLAVE_REGMAP
+        obj_s->regmap = NULL;
+#endif
     }
 
 #if defined I2C1_BASE
@@ -438,8 +483,18 @@ void i2c_init(i2c_t *obj, PinName sda, PinName scl)
     I2C_INIT_DIRECT(obj, &explicit_i2c_pinmap);
 }
 
+#if DEVICE_I2C_ASYNCH && STM_DMA_SUPPORTED
+static void i2c_dma_free(i2c_t *obj);
+#endif
+
 void i2c_free(i2c_t *obj)
 {
+#if DEVICE_I2CSLAVE_REGMAP
+    i2c_slave_regmap_stop(obj);
+#endif
+#if DEVICE_I2C_ASYNCH && STM_DMA_SUPPORTED
+    i2c_dma_free(obj);
+#endif
     i2c_deinit_internal(obj);
 }
 
@@ -992,6 +1047,133 @@ int i2c_write(i2c_t *obj, int address, const char *data, int length, int stop)
     return count;
 }
 
+#if DEVICE_I2C_ASYNCH
+#if STM_DMA_SUPPORTED
+/// Allocate the TX and RX DMA channels of this I2C instance
+/// @returns true if both channels are now owned by this object
+static bool i2c_dma_allocate(i2c_t *obj)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+    I2C_HandleTypeDef *handle = &(obj_s->handle);
+    int index = obj_s->index;
+    const int links = sizeof(I2CTxDMALinks) / sizeof(I2CTxDMALinks[0]);
+
+    if (obj_s->dma_allocated) {
+        return true;
+    }
+
+    // a write then read job switches direction from the interrupt, so both channels are needed
+    if (index >= links || I2CTxDMALinks[index].dma_idx == 0 || I2CRxDMALinks[index].dma_idx == 0) {
+        return false;
+    }
+
+    if (!stm_dma_link_alloc(&I2CTxDMALinks[index], &obj_s->dma_tx_handle, DMA_MEMORY_TO_PERIPH,
+                            false, true, DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_NORMAL)) {
+        return false;
+    }
+    if (!stm_dma_link_alloc(&I2CRxDMALinks[index], &obj_s->dma_rx_handle, DMA_PERIPH_TO_MEMORY,
+                            false, true, DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_NORMAL)) {
+        stm_dma_link_free(&I2CTxDMALinks[index]);
+        return false;
+    }
+
+    __HAL_LINKDMA(handle, hdmatx, obj_s->dma_tx_handle);
+    __HAL_LINKDMA(handle, hdmarx, obj_s->dma_rx_handle);
+    obj_s->dma_allocated = 1;
+
+    DEBUG_PRINTF("I2C index=%d DMA allocated\r\n", obj_s->index);
+    return true;
+}
+
+static void i2c_dma_free(i2c_t *obj)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+    I2C_HandleTypeDef *handle = &(obj_s->handle);
+
+    if (!obj_s->dma_allocated) {
+        return;
+    }
+
+    stm_dma_link_free(&I2CTxDMALinks[obj_s->index]);
+    stm_dma_link_free(&I2CRxDMALinks[obj_s->index]);
+    handle->hdmatx = NULL;
+    handle->hdmarx = NULL;
+    obj_s->dma_allocated = 0;
+    obj_s->dma_active = 0;
+}
+
+/// Decide whether the next transfer goes through DMA, allocating the channels if needed
+static bool i2c_dma_prepare(i2c_t *obj, DMAUsage hint, size_t length, uint32_t handler)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+
+    switch (hint) {
+        case DMA_USAGE_OPPORTUNISTIC:
+            if (length < I2C_DMA_OPPORTUNISTIC_MIN_LENGTH) {
+                return false;
+            }
+            break;
+        case DMA_USAGE_TEMPORARY_ALLOCATED:
+        case DMA_USAGE_ALWAYS:
+        case DMA_USAGE_ALLOCATED:
+            break;
+        case DMA_USAGE_NEVER:
+        default:
+            // a previous hint may have left the channels allocated
+            i2c_dma_free(obj);
+            return false;
+    }
+
+    if (!i2c_dma_allocate(obj)) {
+        // no free channel: fall back to the interrupt driven transfer
+        return false;
+    }
+    obj_s->dma_usage = hint;
+
+    // DMA completion is processed in the same thunk as the I2C interrupts
+    stm_dma_link_set_vector(&I2CTxDMALinks[obj_s->index], handler, 2);
+    stm_dma_link_set_vector(&I2CRxDMALinks[obj_s->index], handler, 2);
+
+    return true;
+}
+
+/// Release the channels after a transfer unless the hint asked to keep them
+static void i2c_dma_release(i2c_t *obj)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+
+    obj_s->dma_active = 0;
+    if (obj_s->dma_usage == DMA_USAGE_OPPORTUNISTIC ||
+            obj_s->dma_usage == DMA_USAGE_TEMPORARY_ALLOCATED) {
+        i2c_dma_free(obj);
+    }
+}
+#endif // STM_DMA_SUPPORTED
+
+/// Start one step of an asynchronous transfer, through DMA when i2c_dma_prepare() allowed it
+static void i2c_master_seq_transmit(struct i2c_s *obj_s, uint16_t address, uint8_t *data, uint16_t length, uint32_t option)
+{
+#if STM_DMA_SUPPORTED
+    if (obj_s->dma_active) {
+        HAL_I2C_Master_Seq_Transmit_DMA(&(obj_s->handle), address, data, length, option);
+        return;
+    }
+#endif
+    HAL_I2C_Master_Sequential_Transmit_IT(&(obj_s->handle), address, data, length, option);
+}
+
+static void i2c_master_seq_receive(struct i2c_s *obj_s, uint16_t address, uint8_t *data, uint16_t length, uint32_t option)
+{
+#if STM_DMA_SUPPORTED
+    if (obj_s->dma_active) {
+        HAL_I2C_Master_Seq_Receive_DMA(&(obj_s->handle), address, data, length, option);
+        return;
+    }
+#endif
+    HAL_I2C_Master_Sequential_Receive_IT(&(obj_s->handle), address, data, length, option);
+}
+#endif // DEVICE_I2C_ASYNCH
+
 void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
 {
     /* Get object ptr based on handler ptr */
@@ -1015,7 +1197,8 @@ void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
         }
 #endif
 
-        HAL_I2C_Master_Sequential_Receive_IT(hi2c, obj_s->address, (uint8_t *)obj->rx_buff.buffer, obj->rx_buff.length, obj_s->XferOperation);
+        /* Repeated start from the interrupt, the write then read is a single job */
+        i2c_master_seq_receive(obj_s, obj_s->address, (uint8_t *)obj->rx_buff.buffer, obj->rx_buff.length, obj_s->XferOperation);
     } else
 #endif
     {
@@ -1230,6 +1413,221 @@ int i2c_slave_write(i2c_t *obj, const char *data, int length)
 
     return count;
 }
+
+#if DEVICE_I2CSLAVE_REGMAP
+
+#if !defined(I2C_IP_VERSION_V2) || !STM_DMA_SUPPORTED
+#error "DEVICE_I2CSLAVE_REGMAP needs the I2C v2 peripheral and the DMA channel tables of stm_dma_info.h"
+#endif
+
+#define REGMAP_IDLE       0
+#define REGMAP_POINTER    1 // master writes, the register pointer comes first
+#define REGMAP_WRITE      2 // master writes registers
+#define REGMAP_READ       3 // master reads registers
+
+#define REGMAP_IT (I2C_CR1_ADDRIE | I2C_CR1_STOPIE | I2C_CR1_ERRIE)
+
+/// TX DMA transfer complete: the master reads past the end of the map, the
+/// interrupt goes on with 0xFF
+static void i2c_regmap_dma_done(DMA_HandleTypeDef *hdma)
+{
+    struct i2c_s *obj_s = (struct i2c_s *)hdma->Parent;
+    I2C_TypeDef *i2c = obj_s->handle.Instance;
+
+    CLEAR_BIT(i2c->CR1, I2C_CR1_TXDMAEN);
+    SET_BIT(i2c->CR1, I2C_CR1_TXIE);
+}
+
+/// End of a transfer, on a stop, a repeated start or an error
+static void i2c_regmap_end(struct i2c_s *obj_s)
+{
+    I2C_TypeDef *i2c = obj_s->handle.Instance;
+
+    CLEAR_BIT(i2c->CR1, I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_TXDMAEN);
+
+    if (obj_s->regmap_state == REGMAP_WRITE && obj_s->regmap_count && obj_s->regmap_handler) {
+        obj_s->regmap_handler(obj_s->regmap_id, obj_s->regmap_start, obj_s->regmap_count);
+    } else if (obj_s->regmap_state == REGMAP_READ) {
+        uint32_t loaded = obj_s->regmap_count;
+        if (obj_s->regmap_dma_length) {
+            loaded += obj_s->regmap_dma_length - __HAL_DMA_GET_COUNTER(&obj_s->dma_tx_handle);
+            HAL_DMA_Abort(&obj_s->dma_tx_handle);
+        }
+        // The byte loaded last is still in TXDR when the master NACKed the previous one
+        if (loaded && !(i2c->ISR & I2C_ISR_TXE)) {
+            loaded--;
+        }
+        obj_s->regmap_ptr = obj_s->regmap_start + loaded;
+        if (obj_s->regmap_ptr > obj_s->regmap_size) {
+            obj_s->regmap_ptr = obj_s->regmap_size;
+        }
+        // Flush TXDR for the next read
+        i2c->ISR |= I2C_ISR_TXE;
+    }
+
+    obj_s->regmap_state = REGMAP_IDLE;
+}
+
+/// Start of a transfer, on the address match
+static void i2c_regmap_begin(struct i2c_s *obj_s, bool read)
+{
+    I2C_TypeDef *i2c = obj_s->handle.Instance;
+
+    obj_s->regmap_start = obj_s->regmap_ptr;
+    obj_s->regmap_count = 0;
+    obj_s->regmap_dma_length = 0;
+
+    if (!read) {
+        obj_s->regmap_state = REGMAP_POINTER;
+        SET_BIT(i2c->CR1, I2C_CR1_RXIE);
+        return;
+    }
+
+    obj_s->regmap_state = REGMAP_READ;
+    i2c->ISR |= I2C_ISR_TXE;
+    if (obj_s->regmap_dma && obj_s->regmap_ptr < obj_s->regmap_size) {
+        // The DMA loads TXDR on each TXIS, straight from the map
+        obj_s->regmap_dma_length = obj_s->regmap_size - obj_s->regmap_ptr;
+        HAL_DMA_Start_IT(&obj_s->dma_tx_handle, (uint32_t)(obj_s->regmap + obj_s->regmap_ptr),
+                         (uint32_t)&i2c->TXDR, obj_s->regmap_dma_length);
+        SET_BIT(i2c->CR1, I2C_CR1_TXDMAEN);
+    } else {
+        SET_BIT(i2c->CR1, I2C_CR1_TXIE);
+    }
+}
+
+static void i2c_regmap_irq(struct i2c_s *obj_s)
+{
+    I2C_TypeDef *i2c = obj_s->handle.Instance;
+
+    // The TX DMA channel shares this handler
+    if (obj_s->regmap_dma) {
+        HAL_DMA_IRQHandler(&obj_s->dma_tx_handle);
+    }
+
+    uint32_t isr = i2c->ISR;
+    uint32_t cr1 = i2c->CR1;
+
+    if (isr & I2C_ISR_RXNE) {
+        uint8_t data = i2c->RXDR;
+        if (obj_s->regmap_state == REGMAP_POINTER) {
+            obj_s->regmap_ptr = (data < obj_s->regmap_size) ? data : obj_s->regmap_size;
+            obj_s->regmap_start = obj_s->regmap_ptr;
+            obj_s->regmap_state = REGMAP_WRITE;
+        } else if (obj_s->regmap_state == REGMAP_WRITE && obj_s->regmap_ptr < obj_s->regmap_size) {
+            obj_s->regmap[obj_s->regmap_ptr++] = data;
+            obj_s->regmap_count++;
+        }
+    }
+
+    if ((cr1 & I2C_CR1_TXIE) && (isr & I2C_ISR_TXIS)) {
+        uint32_t reg = obj_s->regmap_start + obj_s->regmap_dma_length + obj_s->regmap_count;
+        i2c->TXDR = (reg < obj_s->regmap_size) ? obj_s->regmap[reg] : 0xFF;
+        obj_s->regmap_count++;
+    }
+
+    if (isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) {
+        i2c->ICR = I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+        i2c_regmap_end(obj_s);
+    }
+
+    if (isr & I2C_ISR_STOPF) {
+        i2c_regmap_end(obj_s);
+        i2c->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF;
+    }
+
+    if (isr & I2C_ISR_ADDR) {
+        // A repeated start ends the previous transfer, typically the write
+        // of the register pointer before a read
+        i2c_regmap_end(obj_s);
+        i2c->ICR = I2C_ICR_NACKCF;
+        i2c_regmap_begin(obj_s, (isr & I2C_ISR_DIR) != 0);
+        // Clock stretching stops here, the data is ready
+        i2c->ICR = I2C_ICR_ADDRCF;
+    }
+}
+
+int i2c_slave_regmap_start(i2c_t *obj, void *map, size_t size, i2c_slave_regmap_handler handler, uint32_t id)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+    I2C_HandleTypeDef *handle = &(obj_s->handle);
+    int index = obj_s->index;
+    const int links = sizeof(I2CTxDMALinks) / sizeof(I2CTxDMALinks[0]);
+    uint32_t irq_handler;
+
+    // The register pointer is a single byte
+    if (!obj_s->slave || obj_s->regmap || map == NULL || size == 0 || size > 256) {
+        return -1;
+    }
+
+#if DEVICE_I2C_ASYNCH
+    // Give the channels back if a previous asynchronous transfer kept them
+    i2c_dma_free(obj);
+#endif
+
+    // The HAL driver leaves its interrupts to this one
+    HAL_I2C_DisableListen_IT(handle);
+    CLEAR_BIT(handle->Instance->CR1, I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_ADDRIE | I2C_CR1_NACKIE |
+              I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_ERRIE | I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN);
+    handle->Instance->ICR = I2C_ICR_ADDRCF | I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_BERRCF |
+                            I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+
+    obj_s->regmap = (uint8_t *)map;
+    obj_s->regmap_size = size;
+    obj_s->regmap_ptr = 0;
+    obj_s->regmap_state = REGMAP_IDLE;
+    obj_s->regmap_handler = handler;
+    obj_s->regmap_id = id;
+
+    irq_handler = i2c_get_irq_handler(obj);
+
+    // Without a channel the reads are served by the interrupt
+    obj_s->regmap_dma = 0;
+    if (index < links && I2CTxDMALinks[index].dma_idx != 0 &&
+            stm_dma_link_alloc(&I2CTxDMALinks[index], &obj_s->dma_tx_handle, DMA_MEMORY_TO_PERIPH,
+                               false, true, DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_NORMAL)) {
+        obj_s->dma_tx_handle.Parent = obj_s;
+        obj_s->dma_tx_handle.XferCpltCallback = i2c_regmap_dma_done;
+        obj_s->dma_tx_handle.XferHalfCpltCallback = NULL;
+        obj_s->dma_tx_handle.XferErrorCallback = NULL;
+        obj_s->dma_tx_handle.XferAbortCallback = NULL;
+        stm_dma_link_set_vector(&I2CTxDMALinks[index], irq_handler, 1);
+        obj_s->regmap_dma = 1;
+    }
+
+    i2c_regmaps[index] = obj_s;
+    i2c_ev_err_enable(obj, irq_handler);
+    SET_BIT(handle->Instance->CR1, REGMAP_IT);
+
+    DEBUG_PRINTF("I2C index=%d register map started, DMA=%d\r\n", index, obj_s->regmap_dma);
+    return 0;
+}
+
+void i2c_slave_regmap_stop(i2c_t *obj)
+{
+    struct i2c_s *obj_s = I2C_S(obj);
+    I2C_HandleTypeDef *handle = &(obj_s->handle);
+
+    if (!obj_s->regmap) {
+        return;
+    }
+
+    CLEAR_BIT(handle->Instance->CR1, REGMAP_IT | I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_TXDMAEN);
+    if (obj_s->regmap_dma) {
+        HAL_DMA_Abort(&obj_s->dma_tx_handle);
+        stm_dma_link_free(&I2CTxDMALinks[obj_s->index]);
+        obj_s->regmap_dma = 0;
+    }
+    i2c_regmaps[obj_s->index] = NULL;
+    obj_s->regmap_handler = NULL;
+    obj_s->regmap = NULL;
+
+    // Back to the state i2c_slave_address() leaves for the polled slave functions
+    handle->Instance->ISR |= I2C_ISR_TXE;
+    HAL_I2C_EnableListen_IT(handle);
+}
+
+#endif // DEVICE_I2CSLAVE_REGMAP
 #endif // DEVICE_I2CSLAVE
 
 #if DEVICE_I2C_ASYNCH
@@ -1251,12 +1649,7 @@ void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
 
 void i2c_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint32_t address, uint32_t stop, uint32_t handler, uint32_t event, DMAUsage hint)
 {
-
-    // TODO: DMA usage is currently ignored by this way
-    (void) hint;
-
     struct i2c_s *obj_s = I2C_S(obj);
-    I2C_HandleTypeDef *handle = &(obj_s->handle);
 
     /* Update object */
     obj->tx_buff.buffer = (void *)tx;
@@ -1276,6 +1669,12 @@ void i2c_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx,
 
     i2c_ev_err_enable(obj, handler);
 
+#if STM_DMA_SUPPORTED
+    obj_s->dma_active = i2c_dma_prepare(obj, hint, tx_length + rx_length, handler);
+#else
+    (void) hint;
+#endif
+
     /* Set operation step depending if stop sending required or not */
     if ((tx_length && !rx_length) || (!tx_length && rx_length)) {
 #if defined(I2C_IP_VERSION_V1)
@@ -1309,10 +1708,10 @@ void i2c_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx,
         }
 #endif
         if (tx_length > 0) {
-            HAL_I2C_Master_Sequential_Transmit_IT(handle, address, (uint8_t *)tx, tx_length, obj_s->XferOperation);
+            i2c_master_seq_transmit(obj_s, address, (uint8_t *)tx, tx_length, obj_s->XferOperation);
         }
         if (rx_length > 0) {
-            HAL_I2C_Master_Sequential_Receive_IT(handle, address, (uint8_t *)rx, rx_length, obj_s->XferOperation);
+            i2c_master_seq_receive(obj_s, address, (uint8_t *)rx, rx_length, obj_s->XferOperation);
         }
     } else if (tx_length && rx_length) {
         /* Two steps operation, don't modify XferOperation, keep it for next step */
@@ -1321,13 +1720,13 @@ void i2c_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx,
         uint32_t op1 = I2C_FIRST_AND_LAST_FRAME;
         uint32_t op2 = I2C_LAST_FRAME;
         if ((obj_s->XferOperation == op1) || (obj_s->XferOperation == op2)) {
-            HAL_I2C_Master_Sequential_Transmit_IT(handle, address, (uint8_t *)tx, tx_length, I2C_FIRST_FRAME);
+            i2c_master_seq_transmit(obj_s, address, (uint8_t *)tx, tx_length, I2C_FIRST_FRAME);
         } else if ((obj_s->XferOperation == I2C_FIRST_FRAME) ||
                    (obj_s->XferOperation == I2C_NEXT_FRAME)) {
-            HAL_I2C_Master_Sequential_Transmit_IT(handle, address, (uint8_t *)tx, tx_length, I2C_NEXT_FRAME);
+            i2c_master_seq_transmit(obj_s, address, (uint8_t *)tx, tx_length, I2C_NEXT_FRAME);
         }
 #elif defined(I2C_IP_VERSION_V2)
-        HAL_I2C_Master_Sequential_Transmit_IT(handle, address, (uint8_t *)tx, tx_length, I2C_FIRST_FRAME);
+        i2c_master_seq_transmit(obj_s, address, (uint8_t *)tx, tx_length, I2C_FIRST_FRAME);
 #endif
     }
 }
@@ -1339,9 +1738,23 @@ uint32_t i2c_irq_handler_asynch(i2c_t *obj)
     struct i2c_s *obj_s = I2C_S(obj);
     I2C_HandleTypeDef *handle = &(obj_s->handle);
 
+#if STM_DMA_SUPPORTED
+    // DMA channel interrupts share this handler, let the HAL process them first
+    if (obj_s->dma_active) {
+        HAL_DMA_IRQHandler(&obj_s->dma_tx_handle);
+        HAL_DMA_IRQHandler(&obj_s->dma_rx_handle);
+    }
+#endif
+
     HAL_I2C_EV_IRQHandler(handle);
     HAL_I2C_ER_IRQHandler(handle);
 
+#if STM_DMA_SUPPORTED
+    if (obj_s->event && obj_s->dma_active) {
+        i2c_dma_release(obj);
+    }
+#endif
+
     /*  Return I2C event status */
     return (obj_s->event & obj_s->available_events);
 }
@@ -1369,6 +1782,14 @@ void i2c_abort_asynch(i2c_t *obj)
     uint16_t Dummy_DevAddress = 0x00;
 
     HAL_I2C_Master_Abort_IT(handle, Dummy_DevAddress);
+
+#if STM_DMA_SUPPORTED
+    if (obj_s->dma_active) {
+        HAL_DMA_Abort(&obj_s->dma_tx_handle);
+        HAL_DMA_Abort(&obj_s->dma_rx_handle);
+        i2c_dma_release(obj);
+    }
+#endif
 }
 
 #endif // DEVICE_I2C_ASYNCH
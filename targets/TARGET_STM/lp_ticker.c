@@ -54,6 +54,22 @@
  * between is unreliable */
 #define LP_TIMER_SAFE_GUARD 5
 
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+/* The 16-bit counter is extended to 32 bits in software: every read
+ * compares the counter to the previous one, and the autoreload match
+ * interrupt, once per counter period, makes sure no wrap goes unnoticed.
+ * Compare matches are only programmed for events falling before the next
+ * wrap; further ones are programmed from the autoreload match interrupt.
+ * So the ticker layer sees a 32-bit counter and doesn't have to wake up
+ * the system every 7/16th of the counter period to follow its overflows. */
+static volatile uint32_t lp_last_read = 0;
+static volatile timestamp_t lp_target = 0;
+static volatile bool lp_target_pending = false;
+static volatile bool lp_cmp_armed = false;
+
+static void lp_ticker_schedule(void);
+#endif
+
 
 #if defined(DUAL_CORE)
 #if defined(CORE_CM7)
@@ -135,7 +151,11 @@ const ticker_info_t *lp_ticker_get_info()
 #else
         LSI_VALUE / MBED_CONF_TARGET_LPTICKER_LPTIM_CLOCK,
 #endif
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+        32
+#else
         16
+#endif
     };
     return &info;
 }
@@ -153,6 +173,8 @@ volatile bool sleep_manager_locked = false;
 
 static int LPTICKER_inited = 0;
 static void LPTIM_IRQHandler(void);
+static uint32_t lp_ticker_read_cnt(void);
+static void lp_ticker_set_compare(timestamp_t timestamp);
 
 void lp_ticker_init(void)
 {
@@ -289,6 +311,9 @@ void lp_ticker_init(void)
 
     __HAL_LPTIM_ENABLE_IT(&LptimHandle, LPTIM_IT_CMPM);
     __HAL_LPTIM_ENABLE_IT(&LptimHandle, LPTIM_IT_CMPOK);
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+    __HAL_LPTIM_ENABLE_IT(&LptimHandle, LPTIM_IT_ARRM);
+#endif
     HAL_LPTIM_Counter_Start(&LptimHandle, 0xFFFF);
 
     /* Need to write a compare value in order to get LPTIM_FLAG_CMPOK in set_interrupt */
@@ -301,6 +326,12 @@ void lp_ticker_init(void)
     /* Init is called with Interrupts disabled, so the CMPOK interrupt
      * will not be handled. Let's mark it is now safe to write to LP counter */
     lp_cmpok = true;
+
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+    /* Autoreload match interrupt must run even with no event scheduled */
+    lp_last_read = lp_ticker_read_cnt();
+    NVIC_EnableIRQ(LPTIM_MST_IRQ);
+#endif
 }
 
 static void LPTIM_IRQHandler(void)
@@ -320,10 +351,34 @@ static void LPTIM_IRQHandler(void)
         if (__HAL_LPTIM_GET_IT_SOURCE(&LptimHandle, LPTIM_IT_CMPM) != RESET) {
             /* Clear Compare match flag */
             __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_CMPM);
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+            /* The compare register keeps matching once per counter period,
+             * only the first match after it is programmed is an event */
+            if (lp_cmp_armed) {
+                lp_cmp_armed = false;
+                lp_ticker_irq_handler();
+            }
+#else
             lp_ticker_irq_handler();
+#endif
         }
     }
 
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+    /* Autoreload match interrupt, the counter is about to wrap */
+    if (__HAL_LPTIM_GET_FLAG(&LptimHandle, LPTIM_FLAG_ARRM) != RESET) {
+        if (__HAL_LPTIM_GET_IT_SOURCE(&LptimHandle, LPTIM_IT_ARRM) != RESET) {
+            __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_ARRM);
+            /* Keep track of the wrap, and program the event if it falls
+             * within the next counter period */
+            lp_ticker_read();
+            if (lp_target_pending) {
+                lp_ticker_schedule();
+            }
+        }
+    }
+#endif
+
     if (__HAL_LPTIM_GET_FLAG(&LptimHandle, LPTIM_FLAG_CMPOK) != RESET) {
         if (__HAL_LPTIM_GET_IT_SOURCE(&LptimHandle, LPTIM_IT_CMPOK) != RESET) {
             __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_CMPOK);
@@ -338,20 +393,20 @@ static void LPTIM_IRQHandler(void)
                      * change current tick so it can be compared with buffer.
                      * If this event got outdated fire interrupt right now,
                      * else schedule it normally. */
-                    if (lp_delayed_counter <= ((lp_ticker_read() + LP_TIMER_SAFE_GUARD + 1) & 0xFFFF)) {
+                    if (lp_delayed_counter <= ((lp_ticker_read_cnt() + LP_TIMER_SAFE_GUARD + 1) & 0xFFFF)) {
                         lp_ticker_fire_interrupt();
                     } else {
-                        lp_ticker_set_interrupt((lp_delayed_counter - LP_TIMER_SAFE_GUARD - 1) & 0xFFFF);
+                        lp_ticker_set_compare((lp_delayed_counter - LP_TIMER_SAFE_GUARD - 1) & 0xFFFF);
                     }
                     roll_over_flag = false;
                 } else {
-                    if (future_event_flag && (lp_delayed_counter <= lp_ticker_read())) {
+                    if (future_event_flag && (lp_delayed_counter <= lp_ticker_read_cnt())) {
                         /* If this event got outdated fire interrupt right now,
                          * else schedule it normally. */
                         lp_ticker_fire_interrupt();
                         future_event_flag = false;
                     } else {
-                        lp_ticker_set_interrupt(lp_delayed_counter);
+                        lp_ticker_set_compare(lp_delayed_counter);
                     }
                 }
 
@@ -368,7 +423,7 @@ static void LPTIM_IRQHandler(void)
     core_util_critical_section_exit();
 }
 
-uint32_t lp_ticker_read(void)
+static uint32_t lp_ticker_read_cnt(void)
 {
     uint32_t lp_time = LPTIM_MST->CNT;
     /* Reading the LPTIM_CNT register may return unreliable values.
@@ -379,12 +434,76 @@ uint32_t lp_ticker_read(void)
     return lp_time;
 }
 
-/*  This function should always be called from critical section */
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+uint32_t lp_ticker_read(void)
+{
+    core_util_critical_section_enter();
+
+    uint32_t cnt = lp_ticker_read_cnt();
+    uint32_t last = lp_last_read;
+    uint32_t lp_time = (last & 0xFFFF0000) | cnt;
+    if (cnt < (last & 0xFFFF)) {
+        /* Counter wrapped since the last read */
+        lp_time += 0x10000;
+    }
+    lp_last_read = lp_time;
+
+    core_util_critical_section_exit();
+    return lp_time;
+}
+
+/*  Program the compare register for lp_target if it is reached before the
+ *  counter wraps, otherwise leave it to the autoreload match interrupt.
+ *  Called with interrupts disabled */
+static void lp_ticker_schedule(void)
+{
+    uint32_t now = lp_ticker_read();
+    uint32_t delta = lp_target - now;
+    uint32_t to_wrap = 0xFFFF - (now & 0xFFFF);
+
+    if (delta > 0x80000000) {
+        /* Event in the past */
+        lp_target_pending = false;
+        lp_ticker_fire_interrupt();
+    } else if ((delta <= to_wrap) ||
+               ((to_wrap < LP_TIMER_SAFE_GUARD) && (delta < 0x10000 - LP_TIMER_SAFE_GUARD))) {
+        /* Within the current counter period, or close enough to the wrap
+         * for lp_ticker_set_compare to program the next period */
+        lp_target_pending = false;
+        lp_cmp_armed = true;
+        lp_ticker_set_compare(LP_TIMER_WRAP(lp_target));
+    }
+}
+
 void lp_ticker_set_interrupt(timestamp_t timestamp)
 {
     core_util_critical_section_enter();
 
-    timestamp_t last_read_counter = lp_ticker_read();
+    lp_target = timestamp;
+    lp_target_pending = true;
+    lp_cmp_armed = false;
+    lp_ticker_schedule();
+
+    core_util_critical_section_exit();
+}
+#else
+uint32_t lp_ticker_read(void)
+{
+    return lp_ticker_read_cnt();
+}
+
+void lp_ticker_set_interrupt(timestamp_t timestamp)
+{
+    lp_ticker_set_compare(timestamp);
+}
+#endif
+
+/*  This function should always be called from critical section */
+static void lp_ticker_set_compare(timestamp_t timestamp)
+{
+    core_util_critical_section_enter();
+
+    timestamp_t last_read_counter = lp_ticker_read_cnt();
 
     /* Always store the last requested timestamp */
     lp_delayed_counter = timestamp;
@@ -472,6 +591,9 @@ void lp_ticker_fire_interrupt(void)
     lp_Fired = 1;
     /* In case we fire interrupt now, then cancel pending programing */
     lp_delayed_prog = false;
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+    lp_cmp_armed = false;
+#endif
     NVIC_SetPendingIRQ(LPTIM_MST_IRQ);
     NVIC_EnableIRQ(LPTIM_MST_IRQ);
     core_util_critical_section_exit();
@@ -494,8 +616,14 @@ void lp_ticker_disable_interrupt(void)
     }
     lp_delayed_prog = false;
     lp_Fired = 0;
+#if MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
+    /* The interrupt stays enabled for the autoreload match */
+    lp_target_pending = false;
+    lp_cmp_armed = false;
+#else
     NVIC_DisableIRQ(LPTIM_MST_IRQ);
     NVIC_ClearPendingIRQ(LPTIM_MST_IRQ);
+#endif
 
     core_util_critical_section_exit();
 }
@@ -504,7 +632,9 @@ void lp_ticker_clear_interrupt(void)
 {
     core_util_critical_section_enter();
     __HAL_LPTIM_CLEAR_FLAG(&LptimHandle, LPTIM_FLAG_CMPM);
+#if !MBED_CONF_TARGET_LPTICKER_LPTIM_EXTENDED
     NVIC_ClearPendingIRQ(LPTIM_MST_IRQ);
+#endif
     core_util_critical_section_exit();
 }
 
@@ -5,10 +5,16 @@
 
 #if DEVICE_CRC
 
+#ifdef CRC_POLYLENGTH_7B
+#include "stm_dma_utils.h"
+#endif
+
 static CRC_HandleTypeDef current_state;
 static uint32_t final_xor;
 static uint32_t crc_mask;
+#ifndef CRC_POLYLENGTH_7B
 static uint32_t result;
+#endif
 
 /*  STM32 CRC preipheral features
   +-------------------------+-----------------------+---------------+---------------+
@@ -39,6 +45,103 @@ static uint32_t get_crc_mask(int width)
     return (uint32_t)((1ull << width) - 1);
 }
 
+#ifdef CRC_POLYLENGTH_7B
+/*  The data register is fed directly rather than through HAL_CRC_Accumulate,
+    which shuffles the bytes of every word in software.
+
+    The unit processes the bits of each write from the most significant one.
+    Reflected input is a little endian stream of bytes processed from bit 0,
+    so aligned words are written as they are with the whole word bit reversed
+    (REV_IN word), and the unaligned bytes with REV_IN byte. Other input has
+    the bytes of each word swapped and no reversal.
+
+    Large aligned blocks of reflected input are written by a memory to memory
+    DMA transfer, which the memory bus serves at one word per access.
+*/
+#if STM_DMA_SUPPORTED
+#ifndef CRC_DMA_THRESHOLD
+#define CRC_DMA_THRESHOLD 256
+#endif
+
+static DMA_HandleTypeDef crc_dma;
+#endif
+
+static bool reflect_in;
+
+static void crc_set_input_inversion(uint32_t inversion)
+{
+    if (READ_BIT(CRC->CR, CRC_CR_REV_IN) != inversion) {
+        // reading the result waits for the computation of the last write
+        (void)CRC->DR;
+        MODIFY_REG(CRC->CR, CRC_CR_REV_IN, inversion);
+    }
+}
+
+static void crc_write_bytes(const uint8_t *data, size_t size)
+{
+    if (reflect_in) {
+        crc_set_input_inversion(CRC_INPUTDATA_INVERSION_BYTE);
+    }
+
+    while (size--) {
+        *(__IO uint8_t *)&CRC->DR = *data++;
+    }
+}
+
+#if STM_DMA_SUPPORTED
+static size_t crc_write_words_dma(const uint32_t *data, size_t count)
+{
+    if (!stm_dma_link_alloc(&CRCDMALink, &crc_dma, DMA_MEMORY_TO_MEMORY, true, false,
+                            DMA_PDATAALIGN_WORD, DMA_MDATAALIGN_WORD, DMA_NORMAL)) {
+        // the channel is busy, the caller writes the words itself
+        return 0;
+    }
+
+    // give way to the peripheral streams on the controller
+    MODIFY_REG(crc_dma.Instance->CCR, DMA_CCR_PL, DMA_PRIORITY_LOW);
+
+    size_t written = 0;
+    while (written < count) {
+        size_t chunk = count - written > 0xFFFF ? 0xFFFF : count - written;
+        if (HAL_DMA_Start(&crc_dma, (uint32_t)(data + written), (uint32_t)&CRC->DR, chunk) != HAL_OK) {
+            break;
+        }
+        if (HAL_DMA_PollForTransfer(&crc_dma, HAL_DMA_FULL_TRANSFER, HAL_MAX_DELAY) != HAL_OK) {
+            MBED_ASSERT(false);
+        }
+        written += chunk;
+    }
+
+    stm_dma_link_free(&CRCDMALink);
+    return written;
+}
+#endif
+
+static void crc_write_words(const uint32_t *data, size_t count)
+{
+    if (!reflect_in) {
+        while (count--) {
+            CRC->DR = __REV(*data++);
+        }
+        return;
+    }
+
+    crc_set_input_inversion(CRC_INPUTDATA_INVERSION_WORD);
+
+#if STM_DMA_SUPPORTED
+    if (count * 4 >= CRC_DMA_THRESHOLD) {
+        size_t written = crc_write_words_dma(data, count);
+        data += written;
+        count -= written;
+    }
+#endif
+
+    while (count--) {
+        CRC->DR = *data++;
+    }
+}
+#endif
+
 void hal_crc_compute_partial_start(const crc_mbed_config_t *config)
 {
     MBED_ASSERT(HAL_CRC_IS_SUPPORTED(config->polynomial, config->width));
@@ -85,17 +188,38 @@ void hal_crc_compute_partial_start(const crc_mbed_config_t *config)
     if (HAL_CRC_Init(&current_state) != HAL_OK) {
         MBED_ASSERT(false);
     }
+
+#ifdef CRC_POLYLENGTH_7B
+    reflect_in = config->reflect_in;
+    __HAL_CRC_DR_RESET(&current_state);
+#endif
 }
 
 void hal_crc_compute_partial(const uint8_t *data, const size_t size)
 {
     if (data && size) {
+#ifdef CRC_POLYLENGTH_7B
+        size_t head = (4 - ((uint32_t)data & 3)) & 3;
+        if (head > size) {
+            head = size;
+        }
+        size_t words = (size - head) / 4;
+        size_t tail = size - head - words * 4;
+
+        crc_write_bytes(data, head);
+        crc_write_words((const uint32_t *)(data + head), words);
+        crc_write_bytes(data + head + words * 4, tail);
+#else
         result = HAL_CRC_Accumulate(&current_state, (uint32_t *)data, size);
+#endif
     }
 }
 
 uint32_t hal_crc_get_result(void)
 {
+#ifdef CRC_POLYLENGTH_7B
+    uint32_t result = CRC->DR;
+#endif
     return (result ^ final_xor) & crc_mask;
 }
 
@@ -0,0 +1,85 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profiler.h"
+#include "cmsis.h"
+
+/*  The profiler samples on the update interrupt of TIM7, a basic timer on APB1
+ *  used by no other driver. TIM6, the other basic timer, triggers the analogin streams. */
+#if MBED_CONF_PLATFORM_PROFILER_ENTRIES && defined(TIM7)
+
+static TIM_HandleTypeDef profiler_tim;
+
+int mbed_profiler_timer_start(uint32_t period_us)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t PclkFreq;
+
+    // Get clock configuration
+    // Note: PclkFreq contains here the Latency (not used after)
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &PclkFreq);
+    PclkFreq = HAL_RCC_GetPCLK1Freq();
+
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    if (RCC_ClkInitStruct.APB1CLKDivider != RCC_HCLK_DIV1) {
+        PclkFreq *= 2;
+    }
+
+    uint64_t ticks = ((uint64_t)PclkFreq * period_us) / 1000000;
+    if (ticks < 2) {
+        return -1;
+    }
+    uint64_t prescaler = (ticks - 1) / 0x10000;
+    if (prescaler > 0xFFFF) {
+        return -1;
+    }
+
+    __HAL_RCC_TIM7_CLK_ENABLE();
+
+    profiler_tim.Instance = TIM7;
+    profiler_tim.State = HAL_TIM_STATE_RESET;
+    profiler_tim.Init.Prescaler = (uint32_t)prescaler;
+    profiler_tim.Init.Period = (uint32_t)(ticks / (prescaler + 1)) - 1;
+    profiler_tim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    profiler_tim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    profiler_tim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&profiler_tim) != HAL_OK) {
+        __HAL_RCC_TIM7_CLK_DISABLE();
+        return -1;
+    }
+
+    __HAL_TIM_CLEAR_IT(&profiler_tim, TIM_IT_UPDATE);
+    if (HAL_TIM_Base_Start_IT(&profiler_tim) != HAL_OK) {
+        __HAL_RCC_TIM7_CLK_DISABLE();
+        return -1;
+    }
+    return TIM7_IRQn;
+}
+
+void mbed_profiler_timer_clear(void)
+{
+    __HAL_TIM_CLEAR_IT(&profiler_tim, TIM_IT_UPDATE);
+}
+
+void mbed_profiler_timer_stop(void)
+{
+    HAL_TIM_Base_Stop_IT(&profiler_tim);
+    HAL_TIM_Base_DeInit(&profiler_tim);
+    __HAL_RCC_TIM7_CLK_DISABLE();
+}
+
+#endif // MBED_CONF_PLATFORM_PROFILER_ENTRIES && defined(TIM7)
@@ -36,6 +36,9 @@
 #include "mbed_error.h"
 #include "PeripheralPins.h"
 #include "pwmout_device.h"
+#if DEVICE_PWMOUT_WAVEFORM
+#include "stm_dma_utils.h"
+#endif
 
 static TIM_HandleTypeDef TimHandle;
 
@@ -203,6 +206,9 @@ static void _pwmout_init_direct(pwmout_t *obj, const PinMap *pinmap)
     obj->period = 0;
     obj->pulse = 0;
     obj->prescaler = 1;
+#if DEVICE_PWMOUT_WAVEFORM
+    obj->wave_dma = 0;
+#endif
 
     pwmout_period_us(obj, 20000); // 20 ms per default
 }
@@ -219,6 +225,9 @@ void pwmout_init(pwmout_t *obj, PinName pin)
 
 void pwmout_free(pwmout_t *obj)
 {
+#if DEVICE_PWMOUT_WAVEFORM
+    pwmout_waveform_stop(obj);
+#endif
     // Configure GPIO
     pin_function(obj->pin, STM_PIN_DATA(STM_MODE_INPUT, GPIO_NOPULL, 0));
 }
@@ -308,17 +317,14 @@ void pwmout_period_ms(pwmout_t *obj, int ms)
     pwmout_period_us(obj, ms * 1000);
 }
 
-void pwmout_period_us(pwmout_t *obj, int us)
+/* Get the clock of the timer of obj */
+static uint32_t pwmout_timer_clock(pwmout_t *obj)
 {
-    TimHandle.Instance = (TIM_TypeDef *)(obj->pwm);
     RCC_ClkInitTypeDef RCC_ClkInitStruct;
     uint32_t PclkFreq = 0;
     uint32_t APBxCLKDivider = RCC_HCLK_DIV1;
-    float dc = pwmout_read(obj);
     uint8_t i = 0;
 
-    __HAL_TIM_DISABLE(&TimHandle);
-
     // Get clock configuration
     // Note: PclkFreq contains here the Latency (not used after)
     HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &PclkFreq);
@@ -342,25 +348,28 @@ void pwmout_period_us(pwmout_t *obj, int us)
 #endif
     }
 
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    return (APBxCLKDivider == RCC_HCLK_DIV1) ? PclkFreq : PclkFreq * 2;
+}
+
+void pwmout_period_us(pwmout_t *obj, int us)
+{
+    TimHandle.Instance = (TIM_TypeDef *)(obj->pwm);
+    float dc = pwmout_read(obj);
+
+    __HAL_TIM_DISABLE(&TimHandle);
+
+    uint32_t TimClkFreq = pwmout_timer_clock(obj);
 
     /* By default use, 1us as SW pre-scaler */
     obj->prescaler = 1;
-    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
-    if (APBxCLKDivider == RCC_HCLK_DIV1) {
-        TimHandle.Init.Prescaler = (((PclkFreq) / 1000000)) - 1; // 1 us tick
-    } else {
-        TimHandle.Init.Prescaler = (((PclkFreq * 2) / 1000000)) - 1; // 1 us tick
-    }
+    TimHandle.Init.Prescaler = ((TimClkFreq) / 1000000) - 1; // 1 us tick
     TimHandle.Init.Period = (us - 1);
 
     /*  In case period or pre-scalers are out of range, loop-in to get valid values */
     while ((TimHandle.Init.Period > 0xFFFF) || (TimHandle.Init.Prescaler > 0xFFFF)) {
         obj->prescaler = obj->prescaler * 2;
-        if (APBxCLKDivider == RCC_HCLK_DIV1) {
-            TimHandle.Init.Prescaler = (((PclkFreq) / 1000000) * obj->prescaler) - 1;
-        } else {
-            TimHandle.Init.Prescaler = (((PclkFreq * 2) / 1000000) * obj->prescaler) - 1;
-        }
+        TimHandle.Init.Prescaler = (((TimClkFreq) / 1000000) * obj->prescaler) - 1;
         TimHandle.Init.Period = (us - 1) / obj->prescaler;
         /*  Period decreases and prescaler increases over loops, so check for
          *  possible out of range cases */
@@ -413,6 +422,173 @@ int pwmout_read_pulsewidth_us(pwmout_t *obj)
     return (int)(pwm_duty_cycle * (float)obj->period);
 }
 
+#if DEVICE_PWMOUT_WAVEFORM
+
+/* Get the row of TIMUpdateDMALinks of the timer */
+static int pwmout_waveform_dma_index(TIM_TypeDef *tim)
+{
+#if defined(TIM1_BASE)
+    if (tim == TIM1) {
+        return 0;
+    }
+#endif
+#if defined(TIM2_BASE)
+    if (tim == TIM2) {
+        return 1;
+    }
+#endif
+#if defined(TIM3_BASE)
+    if (tim == TIM3) {
+        return 2;
+    }
+#endif
+#if defined(TIM4_BASE)
+    if (tim == TIM4) {
+        return 3;
+    }
+#endif
+#if defined(TIM5_BASE)
+    if (tim == TIM5) {
+        return 4;
+    }
+#endif
+#if defined(TIM8_BASE)
+    if (tim == TIM8) {
+        return 5;
+    }
+#endif
+#if defined(TIM15_BASE)
+    if (tim == TIM15) {
+        return 6;
+    }
+#endif
+#if defined(TIM16_BASE)
+    if (tim == TIM16) {
+        return 7;
+    }
+#endif
+#if defined(TIM17_BASE)
+    if (tim == TIM17) {
+        return 8;
+    }
+#endif
+    return -1;
+}
+
+static void pwmout_waveform_release(pwmout_t *obj)
+{
+    if (obj->wave_dma) {
+        CLEAR_BIT(((TIM_TypeDef *)obj->pwm)->DIER, TIM_DIER_UDE);
+        stm_dma_link_free(&TIMUpdateDMALinks[obj->wave_dma - 1]);
+        obj->wave_dma = 0;
+    }
+}
+
+static void pwmout_waveform_half(DMA_HandleTypeDef *hdma)
+{
+    pwmout_t *obj = (pwmout_t *)hdma->Parent;
+
+    ((pwmout_waveform_handler)obj->wave_handler)(obj->wave_id, obj->wave, obj->wave_length / 2);
+}
+
+static void pwmout_waveform_complete(DMA_HandleTypeDef *hdma)
+{
+    pwmout_t *obj = (pwmout_t *)hdma->Parent;
+
+    if (obj->wave_repeat) {
+        ((pwmout_waveform_handler)obj->wave_handler)(obj->wave_id, obj->wave + obj->wave_length / 2,
+                                                     obj->wave_length / 2);
+    } else {
+        // The last pulse is preloaded, and kept
+        CLEAR_BIT(((TIM_TypeDef *)obj->pwm)->DIER, TIM_DIER_UDE);
+        ((pwmout_waveform_handler)obj->wave_handler)(obj->wave_id, obj->wave, obj->wave_length);
+    }
+}
+
+uint32_t pwmout_waveform_init(pwmout_t *obj, uint32_t period_ns)
+{
+    pwmout_waveform_release(obj);
+
+    uint64_t ticks = (uint64_t)pwmout_timer_clock(obj) * period_ns / 1000000000;
+    if (ticks < 2) {
+        return 0;
+    }
+    uint64_t prescaler = (ticks - 1) / 0x10000;
+    if (prescaler > 0xFFFF) {
+        return 0;
+    }
+    ticks /= prescaler + 1;
+
+    TimHandle.Instance = (TIM_TypeDef *)(obj->pwm);
+    __HAL_TIM_DISABLE(&TimHandle);
+
+    TimHandle.Init.Prescaler     = (uint32_t)prescaler;
+    TimHandle.Init.Period        = (uint32_t)ticks - 1;
+    TimHandle.Init.ClockDivision = 0;
+    TimHandle.Init.CounterMode   = TIM_COUNTERMODE_UP;
+    if (HAL_TIM_PWM_Init(&TimHandle) != HAL_OK) {
+        return 0;
+    }
+
+    // Low until the waveform starts, the channel was configured with preload by pwmout_write()
+    *(&TimHandle.Instance->CCR1 + (obj->channel - 1)) = 0;
+    __HAL_TIM_ENABLE(&TimHandle);
+
+    return (uint32_t)ticks;
+}
+
+int pwmout_waveform_start(pwmout_t *obj, uint16_t *pulses, size_t length, bool repeat,
+                          pwmout_waveform_handler handler, uint32_t id)
+{
+    TIM_TypeDef *tim = (TIM_TypeDef *)obj->pwm;
+    int index = pwmout_waveform_dma_index(tim);
+
+    if (index < 0 || obj->channel < 1 || obj->channel > 4 || pulses == NULL ||
+            length == 0 || length > 0xFFFF || (repeat && (length % 2) != 0)) {
+        return -1;
+    }
+
+    // A single update request per timer, the other channels keep their compare value
+    pwmout_waveform_release(obj);
+    const DMALinkInfo *link = &TIMUpdateDMALinks[index];
+    if (!stm_dma_link_alloc(link, &obj->dma_handle, DMA_MEMORY_TO_PERIPH, false, true,
+                            DMA_PDATAALIGN_WORD, DMA_MDATAALIGN_HALFWORD, repeat ? DMA_CIRCULAR : DMA_NORMAL)) {
+        return -1;
+    }
+    obj->wave_dma = index + 1;
+    obj->wave_repeat = repeat;
+    obj->wave = pulses;
+    obj->wave_length = length;
+    obj->wave_handler = (uint32_t)handler;
+    obj->wave_id = id;
+    obj->dma_handle.Parent = obj;
+    obj->dma_handle.XferHalfCpltCallback = repeat ? pwmout_waveform_half : NULL;
+    obj->dma_handle.XferCpltCallback = pwmout_waveform_complete;
+
+    /*  The update event generated applies a preloaded 0. The next one
+     *  requests the first pulse, preloaded and output from the update after */
+    volatile uint32_t *ccr = &tim->CCR1 + (obj->channel - 1);
+    *ccr = 0;
+    tim->EGR = TIM_EGR_UG;
+    if (HAL_DMA_Start_IT(&obj->dma_handle, (uint32_t)pulses, (uint32_t)ccr, length) != HAL_OK) {
+        pwmout_waveform_release(obj);
+        return -1;
+    }
+    SET_BIT(tim->DIER, TIM_DIER_UDE);
+
+    return 0;
+}
+
+void pwmout_waveform_stop(pwmout_t *obj)
+{
+    if (obj->wave_dma) {
+        pwmout_waveform_release(obj);
+        pwmout_period_us(obj, obj->period);
+    }
+}
+
+#endif /* DEVICE_PWMOUT_WAVEFORM */
+
 const PinMap *pwmout_pinmap()
 {
     return PinMap_PWM;
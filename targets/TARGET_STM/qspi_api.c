@@ -27,6 +27,13 @@
 
 #include "mbed-trace/mbed_trace.h"
 
+#if DEVICE_QSPI_ASYNCH
+#if defined(OCTOSPI1)
+#error "DEVICE_QSPI_ASYNCH is only implemented for QUADSPI"
+#endif
+#include "stm_dma_utils.h"
+#endif
+
 #if defined(OCTOSPI1)
 #define TRACE_GROUP "STOS"
 #else
@@ -377,6 +384,31 @@ qspi_status_t qspi_prepare_command(const qspi_command_t *command, QSPI_CommandTy
 }
 #endif /* OCTOSPI */
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+/* Size of the memory mapped window of the QUADSPI/OCTOSPI (256 Mbytes) */
+#define QSPI_MEMORY_MAPPED_SIZE 0x10000000
+#endif
+
+/* Go back to indirect mode before any other operation */
+static qspi_status_t qspi_leave_memory_mapped(qspi_t *obj)
+{
+#if defined(OCTOSPI1)
+    if (obj->handle.State == HAL_OSPI_STATE_BUSY_MEM_MAPPED) {
+        if (HAL_OSPI_Abort(&obj->handle) != HAL_OK) {
+            tr_error("HAL_OSPI_Abort error");
+            return QSPI_STATUS_ERROR;
+        }
+    }
+#else
+    if (obj->handle.State == HAL_QSPI_STATE_BUSY_MEM_MAPPED) {
+        if (HAL_QSPI_Abort(&obj->handle) != HAL_OK) {
+            return QSPI_STATUS_ERROR;
+        }
+    }
+#endif
+    return QSPI_STATUS_OK;
+}
+
 
 #if defined(OCTOSPI1)
 #if STATIC_PINMAP_READY
@@ -664,6 +696,16 @@ qspi_status_t qspi_free(qspi_t *obj)
 {
     tr_info("qspi_free");
 
+#if DEVICE_QSPI_ASYNCH
+    NVIC_DisableIRQ(QUADSPI_IRQn);
+    if (obj->dma_allocated) {
+        stm_dma_link_free(&QSPIDMALink);
+        obj->handle.hdma = NULL;
+        obj->dma_allocated = 0;
+    }
+    obj->async_handler = 0;
+#endif
+
     if (HAL_QSPI_DeInit(&obj->handle) != HAL_OK) {
         return QSPI_STATUS_ERROR;
     }
@@ -700,6 +742,10 @@ qspi_status_t qspi_free(qspi_t *obj)
 qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 {
     tr_info("qspi_frequency hz %d", hz);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
     qspi_status_t status = QSPI_STATUS_OK;
 
     /* HCLK drives QSPI. QSPI clock depends on prescaler value:
@@ -727,6 +773,10 @@ qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 {
     tr_info("qspi_frequency hz %d", hz);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
     qspi_status_t status = QSPI_STATUS_OK;
 
     /* HCLK drives QSPI. QSPI clock depends on prescaler value:
@@ -760,6 +810,9 @@ qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void *data, size_t *length)
 {
     debug_if(qspi_api_c_debug, "qspi_write size %u\n", *length);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
 
     OSPI_RegularCmdTypeDef st_command;
     qspi_status_t status = qspi_prepare_command(command, &st_command);
@@ -785,6 +838,9 @@ qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void
 qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void *data, size_t *length)
 {
     debug_if(qspi_api_c_debug, "qspi_write size %u\n", *length);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
 
     QSPI_CommandTypeDef st_command;
     qspi_status_t status = qspi_prepare_command(command, &st_command);
@@ -810,6 +866,10 @@ qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void
 #if defined(OCTOSPI1)
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length)
 {
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
     OSPI_RegularCmdTypeDef st_command;
     qspi_status_t status = qspi_prepare_command(command, &st_command);
     if (status != QSPI_STATUS_OK) {
@@ -835,6 +895,10 @@ qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data,
 #else /* OCTOSPI */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length)
 {
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
     QSPI_CommandTypeDef st_command;
     qspi_status_t status = qspi_prepare_command(command, &st_command);
     if (status != QSPI_STATUS_OK) {
@@ -862,6 +926,9 @@ qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data,
 qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command, const void *tx_data, size_t tx_size, void *rx_data, size_t rx_size)
 {
     tr_info("qspi_command_transfer tx %u rx %u command %#04x", tx_size, rx_size, command->instruction.value);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
 
     qspi_status_t status = QSPI_STATUS_OK;
 
@@ -902,6 +969,10 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
 qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command, const void *tx_data, size_t tx_size, void *rx_data, size_t rx_size)
 {
     tr_info("qspi_command_transfer tx %u rx %u command %#04x", tx_size, rx_size, command->instruction.value);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
     qspi_status_t status = QSPI_STATUS_OK;
 
     if ((tx_data == NULL || tx_size == 0) && (rx_data == NULL || rx_size == 0)) {
@@ -938,6 +1009,280 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
 #endif /* OCTOSPI */
 
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+#if defined(OCTOSPI1)
+qspi_status_t qspi_memory_mapped_enable(qspi_t *obj, const qspi_command_t *command, const void **base, size_t *size)
+{
+    tr_info("qspi_memory_mapped_enable command %#04x", command->instruction.value);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    OSPI_RegularCmdTypeDef st_command;
+    qspi_status_t status = qspi_prepare_command(command, &st_command);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    // The address of each access is the offset in the window
+    st_command.Address = 0;
+
+    if (HAL_OSPI_Command(&obj->handle, &st_command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        tr_error("HAL_OSPI_Command error");
+        return QSPI_STATUS_ERROR;
+    }
+
+    OSPI_MemoryMappedTypeDef st_mapped;
+    st_mapped.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+    st_mapped.TimeOutPeriod = 0;
+    if (HAL_OSPI_MemoryMapped(&obj->handle, &st_mapped) != HAL_OK) {
+        tr_error("HAL_OSPI_MemoryMapped error");
+        return QSPI_STATUS_ERROR;
+    }
+
+#if defined(OCTOSPI2)
+    *base = (obj->handle.Instance == OCTOSPI2) ? (const void *)OCTOSPI2_BASE : (const void *)OCTOSPI1_BASE;
+#else
+    *base = (const void *)OCTOSPI1_BASE;
+#endif
+    *size = QSPI_MEMORY_MAPPED_SIZE;
+
+    return QSPI_STATUS_OK;
+}
+#else /* OCTOSPI */
+qspi_status_t qspi_memory_mapped_enable(qspi_t *obj, const qspi_command_t *command, const void **base, size_t *size)
+{
+    tr_info("qspi_memory_mapped_enable command %#04x", command->instruction.value);
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    QSPI_CommandTypeDef st_command;
+    qspi_status_t status = qspi_prepare_command(command, &st_command);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    // The address of each access is the offset in the window
+    st_command.Address = 0;
+
+    QSPI_MemoryMappedTypeDef st_mapped;
+    st_mapped.TimeOutActivation = QSPI_TIMEOUT_COUNTER_DISABLE;
+    st_mapped.TimeOutPeriod = 0;
+    if (HAL_QSPI_MemoryMapped(&obj->handle, &st_command, &st_mapped) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    *base = (const void *)QSPI_BASE;
+    *size = QSPI_MEMORY_MAPPED_SIZE;
+
+    return QSPI_STATUS_OK;
+}
+#endif /* OCTOSPI */
+
+qspi_status_t qspi_memory_mapped_disable(qspi_t *obj)
+{
+    tr_info("qspi_memory_mapped_disable");
+    return qspi_leave_memory_mapped(obj);
+}
+#endif /* DEVICE_QSPI_MEMORY_MAPPED */
+
+#if DEVICE_QSPI_ASYNCH
+/* QUADSPI has a single instance */
+static qspi_t *qspi_async_obj = NULL;
+
+static void qspi_async_irq(void)
+{
+    HAL_QSPI_IRQHandler(&qspi_async_obj->handle);
+}
+
+static void qspi_async_complete(QSPI_HandleTypeDef *hqspi, qspi_status_t status)
+{
+    // handle is the first member of struct qspi_s
+    qspi_t *obj = (qspi_t *)hqspi;
+    qspi_async_handler handler = (qspi_async_handler)obj->async_handler;
+
+    obj->async_handler = 0;
+    if (handler) {
+        handler(obj->async_id, status);
+    }
+}
+
+void HAL_QSPI_RxCpltCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_complete(hqspi, QSPI_STATUS_OK);
+}
+
+void HAL_QSPI_TxCpltCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_complete(hqspi, QSPI_STATUS_OK);
+}
+
+void HAL_QSPI_StatusMatchCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_complete(hqspi, QSPI_STATUS_OK);
+}
+
+void HAL_QSPI_ErrorCallback(QSPI_HandleTypeDef *hqspi)
+{
+    tr_error("QSPI async error %lu", (unsigned long)hqspi->ErrorCode);
+    qspi_async_complete(hqspi, QSPI_STATUS_ERROR);
+}
+
+void HAL_QSPI_TimeOutCallback(QSPI_HandleTypeDef *hqspi)
+{
+    qspi_async_complete(hqspi, QSPI_STATUS_ERROR);
+}
+
+/* Common part of the asynchronous operations, before the command is sent */
+static qspi_status_t qspi_async_prepare(qspi_t *obj, bool use_dma)
+{
+    if (qspi_leave_memory_mapped(obj) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+    if (obj->handle.State != HAL_QSPI_STATE_READY) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    if (use_dma && !obj->dma_allocated) {
+        // The HAL switches the direction of the channel for each transfer
+        if (!stm_dma_link_alloc(&QSPIDMALink, &obj->dma_handle, DMA_PERIPH_TO_MEMORY,
+                                false, true, DMA_PDATAALIGN_BYTE, DMA_MDATAALIGN_BYTE, DMA_NORMAL)) {
+            tr_error("QSPI DMA channel busy");
+            return QSPI_STATUS_ERROR;
+        }
+        __HAL_LINKDMA(&obj->handle, hdma, obj->dma_handle);
+        obj->dma_allocated = 1;
+    }
+
+    qspi_async_obj = obj;
+    NVIC_SetVector(QUADSPI_IRQn, (uint32_t)&qspi_async_irq);
+    NVIC_EnableIRQ(QUADSPI_IRQn);
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length,
+                               qspi_async_handler handler, uint32_t id)
+{
+    debug_if(qspi_api_c_debug, "qspi_write_async size %u\n", length);
+    if (data == NULL || length == 0) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    qspi_status_t status = qspi_async_prepare(obj, true);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    QSPI_CommandTypeDef st_command;
+    status = qspi_prepare_command(command, &st_command);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    st_command.NbData = length;
+
+    if (HAL_QSPI_Command(&obj->handle, &st_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    obj->async_handler = (uint32_t)handler;
+    obj->async_id = id;
+    if (HAL_QSPI_Transmit_DMA(&obj->handle, (uint8_t *)data) != HAL_OK) {
+        obj->async_handler = 0;
+        return QSPI_STATUS_ERROR;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length,
+                              qspi_async_handler handler, uint32_t id)
+{
+    debug_if(qspi_api_c_debug, "qspi_read_async size %u\n", length);
+    if (data == NULL || length == 0) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    qspi_status_t status = qspi_async_prepare(obj, true);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    QSPI_CommandTypeDef st_command;
+    status = qspi_prepare_command(command, &st_command);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    st_command.NbData = length;
+
+    if (HAL_QSPI_Command(&obj->handle, &st_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    obj->async_handler = (uint32_t)handler;
+    obj->async_id = id;
+    if (HAL_QSPI_Receive_DMA(&obj->handle, data) != HAL_OK) {
+        obj->async_handler = 0;
+        return QSPI_STATUS_ERROR;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t qspi_poll_status_async(qspi_t *obj, const qspi_command_t *command, size_t status_size,
+                                     uint32_t mask, uint32_t match, uint32_t interval,
+                                     qspi_async_handler handler, uint32_t id)
+{
+    if (status_size < 1 || status_size > 4) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    qspi_status_t status = qspi_async_prepare(obj, false);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    QSPI_CommandTypeDef st_command;
+    status = qspi_prepare_command(command, &st_command);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+
+    QSPI_AutoPollingTypeDef st_polling;
+    st_polling.Match = match;
+    st_polling.Mask = mask;
+    st_polling.MatchMode = QSPI_MATCH_MODE_AND;
+    st_polling.StatusBytesSize = status_size;
+    // PIR holds a 16-bit count of clock cycles
+    st_polling.Interval = (interval > 0xFFFF) ? 0xFFFF : interval;
+    st_polling.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+
+    obj->async_handler = (uint32_t)handler;
+    obj->async_id = id;
+    if (HAL_QSPI_AutoPolling_IT(&obj->handle, &st_command, &st_polling) != HAL_OK) {
+        obj->async_handler = 0;
+        return QSPI_STATUS_ERROR;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+void qspi_abort_async(qspi_t *obj)
+{
+    NVIC_DisableIRQ(QUADSPI_IRQn);
+    obj->async_handler = 0;
+    if (HAL_QSPI_Abort(&obj->handle) != HAL_OK) {
+        tr_error("HAL_QSPI_Abort error");
+    }
+    __HAL_QSPI_DISABLE_IT(&obj->handle, QSPI_IT_TO | QSPI_IT_SM | QSPI_IT_FT | QSPI_IT_TC | QSPI_IT_TE);
+    NVIC_ClearPendingIRQ(QUADSPI_IRQn);
+    NVIC_EnableIRQ(QUADSPI_IRQn);
+}
+#endif /* DEVICE_QSPI_ASYNCH */
+
 const PinMap *qspi_master_sclk_pinmap()
 {
     return PinMap_QSPI_SCLK;
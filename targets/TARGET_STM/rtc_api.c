@@ -163,26 +163,12 @@ Information about STM32F1:
 For date, there is no specific register, only a software structure.
 It is then not a problem to not use shifts.
 */
-time_t rtc_read(void)
+#if !TARGET_STM32F1
+/* Convert the calendar registers to a timestamp */
+static time_t rtc_calendar_to_time(uint32_t Read_time, uint32_t Read_date)
 {
-#if TARGET_STM32F1
-
-    RtcHandle.Instance = RTC;
-    return RTC_ReadTimeCounter(&RtcHandle);
-
-#else /* TARGET_STM32F1 */
-
     struct tm timeinfo;
 
-    /* Since the shadow registers are bypassed we have to read the time twice and compare them until both times are the same */
-    uint32_t Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
-    uint32_t Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
-
-    while ((Read_time != (RTC->TR & RTC_TR_RESERVED_MASK)) || (Read_date != (RTC->DR & RTC_DR_RESERVED_MASK))) {
-        Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
-        Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
-    }
-
     /* Setup a tm structure based on the RTC
     struct tm :
         tm_sec      seconds after the minute 0-61
@@ -209,10 +195,57 @@ time_t rtc_read(void)
     }
 
     return t;
+}
+#endif /* !TARGET_STM32F1 */
+
+time_t rtc_read(void)
+{
+#if TARGET_STM32F1
+
+    RtcHandle.Instance = RTC;
+    return RTC_ReadTimeCounter(&RtcHandle);
+
+#else /* TARGET_STM32F1 */
+
+    /* Since the shadow registers are bypassed we have to read the time twice and compare them until both times are the same */
+    uint32_t Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
+    uint32_t Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
+
+    while ((Read_time != (RTC->TR & RTC_TR_RESERVED_MASK)) || (Read_date != (RTC->DR & RTC_DR_RESERVED_MASK))) {
+        Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
+        Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
+    }
+
+    return rtc_calendar_to_time(Read_time, Read_date);
 
 #endif /* TARGET_STM32F1 */
 }
 
+#if DEVICE_RTC_SUBSECOND
+time_t rtc_read_subsecond(uint32_t *usec)
+{
+    /* The sub-second register counts down from PREDIV_S_VALUE in the second, it is read
+    *  with the calendar until the three registers are stable so that they match */
+    uint32_t Read_SubSeconds = RTC->SSR;
+    uint32_t Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
+    uint32_t Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
+
+    while ((Read_SubSeconds != RTC->SSR) || (Read_time != (RTC->TR & RTC_TR_RESERVED_MASK)) || (Read_date != (RTC->DR & RTC_DR_RESERVED_MASK))) {
+        Read_SubSeconds = RTC->SSR;
+        Read_time = RTC->TR & RTC_TR_RESERVED_MASK;
+        Read_date = RTC->DR & RTC_DR_RESERVED_MASK;
+    }
+
+    /* After a shift operation the register may exceed PREDIV_S_VALUE for a moment */
+    if (Read_SubSeconds > PREDIV_S_VALUE) {
+        Read_SubSeconds = PREDIV_S_VALUE;
+    }
+    *usec = (uint32_t)(((uint64_t)(PREDIV_S_VALUE - Read_SubSeconds) * 1000000) / (PREDIV_S_VALUE + 1));
+
+    return rtc_calendar_to_time(Read_time, Read_date);
+}
+#endif /* DEVICE_RTC_SUBSECOND */
+
 
 
 void rtc_write(time_t t)
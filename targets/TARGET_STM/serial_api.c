@@ -222,6 +222,11 @@ void serial_free(serial_t *obj)
 {
     struct serial_s *obj_s = SERIAL_S(obj);
 
+#if DEVICE_SERIAL_DMA
+    serial_rx_dma_stop(obj);
+    serial_tx_dma_disable(obj);
+#endif
+
     // Reset UART and disable clock
 #if defined(DUAL_CORE)
     while (LL_HSEM_1StepLock(HSEM, CFG_HW_RCC_SEMID)) {
@@ -38,7 +38,16 @@
 extern void save_timer_ctx(void);
 extern void restore_timer_ctx(void);
 extern void SetSysClock(void);
+#if DEVICE_CLOCK_SCALING
+extern void stm_clock_scaling_resume(void);
+#endif
+
+#if !defined(PWR_CR1_LPMS_STOP2) || !defined(STM32L4_STOP_FAST_WAKEUP)
+#undef STM32L4_STOP_FAST_WAKEUP
+#define STM32L4_STOP_FAST_WAKEUP 0
+#endif
 
+#if !STM32L4_STOP_FAST_WAKEUP
 /*  Wait loop - assuming tick is 1 us */
 static void wait_loop(uint32_t timeout)
 {
@@ -116,6 +125,7 @@ static void ForceOscOutofDeepSleep(void)
     }
 
 }
+#endif /* !STM32L4_STOP_FAST_WAKEUP */
 
 
 void hal_sleep(void)
@@ -158,12 +168,140 @@ void hal_sleep(void)
 extern int serial_is_tx_ongoing(void);
 extern int mbed_sdk_inited;
 
+#ifdef PWR_CR1_LPMS_STOP2 /* STM32L4 */
+/*  Sleep, then Stop 0, 1 and 2. Stop 0 keeps the main regulator on, Stop 1
+ *  the low power one, and Stop 2 powers down most of the core domain.
+ *  The exit latencies are dominated by the clock restoration below, the
+ *  wake-up of the regulators making the small difference between them. */
+#define STM_SLEEP_DEPTH_STOP0   1
+#define STM_SLEEP_DEPTH_STOP1   2
+#define STM_SLEEP_DEPTH_STOP2   3
+
+static const hal_sleep_depth_t stm_sleep_depths[] = {
+    { 0, 0, false },
+    { 600, 2000, true },
+    { 610, 3000, true },
+    { 620, 5000, true },
+};
+
+const hal_sleep_depth_t *hal_sleep_get_depths(uint8_t *count)
+{
+    *count = sizeof(stm_sleep_depths) / sizeof(stm_sleep_depths[0]);
+    return stm_sleep_depths;
+}
+
+#if STM32L4_STOP_FAST_WAKEUP
+/*  Fast clock restoration after Stop mode: the RCC registers are retained,
+ *  and MSI, the wake-up clock, restarts at its range. Only the oscillators
+ *  and PLLs stopped by the hardware are restarted, from the configuration
+ *  cached before entering Stop, waiting on their ready flags. */
+typedef struct {
+    uint32_t cr;
+    uint32_t cfgr;
+#if defined(RCC_CRRCR_HSI48ON)
+    uint32_t crrcr;
+#endif
+} stm_clock_ctx_t;
+
+static void stm_clock_save(stm_clock_ctx_t *ctx)
+{
+    ctx->cr = RCC->CR;
+    ctx->cfgr = RCC->CFGR;
+#if defined(RCC_CRRCR_HSI48ON)
+    ctx->crrcr = RCC->CRRCR;
+#endif
+}
+
+static void stm_clock_restore(const stm_clock_ctx_t *ctx)
+{
+    uint32_t sysclk = ctx->cfgr & RCC_CFGR_SWS;
+
+    if (ctx->cr & RCC_CR_HSEON) {
+        SET_BIT(RCC->CR, RCC_CR_HSEON);
+        while (!READ_BIT(RCC->CR, RCC_CR_HSERDY)) {
+        }
+    }
+    if (ctx->cr & RCC_CR_HSION) {
+        SET_BIT(RCC->CR, RCC_CR_HSION);
+        while (!READ_BIT(RCC->CR, RCC_CR_HSIRDY)) {
+        }
+    }
+    // The PLLs lock in parallel
+    SET_BIT(RCC->CR, ctx->cr & (RCC_CR_PLLON | RCC_CR_PLLSAI1ON
+#if defined(RCC_CR_PLLSAI2ON)
+                                | RCC_CR_PLLSAI2ON
+#endif
+                               ));
+#if defined(RCC_CRRCR_HSI48ON)
+    if (ctx->crrcr & RCC_CRRCR_HSI48ON) {
+        SET_BIT(RCC->CRRCR, RCC_CRRCR_HSI48ON);
+    }
+#endif
+    if (ctx->cr & RCC_CR_PLLON) {
+        while (!READ_BIT(RCC->CR, RCC_CR_PLLRDY)) {
+        }
+    }
+
+    // System clock switched back unless it was MSI, prescalers are retained
+    if ((RCC->CFGR & RCC_CFGR_SWS) != sysclk) {
+        MODIFY_REG(RCC->CFGR, RCC_CFGR_SW, sysclk >> RCC_CFGR_SWS_Pos);
+        while ((RCC->CFGR & RCC_CFGR_SWS) != sysclk) {
+        }
+    }
+
+    // Peripherals clocked by these are not used before their first access
+    if (ctx->cr & RCC_CR_PLLSAI1ON) {
+        while (!READ_BIT(RCC->CR, RCC_CR_PLLSAI1RDY)) {
+        }
+    }
+#if defined(RCC_CR_PLLSAI2ON)
+    if (ctx->cr & RCC_CR_PLLSAI2ON) {
+        while (!READ_BIT(RCC->CR, RCC_CR_PLLSAI2RDY)) {
+        }
+    }
+#endif
+#if defined(RCC_CRRCR_HSI48ON)
+    if (ctx->crrcr & RCC_CRRCR_HSI48ON) {
+        while (!READ_BIT(RCC->CRRCR, RCC_CRRCR_HSI48RDY)) {
+        }
+    }
+#endif
+}
+#endif /* STM32L4_STOP_FAST_WAKEUP */
+
+static void stm_deepsleep(uint8_t depth);
+
+void hal_sleep_depth(uint8_t depth)
+{
+    if (depth == 0) {
+        hal_sleep();
+    } else if (depth >= STM_SLEEP_DEPTH_STOP2) {
+        // Keeps the hal_deepsleep overrides of the targets
+        hal_deepsleep();
+    } else {
+        stm_deepsleep(depth);
+    }
+}
+
+/*  Most of STM32 targets can have the same generic deep sleep
+ *  function, but a few targets might need very specific sleep
+ *  mode management, so this function is defined as WEAK.
+ *  Check for alternative hal_deepsleep specific implementation
+ *  in targets folders in case of doubt */
+__WEAK void hal_deepsleep(void)
+{
+    stm_deepsleep(STM_SLEEP_DEPTH_STOP2);
+}
+
+static void stm_deepsleep(uint8_t depth)
+#else /* PWR_CR1_LPMS_STOP2 */
 /*  Most of STM32 targets can have the same generic deep sleep
  *  function, but a few targets might need very specific sleep
  *  mode management, so this function is defined as WEAK.
  *  Check for alternative hal_deepsleep specific implementation
  *  in targets folders in case of doubt */
 __WEAK void hal_deepsleep(void)
+#endif /* PWR_CR1_LPMS_STOP2 */
 {
     /*  WORKAROUND:
      *  MBED serial driver does not handle deepsleep lock
@@ -196,7 +334,20 @@ __WEAK void hal_deepsleep(void)
     HAL_PWREx_EnableSRAM3ContentRetention();
 #endif
 
-    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+#if STM32L4_STOP_FAST_WAKEUP
+    stm_clock_ctx_t clock_ctx;
+    stm_clock_save(&clock_ctx);
+    // MSI as wake-up clock
+    CLEAR_BIT(RCC->CFGR, RCC_CFGR_STOPWUCK);
+#endif
+
+    if (depth == STM_SLEEP_DEPTH_STOP0) {
+        HAL_PWREx_EnterSTOP0Mode(PWR_STOPENTRY_WFI);
+    } else if (depth == STM_SLEEP_DEPTH_STOP1) {
+        HAL_PWREx_EnterSTOP1Mode(PWR_STOPENTRY_WFI);
+    } else {
+        HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+    }
 
     if (lowPowerModeEnabled) {
         HAL_PWREx_EnableLowPowerRunMode();
@@ -260,6 +411,8 @@ __WEAK void hal_deepsleep(void)
 #endif
 
     LL_HSEM_ReleaseLock(HSEM, CFG_HW_STOP_MODE_SEMID, HSEM_CR_COREID_CURRENT);
+#elif STM32L4_STOP_FAST_WAKEUP
+    stm_clock_restore(&clock_ctx);
 #else
     /* We've seen unstable PLL CLK configuration when DEEP SLEEP exits just few µs after being entered
     *  So we need to force clock init out of Deep Sleep.
@@ -269,13 +422,18 @@ __WEAK void hal_deepsleep(void)
     ForceOscOutofDeepSleep();
     ForcePeriphOutofDeepSleep();
     SetSysClock();
+#if DEVICE_CLOCK_SCALING
+    stm_clock_scaling_resume();
+#endif
 #endif
 
+#if !STM32L4_STOP_FAST_WAKEUP
     /*  Wait for clock to be stabilized.
      *  TO DO: a better way of doing this, would be to rely on
      *  HW Flag. At least this ensures proper operation out of
      *  deep sleep */
     wait_loop(500);
+#endif
 
 
     restore_timer_ctx();
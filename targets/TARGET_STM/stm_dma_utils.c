@@ -0,0 +1,226 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2021 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stm_dma_utils.h"
+#include <string.h>
+#include "mbed_assert.h"
+#include "mbed_critical.h"
+
+#if STM_DMA_SUPPORTED
+
+static DMA_Channel_TypeDef *const dma_channels[STM_DMA_NUM_CONTROLLERS][STM_DMA_MAX_CHANNELS] = {
+    {
+        DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4,
+        DMA1_Channel5, DMA1_Channel6, DMA1_Channel7
+    },
+    {
+        DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4,
+        DMA2_Channel5, DMA2_Channel6, DMA2_Channel7
+    }
+};
+
+static const IRQn_Type dma_irqs[STM_DMA_NUM_CONTROLLERS][STM_DMA_MAX_CHANNELS] = {
+    {
+        DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+        DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn
+    },
+    {
+        DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+        DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn
+    }
+};
+
+/* Owner of each channel, NULL when the channel is free */
+static DMA_HandleTypeDef *dma_handles[STM_DMA_NUM_CONTROLLERS][STM_DMA_MAX_CHANNELS];
+
+#define DMA_CTRL(link) ((link)->dma_idx - 1)
+#define DMA_CHAN(link) ((link)->channel_idx - 1)
+
+static void dma_irq(int ctrl, int chan)
+{
+    DMA_HandleTypeDef *handle = dma_handles[ctrl][chan];
+    if (handle != NULL) {
+        HAL_DMA_IRQHandler(handle);
+    } else {
+        /* Spurious interrupt from a released channel: just clear it */
+        NVIC_DisableIRQ(dma_irqs[ctrl][chan]);
+    }
+}
+
+static void dma1_ch1_irq(void)
+{
+    dma_irq(0, 0);
+}
+static void dma1_ch2_irq(void)
+{
+    dma_irq(0, 1);
+}
+static void dma1_ch3_irq(void)
+{
+    dma_irq(0, 2);
+}
+static void dma1_ch4_irq(void)
+{
+    dma_irq(0, 3);
+}
+static void dma1_ch5_irq(void)
+{
+    dma_irq(0, 4);
+}
+static void dma1_ch6_irq(void)
+{
+    dma_irq(0, 5);
+}
+static void dma1_ch7_irq(void)
+{
+    dma_irq(0, 6);
+}
+static void dma2_ch1_irq(void)
+{
+    dma_irq(1, 0);
+}
+static void dma2_ch2_irq(void)
+{
+    dma_irq(1, 1);
+}
+static void dma2_ch3_irq(void)
+{
+    dma_irq(1, 2);
+}
+static void dma2_ch4_irq(void)
+{
+    dma_irq(1, 3);
+}
+static void dma2_ch5_irq(void)
+{
+    dma_irq(1, 4);
+}
+static void dma2_ch6_irq(void)
+{
+    dma_irq(1, 5);
+}
+static void dma2_ch7_irq(void)
+{
+    dma_irq(1, 6);
+}
+
+static void (*const dma_default_vectors[STM_DMA_NUM_CONTROLLERS][STM_DMA_MAX_CHANNELS])(void) = {
+    {dma1_ch1_irq, dma1_ch2_irq, dma1_ch3_irq, dma1_ch4_irq, dma1_ch5_irq, dma1_ch6_irq, dma1_ch7_irq},
+    {dma2_ch1_irq, dma2_ch2_irq, dma2_ch3_irq, dma2_ch4_irq, dma2_ch5_irq, dma2_ch6_irq, dma2_ch7_irq}
+};
+
+static void dma_enable_clock(int ctrl)
+{
+#if defined(DMAMUX1)
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+#endif
+    if (ctrl == 0) {
+        __HAL_RCC_DMA1_CLK_ENABLE();
+    } else {
+        __HAL_RCC_DMA2_CLK_ENABLE();
+    }
+}
+
+bool stm_dma_link_alloc(const DMALinkInfo *link, DMA_HandleTypeDef *handle, uint32_t direction,
+                        bool periph_inc, bool mem_inc, uint32_t periph_align, uint32_t mem_align,
+                        uint32_t mode)
+{
+    MBED_ASSERT(link != NULL && handle != NULL);
+    MBED_ASSERT(link->dma_idx >= 1 && link->dma_idx <= STM_DMA_NUM_CONTROLLERS);
+    MBED_ASSERT(link->channel_idx >= 1 && link->channel_idx <= STM_DMA_MAX_CHANNELS);
+
+    int ctrl = DMA_CTRL(link);
+    int chan = DMA_CHAN(link);
+
+    core_util_critical_section_enter();
+    if (dma_handles[ctrl][chan] != NULL) {
+        core_util_critical_section_exit();
+        return false;
+    }
+    dma_handles[ctrl][chan] = handle;
+    core_util_critical_section_exit();
+
+    dma_enable_clock(ctrl);
+
+    memset(handle, 0, sizeof(*handle));
+    handle->Instance = dma_channels[ctrl][chan];
+    handle->Init.Request = link->request;
+    handle->Init.Direction = direction;
+    handle->Init.PeriphInc = periph_inc ? DMA_PINC_ENABLE : DMA_PINC_DISABLE;
+    handle->Init.MemInc = mem_inc ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
+    handle->Init.PeriphDataAlignment = periph_align;
+    handle->Init.MemDataAlignment = mem_align;
+    handle->Init.Mode = mode;
+    handle->Init.Priority = DMA_PRIORITY_HIGH;
+
+    if (HAL_DMA_Init(handle) != HAL_OK) {
+        dma_handles[ctrl][chan] = NULL;
+        return false;
+    }
+
+    stm_dma_link_set_vector(link, 0, 1);
+
+    return true;
+}
+
+void stm_dma_link_free(const DMALinkInfo *link)
+{
+    int ctrl = DMA_CTRL(link);
+    int chan = DMA_CHAN(link);
+    DMA_HandleTypeDef *handle = dma_handles[ctrl][chan];
+
+    if (handle == NULL) {
+        return;
+    }
+
+    NVIC_DisableIRQ(dma_irqs[ctrl][chan]);
+    NVIC_ClearPendingIRQ(dma_irqs[ctrl][chan]);
+    HAL_DMA_Abort(handle);
+    HAL_DMA_DeInit(handle);
+
+    core_util_critical_section_enter();
+    dma_handles[ctrl][chan] = NULL;
+    core_util_critical_section_exit();
+}
+
+bool stm_dma_link_busy(const DMALinkInfo *link)
+{
+    return dma_handles[DMA_CTRL(link)][DMA_CHAN(link)] != NULL;
+}
+
+IRQn_Type stm_dma_link_irqn(const DMALinkInfo *link)
+{
+    return dma_irqs[DMA_CTRL(link)][DMA_CHAN(link)];
+}
+
+void stm_dma_link_set_vector(const DMALinkInfo *link, uint32_t vector, uint32_t priority)
+{
+    int ctrl = DMA_CTRL(link);
+    int chan = DMA_CHAN(link);
+    IRQn_Type irq_n = dma_irqs[ctrl][chan];
+
+    if (vector == 0) {
+        vector = (uint32_t)dma_default_vectors[ctrl][chan];
+    }
+
+    NVIC_DisableIRQ(irq_n);
+    NVIC_ClearPendingIRQ(irq_n);
+    NVIC_SetVector(irq_n, vector);
+    NVIC_SetPriority(irq_n, priority);
+    NVIC_EnableIRQ(irq_n);
+}
+
+#endif /* STM_DMA_SUPPORTED */
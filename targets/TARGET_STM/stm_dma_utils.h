@@ -0,0 +1,111 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2021 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_STM_DMA_UTILS_H
+#define MBED_STM_DMA_UTILS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cmsis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** DMA controller, channel and request routing for one peripheral request */
+typedef struct {
+    uint8_t dma_idx;     ///< DMA controller, starting from 1
+    uint8_t channel_idx; ///< Channel of the controller, starting from 1
+    uint8_t request;     ///< CSELR request number, or DMAMUX request id
+} DMALinkInfo;
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "stm_dma_info.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Small DMA channel allocator shared by the STM32 peripheral drivers.
+ *
+ * Each peripheral request is routed to a fixed DMA controller/channel pair
+ * described by a DMALinkInfo entry (see stm_dma_info.h). Several requests
+ * share the same channel on parts without DMAMUX, so a channel is owned by at
+ * most one driver at a time: stm_dma_link_alloc() fails when the channel is
+ * busy and the caller is expected to fall back to its IRQ driven path.
+ *
+ * The HAL handle storage is provided by the caller (usually embedded in the
+ * peripheral object) so no heap is used.
+ */
+
+/** Allocate and initialize the DMA channel described by link
+ *
+ * @param link        DMA controller, channel and request to use
+ * @param handle      Caller provided HAL handle storage
+ * @param direction   DMA_PERIPH_TO_MEMORY, DMA_MEMORY_TO_PERIPH or DMA_MEMORY_TO_MEMORY
+ * @param periph_inc  Increment the peripheral address after each transfer
+ * @param mem_inc     Increment the memory address after each transfer
+ * @param periph_align DMA_PDATAALIGN_xxx
+ * @param mem_align   DMA_MDATAALIGN_xxx
+ * @param mode        DMA_NORMAL or DMA_CIRCULAR
+ * @return true if the channel was free and is now owned by handle
+ */
+bool stm_dma_link_alloc(const DMALinkInfo *link, DMA_HandleTypeDef *handle, uint32_t direction,
+                        bool periph_inc, bool mem_inc, uint32_t periph_align, uint32_t mem_align,
+                        uint32_t mode);
+
+/** Release a DMA channel previously allocated with stm_dma_link_alloc
+ *
+ * @param link    DMA controller, channel and request used
+ */
+void stm_dma_link_free(const DMALinkInfo *link);
+
+/** Check whether the channel used by link is currently owned by a driver
+ *
+ * @param link    DMA controller, channel and request to check
+ * @return true if the channel is in use
+ */
+bool stm_dma_link_busy(const DMALinkInfo *link);
+
+/** Get the NVIC interrupt line of the channel used by link
+ *
+ * @param link    DMA controller, channel and request
+ * @return the channel interrupt number
+ */
+IRQn_Type stm_dma_link_irqn(const DMALinkInfo *link);
+
+/** Route the channel interrupt to a driver specific handler
+ *
+ * By default the channel interrupt calls HAL_DMA_IRQHandler() on the owning
+ * handle. Drivers which need to process DMA and peripheral events in a single
+ * context (for instance the asynch SPI thunk) can install their own vector;
+ * passing 0 restores the default handler.
+ *
+ * @param link    DMA controller, channel and request
+ * @param vector  Handler address, or 0 for the default handler
+ * @param priority NVIC priority of the channel interrupt
+ */
+void stm_dma_link_set_vector(const DMALinkInfo *link, uint32_t vector, uint32_t priority);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
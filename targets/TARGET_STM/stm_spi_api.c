@@ -41,6 +41,15 @@
 #include "PeripheralPins.h"
 #include "spi_device.h"
 
+#if DEVICE_SPI_ASYNCH || DEVICE_SPISLAVE_DMA
+#include "stm_dma_utils.h"
+#endif
+
+#if DEVICE_SPISLAVE_DMA
+#include "gpio_irq_api.h"
+#include "mbed_critical.h"
+#endif
+
 #if DEVICE_SPI_ASYNCH
 #define SPI_INST(obj)    ((SPI_TypeDef *)(obj->spi.spi))
 #else
@@ -67,6 +76,11 @@
 /* Consider 10ms as the default timeout for sending/receving 1 byte */
 #define TIMEOUT_1_BYTE 10
 
+/* With DMA_USAGE_OPPORTUNISTIC, shorter transfers are not worth the DMA setup cost */
+#ifndef SPI_DMA_OPPORTUNISTIC_MIN_LENGTH
+#define SPI_DMA_OPPORTUNISTIC_MIN_LENGTH 16
+#endif
+
 #if defined(SPI_FLAG_FRLVL) // STM32F0 STM32F3 STM32F7 STM32L4
 extern HAL_StatusTypeDef HAL_SPIEx_FlushRxFifo(SPI_HandleTypeDef *hspi);
 #endif
@@ -229,6 +243,10 @@ static void _spi_init_direct(spi_t *obj, const spi_pinmap_t *pinmap)
     spiobj->pin_mosi = pinmap->mosi_pin;
     spiobj->pin_sclk = pinmap->sclk_pin;
     spiobj->pin_ssel = pinmap->ssel_pin;
+#if DEVICE_SPISLAVE_DMA
+    spiobj->slave_dma_rx = 0;
+    spiobj->slave_dma_tx = 0;
+#endif
     if (pinmap->ssel_pin != NC) {
         pin_function(pinmap->ssel_pin, pinmap->ssel_function);
         pin_mode(pinmap->ssel_pin, PullNone);
@@ -302,6 +320,36 @@ void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel
     SPI_INIT_DIRECT(obj, &explicit_spi_pinmap);
 }
 
+#if (DEVICE_SPI_ASYNCH || DEVICE_SPISLAVE_DMA) && STM_DMA_SUPPORTED
+static int spi_get_index(struct spi_s *spiobj)
+{
+    switch ((int)spiobj->spi) {
+#if defined SPI1_BASE
+        case SPI_1:
+            return 0;
+#endif
+#if defined SPI2_BASE
+        case SPI_2:
+            return 1;
+#endif
+#if defined SPI3_BASE
+        case SPI_3:
+            return 2;
+#endif
+        default:
+            return -1;
+    }
+}
+#endif
+
+#if DEVICE_SPI_ASYNCH && STM_DMA_SUPPORTED
+static void spi_dma_free(spi_t *obj);
+#endif
+
+#if DEVICE_SPISLAVE_DMA
+static void spi_slave_dma_free(spi_t *obj);
+#endif
+
 void spi_free(spi_t *obj)
 {
     struct spi_s *spiobj = SPI_S(obj);
@@ -309,6 +357,13 @@ void spi_free(spi_t *obj)
 
     DEBUG_PRINTF("spi_free\r\n");
 
+#if DEVICE_SPI_ASYNCH && STM_DMA_SUPPORTED
+    spi_dma_free(obj);
+#endif
+#if DEVICE_SPISLAVE_DMA
+    spi_slave_dma_free(obj);
+#endif
+
     __HAL_SPI_DISABLE(handle);
     HAL_SPI_DeInit(handle);
 
@@ -690,6 +745,214 @@ const PinMap *spi_slave_cs_pinmap()
     return PinMap_SPI_SSEL;
 }
 
+#if DEVICE_SPISLAVE_DMA
+
+#if !STM_DMA_SUPPORTED
+#error "DEVICE_SPISLAVE_DMA needs the DMA channel tables of stm_dma_info.h"
+#endif
+
+/// Number of bytes moved per DMA item, following the SPI frame size
+static uint32_t spi_slave_dma_frame_size(struct spi_s *spiobj)
+{
+    return (spiobj->handle.Init.DataSize == SPI_DATASIZE_16BIT) ? 2 : 1;
+}
+
+/// Reset the SPI instance, the only way to flush its transmit FIFO, and restore its configuration
+/// The SPI is left disabled with no DMA request enabled
+static void spi_slave_dma_reset(struct spi_s *spiobj)
+{
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+
+    __HAL_SPI_DISABLE(handle);
+#if defined SPI1_BASE
+    if (spiobj->spi == SPI_1) {
+        __HAL_RCC_SPI1_FORCE_RESET();
+        __HAL_RCC_SPI1_RELEASE_RESET();
+    }
+#endif
+#if defined SPI2_BASE
+    if (spiobj->spi == SPI_2) {
+        __HAL_RCC_SPI2_FORCE_RESET();
+        __HAL_RCC_SPI2_RELEASE_RESET();
+    }
+#endif
+#if defined SPI3_BASE
+    if (spiobj->spi == SPI_3) {
+        __HAL_RCC_SPI3_FORCE_RESET();
+        __HAL_RCC_SPI3_RELEASE_RESET();
+    }
+#endif
+    // State is READY: this only rewrites CR1 and CR2
+    HAL_SPI_Init(handle);
+}
+
+/// RX DMA transfer complete callback: the circular buffer wrapped around
+static void spi_slave_dma_wrapped(DMA_HandleTypeDef *hdma)
+{
+    // handle is the first member of struct spi_s
+    struct spi_s *spiobj = (struct spi_s *)hdma->Parent;
+    spiobj->slave_dma_wraps++;
+}
+
+/// NSS EXTI handler: the master ended a transaction
+static void spi_slave_dma_nss_irq(uint32_t id, gpio_irq_event event)
+{
+    struct spi_s *spiobj = SPI_S((spi_t *)id);
+
+    if (event == IRQ_RISE && spiobj->slave_dma_handler) {
+        spiobj->slave_dma_handler(spiobj->slave_dma_id);
+    }
+}
+
+int spi_slave_dma_start(spi_t *obj, void *buffer, size_t length, spi_slave_dma_handler handler, uint32_t id)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+    int index = spi_get_index(spiobj);
+    uint32_t frame_size = spi_slave_dma_frame_size(spiobj);
+
+    if (spiobj->slave_dma_rx || index < 0 || handle->Init.Mode != SPI_MODE_SLAVE ||
+            handle->Init.NSS == SPI_NSS_SOFT || spiobj->pin_ssel == NC ||
+            SPIRxDMALinks[index].dma_idx == 0 || length < frame_size || length / frame_size > 0xFFFF) {
+        return -1;
+    }
+
+#if DEVICE_SPI_ASYNCH
+    // Give the channels back if a previous asynchronous transfer kept them
+    spi_dma_free(obj);
+#endif
+
+    uint32_t periph_align = DMA_PDATAALIGN_BYTE;
+    uint32_t mem_align = DMA_MDATAALIGN_BYTE;
+    if (frame_size == 2) {
+        periph_align = DMA_PDATAALIGN_HALFWORD;
+        mem_align = DMA_MDATAALIGN_HALFWORD;
+    }
+
+    if (!stm_dma_link_alloc(&SPIRxDMALinks[index], &spiobj->dma_rx_handle, DMA_PERIPH_TO_MEMORY,
+                            false, true, periph_align, mem_align, DMA_CIRCULAR)) {
+        return -1;
+    }
+    // Without a transmit channel reception still works, spi_slave_dma_reply() fails
+    if (spiobj->pin_miso != NC && SPITxDMALinks[index].dma_idx != 0 &&
+            stm_dma_link_alloc(&SPITxDMALinks[index], &spiobj->dma_tx_handle, DMA_MEMORY_TO_PERIPH,
+                               false, true, periph_align, mem_align, DMA_NORMAL)) {
+        spiobj->slave_dma_tx = 1;
+    }
+
+    spiobj->dma_rx_handle.Parent = handle;
+    spiobj->dma_rx_handle.XferCpltCallback = spi_slave_dma_wrapped;
+    spiobj->dma_rx_handle.XferHalfCpltCallback = NULL;
+    spiobj->dma_rx_handle.XferErrorCallback = NULL;
+    spiobj->dma_rx_handle.XferAbortCallback = NULL;
+    spiobj->slave_dma_items = length / frame_size;
+    spiobj->slave_dma_wraps = 0;
+    spiobj->slave_dma_handler = handler;
+    spiobj->slave_dma_id = id;
+
+    // Drop whatever the polled API left in the FIFOs, then enable the RX
+    // request before the SPI as the reference manual requires
+    spi_slave_dma_reset(spiobj);
+    HAL_DMA_Start_IT(&spiobj->dma_rx_handle, (uint32_t)&handle->Instance->DR, (uint32_t)buffer,
+                     spiobj->slave_dma_items);
+    SET_BIT(handle->Instance->CR2, SPI_CR2_RXDMAEN);
+    __HAL_SPI_ENABLE(handle);
+    spiobj->slave_dma_rx = 1;
+
+    // The EXTI line is configured without touching the alternate function of the pin
+    gpio_irq_init(&spiobj->slave_nss_irq, spiobj->pin_ssel, spi_slave_dma_nss_irq, (uint32_t)obj);
+    gpio_irq_set(&spiobj->slave_nss_irq, IRQ_RISE, 1);
+
+    DEBUG_PRINTF("SPI inst=0x%8X slave DMA started\r\n", (int)handle->Instance);
+    return 0;
+}
+
+uint32_t spi_slave_dma_count(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    DMA_HandleTypeDef *dma = &(spiobj->dma_rx_handle);
+
+    if (!spiobj->slave_dma_rx) {
+        return 0;
+    }
+
+    core_util_critical_section_enter();
+    uint32_t remaining = __HAL_DMA_GET_COUNTER(dma);
+    // The buffer wrapped around and the DMA interrupt hasn't run yet: the
+    // counter above may have been read before or after the reload
+    if (__HAL_DMA_GET_FLAG(dma, __HAL_DMA_GET_TC_FLAG_INDEX(dma))) {
+        __HAL_DMA_CLEAR_FLAG(dma, __HAL_DMA_GET_TC_FLAG_INDEX(dma));
+        spiobj->slave_dma_wraps++;
+        remaining = __HAL_DMA_GET_COUNTER(dma);
+    }
+    uint32_t items = (spiobj->slave_dma_wraps + 1) * spiobj->slave_dma_items - remaining;
+    core_util_critical_section_exit();
+
+    return items * spi_slave_dma_frame_size(spiobj);
+}
+
+int spi_slave_dma_reply(spi_t *obj, const void *buffer, size_t length)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+    uint32_t frame_size = spi_slave_dma_frame_size(spiobj);
+
+    if (!spiobj->slave_dma_rx || !spiobj->slave_dma_tx || length / frame_size > 0xFFFF) {
+        return -1;
+    }
+
+    // Frames of the previous reply the master didn't clock out are still in
+    // the FIFO: only a reset of the instance drops them. The RX channel keeps
+    // running, the reset happens while NSS is high so no frame is lost.
+    HAL_DMA_Abort(&spiobj->dma_tx_handle);
+    spi_slave_dma_reset(spiobj);
+    SET_BIT(handle->Instance->CR2, SPI_CR2_RXDMAEN);
+    if (buffer != NULL && length >= frame_size) {
+        HAL_DMA_Start(&spiobj->dma_tx_handle, (uint32_t)buffer, (uint32_t)&handle->Instance->DR,
+                      length / frame_size);
+        SET_BIT(handle->Instance->CR2, SPI_CR2_TXDMAEN);
+    }
+    __HAL_SPI_ENABLE(handle);
+
+    return 0;
+}
+
+static void spi_slave_dma_free(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    int index = spi_get_index(spiobj);
+
+    if (!spiobj->slave_dma_rx) {
+        return;
+    }
+
+    gpio_irq_free(&spiobj->slave_nss_irq);
+    CLEAR_BIT(spiobj->handle.Instance->CR2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    stm_dma_link_free(&SPIRxDMALinks[index]);
+    if (spiobj->slave_dma_tx) {
+        stm_dma_link_free(&SPITxDMALinks[index]);
+        spiobj->slave_dma_tx = 0;
+    }
+    spiobj->slave_dma_handler = NULL;
+    spiobj->slave_dma_rx = 0;
+}
+
+void spi_slave_dma_stop(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+
+    if (!spiobj->slave_dma_rx) {
+        return;
+    }
+
+    spi_slave_dma_free(obj);
+    // Back to the state spi_format() leaves for the polled slave functions
+    spi_slave_dma_reset(spiobj);
+    __HAL_SPI_ENABLE(&(spiobj->handle));
+}
+
+#endif // DEVICE_SPISLAVE_DMA
+
 #if DEVICE_SPI_ASYNCH
 typedef enum {
     SPI_TRANSFER_TYPE_NONE = 0,
@@ -699,6 +962,140 @@ typedef enum {
 } transfer_type_t;
 
 
+#if STM_DMA_SUPPORTED
+/// Allocate the TX and RX DMA channels of this SPI instance
+/// @returns true if both channels are now owned by this object
+static bool spi_dma_allocate(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+    int index = spi_get_index(spiobj);
+
+    if (spiobj->dma_allocated) {
+        return true;
+    }
+
+    // rx-only transfers clock out the receive buffer, so both channels are always needed
+    if (index < 0 || handle->Init.Direction != SPI_DIRECTION_2LINES ||
+            SPITxDMALinks[index].dma_idx == 0 || SPIRxDMALinks[index].dma_idx == 0) {
+        return false;
+    }
+
+    uint32_t periph_align = DMA_PDATAALIGN_BYTE;
+    uint32_t mem_align = DMA_MDATAALIGN_BYTE;
+    if (handle->Init.DataSize == SPI_DATASIZE_16BIT) {
+        periph_align = DMA_PDATAALIGN_HALFWORD;
+        mem_align = DMA_MDATAALIGN_HALFWORD;
+    }
+
+    if (!stm_dma_link_alloc(&SPITxDMALinks[index], &spiobj->dma_tx_handle, DMA_MEMORY_TO_PERIPH,
+                            false, true, periph_align, mem_align, DMA_NORMAL)) {
+        return false;
+    }
+    if (!stm_dma_link_alloc(&SPIRxDMALinks[index], &spiobj->dma_rx_handle, DMA_PERIPH_TO_MEMORY,
+                            false, true, periph_align, mem_align, DMA_NORMAL)) {
+        stm_dma_link_free(&SPITxDMALinks[index]);
+        return false;
+    }
+
+    __HAL_LINKDMA(handle, hdmatx, spiobj->dma_tx_handle);
+    __HAL_LINKDMA(handle, hdmarx, spiobj->dma_rx_handle);
+    spiobj->dma_allocated = 1;
+
+    DEBUG_PRINTF("SPI inst=0x%8X DMA allocated\r\n", (int)handle->Instance);
+    return true;
+}
+
+static void spi_dma_free(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+    int index = spi_get_index(spiobj);
+
+    if (!spiobj->dma_allocated) {
+        return;
+    }
+
+    stm_dma_link_free(&SPITxDMALinks[index]);
+    stm_dma_link_free(&SPIRxDMALinks[index]);
+    handle->hdmatx = NULL;
+    handle->hdmarx = NULL;
+    spiobj->dma_allocated = 0;
+    spiobj->dma_active = 0;
+}
+
+/// Match the DMA data width to the current SPI frame size, spi_format() may have changed it
+static void spi_dma_update_width(struct spi_s *spiobj)
+{
+    uint32_t periph_align = DMA_PDATAALIGN_BYTE;
+    uint32_t mem_align = DMA_MDATAALIGN_BYTE;
+    if (spiobj->handle.Init.DataSize == SPI_DATASIZE_16BIT) {
+        periph_align = DMA_PDATAALIGN_HALFWORD;
+        mem_align = DMA_MDATAALIGN_HALFWORD;
+    }
+
+    DMA_HandleTypeDef *dma_handles[] = {&spiobj->dma_tx_handle, &spiobj->dma_rx_handle};
+    for (int i = 0; i < 2; i++) {
+        DMA_HandleTypeDef *dma = dma_handles[i];
+        if (dma->Init.PeriphDataAlignment != periph_align) {
+            dma->Init.PeriphDataAlignment = periph_align;
+            dma->Init.MemDataAlignment = mem_align;
+            HAL_DMA_Init(dma);
+        }
+    }
+}
+
+/// Decide whether the next transfer goes through DMA, allocating the channels if needed
+static bool spi_dma_prepare(spi_t *obj, DMAUsage hint, size_t length, uint32_t handler)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    int index;
+
+    switch (hint) {
+        case DMA_USAGE_OPPORTUNISTIC:
+            if (length < SPI_DMA_OPPORTUNISTIC_MIN_LENGTH) {
+                return false;
+            }
+            break;
+        case DMA_USAGE_TEMPORARY_ALLOCATED:
+        case DMA_USAGE_ALWAYS:
+        case DMA_USAGE_ALLOCATED:
+            break;
+        case DMA_USAGE_NEVER:
+        default:
+            // a previous hint may have left the channels allocated
+            spi_dma_free(obj);
+            return false;
+    }
+
+    if (!spi_dma_allocate(obj)) {
+        // no free channel: fall back to the interrupt driven transfer
+        return false;
+    }
+    spiobj->dma_usage = hint;
+    spi_dma_update_width(spiobj);
+
+    // DMA completion is processed in the same thunk as the SPI interrupt
+    index = spi_get_index(spiobj);
+    stm_dma_link_set_vector(&SPITxDMALinks[index], handler, 1);
+    stm_dma_link_set_vector(&SPIRxDMALinks[index], handler, 1);
+
+    return true;
+}
+
+/// Release the channels after a transfer unless the hint asked to keep them
+static void spi_dma_release(spi_t *obj)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+
+    spiobj->dma_active = 0;
+    if (spiobj->dma_usage == DMA_USAGE_OPPORTUNISTIC ||
+            spiobj->dma_usage == DMA_USAGE_TEMPORARY_ALLOCATED) {
+        spi_dma_free(obj);
+    }
+}
+#endif // STM_DMA_SUPPORTED
+
 /// @returns the number of bytes transferred, or `0` if nothing transferred
 static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer_type, const void *tx, void *rx, size_t length)
 {
@@ -733,21 +1130,42 @@ static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer
 
     // enable the right hal transfer
     int rc = 0;
-    switch (transfer_type) {
-        case SPI_TRANSFER_TYPE_TXRX:
-            rc = HAL_SPI_TransmitReceive_IT(handle, (uint8_t *)tx, (uint8_t *)rx, words);
-            break;
-        case SPI_TRANSFER_TYPE_TX:
-            rc = HAL_SPI_Transmit_IT(handle, (uint8_t *)tx, words);
-            break;
-        case SPI_TRANSFER_TYPE_RX:
-            // the receive function also "transmits" the receive buffer so in order
-            // to guarantee that 0xff is on the line, we explicitly memset it here
-            memset(rx, SPI_FILL_CHAR, length);
-            rc = HAL_SPI_Receive_IT(handle, (uint8_t *)rx, words);
-            break;
-        default:
-            length = 0;
+#if STM_DMA_SUPPORTED
+    // Cortex-M4 has no data cache, buffers can be handed to the DMA as they are
+    if (spiobj->dma_active) {
+        switch (transfer_type) {
+            case SPI_TRANSFER_TYPE_TXRX:
+                rc = HAL_SPI_TransmitReceive_DMA(handle, (uint8_t *)tx, (uint8_t *)rx, words);
+                break;
+            case SPI_TRANSFER_TYPE_TX:
+                rc = HAL_SPI_Transmit_DMA(handle, (uint8_t *)tx, words);
+                break;
+            case SPI_TRANSFER_TYPE_RX:
+                memset(rx, SPI_FILL_CHAR, length);
+                rc = HAL_SPI_Receive_DMA(handle, (uint8_t *)rx, words);
+                break;
+            default:
+                length = 0;
+        }
+    } else
+#endif
+    {
+        switch (transfer_type) {
+            case SPI_TRANSFER_TYPE_TXRX:
+                rc = HAL_SPI_TransmitReceive_IT(handle, (uint8_t *)tx, (uint8_t *)rx, words);
+                break;
+            case SPI_TRANSFER_TYPE_TX:
+                rc = HAL_SPI_Transmit_IT(handle, (uint8_t *)tx, words);
+                break;
+            case SPI_TRANSFER_TYPE_RX:
+                // the receive function also "transmits" the receive buffer so in order
+                // to guarantee that 0xff is on the line, we explicitly memset it here
+                memset(rx, SPI_FILL_CHAR, length);
+                rc = HAL_SPI_Receive_IT(handle, (uint8_t *)rx, words);
+                break;
+            default:
+                length = 0;
+        }
     }
 
     if (rc) {
@@ -764,9 +1182,6 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
     struct spi_s *spiobj = SPI_S(obj);
     SPI_HandleTypeDef *handle = &(spiobj->handle);
 
-    // TODO: DMA usage is currently ignored
-    (void) hint;
-
     // check which use-case we have
     bool use_tx = (tx != NULL && tx_length > 0);
     bool use_rx = (rx != NULL && rx_length > 0);
@@ -796,6 +1211,14 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
     IRQn_Type irq_n = spiobj->spiIRQ;
     NVIC_SetVector(irq_n, (uint32_t)handler);
 
+#if STM_DMA_SUPPORTED
+    size_t dma_length = (use_tx && use_rx) ? ((tx_length < rx_length) ? tx_length : rx_length) :
+                        (use_tx ? tx_length : rx_length);
+    spiobj->dma_active = spi_dma_prepare(obj, hint, dma_length, handler);
+#else
+    (void) hint;
+#endif
+
     // enable the right hal transfer
     if (use_tx && use_rx) {
         // we cannot manage different rx / tx sizes, let's use smaller one
@@ -817,6 +1240,14 @@ inline uint32_t spi_irq_handler_asynch(spi_t *obj)
 {
     int event = 0;
 
+#if STM_DMA_SUPPORTED
+    // DMA channel interrupts share this handler, let the HAL process them first
+    if (obj->spi.dma_active) {
+        HAL_DMA_IRQHandler(&obj->spi.dma_tx_handle);
+        HAL_DMA_IRQHandler(&obj->spi.dma_rx_handle);
+    }
+#endif
+
     // call the CubeF4 handler, this will update the handle
     HAL_SPI_IRQHandler(&obj->spi.handle);
 
@@ -838,6 +1269,11 @@ inline uint32_t spi_irq_handler_asynch(spi_t *obj)
         // disable the interrupt
         NVIC_DisableIRQ(obj->spi.spiIRQ);
         NVIC_ClearPendingIRQ(obj->spi.spiIRQ);
+#if STM_DMA_SUPPORTED
+        if (obj->spi.dma_active) {
+            spi_dma_release(obj);
+        }
+#endif
     }
 
 
@@ -870,6 +1306,14 @@ void spi_abort_asynch(spi_t *obj)
     NVIC_ClearPendingIRQ(irq_n);
     NVIC_DisableIRQ(irq_n);
 
+#if STM_DMA_SUPPORTED
+    if (spiobj->dma_active) {
+        HAL_DMA_Abort(&spiobj->dma_tx_handle);
+        HAL_DMA_Abort(&spiobj->dma_rx_handle);
+        spi_dma_release(obj);
+    }
+#endif
+
     // clean-up
     __HAL_SPI_DISABLE(handle);
     HAL_SPI_DeInit(handle);
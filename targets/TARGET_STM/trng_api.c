@@ -25,6 +25,7 @@
 #include "trng_api.h"
 #include "mbed_error.h"
 #include "mbed_atomic.h"
+#include "mbed_critical.h"
 
 #if defined (TARGET_STM32WB)
 /*  Family specific include for WB with HW semaphores */
@@ -32,6 +33,77 @@
 #include "hw_conf.h"
 #endif
 
+#if !defined(STM32_TRNG_POOL_WORDS) || defined(CFG_HW_RNG_SEMID)
+#undef STM32_TRNG_POOL_WORDS
+#define STM32_TRNG_POOL_WORDS 0
+#endif
+
+#if STM32_TRNG_POOL_WORDS
+/* Words generated in the background by the data ready interrupt, until the
+ * pool is full. The interrupt only runs while the RNG is enabled. trng_get_bytes
+ * disables it while taking words, so the pool has a single writer at a time. */
+static struct {
+    uint32_t words[STM32_TRNG_POOL_WORDS];
+    uint32_t count;
+    uint32_t last;          /* Last word generated, for the repetition test */
+    bool last_valid;
+    bool discard;           /* The next word follows the (re)start of the RNG */
+} trng_pool;
+
+/* Continuous test of the output: a word repeating the previous one is dropped.
+ * The hardware itself flags the seed and clock errors. */
+static bool trng_health_check(uint32_t word)
+{
+    bool passed = !trng_pool.last_valid || (word != trng_pool.last);
+    trng_pool.last = word;
+    trng_pool.last_valid = true;
+    return passed;
+}
+
+static void trng_pool_irq(void)
+{
+    uint32_t sr = RNG->SR;
+
+    if ((RNG->CR & RNG_CR_IE) == 0) {
+        // trng_get_bytes is taking the words
+        return;
+    }
+
+    if (sr & (RNG_SR_SEIS | RNG_SR_CEIS)) {
+        // The words being generated are not trusted: restart the RNG
+        RNG->SR &= ~(RNG_SR_SEIS | RNG_SR_CEIS);
+        RNG->CR &= ~RNG_CR_RNGEN;
+        RNG->CR |= RNG_CR_RNGEN;
+        trng_pool.discard = true;
+        trng_pool.last_valid = false;
+        return;
+    }
+
+    if (sr & RNG_SR_DRDY) {
+        uint32_t word = RNG->DR;
+        if (trng_pool.discard) {
+            trng_pool.discard = false;
+        } else if (trng_health_check(word) && trng_pool.count < STM32_TRNG_POOL_WORDS) {
+            trng_pool.words[trng_pool.count++] = word;
+        }
+        if (trng_pool.count == STM32_TRNG_POOL_WORDS) {
+            // Full: the RNG stops drawing power until words are taken
+            RNG->CR &= ~(RNG_CR_IE | RNG_CR_RNGEN);
+        }
+    }
+}
+
+static void trng_pool_refill(void)
+{
+    if (trng_pool.count < STM32_TRNG_POOL_WORDS) {
+        if ((RNG->CR & RNG_CR_RNGEN) == 0) {
+            trng_pool.discard = true;
+        }
+        RNG->CR |= RNG_CR_IE | RNG_CR_RNGEN;
+    }
+}
+#endif /* STM32_TRNG_POOL_WORDS */
+
 
 void trng_init(trng_t *obj)
 {
@@ -118,11 +190,26 @@ void trng_init(trng_t *obj)
 #if defined(CFG_HW_RNG_SEMID)
     LL_HSEM_ReleaseLock(HSEM, CFG_HW_RNG_SEMID, 0);
 #endif
+
+#if STM32_TRNG_POOL_WORDS
+    /* The words left in the pool by a previous user are still unused */
+    NVIC_SetVector(RNG_IRQn, (uint32_t)&trng_pool_irq);
+    NVIC_EnableIRQ(RNG_IRQn);
+    core_util_critical_section_enter();
+    trng_pool_refill();
+    core_util_critical_section_exit();
+#endif
 }
 
 
 void trng_free(trng_t *obj)
 {
+#if STM32_TRNG_POOL_WORDS
+    NVIC_DisableIRQ(RNG_IRQn);
+    RNG->CR &= ~RNG_CR_IE;
+    NVIC_ClearPendingIRQ(RNG_IRQn);
+#endif
+
 #if defined(CFG_HW_RNG_SEMID)
     /*  In case RNG is a shared ressource, get the HW semaphore first */
     while (LL_HSEM_1StepLock(HSEM, CFG_HW_RNG_SEMID));
@@ -156,10 +243,41 @@ int trng_get_bytes(trng_t *obj, uint8_t *output, size_t length, size_t *output_l
     __HAL_RNG_ENABLE(&obj->handle);
 #endif // TARGET_STM32WB
 
+#if STM32_TRNG_POOL_WORDS
+    /* Serve the request from the pool first, and poll for the rest */
+    core_util_critical_section_enter();
+    RNG->CR &= ~RNG_CR_IE;
+    NVIC_ClearPendingIRQ(RNG_IRQn);
+    core_util_critical_section_exit();
+
+    while ((*output_length < length) && (trng_pool.count > 0)) {
+        uint32_t word = trng_pool.words[--trng_pool.count];
+        trng_pool.words[trng_pool.count] = 0;
+        for (uint8_t i = 0; (i < 4) && (*output_length < length) ; i++) {
+            *output++ = (uint8_t)word;
+            *output_length += 1;
+            word >>= 8;
+        }
+    }
+
+    if ((*output_length < length) && ((RNG->CR & RNG_CR_RNGEN) == 0)) {
+        /* Stopped with the pool full: the first word after the start is not used */
+        __HAL_RNG_ENABLE(&obj->handle);
+        if (HAL_RNG_GenerateRandomNumber(&obj->handle, (uint32_t *)random) != HAL_OK) {
+            ret = -1;
+        }
+    }
+#endif
+
     /* Get Random byte */
     while ((*output_length < length) && (ret == 0)) {
         if (HAL_RNG_GenerateRandomNumber(&obj->handle, (uint32_t *)random) != HAL_OK) {
             ret = -1;
+#if STM32_TRNG_POOL_WORDS
+        } else if (!trng_health_check(*(volatile uint32_t *)random)) {
+            /* A repeated word means a stuck source */
+            ret = -1;
+#endif
         } else {
             for (uint8_t i = 0; (i < 4) && (*output_length < length) ; i++) {
                 *output++ = random[i];
@@ -174,6 +292,12 @@ int trng_get_bytes(trng_t *obj, uint8_t *output, size_t length, size_t *output_l
         ret = -1;
     }
 
+#if STM32_TRNG_POOL_WORDS
+    core_util_critical_section_enter();
+    trng_pool_refill();
+    core_util_critical_section_exit();
+#endif
+
 #if defined(CFG_HW_RNG_SEMID)
     /*  In case RNG is a shared ressource, get the HW semaphore first */
     LL_HSEM_ReleaseLock(HSEM, CFG_HW_RNG_SEMID, 0);
@@ -21,6 +21,7 @@
 #include "PeripheralNames.h"
 #include "us_ticker_data.h"
 #include "us_ticker_defines.h"
+#include "mbed_toolchain.h"
 
 TIM_HandleTypeDef TimMasterHandle;
 
@@ -46,7 +47,7 @@ void us_ticker_irq_handler(void);
 void timer_update_irq_handler(void)
 {
 #else
-void timer_irq_handler(void)
+MBED_RAMFUNC void timer_irq_handler(void)
 {
 #endif
     TimMasterHandle.Instance = TIM_MST;
@@ -130,7 +131,7 @@ void init_16bit_timer(void)
 // ************************************ 32-bit timer ************************************
 #else
 
-void timer_irq_handler(void)
+MBED_RAMFUNC void timer_irq_handler(void)
 {
     TimMasterHandle.Instance = TIM_MST;
     if (__HAL_TIM_GET_FLAG(&TimMasterHandle, TIM_FLAG_CC1) == SET) {
@@ -141,7 +142,7 @@ void timer_irq_handler(void)
     }
 }
 
-void init_32bit_timer(void)
+static uint32_t get_timer_prescaler(void)
 {
     RCC_ClkInitTypeDef RCC_ClkInitStruct;
     uint32_t PclkFreq;
@@ -157,6 +158,20 @@ void init_32bit_timer(void)
     PclkFreq = HAL_RCC_GetPCLK2Freq();
 #endif
 
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+#if TIM_MST_PCLK == 1
+    if (RCC_ClkInitStruct.APB1CLKDivider == RCC_HCLK_DIV1) {
+#else
+    if (RCC_ClkInitStruct.APB2CLKDivider == RCC_HCLK_DIV1) {
+#endif
+        return (uint16_t)((PclkFreq) / 1000000) - 1; // 1 us tick
+    } else {
+        return (uint16_t)((PclkFreq * 2) / 1000000) - 1; // 1 us tick
+    }
+}
+
+void init_32bit_timer(void)
+{
     // Enable timer clock
     TIM_MST_RCC;
 
@@ -174,17 +189,7 @@ void init_32bit_timer(void)
     // Configure time base
     TimMasterHandle.Instance    = TIM_MST;
     TimMasterHandle.Init.Period = 0xFFFFFFFF;
-
-    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
-#if TIM_MST_PCLK == 1
-    if (RCC_ClkInitStruct.APB1CLKDivider == RCC_HCLK_DIV1) {
-#else
-    if (RCC_ClkInitStruct.APB2CLKDivider == RCC_HCLK_DIV1) {
-#endif
-        TimMasterHandle.Init.Prescaler   = (uint16_t)((PclkFreq) / 1000000) - 1; // 1 us tick
-    } else {
-        TimMasterHandle.Init.Prescaler   = (uint16_t)((PclkFreq * 2) / 1000000) - 1; // 1 us tick
-    }
+    TimMasterHandle.Init.Prescaler = get_timer_prescaler();
 
     TimMasterHandle.Init.ClockDivision     = 0;
     TimMasterHandle.Init.CounterMode       = TIM_COUNTERMODE_UP;
@@ -211,6 +216,17 @@ void init_32bit_timer(void)
     __HAL_TIM_DISABLE_IT(&TimMasterHandle, TIM_IT_CC1);
 }
 
+/* NOTE: must be called with interrupts disabled, once the bus clocks have changed */
+void update_timer_prescaler(void)
+{
+    uint32_t cnt = __HAL_TIM_GET_COUNTER(&TimMasterHandle);
+
+    __HAL_TIM_SET_PRESCALER(&TimMasterHandle, get_timer_prescaler());
+    // The prescaler is loaded on the update event, which also clears the counter
+    LL_TIM_GenerateEvent_UPDATE(TimMasterHandle.Instance);
+    __HAL_TIM_SET_COUNTER(&TimMasterHandle, cnt);
+}
+
 #endif // 16-bit/32-bit timer
 
 void us_ticker_init(void)
@@ -0,0 +1,379 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Reader of the binary crash dumps of platform.crash-dump-enabled, see mbed_crash_dump.h.
+Prints a summary, or serves the dump to GDB as a remote target.
+"""
+
+from __future__ import print_function
+import argparse
+import binascii
+import socket
+import struct
+import sys
+import zlib
+
+_MAGIC = 0x4443424D
+_VERSION = 1
+_HEADER_SIZE = 256
+_HEADER = struct.Struct("<IHHIIiIII21I")
+_RECORD = struct.Struct("<III")
+_THREAD = struct.Struct("<IIIIBBbB16s")
+
+_FLAG_TRUNCATED = 0x0001
+_FLAG_FAULT = 0x0002
+_RECORD_MEMORY = 1
+_RECORD_THREAD = 2
+
+_REG_NAMES = ["r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11", "r12",
+              "sp", "lr", "pc", "xpsr", "psp", "msp", "exc_return", "control"]
+# Registers given to GDB, from r0 to xpsr
+_GDB_REG_COUNT = 17
+
+_THREAD_STATES = {0: "Inactive", 1: "Ready", 2: "Running", 3: "Blocked", 4: "Terminated"}
+
+_TARGET_XML = """<?xml version="1.0"?>
+<!DOCTYPE target SYSTEM "gdb-target.dtd">
+<target version="1.0">
+  <architecture>arm</architecture>
+  <feature name="org.gnu.gdb.arm.m-profile">
+""" + "".join('    <reg name="r%d" bitsize="32"/>\n' % i for i in range(13)) + """\
+    <reg name="sp" bitsize="32" type="data_ptr"/>
+    <reg name="lr" bitsize="32"/>
+    <reg name="pc" bitsize="32" type="code_ptr"/>
+    <reg name="xpsr" bitsize="32"/>
+  </feature>
+</target>
+"""
+
+
+def _hex(data):
+    return binascii.hexlify(data).decode()
+
+
+class DumpError(Exception):
+    pass
+
+
+class Thread(object):
+    def __init__(self, thread_id, data):
+        (self.sp, self.stack_mem, self.stack_size, self.entry, self.state, self.stack_frame,
+         self.priority, self.is_current, name) = _THREAD.unpack_from(data)
+        self.id = thread_id
+        self.name = name.split(b'\0')[0].decode('utf-8', 'replace') or "<unnamed>"
+        self.regs = None
+
+
+class CrashDump(object):
+    """Contents of a crash dump: header fields, registers, memory regions and threads"""
+
+    def __init__(self, data):
+        if len(data) < _HEADER_SIZE:
+            raise DumpError("too short for a crash dump")
+        fields = _HEADER.unpack_from(data)
+        magic, version, self.flags, size, crc = fields[:5]
+        if magic != _MAGIC:
+            raise DumpError("no crash dump, bad magic 0x%08X" % magic)
+        if version != _VERSION:
+            raise DumpError("unsupported crash dump version %d" % version)
+        records = data[_HEADER_SIZE:_HEADER_SIZE + size]
+        if len(records) != size or zlib.crc32(records) & 0xFFFFFFFF != crc:
+            raise DumpError("corrupted crash dump, bad CRC")
+        self.error_status, self.error_value, self.error_address, self.thread_id = fields[5:9]
+        self.regs = list(fields[9:])
+
+        self.regions = []
+        self.threads = []
+        offset = 0
+        while offset + _RECORD.size <= size:
+            record_type, address, length = _RECORD.unpack_from(records, offset)
+            offset += _RECORD.size
+            payload = records[offset:offset + length]
+            offset += length
+            if record_type == _RECORD_MEMORY:
+                self.regions.append((address, payload))
+            elif record_type == _RECORD_THREAD:
+                self.threads.append(Thread(address, payload))
+
+        for thread in self.threads:
+            if thread.is_current:
+                thread.regs = self.regs[:_GDB_REG_COUNT]
+            else:
+                thread.regs = self.stacked_registers(thread)
+        if not any(thread.is_current for thread in self.threads):
+            # No RTOS, or the current thread wasn't found
+            current = Thread(0, _THREAD.pack(self.regs[13], 0, 0, 0, 2, 0, 0, 1, b"main"))
+            current.regs = self.regs[:_GDB_REG_COUNT]
+            self.threads.insert(0, current)
+
+    @property
+    def truncated(self):
+        return bool(self.flags & _FLAG_TRUNCATED)
+
+    @property
+    def fault(self):
+        return bool(self.flags & _FLAG_FAULT)
+
+    def read(self, address, length):
+        """Read dumped memory, None if it isn't all in one region"""
+        for start, data in self.regions:
+            if start <= address and address + length <= start + len(data):
+                return data[address - start:address - start + length]
+        return None
+
+    def read_word(self, address):
+        data = self.read(address, 4)
+        return struct.unpack("<I", data)[0] if data is not None else None
+
+    def stacked_registers(self, thread):
+        """Registers of a thread switched out by RTX, from the context saved on its stack"""
+        words = []
+        address = thread.sp
+        fp_frame = not (thread.stack_frame & 0x10)
+        # R4-R11 saved by the scheduler, then S16-S31 for a floating-point context
+        for _ in range(8):
+            words.append(self.read_word(address))
+            address += 4
+        if fp_frame:
+            address += 16 * 4
+        # Exception frame: R0-R3, R12, LR, PC, xPSR, then S0-S15, FPSCR and a reserved word
+        frame = [self.read_word(address + 4 * i) for i in range(8)]
+        address += 8 * 4
+        if fp_frame:
+            address += 18 * 4
+        if None in words or None in frame:
+            return None
+        if frame[7] & (1 << 9):
+            # Stack aligned on exception entry
+            address += 4
+        return frame[0:4] + words + [frame[4], address, frame[5], frame[6], frame[7]]
+
+
+class ElfMemory(object):
+    """Read-only loaded sections of the ELF file, code and constants missing from the dump"""
+
+    def __init__(self, elf_file):
+        self.sections = []
+        if elf_file is None:
+            return
+        from elftools.elf.elffile import ELFFile
+        with open(elf_file, 'rb') as fd:
+            for section in ELFFile(fd).iter_sections():
+                flags = section['sh_flags']
+                # SHF_ALLOC and not SHF_WRITE
+                if section['sh_type'] == 'SHT_PROGBITS' and flags & 0x2 and not flags & 0x1:
+                    self.sections.append((section['sh_addr'], section.data()))
+
+    def read(self, address, length):
+        for start, data in self.sections:
+            if start <= address and address + length <= start + len(data):
+                return data[address - start:address - start + length]
+        return None
+
+
+def print_summary(dump):
+    status = dump.error_status & 0xFFFFFFFF
+    print("Error Status: 0x%08X Code: %d Module: %d" % (status, status & 0xFFFF, (status >> 16) & 0xFF))
+    print("Error Value: 0x%08X" % dump.error_value)
+    print("Location: 0x%08X" % dump.error_address)
+    print("Registers (%s):" % ("fault exception" if dump.fault else "mbed_error"))
+    for name, value in zip(_REG_NAMES, dump.regs):
+        print("  %-10s 0x%08X" % (name, value))
+    print("Threads:")
+    for thread in dump.threads:
+        used = thread.stack_mem + thread.stack_size - thread.sp if thread.stack_size else 0
+        print("  %s0x%08X %-16s %-10s prio %3d entry 0x%08X stack 0x%08X+%d, %d used" % (
+            "* " if thread.is_current else "  ", thread.id, thread.name,
+            _THREAD_STATES.get(thread.state & 0x0F, "0x%02X" % thread.state),
+            thread.priority, thread.entry, thread.stack_mem, thread.stack_size, used))
+    print("Memory:")
+    for start, data in dump.regions:
+        print("  0x%08X-0x%08X %d bytes" % (start, start + len(data), len(data)))
+    if dump.truncated:
+        print("Truncated: the flash area was too small for the whole dump")
+
+
+class GdbServer(object):
+    """Minimal GDB remote serial protocol server over a dump: registers, memory and threads"""
+
+    def __init__(self, dump, elf, read, write):
+        self.dump = dump
+        self.elf = elf
+        self._read = read
+        self._write = write
+        self.ack = True
+        self.thread = self.current_index()
+
+    def current_index(self):
+        for index, thread in enumerate(self.dump.threads):
+            if thread.is_current:
+                return index
+        return 0
+
+    def serve(self):
+        while True:
+            packet = self.receive()
+            if packet is None:
+                return
+            reply = self.handle(packet)
+            if reply is None:
+                return
+            self.send(reply)
+
+    def receive(self):
+        while True:
+            char = self._read(1)
+            if not char:
+                return None
+            if char == b'$':
+                break
+        data = b''
+        while True:
+            char = self._read(1)
+            if not char:
+                return None
+            if char == b'#':
+                break
+            data += char
+        self._read(2)
+        if self.ack:
+            self._write(b'+')
+        return data.decode('latin-1')
+
+    def send(self, reply):
+        data = reply.encode('latin-1')
+        self._write(b'$' + data + b'#' + ('%02x' % (sum(data) & 0xFF)).encode())
+        if self.ack:
+            self._read(1)
+
+    def stop_reply(self):
+        signal = 11 if self.dump.fault else 6
+        return "T%02xthread:%x;" % (signal, self.thread + 1)
+
+    def registers(self):
+        regs = self.dump.threads[self.thread].regs
+        if regs is None:
+            return "xxxxxxxx" * _GDB_REG_COUNT
+        return "".join(_hex(struct.pack("<I", value)) for value in regs)
+
+    def memory(self, address, length):
+        data = self.dump.read(address, length)
+        if data is None:
+            data = self.elf.read(address, length)
+        return _hex(data) if data is not None else "E01"
+
+    def handle(self, packet):
+        if packet.startswith("qSupported"):
+            return "PacketSize=4000;qXfer:features:read+;QStartNoAckMode+"
+        if packet == "QStartNoAckMode":
+            self.send("OK")
+            self.ack = False
+            return self.receive_and_handle()
+        if packet.startswith("qXfer:features:read:target.xml:"):
+            offset, length = (int(x, 16) for x in packet.split(":")[4].split(","))
+            chunk = _TARGET_XML[offset:offset + length]
+            return ("m" if offset + length < len(_TARGET_XML) else "l") + chunk
+        if packet == "?":
+            return self.stop_reply()
+        if packet == "g":
+            return self.registers()
+        if packet.startswith("p"):
+            index = int(packet[1:], 16)
+            regs = self.registers()
+            return regs[index * 8:index * 8 + 8] if index < _GDB_REG_COUNT else "E01"
+        if packet.startswith("m"):
+            address, length = (int(x, 16) for x in packet[1:].split(","))
+            return self.memory(address, length)
+        if packet.startswith("H"):
+            thread = int(packet[2:], 16) if packet[2:] not in ("", "-1", "0") else self.current_index() + 1
+            if 1 <= thread <= len(self.dump.threads):
+                self.thread = thread - 1
+            return "OK"
+        if packet.startswith("T"):
+            return "OK" if 1 <= int(packet[1:], 16) <= len(self.dump.threads) else "E01"
+        if packet == "qC":
+            return "QC%x" % (self.current_index() + 1)
+        if packet == "qfThreadInfo":
+            return "m" + ",".join("%x" % (i + 1) for i in range(len(self.dump.threads)))
+        if packet == "qsThreadInfo":
+            return "l"
+        if packet.startswith("qThreadExtraInfo,"):
+            thread = self.dump.threads[int(packet.split(",")[1], 16) - 1]
+            state = _THREAD_STATES.get(thread.state & 0x0F, "0x%02X" % thread.state)
+            return _hex(("%s %s" % (thread.name, state)).encode())
+        if packet == "qAttached":
+            return "1"
+        if packet.startswith("qSymbol"):
+            return "OK"
+        if packet in ("c", "s") or packet.startswith("vCont;"):
+            # A dump can't run, report the same stop
+            return self.stop_reply()
+        if packet[0] in "GPMX":
+            return "E01"
+        if packet in ("k", "D") or packet.startswith("D;"):
+            if packet != "k":
+                self.send("OK")
+            return None
+        return ""
+
+    def receive_and_handle(self):
+        packet = self.receive()
+        return self.handle(packet) if packet is not None else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read a crash dump of platform.crash-dump-enabled")
+    parser.add_argument("command", choices=["info", "gdbserver"],
+                        help="info prints a summary, gdbserver serves the dump to GDB")
+    parser.add_argument("dump", help="crash dump file, as read with mbed_crash_dump_read()")
+    parser.add_argument("--elf", help="ELF file of the application, for the code and constants")
+    parser.add_argument("--port", type=int,
+                        help="TCP port of the GDB server, by default it talks over stdin and stdout")
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as fd:
+        try:
+            dump = CrashDump(fd.read())
+        except DumpError as error:
+            sys.exit("%s: %s" % (args.dump, error))
+
+    if args.command == "info":
+        print_summary(dump)
+        return
+
+    elf = ElfMemory(args.elf)
+    if args.port is None:
+        stdin = getattr(sys.stdin, 'buffer', sys.stdin)
+        stdout = getattr(sys.stdout, 'buffer', sys.stdout)
+
+        def write(data):
+            stdout.write(data)
+            stdout.flush()
+        GdbServer(dump, elf, stdin.read, write).serve()
+    else:
+        server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        server.bind(("localhost", args.port))
+        server.listen(1)
+        print("Waiting for GDB on port %d" % args.port)
+        connection, _ = server.accept()
+        GdbServer(dump, elf, connection.recv, connection.sendall).serve()
+        connection.close()
+
+
+if __name__ == "__main__":
+    main()
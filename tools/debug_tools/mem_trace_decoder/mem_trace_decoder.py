@@ -0,0 +1,209 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decoder of the binary memory trace of mbed_mem_trace_ring_callback
+"""
+
+from __future__ import print_function
+import bisect
+import re
+import struct
+from collections import defaultdict
+from subprocess import check_output
+
+# mbed_mem_trace_record_t
+_RECORD = struct.Struct("<IHBBIIII")
+
+_MALLOC, _REALLOC, _CALLOC, _FREE = range(4)
+_OP_NAMES = ["malloc", "realloc", "calloc", "free"]
+
+#arm-none-eabi-nm -nl <elf file>
+_NM_EXEC = "arm-none-eabi-nm"
+_OPT = "-nlC"
+_PTN = re.compile("([0-9a-f]*) ([Tt]) ([^\t\n]*)(?:\t(.*):([0-9]*))?")
+
+
+class ElfHelper(object):
+    def __init__(self, elf_file):
+        op = check_output([_NM_EXEC, _OPT, elf_file]).decode('utf-8')
+        self.matches = _PTN.findall(op)
+        self.addrs = [int(x[0], 16) for x in self.matches]
+
+    def function_name_for_addr(self, addr):
+        i = bisect.bisect_right(self.addrs, addr)
+        if i == 0:
+            return "?"
+        return self.matches[i - 1][2]
+
+
+class Allocation(object):
+    def __init__(self, size, caller, timestamp):
+        self.size = size
+        self.caller = caller
+        self.timestamp = timestamp
+
+
+class HeapModel(object):
+    """Replays the traced operations to follow the live allocations"""
+
+    def __init__(self):
+        self.live = {}
+        self.live_size = 0
+        self.peak_size = 0
+        self.peak_timestamp = 0
+        self.op_counts = [0] * len(_OP_NAMES)
+        self.failed = 0
+        self.unknown_frees = 0
+        self.dropped = 0
+        self.records = 0
+        self.sizes = defaultdict(int)
+        self._next_seq = None
+
+    def _add(self, ptr, size, caller, timestamp):
+        self.live[ptr] = Allocation(size, caller, timestamp)
+        self.live_size += size
+        self.sizes[size] += 1
+        if self.live_size > self.peak_size:
+            self.peak_size = self.live_size
+            self.peak_timestamp = timestamp
+
+    def _remove(self, ptr):
+        if ptr == 0:
+            return
+        allocation = self.live.pop(ptr, None)
+        if allocation is None:
+            self.unknown_frees += 1
+        else:
+            self.live_size -= allocation.size
+
+    def replay(self, timestamp, seq, op, res, caller, arg1, arg2):
+        self.records += 1
+        if self._next_seq is not None:
+            self.dropped += (seq - self._next_seq) & 0xFFFF
+        self._next_seq = (seq + 1) & 0xFFFF
+        if op >= len(_OP_NAMES):
+            return
+        self.op_counts[op] += 1
+
+        if op == _MALLOC or op == _CALLOC:
+            size = arg1 if op == _MALLOC else arg1 * arg2
+            if res:
+                self._add(res, size, caller, timestamp)
+            elif size:
+                self.failed += 1
+        elif op == _REALLOC:
+            if res:
+                self._remove(arg1)
+                self._add(res, arg2, caller, timestamp)
+            elif arg2:
+                # Failed, the memory stays allocated
+                self.failed += 1
+            else:
+                self._remove(arg1)
+        elif op == _FREE:
+            self._remove(arg1)
+
+    def holes(self):
+        """Free gaps between the live allocations, a clue of fragmentation"""
+        blocks = sorted((ptr, a.size) for ptr, a in self.live.items())
+        holes = []
+        for (ptr, size), (next_ptr, _) in zip(blocks, blocks[1:]):
+            gap = next_ptr - (ptr + size)
+            if gap > 0:
+                holes.append(gap)
+        return holes
+
+
+def read_records(trace_file):
+    while True:
+        data = trace_file.read(_RECORD.size)
+        if len(data) < _RECORD.size:
+            return
+        timestamp, seq, op, _, res, caller, arg1, arg2 = _RECORD.unpack(data)
+        yield timestamp, seq, op, res, caller, arg1, arg2
+
+
+def caller_name(caller, elfhelper):
+    if elfhelper:
+        return "0x%08X %s" % (caller, elfhelper.function_name_for_addr(caller))
+    return "0x%08X" % caller
+
+
+def main(trace_file, elfhelper, top, dump):
+    model = HeapModel()
+    for record in read_records(trace_file):
+        if dump:
+            timestamp, seq, op, res, caller, arg1, arg2 = record
+            name = _OP_NAMES[op] if op < len(_OP_NAMES) else "?"
+            print("%10u %5u %-7s res=0x%08X arg1=0x%08X arg2=%u caller=%s" %
+                  (timestamp, seq, name, res, arg1, arg2, caller_name(caller, elfhelper)))
+        model.replay(*record)
+
+    print("Records:\t%d" % model.records)
+    print("Dropped:\t%d" % model.dropped)
+    for op, name in enumerate(_OP_NAMES):
+        print("%s:\t%s%d" % (name, "\t" if len(name) < 7 else "", model.op_counts[op]))
+    print("Failed:\t\t%d" % model.failed)
+    print("Unknown frees:\t%d" % model.unknown_frees)
+    print("Peak live:\t%d bytes at %u us" % (model.peak_size, model.peak_timestamp))
+    print("Live at end:\t%d bytes in %d allocations" % (model.live_size, len(model.live)))
+
+    holes = model.holes()
+    if holes:
+        print("\nFragmentation between the live allocations:")
+        print("\tHoles:\t\t%d" % len(holes))
+        print("\tFree in holes:\t%d bytes" % sum(holes))
+        print("\tLargest hole:\t%d bytes" % max(holes))
+
+    by_caller = defaultdict(lambda: [0, 0])
+    for allocation in model.live.values():
+        by_caller[allocation.caller][0] += 1
+        by_caller[allocation.caller][1] += allocation.size
+    if by_caller:
+        print("\nLive allocations by caller (possible leaks):")
+        ranked = sorted(by_caller.items(), key=lambda item: item[1][1], reverse=True)
+        for caller, (count, size) in ranked[:top]:
+            print("\t%8d bytes %6d allocations %s" % (size, count, caller_name(caller, elfhelper)))
+
+    print("\nMost frequent allocation sizes:")
+    ranked = sorted(model.sizes.items(), key=lambda item: item[1], reverse=True)
+    for size, count in ranked[:top]:
+        print("\t%8d bytes %6d times" % (size, count))
+
+
+if __name__ == '__main__':
+    import argparse
+
+    parser = argparse.ArgumentParser(description='Decode the binary memory trace of mbed_mem_trace_ring_callback: '
+                                     'live allocations by caller, peak usage and holes between the allocations. '
+                                     'Giving the ELF file requires arm-gcc binary utilities in the current path as it uses \'nm\' command')
+    parser.add_argument(metavar='TRACE FILE', type=argparse.FileType('rb', 0),
+                        dest='tracefile', help='path to the raw records captured from the target')
+    parser.add_argument(metavar='ELF FILE', nargs='?', default=None,
+                        dest='elffile', help='path to elf file, to name the callers')
+    parser.add_argument('--top', type=int, default=10,
+                        help='number of callers and sizes listed')
+    parser.add_argument('--dump', action='store_true',
+                        help='print every record')
+
+    args = parser.parse_args()
+
+    elfhelper = ElfHelper(args.elffile) if args.elffile else None
+
+    main(args.tracefile, elfhelper, args.top, args.dump)
+
+    args.tracefile.close()
@@ -0,0 +1,170 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decoder of the samples of the mbed statistical profiler, from the output of
+mbed_profiler_dump or from the DWT PC sample packets of an SWO capture
+"""
+
+from __future__ import print_function
+import bisect
+import re
+from collections import defaultdict
+from subprocess import check_output
+
+# Lines printed by mbed_profiler_dump
+_HEADER = re.compile(r"#p:([0-9]+);([0-9]+);([0-9]+)\s*$")
+_ENTRY = re.compile(r"#p:([0-9a-fA-F]+);([0-9]+)\s*$")
+
+# Hardware source packet of the DWT with a periodic PC sample
+_DWT_PC_SAMPLE_ID = 2
+
+#arm-none-eabi-nm -nl <elf file>
+_NM_EXEC = "arm-none-eabi-nm"
+_OPT = "-nlC"
+_PTN = re.compile("([0-9a-f]*) ([Tt]) ([^\t\n]*)(?:\t(.*):([0-9]*))?")
+
+
+class ElfHelper(object):
+    def __init__(self, elf_file):
+        op = check_output([_NM_EXEC, _OPT, elf_file]).decode('utf-8')
+        self.matches = _PTN.findall(op)
+        self.addrs = [int(x[0], 16) for x in self.matches]
+
+    def function_name_for_addr(self, addr):
+        i = bisect.bisect_right(self.addrs, addr)
+        if i == 0:
+            return "?"
+        return self.matches[i - 1][2]
+
+
+class Profile(object):
+    def __init__(self):
+        self.counts = defaultdict(int)
+        self.samples = 0
+        self.dropped = 0
+        self.sleeping = 0
+        self.period_us = 0
+
+
+def read_dump(dump_file):
+    """Samples of the last dump of a log holding mbed_profiler_dump output"""
+    profile = Profile()
+    for line in dump_file:
+        match = _HEADER.search(line)
+        if match:
+            profile = Profile()
+            profile.samples = int(match.group(1))
+            profile.dropped = int(match.group(2))
+            profile.period_us = int(match.group(3))
+            continue
+        match = _ENTRY.search(line)
+        if match:
+            profile.counts[int(match.group(1), 16)] += int(match.group(2))
+    return profile
+
+
+def read_swo(swo_file):
+    """Samples of the DWT PC sample packets of a raw ITM/DWT capture"""
+    profile = Profile()
+    data = bytearray(swo_file.read())
+    i = 0
+    while i < len(data):
+        header = data[i]
+        i += 1
+        if header & 0x03 == 0:
+            # Synchronization, overflow, timestamp or extension packet,
+            # followed by bytes with a continuation bit
+            if header & 0x80 and header != 0x80:
+                while i < len(data) and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+        payload = data[i:i + size]
+        i += size
+        if len(payload) < size:
+            break
+        if header & 0x04 and header >> 3 == _DWT_PC_SAMPLE_ID:
+            profile.samples += 1
+            if size == 4:
+                pc = payload[0] | payload[1] << 8 | payload[2] << 16 | payload[3] << 24
+                profile.counts[pc] += 1
+            else:
+                # The core was sleeping
+                profile.sleeping += 1
+    return profile
+
+
+def main(profile, elfhelper, top, addresses):
+    recorded = sum(profile.counts.values())
+    print("Samples:\t%d" % profile.samples)
+    print("Dropped:\t%d" % profile.dropped)
+    if profile.sleeping:
+        print("Sleeping:\t%d" % profile.sleeping)
+    if profile.period_us:
+        print("Period:\t\t%d us" % profile.period_us)
+    print("Addresses:\t%d" % len(profile.counts))
+    if recorded == 0:
+        return
+
+    total = float(profile.samples or recorded)
+    if elfhelper:
+        by_function = defaultdict(int)
+        for pc, count in profile.counts.items():
+            by_function[elfhelper.function_name_for_addr(pc)] += count
+        print("\nSamples by function:")
+        ranked = sorted(by_function.items(), key=lambda item: item[1], reverse=True)
+        for name, count in ranked[:top]:
+            print("\t%8d %5.1f%% %s" % (count, 100 * count / total, name))
+
+    if addresses or not elfhelper:
+        print("\nSamples by address:")
+        ranked = sorted(profile.counts.items(), key=lambda item: item[1], reverse=True)
+        for pc, count in ranked[:top]:
+            name = " " + elfhelper.function_name_for_addr(pc) if elfhelper else ""
+            print("\t%8d %5.1f%% 0x%08X%s" % (count, 100 * count / total, pc, name))
+
+
+if __name__ == '__main__':
+    import argparse
+
+    parser = argparse.ArgumentParser(description='Decode the samples of the mbed statistical profiler and rank the '
+                                     'functions they fall in. Giving the ELF file requires arm-gcc binary utilities '
+                                     'in the current path as it uses \'nm\' command')
+    parser.add_argument(metavar='SAMPLES FILE', dest='samplesfile',
+                        help='path to the log holding the mbed_profiler_dump output, or to the SWO capture with --swo')
+    parser.add_argument(metavar='ELF FILE', nargs='?', default=None,
+                        dest='elffile', help='path to elf file, to name the functions')
+    parser.add_argument('--swo', action='store_true',
+                        help='read the DWT PC sample packets of a raw SWO capture')
+    parser.add_argument('--top', type=int, default=20,
+                        help='number of functions and addresses listed')
+    parser.add_argument('--addresses', action='store_true',
+                        help='list the samples by address as well as by function')
+
+    args = parser.parse_args()
+
+    elfhelper = ElfHelper(args.elffile) if args.elffile else None
+
+    if args.swo:
+        with open(args.samplesfile, 'rb') as samples_file:
+            profile = read_swo(samples_file)
+    else:
+        with open(args.samplesfile, 'r') as samples_file:
+            profile = read_dump(samples_file)
+
+    main(profile, elfhelper, args.top, args.addresses)
@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decoder of the deferred mbed-trace records sent over ITM (mbed-trace.deferred-itm)
+"""
+
+from __future__ import print_function
+import re
+import struct
+
+_SYNC = 0xA5
+_TRUNCATED = 0x8000
+_WORDS_MASK = 0xFFF
+_NULL_STRING = 0xFFFFFFFF
+
+_LEVELS = {0x10: "DBG ", 0x08: "INFO", 0x04: "WARN", 0x02: "ERR "}
+
+# Conversion specification of the C printf format
+_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaApn%])")
+
+
+def itm_port_data(data, port):
+    """Extract the payload of the software source packets of one stimulus port from an ITM stream"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        header = data[i]
+        i += 1
+        if header == 0x00 or header == 0x70:
+            # Synchronization or overflow
+            continue
+        if (header & 0x0F) == 0x00 or (header & 0x0B) == 0x08:
+            # Timestamp or extension, with continuation bytes while bit 7 is set
+            if header & 0x80:
+                while i < len(data) and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        size = {1: 1, 2: 2, 3: 4}.get(header & 0x03, 0)
+        if not (header & 0x04) and (header >> 3) == port:
+            out += data[i:i + size]
+        i += size
+    return bytes(out)
+
+
+class ElfStrings(object):
+    """Reads the strings of the loaded sections of an ELF file"""
+
+    def __init__(self, elf_file):
+        from elftools.elf.elffile import ELFFile
+        self.sections = []
+        with open(elf_file, 'rb') as fd:
+            for section in ELFFile(fd).iter_sections():
+                if section['sh_type'] == 'SHT_PROGBITS' and section['sh_flags'] & 0x2:
+                    self.sections.append((section['sh_addr'], section.data()))
+
+    def string_at(self, addr):
+        for start, data in self.sections:
+            if start <= addr < start + len(data):
+                end = data.find(b'\0', addr - start)
+                if end < 0:
+                    end = len(data)
+                return data[addr - start:end].decode('utf-8', 'replace')
+        return None
+
+
+class Truncated(Exception):
+    pass
+
+
+class ArgReader(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, size):
+        if self.pos + size > len(self.data):
+            raise Truncated()
+        value = self.data[self.pos:self.pos + size]
+        self.pos += size
+        return value
+
+    def unsigned(self, size):
+        return struct.unpack("<Q" if size == 8 else "<I", self.take(size))[0]
+
+    def signed(self, size):
+        return struct.unpack("<q" if size == 8 else "<i", self.take(size))[0]
+
+    def double(self):
+        return struct.unpack("<d", self.take(8))[0]
+
+    def string(self):
+        length = self.unsigned(4)
+        if length == _NULL_STRING:
+            return "(null)"
+        value = self.take(length).decode('utf-8', 'replace')
+        self.take((4 - length % 4) % 4)
+        return value
+
+
+def format_record(fmt, data):
+    """printf the format with the arguments packed by the target, which is 32-bit"""
+    args = ArgReader(data)
+    out = []
+    pos = 0
+    try:
+        for match in _SPEC.finditer(fmt):
+            out.append(fmt[pos:match.start()])
+            pos = match.start()
+            flags, width, prec, length, conv = match.groups()
+            if width == '*':
+                width = str(args.signed(4))
+            if prec == '*':
+                prec = str(args.signed(4))
+            spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '')
+            size = 8 if length in ('ll', 'j') else 4
+
+            if conv == '%':
+                out.append('%')
+            elif conv == 'n':
+                pass
+            elif conv in 'di':
+                out.append((spec + 'd') % args.signed(size))
+            elif conv in 'uoxX':
+                value = args.unsigned(size)
+                if conv == 'o' and '#' in flags:
+                    spec = spec.replace('#', '')
+                    out.append((spec + 'o') % value if value == 0 else '0' + (spec + 'o') % value)
+                else:
+                    out.append((spec + ('d' if conv == 'u' else conv)) % value)
+            elif conv == 'c':
+                out.append(('%' + flags + (width or '') + 's') % chr(args.unsigned(4) & 0xFF))
+            elif conv == 's':
+                out.append((spec + 's') % args.string())
+            elif conv == 'p':
+                out.append(('%' + flags + (width or '') + 's') % ('0x%x' % args.unsigned(4)))
+            elif conv in 'aA':
+                value = args.double().hex()
+                out.append(value.upper() if conv == 'A' else value)
+            else:
+                out.append((spec + conv) % args.double())
+            pos = match.end()
+    except Truncated:
+        out.append(fmt[pos:])
+        out.append(" <truncated>")
+        return ''.join(out)
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def read_records(data):
+    """Yield (level, timestamp, grp, fmt, arguments, truncated) for each record, skipping garbage"""
+    i = 0
+    while i + 4 <= len(data):
+        header = struct.unpack_from("<I", data, i)[0]
+        words = header & _WORDS_MASK
+        if (header >> 24) != _SYNC or words < 3:
+            i += 1
+            continue
+        if i + 4 + words * 4 > len(data):
+            break
+        timestamp, grp, fmt = struct.unpack_from("<III", data, i + 4)
+        yield ((header >> 16) & 0xFF, timestamp, grp, fmt,
+               data[i + 16:i + 4 + words * 4], bool(header & _TRUNCATED))
+        i += 4 + words * 4
+
+
+def main(data, strings, cpu_freq):
+    for level, timestamp, grp, fmt, args, truncated in read_records(data):
+        grp_str = strings.string_at(grp)
+        fmt_str = strings.string_at(fmt)
+        if grp_str is None:
+            grp_str = "0x%08X" % grp
+        if fmt_str is None:
+            text = "<unknown format 0x%08X>" % fmt
+        else:
+            text = format_record(fmt_str, args)
+            if truncated and not text.endswith("<truncated>"):
+                text += " <truncated>"
+        if cpu_freq:
+            stamp = "[%12.6f]" % (float(timestamp) / cpu_freq)
+        else:
+            stamp = "[%10u]" % timestamp
+        print("%s[%s][%-4s]: %s" % (stamp, _LEVELS.get(level, "    "), grp_str, text))
+
+
+if __name__ == '__main__':
+    import argparse
+
+    parser = argparse.ArgumentParser(description='Decode the deferred mbed-trace records sent over ITM: '
+                                     'formats the traces on the host with the strings of the ELF file')
+    parser.add_argument(metavar='TRACE FILE', type=argparse.FileType('rb', 0),
+                        dest='tracefile', help='path to the SWO data captured from the target')
+    parser.add_argument(metavar='ELF FILE', dest='elffile', help='path to the elf file of the application')
+    parser.add_argument('--port', type=int, default=1,
+                        help='ITM stimulus port of the traces, mbed-trace.deferred-itm-port')
+    parser.add_argument('--raw', action='store_true',
+                        help='the trace file holds the data of the port only, not ITM packets')
+    parser.add_argument('--cpu-freq', type=float, default=0,
+                        help='core clock in Hz, to print the timestamps in seconds instead of cycles')
+
+    args = parser.parse_args()
+
+    data = bytearray(args.tracefile.read())
+    if not args.raw:
+        data = itm_port_data(data, args.port)
+
+    main(bytes(data), ElfStrings(args.elffile), args.cpu_freq)
+
+    args.tracefile.close()
@@ -0,0 +1,291 @@
+#!/usr/bin/env python
+
+"""
+Copyright (c) 2021 ARM Limited. All rights reserved.
+
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Create and apply patches for mbed::DeltaUpdate, see
+storage/update/include/update/DeltaUpdate.h for the format.
+"""
+from __future__ import print_function, division, absolute_import
+
+import struct
+import zlib
+from argparse import ArgumentParser
+
+MAGIC = 0x5055444D
+VERSION = 1
+COMPRESSION_NONE = 0
+COMPRESSION_LZSS = 1
+HEADER = struct.Struct("<IBBBBIIII")
+
+# Matching of the new image against the old one
+BLOCK = 8           # bytes hashed to find match candidates
+MIN_MATCH = 16      # shortest match worth a record
+MAX_CANDIDATES = 8  # old image positions tried per block
+
+
+def _varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return out
+
+
+def _zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def _extend(source, target, s, t):
+    """Length of the approximate match at s/t: extend while at least half
+    of the bytes match, and stop at the best point as bsdiff does."""
+    score = best = length = 0
+    i = 0
+    while s + i < len(source) and t + i < len(target):
+        if source[s + i] == target[t + i]:
+            score += 1
+        i += 1
+        if score * 2 - i > best * 2 - length:
+            best, length = score, i
+        if i - score > 16 and score * 2 < i:
+            break
+    return length
+
+
+def make_records(source, target):
+    """Find matches of the new image in the old one and return the
+    (diff, extra, adjust) records rebuilding it."""
+    index = {}
+    for pos in range(0, max(len(source) - BLOCK + 1, 0)):
+        key = bytes(source[pos:pos + BLOCK])
+        positions = index.setdefault(key, [])
+        if len(positions) < MAX_CANDIDATES:
+            positions.append(pos)
+
+    matches = []
+    t = 0
+    last_s = 0
+    while t + BLOCK <= len(target):
+        candidates = list(index.get(bytes(target[t:t + BLOCK]), []))
+        # continuing in the old image where the last match ended is likely
+        if last_s + BLOCK <= len(source) and source[last_s:last_s + BLOCK] == target[t:t + BLOCK]:
+            candidates.insert(0, last_s)
+        best_len, best_s = 0, 0
+        for s in candidates:
+            length = _extend(source, target, s, t)
+            if length > best_len:
+                best_len, best_s = length, s
+        if best_len >= MIN_MATCH:
+            matches.append((t, best_s, best_len))
+            t += best_len
+            last_s = best_s + best_len
+        else:
+            t += 1
+
+    records = []
+    t_end = 0
+    s_end = 0
+    diff = bytearray()
+    for t, s, length in matches + [(len(target), s_end, 0)]:
+        extra = target[t_end:t]
+        adjust = s - s_end
+        records.append((diff, extra, adjust))
+        diff = bytearray((target[t + i] - source[s + i]) & 0xFF for i in range(length))
+        t_end = t + length
+        s_end = s + length
+    return records
+
+
+def lzss_compress(data, window_sz2, lookahead_sz2):
+    """Compress in the heatshrink format."""
+    window = 1 << window_sz2
+    max_len = 1 << lookahead_sz2
+    bits = []
+    chains = {}
+    pos = 0
+
+    def push(value, count):
+        for i in range(count - 1, -1, -1):
+            bits.append((value >> i) & 1)
+
+    while pos < len(data):
+        best_len, best_off = 0, 0
+        key = bytes(data[pos:pos + 2])
+        if len(key) == 2:
+            for cand in reversed(chains.get(key, [])):
+                if pos - cand > window:
+                    break
+                length = 0
+                while (length < max_len and pos + length < len(data) and
+                       data[cand + length] == data[pos + length]):
+                    length += 1
+                if length > best_len:
+                    best_len, best_off = length, pos - cand
+                    if length == max_len:
+                        break
+        if best_len >= 2:
+            push(0, 1)
+            push(best_off - 1, window_sz2)
+            push(best_len - 1, lookahead_sz2)
+            step = best_len
+        else:
+            push(1, 1)
+            push(data[pos], 8)
+            step = 1
+        for p in range(pos, pos + step):
+            chain = chains.setdefault(bytes(data[p:p + 2]), [])
+            chain.append(p)
+            if len(chain) > 32:
+                del chain[0]
+        pos += step
+
+    out = bytearray()
+    for i in range(0, len(bits), 8):
+        byte = 0
+        for bit in bits[i:i + 8]:
+            byte = (byte << 1) | bit
+        out.append(byte << (8 - len(bits[i:i + 8])))
+    return out
+
+
+def create(source, target, compress=True, window_sz2=10, lookahead_sz2=5):
+    body = bytearray()
+    for diff, extra, adjust in make_records(source, target):
+        body += _varint(len(diff)) + diff
+        body += _varint(len(extra)) + extra
+        body += _varint(_zigzag(adjust))
+    if compress:
+        body = lzss_compress(body, window_sz2, lookahead_sz2)
+    header = HEADER.pack(MAGIC, VERSION,
+                         COMPRESSION_LZSS if compress else COMPRESSION_NONE,
+                         window_sz2 if compress else 0,
+                         lookahead_sz2 if compress else 0,
+                         len(source), zlib.crc32(bytes(source)) & 0xFFFFFFFF,
+                         len(target), zlib.crc32(bytes(target)) & 0xFFFFFFFF)
+    return bytearray(header) + body
+
+
+def _lzss_decompress(data, window_sz2, lookahead_sz2):
+    out = bytearray()
+    bits = [(byte >> (7 - i)) & 1 for byte in data for i in range(8)]
+    pos = 0
+
+    def take(count):
+        value = 0
+        for bit in bits[pos:pos + count]:
+            value = (value << 1) | bit
+        return value
+
+    while True:
+        if pos + 1 > len(bits):
+            return out
+        tag = take(1)
+        pos += 1
+        if tag:
+            if pos + 8 > len(bits):
+                return out
+            out.append(take(8))
+            pos += 8
+        else:
+            if pos + window_sz2 + lookahead_sz2 > len(bits):
+                return out
+            offset = take(window_sz2) + 1
+            pos += window_sz2
+            count = take(lookahead_sz2) + 1
+            pos += lookahead_sz2
+            for _ in range(count):
+                out.append(out[-offset])
+
+
+def apply(source, patch):
+    """Reference implementation of the patching, for checks."""
+    (magic, version, compression, window_sz2, lookahead_sz2,
+     source_size, source_crc, target_size, target_crc) = HEADER.unpack_from(patch)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a patch")
+    if zlib.crc32(bytes(source[:source_size])) & 0xFFFFFFFF != source_crc:
+        raise ValueError("patch is for another image")
+    body = patch[HEADER.size:]
+    if compression == COMPRESSION_LZSS:
+        body = _lzss_decompress(body, window_sz2, lookahead_sz2)
+
+    pos = 0
+
+    def varint():
+        value = shift = 0
+        while True:
+            byte = body[pos + shift // 7]
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value, shift // 7
+
+    target = bytearray()
+    s = 0
+    while len(target) < target_size:
+        length, n = varint()
+        pos += n
+        target += bytearray((body[pos + i] + source[s + i]) & 0xFF for i in range(length))
+        pos += length
+        s += length
+        length, n = varint()
+        pos += n
+        target += body[pos:pos + length]
+        pos += length
+        value, n = varint()
+        pos += n
+        s += (value >> 1) ^ -(value & 1)
+    if zlib.crc32(bytes(target)) & 0xFFFFFFFF != target_crc:
+        raise ValueError("CRC mismatch")
+    return target
+
+
+def main():
+    parser = ArgumentParser(description="Create a delta update patch")
+    parser.add_argument("old", help="image currently on the device")
+    parser.add_argument("new", help="new image")
+    parser.add_argument("patch", help="patch file to create")
+    parser.add_argument("--no-compress", action="store_true",
+                        help="don't compress the patch")
+    parser.add_argument("--window", type=int, default=10,
+                        help="LZSS window size as a power of 2, at most the "
+                             "update.window-size-max of the device (default: 10)")
+    parser.add_argument("--lookahead", type=int, default=5,
+                        help="LZSS lookahead size as a power of 2 (default: 5)")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as f:
+        source = bytearray(f.read())
+    with open(args.new, "rb") as f:
+        target = bytearray(f.read())
+
+    patch = create(source, target, not args.no_compress, args.window, args.lookahead)
+    if apply(source, patch) != target:
+        raise RuntimeError("patch check failed")
+
+    with open(args.patch, "wb") as f:
+        f.write(patch)
+    print("%s: %d bytes, %.1f%% of the new image" %
+          (args.patch, len(patch), 100.0 * len(patch) / max(len(target), 1)))
+
+
+if __name__ == "__main__":
+    main()
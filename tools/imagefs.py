@@ -0,0 +1,196 @@
+#!/usr/bin/env python
+
+"""
+Copyright (c) 2021 ARM Limited. All rights reserved.
+
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Build read-only images of a directory for mbed::ImageFileSystem, see
+storage/filesystem/imagefs/include/imagefs/ImageFileSystem.h for the
+format.
+"""
+from __future__ import print_function, division, absolute_import
+
+import os
+import struct
+import zlib
+from argparse import ArgumentParser
+
+from delta_update import lzss_compress, _lzss_decompress
+
+MAGIC = 0x5346494D
+VERSION = 1
+COMPRESSION_NONE = 0
+COMPRESSION_LZSS = 1
+TYPE_REG = 1
+TYPE_DIR = 2
+BLOCK_RAW = 0x80000000
+NAME_MAX = 255
+HEADER = struct.Struct("<IBBBBIIIIIII")
+ENTRY = struct.Struct("<IHBBII")
+
+
+def _sort_key(path):
+    """Order of the entries: '/' before any other character, so that a
+    directory is directly followed by its content."""
+    return path.replace(b"/", b"\0")
+
+
+def collect(root):
+    """Return the (path, data) of the files and (path, None) of the
+    directories below root, paths relative to it."""
+    entries = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel = os.path.relpath(dirpath, root)
+        for name in dirnames + filenames:
+            path = name if rel == "." else os.path.join(rel, name)
+            full = os.path.join(dirpath, name)
+            path = path.replace(os.sep, "/").encode("utf-8")
+            if len(path) > NAME_MAX:
+                raise ValueError("%s: path longer than %d bytes" % (full, NAME_MAX))
+            if os.path.isdir(full):
+                entries.append((path, None))
+            else:
+                with open(full, "rb") as f:
+                    entries.append((path, bytearray(f.read())))
+    return entries
+
+
+def create(entries, block_size=1024, compress=True, window_sz2=10, lookahead_sz2=5):
+    entries = sorted(entries, key=lambda e: _sort_key(e[0]))
+
+    names = bytearray()
+    blocks = []
+    records = []
+    for i, (path, data) in enumerate(entries):
+        if data is None:
+            prefix = path + b"/"
+            below = 0
+            for other, _ in entries[i + 1:]:
+                if not other.startswith(prefix):
+                    break
+                below += 1
+            records.append((len(names), len(path), TYPE_DIR, below, 0))
+        else:
+            records.append((len(names), len(path), TYPE_REG, len(data), len(blocks)))
+            for pos in range(0, len(data), block_size):
+                block = data[pos:pos + block_size]
+                packed = lzss_compress(block, window_sz2, lookahead_sz2) if compress else block
+                if len(packed) < len(block):
+                    blocks.append((bytes(packed), False))
+                else:
+                    blocks.append((bytes(block), True))
+        names += path
+
+    names_offset = HEADER.size + len(records) * ENTRY.size
+    blocks_offset = (names_offset + len(names) + 3) & ~3
+    offset = blocks_offset + (len(blocks) + 1) * 4
+    table = bytearray()
+    for data, raw in blocks:
+        table += struct.pack("<I", offset | (BLOCK_RAW if raw else 0))
+        offset += len(data)
+    table += struct.pack("<I", offset)
+
+    metadata = bytearray()
+    for record in records:
+        metadata += ENTRY.pack(record[0], record[1], record[2], 0, record[3], record[4])
+    metadata += names
+    metadata += bytearray(blocks_offset - names_offset - len(names))
+    metadata += table
+
+    fields = [MAGIC, VERSION,
+              COMPRESSION_LZSS if compress else COMPRESSION_NONE,
+              window_sz2 if compress else 0,
+              lookahead_sz2 if compress else 0,
+              block_size, len(records), names_offset, blocks_offset,
+              len(blocks), offset]
+    crc = zlib.crc32(HEADER.pack(*(fields + [0])) + metadata) & 0xFFFFFFFF
+    image = bytearray(HEADER.pack(*(fields + [crc]))) + metadata
+    for data, _ in blocks:
+        image += data
+    return image
+
+
+def read(image):
+    """Reference reader, for checks. Return the (path, data) of the
+    entries, data None for directories."""
+    (magic, version, compression, window_sz2, lookahead_sz2, block_size,
+     entry_count, names_offset, blocks_offset, block_count, image_size,
+     crc) = HEADER.unpack_from(image)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not an image")
+    metadata_end = blocks_offset + (block_count + 1) * 4
+    header = HEADER.pack(magic, version, compression, window_sz2, lookahead_sz2,
+                         block_size, entry_count, names_offset, blocks_offset,
+                         block_count, image_size, 0)
+    if zlib.crc32(bytes(header + image[HEADER.size:metadata_end])) & 0xFFFFFFFF != crc:
+        raise ValueError("CRC mismatch")
+
+    def block(index):
+        start, end = struct.unpack_from("<II", image, blocks_offset + index * 4)
+        data = image[start & ~BLOCK_RAW:end & ~BLOCK_RAW]
+        if start & BLOCK_RAW:
+            return data
+        return _lzss_decompress(data, window_sz2, lookahead_sz2)
+
+    entries = []
+    for i in range(entry_count):
+        name_offset, name_len, kind, _, size, first = ENTRY.unpack_from(
+            image, HEADER.size + i * ENTRY.size)
+        path = bytes(image[names_offset + name_offset:names_offset + name_offset + name_len])
+        if kind == TYPE_DIR:
+            entries.append((path, None))
+            continue
+        data = bytearray()
+        index = first
+        while len(data) < size:
+            data += block(index)[:min(block_size, size - len(data))]
+            index += 1
+        entries.append((path, data))
+    return entries
+
+
+def main():
+    parser = ArgumentParser(description="Build an ImageFileSystem image")
+    parser.add_argument("root", help="directory packed in the image")
+    parser.add_argument("image", help="image file to create")
+    parser.add_argument("--block-size", type=int, default=1024,
+                        help="size of the blocks decompressed at once, the "
+                             "device keeps imagefs.cache-blocks of them "
+                             "(default: 1024)")
+    parser.add_argument("--no-compress", action="store_true",
+                        help="store the files uncompressed, they are then "
+                             "read in place from memory mapped images")
+    parser.add_argument("--window", type=int, default=10,
+                        help="LZSS window size as a power of 2 (default: 10)")
+    parser.add_argument("--lookahead", type=int, default=5,
+                        help="LZSS lookahead size as a power of 2 (default: 5)")
+    args = parser.parse_args()
+
+    entries = collect(args.root)
+    image = create(entries, args.block_size, not args.no_compress,
+                   args.window, args.lookahead)
+    if sorted(read(image)) != sorted(entries):
+        raise RuntimeError("image check failed")
+
+    with open(args.image, "wb") as f:
+        f.write(image)
+    size = sum(len(data) for _, data in entries if data is not None)
+    print("%s: %d entries, %d bytes, %.1f%% of the files" %
+          (args.image, len(entries), len(image), 100.0 * len(image) / max(size, 1)))
+
+
+if __name__ == "__main__":
+    main()
@@ -961,6 +961,7 @@ class mbedToolchain(with_metaclass(ABCMeta, object)):
     STACK_PARAM = "target.boot-stack-size"
     TFM_LVL_PARAM = "tfm.level"
     XIP_ENABLE_PARAM = "target.xip-enable"
+    RAMFUNC_SIZE_PARAM = "target.ramfunc_size"
 
     def add_linker_defines(self):
         params, _ = self.config_data
@@ -990,6 +991,15 @@ class mbedToolchain(with_metaclass(ABCMeta, object)):
             self.ld.append(define_string)
             self.flags["ld"].append(define_string)
 
+        # Size of the .ramfunc execution region, see MBED_RAMFUNC
+        if self.RAMFUNC_SIZE_PARAM in params:
+            define_string = self.make_ld_define(
+                "MBED_RAMFUNC_SIZE",
+                int(params[self.RAMFUNC_SIZE_PARAM].value, 0)
+            )
+            self.ld.append(define_string)
+            self.flags["ld"].append(define_string)
+
         if hasattr(self.target, 'post_binary_hook'):
             if self.target.post_binary_hook is None:
                 define_string = self.make_ld_define(